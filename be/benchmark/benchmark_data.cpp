@@ -0,0 +1,132 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark_data.h"
+
+#include <random>
+
+#include "util/binary_cast.hpp"
+#include "util/bitmap_value.h"
+#include "vec/columns/column_complex.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_bitmap.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized::benchmark_data {
+
+ColumnWithTypeAndName int64_column(size_t rows, int64_t cardinality, const std::string& name) {
+    std::mt19937_64 gen(SEED);
+    std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+    auto column = ColumnInt64::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        column->insert_value(dist(gen));
+    }
+    return {std::move(column), std::make_shared<DataTypeInt64>(), name};
+}
+
+ColumnWithTypeAndName float64_column(size_t rows, const std::string& name) {
+    std::mt19937_64 gen(SEED);
+    std::uniform_real_distribution<double> dist(0, 1000);
+    auto column = ColumnFloat64::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        column->insert_value(dist(gen));
+    }
+    return {std::move(column), std::make_shared<DataTypeFloat64>(), name};
+}
+
+ColumnWithTypeAndName string_column(size_t rows, size_t cardinality, size_t length,
+                                    const std::string& name) {
+    std::mt19937_64 gen(SEED);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> dictionary(cardinality);
+    for (auto& str : dictionary) {
+        str.resize(length);
+        for (auto& c : str) {
+            c = letter(gen);
+        }
+    }
+    std::uniform_int_distribution<size_t> dist(0, cardinality - 1);
+    auto column = ColumnString::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        const auto& str = dictionary[dist(gen)];
+        column->insert_data(str.data(), str.size());
+    }
+    return {std::move(column), std::make_shared<DataTypeString>(), name};
+}
+
+ColumnWithTypeAndName numeric_string_column(size_t rows, const std::string& name) {
+    std::mt19937_64 gen(SEED);
+    std::uniform_int_distribution<int64_t> dist(-1000000000, 1000000000);
+    auto column = ColumnString::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        auto str = std::to_string(dist(gen));
+        column->insert_data(str.data(), str.size());
+    }
+    return {std::move(column), std::make_shared<DataTypeString>(), name};
+}
+
+ColumnWithTypeAndName datetime_column(size_t rows, const std::string& name) {
+    std::mt19937_64 gen(SEED);
+    std::uniform_int_distribution<uint64_t> year(2000, 2029);
+    std::uniform_int_distribution<uint64_t> month(1, 12);
+    std::uniform_int_distribution<uint64_t> day(1, 28);
+    std::uniform_int_distribution<uint64_t> second(0, 86399);
+    auto column = ColumnInt64::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t seconds = second(gen);
+        uint64_t olap_datetime = (year(gen) * 10000 + month(gen) * 100 + day(gen)) * 1000000 +
+                                 seconds / 3600 * 10000 + seconds / 60 % 60 * 100 + seconds % 60;
+        auto value = VecDateTimeValue::create_from_olap_datetime(olap_datetime);
+        column->insert_value(binary_cast<VecDateTimeValue, Int64>(value));
+    }
+    return {std::move(column), std::make_shared<DataTypeDateTime>(), name};
+}
+
+ColumnWithTypeAndName bitmap_column(size_t rows, size_t values_per_row, uint64_t cardinality,
+                                    const std::string& name) {
+    std::mt19937_64 gen(SEED);
+    std::uniform_int_distribution<uint64_t> dist(0, cardinality - 1);
+    auto column = ColumnBitmap::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        BitmapValue bitmap;
+        for (size_t j = 0; j < values_per_row; ++j) {
+            bitmap.add(dist(gen));
+        }
+        column->insert_value(std::move(bitmap));
+    }
+    return {std::move(column), std::make_shared<DataTypeBitMap>(), name};
+}
+
+ColumnWithTypeAndName int32_const_column(size_t rows, int32_t value, const std::string& name) {
+    auto column = ColumnInt32::create();
+    column->insert_value(value);
+    return {ColumnConst::create(std::move(column), rows), std::make_shared<DataTypeInt32>(),
+            name};
+}
+
+} // namespace doris::vectorized::benchmark_data
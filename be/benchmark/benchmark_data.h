@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vec/core/column_with_type_and_name.h"
+
+namespace doris::vectorized::benchmark_data {
+
+// The datasets are generated from a fixed seed, so that the results of two runs, or of two
+// builds, are measured on the same values.
+constexpr uint32_t SEED = 20221014;
+
+// The rows of one block fed to the benchmarked code, 16 batches of the default batch size.
+constexpr size_t ROWS = 16 * 4096;
+
+// int64 in [0, cardinality)
+ColumnWithTypeAndName int64_column(size_t rows, int64_t cardinality,
+                                   const std::string& name = "int64");
+
+// float64 in [0, 1000)
+ColumnWithTypeAndName float64_column(size_t rows, const std::string& name = "float64");
+
+// strings of `length` random lower case letters, `cardinality` distinct ones
+ColumnWithTypeAndName string_column(size_t rows, size_t cardinality, size_t length,
+                                    const std::string& name = "string");
+
+// the decimal representation of int64 values
+ColumnWithTypeAndName numeric_string_column(size_t rows, const std::string& name = "numeric");
+
+// datetimes between 2000-01-01 and 2030-01-01
+ColumnWithTypeAndName datetime_column(size_t rows, const std::string& name = "datetime");
+
+// bitmaps of `values_per_row` values in [0, cardinality)
+ColumnWithTypeAndName bitmap_column(size_t rows, size_t values_per_row, uint64_t cardinality,
+                                    const std::string& name = "bitmap");
+
+// a constant column of `rows` rows
+ColumnWithTypeAndName int32_const_column(size_t rows, int32_t value,
+                                         const std::string& name = "const");
+
+} // namespace doris::vectorized::benchmark_data
@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+
+namespace doris::vectorized {
+
+// Adds the rows to `state.range(0)` groups once per iteration, the group of a row is
+// random. A single group goes through add_batch_single_place, as an aggregation without
+// GROUP BY does.
+static void run_aggregate(benchmark::State& state, const std::string& name,
+                          const ColumnsWithTypeAndName& arguments) {
+    DataTypes types;
+    std::vector<const IColumn*> columns;
+    for (const auto& argument : arguments) {
+        types.push_back(argument.type);
+        columns.push_back(argument.column.get());
+    }
+    auto function = AggregateFunctionSimpleFactory::instance().get(name, types, {});
+    if (function == nullptr) {
+        state.SkipWithError(("aggregate function not found: " + name).c_str());
+        return;
+    }
+
+    const size_t groups = state.range(0);
+    const size_t rows = arguments[0].column->size();
+    const auto group_keys = benchmark_data::int64_column(rows, groups, "group");
+    const auto& keys = assert_cast<const ColumnInt64&>(*group_keys.column).get_data();
+
+    Arena arena;
+    std::vector<AggregateDataPtr> group_places(groups);
+    for (auto& place : group_places) {
+        place = arena.aligned_alloc(function->size_of_data(), function->align_of_data());
+    }
+    std::vector<AggregateDataPtr> places(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        places[i] = group_places[keys[i]];
+    }
+
+    for (auto _ : state) {
+        for (auto place : group_places) {
+            function->create(place);
+        }
+        if (groups == 1) {
+            function->add_batch_single_place(rows, group_places[0], columns.data(), &arena);
+        } else {
+            function->add_batch(rows, places.data(), 0, columns.data(), &arena);
+        }
+        for (auto place : group_places) {
+            function->destroy(place);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+using namespace benchmark_data;
+
+static void AggregateSumInt64(benchmark::State& state) {
+    run_aggregate(state, "sum", {int64_column(ROWS, 1L << 40)});
+}
+
+static void AggregateSumFloat64(benchmark::State& state) {
+    run_aggregate(state, "sum", {float64_column(ROWS)});
+}
+
+static void AggregateAvgInt64(benchmark::State& state) {
+    run_aggregate(state, "avg", {int64_column(ROWS, 1L << 40)});
+}
+
+static void AggregateUniqInt64(benchmark::State& state) {
+    run_aggregate(state, "multi_distinct_count", {int64_column(ROWS, ROWS / 4)});
+}
+
+static void AggregateUniqString(benchmark::State& state) {
+    run_aggregate(state, "multi_distinct_count", {string_column(ROWS, ROWS / 4, 16)});
+}
+
+static void AggregateBitmapUnion(benchmark::State& state) {
+    run_aggregate(state, "bitmap_union", {bitmap_column(ROWS, 4, 1L << 20)});
+}
+
+static void AggregateBitmapUnionCount(benchmark::State& state) {
+    run_aggregate(state, "bitmap_union_count", {bitmap_column(ROWS, 4, 1L << 20)});
+}
+
+#define AGGREGATE_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(1)->Arg(1024)->Arg(ROWS / 4)
+
+AGGREGATE_BENCHMARK(AggregateSumInt64);
+AGGREGATE_BENCHMARK(AggregateSumFloat64);
+AGGREGATE_BENCHMARK(AggregateAvgInt64);
+AGGREGATE_BENCHMARK(AggregateUniqInt64);
+AGGREGATE_BENCHMARK(AggregateUniqString);
+AGGREGATE_BENCHMARK(AggregateBitmapUnion);
+AGGREGATE_BENCHMARK(AggregateBitmapUnionCount);
+
+#undef AGGREGATE_BENCHMARK
+
+} // namespace doris::vectorized
@@ -0,0 +1,258 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "exec_node_harness.h"
+#include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/exec/vanalytic_eval_node.h"
+#include "vec/exec/vsort_node.h"
+
+namespace doris::vectorized {
+
+// The rows of the input of every plan, the probe side of the joins.
+static constexpr size_t INPUT_ROWS = 1 << 20;
+
+static TableSpec table_spec(const std::string& spec, size_t rows) {
+    TableSpec table;
+    Status st = parse_table_spec(spec, rows, &table);
+    CHECK(st.ok()) << st.to_string();
+    return table;
+}
+
+// Runs the plan once per iteration, the time of an iteration is the time from open() to the end
+// of the output. Besides the rows/s of the input, it reports the rows of the output, the peak
+// memory of the fragment instance and the average of the given counters of the plan profile.
+static void run_plan(benchmark::State& state, ExecNodeHarness* harness,
+                     const ExecNodeHarness::PlanBuilder& plan, size_t input_rows,
+                     const std::vector<std::string>& counters) {
+    Status st = harness->build();
+    if (!st.ok()) {
+        state.SkipWithError(st.to_string().c_str());
+        return;
+    }
+    RunResult result;
+    int64_t peak_memory = 0;
+    std::map<std::string, double> totals;
+    for (auto _ : state) {
+        st = harness->run(plan, counters, &result);
+        if (!st.ok()) {
+            state.SkipWithError(st.to_string().c_str());
+            break;
+        }
+        state.SetIterationTime(result.elapsed_ns / 1e9);
+        peak_memory = std::max(peak_memory, result.peak_memory);
+        for (const auto& [name, value] : result.counters) {
+            totals[name] += value;
+        }
+    }
+    if (!st.ok()) {
+        return;
+    }
+    state.SetItemsProcessed(state.iterations() * input_rows);
+    state.counters["OutputRows"] = result.output_rows;
+    state.counters["PeakMemory"] = benchmark::Counter(peak_memory, benchmark::Counter::kDefaults,
+                                                      benchmark::Counter::kIs1024);
+    for (const auto& [name, total] : totals) {
+        state.counters[name] = benchmark::Counter(total, benchmark::Counter::kAvgIterations);
+    }
+}
+
+// probe(k, v) join build(k, w) on k, range(0) is the rows of the build side, about a half of the
+// probe rows find a match.
+static void run_hash_join(benchmark::State& state, TJoinOp::type join_op, double skew) {
+    size_t build_rows = state.range(0);
+    ExecNodeHarness harness;
+    int probe = harness.add_table(table_spec(
+            fmt::format("k:bigint:card={}:skew={},v:double", build_rows * 2, skew), INPUT_ROWS));
+    int build = harness.add_table(
+            table_spec(fmt::format("k:bigint:card={},w:bigint", build_rows), build_rows));
+    auto plan = [=](ExecNodeHarness* h, ExecNode** root) {
+        ExecNode* probe_node = nullptr;
+        ExecNode* build_node = nullptr;
+        RETURN_IF_ERROR(h->source(probe, &probe_node));
+        RETURN_IF_ERROR(h->source(build, &build_node));
+        auto tnode = h->plan_node(TPlanNodeType::HASH_JOIN_NODE, {probe, build},
+                                  {false, join_op == TJoinOp::LEFT_OUTER_JOIN});
+        tnode.num_children = 2;
+        tnode.__isset.hash_join_node = true;
+        tnode.hash_join_node.join_op = join_op;
+        TEqJoinCondition condition;
+        condition.left = h->slot_ref(probe, 0);
+        condition.right = h->slot_ref(build, 0);
+        tnode.hash_join_node.eq_join_conjuncts.push_back(condition);
+        return h->create_node<HashJoinNode>(tnode, {probe_node, build_node}, root);
+    };
+    run_plan(state, &harness, plan, INPUT_ROWS + build_rows,
+             {"BuildTime", "ProbeTime", "BuildBuckets"});
+}
+
+// select k, sum(v), count(v) group by k, range(0) is the number of groups.
+static void run_aggregation(benchmark::State& state, const std::string& key_spec) {
+    ExecNodeHarness harness;
+    auto table = table_spec(fmt::format("k:{}:card={},v:bigint", key_spec, state.range(0)),
+                            INPUT_ROWS);
+    const auto& key = table.columns[0];
+    int input = harness.add_table(table);
+    int output = harness.add_tuple(
+            {{"k", key.type, key.nullable}, {"sum_v", TYPE_BIGINT}, {"count_v", TYPE_BIGINT}});
+    auto plan = [=](ExecNodeHarness* h, ExecNode** root) {
+        ExecNode* child = nullptr;
+        RETURN_IF_ERROR(h->source(input, &child));
+        auto tnode = h->plan_node(TPlanNodeType::AGGREGATION_NODE, {output});
+        tnode.num_children = 1;
+        tnode.__isset.agg_node = true;
+        tnode.agg_node.__set_grouping_exprs({h->slot_ref(input, 0)});
+        tnode.agg_node.aggregate_functions = {
+                h->function_call("sum", {h->slot_ref(input, 1)}, TYPE_BIGINT, false),
+                h->function_call("count", {h->slot_ref(input, 1)}, TYPE_BIGINT, false)};
+        tnode.agg_node.intermediate_tuple_id = output;
+        tnode.agg_node.output_tuple_id = output;
+        tnode.agg_node.need_finalize = true;
+        return h->create_node<AggregationNode>(tnode, {child}, root);
+    };
+    run_plan(state, &harness, plan, INPUT_ROWS, {"BuildTime", "GetResultsTime"});
+}
+
+// select * order by the columns in `order_by` limit range(0), the limit is ignored if it is 0.
+static ExecNodeHarness::PlanBuilder sort_plan(int input, const std::vector<int>& order_by,
+                                              int64_t limit) {
+    return [=](ExecNodeHarness* h, ExecNode** root) {
+        ExecNode* child = nullptr;
+        RETURN_IF_ERROR(h->source(input, &child));
+        auto tnode = h->plan_node(TPlanNodeType::SORT_NODE, {input});
+        tnode.num_children = 1;
+        tnode.__isset.sort_node = true;
+        for (auto column : order_by) {
+            tnode.sort_node.sort_info.ordering_exprs.push_back(h->slot_ref(input, column));
+            tnode.sort_node.sort_info.is_asc_order.push_back(true);
+            tnode.sort_node.sort_info.nulls_first.push_back(false);
+        }
+        tnode.sort_node.use_top_n = limit > 0;
+        tnode.sort_node.__set_offset(0);
+        if (limit > 0) {
+            tnode.limit = limit;
+        }
+        return h->create_node<VSortNode>(tnode, {child}, root);
+    };
+}
+
+static void run_sort(benchmark::State& state, const std::string& spec,
+                     const std::vector<int>& order_by) {
+    ExecNodeHarness harness;
+    int input = harness.add_table(table_spec(spec, INPUT_ROWS));
+    run_plan(state, &harness, sort_plan(input, order_by, state.range(0)), INPUT_ROWS,
+             {"TopNFilteredRows"});
+}
+
+// select p, o, v, sum(v) over (partition by p order by o rows between unbounded preceding and
+// current row), range(0) is the number of partitions.
+static void run_analytic(benchmark::State& state) {
+    ExecNodeHarness harness;
+    auto table = table_spec(
+            fmt::format("p:bigint:card={},o:bigint:card={},v:bigint", state.range(0), INPUT_ROWS),
+            INPUT_ROWS);
+    int input = harness.add_table(table);
+    int output = harness.add_tuple({{"sum_v", TYPE_BIGINT}});
+    // the buffered tuple is identical to the input tuple
+    int buffered = harness.add_tuple(table.columns);
+    auto sort = sort_plan(input, {0, 1}, 0);
+    auto plan = [=](ExecNodeHarness* h, ExecNode** root) {
+        ExecNode* child = nullptr;
+        RETURN_IF_ERROR(sort(h, &child));
+        auto tnode = h->plan_node(TPlanNodeType::ANALYTIC_EVAL_NODE, {input, output});
+        tnode.num_children = 1;
+        tnode.__isset.analytic_node = true;
+        auto& analytic = tnode.analytic_node;
+        analytic.partition_exprs = {h->slot_ref(input, 0)};
+        analytic.order_by_exprs = {h->slot_ref(input, 1)};
+        analytic.analytic_functions = {
+                h->function_call("sum", {h->slot_ref(input, 2)}, TYPE_BIGINT, false)};
+        // the unset start is UNBOUNDED PRECEDING
+        TAnalyticWindowBoundary end;
+        end.type = TAnalyticWindowBoundaryType::CURRENT_ROW;
+        TAnalyticWindow window;
+        window.type = TAnalyticWindowType::ROWS;
+        window.__set_window_end(end);
+        analytic.__set_window(window);
+        analytic.intermediate_tuple_id = output;
+        analytic.output_tuple_id = output;
+        analytic.__set_buffered_tuple_id(buffered);
+        return h->create_node<VAnalyticEvalNode>(tnode, {child}, root);
+    };
+    run_plan(state, &harness, plan, INPUT_ROWS, {"EvaluationTime"});
+}
+
+static void HashJoinInner(benchmark::State& state) {
+    run_hash_join(state, TJoinOp::INNER_JOIN, 0);
+}
+
+static void HashJoinInnerSkewedProbe(benchmark::State& state) {
+    run_hash_join(state, TJoinOp::INNER_JOIN, 1.2);
+}
+
+static void HashJoinLeftOuter(benchmark::State& state) {
+    run_hash_join(state, TJoinOp::LEFT_OUTER_JOIN, 0);
+}
+
+static void AggregationInt64Key(benchmark::State& state) {
+    run_aggregation(state, "bigint");
+}
+
+static void AggregationSkewedInt64Key(benchmark::State& state) {
+    run_aggregation(state, "bigint:skew=1.2");
+}
+
+static void AggregationNullableInt64Key(benchmark::State& state) {
+    run_aggregation(state, "bigint:nulls=0.1");
+}
+
+static void AggregationStringKey(benchmark::State& state) {
+    run_aggregation(state, "string:len=16");
+}
+
+static void SortInt64(benchmark::State& state) {
+    run_sort(state, "k:bigint:card=1000000000,v:double", {0});
+}
+
+static void SortStringThenInt64(benchmark::State& state) {
+    run_sort(state, "s:string:card=1000:len=16,k:bigint:card=1000000000:nulls=0.1", {0, 1});
+}
+
+static void AnalyticSumRows(benchmark::State& state) {
+    run_analytic(state);
+}
+
+// the build sides stay below hash_join_parallel_build_min_rows, the harness has no ExecEnv and so
+// no thread pool for a parallel build
+#define EXEC_NODE_BENCHMARK(NAME) BENCHMARK(NAME)->UseManualTime()->Unit(benchmark::kMillisecond)
+
+EXEC_NODE_BENCHMARK(HashJoinInner)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+EXEC_NODE_BENCHMARK(HashJoinInnerSkewedProbe)->Arg(1 << 14);
+EXEC_NODE_BENCHMARK(HashJoinLeftOuter)->Arg(1 << 14);
+EXEC_NODE_BENCHMARK(AggregationInt64Key)->RangeMultiplier(32)->Range(16, 1 << 20);
+EXEC_NODE_BENCHMARK(AggregationSkewedInt64Key)->Arg(1 << 16);
+EXEC_NODE_BENCHMARK(AggregationNullableInt64Key)->Arg(1 << 16);
+EXEC_NODE_BENCHMARK(AggregationStringKey)->Arg(1 << 10)->Arg(1 << 16);
+EXEC_NODE_BENCHMARK(SortInt64)->Arg(0)->Arg(100);
+EXEC_NODE_BENCHMARK(SortStringThenInt64)->Arg(0)->Arg(100);
+EXEC_NODE_BENCHMARK(AnalyticSumRows)->Arg(16)->Arg(1 << 14);
+
+#undef EXEC_NODE_BENCHMARK
+
+} // namespace doris::vectorized
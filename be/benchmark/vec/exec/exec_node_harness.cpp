@@ -0,0 +1,430 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec_node_harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "benchmark_data.h"
+#include "gutil/strings/split.h"
+#include "util/stopwatch.hpp"
+#include "util/string_parser.hpp"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+Status parse_table_spec(const std::string& spec, size_t rows, TableSpec* table) {
+    table->rows = rows;
+    table->columns.clear();
+    std::vector<std::string> column_specs = strings::Split(spec, ",", strings::SkipWhitespace());
+    for (const auto& column_spec : column_specs) {
+        std::vector<std::string> parts = strings::Split(column_spec, ":");
+        if (parts.size() < 2 || parts[0].empty()) {
+            return Status::InvalidArgument("invalid column spec: " + column_spec);
+        }
+        ColumnSpec column;
+        column.name = parts[0];
+        if (parts[1] == "int") {
+            column.type = TYPE_INT;
+        } else if (parts[1] == "bigint") {
+            column.type = TYPE_BIGINT;
+        } else if (parts[1] == "double") {
+            column.type = TYPE_DOUBLE;
+        } else if (parts[1] == "string") {
+            column.type = TYPE_STRING;
+        } else {
+            return Status::InvalidArgument("unsupported column type: " + parts[1]);
+        }
+        for (size_t i = 2; i < parts.size(); ++i) {
+            auto pos = parts[i].find('=');
+            if (pos == std::string::npos) {
+                return Status::InvalidArgument("invalid column option: " + parts[i]);
+            }
+            std::string key = parts[i].substr(0, pos);
+            std::string value = parts[i].substr(pos + 1);
+            StringParser::ParseResult result;
+            if (key == "card") {
+                column.cardinality = StringParser::string_to_unsigned_int<uint64_t>(
+                        value.data(), value.size(), &result);
+            } else if (key == "len") {
+                column.length = StringParser::string_to_unsigned_int<uint64_t>(
+                        value.data(), value.size(), &result);
+            } else if (key == "skew") {
+                column.skew =
+                        StringParser::string_to_float<double>(value.data(), value.size(), &result);
+            } else if (key == "nulls") {
+                column.null_ratio =
+                        StringParser::string_to_float<double>(value.data(), value.size(), &result);
+                column.nullable = column.null_ratio > 0;
+            } else {
+                return Status::InvalidArgument("unknown column option: " + key);
+            }
+            if (result != StringParser::PARSE_SUCCESS) {
+                return Status::InvalidArgument("invalid column option: " + parts[i]);
+            }
+        }
+        table->columns.push_back(std::move(column));
+    }
+    return Status::OK();
+}
+
+// Returns the batches of a table. They are copied by prepare() so that the consumers own the
+// columns they get, like the blocks of a scan, and the copy is not measured.
+class BlockSourceNode final : public ExecNode {
+public:
+    BlockSourceNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                    const std::vector<Block>* blocks)
+            : ExecNode(pool, tnode, descs), _source(blocks) {}
+
+    Status prepare(RuntimeState* state) override {
+        RETURN_IF_ERROR(ExecNode::prepare(state));
+        _blocks.reserve(_source->size());
+        for (const auto& block : *_source) {
+            ColumnsWithTypeAndName columns;
+            for (auto column : block.get_columns_with_type_and_name()) {
+                column.column = column.column->clone_resized(column.column->size());
+                columns.push_back(std::move(column));
+            }
+            _blocks.emplace_back(columns);
+        }
+        return Status::OK();
+    }
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented BlockSourceNode::get_next scalar");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        SCOPED_TIMER(_runtime_profile->total_time_counter());
+        if (_next < _blocks.size()) {
+            block->swap(_blocks[_next++]);
+            _num_rows_returned += block->rows();
+            COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+        }
+        *eos = _next == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    const std::vector<Block>* _source;
+    std::vector<Block> _blocks;
+    size_t _next = 0;
+};
+
+// Draws the ranks of the values of a column, the rank 0 is the most frequent value of a
+// skewed column.
+class RankGenerator {
+public:
+    RankGenerator(size_t cardinality, double skew) : _uniform(0, cardinality - 1) {
+        if (skew > 0) {
+            _cdf.resize(cardinality);
+            double total = 0;
+            for (size_t i = 0; i < cardinality; ++i) {
+                total += 1.0 / std::pow(i + 1, skew);
+                _cdf[i] = total;
+            }
+        }
+    }
+
+    size_t next(std::mt19937_64& gen) {
+        if (_cdf.empty()) {
+            return _uniform(gen);
+        }
+        double x = std::uniform_real_distribution<double>(0, _cdf.back())(gen);
+        size_t rank = std::upper_bound(_cdf.begin(), _cdf.end(), x) - _cdf.begin();
+        return std::min(rank, _cdf.size() - 1);
+    }
+
+private:
+    std::uniform_int_distribution<size_t> _uniform;
+    std::vector<double> _cdf;
+};
+
+template <typename ColumnType, typename Generator>
+static MutableColumnPtr numeric_column(size_t rows, Generator generator) {
+    auto column = ColumnType::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        column->insert_value(generator());
+    }
+    return column;
+}
+
+// The values of the numeric columns are their ranks, the strings are random lower case letters.
+static ColumnPtr generate_column(const ColumnSpec& spec, size_t rows, uint32_t seed) {
+    std::mt19937_64 gen(seed);
+    size_t cardinality = std::max<size_t>(spec.cardinality, 1);
+    RankGenerator ranks(cardinality, spec.skew);
+    MutableColumnPtr column;
+    switch (spec.type) {
+    case TYPE_INT:
+        column = numeric_column<ColumnInt32>(rows, [&] { return Int32(ranks.next(gen)); });
+        break;
+    case TYPE_BIGINT:
+        column = numeric_column<ColumnInt64>(rows, [&] { return Int64(ranks.next(gen)); });
+        break;
+    case TYPE_DOUBLE:
+        column = numeric_column<ColumnFloat64>(rows, [&] { return ranks.next(gen) + 0.5; });
+        break;
+    default: {
+        DCHECK_EQ(spec.type, TYPE_STRING);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::vector<std::string> dictionary(cardinality);
+        for (auto& str : dictionary) {
+            str.resize(spec.length);
+            for (auto& c : str) {
+                c = letter(gen);
+            }
+        }
+        auto strings = ColumnString::create();
+        strings->reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            const auto& str = dictionary[ranks.next(gen)];
+            strings->insert_data(str.data(), str.size());
+        }
+        column = std::move(strings);
+    }
+    }
+    if (!spec.nullable) {
+        return column;
+    }
+    std::bernoulli_distribution is_null(spec.null_ratio);
+    auto null_map = ColumnUInt8::create();
+    null_map->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        null_map->insert_value(is_null(gen));
+    }
+    return ColumnNullable::create(std::move(column), std::move(null_map));
+}
+
+static TypeDescriptor slot_type(const ColumnSpec& spec) {
+    if (spec.type == TYPE_STRING) {
+        return TypeDescriptor::create_string_type();
+    }
+    return TypeDescriptor(spec.type);
+}
+
+static RuntimeProfile::Counter* find_counter(RuntimeProfile* profile, const std::string& name) {
+    if (auto counter = profile->get_counter(name)) {
+        return counter;
+    }
+    std::vector<RuntimeProfile*> children;
+    profile->get_children(&children);
+    for (auto child : children) {
+        if (auto counter = find_counter(child, name)) {
+            return counter;
+        }
+    }
+    return nullptr;
+}
+
+ExecNodeHarness::ExecNodeHarness(int batch_size) : _batch_size(batch_size) {}
+
+ExecNodeHarness::~ExecNodeHarness() {
+    // the nodes refer to the state
+    _run_pool.reset();
+}
+
+int ExecNodeHarness::_add_tuple(const TableSpec& table) {
+    DCHECK(_desc_tbl == nullptr) << "tuples are added after build()";
+    Tuple tuple;
+    tuple.table = table;
+    for (size_t i = 0; i < table.columns.size(); ++i) {
+        tuple.slots.push_back(_next_slot_id++);
+    }
+    _tuples.push_back(std::move(tuple));
+    return _tuples.size() - 1;
+}
+
+int ExecNodeHarness::add_table(const TableSpec& table) {
+    return _add_tuple(table);
+}
+
+int ExecNodeHarness::add_tuple(const std::vector<ColumnSpec>& slots) {
+    return _add_tuple({slots, 0});
+}
+
+Status ExecNodeHarness::build() {
+    DCHECK(_desc_tbl == nullptr);
+    for (int tuple_id = 0; tuple_id < _tuples.size(); ++tuple_id) {
+        const auto& columns = _tuples[tuple_id].table.columns;
+        int num_null_slots = std::count_if(columns.begin(), columns.end(),
+                                           [](const auto& column) { return column.nullable; });
+        int num_null_bytes = (num_null_slots + 7) / 8;
+        int null_slot = 0;
+        // the offsets only matter to the row based tuples, every slot is given 16 bytes
+        int offset = num_null_bytes;
+        for (int i = 0; i < columns.size(); ++i) {
+            TSlotDescriptor slot;
+            slot.id = _tuples[tuple_id].slots[i];
+            slot.parent = tuple_id;
+            slot.slotType = slot_type(columns[i]).to_thrift();
+            slot.columnPos = i;
+            slot.byteOffset = offset;
+            offset += 16;
+            slot.nullIndicatorByte = null_slot / 8;
+            slot.nullIndicatorBit = columns[i].nullable ? null_slot++ % 8 : -1;
+            slot.colName = columns[i].name;
+            slot.slotIdx = i;
+            slot.isMaterialized = true;
+            _thrift_desc_tbl.slotDescriptors.push_back(std::move(slot));
+        }
+        TTupleDescriptor tuple;
+        tuple.id = tuple_id;
+        tuple.byteSize = offset;
+        tuple.numNullBytes = num_null_bytes;
+        _thrift_desc_tbl.tupleDescriptors.push_back(std::move(tuple));
+    }
+    _thrift_desc_tbl.__isset.slotDescriptors = true;
+    RETURN_IF_ERROR(DescriptorTbl::create(&_pool, _thrift_desc_tbl, &_desc_tbl));
+
+    for (auto& tuple : _tuples) {
+        _generate(&tuple);
+    }
+    return Status::OK();
+}
+
+void ExecNodeHarness::_generate(Tuple* tuple) {
+    const auto& table = tuple->table;
+    std::vector<ColumnPtr> columns;
+    for (size_t i = 0; i < table.columns.size(); ++i) {
+        // every column has its own seed, or the columns of the same spec would be equal
+        columns.push_back(generate_column(table.columns[i], table.rows,
+                                          benchmark_data::SEED + tuple->slots[i]));
+    }
+    for (size_t offset = 0; offset < table.rows; offset += _batch_size) {
+        size_t length = std::min<size_t>(_batch_size, table.rows - offset);
+        ColumnsWithTypeAndName block;
+        for (size_t i = 0; i < table.columns.size(); ++i) {
+            auto slot = _desc_tbl->get_slot_descriptor(tuple->slots[i]);
+            block.emplace_back(columns[i]->cut(offset, length), slot->get_data_type_ptr(),
+                               slot->col_name());
+        }
+        tuple->blocks.emplace_back(block);
+    }
+}
+
+TExpr ExecNodeHarness::slot_ref(int tuple_id, int column) const {
+    const auto& spec = _tuples[tuple_id].table.columns[column];
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = slot_type(spec).to_thrift();
+    node.num_children = 0;
+    node.__set_slot_ref(TSlotRef());
+    node.slot_ref.slot_id = _tuples[tuple_id].slots[column];
+    node.slot_ref.tuple_id = tuple_id;
+    node.__set_is_nullable(spec.nullable);
+    TExpr expr;
+    expr.nodes.push_back(std::move(node));
+    return expr;
+}
+
+TExpr ExecNodeHarness::function_call(const std::string& name, const std::vector<TExpr>& args,
+                                     PrimitiveType ret_type, bool nullable) const {
+    TExprNode node;
+    node.node_type = TExprNodeType::AGG_EXPR;
+    node.type = TypeDescriptor(ret_type).to_thrift();
+    node.num_children = args.size();
+    node.fn.name.function_name = name;
+    node.fn.binary_type = TFunctionBinaryType::BUILTIN;
+    for (const auto& arg : args) {
+        node.fn.arg_types.push_back(arg.nodes[0].type);
+    }
+    node.fn.ret_type = node.type;
+    node.fn.has_var_args = false;
+    // only the functions of which the intermediate type is the return type are supported
+    node.fn.__set_aggregate_fn(TAggregateFunction());
+    node.fn.aggregate_fn.intermediate_type = node.type;
+    node.__isset.fn = true;
+    node.__set_agg_expr(TAggregateExpr());
+    node.agg_expr.is_merge_agg = false;
+    node.__set_is_nullable(nullable);
+    TExpr expr;
+    expr.nodes.push_back(std::move(node));
+    for (const auto& arg : args) {
+        expr.nodes.insert(expr.nodes.end(), arg.nodes.begin(), arg.nodes.end());
+    }
+    return expr;
+}
+
+TPlanNode ExecNodeHarness::plan_node(TPlanNodeType::type type, const std::vector<int>& row_tuples,
+                                     const std::vector<bool>& nullable_tuples) {
+    TPlanNode tnode;
+    tnode.node_id = _next_node_id++;
+    tnode.node_type = type;
+    tnode.limit = -1;
+    tnode.row_tuples.assign(row_tuples.begin(), row_tuples.end());
+    tnode.nullable_tuples = nullable_tuples;
+    tnode.nullable_tuples.resize(row_tuples.size(), false);
+    return tnode;
+}
+
+Status ExecNodeHarness::source(int tuple_id, ExecNode** node) {
+    // the type only names the profile, the rows come from another fragment as far as the
+    // plan is concerned
+    auto tnode = plan_node(TPlanNodeType::EXCHANGE_NODE, {tuple_id});
+    *node = _run_pool->add(
+            new BlockSourceNode(_run_pool.get(), tnode, *_desc_tbl, &_tuples[tuple_id].blocks));
+    return (*node)->init(tnode, _state.get());
+}
+
+Status ExecNodeHarness::run(const PlanBuilder& builder, const std::vector<std::string>& counters,
+                            RunResult* result) {
+    DCHECK(_desc_tbl != nullptr) << "build() is not called";
+    _run_pool.reset();
+    TQueryOptions query_options;
+    query_options.__set_batch_size(_batch_size);
+    query_options.__set_enable_vectorized_engine(true);
+    _state.reset(new RuntimeState(TUniqueId(), query_options, TQueryGlobals(), nullptr));
+    RETURN_IF_ERROR(_state->init_instance_mem_tracker());
+    _state->set_desc_tbl(_desc_tbl);
+    _run_pool.reset(new ObjectPool());
+    _next_node_id = 0;
+
+    ExecNode* root = nullptr;
+    RETURN_IF_ERROR(builder(this, &root));
+    *result = RunResult();
+    Status st = root->prepare(_state.get());
+    if (st.ok()) {
+        MonotonicStopWatch watch;
+        watch.start();
+        st = root->open(_state.get());
+        bool eos = false;
+        while (st.ok() && !eos) {
+            Block block;
+            st = root->get_next(_state.get(), &block, &eos);
+            result->output_rows += block.rows();
+        }
+        result->elapsed_ns = watch.elapsed_time();
+    }
+    root->close(_state.get());
+    RETURN_IF_ERROR(st);
+
+    result->peak_memory = _state->instance_mem_tracker()->peak_consumption();
+    for (const auto& name : counters) {
+        if (auto counter = find_counter(root->runtime_profile(), name)) {
+            result->counters[name] = counter->value();
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "exec/exec_node.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// One column of a synthetic table.
+struct ColumnSpec {
+    std::string name;
+    // TYPE_INT, TYPE_BIGINT, TYPE_DOUBLE or TYPE_STRING
+    PrimitiveType type = TYPE_BIGINT;
+    bool nullable = false;
+    // the number of distinct non null values
+    size_t cardinality = 1000;
+    // the zipf exponent of the value frequencies, 0 means uniform
+    double skew = 0;
+    // the ratio of null rows of a nullable column
+    double null_ratio = 0;
+    // the length of the string values
+    size_t length = 16;
+};
+
+struct TableSpec {
+    std::vector<ColumnSpec> columns;
+    size_t rows = 0;
+};
+
+// Parses a comma separated list of columns like "k:bigint:card=1000:skew=1.2,v:double:nulls=0.1".
+// The options of a column are card, skew, nulls and len, a column with nulls > 0 is nullable.
+Status parse_table_spec(const std::string& spec, size_t rows, TableSpec* table);
+
+struct RunResult {
+    int64_t output_rows = 0;
+    // from open() to the end of the output, prepare() and close() are not included
+    int64_t elapsed_ns = 0;
+    // the peak consumption of the fragment instance mem tracker
+    int64_t peak_memory = 0;
+    // the values of the requested counters of the plan profile
+    std::map<std::string, int64_t> counters;
+};
+
+// Runs vectorized exec nodes over synthetic tables, without a fragment or a scan.
+//
+// The tuples are declared first: add_table() for the tables fed to the plan and add_tuple()
+// for the tuples produced by the operators, then build() creates the descriptor table and
+// generates the rows of the tables. A plan is created again by every run() since exec nodes
+// are not reusable, the plan builder creates the nodes with source() and create_node().
+class ExecNodeHarness {
+public:
+    using PlanBuilder = std::function<Status(ExecNodeHarness* harness, ExecNode** root)>;
+
+    explicit ExecNodeHarness(int batch_size = 4096);
+    ~ExecNodeHarness();
+
+    // returns the id of the tuple of the table
+    int add_table(const TableSpec& table);
+    // returns the id of a tuple of the given slots, only the name, type and nullable are used
+    int add_tuple(const std::vector<ColumnSpec>& slots);
+    Status build();
+
+    size_t rows(int tuple_id) const { return _tuples[tuple_id].table.rows; }
+
+    TExpr slot_ref(int tuple_id, int column) const;
+    // an aggregate or analytic function of the given arguments
+    TExpr function_call(const std::string& name, const std::vector<TExpr>& args,
+                        PrimitiveType ret_type, bool nullable) const;
+    // a plan node returning rows of the given tuples, the type specific part is left unset
+    TPlanNode plan_node(TPlanNodeType::type type, const std::vector<int>& row_tuples,
+                        const std::vector<bool>& nullable_tuples = {});
+
+    // a node returning the rows of the table of the tuple
+    Status source(int tuple_id, ExecNode** node);
+
+    template <typename Node>
+    Status create_node(const TPlanNode& tnode, const std::vector<ExecNode*>& children,
+                       ExecNode** node) {
+        *node = _run_pool->add(new Node(_run_pool.get(), tnode, *_desc_tbl));
+        (*node)->_children = children;
+        RETURN_IF_ERROR((*node)->init(tnode, _state.get()));
+        // the same tree of profiles as ExecNode::create_tree()
+        for (int i = 1; i < children.size(); ++i) {
+            (*node)->runtime_profile()->add_child(children[i]->runtime_profile(), true, nullptr);
+        }
+        if (!children.empty()) {
+            (*node)->runtime_profile()->add_child(children[0]->runtime_profile(), true, nullptr);
+        }
+        return Status::OK();
+    }
+
+    Status run(const PlanBuilder& builder, const std::vector<std::string>& counters,
+               RunResult* result);
+
+private:
+    struct Tuple {
+        TableSpec table;
+        std::vector<SlotId> slots;
+        // the batches of the table, empty for the tuples of the operators
+        std::vector<Block> blocks;
+    };
+
+    int _add_tuple(const TableSpec& table);
+    void _generate(Tuple* tuple);
+
+    const int _batch_size;
+    ObjectPool _pool;
+    std::vector<Tuple> _tuples;
+    TDescriptorTable _thrift_desc_tbl;
+    DescriptorTbl* _desc_tbl = nullptr;
+    int _next_slot_id = 0;
+    int _next_node_id = 0;
+
+    // the state and the nodes of the current run
+    std::unique_ptr<RuntimeState> _state;
+    std::unique_ptr<ObjectPool> _run_pool;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,192 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "testutil/function_utils.h"
+#include "vec/columns/column_const.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+// Executes the function on the columns once per iteration, the result column is dropped
+// before the next one.
+static void run_function(benchmark::State& state, const std::string& name,
+                         ColumnsWithTypeAndName arguments, const DataTypePtr& return_type) {
+    Block block(arguments);
+    const size_t rows = block.rows();
+    auto function =
+            SimpleFunctionFactory::instance().get_function(name, arguments, return_type);
+    if (function == nullptr) {
+        state.SkipWithError(("function not found: " + name).c_str());
+        return;
+    }
+
+    ColumnNumbers argument_positions;
+    std::vector<doris_udf::FunctionContext::TypeDesc> arg_types(arguments.size());
+    std::vector<std::shared_ptr<ColumnPtrWrapper>> constant_col_ptrs;
+    std::vector<ColumnPtrWrapper*> constant_cols;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        argument_positions.push_back(i);
+        if (is_column_const(*arguments[i].column)) {
+            constant_col_ptrs.push_back(std::make_shared<ColumnPtrWrapper>(arguments[i].column));
+            constant_cols.push_back(constant_col_ptrs.back().get());
+        } else {
+            constant_cols.push_back(nullptr);
+        }
+    }
+    FunctionUtils fn_utils({}, arg_types, 0);
+    auto* fn_ctx = fn_utils.get_fn_ctx();
+    fn_ctx->impl()->set_constant_cols(constant_cols);
+    function->prepare(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    function->prepare(fn_ctx, FunctionContext::THREAD_LOCAL);
+
+    block.insert({nullptr, return_type, "result"});
+    const size_t result = block.columns() - 1;
+    for (auto _ : state) {
+        auto st = function->execute(fn_ctx, block, argument_positions, result, rows);
+        if (!st.ok()) {
+            state.SkipWithError(st.to_string().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(block.get_by_position(result).column);
+        block.get_by_position(result).column = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+
+    function->close(fn_ctx, FunctionContext::THREAD_LOCAL);
+    function->close(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+}
+
+static void run_cast(benchmark::State& state, const ColumnWithTypeAndName& from,
+                     const DataTypePtr& to) {
+    auto type_name = std::make_shared<DataTypeString>();
+    const auto& target_name = DataTypeFactory::instance().get(to);
+    ColumnWithTypeAndName target {type_name->create_column_const(from.column->size(), target_name),
+                                  type_name, target_name};
+    run_function(state, "CAST", {from, target}, to);
+}
+
+// the rows in reverse order, to compare a column with a different sequence of the same values
+static ColumnPtr reversed(const ColumnPtr& column) {
+    IColumn::Permutation permutation(column->size());
+    for (size_t i = 0; i < permutation.size(); ++i) {
+        permutation[i] = permutation.size() - 1 - i;
+    }
+    return column->permute(permutation, 0);
+}
+
+using namespace benchmark_data;
+
+static void FunctionCastInt64ToString(benchmark::State& state) {
+    run_cast(state, int64_column(ROWS, 1L << 40), std::make_shared<DataTypeString>());
+}
+
+static void FunctionCastStringToInt64(benchmark::State& state) {
+    run_cast(state, numeric_string_column(ROWS), std::make_shared<DataTypeInt64>());
+}
+
+static void FunctionCastInt64ToFloat64(benchmark::State& state) {
+    run_cast(state, int64_column(ROWS, 1L << 40), std::make_shared<DataTypeFloat64>());
+}
+
+static void FunctionCastDateTimeToString(benchmark::State& state) {
+    run_cast(state, datetime_column(ROWS), std::make_shared<DataTypeString>());
+}
+
+static void FunctionStringLower(benchmark::State& state) {
+    run_function(state, "lower", {string_column(ROWS, 1024, state.range(0))},
+                 std::make_shared<DataTypeString>());
+}
+
+static void FunctionStringLength(benchmark::State& state) {
+    run_function(state, "length", {string_column(ROWS, 1024, state.range(0))},
+                 std::make_shared<DataTypeInt32>());
+}
+
+static void FunctionStringConcat(benchmark::State& state) {
+    run_function(state, "concat",
+                 {string_column(ROWS, 1024, state.range(0), "lhs"),
+                  string_column(ROWS, 4096, state.range(0), "rhs")},
+                 std::make_shared<DataTypeString>());
+}
+
+static void FunctionStringSubstring(benchmark::State& state) {
+    run_function(state, "substring",
+                 {string_column(ROWS, 1024, state.range(0)), int32_const_column(ROWS, 2, "pos"),
+                  int32_const_column(ROWS, 8, "len")},
+                 std::make_shared<DataTypeString>());
+}
+
+static void FunctionDateYear(benchmark::State& state) {
+    run_function(state, "year", {datetime_column(ROWS)}, std::make_shared<DataTypeInt32>());
+}
+
+static void FunctionDateToDate(benchmark::State& state) {
+    run_function(state, "to_date", {datetime_column(ROWS)}, std::make_shared<DataTypeDate>());
+}
+
+static void FunctionDateDiff(benchmark::State& state) {
+    auto lhs = datetime_column(ROWS, "lhs");
+    auto rhs = datetime_column(ROWS, "rhs");
+    rhs.column = reversed(rhs.column);
+    run_function(state, "datediff", {lhs, rhs}, std::make_shared<DataTypeInt32>());
+}
+
+static void FunctionCompareEqInt64(benchmark::State& state) {
+    auto rhs = int64_column(ROWS, 16, "rhs");
+    rhs.column = reversed(rhs.column);
+    run_function(state, "eq", {int64_column(ROWS, 16, "lhs"), rhs},
+                 std::make_shared<DataTypeUInt8>());
+}
+
+static void FunctionCompareLtFloat64(benchmark::State& state) {
+    auto rhs = float64_column(ROWS, "rhs");
+    rhs.column = reversed(rhs.column);
+    run_function(state, "lt", {float64_column(ROWS, "lhs"), rhs},
+                 std::make_shared<DataTypeUInt8>());
+}
+
+static void FunctionCompareEqString(benchmark::State& state) {
+    auto rhs = string_column(ROWS, 16, state.range(0), "rhs");
+    rhs.column = reversed(rhs.column);
+    run_function(state, "eq", {string_column(ROWS, 16, state.range(0), "lhs"), rhs},
+                 std::make_shared<DataTypeUInt8>());
+}
+
+BENCHMARK(FunctionCastInt64ToString);
+BENCHMARK(FunctionCastStringToInt64);
+BENCHMARK(FunctionCastInt64ToFloat64);
+BENCHMARK(FunctionCastDateTimeToString);
+BENCHMARK(FunctionStringLower)->Arg(8)->Arg(64);
+BENCHMARK(FunctionStringLength)->Arg(8)->Arg(64);
+BENCHMARK(FunctionStringConcat)->Arg(8)->Arg(64);
+BENCHMARK(FunctionStringSubstring)->Arg(8)->Arg(64);
+BENCHMARK(FunctionDateYear);
+BENCHMARK(FunctionDateToDate);
+BENCHMARK(FunctionDateDiff);
+BENCHMARK(FunctionCompareEqInt64);
+BENCHMARK(FunctionCompareLtFloat64);
+BENCHMARK(FunctionCompareEqString)->Arg(8)->Arg(64);
+
+} // namespace doris::vectorized
@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/aggregation_common.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_map.h"
+
+namespace doris::vectorized {
+
+// The key types of the aggregation and the join, with `state.range(0)` distinct keys.
+using Int64HashMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using StringHashMap = HashMapWithSavedHash<StringRef, UInt64>;
+
+template <typename HashMapType, typename Keys>
+static void insert_keys(HashMapType& map, const Keys& keys) {
+    typename HashMapType::LookupResult it;
+    bool inserted;
+    for (const auto& key : keys) {
+        map.emplace(key, it, inserted);
+        if (inserted) {
+            *lookup_result_get_mapped(it) = 0;
+        }
+        ++*lookup_result_get_mapped(it);
+    }
+}
+
+template <typename HashMapType, typename Keys>
+static void find_keys(benchmark::State& state, const Keys& keys) {
+    HashMapType map;
+    insert_keys(map, keys);
+    for (auto _ : state) {
+        UInt64 sum = 0;
+        for (const auto& key : keys) {
+            auto it = map.find(key);
+            if (it != nullptr) {
+                sum += *lookup_result_get_mapped(it);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename HashMapType, typename Keys>
+static void emplace_keys(benchmark::State& state, const Keys& keys) {
+    for (auto _ : state) {
+        HashMapType map;
+        insert_keys(map, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+using namespace benchmark_data;
+
+static std::vector<UInt64> int64_keys(size_t cardinality) {
+    auto column = int64_column(ROWS, cardinality);
+    const auto& data = assert_cast<const ColumnInt64&>(*column.column).get_data();
+    return {data.begin(), data.end()};
+}
+
+// the column is kept alive by the caller, the keys point into it
+static std::vector<StringRef> string_keys(const ColumnWithTypeAndName& column) {
+    std::vector<StringRef> keys;
+    for (size_t i = 0; i < column.column->size(); ++i) {
+        keys.push_back(column.column->get_data_at(i));
+    }
+    return keys;
+}
+
+static void HashTableEmplaceInt64(benchmark::State& state) {
+    emplace_keys<Int64HashMap>(state, int64_keys(state.range(0)));
+}
+
+static void HashTableFindInt64(benchmark::State& state) {
+    find_keys<Int64HashMap>(state, int64_keys(state.range(0)));
+}
+
+static void HashTableEmplaceString(benchmark::State& state) {
+    auto column = string_column(ROWS, state.range(0), 16);
+    emplace_keys<StringHashMap>(state, string_keys(column));
+}
+
+static void HashTableFindString(benchmark::State& state) {
+    auto column = string_column(ROWS, state.range(0), 16);
+    find_keys<StringHashMap>(state, string_keys(column));
+}
+
+#define HASH_TABLE_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(1024)->Arg(ROWS / 4)->Arg(ROWS)
+
+HASH_TABLE_BENCHMARK(HashTableEmplaceInt64);
+HASH_TABLE_BENCHMARK(HashTableFindInt64);
+HASH_TABLE_BENCHMARK(HashTableEmplaceString);
+HASH_TABLE_BENCHMARK(HashTableFindString);
+
+#undef HASH_TABLE_BENCHMARK
+
+} // namespace doris::vectorized
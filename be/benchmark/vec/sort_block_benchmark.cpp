@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_data.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+
+namespace doris::vectorized {
+
+// Sorts the block by the columns listed in `order_by` once per iteration, the sort replaces
+// the columns of a copy of the block and leaves the source columns untouched.
+static void run_sort(benchmark::State& state, const Block& block, const std::vector<int>& order_by,
+                     UInt64 limit) {
+    SortDescription description;
+    for (auto column : order_by) {
+        description.emplace_back(column, 1, 1);
+    }
+    for (auto _ : state) {
+        Block sorted = block;
+        sort_block(sorted, description, limit);
+        benchmark::DoNotOptimize(sorted.get_by_position(0).column);
+    }
+    state.SetItemsProcessed(state.iterations() * block.rows());
+}
+
+using namespace benchmark_data;
+
+static Block create_block() {
+    return Block({int64_column(ROWS, 1L << 40, "int64"), int64_column(ROWS, 16, "int64_low_card"),
+                  string_column(ROWS, ROWS / 4, 16, "string"), float64_column(ROWS)});
+}
+
+static void SortBlockInt64(benchmark::State& state) {
+    run_sort(state, create_block(), {0}, state.range(0));
+}
+
+static void SortBlockString(benchmark::State& state) {
+    run_sort(state, create_block(), {2}, state.range(0));
+}
+
+static void SortBlockInt64LowCardinalityThenString(benchmark::State& state) {
+    run_sort(state, create_block(), {1, 2}, state.range(0));
+}
+
+// 0 sorts the whole block, the others are the top-n of a LIMIT
+#define SORT_BENCHMARK(NAME) BENCHMARK(NAME)->Arg(0)->Arg(100)->Arg(ROWS / 4)
+
+SORT_BENCHMARK(SortBlockInt64);
+SORT_BENCHMARK(SortBlockString);
+SORT_BENCHMARK(SortBlockInt64LowCardinalityThenString);
+
+#undef SORT_BENCHMARK
+
+} // namespace doris::vectorized
@@ -98,6 +98,8 @@ public:
 
     int64_t get_cgroups_version() { return _cur_version; }
 
+    bool is_cgroups_init_success() const { return _is_cgroups_init_success; }
+
     // set the disk throttle for the user by getting resource value from the map and echo it to the cgroups.
     // currently, both the user and groups under the user are set to the same value
     // because throttle does not support hierachy.
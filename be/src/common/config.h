@@ -81,6 +81,8 @@ CONF_Int32(push_worker_count_normal_priority, "3");
 CONF_Int32(push_worker_count_high_priority, "3");
 // the count of thread to publish version
 CONF_Int32(publish_version_worker_count, "8");
+// the count of thread to add the published rowsets to the tablets of a publish version task
+CONF_Int32(publish_version_tablet_thread_num, "16");
 // the count of thread to clear transaction task
 CONF_Int32(clear_transaction_task_worker_count, "1");
 // the count of thread to delete
@@ -97,6 +99,8 @@ CONF_Int32(check_consistency_worker_count, "1");
 CONF_Int32(upload_worker_count, "1");
 // the count of thread to download
 CONF_Int32(download_worker_count, "1");
+// the count of tablet snapshots transferred concurrently by an upload or download task
+CONF_mInt32(snapshot_transfer_thread_num, "4");
 // the count of thread to make snapshot
 CONF_Int32(make_snapshot_worker_count, "5");
 // the count of thread to release snapshot
@@ -115,6 +119,8 @@ CONF_mInt32(max_download_speed_kbps, "50000");
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
 CONF_mInt32(download_low_speed_time, "300");
+// the count of files downloaded in parallel by a clone task
+CONF_mInt32(clone_download_concurrency, "4");
 // sleep time for one second
 CONF_Int32(sleep_one_second, "1");
 
@@ -156,6 +162,9 @@ CONF_mInt64(doris_blocking_priority_queue_wait_timeout_ms, "5");
 CONF_Int32(doris_scanner_thread_pool_thread_num, "48");
 // number of olap scanner thread pool queue size
 CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
+// number of threads of the scanner scheduler, which assigns the scanners of all the scan
+// nodes to the olap scanner thread pool
+CONF_Int32(doris_scanner_scheduler_thread_num, "2");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
@@ -166,8 +175,9 @@ CONF_mInt32(thrift_connect_timeout_seconds, "3");
 CONF_mInt64(thrift_client_retry_interval_ms, "1000");
 // max row count number for single scan range, used in segmentv1
 CONF_mInt32(doris_scan_range_row_count, "524288");
-// max bytes number for single scan range, used in segmentv2
-CONF_mInt32(doris_scan_range_max_mb, "0");
+// max bytes number for single scan range, used in segmentv2. A tablet larger than it
+// is split on the short key index and scanned by several scanners, 0 means never split.
+CONF_mInt32(doris_scan_range_max_mb, "1024");
 // size of scanner queue between scanner thread and compute thread
 CONF_mInt32(doris_scanner_queue_size, "1024");
 // single read execute fragment row number
@@ -176,6 +186,12 @@ CONF_mInt32(doris_scanner_row_num, "16384");
 CONF_mInt32(doris_scanner_row_bytes, "10485760");
 // number of max scan keys
 CONF_mInt32(doris_max_scan_key_num, "1024");
+// The bytes a block returned by the olap scanners targets, the rows of the blocks are
+// adapted to the row width observed, from 64 rows up to `scan_block_max_rows`.
+// The blocks take `batch_size` rows if it is <= 0.
+CONF_mInt64(scan_block_target_bytes, "1048576"); // 1MB
+// The max rows of the blocks returned by the olap scanners, no less than `batch_size`.
+CONF_mInt32(scan_block_max_rows, "65536");
 // the max number of push down values of a single column.
 // if exceed, no conditions will be pushed down for that column.
 CONF_mInt32(max_pushdown_conditions_per_column, "1024");
@@ -188,8 +204,44 @@ CONF_mInt32(push_write_mbytes_per_sec, "100");
 
 CONF_mInt64(column_dictionary_key_ratio_threshold, "0");
 CONF_mInt64(column_dictionary_key_size_threshold, "0");
+// If true, the encoding of an integer column without an explicit encoding is chosen by
+// encoding the first page with every integer encoding and keeping the smallest one.
+// Segments written with DELTA_BINARY_PACKED or INT_DICT_ENCODING can't be read by older BEs.
+CONF_mBool(enable_int_column_encoding_selection, "false");
+// Same as enable_int_column_encoding_selection but for FLOAT and DOUBLE columns, which are
+// chosen between BIT_SHUFFLE and ALP_ENCODING. Segments written with ALP_ENCODING can't be
+// read by older BEs.
+CONF_mBool(enable_float_column_encoding_selection, "false");
+// If true, the data pages of a dictionary encoded string column fall back to FSST compressed
+// pages instead of plain pages once the dictionary is full.
+// Segments written with FSST_ENCODING can't be read by older BEs.
+CONF_mBool(enable_dict_page_fsst_fallback, "false");
+// If larger than 0, the encoding and the compression of the columns without an explicit
+// encoding are chosen per page: each of the first pages of a column in a segment is encoded
+// and compressed with every candidate, the best one by size and decoding cost is used for it,
+// and the most frequent choice is used for the rest pages. The choice is recorded in the
+// footer of each page, the segments can't be read by older BEs.
+CONF_mInt32(adaptive_page_encoding_sample_pages, "0");
+// If larger than 0, the data pages of a ZSTD compressed column are compressed with a dictionary
+// trained from so many first pages of the column in a segment, which improves the ratio of
+// small pages. The dictionary is stored in the column meta, and it is only used if it saves
+// space on the sample pages even counting its own size. Not used along with adaptive page
+// encoding, the segments can't be read by older BEs.
+CONF_mInt32(zstd_dict_train_pages, "0");
+// max size of a trained ZSTD dictionary
+CONF_mInt32(zstd_dict_max_bytes, "16384");
+// The segments of the merge-on-write unique key tablets with at least so many columns also
+// store the encoded rows in a hidden column, so that reading most columns of a few rows
+// reads one page per row instead of one page per column. Disabled if it is not greater than 0.
+CONF_mInt32(row_store_min_columns, "0");
+// The rows of a batch are read from the row store instead of the columns if there are at most
+// so many of them and at least half of the columns are read.
+CONF_mInt32(row_store_max_read_rows, "32");
 // memory_limitation_per_thread_for_schema_change_bytes unit bytes
 CONF_mInt64(memory_limitation_per_thread_for_schema_change_bytes, "2147483648");
+// number of threads to convert the rowsets of a tablet in schema change, every thread
+// may use memory_limitation_per_thread_for_schema_change_bytes when sorting
+CONF_mInt32(alter_tablet_rowset_parallelism, "1");
 CONF_mInt64(memory_limitation_per_thread_for_storage_migration_bytes, "100000000");
 
 // the clean interval of file descriptor cache and segment cache
@@ -221,6 +273,9 @@ CONF_mInt32(trash_file_expire_time_sec, "259200");
 CONF_mBool(row_nums_check, "true");
 //file descriptors cache, by default, cache 32768 descriptors
 CONF_Int32(file_descriptor_cache_capacity, "32768");
+// The eviction policy of the file descriptor cache, LRU, TINY_LFU or CLOCK,
+// see storage_page_cache_eviction_policy.
+CONF_String(file_descriptor_cache_eviction_policy, "LRU");
 // minimum file descriptor number
 // modify them upon necessity
 CONF_Int32(min_file_descriptor_number, "60000");
@@ -236,16 +291,62 @@ CONF_Int32(storage_page_cache_shard_size, "16");
 CONF_Int32(index_page_cache_percentage, "10");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// The eviction policy of storage page cache, LRU, TINY_LFU or CLOCK.
+// TINY_LFU only admits the pages accessed more frequently than the pages to evict,
+// so the hot pages are not evicted by a large scan.
+// CLOCK doesn't take the exclusive lock of a cache shard on hits, which scales better
+// when many scanner threads read the same hot pages.
+CONF_String(storage_page_cache_eviction_policy, "LRU");
+// The memory limit of the data pages of the fixed-width columns cached after being decoded,
+// which are not decoded again on the cache hits. In the format of storage_page_cache_limit,
+// and 0 disables the cache. Not used if disable_storage_page_cache is true.
+CONF_String(decoded_page_cache_limit, "0");
 
 CONF_Bool(enable_storage_vectorization, "true");
 
 CONF_Bool(enable_low_cardinality_optimize, "true");
+// Whether to let the scanner threads of the olap scan nodes aggregate the blocks read before
+// returning them to the parent aggregation nodes with grouping keys.
+CONF_mBool(enable_scan_aggregation, "false");
+// The groups aggregated by a scanner are flushed to the parent aggregation node once their
+// number reaches this.
+CONF_mInt64(scan_aggregation_max_groups, "65536");
+// Whether the streaming preaggregation aggregates the runs of equal keys without the hash
+// table, if the grouping keys are a prefix of the keys of the AGG/UNIQUE table scanned.
+CONF_mBool(enable_sorted_streaming_aggregation, "true");
+// Whether the multi_distinct_* functions of an aggregation node put the distinct keys of all
+// the groups into one hash table, if there are several of them.
+CONF_mBool(enable_shared_distinct_keys, "true");
+// The sort node under an analytic node splits its input into this many hash partitions by the
+// partition exprs, and sorts the partitions one by one rather than the whole input. 0 means
+// always sorting the whole input.
+CONF_mInt32(analytic_sort_partition_count, "64");
+// If true and lazy materialization is used, the predicate columns of a segment are read one
+// by one in the order of their observed selectivity, and a column is only read for the rows
+// passing the predicates of the columns before it, so its pages without such rows are not
+// read and decompressed.
+CONF_mBool(enable_staged_predicate_column_read, "true");
+// If true, the predicates evaluated on the selected rows of a segment are reordered by their
+// observed cost per filtered row, so that the cheap and selective ones are evaluated first.
+CONF_mBool(enable_adaptive_predicate_order, "true");
 
 // be policy
 // whether disable automatic compaction task
 CONF_mBool(disable_auto_compaction, "false");
 // whether enable vectorized compaction
 CONF_Bool(enable_vectorized_compaction, "true");
+// whether enable ordered data compaction, which links the segments of the input rowsets
+// into the output rowset when they are ordered by keys without deleted rows
+CONF_mBool(enable_ordered_data_compaction, "true");
+// whether enable vertical compaction, which merges the key columns first and then
+// the value columns group by group, to reduce the memory used by compaction of wide tables
+CONF_mBool(enable_vertical_compaction, "false");
+// number of value columns in one column group of vertical compaction
+CONF_Int32(vertical_compaction_num_columns_per_group, "5");
+// vertical compaction is only used for tablets which have more columns than this
+CONF_mInt32(vertical_compaction_min_num_columns, "32");
+// the max data size of a segment written by vertical compaction
+CONF_Int64(vertical_compaction_max_segment_size, "268435456");
 // whether enable vectorized schema change
 CONF_Bool(enable_vectorized_alter_table, "false");
 
@@ -258,13 +359,15 @@ CONF_mInt64(base_compaction_interval_seconds_since_last_operation, "86400");
 CONF_mInt32(base_compaction_write_mbytes_per_sec, "5");
 
 // config the cumulative compaction policy
-// Valid configs: num_based, size_based
+// Valid configs: num_based, size_based, time_series
 // num_based policy, the original version of cumulative compaction, cumulative version compaction once.
 // size_based policy, a optimization version of cumulative compaction, targeting the use cases requiring
 // lower write amplification, trading off read amplification and space amplification.
+// time_series policy, targeting the append-only tables like logs, compacts the rowsets only with the ones
+// written in the same time window, and never compacts the outputs again once the window is closed.
 CONF_mString(cumulative_compaction_policy, "size_based");
 CONF_Validator(cumulative_compaction_policy, [](const std::string config) -> bool {
-    return config == "size_based" || config == "num_based";
+    return config == "size_based" || config == "num_based" || config == "time_series";
 });
 
 // In size_based policy, output rowset of cumulative compaction total disk size exceed this config size,
@@ -284,6 +387,14 @@ CONF_mInt64(cumulative_size_based_promotion_min_size_mbytes, "64");
 // this size, size_based policy may not do to cumulative compaction. The unit is m byte.
 CONF_mInt64(cumulative_size_based_compaction_lower_size_mbytes, "64");
 
+// In time_series policy, the goal size of the output rowsets of compaction, the rowsets reaching this size
+// are never compacted again. The unit is m byte.
+CONF_mInt64(time_series_compaction_goal_size_mbytes, "1024");
+
+// In time_series policy, the rowsets are compacted only with the ones written in the same time window of
+// this length. The unit is second.
+CONF_mInt64(time_series_compaction_time_window_seconds, "3600");
+
 // cumulative compaction policy: min and max delta file's number
 CONF_mInt64(min_cumulative_compaction_num_singleton_deltas, "5");
 CONF_mInt64(max_cumulative_compaction_num_singleton_deltas, "1000");
@@ -342,6 +453,24 @@ CONF_mInt64(tablet_scan_frequency_time_node_interval_second, "300");
 // coefficient for tablet scan frequency and compaction score when finding a tablet for compaction
 CONF_mInt32(compaction_tablet_scan_frequency_factor, "0");
 CONF_mInt32(compaction_tablet_compaction_score_factor, "1");
+// coefficient for the read heat of a tablet when finding a tablet for compaction, which is the
+// scan frequency multiplied by the read amplification beyond 1, i.e. the extra sorted runs
+// merged by its queries per minute, so the tablets whose queries suffer most are compacted first
+CONF_mInt32(compaction_tablet_read_heat_factor, "1");
+// a tablet whose read heat reaches this threshold could take the slots of a disk held by base
+// compactions for its cumulative compaction, 0 to disable
+CONF_mInt64(compaction_preempt_read_heat_threshold, "600");
+// the upper limit of "permits" held by the compaction tasks of a disk, which bounds the I/O of
+// the compactions on the disk, 0 for no limit except total_permits_for_compaction_score
+CONF_mInt64(compaction_permits_per_disk, "0");
+// the upper limit of the I/O bandwidth of compaction, schema change and clone on a disk, which is
+// adjusted by the latency of the foreground reads of the disk, 0 for no limit. The unit is MB/s.
+CONF_mInt64(compaction_io_rate_limit_mbytes_per_sec, "0");
+// the lower limit of the adjusted I/O bandwidth of compaction on a disk. The unit is MB/s.
+CONF_mInt64(compaction_io_min_rate_mbytes_per_sec, "16");
+// the I/O bandwidth of compaction on a disk is halved when the average latency of the foreground
+// reads exceeds this config, 0 to disable the adjustment. The unit is ms.
+CONF_mInt64(compaction_io_read_latency_target_ms, "20");
 
 // This config can be set to limit thread number in tablet migration thread pool.
 CONF_Int32(min_tablet_migration_threads, "1");
@@ -366,6 +495,11 @@ CONF_Int64(load_data_reserve_hours, "4");
 // log error log will be removed after this time
 CONF_mInt64(load_error_log_reserve_hours, "48");
 CONF_Int32(number_tablet_writer_threads, "16");
+// the threads of a slave replica of single replica load pulling the rowsets from the writing
+// replica, separated from the tablet writer threads which wait for the pulls when closing
+CONF_Int32(number_slave_replica_download_threads, "64");
+// the timeout of a slave replica pulling the rowset of a tablet
+CONF_mInt32(slave_replica_pull_rowset_timeout_sec, "600");
 
 // The maximum amount of data that can be processed by a stream load
 CONF_mInt64(streaming_load_max_mb, "10240");
@@ -373,6 +507,24 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_json_max_mb, "100");
+// Whether the vectorized json load parses the data with simdjson on demand, which only
+// extracts the loaded columns. The documents it can not handle, e.g. nested values or
+// invalid rows, are parsed by rapidjson as before.
+CONF_mBool(enable_simdjson_reader, "true");
+// Whether the stream load passes the segments of the http body to the csv line reader
+// without copying them. The segments smaller than 4KB are still copied together.
+CONF_mBool(enable_stream_load_zero_copy, "true");
+// Whether the csv files of the broker and stream loads are decompressed by a separate thread,
+// which overlaps the decompression with the parsing of the decompressed lines.
+CONF_mBool(enable_pipelined_decompression, "true");
+// The max number of the decompressed chunks buffered ahead of the line reader.
+CONF_mInt32(pipelined_decompression_max_buffered_chunks, "4");
+// The stream loads with the header "group_commit: true" and a body smaller than
+// group_commit_max_request_bytes are appended to a shared load of the same table, which
+// is committed once it receives group_commit_max_bytes or group_commit_interval_ms elapses.
+CONF_mInt64(group_commit_max_request_bytes, "10485760");
+CONF_mInt64(group_commit_max_bytes, "67108864");
+CONF_mInt32(group_commit_interval_ms, "1000");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -382,6 +534,10 @@ CONF_mInt32(streaming_load_rpc_max_alive_time_sec, "1200");
 CONF_Int32(tablet_writer_open_rpc_timeout_sec, "60");
 // You can ignore brpc error '[E1011]The server is overcrowded' when writing data.
 CONF_mBool(tablet_writer_ignore_eovercrowded, "false");
+// The max number of add block rpcs a vectorized node channel keeps in flight. The receivers
+// older than this version reject the packets out of order, so only set it larger than 1
+// after all the BEs are upgraded.
+CONF_mInt32(tablet_writer_max_inflight_rpcs, "1");
 // Whether to enable stream load record function, the default is false.
 // False: disable stream load record
 CONF_mBool(enable_stream_load_record, "false");
@@ -401,6 +557,10 @@ CONF_mInt32(olap_table_sink_send_interval_ms, "1");
 CONF_Int32(fragment_pool_thread_num_min, "64");
 CONF_Int32(fragment_pool_thread_num_max, "512");
 CONF_Int32(fragment_pool_queue_size, "2048");
+// The threads preparing the fragment instances of one exec_plan_fragment request in
+// parallel, the instances are prepared one by one if it is 0.
+CONF_Int32(fragment_prepare_thread_pool_thread_num, "16");
+CONF_Int32(fragment_prepare_thread_pool_queue_size, "2048");
 
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
@@ -432,6 +592,14 @@ CONF_Bool(use_mmap_allocate_chunk, "false");
 // acquire more free memory which can not be used by other modules
 CONF_Int64(chunk_reserved_bytes_limit, "2147483648");
 
+// Whether to keep the memory and the threads on the NUMA nodes of a multi-socket host:
+// the threads of the scanner thread pool are bound to the NUMA nodes in round-robin, the
+// scanners are preferred to run on the node the blocks of their scan node are allocated,
+// the chunks are allocated on the node of the allocating thread if use_mmap_allocate_chunk
+// is true, and the free chunks are not reused across the nodes.
+// It takes effect only if there is more than one NUMA node.
+CONF_Bool(enable_numa_affinity, "false");
+
 // The probing algorithm of partitioned hash table.
 // Enable quadratic probing hash table
 CONF_Bool(enable_quadratic_probing, "false");
@@ -481,6 +649,11 @@ CONF_mInt64(write_buffer_size, "209715200");
 // max buffer size used in memtable for the aggregated table
 CONF_mInt64(memtable_max_buffer_size, "419430400");
 
+// If true, the vectorized memtable only appends the loaded blocks and sorts (and aggregates
+// for non-duplicate keys) all buffered rows at once when shrinking or flushing, instead of
+// inserting every row into a skiplist.
+CONF_mBool(enable_memtable_sort_on_flush, "false");
+
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
 // NOTICE(cmy): set these default values very large because we don't want to
@@ -488,6 +661,14 @@ CONF_mInt64(memtable_max_buffer_size, "419430400");
 // user should set these configs properly if necessary.
 CONF_Int64(load_process_max_memory_limit_bytes, "107374182400"); // 100GB
 CONF_Int32(load_process_max_memory_limit_percent, "80");         // 80%
+// When the load memory exceeds this percent of the limit above, the largest memtables of all
+// loads are flushed in background while the loads go on writing, and the add batch RPCs are
+// delayed a little longer as the memory gets closer to the limit.
+CONF_mInt32(load_process_soft_mem_limit_percent, "50");
+// the max delay of an add batch RPC when the load memory is between the soft limit and the limit
+CONF_mInt32(load_process_max_back_pressure_delay_ms, "100");
+// the max time an add batch RPC waits for the flushes when the load memory exceeds the limit
+CONF_mInt32(load_process_mem_limit_wait_ms, "10000");
 
 // result buffer cancelled time (unit: second)
 CONF_mInt32(result_buffer_cancelled_interval_time, "300");
@@ -509,6 +690,12 @@ CONF_Bool(enable_metric_calculator, "true");
 
 // max consumer num in one data consumer group, for routine load
 CONF_mInt32(max_consumer_num_per_group, "3");
+// If true, the partitions of a routine load task are assigned to the consumers by their lag,
+// and each consumer puts the kafka msgs it has fetched into the queue in batches, which grow
+// while the task keeps up with the consumers.
+CONF_mBool(enable_routine_load_adaptive_consume, "false");
+// the max number of kafka msgs a consumer puts into the queue at once in adaptive mode
+CONF_mInt32(routine_load_max_consume_batch_size, "1024");
 
 // the size of thread pool for routine load task.
 // this should be larger than FE config 'max_routine_load_task_num_per_be' (default 5)
@@ -528,6 +715,11 @@ CONF_String(es_scroll_keepalive, "5m");
 // HTTP connection timeout for es
 CONF_mInt32(es_http_timeout_ms, "5000");
 
+// The number of slices each shard of an es table is scrolled with, the slices are scanned
+// by the vectorized es scan node in parallel. Sliced scroll is disabled if it is not greater
+// than 1.
+CONF_mInt32(es_scroll_slices_per_shard, "1");
+
 // the max client cache number per each host
 // There are variety of client cache in BE, but currently we use the
 // same cache size configuration.
@@ -573,6 +765,27 @@ CONF_Int64(brpc_socket_max_unwritten_bytes, "1073741824");
 // is greater than 1.8G. This is to avoid the error of Request length overflow (2G).
 CONF_mBool(transfer_large_data_by_brpc, "false");
 
+// Pass the blocks to the exchange nodes on the same BE by moving the columns instead of
+// serializing them and sending them through brpc.
+CONF_mBool(enable_local_exchange, "true");
+
+// The exchange sends the next exchange_compression_skip_blocks blocks uncompressed when
+// the compressed size of a block is larger than exchange_compression_min_ratio of the
+// uncompressed one.
+CONF_mDouble(exchange_compression_min_ratio, "0.9");
+CONF_mInt32(exchange_compression_skip_blocks, "32");
+
+// Send the blocks of the exchange through a brpc stream per sender and receiver instead
+// of a transmit_block rpc per block. At most exchange_stream_max_buf_bytes bytes not
+// consumed by the receiver are in flight in a stream.
+CONF_mBool(exchange_use_brpc_stream, "false");
+CONF_mInt64(exchange_stream_max_buf_bytes, "16777216");
+
+// A broadcast exchange to more remote receivers than exchange_broadcast_relay_fanout
+// sends the blocks to this many receivers only, which relay them to the others in a tree
+// of this fanout. 0 means the sender sends the blocks to every receiver.
+CONF_mInt32(exchange_broadcast_relay_fanout, "0");
+
 // max number of txns for every txn_partition_map in txn manager
 // this is a self protection to avoid too many txns saving in manager
 CONF_mInt64(max_runnings_transactions_per_txn_map, "100");
@@ -619,6 +832,9 @@ CONF_String(thrift_server_type_of_fe, "THREAD_POOL");
 // disable zone map index when page row is too few
 CONF_mInt32(zone_map_row_num_threshold, "20");
 
+// the number of bytes of each gram in the n-gram bloom filter indexes of new segments
+CONF_mInt32(ngram_bloom_filter_gram_size, "3");
+
 // aws sdk log level
 //    Off = 0,
 //    Fatal = 1,
@@ -631,6 +847,15 @@ CONF_Int32(aws_log_level, "3");
 
 // the buffer size when read data from remote storage like s3
 CONF_mInt32(remote_storage_read_buffer_mb, "16");
+// Whether the buffered reader of the remote files reads the next buffer in the background
+// once it finds the file read sequentially.
+CONF_mBool(enable_buffered_reader_read_ahead, "true");
+// The timeout of reading from a hdfs datanode, the reader gives up a stalled datanode and
+// turns to the other replicas after the timeout.
+CONF_mInt32(hdfs_read_timeout_ms, "60000");
+// The unix domain socket path shared with the local hdfs datanode, the blocks stored on the
+// local datanode are read from the local disks directly if it is set.
+CONF_String(hdfs_domain_socket_path, "");
 
 // Whether Hook TCmalloc new/delete, currently consume/release tls mem tracker in Hook.
 CONF_Bool(track_new_delete, "true");
@@ -654,6 +879,15 @@ CONF_mInt16(mem_tracker_level, "0");
 // Increasing this value will cause MemTracker statistics to be inaccurate.
 CONF_mInt32(mem_tracker_consume_min_size_bytes, "2097152");
 
+// The max bytes of the freed column buffers cached by a fragment instance, which are reused
+// by the blocks of the next batches, 0 means not to cache them.
+CONF_mInt64(column_buffer_pool_bytes_per_instance, "8388608");
+
+// Whether to advise the kernel to back the hash tables larger than 4MB by transparent huge
+// pages, which reduces the TLB misses of the large aggregations and joins. It takes effect
+// if /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise".
+CONF_Bool(enable_huge_pages_for_hash_table, "true");
+
 // When MemTracker is a negative value, it is considered that a memory leak has occurred,
 // but the actual MemTracker records inaccurately will also cause a negative value,
 // so this feature is in the experimental stage.
@@ -673,6 +907,20 @@ CONF_mDouble(tablet_version_graph_orphan_vertex_ratio, "0.1");
 // else we will call sync method
 CONF_mBool(runtime_filter_use_async_rpc, "true");
 
+// Resize the bloom filters for the ndv of the build side when the filters are not merged
+// with the ones of other instances, instead of the size estimated by FE.
+CONF_mBool(enable_runtime_bloom_filter_adaptive_size, "true");
+// The size range of the bloom filters resized by the above.
+CONF_mInt64(runtime_bloom_filter_min_size_bytes, "4096");
+CONF_mInt64(runtime_bloom_filter_max_size_bytes, "16777216");
+
+// Merge the runtime filters built by the instances on one BE before sending them to the
+// merge instance, so that the merge instance receives one filter from each BE.
+CONF_mBool(enable_runtime_filter_local_merge, "true");
+// Compress the bloom filters sent by rpc with LZ4 when they are at least this large,
+// 0 to disable the compression.
+CONF_mInt64(runtime_filter_compression_min_bytes, "65536");
+
 // max send batch parallelism for OlapTableSink
 // The value set by the user for send_batch_parallelism is not allowed to exceed max_send_batch_parallelism_per_job,
 // if exceed, the value of send_batch_parallelism would be max_send_batch_parallelism_per_job
@@ -699,6 +947,9 @@ CONF_mInt32(external_table_connect_timeout_sec, "5");
 // Althought it is called "segment cache", but it caches segments in rowset granularity.
 // So the value of this config should corresponding to the number of rowsets on this BE.
 CONF_mInt32(segment_cache_capacity, "1000000");
+// The eviction policy of the segment cache, LRU, TINY_LFU or CLOCK,
+// see storage_page_cache_eviction_policy.
+CONF_String(segment_cache_eviction_policy, "LRU");
 
 // s3 config
 CONF_mInt32(max_remote_storage_count, "10");
@@ -727,6 +978,12 @@ CONF_mInt32(min_load_rpc_timeout_ms, "20000");
 // use which protocol to access function service, candicate is baidu_std/h2:grpc
 CONF_String(function_service_protocol, "h2:grpc");
 
+// The max rows sent to the function service by one rpc udf call, a block is split into
+// several calls sent in parallel. 0 means sending the whole block by one call.
+CONF_mInt32(rpc_udf_batch_rows, "1024");
+// The max number of the inflight calls of an rpc udf
+CONF_mInt32(rpc_udf_max_inflight_calls, "4");
+
 // use which load balancer to select server to connect
 CONF_String(rpc_load_balancer, "rr");
 
@@ -744,9 +1001,16 @@ CONF_Int32(object_pool_buffer_size, "100");
 // ParquetReaderWrap prefetch buffer size
 CONF_Int32(parquet_reader_max_buffer_size, "50");
 
+// Whether the vectorized parquet scanner decodes the files into columns directly, instead
+// of reading arrow record batches by ParquetReaderWrap and converting them.
+CONF_mBool(enable_native_parquet_reader, "true");
+
 // When the rows number reached this limit, will check the filter rate the of bloomfilter
 // if it is lower than a specific threshold, the predicate will be disabled.
 CONF_mInt32(bloom_filter_predicate_check_row_num, "1000");
+// The bloom filter pushed down by the runtime filters is disabled for the scan node if it
+// filters less than this ratio of the sampled rows.
+CONF_mDouble(bloom_filter_predicate_min_filter_ratio, "0.5");
 
 //whether turn on quick compaction feature
 CONF_Bool(enable_quick_compaction, "false");
@@ -765,6 +1029,199 @@ CONF_mInt64(cooldown_lag_time_sec, "10800"); // 3h
 
 CONF_Int32(s3_transfer_executor_pool_size, "2");
 
+// The max number of finished result files of one outfile instance closed in background while
+// the next file is written. Closing a file uploads it to S3. The files are closed in place if
+// it is not greater than 0.
+CONF_mInt32(outfile_max_concurrent_uploads, "4");
+// number of file upload thread pool size, the pool is shared by all outfile instances
+CONF_Int32(file_upload_thread_pool_thread_num, "32");
+// number of file upload thread pool queue size
+CONF_Int32(file_upload_thread_pool_queue_size, "102400");
+
+// Whether segment iterators prefetch the data pages to read from S3 in background.
+CONF_mBool(enable_s3_prefetch, "true");
+// Ranges to prefetch which are at most this far apart are merged into one request.
+CONF_mInt64(s3_prefetch_merge_gap_bytes, "65536"); // 64KB
+// Ranges are not merged into a request larger than this.
+CONF_mInt64(s3_prefetch_max_request_bytes, "8388608"); // 8MB
+// The max bytes prefetched but not read yet for each opened S3 file.
+CONF_mInt64(s3_prefetch_buffer_bytes, "33554432"); // 32MB
+
+// Whether to read local segment files with io_uring, so that the data pages a segment
+// iterator is going to read are submitted to the kernel in batches. Fall back to pread
+// if io_uring is not supported by the kernel.
+CONF_Bool(enable_io_uring, "false");
+// The submission queue size of the io_uring of each opened local file.
+CONF_Int32(io_uring_queue_depth, "64");
+// The max bytes read by io_uring but not consumed yet for each opened local file.
+CONF_mInt64(io_uring_prefetch_buffer_bytes, "16777216"); // 16MB
+// If io_uring is not used, the data pages a segment iterator is going to read are
+// hinted to the kernel by posix_fadvise(WILLNEED), so that they are read ahead while
+// the current pages are decoded. This is the max bytes hinted but not read yet for each
+// opened local file, 0 to disable.
+CONF_mInt64(local_prefetch_window_bytes, "8388608"); // 8MB
+
+// Whether to cache the data of remote files (e.g. the cold data on S3) on local disk.
+CONF_Bool(enable_file_cache, "false");
+// The directory of the file cache, which should be on a fast local disk like SSD.
+// It is cleared when BE starts.
+CONF_String(file_cache_path, "${DORIS_HOME}/file_cache");
+// The max size of the file cache.
+CONF_Int64(file_cache_max_size, "107374182400"); // 100GB
+// Remote files are cached in blocks of this size.
+CONF_Int64(file_cache_block_size, "1048576"); // 1MB
+// If true, a remote block is cached only when it is missed twice recently,
+// so that one-off scans do not evict the frequently read blocks.
+CONF_mBool(file_cache_admit_on_second_access, "true");
+
+// When `enable_spilling` is set in query options and the memory used by the hash table of
+// a vectorized aggregation node exceeds this threshold, the hash table will be spilled to disk.
+CONF_mInt64(spill_aggregation_threshold_bytes, "1073741824"); // 1GB
+// The number of hash partitions the spilled aggregation data is split into,
+// each partition is merged back separately.
+CONF_mInt32(spill_aggregation_partition_count, "16");
+// When `enable_spilling` is set in query options and the sorted blocks of a vectorized
+// sort node exceed this threshold, they are merged to a sorted run and spilled to disk.
+CONF_mInt64(spill_sort_threshold_bytes, "1073741824"); // 1GB
+// When `enable_spilling` is set in query options and the build side of a vectorized hash join
+// node exceeds this threshold, both sides are hash partitioned to disk and joined partition
+// by partition.
+CONF_mInt64(spill_hash_join_threshold_bytes, "1073741824"); // 1GB
+// The number of hash partitions the spilled hash join is split into.
+CONF_mInt32(spill_hash_join_partition_count, "16");
+// The number of the descriptor tables of queries cached by FragmentMgr, the repeated queries
+// of the same plan reuse the tables instead of creating them again. 0 disables the cache.
+CONF_Int32(descriptor_table_cache_capacity, "128");
+// If true, a query reserves memory on a BE before its fragments start, the fragments are
+// queued while the reservations of the running queries use up the query pool memory.
+CONF_Bool(enable_query_memory_admission, "false");
+// The percentage of the query pool memory limit the reservations of queries can take.
+CONF_Int32(query_admission_mem_limit_percent, "90");
+// The memory a query reserves on a BE, no more than the mem_limit of the query.
+CONF_mInt64(query_initial_reservation_bytes, "1073741824"); // 1GB
+// The percentage the spill thresholds of the operators are lowered to while queries are
+// queued for memory.
+CONF_mInt32(spill_threshold_percent_under_pressure, "25");
+// The max bytes of the spill files a query can write on one BE, -1 means no limit.
+CONF_mInt64(spill_max_bytes_per_query, "-1");
+// number of spill io thread pool size, the pool writes the spilled blocks of all queries,
+// the blocks are written synchronously if it is 0
+CONF_Int32(spill_io_thread_pool_thread_num, "8");
+// number of spill io thread pool queue size
+CONF_Int32(spill_io_thread_pool_queue_size, "102400");
+// The max bytes of the blocks a spill writer has submitted to the spill io thread pool
+// but not written yet, the writer waits for them once it is exceeded.
+CONF_mInt64(spill_io_pending_bytes_per_writer, "67108864"); // 64MB
+
+// The hash table of a vectorized aggregation node is converted to a two level one
+// (256 sub tables selected by the hash value) once it has more keys than this,
+// or it takes more memory than `two_level_aggregation_threshold_bytes`.
+CONF_mInt64(two_level_aggregation_threshold_rows, "100000");
+CONF_mInt64(two_level_aggregation_threshold_bytes, "52428800"); // 50MB
+
+// The number of threads building one hash table of the vectorized hash join in parallel,
+// parallel build is disabled if it is not greater than 1.
+CONF_mInt32(hash_join_parallel_build_threads, "8");
+// A build block of hash join is only inserted in parallel if it has at least so many rows.
+CONF_mInt64(hash_join_parallel_build_min_rows, "1000000");
+// number of hash join build thread pool size, the pool is shared by all hash join nodes
+CONF_Int32(hash_join_build_thread_pool_thread_num, "32");
+// number of hash join build thread pool queue size
+CONF_Int32(hash_join_build_thread_pool_queue_size, "102400");
+
+// The number of tasks converting and encoding the columns of a block appended to a segment
+// in parallel, parallel writing is disabled if it is not greater than 1.
+CONF_mInt32(segment_writer_parallel_tasks, "4");
+// A segment is only written in parallel if it has at least so many columns.
+CONF_mInt32(segment_writer_parallel_min_columns, "64");
+// number of segment writer thread pool size, the pool is shared by all segment writers
+CONF_Int32(segment_writer_thread_pool_thread_num, "32");
+// number of segment writer thread pool queue size
+CONF_Int32(segment_writer_thread_pool_queue_size, "102400");
+
+// Whether the instances of a broadcast join on one BE share the hash table built by
+// one of them.
+CONF_mBool(enable_share_hash_table_for_broadcast_join, "true");
+
+// Whether to execute the supported vectorized fragments by pipelines. The pipeline tasks
+// run on a fixed number of threads and are parked while waiting for data, instead of
+// occupying a fragment thread each.
+CONF_mBool(enable_pipeline_engine, "false");
+// The number of threads executing pipeline tasks, 0 means the number of cores.
+CONF_Int32(pipeline_executor_size, "0");
+// Whether to bind every pipeline executor thread to a core.
+CONF_Bool(pipeline_executor_bind_cores, "false");
+// A pipeline task gives up its thread after running so long, then the other tasks run.
+CONF_mInt32(pipeline_task_time_slice_ms, "100");
+
+// Whether a deterministic vectorized function call whose result is already in the block,
+// computed by an identical expression of the same node, reuses the column instead of
+// executing again.
+CONF_mBool(enable_expr_result_reuse, "true");
+
+// The right side of AND / OR and the branches of CASE WHEN are executed only on the rows
+// not decided yet, which are copied out of the block if they are at most this ratio of the
+// rows. 0 disables copying, the sides needed by no row are skipped anyway.
+CONF_mDouble(short_circuit_evaluation_max_ratio, "0.3");
+
+// A tree of at least this many add, subtract, multiply and comparison calls over the same
+// non-nullable BIGINT or DOUBLE type is evaluated in one pass over small tiles of rows,
+// without a column for every call. 0 disables it.
+CONF_mInt32(expr_fusion_min_operators, "3");
+
+// Whether to record the spans of the queries, e.g. reading a block from the storage, to be
+// exported as a timeline by /api/query_trace.
+CONF_mBool(enable_query_trace, "false");
+
+// The number of spans kept by each thread, the oldest ones are dropped.
+CONF_Int32(query_trace_thread_buffer_events, "16384");
+
+// Whether to count the cycles, instructions, LLC misses and branch misses of the threads of
+// the vectorized exec nodes into their runtime profiles, which needs perf_event to be
+// allowed, e.g. by kernel.perf_event_paranoid.
+CONF_mBool(enable_exec_node_perf_counters, "false");
+
+// The max number of samples of a run of the sampling profiler of /pprof/query_profile, the
+// buffer of the samples is allocated by the first run and kept.
+CONF_Int32(sampling_profiler_max_samples, "32768");
+
+// The number of threads of each data dir to parse and load the tablet and rowset metas at
+// startup, the meta of a data dir is still traversed by one thread.
+CONF_Int32(load_data_dir_thread_num, "8");
+
+// The bytes of the parsed segment footers and short key indexes cached by SegmentMetaCache,
+// so that the reopened segments don't need to read and parse them again. 0 to disable.
+CONF_Int64(segment_meta_cache_bytes, "268435456");
+
+// The bytes of the rows cached by RowCache for the point queries on the primary keys of
+// merge-on-write unique key tables, which are served by the tablet_key_lookup rpc without
+// planning fragments. 0 to disable.
+CONF_Int64(row_cache_bytes, "67108864");
+
+// The bytes of the rows deleted by the delete predicates cached by
+// DeletePredicateBitmapCache for each segment, so the delete predicates are evaluated once
+// for a segment instead of for every block read. 0 to disable.
+CONF_Int64(delete_predicate_bitmap_cache_bytes, "134217728");
+
+// The bytes of the compiled regexes of like, regexp, regexp_extract and regexp_replace
+// cached by RegexCache for all the queries, keyed by their patterns. 0 to disable.
+CONF_Int64(regex_cache_bytes, "33554432");
+
+// Whether to save the pages in the storage page cache into each data dir, and to read them
+// back into the cache in the background after the BE restarts.
+CONF_Bool(enable_page_cache_warm_up, "true");
+// The max number of pages kept to be saved, the pages read into the cache beyond it are not
+// warmed up.
+CONF_Int64(page_cache_warm_up_max_pages, "262144");
+// The interval to save the cached pages, they are also saved when the BE stops.
+CONF_mInt64(page_cache_warm_up_save_interval_sec, "600");
+
+// Whether to collect the null count, the ndv sketch and the quantile sketch of the columns
+// when writing segments, which are merged into the rowset meta.
+CONF_Bool(enable_column_statistics, "true");
+// Whether to report the column statistics of the tablets to FE with the tablet reports.
+CONF_mBool(report_tablet_column_statistics, "false");
+
 } // namespace config
 
 } // namespace doris
@@ -47,6 +47,7 @@ class Tuple;
 class SlotDescriptor;
 class MemPool;
 class FileReader;
+class FileStatisticsFilter;
 
 class ArrowFile : public arrow::io::RandomAccessFile {
 public:
@@ -72,8 +73,10 @@ public:
     ArrowReaderWrap(FileReader* file_reader, int64_t batch_size, int32_t num_of_columns_from_file);
     virtual ~ArrowReaderWrap();
 
+    // The groups(stripes) which can not satisfy `statistics_filter` (nullable) are skipped.
     virtual Status init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
-                               const std::string& timezone) = 0;
+                               const std::string& timezone,
+                               const FileStatisticsFilter* statistics_filter) = 0;
     // for row
     virtual Status read(Tuple* tuple, const std::vector<SlotDescriptor*>& tuple_slot_descs,
                         MemPool* mem_pool, bool* eof) {
@@ -83,6 +86,8 @@ public:
     virtual Status next_batch(std::shared_ptr<arrow::RecordBatch>* batch, bool* eof) = 0;
     virtual void close();
     virtual Status size(int64_t* size) { return Status::NotSupported("Not Implemented size"); }
+    // groups(stripes) skipped by statistics, known after init_reader()
+    int filtered_groups() const { return _filtered_groups; }
 
 protected:
     virtual Status column_indices(const std::vector<SlotDescriptor*>& tuple_slot_descs);
@@ -94,6 +99,7 @@ protected:
     std::shared_ptr<::arrow::RecordBatchReader> _rb_reader;
     int _total_groups;                      // num of groups(stripes) of a parquet(orc) file
     int _current_group;                     // current group(stripe)
+    int _filtered_groups = 0;               // groups(stripes) skipped by statistics
     std::map<std::string, int> _map_column; // column-name <---> column-index
     std::vector<int> _include_column_ids;   // columns that need to get from file
 };
@@ -20,13 +20,84 @@
 #include <arrow/status.h>
 #include <time.h>
 
+#include <orc/OrcFile.hh>
+
 #include "common/logging.h"
+#include "exec/file_statistics_filter.h"
 #include "io/file_reader.h"
 #include "runtime/mem_pool.h"
 #include "runtime/tuple.h"
 
 namespace doris {
 
+// liborc input stream over the ArrowFile of the reader
+class ArrowFileOrcStream : public orc::InputStream {
+public:
+    ArrowFileOrcStream(std::shared_ptr<ArrowFile> file) : _file(std::move(file)) {}
+
+    uint64_t getLength() const override {
+        auto size = _file->GetSize();
+        return size.ok() ? *size : 0;
+    }
+
+    uint64_t getNaturalReadSize() const override { return 128 * 1024; }
+
+    void read(void* buf, uint64_t length, uint64_t offset) override {
+        auto bytes_read = _file->ReadAt(offset, length, buf);
+        if (!bytes_read.ok() || static_cast<uint64_t>(*bytes_read) != length) {
+            throw orc::ParseError("Short read of " + _name);
+        }
+    }
+
+    const std::string& getName() const override { return _name; }
+
+private:
+    std::shared_ptr<ArrowFile> _file;
+    const std::string _name = "orc file";
+};
+
+// The min and max of the column statistics in the domain of the slot, false if unknown.
+static bool orc_statistics_to_fields(const orc::ColumnStatistics* statistics, orc::TypeKind kind,
+                                     PrimitiveType slot_type, vectorized::Field* min,
+                                     vectorized::Field* max) {
+    bool string_slot = slot_type == TYPE_VARCHAR || slot_type == TYPE_STRING;
+    switch (kind) {
+    case orc::BYTE:
+    case orc::SHORT:
+    case orc::INT:
+    case orc::LONG: {
+        auto* typed = dynamic_cast<const orc::IntegerColumnStatistics*>(statistics);
+        if (string_slot || typed == nullptr || !typed->hasMinimum() || !typed->hasMaximum()) {
+            return false;
+        }
+        *min = vectorized::Field(vectorized::Int64(typed->getMinimum()));
+        *max = vectorized::Field(vectorized::Int64(typed->getMaximum()));
+        return true;
+    }
+    case orc::STRING:
+    case orc::VARCHAR: {
+        auto* typed = dynamic_cast<const orc::StringColumnStatistics*>(statistics);
+        if (!string_slot || typed == nullptr || !typed->hasMinimum() || !typed->hasMaximum()) {
+            return false;
+        }
+        *min = vectorized::Field(typed->getMinimum().data(), typed->getMinimum().size());
+        *max = vectorized::Field(typed->getMaximum().data(), typed->getMaximum().size());
+        return true;
+    }
+    case orc::DATE: {
+        auto* typed = dynamic_cast<const orc::DateColumnStatistics*>(statistics);
+        if (!string_slot || typed == nullptr || !typed->hasMinimum() || !typed->hasMaximum()) {
+            return false;
+        }
+        FileStatisticsFilter::date_range_to_strings(typed->getMinimum(), typed->getMaximum(), min,
+                                                    max);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 ORCReaderWrap::ORCReaderWrap(FileReader* file_reader, int64_t batch_size,
                              int32_t num_of_columns_from_file)
         : ArrowReaderWrap(file_reader, batch_size, num_of_columns_from_file) {
@@ -35,7 +106,8 @@ ORCReaderWrap::ORCReaderWrap(FileReader* file_reader, int64_t batch_size,
 }
 
 Status ORCReaderWrap::init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
-                                  const std::string& timezone) {
+                                  const std::string& timezone,
+                                  const FileStatisticsFilter* statistics_filter) {
     // Open ORC file reader
     auto maybe_reader =
             arrow::adapters::orc::ORCFileReader::Open(_arrow_file, arrow::default_memory_pool());
@@ -62,21 +134,89 @@ Status ORCReaderWrap::init_reader(const std::vector<SlotDescriptor*>& tuple_slot
         _map_column.emplace(schema->field(i)->name(), i);
     }
 
+    RETURN_IF_ERROR(column_indices(tuple_slot_descs));
+    if (statistics_filter != nullptr && !statistics_filter->empty()) {
+        RETURN_IF_ERROR(_init_stripes(*statistics_filter));
+    } else {
+        for (int i = 0; i < _total_groups; ++i) {
+            _stripes.push_back(i);
+        }
+    }
+
     bool eof = false;
     RETURN_IF_ERROR(_next_stripe_reader(&eof));
     if (eof) {
         return Status::EndOfFile("end of file");
     }
+    return Status::OK();
+}
 
-    RETURN_IF_ERROR(column_indices(tuple_slot_descs));
+Status ORCReaderWrap::_init_stripes(const FileStatisticsFilter& statistics_filter) {
+    try {
+        std::unique_ptr<orc::InputStream> stream(new ArrowFileOrcStream(_arrow_file));
+        auto reader = orc::createReader(std::move(stream), orc::ReaderOptions());
+        const auto& type = reader->getType();
+        int64_t first_row = 0;
+        for (int i = 0; i < _total_groups; ++i) {
+            _stripe_first_rows.push_back(first_row);
+            first_row += reader->getStripe(i)->getNumberOfRows();
+
+            auto stripe_statistics = reader->getStripeStatistics(i);
+            bool skip = false;
+            for (const auto& predicate : statistics_filter.predicates()) {
+                const auto* column_type = type.getSubtype(_include_column_ids[predicate.position]);
+                const auto* statistics =
+                        stripe_statistics->getColumnStatistics(column_type->getColumnId());
+                if (statistics == nullptr) {
+                    continue;
+                }
+                // all values are null, which no comparison is true for
+                if (statistics->getNumberOfValues() == 0 && statistics->hasNull()) {
+                    skip = true;
+                    break;
+                }
+                vectorized::Field min;
+                vectorized::Field max;
+                if (orc_statistics_to_fields(statistics, column_type->getKind(),
+                                             statistics_filter.slot_type(predicate.position), &min,
+                                             &max) &&
+                    FileStatisticsFilter::can_skip(predicate, min, max)) {
+                    skip = true;
+                    break;
+                }
+            }
+            if (skip) {
+                ++_filtered_groups;
+            } else {
+                _stripes.push_back(i);
+            }
+        }
+    } catch (std::exception& e) {
+        // read all stripes if the statistics are not readable
+        LOG(WARNING) << "failed to read orc stripe statistics: " << e.what();
+        _filtered_groups = 0;
+        _stripes.clear();
+        for (int i = 0; i < _total_groups; ++i) {
+            _stripes.push_back(i);
+        }
+        _stripe_first_rows.clear();
+    }
     return Status::OK();
 }
 
 Status ORCReaderWrap::_next_stripe_reader(bool* eof) {
-    if (_current_group >= _total_groups) {
+    if (_current_group >= _stripes.size()) {
         *eof = true;
         return Status::OK();
     }
+    if (_filtered_groups > 0) {
+        // move to the first row of the stripe, NextStripeReader reads from there to its end
+        auto st = _reader->Seek(_stripe_first_rows[_stripes[_current_group]]);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to seek orc stripe, errmsg=" << st;
+            return Status::InternalError(st.ToString());
+        }
+    }
     // Get a stripe level record batch iterator.
     // record batch will have up to batch_size rows.
     // NextStripeReader serves as a fine grained alternative to ReadStripe
@@ -24,6 +24,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "common/status.h"
 #include "exec/arrow/arrow_reader.h"
@@ -36,16 +37,24 @@ public:
     ~ORCReaderWrap() override = default;
 
     Status init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
-                       const std::string& timezone) override;
+                       const std::string& timezone,
+                       const FileStatisticsFilter* statistics_filter) override;
     Status next_batch(std::shared_ptr<arrow::RecordBatch>* batch, bool* eof) override;
 
 private:
     Status _next_stripe_reader(bool* eof);
+    // Select the stripes to read by the stripe statistics, which are read by liborc since
+    // the arrow adapter does not expose them.
+    Status _init_stripes(const FileStatisticsFilter& statistics_filter);
 
 private:
     // orc file reader object
     std::unique_ptr<arrow::adapters::orc::ORCFileReader> _reader;
     bool _cur_file_eof; // is read over?
+    // the stripes to read, which are not skipped by statistics
+    std::vector<int> _stripes;
+    // the row numbers of the first rows of all stripes
+    std::vector<int64_t> _stripe_first_rows;
 };
 
 } // namespace doris
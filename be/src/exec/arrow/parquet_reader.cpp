@@ -27,6 +27,7 @@
 
 #include "common/logging.h"
 #include "common/status.h"
+#include "exec/file_statistics_filter.h"
 #include "io/file_reader.h"
 #include "runtime/descriptors.h"
 #include "runtime/mem_pool.h"
@@ -35,6 +36,81 @@
 
 namespace doris {
 
+bool filter_parquet_row_group(const FileStatisticsFilter& filter,
+                              const parquet::RowGroupMetaData& row_group,
+                              const std::vector<int>& column_indices) {
+    for (const auto& predicate : filter.predicates()) {
+        auto chunk = row_group.ColumnChunk(column_indices[predicate.position]);
+        if (!chunk->is_stats_set()) {
+            continue;
+        }
+        auto statistics = chunk->statistics();
+        if (statistics == nullptr) {
+            continue;
+        }
+        if (!statistics->HasMinMax()) {
+            // all values are null, which no comparison is true for
+            if (statistics->HasNullCount() && statistics->null_count() == row_group.num_rows()) {
+                return true;
+            }
+            continue;
+        }
+
+        // Only the statistics compare the same way as the values of the src slots, the other
+        // types are converted (e.g. timestamps by time zone) before cast to the slot types.
+        const auto* descr = chunk->descr();
+        const auto& logical_type = descr->logical_type();
+        bool string_slot = filter.slot_type(predicate.position) == TYPE_VARCHAR ||
+                           filter.slot_type(predicate.position) == TYPE_STRING;
+        bool signed_int = logical_type->is_none() ||
+                          (logical_type->is_int() &&
+                           static_cast<const parquet::IntLogicalType&>(*logical_type).is_signed());
+        vectorized::Field min;
+        vectorized::Field max;
+        switch (descr->physical_type()) {
+        case parquet::Type::INT32: {
+            auto typed = std::static_pointer_cast<parquet::Int32Statistics>(statistics);
+            if (string_slot && logical_type->is_date()) {
+                FileStatisticsFilter::date_range_to_strings(typed->min(), typed->max(), &min,
+                                                            &max);
+            } else if (!string_slot && signed_int) {
+                min = vectorized::Field(vectorized::Int64(typed->min()));
+                max = vectorized::Field(vectorized::Int64(typed->max()));
+            } else {
+                continue;
+            }
+            break;
+        }
+        case parquet::Type::INT64: {
+            if (string_slot || !signed_int) {
+                continue;
+            }
+            auto typed = std::static_pointer_cast<parquet::Int64Statistics>(statistics);
+            min = vectorized::Field(vectorized::Int64(typed->min()));
+            max = vectorized::Field(vectorized::Int64(typed->max()));
+            break;
+        }
+        case parquet::Type::BYTE_ARRAY: {
+            if (!string_slot || !(logical_type->is_none() || logical_type->is_string())) {
+                continue;
+            }
+            auto typed = std::static_pointer_cast<parquet::ByteArrayStatistics>(statistics);
+            min = vectorized::Field(reinterpret_cast<const char*>(typed->min().ptr),
+                                    typed->min().len);
+            max = vectorized::Field(reinterpret_cast<const char*>(typed->max().ptr),
+                                    typed->max().len);
+            break;
+        }
+        default:
+            continue;
+        }
+        if (FileStatisticsFilter::can_skip(predicate, min, max)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Broker
 
 ParquetReaderWrap::ParquetReaderWrap(FileReader* file_reader, int64_t batch_size,
@@ -45,7 +121,8 @@ ParquetReaderWrap::ParquetReaderWrap(FileReader* file_reader, int64_t batch_size
           _current_line_of_batch(0) {}
 
 Status ParquetReaderWrap::init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
-                                      const std::string& timezone) {
+                                      const std::string& timezone,
+                                      const FileStatisticsFilter* statistics_filter) {
     try {
         parquet::ArrowReaderProperties arrow_reader_properties =
                 parquet::default_arrow_reader_properties();
@@ -75,7 +152,6 @@ Status ParquetReaderWrap::init_reader(const std::vector<SlotDescriptor*>& tuple_
         if (_total_groups == 0) {
             return Status::EndOfFile("Empty Parquet File");
         }
-        _rows_of_group = _file_metadata->RowGroup(0)->num_rows();
 
         // map
         auto* schemaDescriptor = _file_metadata->schema();
@@ -92,6 +168,20 @@ Status ParquetReaderWrap::init_reader(const std::vector<SlotDescriptor*>& tuple_
 
         RETURN_IF_ERROR(column_indices(tuple_slot_descs));
 
+        for (int i = 0; i < _total_groups; ++i) {
+            if (statistics_filter != nullptr && !statistics_filter->empty() &&
+                filter_parquet_row_group(*statistics_filter, *_file_metadata->RowGroup(i),
+                                         _include_column_ids)) {
+                ++_filtered_groups;
+            } else {
+                _row_groups.push_back(i);
+            }
+        }
+        if (_row_groups.empty()) {
+            return Status::EndOfFile("All row groups are filtered");
+        }
+        _rows_of_group = _file_metadata->RowGroup(_row_groups[0])->num_rows();
+
         std::thread thread(&ParquetReaderWrap::prefetch_batch, this);
         thread.detach();
 
@@ -163,13 +253,13 @@ Status ParquetReaderWrap::read_record_batch(bool* eof) {
                    << " is larger than rows group size:" << _rows_of_group
                    << ". start to read next row group";
         _current_group++;
-        if (_current_group >= _total_groups) { // read completed.
+        if (_current_group >= _row_groups.size()) { // read completed.
             _include_column_ids.clear();
             *eof = true;
             return Status::OK();
         }
         _current_line_of_group = 0;
-        _rows_of_group = _file_metadata->RowGroup(_current_group)
+        _rows_of_group = _file_metadata->RowGroup(_row_groups[_current_group])
                                  ->num_rows(); //get rows of the current row group
         // read batch
         RETURN_IF_ERROR(read_next_batch());
@@ -532,10 +622,11 @@ void ParquetReaderWrap::prefetch_batch() {
     };
     int current_group = 0;
     while (true) {
-        if (_closed || current_group >= _total_groups) {
+        if (_closed || current_group >= _row_groups.size()) {
             return;
         }
-        _status = _reader->GetRecordBatchReader({current_group}, _include_column_ids, &_rb_reader);
+        _status = _reader->GetRecordBatchReader({_row_groups[current_group]}, _include_column_ids,
+                                                &_rb_reader);
         if (!_status.ok()) {
             _closed = true;
             return;
@@ -55,6 +55,13 @@ class Tuple;
 class SlotDescriptor;
 class MemPool;
 class FileReader;
+class FileStatisticsFilter;
+
+// True if the statistics of `row_group` can not satisfy `filter`. `column_indices` are the
+// indices of the parquet columns of the file slots.
+bool filter_parquet_row_group(const FileStatisticsFilter& filter,
+                              const parquet::RowGroupMetaData& row_group,
+                              const std::vector<int>& column_indices);
 
 // Reader of parquet file
 class ParquetReaderWrap final : public ArrowReaderWrap {
@@ -69,7 +76,8 @@ public:
                 MemPool* mem_pool, bool* eof) override;
     Status size(int64_t* size) override;
     Status init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
-                       const std::string& timezone) override;
+                       const std::string& timezone,
+                       const FileStatisticsFilter* statistics_filter) override;
     Status next_batch(std::shared_ptr<arrow::RecordBatch>* batch, bool* eof) override;
     void close() override;
 
@@ -92,6 +100,8 @@ private:
     std::unique_ptr<parquet::arrow::FileReader> _reader;
     std::shared_ptr<parquet::FileMetaData> _file_metadata;
     std::vector<arrow::Type::type> _parquet_column_type;
+    // the row groups to read, which are not skipped by statistics
+    std::vector<int> _row_groups;
 
     int _rows_of_group; // rows in a group.
     int _current_line_of_group;
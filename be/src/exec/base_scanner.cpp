@@ -61,6 +61,7 @@ BaseScanner::BaseScanner(RuntimeState* state, RuntimeProfile* profile,
           _rows_read_counter(nullptr),
           _read_timer(nullptr),
           _materialize_timer(nullptr),
+          _filtered_row_groups_counter(nullptr),
           _success(false),
           _scanner_eof(false) {
 }
@@ -76,12 +77,14 @@ Status BaseScanner::open() {
     _rows_read_counter = ADD_COUNTER(_profile, "RowsRead", TUnit::UNIT);
     _read_timer = ADD_TIMER(_profile, "TotalRawReadTime(*)");
     _materialize_timer = ADD_TIMER(_profile, "MaterializeTupleTime(*)");
+    _filtered_row_groups_counter = ADD_COUNTER(_profile, "FilteredRowGroups", TUnit::UNIT);
 
     DCHECK(!_ranges.empty());
     const auto& range = _ranges[0];
     _num_of_columns_from_file = range.__isset.num_of_columns_from_file
                                         ? implicit_cast<int>(range.num_of_columns_from_file)
                                         : implicit_cast<int>(_src_slot_descs.size());
+    _statistics_filter.init(_pre_filter_texprs, _src_slot_descs, _num_of_columns_from_file);
 
     // check consistency
     if (range.__isset.num_of_columns_from_file) {
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "common/status.h"
+#include "exec/file_statistics_filter.h"
 #include "exprs/expr.h"
 #include "runtime/tuple.h"
 #include "util/runtime_profile.h"
@@ -122,6 +123,9 @@ protected:
     // and will be converted to `_pre_filter_ctxs` when scanner is open.
     const std::vector<TExpr> _pre_filter_texprs;
     std::vector<ExprContext*> _pre_filter_ctxs;
+    // the comparisons of `_pre_filter_texprs` on file columns, for file readers to skip
+    // row groups (stripes) by statistics
+    FileStatisticsFilter _statistics_filter;
 
     bool _strict_mode;
 
@@ -131,6 +135,7 @@ protected:
     RuntimeProfile::Counter* _rows_read_counter;
     RuntimeProfile::Counter* _read_timer;
     RuntimeProfile::Counter* _materialize_timer;
+    RuntimeProfile::Counter* _filtered_row_groups_counter;
 
     // Used to record whether a row of data is successfully read.
     bool _success = false;
@@ -34,6 +34,7 @@
 #include "vec/exec/vjson_scanner.h"
 #include "vec/exec/vorc_scanner.h"
 #include "vec/exec/vparquet_scanner.h"
+#include "vec/exec/vprotobuf_scanner.h"
 
 namespace doris {
 
@@ -258,6 +259,19 @@ std::unique_ptr<BaseScanner> BrokerScanNode::create_scanner(const TBrokerScanRan
                                    _pre_filter_texprs, counter);
         }
         break;
+    case TFileFormatType::FORMAT_PROTOBUF:
+        // only the vectorized scanner is implemented, BrokerScanner reports the format
+        // as unknown for the row based engine
+        if (_vectorized) {
+            scan = new vectorized::VProtobufScanner(
+                    _runtime_state, runtime_profile(), scan_range.params, scan_range.ranges,
+                    scan_range.broker_addresses, _pre_filter_texprs, counter);
+        } else {
+            scan = new BrokerScanner(_runtime_state, runtime_profile(), scan_range.params,
+                                     scan_range.ranges, scan_range.broker_addresses,
+                                     _pre_filter_texprs, counter);
+        }
+        break;
     default:
         if (_vectorized) {
             scan = new vectorized::VBrokerScanner(
@@ -23,14 +23,17 @@
 #include <iostream>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/consts.h"
 #include "exec/decompressor.h"
+#include "exec/pipelined_decompress_reader.h"
 #include "exec/plain_binary_line_reader.h"
 #include "exec/plain_text_line_reader.h"
 #include "io/file_factory.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/tuple.h"
+#include "util/simd/find_byte.h"
 #include "util/string_util.h"
 #include "util/utf8_check.h"
 
@@ -170,6 +173,9 @@ Status BrokerScanner::create_decompressor(TFileFormatType::type type) {
     case TFileFormatType::FORMAT_CSV_DEFLATE:
         compress_type = CompressType::DEFLATE;
         break;
+    case TFileFormatType::FORMAT_CSV_ZSTD:
+        compress_type = CompressType::ZSTD;
+        break;
     default: {
         std::stringstream ss;
         ss << "Unknown format type, cannot inference compress type, type=" << type;
@@ -208,6 +214,17 @@ Status BrokerScanner::open_line_reader() {
     // create decompressor.
     // _decompressor may be nullptr if this is not a compressed file
     RETURN_IF_ERROR(create_decompressor(range.format_type));
+    if (_cur_decompressor != nullptr && config::enable_pipelined_decompression) {
+        // decompress in a separate thread, the line reader reads the decompressed chunks
+        auto reader = std::make_shared<PipelinedDecompressReader>(
+                _cur_file_reader, _cur_decompressor,
+                config::pipelined_decompression_max_buffered_chunks);
+        _cur_decompressor = nullptr;
+        RETURN_IF_ERROR(reader->open());
+        _cur_file_reader = std::move(reader);
+        // the range size is the size of the compressed data
+        size = -1;
+    }
 
     _file_format_type = range.format_type;
     // open line reader
@@ -218,6 +235,7 @@ Status BrokerScanner::open_line_reader() {
     case TFileFormatType::FORMAT_CSV_LZ4FRAME:
     case TFileFormatType::FORMAT_CSV_LZOP:
     case TFileFormatType::FORMAT_CSV_DEFLATE:
+    case TFileFormatType::FORMAT_CSV_ZSTD:
         _cur_line_reader =
                 new PlainTextLineReader(_profile, _cur_file_reader.get(), _cur_decompressor, size,
                                         _line_delimiter, _line_delimiter_length);
@@ -263,6 +281,25 @@ void BrokerScanner::split_line(const Slice& line) {
         }
         delete row;
         delete[] ptr;
+    } else if (_value_separator_length == 1) {
+        // Find all the separators of the line at once, and cut the values by their positions.
+        _separator_positions.clear();
+        simd::find_all_bytes(reinterpret_cast<const uint8_t*>(line.data), line.size,
+                             static_cast<uint8_t>(_value_separator[0]), &_separator_positions);
+        bool trim_tailing_spaces = _state->trim_tailing_spaces_for_external_table_query();
+        const char* value = line.data;
+        size_t start = 0;
+        for (size_t i = 0; i <= _separator_positions.size(); ++i) {
+            size_t end = i < _separator_positions.size() ? _separator_positions[i] : line.size;
+            size_t non_space = end;
+            if (trim_tailing_spaces) {
+                while (non_space > start && *(value + non_space - 1) == ' ') {
+                    non_space--;
+                }
+            }
+            _split_values.emplace_back(value + start, non_space - start);
+            start = end + 1;
+        }
     } else {
         const char* value = line.data;
         size_t start = 0;     // point to the start pos of next col value.
@@ -117,6 +117,8 @@ protected:
     int _skip_lines;
 
     std::vector<Slice> _split_values;
+    // positions of the single byte column separator in the current line
+    std::vector<uint32_t> _separator_positions;
 };
 
 } // namespace doris
@@ -36,6 +36,7 @@
 #include "runtime/runtime_state.h"
 #include "vec/sink/result_sink.h"
 #include "vec/sink/vdata_stream_sender.h"
+#include "vec/sink/vmemory_scratch_sink.h"
 #include "vec/sink/vmysql_table_sink.h"
 #include "vec/sink/vresult_file_sink.h"
 #include "vec/sink/vtablet_sink.h"
@@ -128,7 +129,13 @@ Status DataSink::create_data_sink(ObjectPool* pool, const TDataSink& thrift_sink
             return Status::InternalError("Missing data buffer sink.");
         }
 
-        tmp_sink = new MemoryScratchSink(row_desc, output_exprs, thrift_sink.memory_scratch_sink);
+        if (is_vec) {
+            tmp_sink = new doris::vectorized::VMemoryScratchSink(
+                    row_desc, output_exprs, thrift_sink.memory_scratch_sink);
+        } else {
+            tmp_sink =
+                    new MemoryScratchSink(row_desc, output_exprs, thrift_sink.memory_scratch_sink);
+        }
         sink->reset(tmp_sink);
         break;
     }
@@ -65,6 +65,10 @@ public:
     virtual Status send(RuntimeState* state, vectorized::Block* block) {
         return Status::NotSupported("Not support send block");
     };
+
+    // Whether send() of a block returns without waiting for the receivers, pipelines park
+    // the task instead of calling send() if it's false.
+    virtual bool can_write() { return true; }
     // Releases all resources that were allocated in prepare()/send().
     // Further send() calls are illegal after calling close().
     // It must be okay to call this multiple times. Subsequent calls should
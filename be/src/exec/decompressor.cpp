@@ -36,6 +36,9 @@ Status Decompressor::create_decompressor(CompressType type, Decompressor** decom
     case CompressType::LZ4FRAME:
         *decompressor = new Lz4FrameDecompressor();
         break;
+    case CompressType::ZSTD:
+        *decompressor = new ZstdDecompressor();
+        break;
 #ifdef DORIS_WITH_LZO
     case CompressType::LZOP:
         *decompressor = new LzopDecompressor();
@@ -337,4 +340,53 @@ size_t Lz4FrameDecompressor::get_block_size(const LZ4F_frameInfo_t* info) {
     }
 }
 
+// Zstd
+ZstdDecompressor::~ZstdDecompressor() {
+    if (_dstream != nullptr) {
+        ZSTD_freeDStream(_dstream);
+    }
+}
+
+Status ZstdDecompressor::init() {
+    _dstream = ZSTD_createDStream();
+    if (_dstream == nullptr) {
+        return Status::InternalError("failed to create zstd decompress stream");
+    }
+    size_t ret = ZSTD_initDStream(_dstream);
+    if (ZSTD_isError(ret)) {
+        return Status::InternalError(
+                fmt::format("failed to init zstd decompress stream: {}", ZSTD_getErrorName(ret)));
+    }
+    return Status::OK();
+}
+
+Status ZstdDecompressor::decompress(uint8_t* input, size_t input_len, size_t* input_bytes_read,
+                                    uint8_t* output, size_t output_max_len,
+                                    size_t* decompressed_len, bool* stream_end,
+                                    size_t* more_input_bytes, size_t* more_output_bytes) {
+    ZSTD_inBuffer in_buf = {input, input_len, 0};
+    ZSTD_outBuffer out_buf = {output, output_max_len, 0};
+    // the frames of the file are decompressed one after another by the same stream
+    size_t ret = ZSTD_decompressStream(_dstream, &out_buf, &in_buf);
+    if (ZSTD_isError(ret)) {
+        return Status::InternalError(
+                fmt::format("zstd decompress failed: {}", ZSTD_getErrorName(ret)));
+    }
+    *input_bytes_read = in_buf.pos;
+    *decompressed_len = out_buf.pos;
+    // 0 means a frame is completely decoded and flushed
+    *stream_end = ret == 0;
+    *more_input_bytes = 0;
+    *more_output_bytes = 0;
+    if (in_buf.pos == 0 && !*stream_end) {
+        // the output buf is full of the flushed data, ask for a larger one to make progress
+        *more_output_bytes = ZSTD_DStreamOutSize();
+    }
+    return Status::OK();
+}
+
+std::string ZstdDecompressor::debug_info() {
+    return "ZstdDecompressor";
+}
+
 } // namespace doris
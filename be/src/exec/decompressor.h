@@ -20,6 +20,7 @@
 #include <bzlib.h>
 #include <lz4/lz4frame.h>
 #include <zlib.h>
+#include <zstd.h>
 
 #ifdef DORIS_WITH_LZO
 #include <lzo/lzo1x.h>
@@ -30,7 +31,7 @@
 
 namespace doris {
 
-enum CompressType { UNCOMPRESSED, GZIP, DEFLATE, BZIP2, LZ4FRAME, LZOP };
+enum CompressType { UNCOMPRESSED, GZIP, DEFLATE, BZIP2, LZ4FRAME, LZOP, ZSTD };
 
 class Decompressor {
 public:
@@ -136,6 +137,25 @@ private:
     const static unsigned DORIS_LZ4F_VERSION;
 };
 
+class ZstdDecompressor : public Decompressor {
+public:
+    ~ZstdDecompressor() override;
+
+    Status decompress(uint8_t* input, size_t input_len, size_t* input_bytes_read, uint8_t* output,
+                      size_t output_max_len, size_t* decompressed_len, bool* stream_end,
+                      size_t* more_input_bytes, size_t* more_output_bytes) override;
+
+    std::string debug_info() override;
+
+private:
+    friend class Decompressor;
+    ZstdDecompressor() : Decompressor(CompressType::ZSTD) {}
+    Status init() override;
+
+private:
+    ZSTD_DStream* _dstream = nullptr;
+};
+
 #ifdef DORIS_WITH_LZO
 class LzopDecompressor : public Decompressor {
 public:
@@ -280,17 +280,19 @@ Status ScrollParser::parse(const std::string& scroll_result, bool exactly_once)
         _scroll_id = scroll_node.GetString();
     }
     // { hits: { total : 2, "hits" : [ {}, {}, {} ]}}
-    const rapidjson::Value& outer_hits_node = _document_node[FIELD_HITS];
+    rapidjson::Value& outer_hits_node = _document_node[FIELD_HITS];
     // if has no inner hits, there has no data in this index
     if (!outer_hits_node.HasMember(FIELD_INNER_HITS)) {
         return Status::OK();
     }
-    const rapidjson::Value& inner_hits_node = outer_hits_node[FIELD_INNER_HITS];
+    rapidjson::Value& inner_hits_node = outer_hits_node[FIELD_INNER_HITS];
     // this happened just the end of scrolling
     if (!inner_hits_node.IsArray()) {
         return Status::OK();
     }
-    _inner_hits_node.CopyFrom(inner_hits_node, _document_node.GetAllocator());
+    // take the hits out of the document instead of copying them, they are still owned by the
+    // allocator of _document_node
+    _inner_hits_node.Swap(inner_hits_node);
     // how many documents contains in this batch
     _size = _inner_hits_node.Size();
     return Status::OK();
@@ -304,6 +306,19 @@ const std::string& ScrollParser::get_scroll_id() {
     return _scroll_id;
 }
 
+const char* ScrollParser::_docvalue_col_name(
+        int slot_idx, const SlotDescriptor* slot_desc,
+        const std::map<std::string, std::string>& docvalue_context) {
+    if (_docvalue_col_names.size() <= (size_t)slot_idx) {
+        _docvalue_col_names.resize(slot_idx + 1, nullptr);
+    }
+    if (_docvalue_col_names[slot_idx] == nullptr) {
+        // if pure_doc_value enabled, docvalue_context must contains the key
+        _docvalue_col_names[slot_idx] = docvalue_context.at(slot_desc->col_name()).c_str();
+    }
+    return _docvalue_col_names[slot_idx];
+}
+
 Status ScrollParser::fill_tuple(const TupleDescriptor* tuple_desc, Tuple* tuple,
                                 MemPool* tuple_pool, bool* line_eof,
                                 const std::map<std::string, std::string>& docvalue_context) {
@@ -378,7 +393,7 @@ Status ScrollParser::fill_tuple(const TupleDescriptor* tuple_desc, Tuple* tuple,
         }
 
         tuple->set_not_null(slot_desc->null_indicator_offset());
-        const rapidjson::Value& col = line[col_name];
+        const rapidjson::Value& col = itr->value;
 
         void* slot = tuple->get_slot(slot_desc->tuple_offset());
         PrimitiveType type = slot_desc->type().type;
@@ -617,7 +632,7 @@ Status ScrollParser::fill_columns(const TupleDescriptor* tuple_desc,
             continue;
         }
 
-        const char* col_name = pure_doc_value ? docvalue_context.at(slot_desc->col_name()).c_str()
+        const char* col_name = pure_doc_value ? _docvalue_col_name(i, slot_desc, docvalue_context)
                                               : slot_desc->col_name().c_str();
 
         rapidjson::Value::ConstMemberIterator itr = line.FindMember(col_name);
@@ -630,7 +645,7 @@ Status ScrollParser::fill_columns(const TupleDescriptor* tuple_desc,
             return Status::RuntimeError(details);
         }
 
-        const rapidjson::Value& col = line[col_name];
+        const rapidjson::Value& col = itr->value;
 
         PrimitiveType type = slot_desc->type().type;
 
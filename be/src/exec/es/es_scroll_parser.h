@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "rapidjson/document.h"
 #include "runtime/descriptors.h"
@@ -44,6 +46,11 @@ public:
     int get_size();
 
 private:
+    // The docvalue field name of the slot, which is looked up in docvalue_context once for
+    // all the hits of the batch.
+    const char* _docvalue_col_name(int slot_idx, const SlotDescriptor* slot_desc,
+                                   const std::map<std::string, std::string>& docvalue_context);
+
     // helper method for processing date/datetime cols with rapidjson::Value
     // type is used for distinguish date and datetime
     // fill date slot with string format date
@@ -63,6 +70,8 @@ private:
 
     rapidjson::Document _document_node;
     rapidjson::Value _inner_hits_node;
+    // indexed by the slot index, see _docvalue_col_name
+    std::vector<const char*> _docvalue_col_names;
 
     // todo(milimin): ScrollParser should be divided into two classes: SourceParser and DocValueParser,
     // including remove some variables in the current implementation, e.g. pure_doc_value.
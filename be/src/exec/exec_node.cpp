@@ -25,6 +25,7 @@
 
 #include <sstream>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/analytic_eval_node.h"
@@ -61,6 +62,7 @@
 #include "util/runtime_profile.h"
 #include "vec/core/block.h"
 #include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/join/vmerge_join_node.h"
 #include "vec/exec/vaggregation_node.h"
 #include "vec/exec/vanalytic_eval_node.h"
 #include "vec/exec/vassert_num_rows_node.h"
@@ -201,6 +203,9 @@ Status ExecNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::PREPARE));
     DCHECK(_runtime_profile.get() != nullptr);
     _rows_returned_counter = ADD_COUNTER(_runtime_profile, "RowsReturned", TUnit::UNIT);
+    if (config::enable_exec_node_perf_counters) {
+        _perf_counters.reset(new ProfilePerfCounters(_runtime_profile.get()));
+    }
     _rows_returned_rate = runtime_profile()->add_derived_counter(
             ROW_THROUGHPUT_COUNTER, TUnit::UNIT_PER_SECOND,
             std::bind<int64_t>(&RuntimeProfile::units_per_second, _rows_returned_counter,
@@ -374,6 +379,7 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         case TPlanNodeType::OLAP_SCAN_NODE:
         case TPlanNodeType::ASSERT_NUM_ROWS_NODE:
         case TPlanNodeType::HASH_JOIN_NODE:
+        case TPlanNodeType::MERGE_JOIN_NODE:
         case TPlanNodeType::AGGREGATION_NODE:
         case TPlanNodeType::UNION_NODE:
         case TPlanNodeType::CROSS_JOIN_NODE:
@@ -465,6 +471,15 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         }
         return Status::OK();
 
+    case TPlanNodeType::MERGE_JOIN_NODE:
+        if (state->enable_vectorized_exec()) {
+            *node = pool->add(new vectorized::VMergeJoinNode(pool, tnode, descs));
+        } else {
+            error_msg << "Merge join is only supported by the vectorized engine";
+            return Status::InternalError(error_msg.str());
+        }
+        return Status::OK();
+
     case TPlanNodeType::CROSS_JOIN_NODE:
         if (state->enable_vectorized_exec()) {
             *node = pool->add(new vectorized::VCrossJoinNode(pool, tnode, descs));
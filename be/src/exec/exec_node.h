@@ -31,6 +31,7 @@
 #include "runtime/query_statistics.h"
 #include "service/backend_options.h"
 #include "util/blocking_queue.hpp"
+#include "util/perf_counters.h"
 #include "util/runtime_profile.h"
 #include "vec/exprs/vexpr_context.h"
 
@@ -104,6 +105,26 @@ public:
     virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos);
     virtual Status get_next(RuntimeState* state, vectorized::Block* block, bool* eos);
 
+    // The interfaces below are used by the pipeline execution (see
+    // pipeline/pipeline_fragment_context.h), which drives the nodes by their operators
+    // instead of get_next() of the children.
+    // Performs the work of open() but doesn't open or read the children.
+    virtual Status open_self(RuntimeState* state) { return ExecNode::open(state); }
+    // A node breaking the pipelines consumes all the blocks of its child by sink() before
+    // its results are read by get_next(). eos is true for the last block.
+    virtual Status sink(RuntimeState* state, vectorized::Block* block, bool eos) {
+        return Status::NotSupported("Not Implemented sink");
+    }
+    // A streaming node processes a block of its child by push(), and returns the results
+    // by pull() until need_more_input_data(), eos of push() is true for the last block.
+    virtual Status push(RuntimeState* state, vectorized::Block* block, bool eos) {
+        return Status::NotSupported("Not Implemented push");
+    }
+    virtual Status pull(RuntimeState* state, vectorized::Block* block, bool* eos) {
+        return Status::NotSupported("Not Implemented pull");
+    }
+    virtual bool need_more_input_data() const { return true; }
+
     // Resets the stream of row batches to be retrieved by subsequent GetNext() calls.
     // Clears all internal state, returning this node to the state it was in after calling
     // Prepare() and before calling Open(). This function must not clear memory
@@ -187,6 +208,7 @@ public:
     int64_t limit() const { return _limit; }
     bool reached_limit() const { return _limit != -1 && _num_rows_returned >= _limit; }
     const std::vector<TupleId>& get_tuple_ids() const { return _tuple_ids; }
+    const std::vector<ExecNode*>& children() const { return _children; }
 
     RuntimeProfile* runtime_profile() const { return _runtime_profile.get(); }
     RuntimeProfile::Counter* memory_used_counter() const { return _memory_used_counter; }
@@ -306,6 +328,9 @@ protected:
     // MemTracker used by all Expr.
     std::shared_ptr<MemTracker> _expr_mem_tracker;
 
+    // The hardware counters of the node, nullptr unless config::enable_exec_node_perf_counters
+    std::unique_ptr<ProfilePerfCounters> _perf_counters;
+
     RuntimeProfile::Counter* _rows_returned_counter;
     RuntimeProfile::Counter* _rows_returned_rate;
     // Account for peak memory used by this node
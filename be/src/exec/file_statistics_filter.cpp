@@ -0,0 +1,208 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/file_statistics_filter.h"
+
+#include "cctz/civil_time.h"
+#include "runtime/descriptors.h"
+
+namespace doris {
+
+static int subtree_end(const std::vector<TExprNode>& nodes, int index) {
+    int num_children = nodes[index].num_children;
+    ++index;
+    for (int i = 0; i < num_children; ++i) {
+        index = subtree_end(nodes, index);
+    }
+    return index;
+}
+
+static bool is_string_type(PrimitiveType type) {
+    return type == TYPE_VARCHAR || type == TYPE_STRING;
+}
+
+static bool is_integer_type(PrimitiveType type) {
+    return type == TYPE_TINYINT || type == TYPE_SMALLINT || type == TYPE_INT ||
+           type == TYPE_BIGINT;
+}
+
+void FileStatisticsFilter::init(const std::vector<TExpr>& texprs,
+                                const std::vector<SlotDescriptor*>& slot_descs,
+                                int num_of_columns_from_file) {
+    _num_of_columns_from_file = num_of_columns_from_file;
+    _slot_types.clear();
+    for (int i = 0; i < num_of_columns_from_file; ++i) {
+        _slot_types.push_back(slot_descs[i]->type().type);
+    }
+    _predicates.clear();
+    // the pre-filter exprs are in conjunction
+    for (const auto& texpr : texprs) {
+        if (!texpr.nodes.empty()) {
+            _collect(texpr.nodes, 0, slot_descs);
+        }
+    }
+}
+
+int FileStatisticsFilter::_position_of_slot(const TExprNode& node,
+                                            const std::vector<SlotDescriptor*>& slot_descs) const {
+    if (node.node_type != TExprNodeType::SLOT_REF) {
+        return -1;
+    }
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        if (slot_descs[i]->id() == node.slot_ref.slot_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool FileStatisticsFilter::_literal_to_field(const TExprNode& node, PrimitiveType slot_type,
+                                             vectorized::Field* value) {
+    if (is_string_type(slot_type) && node.node_type == TExprNodeType::STRING_LITERAL) {
+        *value = vectorized::Field(node.string_literal.value.data(),
+                                   node.string_literal.value.size());
+        return true;
+    }
+    if (is_integer_type(slot_type) && node.node_type == TExprNodeType::INT_LITERAL) {
+        *value = vectorized::Field(vectorized::Int64(node.int_literal.value));
+        return true;
+    }
+    return false;
+}
+
+int FileStatisticsFilter::_collect(const std::vector<TExprNode>& nodes, int index,
+                                   const std::vector<SlotDescriptor*>& slot_descs) {
+    const auto& node = nodes[index];
+    int end = subtree_end(nodes, index);
+    if (node.node_type == TExprNodeType::COMPOUND_PRED &&
+        node.opcode == TExprOpcode::COMPOUND_AND) {
+        int child = index + 1;
+        for (int i = 0; i < node.num_children; ++i) {
+            child = _collect(nodes, child, slot_descs);
+        }
+        return end;
+    }
+
+    if (node.node_type == TExprNodeType::BINARY_PRED && node.num_children == 2) {
+        TExprOpcode::type op = node.opcode;
+        if (op != TExprOpcode::EQ && op != TExprOpcode::LT && op != TExprOpcode::LE &&
+            op != TExprOpcode::GT && op != TExprOpcode::GE) {
+            return end;
+        }
+        int left = index + 1;
+        int right = subtree_end(nodes, left);
+        int position = _position_of_slot(nodes[left], slot_descs);
+        int literal = right;
+        if (position < 0) {
+            // `literal op column` => `column op' literal`
+            position = _position_of_slot(nodes[right], slot_descs);
+            literal = left;
+            if (op == TExprOpcode::LT) {
+                op = TExprOpcode::GT;
+            } else if (op == TExprOpcode::LE) {
+                op = TExprOpcode::GE;
+            } else if (op == TExprOpcode::GT) {
+                op = TExprOpcode::LT;
+            } else if (op == TExprOpcode::GE) {
+                op = TExprOpcode::LE;
+            }
+        }
+        vectorized::Field value;
+        if (position >= 0 && _literal_to_field(nodes[literal], _slot_types[position], &value)) {
+            _predicates.push_back({position, op, {std::move(value)}});
+        }
+        return end;
+    }
+
+    if (node.node_type == TExprNodeType::IN_PRED && node.opcode == TExprOpcode::FILTER_IN &&
+        node.num_children > 1) {
+        int position = _position_of_slot(nodes[index + 1], slot_descs);
+        if (position < 0) {
+            return end;
+        }
+        Predicate predicate {position, TExprOpcode::EQ, {}};
+        for (int child = subtree_end(nodes, index + 1); child < end;
+             child = subtree_end(nodes, child)) {
+            vectorized::Field value;
+            if (!_literal_to_field(nodes[child], _slot_types[position], &value)) {
+                return end;
+            }
+            predicate.values.push_back(std::move(value));
+        }
+        _predicates.push_back(std::move(predicate));
+    }
+    return end;
+}
+
+bool FileStatisticsFilter::can_skip(const Predicate& predicate, const vectorized::Field& min,
+                                    const vectorized::Field& max) {
+    switch (predicate.op) {
+    case TExprOpcode::EQ:
+        for (const auto& value : predicate.values) {
+            if (!(value < min || max < value)) {
+                return false;
+            }
+        }
+        return true;
+    case TExprOpcode::LT:
+        return !(min < predicate.values[0]);
+    case TExprOpcode::LE:
+        return predicate.values[0] < min;
+    case TExprOpcode::GT:
+        return !(predicate.values[0] < max);
+    case TExprOpcode::GE:
+        return max < predicate.values[0];
+    default:
+        return false;
+    }
+}
+
+void FileStatisticsFilter::date_range_to_strings(int64_t min_days, int64_t max_days,
+                                                 vectorized::Field* min, vectorized::Field* max) {
+    auto to_string = [](int64_t days) {
+        cctz::civil_day day = cctz::civil_day(1970, 1, 1) + days;
+        char buf[16];
+        int len = snprintf(buf, sizeof(buf), "%04d-%02d-%02d", static_cast<int>(day.year()),
+                           day.month(), day.day());
+        return vectorized::Field(buf, len);
+    };
+    *min = to_string(min_days - 1);
+    *max = to_string(max_days + 1);
+}
+
+bool FileStatisticsFilter::date_string_to_days(const std::string& str, int64_t* days) {
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    if (str.size() != 10 || str[4] != '-' || str[7] != '-' ||
+        sscanf(str.c_str(), "%4d-%2d-%2d", &year, &month, &day) != 3) {
+        return false;
+    }
+    for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (!isdigit(str[i])) {
+            return false;
+        }
+    }
+    cctz::civil_day civil_day(year, month, day);
+    if (civil_day.year() != year || civil_day.month() != month || civil_day.day() != day) {
+        return false;
+    }
+    *days = civil_day - cctz::civil_day(1970, 1, 1);
+    return true;
+}
+
+} // namespace doris
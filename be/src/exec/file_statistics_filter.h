@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "gen_cpp/Exprs_types.h"
+#include "runtime/primitive_type.h"
+#include "vec/core/field.h"
+
+namespace doris {
+
+class SlotDescriptor;
+
+// The comparisons between a file column and literals in the pre-filter of a file scan,
+// `column op literal` and `column IN (literals)` in a conjunction, to skip the row groups
+// (stripes) of parquet (orc) files whose min/max statistics can not satisfy them.
+//
+// The values are compared in the domain of the src slots, so only the string and integer
+// slots are used. The readers convert the statistics into this domain, e.g. those of a
+// date column are converted to strings for a string slot.
+class FileStatisticsFilter {
+public:
+    struct Predicate {
+        // of the file slot
+        int position;
+        // EQ, LT, LE, GT or GE as `column op value`, EQ is for IN as well
+        TExprOpcode::type op;
+        std::vector<vectorized::Field> values;
+    };
+
+    FileStatisticsFilter() = default;
+
+    // The file columns are the first `num_of_columns_from_file` of `slot_descs`.
+    void init(const std::vector<TExpr>& texprs, const std::vector<SlotDescriptor*>& slot_descs,
+              int num_of_columns_from_file);
+
+    bool empty() const { return _predicates.empty(); }
+
+    const std::vector<Predicate>& predicates() const { return _predicates; }
+
+    PrimitiveType slot_type(int position) const { return _slot_types[position]; }
+
+    // True if no value in [min, max] of the column of the predicate satisfies it.
+    static bool can_skip(const Predicate& predicate, const vectorized::Field& min,
+                         const vectorized::Field& max);
+
+    // The string values of [min_days - 1, max_days + 1] since epoch, formatted like
+    // 'yyyy-MM-dd'. The dates converted by readers may shift a day by time zone.
+    static void date_range_to_strings(int64_t min_days, int64_t max_days,
+                                      vectorized::Field* min, vectorized::Field* max);
+
+    // The days since epoch of a 'yyyy-MM-dd' string, false if it is not a valid date of
+    // this format, whose order is the same as that of the strings.
+    static bool date_string_to_days(const std::string& str, int64_t* days);
+
+private:
+    // Return the index after the subtree of `index`.
+    int _collect(const std::vector<TExprNode>& nodes, int index,
+                 const std::vector<SlotDescriptor*>& slot_descs);
+    bool _literal_to_field(const TExprNode& node, PrimitiveType slot_type,
+                           vectorized::Field* value);
+    int _position_of_slot(const TExprNode& node,
+                          const std::vector<SlotDescriptor*>& slot_descs) const;
+
+    int _num_of_columns_from_file = 0;
+    std::vector<PrimitiveType> _slot_types;
+    std::vector<Predicate> _predicates;
+};
+
+} // namespace doris
@@ -342,7 +342,10 @@ Status JsonReader::_parse_json_doc(size_t* size, bool* eof) {
     if (*eof) {
         return Status::OK();
     }
+    return _parse_json_str(json_str, *size, eof);
+}
 
+Status JsonReader::_parse_json_str(const uint8_t* json_str, size_t size, bool* eof) {
     bool has_parse_error = false;
     // parse jsondata to JsonDoc
 
@@ -351,10 +354,10 @@ Status JsonReader::_parse_json_doc(size_t* size, bool* eof) {
     if (_num_as_string) {
         has_parse_error =
                 _origin_json_doc
-                        .Parse<rapidjson::kParseNumbersAsStringsFlag>((char*)json_str, *size)
+                        .Parse<rapidjson::kParseNumbersAsStringsFlag>((char*)json_str, size)
                         .HasParseError();
     } else {
-        has_parse_error = _origin_json_doc.Parse((char*)json_str, *size).HasParseError();
+        has_parse_error = _origin_json_doc.Parse((char*)json_str, size).HasParseError();
     }
 
     if (has_parse_error) {
@@ -363,7 +366,7 @@ Status JsonReader::_parse_json_doc(size_t* size, bool* eof) {
                        _origin_json_doc.GetParseError(),
                        rapidjson::GetParseError_En(_origin_json_doc.GetParseError()));
         RETURN_IF_ERROR(_state->append_error_msg_to_file(
-                [&]() -> std::string { return std::string((char*)json_str, *size); },
+                [&]() -> std::string { return std::string((char*)json_str, size); },
                 [&]() -> std::string { return fmt::to_string(error_msg); }, _scanner_eof));
         _counter->num_rows_filtered++;
         if (*_scanner_eof) {
@@ -143,6 +143,8 @@ protected:
     void _fill_slot(Tuple* tuple, SlotDescriptor* slot_desc, MemPool* mem_pool,
                     const uint8_t* value, int32_t len);
     Status _parse_json_doc(size_t* size, bool* eof);
+    // Parse `json_str` into `_origin_json_doc` and locate `_json_doc` by the json root.
+    Status _parse_json_str(const uint8_t* json_str, size_t size, bool* eof);
     Status _set_tuple_value(rapidjson::Value& objectValue, Tuple* tuple,
                             const std::vector<SlotDescriptor*>& slot_descs, MemPool* tuple_pool,
                             bool* valid);
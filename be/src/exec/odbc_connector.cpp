@@ -19,6 +19,7 @@
 
 #include <sqlext.h>
 
+#include <algorithm>
 #include <codecvt>
 
 #include "common/config.h"
@@ -44,6 +45,8 @@ static constexpr uint32_t SMALL_COLUMN_SIZE_BUFFER = 100;
 static constexpr uint32_t BIG_COLUMN_SIZE_BUFFER = 65535;
 // Default max buffer size use in insert to: 50MB, normally a batch is smaller than the size
 static constexpr uint32_t INSERT_BUFFER_SIZE = 1024l * 1024 * 50;
+// Max size of the buffers the result columns are bound to when fetching arrays of rows: 32MB
+static constexpr uint32_t FETCH_BUFFER_SIZE = 1024l * 1024 * 32;
 
 static std::u16string utf8_to_wstring(const std::string& str) {
     std::wstring_convert<std::codecvt_utf8<char16_t>, char16_t> utf8_ucs2_cvt;
@@ -56,6 +59,7 @@ ODBCConnector::ODBCConnector(const ODBCConnectorParam& param)
         : _connect_string(param.connect_string),
           _sql_str(param.query_string),
           _tuple_desc(param.tuple_desc),
+          _max_row_array_size(std::max<size_t>(1, param.max_row_array_size)),
           _output_expr_ctxs(param.output_expr_ctxs),
           _is_open(false),
           _field_num(0),
@@ -145,7 +149,7 @@ Status ODBCConnector::query() {
         return Status::InternalError("input and output not equal.");
     }
 
-    // allocate memory for the binding
+    size_t row_size = 0;
     for (int i = 0; i < _field_num; i++) {
         DataBinding* column_data = new DataBinding;
         column_data->target_type = SQL_C_CHAR;
@@ -154,16 +158,45 @@ Status ODBCConnector::query() {
                                       type == TYPE_VARCHAR || type == TYPE_STRING)
                                              ? BIG_COLUMN_SIZE_BUFFER
                                              : SMALL_COLUMN_SIZE_BUFFER;
-        column_data->target_value_ptr = malloc(sizeof(char) * column_data->buffer_length);
+        row_size += column_data->buffer_length;
         _columns_data.emplace_back(column_data);
     }
 
+    // Fetch the rows in arrays bound column by column, to save the calls of SQLFetch.
+    // The driver may change the array size, which is read back.
+    size_t buffered_rows = FETCH_BUFFER_SIZE / std::max<size_t>(1, row_size);
+    _row_array_size = std::min(_max_row_array_size, std::max<size_t>(1, buffered_rows));
+    if (_row_array_size > 1) {
+        ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
+                     SQLSetStmtAttr(_stmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN,
+                                    0),
+                     "set row bind type");
+        ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
+                     SQLSetStmtAttr(_stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)_row_array_size,
+                                    0),
+                     "set row array size");
+        ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
+                     SQLGetStmtAttr(_stmt, SQL_ATTR_ROW_ARRAY_SIZE, &_row_array_size, 0, nullptr),
+                     "get row array size");
+        ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
+                     SQLSetStmtAttr(_stmt, SQL_ATTR_ROWS_FETCHED_PTR, &_rows_fetched, 0),
+                     "set rows fetched ptr");
+        LOG(INFO) << "fetch " << _row_array_size << " rows at a time for " << _sql_str;
+    }
+
+    // allocate memory for the binding
+    for (auto& column_data : _columns_data) {
+        column_data->target_value_ptr =
+                malloc(sizeof(char) * column_data->buffer_length * _row_array_size);
+        column_data->strlen_or_ind.reset(new SQLLEN[_row_array_size]);
+    }
+
     // setup the binding
     for (int i = 0; i < _field_num; i++) {
         ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
                      SQLBindCol(_stmt, (SQLUSMALLINT)i + 1, _columns_data[i]->target_type,
                                 _columns_data[i]->target_value_ptr, _columns_data[i]->buffer_length,
-                                &(_columns_data[i]->strlen_or_ind)),
+                                _columns_data[i]->strlen_or_ind.get()),
                      "bind col");
     }
 
@@ -186,6 +219,26 @@ Status ODBCConnector::get_next_row(bool* eos) {
     return Status::OK();
 }
 
+Status ODBCConnector::get_next_rows(size_t* num_rows, bool* eos) {
+    if (!_is_open) {
+        return Status::InternalError("GetNextRows before open.");
+    }
+
+    *num_rows = 0;
+    _rows_fetched = 0;
+    auto ret = SQLFetch(_stmt);
+    if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) {
+        // the fetched rows are only counted by the driver when fetching arrays
+        *num_rows = _row_array_size > 1 ? _rows_fetched : 1;
+        return Status::OK();
+    } else if (ret != SQL_NO_DATA_FOUND) {
+        return error_status("result fetch", handle_diagnostic_record(_stmt, SQL_HANDLE_STMT, ret));
+    }
+
+    *eos = true;
+    return Status::OK();
+}
+
 void ODBCConnector::_init_profile(doris::RuntimeProfile* profile) {
     _convert_tuple_timer = ADD_TIMER(profile, "TupleConvertTime");
     _result_send_timer = ADD_TIMER(profile, "ResultSendTime");
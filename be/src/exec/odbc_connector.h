@@ -22,6 +22,7 @@
 
 #include <boost/format.hpp>
 #include <cstdlib>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,9 @@ struct ODBCConnectorParam {
     // only use in query
     std::string query_string;
     const TupleDescriptor* tuple_desc;
+    // The max number of rows fetched by one SQLFetch, the result columns are bound as arrays
+    // of so many rows. It is limited by the memory of the bound buffers.
+    size_t max_row_array_size = 1;
 
     // only use in write
     std::vector<ExprContext*> output_expr_ctxs;
@@ -48,11 +52,18 @@ struct ODBCConnectorParam {
 struct DataBinding {
     SQLSMALLINT target_type;
     SQLINTEGER buffer_length;
-    SQLLEN strlen_or_ind;
-    SQLPOINTER target_value_ptr;
+    // the length of the value or SQL_NULL_DATA for each row of the fetched array
+    std::unique_ptr<SQLLEN[]> strlen_or_ind;
+    // the values of the fetched rows, buffer_length bytes for each row
+    SQLPOINTER target_value_ptr = nullptr;
 
     DataBinding() = default;
 
+    char* value(size_t row) const {
+        return static_cast<char*>(target_value_ptr) + row * buffer_length;
+    }
+    SQLLEN length(size_t row) const { return strlen_or_ind[row]; }
+
     ~DataBinding() { free(target_value_ptr); }
     DataBinding(const DataBinding&) = delete;
     DataBinding& operator=(const DataBinding&) = delete;
@@ -68,6 +79,8 @@ public:
     // query for ODBC table
     Status query();
     Status get_next_row(bool* eos);
+    // fetch the next array of rows, the values of row i are at DataBinding::value(i)
+    Status get_next_rows(size_t* num_rows, bool* eos);
 
     // write for ODBC table
     Status init_to_write(RuntimeProfile* profile);
@@ -93,6 +106,9 @@ private:
     // only use in query
     std::string _sql_str;
     const TupleDescriptor* _tuple_desc;
+    size_t _max_row_array_size;
+    SQLULEN _row_array_size = 1;
+    SQLULEN _rows_fetched = 0;
 
     // only use in write
     const std::vector<ExprContext*> _output_expr_ctxs;
@@ -37,9 +37,11 @@
 #include "runtime/runtime_state.h"
 #include "runtime/string_value.h"
 #include "runtime/tuple_row.h"
+#include "util/doris_metrics.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/runtime_profile.h"
 #include "util/thread.h"
+#include "util/time.h"
 #include "util/to_string.h"
 
 namespace doris {
@@ -821,9 +823,21 @@ Status OlapScanNode::start_scan_thread(RuntimeState* state) {
             LOG(WARNING) << ss.str();
             return Status::InternalError(ss.str());
         }
+        // Avoid too many scanners for small tablets, one scanner is used for every
+        // doris_scan_range_max_mb bytes of the tablet.
+        int size_based_scanners_per_tablet = 1;
+        if (config::doris_scan_range_max_mb > 0) {
+            size_based_scanners_per_tablet = (int)std::max<int64_t>(
+                    1, tablet->tablet_footprint() / ((int64_t)config::doris_scan_range_max_mb << 20));
+        }
+        int num_scanners = std::min(scanners_per_tablet, size_based_scanners_per_tablet);
+
         std::vector<std::unique_ptr<OlapScanRange>>* ranges = &cond_ranges;
         std::vector<std::unique_ptr<OlapScanRange>> split_ranges;
-        if (need_split && !tablet->all_beta()) {
+        // Beta rowsets are split on the short key indexes of the segments, which have to be
+        // loaded, so only split them if the tablet is scanned by more than one scanner.
+        // The split ranges never overlap, so it's ok for the tablets of all keys types.
+        if (need_split && (!tablet->all_beta() || num_scanners > 1)) {
             auto st = get_hints(tablet, *scan_range, config::doris_scan_range_row_count,
                                 _scan_keys.begin_include(), _scan_keys.end_include(), cond_ranges,
                                 &split_ranges, _runtime_profile.get());
@@ -831,18 +845,7 @@ Status OlapScanNode::start_scan_thread(RuntimeState* state) {
                 ranges = &split_ranges;
             }
         }
-        // In order to avoid the problem of too many scanners caused by small tablets,
-        // in addition to scanRange, we also need to consider the size of the tablet when
-        // creating the scanner. One scanner is used for every 1Gb, and the final scanner_per_tablet
-        // takes the minimum value calculated by scanrange and size.
-        int size_based_scanners_per_tablet = 1;
-        if (config::doris_scan_range_max_mb > 0) {
-            size_based_scanners_per_tablet = std::max(
-                    1, (int)tablet->tablet_footprint() / config::doris_scan_range_max_mb << 20);
-        }
-        int ranges_per_scanner =
-                std::max(1, (int)ranges->size() /
-                                    std::min(scanners_per_tablet, size_based_scanners_per_tablet));
+        int ranges_per_scanner = std::max(1, (int)ranges->size() / num_scanners);
         int num_ranges = ranges->size();
         for (int i = 0; i < num_ranges;) {
             std::vector<OlapScanRange*> scanner_ranges;
@@ -891,13 +894,16 @@ Status OlapScanNode::normalize_predicate(ColumnValueRange<T>& range, SlotDescrip
     // 3. Normalize BinaryPredicate , add to ColumnValueRange
     RETURN_IF_ERROR(normalize_noneq_binary_predicate(slot, &range));
 
-    // 3. Normalize BloomFilterPredicate, push down by hash join node
+    // 4. Normalize prefix LikePredicate, add the range of the prefix to ColumnValueRange
+    RETURN_IF_ERROR(normalize_like_predicate(slot, &range));
+
+    // 5. Normalize BloomFilterPredicate, push down by hash join node
     RETURN_IF_ERROR(normalize_bloom_filter_predicate(slot));
 
-    // 4. Check whether range is empty, set _eos
+    // 6. Check whether range is empty, set _eos
     if (range.is_empty_value_range()) _eos = true;
 
-    // 5. Add range to Column->ColumnValueRange map
+    // 7. Add range to Column->ColumnValueRange map
     _column_value_ranges[slot->col_name()] = range;
 
     return Status::OK();
@@ -1349,6 +1355,57 @@ Status OlapScanNode::normalize_noneq_binary_predicate(SlotDescriptor* slot,
     return Status::OK();
 }
 
+template <class T>
+Status OlapScanNode::normalize_like_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range) {
+    if constexpr (std::is_same_v<T, StringValue>) {
+        // the values of char columns are padded, only handle varchar and string
+        if (slot->type().type != TYPE_VARCHAR && slot->type().type != TYPE_STRING) {
+            return Status::OK();
+        }
+        for (int conj_idx = 0; conj_idx < _conjunct_ctxs.size(); ++conj_idx) {
+            Expr* root_expr = _conjunct_ctxs[conj_idx]->root();
+            if (TExprNodeType::FUNCTION_CALL != root_expr->node_type() ||
+                root_expr->fn().name.function_name != "like" ||
+                root_expr->get_num_children() != 2) {
+                continue;
+            }
+            Expr* slot_expr = root_expr->get_child(0);
+            Expr* pattern_expr = root_expr->get_child(1);
+            if (Expr::type_without_cast(slot_expr) != TExprNodeType::SLOT_REF ||
+                !pattern_expr->is_constant()) {
+                continue;
+            }
+            if (slot_expr->type().type != slot->type().type && !ignore_cast(slot, slot_expr)) {
+                continue;
+            }
+            std::vector<SlotId> slot_ids;
+            if (slot_expr->get_slot_ids(&slot_ids) != 1 || slot_ids[0] != slot->id()) {
+                continue;
+            }
+            auto pattern = reinterpret_cast<StringValue*>(
+                    _conjunct_ctxs[conj_idx]->get_value(pattern_expr, nullptr));
+            if (pattern == nullptr) {
+                continue;
+            }
+            // for the inverted index of the column if any
+            _like_predicates_push_down.emplace_back(slot->col_name(), pattern->to_string());
+            auto lower = _pool->add(new std::string());
+            auto upper = _pool->add(new std::string());
+            if (!get_like_prefix_range(pattern->ptr, pattern->len, lower, upper)) {
+                continue;
+            }
+            // The like predicate is not pushed down, it still filters the rows in the range.
+            range->add_range(FILTER_LARGER_OR_EQUAL, StringValue(*lower));
+            if (!upper->empty()) {
+                range->add_range(FILTER_LESS, StringValue(*upper));
+            }
+            VLOG_CRITICAL << slot->col_name() << " like prefix range: [" << *lower << ", "
+                          << *upper << ")";
+        }
+    }
+    return Status::OK();
+}
+
 Status OlapScanNode::normalize_bloom_filter_predicate(SlotDescriptor* slot) {
     std::vector<uint32_t> filter_conjuncts_index;
 
@@ -1576,6 +1633,7 @@ void OlapScanNode::scanner_thread(OlapScanner* scanner) {
         return;
     }
     int64_t wait_time = scanner->update_wait_worker_timer();
+    DorisMetrics::instance()->scanner_queue_wait_us->add(wait_time / NANOS_PER_MICRO);
     // Do not use ScopedTimer. There is no guarantee that, the counter
     // (_scan_cpu_timer, the class member) is not destroyed after `_running_thread==0`.
     ThreadCpuStopWatch cpu_watch;
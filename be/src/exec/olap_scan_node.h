@@ -123,6 +123,9 @@ protected:
     template <class T>
     Status normalize_noneq_binary_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
 
+    template <class T>
+    Status normalize_like_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
+
     Status normalize_bloom_filter_predicate(SlotDescriptor* slot);
 
     template <typename T>
@@ -190,6 +193,10 @@ protected:
     // 2. std::pair.second :: shared_ptr of BloomFilterFuncBase
     std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>
             _bloom_filters_push_down;
+    // push down like predicates to inverted indexes of storage engine.
+    // 1. std::pair.first :: column name
+    // 2. std::pair.second :: like pattern
+    std::vector<std::pair<std::string, std::string>> _like_predicates_push_down;
 
     // Pool for storing allocated scanner objects.  We don't want to use the
     // runtime pool to ensure that the scanner objects are deleted before this
@@ -22,6 +22,7 @@
 #include "common/utils.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/PaloInternalService_types.h"
+#include "io/cache/file_block_cache.h"
 #include "olap/decimal12.h"
 #include "olap/storage_engine.h"
 #include "olap/uint24.h"
@@ -124,6 +125,7 @@ Status OlapScanner::prepare(
 Status OlapScanner::open() {
     SCOPED_TIMER(_parent->_reader_init_timer);
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    io::FileBlockCache::ScopedBypass bypass_file_cache(_runtime_state->disable_file_cache());
 
     if (_conjunct_ctxs.size() > _parent->_direct_conjunct_size) {
         _use_pushdown_conjuncts = true;
@@ -161,6 +163,7 @@ Status OlapScanner::_init_tablet_reader_params(
     std::copy(bloom_filters.cbegin(), bloom_filters.cend(),
               std::inserter(_tablet_reader_params.bloom_filters,
                             _tablet_reader_params.bloom_filters.begin()));
+    _tablet_reader_params.like_predicates = _parent->_like_predicates_push_down;
 
     // Range
     for (auto key_range : key_ranges) {
@@ -231,6 +234,7 @@ Status OlapScanner::_init_tablet_reader_params(
 
     if (!config::disable_storage_page_cache) {
         _tablet_reader_params.use_page_cache = true;
+        _tablet_reader_params.fill_page_cache = _runtime_state->fill_storage_page_cache();
     }
 
     return Status::OK();
@@ -279,6 +283,7 @@ Status OlapScanner::_init_return_columns() {
 
 Status OlapScanner::get_batch(RuntimeState* state, RowBatch* batch, bool* eof) {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
+    io::FileBlockCache::ScopedBypass bypass_file_cache(state->disable_file_cache());
     // 2. Allocate Row's Tuple buf
     uint8_t* tuple_buf =
             batch->tuple_data_pool()->allocate(state->batch_size() * _tuple_desc->byte_size());
@@ -581,9 +586,7 @@ void OlapScanner::update_counter() {
     DorisMetrics::instance()->query_scan_bytes->increment(_compressed_bytes_read);
     DorisMetrics::instance()->query_scan_rows->increment(_raw_rows_read);
 
-    _tablet->query_scan_bytes->increment(_compressed_bytes_read);
-    _tablet->query_scan_rows->increment(_raw_rows_read);
-    _tablet->query_scan_count->increment(1);
+    _tablet->record_query_scan(_compressed_bytes_read, _raw_rows_read, stats);
 
     _has_update_counter = true;
 }
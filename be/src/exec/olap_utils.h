@@ -19,6 +19,8 @@
 
 #include <math.h>
 
+#include <string>
+
 #include "common/logging.h"
 #include "gen_cpp/Opcodes_types.h"
 #include "olap/tuple.h"
@@ -215,4 +217,30 @@ inline SQLFilterOp to_olap_filter_type(TExprOpcode::type type, bool opposite) {
     return FILTER_IN;
 }
 
+// Get the range [lower, upper) of the strings matching a LIKE pattern, from the literal
+// prefix before the first wildcard. `upper` is empty if the range has no upper bound.
+// Return false if the pattern has no literal prefix.
+inline bool get_like_prefix_range(const char* pattern, size_t len, std::string* lower,
+                                  std::string* upper) {
+    size_t prefix_len = 0;
+    // stop at the escape char too, rather than unescaping the pattern
+    while (prefix_len < len && pattern[prefix_len] != '%' && pattern[prefix_len] != '_' &&
+           pattern[prefix_len] != '\\') {
+        ++prefix_len;
+    }
+    if (prefix_len == 0) {
+        return false;
+    }
+    lower->assign(pattern, prefix_len);
+    // the smallest string larger than all the strings starting with the prefix
+    upper->assign(pattern, prefix_len);
+    while (!upper->empty() && (uint8_t)upper->back() == 0xFF) {
+        upper->pop_back();
+    }
+    if (!upper->empty()) {
+        upper->back() = (char)((uint8_t)upper->back() + 1);
+    }
+    return true;
+}
+
 } // namespace doris
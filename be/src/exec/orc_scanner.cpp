@@ -17,6 +17,10 @@
 
 #include "exec/orc_scanner.h"
 
+#include <orc/sargs/SearchArgument.hh>
+
+#include <map>
+
 #include "io/file_factory.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
@@ -113,8 +117,6 @@ ORCScanner::ORCScanner(RuntimeState* state, RuntimeProfile* profile,
         : BaseScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs, counter),
           // _splittable(params.splittable),
           _cur_file_eof(true),
-          _total_groups(0),
-          _current_group(0),
           _rows_of_group(0),
           _current_line_of_group(0) {}
 
@@ -154,17 +156,17 @@ Status ORCScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof, bool*
                     _cur_file_eof = false;
                 }
             }
-            if (_current_line_of_group >= _rows_of_group) { // read next stripe
-                if (_current_group >= _total_groups) {
+            if (_current_line_of_group >= _rows_of_group) { // read next batch
+                if (_batch == nullptr) {
+                    _batch = _row_reader->createRowBatch(_state->batch_size());
+                }
+                // the row groups skipped by the search argument are not returned
+                if (!_row_reader->next(*_batch.get())) {
                     _cur_file_eof = true;
                     continue;
                 }
-                _rows_of_group = _reader->getStripe(_current_group)->getNumberOfRows();
-                _batch = _row_reader->createRowBatch(_rows_of_group);
-                _row_reader->next(*_batch.get());
-
+                _rows_of_group = _batch->numElements;
                 _current_line_of_group = 0;
-                ++_current_group;
             }
 
             const std::vector<orc::ColumnVectorBatch*>& batch_vec =
@@ -391,10 +393,10 @@ Status ORCScanner::open_next_reader() {
                 new ORCFileStream(file_reader.release(), range.path));
         _reader = orc::createReader(std::move(inStream), _options);
 
-        _total_groups = _reader->getNumberOfStripes();
-        _current_group = 0;
         _rows_of_group = 0;
         _current_line_of_group = 0;
+        _batch = nullptr;
+        _init_search_argument();
         _row_reader = _reader->createRowReader(_row_reader_options);
 
         //include_colus is in loader columns order, and batch is in the orc order
@@ -412,6 +414,84 @@ Status ORCScanner::open_next_reader() {
     }
 }
 
+void ORCScanner::_init_search_argument() {
+    std::map<std::string, orc::TypeKind> column_kinds;
+    const auto& type = _reader->getType();
+    for (int i = 0; i < type.getSubtypeCount(); ++i) {
+        column_kinds.emplace(type.getFieldName(i), type.getSubtype(i)->getKind());
+    }
+
+    auto builder = orc::SearchArgumentFactory::newBuilder();
+    builder->startAnd();
+    int num_predicates = 0;
+    for (const auto& predicate : _statistics_filter.predicates()) {
+        const auto& name = _src_slot_descs[predicate.position]->col_name();
+        auto iter = column_kinds.find(name);
+        if (iter == column_kinds.end()) {
+            continue;
+        }
+        // The values of the src slots are converted from the column values, only push down
+        // the types whose order is the same after conversion.
+        PrimitiveType slot_type = _statistics_filter.slot_type(predicate.position);
+        bool string_slot = slot_type == TYPE_VARCHAR || slot_type == TYPE_STRING;
+        orc::PredicateDataType data_type;
+        std::vector<orc::Literal> literals;
+        if (string_slot && (iter->second == orc::STRING || iter->second == orc::VARCHAR)) {
+            data_type = orc::PredicateDataType::STRING;
+            for (const auto& value : predicate.values) {
+                const auto& str = value.get<vectorized::String>();
+                literals.emplace_back(str.data(), str.size());
+            }
+        } else if (string_slot && iter->second == orc::DATE) {
+            // formatted as 'yyyy-MM-dd' in UTC
+            data_type = orc::PredicateDataType::DATE;
+            for (const auto& value : predicate.values) {
+                int64_t days = 0;
+                if (!FileStatisticsFilter::date_string_to_days(value.get<vectorized::String>(), &days)) {
+                    break;
+                }
+                literals.emplace_back(orc::PredicateDataType::DATE, days);
+            }
+        } else {
+            continue;
+        }
+        if (literals.size() != predicate.values.size()) {
+            continue;
+        }
+
+        switch (predicate.op) {
+        case TExprOpcode::EQ:
+            if (literals.size() == 1) {
+                builder->equals(name, data_type, literals[0]);
+            } else {
+                builder->in(name, data_type, literals);
+            }
+            break;
+        case TExprOpcode::LT:
+            builder->lessThan(name, data_type, literals[0]);
+            break;
+        case TExprOpcode::LE:
+            builder->lessThanEquals(name, data_type, literals[0]);
+            break;
+        case TExprOpcode::GT:
+            builder->startNot().lessThanEquals(name, data_type, literals[0]).end();
+            break;
+        case TExprOpcode::GE:
+            builder->startNot().lessThan(name, data_type, literals[0]).end();
+            break;
+        default:
+            continue;
+        }
+        ++num_predicates;
+    }
+    builder->end();
+    if (num_predicates > 0) {
+        _row_reader_options.searchArgument(builder->build());
+    } else {
+        _row_reader_options.searchArgument(nullptr);
+    }
+}
+
 void ORCScanner::close() {
     BaseScanner::close();
     _batch = nullptr;
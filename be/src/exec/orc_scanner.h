@@ -45,6 +45,9 @@ public:
 private:
     // Read next buffer from reader
     Status open_next_reader();
+    // Push the comparisons of `_statistics_filter` on the columns of the current file down
+    // to liborc, which skips stripes and row groups by statistics and bloom filters.
+    void _init_search_argument();
 
 private:
     // Reader
@@ -61,9 +64,7 @@ private:
     std::vector<int> _position_in_orc_original;
     int _num_of_columns_from_file;
 
-    int _total_groups; // groups in a orc file
-    int _current_group;
-    int64_t _rows_of_group; // rows in a group.
+    int64_t _rows_of_group; // rows in the current batch.
     int64_t _current_line_of_group;
 };
 
@@ -109,7 +109,9 @@ Status ParquetScanner::open_next_reader() {
         _cur_file_reader = new ParquetReaderWrap(file_reader.release(), _state->batch_size(),
                                                  num_of_columns_from_file);
 
-        Status status = _cur_file_reader->init_reader(_src_slot_descs, _state->timezone());
+        Status status = _cur_file_reader->init_reader(_src_slot_descs, _state->timezone(),
+                                                      &_statistics_filter);
+        COUNTER_UPDATE(_filtered_row_groups_counter, _cur_file_reader->filtered_groups());
 
         if (status.is_end_of_file()) {
             continue;
@@ -56,6 +56,10 @@ public:
 
     void set_written_len(int64_t written_len);
 
+    // Close() leaves the file writer open after this is called, for the owner of the file
+    // writer to close it, e.g. to upload the file in background.
+    void release_file_writer() { _file_writer = nullptr; }
+
 private:
     FileWriter* _file_writer; // not owned
     int64_t _cur_pos = 0;     // current write position
@@ -84,6 +88,12 @@ public:
 
     Status parse_schema(const std::vector<std::vector<std::string>>& schema);
 
+    // shared with the vectorized parquet writer
+    static std::shared_ptr<parquet::WriterProperties> build_properties(
+            const std::map<std::string, std::string>& propertie_map);
+    static std::shared_ptr<parquet::schema::GroupNode> build_schema(
+            const std::vector<std::vector<std::string>>& schema);
+
     parquet::RowGroupWriter* get_rg_writer();
 
     int64_t written_len();
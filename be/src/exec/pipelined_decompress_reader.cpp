@@ -0,0 +1,218 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/pipelined_decompress_reader.h"
+
+#include <fmt/format.h>
+
+#include <cstring>
+
+#include "common/logging.h"
+#include "exec/decompressor.h"
+
+namespace doris {
+
+static constexpr size_t INPUT_CHUNK_SIZE = 2 * 1024 * 1024;
+static constexpr size_t OUTPUT_CHUNK_SIZE = 8 * 1024 * 1024;
+
+PipelinedDecompressReader::PipelinedDecompressReader(std::shared_ptr<FileReader> file_reader,
+                                                     Decompressor* decompressor,
+                                                     size_t max_buffered_chunks)
+        : _file_reader(std::move(file_reader)),
+          _decompressor(decompressor),
+          _max_buffered_chunks(std::max<size_t>(max_buffered_chunks, 1)) {}
+
+PipelinedDecompressReader::~PipelinedDecompressReader() {
+    close();
+}
+
+Status PipelinedDecompressReader::open() {
+    DCHECK(!_thread.joinable());
+    _thread = std::thread(&PipelinedDecompressReader::_decompress_thread, this);
+    return Status::OK();
+}
+
+void PipelinedDecompressReader::close() {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _closed = true;
+        _chunks.clear();
+    }
+    _put_cond.notify_all();
+    _get_cond.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _cur_chunk.reset();
+}
+
+void PipelinedDecompressReader::_decompress_thread() {
+    Status st = _decompress();
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to decompress " << _decompressor->debug_info() << ": " << st;
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _status = st;
+        _finished = true;
+    }
+    _get_cond.notify_all();
+}
+
+bool PipelinedDecompressReader::_put_chunk(ByteBufferPtr chunk) {
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        while (!_closed && _chunks.size() >= _max_buffered_chunks) {
+            _put_cond.wait(l);
+        }
+        if (_closed) {
+            return false;
+        }
+        _chunks.emplace_back(std::move(chunk));
+    }
+    _get_cond.notify_one();
+    return true;
+}
+
+Status PipelinedDecompressReader::_decompress() {
+    size_t input_size = INPUT_CHUNK_SIZE;
+    std::unique_ptr<uint8_t[]> input(new uint8_t[input_size]);
+    size_t input_pos = 0;
+    size_t input_limit = 0;
+    size_t output_size = OUTPUT_CHUNK_SIZE;
+    bool file_eof = false;
+    // an empty file is not treated as truncated
+    bool stream_end = true;
+    size_t more_input_bytes = 0;
+    size_t more_output_bytes = 0;
+    // the decompressor may hold the output of the consumed input if the last chunk is full
+    bool output_full = false;
+    while (true) {
+        if ((input_pos == input_limit && !output_full) || more_input_bytes > 0) {
+            int64_t read_len = 0;
+            if (!file_eof) {
+                // move the remaining input to the head, and extend the buf if the
+                // decompressor needs more bytes than it can hold
+                size_t remaining = input_limit - input_pos;
+                if (input_pos > 0) {
+                    memmove(input.get(), input.get() + input_pos, remaining);
+                    input_pos = 0;
+                    input_limit = remaining;
+                }
+                if (remaining + more_input_bytes > input_size) {
+                    input_size = std::max(input_size * 2, remaining + more_input_bytes);
+                    std::unique_ptr<uint8_t[]> new_input(new uint8_t[input_size]);
+                    memcpy(new_input.get(), input.get(), remaining);
+                    input = std::move(new_input);
+                }
+                RETURN_IF_ERROR(_file_reader->read(input.get() + input_limit,
+                                                   input_size - input_limit, &read_len,
+                                                   &file_eof));
+            }
+            if (read_len == 0) {
+                file_eof = true;
+                if (stream_end && input_pos == input_limit) {
+                    return Status::OK();
+                }
+                return Status::InternalError(
+                        "Compressed file has been truncated, which is not allowed");
+            }
+            input_limit += read_len;
+            if ((size_t)read_len < more_input_bytes) {
+                more_input_bytes -= read_len;
+                continue;
+            }
+        } else if (input_pos == input_limit && file_eof && stream_end) {
+            return Status::OK();
+        }
+
+        if (more_output_bytes > 0) {
+            output_size += more_output_bytes;
+        }
+        ByteBufferPtr chunk = ByteBuffer::allocate(output_size);
+        size_t input_len = input_limit - input_pos;
+        size_t input_read_bytes = 0;
+        size_t decompressed_len = 0;
+        more_input_bytes = 0;
+        more_output_bytes = 0;
+        RETURN_IF_ERROR(_decompressor->decompress(
+                input.get() + input_pos, input_len, &input_read_bytes,
+                reinterpret_cast<uint8_t*>(chunk->ptr), chunk->capacity, &decompressed_len,
+                &stream_end, &more_input_bytes, &more_output_bytes));
+        input_pos += input_read_bytes;
+        output_full = decompressed_len == chunk->capacity;
+        if (input_read_bytes == 0 && decompressed_len == 0 && more_input_bytes == 0 &&
+            more_output_bytes == 0) {
+            if (input_len == 0) {
+                // nothing is held by the decompressor, read more input
+                continue;
+            }
+            return Status::InternalError(
+                    fmt::format("decompress made no progress. input_len: {}", input_len));
+        }
+        if (decompressed_len > 0) {
+            chunk->pos = decompressed_len;
+            chunk->flip();
+            if (!_put_chunk(std::move(chunk))) {
+                // closed by the consumer
+                return Status::OK();
+            }
+        }
+    }
+}
+
+Status PipelinedDecompressReader::read_buffer(ByteBufferPtr* buf) {
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        while (!_closed && !_finished && _chunks.empty()) {
+            _get_cond.wait(l);
+        }
+        if (_closed) {
+            return Status::InternalError("PipelinedDecompressReader is closed");
+        }
+        if (_chunks.empty()) {
+            DCHECK(_finished);
+            RETURN_IF_ERROR(_status);
+            buf->reset();
+            return Status::OK();
+        }
+        *buf = std::move(_chunks.front());
+        _chunks.pop_front();
+    }
+    _put_cond.notify_one();
+    return Status::OK();
+}
+
+Status PipelinedDecompressReader::read(uint8_t* buf, int64_t buf_len, int64_t* bytes_read,
+                                       bool* eof) {
+    *bytes_read = 0;
+    while (*bytes_read < buf_len) {
+        if (_cur_chunk == nullptr || !_cur_chunk->has_remaining()) {
+            RETURN_IF_ERROR(read_buffer(&_cur_chunk));
+            if (_cur_chunk == nullptr) {
+                break;
+            }
+        }
+        size_t copy_size = std::min((size_t)(buf_len - *bytes_read), _cur_chunk->remaining());
+        _cur_chunk->get_bytes(reinterpret_cast<char*>(buf) + *bytes_read, copy_size);
+        *bytes_read += copy_size;
+    }
+    *eof = *bytes_read == 0;
+    return Status::OK();
+}
+
+} // namespace doris
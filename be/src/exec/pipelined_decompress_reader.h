@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common/status.h"
+#include "io/file_reader.h"
+#include "util/byte_buffer.h"
+
+namespace doris {
+
+class Decompressor;
+
+// Decompresses the data of a file reader in a separate thread, the decompressed chunks are
+// buffered ahead of the consumer, so the decompression of the next chunks overlaps with the
+// parsing of the current one. The chunks are returned without copying by read_buffer().
+class PipelinedDecompressReader : public FileReader {
+public:
+    // 'file_reader' must be opened, the reader takes the ownership of 'decompressor'
+    PipelinedDecompressReader(std::shared_ptr<FileReader> file_reader, Decompressor* decompressor,
+                              size_t max_buffered_chunks);
+    ~PipelinedDecompressReader() override;
+
+    // start the decompress thread
+    Status open() override;
+
+    Status read(uint8_t* buf, int64_t buf_len, int64_t* bytes_read, bool* eof) override;
+
+    Status readat(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) override {
+        return Status::NotSupported("readat is not supported by PipelinedDecompressReader");
+    }
+
+    Status read_one_message(std::unique_ptr<uint8_t[]>* buf, int64_t* length) override {
+        return Status::NotSupported(
+                "read_one_message is not supported by PipelinedDecompressReader");
+    }
+
+    bool support_read_buffer() const override { return true; }
+    Status read_buffer(ByteBufferPtr* buf) override;
+
+    // the size of the decompressed data is unknown
+    int64_t size() override { return -1; }
+
+    Status seek(int64_t position) override {
+        return Status::NotSupported("seek is not supported by PipelinedDecompressReader");
+    }
+
+    Status tell(int64_t* position) override {
+        return Status::NotSupported("tell is not supported by PipelinedDecompressReader");
+    }
+
+    void close() override;
+    bool closed() override { return _closed; }
+
+private:
+    void _decompress_thread();
+    Status _decompress();
+    // return false if the reader is closed
+    bool _put_chunk(ByteBufferPtr chunk);
+
+private:
+    std::shared_ptr<FileReader> _file_reader;
+    std::unique_ptr<Decompressor> _decompressor;
+    const size_t _max_buffered_chunks;
+
+    std::mutex _lock;
+    std::condition_variable _get_cond;
+    std::condition_variable _put_cond;
+    std::deque<ByteBufferPtr> _chunks;
+    // set by the decompress thread when it exits
+    bool _finished = false;
+    Status _status;
+    bool _closed = false;
+    std::thread _thread;
+
+    // the chunk being copied by read()
+    ByteBufferPtr _cur_chunk;
+};
+
+} // namespace doris
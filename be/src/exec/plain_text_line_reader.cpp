@@ -43,11 +43,11 @@ PlainTextLineReader::PlainTextLineReader(RuntimeProfile* profile, FileReader* fi
           _total_read_bytes(0),
           _line_delimiter(line_delimiter),
           _line_delimiter_length(line_delimiter_length),
-          _input_buf(new uint8_t[INPUT_CHUNK]),
+          _input_buf(nullptr),
           _input_buf_size(INPUT_CHUNK),
           _input_buf_pos(0),
           _input_buf_limit(0),
-          _output_buf(new uint8_t[OUTPUT_CHUNK]),
+          _output_buf(nullptr),
           _output_buf_size(OUTPUT_CHUNK),
           _output_buf_pos(0),
           _output_buf_limit(0),
@@ -56,6 +56,8 @@ PlainTextLineReader::PlainTextLineReader(RuntimeProfile* profile, FileReader* fi
           _stream_end(true),
           _more_input_bytes(0),
           _more_output_bytes(0),
+          _read_buffer(decompressor == nullptr && file_reader != nullptr &&
+                       file_reader->support_read_buffer()),
           _bytes_read_counter(nullptr),
           _read_timer(nullptr),
           _bytes_decompress_counter(nullptr),
@@ -64,6 +66,10 @@ PlainTextLineReader::PlainTextLineReader(RuntimeProfile* profile, FileReader* fi
     _read_timer = ADD_TIMER(_profile, "FileReadTime");
     _bytes_decompress_counter = ADD_COUNTER(_profile, "BytesDecompressed", TUnit::BYTES);
     _decompress_timer = ADD_TIMER(_profile, "DecompressTime");
+    if (!_read_buffer) {
+        _input_buf = new uint8_t[INPUT_CHUNK];
+        _output_buf = new uint8_t[OUTPUT_CHUNK];
+    }
 }
 
 PlainTextLineReader::~PlainTextLineReader() {
@@ -80,6 +86,7 @@ void PlainTextLineReader::close() {
         delete[] _output_buf;
         _output_buf = nullptr;
     }
+    _cur_buffer.reset();
 }
 
 inline bool PlainTextLineReader::update_eof() {
@@ -94,6 +101,9 @@ inline bool PlainTextLineReader::update_eof() {
 uint8_t* PlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                        size_t len) {
     // TODO: meanwhile find and save field pos
+    if (_line_delimiter_length == 1) {
+        return (uint8_t*)memchr(start, _line_delimiter[0], len);
+    }
     return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
 }
 
@@ -182,6 +192,9 @@ void PlainTextLineReader::extend_output_buf() {
 }
 
 Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* eof) {
+    if (_read_buffer) {
+        return read_line_from_buffers(ptr, size, eof);
+    }
     if (_eof || update_eof()) {
         *size = 0;
         *eof = true;
@@ -345,4 +358,88 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
     return Status::OK();
 }
 
+size_t PlainTextLineReader::find_cross_line_delimiter(const uint8_t* start, size_t len) {
+    // the delimiter starts in the last (_line_delimiter_length - 1) bytes of _cross_line
+    size_t tail = std::min(_cross_line.size(), _line_delimiter_length - 1);
+    for (size_t i = _cross_line.size() - tail; i < _cross_line.size(); ++i) {
+        size_t in_line = _cross_line.size() - i;
+        size_t in_start = _line_delimiter_length - in_line;
+        if (in_start <= len &&
+            memcmp(_cross_line.data() + i, _line_delimiter.data(), in_line) == 0 &&
+            memcmp(start, _line_delimiter.data() + in_line, in_start) == 0) {
+            _cross_line.resize(i);
+            return in_start;
+        }
+    }
+    return 0;
+}
+
+Status PlainTextLineReader::read_line_from_buffers(const uint8_t** ptr, size_t* size,
+                                                   bool* eof) {
+    if (_eof || (_min_length >= 0 && _total_read_bytes >= _min_length)) {
+        *size = 0;
+        *eof = true;
+        return Status::OK();
+    }
+    bool cross_line = false;
+    _cross_line.clear();
+    while (true) {
+        if (_cur_buffer == nullptr || _cur_buffer_pos == _cur_buffer->limit) {
+            {
+                SCOPED_TIMER(_read_timer);
+                RETURN_IF_ERROR(_file_reader->read_buffer(&_cur_buffer));
+            }
+            if (_cur_buffer == nullptr) {
+                // the last line without line delimiter
+                _eof = true;
+                *ptr = _cross_line.data();
+                *size = _cross_line.size();
+                *eof = !cross_line;
+                _total_read_bytes += *size;
+                return Status::OK();
+            }
+            _cur_buffer_pos = _cur_buffer->pos;
+            COUNTER_UPDATE(_bytes_read_counter, _cur_buffer->limit - _cur_buffer_pos);
+            continue;
+        }
+
+        const uint8_t* start = reinterpret_cast<const uint8_t*>(_cur_buffer->ptr) + _cur_buffer_pos;
+        size_t len = _cur_buffer->limit - _cur_buffer_pos;
+        if (cross_line && _line_delimiter_length > 1) {
+            size_t taken = find_cross_line_delimiter(start, len);
+            if (taken > 0) {
+                _cur_buffer_pos += taken;
+                *ptr = _cross_line.data();
+                *size = _cross_line.size();
+                *eof = false;
+                _total_read_bytes += *size + _line_delimiter_length;
+                return Status::OK();
+            }
+        }
+
+        const uint8_t* pos = update_field_pos_and_find_line_delimiter(start, len);
+        if (pos == nullptr) {
+            // the line continues in the next chunk
+            _cross_line.insert(_cross_line.end(), start, start + len);
+            _cur_buffer_pos += len;
+            cross_line = true;
+            continue;
+        }
+
+        size_t offset = pos - start;
+        _cur_buffer_pos += offset + _line_delimiter_length;
+        if (cross_line) {
+            _cross_line.insert(_cross_line.end(), start, pos);
+            *ptr = _cross_line.data();
+            *size = _cross_line.size();
+        } else {
+            *ptr = start;
+            *size = offset;
+        }
+        *eof = false;
+        _total_read_bytes += *size + _line_delimiter_length;
+        return Status::OK();
+    }
+}
+
 } // namespace doris
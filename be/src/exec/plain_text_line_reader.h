@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "exec/line_reader.h"
+#include "util/byte_buffer.h"
 #include "util/runtime_profile.h"
 
 namespace doris {
@@ -56,6 +59,13 @@ private:
     void extend_input_buf();
     void extend_output_buf();
 
+    // Read a line from the chunks returned by FileReader::read_buffer(). The line points to
+    // the chunk if it is inside one, only the lines across chunks are copied to _cross_line.
+    Status read_line_from_buffers(const uint8_t** ptr, size_t* size, bool* eof);
+    // For multi bytes delimiter, find the delimiter which starts in the tail of _cross_line
+    // and ends in 'start', return the bytes of 'start' it takes, or 0 if not found.
+    size_t find_cross_line_delimiter(const uint8_t* start, size_t len);
+
 private:
     RuntimeProfile* _profile;
     FileReader* _file_reader;
@@ -83,6 +93,14 @@ private:
     size_t _more_input_bytes;
     size_t _more_output_bytes;
 
+    // whether to read the chunks of the file reader without copying,
+    // only for the uncompressed data of the readers supporting read_buffer()
+    bool _read_buffer;
+    ByteBufferPtr _cur_buffer;
+    size_t _cur_buffer_pos = 0;
+    // the line across chunks
+    std::vector<uint8_t> _cross_line;
+
     // Profile counters
     RuntimeProfile::Counter* _bytes_read_counter;
     RuntimeProfile::Counter* _read_timer;
@@ -19,6 +19,7 @@
 
 #include "runtime/large_int_value.h"
 #include "runtime/mem_pool.h"
+#include "util/hash_util.hpp"
 #include "util/random.h"
 #include "util/string_parser.hpp"
 #include "util/time.h"
@@ -37,6 +38,9 @@ Status OlapTableSchemaParam::init(const POlapTableSchemaParam& pschema) {
     _db_id = pschema.db_id();
     _table_id = pschema.table_id();
     _version = pschema.version();
+    _is_partial_update = pschema.is_partial_update();
+    _partial_update_input_columns.insert(pschema.partial_update_input_columns().begin(),
+                                         pschema.partial_update_input_columns().end());
     std::map<std::string, SlotDescriptor*> slots_map;
     _tuple_desc = _obj_pool.add(new TupleDescriptor(pschema.tuple_desc()));
 
@@ -73,6 +77,9 @@ Status OlapTableSchemaParam::init(const TOlapTableSchemaParam& tschema) {
     _db_id = tschema.db_id;
     _table_id = tschema.table_id;
     _version = tschema.version;
+    _is_partial_update = tschema.__isset.is_partial_update && tschema.is_partial_update;
+    _partial_update_input_columns.insert(tschema.partial_update_input_columns.begin(),
+                                         tschema.partial_update_input_columns.end());
     std::map<std::string, SlotDescriptor*> slots_map;
     _tuple_desc = _obj_pool.add(new TupleDescriptor(tschema.tuple_desc));
     for (auto& t_slot_desc : tschema.slot_descs) {
@@ -108,6 +115,10 @@ void OlapTableSchemaParam::to_protobuf(POlapTableSchemaParam* pschema) const {
     pschema->set_db_id(_db_id);
     pschema->set_table_id(_table_id);
     pschema->set_version(_version);
+    pschema->set_is_partial_update(_is_partial_update);
+    for (auto& column : _partial_update_input_columns) {
+        pschema->add_partial_update_input_columns(column);
+    }
     _tuple_desc->to_protobuf(pschema->mutable_tuple_desc());
     for (auto slot : _tuple_desc->slots()) {
         slot->to_protobuf(pschema->add_slot_descs());
@@ -541,11 +552,156 @@ Status VOlapTablePartitionParam::init() {
         }
     }
 
+    _init_int_partitions();
+
     _mem_usage = _partition_block.allocated_bytes();
     _mem_tracker->consume(_mem_usage);
     return Status::OK();
 }
 
+template <typename T>
+static bool get_int_values(const vectorized::IColumn& column,
+                           std::vector<vectorized::Int128>* values) {
+    auto col = vectorized::check_and_get_column<vectorized::ColumnVector<T>>(column);
+    if (col == nullptr) {
+        return false;
+    }
+    const auto& data = col->get_data();
+    values->assign(data.begin(), data.end());
+    return true;
+}
+
+// Gets the values of the integer-like column as Int128, which keeps their order, including
+// the DATE, DATETIME and their V2 types. Returns false for other columns.
+static bool get_int_values(const vectorized::IColumn& column,
+                           std::vector<vectorized::Int128>* values) {
+    return get_int_values<vectorized::Int8>(column, values) ||
+           get_int_values<vectorized::Int16>(column, values) ||
+           get_int_values<vectorized::Int32>(column, values) ||
+           get_int_values<vectorized::Int64>(column, values) ||
+           get_int_values<vectorized::Int128>(column, values) ||
+           get_int_values<vectorized::UInt8>(column, values) ||
+           get_int_values<vectorized::UInt32>(column, values) ||
+           get_int_values<vectorized::UInt64>(column, values);
+}
+
+void VOlapTablePartitionParam::_init_int_partitions() {
+    if (_partition_slot_locs.size() != 1) {
+        return;
+    }
+    // the partition block is empty if there are only MIN/MAX keys
+    const auto& key_column = *_partition_block.get_by_position(_partition_slot_locs[0]).column;
+    const vectorized::IColumn* nested = &key_column;
+    if (auto nullable = vectorized::check_and_get_column<vectorized::ColumnNullable>(key_column)) {
+        if (nullable->has_null()) {
+            return;
+        }
+        nested = &nullable->get_nested_column();
+    }
+    std::vector<vectorized::Int128> keys;
+    if (!get_int_values(*nested, &keys)) {
+        return;
+    }
+    // the map is ordered by the end keys, and the key of row -1 is the MAXVALUE
+    for (auto& [key, part] : *_partitions_map) {
+        if (_is_in_partition) {
+            _int_in_partitions.emplace(keys[key->second], part);
+            continue;
+        }
+        IntRangePartition range;
+        range.partition = part;
+        if (part->start_key.second != -1) {
+            range.has_start = true;
+            range.start = keys[part->start_key.second];
+        }
+        if (key->second == -1) {
+            _int_max_partition = range;
+        } else {
+            _int_range_ends.push_back(keys[key->second]);
+            _int_range_partitions.push_back(range);
+        }
+    }
+    _is_int_partition = true;
+}
+
+void VOlapTablePartitionParam::find_partitions(
+        vectorized::Block* block, std::vector<const VOlapTablePartition*>* partitions) const {
+    size_t num_rows = block->rows();
+    partitions->assign(num_rows, nullptr);
+    if (num_rows == 0) {
+        return;
+    }
+    std::vector<vectorized::Int128> values;
+    const vectorized::NullMap* null_map = nullptr;
+    bool is_int_column = false;
+    if (_is_int_partition) {
+        auto column = block->get_by_position(_partition_slot_locs[0]).column.get();
+        if (auto nullable = vectorized::check_and_get_column<vectorized::ColumnNullable>(column)) {
+            null_map = &nullable->get_null_map_data();
+            column = &nullable->get_nested_column();
+        }
+        is_int_column = get_int_values(*column, &values);
+    }
+    if (!is_int_column) {
+        for (int i = 0; i < num_rows; ++i) {
+            BlockRow block_row(block, i);
+            find_partition(&block_row, &(*partitions)[i]);
+        }
+        return;
+    }
+
+    for (int i = 0; i < num_rows; ++i) {
+        if (null_map != nullptr && (*null_map)[i]) {
+            BlockRow block_row(block, i);
+            find_partition(&block_row, &(*partitions)[i]);
+            continue;
+        }
+        auto value = values[i];
+        if (_is_in_partition) {
+            auto it = _int_in_partitions.find(value);
+            if (it != _int_in_partitions.end()) {
+                (*partitions)[i] = it->second;
+            }
+            continue;
+        }
+        auto it = std::upper_bound(_int_range_ends.begin(), _int_range_ends.end(), value);
+        const IntRangePartition* range = &_int_max_partition;
+        if (it != _int_range_ends.end()) {
+            range = &_int_range_partitions[it - _int_range_ends.begin()];
+        }
+        if (range->partition != nullptr && (!range->has_start || !(value < range->start))) {
+            (*partitions)[i] = range->partition;
+        }
+    }
+}
+
+void VOlapTablePartitionParam::find_tablets(
+        vectorized::Block* block, const std::vector<const VOlapTablePartition*>& partitions,
+        std::vector<uint32_t>* tablet_indexes) const {
+    size_t num_rows = block->rows();
+    tablet_indexes->assign(num_rows, 0);
+    if (_distributed_slot_locs.empty()) {
+        for (int i = 0; i < num_rows; ++i) {
+            if (partitions[i] != nullptr) {
+                BlockRow block_row(block, i);
+                (*tablet_indexes)[i] = find_tablet(&block_row, *partitions[i]);
+            }
+        }
+        return;
+    }
+
+    // the hash of the columns are computed the same as _compute_tablet_index() does
+    std::vector<uint32_t> hash_vals(num_rows, 0);
+    for (auto loc : _distributed_slot_locs) {
+        block->get_by_position(loc).column->update_crcs_with_value(hash_vals, _slots[loc]->type());
+    }
+    for (int i = 0; i < num_rows; ++i) {
+        if (partitions[i] != nullptr) {
+            (*tablet_indexes)[i] = hash_vals[i] % partitions[i]->num_buckets;
+        }
+    }
+}
+
 bool VOlapTablePartitionParam::find_partition(BlockRow* block_row,
                                               const VOlapTablePartition** partition) const {
     auto it = _is_in_partition ? _partitions_map->find(block_row)
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +31,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/raw_value.h"
 #include "runtime/tuple.h"
+#include "vec/common/hash_table/hash.h"
 #include "vec/core/block.h"
 
 namespace doris {
@@ -60,6 +62,12 @@ public:
     TupleDescriptor* tuple_desc() const { return _tuple_desc; }
     const std::vector<OlapTableIndexSchema*>& indexes() const { return _indexes; }
 
+    // whether the load only provides the columns in partial_update_input_columns()
+    bool is_partial_update() const { return _is_partial_update; }
+    const std::set<std::string>& partial_update_input_columns() const {
+        return _partial_update_input_columns;
+    }
+
     void to_protobuf(POlapTableSchemaParam* pschema) const;
 
     // NOTE: this function is not thread-safe.
@@ -81,6 +89,8 @@ private:
     TupleDescriptor* _tuple_desc = nullptr;
     mutable POlapTableSchemaParam* _proto_schema = nullptr;
     std::vector<OlapTableIndexSchema*> _indexes;
+    bool _is_partial_update = false;
+    std::set<std::string> _partial_update_input_columns;
     mutable ObjectPool _obj_pool;
 };
 
@@ -266,9 +276,23 @@ public:
 
     uint32_t find_tablet(BlockRow* block_row, const VOlapTablePartition& partition) const;
 
+    // Finds the partitions of all rows of the block column-wise, the partition of a row is
+    // nullptr if it is not found.
+    void find_partitions(vectorized::Block* block,
+                         std::vector<const VOlapTablePartition*>* partitions) const;
+
+    // Finds the tablet indexes of the rows of the block in their partitions, computing the
+    // hash of the distributed columns column-wise. The rows without partition are skipped.
+    void find_tablets(vectorized::Block* block,
+                      const std::vector<const VOlapTablePartition*>& partitions,
+                      std::vector<uint32_t>* tablet_indexes) const;
+
     const std::vector<VOlapTablePartition*>& get_partitions() const { return _partitions; }
 
 private:
+    // Builds the sorted bounds of the single integer partition column, so that the rows are
+    // routed by a binary search or a hash lookup instead of the comparisons of `BlockRow`s.
+    void _init_int_partitions();
     Status _create_partition_keys(const std::vector<TExprNode>& t_exprs, BlockRow* part_key);
 
     Status _create_partition_key(const TExprNode& t_expr, BlockRow* part_key, uint16_t pos);
@@ -300,6 +324,23 @@ private:
 
     bool _is_in_partition = false;
     uint32_t _mem_usage = 0;
+
+    // The partitions by the values of the single integer partition column, the values of the
+    // integer types are kept as Int128 which keeps their order.
+    struct IntRangePartition {
+        bool has_start = false;
+        vectorized::Int128 start = 0;
+        const VOlapTablePartition* partition = nullptr;
+    };
+    bool _is_int_partition = false;
+    // the sorted end keys of the range partitions and their partitions
+    std::vector<vectorized::Int128> _int_range_ends;
+    std::vector<IntRangePartition> _int_range_partitions;
+    // the partition without end key, i.e. MAXVALUE
+    IntRangePartition _int_max_partition;
+    std::unordered_map<vectorized::Int128, const VOlapTablePartition*,
+                       HashCRC32<vectorized::Int128>>
+            _int_in_partitions;
 };
 
 using TabletLocation = TTabletLocation;
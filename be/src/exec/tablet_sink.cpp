@@ -570,7 +570,15 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
             return Status::InternalError("unknown tablet");
         }
         std::vector<std::shared_ptr<NodeChannel>> channels;
-        for (auto& node_id : location->node_ids) {
+        // in single replica load, the rows are only sent to the first replica, and the others
+        // pull the rowset from it
+        std::vector<int64_t> node_ids = location->node_ids;
+        std::vector<int64_t> slave_node_ids;
+        if (_parent->_write_single_replica && node_ids.size() > 1) {
+            slave_node_ids.assign(node_ids.begin() + 1, node_ids.end());
+            node_ids.resize(1);
+        }
+        for (auto& node_id : node_ids) {
             std::shared_ptr<NodeChannel> channel;
             auto it = _node_channels.find(node_id);
             if (it == _node_channels.end()) {
@@ -587,6 +595,9 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
                 channel = it->second;
             }
             channel->add_tablet(tablet);
+            if (!slave_node_ids.empty()) {
+                channel->add_slave_tablet_nodes(tablet.tablet_id, slave_node_ids);
+            }
             channels.push_back(channel);
             _tablets_by_channel[node_id].insert(tablet.tablet_id);
         }
@@ -612,7 +623,7 @@ void IndexChannel::mark_as_failed(int64_t node_id, const std::string& host, cons
             for (const auto the_tablet_id : it->second) {
                 _failed_channels[the_tablet_id].insert(node_id);
                 _failed_channels_msgs.emplace(the_tablet_id, err + ", host: " + host);
-                if (_failed_channels[the_tablet_id].size() >= ((_parent->_num_replicas + 1) / 2)) {
+                if (_failed_channels[the_tablet_id].size() >= _max_failed_replicas()) {
                     _intolerable_failure_status =
                             Status::InternalError(_failed_channels_msgs[the_tablet_id]);
                 }
@@ -620,7 +631,7 @@ void IndexChannel::mark_as_failed(int64_t node_id, const std::string& host, cons
         } else {
             _failed_channels[tablet_id].insert(node_id);
             _failed_channels_msgs.emplace(tablet_id, err + ", host: " + host);
-            if (_failed_channels[tablet_id].size() >= ((_parent->_num_replicas + 1) / 2)) {
+            if (_failed_channels[tablet_id].size() >= _max_failed_replicas()) {
                 _intolerable_failure_status =
                         Status::InternalError(_failed_channels_msgs[tablet_id]);
             }
@@ -628,6 +639,11 @@ void IndexChannel::mark_as_failed(int64_t node_id, const std::string& host, cons
     }
 }
 
+size_t IndexChannel::_max_failed_replicas() const {
+    // in single replica load, all replicas fail if the written one fails
+    return _parent->_write_single_replica ? 1 : (_parent->_num_replicas + 1) / 2;
+}
+
 Status IndexChannel::check_intolerable_failure() {
     std::lock_guard<SpinLock> l(_fail_lock);
     return _intolerable_failure_status;
@@ -695,6 +711,8 @@ Status OlapTableSink::init(const TDataSink& t_sink) {
     if (table_sink.__isset.send_batch_parallelism && table_sink.send_batch_parallelism > 1) {
         _send_batch_parallelism = table_sink.send_batch_parallelism;
     }
+    _write_single_replica = _is_vectorized && table_sink.__isset.write_single_replica &&
+                            table_sink.write_single_replica;
     // if distributed column list is empty, we can ensure that tablet is with random distribution info
     // and if load_to_single_tablet is set and set to true, we should find only one tablet in one partition
     // for the whole olap table sink
@@ -172,6 +172,12 @@ public:
     // called before open, used to add tablet located in this backend
     void add_tablet(const TTabletWithPartition& tablet) { _all_tablets.emplace_back(tablet); }
 
+    // called before open, used to add the replicas of the tablet which pull the rowset written
+    // by this backend in single replica load
+    void add_slave_tablet_nodes(int64_t tablet_id, const std::vector<int64_t>& slave_nodes) {
+        _slave_tablet_nodes[tablet_id] = slave_nodes;
+    }
+
     virtual Status init(RuntimeState* state);
 
     // we use open/open_wait to parallel
@@ -284,6 +290,8 @@ protected:
     RefCountClosure<PTabletWriterOpenResult>* _open_closure = nullptr;
 
     std::vector<TTabletWithPartition> _all_tablets;
+    // tablet_id -> the slave replicas of single replica load
+    std::unordered_map<int64_t, std::vector<int64_t>> _slave_tablet_nodes;
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
 
     AddBatchCounter _add_batch_counter;
@@ -347,6 +355,9 @@ private:
     friend class NodeChannel;
     friend class VNodeChannel;
 
+    // the number of failed replicas of a tablet which fails the load
+    size_t _max_failed_replicas() const;
+
     OlapTableSink* _parent;
     int64_t _index_id;
     bool _is_vectorized = false;
@@ -448,6 +459,9 @@ protected:
     int64_t _txn_id = -1;
     int _num_replicas = -1;
     int _tuple_desc_id = -1;
+    // write the rows to one replica of each tablet, the other replicas pull its rowset,
+    // only supported by the vectorized sink
+    bool _write_single_replica = false;
 
     // this is tuple descriptor of destination OLAP table
     TupleDescriptor* _output_tuple_desc = nullptr;
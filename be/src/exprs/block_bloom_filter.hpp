@@ -73,6 +73,15 @@ public:
         }
     }
 
+    // Finds the elements of 'hashes' in batch, setting results[i] to 1 if hashes[i] is
+    // found and 0 otherwise, so the results can be written into an IColumn::Filter.
+    void find_batch(const uint32_t* hashes, size_t n, uint8_t* results) const noexcept;
+
+    // The hash of the key used by insert(const Slice&) and find(const Slice&).
+    uint32_t hash(const Slice& key) const noexcept {
+        return HashUtil::murmur_hash3_32(key.data, key.size, _hash_seed);
+    }
+
     // Computes the logical OR of this filter with 'other' and stores the result in this
     // filter.
     // Notes:
@@ -148,6 +157,13 @@ private:
 
     bool bucket_find(uint32_t bucket_idx, uint32_t hash) const noexcept;
 
+    void find_batch_no_avx2(const uint32_t* hashes, size_t n, uint8_t* results) const noexcept;
+
+#ifdef __aarch64__
+    // A NEON version of BucketFind().
+    bool bucket_find_neon(uint32_t bucket_idx, uint32_t hash) const noexcept;
+#endif
+
     // Computes out[i] |= in[i] for the arrays 'in' and 'out' of length 'n' without using AVX2
     // operations.
     static void or_equal_array_no_avx2(size_t n, const uint8_t* __restrict__ in,
@@ -169,6 +185,10 @@ private:
     bool bucket_find_avx2(uint32_t bucket_idx, uint32_t hash) const noexcept
             __attribute__((__target__("avx2")));
 
+    // Same as FindBatch(), but skips the CPU check and assumes that AVX2 is available.
+    void find_batch_avx2(const uint32_t* hashes, size_t n, uint8_t* results) const noexcept
+            __attribute__((__target__("avx2")));
+
     // Computes out[i] |= in[i] for the arrays 'in' and 'out' of length 'n' using AVX2
     // instructions. 'n' must be a multiple of 32.
     static void or_equal_array_avx2(size_t n, const uint8_t* __restrict__ in,
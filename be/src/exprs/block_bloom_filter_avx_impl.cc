@@ -22,6 +22,8 @@
 
 #include <immintrin.h>
 
+#include <algorithm>
+
 #include "exprs/block_bloom_filter.hpp"
 
 namespace doris {
@@ -61,6 +63,28 @@ bool BlockBloomFilter::bucket_find_avx2(const uint32_t bucket_idx,
     return result;
 }
 
+void BlockBloomFilter::find_batch_avx2(const uint32_t* hashes, size_t n,
+                                       uint8_t* results) const noexcept {
+    // The buckets of a large filter are mostly not in cache, so compute and prefetch the
+    // buckets of several hashes before probing them.
+    static constexpr size_t kPrefetchBatch = 16;
+    uint32_t bucket_idx[kPrefetchBatch];
+    const __m256i* const directory = reinterpret_cast<const __m256i*>(_directory);
+    for (size_t start = 0; start < n; start += kPrefetchBatch) {
+        const size_t batch_size = std::min(kPrefetchBatch, n - start);
+        for (size_t i = 0; i < batch_size; ++i) {
+            bucket_idx[i] = rehash32to32(hashes[start + i]) & _directory_mask;
+            __builtin_prefetch(&directory[bucket_idx[i]]);
+        }
+        for (size_t i = 0; i < batch_size; ++i) {
+            const __m256i mask = make_mark(hashes[start + i]);
+            results[start + i] = _mm256_testc_si256(directory[bucket_idx[i]], mask);
+        }
+    }
+    // Unset the high bits of the YMM registers once for the whole batch.
+    _mm256_zeroupper();
+}
+
 void BlockBloomFilter::insert_avx2(const uint32_t hash) noexcept {
     _always_false = false;
     const uint32_t bucket_idx = rehash32to32(hash) & _directory_mask;
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -66,6 +67,14 @@ public:
 
     void add_bytes(const char* data, size_t len) { _bloom_filter->insert(Slice(data, len)); }
 
+    uint32_t hash(const char* data, size_t len) const {
+        return _bloom_filter->hash(Slice(data, len));
+    }
+
+    void find_batch(const uint32_t* hashes, size_t n, uint8_t* results) const {
+        _bloom_filter->find_batch(hashes, n, results);
+    }
+
 private:
     std::shared_ptr<doris::BlockBloomFilter> _bloom_filter;
 };
@@ -89,6 +98,35 @@ public:
 
     virtual Status get_data(char** data, int* len) = 0;
     virtual void light_copy(IBloomFilterFuncBase* other) = 0;
+
+    // The column predicates of the consumer sample the selectivity of the filter over the
+    // first `sampling_rows` rows, and stop evaluating the filter if it filters less than
+    // `min_filter_ratio` of them. The filter is shared by all the scanners of a scan node,
+    // so the decision is made once for the scan node.
+    void update_selectivity(uint64_t evaluated_rows, uint64_t passed_rows,
+                            uint64_t sampling_rows, double min_filter_ratio) {
+        if (!_sampling.load(std::memory_order_relaxed)) {
+            return;
+        }
+        uint64_t evaluated = _evaluated_rows.fetch_add(evaluated_rows) + evaluated_rows;
+        uint64_t passed = _passed_rows.fetch_add(passed_rows) + passed_rows;
+        if (evaluated >= sampling_rows && _sampling.exchange(false)) {
+            if (evaluated - passed < evaluated * min_filter_ratio) {
+                _effective.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool is_effective() const { return _effective.load(std::memory_order_relaxed); }
+    bool is_sampling() const { return _sampling.load(std::memory_order_relaxed); }
+    uint64_t sampled_rows() const { return _evaluated_rows.load(std::memory_order_relaxed); }
+    uint64_t sampled_passed_rows() const { return _passed_rows.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> _sampling {true};
+    std::atomic<bool> _effective {true};
+    std::atomic<uint64_t> _evaluated_rows {0};
+    std::atomic<uint64_t> _passed_rows {0};
 };
 
 template <class BloomFilterAdaptor>
@@ -177,6 +215,12 @@ struct CommonFindOp {
                                         const void* data) const {
         return this->find(bloom_filter, data);
     }
+    // the hash of the value in the format of the storage engine, which is probed by
+    // the batch find of the column predicates
+    ALWAYS_INLINE uint32_t hash_olap_engine(const BloomFilterAdaptor& bloom_filter,
+                                            const void* data) const {
+        return bloom_filter.hash((const char*)data, sizeof(T));
+    }
     ALWAYS_INLINE bool find(const BloomFilterAdaptor& bloom_filter, uint32_t data) const {
         return bloom_filter.test(data);
     }
@@ -201,6 +245,11 @@ struct StringFindOp {
                                         const void* data) const {
         return StringFindOp::find(bloom_filter, data);
     }
+    ALWAYS_INLINE uint32_t hash_olap_engine(const BloomFilterAdaptor& bloom_filter,
+                                            const void* data) const {
+        const auto* value = reinterpret_cast<const StringValue*>(data);
+        return bloom_filter.hash(value->ptr, value->len);
+    }
     ALWAYS_INLINE bool find(const BloomFilterAdaptor& bloom_filter, uint32_t data) const {
         return bloom_filter.test(data);
     }
@@ -213,10 +262,20 @@ struct FixedStringFindOp : public StringFindOp<BloomFilterAdaptor> {
     ALWAYS_INLINE bool find_olap_engine(const BloomFilterAdaptor& bloom_filter,
                                         const void* input_data) const {
         const auto* value = reinterpret_cast<const StringValue*>(input_data);
+        return bloom_filter.test(Slice(value->ptr, trimmed_size(value)));
+    }
+    ALWAYS_INLINE uint32_t hash_olap_engine(const BloomFilterAdaptor& bloom_filter,
+                                            const void* input_data) const {
+        const auto* value = reinterpret_cast<const StringValue*>(input_data);
+        return bloom_filter.hash(value->ptr, trimmed_size(value));
+    }
+
+private:
+    static int64_t trimmed_size(const StringValue* value) {
         int64_t size = value->len;
         char* data = value->ptr;
         while (size > 0 && data[size - 1] == '\0') size--;
-        return bloom_filter.test(Slice(value->ptr, size));
+        return size;
     }
 };
 
@@ -227,6 +286,11 @@ struct DateTimeFindOp : public CommonFindOp<DateTimeValue, BloomFilterAdaptor> {
         value.from_olap_datetime(*reinterpret_cast<const uint64_t*>(data));
         return bloom_filter.test(Slice((char*)&value, sizeof(DateTimeValue)));
     }
+    uint32_t hash_olap_engine(const BloomFilterAdaptor& bloom_filter, const void* data) const {
+        DateTimeValue value;
+        value.from_olap_datetime(*reinterpret_cast<const uint64_t*>(data));
+        return bloom_filter.hash((char*)&value, sizeof(DateTimeValue));
+    }
 };
 
 // avoid violating C/C++ aliasing rules.
@@ -246,6 +310,18 @@ struct DateFindOp : public CommonFindOp<DateTimeValue, BloomFilterAdaptor> {
         memcpy(&data_bytes, &date_value, sizeof(date_value));
         return bloom_filter.test(Slice(data_bytes, sizeof(DateTimeValue)));
     }
+    uint32_t hash_olap_engine(const BloomFilterAdaptor& bloom_filter, const void* data) const {
+        uint24_t date = *static_cast<const uint24_t*>(data);
+        uint64_t value = uint32_t(date);
+
+        DateTimeValue date_value;
+        date_value.from_olap_date(value);
+        date_value.to_datetime();
+
+        char data_bytes[sizeof(date_value)];
+        memcpy(&data_bytes, &date_value, sizeof(date_value));
+        return bloom_filter.hash(data_bytes, sizeof(DateTimeValue));
+    }
 };
 
 template <class BloomFilterAdaptor>
@@ -262,6 +338,18 @@ struct DecimalV2FindOp : public CommonFindOp<DecimalV2Value, BloomFilterAdaptor>
         memcpy(&data_bytes, &value, decimal_value_sz);
         return bloom_filter.test(Slice(data_bytes, decimal_value_sz));
     }
+    uint32_t hash_olap_engine(const BloomFilterAdaptor& bloom_filter, const void* data) const {
+        auto packed_decimal = *static_cast<const decimal12_t*>(data);
+        DecimalV2Value value;
+        int64_t int_value = packed_decimal.integer;
+        int32_t frac_value = packed_decimal.fraction;
+        value.from_olap_decimal(int_value, frac_value);
+
+        constexpr int decimal_value_sz = sizeof(DecimalV2Value);
+        char data_bytes[decimal_value_sz];
+        memcpy(&data_bytes, &value, decimal_value_sz);
+        return bloom_filter.hash(data_bytes, decimal_value_sz);
+    }
 };
 
 template <PrimitiveType type, class BloomFilterAdaptor>
@@ -325,7 +413,32 @@ public:
         return dummy.find(*this->_bloom_filter, data);
     }
 
+    // Find values[sel[0..size)] of the storage format in batch, which hashes all of them
+    // first and then probes the filter with SIMD. results[i] is set to 1 if values[sel[i]]
+    // is found and 0 otherwise, so it can be an IColumn::Filter.
+    template <typename ValueType>
+    void find_olap_engine_batch(const ValueType* values, const uint16_t* sel, uint16_t size,
+                                uint8_t* results) const {
+        DCHECK(this->_bloom_filter != nullptr);
+        uint32_t hashes[HASH_BATCH_SIZE];
+        for (uint16_t start = 0; start < size; start += HASH_BATCH_SIZE) {
+            uint16_t batch_size = std::min<uint16_t>(HASH_BATCH_SIZE, size - start);
+            for (uint16_t i = 0; i < batch_size; ++i) {
+                hashes[i] = dummy.hash_olap_engine(*this->_bloom_filter, &values[sel[start + i]]);
+            }
+            this->_bloom_filter->find_batch(hashes, batch_size, results + start);
+        }
+    }
+
+    // The same as above for the hashes computed already, e.g. by dictionary columns.
+    void find_uint32_t_batch(const uint32_t* hashes, uint16_t size, uint8_t* results) const {
+        DCHECK(this->_bloom_filter != nullptr);
+        this->_bloom_filter->find_batch(hashes, size, results);
+    }
+
 private:
+    static constexpr uint16_t HASH_BATCH_SIZE = 256;
+
     typename BloomFilterTypeTraits<type, BloomFilterAdaptor>::FindOp dummy;
 };
 
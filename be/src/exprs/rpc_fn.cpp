@@ -19,8 +19,12 @@
 
 #include <fmt/format.h>
 
+#include <deque>
+
+#include "common/config.h"
 #include "runtime/fragment_mgr.h"
 #include "util/brpc_client_cache.h"
+#include "util/defer_op.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_vector.h"
 #include "vec/core/block.h"
@@ -739,20 +743,22 @@ void convert_to_block(vectorized::Block& block, const PValues& result, size_t po
         block.replace_by_position(pos, std::move(column));
     }
 }
-Status RPCFn::vec_call(FunctionContext* context, vectorized::Block& block,
-                       const vectorized::ColumnNumbers& arguments, size_t result,
-                       size_t input_rows_count) {
-    PFunctionCallRequest request;
-    PFunctionCallResponse response;
-    request.set_function_name(_function_name);
-    convert_block_to_proto(block, arguments, input_rows_count, &request);
-    brpc::Controller cntl;
-    _client->fn_call(&cntl, &request, &response, nullptr);
-    if (cntl.Failed()) {
-        return Status::InternalError(
-                fmt::format("call to rpc function {} failed: {}", _signature, cntl.ErrorText())
-                        .c_str());
+void RPCFn::_send_vec_call(vectorized::Block& block, const vectorized::ColumnNumbers& arguments,
+                           size_t rows, VecCall* call) {
+    call->rows = rows;
+    call->request.set_function_name(_function_name);
+    convert_block_to_proto(block, arguments, rows, &call->request);
+    call->cid = call->cntl.call_id();
+    _client->fn_call(&call->cntl, &call->request, &call->response, brpc::DoNothing());
+}
+
+Status RPCFn::_join_vec_call(VecCall* call) {
+    brpc::Join(call->cid);
+    if (call->cntl.Failed()) {
+        return Status::InternalError(fmt::format("call to rpc function {} failed: {}", _signature,
+                                                 call->cntl.ErrorText()));
     }
+    const PFunctionCallResponse& response = call->response;
     if (!response.has_status() || response.result_size() == 0) {
         return Status::InternalError(fmt::format(
                 "call rpc function {} failed: status or result is not set.", _signature));
@@ -761,7 +767,69 @@ Status RPCFn::vec_call(FunctionContext* context, vectorized::Block& block,
         return Status::InternalError(fmt::format("call to rpc function {} failed: {}", _signature,
                                                  response.status().DebugString()));
     }
-    convert_to_block(block, response.result(0), result);
+    return Status::OK();
+}
+
+Status RPCFn::vec_call(FunctionContext* context, vectorized::Block& block,
+                       const vectorized::ColumnNumbers& arguments, size_t result,
+                       size_t input_rows_count) {
+    size_t batch_rows = config::rpc_udf_batch_rows > 0 ? config::rpc_udf_batch_rows : 0;
+    if (batch_rows == 0 || input_rows_count <= batch_rows) {
+        VecCall call;
+        _send_vec_call(block, arguments, input_rows_count, &call);
+        RETURN_IF_ERROR(_join_vec_call(&call));
+        convert_to_block(block, call.response.result(0), result);
+        return Status::OK();
+    }
+
+    // Split the block into several calls, and keep at most max_inflight of them inflight.
+    // The results are received in the order of the calls and appended to the result column.
+    size_t max_inflight = std::max(config::rpc_udf_max_inflight_calls, 1);
+    auto result_type = block.get_by_position(result).type;
+    auto result_column = result_type->create_column();
+    result_column->reserve(input_rows_count);
+    std::deque<std::unique_ptr<VecCall>> inflight;
+    // the controllers must not be destroyed before their calls finish
+    Defer join_inflight {[&]() {
+        for (auto& call : inflight) {
+            brpc::Join(call->cid);
+        }
+    }};
+    auto receive = [&]() {
+        std::unique_ptr<VecCall> call = std::move(inflight.front());
+        inflight.pop_front();
+        RETURN_IF_ERROR(_join_vec_call(call.get()));
+        vectorized::Block result_block;
+        result_block.insert({result_type->create_column(), result_type, ""});
+        convert_to_block(result_block, call->response.result(0), 0);
+        const auto& column = result_block.get_by_position(0).column;
+        if (column->size() != call->rows) {
+            return Status::InternalError(
+                    fmt::format("call rpc function {} failed: {} results of {} rows", _signature,
+                                column->size(), call->rows));
+        }
+        result_column->insert_range_from(*column, 0, call->rows);
+        return Status::OK();
+    };
+    for (size_t start = 0; start < input_rows_count; start += batch_rows) {
+        if (inflight.size() >= max_inflight) {
+            RETURN_IF_ERROR(receive());
+        }
+        size_t rows = std::min(batch_rows, input_rows_count - start);
+        vectorized::Block chunk;
+        vectorized::ColumnNumbers chunk_arguments;
+        for (size_t col_idx : arguments) {
+            const auto& column = block.get_by_position(col_idx);
+            chunk_arguments.push_back(chunk.columns());
+            chunk.insert({column.column->cut(start, rows), column.type, column.name});
+        }
+        inflight.push_back(std::make_unique<VecCall>());
+        _send_vec_call(chunk, chunk_arguments, rows, inflight.back().get());
+    }
+    while (!inflight.empty()) {
+        RETURN_IF_ERROR(receive());
+    }
+    block.replace_by_position(result, std::move(result_column));
     return Status::OK();
 }
 } // namespace doris
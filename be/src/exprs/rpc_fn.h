@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <brpc/controller.h>
+
 #include <memory>
 #include <string>
 
@@ -60,6 +62,17 @@ private:
                          const std::vector<Expr*>& exprs);
     void cancel(const std::string& msg);
 
+    struct VecCall {
+        PFunctionCallRequest request;
+        PFunctionCallResponse response;
+        brpc::Controller cntl;
+        brpc::CallId cid;
+        size_t rows;
+    };
+    void _send_vec_call(vectorized::Block& block, const std::vector<size_t>& arguments,
+                        size_t rows, VecCall* call);
+    Status _join_vec_call(VecCall* call);
+
     std::shared_ptr<PFunctionService_Stub> _client;
     RuntimeState* _state;
     std::string _function_name;
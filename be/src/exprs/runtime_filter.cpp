@@ -17,8 +17,10 @@
 
 #include "runtime_filter.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exprs/binary_predicate.h"
@@ -35,10 +37,15 @@
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
+#include "util/bit_util.h"
+#include "util/block_compression.h"
 #include "util/runtime_profile.h"
 #include "util/string_parser.hpp"
 
 namespace doris {
+// the false positive probability of the bloom filters sized for the build side
+static constexpr double ADAPTIVE_BLOOM_FILTER_FPP = 0.05;
+
 // PrimitiveType->TExprNodeType
 // TODO: use constexpr if we use c++14
 TExprNodeType::type get_expr_node_type(PrimitiveType type) {
@@ -375,6 +382,30 @@ public:
         }
     }
 
+    // Re-create the bloom filter with the size for the ndv of the build side, must be
+    // called before any value is inserted.
+    Status resize_bloom_filter(int64_t build_ndv) {
+        DCHECK(_filter_type == RuntimeFilterType::BLOOM_FILTER ||
+               _filter_type == RuntimeFilterType::IN_OR_BLOOM_FILTER);
+        DCHECK(_bloomfilter_func != nullptr);
+        int64_t size = IRuntimeFilter::bloom_filter_size_for_ndv(build_ndv);
+        if (size == bloom_filter_size()) {
+            return Status::OK();
+        }
+        _bloomfilter_func.reset(create_bloom_filter(_column_return_type));
+        return _bloomfilter_func->init_with_fixed_length(size);
+    }
+
+    int64_t bloom_filter_size() {
+        if (_bloomfilter_func == nullptr) {
+            return 0;
+        }
+        char* data = nullptr;
+        int len = 0;
+        _bloomfilter_func->get_data(&data, &len);
+        return len;
+    }
+
     void insert(const void* data) {
         switch (_filter_type) {
         case RuntimeFilterType::IN_FILTER: {
@@ -1078,6 +1109,24 @@ Status IRuntimeFilter::create_wrapper(const UpdateRuntimeFilterParams* param, Ob
     return _create_wrapper(param, pool, wrapper);
 }
 
+int64_t IRuntimeFilter::bloom_filter_size_for_ndv(int64_t ndv) {
+    int64_t min_size = BitUtil::RoundUpToPowerOfTwo(
+            std::max<int64_t>(config::runtime_bloom_filter_min_size_bytes, 1));
+    int64_t max_size = std::max(
+            min_size, BitUtil::RoundUpToPowerOfTwo(config::runtime_bloom_filter_max_size_bytes));
+    // the filter for more values than this is always of the max size, and the bits
+    // computed for them may overflow
+    ndv = std::min(std::max<int64_t>(ndv, 0), max_size * 2);
+    int64_t size = CurrentBloomFilterAdaptor::optimal_bit_num(ndv, ADAPTIVE_BLOOM_FILTER_FPP);
+    return std::clamp(size, min_size, max_size);
+}
+
+Status IRuntimeFilter::resize_bloom_filter(int64_t build_ndv) {
+    DCHECK(is_producer());
+    DCHECK(!_has_remote_target);
+    return _wrapper->resize_bloom_filter(build_ndv);
+}
+
 void IRuntimeFilter::change_to_bloom_filter() {
     auto origin_type = _wrapper->get_real_type();
     _wrapper->change_to_bloom_filter();
@@ -1101,7 +1150,23 @@ Status IRuntimeFilter::_create_wrapper(const T* param, ObjectPool* pool,
     }
     case PFilterType::BLOOM_FILTER: {
         DCHECK(param->request->has_bloom_filter());
-        return (*wrapper)->assign(&param->request->bloom_filter(), param->data);
+        const PBloomFilter& bloom_filter = param->request->bloom_filter();
+        if (bloom_filter.has_compression_type() &&
+            bloom_filter.compression_type() != segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            std::unique_ptr<BlockCompressionCodec> codec;
+            RETURN_IF_ERROR(get_block_compression_codec(bloom_filter.compression_type(), codec));
+            std::unique_ptr<char[]> buf(new char[bloom_filter.filter_length()]);
+            Slice decompressed(buf.get(), bloom_filter.filter_length());
+            RETURN_IF_ERROR(codec->decompress(
+                    Slice(param->data, bloom_filter.compressed_length()), &decompressed));
+            if (decompressed.size != bloom_filter.filter_length()) {
+                return Status::Corruption(
+                        fmt::format("bad compressed bloom filter, expect {} bytes, got {}",
+                                    bloom_filter.filter_length(), decompressed.size));
+            }
+            return (*wrapper)->assign(&bloom_filter, buf.get());
+        }
+        return (*wrapper)->assign(&bloom_filter, param->data);
     }
     case PFilterType::MINMAX_FILTER: {
         DCHECK(param->request->has_minmax_filter());
@@ -1131,6 +1196,10 @@ void IRuntimeFilter::update_runtime_filter_type_to_profile() {
     if (_profile.get() != nullptr) {
         _profile->add_info_string("RealRuntimeFilterType",
                                   ::doris::to_string(_wrapper->get_real_type()));
+        if (_wrapper->get_real_type() == RuntimeFilterType::BLOOM_FILTER) {
+            _profile->add_info_string("BloomFilterSize",
+                                      std::to_string(_wrapper->bloom_filter_size()));
+        }
     }
 }
 
@@ -1138,6 +1207,13 @@ void IRuntimeFilter::set_push_down_profile() {
     _profile->add_info_string("HasPushDownToEngine", "true");
 }
 
+void IRuntimeFilter::update_selectivity_to_profile(uint64_t sampled_rows, uint64_t passed_rows,
+                                                   bool effective) {
+    _profile->add_info_string("SampledRows", std::to_string(sampled_rows));
+    _profile->add_info_string("SampledPassedRows", std::to_string(passed_rows));
+    _profile->add_info_string("IsEffective", effective ? "true" : "false");
+}
+
 void IRuntimeFilter::ready_for_publish() {
     _wrapper->ready_for_publish();
 }
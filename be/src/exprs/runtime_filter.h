@@ -27,6 +27,10 @@
 #include "util/time.h"
 #include "util/uid_util.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace doris {
 class Predicate;
 class ObjectPool;
@@ -41,6 +45,8 @@ class TRuntimeFilterDesc;
 class RowDescriptor;
 class PInFilter;
 class PMinMaxFilter;
+class PBloomFilter;
+class RuntimeFilterLocalMerger;
 class HashJoinNode;
 class RuntimeProfile;
 
@@ -195,6 +201,10 @@ public:
     static Status create_wrapper(const UpdateRuntimeFilterParams* param, ObjectPool* pool,
                                  std::unique_ptr<RuntimePredicateWrapper>* wrapper);
     void change_to_bloom_filter();
+    // Size the bloom filter for the ndv of the build side instead of the estimation of FE,
+    // only for the filters without remote targets, which are never merged.
+    Status resize_bloom_filter(int64_t build_ndv);
+    static int64_t bloom_filter_size_for_ndv(int64_t ndv);
     Status update_filter(const UpdateRuntimeFilterParams* param);
 
     void set_ignored() { _is_ignored = true; }
@@ -210,16 +220,32 @@ public:
     // consumer should call before released
     Status consumer_close();
 
+    // Merge the filter with the ones of the other `producer_num` producers on this BE
+    // before pushing it to remote node, only the last producer pushes the merged filter.
+    void set_local_merger(RuntimeFilterLocalMerger* merger, int producer_num) {
+        _local_merger = merger;
+        _local_producer_num = producer_num;
+    }
+
     // async push runtimefilter to remote node
     Status push_to_remote(RuntimeState* state, const TNetworkAddress* addr);
     Status join_rpc();
 
+    // Append the serialized bloom filter to the rpc attachment, compressed when it is
+    // large enough and compressible, which is recorded in `bloom_filter`.
+    static void append_bloom_filter_to_attachment(PBloomFilter* bloom_filter, const void* data,
+                                                  int len, butil::IOBuf* attachment);
+
     void init_profile(RuntimeProfile* parent_profile);
 
     void update_runtime_filter_type_to_profile();
 
     void set_push_down_profile();
 
+    // the selectivity sampled by the pushed down bloom filter predicates
+    void update_selectivity_to_profile(uint64_t sampled_rows, uint64_t passed_rows,
+                                       bool effective);
+
     void ready_for_publish();
 
 protected:
@@ -283,6 +309,10 @@ protected:
     struct rpc_context;
     std::shared_ptr<rpc_context> _rpc_context;
 
+    // only for the producers whose filters are merged on this BE
+    RuntimeFilterLocalMerger* _local_merger = nullptr;
+    int _local_producer_num = 1;
+
     // parent profile
     // only effect on consumer
     std::unique_ptr<RuntimeProfile> _profile;
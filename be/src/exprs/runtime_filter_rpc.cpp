@@ -19,7 +19,9 @@
 #include "common/status.h"
 #include "exprs/runtime_filter.h"
 #include "runtime/exec_env.h"
+#include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
+#include "util/block_compression.h"
 
 // for rpc
 #include "gen_cpp/internal_service.pb.h"
@@ -62,12 +64,37 @@ Status IRuntimeFilter::push_to_remote(RuntimeState* state, const TNetworkAddress
     _rpc_context->cid = _rpc_context->cntl.call_id();
 
     Status serialize_status = serialize(&_rpc_context->request, &data, &len);
+    if (serialize_status.ok() && _local_merger != nullptr) {
+        IRuntimeFilter* merged_filter = nullptr;
+        serialize_status = _local_merger->merge(&_rpc_context->request,
+                                                static_cast<const char*>(data), &merged_filter);
+        if (serialize_status.ok() && merged_filter == nullptr) {
+            // the last producer on this BE will push the merged filter
+            _rpc_context.reset();
+            return Status::OK();
+        }
+        if (serialize_status.ok()) {
+            _rpc_context->request.clear_minmax_filter();
+            _rpc_context->request.clear_bloom_filter();
+            _rpc_context->request.clear_in_filter();
+            data = nullptr;
+            len = 0;
+            serialize_status = merged_filter->serialize(&_rpc_context->request, &data, &len);
+            _rpc_context->request.set_merged_instance_num(_local_producer_num);
+        }
+    }
     if (serialize_status.ok()) {
         VLOG_NOTICE << "Producer:" << _rpc_context->request.ShortDebugString() << addr->hostname
                     << ":" << addr->port;
         if (len > 0) {
             DCHECK(data != nullptr);
-            _rpc_context->cntl.request_attachment().append(data, len);
+            if (_rpc_context->request.has_bloom_filter()) {
+                append_bloom_filter_to_attachment(_rpc_context->request.mutable_bloom_filter(),
+                                                  data, len,
+                                                  &_rpc_context->cntl.request_attachment());
+            } else {
+                _rpc_context->cntl.request_attachment().append(data, len);
+            }
         }
         if (config::runtime_filter_use_async_rpc) {
             stub->merge_filter(&_rpc_context->cntl, &_rpc_context->request, &_rpc_context->response,
@@ -85,6 +112,33 @@ Status IRuntimeFilter::push_to_remote(RuntimeState* state, const TNetworkAddress
     return serialize_status;
 }
 
+void IRuntimeFilter::append_bloom_filter_to_attachment(PBloomFilter* bloom_filter,
+                                                       const void* data, int len,
+                                                       butil::IOBuf* attachment) {
+    if (config::runtime_filter_compression_min_bytes > 0 &&
+        len >= config::runtime_filter_compression_min_bytes) {
+        std::unique_ptr<BlockCompressionCodec> codec;
+        Status st = get_block_compression_codec(segment_v2::CompressionTypePB::LZ4, codec);
+        if (st.ok()) {
+            std::unique_ptr<char[]> buf(new char[codec->max_compressed_len(len)]);
+            Slice compressed(buf.get(), codec->max_compressed_len(len));
+            st = codec->compress(Slice(static_cast<const char*>(data), len), &compressed);
+            // the filters of a small build side are sparse and compress well, while the
+            // dense ones are sent as they are
+            if (st.ok() && compressed.size < len * 0.9) {
+                bloom_filter->set_compression_type(segment_v2::CompressionTypePB::LZ4);
+                bloom_filter->set_compressed_length(compressed.size);
+                attachment->append(compressed.data, compressed.size);
+                return;
+            }
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to compress runtime bloom filter: " << st;
+        }
+    }
+    attachment->append(data, len);
+}
+
 Status IRuntimeFilter::join_rpc() {
     DCHECK(is_producer());
     if (_rpc_context != nullptr) {
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "common/config.h"
 #include "exprs/runtime_filter.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
@@ -140,6 +141,15 @@ public:
                 continue;
             }
 
+            // the bloom filters merged with the ones of other instances must keep the
+            // same size, so only the local ones are sized for the hash table
+            if (config::enable_runtime_bloom_filter_adaptive_size &&
+                !runtime_filter->has_remote_target() &&
+                (runtime_filter->type() == RuntimeFilterType::BLOOM_FILTER ||
+                 runtime_filter->type() == RuntimeFilterType::IN_OR_BLOOM_FILTER)) {
+                RETURN_IF_ERROR(runtime_filter->resize_bloom_filter(hash_table_size));
+            }
+
             if ((runtime_filter->type() == RuntimeFilterType::IN_FILTER) ||
                 (runtime_filter->type() == RuntimeFilterType::IN_OR_BLOOM_FILTER &&
                  !over_max_in_num)) {
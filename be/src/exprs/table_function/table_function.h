@@ -64,6 +64,40 @@ public:
                 fmt::format("vectorized table function {} not supported now.", _fn_name));
     }
 
+    // only used for vectorized.
+    // Expand the rows of the block given to process_init() from `*row_idx` at once, instead of
+    // calling process_row() and get_value() per output value. The values are appended to
+    // `column` and the end offset of each row in it to `offsets`, it stops at the end of the
+    // `rows` rows or once `column` holds `max_values` values, `*row_idx` is the next row.
+    virtual Status process_batch(size_t* row_idx, size_t rows, size_t max_values,
+                                 vectorized::IColumn::Offsets* offsets,
+                                 vectorized::IColumn* column) {
+        for (; *row_idx < rows && column->size() < max_values; ++*row_idx) {
+            RETURN_IF_ERROR(process_row(*row_idx));
+            if (_is_current_empty) {
+                if (_is_outer) {
+                    column->insert_default();
+                }
+            } else {
+                bool eos = false;
+                while (!eos) {
+                    void* value = nullptr;
+                    int64_t length = 0;
+                    RETURN_IF_ERROR(get_value(&value));
+                    RETURN_IF_ERROR(get_value_length(&length));
+                    if (value == nullptr) {
+                        column->insert_default();
+                    } else {
+                        column->insert_data(reinterpret_cast<char*>(value), length);
+                    }
+                    RETURN_IF_ERROR(forward(&eos));
+                }
+            }
+            offsets->push_back(column->size());
+        }
+        return Status::OK();
+    }
+
     virtual Status reset() = 0;
 
     virtual Status get_value(void** output) = 0;
@@ -25,6 +25,7 @@
 #include "http/http_request.h"
 #include "http/http_response.h"
 #include "http/http_status.h"
+#include "olap/page_cache_warmer.h"
 
 namespace doris {
 
@@ -37,6 +38,11 @@ void HealthAction::handle(HttpRequest* req) {
     ss << "{";
     ss << "\"status\": \"OK\",";
     ss << "\"msg\": \"To Be Added\"";
+    // the BE serves the queries while warming up, so it's healthy anyway
+    auto warmer = PageCacheWarmer::instance();
+    if (warmer != nullptr) {
+        ss << ",\"page_cache_warmed_up\": " << (warmer->warmed_up() ? "true" : "false");
+    }
     ss << "}";
     std::string result = ss.str();
 
@@ -40,6 +40,8 @@
 #include "util/bfd_parser.h"
 #include "util/file_utils.h"
 #include "util/pprof_utils.h"
+#include "util/sampling_profiler.h"
+#include "util/uid_util.h"
 
 namespace doris {
 
@@ -194,6 +196,50 @@ void ProfileAction::handle(HttpRequest* req) {
 #endif
 }
 
+// Samples the CPU by SamplingProfiler, returns the folded stacks for flamegraph.pl.
+//   /pprof/query_profile?seconds=30&frequency=99&query_id=<id>
+class QueryProfileAction : public HttpHandler {
+public:
+    QueryProfileAction() {}
+    virtual ~QueryProfileAction() {}
+
+    virtual void handle(HttpRequest* req) override;
+};
+
+void QueryProfileAction::handle(HttpRequest* req) {
+    // shares SIGPROF with the CPU profiler of gperftools
+    std::lock_guard<std::mutex> lock(kPprofActionMutex);
+
+    int seconds = kPprofDefaultSampleSecs;
+    const std::string& seconds_str = req->param(SECOND_KEY);
+    if (!seconds_str.empty()) {
+        seconds = std::atoi(seconds_str.c_str());
+    }
+    int frequency = 99;
+    const std::string& frequency_str = req->param("frequency");
+    if (!frequency_str.empty()) {
+        frequency = std::atoi(frequency_str.c_str());
+    }
+    // a copy, parse_id() modifies the string
+    std::string query_id_str = req->param("query_id");
+    TUniqueId query_id;
+    if (!query_id_str.empty() && !parse_id(query_id_str, &query_id)) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                "invalid query_id: " + req->param("query_id"));
+        return;
+    }
+
+    std::string folded_stacks;
+    Status st = SamplingProfiler::profile(
+            seconds, frequency, req->param("query_id").empty() ? nullptr : &query_id,
+            &folded_stacks);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::INTERNAL_SERVER_ERROR, st.to_string());
+        return;
+    }
+    HttpChannel::send_reply(req, folded_stacks);
+}
+
 class PmuProfileAction : public HttpHandler {
 public:
     PmuProfileAction() {}
@@ -291,6 +337,8 @@ Status PprofActions::setup(ExecEnv* exec_env, EvHttpServer* http_server, ObjectP
     http_server->register_handler(HttpMethod::GET, "/pprof/heap", pool.add(new HeapAction()));
     http_server->register_handler(HttpMethod::GET, "/pprof/growth", pool.add(new GrowthAction()));
     http_server->register_handler(HttpMethod::GET, "/pprof/profile", pool.add(new ProfileAction()));
+    http_server->register_handler(HttpMethod::GET, "/pprof/query_profile",
+                                  pool.add(new QueryProfileAction()));
     http_server->register_handler(HttpMethod::GET, "/pprof/pmuprofile",
                                   pool.add(new PmuProfileAction()));
     http_server->register_handler(HttpMethod::GET, "/pprof/contention",
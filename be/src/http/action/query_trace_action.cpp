@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/query_trace_action.h"
+
+#include <string>
+#include <vector>
+
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "util/query_trace.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+
+void QueryTraceAction::handle(HttpRequest* req) {
+    // a copy, parse_id() modifies the string
+    std::string query_id_str = req->param("query_id");
+    const std::string& format = req->param("format");
+    TUniqueId query_id;
+    if (!query_id_str.empty() && !parse_id(query_id_str, &query_id)) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                "invalid query_id: " + req->param("query_id"));
+        return;
+    }
+    if (!format.empty() && format != "chrome" && format != "otlp") {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                "invalid format: " + format + ", should be chrome or otlp");
+        return;
+    }
+
+    const TUniqueId* query = req->param("query_id").empty() ? nullptr : &query_id;
+    std::vector<QueryTraceEvent> events;
+    QueryTracer::instance()->get_events(query, &events);
+    if (req->param("clear") == "true") {
+        QueryTracer::instance()->clear();
+    }
+    std::string trace = format == "otlp" ? QueryTracer::to_otlp_json(events, query)
+                                         : QueryTracer::to_chrome_trace(events);
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, trace);
+}
+
+} // namespace doris
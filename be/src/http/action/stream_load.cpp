@@ -46,6 +46,7 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_path_mgr.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
@@ -94,6 +95,8 @@ static TFileFormatType::type parse_format(const std::string& format_str,
             format_type = TFileFormatType::FORMAT_CSV_LZOP;
         } else if (iequal(compress_type, "DEFLATE")) {
             format_type = TFileFormatType::FORMAT_CSV_DEFLATE;
+        } else if (iequal(compress_type, "ZSTD")) {
+            format_type = TFileFormatType::FORMAT_CSV_ZSTD;
         }
     } else if (iequal(format_str, "JSON")) {
         if (compress_type.empty()) {
@@ -116,6 +119,7 @@ static bool is_format_support_streaming(TFileFormatType::type format) {
     case TFileFormatType::FORMAT_CSV_LZ4FRAME:
     case TFileFormatType::FORMAT_CSV_LZO:
     case TFileFormatType::FORMAT_CSV_LZOP:
+    case TFileFormatType::FORMAT_CSV_ZSTD:
     case TFileFormatType::FORMAT_JSON:
         return true;
     default:
@@ -194,6 +198,9 @@ Status StreamLoadAction::_handle(StreamLoadContext* ctx) {
     } else {
         RETURN_IF_ERROR(ctx->body_sink->finish());
     }
+    if (ctx->group_commit) {
+        return _exec_env->group_commit_mgr()->group_commit(ctx);
+    }
 
     // wait stream load finish
     RETURN_IF_ERROR(ctx->future.get());
@@ -332,6 +339,12 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
         }
     }
 
+    RETURN_IF_ERROR(_check_group_commit(http_req, ctx));
+    if (ctx->group_commit) {
+        // the transaction is began by the group
+        return _process_put(http_req, ctx);
+    }
+
     // begin transaction
     int64_t begin_txn_start_time = MonotonicNanos();
     RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(ctx));
@@ -341,6 +354,28 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
     return _process_put(http_req, ctx);
 }
 
+Status StreamLoadAction::_check_group_commit(HttpRequest* http_req, StreamLoadContext* ctx) {
+    if (!iequal(http_req->header(HTTP_GROUP_COMMIT), "true")) {
+        return Status::OK();
+    }
+    if (!http_req->header(HTTP_LABEL_KEY).empty()) {
+        return Status::InvalidArgument("label can not be set for group commit");
+    }
+    // Only the loads whose bodies can be simply concatenated line by line are grouped,
+    // the others are loaded as before.
+    const std::string& line_delimiter = http_req->header(HTTP_LINE_DELIMITER);
+    bool concatenable = false;
+    if (ctx->format == TFileFormatType::FORMAT_CSV_PLAIN) {
+        concatenable = ctx->header_type.empty() && line_delimiter.size() <= 1;
+    } else if (ctx->format == TFileFormatType::FORMAT_JSON) {
+        concatenable = iequal(http_req->header(HTTP_READ_JSON_BY_LINE), "true") &&
+                       line_delimiter.empty();
+    }
+    ctx->group_commit = concatenable && !ctx->two_phase_commit && ctx->body_bytes > 0 &&
+                        ctx->body_bytes <= config::group_commit_max_request_bytes;
+    return Status::OK();
+}
+
 void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     StreamLoadContext* ctx = (StreamLoadContext*)req->handler_ctx();
     if (ctx == nullptr || !ctx->status.ok()) {
@@ -351,6 +386,16 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     auto evbuf = evhttp_request_get_input_buffer(ev_req);
 
     int64_t start_read_data_time = MonotonicNanos();
+    if (config::enable_stream_load_zero_copy) {
+        auto st = _append_evbuffer(ctx, evbuf);
+        if (!st.ok()) {
+            LOG(WARNING) << "append body content failed. errmsg=" << st.get_error_msg() << ", "
+                         << ctx->brief();
+            ctx->status = st;
+        }
+        ctx->read_data_cost_nanos += (MonotonicNanos() - start_read_data_time);
+        return;
+    }
     while (evbuffer_get_length(evbuf) > 0) {
         auto bb = ByteBuffer::allocate(128 * 1024);
         auto remove_bytes = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
@@ -368,6 +413,34 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     ctx->read_data_cost_nanos += (MonotonicNanos() - start_read_data_time);
 }
 
+Status StreamLoadAction::_append_evbuffer(StreamLoadContext* ctx, struct evbuffer* evbuf) {
+    // Move the segments out of the request buffer, which doesn't copy the data, and keep
+    // them alive until all the byte buffers wrapping them are released by the reader.
+    size_t length = evbuffer_get_length(evbuf);
+    if (length == 0) {
+        return Status::OK();
+    }
+    std::shared_ptr<struct evbuffer> segments(evbuffer_new(), evbuffer_free);
+    if (segments == nullptr || evbuffer_remove_buffer(evbuf, segments.get(), length) < 0) {
+        return Status::InternalError("failed to move the http body");
+    }
+    int num_segments = evbuffer_peek(segments.get(), -1, nullptr, nullptr, 0);
+    std::vector<struct evbuffer_iovec> iovecs(num_segments);
+    evbuffer_peek(segments.get(), -1, nullptr, iovecs.data(), num_segments);
+    for (auto& iovec : iovecs) {
+        ctx->receive_bytes += iovec.iov_len;
+        // too many small chunks slow down the pipe, copy them together
+        if (iovec.iov_len < 4096) {
+            RETURN_IF_ERROR(ctx->body_sink->append(static_cast<const char*>(iovec.iov_base),
+                                                   iovec.iov_len));
+            continue;
+        }
+        RETURN_IF_ERROR(ctx->body_sink->append(
+                ByteBuffer::wrap(static_cast<char*>(iovec.iov_base), iovec.iov_len, segments)));
+    }
+    return Status::OK();
+}
+
 void StreamLoadAction::free_handler_ctx(void* param) {
     StreamLoadContext* ctx = (StreamLoadContext*)param;
     if (ctx == nullptr) {
@@ -395,7 +468,13 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
     request.formatType = ctx->format;
     request.__set_header_type(ctx->header_type);
     request.__set_loadId(ctx->id.to_thrift());
-    if (ctx->use_streaming) {
+    if (ctx->group_commit) {
+        // buffer the whole body, which is appended to the group once received
+        auto pipe = std::make_shared<StreamLoadPipe>(ctx->body_bytes + 1 /* max_buffered_bytes */,
+                                                     64 * 1024 /* min_chunk_size */);
+        request.fileType = TFileType::FILE_STREAM;
+        ctx->body_sink = pipe;
+    } else if (ctx->use_streaming) {
         auto pipe = std::make_shared<StreamLoadPipe>(kMaxPipeBufferedBytes /* max_buffered_bytes */,
                                                      64 * 1024 /* min_chunk_size */,
                                                      ctx->body_bytes /* total_length */);
@@ -528,6 +607,10 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
         }
     }
 
+    if (!http_req->header(HTTP_PARTIAL_COLUMNS).empty()) {
+        request.__set_partial_update(iequal(http_req->header(HTTP_PARTIAL_COLUMNS), "true"));
+    }
+
     if (ctx->timeout_second != -1) {
         request.__set_timeout(ctx->timeout_second);
     }
@@ -561,6 +644,12 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
         request.__set_max_filter_ratio(ctx->max_filter_ratio);
     }
 
+    if (ctx->group_commit) {
+        // planned by the group
+        ctx->put_request = request;
+        return Status::OK();
+    }
+
 #ifndef BE_TEST
     // plan this load
     TNetworkAddress master_addr = _exec_env->master_info()->network_address;
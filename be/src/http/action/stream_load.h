@@ -24,6 +24,8 @@
 #include "runtime/client_cache.h"
 #include "runtime/message_body_sink.h"
 
+struct evbuffer;
+
 namespace doris {
 
 class ExecEnv;
@@ -50,7 +52,11 @@ private:
     Status _data_saved_path(HttpRequest* req, std::string* file_path);
     Status _execute_plan_fragment(StreamLoadContext* ctx);
     Status _process_put(HttpRequest* http_req, StreamLoadContext* ctx);
+    // Set ctx->group_commit if the load asks for and can be grouped with other loads.
+    Status _check_group_commit(HttpRequest* http_req, StreamLoadContext* ctx);
     void _sava_stream_load_record(StreamLoadContext* ctx, const std::string& str);
+    // Append the http body in 'evbuf' to the body sink without copying.
+    Status _append_evbuffer(StreamLoadContext* ctx, struct evbuffer* evbuf);
 
 private:
     ExecEnv* _exec_env;
@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/tablets_scan_stats_action.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "service/backend_options.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+
+namespace {
+
+struct TabletScanStats {
+    TabletSharedPtr tablet;
+    int64_t scan_count;
+    int64_t scan_bytes;
+    int64_t scan_rows;
+    int64_t filtered_rows;
+    // the average number of the sorted runs merged by a scan
+    double read_amplification;
+    double page_cache_hit_ratio;
+};
+
+} // namespace
+
+TabletsScanStatsAction::TabletsScanStatsAction() {
+    _host = BackendOptions::get_localhost();
+}
+
+void TabletsScanStatsAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(
+            req, HttpStatus::OK,
+            get_tablets_scan_stats(req->param("limit"), req->param("order_by")).ToString());
+}
+
+EasyJson TabletsScanStatsAction::get_tablets_scan_stats(const std::string& limit,
+                                                        const std::string& order_by) {
+    EasyJson result;
+    int64_t number = 0;
+    if (limit.empty()) {
+        number = 100; // default
+    } else if (limit == "all") {
+        number = std::numeric_limits<int64_t>::max();
+    } else if (std::all_of(limit.begin(), limit.end(), ::isdigit)) {
+        number = std::atol(limit.c_str());
+    } else {
+        result["msg"] = "Parameter Error: invalid limit " + limit;
+        result["code"] = 1;
+        return result;
+    }
+    std::function<double(const TabletScanStats&)> key;
+    if (order_by.empty() || order_by == "scan_count") {
+        key = [](const TabletScanStats& stats) { return stats.scan_count; };
+    } else if (order_by == "scan_bytes") {
+        key = [](const TabletScanStats& stats) { return stats.scan_bytes; };
+    } else if (order_by == "filtered_rows") {
+        key = [](const TabletScanStats& stats) { return stats.filtered_rows; };
+    } else if (order_by == "read_amplification") {
+        key = [](const TabletScanStats& stats) { return stats.read_amplification; };
+    } else {
+        result["msg"] = "Parameter Error: invalid order_by " + order_by;
+        result["code"] = 1;
+        return result;
+    }
+
+    std::vector<TabletSharedPtr> tablets;
+    StorageEngine::instance()->tablet_manager()->get_scanned_tablets(&tablets);
+    std::vector<TabletScanStats> tablets_stats;
+    tablets_stats.reserve(tablets.size());
+    for (auto& tablet : tablets) {
+        TabletScanStats stats;
+        stats.tablet = tablet;
+        stats.scan_count = tablet->query_scan_count->value();
+        stats.scan_bytes = tablet->query_scan_bytes->value();
+        stats.scan_rows = tablet->query_scan_rows->value();
+        stats.filtered_rows = tablet->query_scan_filtered_rows->value();
+        stats.read_amplification =
+                static_cast<double>(tablet->query_scan_sorted_runs->value()) / stats.scan_count;
+        int64_t pages = tablet->query_scan_pages->value();
+        stats.page_cache_hit_ratio =
+                pages > 0 ? static_cast<double>(tablet->query_scan_cached_pages->value()) / pages
+                          : 0;
+        tablets_stats.push_back(std::move(stats));
+    }
+    size_t num = std::min<size_t>(number, tablets_stats.size());
+    std::partial_sort(tablets_stats.begin(), tablets_stats.begin() + num, tablets_stats.end(),
+                      [&key](const TabletScanStats& a, const TabletScanStats& b) {
+                          return key(a) > key(b);
+                      });
+    tablets_stats.resize(num);
+
+    result["msg"] = "OK";
+    result["code"] = 0;
+    EasyJson data = result.Set("data", EasyJson::kObject);
+    data["host"] = _host;
+    EasyJson tablets_ej = data.Set("tablets", EasyJson::kArray);
+    for (auto& stats : tablets_stats) {
+        EasyJson tablet = tablets_ej.PushBack(EasyJson::kObject);
+        tablet["tablet_id"] = stats.tablet->tablet_id();
+        tablet["partition_id"] = stats.tablet->partition_id();
+        tablet["scan_count"] = stats.scan_count;
+        tablet["scan_bytes"] = stats.scan_bytes;
+        tablet["scan_rows"] = stats.scan_rows;
+        tablet["filtered_rows"] = stats.filtered_rows;
+        tablet["read_amplification"] = stats.read_amplification;
+        tablet["page_cache_hit_ratio"] = stats.page_cache_hit_ratio;
+        tablet["version_count"] = stats.tablet->version_count();
+    }
+    result["count"] = tablets_stats.size();
+    return result;
+}
+} // namespace doris
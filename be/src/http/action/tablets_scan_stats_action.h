@@ -0,0 +1,44 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "http/http_handler.h"
+#include "util/easy_json.h"
+
+namespace doris {
+
+// Get the scan statistics of the hot tablets from http API, to find the skewed tablets and
+// the ones with high read amplification.
+//
+// Params:
+//   limit: the number of the tablets to return, 100 by default, or "all".
+//   order_by: scan_count (default), scan_bytes, filtered_rows or read_amplification, the
+//             tablets are returned in the descending order of it.
+class TabletsScanStatsAction : public HttpHandler {
+public:
+    TabletsScanStatsAction();
+    void handle(HttpRequest* req) override;
+    EasyJson get_tablets_scan_stats(const std::string& limit, const std::string& order_by);
+    std::string host() { return _host; }
+
+private:
+    std::string _host;
+};
+} // namespace doris
@@ -0,0 +1,126 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/workload_group_action.h"
+
+#include <string>
+
+#include "gutil/strings/numbers.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/workload_group_mgr.h"
+#include "util/mem_info.h"
+#include "util/parse_util.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+
+void WorkloadGroupAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    if (req->method() == HttpMethod::GET) {
+        HttpChannel::send_reply(req, HttpStatus::OK, _show_groups().ToString());
+        return;
+    }
+    LOG(INFO) << req->debug_string();
+    Status st = req->method() == HttpMethod::DELETE ? _handle_drop(req) : _handle_update(req);
+    EasyJson result;
+    result["status"] = st.ok() ? "OK" : "BAD";
+    result["msg"] = st.ok() ? "" : st.get_error_msg();
+    HttpChannel::send_reply(req, st.ok() ? HttpStatus::OK : HttpStatus::BAD_REQUEST,
+                            result.ToString());
+}
+
+Status WorkloadGroupAction::_handle_update(HttpRequest* req) {
+    const std::string& name = req->param("name");
+    if (name.empty()) {
+        return Status::InvalidArgument("name of workload group is required");
+    }
+    WorkloadGroupInfo info;
+    auto group = _exec_env->workload_group_mgr()->get_group(name);
+    if (group != nullptr) {
+        info = group->info();
+    }
+    info.name = name;
+
+    const std::string& cpu_share = req->param("cpu_share");
+    if (!cpu_share.empty() && !safe_strto32(cpu_share, &info.cpu_share)) {
+        return Status::InvalidArgument("invalid cpu_share: " + cpu_share);
+    }
+    const std::string& memory_limit = req->param("memory_limit");
+    if (memory_limit == "-1") {
+        info.memory_limit = -1;
+    } else if (!memory_limit.empty()) {
+        bool is_percent = false;
+        info.memory_limit = ParseUtil::parse_mem_spec(
+                memory_limit, _exec_env->query_pool_mem_tracker()->limit(),
+                MemInfo::physical_mem(), &is_percent);
+        if (info.memory_limit <= 0) {
+            return Status::InvalidArgument("invalid memory_limit: " + memory_limit);
+        }
+    }
+    const std::string& scan_thread_num = req->param("scan_thread_num");
+    if (!scan_thread_num.empty() && !safe_strto32(scan_thread_num, &info.scan_thread_num)) {
+        return Status::InvalidArgument("invalid scan_thread_num: " + scan_thread_num);
+    }
+    const std::string& memory_policy = req->param("memory_policy");
+    if (memory_policy == "fail") {
+        info.memory_policy = WorkloadGroupMemoryPolicy::FAIL;
+    } else if (memory_policy == "cancel") {
+        info.memory_policy = WorkloadGroupMemoryPolicy::CANCEL;
+    } else if (!memory_policy.empty()) {
+        return Status::InvalidArgument("invalid memory_policy: " + memory_policy +
+                                       ", should be fail or cancel");
+    }
+    return _exec_env->workload_group_mgr()->create_or_update_group(info);
+}
+
+Status WorkloadGroupAction::_handle_drop(HttpRequest* req) {
+    const std::string& name = req->param("name");
+    if (name.empty()) {
+        return Status::InvalidArgument("name of workload group is required");
+    }
+    return _exec_env->workload_group_mgr()->drop_group(name);
+}
+
+EasyJson WorkloadGroupAction::_show_groups() {
+    std::vector<std::shared_ptr<WorkloadGroup>> groups;
+    _exec_env->workload_group_mgr()->get_groups(&groups);
+
+    EasyJson result;
+    result["status"] = "OK";
+    EasyJson data = result.Set("workload_groups", EasyJson::kArray);
+    for (auto& group : groups) {
+        auto info = group->info();
+        EasyJson item = data.PushBack(EasyJson::kObject);
+        item["name"] = info.name;
+        item["cpu_share"] = info.cpu_share;
+        item["memory_limit"] = info.memory_limit;
+        item["memory_used"] = group->mem_tracker()->consumption();
+        item["memory_policy"] =
+                info.memory_policy == WorkloadGroupMemoryPolicy::CANCEL ? "cancel" : "fail";
+        item["scan_thread_num"] = info.scan_thread_num;
+        item["running_scan_num"] = group->running_scan_num();
+    }
+    return result;
+}
+
+} // namespace doris
@@ -0,0 +1,52 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "common/status.h"
+#include "http/http_handler.h"
+#include "util/easy_json.h"
+
+namespace doris {
+
+class ExecEnv;
+class HttpRequest;
+
+// Manages the workload groups of the BE.
+//
+// GET    /api/workload_group: shows all the groups.
+// POST   /api/workload_group?name=xx[&cpu_share=1024][&memory_limit=10G|20%]
+//                           [&scan_thread_num=8][&memory_policy=fail|cancel]
+//        creates a group or updates it, the params not given keep their values.
+// DELETE /api/workload_group?name=xx: drops a group.
+class WorkloadGroupAction : public HttpHandler {
+public:
+    explicit WorkloadGroupAction(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    ~WorkloadGroupAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    Status _handle_update(HttpRequest* req);
+    Status _handle_drop(HttpRequest* req);
+    EasyJson _show_groups();
+
+    ExecEnv* _exec_env;
+};
+
+} // namespace doris
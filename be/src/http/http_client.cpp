@@ -17,6 +17,8 @@
 
 #include "http/http_client.h"
 
+#include <filesystem>
+
 #include "common/config.h"
 
 namespace doris {
@@ -168,10 +170,21 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
     return Status::OK();
 }
 
-Status HttpClient::download(const std::string& local_path) {
+Status HttpClient::download(const std::string& local_path, bool resume) {
     // set method to GET
     set_method(GET);
 
+    const char* mode = "w";
+    if (resume) {
+        std::error_code ec;
+        auto local_file_size = std::filesystem::file_size(local_path, ec);
+        if (!ec && local_file_size > 0) {
+            // the server responds 206 with the remaining part, or the download fails
+            curl_easy_setopt(_curl, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)local_file_size);
+            mode = "a";
+        }
+    }
+
     // TODO(zc) Move this download speed limit outside to limit download speed
     // at system level
     curl_easy_setopt(_curl, CURLOPT_LOW_SPEED_LIMIT, config::download_low_speed_limit_kbps * 1024);
@@ -179,7 +192,7 @@ Status HttpClient::download(const std::string& local_path) {
     curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
 
     auto fp_closer = [](FILE* fp) { fclose(fp); };
-    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), "w"), fp_closer);
+    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), mode), fp_closer);
     if (fp == nullptr) {
         LOG(WARNING) << "open file failed, file=" << local_path;
         return Status::InternalError("open file failed");
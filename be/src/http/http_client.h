@@ -123,8 +123,9 @@ public:
     }
 
     // helper function to download a file, you can call this function to download
-    // a file to local_path
-    Status download(const std::string& local_path);
+    // a file to local_path. If resume is true and local_path exists, only the remaining part
+    // of the file is downloaded and appended to it.
+    Status download(const std::string& local_path, bool resume = false);
 
     Status execute_post_request(const std::string& payload, std::string* response);
 
@@ -50,8 +50,10 @@ static const std::string HTTP_SEQUENCE_COL = "sequence_col";
 static const std::string HTTP_COMPRESS_TYPE = "compress_type";
 static const std::string HTTP_SEND_BATCH_PARALLELISM = "send_batch_parallelism";
 static const std::string HTTP_LOAD_TO_SINGLE_TABLET = "load_to_single_tablet";
+static const std::string HTTP_PARTIAL_COLUMNS = "partial_columns";
 
 static const std::string HTTP_TWO_PHASE_COMMIT = "two_phase_commit";
+static const std::string HTTP_GROUP_COMMIT = "group_commit";
 static const std::string HTTP_TXN_ID_KEY = "txn_id";
 static const std::string HTTP_TXN_OPERATION_KEY = "txn_operation";
 
@@ -18,8 +18,11 @@
 #include "http/utils.h"
 
 #include <fcntl.h>
+#include <fmt/format.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
@@ -108,6 +111,56 @@ std::string get_content_type(const std::string& file_name) {
     return "";
 }
 
+bool parse_range_header(const std::string& range_header, int64_t file_size, int64_t* offset,
+                        int64_t* length) {
+    const std::string k_bytes = "bytes=";
+    if (range_header.compare(0, k_bytes.size(), k_bytes) != 0) {
+        return false;
+    }
+    std::string range = range_header.substr(k_bytes.size());
+    auto pos = range.find('-');
+    // multiple ranges are not supported
+    if (pos == std::string::npos || range.find(',') != std::string::npos) {
+        return false;
+    }
+    std::string first = range.substr(0, pos);
+    std::string last = range.substr(pos + 1);
+    auto parse_number = [](const std::string& str, int64_t* value) {
+        if (str.empty() || str.size() > 18 ||
+            str.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        *value = std::stoll(str);
+        return true;
+    };
+    int64_t start = 0;
+    int64_t end = file_size - 1;
+    if (first.empty()) {
+        // the last n bytes
+        int64_t suffix_length = 0;
+        if (!parse_number(last, &suffix_length) || suffix_length == 0) {
+            return false;
+        }
+        start = std::max<int64_t>(file_size - suffix_length, 0);
+    } else {
+        if (!parse_number(first, &start)) {
+            return false;
+        }
+        if (!last.empty()) {
+            if (!parse_number(last, &end) || end < start) {
+                return false;
+            }
+            end = std::min(end, file_size - 1);
+        }
+    }
+    if (start >= file_size) {
+        return false;
+    }
+    *offset = start;
+    *length = end - start + 1;
+    return true;
+}
+
 void do_file_response(const std::string& file_path, HttpRequest* req) {
     if (file_path.find("..") != std::string::npos) {
         LOG(WARNING) << "Not allowed to read relative path: " << file_path;
@@ -134,13 +187,21 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    // a single byte range is supported to resume the downloads
+    int64_t offset = 0;
+    int64_t length = file_size;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
+    bool has_range = !range_header.empty() && req->method() != HttpMethod::HEAD;
+    if (has_range && !parse_range_header(range_header, file_size, &offset, &length)) {
+        close(fd);
+        req->add_output_header(HttpHeaders::CONTENT_RANGE,
+                               fmt::format("bytes */{}", file_size).c_str());
+        HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+        return;
     }
 
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
+    req->add_output_header(HttpHeaders::ACCEPT_RANGES, "bytes");
 
     if (req->method() == HttpMethod::HEAD) {
         close(fd);
@@ -149,6 +210,13 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
         return;
     }
 
+    if (has_range) {
+        req->add_output_header(
+                HttpHeaders::CONTENT_RANGE,
+                fmt::format("bytes {}-{}/{}", offset, offset + length - 1, file_size).c_str());
+        HttpChannel::send_file(req, fd, offset, length, HttpStatus::PARTIAL_CONTENT);
+        return;
+    }
     HttpChannel::send_file(req, fd, 0, file_size);
 }
 
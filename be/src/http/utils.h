@@ -35,6 +35,11 @@ bool parse_basic_auth(const HttpRequest& req, std::string* user, std::string* pa
 
 bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
+// parse a single byte range of the "Range" header, e.g. "bytes=0-99", "bytes=100-" or
+// "bytes=-100". return false if the range is invalid or not satisfiable.
+bool parse_range_header(const std::string& range_header, int64_t file_size, int64_t* offset,
+                        int64_t* length);
+
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
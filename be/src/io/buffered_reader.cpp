@@ -21,6 +21,7 @@
 #include <sstream>
 
 #include "common/config.h"
+#include "common/logging.h"
 #include "olap/olap_define.h"
 
 namespace doris {
@@ -32,7 +33,8 @@ BufferedReader::BufferedReader(RuntimeProfile* profile, FileReader* reader, int6
           _buffer_size(buffer_size),
           _buffer_offset(0),
           _buffer_limit(0),
-          _cur_offset(0) {
+          _cur_offset(0),
+          _enable_read_ahead(config::enable_buffered_reader_read_ahead) {
     if (_buffer_size == -1L) {
         _buffer_size = config::remote_storage_read_buffer_mb * 1024 * 1024;
     }
@@ -112,6 +114,7 @@ Status BufferedReader::_read_once(int64_t position, int64_t nbytes, int64_t* byt
         // if requested length is larger than the capacity of buffer, do not
         // need to copy the character into local buffer.
         if (nbytes > _buffer_size) {
+            RETURN_IF_ERROR(_wait_read_ahead());
             auto st = _reader->readat(position, nbytes, bytes_read, out);
             if (st.ok()) {
                 _cur_offset = position + *bytes_read;
@@ -135,15 +138,55 @@ Status BufferedReader::_read_once(int64_t position, int64_t nbytes, int64_t* byt
 
 Status BufferedReader::_fill() {
     if (_buffer_offset >= 0) {
-        int64_t bytes_read = 0;
         SCOPED_TIMER(_remote_read_timer);
-        RETURN_IF_ERROR(_reader->readat(_buffer_offset, _buffer_size, &bytes_read, _buffer));
-        _buffer_limit = _buffer_offset + bytes_read;
+        // the file is read sequentially if the buffer follows the last one
+        bool sequential = _buffer_limit > 0 && _buffer_offset == _buffer_limit;
+        bool ahead_hit = _ahead_future.valid() && _ahead_offset == _buffer_offset;
+        Status st = _wait_read_ahead();
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to read ahead, read synchronously: " << st;
+        }
+        if (ahead_hit && st.ok()) {
+            std::swap(_buffer, _ahead_buffer);
+            _buffer_limit = _buffer_offset + _ahead_bytes;
+        } else {
+            int64_t bytes_read = 0;
+            _remote_read_count++;
+            RETURN_IF_ERROR(_reader->readat(_buffer_offset, _buffer_size, &bytes_read, _buffer));
+            _buffer_limit = _buffer_offset + bytes_read;
+        }
+        if (_enable_read_ahead && (sequential || ahead_hit) && _buffer_limit > _buffer_offset) {
+            _read_ahead(_buffer_limit);
+        }
     }
     return Status::OK();
 }
 
+void BufferedReader::_read_ahead(int64_t position) {
+    DCHECK(!_ahead_future.valid());
+    if (_ahead_buffer == nullptr) {
+        _ahead_buffer = new char[_buffer_size];
+    }
+    _remote_read_count++;
+    _ahead_offset = position;
+    _ahead_bytes = 0;
+    _ahead_future = std::async(std::launch::async, [this, position]() {
+        return _reader->readat(position, _buffer_size, &_ahead_bytes, _ahead_buffer);
+    });
+}
+
+Status BufferedReader::_wait_read_ahead() {
+    if (!_ahead_future.valid()) {
+        return Status::OK();
+    }
+    // get() makes the future invalid
+    Status st = _ahead_future.get();
+    _ahead_offset = -1;
+    return st;
+}
+
 int64_t BufferedReader::size() {
+    WARN_IF_ERROR(_wait_read_ahead(), "failed to read ahead");
     return _reader->size();
 }
 
@@ -158,8 +201,10 @@ Status BufferedReader::tell(int64_t* position) {
 }
 
 void BufferedReader::close() {
+    WARN_IF_ERROR(_wait_read_ahead(), "failed to read ahead");
     _reader->close();
     SAFE_DELETE_ARRAY(_buffer);
+    SAFE_DELETE_ARRAY(_ahead_buffer);
 
     if (_read_counter != nullptr) {
         COUNTER_UPDATE(_read_counter, _read_count);
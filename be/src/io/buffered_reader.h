@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <future>
 #include <memory>
 
 #include "common/status.h"
@@ -56,6 +57,10 @@ public:
 private:
     Status _fill();
     Status _read_once(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out);
+    // read the next buffer from 'position' in the background
+    void _read_ahead(int64_t position);
+    // wait for the inflight read ahead, the inner reader can not be read concurrently
+    Status _wait_read_ahead();
 
 private:
     RuntimeProfile* _profile;
@@ -66,6 +71,12 @@ private:
     int64_t _buffer_limit;
     int64_t _cur_offset;
 
+    bool _enable_read_ahead;
+    char* _ahead_buffer = nullptr;
+    int64_t _ahead_offset = -1;
+    int64_t _ahead_bytes = 0;
+    std::future<Status> _ahead_future;
+
     int64_t _read_count = 0;
     int64_t _remote_read_count = 0;
 
@@ -0,0 +1,106 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/cache/cached_remote_file_reader.h"
+
+#include "common/logging.h"
+#include "io/cache/file_block_cache.h"
+
+namespace doris {
+namespace io {
+
+CachedRemoteFileReader::CachedRemoteFileReader(std::unique_ptr<FileReader> remote_reader,
+                                               FileBlockCache* cache)
+        : _remote_reader(std::move(remote_reader)), _cache(cache) {}
+
+Status CachedRemoteFileReader::_read_from_remote(size_t offset, Slice result) {
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(_remote_reader->read_at(offset, result, &bytes_read));
+    if (bytes_read != result.size) {
+        return Status::IOError(fmt::format("failed to read from {}(bytes read: {}, bytes req: {})",
+                                           path().native(), bytes_read, result.size));
+    }
+    return Status::OK();
+}
+
+Status CachedRemoteFileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
+    size_t file_size = size();
+    if (offset > file_size) {
+        return Status::IOError(
+                fmt::format("offset exceeds file size(offset: {}, file size: {}, path: {})", offset,
+                            file_size, path().native()));
+    }
+    size_t bytes_req = std::min(result.size, file_size - offset);
+    if (FileBlockCache::is_bypassed() || bytes_req == 0) {
+        return _remote_reader->read_at(offset, Slice(result.data, bytes_req), bytes_read);
+    }
+
+    const std::string& remote_path = path().native();
+    const size_t block_size = _cache->block_size();
+    const size_t end = offset + bytes_req;
+    std::unique_ptr<char[]> block_buf;
+    // The not admitted missed blocks are read from remote in one request if they are adjacent.
+    size_t pending_offset = offset;
+    size_t pending_size = 0;
+    auto flush_pending = [&]() -> Status {
+        if (pending_size > 0) {
+            RETURN_IF_ERROR(_read_from_remote(
+                    pending_offset, Slice(result.data + (pending_offset - offset), pending_size)));
+            pending_size = 0;
+        }
+        return Status::OK();
+    };
+
+    size_t cur = offset;
+    while (cur < end) {
+        size_t block_index = cur / block_size;
+        size_t block_offset = block_index * block_size;
+        size_t offset_in_block = cur - block_offset;
+        size_t len = std::min(end, block_offset + block_size) - cur;
+        char* to = result.data + (cur - offset);
+
+        if (_cache->read(remote_path, block_index, offset_in_block, Slice(to, len))) {
+            RETURN_IF_ERROR(flush_pending());
+        } else if (_cache->should_admit(remote_path, block_index)) {
+            RETURN_IF_ERROR(flush_pending());
+            size_t block_len = std::min(block_size, file_size - block_offset);
+            if (block_buf == nullptr) {
+                block_buf.reset(new char[block_size]);
+            }
+            Slice block(block_buf.get(), block_len);
+            RETURN_IF_ERROR(_read_from_remote(block_offset, block));
+            Status st = _cache->insert(remote_path, block_index, block);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to cache block " << block_index << " of " << remote_path
+                             << ": " << st;
+            }
+            memcpy(to, block_buf.get() + offset_in_block, len);
+        } else {
+            if (pending_size == 0) {
+                pending_offset = cur;
+            }
+            pending_size += len;
+        }
+        cur += len;
+    }
+    RETURN_IF_ERROR(flush_pending());
+    *bytes_read = bytes_req;
+    return Status::OK();
+}
+
+} // namespace io
+} // namespace doris
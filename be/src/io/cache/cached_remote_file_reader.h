@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "gutil/macros.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/path.h"
+
+namespace doris {
+namespace io {
+
+class FileBlockCache;
+
+// Reads a remote file through the local FileBlockCache.
+// Missed blocks are read from `remote_reader`, and loaded into the cache if admitted.
+class CachedRemoteFileReader final : public FileReader {
+public:
+    CachedRemoteFileReader(std::unique_ptr<FileReader> remote_reader, FileBlockCache* cache);
+
+    ~CachedRemoteFileReader() override = default;
+
+    Status close() override { return _remote_reader->close(); }
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override;
+
+    void prefetch(const std::vector<PrefetchRange>& ranges) override {
+        _remote_reader->prefetch(ranges);
+    }
+
+    bool support_prefetch() const override { return _remote_reader->support_prefetch(); }
+
+    const Path& path() const override { return _remote_reader->path(); }
+
+    size_t size() const override { return _remote_reader->size(); }
+
+private:
+    // read [offset, offset + result.size) from the remote file
+    Status _read_from_remote(size_t offset, Slice result);
+
+    std::unique_ptr<FileReader> _remote_reader;
+    FileBlockCache* _cache;
+};
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,192 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/cache/file_block_cache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "io/fs/local_file_system.h"
+#include "util/doris_metrics.h"
+
+namespace doris {
+namespace io {
+
+FileBlockCache* FileBlockCache::_s_instance = nullptr;
+thread_local bool FileBlockCache::_tls_bypass = false;
+
+Status FileBlockCache::create_global_cache(const std::string& cache_path, size_t capacity,
+                                           size_t block_size) {
+    DCHECK(_s_instance == nullptr);
+    // Intentionally leaked, so that the cached block files are not deleted at exit
+    // after the metrics are destroyed.
+    std::unique_ptr<FileBlockCache> cache(new FileBlockCache(cache_path, capacity, block_size));
+    RETURN_IF_ERROR(cache->init());
+    _s_instance = cache.release();
+    return Status::OK();
+}
+
+FileBlockCache::FileBlockCache(std::string cache_path, size_t capacity, size_t block_size)
+        : _cache_path(std::move(cache_path)), _capacity(capacity), _block_size(block_size) {}
+
+FileBlockCache::~FileBlockCache() = default;
+
+Status FileBlockCache::init() {
+    if (_block_size == 0 || _capacity < _block_size) {
+        return Status::InvalidArgument(
+                fmt::format("invalid file cache config, capacity: {}, block size: {}", _capacity,
+                            _block_size));
+    }
+    auto fs = global_local_filesystem();
+    bool exists = false;
+    RETURN_IF_ERROR(fs->exists(_cache_path, &exists));
+    if (exists) {
+        RETURN_IF_ERROR(fs->delete_directory(_cache_path));
+    }
+    RETURN_IF_ERROR(fs->create_directory(_cache_path));
+
+    _cache.reset(new_lru_cache("FileBlockCache", _capacity));
+    // each missed block takes 1 charge, remember as many keys as the blocks can be cached
+    _admission_cache.reset(new_lru_cache("FileBlockCacheAdmission", _capacity / _block_size));
+    LOG(INFO) << "file cache is enabled, path: " << _cache_path << ", capacity: " << _capacity
+              << ", block size: " << _block_size;
+    return Status::OK();
+}
+
+std::string FileBlockCache::_encode_key(const std::string& remote_path, size_t block_index) {
+    std::string key(remote_path);
+    key.append((const char*)&block_index, sizeof(block_index));
+    return key;
+}
+
+void FileBlockCache::_delete_cached_block(const CacheKey& key, void* value) {
+    auto block = reinterpret_cast<CachedBlock*>(value);
+    if (::unlink(block->local_path.c_str()) != 0 && errno != ENOENT) {
+        LOG(WARNING) << "failed to delete cached block " << block->local_path << ": "
+                     << std::strerror(errno);
+    }
+    DorisMetrics::instance()->file_cache_used_bytes->increment(-(int64_t)block->size);
+    delete block;
+}
+
+bool FileBlockCache::read(const std::string& remote_path, size_t block_index,
+                          size_t offset_in_block, Slice result) {
+    auto key = _encode_key(remote_path, block_index);
+    auto handle = _cache->lookup(key);
+    if (handle == nullptr) {
+        DorisMetrics::instance()->file_cache_miss_total->increment(1);
+        return false;
+    }
+    // The handle keeps the block file from being deleted by eviction while reading.
+    auto block = reinterpret_cast<CachedBlock*>(_cache->value(handle));
+    bool success = false;
+    if (offset_in_block + result.size <= block->size) {
+        int fd = ::open(block->local_path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            char* to = result.data;
+            size_t bytes_req = result.size;
+            size_t offset = offset_in_block;
+            while (bytes_req != 0) {
+                auto res = ::pread(fd, to, bytes_req, offset);
+                if (res < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (res <= 0) {
+                    break;
+                }
+                to += res;
+                offset += res;
+                bytes_req -= res;
+            }
+            ::close(fd);
+            success = bytes_req == 0;
+        }
+        if (!success) {
+            LOG(WARNING) << "failed to read cached block " << block->local_path << ": "
+                         << std::strerror(errno);
+        }
+    }
+    _cache->release(handle);
+    if (!success) {
+        _cache->erase(key);
+        DorisMetrics::instance()->file_cache_miss_total->increment(1);
+        return false;
+    }
+    DorisMetrics::instance()->file_cache_hit_total->increment(1);
+    DorisMetrics::instance()->file_cache_bytes_read_total->increment(result.size);
+    return true;
+}
+
+bool FileBlockCache::should_admit(const std::string& remote_path, size_t block_index) {
+    if (!config::file_cache_admit_on_second_access) {
+        return true;
+    }
+    auto key = _encode_key(remote_path, block_index);
+    auto handle = _admission_cache->lookup(key);
+    if (handle != nullptr) {
+        _admission_cache->release(handle);
+        _admission_cache->erase(key);
+        return true;
+    }
+    handle = _admission_cache->insert(key, nullptr, 1, [](const CacheKey&, void*) {});
+    _admission_cache->release(handle);
+    return false;
+}
+
+Status FileBlockCache::insert(const std::string& remote_path, size_t block_index,
+                              const Slice& data) {
+    auto local_path = fmt::format("{}/{}", _cache_path, _next_file_id++);
+    int fd = ::open(local_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return Status::IOError(
+                fmt::format("cannot open {}: {}", local_path, std::strerror(errno)));
+    }
+    const char* from = data.data;
+    size_t bytes_left = data.size;
+    while (bytes_left != 0) {
+        auto res = ::write(fd, from, bytes_left);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        if (res < 0) {
+            auto st = Status::IOError(
+                    fmt::format("cannot write to {}: {}", local_path, std::strerror(errno)));
+            ::close(fd);
+            ::unlink(local_path.c_str());
+            return st;
+        }
+        from += res;
+        bytes_left -= res;
+    }
+    ::close(fd);
+
+    auto block = new CachedBlock {std::move(local_path), data.size};
+    DorisMetrics::instance()->file_cache_used_bytes->increment(data.size);
+    DorisMetrics::instance()->file_cache_bytes_written_total->increment(data.size);
+    // If the same block is inserted concurrently, the replaced one is deleted by its deleter.
+    auto handle = _cache->insert(_encode_key(remote_path, block_index), block, data.size,
+                                 &FileBlockCache::_delete_cached_block);
+    _cache->release(handle);
+    return Status::OK();
+}
+
+} // namespace io
+} // namespace doris
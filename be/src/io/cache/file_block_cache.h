@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+#include "olap/lru_cache.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace io {
+
+// A block-granular cache of remote file data on local disk.
+//
+// A remote file is split into blocks of `block_size` bytes, and each cached block is
+// stored as a local file under `cache_path`. Blocks are evicted in LRU order once
+// their total size exceeds `capacity`. When `file_cache_admit_on_second_access` is set,
+// a block is only admitted on its second miss, so that a one-off scan does not evict
+// the blocks of repeated queries.
+//
+// Cached blocks are not kept across restart, the cache path is cleared in init().
+// This class is thread-safe.
+class FileBlockCache {
+public:
+    // Create global instance of this class
+    static Status create_global_cache(const std::string& cache_path, size_t capacity,
+                                      size_t block_size);
+
+    // Return global instance, nullptr if the file cache is not enabled.
+    static FileBlockCache* instance() { return _s_instance; }
+
+    FileBlockCache(std::string cache_path, size_t capacity, size_t block_size);
+    ~FileBlockCache();
+
+    Status init();
+
+    size_t block_size() const { return _block_size; }
+
+    // Read `result.size` bytes at `offset_in_block` of the given block into `result`.
+    // Return false if the block is not cached or can not be read.
+    bool read(const std::string& remote_path, size_t block_index, size_t offset_in_block,
+              Slice result);
+
+    // Return whether a missed block should be loaded into the cache.
+    bool should_admit(const std::string& remote_path, size_t block_index);
+
+    // Cache `data` as the whole content of the given block.
+    Status insert(const std::string& remote_path, size_t block_index, const Slice& data);
+
+    // Reads from the current thread bypass the file cache during the lifetime of this object.
+    // It is used by the queries which disable the file cache.
+    class ScopedBypass {
+    public:
+        explicit ScopedBypass(bool bypass) : _old(_tls_bypass) { _tls_bypass = _old || bypass; }
+        ~ScopedBypass() { _tls_bypass = _old; }
+
+    private:
+        bool _old;
+    };
+
+    static bool is_bypassed() { return _tls_bypass; }
+
+private:
+    // Value of the entries in _cache
+    struct CachedBlock {
+        std::string local_path;
+        size_t size;
+    };
+
+    static std::string _encode_key(const std::string& remote_path, size_t block_index);
+    static void _delete_cached_block(const CacheKey& key, void* value);
+
+    static FileBlockCache* _s_instance;
+    static thread_local bool _tls_bypass;
+
+    std::string _cache_path;
+    size_t _capacity;
+    size_t _block_size;
+    // used to generate unique local file names of cached blocks
+    std::atomic<uint64_t> _next_file_id {0};
+
+    std::unique_ptr<Cache> _cache;
+    // keys of the recently missed blocks, for admission control
+    std::unique_ptr<Cache> _admission_cache;
+
+    DISALLOW_COPY_AND_ASSIGN(FileBlockCache);
+};
+
+} // namespace io
+} // namespace doris
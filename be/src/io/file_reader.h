@@ -22,6 +22,7 @@
 #include <memory>
 
 #include "common/status.h"
+#include "util/byte_buffer.h"
 
 namespace doris {
 
@@ -43,6 +44,16 @@ public:
      *  other return readed bytes.
      */
     virtual Status read_one_message(std::unique_ptr<uint8_t[]>* buf, int64_t* length) = 0;
+
+    /**
+     * Return the next buffered chunk without copying it, the bytes in [pos, limit) of the
+     * buffer are the content, which must not be modified. 'buf' is set to nullptr if
+     * read eof. Only available if support_read_buffer() returns true.
+     */
+    virtual bool support_read_buffer() const { return false; }
+    virtual Status read_buffer(ByteBufferPtr* buf) {
+        return Status::NotSupported("read_buffer is not supported");
+    }
     virtual int64_t size() = 0;
     virtual Status seek(int64_t position) = 0;
     virtual Status tell(int64_t* position) = 0;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "common/status.h"
 #include "gutil/macros.h"
 #include "io/fs/path.h"
@@ -7,6 +9,12 @@
 namespace doris {
 namespace io {
 
+// A byte range [offset, offset + size) of a file
+struct PrefetchRange {
+    size_t offset;
+    size_t size;
+};
+
 class FileReader {
 public:
     FileReader() = default;
@@ -18,6 +26,13 @@ public:
 
     virtual Status read_at(size_t offset, Slice result, size_t* bytes_read) = 0;
 
+    // Hint that `ranges` will be read soon, in the given order. Readers of remote storage
+    // may fetch them in background. By default it does nothing.
+    virtual void prefetch(const std::vector<PrefetchRange>& ranges) {}
+
+    // Whether prefetch() does anything, so callers may skip computing the ranges.
+    virtual bool support_prefetch() const { return false; }
+
     virtual const Path& path() const = 0;
 
     virtual size_t size() const = 0;
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/io_limiter.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "common/config.h"
+#include "util/doris_metrics.h"
+#include "util/time.h"
+
+namespace doris {
+namespace io {
+
+static int64_t mbytes_to_bytes(int64_t mbytes) {
+    return mbytes * 1024 * 1024;
+}
+
+static int64_t max_rate() {
+    return mbytes_to_bytes(std::max<int64_t>(config::compaction_io_rate_limit_mbytes_per_sec, 0));
+}
+
+IOLimiter::IOLimiter() : _last_refill_ns(MonotonicNanos()), _rate(max_rate()) {}
+
+void IOLimiter::acquire(size_t bytes) {
+    int64_t rate = _rate.load(std::memory_order_relaxed);
+    if (rate <= 0 || bytes == 0) {
+        return;
+    }
+    int64_t wait_ns = 0;
+    {
+        std::lock_guard l(_lock);
+        int64_t now = MonotonicNanos();
+        // burst at most one second
+        _tokens = std::min<double>(rate, _tokens + (now - _last_refill_ns) * (rate / 1e9));
+        _last_refill_ns = now;
+        _tokens -= bytes;
+        if (_tokens < 0) {
+            wait_ns = static_cast<int64_t>(-_tokens / rate * 1e9);
+        }
+    }
+    if (wait_ns > 0) {
+        DorisMetrics::instance()->compaction_io_throttled_ms->increment(wait_ns / 1000000);
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+    }
+}
+
+void IOLimiter::adjust() {
+    int64_t read_count = _read_count.exchange(0, std::memory_order_relaxed);
+    int64_t latency_sum_ns = _read_latency_sum_ns.exchange(0, std::memory_order_relaxed);
+    int64_t upper = max_rate();
+    if (upper <= 0) {
+        _rate.store(0, std::memory_order_relaxed);
+        return;
+    }
+    int64_t min_rate_mbytes = std::max<int64_t>(config::compaction_io_min_rate_mbytes_per_sec, 1);
+    int64_t lower = std::min(upper, mbytes_to_bytes(min_rate_mbytes));
+    int64_t rate = _rate.load(std::memory_order_relaxed);
+    if (rate <= 0 || rate > upper) {
+        rate = upper;
+    }
+    int64_t target_ns = config::compaction_io_read_latency_target_ms * 1000000;
+    if (target_ns > 0 && read_count > 0 && latency_sum_ns / read_count > target_ns) {
+        rate = std::max(lower, rate / 2);
+    } else {
+        rate = std::min(upper, rate + upper / 10);
+    }
+    _rate.store(rate, std::memory_order_relaxed);
+}
+
+} // namespace io
+} // namespace doris
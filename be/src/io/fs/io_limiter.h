@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace doris {
+namespace io {
+
+// A token bucket limiting the I/O bandwidth of the background tasks on a disk, i.e. compaction,
+// schema change and clone, which are marked by IOLimiter::Scope. The rate is adjusted by the
+// latency of the foreground reads on the disk: it is halved when the average latency exceeds
+// the target, otherwise it grows back to the configured upper limit.
+class IOLimiter {
+public:
+    // The I/O of the current thread is limited in the scope.
+    class Scope {
+    public:
+        Scope() : _old_limited(_s_limited) { _s_limited = true; }
+        ~Scope() { _s_limited = _old_limited; }
+
+    private:
+        bool _old_limited;
+    };
+
+    static bool is_limited() { return _s_limited; }
+
+    IOLimiter();
+
+    // Waits until `bytes` tokens are available, the tokens could be borrowed from the future,
+    // so a large request never starves.
+    void acquire(size_t bytes);
+
+    // Records the latency of a foreground read.
+    void record_read_latency(int64_t latency_ns) {
+        _read_latency_sum_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+        _read_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Adjusts the rate by the foreground read latency since the last adjustment, called
+    // periodically.
+    void adjust();
+
+    // bytes per second, 0 for no limit
+    int64_t rate() const { return _rate.load(std::memory_order_relaxed); }
+
+private:
+    inline static thread_local bool _s_limited = false;
+
+    std::mutex _lock;
+    double _tokens = 0;
+    int64_t _last_refill_ns;
+
+    std::atomic<int64_t> _rate;
+    std::atomic<int64_t> _read_latency_sum_ns {0};
+    std::atomic<int64_t> _read_count {0};
+};
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,198 @@
+#include "io/fs/io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "common/logging.h"
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define DORIS_HAVE_IO_URING 1
+#endif
+
+namespace doris {
+namespace io {
+
+#ifdef DORIS_HAVE_IO_URING
+
+static int sys_io_uring_setup(uint32_t entries, io_uring_params* params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int sys_io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+bool IoUring::is_supported() {
+    static bool supported = [] {
+        IoUring ring;
+        Status st = ring.init(1);
+        if (!st.ok()) {
+            LOG(INFO) << "io_uring is not supported: " << st;
+        }
+        return st.ok();
+    }();
+    return supported;
+}
+
+Status IoUring::init(uint32_t entries) {
+    DCHECK_EQ(_ring_fd, -1);
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _ring_fd = sys_io_uring_setup(entries, &params);
+    if (_ring_fd < 0) {
+        return Status::IOError(fmt::format("io_uring_setup failed: {}", std::strerror(errno)));
+    }
+    _sq_entries = params.sq_entries;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    _ring_fd, IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+        return Status::IOError(fmt::format("failed to mmap sq ring: {}", std::strerror(errno)));
+    }
+    if (single_mmap) {
+        _cq_ring = _sq_ring;
+    } else {
+        _cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING);
+        if (_cq_ring == MAP_FAILED) {
+            _cq_ring = nullptr;
+            return Status::IOError(
+                    fmt::format("failed to mmap cq ring: {}", std::strerror(errno)));
+        }
+    }
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                 IORING_OFF_SQES);
+    if (_sqes == MAP_FAILED) {
+        _sqes = nullptr;
+        return Status::IOError(fmt::format("failed to mmap sqes: {}", std::strerror(errno)));
+    }
+
+    auto sq = reinterpret_cast<char*>(_sq_ring);
+    _sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    _sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    auto cq = reinterpret_cast<char*>(_cq_ring);
+    _cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+    return Status::OK();
+}
+
+IoUring::~IoUring() {
+    // the kernel may still write into the buffers of inflight reads, so callers
+    // must reap them before the buffers are freed
+    DCHECK_EQ(_inflight, _to_submit);
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+void IoUring::prepare_read(int fd, void* buf, uint32_t size, uint64_t offset,
+                           uint64_t user_data) {
+    DCHECK_GT(available(), 0);
+    // only this thread updates the sq tail
+    uint32_t tail = *_sq_tail;
+    uint32_t index = tail & *_sq_mask;
+    auto sqe = reinterpret_cast<io_uring_sqe*>(_sqes) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = size;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    _sq_array[index] = index;
+    __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++_inflight;
+    ++_to_submit;
+}
+
+Status IoUring::submit() {
+    while (_to_submit > 0) {
+        int ret = sys_io_uring_enter(_ring_fd, _to_submit, 0, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return Status::IOError(fmt::format("io_uring_enter failed: {}", std::strerror(errno)));
+        }
+        _to_submit -= ret;
+    }
+    return Status::OK();
+}
+
+Status IoUring::wait_completion(uint64_t* user_data, int32_t* res) {
+    DCHECK_GT(_inflight, 0);
+    RETURN_IF_ERROR(submit());
+    while (true) {
+        uint32_t head = *_cq_head;
+        uint32_t tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        if (head != tail) {
+            auto cqe = reinterpret_cast<io_uring_cqe*>(_cqes) + (head & *_cq_mask);
+            *user_data = cqe->user_data;
+            *res = cqe->res;
+            __atomic_store_n(_cq_head, head + 1, __ATOMIC_RELEASE);
+            --_inflight;
+            return Status::OK();
+        }
+        int ret = sys_io_uring_enter(_ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR) {
+            return Status::IOError(fmt::format("io_uring_enter failed: {}", std::strerror(errno)));
+        }
+    }
+}
+
+#else // DORIS_HAVE_IO_URING
+
+bool IoUring::is_supported() {
+    return false;
+}
+
+Status IoUring::init(uint32_t entries) {
+    return Status::NotSupported("io_uring is not supported by the build environment");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::prepare_read(int fd, void* buf, uint32_t size, uint64_t offset,
+                           uint64_t user_data) {
+    LOG(FATAL) << "io_uring is not supported";
+}
+
+Status IoUring::submit() {
+    return Status::NotSupported("io_uring is not supported by the build environment");
+}
+
+Status IoUring::wait_completion(uint64_t* user_data, int32_t* res) {
+    return Status::NotSupported("io_uring is not supported by the build environment");
+}
+
+#endif // DORIS_HAVE_IO_URING
+
+} // namespace io
+} // namespace doris
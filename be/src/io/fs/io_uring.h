@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+
+namespace doris {
+namespace io {
+
+// A minimal io_uring instance for asynchronous reads, using the raw system calls so that
+// no additional library is needed. Not thread-safe.
+//
+// Usage:
+//   IoUring ring;
+//   RETURN_IF_ERROR(ring.init(64));
+//   ring.prepare_read(fd, buf, size, offset, user_data);  // queue several reads
+//   RETURN_IF_ERROR(ring.submit());                      // one system call for all
+//   RETURN_IF_ERROR(ring.wait_completion(&user_data, &res));
+class IoUring {
+public:
+    IoUring() = default;
+    ~IoUring();
+
+    // Whether io_uring can be used on this host, the result is probed once.
+    static bool is_supported();
+
+    Status init(uint32_t entries);
+
+    // Number of reads which can still be prepared.
+    uint32_t available() const { return _sq_entries - _inflight; }
+
+    uint32_t inflight() const { return _inflight; }
+
+    // Queue a read of `size` bytes at `offset` of `fd` into `buf`.
+    // REQUIRES: available() > 0
+    void prepare_read(int fd, void* buf, uint32_t size, uint64_t offset, uint64_t user_data);
+
+    // Submit all prepared reads.
+    Status submit();
+
+    // Wait for a completed read. `res` is the bytes read, or -errno if failed.
+    // REQUIRES: inflight() > 0
+    Status wait_completion(uint64_t* user_data, int32_t* res);
+
+private:
+    int _ring_fd = -1;
+    uint32_t _sq_entries = 0;
+    // prepared or submitted reads whose completion is not reaped yet
+    uint32_t _inflight = 0;
+    // prepared but not submitted reads
+    uint32_t _to_submit = 0;
+
+    void* _sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    void* _cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    void* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    uint32_t* _sq_head = nullptr;
+    uint32_t* _sq_tail = nullptr;
+    uint32_t* _sq_mask = nullptr;
+    uint32_t* _sq_array = nullptr;
+    uint32_t* _cq_head = nullptr;
+    uint32_t* _cq_tail = nullptr;
+    uint32_t* _cq_mask = nullptr;
+    void* _cqes = nullptr;
+
+    DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+} // namespace io
+} // namespace doris
@@ -1,16 +1,25 @@
 #include "io/fs/local_file_reader.h"
 
+#include <fcntl.h>
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
 #include "util/doris_metrics.h"
 #include "util/errno.h"
+#include "util/time.h"
 
 namespace doris {
 namespace io {
 
 LocalFileReader::LocalFileReader(Path path, size_t file_size,
-                                 std::shared_ptr<OpenedFileHandle<int>> file_handle)
+                                 std::shared_ptr<OpenedFileHandle<int>> file_handle,
+                                 IOLimiter* io_limiter)
         : _file_handle(std::move(file_handle)),
           _path(std::move(path)),
           _file_size(file_size),
+          _io_limiter(io_limiter),
           _closed(false) {
     _fd = *_file_handle->file();
     DorisMetrics::instance()->local_file_open_reading->increment(1);
@@ -24,6 +33,12 @@ LocalFileReader::~LocalFileReader() {
 Status LocalFileReader::close() {
     bool expected = false;
     if (_closed.compare_exchange_strong(expected, true)) {
+        {
+            std::lock_guard l(_prefetch_lock);
+            _pending_ranges.clear();
+            _advised_ranges.clear();
+            _advised_bytes = 0;
+        }
         _file_handle.reset();
         DorisMetrics::instance()->local_file_open_reading->increment(-1);
     }
@@ -41,7 +56,16 @@ Status LocalFileReader::read_at(size_t offset, Slice result, size_t* bytes_read)
     char* to = result.data;
     bytes_req = std::min(bytes_req, _file_size - offset);
     *bytes_read = bytes_req;
+    if (bytes_req > 0) {
+        _consume_prefetch(offset);
+    }
 
+    // the background reads are limited, and the foreground ones are timed to adjust the limit
+    bool limited = _io_limiter != nullptr && IOLimiter::is_limited();
+    if (limited) {
+        _io_limiter->acquire(bytes_req);
+    }
+    int64_t start_ns = MonotonicNanos();
     while (bytes_req != 0) {
         auto res = ::pread(_fd, to, bytes_req, offset);
         if (-1 == res && errno != EINTR) {
@@ -57,9 +81,69 @@ Status LocalFileReader::read_at(size_t offset, Slice result, size_t* bytes_read)
             bytes_req -= res;
         }
     }
+    if (_io_limiter != nullptr && !limited && *bytes_read > 0) {
+        _io_limiter->record_read_latency(MonotonicNanos() - start_ns);
+    }
     DorisMetrics::instance()->local_bytes_read_total->increment(*bytes_read);
     return Status::OK();
 }
 
+bool LocalFileReader::support_prefetch() const {
+    return config::local_prefetch_window_bytes > 0;
+}
+
+void LocalFileReader::prefetch(const std::vector<PrefetchRange>& ranges) {
+    DCHECK(!_closed.load());
+    std::lock_guard l(_prefetch_lock);
+    for (auto& range : ranges) {
+        if (range.size == 0 || range.offset >= _file_size) {
+            continue;
+        }
+        _pending_ranges.push_back({range.offset, std::min(range.size, _file_size - range.offset)});
+    }
+    _advise_locked();
+}
+
+void LocalFileReader::_consume_prefetch(size_t offset) {
+    std::lock_guard l(_prefetch_lock);
+    if (_advised_ranges.empty()) {
+        return;
+    }
+    auto it = std::find_if(_advised_ranges.begin(), _advised_ranges.end(), [&](auto& range) {
+        return offset >= range.offset && offset < range.offset + range.size;
+    });
+    if (it == _advised_ranges.end()) {
+        return;
+    }
+    // The ranges hinted before the read one but never read are most likely for the pages
+    // skipped by the reader, drop them to go on hinting.
+    ++it;
+    for (auto drop = _advised_ranges.begin(); drop != it; ++drop) {
+        _advised_bytes -= drop->size;
+    }
+    _advised_ranges.erase(_advised_ranges.begin(), it);
+    _advise_locked();
+}
+
+void LocalFileReader::_advise_locked() {
+    const size_t window = config::local_prefetch_window_bytes;
+    while (!_pending_ranges.empty()) {
+        auto& range = _pending_ranges.front();
+        // always allow one range, in case a single range is larger than the window
+        if (!_advised_ranges.empty() && _advised_bytes + range.size > window) {
+            break;
+        }
+        int res = ::posix_fadvise(_fd, range.offset, range.size, POSIX_FADV_WILLNEED);
+        if (res != 0) {
+            LOG(WARNING) << "failed to fadvise " << _path.native() << ": " << std::strerror(res);
+            _pending_ranges.clear();
+            return;
+        }
+        _advised_bytes += range.size;
+        _advised_ranges.push_back(range);
+        _pending_ranges.pop_front();
+    }
+}
+
 } // namespace io
 } // namespace doris
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <deque>
+#include <mutex>
+
 #include "io/fs/file_reader.h"
+#include "io/fs/io_limiter.h"
 #include "io/fs/path.h"
 #include "util/file_cache.h"
 
@@ -10,7 +14,8 @@ namespace io {
 class LocalFileReader final : public FileReader {
 public:
     LocalFileReader(Path path, size_t file_size,
-                    std::shared_ptr<OpenedFileHandle<int>> file_handle);
+                    std::shared_ptr<OpenedFileHandle<int>> file_handle,
+                    IOLimiter* io_limiter = nullptr);
 
     ~LocalFileReader() override;
 
@@ -22,13 +27,31 @@ public:
 
     size_t size() const override { return _file_size; }
 
+    // The ranges are hinted to the kernel by posix_fadvise(WILLNEED) in order, while the
+    // bytes hinted but not read yet are under `local_prefetch_window_bytes`.
+    void prefetch(const std::vector<PrefetchRange>& ranges) override;
+
+    bool support_prefetch() const override;
+
 private:
+    // Drop the hinted ranges up to the one containing `offset`, and hint more.
+    void _consume_prefetch(size_t offset);
+    void _advise_locked();
+
     std::shared_ptr<OpenedFileHandle<int>> _file_handle;
     int _fd; // ref
     Path _path;
     size_t _file_size;
+    IOLimiter* _io_limiter; // ref
 
     std::atomic_bool _closed;
+
+    std::mutex _prefetch_lock;
+    // the ranges to hint to the kernel
+    std::deque<PrefetchRange> _pending_ranges;
+    // the ranges hinted but not read yet, in the order they are hinted
+    std::deque<PrefetchRange> _advised_ranges;
+    size_t _advised_bytes = 0;
 };
 
 } // namespace io
@@ -1,15 +1,19 @@
 #include "io/fs/local_file_system.h"
 
+#include "common/config.h"
 #include "io/fs/file_system.h"
+#include "io/fs/io_uring.h"
 #include "io/fs/local_file_reader.h"
 #include "io/fs/local_file_writer.h"
+#include "io/fs/uring_file_reader.h"
 #include "olap/storage_engine.h"
 
 namespace doris {
 namespace io {
 
 LocalFileSystem::LocalFileSystem(Path root_path, ResourceId resource_id)
-        : FileSystem(std::move(root_path), std::move(resource_id), FileSystemType::LOCAL) {
+        : FileSystem(std::move(root_path), std::move(resource_id), FileSystemType::LOCAL),
+          _io_limiter(new IOLimiter()) {
 #ifdef BE_TEST
     _file_cache.reset(
             new FileCache<int>("Readable_file_cache", config::file_descriptor_cache_capacity));
@@ -35,7 +39,7 @@ Status LocalFileSystem::create_file(const Path& path, std::unique_ptr<FileWriter
         return Status::IOError(
                 fmt::format("cannot open {}: {}", fs_path.native(), std::strerror(errno)));
     }
-    *writer = std::make_unique<LocalFileWriter>(std::move(fs_path), fd);
+    *writer = std::make_unique<LocalFileWriter>(std::move(fs_path), fd, _io_limiter.get());
     return Status::OK();
 }
 
@@ -60,7 +64,13 @@ Status LocalFileSystem::open_file(const Path& path, std::unique_ptr<FileReader>*
     }
     size_t fsize = 0;
     RETURN_IF_ERROR(file_size(fs_path, &fsize));
-    *reader = std::make_unique<LocalFileReader>(std::move(fs_path), fsize, std::move(file_handle));
+    if (config::enable_io_uring && IoUring::is_supported()) {
+        *reader = std::make_unique<UringFileReader>(std::move(fs_path), fsize,
+                                                    std::move(file_handle), _io_limiter.get());
+    } else {
+        *reader = std::make_unique<LocalFileReader>(std::move(fs_path), fsize,
+                                                    std::move(file_handle), _io_limiter.get());
+    }
     return Status::OK();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "io/fs/file_system.h"
+#include "io/fs/io_limiter.h"
 #include "util/file_cache.h"
 
 namespace doris {
@@ -29,10 +30,14 @@ public:
 
     Status list(const Path& path, std::vector<Path>* files) override;
 
+    // the limiter of the background I/O of the files in this file system
+    IOLimiter* io_limiter() const { return _io_limiter.get(); }
+
 private:
     Path absolute_path(const Path& path) const;
 
     std::unique_ptr<FileCache<int>> _file_cache;
+    std::unique_ptr<IOLimiter> _io_limiter;
 };
 
 LocalFileSystem* global_local_filesystem();
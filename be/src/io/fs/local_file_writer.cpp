@@ -35,7 +35,8 @@ Status sync_dir(const io::Path& dirname) {
 
 namespace io {
 
-LocalFileWriter::LocalFileWriter(Path path, int fd) : FileWriter(std::move(path)), _fd(fd) {
+LocalFileWriter::LocalFileWriter(Path path, int fd, IOLimiter* io_limiter)
+        : FileWriter(std::move(path)), _fd(fd), _io_limiter(io_limiter) {
     DorisMetrics::instance()->local_file_open_writing->increment(1);
     DorisMetrics::instance()->local_file_writer_total->increment(1);
 }
@@ -76,6 +77,9 @@ Status LocalFileWriter::appendv(const Slice* data, size_t data_cnt) {
         bytes_req += result.size;
         iov[i] = {result.data, result.size};
     }
+    if (_io_limiter != nullptr && IOLimiter::is_limited()) {
+        _io_limiter->acquire(bytes_req);
+    }
 
     size_t completed_iov = 0;
     size_t n_left = bytes_req;
@@ -161,6 +165,9 @@ Status LocalFileWriter::write_at(size_t offset, const Slice& data) {
 
     size_t bytes_req = data.size;
     char* from = data.data;
+    if (_io_limiter != nullptr && IOLimiter::is_limited()) {
+        _io_limiter->acquire(bytes_req);
+    }
 
     while (bytes_req != 0) {
         auto res = ::pwrite(_fd, from, bytes_req, offset);
@@ -3,13 +3,14 @@
 #include <cstddef>
 
 #include "io/fs/file_writer.h"
+#include "io/fs/io_limiter.h"
 
 namespace doris {
 namespace io {
 
 class LocalFileWriter final : public FileWriter {
 public:
-    LocalFileWriter(Path path, int fd);
+    LocalFileWriter(Path path, int fd, IOLimiter* io_limiter = nullptr);
     ~LocalFileWriter() override;
 
     Status close() override;
@@ -31,6 +32,7 @@ private:
 
 private:
     int _fd; // owned
+    IOLimiter* _io_limiter; // ref
 
     size_t _bytes_appended = 0;
     bool _dirty = false;
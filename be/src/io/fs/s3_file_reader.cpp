@@ -3,6 +3,8 @@
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/GetObjectRequest.h>
 
+#include "common/config.h"
+#include "common/logging.h"
 #include "io/fs/s3_common.h"
 #include "util/doris_metrics.h"
 
@@ -21,6 +23,10 @@ S3FileReader::S3FileReader(Path path, size_t file_size, std::string key, std::st
 }
 
 S3FileReader::~S3FileReader() {
+    // the background requests write into the prefetch buffers
+    for (auto& [_, buffer] : _prefetch_buffers) {
+        buffer->outcome.wait();
+    }
     DorisMetrics::instance()->s3_file_open_reading->increment(-1);
 }
 
@@ -37,6 +43,45 @@ Status S3FileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
     size_t bytes_req = result.size;
     char* to = result.data;
     bytes_req = std::min(bytes_req, _file_size - offset);
+    if (bytes_req == 0) {
+        *bytes_read = 0;
+        return Status::OK();
+    }
+
+    std::shared_ptr<PrefetchBuffer> buffer;
+    {
+        std::lock_guard l(_prefetch_lock);
+        buffer = _find_prefetch_buffer_locked(offset, bytes_req);
+    }
+    if (buffer != nullptr) {
+        const auto& outcome = buffer->outcome.get();
+        bool success = outcome.IsSuccess() &&
+                       outcome.GetResult().GetContentLength() == (int64_t)buffer->size;
+        if (success) {
+            memcpy(to, buffer->data.get() + (offset - buffer->offset), bytes_req);
+            DorisMetrics::instance()->s3_bytes_read_total->increment(bytes_req);
+            DorisMetrics::instance()->s3_prefetch_hit_bytes_total->increment(bytes_req);
+        } else if (outcome.IsSuccess()) {
+            LOG(WARNING) << "failed to prefetch " << _path.native() << ", offset: "
+                         << buffer->offset << ", size: " << buffer->size << ", bytes read: "
+                         << outcome.GetResult().GetContentLength();
+        } else {
+            LOG(WARNING) << "failed to prefetch " << _path.native() << ", offset: "
+                         << buffer->offset << ", size: " << buffer->size << ", "
+                         << outcome.GetError().GetMessage();
+        }
+        std::lock_guard l(_prefetch_lock);
+        buffer->consumed += bytes_req;
+        _last_read_seq = std::max(_last_read_seq, buffer->seq);
+        if (!success || buffer->consumed >= buffer->size) {
+            _release_prefetch_buffer_locked(buffer);
+        }
+        _issue_prefetch_locked();
+        if (success) {
+            *bytes_read = bytes_req;
+            return Status::OK();
+        }
+    }
 
     Aws::S3::Model::GetObjectRequest request;
     request.WithBucket(_bucket).WithKey(_key);
@@ -58,5 +103,115 @@ Status S3FileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
     return Status::OK();
 }
 
+bool S3FileReader::support_prefetch() const {
+    return config::enable_s3_prefetch;
+}
+
+void S3FileReader::prefetch(const std::vector<PrefetchRange>& ranges) {
+    if (!config::enable_s3_prefetch) {
+        return;
+    }
+    const size_t max_gap = config::s3_prefetch_merge_gap_bytes;
+    const size_t max_request_size = config::s3_prefetch_max_request_bytes;
+    // Merge each range into a previous request ending at most `max_gap` bytes before it.
+    // The requests are issued in the order of their first ranges.
+    std::vector<PrefetchRange> requests;
+    // end offset of the requests which can be extended -> index in `requests`
+    std::map<size_t, size_t> open_requests;
+    for (auto& range : ranges) {
+        if (range.size == 0 || range.offset >= _file_size) {
+            continue;
+        }
+        size_t range_end = std::min(range.offset + range.size, _file_size);
+        auto it = open_requests.lower_bound(range.offset > max_gap ? range.offset - max_gap : 0);
+        if (it != open_requests.end() && it->first <= range.offset) {
+            auto& request = requests[it->second];
+            request.size = range_end - request.offset;
+            size_t idx = it->second;
+            open_requests.erase(it);
+            if (request.size < max_request_size) {
+                open_requests.emplace(range_end, idx);
+            }
+        } else {
+            requests.push_back({range.offset, range_end - range.offset});
+            open_requests.emplace(range_end, requests.size() - 1);
+        }
+    }
+
+    std::lock_guard l(_prefetch_lock);
+    _pending_ranges.insert(_pending_ranges.end(), requests.begin(), requests.end());
+    _issue_prefetch_locked();
+}
+
+std::shared_ptr<S3FileReader::PrefetchBuffer> S3FileReader::_find_prefetch_buffer_locked(
+        size_t offset, size_t size) {
+    auto it = _prefetch_buffers.upper_bound(offset);
+    if (it == _prefetch_buffers.begin()) {
+        return nullptr;
+    }
+    --it;
+    auto& buffer = it->second;
+    if (offset + size > buffer->offset + buffer->size) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+void S3FileReader::_release_prefetch_buffer_locked(const std::shared_ptr<PrefetchBuffer>& buffer) {
+    auto it = _prefetch_buffers.find(buffer->offset);
+    if (it != _prefetch_buffers.end() && it->second == buffer) {
+        _prefetch_bytes -= buffer->size;
+        _prefetch_buffers.erase(it);
+    }
+}
+
+void S3FileReader::_issue_prefetch_locked() {
+    const size_t max_buffer_size = config::s3_prefetch_buffer_bytes;
+    if (_pending_ranges.empty()) {
+        return;
+    }
+    // The buffers issued before the last read one but never read are most likely for
+    // the pages skipped by the reader, drop them to go on prefetching.
+    for (auto it = _prefetch_buffers.begin(); it != _prefetch_buffers.end();) {
+        auto& buffer = it->second;
+        if (buffer->consumed == 0 && buffer->seq < _last_read_seq &&
+            buffer->outcome.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            _prefetch_bytes -= buffer->size;
+            it = _prefetch_buffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto client = _fs->get_client();
+    while (!_pending_ranges.empty()) {
+        auto& range = _pending_ranges.front();
+        // always allow one request, in case a single request is larger than the limit
+        if (!_prefetch_buffers.empty() && _prefetch_bytes + range.size > max_buffer_size) {
+            break;
+        }
+        if (_prefetch_buffers.count(range.offset) > 0) {
+            _pending_ranges.pop_front();
+            continue;
+        }
+        auto buffer = std::make_shared<PrefetchBuffer>();
+        buffer->offset = range.offset;
+        buffer->size = range.size;
+        buffer->data.reset(new char[range.size]);
+        buffer->client = client;
+        buffer->seq = _next_prefetch_seq++;
+
+        Aws::S3::Model::GetObjectRequest request;
+        request.WithBucket(_bucket).WithKey(_key);
+        request.SetRange(fmt::format("bytes={}-{}", range.offset, range.offset + range.size - 1));
+        request.SetResponseStreamFactory(AwsWriteableStreamFactory(buffer->data.get(), range.size));
+        buffer->outcome = client->GetObjectCallable(request).share();
+        DorisMetrics::instance()->s3_prefetch_request_total->increment(1);
+
+        _prefetch_bytes += range.size;
+        _prefetch_buffers.emplace(range.offset, std::move(buffer));
+        _pending_ranges.pop_front();
+    }
+}
+
 } // namespace io
 } // namespace doris
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <aws/s3/S3Client.h>
+
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+
 #include "gutil/macros.h"
 #include "io/fs/file_reader.h"
 #include "io/fs/path.h"
@@ -19,17 +26,54 @@ public:
 
     Status read_at(size_t offset, Slice result, size_t* bytes_read) override;
 
+    // Coalesce the ranges which are adjacent in the file into larger requests, and fetch
+    // them concurrently in background while the total size of the fetched but not yet
+    // consumed data is under `s3_prefetch_buffer_bytes`.
+    void prefetch(const std::vector<PrefetchRange>& ranges) override;
+
+    bool support_prefetch() const override;
+
     const Path& path() const override { return _path; }
 
     size_t size() const override { return _file_size; }
 
 private:
+    // The data of a background request
+    struct PrefetchBuffer {
+        size_t offset;
+        size_t size;
+        std::unique_ptr<char[]> data;
+        // keep the client alive until the request is finished
+        std::shared_ptr<Aws::S3::S3Client> client;
+        std::shared_future<Aws::S3::Model::GetObjectOutcome> outcome;
+        // bytes already returned by read_at()
+        size_t consumed = 0;
+        // the order the request is issued
+        uint64_t seq = 0;
+    };
+
+    // Return the buffer containing the whole range, or nullptr
+    std::shared_ptr<PrefetchBuffer> _find_prefetch_buffer_locked(size_t offset, size_t size);
+    void _release_prefetch_buffer_locked(const std::shared_ptr<PrefetchBuffer>& buffer);
+    // Issue the pending ranges while the buffer limit allows.
+    void _issue_prefetch_locked();
+
     Path _path;
     size_t _file_size;
     S3FileSystem* _fs;
 
     std::string _bucket;
     std::string _key;
+
+    std::mutex _prefetch_lock;
+    // ranges to prefetch but not issued yet
+    std::deque<PrefetchRange> _pending_ranges;
+    // issued requests, ordered by offset
+    std::map<size_t, std::shared_ptr<PrefetchBuffer>> _prefetch_buffers;
+    size_t _prefetch_bytes = 0;
+    uint64_t _next_prefetch_seq = 0;
+    // the largest seq of the buffers which have been read
+    uint64_t _last_read_seq = 0;
 };
 
 } // namespace io
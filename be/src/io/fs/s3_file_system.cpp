@@ -14,6 +14,8 @@
 #include "common/config.h"
 #include "common/status.h"
 #include "gutil/strings/stringpiece.h"
+#include "io/cache/cached_remote_file_reader.h"
+#include "io/cache/file_block_cache.h"
 #include "io/fs/remote_file_system.h"
 #include "io/fs/s3_file_reader.h"
 
@@ -115,6 +117,9 @@ Status S3FileSystem::open_file(const Path& path, std::unique_ptr<FileReader>* re
     auto fs_path = Path(_endpoint) / _bucket / key;
     *reader = std::make_unique<S3FileReader>(std::move(fs_path), fsize, std::move(key), _bucket,
                                              this);
+    if (auto cache = FileBlockCache::instance(); cache != nullptr) {
+        *reader = std::make_unique<CachedRemoteFileReader>(std::move(*reader), cache);
+    }
     return Status::OK();
 }
 
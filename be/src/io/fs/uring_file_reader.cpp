@@ -0,0 +1,258 @@
+#include "io/fs/uring_file_reader.h"
+
+#include <limits>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/doris_metrics.h"
+#include "util/errno.h"
+#include "util/time.h"
+
+namespace doris {
+namespace io {
+
+UringFileReader::UringFileReader(Path path, size_t file_size,
+                                 std::shared_ptr<OpenedFileHandle<int>> file_handle,
+                                 IOLimiter* io_limiter)
+        : _file_handle(std::move(file_handle)),
+          _path(std::move(path)),
+          _file_size(file_size),
+          _io_limiter(io_limiter),
+          _closed(false) {
+    _fd = *_file_handle->file();
+    DorisMetrics::instance()->local_file_open_reading->increment(1);
+    DorisMetrics::instance()->local_file_reader_total->increment(1);
+}
+
+UringFileReader::~UringFileReader() {
+    WARN_IF_ERROR(close(), fmt::format("Failed to close file {}", _path.native()));
+}
+
+Status UringFileReader::close() {
+    bool expected = false;
+    if (_closed.compare_exchange_strong(expected, true)) {
+        std::lock_guard l(_prefetch_lock);
+        // the kernel writes into the buffers of the inflight reads
+        while (!_inflight_buffers.empty()) {
+            Status st = _reap_completion_locked();
+            if (!st.ok()) {
+                // should not happen, leak the buffers rather than let them be overwritten
+                LOG(ERROR) << "failed to wait for inflight reads of " << _path.native() << ": "
+                           << st;
+                for (auto& [_, buffer] : _inflight_buffers) {
+                    buffer->data.release();
+                }
+                _inflight_buffers.clear();
+                _ring.release();
+                break;
+            }
+        }
+        _prefetch_buffers.clear();
+        _pending_ranges.clear();
+        _ring.reset();
+        _file_handle.reset();
+        DorisMetrics::instance()->local_file_open_reading->increment(-1);
+    }
+    return Status::OK();
+}
+
+Status UringFileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
+    if (_io_limiter == nullptr) {
+        return _read_at(offset, result, bytes_read);
+    }
+    // the background reads are limited, and the foreground ones are timed to adjust the limit
+    bool limited = IOLimiter::is_limited();
+    if (limited && offset < _file_size) {
+        _io_limiter->acquire(std::min(result.size, _file_size - offset));
+    }
+    int64_t start_ns = MonotonicNanos();
+    Status st = _read_at(offset, result, bytes_read);
+    if (!limited && st.ok() && *bytes_read > 0) {
+        _io_limiter->record_read_latency(MonotonicNanos() - start_ns);
+    }
+    return st;
+}
+
+Status UringFileReader::_read_at(size_t offset, Slice result, size_t* bytes_read) {
+    DCHECK(!_closed.load());
+    if (offset > _file_size) {
+        return Status::IOError(
+                fmt::format("offset exceeds file size(offset: {), file size: {}, path: {})", offset,
+                            _file_size, _path.native()));
+    }
+    size_t bytes_req = result.size;
+    char* to = result.data;
+    bytes_req = std::min(bytes_req, _file_size - offset);
+    *bytes_read = bytes_req;
+    if (bytes_req == 0) {
+        return Status::OK();
+    }
+
+    {
+        std::lock_guard l(_prefetch_lock);
+        auto buffer = _find_prefetch_buffer_locked(offset, bytes_req);
+        if (buffer != nullptr) {
+            Status st;
+            while (st.ok() && !buffer->done) {
+                st = _reap_completion_locked();
+            }
+            bool success = st.ok() && buffer->res == (int32_t)buffer->size;
+            if (success) {
+                memcpy(to, buffer->data.get() + (offset - buffer->offset), bytes_req);
+            } else if (!st.ok()) {
+                LOG(WARNING) << "failed to prefetch " << _path.native() << ": " << st;
+            } else {
+                LOG(WARNING) << "failed to prefetch " << _path.native()
+                             << ", offset: " << buffer->offset << ", size: " << buffer->size
+                             << ", res: " << buffer->res;
+            }
+            buffer->consumed += bytes_req;
+            _last_read_seq = std::max(_last_read_seq, buffer->seq);
+            if (!success || buffer->consumed >= buffer->size) {
+                _release_prefetch_buffer_locked(buffer);
+            }
+            _issue_prefetch_locked();
+            if (success) {
+                DorisMetrics::instance()->local_bytes_read_total->increment(bytes_req);
+                return Status::OK();
+            }
+        }
+    }
+    return _pread(offset, to, bytes_req);
+}
+
+Status UringFileReader::_pread(size_t offset, char* to, size_t bytes_req) {
+    size_t bytes_read = bytes_req;
+    while (bytes_req != 0) {
+        auto res = ::pread(_fd, to, bytes_req, offset);
+        if (-1 == res && errno != EINTR) {
+            return Status::IOError(
+                    fmt::format("cannot read from {}: {}", _path.native(), std::strerror(errno)));
+        }
+        if (res == 0) {
+            return Status::IOError(
+                    fmt::format("cannot read from {}: unexpected EOF", _path.native()));
+        }
+        if (res > 0) {
+            to += res;
+            offset += res;
+            bytes_req -= res;
+        }
+    }
+    DorisMetrics::instance()->local_bytes_read_total->increment(bytes_read);
+    return Status::OK();
+}
+
+void UringFileReader::prefetch(const std::vector<PrefetchRange>& ranges) {
+    DCHECK(!_closed.load());
+    std::lock_guard l(_prefetch_lock);
+    if (_ring == nullptr && !_ring_failed) {
+        _ring = std::make_unique<IoUring>();
+        Status st = _ring->init(config::io_uring_queue_depth);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to init io_uring for " << _path.native() << ": " << st;
+            _ring.reset();
+            _ring_failed = true;
+        }
+    }
+    if (_ring_failed) {
+        return;
+    }
+    for (auto& range : ranges) {
+        if (range.size == 0 || range.offset >= _file_size) {
+            continue;
+        }
+        size_t size = std::min(range.size, _file_size - range.offset);
+        if (size > std::numeric_limits<int32_t>::max()) {
+            continue;
+        }
+        _pending_ranges.push_back({range.offset, size});
+    }
+    _issue_prefetch_locked();
+}
+
+std::shared_ptr<UringFileReader::PrefetchBuffer> UringFileReader::_find_prefetch_buffer_locked(
+        size_t offset, size_t size) {
+    auto it = _prefetch_buffers.upper_bound(offset);
+    if (it == _prefetch_buffers.begin()) {
+        return nullptr;
+    }
+    --it;
+    auto& buffer = it->second;
+    if (offset + size > buffer->offset + buffer->size) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+void UringFileReader::_release_prefetch_buffer_locked(
+        const std::shared_ptr<PrefetchBuffer>& buffer) {
+    auto it = _prefetch_buffers.find(buffer->offset);
+    if (it != _prefetch_buffers.end() && it->second == buffer) {
+        _prefetch_bytes -= buffer->size;
+        _prefetch_buffers.erase(it);
+    }
+}
+
+void UringFileReader::_issue_prefetch_locked() {
+    const size_t max_buffer_size = config::io_uring_prefetch_buffer_bytes;
+    if (_ring == nullptr || _pending_ranges.empty()) {
+        return;
+    }
+    // The buffers issued before the last read one but never read are most likely for
+    // the pages skipped by the reader, drop them to go on prefetching.
+    for (auto it = _prefetch_buffers.begin(); it != _prefetch_buffers.end();) {
+        auto& buffer = it->second;
+        if (buffer->consumed == 0 && buffer->seq < _last_read_seq) {
+            _prefetch_bytes -= buffer->size;
+            it = _prefetch_buffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    bool prepared = false;
+    while (!_pending_ranges.empty() && _ring->available() > 0) {
+        auto& range = _pending_ranges.front();
+        // always allow one read, in case a single read is larger than the limit
+        if (!_prefetch_buffers.empty() && _prefetch_bytes + range.size > max_buffer_size) {
+            break;
+        }
+        if (_prefetch_buffers.count(range.offset) > 0) {
+            _pending_ranges.pop_front();
+            continue;
+        }
+        auto buffer = std::make_shared<PrefetchBuffer>();
+        buffer->offset = range.offset;
+        buffer->size = range.size;
+        buffer->data.reset(new char[range.size]);
+        buffer->seq = _next_prefetch_seq++;
+        _ring->prepare_read(_fd, buffer->data.get(), range.size, range.offset, buffer->seq);
+        prepared = true;
+
+        _prefetch_bytes += range.size;
+        _inflight_buffers.emplace(buffer->seq, buffer);
+        _prefetch_buffers.emplace(range.offset, std::move(buffer));
+        _pending_ranges.pop_front();
+    }
+    if (prepared) {
+        // a failed submission is retried by the next submit() or wait_completion()
+        WARN_IF_ERROR(_ring->submit(), "failed to submit io_uring reads of " + _path.native());
+    }
+}
+
+Status UringFileReader::_reap_completion_locked() {
+    uint64_t seq = 0;
+    int32_t res = 0;
+    RETURN_IF_ERROR(_ring->wait_completion(&seq, &res));
+    auto it = _inflight_buffers.find(seq);
+    DCHECK(it != _inflight_buffers.end());
+    if (it != _inflight_buffers.end()) {
+        it->second->done = true;
+        it->second->res = res;
+        _inflight_buffers.erase(it);
+    }
+    return Status::OK();
+}
+
+} // namespace io
+} // namespace doris
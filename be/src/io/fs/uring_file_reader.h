@@ -0,0 +1,89 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <mutex>
+
+#include "io/fs/file_reader.h"
+#include "io/fs/io_limiter.h"
+#include "io/fs/io_uring.h"
+#include "io/fs/path.h"
+#include "util/file_cache.h"
+
+namespace doris {
+namespace io {
+
+// A local file reader which reads the prefetched ranges with io_uring. The ranges passed
+// to prefetch() are submitted to the kernel in batches while the bytes read but not
+// consumed are under `io_uring_prefetch_buffer_bytes`, other reads fall back to pread.
+class UringFileReader final : public FileReader {
+public:
+    UringFileReader(Path path, size_t file_size,
+                    std::shared_ptr<OpenedFileHandle<int>> file_handle,
+                    IOLimiter* io_limiter = nullptr);
+
+    ~UringFileReader() override;
+
+    Status close() override;
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override;
+
+    void prefetch(const std::vector<PrefetchRange>& ranges) override;
+
+    bool support_prefetch() const override { return true; }
+
+    const Path& path() const override { return _path; }
+
+    size_t size() const override { return _file_size; }
+
+private:
+    struct PrefetchBuffer {
+        size_t offset;
+        size_t size;
+        std::unique_ptr<char[]> data;
+        // bytes already returned by read_at()
+        size_t consumed = 0;
+        // the order the read is prepared, also the user data of the read
+        uint64_t seq = 0;
+        bool done = false;
+        // the result of the read, bytes read or -errno
+        int32_t res = 0;
+    };
+
+    Status _read_at(size_t offset, Slice result, size_t* bytes_read);
+
+    Status _pread(size_t offset, char* to, size_t bytes_req);
+
+    std::shared_ptr<PrefetchBuffer> _find_prefetch_buffer_locked(size_t offset, size_t size);
+    void _release_prefetch_buffer_locked(const std::shared_ptr<PrefetchBuffer>& buffer);
+    // Prepare the pending ranges while the ring and the buffer limit allow, and submit
+    // them at once.
+    void _issue_prefetch_locked();
+    // Wait for a read to complete.
+    Status _reap_completion_locked();
+
+    std::shared_ptr<OpenedFileHandle<int>> _file_handle;
+    int _fd; // ref
+    Path _path;
+    size_t _file_size;
+    IOLimiter* _io_limiter; // ref
+
+    std::atomic_bool _closed;
+
+    std::mutex _prefetch_lock;
+    // initialized at the first prefetch()
+    std::unique_ptr<IoUring> _ring;
+    bool _ring_failed = false;
+    std::deque<PrefetchRange> _pending_ranges;
+    // reads not dropped yet, ordered by offset
+    std::map<size_t, std::shared_ptr<PrefetchBuffer>> _prefetch_buffers;
+    // reads not completed yet, the kernel writes into their buffers even if dropped
+    std::map<uint64_t, std::shared_ptr<PrefetchBuffer>> _inflight_buffers;
+    size_t _prefetch_bytes = 0;
+    uint64_t _next_prefetch_seq = 0;
+    // the largest seq of the buffers which have been read
+    uint64_t _last_read_seq = 0;
+};
+
+} // namespace io
+} // namespace doris
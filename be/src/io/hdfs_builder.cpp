@@ -22,6 +22,7 @@
 #include <fstream>
 
 #include "agent/utils.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "util/uid_util.h"
 #include "util/url_coding.h"
@@ -65,6 +66,14 @@ HDFSCommonBuilder createHDFSBuilder(const THdfsParams& hdfsParams) {
         builder.need_kinit = true;
         builder.hdfs_kerberos_keytab = hdfsParams.hdfs_kerberos_keytab;
     }
+    // set the read conf of be, which can be overridden by the conf of the table
+    hdfsBuilderConfSetStr(builder.get(), "input.read.timeout",
+                          std::to_string(config::hdfs_read_timeout_ms).c_str());
+    if (!config::hdfs_domain_socket_path.empty()) {
+        hdfsBuilderConfSetStr(builder.get(), "dfs.client.read.shortcircuit", "true");
+        hdfsBuilderConfSetStr(builder.get(), "dfs.domain.socket.path",
+                              config::hdfs_domain_socket_path.c_str());
+    }
     // set other conf
     if (hdfsParams.__isset.hdfs_conf) {
         for (const THdfsConf& conf : hdfsParams.hdfs_conf) {
@@ -109,7 +109,7 @@ Status HdfsFileReader::read_one_message(std::unique_ptr<uint8_t[]>* buf, int64_t
 }
 
 Status HdfsFileReader::read(uint8_t* buf, int64_t buf_len, int64_t* bytes_read, bool* eof) {
-    readat(_current_offset, buf_len, bytes_read, buf);
+    RETURN_IF_ERROR(readat(_current_offset, buf_len, bytes_read, buf));
     if (*bytes_read == 0) {
         *eof = true;
     } else {
@@ -65,14 +65,16 @@ public:
         return Status::OK();
     }
 
+    bool can_do_bitmap_index() const override { return false; }
+
     void evaluate(vectorized::IColumn& column, uint16_t* sel, uint16_t* size) const override;
 
 private:
+    // the rows probed in a batch by the vectorized evaluate
+    static constexpr uint16_t BATCH_SIZE = 256;
+
     std::shared_ptr<IBloomFilterFuncBase> _filter;
     SpecificFilter* _specific_filter; // owned by _filter
-    mutable uint64_t _evaluated_rows = 1;
-    mutable uint64_t _passed_rows = 0;
-    mutable bool _enable_pred = true;
 };
 
 // bloom filter column predicate do not support in segment v1
@@ -113,65 +115,64 @@ void BloomFilterColumnPredicate<T>::evaluate(ColumnBlock* block, uint16_t* sel,
 template <PrimitiveType T>
 void BloomFilterColumnPredicate<T>::evaluate(vectorized::IColumn& column, uint16_t* sel,
                                              uint16_t* size) const {
-    uint16_t new_size = 0;
     using FT = typename PredicatePrimitiveTypeTraits<T>::PredicateFieldType;
-    if (!_enable_pred) {
+    if (!_filter->is_effective()) {
         return;
     }
+    const vectorized::IColumn* nested_column = &column;
+    const uint8_t* null_map = nullptr;
     if (column.is_nullable()) {
         auto* nullable_col = vectorized::check_and_get_column<vectorized::ColumnNullable>(column);
-        auto& null_map_data = nullable_col->get_null_map_column().get_data();
-        // deal ColumnDict
-        if (nullable_col->get_nested_column().is_column_dictionary()) {
-            auto* dict_col = vectorized::check_and_get_column<vectorized::ColumnDictI32>(
-                    nullable_col->get_nested_column());
-            const_cast<vectorized::ColumnDictI32*>(dict_col)
-                    ->generate_hash_values_for_runtime_filter();
-            for (uint16_t i = 0; i < *size; i++) {
-                uint16_t idx = sel[i];
-                sel[new_size] = idx;
-                new_size += (!null_map_data[idx]) &&
-                            _specific_filter->find_uint32_t(dict_col->get_hash_value(idx));
+        nested_column = &nullable_col->get_nested_column();
+        null_map = nullable_col->get_null_map_column().get_data().data();
+    }
+
+    const vectorized::ColumnDictI32* dict_col = nullptr;
+    const FT* values = nullptr;
+    if (nested_column->is_column_dictionary()) {
+        dict_col = vectorized::check_and_get_column<vectorized::ColumnDictI32>(*nested_column);
+        const_cast<vectorized::ColumnDictI32*>(dict_col)->generate_hash_values_for_runtime_filter();
+    } else {
+        values = vectorized::check_and_get_column<vectorized::PredicateColumnType<FT>>(
+                         *nested_column)
+                         ->get_data()
+                         .data();
+    }
+
+    // probe the rows in batches, the found flags of which are compacted into sel
+    uint8_t found[BATCH_SIZE];
+    uint32_t hashes[BATCH_SIZE];
+    uint16_t new_size = 0;
+    for (uint16_t start = 0; start < *size; start += BATCH_SIZE) {
+        uint16_t batch_size = std::min<uint16_t>(BATCH_SIZE, *size - start);
+        if (dict_col != nullptr) {
+            for (uint16_t i = 0; i < batch_size; ++i) {
+                hashes[i] = dict_col->get_hash_value(sel[start + i]);
             }
+            _specific_filter->find_uint32_t_batch(hashes, batch_size, found);
         } else {
-            auto* pred_col = vectorized::check_and_get_column<vectorized::PredicateColumnType<FT>>(
-                    nullable_col->get_nested_column());
-            auto& pred_col_data = pred_col->get_data();
-            for (uint16_t i = 0; i < *size; i++) {
-                uint16_t idx = sel[i];
+            _specific_filter->find_olap_engine_batch(values, sel + start, batch_size, found);
+        }
+        // sel[start, *size) is not overwritten yet as new_size <= start + i
+        if (null_map != nullptr) {
+            for (uint16_t i = 0; i < batch_size; ++i) {
+                uint16_t idx = sel[start + i];
                 sel[new_size] = idx;
-                const auto* cell_value = reinterpret_cast<const void*>(&(pred_col_data[idx]));
-                new_size += (!null_map_data[idx]) && _specific_filter->find_olap_engine(cell_value);
+                new_size += found[i] & !null_map[idx];
+            }
+        } else {
+            for (uint16_t i = 0; i < batch_size; ++i) {
+                sel[new_size] = sel[start + i];
+                new_size += found[i];
             }
-        }
-    } else if (column.is_column_dictionary()) {
-        auto* dict_col = vectorized::check_and_get_column<vectorized::ColumnDictI32>(column);
-        const_cast<vectorized::ColumnDictI32*>(dict_col)->generate_hash_values_for_runtime_filter();
-        for (uint16_t i = 0; i < *size; i++) {
-            uint16_t idx = sel[i];
-            sel[new_size] = idx;
-            new_size += _specific_filter->find_uint32_t(dict_col->get_hash_value(idx));
-        }
-    } else {
-        auto* pred_col =
-                vectorized::check_and_get_column<vectorized::PredicateColumnType<FT>>(column);
-        auto& pred_col_data = pred_col->get_data();
-        for (uint16_t i = 0; i < *size; i++) {
-            uint16_t idx = sel[i];
-            sel[new_size] = idx;
-            const auto* cell_value = reinterpret_cast<const void*>(&(pred_col_data[idx]));
-            new_size += _specific_filter->find_olap_engine(cell_value);
         }
     }
     // If the pass rate is very high, for example > 50%, then the bloomfilter is useless.
     // Some bloomfilter is useless, for example ssb 4.3, it consumes a lot of cpu but it is
     // useless.
-    _evaluated_rows += *size;
-    _passed_rows += new_size;
-    if (_evaluated_rows > config::bloom_filter_predicate_check_row_num) {
-        if (_passed_rows / (_evaluated_rows * 1.0) > 0.5) {
-            _enable_pred = false;
-        }
+    if (_filter->is_sampling()) {
+        _filter->update_selectivity(*size, new_size, config::bloom_filter_predicate_check_row_num,
+                                    config::bloom_filter_predicate_min_filter_ratio);
     }
     *size = new_size;
 }
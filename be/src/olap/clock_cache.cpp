@@ -0,0 +1,399 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/clock_cache.h"
+
+#include <mutex>
+
+#include "gutil/bits.h"
+#include "runtime/thread_context.h"
+#include "util/doris_metrics.h"
+
+namespace doris {
+
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(capacity, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(usage, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(usage_ratio, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(lookup_count, MetricUnit::OPERATIONS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(hit_count, MetricUnit::OPERATIONS);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(hit_ratio, MetricUnit::NOUNIT);
+
+void ClockHandle::free() {
+    (*deleter)(key(), value);
+    if (mem_tracker) {
+        mem_tracker->transfer_to(tls_ctx()->_thread_mem_tracker_mgr->raw_mem_tracker(),
+                                 total_size);
+    }
+    this->~ClockHandle();
+    ::free(this);
+}
+
+// the clock count of an entry after it is inserted or hit, the DURABLE entries survive
+// one more pass of the clock hand
+static uint8_t initial_clock_count(CachePriority priority) {
+    return priority == CachePriority::DURABLE ? 1 : 0;
+}
+
+static uint8_t hit_clock_count(CachePriority priority) {
+    return priority == CachePriority::DURABLE ? 2 : 1;
+}
+
+ClockCache::ClockCache(LRUCacheType type) : _type(type) {
+    _table.resize(16, nullptr);
+}
+
+ClockCache::~ClockCache() {
+    prune();
+}
+
+ClockHandle** ClockCache::_find_pointer(const CacheKey& key, uint32_t hash) {
+    ClockHandle** ptr = &_table[hash & (_table.size() - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+        ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+}
+
+void ClockCache::_table_insert(ClockHandle* e, ClockHandle** old) {
+    ClockHandle** ptr = _find_pointer(e->key(), e->hash);
+    *old = *ptr;
+    e->next_hash = *old != nullptr ? (*old)->next_hash : nullptr;
+    *ptr = e;
+    if (*old == nullptr && ++_elems > _table.size()) {
+        _table_resize();
+    }
+}
+
+void ClockCache::_table_remove(ClockHandle* e) {
+    ClockHandle** ptr = &_table[e->hash & (_table.size() - 1)];
+    while (*ptr != nullptr && *ptr != e) {
+        ptr = &(*ptr)->next_hash;
+    }
+    if (*ptr != nullptr) {
+        *ptr = e->next_hash;
+        --_elems;
+    }
+}
+
+void ClockCache::_table_resize() {
+    std::vector<ClockHandle*> new_table(_table.size() * 2, nullptr);
+    for (auto h : _table) {
+        while (h != nullptr) {
+            ClockHandle* next = h->next_hash;
+            ClockHandle** ptr = &new_table[h->hash & (new_table.size() - 1)];
+            h->next_hash = *ptr;
+            *ptr = h;
+            h = next;
+        }
+    }
+    _table.swap(new_table);
+}
+
+void ClockCache::_ring_append(ClockHandle* e) {
+    if (_hand == nullptr) {
+        e->next = e->prev = e;
+        _hand = e;
+        return;
+    }
+    // just behind the hand, so it's checked lastly
+    e->next = _hand;
+    e->prev = _hand->prev;
+    e->prev->next = e;
+    _hand->prev = e;
+}
+
+void ClockCache::_ring_remove(ClockHandle* e) {
+    if (_hand == e) {
+        _hand = e->next == e ? nullptr : e->next;
+    }
+    e->next->prev = e->prev;
+    e->prev->next = e->next;
+    e->next = e->prev = nullptr;
+}
+
+bool ClockCache::_remove_from_cache(ClockHandle* e) {
+    DCHECK(e->in_cache);
+    _ring_remove(e);
+    _table_remove(e);
+    e->in_cache = false;
+    return e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+void ClockCache::_free(ClockHandle* e) {
+    _usage.fetch_sub(e->total_size, std::memory_order_relaxed);
+    e->free();
+}
+
+void ClockCache::_evict(size_t total_size, std::vector<ClockHandle*>* to_free) {
+    // every entry is passed at most (max clock count + 1) times
+    size_t max_steps = (hit_clock_count(CachePriority::DURABLE) + 1) * (size_t)_elems;
+    for (size_t i = 0; i < max_steps && _hand != nullptr &&
+                       _usage.load(std::memory_order_relaxed) + total_size > _capacity;
+         ++i) {
+        ClockHandle* e = _hand;
+        _hand = e->next;
+        if (e->refs.load(std::memory_order_acquire) > 1) {
+            // in use
+            continue;
+        }
+        uint8_t count = e->clock_count.load(std::memory_order_relaxed);
+        if (count > 0) {
+            e->clock_count.store(count - 1, std::memory_order_relaxed);
+            continue;
+        }
+        if (_remove_from_cache(e)) {
+            to_free->push_back(e);
+        }
+    }
+}
+
+Cache::Handle* ClockCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                                  void (*deleter)(const CacheKey& key, void* value),
+                                  CachePriority priority, MemTracker* tracker) {
+    size_t handle_size = sizeof(ClockHandle) - 1 + key.size();
+    ClockHandle* e = new (malloc(handle_size)) ClockHandle();
+    e->value = value;
+    e->deleter = deleter;
+    e->charge = charge;
+    e->key_length = key.size();
+    e->total_size = (_type == LRUCacheType::SIZE ? handle_size + charge : 1);
+    e->refs.store(2, std::memory_order_relaxed); // one for the returned handle, one for cache
+    e->clock_count.store(initial_clock_count(priority), std::memory_order_relaxed);
+    e->in_cache = true;
+    e->hash = hash;
+    e->priority = priority;
+    e->mem_tracker = tracker;
+    memcpy(e->key_data, key.data(), key.size());
+    // The same as LRUCache, the memory is transferred to the tracker of the cache.
+    if (tracker) {
+        tls_ctx()->_thread_mem_tracker_mgr->raw_mem_tracker()->transfer_to(tracker, e->total_size);
+    }
+
+    std::vector<ClockHandle*> to_free;
+    {
+        std::unique_lock l(_mutex);
+        // the cache might get larger than its capacity if all entries are in use
+        _evict(e->total_size, &to_free);
+
+        ClockHandle* old = nullptr;
+        _table_insert(e, &old);
+        _ring_append(e);
+        _usage.fetch_add(e->total_size, std::memory_order_relaxed);
+        if (old != nullptr) {
+            _ring_remove(old);
+            old->in_cache = false;
+            if (old->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                to_free.push_back(old);
+            }
+        }
+    }
+
+    // free the entries out of lock
+    for (auto h : to_free) {
+        _free(h);
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Cache::Handle* ClockCache::lookup(const CacheKey& key, uint32_t hash) {
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    std::shared_lock l(_mutex);
+    ClockHandle* e = *_find_pointer(key, hash);
+    if (e != nullptr) {
+        // the entry can't be evicted concurrently, which needs the exclusive lock
+        e->refs.fetch_add(1, std::memory_order_relaxed);
+        uint8_t count = hit_clock_count(e->priority);
+        // don't dirty the cache line of a hot entry on every hit
+        if (e->clock_count.load(std::memory_order_relaxed) < count) {
+            e->clock_count.store(count, std::memory_order_relaxed);
+        }
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCache::release(Cache::Handle* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    ClockHandle* e = reinterpret_cast<ClockHandle*>(handle);
+    // the cache holds a reference while the entry is in cache, so this is the last
+    // reference only if the entry has been removed from the cache
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _free(e);
+    }
+}
+
+void ClockCache::erase(const CacheKey& key, uint32_t hash) {
+    ClockHandle* e = nullptr;
+    bool last_ref = false;
+    {
+        std::unique_lock l(_mutex);
+        e = *_find_pointer(key, hash);
+        if (e != nullptr) {
+            last_ref = _remove_from_cache(e);
+        }
+    }
+    if (last_ref) {
+        _free(e);
+    }
+}
+
+int64_t ClockCache::_prune(const CacheValuePredicate* pred) {
+    std::vector<ClockHandle*> to_free;
+    {
+        std::unique_lock l(_mutex);
+        size_t num_entries = _elems;
+        ClockHandle* e = _hand;
+        for (size_t i = 0; i < num_entries; ++i) {
+            ClockHandle* next = e->next;
+            if (e->refs.load(std::memory_order_acquire) == 1 &&
+                (pred == nullptr || (*pred)(e->value))) {
+                if (_remove_from_cache(e)) {
+                    to_free.push_back(e);
+                }
+            }
+            e = next;
+        }
+    }
+    for (auto h : to_free) {
+        _free(h);
+    }
+    return to_free.size();
+}
+
+int64_t ClockCache::prune() {
+    return _prune(nullptr);
+}
+
+int64_t ClockCache::prune_if(CacheValuePredicate pred) {
+    return _prune(&pred);
+}
+
+uint32_t ShardedClockCache::_hash_slice(const CacheKey& s) {
+    return s.hash(s.data(), s.size(), 0);
+}
+
+ShardedClockCache::ShardedClockCache(const std::string& name, size_t total_capacity,
+                                     LRUCacheType type, uint32_t num_shards)
+        : _name(name),
+          _num_shard_bits(Bits::FindLSBSetNonZero(num_shards)),
+          _num_shards(num_shards),
+          _last_id(1),
+          _mem_tracker(MemTracker::create_tracker(-1, name, nullptr, MemTrackerLevel::OVERVIEW)) {
+    CHECK(num_shards > 0) << "num_shards cannot be 0";
+    CHECK_EQ((num_shards & (num_shards - 1)), 0)
+            << "num_shards should be power of two, but got " << num_shards;
+
+    const size_t per_shard = (total_capacity + (_num_shards - 1)) / _num_shards;
+    for (int s = 0; s < _num_shards; s++) {
+        _shards.emplace_back(new ClockCache(type));
+        _shards.back()->set_capacity(per_shard);
+    }
+
+    // the same metrics as ShardedLRUCache
+    _entity = DorisMetrics::instance()->metric_registry()->register_entity(
+            std::string("lru_cache:") + name, {{"name", name}});
+    _entity->register_hook(name, std::bind(&ShardedClockCache::update_cache_metrics, this));
+    INT_GAUGE_METRIC_REGISTER(_entity, capacity);
+    INT_GAUGE_METRIC_REGISTER(_entity, usage);
+    INT_DOUBLE_METRIC_REGISTER(_entity, usage_ratio);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, lookup_count);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, hit_count);
+    INT_DOUBLE_METRIC_REGISTER(_entity, hit_ratio);
+}
+
+ShardedClockCache::~ShardedClockCache() {
+    _shards.clear();
+    _entity->deregister_hook(_name);
+    DorisMetrics::instance()->metric_registry()->deregister_entity(_entity);
+}
+
+Cache::Handle* ShardedClockCache::insert(const CacheKey& key, void* value, size_t charge,
+                                         void (*deleter)(const CacheKey& key, void* value),
+                                         CachePriority priority) {
+    const uint32_t hash = _hash_slice(key);
+    return _shards[_shard(hash)]->insert(key, hash, value, charge, deleter, priority,
+                                         _mem_tracker.get());
+}
+
+Cache::Handle* ShardedClockCache::lookup(const CacheKey& key) {
+    const uint32_t hash = _hash_slice(key);
+    return _shards[_shard(hash)]->lookup(key, hash);
+}
+
+void ShardedClockCache::release(Handle* handle) {
+    ClockHandle* h = reinterpret_cast<ClockHandle*>(handle);
+    _shards[_shard(h->hash)]->release(handle);
+}
+
+void ShardedClockCache::erase(const CacheKey& key) {
+    const uint32_t hash = _hash_slice(key);
+    _shards[_shard(hash)]->erase(key, hash);
+}
+
+void* ShardedClockCache::value(Handle* handle) {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+}
+
+Slice ShardedClockCache::value_slice(Handle* handle) {
+    auto clock_handle = reinterpret_cast<ClockHandle*>(handle);
+    return Slice((char*)clock_handle->value, clock_handle->charge);
+}
+
+uint64_t ShardedClockCache::new_id() {
+    return _last_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+int64_t ShardedClockCache::prune() {
+    int64_t num_prune = 0;
+    for (auto& shard : _shards) {
+        num_prune += shard->prune();
+    }
+    return num_prune;
+}
+
+int64_t ShardedClockCache::prune_if(CacheValuePredicate pred) {
+    int64_t num_prune = 0;
+    for (auto& shard : _shards) {
+        num_prune += shard->prune_if(pred);
+    }
+    return num_prune;
+}
+
+void ShardedClockCache::update_cache_metrics() const {
+    size_t total_capacity = 0;
+    size_t total_usage = 0;
+    size_t total_lookup_count = 0;
+    size_t total_hit_count = 0;
+    for (auto& shard : _shards) {
+        total_capacity += shard->get_capacity();
+        total_usage += shard->get_usage();
+        total_lookup_count += shard->get_lookup_count();
+        total_hit_count += shard->get_hit_count();
+    }
+
+    capacity->set_value(total_capacity);
+    usage->set_value(total_usage);
+    lookup_count->set_value(total_lookup_count);
+    hit_count->set_value(total_hit_count);
+    usage_ratio->set_value(total_capacity == 0 ? 0 : ((double)total_usage / total_capacity));
+    hit_ratio->set_value(total_lookup_count == 0 ? 0
+                                                 : ((double)total_hit_count / total_lookup_count));
+}
+
+} // namespace doris
@@ -0,0 +1,156 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "olap/lru_cache.h"
+
+namespace doris {
+
+// An entry of ClockCache. Unlike LRUHandle, the reference count and the clock bit are
+// atomics which are updated by the lookups and the releases without the exclusive lock.
+struct ClockHandle {
+    void* value;
+    void (*deleter)(const CacheKey&, void* value);
+    ClockHandle* next_hash = nullptr; // next entry in hash table
+    ClockHandle* next = nullptr;      // next entry in clock ring
+    ClockHandle* prev = nullptr;      // previous entry in clock ring
+    size_t charge;
+    size_t key_length;
+    size_t total_size; // including key length
+    // one for the cache while it is in the cache, and one for each handle returned
+    std::atomic<uint32_t> refs;
+    // the clock hand passes the entry this number of times before evicting it,
+    // reset by the hits
+    std::atomic<uint8_t> clock_count;
+    bool in_cache; // protected by the exclusive lock of the shard
+    uint32_t hash;
+    CachePriority priority;
+    MemTracker* mem_tracker;
+    char key_data[1]; // Beginning of key
+
+    CacheKey key() const { return CacheKey(key_data, key_length); }
+
+    void free();
+};
+
+// A single shard of ShardedClockCache. The entries are evicted by the CLOCK algorithm, a hit
+// only sets the clock count of the entry instead of moving it in a list, so the lookups share
+// the lock of the shard and only the insertions, erasures and evictions are exclusive.
+// The releases are lock free.
+class ClockCache {
+public:
+    ClockCache(LRUCacheType type);
+    ~ClockCache();
+
+    void set_capacity(size_t capacity) { _capacity = capacity; }
+
+    Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                          void (*deleter)(const CacheKey& key, void* value),
+                          CachePriority priority = CachePriority::NORMAL,
+                          MemTracker* tracker = nullptr);
+    Cache::Handle* lookup(const CacheKey& key, uint32_t hash);
+    void release(Cache::Handle* handle);
+    void erase(const CacheKey& key, uint32_t hash);
+    int64_t prune();
+    int64_t prune_if(CacheValuePredicate pred);
+
+    uint64_t get_lookup_count() const { return _lookup_count.load(std::memory_order_relaxed); }
+    uint64_t get_hit_count() const { return _hit_count.load(std::memory_order_relaxed); }
+    size_t get_usage() const { return _usage.load(std::memory_order_relaxed); }
+    size_t get_capacity() const { return _capacity; }
+
+private:
+    ClockHandle** _find_pointer(const CacheKey& key, uint32_t hash);
+    void _table_insert(ClockHandle* e, ClockHandle** old);
+    void _table_remove(ClockHandle* e);
+    void _table_resize();
+
+    void _ring_append(ClockHandle* e);
+    void _ring_remove(ClockHandle* e);
+
+    // Removes e from the cache, and returns whether it should be freed. REQUIRES: exclusive lock
+    bool _remove_from_cache(ClockHandle* e);
+    void _evict(size_t total_size, std::vector<ClockHandle*>* to_free);
+    int64_t _prune(const CacheValuePredicate* pred);
+    void _free(ClockHandle* e);
+
+    LRUCacheType _type;
+    size_t _capacity = 0;
+
+    std::shared_mutex _mutex;
+    std::atomic<size_t> _usage {0};
+
+    // the hash table, a bucket is a list of next_hash
+    std::vector<ClockHandle*> _table;
+    uint32_t _elems = 0;
+
+    // the circular list of the entries in cache, _hand is the next one to check
+    ClockHandle* _hand = nullptr;
+
+    std::atomic<uint64_t> _lookup_count {0};
+    std::atomic<uint64_t> _hit_count {0};
+};
+
+class ShardedClockCache : public Cache {
+public:
+    ShardedClockCache(const std::string& name, size_t total_capacity, LRUCacheType type,
+                      uint32_t num_shards);
+    ~ShardedClockCache() override;
+    Handle* insert(const CacheKey& key, void* value, size_t charge,
+                   void (*deleter)(const CacheKey& key, void* value),
+                   CachePriority priority = CachePriority::NORMAL) override;
+    Handle* lookup(const CacheKey& key) override;
+    void release(Handle* handle) override;
+    void erase(const CacheKey& key) override;
+    void* value(Handle* handle) override;
+    Slice value_slice(Handle* handle) override;
+    uint64_t new_id() override;
+    int64_t prune() override;
+    int64_t prune_if(CacheValuePredicate pred) override;
+
+private:
+    void update_cache_metrics() const;
+
+    static uint32_t _hash_slice(const CacheKey& s);
+    uint32_t _shard(uint32_t hash) {
+        return _num_shard_bits > 0 ? (hash >> (32 - _num_shard_bits)) : 0;
+    }
+
+    std::string _name;
+    const int _num_shard_bits;
+    const uint32_t _num_shards;
+    std::vector<std::unique_ptr<ClockCache>> _shards;
+    std::atomic<uint64_t> _last_id;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+    std::shared_ptr<MetricEntity> _entity = nullptr;
+    IntGauge* capacity = nullptr;
+    IntGauge* usage = nullptr;
+    DoubleGauge* usage_ratio = nullptr;
+    IntAtomicCounter* lookup_count = nullptr;
+    IntAtomicCounter* hit_count = nullptr;
+    DoubleGauge* hit_ratio = nullptr;
+};
+
+} // namespace doris
@@ -45,6 +45,8 @@ enum class PredicateType {
     IS_NULL = 9,
     IS_NOT_NULL = 10,
     BF = 11, // BloomFilter
+    MATCH = 12, // only evaluated by inverted index
+    LIKE = 13,
 };
 
 class ColumnPredicate {
@@ -70,6 +72,9 @@ public:
     virtual Status evaluate(const Schema& schema,
                             const std::vector<BitmapIndexIterator*>& iterators, uint32_t num_rows,
                             roaring::Roaring* roaring) const = 0;
+    // Whether the evaluation on Bitmap filters the rows exactly, so the predicate is not
+    // evaluated on the rows read any more.
+    virtual bool can_do_bitmap_index() const { return true; }
 
     // evaluate predicate on IColumn
     // a short circuit eval way
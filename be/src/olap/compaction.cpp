@@ -18,8 +18,11 @@
 #include "olap/compaction.h"
 
 #include "gutil/strings/substitute.h"
+#include "io/fs/io_limiter.h"
+#include "olap/rowset/vertical_beta_rowset_writer.h"
 #include "util/time.h"
 #include "util/trace.h"
+#include "vec/olap/vertical_merge_iterator.h"
 
 using std::vector;
 
@@ -110,6 +113,7 @@ Status Compaction::do_compaction(int64_t permits) {
     TRACE("start to do compaction");
     _tablet->data_dir()->disks_compaction_score_increment(permits);
     _tablet->data_dir()->disks_compaction_num_increment(1);
+    io::IOLimiter::Scope io_limiter_scope;
     Status st = do_compaction_impl(permits);
     _tablet->data_dir()->disks_compaction_score_increment(-permits);
     _tablet->data_dir()->disks_compaction_num_increment(-1);
@@ -136,14 +140,22 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     _oldest_write_timestamp = _input_rowsets.front()->oldest_write_timestamp();
     _newest_write_timestamp = _input_rowsets.back()->newest_write_timestamp();
 
+    auto use_ordered_data_compaction = _should_use_ordered_data_compaction();
     auto use_vectorized_compaction = _should_use_vectorized_compaction();
-    string merge_type = use_vectorized_compaction ? "v" : "";
+    auto use_vertical_compaction = !use_ordered_data_compaction && use_vectorized_compaction &&
+                                   _should_use_vertical_compaction();
+    string merge_type = use_ordered_data_compaction ? "ordered "
+                        : use_vertical_compaction   ? "vertical "
+                        : use_vectorized_compaction ? "v"
+                                                    : "";
 
     LOG(INFO) << "start " << merge_type << compaction_name() << ". tablet=" << _tablet->full_name()
               << ", output_version=" << _output_version << ", permits: " << permits;
 
-    RETURN_NOT_OK(construct_output_rowset_writer());
-    RETURN_NOT_OK(construct_input_rowset_readers());
+    RETURN_NOT_OK(construct_output_rowset_writer(use_vertical_compaction));
+    if (!use_vertical_compaction && !use_ordered_data_compaction) {
+        RETURN_NOT_OK(construct_input_rowset_readers());
+    }
     TRACE("prepare finished");
 
     // 2. write merged rows to output rowset
@@ -151,7 +163,14 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     Merger::Statistics stats;
     Status res;
 
-    if (use_vectorized_compaction) {
+    if (use_ordered_data_compaction) {
+        res = _link_ordered_rowsets(&stats);
+    } else if (use_vertical_compaction) {
+        res = Merger::vertical_merge_rowsets(
+                _tablet, compaction_type(), _input_rowsets,
+                static_cast<VerticalBetaRowsetWriter*>(_output_rs_writer.get()),
+                _get_vertical_compaction_max_rows_per_segment(), &stats);
+    } else if (use_vectorized_compaction) {
         res = Merger::vmerge_rowsets(_tablet, compaction_type(), _input_rs_readers,
                                      _output_rs_writer.get(), &stats);
     } else {
@@ -219,12 +238,125 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     return Status::OK();
 }
 
-Status Compaction::construct_output_rowset_writer() {
+Status Compaction::construct_output_rowset_writer(bool is_vertical) {
+    if (is_vertical) {
+        return _tablet->create_vertical_rowset_writer(_output_version, VISIBLE, NONOVERLAPPING,
+                                                      _oldest_write_timestamp,
+                                                      _newest_write_timestamp, &_output_rs_writer);
+    }
     return _tablet->create_rowset_writer(_output_version, VISIBLE, NONOVERLAPPING,
                                          _oldest_write_timestamp, _newest_write_timestamp,
                                          &_output_rs_writer);
 }
 
+bool Compaction::_should_use_ordered_data_compaction() {
+    if (!config::enable_ordered_data_compaction ||
+        compaction_type() != ReaderType::READER_CUMULATIVE_COMPACTION) {
+        return false;
+    }
+    if (_tablet->tablet_meta()->preferred_rowset_type() == ALPHA_ROWSET &&
+        StorageEngine::instance()->default_rowset_type() == ALPHA_ROWSET) {
+        return false;
+    }
+    if (_tablet->enable_unique_key_merge_on_write()) {
+        // the rows deleted until the output version must be dropped by merging
+        std::vector<RowsetId> input_rowset_ids;
+        for (auto& rowset : _input_rowsets) {
+            input_rowset_ids.push_back(rowset->rowset_id());
+        }
+        if (!_tablet->tablet_meta()
+                     ->delete_bitmap()
+                     .snapshot(input_rowset_ids, _output_version.second)
+                     .delete_bitmap.empty()) {
+            return false;
+        }
+    }
+    // The segments can be linked into the output rowset if they are ordered by keys in
+    // the order of versions. Only the rows of duplicate keys can have the same key.
+    bool allow_same_key = _tablet->tablet_schema().keys_type() == KeysType::DUP_KEYS;
+    const std::string* prev_max_key = nullptr;
+    for (auto& rowset : _input_rowsets) {
+        const auto& rowset_meta = rowset->rowset_meta();
+        if (rowset_meta->rowset_type() != BETA_ROWSET || rowset_meta->has_delete_predicate()) {
+            return false;
+        }
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        if (!rowset_meta->has_segments_key_bounds()) {
+            return false;
+        }
+        for (int64_t i = 0; i < rowset->num_segments(); ++i) {
+            const auto& key_bounds = rowset_meta->segment_key_bounds(i);
+            if (prev_max_key != nullptr) {
+                int cmp = key_bounds.min_key().compare(*prev_max_key);
+                if (cmp < 0 || (cmp == 0 && !allow_same_key)) {
+                    return false;
+                }
+            }
+            prev_max_key = &key_bounds.max_key();
+        }
+    }
+    return true;
+}
+
+Status Compaction::_link_ordered_rowsets(Merger::Statistics* stats) {
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        RETURN_NOT_OK(_output_rs_writer->add_rowset(rowset));
+    }
+    RETURN_NOT_OK(_output_rs_writer->flush());
+    stats->output_rows = _input_row_num;
+    return Status::OK();
+}
+
+bool Compaction::_should_use_vectorized_compaction() {
+    return config::enable_vectorized_compaction;
+}
+
+bool Compaction::_should_use_vertical_compaction() {
+    if (!config::enable_vertical_compaction) {
+        return false;
+    }
+    const auto& tablet_schema = _tablet->tablet_schema();
+    if (static_cast<int32_t>(tablet_schema.num_columns()) <
+        config::vertical_compaction_min_num_columns) {
+        return false;
+    }
+    // The rows of aggregate keys are aggregated by all the value columns together, and the
+    // rows with the same key are replaced by the sequence column, they can not be merged
+    // only by key columns.
+    if (tablet_schema.keys_type() == AGG_KEYS || tablet_schema.has_sequence_col()) {
+        return false;
+    }
+    if (_tablet->tablet_meta()->preferred_rowset_type() == ALPHA_ROWSET &&
+        StorageEngine::instance()->default_rowset_type() == ALPHA_ROWSET) {
+        return false;
+    }
+    int64_t num_segments = 0;
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->rowset_meta()->rowset_type() != BETA_ROWSET) {
+            return false;
+        }
+        // delete conditions may refer to value columns, which are not read with the keys
+        if (compaction_type() == ReaderType::READER_BASE_COMPACTION &&
+            rowset->rowset_meta()->has_delete_predicate()) {
+            return false;
+        }
+        num_segments += rowset->num_segments();
+    }
+    return num_segments <= vectorized::RowSource::MAX_SOURCE_NUM;
+}
+
+uint32_t Compaction::_get_vertical_compaction_max_rows_per_segment() {
+    int64_t avg_row_size = _input_rowsets_size / std::max<int64_t>(_input_row_num, 1);
+    int64_t max_rows =
+            config::vertical_compaction_max_segment_size / std::max<int64_t>(avg_row_size, 1);
+    return std::clamp<int64_t>(max_rows, 1, std::numeric_limits<uint32_t>::max());
+}
+
 Status Compaction::construct_input_rowset_readers() {
     for (auto& rowset : _input_rowsets) {
         RowsetReaderSharedPtr rs_reader;
@@ -237,6 +369,13 @@ Status Compaction::construct_input_rowset_readers() {
 Status Compaction::modify_rowsets() {
     std::vector<RowsetSharedPtr> output_rowsets;
     output_rowsets.push_back(_output_rowset);
+    std::unique_lock<std::mutex> update_lock;
+    if (_tablet->enable_unique_key_merge_on_write()) {
+        // no loads could be published until the delete bitmap is transferred to output rowset
+        update_lock = std::unique_lock<std::mutex>(_tablet->get_rowset_update_lock());
+        RETURN_NOT_OK(
+                _tablet->update_delete_bitmap_for_compaction(_input_rowsets, _output_rowset));
+    }
     std::lock_guard<std::shared_mutex> wrlock(_tablet->get_header_lock());
     RETURN_NOT_OK(_tablet->modify_rowsets(output_rowsets, _input_rowsets, true));
     _tablet->save_meta();
@@ -67,7 +67,7 @@ protected:
     Status modify_rowsets();
     void gc_output_rowset();
 
-    Status construct_output_rowset_writer();
+    Status construct_output_rowset_writer(bool is_vertical = false);
     Status construct_input_rowset_readers();
 
     Status check_version_continuity(const std::vector<RowsetSharedPtr>& rowsets);
@@ -81,6 +81,16 @@ private:
     // return -1 if these are not alpha rowsets.
     int64_t _get_input_num_rows_from_seg_grps();
 
+    // Whether the input rowsets are ordered by keys without deleted rows, so that the
+    // output rowset can be made by linking their segments instead of merging.
+    bool _should_use_ordered_data_compaction();
+    Status _link_ordered_rowsets(Merger::Statistics* stats);
+
+    bool _should_use_vectorized_compaction();
+    bool _should_use_vertical_compaction();
+    // max rows of an output segment of vertical compaction, estimated by the input rowsets
+    uint32_t _get_vertical_compaction_max_rows_per_segment();
+
 protected:
     // the root tracker for this compaction
     std::shared_ptr<MemTracker> _mem_tracker;
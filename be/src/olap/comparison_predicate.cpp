@@ -144,10 +144,8 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE(GreaterPredicate, >)
 COMPARISON_PRED_COLUMN_BLOCK_EVALUATE(GreaterEqualPredicate, >=)
 
 // todo(zeno) define interface in IColumn to simplify code
-// If 1 OP 0 returns true, it means the predicate is > or >=
-// If 1 OP 1 returns true, it means the predicate is >= or <=
-// by this way, avoid redundant code
-#define COMPARISON_PRED_COLUMN_EVALUATE(CLASS, OP, IS_RANGE)                                       \
+// For dictionary columns, the predicate is evaluated once for each value of the dictionary.
+#define COMPARISON_PRED_COLUMN_EVALUATE(CLASS, OP)                                                 \
     template <class T>                                                                             \
     void CLASS<T>::evaluate(vectorized::IColumn& column, uint16_t* sel, uint16_t* size) const {    \
         uint16_t new_size = 0;                                                                     \
@@ -163,14 +161,13 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE(GreaterEqualPredicate, >=)
                     auto* nested_col_ptr = vectorized::check_and_get_column<                       \
                             vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);          \
                     auto& data_array = nested_col_ptr->get_data();                                 \
-                    auto dict_code =                                                               \
-                            IS_RANGE ? nested_col_ptr->find_code_by_bound(_value, 1 OP 0, 1 OP 1)  \
-                                     : nested_col_ptr->find_code(_value);                          \
+                    const auto& code_flags = nested_col_ptr->find_codes_by_predicate(              \
+                            this, [this](const StringValue& value) { return value OP _value; });   \
                     for (uint16_t i = 0; i < *size; i++) {                                         \
                         uint16_t idx = sel[i];                                                     \
                         sel[new_size] = idx;                                                       \
                         const auto& cell_value = data_array[idx];                                  \
-                        bool ret = !null_bitmap[idx] && (cell_value OP dict_code);                 \
+                        bool ret = !null_bitmap[idx] && code_flags[cell_value];                    \
                         new_size += _opposite ? !ret : ret;                                        \
                     }                                                                              \
                 }                                                                                  \
@@ -193,13 +190,13 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE(GreaterEqualPredicate, >=)
                         reinterpret_cast<vectorized::ColumnDictionary<vectorized::Int32>&>(        \
                                 column);                                                           \
                 auto& data_array = dict_col.get_data();                                            \
-                auto dict_code = IS_RANGE ? dict_col.find_code_by_bound(_value, 1 OP 0, 1 OP 1)    \
-                                          : dict_col.find_code(_value);                            \
+                const auto& code_flags = dict_col.find_codes_by_predicate(                         \
+                        this, [this](const StringValue& value) { return value OP _value; });       \
                 for (uint16_t i = 0; i < *size; ++i) {                                             \
                     uint16_t idx = sel[i];                                                         \
                     sel[new_size] = idx;                                                           \
                     const auto& cell_value = data_array[idx];                                      \
-                    bool ret = cell_value OP dict_code;                                            \
+                    bool ret = code_flags[cell_value];                                             \
                     new_size += _opposite ? !ret : ret;                                            \
                 }                                                                                  \
             }                                                                                      \
@@ -217,12 +214,12 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE(GreaterEqualPredicate, >=)
         *size = new_size;                                                                          \
     }
 
-COMPARISON_PRED_COLUMN_EVALUATE(EqualPredicate, ==, false)
-COMPARISON_PRED_COLUMN_EVALUATE(NotEqualPredicate, !=, false)
-COMPARISON_PRED_COLUMN_EVALUATE(LessPredicate, <, true)
-COMPARISON_PRED_COLUMN_EVALUATE(LessEqualPredicate, <=, true)
-COMPARISON_PRED_COLUMN_EVALUATE(GreaterPredicate, >, true)
-COMPARISON_PRED_COLUMN_EVALUATE(GreaterEqualPredicate, >=, true)
+COMPARISON_PRED_COLUMN_EVALUATE(EqualPredicate, ==)
+COMPARISON_PRED_COLUMN_EVALUATE(NotEqualPredicate, !=)
+COMPARISON_PRED_COLUMN_EVALUATE(LessPredicate, <)
+COMPARISON_PRED_COLUMN_EVALUATE(LessEqualPredicate, <=)
+COMPARISON_PRED_COLUMN_EVALUATE(GreaterPredicate, >)
+COMPARISON_PRED_COLUMN_EVALUATE(GreaterEqualPredicate, >=)
 
 #define COMPARISON_PRED_COLUMN_EVALUATE_VEC(CLASS, OP)                                           \
     template <class T>                                                                           \
@@ -298,7 +295,7 @@ COMPARISON_PRED_COLUMN_EVALUATE_VEC(GreaterEqualPredicate, >=)
 COMPARISON_PRED_COLUMN_BLOCK_EVALUATE_BOOL2(or, |, )
 COMPARISON_PRED_COLUMN_BLOCK_EVALUATE_BOOL2(and, &, !)
 
-#define COMPARISON_PRED_COLUMN_EVALUATE_BOOL(CLASS, OP, IS_RANGE, BOOL_NAME, BOOL_OP, SHORT_OP)    \
+#define COMPARISON_PRED_COLUMN_EVALUATE_BOOL(CLASS, OP, BOOL_NAME, BOOL_OP, SHORT_OP)              \
     template <class T>                                                                             \
     void CLASS<T>::evaluate_##BOOL_NAME(vectorized::IColumn& column, uint16_t* sel, uint16_t size, \
                                         bool* flags) const {                                       \
@@ -314,13 +311,12 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE_BOOL2(and, &, !)
                     auto* nested_col_ptr = vectorized::check_and_get_column<                       \
                             vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);          \
                     auto& data_array = nested_col_ptr->get_data();                                 \
-                    auto dict_code =                                                               \
-                            IS_RANGE ? nested_col_ptr->find_code_by_bound(_value, 1 OP 0, 1 OP 1)  \
-                                     : nested_col_ptr->find_code(_value);                          \
+                    const auto& code_flags = nested_col_ptr->find_codes_by_predicate(              \
+                            this, [this](const StringValue& value) { return value OP _value; });   \
                     for (uint16_t i = 0; i < size; i++) {                                          \
                         if (SHORT_OP(flags[i])) continue;                                          \
                         uint16_t idx = sel[i];                                                     \
-                        bool ret = !null_bitmap[idx] && (data_array[idx] OP dict_code);            \
+                        bool ret = !null_bitmap[idx] && code_flags[data_array[idx]];               \
                         flags[i] = flags[i] BOOL_OP(_opposite ? !ret : ret);                       \
                     }                                                                              \
                 }                                                                                  \
@@ -341,12 +337,12 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE_BOOL2(and, &, !)
                         reinterpret_cast<vectorized::ColumnDictionary<vectorized::Int32>&>(        \
                                 column);                                                           \
                 auto& data_array = dict_col.get_data();                                            \
-                auto dict_code = IS_RANGE ? dict_col.find_code_by_bound(_value, 1 OP 0, 1 OP 1)    \
-                                          : dict_col.find_code(_value);                            \
+                const auto& code_flags = dict_col.find_codes_by_predicate(                         \
+                        this, [this](const StringValue& value) { return value OP _value; });       \
                 for (uint16_t i = 0; i < size; i++) {                                              \
                     if (SHORT_OP(flags[i])) continue;                                              \
                     uint16_t idx = sel[i];                                                         \
-                    bool ret = data_array[idx] OP dict_code;                                       \
+                    bool ret = code_flags[data_array[idx]];                                        \
                     flags[i] = flags[i] BOOL_OP(_opposite ? !ret : ret);                           \
                 }                                                                                  \
             }                                                                                      \
@@ -363,16 +359,13 @@ COMPARISON_PRED_COLUMN_BLOCK_EVALUATE_BOOL2(and, &, !)
         }                                                                                          \
     }
 
-#define COMPARISON_PRED_COLUMN_EVALUATE_BOOL2(BOOL_NAME, BOOL_OP, SHORT_OP)                       \
-    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(EqualPredicate, ==, false, BOOL_NAME, BOOL_OP, SHORT_OP) \
-    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(NotEqualPredicate, !=, false, BOOL_NAME, BOOL_OP,        \
-                                         SHORT_OP)                                                \
-    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(LessPredicate, <, true, BOOL_NAME, BOOL_OP, SHORT_OP)    \
-    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(LessEqualPredicate, <=, true, BOOL_NAME, BOOL_OP,        \
-                                         SHORT_OP)                                                \
-    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(GreaterPredicate, >, true, BOOL_NAME, BOOL_OP, SHORT_OP) \
-    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(GreaterEqualPredicate, >=, true, BOOL_NAME, BOOL_OP,     \
-                                         SHORT_OP)
+#define COMPARISON_PRED_COLUMN_EVALUATE_BOOL2(BOOL_NAME, BOOL_OP, SHORT_OP)                        \
+    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(EqualPredicate, ==, BOOL_NAME, BOOL_OP, SHORT_OP)         \
+    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(NotEqualPredicate, !=, BOOL_NAME, BOOL_OP, SHORT_OP)      \
+    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(LessPredicate, <, BOOL_NAME, BOOL_OP, SHORT_OP)           \
+    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(LessEqualPredicate, <=, BOOL_NAME, BOOL_OP, SHORT_OP)     \
+    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(GreaterPredicate, >, BOOL_NAME, BOOL_OP, SHORT_OP)        \
+    COMPARISON_PRED_COLUMN_EVALUATE_BOOL(GreaterEqualPredicate, >=, BOOL_NAME, BOOL_OP, SHORT_OP)
 
 COMPARISON_PRED_COLUMN_EVALUATE_BOOL2(or, |, )
 COMPARISON_PRED_COLUMN_EVALUATE_BOOL2(and, &, !)
@@ -460,6 +460,173 @@ void NumBasedCumulativeCompactionPolicy::calculate_cumulative_point(
     }
 }
 
+TimeSeriesCumulativeCompactionPolicy::TimeSeriesCumulativeCompactionPolicy(int64_t goal_size,
+                                                                           int64_t time_window_sec)
+        : CumulativeCompactionPolicy(),
+          _goal_size(goal_size),
+          _time_window_sec(std::max<int64_t>(time_window_sec, 1)) {}
+
+void TimeSeriesCumulativeCompactionPolicy::calculate_cumulative_point(
+        Tablet* tablet, const std::vector<RowsetMetaSharedPtr>& all_metas,
+        int64_t current_cumulative_point, int64_t* ret_cumulative_point) {
+    _num_based_policy.calculate_cumulative_point(tablet, all_metas, current_cumulative_point,
+                                                 ret_cumulative_point);
+}
+
+void TimeSeriesCumulativeCompactionPolicy::calc_cumulative_compaction_score(
+        TabletState state, const std::vector<RowsetMetaSharedPtr>& all_rowsets,
+        const int64_t current_cumulative_point, uint32_t* score) {
+    _num_based_policy.calc_cumulative_compaction_score(state, all_rowsets,
+                                                       current_cumulative_point, score);
+}
+
+int64_t TimeSeriesCumulativeCompactionPolicy::_time_bucket(
+        const RowsetMetaSharedPtr& rs_meta) const {
+    int64_t timestamp = rs_meta->newest_write_timestamp();
+    if (timestamp < 0) {
+        // the rowsets written before the write timestamps are recorded
+        timestamp = rs_meta->creation_time();
+    }
+    return _time_bucket(timestamp);
+}
+
+bool TimeSeriesCumulativeCompactionPolicy::_is_closed(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets, size_t index,
+        int64_t now) const {
+    auto rs_meta = candidate_rowsets[index]->rowset_meta();
+    if (rs_meta->is_segments_overlapping()) {
+        return false;
+    }
+    if (rs_meta->total_disk_size() >= _goal_size) {
+        return true;
+    }
+    // the only run left in its bucket, which is closed by a later rowset or by the time
+    int64_t bucket = _time_bucket(rs_meta);
+    if (index + 1 < candidate_rowsets.size()) {
+        auto& next = candidate_rowsets[index + 1];
+        return tablet->version_for_delete_predicate(next->version()) ||
+               _time_bucket(next->rowset_meta()) != bucket;
+    }
+    return bucket < _time_bucket(now);
+}
+
+int TimeSeriesCumulativeCompactionPolicy::pick_input_rowsets(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+        const int64_t max_compaction_score, const int64_t min_compaction_score,
+        std::vector<RowsetSharedPtr>* input_rowsets, Version* last_delete_version,
+        size_t* compaction_score) {
+    *compaction_score = 0;
+    int64_t now = UnixSeconds();
+
+    // skip the closed rowsets at the front, they are never compacted again
+    size_t i = 0;
+    while (i < candidate_rowsets.size() &&
+           !tablet->version_for_delete_predicate(candidate_rowsets[i]->version()) &&
+           _is_closed(tablet, candidate_rowsets, i, now)) {
+        ++i;
+    }
+    if (i > 0 && tablet->tablet_state() == TABLET_RUNNING) {
+        tablet->set_cumulative_layer_point(candidate_rowsets[i - 1]->end_version() + 1);
+    }
+
+    // pick the rowsets of the first bucket left
+    int64_t bucket = -1;
+    int64_t total_size = 0;
+    bool bucket_closed = false;
+    bool reach_goal_size = false;
+    for (; i < candidate_rowsets.size(); ++i) {
+        RowsetSharedPtr rowset = candidate_rowsets[i];
+        if (tablet->version_for_delete_predicate(rowset->version())) {
+            // the rowsets before a delete version are never compacted with the ones after it,
+            // if there is no rowset before, the cumulative point moves after the delete version.
+            *last_delete_version = rowset->version();
+            bucket_closed = true;
+            break;
+        }
+        int64_t rowset_bucket = _time_bucket(rowset->rowset_meta());
+        int64_t rowset_size = rowset->rowset_meta()->total_disk_size();
+        if (input_rowsets->empty()) {
+            bucket = rowset_bucket;
+        } else if (rowset_bucket != bucket) {
+            bucket_closed = true;
+            break;
+        } else if (total_size + rowset_size > _goal_size) {
+            reach_goal_size = true;
+            break;
+        }
+        if (*compaction_score >= max_compaction_score) {
+            // got enough segments
+            break;
+        }
+        *compaction_score += rowset->rowset_meta()->get_compaction_score();
+        total_size += rowset_size;
+        input_rowsets->push_back(rowset);
+    }
+    int transient_size = i;
+
+    if (input_rowsets->empty()) {
+        // no rowset before the delete version, or all the rowsets are closed
+        return last_delete_version->first != -1 ? transient_size : candidate_rowsets.size();
+    }
+    if (bucket < _time_bucket(now)) {
+        bucket_closed = true;
+    }
+
+    if (bucket_closed || reach_goal_size) {
+        // the last compaction of these rowsets, a single non-overlapping one is closed already
+        if (input_rowsets->size() == 1 &&
+            !input_rowsets->front()->rowset_meta()->is_segments_overlapping()) {
+            if (tablet->tablet_state() == TABLET_RUNNING) {
+                tablet->set_cumulative_layer_point(input_rowsets->front()->end_version() + 1);
+            }
+            input_rowsets->clear();
+            *compaction_score = 0;
+        }
+        return transient_size;
+    }
+
+    // In the open bucket, the rowsets are compacted with the ones of the same size tier, a rowset
+    // is not compacted again until the total size of the rowsets after it reaches its size, so
+    // the number of times a row is rewritten in the bucket is logarithmic.
+    auto rs_iter = input_rowsets->begin();
+    while (rs_iter != input_rowsets->end()) {
+        auto rs_meta = (*rs_iter)->rowset_meta();
+        if (rs_meta->is_segments_overlapping() ||
+            rs_meta->total_disk_size() < total_size - rs_meta->total_disk_size()) {
+            break;
+        }
+        total_size -= rs_meta->total_disk_size();
+        *compaction_score -= rs_meta->get_compaction_score();
+        rs_iter = input_rowsets->erase(rs_iter);
+    }
+
+    VLOG_CRITICAL << "cumulative compaction time_series policy, compaction_score = "
+                  << *compaction_score << ", total_size = " << total_size
+                  << ", tablet = " << tablet->full_name() << ", input_rowset size "
+                  << input_rowsets->size();
+
+    if (*compaction_score < min_compaction_score) {
+        input_rowsets->clear();
+        *compaction_score = 0;
+        return candidate_rowsets.size();
+    }
+    return transient_size;
+}
+
+void TimeSeriesCumulativeCompactionPolicy::update_cumulative_point(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& input_rowsets,
+        RowsetSharedPtr output_rowset, Version& last_delete_version) {
+    if (tablet->tablet_state() != TABLET_RUNNING) {
+        // if tablet under alter process, do not update cumulative point
+        return;
+    }
+    if (last_delete_version.first != -1 ||
+        output_rowset->rowset_meta()->total_disk_size() >= _goal_size ||
+        _time_bucket(output_rowset->rowset_meta()) < _time_bucket(UnixSeconds())) {
+        tablet->set_cumulative_layer_point(output_rowset->end_version() + 1);
+    }
+}
+
 void CumulativeCompactionPolicy::pick_candidate_rowsets(
         const std::unordered_map<Version, RowsetSharedPtr, HashOfVersion>& rs_version_map,
         int64_t cumulative_point, std::vector<RowsetSharedPtr>* candidate_rowsets) {
@@ -483,6 +650,9 @@ CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy(std::stri
     } else if (policy_type == SIZE_BASED_POLICY) {
         return std::unique_ptr<CumulativeCompactionPolicy>(
                 new SizeBasedCumulativeCompactionPolicy());
+    } else if (policy_type == TIME_SERIES_POLICY) {
+        return std::unique_ptr<CumulativeCompactionPolicy>(
+                new TimeSeriesCumulativeCompactionPolicy());
     }
 
     return std::shared_ptr<CumulativeCompactionPolicy>(new NumBasedCumulativeCompactionPolicy());
@@ -494,6 +664,8 @@ void CumulativeCompactionPolicyFactory::_parse_cumulative_compaction_policy(
         *policy_type = NUM_BASED_POLICY;
     } else if (type == CUMULATIVE_SIZE_BASED_POLICY) {
         *policy_type = SIZE_BASED_POLICY;
+    } else if (type == CUMULATIVE_TIME_SERIES_POLICY) {
+        *policy_type = TIME_SERIES_POLICY;
     } else {
         LOG(WARNING) << "parse cumulative compaction policy error " << type << ", default use "
                      << CUMULATIVE_NUM_BASED_POLICY;
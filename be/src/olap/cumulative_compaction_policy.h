@@ -30,16 +30,19 @@ namespace doris {
 class Tablet;
 
 /// This CompactionPolicy enum is used to represent the type of compaction policy.
-/// Now it has two values, NUM_BASED_POLICY and SIZE_BASED_POLICY.
+/// Now it has three values, NUM_BASED_POLICY, SIZE_BASED_POLICY and TIME_SERIES_POLICY.
 /// NUM_BASED_POLICY means current compaction policy implemented by num based policy.
 /// SIZE_BASED_POLICY means current compaction policy implemented by size_based policy.
+/// TIME_SERIES_POLICY means current compaction policy implemented by time series policy.
 enum CompactionPolicy {
     NUM_BASED_POLICY = 0,
     SIZE_BASED_POLICY = 1,
+    TIME_SERIES_POLICY = 2,
 };
 
 const static std::string CUMULATIVE_NUM_BASED_POLICY = "NUM_BASED";
 const static std::string CUMULATIVE_SIZE_BASED_POLICY = "SIZE_BASED";
+const static std::string CUMULATIVE_TIME_SERIES_POLICY = "TIME_SERIES";
 /// This class CumulativeCompactionPolicy is the base class of cumulative compaction policy.
 /// It defines the policy to do cumulative compaction. It has different derived classes, which implements
 /// concrete cumulative compaction algorithm. The policy is configured by conf::cumulative_compaction_policy.
@@ -243,11 +246,72 @@ private:
     std::vector<int64_t> _levels;
 };
 
+/// Time series cumulative compaction policy implemention, which is targeting the append-only tables like logs.
+/// The rowsets are divided into time buckets by their write time, and only the rowsets in the same bucket are
+/// compacted together. In the open bucket, the newly loaded rowsets are compacted into runs tiered by size, and
+/// once the bucket is closed, i.e. its time window passes, its runs are compacted into outputs of the goal size.
+/// These outputs are never compacted again: the cumulative point moves after them, and there is no base compaction
+/// in this policy. So the rows are rewritten only a few times, trading off the number of rowsets of the tablets.
+class TimeSeriesCumulativeCompactionPolicy final : public CumulativeCompactionPolicy {
+public:
+    TimeSeriesCumulativeCompactionPolicy(
+            int64_t goal_size = config::time_series_compaction_goal_size_mbytes * 1024 * 1024,
+            int64_t time_window_sec = config::time_series_compaction_time_window_seconds);
+
+    ~TimeSeriesCumulativeCompactionPolicy() {}
+
+    /// Time series policy implements calculate cumulative point function in the same way as num based policy.
+    void calculate_cumulative_point(Tablet* tablet,
+                                    const std::vector<RowsetMetaSharedPtr>& all_rowsets,
+                                    int64_t current_cumulative_point,
+                                    int64_t* cumulative_point) override;
+
+    /// Time series policy implements pick input rowsets function.
+    /// It skips the closed rowsets at the front, moving the cumulative point after them, then picks the rowsets of
+    /// the first bucket left: all of them up to the goal size if the bucket is closed, otherwise the rowsets of the
+    /// same size tier.
+    int pick_input_rowsets(Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+                           const int64_t max_compaction_score, const int64_t min_compaction_score,
+                           std::vector<RowsetSharedPtr>* input_rowsets,
+                           Version* last_delete_version, size_t* compaction_score) override;
+
+    /// Time series policy implements update cumulative point function.
+    /// The cumulative point moves after the output rowset if it is closed, i.e. it reaches the goal size, its bucket
+    /// is closed, or it is followed by a delete version.
+    void update_cumulative_point(Tablet* tablet, const std::vector<RowsetSharedPtr>& input_rowsets,
+                                 RowsetSharedPtr _output_rowset,
+                                 Version& last_delete_version) override;
+
+    /// Time series policy implements calc cumulative compaction score function in the same way as num based policy.
+    void calc_cumulative_compaction_score(TabletState state,
+                                          const std::vector<RowsetMetaSharedPtr>& all_rowsets,
+                                          int64_t current_cumulative_point,
+                                          uint32_t* score) override;
+
+    std::string name() override { return CUMULATIVE_TIME_SERIES_POLICY; }
+
+private:
+    /// the time bucket of the rowset by its newest write time
+    int64_t _time_bucket(const RowsetMetaSharedPtr& rs_meta) const;
+    int64_t _time_bucket(int64_t timestamp) const { return timestamp / _time_window_sec; }
+
+    /// whether the candidate rowset at `index` is closed, which is never compacted again
+    bool _is_closed(Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+                    size_t index, int64_t now) const;
+
+private:
+    /// the goal size of the output rowsets, unit is byte.
+    int64_t _goal_size;
+    /// the time window of the buckets, unit is second.
+    int64_t _time_window_sec;
+    NumBasedCumulativeCompactionPolicy _num_based_policy;
+};
+
 /// The factory of CumulativeCompactionPolicy, it can product different policy according to the `policy` parameter.
 class CumulativeCompactionPolicyFactory {
 public:
     /// Static factory function. It can product different policy according to the `policy` parameter and use tablet ptr
-    /// to construct the policy. Now it can product size based and num based policies.
+    /// to construct the policy. Now it can product size based, num based and time series policies.
     static std::shared_ptr<CumulativeCompactionPolicy> create_cumulative_compaction_policy(
             std::string policy);
 
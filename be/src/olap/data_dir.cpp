@@ -29,7 +29,9 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -47,10 +49,13 @@
 #include "olap/utils.h" // for check_dir_existed
 #include "service/backend_options.h"
 #include "util/errno.h"
+#include "util/defer_op.h"
+#include "util/doris_metrics.h"
 #include "util/file_utils.h"
 #include "util/storage_backend.h"
 #include "util/storage_backend_mgr.h"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 
 using strings::Substitute;
 
@@ -94,6 +99,10 @@ DataDir::DataDir(const std::string& path, int64_t capacity_bytes,
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_compaction_num);
 }
 
+io::IOLimiter* DataDir::io_limiter() const {
+    return static_cast<io::LocalFileSystem*>(_fs.get())->io_limiter();
+}
+
 DataDir::~DataDir() {
     DorisMetrics::instance()->metric_registry()->deregister_entity(_data_dir_metric_entity);
     delete _id_generator;
@@ -354,6 +363,71 @@ Status DataDir::_check_incompatible_old_format_tablet() {
 }
 
 // TODO(ygl): deal with rowsets and tablets when load failed
+namespace {
+
+// Runs 'func' on the entries by a pool in batches, to parse and init the metas of a data dir
+// concurrently while its meta is traversed serially. The number of the queued batches is
+// bounded to bound the memory of the entries waiting.
+template <typename Entry>
+class BatchLoader {
+public:
+    BatchLoader(ThreadPool* pool, int num_threads, std::function<void(Entry&)> func)
+            : _pool(pool), _num_threads(num_threads), _func(std::move(func)) {}
+
+    void add(Entry entry) {
+        _batch.push_back(std::move(entry));
+        if (_batch.size() >= BATCH_SIZE) {
+            _flush();
+        }
+    }
+
+    // Waits for all the entries.
+    void finish() {
+        _flush();
+        _pool->wait();
+    }
+
+private:
+    static constexpr size_t BATCH_SIZE = 256;
+
+    void _flush() {
+        if (_batch.empty()) {
+            return;
+        }
+        auto batch = std::make_shared<std::vector<Entry>>(std::move(_batch));
+        _batch.clear();
+        if (_pool->get_queue_size() >= _num_threads * 2) {
+            _pool->wait();
+        }
+        auto run = [batch, func = &_func]() {
+            for (auto& entry : *batch) {
+                (*func)(entry);
+            }
+        };
+        if (!_pool->submit_func(run).ok()) {
+            run();
+        }
+    }
+
+    ThreadPool* _pool;
+    const int _num_threads;
+    std::function<void(Entry&)> _func;
+    std::vector<Entry> _batch;
+};
+
+struct RowsetMetaEntry {
+    RowsetId rowset_id;
+    std::string meta;
+};
+
+struct TabletMetaEntry {
+    int64_t tablet_id;
+    int32_t schema_hash;
+    std::string meta;
+};
+
+} // namespace
+
 Status DataDir::load() {
     LOG(INFO) << "start to load tablets from " << _path;
 
@@ -365,25 +439,44 @@ Status DataDir::load() {
     // necessarily check incompatible old format. when there are old metas, it may load to data missing
     _check_incompatible_old_format_tablet();
 
+    // The meta is traversed serially, the metas are parsed and loaded by the pool.
+    int num_threads = std::max(config::load_data_dir_thread_num, 1);
+    std::unique_ptr<ThreadPool> load_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("LoadDataDirThreadPool")
+                            .set_min_threads(num_threads)
+                            .set_max_threads(num_threads)
+                            .build(&load_pool));
+    DorisMetrics::instance()->startup_loading_data_dirs->increment(1);
+    Defer defer {[]() { DorisMetrics::instance()->startup_loading_data_dirs->increment(-1); }};
+
+    std::mutex load_lock;
     std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas, &local_fs = fs()](
-                                    TabletUid tablet_uid, RowsetId rowset_id,
-                                    const std::string& meta_str) -> bool {
-        RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
-        if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
-        }
-        if (rowset_meta->is_local()) {
-            rowset_meta->set_fs(local_fs);
-        }
-        dir_rowset_metas.push_back(rowset_meta);
+    BatchLoader<RowsetMetaEntry> rowset_meta_loader(
+            load_pool.get(), num_threads,
+            [&dir_rowset_metas, &load_lock, &local_fs = fs()](RowsetMetaEntry& entry) {
+                RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
+                bool parsed = rowset_meta->init(entry.meta);
+                std::string().swap(entry.meta);
+                if (!parsed) {
+                    LOG(WARNING) << "parse rowset meta string failed for rowset_id:"
+                                 << entry.rowset_id;
+                    return;
+                }
+                if (rowset_meta->is_local()) {
+                    rowset_meta->set_fs(local_fs);
+                }
+                std::lock_guard l(load_lock);
+                dir_rowset_metas.push_back(rowset_meta);
+            });
+    auto load_rowset_func = [&rowset_meta_loader](TabletUid tablet_uid, RowsetId rowset_id,
+                                                  const std::string& meta_str) -> bool {
+        DorisMetrics::instance()->startup_rowset_metas->increment(1);
+        rowset_meta_loader.add({rowset_id, meta_str});
         return true;
     };
     Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_meta, load_rowset_func);
+    rowset_meta_loader.finish();
 
     if (!load_rowset_status) {
         LOG(WARNING) << "errors when load rowset meta from meta env, skip this data dir:" << _path;
@@ -396,36 +489,49 @@ Status DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
-                                    int64_t tablet_id, int32_t schema_hash,
-                                    const std::string& value) -> bool {
-        Status status = _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value,
-                                                               false, false, false, false);
-        if (!status.ok() && status.precise_code() != OLAP_ERR_TABLE_ALREADY_DELETED_ERROR &&
-            status.precise_code() != OLAP_ERR_ENGINE_INSERT_OLD_TABLET) {
-            // load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
-            // which means the tablet status is DELETED
-            // This may happen when the tablet was just deleted before the BE restarted,
-            // but it has not been cleared from rocksdb. At this time, restarting the BE
-            // will read the tablet in the DELETE state from rocksdb. These tablets have been
-            // added to the garbage collection queue and will be automatically deleted afterwards.
-            // Therefore, we believe that this situation is not a failure.
-
-            // Besides, load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)
-            // when BE is restarting and the older tablet have been added to the
-            // garbage collection queue but not deleted yet.
-            // In this case, since the data_dirs are parallel loaded, a later loaded tablet
-            // may be older than previously loaded one, which should not be acknowledged as a
-            // failure.
-            LOG(WARNING) << "load tablet from header failed. status:" << status
-                         << ", tablet=" << tablet_id << "." << schema_hash;
-            failed_tablet_ids.insert(tablet_id);
-        } else {
-            tablet_ids.insert(tablet_id);
-        }
+    BatchLoader<TabletMetaEntry> tablet_meta_loader(
+            load_pool.get(), num_threads,
+            [this, &tablet_ids, &failed_tablet_ids, &load_lock](TabletMetaEntry& entry) {
+                Status status = _tablet_manager->load_tablet_from_meta(
+                        this, entry.tablet_id, entry.schema_hash, entry.meta, false, false, false,
+                        false);
+                std::string().swap(entry.meta);
+                DorisMetrics::instance()->startup_loaded_tablet_metas_total->increment(1);
+                std::lock_guard l(load_lock);
+                if (!status.ok() && status.precise_code() != OLAP_ERR_TABLE_ALREADY_DELETED_ERROR &&
+                    status.precise_code() != OLAP_ERR_ENGINE_INSERT_OLD_TABLET) {
+                    // load_tablet_from_meta() may return
+                    // Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
+                    // which means the tablet status is DELETED
+                    // This may happen when the tablet was just deleted before the BE
+                    // restarted, but it has not been cleared from rocksdb. At this time,
+                    // restarting the BE will read the tablet in the DELETE state from rocksdb.
+                    // These tablets have been added to the garbage collection queue and will
+                    // be automatically deleted afterwards.
+                    // Therefore, we believe that this situation is not a failure.
+
+                    // Besides, load_tablet_from_meta() may return
+                    // Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)
+                    // when BE is restarting and the older tablet have been added to the
+                    // garbage collection queue but not deleted yet.
+                    // In this case, since the data_dirs and the tablets are parallel loaded,
+                    // a later loaded tablet may be older than previously loaded one, which
+                    // should not be acknowledged as a failure.
+                    LOG(WARNING) << "load tablet from header failed. status:" << status
+                                 << ", tablet=" << entry.tablet_id << "." << entry.schema_hash;
+                    failed_tablet_ids.insert(entry.tablet_id);
+                } else {
+                    tablet_ids.insert(entry.tablet_id);
+                }
+            });
+    auto load_tablet_func = [&tablet_meta_loader](int64_t tablet_id, int32_t schema_hash,
+                                                  const std::string& value) -> bool {
+        DorisMetrics::instance()->startup_tablet_metas->increment(1);
+        tablet_meta_loader.add({tablet_id, schema_hash, value});
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    tablet_meta_loader.finish();
     if (failed_tablet_ids.size() != 0) {
         LOG(WARNING) << "load tablets from header failed"
                      << ", loaded tablet: " << tablet_ids.size()
@@ -448,66 +554,16 @@ Status DataDir::load() {
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    int64_t invalid_rowset_counter = 0;
-    for (auto rowset_meta : dir_rowset_metas) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
-        // tablet maybe dropped, but not drop related rowset meta
-        if (tablet == nullptr) {
-            VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
-                        << ", schema hash: " << rowset_meta->tablet_schema_hash()
-                        << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            ++invalid_rowset_counter;
-            continue;
-        }
-
-        RowsetSharedPtr rowset;
-        Status create_status = tablet->create_rowset(rowset_meta, &rowset);
-        if (!create_status) {
-            LOG(WARNING) << "could not create rowset from rowsetmeta: "
-                         << " rowset_id: " << rowset_meta->rowset_id()
-                         << " rowset_type: " << rowset_meta->rowset_type()
-                         << " rowset_state: " << rowset_meta->rowset_state();
-            continue;
-        }
-        if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
-            rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            Status commit_txn_status = _txn_manager->commit_txn(
-                    _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
-                    rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
-                    rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
-            if (!commit_txn_status &&
-                commit_txn_status !=
-                        Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
-                LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
-                             << " to tablet: " << rowset_meta->tablet_id()
-                             << " for txn: " << rowset_meta->txn_id();
-            } else {
-                LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
-                          << " to tablet: " << rowset_meta->tablet_id()
-                          << " schema hash: " << rowset_meta->tablet_schema_hash()
-                          << " for txn: " << rowset_meta->txn_id();
-            }
-        } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
-                   rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            Status publish_status = tablet->add_rowset(rowset);
-            if (!publish_status &&
-                publish_status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-                LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
-                             << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
-                             << " txn id:" << rowset_meta->txn_id()
-                             << " start_version: " << rowset_meta->version().first
-                             << " end_version: " << rowset_meta->version().second;
-            }
-        } else {
-            LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
-                         << " with tablet id: " << rowset_meta->tablet_id()
-                         << " tablet uid: " << rowset_meta->tablet_uid()
-                         << " schema hash: " << rowset_meta->tablet_schema_hash()
-                         << " txn: " << rowset_meta->txn_id()
-                         << " current valid tablet uid: " << tablet->tablet_uid();
-            ++invalid_rowset_counter;
-        }
-    }
+    std::atomic<int64_t> invalid_rowset_counter = 0;
+    BatchLoader<RowsetMetaSharedPtr> rowset_loader(
+            load_pool.get(), num_threads, [this, &invalid_rowset_counter](auto& rowset_meta) {
+                _load_rowset(rowset_meta, &invalid_rowset_counter);
+                DorisMetrics::instance()->startup_loaded_rowset_metas_total->increment(1);
+            });
+    for (auto& rowset_meta : dir_rowset_metas) {
+        rowset_loader.add(rowset_meta);
+    }
+    rowset_loader.finish();
     // At startup, we only count these invalid rowset, but do not actually delete it.
     // The actual delete operation is in StorageEngine::_clean_unused_rowset_metas,
     // which is cleaned up uniformly by the background cleanup thread.
@@ -518,6 +574,78 @@ Status DataDir::load() {
     return Status::OK();
 }
 
+void DataDir::_load_rowset(const RowsetMetaSharedPtr& rowset_meta,
+                           std::atomic<int64_t>* invalid_rowset_counter) {
+    TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
+    // tablet maybe dropped, but not drop related rowset meta
+    if (tablet == nullptr) {
+        VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
+                    << ", schema hash: " << rowset_meta->tablet_schema_hash()
+                    << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
+        ++(*invalid_rowset_counter);
+        return;
+    }
+
+    bool is_visible = rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
+                      rowset_meta->tablet_uid() == tablet->tablet_uid();
+    if (is_visible) {
+        // Most visible rowsets are in the tablet meta too, and have been created by the
+        // tablet, do not create them again.
+        std::shared_lock rdlock(tablet->get_header_lock());
+        auto existed = tablet->get_rowset_by_version(rowset_meta->version());
+        if (existed != nullptr && existed->rowset_id() == rowset_meta->rowset_id()) {
+            return;
+        }
+    }
+
+    RowsetSharedPtr rowset;
+    Status create_status = tablet->create_rowset(rowset_meta, &rowset);
+    if (!create_status) {
+        LOG(WARNING) << "could not create rowset from rowsetmeta: "
+                     << " rowset_id: " << rowset_meta->rowset_id()
+                     << " rowset_type: " << rowset_meta->rowset_type()
+                     << " rowset_state: " << rowset_meta->rowset_state();
+        return;
+    }
+    if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
+        rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        Status commit_txn_status = _txn_manager->commit_txn(
+                _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
+                rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
+                rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
+        if (!commit_txn_status &&
+            commit_txn_status !=
+                    Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
+            LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
+                         << " to tablet: " << rowset_meta->tablet_id()
+                         << " for txn: " << rowset_meta->txn_id();
+        } else {
+            LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
+                      << " to tablet: " << rowset_meta->tablet_id()
+                      << " schema hash: " << rowset_meta->tablet_schema_hash()
+                      << " for txn: " << rowset_meta->txn_id();
+        }
+    } else if (is_visible) {
+        Status publish_status = tablet->add_rowset(rowset);
+        if (!publish_status &&
+            publish_status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+            LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
+                         << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
+                         << " txn id:" << rowset_meta->txn_id()
+                         << " start_version: " << rowset_meta->version().first
+                         << " end_version: " << rowset_meta->version().second;
+        }
+    } else {
+        LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
+                     << " with tablet id: " << rowset_meta->tablet_id()
+                     << " tablet uid: " << rowset_meta->tablet_uid()
+                     << " schema hash: " << rowset_meta->tablet_schema_hash()
+                     << " txn: " << rowset_meta->txn_id()
+                     << " current valid tablet uid: " << tablet->tablet_uid();
+        ++(*invalid_rowset_counter);
+    }
+}
+
 void DataDir::add_pending_ids(const std::string& id) {
     std::lock_guard<std::shared_mutex> wr_lock(_pending_path_mutex);
     _pending_path_ids.insert(id);
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <mutex>
@@ -29,8 +30,10 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "io/fs/file_system.h"
+#include "io/fs/io_limiter.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/rowset_id_generator.h"
+#include "olap/rowset/rowset_meta.h"
 #include "util/metrics.h"
 
 namespace doris {
@@ -57,6 +60,9 @@ public:
 
     const io::FileSystemPtr& fs() const { return _fs; }
 
+    // the limiter of the I/O of compaction, schema change and clone on this disk
+    io::IOLimiter* io_limiter() const;
+
     bool is_used() const { return _is_used; }
     void set_is_used(bool is_used) { _is_used = is_used; }
     int32_t cluster_id() const { return _cluster_id; }
@@ -153,6 +159,10 @@ private:
     // process will log fatal.
     Status _check_incompatible_old_format_tablet();
 
+    // Adds a committed rowset to the txn manager, or a visible rowset to its tablet.
+    void _load_rowset(const RowsetMetaSharedPtr& rowset_meta,
+                      std::atomic<int64_t>* invalid_rowset_counter);
+
     void _process_garbage_path(const std::string& path);
 
     void _remove_check_paths(const std::set<std::string>& paths);
@@ -230,6 +230,24 @@ bool DeleteHandler::_parse_condition(const std::string& condition_str, TConditio
     return true;
 }
 
+Status DeleteHandler::get_condition_columns(const DelPredicateArray& delete_conditions,
+                                            std::set<std::string>* column_names) {
+    for (const auto& delete_condition : delete_conditions) {
+        for (const auto& sub_predicate : delete_condition.sub_predicates()) {
+            TCondition condition;
+            if (!_parse_condition(sub_predicate, &condition)) {
+                LOG(WARNING) << "fail to parse condition. [condition=" << sub_predicate << "]";
+                return Status::OLAPInternalError(OLAP_ERR_DELETE_INVALID_PARAMETERS);
+            }
+            column_names->insert(condition.column_name);
+        }
+        for (const auto& in_predicate : delete_condition.in_predicates()) {
+            column_names->insert(in_predicate.column_name());
+        }
+    }
+    return Status::OK();
+}
+
 Status DeleteHandler::init(const TabletSchema& schema, const DelPredicateArray& delete_conditions,
                            int64_t version, const TabletReader* reader) {
     DCHECK(!_is_inited) << "reinitialize delete handler.";
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -118,6 +119,10 @@ public:
     // Release an instance of this class.
     void finalize();
 
+    // Collect the names of the columns which the delete conditions are on.
+    static Status get_condition_columns(const DelPredicateArray& delete_conditions,
+                                        std::set<std::string>* column_names);
+
     // Return all the delete conditions.
     const std::vector<DeleteConditions>& get_delete_conditions() const { return _del_conds; }
 
@@ -127,7 +132,7 @@ public:
 
 private:
     // Use regular expression to extract 'column_name', 'op' and 'operands'
-    bool _parse_condition(const std::string& condition_str, TCondition* condition);
+    static bool _parse_condition(const std::string& condition_str, TCondition* condition);
 
     bool _is_inited = false;
     // DeleteConditions in _del_conds are in 'OR' relationship
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/delete_predicate_bitmap_cache.h"
+
+namespace doris {
+
+DeletePredicateBitmapCache* DeletePredicateBitmapCache::_s_instance = nullptr;
+
+void DeletePredicateBitmapCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity == 0) {
+        return;
+    }
+    static DeletePredicateBitmapCache instance(capacity);
+    _s_instance = &instance;
+}
+
+DeletePredicateBitmapCache::DeletePredicateBitmapCache(size_t capacity) {
+    _cache.reset(new_lru_cache("DeletePredicateBitmapCache", capacity, LRUCacheType::SIZE));
+}
+
+std::string DeletePredicateBitmapCache::_key(const CacheKey& key) {
+    std::string str = key.rowset_id.to_string();
+    str.append(reinterpret_cast<const char*>(&key.segment_id), sizeof(key.segment_id));
+    str.append(reinterpret_cast<const char*>(&key.delete_version), sizeof(key.delete_version));
+    return str;
+}
+
+std::shared_ptr<const roaring::Roaring> DeletePredicateBitmapCache::lookup(const CacheKey& key) {
+    auto handle = _cache->lookup(doris::CacheKey(_key(key)));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto deleted_rows =
+            *reinterpret_cast<std::shared_ptr<const roaring::Roaring>*>(_cache->value(handle));
+    _cache->release(handle);
+    return deleted_rows;
+}
+
+void DeletePredicateBitmapCache::insert(const CacheKey& key,
+                                        std::shared_ptr<const roaring::Roaring> deleted_rows) {
+    auto deleter = [](const doris::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const roaring::Roaring>*>(value);
+    };
+    size_t charge = sizeof(roaring::Roaring) + deleted_rows->getSizeInBytes(false);
+    auto value = new std::shared_ptr<const roaring::Roaring>(std::move(deleted_rows));
+    auto handle = _cache->insert(doris::CacheKey(_key(key)), value, charge, deleter,
+                                 CachePriority::NORMAL);
+    _cache->release(handle);
+}
+
+} // namespace doris
@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+
+#include "olap/lru_cache.h"
+#include "olap/olap_common.h"
+
+namespace doris {
+
+// DeletePredicateBitmapCache caches the rows of a segment deleted by the delete predicates
+// of the tablet, so the predicates are evaluated once for a segment instead of for every
+// block of every query. The entries are keyed by the segment and the version of the last
+// delete predicate applied, which determine the applied predicates: the predicates of a
+// rowset are all the ones after its version up to that version. A segment is immutable and
+// a compacted rowset gets a new id, so the entries are only evicted, never invalidated.
+class DeletePredicateBitmapCache {
+public:
+    struct CacheKey {
+        RowsetId rowset_id;
+        uint32_t segment_id;
+        int64_t delete_version;
+    };
+
+    // Caches nothing if capacity is 0.
+    static void create_global_instance(size_t capacity);
+
+    // nullptr if the cache is disabled or not created, e.g. in the tools.
+    static DeletePredicateBitmapCache* instance() { return _s_instance; }
+
+    explicit DeletePredicateBitmapCache(size_t capacity);
+
+    std::shared_ptr<const roaring::Roaring> lookup(const CacheKey& key);
+    void insert(const CacheKey& key, std::shared_ptr<const roaring::Roaring> deleted_rows);
+
+private:
+    static std::string _key(const CacheKey& key);
+
+    static DeletePredicateBitmapCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris
@@ -17,16 +17,22 @@
 
 #include "olap/delta_writer.h"
 
+#include <filesystem>
+
 #include "olap/base_compaction.h"
 #include "olap/cumulative_compaction.h"
 #include "olap/data_dir.h"
 #include "olap/memtable.h"
 #include "olap/memtable_flush_executor.h"
+#include "olap/partial_update_info.h"
+#include "olap/rowset/beta_rowset.h"
 #include "olap/schema.h"
 #include "olap/schema_change.h"
 #include "olap/storage_engine.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 
 namespace doris {
 
@@ -120,8 +126,12 @@ Status DeltaWriter::init() {
                                                                   _req.txn_id, _req.load_id));
     }
 
+    std::shared_ptr<PartialUpdateInfo> partial_update_info;
+    if (_req.is_partial_update) {
+        RETURN_NOT_OK(_init_partial_update_info(&partial_update_info));
+    }
     RETURN_NOT_OK(_tablet->create_rowset_writer(_req.txn_id, _req.load_id, PREPARED, OVERLAPPING,
-                                                &_rowset_writer));
+                                                &_rowset_writer, partial_update_info));
     _tablet_schema = &(_tablet->tablet_schema());
     _schema.reset(new Schema(*_tablet_schema));
     _reset_mem_table();
@@ -134,6 +144,33 @@ Status DeltaWriter::init() {
     return Status::OK();
 }
 
+Status DeltaWriter::_init_partial_update_info(std::shared_ptr<PartialUpdateInfo>* info) {
+    if (!_is_vec || !_tablet->enable_unique_key_merge_on_write()) {
+        return Status::NotSupported(fmt::format(
+                "partial update needs vectorized load into a merge-on-write tablet, tablet: {}",
+                _tablet->full_name()));
+    }
+    auto partial_update_info = std::make_shared<PartialUpdateInfo>();
+    const auto& tablet_schema = _tablet->tablet_schema();
+    for (uint32_t cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+        const auto& column = tablet_schema.column(cid);
+        if (_req.partial_update_input_columns->count(column.name()) > 0) {
+            continue;
+        }
+        if (column.is_key()) {
+            return Status::InvalidArgument(fmt::format(
+                    "key column {} is missing in partial update of tablet {}", column.name(),
+                    _tablet->full_name()));
+        }
+        partial_update_info->missing_cids.push_back(cid);
+    }
+    partial_update_info->tablet = _tablet;
+    _tablet->capture_rowsets_for_lookup(&partial_update_info->rowsets,
+                                        &partial_update_info->version);
+    *info = std::move(partial_update_info);
+    return Status::OK();
+}
+
 Status DeltaWriter::write(Tuple* tuple) {
     std::lock_guard<std::mutex> l(_lock);
     if (!_is_init && !_is_cancelled) {
@@ -213,6 +250,12 @@ Status DeltaWriter::_flush_memtable_async() {
     if (++_segment_counter > config::max_segment_num_per_rowset) {
         return Status::OLAPInternalError(OLAP_ERR_TOO_MANY_SEGMENTS);
     }
+    // Memtables of a beta rowset are flushed concurrently, reserve the segment id here so
+    // that the segments are still ordered by the time their memtables were filled.
+    // Empty memtables write nothing, so they must not take an id.
+    if (_mem_table->rows() > 0) {
+        _mem_table->set_segment_id(_rowset_writer->allocate_segment_id());
+    }
     return _flush_token->submit(_mem_table);
 }
 
@@ -249,6 +292,35 @@ Status DeltaWriter::flush_memtable_and_wait(bool need_wait) {
     return Status::OK();
 }
 
+int64_t DeltaWriter::active_memtable_mem_consumption() {
+    std::lock_guard<std::mutex> l(_lock);
+    if (!_is_init || _is_cancelled || _mem_table == nullptr) {
+        return 0;
+    }
+    return _mem_table->memory_usage();
+}
+
+Status DeltaWriter::flush_active_memtable() {
+    std::lock_guard<std::mutex> l(_lock);
+    if (!_is_init) {
+        // return OLAP_SUCCESS for same reason as described in flush_memtable_and_wait()
+        return Status::OK();
+    }
+    if (_is_cancelled) {
+        return Status::OLAPInternalError(OLAP_ERR_ALREADY_CANCELLED);
+    }
+    // _mem_table is reset when the writer is closed
+    if (_mem_table == nullptr || _mem_table->memory_usage() == 0) {
+        return Status::OK();
+    }
+    VLOG_NOTICE << "flush memtable to reduce load mem consumption. memtable size: "
+                << _mem_table->memory_usage() << ", tablet: " << _req.tablet_id
+                << ", load id: " << print_id(_req.load_id);
+    RETURN_NOT_OK(_flush_memtable_async());
+    _reset_mem_table();
+    return Status::OK();
+}
+
 Status DeltaWriter::wait_flush() {
     std::lock_guard<std::mutex> l(_lock);
     if (!_is_init) {
@@ -323,6 +395,32 @@ Status DeltaWriter::close_wait() {
     return Status::OK();
 }
 
+Status DeltaWriter::fill_pull_rowset_request(PTabletPullRowsetRequest* request) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (!_delta_written_success) {
+        return Status::InternalError("the rowset is not committed");
+    }
+    request->set_txn_id(_req.txn_id);
+    request->set_partition_id(_req.partition_id);
+    *request->mutable_load_id() = _req.load_id;
+    _cur_rowset->rowset_meta()->to_rowset_pb(request->mutable_rowset_meta());
+    request->set_host(BackendOptions::get_localhost());
+    request->set_http_port(config::webserver_port);
+    request->set_token(ExecEnv::GetInstance()->token());
+    request->set_tablet_path(_tablet->tablet_path());
+    for (int i = 0; i < _cur_rowset->num_segments(); ++i) {
+        auto path = BetaRowset::local_segment_path(_tablet->tablet_path(),
+                                                   _cur_rowset->rowset_id(), i);
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return Status::IOError(fmt::format("failed to get size of {}: {}", path, ec.message()));
+        }
+        (*request->mutable_segments_size())[i] = file_size;
+    }
+    return Status::OK();
+}
+
 Status DeltaWriter::cancel() {
     std::lock_guard<std::mutex> l(_lock);
     if (!_is_init || _is_cancelled) {
@@ -47,6 +47,9 @@ struct WriteRequest {
     // slots are in order of tablet's schema
     const std::vector<SlotDescriptor*>* slots;
     bool is_high_priority = false;
+    // only the columns in `partial_update_input_columns` are provided by a partial update
+    bool is_partial_update = false;
+    const std::set<std::string>* partial_update_input_columns = nullptr;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -84,9 +87,21 @@ public:
 
     int64_t mem_consumption() const;
 
+    // the memory of the memtable accepting writes, the rest of mem_consumption() is held by
+    // the memtables in flush queue.
+    int64_t active_memtable_mem_consumption();
+
+    // submit the memtable accepting writes to flush queue without waiting, no-op if it is empty.
+    // This is for the global memtable memory scheduler of LoadChannelMgr.
+    Status flush_active_memtable();
+
     // Wait all memtable in flush queue to be flushed
     Status wait_flush();
 
+    // fill the request for the slave replicas of single replica load to pull the rowset,
+    // must be called after close_wait() succeeded.
+    Status fill_pull_rowset_request(PTabletPullRowsetRequest* request);
+
     int64_t tablet_id() { return _tablet->tablet_id(); }
 
     int32_t schema_hash() { return _tablet->schema_hash(); }
@@ -105,6 +120,10 @@ private:
 
     void _reset_mem_table();
 
+    // Finds the missing columns of a partial update and snapshots the rowsets to look up the
+    // latest rows of the keys in.
+    Status _init_partial_update_info(std::shared_ptr<PartialUpdateInfo>* info);
+
     bool _is_init = false;
     bool _is_cancelled = false;
     WriteRequest _req;
@@ -18,6 +18,7 @@
 #include "olap/hll.h"
 
 #include <algorithm>
+#include <array>
 #include <map>
 
 #include "common/logging.h"
@@ -75,6 +76,16 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t num) {
+    size_t i = 0;
+    for (; i < num && (_type == HLL_DATA_EMPTY || _type == HLL_DATA_EXPLICIT); ++i) {
+        update(hash_values[i]);
+    }
+    for (; i < num; ++i) {
+        _update_registers(hash_values[i]);
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -313,6 +324,51 @@ bool HyperLogLog::deserialize(const Slice& slice) {
     return true;
 }
 
+bool HyperLogLog::merge_serialized(const Slice& slice) {
+    if (slice.data == nullptr || slice.size <= 0 || !is_valid(slice)) {
+        return false;
+    }
+    const uint8_t* ptr = (uint8_t*)slice.data;
+    auto type = (HllDataType)*ptr++;
+    if (type == HLL_DATA_EMPTY) {
+        return true;
+    }
+    if (type == HLL_DATA_EXPLICIT) {
+        uint8_t num_explicits = *ptr++;
+        for (int i = 0; i < num_explicits; ++i) {
+            update(decode_fixed64_le(ptr));
+            ptr += 8;
+        }
+        return true;
+    }
+    // the same transitions as merge()
+    switch (_type) {
+    case HLL_DATA_EMPTY:
+        _registers = new uint8_t[HLL_REGISTERS_COUNT];
+        memset(_registers, 0, HLL_REGISTERS_COUNT);
+        _type = HLL_DATA_FULL;
+        break;
+    case HLL_DATA_EXPLICIT:
+        _convert_explicit_to_register();
+        _type = HLL_DATA_FULL;
+        break;
+    default:
+        break;
+    }
+    if (type == HLL_DATA_SPARSE) {
+        uint32_t num_registers = decode_fixed32_le(ptr);
+        ptr += 4;
+        for (uint32_t i = 0; i < num_registers; ++i) {
+            uint16_t register_idx = decode_fixed16_le(ptr);
+            ptr += 2;
+            _registers[register_idx] = std::max(_registers[register_idx], *ptr++);
+        }
+    } else {
+        _merge_registers(ptr);
+    }
+    return true;
+}
+
 int64_t HyperLogLog::estimate_cardinality() const {
     if (_type == HLL_DATA_EMPTY) {
         return 0;
@@ -335,15 +391,22 @@ int64_t HyperLogLog::estimate_cardinality() const {
         alpha = 0.7213f / (1 + 1.079f / num_streams);
     }
 
+    // 2^-value of every register value, which is at most HLL_ZERO_COUNT_BITS + 1. The sum
+    // is still accumulated in the order of the registers to be the same as the FE.
+    static const auto inverse_powers = [] {
+        std::array<float, 256> powers;
+        for (int i = 0; i < powers.size(); ++i) {
+            powers[i] = powf(2.0f, -i);
+        }
+        return powers;
+    }();
+
     float harmonic_mean = 0;
     int num_zero_registers = 0;
 
     for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers[i]);
-
-        if (_registers[i] == 0) {
-            ++num_zero_registers;
-        }
+        harmonic_mean += inverse_powers[_registers[i]];
+        num_zero_registers += _registers[i] == 0;
     }
 
     harmonic_mean = 1.0f / harmonic_mean;
@@ -27,6 +27,8 @@
 
 #ifdef __x86_64__
 #include <immintrin.h>
+#elif defined(__aarch64__)
+#include <sse2neon.h>
 #endif
 
 #include "gutil/macros.h"
@@ -207,6 +209,11 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add many hash values, the registers are updated in a tight loop once the explicit
+    // values are converted.
+    // NOTE: input must be hash values
+    void update_batch(const uint64_t* hash_values, size_t num);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
@@ -230,6 +237,10 @@ public:
     // Now, only empty HLL support this function.
     bool deserialize(const Slice& slice);
 
+    // Merges the serialized binary into this without an HyperLogLog built for it, the
+    // registers are read from the slice directly.
+    bool merge_serialized(const Slice& slice);
+
     int64_t estimate_cardinality() const;
 
     static std::string empty() {
@@ -302,6 +313,17 @@ private:
             src += 32;
             dst += 32;
         }
+#elif defined(__SSE2__) || defined(__aarch64__)
+        int loop = HLL_REGISTERS_COUNT / 16; // 16 = 128/8
+        uint8_t* dst = _registers;
+        const uint8_t* src = other_registers;
+        for (int i = 0; i < loop; i++) {
+            __m128i xa = _mm_loadu_si128((const __m128i*)dst);
+            __m128i xb = _mm_loadu_si128((const __m128i*)src);
+            _mm_storeu_si128((__m128i*)dst, _mm_max_epu8(xa, xb));
+            src += 16;
+            dst += 16;
+        }
 #else
         for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
             _registers[i] =
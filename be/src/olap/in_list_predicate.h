@@ -295,8 +295,10 @@ private:
                 auto* nested_col_ptr = vectorized::check_and_get_column<
                         vectorized::ColumnDictionary<vectorized::Int32>>(column);
                 auto& data_array = nested_col_ptr->get_data();
-                std::vector<vectorized::UInt8> selected;
-                nested_col_ptr->find_codes(_values, selected);
+                const auto& selected = nested_col_ptr->find_codes_by_predicate(
+                        this, [this](const StringValue& value) {
+                            return _values.find(value) != _values.end();
+                        });
 
                 for (uint16_t i = 0; i < *size; i++) {
                     uint16_t idx = sel[i];
@@ -18,8 +18,12 @@
 #pragma once
 
 #include <memory>
+#include <roaring/roaring.hh>
+#include <set>
+#include <unordered_map>
 
 #include "common/status.h"
+#include "gen_cpp/PlanNodes_types.h"
 #include "olap/block_column_predicate.h"
 #include "olap/column_predicate.h"
 #include "olap/olap_common.h"
@@ -73,15 +77,37 @@ public:
 
     std::shared_ptr<AndBlockColumnPredicate> delete_condition_predicates =
             std::make_shared<AndBlockColumnPredicate>();
+    // the rowset read and the version of the last delete condition applied to it, to cache
+    // the rows deleted by delete_condition_predicates, -1 if there is no delete condition
+    RowsetId rowset_id;
+    int64_t delete_condition_version = -1;
     // reader's column predicate, nullptr if not existed
     // used to fiter rows in row block
     // TODO(hkp): refactor the column predicate framework
     // to unify Conditions and ColumnPredicate
     std::vector<ColumnPredicate*> column_predicates;
+    // predicates of the late-arriving runtime filters, appended to `column_predicates`
+    // when the segment starts to be read
+    const std::vector<ColumnPredicate*>* runtime_predicates = nullptr;
+    // segment id -> rows deleted or overwritten by later loads, only for unique key
+    // tablets with merge-on-write enabled
+    std::unordered_map<uint32_t, std::shared_ptr<roaring::Roaring>> delete_bitmap;
+    // string columns returned as dictionary columns if their pages are dict-encoded,
+    // only for the vectorized query engine
+    std::set<ColumnId> dict_output_columns;
 
     // REQUIRED (null is not allowed)
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    // whether to insert the pages read into the page cache if use_page_cache,
+    // false for the scan-only queries not to evict the hot pages
+    bool fill_page_cache = true;
+    // The aggregation without grouping over the scan. If the segment has no predicate or
+    // deleted row to apply, it returns the rows answering the aggregation from the metadata
+    // instead of reading the data pages: COUNT returns as many rows of default values as the
+    // segment has, MINMAX returns the min values and the max values of the segment zone maps
+    // as two rows.
+    TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
     int block_row_max = 4096;
 };
 
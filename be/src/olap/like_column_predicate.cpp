@@ -0,0 +1,178 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/like_column_predicate.h"
+
+#include <string.h>
+
+#include "olap/column_block.h"
+#include "runtime/string_value.h"
+#include "runtime/vectorized_row_batch.h"
+#include "vec/columns/column_dictionary.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/predicate_column.h"
+
+namespace doris {
+
+LikeColumnPredicate::LikeColumnPredicate(uint32_t column_id, const std::string& pattern)
+        : ColumnPredicate(column_id) {
+    DCHECK(is_supported_pattern(pattern));
+    size_t first = pattern.find('%');
+    if (first == std::string::npos) {
+        _is_exact = true;
+        _prefix = pattern;
+        return;
+    }
+    size_t last = pattern.rfind('%');
+    _prefix = pattern.substr(0, first);
+    _suffix = pattern.substr(last + 1);
+    size_t begin = first + 1;
+    while (begin < last) {
+        size_t end = pattern.find('%', begin);
+        if (end > begin) {
+            _middles.emplace_back(pattern, begin, end - begin);
+        }
+        begin = end + 1;
+    }
+}
+
+bool LikeColumnPredicate::is_supported_pattern(const std::string& pattern) {
+    return pattern.find_first_of("_\\") == std::string::npos;
+}
+
+bool LikeColumnPredicate::match(const char* data, size_t size) const {
+    if (_is_exact) {
+        return size == _prefix.size() && memcmp(data, _prefix.data(), size) == 0;
+    }
+    if (size < _prefix.size() + _suffix.size() ||
+        memcmp(data, _prefix.data(), _prefix.size()) != 0 ||
+        memcmp(data + size - _suffix.size(), _suffix.data(), _suffix.size()) != 0) {
+        return false;
+    }
+    // the literals between the prefix and the suffix are matched greedily from the left
+    const char* begin = data + _prefix.size();
+    const char* end = data + size - _suffix.size();
+    for (auto& middle : _middles) {
+        const void* found = memmem(begin, end - begin, middle.data(), middle.size());
+        if (found == nullptr) {
+            return false;
+        }
+        begin = static_cast<const char*>(found) + middle.size();
+    }
+    return true;
+}
+
+template <typename Fn>
+void LikeColumnPredicate::_evaluate_cells(const ColumnBlock* block, const uint16_t* sel,
+                                          uint16_t size, Fn&& fn) const {
+    for (uint16_t i = 0; i < size; ++i) {
+        uint16_t idx = sel[i];
+        if (block->is_nullable() && block->cell(idx).is_null()) {
+            fn(i, false);
+            continue;
+        }
+        const auto* cell_value = reinterpret_cast<const Slice*>(block->cell(idx).cell_ptr());
+        fn(i, match(cell_value->data, cell_value->size));
+    }
+}
+
+template <typename Fn>
+void LikeColumnPredicate::_evaluate_rows(const vectorized::IColumn& column, const uint16_t* sel,
+                                         uint16_t size, Fn&& fn) const {
+    const vectorized::IColumn* nested_col = &column;
+    const vectorized::NullMap* null_map = nullptr;
+    if (column.is_nullable()) {
+        auto* nullable_col = vectorized::check_and_get_column<vectorized::ColumnNullable>(column);
+        null_map = &nullable_col->get_null_map_data();
+        nested_col = &nullable_col->get_nested_column();
+    }
+
+    if (nested_col->is_column_dictionary()) {
+        auto* dict_col = vectorized::check_and_get_column<
+                vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);
+        auto& codes = dict_col->get_data();
+        const auto& code_flags = dict_col->find_codes_by_predicate(
+                this, [this](const StringValue& value) { return match(value.ptr, value.len); });
+        for (uint16_t i = 0; i < size; ++i) {
+            uint16_t idx = sel[i];
+            // the code of a null row is -1
+            fn(i, (null_map == nullptr || !(*null_map)[idx]) && code_flags[codes[idx]]);
+        }
+    } else {
+        auto& values =
+                vectorized::check_and_get_column<vectorized::PredicateColumnType<StringValue>>(
+                        nested_col)
+                        ->get_data();
+        for (uint16_t i = 0; i < size; ++i) {
+            uint16_t idx = sel[i];
+            fn(i, (null_map == nullptr || !(*null_map)[idx]) &&
+                          match(values[idx].ptr, values[idx].len));
+        }
+    }
+}
+
+void LikeColumnPredicate::evaluate(VectorizedRowBatch* batch) const {
+    // segment v1 is not supported, the LIKE predicate is evaluated by the scanner
+    uint16_t n = batch->size();
+    uint16_t* sel = batch->selected();
+    if (!batch->selected_in_use()) {
+        for (uint16_t i = 0; i != n; ++i) {
+            sel[i] = i;
+        }
+    }
+}
+
+void LikeColumnPredicate::evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const {
+    uint16_t new_size = 0;
+    _evaluate_cells(block, sel, *size, [&](uint16_t i, bool matched) {
+        sel[new_size] = sel[i];
+        new_size += matched;
+    });
+    *size = new_size;
+}
+
+void LikeColumnPredicate::evaluate_or(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                                      bool* flags) const {
+    _evaluate_cells(block, sel, size, [&](uint16_t i, bool matched) { flags[i] |= matched; });
+}
+
+void LikeColumnPredicate::evaluate_and(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                                       bool* flags) const {
+    _evaluate_cells(block, sel, size, [&](uint16_t i, bool matched) { flags[i] &= matched; });
+}
+
+void LikeColumnPredicate::evaluate(vectorized::IColumn& column, uint16_t* sel,
+                                   uint16_t* size) const {
+    uint16_t new_size = 0;
+    _evaluate_rows(column, sel, *size, [&](uint16_t i, bool matched) {
+        sel[new_size] = sel[i];
+        new_size += matched;
+    });
+    *size = new_size;
+}
+
+void LikeColumnPredicate::evaluate_and(vectorized::IColumn& column, uint16_t* sel, uint16_t size,
+                                       bool* flags) const {
+    _evaluate_rows(column, sel, size, [&](uint16_t i, bool matched) { flags[i] &= matched; });
+}
+
+void LikeColumnPredicate::evaluate_or(vectorized::IColumn& column, uint16_t* sel, uint16_t size,
+                                      bool* flags) const {
+    _evaluate_rows(column, sel, size, [&](uint16_t i, bool matched) { flags[i] |= matched; });
+}
+
+} //namespace doris
@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <roaring/roaring.hh>
+#include <string>
+#include <vector>
+
+#include "olap/column_predicate.h"
+
+namespace doris {
+
+// The predicate that the values match a LIKE pattern of literals and '%' wildcards. It is
+// pushed down from a LIKE predicate, and evaluated once for each value of the dictionary of
+// the dict-encoded pages rather than for each row.
+class LikeColumnPredicate : public ColumnPredicate {
+public:
+    LikeColumnPredicate(uint32_t column_id, const std::string& pattern);
+
+    // Only the patterns without '_' and escape chars are supported, whose matching does not
+    // depend on the charset.
+    static bool is_supported_pattern(const std::string& pattern);
+
+    PredicateType type() const override { return PredicateType::LIKE; }
+
+    void evaluate(VectorizedRowBatch* batch) const override;
+
+    void evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const override;
+
+    void evaluate_or(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                     bool* flags) const override;
+
+    void evaluate_and(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                      bool* flags) const override;
+
+    Status evaluate(const Schema& schema, const std::vector<BitmapIndexIterator*>& iterators,
+                    uint32_t num_rows, roaring::Roaring* roaring) const override {
+        return Status::OK();
+    }
+
+    bool can_do_bitmap_index() const override { return false; }
+
+    void evaluate(vectorized::IColumn& column, uint16_t* sel, uint16_t* size) const override;
+
+    void evaluate_and(vectorized::IColumn& column, uint16_t* sel, uint16_t size,
+                      bool* flags) const override;
+
+    void evaluate_or(vectorized::IColumn& column, uint16_t* sel, uint16_t size,
+                     bool* flags) const override;
+
+    bool match(const char* data, size_t size) const;
+
+private:
+    // Call `fn(i, matched)` for each selected row of `column`, which is a (nullable) predicate
+    // column or dictionary column of strings.
+    template <typename Fn>
+    void _evaluate_rows(const vectorized::IColumn& column, const uint16_t* sel, uint16_t size,
+                        Fn&& fn) const;
+
+    // Call `fn(i, matched)` for each selected cell of `block`.
+    template <typename Fn>
+    void _evaluate_cells(const ColumnBlock* block, const uint16_t* sel, uint16_t size,
+                         Fn&& fn) const;
+
+    // the pattern without '%'
+    bool _is_exact = false;
+    std::string _prefix;
+    std::string _suffix;
+    // the literals between the first and the last '%'
+    std::vector<std::string> _middles;
+};
+
+} //namespace doris
@@ -8,10 +8,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
 #include "gutil/bits.h"
+#include "olap/clock_cache.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/olap_index.h"
@@ -19,6 +21,7 @@
 #include "olap/utils.h"
 #include "runtime/thread_context.h"
 #include "util/doris_metrics.h"
+#include "util/string_util.h"
 
 using std::string;
 using std::stringstream;
@@ -165,12 +168,80 @@ void HandleTable::_resize() {
     _length = new_length;
 }
 
-LRUCache::LRUCache(LRUCacheType type) : _type(type) {
+static constexpr uint64_t kSketchSeeds[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                             0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+
+void FrequencySketch::ensure_capacity(size_t num_entries) {
+    size_t length = 64;
+    while (length < num_entries) {
+        length <<= 1;
+    }
+    if (length <= _table.size()) {
+        return;
+    }
+    _table.assign(length, 0);
+    // 4 counters of each key in the 16 counters of a word, so the history of about
+    // 10 times the keys is kept
+    _sample_size = 10 * length;
+    _additions = 0;
+}
+
+uint64_t FrequencySketch::_index_hash(uint32_t hash, int depth) {
+    uint64_t h = (hash + kSketchSeeds[depth]) * kSketchSeeds[depth];
+    return h ^ (h >> 32);
+}
+
+void FrequencySketch::increment(uint32_t hash) {
+    if (_table.empty()) {
+        return;
+    }
+    bool added = false;
+    for (int i = 0; i < kDepth; ++i) {
+        uint64_t h = _index_hash(hash, i);
+        uint64_t& word = _table[h & (_table.size() - 1)];
+        int offset = ((h >> 48) & 15) << 2;
+        if (((word >> offset) & 15) != 15) {
+            word += 1ULL << offset;
+            added = true;
+        }
+    }
+    if (added && ++_additions >= _sample_size) {
+        _reset();
+    }
+}
+
+uint32_t FrequencySketch::frequency(uint32_t hash) const {
+    if (_table.empty()) {
+        return 0;
+    }
+    uint32_t frequency = 15;
+    for (int i = 0; i < kDepth; ++i) {
+        uint64_t h = _index_hash(hash, i);
+        uint64_t word = _table[h & (_table.size() - 1)];
+        int offset = ((h >> 48) & 15) << 2;
+        frequency = std::min(frequency, (uint32_t)((word >> offset) & 15));
+    }
+    return frequency;
+}
+
+void FrequencySketch::_reset() {
+    for (auto& word : _table) {
+        word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    _additions /= 2;
+}
+
+LRUCache::LRUCache(LRUCacheType type, CacheEvictionPolicy policy) : _type(type), _policy(policy) {
     // Make empty circular linked list
     _lru_normal.next = &_lru_normal;
     _lru_normal.prev = &_lru_normal;
     _lru_durable.next = &_lru_durable;
     _lru_durable.prev = &_lru_durable;
+    _lru_protected.next = &_lru_protected;
+    _lru_protected.prev = &_lru_protected;
+    if (_policy == CacheEvictionPolicy::TINY_LFU) {
+        _sketch.ensure_capacity(0);
+    }
 }
 
 LRUCache::~LRUCache() {
@@ -197,9 +268,55 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->next->prev = e;
 }
 
+// The max ratio of the capacity taken by the protected segment of TINY_LFU
+static constexpr double kProtectedRatio = 0.8;
+
+void LRUCache::_protect(LRUHandle* e) {
+    if (e->in_protected || e->priority != CachePriority::NORMAL) {
+        return;
+    }
+    e->in_protected = true;
+    _protected_usage += e->total_size;
+    // demote the oldest protected entries to the probation segment
+    while (_protected_usage > _capacity * kProtectedRatio &&
+           _lru_protected.next != &_lru_protected) {
+        LRUHandle* old = _lru_protected.next;
+        _lru_remove(old);
+        _unprotect(old);
+        _lru_append(&_lru_normal, old);
+    }
+}
+
+void LRUCache::_unprotect(LRUHandle* e) {
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->total_size;
+    }
+}
+
+bool LRUCache::_admit(const CacheKey& key, uint32_t hash, size_t total_size) {
+    _sketch.ensure_capacity(_table.size() + 1);
+    if (_usage + total_size <= _capacity || _table.lookup(key, hash) != nullptr) {
+        return true;
+    }
+    LRUHandle* victim = _lru_normal.next;
+    if (victim == &_lru_normal) {
+        victim = _lru_protected.next;
+        if (victim == &_lru_protected) {
+            // only the durable entries could be evicted
+            return true;
+        }
+    }
+    return _sketch.frequency(hash) > _sketch.frequency(victim->hash);
+}
+
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     std::lock_guard<std::mutex> l(_mutex);
     ++_lookup_count;
+    if (_policy == CacheEvictionPolicy::TINY_LFU) {
+        // the misses are counted too, so an entry is admitted when it is accessed again
+        _sketch.increment(hash);
+    }
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
@@ -210,6 +327,9 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        if (_policy == CacheEvictionPolicy::TINY_LFU) {
+            _protect(e);
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -232,13 +352,14 @@ void LRUCache::release(Cache::Handle* handle) {
                 bool removed = _table.remove(e);
                 DCHECK(removed);
                 e->in_cache = false;
+                _unprotect(e);
                 _unref(e);
                 _usage -= e->total_size;
                 last_ref = true;
             } else {
                 // put it to LRU free list
                 if (e->priority == CachePriority::NORMAL) {
-                    _lru_append(&_lru_normal, e);
+                    _lru_append(e->in_protected ? &_lru_protected : &_lru_normal, e);
                 } else if (e->priority == CachePriority::DURABLE) {
                     _lru_append(&_lru_durable, e);
                 }
@@ -261,7 +382,14 @@ void LRUCache::_evict_from_lru(size_t total_size, LRUHandle** to_remove_head) {
         old->next = *to_remove_head;
         *to_remove_head = old;
     }
-    // 2. evict durable cache entries if need
+    // 2. evict protected cache entries of TINY_LFU
+    while (_usage + total_size > _capacity && _lru_protected.next != &_lru_protected) {
+        LRUHandle* old = _lru_protected.next;
+        _evict_one_entry(old);
+        old->next = *to_remove_head;
+        *to_remove_head = old;
+    }
+    // 3. evict durable cache entries if need
     while (_usage + total_size > _capacity && _lru_durable.next != &_lru_durable) {
         LRUHandle* old = _lru_durable.next;
         DCHECK(old->priority == CachePriority::DURABLE);
@@ -278,6 +406,7 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     bool removed = _table.remove(e);
     DCHECK(removed);
     e->in_cache = false;
+    _unprotect(e);
     _unref(e);
     _usage -= e->total_size;
 }
@@ -296,17 +425,29 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->in_protected = false;
     e->priority = priority;
     e->mem_tracker = tracker;
     memcpy(e->key_data, key.data(), key.size());
     // The memory of the parameter value should be recorded in the tls mem tracker,
     // transfer the memory ownership of the value to ShardedLRUCache::_mem_tracker.
     if (tracker)
-        tls_ctx()->_thread_mem_tracker_mgr->mem_tracker()->transfer_to(tracker, e->total_size);
+        tls_ctx()->_thread_mem_tracker_mgr->raw_mem_tracker()->transfer_to(tracker, e->total_size);
     LRUHandle* to_remove_head = nullptr;
     {
         std::lock_guard<std::mutex> l(_mutex);
 
+        if (_policy == CacheEvictionPolicy::TINY_LFU && priority == CachePriority::NORMAL &&
+            !_admit(key, hash, e->total_size)) {
+            // Not cached, the returned handle is the only reference, which is still charged
+            // until it is released.
+            ++_reject_count;
+            e->in_cache = false;
+            e->refs = 1;
+            _usage += e->total_size;
+            return reinterpret_cast<Cache::Handle*>(e);
+        }
+
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
         _evict_from_lru(e->total_size, &to_remove_head);
@@ -318,6 +459,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         _usage += e->total_size;
         if (old != nullptr) {
             old->in_cache = false;
+            _unprotect(old);
             if (_unref(old)) {
                 _usage -= old->total_size;
                 // old is on LRU because it's in cache and its reference count
@@ -347,6 +489,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
         std::lock_guard<std::mutex> l(_mutex);
         e = _table.remove(key, hash);
         if (e != nullptr) {
+            _unprotect(e);
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->total_size;
@@ -374,6 +517,12 @@ int64_t LRUCache::prune() {
             old->next = to_remove_head;
             to_remove_head = old;
         }
+        while (_lru_protected.next != &_lru_protected) {
+            LRUHandle* old = _lru_protected.next;
+            _evict_one_entry(old);
+            old->next = to_remove_head;
+            to_remove_head = old;
+        }
         while (_lru_durable.next != &_lru_durable) {
             LRUHandle* old = _lru_durable.next;
             _evict_one_entry(old);
@@ -406,6 +555,17 @@ int64_t LRUCache::prune_if(CacheValuePredicate pred) {
             p = next;
         }
 
+        p = _lru_protected.next;
+        while (p != &_lru_protected) {
+            LRUHandle* next = p->next;
+            if (pred(p->value)) {
+                _evict_one_entry(p);
+                p->next = to_remove_head;
+                to_remove_head = p;
+            }
+            p = next;
+        }
+
         p = _lru_durable.next;
         while (p != &_lru_durable) {
             LRUHandle* next = p->next;
@@ -432,7 +592,7 @@ inline uint32_t ShardedLRUCache::_hash_slice(const CacheKey& s) {
 }
 
 ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                                 uint32_t num_shards)
+                                 uint32_t num_shards, CacheEvictionPolicy policy)
         : _name(name),
           _num_shard_bits(Bits::FindLSBSetNonZero(num_shards)),
           _num_shards(num_shards),
@@ -446,7 +606,7 @@ ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity,
     const size_t per_shard = (total_capacity + (_num_shards - 1)) / _num_shards;
     LRUCache** shards = new (std::nothrow) LRUCache*[_num_shards];
     for (int s = 0; s < _num_shards; s++) {
-        shards[s] = new LRUCache(type);
+        shards[s] = new LRUCache(type, policy);
         shards[s]->set_capacity(per_shard);
     }
     _shards = shards;
@@ -546,9 +706,25 @@ void ShardedLRUCache::update_cache_metrics() const {
                                                  : ((double)total_hit_count / total_lookup_count));
 }
 
+bool parse_cache_eviction_policy(const std::string& str, CacheEvictionPolicy* policy) {
+    if (iequal(str, "LRU")) {
+        *policy = CacheEvictionPolicy::LRU;
+    } else if (iequal(str, "TINY_LFU")) {
+        *policy = CacheEvictionPolicy::TINY_LFU;
+    } else if (iequal(str, "CLOCK")) {
+        *policy = CacheEvictionPolicy::CLOCK;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 Cache* new_lru_cache(const std::string& name, size_t capacity, LRUCacheType type,
-                     uint32_t num_shards) {
-    return new ShardedLRUCache(name, capacity, type, num_shards);
+                     uint32_t num_shards, CacheEvictionPolicy policy) {
+    if (policy == CacheEvictionPolicy::CLOCK) {
+        return new ShardedClockCache(name, capacity, type, num_shards);
+    }
+    return new ShardedLRUCache(name, capacity, type, num_shards, policy);
 }
 
 } // namespace doris
@@ -53,10 +53,27 @@ enum LRUCacheType {
     NUMBER // The capacity of cache is based on the number of cache entry.
 };
 
+enum class CacheEvictionPolicy {
+    // Evict the least recently used entries.
+    LRU,
+    // A TinyLFU admission filter in front of a segmented LRU. A new entry is only admitted
+    // by a full cache if it is accessed more frequently than the entry to evict, and the
+    // entries hit again are protected from the entries accessed once, so a large scan
+    // doesn't evict the hot entries. The DURABLE entries are still evicted lastly.
+    TINY_LFU,
+    // CLOCK, an approximation of LRU whose hits don't take the exclusive lock of the shard,
+    // for the caches looked up by many threads concurrently, see ClockCache.
+    CLOCK
+};
+
+// Parses LRU, TINY_LFU or CLOCK case-insensitively, returns false if it's none of them.
+bool parse_cache_eviction_policy(const std::string& str, CacheEvictionPolicy* policy);
+
 // Create a new cache with a specified name and capacity.
-// This implementation of Cache uses a least-recently-used eviction policy.
+// This implementation of Cache uses a least-recently-used eviction policy by default.
 extern Cache* new_lru_cache(const std::string& name, size_t capacity,
-                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16);
+                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16,
+                            CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
 
 class CacheKey {
 public:
@@ -233,6 +250,7 @@ typedef struct LRUHandle {
     size_t key_length;
     size_t total_size; // including key length
     bool in_cache;     // Whether entry is in the cache.
+    bool in_protected; // Whether entry is in the protected segment of TINY_LFU.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
@@ -252,7 +270,7 @@ typedef struct LRUHandle {
     void free() {
         (*deleter)(key(), value);
         if (mem_tracker)
-            mem_tracker->transfer_to(tls_ctx()->_thread_mem_tracker_mgr->mem_tracker().get(),
+            mem_tracker->transfer_to(tls_ctx()->_thread_mem_tracker_mgr->raw_mem_tracker(),
                                      total_size);
         ::free(this);
     }
@@ -278,6 +296,8 @@ public:
     // Remove element from hash table by "key" and "hash".
     LRUHandle* remove(const CacheKey& key, uint32_t hash);
 
+    uint32_t size() const { return _elems; }
+
     // Remove element from hash table by "h", it would be faster
     // than the function above.
     // Return whether h is found and removed.
@@ -300,10 +320,35 @@ private:
     void _resize();
 };
 
+// A count-min sketch of 4-bit counters estimating the recent access frequencies of the
+// key hashes for TINY_LFU. All the counters are halved periodically to age the history.
+// Not thread-safe.
+class FrequencySketch {
+public:
+    // Grows the sketch for about num_entries keys, the counters are cleared if it grows.
+    void ensure_capacity(size_t num_entries);
+
+    void increment(uint32_t hash);
+
+    // Returns the estimated frequency, at most 15.
+    uint32_t frequency(uint32_t hash) const;
+
+private:
+    static constexpr int kDepth = 4;
+
+    static uint64_t _index_hash(uint32_t hash, int depth);
+    void _reset();
+
+    // 16 counters in each word
+    std::vector<uint64_t> _table;
+    size_t _additions = 0;
+    size_t _sample_size = 0;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
 public:
-    LRUCache(LRUCacheType type);
+    LRUCache(LRUCacheType type, CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
     ~LRUCache();
 
     // Separate from constructor so caller can easily make an array of LRUCache
@@ -322,6 +367,7 @@ public:
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
+    uint64_t get_reject_count() const { return _reject_count; }
     size_t get_usage() const { return _usage; }
     size_t get_capacity() const { return _capacity; }
 
@@ -331,9 +377,13 @@ private:
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t total_size, LRUHandle** to_remove_head);
     void _evict_one_entry(LRUHandle* e);
+    bool _admit(const CacheKey& key, uint32_t hash, size_t total_size);
+    void _protect(LRUHandle* e);
+    void _unprotect(LRUHandle* e);
 
 private:
     LRUCacheType _type;
+    CacheEvictionPolicy _policy;
 
     // Initialized before use.
     size_t _capacity = 0;
@@ -348,17 +398,24 @@ private:
     LRUHandle _lru_normal;
     // _lru_durable.prev is newest entry, _lru_durable.next is oldest entry.
     LRUHandle _lru_durable;
+    // For TINY_LFU, _lru_normal is the probation segment of the NORMAL entries accessed once,
+    // and _lru_protected is the protected segment of the ones hit in the cache.
+    LRUHandle _lru_protected;
+    size_t _protected_usage = 0;
+    FrequencySketch _sketch;
 
     HandleTable _table;
 
     uint64_t _lookup_count = 0; // cache查找总次数
     uint64_t _hit_count = 0;    // 命中cache的总次数
+    uint64_t _reject_count = 0; // the entries not admitted by TINY_LFU
 };
 
 class ShardedLRUCache : public Cache {
 public:
     explicit ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                             uint32_t num_shards);
+                             uint32_t num_shards,
+                             CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
     // TODO(fdy): 析构时清除所有cache元素
     virtual ~ShardedLRUCache();
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/match_predicate.h"
+
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_tokenizer.h"
+
+namespace doris {
+
+bool MatchPredicate::get_words_of_like_pattern(const std::string& pattern,
+                                               std::vector<std::string>* words) {
+    // the escaped wildcards are not handled
+    if (pattern.find('\\') != std::string::npos) {
+        return false;
+    }
+    // '%' and '_' are not token chars, so the tokens of the pattern are exactly the
+    // runs of token chars in its literal parts
+    segment_v2::for_each_token(pattern.data(), pattern.size(),
+                               [&](const char* token, size_t len) {
+                                   words->emplace_back(token, len);
+                               });
+    return !words->empty();
+}
+
+bool MatchPredicate::get_substrings_of_like_pattern(const std::string& pattern,
+                                                    std::vector<std::string>* substrings) {
+    if (pattern.find('\\') != std::string::npos) {
+        return false;
+    }
+    size_t begin = 0;
+    while (begin < pattern.size()) {
+        size_t end = pattern.find_first_of("%_", begin);
+        if (end == std::string::npos) {
+            end = pattern.size();
+        }
+        if (end > begin) {
+            substrings->emplace_back(pattern, begin, end - begin);
+        }
+        begin = end + 1;
+    }
+    return !substrings->empty();
+}
+
+Status MatchPredicate::evaluate(segment_v2::InvertedIndexIterator* iterator,
+                                roaring::Roaring* roaring) const {
+    for (auto& word : _words) {
+        if (roaring->isEmpty()) {
+            break;
+        }
+        roaring::Roaring matched;
+        RETURN_IF_ERROR(iterator->read_terms_containing(Slice(word), &matched));
+        *roaring &= matched;
+    }
+    return Status::OK();
+}
+
+} //namespace doris
@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <roaring/roaring.hh>
+#include <string>
+#include <vector>
+
+#include "olap/column_predicate.h"
+
+namespace doris {
+
+namespace segment_v2 {
+class InvertedIndexIterator;
+}
+
+// The predicate that the values contain all of `words` and `substrings`, for which the
+// inverted index finds the rows having a token containing each word, and the n-gram bloom
+// filter index finds the pages which may contain each substring. It is pushed down from a
+// LIKE predicate, which is still evaluated on the selected rows, so it only needs to select
+// a superset of the matched rows: if there is no such index, it selects all the rows.
+class MatchPredicate : public ColumnPredicate {
+public:
+    MatchPredicate(uint32_t column_id, std::vector<std::string> words,
+                   std::vector<std::string> substrings)
+            : ColumnPredicate(column_id),
+              _words(std::move(words)),
+              _substrings(std::move(substrings)) {}
+
+    // Get the words which the values matching a LIKE pattern must contain and can be
+    // looked up by inverted index, i.e. the runs of token chars of the pattern.
+    // Return false if there is no such word.
+    static bool get_words_of_like_pattern(const std::string& pattern,
+                                          std::vector<std::string>* words);
+
+    // Get the substrings which the values matching a LIKE pattern must contain, i.e. the
+    // runs of non-wildcard chars of the pattern. Return false if there is no such substring.
+    static bool get_substrings_of_like_pattern(const std::string& pattern,
+                                               std::vector<std::string>* substrings);
+
+    PredicateType type() const override { return PredicateType::MATCH; }
+
+    void evaluate(VectorizedRowBatch* batch) const override {}
+
+    void evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const override {}
+
+    void evaluate_or(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                     bool* flags) const override {
+        memset(flags, 1, size);
+    }
+
+    void evaluate_and(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                      bool* flags) const override {}
+
+    Status evaluate(const Schema& schema, const std::vector<BitmapIndexIterator*>& iterators,
+                    uint32_t num_rows, roaring::Roaring* roaring) const override {
+        return Status::OK();
+    }
+
+    // Remove the rows not matched from `roaring` by the inverted index.
+    Status evaluate(segment_v2::InvertedIndexIterator* iterator, roaring::Roaring* roaring) const;
+
+    const std::vector<std::string>& words() const { return _words; }
+
+    const std::vector<std::string>& substrings() const { return _substrings; }
+
+private:
+    std::vector<std::string> _words;
+    std::vector<std::string> _substrings;
+};
+
+} //namespace doris
@@ -27,6 +27,7 @@
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/core/field.h"
+#include "vec/core/sort_block.h"
 
 namespace doris {
 
@@ -50,9 +51,13 @@ MemTable::MemTable(int64_t tablet_id, Schema* schema, const TabletSchema* tablet
     if (support_vec) {
         _skip_list = nullptr;
         _vec_row_comparator = std::make_shared<RowInBlockComparator>(_schema);
-        // TODO: Support ZOrderComparator in the future
-        _vec_skip_list = std::make_unique<VecTable>(
-                _vec_row_comparator.get(), _table_mem_pool.get(), _keys_type == KeysType::DUP_KEYS);
+        _sort_on_flush = config::enable_memtable_sort_on_flush;
+        if (!_sort_on_flush) {
+            // TODO: Support ZOrderComparator in the future
+            _vec_skip_list = std::make_unique<VecTable>(_vec_row_comparator.get(),
+                                                        _table_mem_pool.get(),
+                                                        _keys_type == KeysType::DUP_KEYS);
+        }
         _init_columns_offset_by_slot_descs(slot_descs, tuple_desc);
     } else {
         _vec_skip_list = nullptr;
@@ -138,6 +143,12 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
     _mem_usage += input_size;
     _mem_tracker->consume(input_size);
 
+    if (_sort_on_flush) {
+        // rows are sorted and aggregated in batch by _sort_and_collect_results()
+        _rows += num_rows;
+        return;
+    }
+
     for (int i = 0; i < num_rows; i++) {
         _row_in_blocks.emplace_back(new RowInBlock {cursor_in_mutableblock + i});
         _insert_one_row_from_block(_row_in_blocks.back());
@@ -239,6 +250,8 @@ void MemTable::_aggregate_two_row_in_block(RowInBlock* new_row, RowInBlock* row_
         if (res > 0) {
             return;
         }
+        // the following rows are compared with the largest sequence so far
+        row_in_skiplist->_row_pos = new_row->_row_pos;
     }
     // dst is non-sequence row, or dst sequence is smaller
     for (uint32_t cid = _schema->num_key_columns(); cid < _schema->num_columns(); ++cid) {
@@ -287,25 +300,108 @@ void MemTable::_collect_vskiplist_results() {
         }
         if constexpr (!is_final) {
             // if is not final, we collect the agg results to input_block and then continue to insert
-            size_t shrunked_after_agg = _output_mutable_block.allocated_bytes();
-            _mem_tracker->consume(shrunked_after_agg - _mem_usage);
-            _mem_usage = shrunked_after_agg;
-            _input_mutable_block.swap(_output_mutable_block);
-            //TODO(weixang):opt here.
-            std::unique_ptr<vectorized::Block> empty_input_block =
-                    in_block.create_same_struct_block(0);
-            _output_mutable_block =
-                    vectorized::MutableBlock::build_mutable_block(empty_input_block.get());
-            _output_mutable_block.clear_column_data();
+            _swap_output_to_input(in_block);
         }
     }
 }
 
+template <bool is_final>
+void MemTable::_sort_and_collect_results() {
+    vectorized::Block in_block = _input_mutable_block.to_block();
+    size_t num_rows = in_block.rows();
+    size_t num_key_columns = _schema->num_key_columns();
+
+    vectorized::SortDescription sort_description;
+    for (size_t i = 0; i < num_key_columns; ++i) {
+        // same order as RowInBlockComparator, nulls first
+        sort_description.emplace_back(i, 1, -1);
+    }
+    // The sort must be stable so that the rows with same key keep the load order,
+    // then the REPLACE aggregation still takes the last loaded value.
+    vectorized::IColumn::Permutation perm;
+    vectorized::stable_get_permutation(in_block, sort_description, perm);
+
+    if (_keys_type == KeysType::DUP_KEYS) {
+        DCHECK(num_rows <= std::numeric_limits<int>::max());
+        std::vector<int> row_pos_vec(perm.begin(), perm.end());
+        _output_mutable_block.add_rows(&in_block, row_pos_vec.data(),
+                                       row_pos_vec.data() + row_pos_vec.size());
+    } else {
+        auto& block_data = in_block.get_columns_with_type_and_name();
+        std::vector<std::unique_ptr<char[]>> agg_places_holder(_schema->num_columns());
+        std::vector<vectorized::AggregateDataPtr> agg_places(_schema->num_columns(), nullptr);
+        for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+            agg_places_holder[cid].reset(new char[_agg_functions[cid]->size_of_data()]);
+            agg_places[cid] = agg_places_holder[cid].get();
+        }
+        bool has_sequence_col = _tablet_schema->has_sequence_col();
+        auto sequence_idx = has_sequence_col ? _tablet_schema->sequence_col_idx() : -1;
+
+        size_t start = 0;
+        while (start < num_rows) {
+            size_t end = start + 1;
+            while (end < num_rows && in_block.compare_at(perm[start], perm[end], num_key_columns,
+                                                         in_block, -1) == 0) {
+                ++end;
+            }
+            for (size_t i = 0; i < num_key_columns; ++i) {
+                _output_mutable_block.get_column_by_position(i)->insert_from(
+                        *block_data[i].column.get(), perm[start]);
+            }
+            for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+                _agg_functions[cid]->create(agg_places[cid]);
+            }
+            size_t sequence_row = perm[start];
+            for (size_t i = start; i < end; ++i) {
+                if (has_sequence_col && i != start) {
+                    const auto& sequence_column = *block_data[sequence_idx].column;
+                    // the row with larger sequence so far wins, skip the smaller ones
+                    if (sequence_column.compare_at(sequence_row, perm[i], sequence_column, -1) >
+                        0) {
+                        continue;
+                    }
+                    sequence_row = perm[i];
+                }
+                for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+                    const auto* col_ptr = block_data[cid].column.get();
+                    _agg_functions[cid]->add(agg_places[cid], &col_ptr, perm[i], nullptr);
+                }
+            }
+            for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+                _agg_functions[cid]->insert_result_into(
+                        agg_places[cid], *(_output_mutable_block.get_column_by_position(cid)));
+                _agg_functions[cid]->destroy(agg_places[cid]);
+            }
+            start = end;
+        }
+        if constexpr (!is_final) {
+            // the aggregated rows are loaded again as plain rows, and are merged with the
+            // following rows at the next shrink or flush
+            _swap_output_to_input(in_block);
+        }
+    }
+}
+
+void MemTable::_swap_output_to_input(const vectorized::Block& in_block) {
+    size_t shrunked_after_agg = _output_mutable_block.allocated_bytes();
+    _mem_tracker->consume(shrunked_after_agg - _mem_usage);
+    _mem_usage = shrunked_after_agg;
+    _input_mutable_block.swap(_output_mutable_block);
+    //TODO(weixang):opt here.
+    std::unique_ptr<vectorized::Block> empty_input_block = in_block.create_same_struct_block(0);
+    _output_mutable_block = vectorized::MutableBlock::build_mutable_block(empty_input_block.get());
+    _output_mutable_block.clear_column_data();
+}
+
 void MemTable::shrink_memtable_by_agg() {
     if (_keys_type == KeysType::DUP_KEYS) {
         return;
     }
-    _collect_vskiplist_results<false>();
+    if (_sort_on_flush) {
+        _sort_and_collect_results<false>();
+    } else {
+        _collect_vskiplist_results<false>();
+    }
 }
 
 bool MemTable::is_flush() const {
@@ -324,6 +420,7 @@ Status MemTable::flush() {
     RETURN_NOT_OK(_do_flush(duration_ns));
     DorisMetrics::instance()->memtable_flush_total->increment(1);
     DorisMetrics::instance()->memtable_flush_duration_us->increment(duration_ns / 1000);
+    DorisMetrics::instance()->memtable_flush_latency_us->add(duration_ns / 1000);
     VLOG_CRITICAL << "after flush memtable for tablet: " << _tablet_id
                   << ", flushsize: " << _flush_size;
     return Status::OK();
@@ -348,9 +445,13 @@ Status MemTable::_do_flush(int64_t& duration_ns) {
             RETURN_NOT_OK(st);
         }
     } else {
-        _collect_vskiplist_results<true>();
+        if (_sort_on_flush) {
+            _sort_and_collect_results<true>();
+        } else {
+            _collect_vskiplist_results<true>();
+        }
         vectorized::Block block = _output_mutable_block.to_block();
-        RETURN_NOT_OK(_rowset_writer->flush_single_memtable(&block));
+        RETURN_NOT_OK(_rowset_writer->flush_single_memtable(&block, _segment_id));
         _flush_size = block.allocated_bytes();
     }
     return Status::OK();
@@ -66,6 +66,13 @@ public:
 
     int64_t flush_size() const { return _flush_size; }
 
+    // Number of rows inserted to this memtable
+    int64_t rows() const { return _rows; }
+
+    // the segment id reserved for this memtable before it is submitted to flush, or -1
+    void set_segment_id(int32_t segment_id) { _segment_id = segment_id; }
+    int32_t segment_id() const { return _segment_id; }
+
 private:
     Status _do_flush(int64_t& duration_ns);
 
@@ -197,6 +204,7 @@ private:
     // This is not the rows in this memtable, because rows may be merged
     // in unique or aggragate key model.
     int64_t _rows = 0;
+    int32_t _segment_id = -1;
     void (MemTable::*_insert_fn)(const Tuple* tuple) = nullptr;
     void (MemTable::*_aggregate_two_row_fn)(const ContiguousRow& new_row,
                                             TableKey row_in_skiplist) = nullptr;
@@ -207,7 +215,13 @@ private:
 
     template <bool is_final>
     void _collect_vskiplist_results();
+    // sort all rows of _input_mutable_block by key columns and aggregate the rows
+    // with same key into _output_mutable_block, only used when _sort_on_flush is true
+    template <bool is_final>
+    void _sort_and_collect_results();
+    void _swap_output_to_input(const vectorized::Block& in_block);
     bool _is_first_insertion;
+    bool _sort_on_flush = false;
 
     void _init_agg_functions(const vectorized::Block* block);
     std::vector<vectorized::AggregateFunctionPtr> _agg_functions;
@@ -107,7 +107,9 @@ void MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
             .build(&_high_prio_flush_pool);
 }
 
-// NOTE: we use SERIAL mode here to ensure all mem-tables from one tablet are flushed in order.
+// NOTE: alpha rowset uses SERIAL mode to ensure all mem-tables from one tablet are flushed in order.
+// Beta rowset uses CONCURRENT mode, the order of segments is kept by the segment id reserved
+// for each mem-table in DeltaWriter::_flush_memtable_async().
 Status MemTableFlushExecutor::create_flush_token(std::unique_ptr<FlushToken>* flush_token,
                                                  RowsetTypePB rowset_type, bool is_high_priority) {
     if (!is_high_priority) {
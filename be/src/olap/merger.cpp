@@ -22,10 +22,15 @@
 
 #include "olap/olap_define.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/vertical_beta_rowset_writer.h"
+#include "olap/schema.h"
+#include "olap/segment_loader.h"
 #include "olap/tablet.h"
 #include "olap/tuple_reader.h"
 #include "util/trace.h"
 #include "vec/olap/block_reader.h"
+#include "vec/olap/vertical_merge_iterator.h"
 
 namespace doris {
 
@@ -133,4 +138,134 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     return Status::OK();
 }
 
+void Merger::vertical_split_columns(const TabletSchema& tablet_schema,
+                                    std::vector<std::vector<uint32_t>>* column_groups) {
+    uint32_t num_key_columns = tablet_schema.num_key_columns();
+    std::vector<uint32_t> key_columns(num_key_columns);
+    std::iota(key_columns.begin(), key_columns.end(), 0);
+    column_groups->emplace_back(std::move(key_columns));
+
+    size_t num_columns_per_group = std::max(1, config::vertical_compaction_num_columns_per_group);
+    std::vector<uint32_t> value_columns;
+    for (uint32_t cid = num_key_columns; cid < tablet_schema.num_columns(); ++cid) {
+        DCHECK(!tablet_schema.column(cid).is_key()) << "key columns should be the prefix";
+        value_columns.push_back(cid);
+        if (value_columns.size() == num_columns_per_group) {
+            column_groups->emplace_back(std::move(value_columns));
+            value_columns.clear();
+        }
+    }
+    if (!value_columns.empty()) {
+        column_groups->emplace_back(std::move(value_columns));
+    }
+}
+
+Status Merger::vertical_compact_one_group(
+        TabletSharedPtr tablet, ReaderType reader_type,
+        const std::vector<RowsetSharedPtr>& src_rowsets, const std::vector<uint32_t>& column_group,
+        bool is_key, vectorized::RowSourcesBuffer* row_sources_buf,
+        VerticalBetaRowsetWriter* dst_rowset_writer, uint32_t max_rows_per_segment,
+        Statistics* stats_output) {
+    const auto& tablet_schema = tablet->tablet_schema();
+    Schema schema(tablet_schema.columns(), column_group);
+    OlapReaderStatistics reader_stats;
+    // The segments must be alive until the iterators are released
+    std::vector<SegmentCacheHandle> segment_cache_handles(src_rowsets.size());
+
+    // Every segment is an input of merge, so that the value columns of a segment can be
+    // read sequentially in the order of the key columns.
+    const DeleteBitmap* delete_bitmap = tablet->enable_unique_key_merge_on_write()
+                                                ? &tablet->tablet_meta()->delete_bitmap()
+                                                : nullptr;
+    std::vector<std::unique_ptr<RowwiseIterator>> seg_iterators;
+    for (size_t i = 0; i < src_rowsets.size(); ++i) {
+        auto rowset = std::static_pointer_cast<BetaRowset>(src_rowsets[i]);
+        RETURN_NOT_OK(rowset->load());
+        StorageReadOptions read_options;
+        read_options.stats = &reader_stats;
+        read_options.use_page_cache = false;
+        if (delete_bitmap != nullptr) {
+            for (uint32_t seg_id = 0; seg_id < rowset->num_segments(); ++seg_id) {
+                auto seg_delete_bitmap = delete_bitmap->get_agg(
+                        {rowset->rowset_id(), seg_id, dst_rowset_writer->version().second});
+                if (!seg_delete_bitmap->isEmpty()) {
+                    read_options.delete_bitmap.emplace(seg_id, std::move(seg_delete_bitmap));
+                }
+            }
+        }
+        RETURN_NOT_OK(SegmentLoader::instance()->load_segments(rowset, &segment_cache_handles[i],
+                                                               false));
+        for (auto& segment : segment_cache_handles[i].get_segments()) {
+            std::unique_ptr<RowwiseIterator> iter;
+            RETURN_NOT_OK(segment->new_iterator(schema, read_options, &iter));
+            seg_iterators.push_back(std::move(iter));
+        }
+    }
+
+    std::vector<RowwiseIterator*> iterators;
+    for (auto& iter : seg_iterators) {
+        iterators.push_back(iter.release());
+    }
+    std::unique_ptr<RowwiseIterator> merge_iter;
+    if (is_key) {
+        row_sources_buf->clear();
+        merge_iter.reset(vectorized::new_vertical_heap_merge_iterator(
+                iterators, tablet_schema.keys_type() == UNIQUE_KEYS, row_sources_buf));
+    } else {
+        row_sources_buf->seek_to_begin();
+        merge_iter.reset(vectorized::new_vertical_mask_merge_iterator(iterators, row_sources_buf));
+    }
+    RETURN_NOT_OK(merge_iter->init(StorageReadOptions()));
+
+    vectorized::Block block = tablet_schema.create_block(column_group);
+    int64_t output_rows = 0;
+    while (true) {
+        auto st = merge_iter->next_batch(&block);
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_NOT_OK_LOG(
+                st, "failed to read next block when merging rowsets of tablet " + tablet->full_name());
+        RETURN_NOT_OK_LOG(
+                dst_rowset_writer->add_columns(&block, column_group, is_key, max_rows_per_segment),
+                "failed to write block when merging rowsets of tablet " + tablet->full_name());
+        output_rows += block.rows();
+        block.clear_column_data();
+    }
+
+    if (is_key && stats_output != nullptr) {
+        stats_output->output_rows = output_rows;
+        stats_output->merged_rows = row_sources_buf->total_size() - output_rows;
+        stats_output->filtered_rows = reader_stats.rows_del_filtered;
+    }
+
+    RETURN_NOT_OK_LOG(
+            dst_rowset_writer->flush_columns(),
+            "failed to flush columns when merging rowsets of tablet " + tablet->full_name());
+    return Status::OK();
+}
+
+Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                      const std::vector<RowsetSharedPtr>& src_rowsets,
+                                      VerticalBetaRowsetWriter* dst_rowset_writer,
+                                      uint32_t max_rows_per_segment, Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("vertical_merge_rowsets_latency_us");
+
+    std::vector<std::vector<uint32_t>> column_groups;
+    vertical_split_columns(tablet->tablet_schema(), &column_groups);
+
+    vectorized::RowSourcesBuffer row_sources_buf;
+    for (size_t i = 0; i < column_groups.size(); ++i) {
+        RETURN_NOT_OK(vertical_compact_one_group(tablet, reader_type, src_rowsets,
+                                                 column_groups[i], i == 0, &row_sources_buf,
+                                                 dst_rowset_writer, max_rows_per_segment,
+                                                 stats_output));
+    }
+
+    RETURN_NOT_OK_LOG(
+            dst_rowset_writer->final_flush(),
+            "failed to flush rowset when merging rowsets of tablet " + tablet->full_name());
+    return Status::OK();
+}
+
 } // namespace doris
@@ -23,6 +23,12 @@
 
 namespace doris {
 
+class VerticalBetaRowsetWriter;
+
+namespace vectorized {
+class RowSourcesBuffer;
+} // namespace vectorized
+
 class Merger {
 public:
     struct Statistics {
@@ -42,6 +48,28 @@ public:
     static Status vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                  RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+
+    // Vertical compaction merges the key columns of `src_rowsets` first, and records the
+    // source of every row. Then the value columns are merged group by group in the same
+    // order, so that only one group of columns is in memory at a time.
+    static Status vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                         const std::vector<RowsetSharedPtr>& src_rowsets,
+                                         VerticalBetaRowsetWriter* dst_rowset_writer,
+                                         uint32_t max_rows_per_segment, Statistics* stats_output);
+
+    // Split the columns of `tablet_schema` into groups for vertical compaction, the first
+    // group contains all the key columns.
+    static void vertical_split_columns(const TabletSchema& tablet_schema,
+                                       std::vector<std::vector<uint32_t>>* column_groups);
+
+    static Status vertical_compact_one_group(TabletSharedPtr tablet, ReaderType reader_type,
+                                             const std::vector<RowsetSharedPtr>& src_rowsets,
+                                             const std::vector<uint32_t>& column_group,
+                                             bool is_key,
+                                             vectorized::RowSourcesBuffer* row_sources_buf,
+                                             VerticalBetaRowsetWriter* dst_rowset_writer,
+                                             uint32_t max_rows_per_segment,
+                                             Statistics* stats_output);
 };
 
 } // namespace doris
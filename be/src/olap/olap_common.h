@@ -270,6 +270,14 @@ struct OlapReaderStatistics {
 
     int64_t rows_vec_cond_filtered = 0;
     int64_t rows_vec_del_cond_filtered = 0;
+    // rows of the predicate columns which are not read by the staged predicate column read
+    int64_t rows_pred_column_skipped = 0;
+    // rows of the segments whose aggregation pushed down are answered by the metadata
+    int64_t rows_read_by_metadata = 0;
+    // rows of the segments whose COUNT pushed down are answered by the indexes
+    int64_t rows_counted_by_index = 0;
+    // rows of the lazily materialized columns read from the row store
+    int64_t rows_read_by_row_store = 0;
     int64_t vec_cond_ns = 0;
     int64_t short_cond_ns = 0;
     int64_t first_read_ns = 0;
@@ -295,6 +303,8 @@ struct OlapReaderStatistics {
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
+    int64_t rows_inverted_index_filtered = 0;
+    int64_t inverted_index_filter_timer = 0;
     // number of segment filtered by column stat when creating seg iterator
     int64_t filtered_segment_number = 0;
     // total number of segment
@@ -394,4 +404,16 @@ struct RowsetId {
     }
 };
 
+// Locates a row in a tablet: the segment `segment_id` of rowset `rowset_id`,
+// and the row `row_id` in that segment.
+struct RowLocation {
+    RowLocation() : segment_id(0), row_id(0) {}
+    RowLocation(uint32_t sid, uint32_t rid) : segment_id(sid), row_id(rid) {}
+    RowLocation(RowsetId rsid, uint32_t sid, uint32_t rid)
+            : rowset_id(rsid), segment_id(sid), row_id(rid) {}
+    RowsetId rowset_id;
+    uint32_t segment_id;
+    uint32_t row_id;
+};
+
 } // namespace doris
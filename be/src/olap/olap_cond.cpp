@@ -19,6 +19,7 @@
 
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <utility>
@@ -169,6 +170,13 @@ Status Cond::init(const TCondition& tcond, const TabletColumn& column) {
                 f.release();
             }
         }
+        if (op == OP_IN) {
+            sorted_operands.assign(operand_set.begin(), operand_set.end());
+            std::sort(sorted_operands.begin(), sorted_operands.end(),
+                      [](const WrapperField* lhs, const WrapperField* rhs) {
+                          return lhs->cmp(rhs) < 0;
+                      });
+        }
     }
 
     return Status::OK();
@@ -245,8 +253,18 @@ bool Cond::eval(const std::pair<WrapperField*, WrapperField*>& statistic) const
         return operand_field->cmp(statistic.second) <= 0;
     }
     case OP_IN: {
-        return min_value_field->cmp(statistic.second) <= 0 &&
-               max_value_field->cmp(statistic.first) >= 0;
+        if (min_value_field->cmp(statistic.second) > 0 ||
+            max_value_field->cmp(statistic.first) < 0) {
+            return false;
+        }
+        // the values may all fall in the gaps between the operands, e.g. the zone map of a
+        // string column page [b, c) for `IN ('a', 'd')`
+        auto it = std::lower_bound(sorted_operands.begin(), sorted_operands.end(),
+                                   statistic.first,
+                                   [](const WrapperField* operand, const WrapperField* value) {
+                                       return operand->cmp(value) < 0;
+                                   });
+        return it != sorted_operands.end() && (*it)->cmp(statistic.second) <= 0;
     }
     case OP_NOT_IN: {
         return true;
@@ -92,6 +92,8 @@ public:
     // valid when op is OP_IN or OP_NOT_IN, represents the minimum or maximum value of in elements
     WrapperField* min_value_field = nullptr;
     WrapperField* max_value_field = nullptr;
+    // valid when op is OP_IN, the fields of operand_set in ascending order
+    std::vector<const WrapperField*> sorted_operands;
 };
 
 // 所有归属于同一列上的条件二元组，聚合在一个CondColumn上
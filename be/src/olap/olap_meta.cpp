@@ -26,6 +26,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/slice_transform.h"
+#include "rocksdb/write_batch.h"
 #include "util/doris_metrics.h"
 #include "util/runtime_profile.h"
 
@@ -136,6 +137,39 @@ Status OlapMeta::put(const int column_family_index, const std::string& key,
     return Status::OK();
 }
 
+Status OlapMeta::put(const int column_family_index,
+                     const std::vector<std::pair<std::string, std::string>>& entries) {
+    if (entries.empty()) {
+        return Status::OK();
+    }
+    DorisMetrics::instance()->meta_write_request_total->increment(1);
+    rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
+    int64_t duration_ns = 0;
+    rocksdb::Status s;
+    {
+        SCOPED_RAW_TIMER(&duration_ns);
+        rocksdb::WriteBatch batch;
+        for (auto& [key, value] : entries) {
+            s = batch.Put(handle, rocksdb::Slice(key), rocksdb::Slice(value));
+            if (!s.ok()) {
+                break;
+            }
+        }
+        if (s.ok()) {
+            WriteOptions write_options;
+            write_options.sync = config::sync_tablet_meta;
+            s = _db->Write(write_options, &batch);
+        }
+    }
+    DorisMetrics::instance()->meta_write_request_duration_us->increment(duration_ns / 1000);
+    if (!s.ok()) {
+        LOG(WARNING) << "rocks db put " << entries.size() << " keys failed, first key:"
+                     << entries.front().first << ", reason:" << s.ToString();
+        return Status::OLAPInternalError(OLAP_ERR_META_PUT);
+    }
+    return Status::OK();
+}
+
 Status OlapMeta::remove(const int column_family_index, const std::string& key) {
     DorisMetrics::instance()->meta_write_request_total->increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
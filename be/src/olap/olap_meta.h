@@ -20,6 +20,8 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "olap/olap_define.h"
 #include "rocksdb/db.h"
@@ -40,6 +42,10 @@ public:
 
     Status put(const int column_family_index, const std::string& key, const std::string& value);
 
+    // put the key value pairs in one write batch
+    Status put(const int column_family_index,
+               const std::vector<std::pair<std::string, std::string>>& entries);
+
     Status remove(const int column_family_index, const std::string& key);
 
     Status iterate(const int column_family_index, const std::string& prefix,
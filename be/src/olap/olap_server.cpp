@@ -28,10 +28,12 @@
 #include "agent/cgroups_mgr.h"
 #include "common/status.h"
 #include "gutil/strings/substitute.h"
+#include "io/fs/io_limiter.h"
 #include "olap/convert_rowset.h"
 #include "olap/cumulative_compaction.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
+#include "olap/page_cache_warmer.h"
 #include "olap/storage_engine.h"
 #include "util/time.h"
 
@@ -152,6 +154,11 @@ Status StorageEngine::start_bg_threads() {
         LOG(INFO) << "path scan/gc threads started. number:" << get_stores().size();
     }
 
+    ThreadPoolBuilder("PublishVersionTabletThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(std::max(config::publish_version_tablet_thread_num, 1))
+            .build(&_publish_version_thread_pool);
+
     ThreadPoolBuilder("CooldownTaskThreadPool")
             .set_min_threads(config::cooldown_thread_num)
             .set_max_threads(config::cooldown_thread_num)
@@ -164,6 +171,14 @@ Status StorageEngine::start_bg_threads() {
             &_cooldown_tasks_producer_thread));
     LOG(INFO) << "cooldown tasks producer thread started";
 
+    if (PageCacheWarmer::instance() != nullptr) {
+        RETURN_IF_ERROR(Thread::create(
+                "StorageEngine", "page_cache_warm_up_thread",
+                [this]() { this->_page_cache_warm_up_callback(); },
+                &_page_cache_warm_up_thread));
+        LOG(INFO) << "page cache warm up thread started";
+    }
+
     LOG(INFO) << "all storage engine's background threads are started.";
     return Status::OK();
 }
@@ -529,13 +544,17 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
     // when travesing the data dir
     std::map<DataDir*, std::unordered_set<TTabletId>> copied_cumu_map;
     std::map<DataDir*, std::unordered_set<TTabletId>> copied_base_map;
+    std::map<DataDir*, int64_t> copied_permits_map;
     {
         std::unique_lock<std::mutex> lock(_tablet_submitted_compaction_mutex);
         copied_cumu_map = _tablet_submitted_cumu_compaction;
         copied_base_map = _tablet_submitted_base_compaction;
+        copied_permits_map = _disk_compaction_permits;
     }
     for (auto data_dir : data_dirs) {
         bool need_pick_tablet = true;
+        // whether to pick the tablet only if it is hot enough to take a slot of base compaction
+        bool need_pick_hot_tablet = false;
         // We need to reserve at least one Slot for cumulative compaction.
         // So when there is only one Slot, we have to judge whether there is a cumulative compaction
         // in the current submitted tasks.
@@ -547,7 +566,15 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
         if (count >= thread_per_disk) {
             // Return if no available slot
             need_pick_tablet = false;
-            if (!check_score) {
+            // The slots held by base compactions could be taken by the cumulative compaction
+            // of a hot tablet, which reduces the read amplification of its queries in time,
+            // while the base compactions are less urgent.
+            if (compaction_type == CompactionType::CUMULATIVE_COMPACTION &&
+                config::compaction_preempt_read_heat_threshold > 0 &&
+                !copied_base_map[data_dir].empty() &&
+                static_cast<int>(copied_cumu_map[data_dir].size()) < thread_per_disk) {
+                need_pick_hot_tablet = true;
+            } else if (!check_score) {
                 continue;
             }
         } else if (count >= thread_per_disk - 1) {
@@ -562,19 +589,36 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
             }
         }
 
+        // The I/O of the compactions on a disk is bounded by the permits they hold.
+        if (config::compaction_permits_per_disk > 0 &&
+            copied_permits_map[data_dir] >= config::compaction_permits_per_disk) {
+            need_pick_tablet = false;
+            need_pick_hot_tablet = false;
+            if (!check_score) {
+                continue;
+            }
+        }
+
         // Even if need_pick_tablet is false, we still need to call find_best_tablet_to_compaction(),
         // So that we can update the max_compaction_score metric.
         if (!data_dir->reach_capacity_limit(0)) {
             uint32_t disk_max_score = 0;
+            double read_heat = 0.0;
             TabletSharedPtr tablet = _tablet_manager->find_best_tablet_to_compaction(
                     compaction_type, data_dir,
                     compaction_type == CompactionType::CUMULATIVE_COMPACTION
                             ? copied_cumu_map[data_dir]
                             : copied_base_map[data_dir],
-                    &disk_max_score, _cumulative_compaction_policy);
+                    &disk_max_score, _cumulative_compaction_policy, &read_heat);
             if (tablet != nullptr) {
                 if (need_pick_tablet) {
                     tablets_compaction.emplace_back(tablet);
+                } else if (need_pick_hot_tablet &&
+                           read_heat >= config::compaction_preempt_read_heat_threshold) {
+                    VLOG_NOTICE << "hot tablet " << tablet->tablet_id() << " with read heat "
+                                << read_heat << " takes a compaction slot of base compaction on "
+                                << data_dir->path();
+                    tablets_compaction.emplace_back(tablet);
                 }
                 max_compaction_score = std::max(max_compaction_score, disk_max_score);
             }
@@ -631,6 +675,11 @@ bool StorageEngine::_push_tablet_into_submitted_compaction(TabletSharedPtr table
     return already_existed;
 }
 
+void StorageEngine::_update_disk_compaction_permits(DataDir* data_dir, int64_t permits) {
+    std::unique_lock<std::mutex> lock(_tablet_submitted_compaction_mutex);
+    _disk_compaction_permits[data_dir] += permits;
+}
+
 void StorageEngine::_pop_tablet_from_submitted_compaction(TabletSharedPtr tablet,
                                                           CompactionType compaction_type) {
     std::unique_lock<std::mutex> lock(_tablet_submitted_compaction_mutex);
@@ -662,6 +711,7 @@ Status StorageEngine::_submit_compaction_task(TabletSharedPtr tablet,
     int64_t permits = 0;
     Status st = tablet->prepare_compaction_and_calculate_permits(compaction_type, tablet, &permits);
     if (st.ok() && permits > 0 && _permit_limiter.request(permits)) {
+        _update_disk_compaction_permits(tablet->data_dir(), permits);
         std::unique_ptr<ThreadPool>& thread_pool =
                 (compaction_type == CompactionType::CUMULATIVE_COMPACTION)
                         ? _cumu_compaction_thread_pool
@@ -672,12 +722,14 @@ Status StorageEngine::_submit_compaction_task(TabletSharedPtr tablet,
             CgroupsMgr::apply_system_cgroup();
             tablet->execute_compaction(compaction_type);
             _permit_limiter.release(permits);
+            _update_disk_compaction_permits(tablet->data_dir(), -permits);
             // reset compaction
             tablet->reset_compaction(compaction_type);
             _pop_tablet_from_submitted_compaction(tablet, compaction_type);
         });
         if (!st.ok()) {
             _permit_limiter.release(permits);
+            _update_disk_compaction_permits(tablet->data_dir(), -permits);
             // reset compaction
             tablet->reset_compaction(compaction_type);
             _pop_tablet_from_submitted_compaction(tablet, compaction_type);
@@ -788,4 +840,46 @@ void StorageEngine::_cooldown_tasks_producer_callback() {
     } while (!_stop_background_threads_latch.wait_for(std::chrono::seconds(interval)));
 }
 
+void StorageEngine::_page_cache_warm_up_callback() {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    auto warmer = PageCacheWarmer::instance();
+    auto stopped = [this]() { return _stop_background_threads_latch.count() == 0; };
+    {
+        // read the pages as background IO, not to slow down the queries coming in
+        io::IOLimiter::Scope io_limiter_scope;
+        for (auto data_dir : get_stores()) {
+            if (stopped()) {
+                break;
+            }
+            int64_t start_ms = MonotonicMillis();
+            int64_t num_pages = 0;
+            Status st = warmer->warm_up(data_dir->fs(), data_dir->path(), stopped, &num_pages);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to warm up page cache from " << data_dir->path() << ": "
+                             << st;
+            }
+            LOG(INFO) << "warmed up page cache with " << num_pages << " pages from "
+                      << data_dir->path() << " in " << MonotonicMillis() - start_ms << "ms";
+        }
+    }
+    warmer->set_warmed_up();
+
+    auto save = [this, warmer]() {
+        for (auto data_dir : get_stores()) {
+            WARN_IF_ERROR(warmer->save(data_dir->path()),
+                          "failed to save page cache pages of " + data_dir->path());
+        }
+    };
+    int64_t interval = config::page_cache_warm_up_save_interval_sec;
+    while (!_stop_background_threads_latch.wait_for(
+            std::chrono::seconds(std::max<int64_t>(interval, 1)))) {
+        save();
+        interval = config::page_cache_warm_up_save_interval_sec;
+    }
+    // the pages when stopping are the hottest to warm up with
+    save();
+}
+
 } // namespace doris
@@ -17,6 +17,7 @@
 
 #include "olap/page_cache.h"
 
+#include "olap/page_cache_warmer.h"
 #include "runtime/thread_context.h"
 
 namespace doris {
@@ -24,31 +25,33 @@ namespace doris {
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                           uint32_t num_shards) {
+                                           uint32_t num_shards,
+                                           CacheEvictionPolicy eviction_policy) {
     DCHECK(_s_instance == nullptr);
-    static StoragePageCache instance(capacity, index_cache_percentage, num_shards);
+    static StoragePageCache instance(capacity, index_cache_percentage, num_shards,
+                                     eviction_policy);
     _s_instance = &instance;
 }
 
 StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage,
-                                   uint32_t num_shards)
+                                   uint32_t num_shards, CacheEvictionPolicy eviction_policy)
         : _index_cache_percentage(index_cache_percentage),
           _mem_tracker(MemTracker::create_tracker(capacity, "StoragePageCache", nullptr,
                                                   MemTrackerLevel::OVERVIEW)) {
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     if (index_cache_percentage == 0) {
-        _data_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards));
+        _data_page_cache = std::unique_ptr<Cache>(new_lru_cache(
+                "DataPageCache", capacity, LRUCacheType::SIZE, num_shards, eviction_policy));
     } else if (index_cache_percentage == 100) {
-        _index_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("IndexPageCache", capacity, LRUCacheType::SIZE, num_shards));
+        _index_page_cache = std::unique_ptr<Cache>(new_lru_cache(
+                "IndexPageCache", capacity, LRUCacheType::SIZE, num_shards, eviction_policy));
     } else if (index_cache_percentage > 0 && index_cache_percentage < 100) {
         _data_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("DataPageCache", capacity * (100 - index_cache_percentage) / 100,
-                              LRUCacheType::SIZE, num_shards));
+                              LRUCacheType::SIZE, num_shards, eviction_policy));
         _index_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("IndexPageCache", capacity * index_cache_percentage / 100,
-                              LRUCacheType::SIZE, num_shards));
+                              LRUCacheType::SIZE, num_shards, eviction_policy));
     } else {
         CHECK(false) << "invalid index page cache percentage";
     }
@@ -67,7 +70,13 @@ bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle,
 
 void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle,
                               segment_v2::PageTypePB page_type, bool in_memory) {
-    auto deleter = [](const doris::CacheKey& key, void* value) { delete[](uint8_t*) value; };
+    auto deleter = [](const doris::CacheKey& key, void* value) {
+        delete[](uint8_t*) value;
+        auto warmer = PageCacheWarmer::instance();
+        if (warmer != nullptr) {
+            warmer->remove(key);
+        }
+    };
 
     CachePriority priority = CachePriority::NORMAL;
     if (in_memory) {
@@ -79,4 +88,36 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     *handle = PageCacheHandle(cache, lru_handle);
 }
 
+DecodedPageCache* DecodedPageCache::_s_instance = nullptr;
+
+void DecodedPageCache::create_global_cache(size_t capacity, uint32_t num_shards) {
+    DCHECK(_s_instance == nullptr);
+    static DecodedPageCache instance(capacity, num_shards);
+    _s_instance = &instance;
+}
+
+DecodedPageCache::DecodedPageCache(size_t capacity, uint32_t num_shards)
+        : _mem_tracker(MemTracker::create_tracker(capacity, "DecodedPageCache", nullptr,
+                                                  MemTrackerLevel::OVERVIEW)) {
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    _cache.reset(new_lru_cache("DecodedPageCache", capacity, LRUCacheType::SIZE, num_shards,
+                               CacheEvictionPolicy::TINY_LFU));
+}
+
+bool DecodedPageCache::lookup(const StoragePageCache::CacheKey& key, PageCacheHandle* handle) {
+    auto lru_handle = _cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    return true;
+}
+
+void DecodedPageCache::insert(const StoragePageCache::CacheKey& key, const Slice& data,
+                              PageCacheHandle* handle) {
+    auto deleter = [](const doris::CacheKey& key, void* value) { delete[](uint8_t*) value; };
+    auto lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter);
+    *handle = PageCacheHandle(_cache.get(), lru_handle);
+}
+
 } // namespace doris
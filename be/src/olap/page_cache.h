@@ -57,14 +57,17 @@ public:
     static constexpr uint32_t kDefaultNumShards = 16;
 
     // Create global instance of this class
-    static void create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                    uint32_t num_shards = kDefaultNumShards);
+    static void create_global_cache(
+            size_t capacity, int32_t index_cache_percentage,
+            uint32_t num_shards = kDefaultNumShards,
+            CacheEvictionPolicy eviction_policy = CacheEvictionPolicy::LRU);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards);
+    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards,
+                     CacheEvictionPolicy eviction_policy = CacheEvictionPolicy::LRU);
 
     // Lookup the given page in the cache.
     //
@@ -114,6 +117,34 @@ private:
     }
 };
 
+// Cache of the data pages decoded into PLAIN pages, which are copied into the columns
+// directly, without running the decoders of their encodings (bitshuffle, frame of reference,
+// run length) again on every hit. Only the fixed-width columns are cached. The entries are
+// raw pages in the layout of StoragePageCache, with a budget of their own, and admitted by
+// TinyLFU so that only the pages of the hot columns take the memory.
+class DecodedPageCache {
+public:
+    // Create global instance of this class, the pages are not decoded if not created
+    static void create_global_cache(size_t capacity,
+                                    uint32_t num_shards = StoragePageCache::kDefaultNumShards);
+
+    // nullptr if the cache is disabled
+    static DecodedPageCache* instance() { return _s_instance; }
+
+    DecodedPageCache(size_t capacity, uint32_t num_shards);
+
+    bool lookup(const StoragePageCache::CacheKey& key, PageCacheHandle* handle);
+
+    void insert(const StoragePageCache::CacheKey& key, const Slice& data,
+                PageCacheHandle* handle);
+
+private:
+    static DecodedPageCache* _s_instance;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+    std::unique_ptr<Cache> _cache;
+};
+
 // A handle for StoragePageCache entry. This class make it easy to handle
 // Cache entry. Users don't need to release the obtained cache entry. This
 // class will release the cache entry when it is destroyed.
@@ -0,0 +1,182 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/page_cache_warmer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "io/fs/file_reader.h"
+#include "io/fs/file_system.h"
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/page_handle.h"
+#include "olap/rowset/segment_v2/page_io.h"
+#include "util/block_compression.h"
+
+namespace doris {
+
+PageCacheWarmer* PageCacheWarmer::_s_instance = nullptr;
+
+void PageCacheWarmer::create_global_instance(size_t max_pages) {
+    DCHECK(_s_instance == nullptr);
+    if (max_pages == 0) {
+        return;
+    }
+    // never destroyed, the pages freed by the page cache at exit still remove themselves
+    _s_instance = new PageCacheWarmer(max_pages);
+}
+
+void PageCacheWarmer::add(const StoragePageCache::CacheKey& key, const PageInfo& info) {
+    std::lock_guard l(_lock);
+    if (_pages.size() >= _max_pages) {
+        return;
+    }
+    _pages[key.encode()] = info;
+}
+
+void PageCacheWarmer::remove(const CacheKey& key) {
+    std::lock_guard l(_lock);
+    _pages.erase(key.to_string());
+}
+
+size_t PageCacheWarmer::num_pages() {
+    std::lock_guard l(_lock);
+    return _pages.size();
+}
+
+Status PageCacheWarmer::save(const std::string& dir) {
+    std::string prefix = dir + "/";
+    // file -> offset -> page, so the pages are read in order when warming up
+    std::map<std::string, std::map<int64_t, PageInfo>> files;
+    {
+        std::lock_guard l(_lock);
+        for (auto& [key, info] : _pages) {
+            if (key.size() <= sizeof(int64_t) || key.compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+            int64_t offset = 0;
+            memcpy(&offset, key.data() + key.size() - sizeof(offset), sizeof(offset));
+            files[key.substr(0, key.size() - sizeof(offset))].emplace(offset, info);
+        }
+    }
+
+    segment_v2::CachedPagesPB pages_pb;
+    for (auto& [path, pages] : files) {
+        auto file_pb = pages_pb.add_files();
+        file_pb->set_path(path);
+        for (auto& [offset, info] : pages) {
+            auto page_pb = file_pb->add_pages();
+            page_pb->set_offset(offset);
+            page_pb->set_size(info.size);
+            page_pb->set_type(info.type);
+            page_pb->set_compression(info.compression);
+            if (info.field_type != OLAP_FIELD_TYPE_UNKNOWN) {
+                page_pb->set_field_type(info.field_type);
+                page_pb->set_encoding(info.encoding);
+            }
+            page_pb->set_kept_in_memory(info.kept_in_memory);
+        }
+    }
+
+    // replace the old file only when the new one is complete
+    std::string path = dir + "/" + PAGES_FILE_NAME;
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out || !pages_pb.SerializeToOstream(&out)) {
+            return Status::IOError(fmt::format("failed to write {}", tmp_path));
+        }
+        out.close();
+        if (!out) {
+            return Status::IOError(fmt::format("failed to write {}", tmp_path));
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        return Status::IOError(fmt::format("failed to rename {} to {}: {}", tmp_path, path,
+                                           std::strerror(errno)));
+    }
+    return Status::OK();
+}
+
+Status PageCacheWarmer::warm_up(const io::FileSystemPtr& fs, const std::string& dir,
+                                const std::function<bool()>& stopped, int64_t* num_pages) {
+    *num_pages = 0;
+    std::string path = dir + "/" + PAGES_FILE_NAME;
+    segment_v2::CachedPagesPB pages_pb;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            // nothing saved
+            return Status::OK();
+        }
+        if (!pages_pb.ParseFromIstream(&in)) {
+            return Status::Corruption(fmt::format("failed to parse {}", path));
+        }
+    }
+
+    std::map<segment_v2::CompressionTypePB, std::unique_ptr<BlockCompressionCodec>> codecs;
+    OlapReaderStatistics stats;
+    for (auto& file_pb : pages_pb.files()) {
+        std::unique_ptr<io::FileReader> file_reader;
+        if (!fs->open_file(file_pb.path(), &file_reader).ok()) {
+            continue;
+        }
+        for (auto& page_pb : file_pb.pages()) {
+            if (stopped()) {
+                return Status::OK();
+            }
+            auto& codec = codecs[page_pb.compression()];
+            if (codec == nullptr && page_pb.compression() != segment_v2::NO_COMPRESSION &&
+                !get_block_compression_codec(page_pb.compression(), codec).ok()) {
+                continue;
+            }
+            const segment_v2::EncodingInfo* encoding_info = nullptr;
+            if (page_pb.has_field_type() &&
+                !segment_v2::EncodingInfo::get(static_cast<FieldType>(page_pb.field_type()),
+                                               page_pb.encoding(), &encoding_info)
+                         .ok()) {
+                continue;
+            }
+            segment_v2::PageReadOptions opts;
+            opts.file_reader = file_reader.get();
+            opts.page_pointer = segment_v2::PagePointer(page_pb.offset(), page_pb.size());
+            opts.codec = codec.get();
+            opts.stats = &stats;
+            opts.kept_in_memory = page_pb.kept_in_memory();
+            opts.type = page_pb.type();
+            opts.encoding_info = encoding_info;
+            segment_v2::PageHandle handle;
+            Slice body;
+            segment_v2::PageFooterPB footer;
+            Status st = segment_v2::PageIO::read_and_decompress_page(opts, &handle, &body, &footer);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to warm up page " << page_pb.offset() << " of "
+                             << file_pb.path() << ": " << st;
+                break;
+            }
+            ++*num_pages;
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "io/fs/file_system.h"
+#include "olap/lru_cache.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+
+namespace doris {
+
+// PageCacheWarmer keeps the pages in StoragePageCache with what is needed to read them
+// again, saves them into each data dir periodically, and reads them back into the cache in
+// the background after the BE restarts, so the queries don't see a cold cache for long.
+//
+// The pages are added when they are read into the cache, and removed when they are freed by
+// the cache, so only the cached pages are saved. The pages compressed with the dictionaries
+// of their columns are not kept.
+class PageCacheWarmer {
+public:
+    struct PageInfo {
+        // the size of the page in the file
+        uint32_t size;
+        segment_v2::PageTypePB type;
+        segment_v2::CompressionTypePB compression;
+        // the field type and the encoding to pre-decode the page with, field_type is
+        // OLAP_FIELD_TYPE_UNKNOWN if the page is not pre-decoded
+        FieldType field_type;
+        segment_v2::EncodingTypePB encoding;
+        bool kept_in_memory;
+    };
+
+    // The name of the file of the pages saved in each data dir.
+    static constexpr const char* PAGES_FILE_NAME = "page_cache_pages";
+
+    // Keeps nothing if max_pages is 0.
+    static void create_global_instance(size_t max_pages);
+
+    // nullptr if disabled or not created, e.g. in the tools.
+    static PageCacheWarmer* instance() { return _s_instance; }
+
+    explicit PageCacheWarmer(size_t max_pages) : _max_pages(max_pages) {}
+
+    // Adds a page read into the cache, ignored if there are max_pages already.
+    void add(const StoragePageCache::CacheKey& key, const PageInfo& info);
+
+    // Removes a page freed by the cache, the key is the encoded StoragePageCache::CacheKey.
+    void remove(const CacheKey& key);
+
+    size_t num_pages();
+
+    // Saves the pages of the files under dir into dir/PAGES_FILE_NAME.
+    Status save(const std::string& dir);
+
+    // Reads the pages saved in dir into the cache through fs, in the order of their files and
+    // offsets. It's stopped when stopped() returns true. The files not existing any more,
+    // e.g. the ones compacted, are skipped.
+    Status warm_up(const io::FileSystemPtr& fs, const std::string& dir,
+                   const std::function<bool()>& stopped, int64_t* num_pages);
+
+    // Whether warm_up() of all the data dirs is done, for the health check.
+    bool warmed_up() const { return _warmed_up.load(); }
+    void set_warmed_up() { _warmed_up = true; }
+
+private:
+    static PageCacheWarmer* _s_instance;
+
+    const size_t _max_pages;
+    std::mutex _lock;
+    // the encoded StoragePageCache::CacheKey to the page
+    std::unordered_map<std::string, PageInfo> _pages;
+    std::atomic<bool> _warmed_up {false};
+};
+
+} // namespace doris
@@ -0,0 +1,43 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "olap/rowset/rowset.h"
+
+namespace doris {
+
+class Tablet;
+
+// A partial update of a merge-on-write unique key tablet only provides some of the columns,
+// the other columns of a key are filled with the values of its latest row, which are looked
+// up in the rowsets visible when the load starts, and looked up again when the load is
+// published for the keys changed by the loads published in between.
+struct PartialUpdateInfo {
+    std::shared_ptr<Tablet> tablet;
+    // ids of the columns not provided by the load, in ascending order
+    std::vector<uint32_t> missing_cids;
+    // the rowsets of `version`, sorted by version in descending order
+    std::vector<RowsetSharedPtr> rowsets;
+    int64_t version = 0;
+};
+
+} // namespace doris
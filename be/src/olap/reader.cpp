@@ -19,14 +19,18 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include <algorithm>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <charconv>
 #include <unordered_set>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "olap/bloom_filter_predicate.h"
 #include "olap/comparison_predicate.h"
 #include "olap/in_list_predicate.h"
+#include "olap/like_column_predicate.h"
+#include "olap/match_predicate.h"
 #include "olap/null_predicate.h"
 #include "olap/olap_common.h"
 #include "olap/row.h"
@@ -98,6 +102,9 @@ TabletReader::~TabletReader() {
     for (auto pred : _value_col_predicates) {
         delete pred;
     }
+    for (auto pred : _runtime_col_predicates) {
+        delete pred;
+    }
 }
 
 Status TabletReader::init(const ReaderParams& read_params) {
@@ -192,6 +199,10 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
             // duplicated keys are allowed, no need to merge sort keys in rowset
             need_ordered_result = false;
         }
+        if (_tablet->enable_unique_key_merge_on_write()) {
+            // overwritten rows are filtered by delete bitmap, keys are unique among rowsets
+            need_ordered_result = false;
+        }
         if (_aggregation) {
             // compute engine will aggregate rows with the same key,
             // it's ok for rowset to return unordered result
@@ -199,6 +210,20 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
         }
     }
 
+    // The blocks of segments are passed through only if the rows are neither merged nor
+    // aggregated by the reader, the dictionary columns can't be copied.
+    if (read_params.reader_type == READER_QUERY && !need_ordered_result &&
+        config::enable_low_cardinality_optimize &&
+        (read_params.direct_mode || _tablet->keys_type() == DUP_KEYS ||
+         _tablet->enable_unique_key_merge_on_write())) {
+        for (auto cid : read_params.dict_output_columns) {
+            FieldType type = _tablet->tablet_schema().column(cid).type();
+            if (type == OLAP_FIELD_TYPE_VARCHAR || type == OLAP_FIELD_TYPE_STRING) {
+                _dict_output_columns.insert(cid);
+            }
+        }
+    }
+
     _reader_context.reader_type = read_params.reader_type;
     _reader_context.tablet_schema = &_tablet->tablet_schema();
     _reader_context.need_ordered_result = need_ordered_result;
@@ -210,6 +235,7 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
     _reader_context.all_conditions = &_all_conditions;
     _reader_context.predicates = &_col_predicates;
     _reader_context.value_predicates = &_value_col_predicates;
+    _reader_context.runtime_predicates = &_runtime_col_predicates;
     _reader_context.lower_bound_keys = &_keys_param.start_keys;
     _reader_context.is_lower_keys_included = &_is_lower_keys_included;
     _reader_context.upper_bound_keys = &_keys_param.end_keys;
@@ -218,9 +244,31 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
     _reader_context.stats = &_stats;
     _reader_context.runtime_state = read_params.runtime_state;
     _reader_context.use_page_cache = read_params.use_page_cache;
+    _reader_context.fill_page_cache = read_params.fill_page_cache;
+    _reader_context.push_down_agg_type_opt = read_params.push_down_agg_type_opt;
     _reader_context.sequence_id_idx = _sequence_col_idx;
     _reader_context.batch_size = _batch_size;
     _reader_context.is_unique = tablet()->keys_type() == UNIQUE_KEYS;
+    _reader_context.version = read_params.version;
+    _reader_context.dict_output_columns = &_dict_output_columns;
+    if (_tablet->enable_unique_key_merge_on_write()) {
+        _reader_context.delete_bitmap = &_tablet->tablet_meta()->delete_bitmap();
+    }
+
+    if (read_params.reader_type == READER_QUERY) {
+        // the non-overlapping rowsets are read one by one, while the segments of an
+        // overlapping rowset are all merged
+        int64_t sorted_runs = 0;
+        for (auto& rs_reader : *rs_readers) {
+            auto rowset = rs_reader->rowset();
+            if (rowset->num_segments() > 0) {
+                sorted_runs += rowset->rowset_meta()->is_segments_overlapping()
+                                       ? rowset->num_segments()
+                                       : 1;
+            }
+        }
+        _tablet->record_read_amplification(sorted_runs);
+    }
 
     *valid_rs_readers = *rs_readers;
 
@@ -444,9 +492,13 @@ void TabletReader::_init_conditions_param(const ReaderParams& read_params) {
     for (const auto& condition : read_params.conditions) {
         ColumnPredicate* predicate = _parse_to_predicate(condition);
         if (predicate != nullptr) {
+            // value columns of merge-on-write tablets can be filtered in segments directly,
+            // because there is only one visible row for each key
             if (_tablet->tablet_schema()
-                        .column(_tablet->field_index(condition.column_name))
-                        .aggregation() != FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE) {
+                                .column(_tablet->field_index(condition.column_name))
+                                .aggregation() !=
+                        FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE &&
+                !_tablet->enable_unique_key_merge_on_write()) {
                 _value_col_predicates.push_back(predicate);
             } else {
                 _col_predicates.push_back(predicate);
@@ -462,6 +514,84 @@ void TabletReader::_init_conditions_param(const ReaderParams& read_params) {
     for (const auto& filter : read_params.bloom_filters) {
         _col_predicates.emplace_back(_parse_to_predicate(filter));
     }
+
+    // The LIKE predicates are evaluated by the scan node, only push down those which can
+    // be looked up by inverted indexes or n-gram bloom filter indexes, or evaluated on the
+    // dictionaries of the dict-encoded pages.
+    for (const auto& [column_name, pattern] : read_params.like_predicates) {
+        int32_t index = _tablet->field_index(column_name);
+        if (index < 0) {
+            continue;
+        }
+        const TabletColumn& column = _tablet->tablet_schema().column(index);
+        if (column.aggregation() != FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE &&
+            !_tablet->enable_unique_key_merge_on_write()) {
+            continue;
+        }
+        std::vector<std::string> words;
+        std::vector<std::string> substrings;
+        bool has_words = column.has_inverted_index() &&
+                         MatchPredicate::get_words_of_like_pattern(pattern, &words);
+        bool has_substrings = column.has_ngram_bf_index() &&
+                              MatchPredicate::get_substrings_of_like_pattern(pattern, &substrings);
+        if (has_words || has_substrings) {
+            _col_predicates.push_back(
+                    new MatchPredicate(index, std::move(words), std::move(substrings)));
+        }
+        // CHAR is not supported because of the padding zeros
+        if (config::enable_low_cardinality_optimize &&
+            (column.type() == OLAP_FIELD_TYPE_VARCHAR || column.type() == OLAP_FIELD_TYPE_STRING) &&
+            LikeColumnPredicate::is_supported_pattern(pattern)) {
+            _col_predicates.push_back(new LikeColumnPredicate(index, pattern));
+        }
+    }
+}
+
+bool TabletReader::_can_apply_runtime_predicate(int32_t index) const {
+    if (index < 0 || std::find(_return_columns.begin(), _return_columns.end(), (uint32_t)index) ==
+                             _return_columns.end()) {
+        return false;
+    }
+    // value columns have to be aggregated before filtered, see _init_conditions_param()
+    return _tablet->tablet_schema().column(index).aggregation() ==
+                   FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE ||
+           _tablet->enable_unique_key_merge_on_write();
+}
+
+void TabletReader::append_runtime_predicates(
+        const std::vector<TCondition>& conditions,
+        const std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>&
+                bloom_filters) {
+    for (const auto& condition : conditions) {
+        if (!_can_apply_runtime_predicate(_tablet->field_index(condition.column_name))) {
+            continue;
+        }
+        ColumnPredicate* predicate = _parse_to_predicate(condition);
+        if (predicate == nullptr) {
+            continue;
+        }
+        // the conditions are used by the segments to filter pages by zone maps and bloom
+        // filter indexes
+        Status status = _conditions.append_condition(condition);
+        if (!status.ok()) {
+            LOG(WARNING) << "failed to append runtime filter condition of column "
+                         << condition.column_name << ": " << status;
+            delete predicate;
+            continue;
+        }
+        status = _all_conditions.append_condition(condition);
+        DCHECK_EQ(Status::OK(), status);
+        _runtime_col_predicates.push_back(predicate);
+    }
+    for (const auto& filter : bloom_filters) {
+        if (!_can_apply_runtime_predicate(_tablet->field_index(filter.first))) {
+            continue;
+        }
+        ColumnPredicate* predicate = _parse_to_predicate(filter);
+        if (predicate != nullptr) {
+            _runtime_col_predicates.push_back(predicate);
+        }
+    }
 }
 
 #define COMPARISON_PREDICATE_CONDITION_VALUE(NAME, PREDICATE)                                      \
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/PlanNodes_types.h>
 #include <thrift/protocol/TDebugProtocol.h>
 
 #include "exprs/bloomfilter_predicate.h"
@@ -67,6 +68,10 @@ public:
         // 2. when read column index page
         //     if config::disable_storage_page_cache is false, we use page cache
         bool use_page_cache = false;
+        // false to read the cached pages without caching the others
+        bool fill_page_cache = true;
+        // see StorageReadOptions::push_down_agg_type_opt
+        TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
         Version version = Version(-1, 0);
 
         std::vector<OlapTuple> start_key;
@@ -76,6 +81,11 @@ public:
 
         std::vector<TCondition> conditions;
         std::vector<std::pair<string, std::shared_ptr<IBloomFilterFuncBase>>> bloom_filters;
+        // column name and LIKE pattern, only used by inverted indexes
+        std::vector<std::pair<std::string, std::string>> like_predicates;
+        // string columns which can be returned as dictionary columns, only the group by keys
+        // of the aggregation over the scan
+        std::set<uint32_t> dict_output_columns;
 
         // The ColumnData will be set when using Merger, eg Cumulative, BE.
         std::vector<RowsetReaderSharedPtr> rs_readers;
@@ -116,6 +126,15 @@ public:
         return Status::OLAPInternalError(OLAP_ERR_READER_INITIALIZE_ERROR);
     }
 
+    // Apply the runtime filters arriving after the reader is initialized, to the segments
+    // not read yet. Only the conditions and bloom filters on the key columns (or all the
+    // columns of merge-on-write tablets) which are returned are applied, the others are
+    // ignored.
+    void append_runtime_predicates(
+            const std::vector<TCondition>& conditions,
+            const std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>&
+                    bloom_filters);
+
     uint64_t merged_rows() const { return _merged_rows; }
 
     uint64_t filtered_rows() const {
@@ -164,6 +183,8 @@ protected:
 
     Status _init_delete_condition(const ReaderParams& read_params);
 
+    bool _can_apply_runtime_predicate(int32_t index) const;
+
     Status _init_return_columns(const ReaderParams& read_params);
     void _init_seek_columns();
 
@@ -176,6 +197,7 @@ protected:
     std::unique_ptr<MemPool> _predicate_mem_pool;
     std::set<uint32_t> _load_bf_columns;
     std::set<uint32_t> _load_bf_all_columns;
+    std::set<uint32_t> _dict_output_columns;
     std::vector<uint32_t> _return_columns;
     // only use in outer join which change the column nullable which must keep same in
     // vec query engine
@@ -194,6 +216,8 @@ protected:
     Conditions _all_conditions;
     std::vector<ColumnPredicate*> _col_predicates;
     std::vector<ColumnPredicate*> _value_col_predicates;
+    // predicates of the runtime filters appended after init
+    std::vector<ColumnPredicate*> _runtime_col_predicates;
     DeleteHandler _delete_handler;
 
     bool _aggregation = false;
@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/row_cache.h"
+
+namespace doris {
+
+RowCache* RowCache::_s_instance = nullptr;
+
+void RowCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity == 0) {
+        return;
+    }
+    static RowCache instance(capacity);
+    _s_instance = &instance;
+}
+
+RowCache::RowCache(size_t capacity) {
+    _cache.reset(new_lru_cache("RowCache", capacity, LRUCacheType::SIZE));
+}
+
+std::string RowCache::_key(const RowLocation& location) {
+    std::string key = location.rowset_id.to_string();
+    key.append(reinterpret_cast<const char*>(&location.segment_id), sizeof(uint32_t));
+    key.append(reinterpret_cast<const char*>(&location.row_id), sizeof(uint32_t));
+    return key;
+}
+
+std::shared_ptr<const vectorized::Block> RowCache::lookup(const RowLocation& location) {
+    auto handle = _cache->lookup(CacheKey(_key(location)));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto row = *reinterpret_cast<std::shared_ptr<const vectorized::Block>*>(
+            _cache->value(handle));
+    _cache->release(handle);
+    return row;
+}
+
+void RowCache::insert(const RowLocation& location, std::shared_ptr<const vectorized::Block> row) {
+    auto deleter = [](const doris::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const vectorized::Block>*>(value);
+    };
+    size_t charge = sizeof(vectorized::Block) + row->allocated_bytes();
+    auto handle = _cache->insert(CacheKey(_key(location)),
+                                 new std::shared_ptr<const vectorized::Block>(std::move(row)),
+                                 charge, deleter, CachePriority::NORMAL);
+    _cache->release(handle);
+}
+
+} // namespace doris
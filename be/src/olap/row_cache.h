@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "olap/lru_cache.h"
+#include "olap/olap_common.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+// RowCache caches the full rows read by the point queries on the primary keys of the
+// merge-on-write unique key tablets, each of them is a block of one row with all the columns
+// of the tablet schema. The entries are keyed by the locations of the rows, which are never
+// modified since the segments are immutable, so the entries are only evicted, never
+// invalidated: a row overwritten by a later load is located at another place.
+class RowCache {
+public:
+    // Caches nothing if capacity is 0.
+    static void create_global_instance(size_t capacity);
+
+    // nullptr if the cache is disabled or not created, e.g. in the tools.
+    static RowCache* instance() { return _s_instance; }
+
+    explicit RowCache(size_t capacity);
+
+    std::shared_ptr<const vectorized::Block> lookup(const RowLocation& location);
+    void insert(const RowLocation& location, std::shared_ptr<const vectorized::Block> row);
+
+private:
+    static std::string _key(const RowLocation& location);
+
+    static RowCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris
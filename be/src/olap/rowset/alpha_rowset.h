@@ -47,7 +47,8 @@ public:
 
     Status remove() override;
 
-    Status link_files_to(const std::string& dir, RowsetId new_rowset_id) override;
+    Status link_files_to(const std::string& dir, RowsetId new_rowset_id,
+                         size_t new_rowset_start_seg_id = 0) override;
 
     Status copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) override;
 
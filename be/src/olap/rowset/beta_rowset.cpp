@@ -27,8 +27,12 @@
 #include "gutil/strings/substitute.h"
 #include "io/fs/s3_file_system.h"
 #include "olap/olap_define.h"
+#include "olap/row_cursor.h"
 #include "olap/rowset/beta_rowset_reader.h"
+#include "olap/segment_loader.h"
+#include "olap/short_key_index.h"
 #include "olap/utils.h"
+#include "runtime/mem_pool.h"
 #include "util/doris_metrics.h"
 
 namespace doris {
@@ -97,7 +101,72 @@ Status BetaRowset::create_reader(RowsetReaderSharedPtr* result) {
 Status BetaRowset::split_range(const RowCursor& start_key, const RowCursor& end_key,
                                uint64_t request_block_row_count, size_t key_num,
                                std::vector<OlapTuple>* ranges) {
+    // Every short key in the short key index of a segment is the first key of a block of
+    // num_rows_per_row_block rows, so the short keys of all segments sorted together split
+    // the rows of this rowset into ranges of about request_block_row_count rows.
+    size_t num_short_keys = _schema->num_short_key_columns();
+    if (key_num > num_short_keys) {
+        // could not split on the short keys, scan the whole range
+        ranges->emplace_back(start_key.to_tuple());
+        ranges->emplace_back(end_key.to_tuple());
+        return Status::OK();
+    }
+    std::string lower_key;
+    std::string upper_key;
+    encode_key_with_padding(&lower_key, start_key, num_short_keys, true);
+    encode_key_with_padding(&upper_key, end_key, num_short_keys, false);
+
+    SegmentCacheHandle segment_cache_handle;
+    RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+            std::static_pointer_cast<BetaRowset>(shared_from_this()), &segment_cache_handle,
+            true));
+    std::vector<std::string> short_keys;
+    for (auto& segment : segment_cache_handle.get_segments()) {
+        RETURN_NOT_OK(segment->get_short_keys(lower_key, upper_key, &short_keys));
+    }
+    std::sort(short_keys.begin(), short_keys.end());
+
+    size_t step = std::max<size_t>(
+            1, request_block_row_count / std::max<size_t>(1, _schema->num_rows_per_row_block()));
+    // the split keys only have the first key_num columns as the scan keys
+    RowCursor split_key;
+    RETURN_NOT_OK(split_key.init(*_schema, key_num));
+    MemPool pool("BetaRowset::split_range");
+
     ranges->emplace_back(start_key.to_tuple());
+    std::string last_split_key = lower_key;
+    for (size_t i = step; i < short_keys.size(); i += step) {
+        // decode the short key as encode_key() encodes it
+        Slice encoded_key(short_keys[i]);
+        size_t cid = 0;
+        for (; cid < key_num && encoded_key.size > 0; ++cid) {
+            uint8_t marker = encoded_key.data[0];
+            encoded_key.remove_prefix(1);
+            if (marker == KEY_NULL_FIRST_MARKER) {
+                split_key.set_null(cid);
+                continue;
+            }
+            split_key.set_not_null(cid);
+            RETURN_NOT_OK(split_key.column_schema(cid)->decode_ascending(
+                    &encoded_key, reinterpret_cast<uint8_t*>(split_key.cell_ptr(cid)), &pool));
+        }
+        if (cid < key_num) {
+            // the short key is truncated inside the scan keys
+            continue;
+        }
+        // the split keys must be strictly inside the range and increasing,
+        // otherwise the rows equal to the start key may be returned for an exclusive range
+        std::string split_encoded_key;
+        encode_key(&split_encoded_key, split_key, key_num);
+        if (split_encoded_key <= last_split_key || split_encoded_key >= upper_key) {
+            continue;
+        }
+        last_split_key = std::move(split_encoded_key);
+        OlapTuple split_tuple = split_key.to_tuple();
+        // the end of the last range and the start of the next one
+        ranges->emplace_back(split_tuple);
+        ranges->emplace_back(split_tuple);
+    }
     ranges->emplace_back(end_key.to_tuple());
     return Status::OK();
 }
@@ -133,14 +202,15 @@ void BetaRowset::do_close() {
     // do nothing.
 }
 
-Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id) {
+Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id,
+                                 size_t new_rowset_start_seg_id) {
     DCHECK(is_local());
     auto fs = _rowset_meta->fs();
     if (!fs) {
         return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
     }
     for (int i = 0; i < num_segments(); ++i) {
-        auto dst_path = local_segment_path(dir, new_rowset_id, i);
+        auto dst_path = local_segment_path(dir, new_rowset_id, i + new_rowset_start_seg_id);
         // TODO(lingbin): use Env API? or EnvUtil?
         if (FileUtils::check_exist(dst_path)) {
             LOG(WARNING) << "failed to create hard link, file already exist: " << dst_path;
@@ -26,6 +26,7 @@
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/schema.h"
+#include "olap/tablet_meta.h"
 #include "vec/core/block.h"
 #include "vec/olap/vgeneric_iterators.h"
 
@@ -65,7 +66,14 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
         read_context->delete_handler->get_delete_conditions_after_version(
                 _rowset->end_version(), &read_options.delete_conditions,
                 read_options.delete_condition_predicates.get());
+        for (auto& del_cond : read_context->delete_handler->get_delete_conditions()) {
+            if (del_cond.filter_version > _rowset->end_version()) {
+                read_options.delete_condition_version =
+                        std::max(read_options.delete_condition_version, del_cond.filter_version);
+            }
+        }
     }
+    read_options.rowset_id = _rowset->rowset_id();
     if (read_context->predicates != nullptr) {
         read_options.column_predicates.insert(read_options.column_predicates.end(),
                                               read_context->predicates->begin(),
@@ -82,7 +90,22 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
             read_options.conditions = read_context->all_conditions;
         }
     }
+    read_options.runtime_predicates = read_context->runtime_predicates;
     read_options.use_page_cache = read_context->use_page_cache;
+    read_options.fill_page_cache = read_context->fill_page_cache;
+    read_options.push_down_agg_type_opt = read_context->push_down_agg_type_opt;
+    if (read_context->dict_output_columns != nullptr) {
+        read_options.dict_output_columns = *read_context->dict_output_columns;
+    }
+    if (read_context->delete_bitmap != nullptr) {
+        for (uint32_t seg_id = 0; seg_id < _rowset->num_segments(); ++seg_id) {
+            auto delete_bitmap = read_context->delete_bitmap->get_agg(
+                    {_rowset->rowset_id(), seg_id, read_context->version.second});
+            if (!delete_bitmap->isEmpty()) {
+                read_options.delete_bitmap.emplace(seg_id, std::move(delete_bitmap));
+            }
+        }
+    }
 
     // load segments
     RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
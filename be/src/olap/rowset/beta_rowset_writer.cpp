@@ -17,6 +17,7 @@
 
 #include "olap/rowset/beta_rowset_writer.h"
 
+#include <algorithm>
 #include <ctime> // time
 
 #include "common/config.h"
@@ -31,6 +32,7 @@
 #include "olap/row_cursor.h" // RowCursor
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/segment_v2/column_statistics.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
@@ -155,7 +157,23 @@ template Status BetaRowsetWriter::_add_row(const ContiguousRow& row);
 
 Status BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     assert(rowset->rowset_meta()->rowset_type() == BETA_ROWSET);
-    RETURN_NOT_OK(rowset->link_files_to(_context.tablet_path, _context.rowset_id));
+    // the segments of `rowset` are appended after the existing ones
+    RETURN_NOT_OK(rowset->link_files_to(_context.tablet_path, _context.rowset_id, _num_segment));
+    if (rowset->rowset_meta()->has_segments_key_bounds()) {
+        std::lock_guard<SpinLock> l(_lock);
+        for (int64_t i = 0; i < rowset->num_segments(); ++i) {
+            _segments_key_bounds.emplace(_num_segment + i,
+                                         rowset->rowset_meta()->segment_key_bounds(i));
+        }
+    }
+    if (!rowset->rowset_meta()->column_statistics().empty()) {
+        std::lock_guard<SpinLock> l(_lock);
+        for (const auto& statistics : rowset->rowset_meta()->column_statistics()) {
+            segment_v2::ColumnStatisticsCollector::merge(
+                    statistics, &_column_statistics[statistics.unique_id()]);
+        }
+        _num_segments_with_statistics += rowset->num_segments();
+    }
     _num_rows_written += rowset->num_rows();
     _total_data_size += rowset->rowset_meta()->data_disk_size();
     _total_index_size += rowset->rowset_meta()->index_disk_size();
@@ -185,11 +203,13 @@ Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flus
     // Create segment writer for each memtable, so that
     // all memtables can be flushed in parallel.
     std::unique_ptr<segment_v2::SegmentWriter> writer;
+    // if the segment id is reserved, all rows of the memtable go to that segment
+    int32_t segment_id = memtable->segment_id();
 
     MemTable::Iterator it(memtable);
     for (it.seek_to_first(); it.valid(); it.next()) {
         if (PREDICT_FALSE(writer == nullptr)) {
-            RETURN_NOT_OK(_create_segment_writer(&writer));
+            RETURN_NOT_OK(_create_segment_writer(&writer, nullptr, true, segment_id));
         }
         ContiguousRow dst_row = it.get_current_row();
         auto s = writer->append_row(dst_row);
@@ -198,8 +218,9 @@ Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flus
             return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
         }
 
-        if (PREDICT_FALSE(writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
-                          writer->num_rows_written() >= _context.max_rows_per_segment)) {
+        if (PREDICT_FALSE(segment_id < 0 &&
+                          (writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+                           writer->num_rows_written() >= _context.max_rows_per_segment))) {
             RETURN_NOT_OK(_flush_segment_writer(&writer));
         }
         ++_num_rows_written;
@@ -213,13 +234,26 @@ Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flus
     return Status::OK();
 }
 
-Status BetaRowsetWriter::flush_single_memtable(const vectorized::Block* block) {
+Status BetaRowsetWriter::flush_single_memtable(const vectorized::Block* block,
+                                               int32_t segment_id) {
     if (block->rows() == 0) {
         return Status::OK();
     }
     std::unique_ptr<segment_v2::SegmentWriter> writer;
-    RETURN_NOT_OK(_create_segment_writer(&writer));
-    RETURN_NOT_OK(_add_block(block, &writer));
+    if (segment_id < 0) {
+        RETURN_NOT_OK(_create_segment_writer(&writer));
+        RETURN_NOT_OK(_add_block(block, &writer));
+    } else {
+        // The segment id is reserved, so the memtable can not be split into more segments.
+        // Its size is bounded by write_buffer_size, so the segment is still reasonable.
+        RETURN_NOT_OK(_create_segment_writer(&writer, nullptr, true, segment_id));
+        auto s = writer->append_block(block, 0, block->rows());
+        if (UNLIKELY(!s.ok())) {
+            LOG(WARNING) << "failed to append block: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        _num_rows_written += block->rows();
+    }
     RETURN_NOT_OK(_flush_segment_writer(&writer));
     return Status::OK();
 }
@@ -240,9 +274,32 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     _rowset_meta->set_empty(_num_rows_written == 0);
     _rowset_meta->set_creation_time(time(nullptr));
     _rowset_meta->set_num_segments(_num_segment);
+    if (_segments_key_bounds.size() == static_cast<size_t>(_num_segment)) {
+        std::vector<KeyBoundsPB> segments_key_bounds;
+        for (auto& [segment_id, key_bounds] : _segments_key_bounds) {
+            segments_key_bounds.push_back(key_bounds);
+        }
+        _rowset_meta->set_segments_key_bounds(segments_key_bounds);
+    }
+    if (_num_segment > 0 && _num_segments_with_statistics == _num_segment) {
+        std::vector<segment_v2::ColumnStatisticsPB> column_statistics;
+        for (auto& [unique_id, statistics] : _column_statistics) {
+            column_statistics.push_back(statistics);
+        }
+        _rowset_meta->set_column_statistics(column_statistics);
+    }
     if (_num_segment <= 1) {
         _rowset_meta->set_segments_overlap(NONOVERLAPPING);
     }
+    if (_context.partial_update_info != nullptr) {
+        // the missing columns are checked again when the rowset is published
+        PartialUpdatePB partial_update;
+        for (auto cid : _context.partial_update_info->missing_cids) {
+            partial_update.add_missing_cids(cid);
+        }
+        partial_update.set_snapshot_version(_context.partial_update_info->version);
+        _rowset_meta->set_partial_update(partial_update);
+    }
     if (_is_pending) {
         _rowset_meta->set_rowset_state(COMMITTED);
     } else {
@@ -269,9 +326,13 @@ RowsetSharedPtr BetaRowsetWriter::build() {
 }
 
 Status BetaRowsetWriter::_create_segment_writer(
-        std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+        std::unique_ptr<segment_v2::SegmentWriter>* writer,
+        const std::vector<uint32_t>* column_ids, bool is_key, int32_t segment_id) {
+    if (segment_id < 0) {
+        segment_id = _num_segment++;
+    }
     auto path = BetaRowset::local_segment_path(_context.tablet_path, _context.rowset_id,
-                                               _num_segment++);
+                                               segment_id);
     auto fs = _rowset_meta->fs();
     if (!fs) {
         return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
@@ -286,7 +347,11 @@ Status BetaRowsetWriter::_create_segment_writer(
 
     DCHECK(file_writer != nullptr);
     segment_v2::SegmentWriterOptions writer_options;
-    writer->reset(new segment_v2::SegmentWriter(file_writer.get(), _num_segment,
+    writer_options.enable_unique_key_merge_on_write = _context.enable_unique_key_merge_on_write;
+    if (column_ids == nullptr) {
+        writer_options.partial_update_info = _context.partial_update_info;
+    }
+    writer->reset(new segment_v2::SegmentWriter(file_writer.get(), segment_id,
                                                 _context.tablet_schema, _context.data_dir,
                                                 _context.max_rows_per_segment, writer_options));
     {
@@ -294,7 +359,8 @@ Status BetaRowsetWriter::_create_segment_writer(
         _file_writers.push_back(std::move(file_writer));
     }
 
-    auto s = (*writer)->init(config::push_write_mbytes_per_sec);
+    auto s = column_ids == nullptr ? (*writer)->init(config::push_write_mbytes_per_sec)
+                                   : (*writer)->init(*column_ids, is_key);
     if (!s.ok()) {
         LOG(WARNING) << "failed to init segment writer: " << s.to_string();
         writer->reset(nullptr);
@@ -316,8 +382,34 @@ Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::Segme
     }
     _total_data_size += segment_size;
     _total_index_size += index_size;
+    _add_segment_key_bounds(**writer);
+    _add_segment_column_statistics(**writer);
     writer->reset();
     return Status::OK();
 }
 
+void BetaRowsetWriter::_add_segment_key_bounds(const segment_v2::SegmentWriter& writer) {
+    KeyBoundsPB key_bounds;
+    key_bounds.set_min_key(writer.min_encoded_key());
+    key_bounds.set_max_key(writer.max_encoded_key());
+    std::lock_guard<SpinLock> l(_lock);
+    _segments_key_bounds.emplace(writer.get_segment_id(), std::move(key_bounds));
+}
+
+void BetaRowsetWriter::_add_segment_column_statistics(const segment_v2::SegmentWriter& writer) {
+    const auto& columns = writer.footer().columns();
+    auto has_statistics = [](const segment_v2::ColumnMetaPB& column) {
+        return column.has_statistics();
+    };
+    if (columns.empty() || !std::all_of(columns.begin(), columns.end(), has_statistics)) {
+        return;
+    }
+    std::lock_guard<SpinLock> l(_lock);
+    for (const auto& column : columns) {
+        segment_v2::ColumnStatisticsCollector::merge(column.statistics(),
+                                                     &_column_statistics[column.unique_id()]);
+    }
+    ++_num_segments_with_statistics;
+}
+
 } // namespace doris
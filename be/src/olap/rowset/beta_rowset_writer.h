@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <map>
+
+#include "gen_cpp/segment_v2.pb.h"
 #include "olap/rowset/rowset_writer.h"
 
 namespace doris {
@@ -53,7 +56,9 @@ public:
     // Return the file size flushed to disk in "flush_size"
     // This method is thread-safe.
     Status flush_single_memtable(MemTable* memtable, int64_t* flush_size) override;
-    Status flush_single_memtable(const vectorized::Block* block) override;
+    Status flush_single_memtable(const vectorized::Block* block, int32_t segment_id = -1) override;
+
+    int32_t allocate_segment_id() override { return _num_segment++; }
 
     RowsetSharedPtr build() override;
 
@@ -65,17 +70,26 @@ public:
 
     RowsetTypePB type() const override { return RowsetTypePB::BETA_ROWSET; }
 
-private:
+protected:
     template <typename RowType>
     Status _add_row(const RowType& row);
     Status _add_block(const vectorized::Block* block,
                       std::unique_ptr<segment_v2::SegmentWriter>* writer);
 
-    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    // Create a segment writer for the columns in `column_ids`, or all columns if it is nullptr.
+    // A new segment id is allocated unless a reserved `segment_id` is given.
+    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                  const std::vector<uint32_t>* column_ids = nullptr,
+                                  bool is_key = true, int32_t segment_id = -1);
 
     Status _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
 
-private:
+    // record the key bounds of a flushed segment
+    void _add_segment_key_bounds(const segment_v2::SegmentWriter& writer);
+    // merge the column statistics of a finalized segment into the ones of the rowset
+    void _add_segment_column_statistics(const segment_v2::SegmentWriter& writer);
+
+protected:
     RowsetWriterContext _context;
     std::shared_ptr<RowsetMeta> _rowset_meta;
 
@@ -84,9 +98,15 @@ private:
     /// Because we want to flush memtables in parallel.
     /// In other processes, such as merger or schema change, we will use this unified writer for data writing.
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
-    mutable SpinLock _lock; // lock to protect _wblocks.
+    mutable SpinLock _lock; // lock to protect _wblocks and _segments_key_bounds.
     // TODO(lingbin): it is better to wrapper in a Batch?
     std::vector<std::unique_ptr<io::FileWriter>> _file_writers;
+    // key bounds of segments, segments may be flushed out of order
+    std::map<uint32_t, KeyBoundsPB> _segments_key_bounds;
+    // column statistics merged by the unique id of the column, they are saved in the rowset
+    // meta only if the statistics of all segments are merged
+    std::map<uint32_t, segment_v2::ColumnStatisticsPB> _column_statistics;
+    int64_t _num_segments_with_statistics = 0;
 
     // counters and statistics maintained during data write
     std::atomic<int64_t> _num_rows_written;
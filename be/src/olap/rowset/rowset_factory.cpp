@@ -25,6 +25,7 @@
 #include "olap/rowset/alpha_rowset_writer.h"
 #include "olap/rowset/beta_rowset_writer.h"
 #include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/vertical_beta_rowset_writer.h"
 
 namespace doris {
 
@@ -54,4 +55,16 @@ Status RowsetFactory::create_rowset_writer(const RowsetWriterContext& context,
     return Status::OLAPInternalError(OLAP_ERR_ROWSET_TYPE_NOT_FOUND);
 }
 
+Status RowsetFactory::create_rowset_writer(const RowsetWriterContext& context, bool is_vertical,
+                                           std::unique_ptr<RowsetWriter>* output) {
+    if (!is_vertical) {
+        return create_rowset_writer(context, output);
+    }
+    if (context.rowset_type != BETA_ROWSET) {
+        return Status::OLAPInternalError(OLAP_ERR_ROWSET_TYPE_NOT_FOUND);
+    }
+    output->reset(new VerticalBetaRowsetWriter);
+    return (*output)->init(context);
+}
+
 } // namespace doris
@@ -39,6 +39,11 @@ public:
     // return others if failed
     static Status create_rowset_writer(const RowsetWriterContext& context,
                                        std::unique_ptr<RowsetWriter>* output);
+
+    // create and init rowset writer, which writes the rowset column group by column group
+    // if `is_vertical` is true. Only beta rowset supports vertical writing.
+    static Status create_rowset_writer(const RowsetWriterContext& context, bool is_vertical,
+                                       std::unique_ptr<RowsetWriter>* output);
 };
 
 } // namespace doris
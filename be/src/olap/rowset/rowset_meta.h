@@ -244,6 +244,49 @@ public:
 
     void set_num_segments(int64_t num_segments) { _rowset_meta_pb.set_num_segments(num_segments); }
 
+    // key bounds are only recorded by the writers of this version, so old rowsets
+    // may not have them
+    bool has_segments_key_bounds() const {
+        return num_segments() > 0 && _rowset_meta_pb.segments_key_bounds_size() == num_segments();
+    }
+
+    const KeyBoundsPB& segment_key_bounds(int64_t segment_id) const {
+        return _rowset_meta_pb.segments_key_bounds(segment_id);
+    }
+
+    void set_segments_key_bounds(const std::vector<KeyBoundsPB>& segments_key_bounds) {
+        _rowset_meta_pb.clear_segments_key_bounds();
+        for (const auto& key_bounds : segments_key_bounds) {
+            *_rowset_meta_pb.add_segments_key_bounds() = key_bounds;
+        }
+    }
+
+    void add_segment_key_bounds(const KeyBoundsPB& key_bounds) {
+        *_rowset_meta_pb.add_segments_key_bounds() = key_bounds;
+    }
+
+    bool has_partial_update() const { return _rowset_meta_pb.has_partial_update(); }
+
+    const PartialUpdatePB& partial_update() const { return _rowset_meta_pb.partial_update(); }
+
+    void set_partial_update(const PartialUpdatePB& partial_update) {
+        *_rowset_meta_pb.mutable_partial_update() = partial_update;
+    }
+
+    // column statistics are only collected by the writers of this version, so old rowsets
+    // may not have them
+    const google::protobuf::RepeatedPtrField<segment_v2::ColumnStatisticsPB>& column_statistics()
+            const {
+        return _rowset_meta_pb.column_statistics();
+    }
+
+    void set_column_statistics(const std::vector<segment_v2::ColumnStatisticsPB>& statistics) {
+        _rowset_meta_pb.clear_column_statistics();
+        for (const auto& column_statistics : statistics) {
+            *_rowset_meta_pb.add_column_statistics() = column_statistics;
+        }
+    }
+
     void to_rowset_pb(RowsetMetaPB* rs_meta_pb) const { *rs_meta_pb = _rowset_meta_pb; }
     const RowsetMetaPB& get_rowset_pb() { return _rowset_meta_pb; }
 
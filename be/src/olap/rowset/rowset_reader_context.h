@@ -18,6 +18,7 @@
 #ifndef DORIS_BE_SRC_OLAP_ROWSET_ROWSET_READER_CONTEXT_H
 #define DORIS_BE_SRC_OLAP_ROWSET_ROWSET_READER_CONTEXT_H
 
+#include "gen_cpp/PlanNodes_types.h"
 #include "olap/column_predicate.h"
 #include "olap/olap_common.h"
 #include "runtime/runtime_state.h"
@@ -26,6 +27,7 @@ namespace doris {
 
 class RowCursor;
 class Conditions;
+class DeleteBitmap;
 class DeleteHandler;
 class TabletSchema;
 
@@ -52,6 +54,9 @@ struct RowsetReaderContext {
     const std::vector<ColumnPredicate*>* predicates = nullptr;
     // value column predicate in UNIQUE table
     const std::vector<ColumnPredicate*>* value_predicates = nullptr;
+    // predicates of the runtime filters arriving after the reader is created, they grow
+    // while reading and are applied by the segments not read yet
+    const std::vector<ColumnPredicate*>* runtime_predicates = nullptr;
     const std::vector<RowCursor>* lower_bound_keys = nullptr;
     const std::vector<bool>* is_lower_keys_included = nullptr;
     const std::vector<RowCursor>* upper_bound_keys = nullptr;
@@ -60,10 +65,18 @@ struct RowsetReaderContext {
     OlapReaderStatistics* stats = nullptr;
     RuntimeState* runtime_state = nullptr;
     bool use_page_cache = false;
+    bool fill_page_cache = true;
+    TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
     int sequence_id_idx = -1;
     int batch_size = 1024;
     bool is_vec = false;
     bool is_unique = false;
+    // the version to read, rows deleted by loads after it are still visible
+    Version version {-1, 0};
+    // not null only for unique key tablets with merge-on-write enabled
+    const DeleteBitmap* delete_bitmap = nullptr;
+    // string columns which can be returned as dictionary columns
+    const std::set<uint32_t>* dict_output_columns = nullptr;
 };
 
 } // namespace doris
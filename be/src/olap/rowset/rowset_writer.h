@@ -60,10 +60,18 @@ public:
     virtual Status flush_single_memtable(MemTable* memtable, int64_t* flush_size) {
         return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
     }
-    virtual Status flush_single_memtable(const vectorized::Block* block) {
+    // If `segment_id` is not -1, it is a segment id reserved by allocate_segment_id(),
+    // and the whole block is written into that single segment.
+    virtual Status flush_single_memtable(const vectorized::Block* block,
+                                         int32_t segment_id = -1) {
         return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
     }
 
+    // Reserve the id of the next segment. Memtables of one tablet may be flushed concurrently,
+    // reserving the id when a memtable is submitted keeps segments in load order, which the
+    // unique key model relies on. Return -1 if the writer does not support it.
+    virtual int32_t allocate_segment_id() { return -1; }
+
     // finish building and return pointer to the built rowset (guaranteed to be inited).
     // return nullptr when failed
     virtual RowsetSharedPtr build() = 0;
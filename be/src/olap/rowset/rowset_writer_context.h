@@ -19,6 +19,7 @@
 
 #include "gen_cpp/olap_file.pb.h"
 #include "olap/data_dir.h"
+#include "olap/partial_update_info.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
 #include "olap/tablet_schema.h"
@@ -60,6 +61,7 @@ struct RowsetWriterContext {
         context.rowset_state = VISIBLE;
         context.version = version;
         context.segments_overlap = segments_overlap;
+        context.enable_unique_key_merge_on_write = new_tablet->enable_unique_key_merge_on_write();
 
         return context;
     }
@@ -96,6 +98,10 @@ struct RowsetWriterContext {
 
     int64_t oldest_write_timestamp;
     int64_t newest_write_timestamp;
+    // build primary key index in segments, see TabletMeta::enable_unique_key_merge_on_write
+    bool enable_unique_key_merge_on_write = false;
+    // set for a partial update of a merge-on-write tablet
+    std::shared_ptr<PartialUpdateInfo> partial_update_info;
 };
 
 } // namespace doris
@@ -0,0 +1,417 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "gutil/port.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "olap/rowset/segment_v2/page_builder.h"
+#include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/types.h"
+#include "util/bit_packing.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// ALP (Adaptive Lossless floating-Point) encoding for FLOAT/DOUBLE columns, see
+// "ALP: Adaptive Lossless floating-Point Compression" (SIGMOD 2024).
+//
+// Floating point values written from decimals with few significant digits, like most metrics,
+// are turned into integers by v * 10^e / 10^f, the integers are then encoded by
+// frame-of-reference and bit-packing. The exponent e and the factor f are chosen per page
+// from a sample of its values. The values which don't convert back to exactly the same bits
+// (NaN, -0.0, values with too many digits...) are stored as exceptions.
+//
+// The format of a page is:
+//
+//   NumValues: uint32
+//   Mode: uint8, ALP_PAGE_MODE_RAW or ALP_PAGE_MODE_ENCODED
+//   if Mode is ALP_PAGE_MODE_RAW, the values are not worth converting:
+//     Values: the raw values
+//   if Mode is ALP_PAGE_MODE_ENCODED:
+//     Exponent: uint8
+//     Factor: uint8
+//     Base: uint64, the minimum converted integer
+//     BitWidth: uint8
+//     Values: (integer - Base) of each value bit-packed with BitWidth bits, 0 for exceptions
+//     NumExceptions: uint32
+//     ExceptionPositions: uint32 * NumExceptions
+//     ExceptionValues: the raw values of the exceptions
+//   Padding: BitPacking::PADDING_BYTES zero bytes
+enum {
+    ALP_PAGE_MODE_RAW = 0,
+    ALP_PAGE_MODE_ENCODED = 1,
+    ALP_PAGE_HEADER_SIZE = 5,
+    ALP_ENCODED_HEADER_SIZE = 11,
+    // the number of values to choose the exponent and the factor from
+    ALP_SAMPLE_SIZE = 256,
+    ALP_DECODE_BATCH_SIZE = 1024,
+};
+
+template <typename CppType>
+struct AlpTraits {
+    static_assert(std::is_floating_point<CppType>::value, "ALP only supports float and double");
+    // the maximum exponent, beyond which the converted integers of the type lose precision
+    static constexpr int MAX_EXPONENT = std::is_same<CppType, float>::value ? 10 : 18;
+
+    static double power_of_ten(int n) {
+        static constexpr double POWERS[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,
+                                            1e7,  1e8,  1e9,  1e10, 1e11, 1e12, 1e13,
+                                            1e14, 1e15, 1e16, 1e17, 1e18};
+        return POWERS[n];
+    }
+
+    // Convert v to an integer with exponent e and factor f, return false if it's out of the
+    // range of the integers which are exactly representable.
+    static bool encode(CppType v, int e, int f, int64_t* out) {
+        double scaled = static_cast<double>(v) * power_of_ten(e) / power_of_ten(f);
+        // also false for NaN
+        if (!(std::abs(scaled) < static_cast<double>(1LL << 52))) {
+            return false;
+        }
+        *out = static_cast<int64_t>(scaled + (scaled >= 0 ? 0.5 : -0.5));
+        return true;
+    }
+
+    // Only a multiplication and a division, which a compiler never fuses, so the decoding is
+    // exactly the same in the writer and in the reader.
+    static CppType decode(int64_t v, int e, int f) {
+        return static_cast<CppType>(static_cast<double>(v) * power_of_ten(f) / power_of_ten(e));
+    }
+
+    static bool same_bits(CppType l, CppType r) { return memcmp(&l, &r, sizeof(CppType)) == 0; }
+};
+
+template <FieldType Type>
+class AlpPageBuilder : public PageBuilder {
+public:
+    explicit AlpPageBuilder(const PageBuilderOptions& options)
+            : _options(options), _finished(false) {
+        reset();
+    }
+
+    bool is_page_full() override { return _values.size() >= _capacity; }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min(*count, _capacity - std::min(_capacity, _values.size()));
+        size_t orig_size = _values.size();
+        _values.resize(orig_size + to_add);
+        memcpy(&_values[orig_size], vals, to_add * SIZE_OF_TYPE);
+        *count = to_add;
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _buffer.clear();
+        put_fixed32_le(&_buffer, _values.size());
+        int exponent = 0;
+        int factor = 0;
+        if (_values.empty() || !_choose_exponent(&exponent, &factor)) {
+            _buffer.push_back(static_cast<char>(ALP_PAGE_MODE_RAW));
+            _buffer.append(_values.data(), _values.size() * SIZE_OF_TYPE);
+        } else {
+            _encode(exponent, factor);
+        }
+        _buffer.resize(_buffer.size() + BitPacking::PADDING_BYTES);
+        memset(_buffer.data() + _buffer.size() - BitPacking::PADDING_BYTES, 0,
+               BitPacking::PADDING_BYTES);
+        return _buffer.build();
+    }
+
+    void reset() override {
+        _values.clear();
+        _capacity = std::max<size_t>(1, _options.data_page_size / SIZE_OF_TYPE);
+        _values.reserve(_capacity);
+        _buffer.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _values.size() * SIZE_OF_TYPE; }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using Traits = AlpTraits<CppType>;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    // Choose the exponent and the factor which take the least bits for the sampled values,
+    // return false if the raw values are smaller.
+    bool _choose_exponent(int* exponent, int* factor) const {
+        size_t step = std::max<size_t>(1, _values.size() / ALP_SAMPLE_SIZE);
+        std::vector<CppType> samples;
+        for (size_t i = 0; i < _values.size(); i += step) {
+            samples.push_back(_values[i]);
+        }
+        const uint64_t exception_bits = SIZE_OF_TYPE * 8 + 32;
+        uint64_t best_bits = samples.size() * SIZE_OF_TYPE * 8;
+        bool found = false;
+        for (int e = Traits::MAX_EXPONENT; e >= 0; --e) {
+            for (int f = e; f >= 0; --f) {
+                int64_t min = std::numeric_limits<int64_t>::max();
+                int64_t max = std::numeric_limits<int64_t>::min();
+                uint64_t num_exceptions = 0;
+                for (CppType v : samples) {
+                    int64_t encoded;
+                    if (Traits::encode(v, e, f, &encoded) &&
+                        Traits::same_bits(Traits::decode(encoded, e, f), v)) {
+                        min = std::min(min, encoded);
+                        max = std::max(max, encoded);
+                    } else {
+                        ++num_exceptions;
+                    }
+                }
+                int width = min > max ? 0 : BitPacking::bit_width(uint64_t(max) - uint64_t(min));
+                uint64_t bits = samples.size() * width + num_exceptions * exception_bits;
+                // prefer the smaller exponent and factor on ties, they have less exceptions
+                // for the values beyond the sample
+                if (bits <= best_bits) {
+                    best_bits = bits;
+                    *exponent = e;
+                    *factor = f;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    void _encode(int exponent, int factor) {
+        const size_t num = _values.size();
+        std::vector<uint64_t> encoded(num);
+        std::vector<uint32_t> exception_positions;
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        for (size_t i = 0; i < num; ++i) {
+            int64_t v;
+            if (Traits::encode(_values[i], exponent, factor, &v) &&
+                Traits::same_bits(Traits::decode(v, exponent, factor), _values[i])) {
+                encoded[i] = v;
+                min = std::min(min, v);
+                max = std::max(max, v);
+            } else {
+                exception_positions.push_back(i);
+            }
+        }
+        if (min > max) {
+            min = max = 0;
+        }
+        for (size_t i = 0, j = 0; i < num; ++i) {
+            if (j < exception_positions.size() && exception_positions[j] == i) {
+                encoded[i] = 0;
+                ++j;
+            } else {
+                encoded[i] -= uint64_t(min);
+            }
+        }
+        int width = BitPacking::bit_width(uint64_t(max) - uint64_t(min));
+        _buffer.push_back(static_cast<char>(ALP_PAGE_MODE_ENCODED));
+        _buffer.push_back(static_cast<char>(exponent));
+        _buffer.push_back(static_cast<char>(factor));
+        put_fixed64_le(&_buffer, uint64_t(min));
+        _buffer.push_back(static_cast<char>(width));
+        BitPacking::pack(encoded.data(), num, width, &_buffer);
+        put_fixed32_le(&_buffer, exception_positions.size());
+        for (uint32_t pos : exception_positions) {
+            put_fixed32_le(&_buffer, pos);
+        }
+        for (uint32_t pos : exception_positions) {
+            _buffer.append(&_values[pos], SIZE_OF_TYPE);
+        }
+    }
+
+    PageBuilderOptions _options;
+    bool _finished;
+    size_t _capacity;
+    std::vector<CppType> _values;
+    faststring _buffer;
+};
+
+template <FieldType Type>
+class AlpPageDecoder : public PageDecoder {
+public:
+    AlpPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _parsed(false), _num_elements(0), _cur_index(0) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < ALP_PAGE_HEADER_SIZE + BitPacking::PADDING_BYTES) {
+            return Status::Corruption(fmt::format("alp page is too small: {}", _data.size));
+        }
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(_data.data);
+        const uint8_t* end = ptr + _data.size - BitPacking::PADDING_BYTES;
+        _num_elements = decode_fixed32_le(ptr);
+        int mode = ptr[4];
+        ptr += ALP_PAGE_HEADER_SIZE;
+        _values.reset(new CppType[std::max<size_t>(1, _num_elements)]);
+        if (mode == ALP_PAGE_MODE_RAW) {
+            if (PREDICT_FALSE(size_t(end - ptr) != _num_elements * SIZE_OF_TYPE)) {
+                return Status::Corruption("alp page is truncated");
+            }
+            memcpy(_values.get(), ptr, _num_elements * SIZE_OF_TYPE);
+        } else if (mode == ALP_PAGE_MODE_ENCODED) {
+            RETURN_IF_ERROR(_decode(ptr, end));
+        } else {
+            return Status::Corruption(fmt::format("invalid alp page mode: {}", mode));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init()";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override { return next_batch<true>(n, dst); }
+
+    template <bool forward_index>
+    Status next_batch(size_t* n, ColumnBlockView* dst) {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        memcpy(dst->data(), &_values[_cur_index], max_fetch * SIZE_OF_TYPE);
+        *n = max_fetch;
+        if (forward_index) {
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        dst->insert_many_fix_len_data(reinterpret_cast<const char*>(&_values[_cur_index]),
+                                      max_fetch);
+        *n = max_fetch;
+        _cur_index += max_fetch;
+        return Status::OK();
+    }
+
+    Status peek_next_batch(size_t* n, ColumnBlockView* dst) override {
+        return next_batch<false>(n, dst);
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using Traits = AlpTraits<CppType>;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    Status _decode(const uint8_t* ptr, const uint8_t* end) {
+        if (PREDICT_FALSE(end - ptr < ALP_ENCODED_HEADER_SIZE)) {
+            return Status::Corruption("alp page is truncated");
+        }
+        int exponent = ptr[0];
+        int factor = ptr[1];
+        uint64_t base = decode_fixed64_le(ptr + 2);
+        int width = ptr[10];
+        ptr += ALP_ENCODED_HEADER_SIZE;
+        if (PREDICT_FALSE(exponent > Traits::MAX_EXPONENT || factor > exponent || width > 64)) {
+            return Status::Corruption(fmt::format("invalid alp exponent {}, factor {}, width {}",
+                                                  exponent, factor, width));
+        }
+        size_t packed_bytes = BitPacking::packed_bytes(_num_elements, width);
+        if (PREDICT_FALSE(size_t(end - ptr) < packed_bytes + sizeof(uint32_t))) {
+            return Status::Corruption("alp page is truncated");
+        }
+        const uint8_t* packed = ptr;
+        ptr += packed_bytes;
+        uint32_t num_exceptions = decode_fixed32_le(ptr);
+        ptr += sizeof(uint32_t);
+        if (PREDICT_FALSE(uint64_t(end - ptr) !=
+                          uint64_t(num_exceptions) * (sizeof(uint32_t) + SIZE_OF_TYPE))) {
+            return Status::Corruption("alp page is truncated");
+        }
+
+        // the decoding loop has no branch so that it's vectorized
+        uint64_t buf[ALP_DECODE_BATCH_SIZE];
+        for (size_t start = 0; start < _num_elements; start += ALP_DECODE_BATCH_SIZE) {
+            size_t num = std::min<size_t>(ALP_DECODE_BATCH_SIZE, _num_elements - start);
+            BitPacking::unpack(packed, start, num, width, buf);
+            CppType* out = &_values[start];
+            for (size_t i = 0; i < num; ++i) {
+                out[i] = Traits::decode(static_cast<int64_t>(buf[i] + base), exponent, factor);
+            }
+        }
+        const uint8_t* exception_values = ptr + num_exceptions * sizeof(uint32_t);
+        for (uint32_t i = 0; i < num_exceptions; ++i) {
+            uint32_t pos = decode_fixed32_le(ptr + i * sizeof(uint32_t));
+            if (PREDICT_FALSE(pos >= _num_elements)) {
+                return Status::Corruption(fmt::format("invalid alp exception position {}", pos));
+            }
+            memcpy(&_values[pos], exception_values + i * SIZE_OF_TYPE, SIZE_OF_TYPE);
+        }
+        return Status::OK();
+    }
+
+    Slice _data;
+    bool _parsed;
+    size_t _num_elements;
+    size_t _cur_index;
+    // the page is decoded entirely in init(), so that seeking is O(1)
+    std::unique_ptr<CppType[]> _values;
+};
+
+} // namespace segment_v2
+} // namespace doris
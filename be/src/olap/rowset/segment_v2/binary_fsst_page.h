@@ -0,0 +1,327 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// FSST compressed page encoding for strings.
+//
+// Each value is compressed separately with a symbol table built from the values of the page,
+// so values can still be decompressed individually.
+//
+// The page consists of:
+// SymbolTable:
+//   the serialized FsstSymbolTable
+// Values:
+//   compressed values
+// Trailer
+//  Offsets:
+//    (num_elems + 1) offsets pointing to the beginning of each compressed value and the end of
+//    the last one, relative to the start of the page
+//  num_elems (32-bit fixed)
+//
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "olap/rowset/segment_v2/page_builder.h"
+#include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/types.h"
+#include "runtime/mem_pool.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/fsst.h"
+#include "vec/columns/column_complex.h"
+#include "vec/columns/column_nullable.h"
+
+namespace doris {
+namespace segment_v2 {
+
+class BinaryFsstPageBuilder : public PageBuilder {
+public:
+    // the symbol table is built from at most this many bytes of the values
+    static constexpr size_t MAX_SAMPLE_BYTES = 16 * 1024;
+
+    BinaryFsstPageBuilder(const PageBuilderOptions& options) : _options(options) { reset(); }
+
+    bool is_page_full() override {
+        // data_page_size is 0, do not limit the page size
+        return _options.data_page_size != 0 && _size_estimate > _options.data_page_size;
+    }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        DCHECK_GT(*count, 0);
+        size_t i = 0;
+        while (!is_page_full() && i < *count) {
+            auto src = reinterpret_cast<const Slice*>(vals);
+            _offsets.push_back(_buffer.size());
+            _buffer.append(src->data, src->size);
+            // it's not known how much the values compress before the page is finished,
+            // so the page is cut by the raw size like BinaryPlainPageBuilder
+            _size_estimate += src->size + sizeof(uint32_t);
+            i++;
+            vals += sizeof(Slice);
+        }
+        *count = i;
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _offsets.push_back(_buffer.size());
+        size_t num = _offsets.size() - 1;
+
+        std::vector<Slice> samples;
+        size_t sample_bytes = 0;
+        // take the values evenly over the page
+        size_t step = std::max<size_t>(1, _buffer.size() / MAX_SAMPLE_BYTES);
+        for (size_t i = 0; i < num && sample_bytes < MAX_SAMPLE_BYTES; i += step) {
+            samples.push_back(_value_at(i));
+            sample_bytes += samples.back().size;
+        }
+        FsstSymbolTable table;
+        table.build(samples);
+
+        faststring page;
+        page.reserve(_buffer.size() + (num + 2) * sizeof(uint32_t));
+        table.serialize(&page);
+        std::vector<uint32_t> offsets;
+        offsets.reserve(num + 1);
+        for (size_t i = 0; i < num; ++i) {
+            offsets.push_back(page.size());
+            table.compress(_value_at(i), &page);
+        }
+        offsets.push_back(page.size());
+        for (uint32_t offset : offsets) {
+            put_fixed32_le(&page, offset);
+        }
+        put_fixed32_le(&page, num);
+        if (num > 0) {
+            Slice first = _value_at(0);
+            Slice last = _value_at(num - 1);
+            _first_value.assign_copy(reinterpret_cast<const uint8_t*>(first.data), first.size);
+            _last_value.assign_copy(reinterpret_cast<const uint8_t*>(last.data), last.size);
+        }
+        return page.build();
+    }
+
+    void reset() override {
+        _offsets.clear();
+        _buffer.clear();
+        _buffer.reserve(_options.data_page_size == 0 ? 1024 : _options.data_page_size);
+        _size_estimate = sizeof(uint32_t);
+        _finished = false;
+    }
+
+    size_t count() const override { return _finished ? _offsets.size() - 1 : _offsets.size(); }
+
+    uint64_t size() const override { return _size_estimate; }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (count() == 0) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = Slice(_first_value);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (count() == 0) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = Slice(_last_value);
+        return Status::OK();
+    }
+
+private:
+    // only valid after the end offset is appended in finish()
+    Slice _value_at(size_t idx) const {
+        return Slice(&_buffer[_offsets[idx]], _offsets[idx + 1] - _offsets[idx]);
+    }
+
+    PageBuilderOptions _options;
+    // raw values
+    faststring _buffer;
+    std::vector<uint32_t> _offsets;
+    size_t _size_estimate;
+    bool _finished;
+    faststring _first_value;
+    faststring _last_value;
+};
+
+class BinaryFsstPageDecoder : public PageDecoder {
+public:
+    BinaryFsstPageDecoder(Slice data) : BinaryFsstPageDecoder(data, PageDecoderOptions()) {}
+
+    BinaryFsstPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _options(options) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < sizeof(uint32_t)) {
+            return Status::Corruption(strings::Substitute(
+                    "not enough bytes for trailer in BinaryFsstPageDecoder, size: $0",
+                    _data.size));
+        }
+        _num_elems = decode_fixed32_le((const uint8_t*)&_data[_data.size - sizeof(uint32_t)]);
+        if (_data.size < (uint64_t(_num_elems) + 2) * sizeof(uint32_t)) {
+            return Status::Corruption(strings::Substitute(
+                    "not enough bytes for $0 offsets in BinaryFsstPageDecoder, size: $1",
+                    _num_elems, _data.size));
+        }
+        _offsets_pos = _data.size - (_num_elems + 2) * sizeof(uint32_t);
+        size_t table_size = 0;
+        RETURN_IF_ERROR(_table.deserialize(Slice(_data.data, _offsets_pos), &table_size));
+        if (_offset(0) != table_size || _offset(_num_elems) != _offsets_pos) {
+            return Status::Corruption(strings::Substitute(
+                    "invalid offsets in BinaryFsstPageDecoder, begin: $0, end: $1",
+                    _offset(0), _offset(_num_elems)));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_idx >= _num_elems)) {
+            *n = 0;
+            return Status::OK();
+        }
+        const size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elems - _cur_idx));
+        _decompress(_cur_idx, max_fetch);
+
+        char* destination = (char*)dst->column_block()->pool()->allocate(_values.size());
+        if (destination == nullptr) {
+            return Status::MemoryAllocFailed(
+                    strings::Substitute("memory allocate failed, size:$0", _values.size()));
+        }
+        memcpy(destination, _values.data(), _values.size());
+        Slice* out = reinterpret_cast<Slice*>(dst->data());
+        for (size_t i = 0; i < max_fetch; ++i, ++out) {
+            *out = Slice(destination + _value_offsets[i], _value_lens[i]);
+        }
+        _cur_idx += max_fetch;
+        *n = max_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_idx >= _num_elems)) {
+            *n = 0;
+            return Status::OK();
+        }
+        const size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elems - _cur_idx));
+        _decompress(_cur_idx, max_fetch);
+        dst->insert_many_binary_data((char*)_values.data(), _value_lens.data(),
+                                     _value_offsets.data(), max_fetch);
+        _cur_idx += max_fetch;
+        *n = max_fetch;
+        return Status::OK();
+    }
+
+    size_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    size_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+    // Compress 'value' with the symbol table of this page, to be compared with
+    // compressed_equals().
+    void compress_value(const Slice& value, faststring* compressed) const {
+        compressed->clear();
+        _table.compress(value, compressed);
+    }
+
+    // Whether the value at 'idx' equals the value compressed by compress_value(), without
+    // decompressing it.
+    bool compressed_equals(size_t idx, const faststring& compressed) const {
+        Slice value = _compressed_at(idx);
+        return value.size == compressed.size() &&
+               memcmp(value.data, compressed.data(), value.size) == 0;
+    }
+
+    // Whether the value at 'idx' starts with 'prefix', only the bytes for the prefix are
+    // decompressed.
+    bool starts_with(size_t idx, const Slice& prefix) {
+        _prefix_buffer.resize(prefix.size + FsstSymbolTable::MAX_SYMBOL_LENGTH);
+        size_t size = _table.decompress_prefix(_compressed_at(idx), prefix.size,
+                                               _prefix_buffer.data());
+        return size >= prefix.size && memcmp(_prefix_buffer.data(), prefix.data, prefix.size) == 0;
+    }
+
+private:
+    uint32_t _offset(size_t idx) const {
+        return decode_fixed32_le((const uint8_t*)&_data[_offsets_pos + idx * sizeof(uint32_t)]);
+    }
+
+    Slice _compressed_at(size_t idx) const {
+        uint32_t begin = _offset(idx);
+        return Slice(&_data[begin], _offset(idx + 1) - begin);
+    }
+
+    // decompress values [start, start + num) into _values
+    void _decompress(size_t start, size_t num) {
+        size_t compressed_size = _offset(start + num) - _offset(start);
+        _values.resize(FsstSymbolTable::max_decompressed_size(compressed_size));
+        _value_lens.resize(num);
+        _value_offsets.resize(num);
+        size_t pos = 0;
+        for (size_t i = 0; i < num; ++i) {
+            size_t len = _table.decompress(_compressed_at(start + i), _values.data() + pos);
+            _value_offsets[i] = pos;
+            _value_lens[i] = len;
+            pos += len;
+        }
+        _values.resize(pos);
+    }
+
+    Slice _data;
+    PageDecoderOptions _options;
+    bool _parsed = false;
+    uint32_t _num_elems = 0;
+    uint32_t _offsets_pos = 0;
+    // Index of the currently seeked element in the page.
+    uint32_t _cur_idx = 0;
+    FsstSymbolTable _table;
+
+    // decompressed values of the last batch
+    faststring _values;
+    std::vector<uint32_t> _value_lens;
+    std::vector<uint32_t> _value_offsets;
+    faststring _prefix_buffer;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -30,6 +30,15 @@
 namespace doris {
 namespace segment_v2 {
 
+// Call `fn` with each substring of `gram_size` bytes of `data`, which are added to
+// n-gram bloom filters.
+template <typename Fn>
+void for_each_ngram(const char* data, size_t len, size_t gram_size, Fn&& fn) {
+    for (size_t i = 0; i + gram_size <= len; ++i) {
+        fn(data + i, gram_size);
+    }
+}
+
 struct BloomFilterOptions {
     // false positive probability
     double fpp = 0.05;
@@ -19,6 +19,8 @@
 
 #include <map>
 #include <roaring/roaring.hh>
+#include <string>
+#include <unordered_set>
 
 #include "olap/rowset/segment_v2/bloom_filter.h" // for BloomFilterOptions, BloomFilter
 #include "olap/rowset/segment_v2/common.h"
@@ -168,6 +170,83 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// Builder for n-gram bloom filter, which builds a bloom filter of the grams of the values
+// by every data page, so the pages not containing a substring can be skipped.
+class NgramBloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
+public:
+    NgramBloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options, uint32_t gram_size)
+            : _bf_options(bf_options), _gram_size(gram_size) {}
+
+    ~NgramBloomFilterIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const Slice* v = (const Slice*)values;
+        for (int i = 0; i < count; ++i) {
+            for_each_ngram(v->data, v->size, _gram_size, [this](const char* gram, size_t len) {
+                if (_grams.emplace(gram, len).second) {
+                    _grams_size += len;
+                }
+            });
+            ++v;
+        }
+    }
+
+    void add_nulls(uint32_t count) override { _has_null = true; }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_grams.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (auto& gram : _grams) {
+            bf->add_bytes(gram.data(), gram.size());
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _grams.clear();
+        _grams_size = 0;
+        _has_null = false;
+        return Status::OK();
+    }
+
+    Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) override {
+        if (_grams.size() > 0) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_size(_gram_size);
+
+        const auto* bf_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = PLAIN_ENCODING;
+        IndexedColumnWriter bf_writer(options, bf_type_info, file_writer);
+        RETURN_IF_ERROR(bf_writer.init());
+        for (auto& bf : _bfs) {
+            Slice data(bf->data(), bf->size());
+            RETURN_IF_ERROR(bf_writer.add(&data));
+        }
+        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
+        return Status::OK();
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _grams_size; }
+
+private:
+    BloomFilterOptions _bf_options;
+    uint32_t _gram_size;
+    bool _has_null = false;
+    uint64_t _bf_buffer_size = 0;
+    // distinct grams of the current page
+    std::unordered_set<std::string> _grams;
+    uint64_t _grams_size = 0;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
 // TODO currently we don't support bloom filter index for tinyint/hll/float/double
@@ -216,5 +295,25 @@ Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options,
     return Status::OK();
 }
 
+Status BloomFilterIndexWriter::create_ngram(const BloomFilterOptions& bf_options,
+                                            const TypeInfo* type_info, uint32_t gram_size,
+                                            std::unique_ptr<BloomFilterIndexWriter>* res) {
+    FieldType type = type_info->type();
+    switch (type) {
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_STRING:
+        if (gram_size == 0) {
+            return Status::InvalidArgument("invalid gram size of ngram bloom filter index: 0");
+        }
+        res->reset(new NgramBloomFilterIndexWriterImpl(bf_options, gram_size));
+        break;
+    default:
+        return Status::NotSupported("unsupported type for ngram bloom filter index: " +
+                                    std::to_string(type));
+    }
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace doris
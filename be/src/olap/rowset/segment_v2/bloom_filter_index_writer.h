@@ -41,6 +41,11 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfo* type_info,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Create a writer building bloom filters of the `gram_size` bytes substrings of the
+    // values, only for string types.
+    static Status create_ngram(const BloomFilterOptions& bf_options, const TypeInfo* type_info,
+                               uint32_t gram_size, std::unique_ptr<BloomFilterIndexWriter>* res);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
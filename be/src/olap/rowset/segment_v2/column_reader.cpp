@@ -19,12 +19,15 @@
 
 #include "gutil/strings/substitute.h"                // for Substitute
 #include "olap/column_block.h"                       // for ColumnBlockView
+#include "olap/column_vector.h"
+#include "olap/page_cache.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h" // for BinaryDictPageDecoder
 #include "olap/rowset/segment_v2/bloom_filter_index_reader.h"
 #include "olap/rowset/segment_v2/encoding_info.h" // for EncodingInfo
 #include "olap/rowset/segment_v2/page_handle.h"   // for PageHandle
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
+#include "olap/rowset/segment_v2/plain_page.h"
 #include "olap/types.h"                          // for TypeInfo
 #include "util/block_compression.h"
 #include "util/rle_encoding.h" // for RleDecoder
@@ -104,6 +107,31 @@ Status ColumnReader::init() {
                 strings::Substitute("unsupported typeinfo, type=$0", _meta.type()));
     }
     RETURN_IF_ERROR(EncodingInfo::get(_type_info.get(), _meta.encoding(), &_encoding_info));
+    if (_meta.has_compression_dict()) {
+        _compression_dict =
+                std::make_shared<ZstdDictionary>(std::move(*_meta.mutable_compression_dict()));
+        _meta.clear_compression_dict();
+    }
+    if (_encoding_info->encoding() != PLAIN_ENCODING) {
+        switch (_type_info->type()) {
+        case OLAP_FIELD_TYPE_BOOL:
+        case OLAP_FIELD_TYPE_TINYINT:
+        case OLAP_FIELD_TYPE_SMALLINT:
+        case OLAP_FIELD_TYPE_INT:
+        case OLAP_FIELD_TYPE_BIGINT:
+        case OLAP_FIELD_TYPE_LARGEINT:
+        case OLAP_FIELD_TYPE_FLOAT:
+        case OLAP_FIELD_TYPE_DOUBLE:
+        case OLAP_FIELD_TYPE_DATE:
+        case OLAP_FIELD_TYPE_DATETIME:
+        case OLAP_FIELD_TYPE_DECIMAL:
+            RETURN_IF_ERROR(
+                    EncodingInfo::get(_type_info.get(), PLAIN_ENCODING, &_plain_encoding_info));
+            break;
+        default:
+            break;
+        }
+    }
 
     for (int i = 0; i < _meta.indexes_size(); i++) {
         auto& index_meta = _meta.indexes(i);
@@ -120,6 +148,12 @@ Status ColumnReader::init() {
         case BLOOM_FILTER_INDEX:
             _bf_index_meta = &index_meta.bloom_filter_index();
             break;
+        case INVERTED_INDEX:
+            _inverted_index_meta = &index_meta.inverted_index();
+            break;
+        case NGRAM_BLOOM_FILTER_INDEX:
+            _ngram_bf_index_meta = &index_meta.ngram_bloom_filter_index();
+            break;
         default:
             return Status::Corruption(strings::Substitute(
                     "Bad file $0: invalid column index type $1", _path, index_meta.type()));
@@ -140,17 +174,25 @@ Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     return Status::OK();
 }
 
+Status ColumnReader::new_inverted_index_iterator(InvertedIndexIterator** iterator) {
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    RETURN_IF_ERROR(_inverted_index->new_iterator(iterator));
+    return Status::OK();
+}
+
 Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
                                PageHandle* handle, Slice* page_body, PageFooterPB* footer,
-                               BlockCompressionCodec* codec) {
+                               BlockCompressionCodec* codec, BlockCompressionCodec* dict_codec) {
     iter_opts.sanity_check();
     PageReadOptions opts;
     opts.file_reader = iter_opts.file_reader;
     opts.page_pointer = pp;
     opts.codec = codec;
+    opts.dict_codec = dict_codec;
     opts.stats = iter_opts.stats;
     opts.verify_checksum = _opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
+    opts.fill_page_cache = iter_opts.fill_page_cache;
     opts.kept_in_memory = _opts.kept_in_memory;
     opts.type = iter_opts.type;
     opts.encoding_info = _encoding_info;
@@ -158,6 +200,102 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
 
+Status ColumnReader::page_encoding_info(const DataPageFooterPB& footer,
+                                        const EncodingInfo** info) const {
+    if (!footer.has_encoding() || footer.encoding() == _encoding_info->encoding()) {
+        *info = _encoding_info;
+        return Status::OK();
+    }
+    return EncodingInfo::get(_type_info.get(), footer.encoding(), info);
+}
+
+bool ColumnReader::use_decoded_page_cache(const ColumnIteratorOptions& iter_opts) const {
+    return _plain_encoding_info != nullptr && iter_opts.use_page_cache &&
+           DecodedPageCache::instance() != nullptr;
+}
+
+Status ColumnReader::read_decoded_page(const ColumnIteratorOptions& iter_opts,
+                                       const PagePointer& pp, PageHandle* handle,
+                                       Slice* page_body, PageFooterPB* footer,
+                                       BlockCompressionCodec* codec,
+                                       BlockCompressionCodec* dict_codec) {
+    auto cache = DecodedPageCache::instance();
+    StoragePageCache::CacheKey cache_key(iter_opts.file_reader->path().native(), pp.offset);
+    PageCacheHandle cache_handle;
+    if (cache->lookup(cache_key, &cache_handle)) {
+        *handle = PageHandle(std::move(cache_handle));
+        iter_opts.stats->total_pages_num++;
+        iter_opts.stats->cached_pages_num++;
+        Slice page_slice = handle->data();
+        uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+        std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
+        if (!footer->ParseFromString(footer_buf)) {
+            return Status::Corruption("Bad decoded page: invalid footer");
+        }
+        *page_body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+        return Status::OK();
+    }
+
+    // the decoded page takes the place of the raw page in the cache
+    ColumnIteratorOptions raw_opts = iter_opts;
+    raw_opts.fill_page_cache = false;
+    PageHandle raw_handle;
+    Slice raw_body;
+    RETURN_IF_ERROR(read_page(raw_opts, pp, &raw_handle, &raw_body, footer, codec, dict_codec));
+
+    size_t null_size = footer->data_page_footer().nullmap_size();
+    Slice data_slice(raw_body.data, raw_body.size - null_size);
+    const EncodingInfo* encoding_info = nullptr;
+    RETURN_IF_ERROR(page_encoding_info(footer->data_page_footer(), &encoding_info));
+    PageDecoder* raw_decoder = nullptr;
+    RETURN_IF_ERROR(
+            encoding_info->create_page_decoder(data_slice, PageDecoderOptions(), &raw_decoder));
+    std::unique_ptr<PageDecoder> decoder(raw_decoder);
+    RETURN_IF_ERROR(decoder->init());
+
+    size_t num_values = decoder->count();
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(
+            ColumnVectorBatch::create(num_values, false, _type_info.get(), nullptr, &cvb));
+    ColumnBlock block(cvb.get(), nullptr);
+    ColumnBlockView column_block_view(&block);
+    size_t num_read = num_values;
+    RETURN_IF_ERROR(decoder->next_batch(&num_read, &column_block_view));
+    if (num_read != num_values) {
+        return Status::Corruption(strings::Substitute(
+                "Bad page of $0: decoded $1 values of $2", _path, num_read, num_values));
+    }
+
+    // PLAIN page := NumValues(4), Values, NullBitmap, PageFooterPB, FooterPBSize(4)
+    std::string footer_buf;
+    footer->SerializeToString(&footer_buf);
+    size_t values_size = num_values * _type_info->size();
+    size_t body_size = PLAIN_PAGE_HEADER_SIZE + values_size + null_size;
+    size_t page_size = body_size + footer_buf.size() + 4;
+    std::unique_ptr<char[]> page(new char[page_size]);
+    char* cur = page.get();
+    encode_fixed32_le((uint8_t*)cur, num_values);
+    cur += PLAIN_PAGE_HEADER_SIZE;
+    memcpy(cur, cvb->data(), values_size);
+    cur += values_size;
+    memcpy(cur, raw_body.data + raw_body.size - null_size, null_size);
+    cur += null_size;
+    memcpy(cur, footer_buf.data(), footer_buf.size());
+    cur += footer_buf.size();
+    encode_fixed32_le((uint8_t*)cur, footer_buf.size());
+
+    Slice page_slice(page.get(), page_size);
+    if (iter_opts.fill_page_cache) {
+        cache->insert(cache_key, page_slice, &cache_handle);
+        *handle = PageHandle(std::move(cache_handle));
+    } else {
+        *handle = PageHandle(page_slice);
+    }
+    page.release(); // memory now managed by handle
+    *page_body = Slice(page_slice.data, body_size);
+    return Status::OK();
+}
+
 Status ColumnReader::get_row_ranges_by_zone_map(CondColumn* cond_column,
                                                 CondColumn* delete_condition,
                                                 RowRanges* row_ranges) {
@@ -266,24 +404,54 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(CondColumn* cond_column,
     RowRanges bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
     RETURN_IF_ERROR(_bloom_filter_index->new_iterator(&bf_iter));
-    size_t range_size = row_ranges->range_size();
-    // get covered page ids
     std::set<uint32_t> page_ids;
-    for (int i = 0; i < range_size; ++i) {
-        int64_t from = row_ranges->get_range_from(i);
-        int64_t idx = from;
-        int64_t to = row_ranges->get_range_to(i);
-        auto iter = _ordinal_index->seek_at_or_before(from);
-        while (idx < to && iter.valid()) {
-            page_ids.insert(iter.page_index());
-            idx = iter.last_ordinal() + 1;
-            iter.next();
+    _get_page_ids(*row_ranges, &page_ids);
+    for (auto& pid : page_ids) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        if (cond_column->eval(bf.get())) {
+            bf_row_ranges.add(RowRange(_ordinal_index->get_first_ordinal(pid),
+                                       _ordinal_index->get_last_ordinal(pid) + 1));
         }
     }
+    RowRanges::ranges_intersection(*row_ranges, bf_row_ranges, row_ranges);
+    return Status::OK();
+}
+
+Status ColumnReader::get_row_ranges_by_ngram_bloom_filter(
+        const std::vector<std::string>& substrings, RowRanges* row_ranges) {
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    const size_t gram_size = _ngram_bf_index_meta->gram_size();
+    // the substrings shorter than a gram can't be checked
+    std::vector<const std::string*> checked_substrings;
+    for (auto& substring : substrings) {
+        if (substring.size() >= gram_size) {
+            checked_substrings.push_back(&substring);
+        }
+    }
+    if (gram_size == 0 || checked_substrings.empty()) {
+        return Status::OK();
+    }
+    RowRanges bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index->new_iterator(&bf_iter));
+    std::set<uint32_t> page_ids;
+    _get_page_ids(*row_ranges, &page_ids);
     for (auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
-        if (cond_column->eval(bf.get())) {
+        bool may_match = true;
+        for (auto substring : checked_substrings) {
+            for_each_ngram(substring->data(), substring->size(), gram_size,
+                           [&](const char* gram, size_t len) {
+                               may_match = may_match &&
+                                           bf->test_bytes(const_cast<char*>(gram), len);
+                           });
+            if (!may_match) {
+                break;
+            }
+        }
+        if (may_match) {
             bf_row_ranges.add(RowRange(_ordinal_index->get_first_ordinal(pid),
                                        _ordinal_index->get_last_ordinal(pid) + 1));
         }
@@ -292,6 +460,21 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(CondColumn* cond_column,
     return Status::OK();
 }
 
+void ColumnReader::_get_page_ids(const RowRanges& row_ranges, std::set<uint32_t>* page_ids) {
+    size_t range_size = row_ranges.range_size();
+    for (int i = 0; i < range_size; ++i) {
+        int64_t from = row_ranges.get_range_from(i);
+        int64_t idx = from;
+        int64_t to = row_ranges.get_range_to(i);
+        auto iter = _ordinal_index->seek_at_or_before(from);
+        while (idx < to && iter.valid()) {
+            page_ids->insert(iter.page_index());
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     DCHECK(_ordinal_index_meta != nullptr);
     _ordinal_index.reset(new OrdinalIndexReader(_fs, _path, _ordinal_index_meta, _num_rows));
@@ -314,6 +497,14 @@ Status ColumnReader::_load_bitmap_index(bool use_page_cache, bool kept_in_memory
     return Status::OK();
 }
 
+Status ColumnReader::_load_inverted_index(bool use_page_cache, bool kept_in_memory) {
+    if (_inverted_index_meta != nullptr) {
+        _inverted_index.reset(new InvertedIndexReader(_fs, _path, _inverted_index_meta));
+        return _inverted_index->load(use_page_cache, kept_in_memory);
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
     if (_bf_index_meta != nullptr) {
         _bloom_filter_index.reset(new BloomFilterIndexReader(_fs, _path, _bf_index_meta));
@@ -322,6 +513,15 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return Status::OK();
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    if (_ngram_bf_index_meta != nullptr) {
+        _ngram_bloom_filter_index.reset(
+                new BloomFilterIndexReader(_fs, _path, _ngram_bf_index_meta));
+        return _ngram_bloom_filter_index->load(use_page_cache, kept_in_memory);
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     RETURN_IF_ERROR(_ensure_index_loaded());
     *iter = _ordinal_index->begin();
@@ -340,6 +540,26 @@ Status ColumnReader::seek_at_or_before(ordinal_t ordinal, OrdinalPageIndexIterat
     return Status::OK();
 }
 
+Status ColumnReader::get_data_page_ranges(const roaring::Roaring& row_bitmap,
+                                          std::vector<io::PrefetchRange>* ranges) {
+    if (is_empty() || !is_scalar_type((FieldType)_meta.type()) || row_bitmap.isEmpty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    auto it = row_bitmap.begin();
+    for (int i = 0; i < _ordinal_index->num_data_pages(); ++i) {
+        it.equalorlarger(_ordinal_index->get_first_ordinal(i));
+        if (it == row_bitmap.end()) {
+            break;
+        }
+        if (*it <= _ordinal_index->get_last_ordinal(i)) {
+            const PagePointer& pp = OrdinalPageIndexIterator(_ordinal_index.get(), i).page();
+            ranges->push_back({pp.offset, pp.size});
+        }
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::new_iterator(ColumnIterator** iterator) {
     if (is_empty()) {
         *iterator = new EmptyFileColumnIterator();
@@ -508,6 +728,9 @@ FileColumnIterator::FileColumnIterator(ColumnReader* reader) : _reader(reader) {
 Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     RETURN_IF_ERROR(get_block_compression_codec(_reader->get_compression(), _compress_codec));
+    if (_reader->compression_dict() != nullptr) {
+        RETURN_IF_ERROR(get_zstd_dict_compression_codec(_reader->compression_dict(), _dict_codec));
+    }
     return Status::OK();
 }
 
@@ -699,19 +922,28 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     Slice page_body;
     PageFooterPB footer;
     _opts.type = DATA_PAGE;
+    if (_reader->use_decoded_page_cache(_opts)) {
+        RETURN_IF_ERROR(_reader->read_decoded_page(_opts, iter.page(), &handle, &page_body,
+                                                   &footer, _compress_codec.get(),
+                                                   _dict_codec.get()));
+        return ParsedPage::create(std::move(handle), page_body, footer.data_page_footer(),
+                                  _reader->plain_encoding_info(), iter.page(),
+                                  iter.page_index(), &_page);
+    }
     RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer,
-                                       _compress_codec.get()));
+                                       _compress_codec.get(), _dict_codec.get()));
     // parse data page
+    const EncodingInfo* encoding_info = nullptr;
+    RETURN_IF_ERROR(_reader->page_encoding_info(footer.data_page_footer(), &encoding_info));
     RETURN_IF_ERROR(ParsedPage::create(std::move(handle), page_body, footer.data_page_footer(),
-                                       _reader->encoding_info(), iter.page(), iter.page_index(),
-                                       &_page));
+                                       encoding_info, iter.page(), iter.page_index(), &_page));
 
     // dictionary page is read when the first data page that uses it is read,
     // this is to optimize the memory usage: when there is no query on one column, we could
     // release the memory of dictionary page.
     // note that concurrent iterators for the same column won't repeatedly read dictionary page
     // because of page cache.
-    if (_reader->encoding_info()->encoding() == DICT_ENCODING) {
+    if (encoding_info->encoding() == DICT_ENCODING) {
         auto dict_page_decoder = reinterpret_cast<BinaryDictPageDecoder*>(_page.data_decoder);
         if (dict_page_decoder->is_dict_encoding()) {
             if (_dict_decoder == nullptr) {
@@ -757,6 +989,14 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(CondColumn* cond_colum
     return Status::OK();
 }
 
+Status FileColumnIterator::get_row_ranges_by_ngram_bloom_filter(
+        const std::vector<std::string>& substrings, RowRanges* row_ranges) {
+    if (_reader->has_ngram_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->get_row_ranges_by_ngram_bloom_filter(substrings, row_ranges));
+    }
+    return Status::OK();
+}
+
 Status DefaultValueColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     // be consistent with segment v1
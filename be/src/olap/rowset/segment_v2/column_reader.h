@@ -20,6 +20,7 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
 #include <memory>  // for unique_ptr
+#include <set>
 
 #include "common/logging.h"
 #include "common/status.h"         // for Status
@@ -28,6 +29,7 @@
 #include "olap/olap_cond.h"                             // for CondColumn
 #include "olap/rowset/segment_v2/bitmap_index_reader.h" // for BitmapIndexReader
 #include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h" // for InvertedIndexReader
 #include "olap/rowset/segment_v2/ordinal_page_index.h" // for OrdinalPageIndexIterator
 #include "olap/rowset/segment_v2/page_handle.h"        // for PageHandle
 #include "olap/rowset/segment_v2/parsed_page.h"        // for ParsedPage
@@ -42,6 +44,7 @@ namespace doris {
 class ColumnBlock;
 class TypeInfo;
 class BlockCompressionCodec;
+class ZstdDictionary;
 class WrapperField;
 
 namespace fs {
@@ -68,6 +71,7 @@ struct ColumnIteratorOptions {
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    bool fill_page_cache = true;
     // for page cache allocation
     // page types are divided into DATA_PAGE & INDEX_PAGE
     // INDEX_PAGE including index_page, dict_page and short_key_page
@@ -98,22 +102,54 @@ public:
     // Client should delete returned iterator
     Status new_bitmap_index_iterator(BitmapIndexIterator** iterator);
 
+    Status new_inverted_index_iterator(InvertedIndexIterator** iterator);
+
     // Seek to the first entry in the column.
     Status seek_to_first(OrdinalPageIndexIterator* iter);
     Status seek_at_or_before(ordinal_t ordinal, OrdinalPageIndexIterator* iter);
 
-    // read a page from file into a page handle
+    // read a page from file into a page handle, `dict_codec` decompresses the data pages
+    // compressed with the dictionary of the column
     Status read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
                      PageHandle* handle, Slice* page_body, PageFooterPB* footer,
-                     BlockCompressionCodec* codec);
+                     BlockCompressionCodec* codec, BlockCompressionCodec* dict_codec = nullptr);
+
+    // Whether the data pages are read through DecodedPageCache.
+    bool use_decoded_page_cache(const ColumnIteratorOptions& iter_opts) const;
+
+    // Read a data page decoded into a PLAIN page, from DecodedPageCache if it's cached.
+    // REQUIRES: use_decoded_page_cache(iter_opts)
+    Status read_decoded_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
+                             PageHandle* handle, Slice* page_body, PageFooterPB* footer,
+                             BlockCompressionCodec* codec,
+                             BlockCompressionCodec* dict_codec = nullptr);
 
     bool is_nullable() const { return _meta.is_nullable(); }
 
     const EncodingInfo* encoding_info() const { return _encoding_info; }
 
+    // Encoding of a data page, which is recorded in the page footer if it is chosen per page.
+    Status page_encoding_info(const DataPageFooterPB& footer, const EncodingInfo** info) const;
+
+    // PLAIN encoding of the pages read by read_decoded_page()
+    const EncodingInfo* plain_encoding_info() const { return _plain_encoding_info; }
+
+    // ZSTD dictionary of the data pages, null if the column doesn't have one
+    const std::shared_ptr<const ZstdDictionary>& compression_dict() const {
+        return _compression_dict;
+    }
+
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
+    // nullptr if there is no zone map
+    const ZoneMapPB* segment_zone_map() const {
+        return _zone_map_index_meta == nullptr ? nullptr
+                                               : &_zone_map_index_meta->segment_zone_map();
+    }
     bool has_bitmap_index() const { return _bitmap_index_meta != nullptr; }
+
+    bool has_inverted_index() const { return _inverted_index_meta != nullptr; }
     bool has_bloom_filter_index() const { return _bf_index_meta != nullptr; }
+    bool has_ngram_bloom_filter_index() const { return _ngram_bf_index_meta != nullptr; }
 
     // Check if this column could match `cond' using segment zone map.
     // Since segment zone map is stored in metadata, this function is fast without I/O.
@@ -129,8 +165,18 @@ public:
     // get row ranges with bloom filter index
     Status get_row_ranges_by_bloom_filter(CondColumn* cond_column, RowRanges* row_ranges);
 
+    // get row ranges with n-gram bloom filter index, the pages in which no value may
+    // contain all of `substrings` are excluded
+    Status get_row_ranges_by_ngram_bloom_filter(const std::vector<std::string>& substrings,
+                                                RowRanges* row_ranges);
+
     PagePointer get_dict_page_pointer() const { return _meta.dict_page(); }
 
+    // Append the file ranges of the data pages containing any row in `row_bitmap`.
+    // Only supported for scalar columns, other columns append nothing.
+    Status get_data_page_ranges(const roaring::Roaring& row_bitmap,
+                                std::vector<io::PrefetchRange>* ranges);
+
     bool is_empty() const { return _num_rows == 0; }
 
     CompressionTypePB get_compression() const { return _meta.compression(); }
@@ -149,6 +195,9 @@ private:
             RETURN_IF_ERROR(_load_ordinal_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bitmap_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_inverted_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(
+                    _load_ngram_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
             return Status::OK();
         });
     }
@@ -157,6 +206,11 @@ private:
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_inverted_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+
+    // the page ids of the pages covering `row_ranges`
+    void _get_page_ids(const RowRanges& row_ranges, std::set<uint32_t>* page_ids);
 
     bool _zone_map_match_condition(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                    WrapperField* max_value_container, CondColumn* cond) const;
@@ -181,18 +235,26 @@ private:
             TypeInfoPtr(nullptr, nullptr); // initialized in init(), may changed by subclasses.
     const EncodingInfo* _encoding_info =
             nullptr; // initialized in init(), used for create PageDecoder
+    // initialized in init() if the pages could be decoded into PLAIN pages
+    const EncodingInfo* _plain_encoding_info = nullptr;
+    // initialized in init(), shared by the iterators to cache the digested dictionary
+    std::shared_ptr<const ZstdDictionary> _compression_dict;
 
     // meta for various column indexes (null if the index is absent)
     const ZoneMapIndexPB* _zone_map_index_meta = nullptr;
     const OrdinalIndexPB* _ordinal_index_meta = nullptr;
     const BitmapIndexPB* _bitmap_index_meta = nullptr;
+    const InvertedIndexPB* _inverted_index_meta = nullptr;
     const BloomFilterIndexPB* _bf_index_meta = nullptr;
+    const BloomFilterIndexPB* _ngram_bf_index_meta = nullptr;
 
     DorisCallOnce<Status> _load_index_once;
     std::unique_ptr<ZoneMapIndexReader> _zone_map_index;
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
+    std::unique_ptr<InvertedIndexReader> _inverted_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<BloomFilterIndexReader> _ngram_bloom_filter_index;
 
     std::vector<std::unique_ptr<ColumnReader>> _sub_readers;
 };
@@ -247,6 +309,11 @@ public:
         return Status::OK();
     }
 
+    virtual Status get_row_ranges_by_ngram_bloom_filter(const std::vector<std::string>& substrings,
+                                                        RowRanges* row_ranges) {
+        return Status::OK();
+    }
+
 protected:
     ColumnIteratorOptions _opts;
 };
@@ -280,6 +347,9 @@ public:
 
     Status get_row_ranges_by_bloom_filter(CondColumn* cond_column, RowRanges* row_ranges) override;
 
+    Status get_row_ranges_by_ngram_bloom_filter(const std::vector<std::string>& substrings,
+                                                RowRanges* row_ranges) override;
+
     ParsedPage* get_current_page() { return &_page; }
 
     bool is_nullable() { return _reader->is_nullable(); }
@@ -294,6 +364,8 @@ private:
 
     // iterator owned compress codec, should NOT be shared by threads, initialized in init()
     std::unique_ptr<BlockCompressionCodec> _compress_codec;
+    // codec of the data pages compressed with the dictionary of the column, if it has one
+    std::unique_ptr<BlockCompressionCodec> _dict_codec;
 
     // 1. The _page represents current page.
     // 2. We define an operation is one seek and following read,
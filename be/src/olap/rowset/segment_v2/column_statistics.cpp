@@ -0,0 +1,210 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/column_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "olap/field.h"
+#include "olap/types.h"
+#include "util/hash_util.hpp"
+#include "util/slice.h"
+#include "util/tdigest.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static constexpr uint32_t NDV_HASH_SEED = 0xadc83b19;
+
+ColumnStatisticsCollector::ColumnStatisticsCollector(const Field* field)
+        : _field(field), _type(field->type()) {
+    switch (_type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DOUBLE:
+    // the encoded dates and datetimes are in the same order as the values
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+        _quantile_sketch = std::make_unique<TDigest>(QUANTILE_COMPRESSION);
+        break;
+    default:
+        break;
+    }
+}
+
+ColumnStatisticsCollector::~ColumnStatisticsCollector() = default;
+
+bool ColumnStatisticsCollector::need_statistics(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_STRUCT:
+    case OLAP_FIELD_TYPE_ARRAY:
+    case OLAP_FIELD_TYPE_MAP:
+    case OLAP_FIELD_TYPE_HLL:
+    case OLAP_FIELD_TYPE_OBJECT:
+    case OLAP_FIELD_TYPE_QUANTILE_STATE:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void ColumnStatisticsCollector::add_values(const void* values, size_t count) {
+    _num_rows += count;
+    if (_type == OLAP_FIELD_TYPE_CHAR || _type == OLAP_FIELD_TYPE_VARCHAR ||
+        _type == OLAP_FIELD_TYPE_STRING) {
+        auto slices = static_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t hash = HashUtil::murmur_hash64A(slices[i].data, slices[i].size,
+                                                     NDV_HASH_SEED);
+            _add_hash(hash);
+        }
+        return;
+    }
+    size_t size = _field->size();
+    auto data = static_cast<const uint8_t*>(values);
+    for (size_t i = 0; i < count; ++i) {
+        _add_hash(HashUtil::murmur_hash64A(data + i * size, size, NDV_HASH_SEED));
+    }
+    switch (_type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        _add_quantile_values<int8_t>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        _add_quantile_values<int16_t>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_INT:
+        _add_quantile_values<int32_t>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_BIGINT:
+        _add_quantile_values<int64_t>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_LARGEINT:
+        _add_quantile_values<int128_t>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_FLOAT:
+        _add_quantile_values<float>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_DOUBLE:
+        _add_quantile_values<double>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_DATE:
+        _add_quantile_values<CppTypeTraits<OLAP_FIELD_TYPE_DATE>::CppType>(values, count);
+        break;
+    case OLAP_FIELD_TYPE_DATETIME:
+        _add_quantile_values<CppTypeTraits<OLAP_FIELD_TYPE_DATETIME>::CppType>(values, count);
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename CppType>
+void ColumnStatisticsCollector::_add_quantile_values(const void* values, size_t count) {
+    _quantile_sketch->add(static_cast<const CppType*>(values), count);
+}
+
+void ColumnStatisticsCollector::_add_hash(uint64_t hash) {
+    size_t index = hash & (NDV_SKETCH_REGISTERS - 1);
+    uint64_t remaining = hash >> NDV_SKETCH_BITS;
+    // the position of the first 1 bit in the remaining bits
+    uint8_t rank = remaining == 0 ? 64 - NDV_SKETCH_BITS + 1 : __builtin_ctzll(remaining) + 1;
+    _registers[index] = std::max(_registers[index], rank);
+}
+
+void ColumnStatisticsCollector::finish(uint32_t unique_id, ColumnStatisticsPB* statistics) {
+    statistics->set_unique_id(unique_id);
+    statistics->set_num_rows(_num_rows);
+    statistics->set_null_count(_null_count);
+    statistics->set_ndv_sketch(_registers, NDV_SKETCH_REGISTERS);
+    if (_quantile_sketch != nullptr && _num_rows > _null_count) {
+        std::string buf(_quantile_sketch->serialized_size(), '\0');
+        buf.resize(_quantile_sketch->serialize(reinterpret_cast<uint8_t*>(buf.data())));
+        statistics->set_quantile_sketch(std::move(buf));
+    }
+}
+
+void ColumnStatisticsCollector::merge(const ColumnStatisticsPB& src, ColumnStatisticsPB* dst) {
+    dst->set_unique_id(src.unique_id());
+    dst->set_num_rows(dst->num_rows() + src.num_rows());
+    dst->set_null_count(dst->null_count() + src.null_count());
+    if (src.ndv_sketch().size() == NDV_SKETCH_REGISTERS) {
+        if (dst->ndv_sketch().size() != NDV_SKETCH_REGISTERS) {
+            dst->set_ndv_sketch(src.ndv_sketch());
+        } else {
+            auto registers = dst->mutable_ndv_sketch()->data();
+            for (size_t i = 0; i < NDV_SKETCH_REGISTERS; ++i) {
+                registers[i] = std::max<uint8_t>(registers[i], src.ndv_sketch()[i]);
+            }
+        }
+    }
+    if (src.has_quantile_sketch()) {
+        if (!dst->has_quantile_sketch()) {
+            dst->set_quantile_sketch(src.quantile_sketch());
+        } else {
+            TDigest dst_sketch;
+            dst_sketch.unserialize(reinterpret_cast<const uint8_t*>(dst->quantile_sketch().data()));
+            TDigest src_sketch;
+            src_sketch.unserialize(reinterpret_cast<const uint8_t*>(src.quantile_sketch().data()));
+            dst_sketch.merge(&src_sketch);
+            std::string buf(dst_sketch.serialized_size(), '\0');
+            buf.resize(dst_sketch.serialize(reinterpret_cast<uint8_t*>(buf.data())));
+            dst->set_quantile_sketch(std::move(buf));
+        }
+    }
+}
+
+int64_t ColumnStatisticsCollector::estimate_ndv(const ColumnStatisticsPB& statistics) {
+    const std::string& registers = statistics.ndv_sketch();
+    if (registers.size() != NDV_SKETCH_REGISTERS) {
+        return 0;
+    }
+    constexpr double m = NDV_SKETCH_REGISTERS;
+    double sum = 0;
+    size_t num_zeros = 0;
+    for (size_t i = 0; i < NDV_SKETCH_REGISTERS; ++i) {
+        uint8_t rank = registers[i];
+        sum += std::ldexp(1.0, -rank);
+        num_zeros += rank == 0;
+    }
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    // linear counting for the small cardinalities
+    if (estimate <= 2.5 * m && num_zeros > 0) {
+        estimate = m * std::log(m / num_zeros);
+    }
+    uint64_t non_null_rows = statistics.num_rows() - statistics.null_count();
+    return std::min<int64_t>(std::llround(estimate), non_null_rows);
+}
+
+bool ColumnStatisticsCollector::estimate_quantile(const ColumnStatisticsPB& statistics, double q,
+                                                  double* value) {
+    if (!statistics.has_quantile_sketch()) {
+        return false;
+    }
+    TDigest sketch;
+    sketch.unserialize(reinterpret_cast<const uint8_t*>(statistics.quantile_sketch().data()));
+    *value = sketch.quantile(q);
+    return !std::isnan(*value);
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "olap/olap_common.h"
+
+namespace doris {
+
+class Field;
+class TDigest;
+
+namespace segment_v2 {
+
+// Collects the statistics of the values of a column written into a segment for the cost
+// based optimizer: the null count, a HyperLogLog sketch of the number of the distinct
+// values, and a TDigest of the values of the numeric and date types. Both sketches are
+// small and mergeable, so the statistics of the segments are merged into the ones of the
+// rowset and of the tablet.
+class ColumnStatisticsCollector {
+public:
+    // 2^10 one byte registers, with a standard error of about 3%
+    static constexpr int NDV_SKETCH_BITS = 10;
+    static constexpr size_t NDV_SKETCH_REGISTERS = 1 << NDV_SKETCH_BITS;
+    // about 2 * QUANTILE_COMPRESSION centroids of 8 bytes at most
+    static constexpr float QUANTILE_COMPRESSION = 100;
+
+    explicit ColumnStatisticsCollector(const Field* field);
+    ~ColumnStatisticsCollector();
+
+    // values are in the memory format of the field, e.g. Slice for strings
+    void add_values(const void* values, size_t count);
+    void add_nulls(size_t count) {
+        _num_rows += count;
+        _null_count += count;
+    }
+
+    void finish(uint32_t unique_id, ColumnStatisticsPB* statistics);
+
+    // Whether the statistics are collected for the columns of type.
+    static bool need_statistics(FieldType type);
+
+    // Merges src into dst, both of the same column.
+    static void merge(const ColumnStatisticsPB& src, ColumnStatisticsPB* dst);
+
+    // The estimated number of the distinct non-null values.
+    static int64_t estimate_ndv(const ColumnStatisticsPB& statistics);
+
+    // The estimated value at quantile q in [0, 1], false if there is no quantile sketch.
+    static bool estimate_quantile(const ColumnStatisticsPB& statistics, double q, double* value);
+
+private:
+    void _add_hash(uint64_t hash);
+
+    template <typename CppType>
+    void _add_quantile_values(const void* values, size_t count);
+
+    const Field* _field;
+    const FieldType _type;
+    uint64_t _num_rows = 0;
+    uint64_t _null_count = 0;
+    uint8_t _registers[NDV_SKETCH_REGISTERS] = {};
+    // nullptr for the types other than the numeric and date ones
+    std::unique_ptr<TDigest> _quantile_sketch;
+};
+
+} // namespace segment_v2
+} // namespace doris
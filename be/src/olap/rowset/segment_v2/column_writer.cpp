@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/column_writer.h"
 
+#include <algorithm>
 #include <cstddef>
 
 #include "common/logging.h"
@@ -25,7 +26,9 @@
 #include "olap/rowset/segment_v2/bitmap_index_writer.h"
 #include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/rowset/segment_v2/bloom_filter_index_writer.h"
+#include "olap/rowset/segment_v2/column_statistics.h"
 #include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
 #include "olap/rowset/segment_v2/options.h"
 #include "olap/rowset/segment_v2/ordinal_page_index.h"
 #include "olap/rowset/segment_v2/page_builder.h"
@@ -266,8 +269,41 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), _compress_codec));
 
+    _page_codecs.push_back({_opts.meta->compression(), _compress_codec.get()});
+
     PageBuilder* page_builder = nullptr;
 
+    _num_pages_to_sample = config::adaptive_page_encoding_sample_pages;
+    if (_num_pages_to_sample > 0 && _opts.meta->encoding() == DEFAULT_ENCODING) {
+        _adaptive_page_encoding = true;
+        // the values of string columns are not kept, only the compression is chosen for them
+        _sampling_encoding = !is_olap_string_type(get_field()->type());
+        for (auto type : {NO_COMPRESSION, LZ4F, ZSTD}) {
+            if (type == _opts.meta->compression()) {
+                continue;
+            }
+            std::unique_ptr<BlockCompressionCodec> codec;
+            RETURN_IF_ERROR(get_block_compression_codec(type, codec));
+            _page_codecs.push_back({type, codec.get()});
+            _owned_page_codecs.push_back(std::move(codec));
+        }
+    } else if (_opts.meta->encoding() == DEFAULT_ENCODING) {
+        switch (get_field()->type()) {
+        case OLAP_FIELD_TYPE_TINYINT:
+        case OLAP_FIELD_TYPE_SMALLINT:
+        case OLAP_FIELD_TYPE_INT:
+        case OLAP_FIELD_TYPE_BIGINT:
+        case OLAP_FIELD_TYPE_DATETIME:
+            _sampling_encoding = config::enable_int_column_encoding_selection;
+            break;
+        case OLAP_FIELD_TYPE_FLOAT:
+        case OLAP_FIELD_TYPE_DOUBLE:
+            _sampling_encoding = config::enable_float_column_encoding_selection;
+            break;
+        default:
+            break;
+        }
+    }
     RETURN_IF_ERROR(
             EncodingInfo::get(get_field()->type_info(), _opts.meta->encoding(), &_encoding_info));
     _opts.meta->set_encoding(_encoding_info->encoding());
@@ -284,6 +320,8 @@ Status ScalarColumnWriter::init() {
     // because the default encoding of a data type can be changed in the future
     DCHECK_NE(_opts.meta->encoding(), DEFAULT_ENCODING);
     _page_builder.reset(page_builder);
+    _training_compression_dict = !_adaptive_page_encoding && _opts.meta->compression() == ZSTD &&
+                                 config::zstd_dict_train_pages > 0;
     // create ordinal builder
     _ordinal_index_builder.reset(new OrdinalIndexWriter());
     // create null bitmap builder
@@ -301,6 +339,18 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(
                 BloomFilterOptions(), get_field()->type_info(), &_bloom_filter_index_builder));
     }
+    if (_opts.need_ngram_bloom_filter) {
+        RETURN_IF_ERROR(BloomFilterIndexWriter::create_ngram(
+                BloomFilterOptions(), get_field()->type_info(),
+                config::ngram_bloom_filter_gram_size, &_ngram_bloom_filter_index_builder));
+    }
+    if (_opts.need_inverted_index) {
+        RETURN_IF_ERROR(
+                InvertedIndexWriter::create(get_field()->type_info(), &_inverted_index_builder));
+    }
+    if (_opts.need_statistics) {
+        _statistics_collector.reset(new ColumnStatisticsCollector(get_field()));
+    }
     return Status::OK();
 }
 
@@ -316,6 +366,15 @@ Status ScalarColumnWriter::append_nulls(size_t num_rows) {
     if (_opts.need_bloom_filter) {
         _bloom_filter_index_builder->add_nulls(num_rows);
     }
+    if (_opts.need_ngram_bloom_filter) {
+        _ngram_bloom_filter_index_builder->add_nulls(num_rows);
+    }
+    if (_opts.need_inverted_index) {
+        _inverted_index_builder->add_nulls(num_rows);
+    }
+    if (_opts.need_statistics) {
+        _statistics_collector->add_nulls(num_rows);
+    }
     return Status::OK();
 }
 
@@ -339,6 +398,9 @@ Status ScalarColumnWriter::append_data(const uint8_t** ptr, size_t num_rows) {
 
 Status ScalarColumnWriter::append_data_in_current_page(const uint8_t** ptr, size_t* num_written) {
     RETURN_IF_ERROR(_page_builder->add(*ptr, num_written));
+    if (_sampling_encoding) {
+        _encoding_sample.append(*ptr, get_field()->size() * (*num_written));
+    }
     if (_opts.need_zone_map) {
         _zone_map_index_builder->add_values(*ptr, *num_written);
     }
@@ -348,6 +410,15 @@ Status ScalarColumnWriter::append_data_in_current_page(const uint8_t** ptr, size
     if (_opts.need_bloom_filter) {
         _bloom_filter_index_builder->add_values(*ptr, *num_written);
     }
+    if (_opts.need_ngram_bloom_filter) {
+        _ngram_bloom_filter_index_builder->add_values(*ptr, *num_written);
+    }
+    if (_opts.need_inverted_index) {
+        _inverted_index_builder->add_values(*ptr, *num_written);
+    }
+    if (_opts.need_statistics) {
+        _statistics_collector->add_values(*ptr, *num_written);
+    }
 
     _next_rowid += *num_written;
     *ptr += get_field()->size() * (*num_written);
@@ -361,6 +432,9 @@ Status ScalarColumnWriter::append_data_in_current_page(const uint8_t** ptr, size
 
 Status ScalarColumnWriter::append_data_in_current_page(const uint8_t* ptr, size_t* num_written) {
     RETURN_IF_ERROR(_page_builder->add(ptr, num_written));
+    if (_sampling_encoding) {
+        _encoding_sample.append(ptr, get_field()->size() * (*num_written));
+    }
     if (_opts.need_zone_map) {
         _zone_map_index_builder->add_values(ptr, *num_written);
     }
@@ -370,6 +444,15 @@ Status ScalarColumnWriter::append_data_in_current_page(const uint8_t* ptr, size_
     if (_opts.need_bloom_filter) {
         _bloom_filter_index_builder->add_values(ptr, *num_written);
     }
+    if (_opts.need_ngram_bloom_filter) {
+        _ngram_bloom_filter_index_builder->add_values(ptr, *num_written);
+    }
+    if (_opts.need_inverted_index) {
+        _inverted_index_builder->add_values(ptr, *num_written);
+    }
+    if (_opts.need_statistics) {
+        _statistics_collector->add_values(ptr, *num_written);
+    }
 
     _next_rowid += *num_written;
     if (is_nullable()) {
@@ -394,12 +477,33 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_opts.need_bloom_filter) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_opts.need_ngram_bloom_filter) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
+    if (_opts.need_inverted_index) {
+        size += _inverted_index_builder->size();
+    }
     return size;
 }
 
 Status ScalarColumnWriter::finish() {
     RETURN_IF_ERROR(finish_current_page());
+    if (_training_compression_dict) {
+        // too few pages to train a dictionary for
+        _training_compression_dict = false;
+        for (auto page : _dict_sample_pages) {
+            OwnedSlice compressed_body;
+            RETURN_IF_ERROR(PageIO::compress_page_body(
+                    _compress_codec.get(), _opts.compression_min_space_saving,
+                    {page->data[0].slice(), page->data[1].slice()}, &compressed_body));
+            _set_sample_page_body(page, std::move(compressed_body), false);
+        }
+        _dict_sample_pages.clear();
+    }
     _opts.meta->set_num_rows(_next_rowid);
+    if (_opts.need_statistics) {
+        _statistics_collector->finish(_opts.meta->unique_id(), _opts.meta->mutable_statistics());
+    }
     return Status::OK();
 }
 
@@ -448,7 +552,19 @@ Status ScalarColumnWriter::write_bitmap_index() {
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_opts.need_bloom_filter) {
-        return _bloom_filter_index_builder->finish(_file_writer, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(
+                _bloom_filter_index_builder->finish(_file_writer, _opts.meta->add_indexes()));
+    }
+    if (_opts.need_ngram_bloom_filter) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_file_writer,
+                                                                  _opts.meta->add_indexes()));
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::write_inverted_index() {
+    if (_opts.need_inverted_index) {
+        return _inverted_index_builder->finish(_file_writer, _opts.meta->add_indexes());
     }
     return Status::OK();
 }
@@ -465,10 +581,136 @@ Status ScalarColumnWriter::_write_data_page(Page* page) {
     return Status::OK();
 }
 
+// The decoding cost of the codecs relative to the size of the pages, a page compressed by a
+// slower codec has to be small enough to be chosen.
+static double page_decode_cost_factor(CompressionTypePB type) {
+    switch (type) {
+    case NO_COMPRESSION:
+        return 1.0;
+    case SNAPPY:
+    case LZ4:
+    case LZ4F:
+        return 1.05;
+    default:
+        return 1.15;
+    }
+}
+
+Status ScalarColumnWriter::_score_encoded_page(const Slice& encoded, size_t* codec_idx,
+                                               double* score) {
+    *score = -1;
+    for (size_t i = 0; i < _page_codecs.size(); ++i) {
+        OwnedSlice compressed;
+        RETURN_IF_ERROR(PageIO::compress_page_body(_page_codecs[i].codec,
+                                                   _opts.compression_min_space_saving,
+                                                   {encoded}, &compressed));
+        // the page is stored uncompressed if the codec doesn't save enough space
+        double cur = compressed.slice().empty()
+                             ? encoded.size
+                             : compressed.slice().size *
+                                       page_decode_cost_factor(_page_codecs[i].type);
+        if (*score < 0 || cur < *score) {
+            *score = cur;
+            *codec_idx = i;
+        }
+    }
+    return Status::OK();
+}
+
+// All pages share the encoding in the column meta unless the encoding is chosen per page, so
+// the encoding is chosen before the first page is flushed. The values of the page are encoded
+// with every candidate encoding and compressed, the smallest one is used.
+Status ScalarColumnWriter::_choose_encoding() {
+    OwnedSlice sample = _encoding_sample.build();
+    const uint8_t* values = reinterpret_cast<const uint8_t*>(sample.slice().data);
+    const size_t num_values = sample.slice().size / get_field()->size();
+    if (num_values == 0) {
+        // all values of the page are null, keep the current encoding
+        return Status::OK();
+    }
+
+    PageBuilderOptions opts;
+    opts.data_page_size = _opts.data_page_size;
+    const EncodingInfo* best = nullptr;
+    double best_score = 0;
+    for (auto encoding : {_encoding_info->encoding(), BIT_SHUFFLE, FOR_ENCODING,
+                          DELTA_BINARY_PACKED, INT_DICT_ENCODING, ALP_ENCODING, PLAIN_ENCODING}) {
+        const EncodingInfo* info = nullptr;
+        if (!EncodingInfo::get(get_field()->type_info(), encoding, &info).ok()) {
+            continue;
+        }
+        PageBuilder* page_builder = nullptr;
+        RETURN_IF_ERROR(info->create_page_builder(opts, &page_builder));
+        std::unique_ptr<PageBuilder> builder(page_builder);
+        size_t num_added = num_values;
+        RETURN_IF_ERROR(builder->add(values, &num_added));
+        if (num_added != num_values) {
+            // e.g. too many distinct values for dictionary encoding
+            continue;
+        }
+        OwnedSlice encoded = builder->finish();
+        size_t codec_idx = 0;
+        double score = 0;
+        RETURN_IF_ERROR(_score_encoded_page(encoded.slice(), &codec_idx, &score));
+        if (best == nullptr || score < best_score) {
+            best = info;
+            best_score = score;
+        }
+    }
+    if (best == nullptr || best == _encoding_info) {
+        return Status::OK();
+    }
+
+    // move the values of the current page to a page builder of the chosen encoding
+    PageBuilder* page_builder = nullptr;
+    RETURN_IF_ERROR(best->create_page_builder(opts, &page_builder));
+    std::unique_ptr<PageBuilder> builder(page_builder);
+    size_t num_added = num_values;
+    RETURN_IF_ERROR(builder->add(values, &num_added));
+    DCHECK_EQ(num_added, num_values);
+    _page_builder = std::move(builder);
+    _encoding_info = best;
+    _opts.meta->set_encoding(best->encoding());
+    VLOG_DEBUG << "choose encoding " << EncodingTypePB_Name(best->encoding()) << " for column "
+               << get_field()->name() << ", encoded size of the page: " << best_score;
+    return Status::OK();
+}
+
+// Once enough pages are sampled, the most frequent choice of them is used for the rest pages.
+Status ScalarColumnWriter::_record_page_choice(EncodingTypePB encoding, size_t codec_idx) {
+    ++_page_choices[{encoding, codec_idx}];
+    if (++_num_sampled_pages < _num_pages_to_sample) {
+        return Status::OK();
+    }
+    _sampling_encoding = false;
+    auto best = std::max_element(
+            _page_choices.begin(), _page_choices.end(),
+            [](const auto& l, const auto& r) { return l.second < r.second; });
+    _page_codec_idx = best->first.second;
+    if (best->first.first != _encoding_info->encoding()) {
+        const EncodingInfo* info = nullptr;
+        RETURN_IF_ERROR(EncodingInfo::get(get_field()->type_info(), best->first.first, &info));
+        PageBuilderOptions opts;
+        opts.data_page_size = _opts.data_page_size;
+        PageBuilder* page_builder = nullptr;
+        RETURN_IF_ERROR(info->create_page_builder(opts, &page_builder));
+        _page_builder.reset(page_builder);
+        _encoding_info = info;
+        _opts.meta->set_encoding(info->encoding());
+    }
+    _page_choices.clear();
+    return Status::OK();
+}
+
 Status ScalarColumnWriter::finish_current_page() {
     if (_next_rowid == _first_rowid) {
         return Status::OK();
     }
+    if (_sampling_encoding) {
+        RETURN_IF_ERROR(_choose_encoding());
+        // the encoding of the column is chosen only once unless it is chosen per page
+        _sampling_encoding = _adaptive_page_encoding;
+    }
     if (_opts.need_zone_map) {
         if (_next_rowid - _first_rowid < config::zone_map_row_num_threshold) {
             _zone_map_index_builder->reset_page_zone_map();
@@ -479,12 +721,22 @@ Status ScalarColumnWriter::finish_current_page() {
     if (_opts.need_bloom_filter) {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
+    if (_opts.need_ngram_bloom_filter) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
 
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     OwnedSlice encoded_values = _page_builder->finish();
     _page_builder->reset();
     body.push_back(encoded_values.slice());
+    EncodingTypePB page_encoding = _encoding_info->encoding();
+    size_t codec_idx = _page_codec_idx;
+    if (_adaptive_page_encoding && _num_sampled_pages < _num_pages_to_sample) {
+        double score = 0;
+        RETURN_IF_ERROR(_score_encoded_page(encoded_values.slice(), &codec_idx, &score));
+        RETURN_IF_ERROR(_record_page_choice(page_encoding, codec_idx));
+    }
 
     OwnedSlice nullmap;
     if (_null_bitmap_builder != nullptr) {
@@ -506,10 +758,28 @@ Status ScalarColumnWriter::finish_current_page() {
     if (_new_page_callback != nullptr) {
         _new_page_callback->put_extra_info_in_page(data_page_footer);
     }
+    if (_adaptive_page_encoding) {
+        data_page_footer->set_encoding(page_encoding);
+        page->footer.set_compression(_page_codecs[codec_idx].type);
+    }
+    if (_training_compression_dict) {
+        // the page is compressed once the dictionary is trained
+        page->data.emplace_back(std::move(encoded_values));
+        page->data.emplace_back(std::move(nullmap));
+        _dict_sample_pages.push_back(page.get());
+        _push_back_page(page.release());
+        _first_rowid = _next_rowid;
+        if (_dict_sample_pages.size() >= (size_t)config::zstd_dict_train_pages) {
+            RETURN_IF_ERROR(_train_compression_dict());
+        }
+        return Status::OK();
+    }
     // trying to compress page body
+    const BlockCompressionCodec* codec =
+            _dict_codec != nullptr ? _dict_codec.get() : _page_codecs[codec_idx].codec;
     OwnedSlice compressed_body;
-    RETURN_IF_ERROR(PageIO::compress_page_body(
-            _compress_codec.get(), _opts.compression_min_space_saving, body, &compressed_body));
+    RETURN_IF_ERROR(PageIO::compress_page_body(codec, _opts.compression_min_space_saving, body,
+                                               &compressed_body));
     if (compressed_body.slice().empty()) {
         // page body is uncompressed
         page->data.emplace_back(std::move(encoded_values));
@@ -517,6 +787,9 @@ Status ScalarColumnWriter::finish_current_page() {
     } else {
         // page body is compressed
         page->data.emplace_back(std::move(compressed_body));
+        if (_dict_codec != nullptr) {
+            page->footer.set_use_compression_dict(true);
+        }
     }
 
     _push_back_page(page.release());
@@ -524,6 +797,76 @@ Status ScalarColumnWriter::finish_current_page() {
     return Status::OK();
 }
 
+void ScalarColumnWriter::_set_sample_page_body(Page* page, OwnedSlice compressed_body,
+                                               bool use_dict) {
+    if (compressed_body.slice().empty()) {
+        return;
+    }
+    for (auto& data_slice : page->data) {
+        _data_size -= data_slice.slice().size;
+    }
+    page->data.clear();
+    _data_size += compressed_body.slice().size;
+    page->data.emplace_back(std::move(compressed_body));
+    if (use_dict) {
+        page->footer.set_use_compression_dict(true);
+    }
+}
+
+// The sample pages are compressed both with and without the dictionary, the dictionary is
+// only used if it saves space on them even counting its own size.
+Status ScalarColumnWriter::_train_compression_dict() {
+    _training_compression_dict = false;
+    std::vector<Slice> samples;
+    for (auto page : _dict_sample_pages) {
+        samples.push_back(page->data[0].slice());
+    }
+    std::string dict;
+    RETURN_IF_ERROR(train_zstd_dictionary(samples, config::zstd_dict_max_bytes, &dict));
+    std::unique_ptr<BlockCompressionCodec> dict_codec;
+    if (!dict.empty()) {
+        RETURN_IF_ERROR(get_zstd_dict_compression_codec(std::make_shared<ZstdDictionary>(dict),
+                                                        dict_codec));
+    }
+
+    size_t num_pages = _dict_sample_pages.size();
+    std::vector<OwnedSlice> plain_bodies(num_pages);
+    std::vector<OwnedSlice> dict_bodies(num_pages);
+    size_t plain_size = 0;
+    size_t dict_size = dict.size();
+    for (size_t i = 0; i < num_pages; ++i) {
+        auto& data = _dict_sample_pages[i]->data;
+        std::vector<Slice> body {data[0].slice(), data[1].slice()};
+        size_t uncompressed_size = Slice::compute_total_size(body);
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec.get(),
+                                                   _opts.compression_min_space_saving, body,
+                                                   &plain_bodies[i]));
+        plain_size += plain_bodies[i].slice().empty() ? uncompressed_size
+                                                      : plain_bodies[i].slice().size;
+        if (dict_codec != nullptr) {
+            RETURN_IF_ERROR(PageIO::compress_page_body(dict_codec.get(),
+                                                       _opts.compression_min_space_saving, body,
+                                                       &dict_bodies[i]));
+            dict_size += dict_bodies[i].slice().empty() ? uncompressed_size
+                                                        : dict_bodies[i].slice().size;
+        }
+    }
+    bool use_dict = dict_codec != nullptr && dict_size < plain_size;
+    for (size_t i = 0; i < num_pages; ++i) {
+        _set_sample_page_body(_dict_sample_pages[i],
+                              std::move(use_dict ? dict_bodies[i] : plain_bodies[i]), use_dict);
+    }
+    _dict_sample_pages.clear();
+    if (use_dict) {
+        VLOG_DEBUG << "use a zstd dictionary of " << dict.size() << " bytes for column "
+                   << get_field()->name() << ", size of the sample pages: " << plain_size
+                   << " -> " << dict_size;
+        _opts.meta->set_compression_dict(std::move(dict));
+        _dict_codec = std::move(dict_codec);
+    }
+    return Status::OK();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ArrayColumnWriter::ArrayColumnWriter(const ColumnWriterOptions& opts, std::unique_ptr<Field> field,
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory> // for unique_ptr
+#include <vector>
 
 #include "common/status.h"         // for Status
 #include "gen_cpp/segment_v2.pb.h" // for EncodingTypePB
@@ -25,6 +27,7 @@
 #include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
 #include "olap/tablet_schema.h"                  // for TabletColumn
 #include "util/bitmap.h"                         // for BitmapChange
+#include "util/faststring.h"
 #include "util/slice.h"                          // for OwnedSlice
 
 namespace doris {
@@ -50,23 +53,32 @@ struct ColumnWriterOptions {
     bool need_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    bool need_inverted_index = false;
+    bool need_ngram_bloom_filter = false;
+    // collect the ColumnStatisticsPB into meta
+    bool need_statistics = false;
     std::string to_string() const {
         std::stringstream ss;
         ss << std::boolalpha << "meta=" << meta->DebugString()
            << ", data_page_size=" << data_page_size
            << ", compression_min_space_saving = " << compression_min_space_saving
            << ", need_zone_map=" << need_zone_map << ", need_bitmap_index=" << need_bitmap_index
-           << ", need_bloom_filter" << need_bloom_filter;
+           << ", need_bloom_filter" << need_bloom_filter
+           << ", need_inverted_index=" << need_inverted_index
+           << ", need_ngram_bloom_filter=" << need_ngram_bloom_filter
+           << ", need_statistics=" << need_statistics;
         return ss.str();
     }
 };
 
 class BitmapIndexWriter;
+class ColumnStatisticsCollector;
 class EncodingInfo;
 class NullBitmapBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
 class BloomFilterIndexWriter;
+class InvertedIndexWriter;
 class ZoneMapIndexWriter;
 
 class ColumnWriter {
@@ -128,6 +140,8 @@ public:
 
     virtual Status write_bloom_filter_index() = 0;
 
+    virtual Status write_inverted_index() = 0;
+
     virtual ordinal_t get_next_rowid() const = 0;
 
     // used for append not null data.
@@ -184,6 +198,7 @@ public:
     Status write_zone_map() override;
     Status write_bitmap_index() override;
     Status write_bloom_filter_index() override;
+    Status write_inverted_index() override;
     ordinal_t get_next_rowid() const override { return _next_rowid; }
 
     void register_flush_page_callback(FlushPageCallback* flush_page_callback) {
@@ -203,6 +218,27 @@ private:
 
     const EncodingInfo* _encoding_info = nullptr;
 
+    // true while the encoding is chosen at write time, the non-null values of the current page
+    // are kept in _encoding_sample meanwhile
+    bool _sampling_encoding = false;
+    faststring _encoding_sample;
+
+    // If true, the encoding and the compression of each page are recorded in its footer.
+    // They are chosen for each of the first _num_pages_to_sample pages, the most frequent
+    // choice is used for the rest pages.
+    bool _adaptive_page_encoding = false;
+    int _num_pages_to_sample = 0;
+    int _num_sampled_pages = 0;
+    std::map<std::pair<EncodingTypePB, size_t>, int> _page_choices;
+    struct PageCodec {
+        CompressionTypePB type;
+        const BlockCompressionCodec* codec;
+    };
+    // the first one is the codec of the column
+    std::vector<PageCodec> _page_codecs;
+    std::vector<std::unique_ptr<BlockCompressionCodec>> _owned_page_codecs;
+    size_t _page_codec_idx = 0;
+
     ordinal_t _next_rowid = 0;
 
     // All Pages will be organized into a linked list
@@ -239,6 +275,17 @@ private:
     }
 
     Status _write_data_page(Page* page);
+    // replace the uncompressed body of a page kept to train the compression dictionary
+    void _set_sample_page_body(Page* page, OwnedSlice compressed_body, bool use_dict);
+    // train the compression dictionary from the sample pages and compress them
+    Status _train_compression_dict();
+
+    // choose the encoding of the column by encoding the values of the current page
+    Status _choose_encoding();
+    // the size of the encoded page after compression weighted by the decoding cost, and the
+    // index of the codec in _page_codecs giving it
+    Status _score_encoded_page(const Slice& encoded, size_t* codec_idx, double* score);
+    Status _record_page_choice(EncodingTypePB encoding, size_t codec_idx);
 
 private:
     io::FileWriter* _file_writer = nullptr;
@@ -251,10 +298,19 @@ private:
 
     std::unique_ptr<BlockCompressionCodec> _compress_codec;
 
+    // true while the first data pages are kept uncompressed in _dict_sample_pages, to train
+    // the ZSTD dictionary which compresses the data pages by _dict_codec
+    bool _training_compression_dict = false;
+    std::vector<Page*> _dict_sample_pages;
+    std::unique_ptr<BlockCompressionCodec> _dict_codec;
+
     std::unique_ptr<OrdinalIndexWriter> _ordinal_index_builder;
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
+    std::unique_ptr<InvertedIndexWriter> _inverted_index_builder;
+    std::unique_ptr<ColumnStatisticsCollector> _statistics_collector;
 
     // call before flush data page.
     FlushPageCallback* _new_page_callback = nullptr;
@@ -302,11 +358,17 @@ public:
         return Status::OK();
     }
     Status write_bloom_filter_index() override {
-        if (_opts.need_bloom_filter) {
+        if (_opts.need_bloom_filter || _opts.need_ngram_bloom_filter) {
             return Status::NotSupported("array not support bloom filter index");
         }
         return Status::OK();
     }
+    Status write_inverted_index() override {
+        if (_opts.need_inverted_index) {
+            return Status::NotSupported("array not support inverted index");
+        }
+        return Status::OK();
+    }
     ordinal_t get_next_rowid() const override { return _length_writer->get_next_rowid(); }
 
 private:
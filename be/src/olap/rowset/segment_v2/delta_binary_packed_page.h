@@ -0,0 +1,291 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "gutil/port.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "olap/rowset/segment_v2/page_builder.h"
+#include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/types.h"
+#include "util/bit_packing.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Delta + bit-packing encoding for integer columns, it is very compact for monotonic data like
+// auto increment ids and timestamps.
+//
+// The format of a page is:
+//
+//   NumValues: uint32
+//   FirstValue: uint64, the first value widened to 64 bits
+//   MiniBlock * ceil((NumValues - 1) / DELTA_MINI_BLOCK_SIZE):
+//     MinDelta: uint64
+//     BitWidth: uint8
+//     Deltas: the (delta - MinDelta) of up to DELTA_MINI_BLOCK_SIZE values bit-packed
+//             with BitWidth bits
+//   Padding: BitPacking::PADDING_BYTES zero bytes
+//
+// All the arithmetic is done on uint64 with wrap around, so any delta can be represented
+// and it is reversed exactly by the decoder.
+enum { DELTA_MINI_BLOCK_SIZE = 128, DELTA_PAGE_HEADER_SIZE = 12 };
+
+template <FieldType Type>
+class DeltaBinaryPackedPageBuilder : public PageBuilder {
+public:
+    explicit DeltaBinaryPackedPageBuilder(const PageBuilderOptions& options)
+            : _options(options), _finished(false) {
+        reset();
+    }
+
+    bool is_page_full() override { return _values.size() >= _capacity; }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        size_t to_add = std::min(*count, _capacity - std::min(_capacity, _values.size()));
+        size_t orig_size = _values.size();
+        _values.resize(orig_size + to_add);
+        memcpy(&_values[orig_size], vals, to_add * SIZE_OF_TYPE);
+        *count = to_add;
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _buffer.clear();
+        put_fixed32_le(&_buffer, _values.size());
+        put_fixed64_le(&_buffer, _values.empty() ? 0 : _widen(_values[0]));
+
+        uint64_t deltas[DELTA_MINI_BLOCK_SIZE];
+        for (size_t start = 1; start < _values.size(); start += DELTA_MINI_BLOCK_SIZE) {
+            size_t num = std::min<size_t>(DELTA_MINI_BLOCK_SIZE, _values.size() - start);
+            int64_t min_delta = std::numeric_limits<int64_t>::max();
+            for (size_t i = 0; i < num; ++i) {
+                deltas[i] = _widen(_values[start + i]) - _widen(_values[start + i - 1]);
+                min_delta = std::min(min_delta, static_cast<int64_t>(deltas[i]));
+            }
+            uint64_t max_adjusted = 0;
+            for (size_t i = 0; i < num; ++i) {
+                deltas[i] -= static_cast<uint64_t>(min_delta);
+                max_adjusted = std::max(max_adjusted, deltas[i]);
+            }
+            int width = BitPacking::bit_width(max_adjusted);
+            put_fixed64_le(&_buffer, static_cast<uint64_t>(min_delta));
+            _buffer.push_back(static_cast<char>(width));
+            BitPacking::pack(deltas, num, width, &_buffer);
+        }
+        _buffer.resize(_buffer.size() + BitPacking::PADDING_BYTES);
+        memset(_buffer.data() + _buffer.size() - BitPacking::PADDING_BYTES, 0,
+               BitPacking::PADDING_BYTES);
+        return _buffer.build();
+    }
+
+    void reset() override {
+        _values.clear();
+        _capacity = std::max<size_t>(1, _options.data_page_size / SIZE_OF_TYPE);
+        _values.reserve(_capacity);
+        _buffer.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _values.size() * SIZE_OF_TYPE; }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    static_assert(std::is_integral<CppType>::value && sizeof(CppType) <= 8,
+                  "delta binary packed encoding only supports integers up to 64 bits");
+
+    // sign extend signed values so that the deltas of negative values are small too
+    static uint64_t _widen(CppType v) {
+        if constexpr (std::is_signed<CppType>::value) {
+            return static_cast<uint64_t>(static_cast<int64_t>(v));
+        } else {
+            return static_cast<uint64_t>(v);
+        }
+    }
+
+    PageBuilderOptions _options;
+    bool _finished;
+    size_t _capacity;
+    std::vector<CppType> _values;
+    faststring _buffer;
+};
+
+template <FieldType Type>
+class DeltaBinaryPackedPageDecoder : public PageDecoder {
+public:
+    DeltaBinaryPackedPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _parsed(false), _num_elements(0), _cur_index(0) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < DELTA_PAGE_HEADER_SIZE + BitPacking::PADDING_BYTES) {
+            return Status::Corruption(
+                    fmt::format("delta binary packed page is too small: {}", _data.size));
+        }
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(_data.data);
+        const uint8_t* end = ptr + _data.size - BitPacking::PADDING_BYTES;
+        _num_elements = decode_fixed32_le(ptr);
+        uint64_t value = decode_fixed64_le(ptr + 4);
+        ptr += DELTA_PAGE_HEADER_SIZE;
+
+        _values.reset(new CppType[std::max<size_t>(1, _num_elements)]);
+        if (_num_elements > 0) {
+            _values[0] = static_cast<CppType>(value);
+        }
+        uint64_t deltas[DELTA_MINI_BLOCK_SIZE];
+        for (size_t start = 1; start < _num_elements; start += DELTA_MINI_BLOCK_SIZE) {
+            size_t num = std::min<size_t>(DELTA_MINI_BLOCK_SIZE, _num_elements - start);
+            if (PREDICT_FALSE(ptr + 9 > end)) {
+                return Status::Corruption("delta binary packed page is truncated");
+            }
+            uint64_t min_delta = decode_fixed64_le(ptr);
+            int width = ptr[8];
+            ptr += 9;
+            size_t packed_bytes = BitPacking::packed_bytes(num, width);
+            if (PREDICT_FALSE(width > 64 || ptr + packed_bytes > end)) {
+                return Status::Corruption("delta binary packed page is truncated");
+            }
+            BitPacking::unpack(ptr, 0, num, width, deltas);
+            ptr += packed_bytes;
+            for (size_t i = 0; i < num; ++i) {
+                deltas[i] += min_delta;
+            }
+            CppType* out = &_values[start];
+            for (size_t i = 0; i < num; ++i) {
+                value += deltas[i];
+                out[i] = static_cast<CppType>(value);
+            }
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init()";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (_num_elements == 0) {
+            return Status::NotFound("page is empty");
+        }
+        CppType target;
+        memcpy(&target, value, SIZE_OF_TYPE);
+        // only valid for sorted pages, like the other value seek implementations
+        auto it = std::lower_bound(&_values[0], &_values[0] + _num_elements, target);
+        size_t pos = it - &_values[0];
+        if (pos >= _num_elements) {
+            return Status::NotFound("all value small than the value");
+        }
+        *exact_match = _values[pos] == target;
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override { return next_batch<true>(n, dst); }
+
+    template <bool forward_index>
+    Status next_batch(size_t* n, ColumnBlockView* dst) {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        memcpy(dst->data(), &_values[_cur_index], max_fetch * SIZE_OF_TYPE);
+        *n = max_fetch;
+        if (forward_index) {
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        dst->insert_many_fix_len_data(reinterpret_cast<const char*>(&_values[_cur_index]),
+                                      max_fetch);
+        *n = max_fetch;
+        _cur_index += max_fetch;
+        return Status::OK();
+    }
+
+    Status peek_next_batch(size_t* n, ColumnBlockView* dst) override {
+        return next_batch<false>(n, dst);
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    Slice _data;
+    bool _parsed;
+    size_t _num_elements;
+    size_t _cur_index;
+    // the page is decoded entirely in init(), so that seeking is O(1)
+    std::unique_ptr<CppType[]> _values;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,319 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <fmt/format.h>
+#include <parallel_hashmap/phmap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "gutil/port.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "olap/rowset/segment_v2/page_builder.h"
+#include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/types.h"
+#include "util/bit_packing.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Dictionary encoding for low cardinality integer columns, like status codes.
+//
+// Unlike BinaryDictPage, the dictionary is kept in the page itself, so that a page can be
+// decoded without any other page and pages of a column can have different dictionaries.
+// The dictionary is sorted, so the order of the codes is the same as the order of the values.
+//
+// The format of a page is:
+//
+//   NumValues: uint32
+//   NumDictValues: uint32
+//   BitWidth: uint8, bit width of the codes, it is determined by NumDictValues
+//   DictValues: NumDictValues * SIZE_OF_TYPE, sorted in ascending order
+//   Codes: NumValues codes bit-packed with BitWidth bits
+//   Padding: BitPacking::PADDING_BYTES zero bytes
+enum { INT_DICT_PAGE_HEADER_SIZE = 9 };
+
+template <FieldType Type>
+class IntDictPageBuilder : public PageBuilder {
+public:
+    explicit IntDictPageBuilder(const PageBuilderOptions& options)
+            : _options(options), _finished(false) {
+        reset();
+    }
+
+    // the page is full when there are too many values or too many distinct values
+    bool is_page_full() override {
+        return _codes.size() >= _capacity || _dict_values.size() >= _max_dict_size;
+    }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        const CppType* values = reinterpret_cast<const CppType*>(vals);
+        size_t to_add = std::min(*count, _capacity - std::min(_capacity, _codes.size()));
+        size_t added = 0;
+        for (; added < to_add; ++added) {
+            CppType value;
+            memcpy(&value, &values[added], SIZE_OF_TYPE);
+            auto it = _dictionary.find(value);
+            if (it != _dictionary.end()) {
+                _codes.push_back(it->second);
+                continue;
+            }
+            if (_dict_values.size() >= _max_dict_size) {
+                break;
+            }
+            uint32_t code = _dict_values.size();
+            _dictionary.emplace(value, code);
+            _dict_values.push_back(value);
+            _codes.push_back(code);
+        }
+        if (added > 0) {
+            if (_codes.size() == added) {
+                memcpy(&_first_value, &values[0], SIZE_OF_TYPE);
+            }
+            memcpy(&_last_value, &values[added - 1], SIZE_OF_TYPE);
+        }
+        *count = added;
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        // sort the dictionary, and remap the codes to the ranks of their values
+        std::vector<uint32_t> order(_dict_values.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [this](uint32_t l, uint32_t r) { return _dict_values[l] < _dict_values[r]; });
+        std::vector<uint64_t> ranks(_dict_values.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            ranks[order[i]] = i;
+        }
+        int width = _dict_values.size() <= 1 ? 0 : BitPacking::bit_width(_dict_values.size() - 1);
+
+        _buffer.clear();
+        put_fixed32_le(&_buffer, _codes.size());
+        put_fixed32_le(&_buffer, _dict_values.size());
+        _buffer.push_back(static_cast<char>(width));
+        for (uint32_t idx : order) {
+            _buffer.append(&_dict_values[idx], SIZE_OF_TYPE);
+        }
+        std::vector<uint64_t> codes(_codes.size());
+        for (size_t i = 0; i < _codes.size(); ++i) {
+            codes[i] = ranks[_codes[i]];
+        }
+        BitPacking::pack(codes.data(), codes.size(), width, &_buffer);
+        _buffer.resize(_buffer.size() + BitPacking::PADDING_BYTES);
+        memset(_buffer.data() + _buffer.size() - BitPacking::PADDING_BYTES, 0,
+               BitPacking::PADDING_BYTES);
+        return _buffer.build();
+    }
+
+    void reset() override {
+        _codes.clear();
+        _dict_values.clear();
+        _dictionary.clear();
+        _capacity = std::max<size_t>(1, _options.data_page_size / SIZE_OF_TYPE);
+        _max_dict_size = std::max<size_t>(1, _options.dict_page_size / SIZE_OF_TYPE);
+        _codes.reserve(_capacity);
+        _buffer.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _codes.size(); }
+
+    uint64_t size() const override {
+        return _dict_values.size() * SIZE_OF_TYPE +
+               BitPacking::packed_bytes(_codes.size(), _max_code_width());
+    }
+
+    Status get_first_value(void* value) const override {
+        if (_codes.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_codes.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    static_assert(std::is_integral<CppType>::value, "int dict encoding only supports integers");
+
+    int _max_code_width() const {
+        return _dict_values.size() <= 1 ? 0 : BitPacking::bit_width(_dict_values.size() - 1);
+    }
+
+    PageBuilderOptions _options;
+    bool _finished;
+    size_t _capacity;
+    size_t _max_dict_size;
+    // codes in the order of insertion, remapped to the sorted dictionary in finish()
+    std::vector<uint32_t> _codes;
+    std::vector<CppType> _dict_values;
+    phmap::flat_hash_map<CppType, uint32_t> _dictionary;
+    faststring _buffer;
+    CppType _first_value;
+    CppType _last_value;
+};
+
+template <FieldType Type>
+class IntDictPageDecoder : public PageDecoder {
+public:
+    IntDictPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data),
+              _parsed(false),
+              _num_elements(0),
+              _num_dict_values(0),
+              _bit_width(0),
+              _dict(nullptr),
+              _codes(nullptr),
+              _cur_index(0) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < INT_DICT_PAGE_HEADER_SIZE + BitPacking::PADDING_BYTES) {
+            return Status::Corruption(fmt::format("int dict page is too small: {}", _data.size));
+        }
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(_data.data);
+        _num_elements = decode_fixed32_le(ptr);
+        _num_dict_values = decode_fixed32_le(ptr + 4);
+        _bit_width = ptr[8];
+        int expected_width =
+                _num_dict_values <= 1 ? 0 : BitPacking::bit_width(_num_dict_values - 1);
+        size_t expected_size = INT_DICT_PAGE_HEADER_SIZE + _num_dict_values * SIZE_OF_TYPE +
+                               BitPacking::packed_bytes(_num_elements, _bit_width) +
+                               BitPacking::PADDING_BYTES;
+        if (_bit_width != expected_width || _data.size != expected_size ||
+            (_num_elements > 0 && _num_dict_values == 0)) {
+            return Status::Corruption(fmt::format(
+                    "invalid int dict page, num values: {}, num dict values: {}, bit width: {}, "
+                    "page size: {}",
+                    _num_elements, _num_dict_values, _bit_width, _data.size));
+        }
+        _dict = ptr + INT_DICT_PAGE_HEADER_SIZE;
+        _codes = _dict + _num_dict_values * SIZE_OF_TYPE;
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init()";
+        DCHECK_LE(pos, _num_elements);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override { return next_batch<true>(n, dst); }
+
+    template <bool forward_index>
+    Status next_batch(size_t* n, ColumnBlockView* dst) {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        _copy_values(_cur_index, max_fetch, dst->data());
+        *n = max_fetch;
+        if (forward_index) {
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, _num_elements - _cur_index);
+        CppType values[DECODE_BATCH_SIZE];
+        for (size_t done = 0; done < max_fetch;) {
+            size_t num = std::min<size_t>(DECODE_BATCH_SIZE, max_fetch - done);
+            _copy_values(_cur_index + done, num, values);
+            dst->insert_many_fix_len_data(reinterpret_cast<const char*>(values), num);
+            done += num;
+        }
+        *n = max_fetch;
+        _cur_index += max_fetch;
+        return Status::OK();
+    }
+
+    Status peek_next_batch(size_t* n, ColumnBlockView* dst) override {
+        return next_batch<false>(n, dst);
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+    size_t num_dict_values() const { return _num_dict_values; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size, DECODE_BATCH_SIZE = 256 };
+
+    // the codes are fixed width, so any range of them can be unpacked without touching the
+    // codes before it
+    void _copy_values(size_t first, size_t num, void* data) const {
+        uint8_t* out = reinterpret_cast<uint8_t*>(data);
+        uint64_t codes[DECODE_BATCH_SIZE];
+        for (size_t done = 0; done < num;) {
+            size_t batch = std::min<size_t>(DECODE_BATCH_SIZE, num - done);
+            BitPacking::unpack(_codes, first + done, batch, _bit_width, codes);
+            for (size_t i = 0; i < batch; ++i) {
+                memcpy(out + (done + i) * SIZE_OF_TYPE,
+                       _dict + std::min<uint64_t>(codes[i], _num_dict_values - 1) * SIZE_OF_TYPE,
+                       SIZE_OF_TYPE);
+            }
+            done += batch;
+        }
+    }
+
+    Slice _data;
+    bool _parsed;
+    size_t _num_elements;
+    size_t _num_dict_values;
+    int _bit_width;
+    const uint8_t* _dict;
+    const uint8_t* _codes;
+    size_t _cur_index;
+};
+
+} // namespace segment_v2
+} // namespace doris
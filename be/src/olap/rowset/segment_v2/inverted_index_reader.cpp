@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
+
+#include <cstring>
+
+#include "olap/column_block.h"
+#include "olap/types.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status InvertedIndexReader::load(bool use_page_cache, bool kept_in_memory) {
+    const IndexedColumnMetaPB& dict_meta = _inverted_index_meta->dict_column();
+    const IndexedColumnMetaPB& posting_meta = _inverted_index_meta->posting_column();
+
+    _dict_column_reader.reset(new IndexedColumnReader(_fs, _path, dict_meta));
+    _posting_column_reader.reset(new IndexedColumnReader(_fs, _path, posting_meta));
+    RETURN_IF_ERROR(_dict_column_reader->load(use_page_cache, kept_in_memory));
+    RETURN_IF_ERROR(_posting_column_reader->load(use_page_cache, kept_in_memory));
+    return Status::OK();
+}
+
+Status InvertedIndexReader::new_iterator(InvertedIndexIterator** iterator) {
+    *iterator = new InvertedIndexIterator(this);
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::read_term(const Slice& term, roaring::Roaring* result) {
+    bool exact_match = false;
+    Status st = _dict_column_iter.seek_at_or_after(&term, &exact_match);
+    if (st.is_not_found()) {
+        return Status::OK(); // all tokens < term
+    }
+    RETURN_IF_ERROR(st);
+    if (exact_match) {
+        RETURN_IF_ERROR(_read_posting(_dict_column_iter.get_current_ordinal(), result));
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::read_terms_containing(const Slice& word, roaring::Roaring* result) {
+    const int64_t num_terms = _reader->num_terms();
+    const size_t batch_size = 1024;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(batch_size, false,
+                                              get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>(),
+                                              nullptr, &cvb));
+    std::vector<ordinal_t> matched_ordinals;
+    for (ordinal_t start = 0; start < num_terms; start += batch_size) {
+        ColumnBlock block(cvb.get(), _pool.get());
+        ColumnBlockView column_block_view(&block);
+        RETURN_IF_ERROR(_dict_column_iter.seek_to_ordinal(start));
+        size_t num_read = std::min<int64_t>(batch_size, num_terms - start);
+        RETURN_IF_ERROR(_dict_column_iter.next_batch(&num_read, &column_block_view));
+        auto terms = reinterpret_cast<const Slice*>(block.data());
+        for (size_t i = 0; i < num_read; ++i) {
+            if (terms[i].size >= word.size &&
+                memmem(terms[i].data, terms[i].size, word.data, word.size) != nullptr) {
+                matched_ordinals.push_back(start + i);
+            }
+        }
+        _pool->clear();
+    }
+    for (auto ordinal : matched_ordinals) {
+        roaring::Roaring bitmap;
+        RETURN_IF_ERROR(_read_posting(ordinal, &bitmap));
+        *result |= bitmap;
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::_read_posting(ordinal_t ordinal, roaring::Roaring* result) {
+    size_t num_to_read = 1;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(
+            num_to_read, false, get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>(), nullptr, &cvb));
+    ColumnBlock block(cvb.get(), _pool.get());
+    ColumnBlockView column_block_view(&block);
+
+    RETURN_IF_ERROR(_posting_column_iter.seek_to_ordinal(ordinal));
+    size_t num_read = num_to_read;
+    RETURN_IF_ERROR(_posting_column_iter.next_batch(&num_read, &column_block_view));
+    DCHECK(num_to_read == num_read);
+
+    *result = roaring::Roaring::read(reinterpret_cast<const Slice*>(block.data())->data, false);
+    _pool->clear();
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
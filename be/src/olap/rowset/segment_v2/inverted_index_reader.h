@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <roaring/roaring.hh>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "io/fs/file_system.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "runtime/mem_pool.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace segment_v2 {
+
+class InvertedIndexIterator;
+
+class InvertedIndexReader {
+public:
+    explicit InvertedIndexReader(io::FileSystem* fs, const std::string& path,
+                                 const InvertedIndexPB* inverted_index_meta)
+            : _fs(fs), _path(path), _inverted_index_meta(inverted_index_meta) {}
+
+    Status load(bool use_page_cache, bool kept_in_memory);
+
+    // create a new index iterator. Client should delete returned iterator
+    Status new_iterator(InvertedIndexIterator** iterator);
+
+    int64_t num_terms() const { return _dict_column_reader->num_values(); }
+
+private:
+    friend class InvertedIndexIterator;
+
+    io::FileSystem* _fs;
+    std::string _path;
+    const InvertedIndexPB* _inverted_index_meta;
+    std::unique_ptr<IndexedColumnReader> _dict_column_reader;
+    std::unique_ptr<IndexedColumnReader> _posting_column_reader;
+};
+
+class InvertedIndexIterator {
+public:
+    explicit InvertedIndexIterator(InvertedIndexReader* reader)
+            : _reader(reader),
+              _dict_column_iter(reader->_dict_column_reader.get()),
+              _posting_column_iter(reader->_posting_column_reader.get()),
+              _pool(new MemPool("InvertedIndexIterator")) {}
+
+    // Read the rows having the token `term` into `result`.
+    Status read_term(const Slice& term, roaring::Roaring* result);
+
+    // Read the rows having any token containing `word` into `result`, by scanning the
+    // dictionary of the tokens.
+    Status read_terms_containing(const Slice& word, roaring::Roaring* result);
+
+private:
+    Status _read_posting(ordinal_t ordinal, roaring::Roaring* result);
+
+    InvertedIndexReader* _reader;
+    IndexedColumnIterator _dict_column_iter;
+    IndexedColumnIterator _posting_column_iter;
+    std::unique_ptr<MemPool> _pool;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
+namespace doris {
+namespace segment_v2 {
+
+// The tokenizer of inverted index. A text is split into the maximal runs of token chars,
+// i.e. ASCII letters and digits, and the bytes of multi-byte UTF-8 chars. The tokens keep
+// their case, so that the index is exact for case-sensitive matching.
+inline bool is_token_char(uint8_t c) {
+    return c >= 0x80 || std::isalnum(c);
+}
+
+// Call `fn(const char* token, size_t len)` for each token of the text.
+template <typename Fn>
+void for_each_token(const char* data, size_t len, Fn&& fn) {
+    size_t i = 0;
+    while (i < len) {
+        while (i < len && !is_token_char(data[i])) {
+            ++i;
+        }
+        size_t begin = i;
+        while (i < len && is_token_char(data[i])) {
+            ++i;
+        }
+        if (i > begin) {
+            fn(data + begin, i - begin);
+        }
+    }
+}
+
+// Whether `word` can not span several tokens, so the texts containing it are exactly the
+// texts having a token containing it.
+inline bool is_single_token(const char* data, size_t len) {
+    if (len == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        if (!is_token_char(data[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,111 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
+
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/indexed_column_writer.h"
+#include "olap/rowset/segment_v2/inverted_index_tokenizer.h"
+#include "olap/types.h"
+#include "util/faststring.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status InvertedIndexWriter::create(const TypeInfo* type_info,
+                                   std::unique_ptr<InvertedIndexWriter>* res) {
+    FieldType type = type_info->type();
+    switch (type) {
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_STRING:
+        res->reset(new InvertedIndexWriter());
+        break;
+    default:
+        return Status::NotSupported("unsupported type for inverted index: " +
+                                    std::to_string(type));
+    }
+    return Status::OK();
+}
+
+void InvertedIndexWriter::add_values(const void* values, size_t count) {
+    auto p = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; ++i, ++p) {
+        for_each_token(p->data, p->size, [this](const char* token, size_t len) {
+            auto it = _mem_index.find(std::string_view(token, len));
+            if (it == _mem_index.end()) {
+                it = _mem_index.emplace(std::string(token, len), roaring::Roaring()).first;
+                _size += len + sizeof(roaring::Roaring);
+            }
+            uint64_t old_size = it->second.getSizeInBytes(false);
+            it->second.add(_rid);
+            _size += it->second.getSizeInBytes(false) - old_size;
+        });
+        _rid++;
+    }
+}
+
+Status InvertedIndexWriter::finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(INVERTED_INDEX);
+    InvertedIndexPB* meta = index_meta->mutable_inverted_index();
+    meta->set_tokenizer(InvertedIndexPB::ALNUM_TOKENIZER);
+
+    { // write dictionary
+        const auto* dict_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+        IndexedColumnWriterOptions options;
+        // the ordinal index is for scanning the tokens in order
+        options.write_ordinal_index = true;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(dict_type_info, true);
+        options.compression = LZ4F;
+
+        IndexedColumnWriter dict_column_writer(options, dict_type_info, file_writer);
+        RETURN_IF_ERROR(dict_column_writer.init());
+        for (auto const& it : _mem_index) {
+            Slice token(it.first);
+            RETURN_IF_ERROR(dict_column_writer.add(&token));
+        }
+        RETURN_IF_ERROR(dict_column_writer.finish(meta->mutable_dict_column()));
+    }
+    { // write posting lists
+        const auto* bitmap_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_OBJECT>();
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_type_info, false);
+        // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter posting_column_writer(options, bitmap_type_info, file_writer);
+        RETURN_IF_ERROR(posting_column_writer.init());
+
+        faststring buf;
+        for (auto& it : _mem_index) {
+            auto& bitmap = it.second;
+            bitmap.runOptimize();
+            buf.resize(bitmap.getSizeInBytes(false));
+            bitmap.write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(posting_column_writer.add(&buf_slice));
+        }
+        RETURN_IF_ERROR(posting_column_writer.finish(meta->mutable_posting_column()));
+    }
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+#include <string_view>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace io {
+class FileWriter;
+}
+
+namespace segment_v2 {
+
+// Builder for inverted index of string columns. Inverted index is comprised of two parts like
+// bitmap index, but is keyed by the tokens of the values instead of the whole values
+// - an "ordered dictionary" which contains all distinct tokens of a column
+// - a posting list which stores one bitmap for each token in the dictionary, containing the
+//   rowid of the values having the token
+//
+// E.g, for the rows ['GET /index.html', 'POST /index.html', 'GET /a.png'], the dictionary
+// would be ['GET', 'POST', 'a', 'html', 'index', 'png'] and the bitmaps would be
+// [0 2], [1], [2], [0 1], [0 1], [2].
+class InvertedIndexWriter {
+public:
+    static Status create(const TypeInfo* type_info, std::unique_ptr<InvertedIndexWriter>* res);
+
+    InvertedIndexWriter() = default;
+    ~InvertedIndexWriter() = default;
+
+    // `values` points to Slices
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) { _rid += count; }
+
+    Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const { return _size; }
+
+private:
+    rowid_t _rid = 0;
+    uint64_t _size = 0;
+    // token to its row id list
+    std::map<std::string, roaring::Roaring, std::less<>> _mem_index;
+
+    DISALLOW_COPY_AND_ASSIGN(InvertedIndexWriter);
+};
+
+} // namespace segment_v2
+} // namespace doris
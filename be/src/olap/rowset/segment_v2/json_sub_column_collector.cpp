@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/json_sub_column_collector.h"
+
+#include <algorithm>
+
+namespace doris {
+namespace segment_v2 {
+
+void JsonSubColumnCollector::add(const BinaryJsonValue& value) {
+    ++_num_rows;
+    if (!value.is_valid() || value.type() != BinaryJsonValue::OBJECT) {
+        return;
+    }
+    for (uint32_t i = 0; i < value.count(); ++i) {
+        auto key = value.member_key(i);
+        auto it = _keys.find(std::string(key));
+        if (it == _keys.end()) {
+            if (_keys.size() >= _max_keys) {
+                continue;
+            }
+            it = _keys.emplace(std::string(key), KeyStats()).first;
+        }
+        ++it->second.count;
+        auto type = value.member_value(i).type();
+        if (type != BinaryJsonValue::NULL_VALUE) {
+            it->second.types |= 1U << type;
+        }
+    }
+}
+
+bool JsonSubColumnCollector::_to_field_type(uint32_t types, FieldType* type) {
+    constexpr uint32_t BOOL_TYPES =
+            (1U << BinaryJsonValue::TRUE_VALUE) | (1U << BinaryJsonValue::FALSE_VALUE);
+    constexpr uint32_t NUMBER_TYPES =
+            (1U << BinaryJsonValue::INT64) | (1U << BinaryJsonValue::DOUBLE);
+    if (types == 0) {
+        // all values are null, nothing to be gained from a sub-column
+        return false;
+    }
+    if ((types & ~BOOL_TYPES) == 0) {
+        *type = OLAP_FIELD_TYPE_BOOL;
+    } else if (types == (1U << BinaryJsonValue::INT64)) {
+        *type = OLAP_FIELD_TYPE_BIGINT;
+    } else if ((types & ~NUMBER_TYPES) == 0) {
+        *type = OLAP_FIELD_TYPE_DOUBLE;
+    } else if (types == (1U << BinaryJsonValue::STRING)) {
+        *type = OLAP_FIELD_TYPE_STRING;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<JsonSubColumnCollector::SubColumn> JsonSubColumnCollector::frequent_keys(
+        double min_ratio, size_t max_columns) const {
+    std::vector<SubColumn> columns;
+    for (auto& [key, stats] : _keys) {
+        FieldType type;
+        if (stats.count >= min_ratio * _num_rows && _to_field_type(stats.types, &type)) {
+            columns.push_back({key, type, stats.count});
+        }
+    }
+    std::sort(columns.begin(), columns.end(), [](const SubColumn& lhs, const SubColumn& rhs) {
+        return lhs.count > rhs.count || (lhs.count == rhs.count && lhs.key < rhs.key);
+    });
+    if (columns.size() > max_columns) {
+        columns.resize(max_columns);
+    }
+    return columns;
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "olap/olap_common.h"
+#include "util/binary_json.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Collects the top level keys of the json values written to a segment, to find the keys
+// frequent enough and of a single scalar type, which are worth storing as typed
+// sub-columns with their own zone maps. The other keys stay in the binary json value.
+class JsonSubColumnCollector {
+public:
+    struct SubColumn {
+        std::string key;
+        FieldType type;
+        // the number of rows in which the key is present
+        size_t count;
+    };
+
+    // Keys first seen after max_keys distinct keys are ignored, to bound the memory.
+    explicit JsonSubColumnCollector(size_t max_keys = 1024) : _max_keys(max_keys) {}
+
+    // null values and values other than objects are counted as rows without keys
+    void add(const BinaryJsonValue& value);
+
+    size_t num_rows() const { return _num_rows; }
+
+    // Returns at most max_columns keys present in at least min_ratio of the rows, by
+    // descending count. A key is dropped if it has nested or conflicting types, an int
+    // key with some double values is typed as double.
+    std::vector<SubColumn> frequent_keys(double min_ratio, size_t max_columns) const;
+
+private:
+    struct KeyStats {
+        size_t count = 0;
+        // bitmask of the types of the non null values, by BinaryJsonValue::Type
+        uint32_t types = 0;
+    };
+
+    static bool _to_field_type(uint32_t types, FieldType* type);
+
+    size_t _max_keys;
+    size_t _num_rows = 0;
+    std::unordered_map<std::string, KeyStats> _keys;
+};
+
+} // namespace segment_v2
+} // namespace doris
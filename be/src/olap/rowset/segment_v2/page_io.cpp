@@ -18,23 +18,43 @@
 #include "olap/rowset/segment_v2/page_io.h"
 
 #include <cstring>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_writer.h"
 #include "olap/page_cache.h"
+#include "olap/page_cache_warmer.h"
 #include "util/block_compression.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/doris_metrics.h"
 #include "util/faststring.h"
+#include "util/query_trace.h"
 #include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace doris {
 namespace segment_v2 {
 
 using strings::Substitute;
 
+// Return the codec of a page which records its own compression type. The codecs are cached
+// per thread because some of them (e.g. ZSTD) keep a context which can't be shared.
+static Status get_page_codec(CompressionTypePB type, const BlockCompressionCodec** codec) {
+    static thread_local std::unordered_map<int, std::unique_ptr<BlockCompressionCodec>> codecs;
+    auto it = codecs.find(type);
+    if (it == codecs.end()) {
+        std::unique_ptr<BlockCompressionCodec> new_codec;
+        RETURN_IF_ERROR(get_block_compression_codec(type, new_codec));
+        it = codecs.emplace(type, std::move(new_codec)).first;
+    }
+    *codec = it->second.get();
+    return Status::OK();
+}
+
 Status PageIO::compress_page_body(const BlockCompressionCodec* codec, double min_space_saving,
                                   const std::vector<Slice>& body, OwnedSlice* compressed_body) {
     size_t uncompressed_size = Slice::compute_total_size(body);
@@ -144,9 +164,13 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     Slice page_slice(page.get(), page_size);
     {
         SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        SCOPED_QUERY_TRACE("storage", "read_page");
+        int64_t start_ns = MonotonicNanos();
         size_t bytes_read = 0;
         RETURN_IF_ERROR(
                 opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read));
+        DorisMetrics::instance()->page_read_latency_us->add((MonotonicNanos() - start_ns) /
+                                                            NANOS_PER_MICRO);
         DCHECK_EQ(bytes_read, page_size);
         opts.stats->compressed_bytes_read += page_size;
     }
@@ -170,17 +194,28 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     uint32_t body_size = page_slice.size - 4 - footer_size;
     if (body_size != footer->uncompressed_size()) { // need decompress body
-        if (opts.codec == nullptr) {
+        const BlockCompressionCodec* codec = opts.codec;
+        if (footer->use_compression_dict()) {
+            codec = opts.dict_codec;
+            if (codec == nullptr) {
+                return Status::Corruption(
+                        "Bad page: page is compressed with dictionary but column has none");
+            }
+        } else if (footer->has_compression()) {
+            RETURN_IF_ERROR(get_page_codec(footer->compression(), &codec));
+        }
+        if (codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
         SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
+        SCOPED_QUERY_TRACE("storage", "decompress_page");
         std::unique_ptr<char[]> decompressed_page(
                 new char[footer->uncompressed_size() + footer_size + 4]);
 
         // decompress page body
         Slice compressed_body(page_slice.data, body_size);
         Slice decompressed_body(decompressed_page.get(), footer->uncompressed_size());
-        RETURN_IF_ERROR(opts.codec->decompress(compressed_body, &decompressed_body));
+        RETURN_IF_ERROR(codec->decompress(compressed_body, &decompressed_body));
         if (decompressed_body.size != footer->uncompressed_size()) {
             return Status::Corruption(strings::Substitute(
                     "Bad page: record uncompressed size=$0 vs real decompressed size=$1",
@@ -198,7 +233,14 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     if (opts.encoding_info) {
-        auto* pre_decoder = opts.encoding_info->get_data_page_pre_decoder();
+        const EncodingInfo* encoding_info = opts.encoding_info;
+        if (footer->data_page_footer().has_encoding() &&
+            footer->data_page_footer().encoding() != encoding_info->encoding()) {
+            RETURN_IF_ERROR(EncodingInfo::get(encoding_info->type(),
+                                              footer->data_page_footer().encoding(),
+                                              &encoding_info));
+        }
+        auto* pre_decoder = encoding_info->get_data_page_pre_decoder();
         if (pre_decoder) {
             RETURN_IF_ERROR(pre_decoder->decode(
                     &page, &page_slice,
@@ -207,10 +249,23 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
+    if (opts.use_page_cache && opts.fill_page_cache && cache->is_cache_available(opts.type)) {
         // insert this page into cache and return the cache handle
         cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
+        // the dictionaries are not known when warming up the cache
+        auto warmer = PageCacheWarmer::instance();
+        if (warmer != nullptr && !footer->use_compression_dict()) {
+            PageCacheWarmer::PageInfo info;
+            info.size = page_size;
+            info.type = opts.type;
+            info.compression = opts.codec ? opts.codec->type() : NO_COMPRESSION;
+            info.field_type =
+                    opts.encoding_info ? opts.encoding_info->type() : OLAP_FIELD_TYPE_UNKNOWN;
+            info.encoding = opts.encoding_info ? opts.encoding_info->encoding() : DEFAULT_ENCODING;
+            info.kept_in_memory = opts.kept_in_memory;
+            warmer->add(cache_key, info);
+        }
     } else {
         *handle = PageHandle(page_slice);
     }
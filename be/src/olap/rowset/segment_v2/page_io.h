@@ -51,12 +51,16 @@ struct PageReadOptions {
     PagePointer page_pointer;
     // decompressor for page body (null means page body is not compressed)
     const BlockCompressionCodec* codec = nullptr;
+    // decompressor for the page body compressed with the dictionary of the column
+    const BlockCompressionCodec* dict_codec = nullptr;
     // used to collect IO metrics
     OlapReaderStatistics* stats = nullptr;
     // whether to verify page checksum
     bool verify_checksum = true;
     // whether to use page cache in read path
     bool use_page_cache = true;
+    // whether to insert the page into page cache if it's not cached, only if use_page_cache
+    bool fill_page_cache = true;
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/primary_key_index.h"
+
+#include "common/config.h"
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/types.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status PrimaryKeyIndexBuilder::init() {
+    // keys are memcomparable encoded, see SegmentWriter::_full_encode_keys
+    const auto* type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+    segment_v2::IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = true;
+    options.encoding = segment_v2::EncodingInfo::get_default_encoding(type_info, true);
+    // the index is probed for every row of later loads, keep its pages cheap to decode
+    options.compression = NO_COMPRESSION;
+    _primary_key_index_builder.reset(
+            new segment_v2::IndexedColumnWriter(options, type_info, _file_writer));
+    return _primary_key_index_builder->init();
+}
+
+Status PrimaryKeyIndexBuilder::add_item(const Slice& key) {
+    DCHECK(_num_rows == 0 || Slice(_max_key).compare(key) < 0)
+            << "primary keys must be added in strictly ascending order";
+    RETURN_IF_ERROR(_primary_key_index_builder->add(&key));
+    // the first key is the minimal key, and the last one is the maximal key
+    if (UNLIKELY(_num_rows == 0)) {
+        _min_key.assign(key.data, key.size);
+    }
+    _max_key.assign(key.data, key.size);
+    _num_rows++;
+    _size += key.get_size();
+    return Status::OK();
+}
+
+Status PrimaryKeyIndexBuilder::finalize(PrimaryKeyIndexMetaPB* meta) {
+    RETURN_IF_ERROR(_primary_key_index_builder->finish(meta->mutable_primary_key_index()));
+    meta->set_min_key(_min_key);
+    meta->set_max_key(_max_key);
+    return Status::OK();
+}
+
+Status PrimaryKeyIndexReader::parse(io::FileSystem* fs, const std::string& path,
+                                    const PrimaryKeyIndexMetaPB& meta) {
+    // parse primary key index
+    _index_reader.reset(new segment_v2::IndexedColumnReader(fs, path, meta.primary_key_index()));
+    RETURN_IF_ERROR(_index_reader->load(!config::disable_storage_page_cache, false));
+    _parsed = true;
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
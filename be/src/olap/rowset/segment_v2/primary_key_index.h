@@ -0,0 +1,108 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "io/fs/file_system.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "olap/rowset/segment_v2/indexed_column_writer.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace io {
+class FileWriter;
+} // namespace io
+
+namespace segment_v2 {
+
+// Build index for primary key.
+// The primary key index is designed in a similar way like RocksDB
+// Partitioned Index, which is created in the segment file when MemTable flushes.
+// Index is stored in multiple pages to leverage the IndexedColumnWriter.
+//
+// NOTE: for now, it's only used when unique key merge-on-write property enabled,
+// and the keys are added in ascending order, each key at most once.
+class PrimaryKeyIndexBuilder {
+public:
+    explicit PrimaryKeyIndexBuilder(io::FileWriter* file_writer)
+            : _file_writer(file_writer), _num_rows(0), _size(0) {}
+
+    Status init();
+
+    Status add_item(const Slice& key);
+
+    uint32_t num_rows() const { return _num_rows; }
+
+    uint64_t size() const { return _size; }
+
+    Slice min_key() { return Slice(_min_key); }
+    Slice max_key() { return Slice(_max_key); }
+
+    Status finalize(PrimaryKeyIndexMetaPB* meta);
+
+private:
+    io::FileWriter* _file_writer = nullptr;
+    uint32_t _num_rows;
+    uint64_t _size;
+
+    std::string _min_key;
+    std::string _max_key;
+    std::unique_ptr<IndexedColumnWriter> _primary_key_index_builder;
+
+    DISALLOW_COPY_AND_ASSIGN(PrimaryKeyIndexBuilder);
+};
+
+class PrimaryKeyIndexReader {
+public:
+    PrimaryKeyIndexReader() : _parsed(false) {}
+
+    Status parse(io::FileSystem* fs, const std::string& path, const PrimaryKeyIndexMetaPB& meta);
+
+    Status new_iterator(std::unique_ptr<IndexedColumnIterator>* index_iterator) const {
+        DCHECK(_parsed);
+        index_iterator->reset(new IndexedColumnIterator(_index_reader.get()));
+        return Status::OK();
+    }
+
+    const TypeInfo* type_info() const {
+        DCHECK(_parsed);
+        return _index_reader->type_info();
+    }
+
+    int64_t num_rows() const {
+        DCHECK(_parsed);
+        return _index_reader->num_values();
+    }
+
+private:
+    bool _parsed;
+    std::unique_ptr<IndexedColumnReader> _index_reader;
+
+    DISALLOW_COPY_AND_ASSIGN(PrimaryKeyIndexReader);
+};
+
+} // namespace segment_v2
+} // namespace doris
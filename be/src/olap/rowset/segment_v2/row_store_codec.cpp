@@ -0,0 +1,136 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/row_store_codec.h"
+
+#include <fmt/format.h>
+
+#include "util/coding.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/typeid_cast.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static bool is_plain_column(const vectorized::IColumn& column) {
+    return column.is_fixed_and_contiguous() ||
+           typeid_cast<const vectorized::ColumnString*>(&column) != nullptr;
+}
+
+bool RowStoreCodec::is_supported(const vectorized::IColumn& column) {
+    if (const auto* nullable = typeid_cast<const vectorized::ColumnNullable*>(&column)) {
+        return is_plain_column(nullable->get_nested_column());
+    }
+    return is_plain_column(column);
+}
+
+void RowStoreCodec::encode_rows(const std::vector<const vectorized::IColumn*>& columns,
+                                const std::vector<uint32_t>& unique_ids, size_t row_pos,
+                                size_t num_rows, faststring* buf, std::vector<size_t>* row_ends) {
+    DCHECK_EQ(columns.size(), unique_ids.size());
+    // the null maps and the nested columns of the nullable columns
+    std::vector<const uint8_t*> null_maps(columns.size(), nullptr);
+    std::vector<const vectorized::IColumn*> values(columns);
+    for (size_t i = 0; i < columns.size(); ++i) {
+        DCHECK(is_supported(*columns[i]));
+        if (const auto* nullable = typeid_cast<const vectorized::ColumnNullable*>(columns[i])) {
+            null_maps[i] = nullable->get_null_map_data().data();
+            values[i] = &nullable->get_nested_column();
+        }
+    }
+    for (size_t row = row_pos; row < row_pos + num_rows; ++row) {
+        buf->push_back(ROW_STORE_VERSION);
+        put_varint32(buf, columns.size());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            put_varint32(buf, unique_ids[i]);
+            if (null_maps[i] != nullptr && null_maps[i][row]) {
+                put_varint32(buf, 0);
+                continue;
+            }
+            StringRef value = values[i]->get_data_at(row);
+            put_varint32(buf, value.size + 1);
+            buf->append(value.data, value.size);
+        }
+        row_ends->push_back(buf->size());
+    }
+}
+
+static Status decode_value(const Slice& value, bool is_null, vectorized::IColumn* column) {
+    if (auto* nullable = typeid_cast<vectorized::ColumnNullable*>(column)) {
+        if (is_null) {
+            nullable->insert_default();
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(decode_value(value, false, &nullable->get_nested_column()));
+        nullable->get_null_map_data().push_back(0);
+        return Status::OK();
+    }
+    if (is_null) {
+        return Status::Corruption(
+                fmt::format("null value of not nullable column {}", column->get_name()));
+    }
+    if (column->is_fixed_and_contiguous() ? value.size != column->size_of_value_if_fixed()
+                                          : !is_plain_column(*column)) {
+        return Status::Corruption(fmt::format("bad value of {} bytes for column {}", value.size,
+                                              column->get_name()));
+    }
+    column->insert_data(value.data, value.size);
+    return Status::OK();
+}
+
+Status RowStoreCodec::decode_row(const Slice& row,
+                                 const std::unordered_map<uint32_t, size_t>& positions,
+                                 const std::vector<vectorized::IColumn*>& columns) {
+    if (row.size == 0) {
+        return Status::Corruption("empty row");
+    }
+    if ((uint8_t)row.data[0] != ROW_STORE_VERSION) {
+        return Status::NotSupported(
+                fmt::format("unknown row store version {}", (uint8_t)row.data[0]));
+    }
+    Slice input(row.data + 1, row.size - 1);
+    uint32_t num_cells = 0;
+    if (!get_varint32(&input, &num_cells)) {
+        return Status::Corruption("bad number of cells");
+    }
+    size_t num_decoded = 0;
+    for (uint32_t i = 0; i < num_cells; ++i) {
+        uint32_t unique_id = 0;
+        uint32_t size = 0;
+        if (!get_varint32(&input, &unique_id) || !get_varint32(&input, &size) ||
+            (size > 0 && size - 1 > input.size)) {
+            return Status::Corruption(fmt::format("bad cell {} of {}", i, num_cells));
+        }
+        Slice value(input.data, size > 0 ? size - 1 : 0);
+        input.remove_prefix(value.size);
+        auto it = positions.find(unique_id);
+        if (it == positions.end()) {
+            continue;
+        }
+        RETURN_IF_ERROR(decode_value(value, size == 0, columns[it->second]));
+        ++num_decoded;
+    }
+    if (input.size != 0 || num_decoded != positions.size()) {
+        return Status::Corruption(fmt::format("{} of {} columns decoded, {} bytes left",
+                                              num_decoded, positions.size(), input.size));
+    }
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
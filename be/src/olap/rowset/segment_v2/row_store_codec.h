@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace doris {
+
+namespace vectorized {
+class IColumn;
+} // namespace vectorized
+
+namespace segment_v2 {
+
+// Encodes the rows of the row store, see RowStorePB. A row is
+//
+//   version: uint8, ROW_STORE_VERSION
+//   num_cells: varint32
+//   cells: unique_id: varint32, size: varint32, value: `size - 1` bytes
+//
+// with one cell for each column, and size 0 for null. The value is the bytes of the strings,
+// or the fixed-width value of the other types in little endian, e.g. the 16 bytes of
+// DECIMALV2 and the 8 bytes of VecDateTimeValue for DATE. The rows don't depend on the order
+// of the columns, the cells of the columns dropped from the schema are skipped.
+class RowStoreCodec {
+public:
+    static constexpr uint8_t ROW_STORE_VERSION = 1;
+
+    // Whether the values of the column can be encoded: a string column, a column of
+    // fixed-width values, or a nullable one of them.
+    static bool is_supported(const vectorized::IColumn& column);
+
+    // Appends the rows [row_pos, row_pos + num_rows) of `columns`, whose unique ids are
+    // `unique_ids`, to `buf`, and the end offset of each row in `buf` to `row_ends`.
+    // REQUIRES: is_supported(column) for all the columns.
+    static void encode_rows(const std::vector<const vectorized::IColumn*>& columns,
+                            const std::vector<uint32_t>& unique_ids, size_t row_pos,
+                            size_t num_rows, faststring* buf, std::vector<size_t>* row_ends);
+
+    // Appends the value of the column of unique id `unique_id` of the row to
+    // `columns[positions[unique_id]]`, for every column in `positions`. Returns Corruption if
+    // the row is bad or misses any of the columns, and NotSupported if the version of the row
+    // is unknown, the columns are left partially appended on any error.
+    static Status decode_row(const Slice& row,
+                             const std::unordered_map<uint32_t, size_t>& positions,
+                             const std::vector<vectorized::IColumn*>& columns);
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -17,20 +17,29 @@
 
 #include "olap/rowset/segment_v2/segment.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "gutil/strings/substitute.h"
+#include "olap/column_block.h"
+#include "olap/column_vector.h"
 #include "olap/fs/fs_util.h"
 #include "olap/rowset/segment_v2/column_reader.h" // ColumnReader
 #include "olap/rowset/segment_v2/empty_segment_iterator.h"
 #include "olap/rowset/segment_v2/page_io.h"
+#include "olap/rowset/segment_v2/primary_key_index.h"
+#include "olap/rowset/segment_v2/row_store_codec.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
 #include "util/crc32c.h"
+#include "util/doris_metrics.h"
 #include "util/slice.h" // Slice
+#include "util/time.h"
+#include "vec/columns/column_string.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -39,8 +48,11 @@ using strings::Substitute;
 
 Status Segment::open(io::FileSystem* fs, const std::string& path, uint32_t segment_id,
                      const TabletSchema* tablet_schema, std::shared_ptr<Segment>* output) {
+    int64_t start_ns = MonotonicNanos();
     std::shared_ptr<Segment> segment(new Segment(fs, path, segment_id, tablet_schema));
     RETURN_IF_ERROR(segment->_open());
+    DorisMetrics::instance()->segment_open_latency_us->add((MonotonicNanos() - start_ns) /
+                                                           NANOS_PER_MICRO);
     output->swap(segment);
     return Status::OK();
 }
@@ -61,7 +73,7 @@ Segment::~Segment() {
 
 Status Segment::_open() {
     RETURN_IF_ERROR(_parse_footer());
-    RETURN_IF_ERROR(_create_column_readers());
+    RETURN_IF_ERROR(_init_column_readers());
     _is_open = true;
     return Status::OK();
 }
@@ -76,11 +88,12 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
     if (read_options.conditions != nullptr) {
         for (auto& column_condition : read_options.conditions->columns()) {
             int32_t column_id = column_condition.first;
-            if (_column_readers[column_id] == nullptr ||
-                !_column_readers[column_id]->has_zone_map()) {
+            ColumnReader* reader = nullptr;
+            RETURN_IF_ERROR(_get_column_reader(column_id, &reader));
+            if (reader == nullptr || !reader->has_zone_map()) {
                 continue;
             }
-            if (!_column_readers[column_id]->match_condition(column_condition.second)) {
+            if (!reader->match_condition(column_condition.second)) {
                 // any condition not satisfied, return.
                 iter->reset(new EmptySegmentIterator(schema));
                 read_options.stats->filtered_segment_number++;
@@ -96,6 +109,13 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
 }
 
 Status Segment::_parse_footer() {
+    auto meta_cache = SegmentMetaCache::instance();
+    if (meta_cache != nullptr) {
+        _footer = meta_cache->lookup_footer(_path);
+        if (_footer != nullptr) {
+            return Status::OK();
+        }
+    }
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::unique_ptr<io::FileReader> file_reader;
     RETURN_IF_ERROR(_fs->open_file(_path, &file_reader));
@@ -123,8 +143,6 @@ Status Segment::_parse_footer() {
         return Status::Corruption(strings::Substitute("Bad segment file $0: file size $1 < $2",
                                                       _path, file_size, 12 + footer_length));
     }
-    _mem_tracker->consume(footer_length);
-
     std::string footer_buf;
     footer_buf.resize(footer_length);
     RETURN_IF_ERROR(file_reader->read_at(file_size - 12 - footer_length, footer_buf, &bytes_read));
@@ -140,66 +158,360 @@ Status Segment::_parse_footer() {
     }
 
     // deserialize footer PB
-    if (!_footer.ParseFromString(footer_buf)) {
+    auto footer = std::make_shared<SegmentFooterPB>();
+    if (!footer->ParseFromString(footer_buf)) {
         return Status::Corruption(
                 strings::Substitute("Bad segment file $0: failed to parse SegmentFooterPB", _path));
     }
+    _footer = footer;
+    if (meta_cache != nullptr) {
+        // charged by the cache
+        meta_cache->insert_footer(_path, _footer);
+    } else {
+        _mem_tracker->consume(footer_length);
+    }
+    return Status::OK();
+}
+
+Status Segment::get_short_keys(const Slice& lower_key, const Slice& upper_key,
+                               std::vector<std::string>* short_keys) {
+    if (num_rows() == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_load_index());
+    auto end = _sk_index_decoder->lower_bound(upper_key);
+    for (auto iter = _sk_index_decoder->upper_bound(lower_key); iter.ordinal() < end.ordinal();
+         ++iter) {
+        short_keys->emplace_back((*iter).to_string());
+    }
     return Status::OK();
 }
 
 Status Segment::_load_index() {
     return _load_index_once.call([this] {
-        // read and parse short key index page
-
-        std::unique_ptr<io::FileReader> file_reader;
-        RETURN_IF_ERROR(_fs->open_file(_path, &file_reader));
-
-        PageReadOptions opts;
-        opts.file_reader = file_reader.get();
-        opts.page_pointer = PagePointer(_footer.short_key_index_page());
-        opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
-        OlapReaderStatistics tmp_stats;
-        opts.stats = &tmp_stats;
-        opts.type = INDEX_PAGE;
-
-        Slice body;
-        PageFooterPB footer;
-        RETURN_IF_ERROR(PageIO::read_and_decompress_page(opts, &_sk_index_handle, &body, &footer));
-        DCHECK_EQ(footer.type(), SHORT_KEY_PAGE);
-        DCHECK(footer.has_short_key_page_footer());
-
-        _mem_tracker->consume(body.get_size());
+        auto meta_cache = SegmentMetaCache::instance();
+        if (meta_cache != nullptr) {
+            _sk_index_page = meta_cache->lookup_short_key_index(_path);
+        }
+        if (_sk_index_page == nullptr) {
+            RETURN_IF_ERROR(_read_short_key_index());
+            if (meta_cache != nullptr) {
+                // charged by the cache
+                meta_cache->insert_short_key_index(_path, _sk_index_page);
+            } else {
+                _mem_tracker->consume(_sk_index_page->body.size());
+            }
+        }
         _sk_index_decoder.reset(new ShortKeyIndexDecoder);
-        return _sk_index_decoder->parse(body, footer.short_key_page_footer());
+        return _sk_index_decoder->parse(Slice(_sk_index_page->body), _sk_index_page->footer);
     });
 }
 
-Status Segment::_create_column_readers() {
-    for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
-        auto& column_pb = _footer.columns(ordinal);
-        _column_id_to_footer_ordinal.emplace(column_pb.unique_id(), ordinal);
+Status Segment::_read_short_key_index() {
+    std::unique_ptr<io::FileReader> file_reader;
+    RETURN_IF_ERROR(_fs->open_file(_path, &file_reader));
+
+    PageReadOptions opts;
+    opts.file_reader = file_reader.get();
+    opts.page_pointer = PagePointer(_footer->short_key_index_page());
+    opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
+    OlapReaderStatistics tmp_stats;
+    opts.stats = &tmp_stats;
+    opts.type = INDEX_PAGE;
+
+    PageHandle handle;
+    Slice body;
+    PageFooterPB footer;
+    RETURN_IF_ERROR(PageIO::read_and_decompress_page(opts, &handle, &body, &footer));
+    DCHECK_EQ(footer.type(), SHORT_KEY_PAGE);
+    DCHECK(footer.has_short_key_page_footer());
+
+    auto page = std::make_shared<ShortKeyIndexPage>();
+    page->body.assign(body.data, body.size);
+    page->footer = footer.short_key_page_footer();
+    _sk_index_page = std::move(page);
+    return Status::OK();
+}
+
+Status Segment::_load_pk_index() {
+    return _load_pk_index_once.call([this] {
+        if (!has_primary_key_index()) {
+            return Status::NotSupported("segment has no primary key index");
+        }
+        _pk_index_reader.reset(new PrimaryKeyIndexReader());
+        return _pk_index_reader->parse(_fs, _path, _footer->primary_key_index_meta());
+    });
+}
+
+Status Segment::new_primary_key_iterator(std::unique_ptr<IndexedColumnIterator>* iter) {
+    RETURN_IF_ERROR(_load_pk_index());
+    return _pk_index_reader->new_iterator(iter);
+}
+
+Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location,
+                               IndexedColumnIterator* index_iterator) {
+    RETURN_IF_ERROR(_load_pk_index());
+    const auto& pk_meta = _footer->primary_key_index_meta();
+    if (key.compare(Slice(pk_meta.min_key())) < 0 || key.compare(Slice(pk_meta.max_key())) > 0) {
+        return Status::NotFound("key is out of the range of segment");
     }
+    std::unique_ptr<IndexedColumnIterator> owned_iterator;
+    if (index_iterator == nullptr) {
+        RETURN_IF_ERROR(_pk_index_reader->new_iterator(&owned_iterator));
+        index_iterator = owned_iterator.get();
+    }
+    bool exact_match = false;
+    RETURN_IF_ERROR(index_iterator->seek_at_or_after(&key, &exact_match));
+    if (!exact_match) {
+        return Status::NotFound("can't find key in the segment");
+    }
+    row_location->segment_id = _segment_id;
+    row_location->row_id = index_iterator->get_current_ordinal();
+    return Status::OK();
+}
 
-    _column_readers.resize(_tablet_schema->columns().size());
-    for (uint32_t ordinal = 0; ordinal < _tablet_schema->num_columns(); ++ordinal) {
-        auto& column = _tablet_schema->columns()[ordinal];
-        auto iter = _column_id_to_footer_ordinal.find(column.unique_id());
-        if (iter == _column_id_to_footer_ordinal.end()) {
-            continue;
+Status Segment::read_key_by_rowid(uint32_t row_id, std::string* key) {
+    RETURN_IF_ERROR(_load_pk_index());
+    std::unique_ptr<IndexedColumnIterator> index_iterator;
+    RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
+    RETURN_IF_ERROR(index_iterator->seek_to_ordinal(row_id));
+
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(
+            ColumnVectorBatch::create(1, false, _pk_index_reader->type_info(), nullptr, &cvb));
+    MemPool pool("Segment::read_key_by_rowid");
+    ColumnBlock block(cvb.get(), &pool);
+    ColumnBlockView column_block_view(&block);
+    size_t num_read = 1;
+    RETURN_IF_ERROR(index_iterator->next_batch(&num_read, &column_block_view));
+    if (num_read != 1) {
+        return Status::InternalError(
+                strings::Substitute("failed to read key of row $0 in $1", row_id, _path));
+    }
+    const auto* slice = reinterpret_cast<const Slice*>(block.data());
+    key->assign(slice->data, slice->size);
+    return Status::OK();
+}
+
+Status Segment::read_row_by_rowid(uint32_t row_id, const std::vector<uint32_t>& cids,
+                                  vectorized::MutableColumns* columns) {
+    DCHECK_EQ(cids.size(), columns->size());
+    if (row_id >= num_rows()) {
+        return Status::InvalidArgument(strings::Substitute(
+                "row $0 is out of range, $1 has $2 rows", row_id, _path, num_rows()));
+    }
+    std::unique_ptr<io::FileReader> file_reader;
+    RETURN_IF_ERROR(_fs->open_file(_path, &file_reader));
+    OlapReaderStatistics stats;
+    // one page of the row store is read instead of one page per column
+    if (has_row_store() && cids.size() * 2 >= _tablet_schema->num_columns()) {
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &stats;
+        iter_opts.use_page_cache = !config::disable_storage_page_cache;
+        iter_opts.file_reader = file_reader.get();
+        std::vector<vectorized::IColumn*> dst_columns;
+        for (auto& column : *columns) {
+            dst_columns.push_back(column.get());
+        }
+        auto st = read_rows_from_row_store(iter_opts, &row_id, 1, cids, dst_columns);
+        if (!st.is_not_supported()) {
+            return st;
+        }
+    }
+    for (size_t i = 0; i < cids.size(); ++i) {
+        ColumnIterator* column_iterator = nullptr;
+        RETURN_IF_ERROR(new_column_iterator(cids[i], &column_iterator));
+        std::unique_ptr<ColumnIterator> iter(column_iterator);
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &stats;
+        iter_opts.use_page_cache = !config::disable_storage_page_cache;
+        iter_opts.file_reader = file_reader.get();
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        RETURN_IF_ERROR(iter->seek_to_ordinal(row_id));
+        size_t num_read = 1;
+        RETURN_IF_ERROR(iter->next_batch(&num_read, (*columns)[i]));
+        if (num_read != 1) {
+            return Status::InternalError(strings::Substitute(
+                    "failed to read column $0 of row $1 in $2", cids[i], row_id, _path));
+        }
+    }
+    return Status::OK();
+}
+
+Status Segment::traverse_primary_keys(
+        const std::function<Status(uint32_t row_id, const Slice& key)>& visitor) {
+    RETURN_IF_ERROR(_load_pk_index());
+    std::unique_ptr<IndexedColumnIterator> index_iterator;
+    RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
+
+    constexpr size_t batch_size = 1024;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(batch_size, false, _pk_index_reader->type_info(),
+                                              nullptr, &cvb));
+    MemPool pool("Segment::traverse_primary_keys");
+    uint32_t total_rows = _pk_index_reader->num_rows();
+    uint32_t row_id = 0;
+    while (row_id < total_rows) {
+        // the iterator can read only once after each seek
+        RETURN_IF_ERROR(index_iterator->seek_to_ordinal(row_id));
+        size_t num_read = std::min<size_t>(batch_size, total_rows - row_id);
+        ColumnBlock block(cvb.get(), &pool);
+        ColumnBlockView column_block_view(&block);
+        RETURN_IF_ERROR(index_iterator->next_batch(&num_read, &column_block_view));
+        if (UNLIKELY(num_read == 0)) {
+            return Status::InternalError(strings::Substitute(
+                    "unexpected end of primary key index at row $0 in $1", row_id, _path));
+        }
+        const auto* keys = reinterpret_cast<const Slice*>(block.data());
+        for (size_t i = 0; i < num_read; ++i) {
+            RETURN_IF_ERROR(visitor(row_id + i, keys[i]));
         }
+        row_id += num_read;
+        pool.clear();
+    }
+    return Status::OK();
+}
 
+Status Segment::_init_column_readers() {
+    for (uint32_t ordinal = 0; ordinal < _footer->columns().size(); ++ordinal) {
+        auto& column_pb = _footer->columns(ordinal);
+        _column_id_to_footer_ordinal.emplace(column_pb.unique_id(), ordinal);
+    }
+    _column_readers.resize(_tablet_schema->columns().size());
+    _create_column_reader_once.reset(new DorisCallOnce<Status>[_column_readers.size()]);
+    // the rows may be written before the schema of the tablet is changed, each row records
+    // the unique ids of its columns
+    _has_row_store = _footer->has_row_store();
+    if (_has_row_store) {
+        const auto& unique_ids = _footer->row_store().column_unique_ids();
+        _row_store_unique_ids.insert(unique_ids.begin(), unique_ids.end());
+    }
+    return Status::OK();
+}
+
+Status Segment::read_rows_from_row_store(const ColumnIteratorOptions& iter_opts,
+                                         const uint32_t* row_ids, size_t num_rows,
+                                         const std::vector<uint32_t>& cids,
+                                         const std::vector<vectorized::IColumn*>& columns) {
+    DCHECK(has_row_store());
+    DCHECK_EQ(cids.size(), columns.size());
+    auto row_block = _tablet_schema->create_block();
+    // the values are decoded into `decoded_columns` first, so nothing is appended to `columns`
+    // on errors
+    vectorized::MutableColumns decoded_columns;
+    std::vector<vectorized::IColumn*> decoded_column_ptrs;
+    std::unordered_map<uint32_t, size_t> positions;
+    for (size_t i = 0; i < cids.size(); ++i) {
+        uint32_t unique_id = _tablet_schema->column(cids[i]).unique_id();
+        // e.g. the columns added after the rows are written
+        if (_row_store_unique_ids.count(unique_id) == 0) {
+            return Status::NotSupported(fmt::format("column {} of {} is not in the row store",
+                                                    cids[i], _path));
+        }
+        const auto& row_column = row_block.get_by_position(cids[i]).column;
+        if (columns[i]->get_name() != row_column->get_name()) {
+            return Status::NotSupported(fmt::format(
+                    "can't read column {} of {} from row store, {} is read instead of {}",
+                    cids[i], _path, columns[i]->get_name(), row_column->get_name()));
+        }
+        if (!positions.emplace(unique_id, i).second) {
+            return Status::NotSupported(
+                    fmt::format("column {} of {} is read more than once", cids[i], _path));
+        }
+        decoded_columns.push_back(columns[i]->clone_empty());
+        decoded_column_ptrs.push_back(decoded_columns.back().get());
+    }
+    RETURN_IF_ERROR(_create_row_store_reader_once.call([this] {
         ColumnReaderOptions opts;
         opts.kept_in_memory = _tablet_schema->is_in_memory();
-        std::unique_ptr<ColumnReader> reader;
-        RETURN_IF_ERROR(ColumnReader::create(opts, _footer.columns(iter->second),
-                                             _footer.num_rows(), _fs, _path, &reader));
-        _column_readers[ordinal] = std::move(reader);
+        return ColumnReader::create(opts, _footer->row_store().column(), _footer->num_rows(),
+                                    _fs, _path, &_row_store_reader);
+    }));
+    ColumnIterator* column_iterator = nullptr;
+    RETURN_IF_ERROR(_row_store_reader->new_iterator(&column_iterator));
+    std::unique_ptr<ColumnIterator> iter(column_iterator);
+    RETURN_IF_ERROR(iter->init(iter_opts));
+    vectorized::MutableColumnPtr rows = vectorized::ColumnString::create();
+    for (size_t i = 0; i < num_rows; ++i) {
+        RETURN_IF_ERROR(iter->seek_to_ordinal(row_ids[i]));
+        size_t num_read = 1;
+        RETURN_IF_ERROR(iter->next_batch(&num_read, rows));
+        if (num_read != 1) {
+            return Status::InternalError(fmt::format("failed to read row {} of {} from row store",
+                                                     row_ids[i], _path));
+        }
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+        StringRef row = rows->get_data_at(i);
+        auto st = RowStoreCodec::decode_row(Slice(row.data, row.size), positions,
+                                            decoded_column_ptrs);
+        if (!st.ok()) {
+            return st.clone_and_append(
+                    fmt::format("bad row {} in the row store of {}", row_ids[i], _path));
+        }
+    }
+    for (size_t i = 0; i < cids.size(); ++i) {
+        columns[i]->insert_range_from(*decoded_columns[i], 0, num_rows);
+    }
+    return Status::OK();
+}
+
+Status Segment::read_columns_by_rowids(const std::vector<uint32_t>& cids, const uint32_t* row_ids,
+                                       size_t num_rows, vectorized::MutableColumns* columns,
+                                       OlapReaderStatistics* stats) {
+    DCHECK_EQ(cids.size(), columns->size());
+    std::unique_ptr<io::FileReader> file_reader;
+    RETURN_IF_ERROR(_fs->open_file(_path, &file_reader));
+    ColumnIteratorOptions iter_opts;
+    iter_opts.stats = stats;
+    iter_opts.file_reader = file_reader.get();
+    for (size_t i = 0; i < cids.size(); ++i) {
+        ColumnIterator* column_iterator = nullptr;
+        RETURN_IF_ERROR(new_column_iterator(cids[i], &column_iterator));
+        std::unique_ptr<ColumnIterator> iter(column_iterator);
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        auto& column = (*columns)[i];
+        auto type = _tablet_schema->column(cids[i]).type();
+        if (type == OLAP_FIELD_TYPE_DATE) {
+            column->set_date_type();
+        } else if (type == OLAP_FIELD_TYPE_DATETIME) {
+            column->set_datetime_type();
+        }
+        for (size_t j = 0; j < num_rows; ++j) {
+            RETURN_IF_ERROR(iter->seek_to_ordinal(row_ids[j]));
+            size_t num_read = 1;
+            bool has_null = false;
+            RETURN_IF_ERROR(iter->next_batch(&num_read, column, &has_null));
+            if (num_read != 1) {
+                return Status::InternalError(fmt::format("failed to read row {} of column {} of {}",
+                                                         row_ids[j], cids[i], _path));
+            }
+        }
     }
     return Status::OK();
 }
 
+Status Segment::_get_column_reader(uint32_t cid, ColumnReader** reader) {
+    *reader = nullptr;
+    auto iter = _column_id_to_footer_ordinal.find(_tablet_schema->column(cid).unique_id());
+    if (iter == _column_id_to_footer_ordinal.end()) {
+        return Status::OK();
+    }
+    uint32_t ordinal = iter->second;
+    RETURN_IF_ERROR(_create_column_reader_once[cid].call([this, cid, ordinal] {
+        ColumnReaderOptions opts;
+        opts.kept_in_memory = _tablet_schema->is_in_memory();
+        return ColumnReader::create(opts, _footer->columns(ordinal), _footer->num_rows(), _fs,
+                                    _path, &_column_readers[cid]);
+    }));
+    *reader = _column_readers[cid].get();
+    return Status::OK();
+}
+
 Status Segment::new_column_iterator(uint32_t cid, ColumnIterator** iter) {
-    if (_column_readers[cid] == nullptr) {
+    ColumnReader* reader = nullptr;
+    RETURN_IF_ERROR(_get_column_reader(cid, &reader));
+    if (reader == nullptr) {
         const TabletColumn& tablet_column = _tablet_schema->column(cid);
         if (!tablet_column.has_default_value() && !tablet_column.is_nullable()) {
             return Status::InternalError("invalid nonexistent column without default value.");
@@ -215,12 +527,23 @@ Status Segment::new_column_iterator(uint32_t cid, ColumnIterator** iter) {
         *iter = default_value_iter.release();
         return Status::OK();
     }
-    return _column_readers[cid]->new_iterator(iter);
+    return reader->new_iterator(iter);
 }
 
 Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter) {
-    if (_column_readers[cid] != nullptr && _column_readers[cid]->has_bitmap_index()) {
-        return _column_readers[cid]->new_bitmap_index_iterator(iter);
+    ColumnReader* reader = nullptr;
+    RETURN_IF_ERROR(_get_column_reader(cid, &reader));
+    if (reader != nullptr && reader->has_bitmap_index()) {
+        return reader->new_bitmap_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
+Status Segment::new_inverted_index_iterator(uint32_t cid, InvertedIndexIterator** iter) {
+    ColumnReader* reader = nullptr;
+    RETURN_IF_ERROR(_get_column_reader(cid, &reader));
+    if (reader != nullptr && reader->has_inverted_index()) {
+        return reader->new_inverted_index_iterator(iter);
     }
     return Status::OK();
 }
@@ -18,8 +18,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory> // for unique_ptr
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "common/status.h" // Status
@@ -27,11 +29,14 @@
 #include "gutil/macros.h"
 #include "io/fs/file_system.h"
 #include "olap/iterators.h"
+#include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/page_handle.h"
+#include "olap/segment_meta_cache.h"
 #include "olap/short_key_index.h"
 #include "olap/tablet_schema.h"
 #include "util/faststring.h"
 #include "util/once.h"
+#include "vec/columns/column.h"
 
 namespace doris {
 
@@ -46,6 +51,9 @@ namespace segment_v2 {
 class BitmapIndexIterator;
 class ColumnReader;
 class ColumnIterator;
+struct ColumnIteratorOptions;
+class IndexedColumnIterator;
+class PrimaryKeyIndexReader;
 class Segment;
 class SegmentIterator;
 using SegmentSharedPtr = std::shared_ptr<Segment>;
@@ -70,12 +78,14 @@ public:
 
     uint64_t id() const { return _segment_id; }
 
-    uint32_t num_rows() const { return _footer.num_rows(); }
+    uint32_t num_rows() const { return _footer->num_rows(); }
 
     Status new_column_iterator(uint32_t cid, ColumnIterator** iter);
 
     Status new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
 
+    Status new_inverted_index_iterator(uint32_t cid, InvertedIndexIterator** iter);
+
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
     uint32_t num_rows_per_block() const {
@@ -86,11 +96,20 @@ public:
         DCHECK(_load_index_once.has_called() && _load_index_once.stored_result().ok());
         return _sk_index_decoder->lower_bound(key);
     }
+    std::pair<ShortKeyIndexIterator, ShortKeyIndexIterator> equal_range(const Slice& key) const {
+        DCHECK(_load_index_once.has_called() && _load_index_once.stored_result().ok());
+        return _sk_index_decoder->equal_range(key);
+    }
     ShortKeyIndexIterator upper_bound(const Slice& key) const {
         DCHECK(_load_index_once.has_called() && _load_index_once.stored_result().ok());
         return _sk_index_decoder->upper_bound(key);
     }
 
+    // Collects the encoded short keys in (lower_key, upper_key) from the short key index,
+    // every one of them is the first key of a block of num_rows_per_block() rows.
+    Status get_short_keys(const Slice& lower_key, const Slice& upper_key,
+                          std::vector<std::string>* short_keys);
+
     // This will return the last row block in this segment.
     // NOTE: Before call this function , client should assure that
     // this segment is not empty.
@@ -100,8 +119,52 @@ public:
         return _sk_index_decoder->num_items() - 1;
     }
 
+    // Only valid for segments of unique key tablets with merge-on-write enabled.
+    bool has_primary_key_index() const { return _footer->has_primary_key_index_meta(); }
+
+    Status new_primary_key_iterator(std::unique_ptr<IndexedColumnIterator>* iter);
+
+    // Finds the row whose encoded primary key equals `key`, sets `segment_id` and
+    // `row_id` of `row_location` if found, otherwise returns NotFound.
+    // `index_iterator` is an iterator from `new_primary_key_iterator`, which could be
+    // reused for looking up many keys, a temporary one is created if it is nullptr.
+    Status lookup_row_key(const Slice& key, RowLocation* row_location,
+                          IndexedColumnIterator* index_iterator = nullptr);
+
+    // Reads the encoded primary key of the row `row_id`.
+    Status read_key_by_rowid(uint32_t row_id, std::string* key);
+
+    // Reads the row `row_id` of the columns `cids` of the tablet schema, appending the values
+    // to `columns` one by one, which are created from the data types of these columns.
+    Status read_row_by_rowid(uint32_t row_id, const std::vector<uint32_t>& cids,
+                             vectorized::MutableColumns* columns);
+
+    // Whether this segment has a row store, see RowStoreCodec.
+    bool has_row_store() const { return _has_row_store; }
+
+    // Reads the rows `row_ids` from the row store, appending the values of the columns `cids`
+    // of the tablet schema to `columns` one by one. Returns NotSupported if any of the columns
+    // is not in the rows, e.g. added by a schema change, or `columns` are not created from the
+    // data types of these columns. Nothing is appended on any error.
+    // REQUIRES: has_row_store()
+    Status read_rows_from_row_store(const ColumnIteratorOptions& iter_opts,
+                                    const uint32_t* row_ids, size_t num_rows,
+                                    const std::vector<uint32_t>& cids,
+                                    const std::vector<vectorized::IColumn*>& columns);
+
+    // Reads the rows `row_ids` in ascending order from the columns `cids`, appending the values
+    // of each column to the column of `columns` at the same position.
+    Status read_columns_by_rowids(const std::vector<uint32_t>& cids, const uint32_t* row_ids,
+                                  size_t num_rows, vectorized::MutableColumns* columns,
+                                  OlapReaderStatistics* stats);
+
+    // Calls `visitor` on the row id and the encoded primary key of each row in row id order,
+    // stops on the first error returned by `visitor`.
+    Status traverse_primary_keys(
+            const std::function<Status(uint32_t row_id, const Slice& key)>& visitor);
+
     // only used by UT
-    const SegmentFooterPB& footer() const { return _footer; }
+    const SegmentFooterPB& footer() const { return *_footer; }
 
 private:
     DISALLOW_COPY_AND_ASSIGN(Segment);
@@ -110,10 +173,17 @@ private:
     // open segment file and read the minimum amount of necessary information (footer)
     Status _open();
     Status _parse_footer();
-    Status _create_column_readers();
+    Status _init_column_readers();
+    // Gets the ColumnReader of a column of TabletSchema, which is created on the first access,
+    // so only the columns read by the queries are opened. nullptr if this segment has no data
+    // for that column, which may be added after this segment is generated.
+    Status _get_column_reader(uint32_t cid, ColumnReader** reader);
     // Load and decode short key index.
     // May be called multiple times, subsequent calls will no op.
     Status _load_index();
+    Status _read_short_key_index();
+    // Load primary key index, may be called multiple times, subsequent calls will no op.
+    Status _load_pk_index();
 
 private:
     friend class SegmentIterator;
@@ -126,24 +196,34 @@ private:
     // This mem tracker is only for tracking memory use by segment meta data such as footer or index page.
     // The memory consumed by querying is tracked in segment iterator.
     std::shared_ptr<MemTracker> _mem_tracker;
-    SegmentFooterPB _footer;
+    // shared with SegmentMetaCache
+    std::shared_ptr<const SegmentFooterPB> _footer;
 
     // Map from column unique id to column ordinal in footer's ColumnMetaPB
     // If we can't find unique id from it, it means this segment is created
     // with an old schema.
     std::unordered_map<uint32_t, uint32_t> _column_id_to_footer_ordinal;
 
-    // ColumnReader for each column in TabletSchema. If ColumnReader is nullptr,
-    // This means that this segment has no data for that column, which may be added
-    // after this segment is generated.
+    // ColumnReader for each column in TabletSchema, created by _get_column_reader().
     std::vector<std::unique_ptr<ColumnReader>> _column_readers;
+    std::unique_ptr<DorisCallOnce<Status>[]> _create_column_reader_once;
+
+    bool _has_row_store = false;
+    // unique ids of the columns in the rows of the row store
+    std::unordered_set<uint32_t> _row_store_unique_ids;
+    // reader of the row store column, created on the first read of the row store
+    std::unique_ptr<ColumnReader> _row_store_reader;
+    DorisCallOnce<Status> _create_row_store_reader_once;
 
     // used to guarantee that short key index will be loaded at most once in a thread-safe way
     DorisCallOnce<Status> _load_index_once;
-    // used to hold short key index page in memory
-    PageHandle _sk_index_handle;
+    // used to hold short key index page in memory, shared with SegmentMetaCache
+    std::shared_ptr<const ShortKeyIndexPage> _sk_index_page;
     // short key index decoder
     std::unique_ptr<ShortKeyIndexDecoder> _sk_index_decoder;
+    // used to guarantee that primary key index will be loaded at most once
+    DorisCallOnce<Status> _load_pk_index_once;
+    std::unique_ptr<PrimaryKeyIndexReader> _pk_index_reader;
     // segment footer need not to be read for remote storage, so _is_open is false. When remote file
     // need to be read. footer will be read and _is_open will be set to true.
     bool _is_open = false;
@@ -17,24 +17,33 @@
 
 #include "olap/rowset/segment_v2/segment_iterator.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <utility>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "olap/column_predicate.h"
+#include "olap/delete_predicate_bitmap_cache.h"
 #include "olap/fs/fs_util.h"
 #include "olap/in_list_predicate.h"
+#include "olap/match_predicate.h"
 #include "olap/olap_common.h"
 #include "olap/row.h"
 #include "olap/row_block2.h"
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/short_key_index.h"
+#include "olap/wrapper_field.h"
 #include "util/doris_metrics.h"
 #include "util/simd/bits.h"
+#include "util/time.h"
 #include "vec/columns/column_dictionary.h"
+#include "vec/columns/column_nullable.h"
 
 using strings::Substitute;
 
@@ -136,12 +145,25 @@ Status SegmentIterator::init(const StorageReadOptions& opts) {
 
 Status SegmentIterator::_init(bool is_vec) {
     DorisMetrics::instance()->segment_read_total->increment(1);
+    if (_opts.runtime_predicates != nullptr) {
+        _col_predicates.insert(_col_predicates.end(), _opts.runtime_predicates->begin(),
+                               _opts.runtime_predicates->end());
+    }
     // get file handle from file descriptor of segment
     auto fs = _segment->_fs;
     RETURN_IF_ERROR(fs->open_file(_segment->_path, &_file_reader));
 
     _row_bitmap.addRange(0, _segment->num_rows());
+    // remove the rows overwritten or deleted by later loads in merge-on-write tablets
+    if (auto it = _opts.delete_bitmap.find(segment_id()); it != _opts.delete_bitmap.end()) {
+        size_t pre_size = _row_bitmap.cardinality();
+        _row_bitmap -= *(it->second);
+        _opts.stats->rows_del_filtered += (pre_size - _row_bitmap.cardinality());
+    }
     RETURN_IF_ERROR(_init_return_column_iterators());
+    if (is_vec) {
+        RETURN_IF_ERROR(_apply_delete_predicate_bitmap());
+    }
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
     // z-order can not use prefix index
     if (_segment->_tablet_schema->sort_type() != SortType::ZORDER) {
@@ -151,13 +173,54 @@ Status SegmentIterator::_init(bool is_vec) {
     if (is_vec) {
         _vec_init_lazy_materialization();
         _vec_init_char_column_id();
+        _count_by_index = _can_count_by_index();
     } else {
         _init_lazy_materialization();
     }
+    if (_file_reader->support_prefetch() && !_count_by_index) {
+        // the columns read for all rows in _row_bitmap
+        if (is_vec) {
+            RETURN_IF_ERROR(_prefetch_data_pages(_first_read_column_ids));
+        } else {
+            RETURN_IF_ERROR(_prefetch_data_pages(
+                    _lazy_materialization_read ? _predicate_columns : _schema.column_ids()));
+        }
+    }
     _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
     return Status::OK();
 }
 
+Status SegmentIterator::_prefetch_data_pages(const std::vector<ColumnId>& column_ids) {
+    if (_row_bitmap.isEmpty()) {
+        return Status::OK();
+    }
+    std::vector<std::vector<io::PrefetchRange>> column_ranges;
+    size_t total = 0;
+    for (auto cid : column_ids) {
+        ColumnReader* reader = nullptr;
+        RETURN_IF_ERROR(_segment->_get_column_reader(cid, &reader));
+        if (reader == nullptr) {
+            continue;
+        }
+        column_ranges.emplace_back();
+        RETURN_IF_ERROR(reader->get_data_page_ranges(_row_bitmap, &column_ranges.back()));
+        total += column_ranges.back().size();
+    }
+    // Columns are read batch by batch, so interleave the pages of all columns to
+    // approximate the order they are read.
+    std::vector<io::PrefetchRange> ranges;
+    ranges.reserve(total);
+    for (size_t i = 0; ranges.size() < total; ++i) {
+        for (auto& column_range : column_ranges) {
+            if (i < column_range.size()) {
+                ranges.push_back(column_range[i]);
+            }
+        }
+    }
+    _file_reader->prefetch(ranges);
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     DorisMetrics::instance()->segment_row_total->increment(num_rows());
 
@@ -229,10 +292,76 @@ Status SegmentIterator::_prepare_seek(const StorageReadOptions::KeyRange& key_ra
     return Status::OK();
 }
 
+// Removes the rows deleted by the delete predicates from _row_bitmap, by the rows of the
+// segment cached or evaluated all at once, then the delete predicates are not evaluated on
+// the blocks read any more.
+Status SegmentIterator::_apply_delete_predicate_bitmap() {
+    auto cache = DeletePredicateBitmapCache::instance();
+    if (cache == nullptr || _opts.delete_condition_version < 0 ||
+        _opts.delete_condition_predicates->num_of_column_predicate() == 0 ||
+        _row_bitmap.isEmpty()) {
+        return Status::OK();
+    }
+    DeletePredicateBitmapCache::CacheKey key {_opts.rowset_id, segment_id(),
+                                              _opts.delete_condition_version};
+    auto deleted_rows = cache->lookup(key);
+    if (deleted_rows == nullptr) {
+        auto rows = std::make_shared<roaring::Roaring>();
+        RETURN_IF_ERROR(_evaluate_delete_predicates(rows.get()));
+        rows->runOptimize();
+        cache->insert(key, rows);
+        deleted_rows = std::move(rows);
+    }
+    size_t pre_size = _row_bitmap.cardinality();
+    _row_bitmap -= *deleted_rows;
+    _opts.stats->rows_vec_del_cond_filtered += (pre_size - _row_bitmap.cardinality());
+    _opts.delete_condition_predicates = std::make_shared<AndBlockColumnPredicate>();
+    return Status::OK();
+}
+
+Status SegmentIterator::_evaluate_delete_predicates(roaring::Roaring* deleted_rows) {
+    std::set<ColumnId> cids;
+    _opts.delete_condition_predicates->get_all_column_ids(cids);
+    vectorized::MutableColumns columns(*cids.rbegin() + 1);
+    const uint32_t num_rows = _segment->num_rows();
+    const uint32_t batch_rows = _opts.block_row_max;
+    std::vector<uint16_t> sel(batch_rows);
+    for (auto cid : cids) {
+        RETURN_IF_ERROR(_column_iterators[cid]->seek_to_ordinal(0));
+    }
+    for (uint32_t start = 0; start < num_rows; start += batch_rows) {
+        uint16_t rows = std::min(batch_rows, num_rows - start);
+        for (auto cid : cids) {
+            auto column_desc = _schema.column(cid);
+            columns[cid] = Schema::get_predicate_column_nullable_ptr(column_desc->type(),
+                                                                     column_desc->is_nullable());
+            size_t rows_read = rows;
+            RETURN_IF_ERROR(_column_iterators[cid]->next_batch(&rows_read, columns[cid]));
+            DCHECK_EQ(rows, rows_read);
+        }
+        for (uint16_t i = 0; i < rows; ++i) {
+            sel[i] = i;
+        }
+        uint16_t selected_size = rows;
+        _opts.delete_condition_predicates->evaluate(columns, sel.data(), &selected_size);
+        // the rows selected are the ones not deleted, in ascending order
+        uint16_t j = 0;
+        for (uint16_t i = 0; i < rows; ++i) {
+            if (j < selected_size && sel[j] == i) {
+                ++j;
+            } else {
+                deleted_rows->add(start + i);
+            }
+        }
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_column_conditions() {
     if (_row_bitmap.isEmpty()) {
         return Status::OK();
     }
+    RETURN_IF_ERROR(_apply_match_predicates());
     RETURN_IF_ERROR(_apply_bitmap_index());
 
     if (!_row_bitmap.isEmpty() &&
@@ -324,8 +453,9 @@ Status SegmentIterator::_apply_bitmap_index() {
     std::vector<ColumnPredicate*> remaining_predicates;
 
     for (auto pred : _col_predicates) {
-        if (_bitmap_index_iterators[pred->column_id()] == nullptr) {
-            // no bitmap index for this column
+        if (_bitmap_index_iterators[pred->column_id()] == nullptr ||
+            !pred->can_do_bitmap_index()) {
+            // no bitmap index for this column, or the predicate can't be evaluated by it
             remaining_predicates.push_back(pred);
         } else {
             RETURN_IF_ERROR(pred->evaluate(_schema, _bitmap_index_iterators, _segment->num_rows(),
@@ -340,6 +470,44 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+// filter rows by match predicates using inverted indexes, or n-gram bloom filter indexes
+// for the columns without inverted index.
+// upon return, all the match predicates are removed from _col_predicates, they are only
+// hints for the indexes and the original predicates are evaluated elsewhere.
+Status SegmentIterator::_apply_match_predicates() {
+    std::vector<ColumnPredicate*> remaining_predicates;
+    for (auto pred : _col_predicates) {
+        if (pred->type() != PredicateType::MATCH) {
+            remaining_predicates.push_back(pred);
+            continue;
+        }
+        if (_row_bitmap.isEmpty()) {
+            continue;
+        }
+        auto match_pred = static_cast<MatchPredicate*>(pred);
+        InvertedIndexIterator* iter = nullptr;
+        RETURN_IF_ERROR(_segment->new_inverted_index_iterator(pred->column_id(), &iter));
+        if (iter != nullptr) {
+            SCOPED_RAW_TIMER(&_opts.stats->inverted_index_filter_timer);
+            std::unique_ptr<InvertedIndexIterator> iter_holder(iter);
+            size_t input_rows = _row_bitmap.cardinality();
+            RETURN_IF_ERROR(match_pred->evaluate(iter_holder.get(), &_row_bitmap));
+            _opts.stats->rows_inverted_index_filtered += (input_rows - _row_bitmap.cardinality());
+        } else if (!match_pred->substrings().empty() &&
+                   _column_iterators[pred->column_id()] != nullptr) {
+            ColumnIterator* column_iter = _column_iterators[pred->column_id()];
+            RowRanges bf_row_ranges = RowRanges::create_single(num_rows());
+            RETURN_IF_ERROR(column_iter->get_row_ranges_by_ngram_bloom_filter(
+                    match_pred->substrings(), &bf_row_ranges));
+            size_t input_rows = _row_bitmap.cardinality();
+            _row_bitmap &= RowRanges::ranges_to_roaring(bf_row_ranges);
+            _opts.stats->rows_bf_filtered += (input_rows - _row_bitmap.cardinality());
+        }
+    }
+    _col_predicates = std::move(remaining_predicates);
+    return Status::OK();
+}
+
 Status SegmentIterator::_init_return_column_iterators() {
     if (_cur_rowid >= num_rows()) {
         return Status::OK();
@@ -350,6 +518,7 @@ Status SegmentIterator::_init_return_column_iterators() {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.fill_page_cache = _opts.fill_page_cache;
             iter_opts.file_reader = _file_reader.get();
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
         }
@@ -398,7 +567,7 @@ Status SegmentIterator::_lookup_ordinal(const RowCursor& key, bool is_include, r
     encode_key_with_padding(&index_key, key, _segment->num_short_keys(), is_include);
 
     uint32_t start_block_id = 0;
-    auto start_iter = _segment->lower_bound(index_key);
+    auto [start_iter, end_iter] = _segment->equal_range(index_key);
     if (start_iter.valid()) {
         // Because previous block may contain this key, so we should set rowid to
         // last block's first row.
@@ -415,7 +584,6 @@ Status SegmentIterator::_lookup_ordinal(const RowCursor& key, bool is_include, r
     rowid_t start = start_block_id * _segment->num_rows_per_block();
 
     rowid_t end = upper_bound;
-    auto end_iter = _segment->upper_bound(index_key);
     if (end_iter.valid()) {
         end = end_iter.ordinal() * _segment->num_rows_per_block();
     }
@@ -638,6 +806,12 @@ Status SegmentIterator::next_batch(RowBlockV2* block) {
 // todo(wb) need a UT here
 void SegmentIterator::_vec_init_lazy_materialization() {
     _is_pred_column.resize(_schema.columns().size(), false);
+    _is_dict_output_column.resize(_schema.columns().size(), false);
+    for (auto cid : _opts.dict_output_columns) {
+        if (cid < _schema.columns().size() && _schema.column(cid) != nullptr) {
+            _is_dict_output_column[cid] = true;
+        }
+    }
 
     // including short/vec/delete pred
     std::set<ColumnId> pred_column_ids;
@@ -665,7 +839,7 @@ void SegmentIterator::_vec_init_lazy_materialization() {
                 predicate->type() == PredicateType::IS_NOT_NULL || type == OLAP_FIELD_TYPE_DATE ||
                 type == OLAP_FIELD_TYPE_DECIMAL) {
                 short_cir_pred_col_id_set.insert(cid);
-                _short_cir_eval_predicate.push_back(predicate);
+                _short_cir_eval_predicate.emplace_back(predicate);
             } else {
                 vec_pred_col_id_set.insert(predicate->column_id());
                 if (_pre_eval_block_predicate == nullptr) {
@@ -760,6 +934,23 @@ void SegmentIterator::_vec_init_lazy_materialization() {
         }
     }
 
+    // Step 4: read the predicate columns by stage if more than one of them is read before
+    // the non-predicate columns
+    if (config::enable_staged_predicate_column_read && _lazy_materialization_read &&
+        !_col_predicates.empty() && pred_column_ids.size() > 1) {
+        _staged_predicate_read = true;
+        for (auto cid : pred_column_ids) {
+            PredicateColumnStage stage;
+            stage.cid = cid;
+            for (auto predicate : _col_predicates) {
+                if (predicate->column_id() == cid) {
+                    stage.predicates.emplace_back(predicate);
+                }
+            }
+            _predicate_stages.push_back(std::move(stage));
+        }
+    }
+
     // make _schema_block_id_map
     _schema_block_id_map.resize(_schema.columns().size());
     for (int i = 0; i < _schema.num_column_ids(); i++) {
@@ -799,10 +990,24 @@ void SegmentIterator::_init_current_block(
         auto column_desc = _schema.column(cid);
 
         // the column in block must clear() here to insert new data
-        if (_is_pred_column[cid] ||
+        bool is_pred_or_dict_column = _is_pred_column[cid] || _is_dict_output_column[cid];
+        if (is_pred_or_dict_column ||
             i >= block->columns()) { //todo(wb) maybe we can release it after output block
             current_columns[cid]->clear();
+            if (is_pred_or_dict_column && _is_dictionary_column_converted(column_desc->type(),
+                                                                         *current_columns[cid])) {
+                // A dictionary column is converted to a predicate column when a plain page
+                // is read, use a dictionary column again in case the following pages are
+                // dict-encoded.
+                current_columns[cid] = Schema::get_predicate_column_nullable_ptr(
+                        column_desc->type(), column_desc->is_nullable());
+                current_columns[cid]->reserve(_opts.block_row_max);
+            }
         } else { // non-predicate column
+            if (_is_dictionary_column(*block->get_by_position(i).column)) {
+                // output as a dictionary column by the previous reader
+                block->replace_by_position(i, block->get_by_position(i).type->create_column());
+            }
             current_columns[cid] = std::move(*block->get_by_position(i).column).mutate();
 
             if (column_desc->type() == OLAP_FIELD_TYPE_DATE) {
@@ -815,19 +1020,90 @@ void SegmentIterator::_init_current_block(
     }
 }
 
-void SegmentIterator::_output_non_pred_columns(vectorized::Block* block) {
+bool SegmentIterator::_is_dictionary_column(const vectorized::IColumn& column) {
+    if (column.is_nullable()) {
+        return reinterpret_cast<const vectorized::ColumnNullable&>(column)
+                .get_nested_column()
+                .is_column_dictionary();
+    }
+    return column.is_column_dictionary();
+}
+
+bool SegmentIterator::_is_dictionary_column_converted(FieldType type,
+                                                     const vectorized::IColumn& column) {
+    if (!config::enable_low_cardinality_optimize ||
+        (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR &&
+         type != OLAP_FIELD_TYPE_STRING)) {
+        return false;
+    }
+    return !_is_dictionary_column(column);
+}
+
+Status SegmentIterator::_output_non_pred_columns(vectorized::Block* block) {
     SCOPED_RAW_TIMER(&_opts.stats->output_col_ns);
     for (auto cid : _non_predicate_columns) {
         auto loc = _schema_block_id_map[cid];
         // if loc < block->block->columns() means the column is delete column and should
         // not output by block, so just skip the column.
         if (loc < block->columns()) {
-            block->replace_by_position(loc, std::move(_current_return_columns[cid]));
+            if (_is_dict_output_column[cid]) {
+                RETURN_IF_ERROR(_output_dict_column(block, cid, nullptr, 0));
+            } else {
+                block->replace_by_position(loc, std::move(_current_return_columns[cid]));
+            }
         }
     }
+    return Status::OK();
 }
 
-Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32_t& nrows_read,
+Status SegmentIterator::_output_dict_column(vectorized::Block* block, ColumnId cid,
+                                            uint16_t* sel_rowid_idx, uint16_t select_size) {
+    int block_cid = _schema_block_id_map[cid];
+    if (block_cid >= block->columns()) {
+        return Status::OK();
+    }
+    auto& column = _current_return_columns[cid];
+    std::vector<uint16_t> all_rows;
+    if (sel_rowid_idx == nullptr) {
+        all_rows.resize(column->size());
+        std::iota(all_rows.begin(), all_rows.end(), 0);
+        sel_rowid_idx = all_rows.data();
+        select_size = all_rows.size();
+    }
+
+    const auto& type = block->get_by_position(block_cid).type;
+    if (!_is_dictionary_column(*column)) {
+        // converted to a predicate column by a plain page
+        block->replace_by_position(block_cid, type->create_column());
+        return block->copy_column_data_to_block(column.get(), sel_rowid_idx, select_size,
+                                                block_cid, _opts.block_row_max);
+    }
+
+    const vectorized::IColumn* nested_col = column.get();
+    const vectorized::NullMap* null_map = nullptr;
+    if (column->is_nullable()) {
+        auto* nullable_col = reinterpret_cast<const vectorized::ColumnNullable*>(column.get());
+        nested_col = &nullable_col->get_nested_column();
+        null_map = &nullable_col->get_null_map_data();
+    }
+    auto res = reinterpret_cast<const vectorized::ColumnDictI32*>(nested_col)
+                       ->create_owned_column(sel_rowid_idx, select_size);
+    if (type->is_nullable()) {
+        auto res_null_map = vectorized::ColumnUInt8::create(select_size, 0);
+        if (null_map != nullptr) {
+            auto& res_null_data = res_null_map->get_data();
+            for (size_t i = 0; i < select_size; ++i) {
+                res_null_data[i] = (*null_map)[sel_rowid_idx[i]];
+            }
+        }
+        res = vectorized::ColumnNullable::create(std::move(res), std::move(res_null_map));
+    }
+    block->replace_by_position(block_cid, std::move(res));
+    return Status::OK();
+}
+
+Status SegmentIterator::_read_columns_by_index(const std::vector<ColumnId>& column_ids,
+                                               uint32_t nrows_read_limit, uint32_t& nrows_read,
                                                bool set_block_rowid) {
     SCOPED_RAW_TIMER(&_opts.stats->first_read_ns);
     do {
@@ -840,11 +1116,10 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
         }
         if (_cur_rowid == 0 || _cur_rowid != range_from) {
             _cur_rowid = range_from;
-            RETURN_IF_ERROR(_seek_columns(_first_read_column_ids, _cur_rowid));
+            RETURN_IF_ERROR(_seek_columns(column_ids, _cur_rowid));
         }
         size_t rows_to_read = range_to - range_from;
-        RETURN_IF_ERROR(
-                _read_columns(_first_read_column_ids, _current_return_columns, rows_to_read));
+        RETURN_IF_ERROR(_read_columns(column_ids, _current_return_columns, rows_to_read));
         _cur_rowid += rows_to_read;
         if (set_block_rowid) {
             for (uint32_t rid = range_from; rid < range_to; rid++) {
@@ -857,6 +1132,92 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
     return Status::OK();
 }
 
+Status SegmentIterator::_read_and_evaluate_by_stage(uint32_t nrows_read_limit,
+                                                    uint32_t& nrows_read, uint16_t* sel_rowid_idx,
+                                                    uint16_t* selected_size) {
+    // the order of the last batches is kept for ties, so that the first column isn't changed
+    // back and forth
+    std::stable_sort(_predicate_stages.begin(), _predicate_stages.end(),
+                     [](const PredicateColumnStage& l, const PredicateColumnStage& r) {
+                         return l.pass_ratio() < r.pass_ratio();
+                     });
+    ColumnId first_cid = _predicate_stages[0].cid;
+    if (first_cid != _first_stage_cid) {
+        // the iterator of the new first column is at where the last batch read it to
+        if (_cur_rowid != 0) {
+            RETURN_IF_ERROR(_column_iterators[first_cid]->seek_to_ordinal(_cur_rowid));
+        }
+        _first_stage_cid = first_cid;
+    }
+    RETURN_IF_ERROR(_read_columns_by_index({first_cid}, nrows_read_limit, nrows_read, true));
+    if (nrows_read == 0) {
+        return Status::OK();
+    }
+
+    *selected_size = nrows_read;
+    for (uint32_t i = 0; i < nrows_read; ++i) {
+        sel_rowid_idx[i] = i;
+    }
+    for (auto& stage : _predicate_stages) {
+        if (stage.cid != first_cid) {
+            if (*selected_size == 0) {
+                // none of the rows is read, the columns are not output either
+                _opts.stats->rows_pred_column_skipped += nrows_read;
+                continue;
+            }
+            RETURN_IF_ERROR(_read_column_by_selected_rows(stage.cid, sel_rowid_idx,
+                                                          *selected_size, nrows_read));
+        }
+        SCOPED_RAW_TIMER(&_opts.stats->short_cond_ns);
+        uint16_t input_size = *selected_size;
+        _evaluate_adaptive_predicates(stage.predicates, sel_rowid_idx, selected_size);
+        stage.input_rows += input_size;
+        stage.passed_rows += *selected_size;
+    }
+    _opts.stats->rows_vec_cond_filtered += nrows_read - *selected_size;
+
+    uint16_t original_size = *selected_size;
+    _opts.delete_condition_predicates->evaluate(_current_return_columns, sel_rowid_idx,
+                                                selected_size);
+    _opts.stats->rows_vec_del_cond_filtered += original_size - *selected_size;
+    return Status::OK();
+}
+
+Status SegmentIterator::_read_column_by_selected_rows(ColumnId cid, const uint16_t* sel_rowid_idx,
+                                                      uint16_t selected_size,
+                                                      uint32_t nrows_read) {
+    // a gap of fewer rows is read through rather than seeked over, most likely it's in the
+    // same page anyway
+    static constexpr uint32_t MAX_READ_GAP = 32;
+    SCOPED_RAW_TIMER(&_opts.stats->lazy_read_ns);
+    auto& column = _current_return_columns[cid];
+    uint32_t pos = 0;
+    uint16_t i = 0;
+    while (i < selected_size) {
+        uint32_t start = sel_rowid_idx[i];
+        uint32_t end = start + 1;
+        for (++i; i < selected_size; ++i) {
+            uint32_t next = sel_rowid_idx[i];
+            // the rows in between must be consecutive in the segment to be read at once
+            if (next - end >= MAX_READ_GAP ||
+                _block_rowids[next] - _block_rowids[start] != next - start) {
+                break;
+            }
+            end = next + 1;
+        }
+        column->insert_many_defaults(start - pos);
+        RETURN_IF_ERROR(_column_iterators[cid]->seek_to_ordinal(_block_rowids[start]));
+        size_t rows_read = end - start;
+        RETURN_IF_ERROR(_column_iterators[cid]->next_batch(&rows_read, column));
+        DCHECK_EQ(end - start, rows_read);
+        _opts.stats->rows_pred_column_skipped += start - pos;
+        pos = end;
+    }
+    column->insert_many_defaults(nrows_read - pos);
+    _opts.stats->rows_pred_column_skipped += nrows_read - pos;
+    return Status::OK();
+}
+
 void SegmentIterator::_evaluate_vectorization_predicate(uint16_t* sel_rowid_idx,
                                                         uint16_t& selected_size) {
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
@@ -906,17 +1267,8 @@ void SegmentIterator::_evaluate_short_circuit_predicate(uint16_t* vec_sel_rowid_
     }
 
     uint16_t original_size = *selected_size_ptr;
-    for (auto predicate : _short_cir_eval_predicate) {
-        auto column_id = predicate->column_id();
-        auto& short_cir_column = _current_return_columns[column_id];
-        auto* col_ptr = short_cir_column.get();
-        // range comparison predicate needs to sort the dict and convert the encoding
-        if (predicate->type() == PredicateType::LT || predicate->type() == PredicateType::LE ||
-            predicate->type() == PredicateType::GT || predicate->type() == PredicateType::GE) {
-            col_ptr->convert_dict_codes_if_necessary();
-        }
-        predicate->evaluate(*short_cir_column, vec_sel_rowid_idx, selected_size_ptr);
-    }
+    _evaluate_adaptive_predicates(_short_cir_eval_predicate, vec_sel_rowid_idx,
+                                  selected_size_ptr);
     _opts.stats->rows_vec_cond_filtered += original_size - *selected_size_ptr;
 
     // evaluate delete condition
@@ -926,11 +1278,45 @@ void SegmentIterator::_evaluate_short_circuit_predicate(uint16_t* vec_sel_rowid_
     _opts.stats->rows_vec_del_cond_filtered += original_size - *selected_size_ptr;
 }
 
+void SegmentIterator::_evaluate_adaptive_predicates(std::vector<AdaptivePredicate>& predicates,
+                                                    uint16_t* sel_rowid_idx,
+                                                    uint16_t* selected_size) {
+    // the statistics are halved after so many rows, so that the order follows the data
+    static constexpr uint64_t STATS_DECAY_ROWS = 1 << 20;
+    if (config::enable_adaptive_predicate_order && predicates.size() > 1) {
+        std::stable_sort(predicates.begin(), predicates.end(),
+                         [](const AdaptivePredicate& l, const AdaptivePredicate& r) {
+                             return l.rank() < r.rank();
+                         });
+    }
+    for (auto& pred : predicates) {
+        if (*selected_size == 0) {
+            break;
+        }
+        auto& column = _current_return_columns[pred.predicate->column_id()];
+        uint16_t input_size = *selected_size;
+        int64_t start_ns = MonotonicNanos();
+        pred.predicate->evaluate(*column, sel_rowid_idx, selected_size);
+        pred.cost_ns += MonotonicNanos() - start_ns;
+        pred.input_rows += input_size;
+        pred.passed_rows += *selected_size;
+        if (pred.input_rows > STATS_DECAY_ROWS) {
+            pred.input_rows /= 2;
+            pred.passed_rows /= 2;
+            pred.cost_ns /= 2;
+        }
+    }
+}
+
 void SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_column_ids,
                                               std::vector<rowid_t>& rowid_vector,
                                               uint16_t* sel_rowid_idx, size_t select_size,
                                               vectorized::MutableColumns* mutable_columns) {
     SCOPED_RAW_TIMER(&_opts.stats->lazy_read_ns);
+    if (_read_columns_by_row_store(read_column_ids, rowid_vector, sel_rowid_idx, select_size,
+                                   mutable_columns)) {
+        return;
+    }
     size_t start_idx = 0;
     while (start_idx < select_size) {
         size_t end_idx = start_idx + 1;
@@ -945,11 +1331,164 @@ void SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_column
     }
 }
 
+bool SegmentIterator::_read_columns_by_row_store(const std::vector<ColumnId>& read_column_ids,
+                                                 const std::vector<rowid_t>& rowid_vector,
+                                                 const uint16_t* sel_rowid_idx,
+                                                 size_t select_size,
+                                                 vectorized::MutableColumns* mutable_columns) {
+    if (_row_store_unsupported || !_segment->has_row_store() || select_size == 0 ||
+        select_size > (size_t)config::row_store_max_read_rows ||
+        read_column_ids.size() * 2 < _segment->_tablet_schema->num_columns()) {
+        return false;
+    }
+    std::vector<rowid_t> row_ids(select_size);
+    for (size_t i = 0; i < select_size; ++i) {
+        row_ids[i] = rowid_vector[sel_rowid_idx[i]];
+    }
+    std::vector<vectorized::IColumn*> columns;
+    for (auto cid : read_column_ids) {
+        columns.push_back((*mutable_columns)[cid].get());
+    }
+    ColumnIteratorOptions iter_opts;
+    iter_opts.stats = _opts.stats;
+    iter_opts.use_page_cache = _opts.use_page_cache;
+    iter_opts.fill_page_cache = _opts.fill_page_cache;
+    iter_opts.file_reader = _file_reader.get();
+    auto st = _segment->read_rows_from_row_store(iter_opts, row_ids.data(), select_size,
+                                                 read_column_ids, columns);
+    if (st.ok()) {
+        _opts.stats->rows_read_by_row_store += select_size;
+    } else if (st.is_not_supported()) {
+        VLOG_DEBUG << st.to_string();
+        _row_store_unsupported = true;
+    } else if (!st.ok()) {
+        LOG(WARNING) << "failed to read the row store, read the columns instead: " << st;
+    }
+    return st.ok();
+}
+
+bool SegmentIterator::_can_read_by_metadata() {
+    if (_opts.push_down_agg_type_opt == TPushAggOp::NONE || !_col_predicates.empty() ||
+        (_opts.runtime_predicates != nullptr && !_opts.runtime_predicates->empty()) ||
+        (_opts.conditions != nullptr && !_opts.conditions->empty()) ||
+        !_opts.key_ranges.empty() || !_opts.delete_conditions.empty() ||
+        _opts.delete_condition_predicates->num_of_column_predicate() > 0 ||
+        _opts.delete_bitmap.count(segment_id()) > 0) {
+        return false;
+    }
+    if (_opts.push_down_agg_type_opt == TPushAggOp::COUNT) {
+        return true;
+    }
+    DCHECK_EQ(_opts.push_down_agg_type_opt, TPushAggOp::MINMAX);
+    for (auto cid : _schema.column_ids()) {
+        ColumnReader* reader = nullptr;
+        if (!_segment->_get_column_reader(cid, &reader).ok() || reader == nullptr) {
+            return false;
+        }
+        // the zone maps of the other types are truncated or in another format than the columns
+        switch (_schema.column(cid)->type()) {
+        case OLAP_FIELD_TYPE_TINYINT:
+        case OLAP_FIELD_TYPE_SMALLINT:
+        case OLAP_FIELD_TYPE_INT:
+        case OLAP_FIELD_TYPE_BIGINT:
+        case OLAP_FIELD_TYPE_LARGEINT:
+        case OLAP_FIELD_TYPE_FLOAT:
+        case OLAP_FIELD_TYPE_DOUBLE:
+            break;
+        default:
+            return false;
+        }
+        auto zone_map = reader->segment_zone_map();
+        if (zone_map == nullptr || zone_map->pass_all()) {
+            return false;
+        }
+        if (!zone_map->has_not_null() && !_schema.column(cid)->is_nullable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status SegmentIterator::_next_batch_by_metadata(vectorized::Block* block) {
+    block->clear_column_data(_schema.num_column_ids());
+    size_t num_rows = _segment->num_rows() - _cur_rowid;
+    if (_opts.push_down_agg_type_opt == TPushAggOp::COUNT) {
+        num_rows = std::min<size_t>(num_rows, _opts.block_row_max);
+    } else if (num_rows > 0) {
+        // the min values and the max values
+        num_rows = 2;
+    }
+    if (num_rows == 0) {
+        return Status::EndOfFile("no more data in segment");
+    }
+    for (size_t i = 0; i < _schema.num_column_ids(); ++i) {
+        auto column = block->get_by_position(i).column->assume_mutable();
+        if (_opts.push_down_agg_type_opt == TPushAggOp::COUNT) {
+            column->insert_many_defaults(num_rows);
+            continue;
+        }
+        auto cid = _schema.column_id(i);
+        ColumnReader* reader = nullptr;
+        RETURN_IF_ERROR(_segment->_get_column_reader(cid, &reader));
+        auto zone_map = reader->segment_zone_map();
+        if (!zone_map->has_not_null()) {
+            column->insert_many_defaults(num_rows);
+            continue;
+        }
+        auto field = _schema.column(cid);
+        std::unique_ptr<WrapperField> value(WrapperField::create_by_type(field->type()));
+        for (auto& str : {zone_map->min(), zone_map->max()}) {
+            RETURN_IF_ERROR(value->from_string(str));
+            column->insert_data(reinterpret_cast<const char*>(value->cell_ptr()), 0);
+        }
+    }
+    size_t rows_answered = _opts.push_down_agg_type_opt == TPushAggOp::COUNT
+                                   ? num_rows
+                                   : _segment->num_rows() - _cur_rowid;
+    _cur_rowid += rows_answered;
+    _opts.stats->blocks_load += 1;
+    _opts.stats->rows_read_by_metadata += rows_answered;
+    return Status::OK();
+}
+
+bool SegmentIterator::_can_count_by_index() const {
+    // the predicates left are those not evaluated by the indexes
+    return _opts.push_down_agg_type_opt == TPushAggOp::COUNT && _col_predicates.empty() &&
+           _opts.delete_condition_predicates->num_of_column_predicate() == 0;
+}
+
+Status SegmentIterator::_next_batch_by_index(vectorized::Block* block) {
+    block->clear_column_data(_schema.num_column_ids());
+    uint32_t num_rows = 0;
+    uint32_t range_from = 0;
+    uint32_t range_to = 0;
+    while (num_rows < _opts.block_row_max &&
+           _range_iter->next_range(_opts.block_row_max - num_rows, &range_from, &range_to)) {
+        num_rows += range_to - range_from;
+    }
+    if (num_rows == 0) {
+        return Status::EndOfFile("no more data in segment");
+    }
+    for (size_t i = 0; i < _schema.num_column_ids(); ++i) {
+        block->get_by_position(i).column->assume_mutable()->insert_many_defaults(num_rows);
+    }
+    _opts.stats->blocks_load += 1;
+    _opts.stats->rows_counted_by_index += num_rows;
+    return Status::OK();
+}
+
 Status SegmentIterator::next_batch(vectorized::Block* block) {
     bool is_mem_reuse = block->mem_reuse();
     DCHECK(is_mem_reuse);
 
     SCOPED_RAW_TIMER(&_opts.stats->block_load_ns);
+    if (UNLIKELY(!_inited) && _can_read_by_metadata()) {
+        _inited = true;
+        _read_by_metadata = true;
+    }
+    if (_read_by_metadata) {
+        return _next_batch_by_metadata(block);
+    }
     if (UNLIKELY(!_inited)) {
         RETURN_IF_ERROR(_init(true));
         _inited = true;
@@ -960,7 +1499,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
         for (size_t i = 0; i < _schema.num_column_ids(); i++) {
             auto cid = _schema.column_id(i);
             auto column_desc = _schema.column(cid);
-            if (_is_pred_column[cid]) {
+            if (_is_pred_column[cid] || _is_dict_output_column[cid]) {
                 _current_return_columns[cid] = Schema::get_predicate_column_nullable_ptr(
                         column_desc->type(), column_desc->is_nullable());
                 _current_return_columns[cid]->reserve(_opts.block_row_max);
@@ -978,12 +1517,23 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
             }
         }
     }
+    if (_count_by_index) {
+        return _next_batch_by_index(block);
+    }
 
     _init_current_block(block, _current_return_columns);
 
     uint32_t nrows_read = 0;
     uint32_t nrows_read_limit = _opts.block_row_max;
-    _read_columns_by_index(nrows_read_limit, nrows_read, _lazy_materialization_read);
+    uint16_t selected_size = 0;
+    uint16_t sel_rowid_idx[nrows_read_limit];
+    if (_staged_predicate_read) {
+        RETURN_IF_ERROR(_read_and_evaluate_by_stage(nrows_read_limit, nrows_read, sel_rowid_idx,
+                                                    &selected_size));
+    } else {
+        RETURN_IF_ERROR(_read_columns_by_index(_first_read_column_ids, nrows_read_limit,
+                                               nrows_read, _lazy_materialization_read));
+    }
 
     _opts.stats->blocks_load += 1;
     _opts.stats->raw_rows_read += nrows_read;
@@ -992,7 +1542,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
         for (int i = 0; i < block->columns(); i++) {
             auto cid = _schema.column_id(i);
             // todo(wb) abstract make column where
-            if (!_is_pred_column[cid]) { // non-predicate
+            if (!_is_pred_column[cid] && !_is_dict_output_column[cid]) { // non-predicate
                 block->replace_by_position(i, std::move(_current_return_columns[cid]));
             }
         }
@@ -1001,19 +1551,20 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
     }
 
     if (!_is_need_vec_eval && !_is_need_short_eval) {
-        _output_non_pred_columns(block);
+        RETURN_IF_ERROR(_output_non_pred_columns(block));
     } else {
-        uint16_t selected_size = nrows_read;
-        uint16_t sel_rowid_idx[selected_size];
+        if (!_staged_predicate_read) {
+            selected_size = nrows_read;
 
-        // step 1: evaluate vectorization predicate
-        _evaluate_vectorization_predicate(sel_rowid_idx, selected_size);
+            // step 1: evaluate vectorization predicate
+            _evaluate_vectorization_predicate(sel_rowid_idx, selected_size);
 
-        // step 2: evaluate short ciruit predicate
-        // todo(wb) research whether need to read short predicate after vectorization evaluation
-        //          to reduce cost of read short circuit columns.
-        //          In SSB test, it make no difference; So need more scenarios to test
-        _evaluate_short_circuit_predicate(sel_rowid_idx, &selected_size);
+            // step 2: evaluate short ciruit predicate
+            // todo(wb) research whether need to read short predicate after vectorization
+            //          evaluation to reduce cost of read short circuit columns.
+            //          In SSB test, it make no difference; So need more scenarios to test
+            _evaluate_short_circuit_predicate(sel_rowid_idx, &selected_size);
+        }
 
         if (!_lazy_materialization_read) {
             Status ret = _output_column_by_sel_idx(block, _first_read_column_ids, sel_rowid_idx,
@@ -1032,7 +1583,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
 
         // step4: output columns
         // 4.1 output non-predicate column
-        _output_non_pred_columns(block);
+        RETURN_IF_ERROR(_output_non_pred_columns(block));
 
         // 4.3 output short circuit and predicate column
         // when lazy materialization enables, _first_read_column_ids = distinct(_short_cir_pred_column_ids + _vec_pred_column_ids)
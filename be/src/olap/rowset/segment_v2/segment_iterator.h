@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <roaring/roaring.hh>
 #include <vector>
@@ -75,11 +77,16 @@ private:
 
     // calculate row ranges that satisfy requested column conditions using various column index
     Status _get_row_ranges_by_column_conditions();
+    Status _apply_delete_predicate_bitmap();
+    Status _evaluate_delete_predicates(roaring::Roaring* deleted_rows);
     Status _get_row_ranges_from_conditions(RowRanges* condition_row_ranges);
     Status _apply_bitmap_index();
+    Status _apply_match_predicates();
 
     void _init_lazy_materialization();
     void _vec_init_lazy_materialization();
+    // hint the file reader to prefetch the data pages of `column_ids` selected by _row_bitmap
+    Status _prefetch_data_pages(const std::vector<ColumnId>& column_ids);
     // TODO: Fix Me
     // CHAR type in storge layer padding the 0 in length. But query engine need ignore the padding 0.
     // so segment iterator need to shrink char column before output it. only use in vec query engine.
@@ -96,22 +103,56 @@ private:
     // for vectorization implementation
     Status _read_columns(const std::vector<ColumnId>& column_ids,
                          vectorized::MutableColumns& column_block, size_t nrows);
-    Status _read_columns_by_index(uint32_t nrows_read_limit, uint32_t& nrows_read,
+    Status _read_columns_by_index(const std::vector<ColumnId>& column_ids,
+                                  uint32_t nrows_read_limit, uint32_t& nrows_read,
                                   bool set_block_rowid);
+    // Read the predicate columns by stage and evaluate the predicates and the delete
+    // conditions on them, see _predicate_stages.
+    Status _read_and_evaluate_by_stage(uint32_t nrows_read_limit, uint32_t& nrows_read,
+                                       uint16_t* sel_rowid_idx, uint16_t* selected_size);
+    // Read the rows at `sel_rowid_idx` of the column, the other rows of the block are filled
+    // with defaults to be aligned with the columns read by _read_columns_by_index().
+    Status _read_column_by_selected_rows(ColumnId cid, const uint16_t* sel_rowid_idx,
+                                         uint16_t selected_size, uint32_t nrows_read);
+    // Whether the aggregation pushed down can be answered by the metadata of the segment,
+    // see StorageReadOptions::push_down_agg_type_opt.
+    bool _can_read_by_metadata();
+    Status _next_batch_by_metadata(vectorized::Block* block);
+    // Whether the COUNT pushed down can be answered by the rows left in _row_bitmap, i.e.
+    // all the predicates are evaluated by the indexes and no column needs to be read.
+    bool _can_count_by_index() const;
+    Status _next_batch_by_index(vectorized::Block* block);
     void _init_current_block(vectorized::Block* block,
                              std::vector<vectorized::MutableColumnPtr>& non_pred_vector);
+    static bool _is_dictionary_column(const vectorized::IColumn& column);
+    // whether `column` of a string predicate column is not a dictionary column any more
+    static bool _is_dictionary_column_converted(FieldType type, const vectorized::IColumn& column);
     void _evaluate_vectorization_predicate(uint16_t* sel_rowid_idx, uint16_t& selected_size);
     void _evaluate_short_circuit_predicate(uint16_t* sel_rowid_idx, uint16_t* selected_size);
-    void _output_non_pred_columns(vectorized::Block* block);
+    struct AdaptivePredicate;
+    // Evaluate the predicates on the selected rows one by one, see AdaptivePredicate.
+    void _evaluate_adaptive_predicates(std::vector<AdaptivePredicate>& predicates,
+                                       uint16_t* sel_rowid_idx, uint16_t* selected_size);
+    Status _output_non_pred_columns(vectorized::Block* block);
     void _read_columns_by_rowids(std::vector<ColumnId>& read_column_ids,
                                  std::vector<rowid_t>& rowid_vector, uint16_t* sel_rowid_idx,
                                  size_t select_size, vectorized::MutableColumns* mutable_columns);
+    // Reads the selected rows from the row store of the segment if there are a few of them
+    // and most columns are read, returns false if they are not read.
+    bool _read_columns_by_row_store(const std::vector<ColumnId>& read_column_ids,
+                                    const std::vector<rowid_t>& rowid_vector,
+                                    const uint16_t* sel_rowid_idx, size_t select_size,
+                                    vectorized::MutableColumns* mutable_columns);
 
     template <class Container>
     Status _output_column_by_sel_idx(vectorized::Block* block, const Container& column_ids,
                                      uint16_t* sel_rowid_idx, uint16_t select_size) {
         SCOPED_RAW_TIMER(&_opts.stats->output_col_ns);
         for (auto cid : column_ids) {
+            if (_is_dict_output_column[cid]) {
+                RETURN_IF_ERROR(_output_dict_column(block, cid, sel_rowid_idx, select_size));
+                continue;
+            }
             int block_cid = _schema_block_id_map[cid];
             RETURN_IF_ERROR(block->copy_column_data_to_block(_current_return_columns[cid].get(),
                                                              sel_rowid_idx, select_size, block_cid,
@@ -120,6 +161,12 @@ private:
         return Status::OK();
     }
 
+    // Output the selected rows of a column of `_opts.dict_output_columns`, or all rows if
+    // `sel_rowid_idx` is nullptr, as a dictionary column which owns its dictionary, or as a
+    // string column if plain pages are read.
+    Status _output_dict_column(vectorized::Block* block, ColumnId cid, uint16_t* sel_rowid_idx,
+                               uint16_t select_size);
+
 private:
     class BitmapRangeIterator;
 
@@ -140,6 +187,8 @@ private:
     // --------------------------------------------
     // whether lazy materialization read should be used.
     bool _lazy_materialization_read;
+    // set if the columns read can't be read from the row store
+    bool _row_store_unsupported = false;
     // columns to read before predicate evaluation
     std::vector<ColumnId> _predicate_columns;
     // columns to read after predicate evaluation
@@ -156,9 +205,57 @@ private:
     std::vector<ColumnId>
             _short_cir_pred_column_ids; // keep columnId of columns for short circuit predicate evaluation
     std::vector<bool> _is_pred_column; // columns hold by segmentIter
+    // columns returned as dictionary columns, see StorageReadOptions::dict_output_columns
+    std::vector<bool> _is_dict_output_column;
     vectorized::MutableColumns _current_return_columns;
     std::unique_ptr<AndBlockColumnPredicate> _pre_eval_block_predicate;
-    std::vector<ColumnPredicate*> _short_cir_eval_predicate;
+    // A predicate evaluated on the rows passing the predicates before it, with its statistics
+    // over the batches. The predicates are ordered by their cost per filtered row, so that the
+    // cheap and selective ones are evaluated first and the others see fewer rows.
+    struct AdaptivePredicate {
+        ColumnPredicate* predicate;
+        uint64_t input_rows = 0;
+        uint64_t passed_rows = 0;
+        int64_t cost_ns = 0;
+
+        AdaptivePredicate(ColumnPredicate* pred) : predicate(pred) {}
+
+        double rank() const {
+            if (input_rows == 0) {
+                // evaluate it first to get the statistics
+                return 0;
+            }
+            double filtered_ratio = 1 - double(passed_rows) / input_rows;
+            return double(cost_ns + 1) / input_rows / std::max(filtered_ratio, 0.001);
+        }
+    };
+    std::vector<AdaptivePredicate> _short_cir_eval_predicate;
+
+    // When the predicate columns are read by stage, only the first column is read for the
+    // whole batch, each of the other columns is only read for the rows passing the predicates
+    // of the columns before it. The columns are ordered by the ratio of the rows passing their
+    // predicates, the delete condition columns without predicates are the last.
+    struct PredicateColumnStage {
+        ColumnId cid;
+        std::vector<AdaptivePredicate> predicates;
+        uint64_t input_rows = 0;
+        uint64_t passed_rows = 0;
+
+        double pass_ratio() const {
+            if (predicates.empty()) {
+                return 2;
+            }
+            return input_rows == 0 ? 1 : double(passed_rows) / input_rows;
+        }
+    };
+    bool _staged_predicate_read = false;
+    // the rows are answered by the metadata instead of the data pages
+    bool _read_by_metadata = false;
+    // the rows are counted by the indexes instead of read from the data pages
+    bool _count_by_index = false;
+    std::vector<PredicateColumnStage> _predicate_stages;
+    // the column of the first stage of the last batch, its iterator is at _cur_rowid
+    ColumnId _first_stage_cid = std::numeric_limits<ColumnId>::max();
     // when lazy materialization is enable, segmentIter need to read data at least twice
     // first, read predicate columns by various index
     // second, read non-predicate columns
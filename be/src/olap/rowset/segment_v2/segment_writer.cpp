@@ -17,19 +17,31 @@
 
 #include "olap/rowset/segment_v2/segment_writer.h"
 
+#include <numeric>
+
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "io/fs/file_writer.h"
 #include "olap/data_dir.h"
+#include "olap/partial_update_info.h"
 #include "olap/row.h"                             // ContiguousRow
 #include "olap/row_cursor.h"                      // RowCursor
+#include "olap/rowset/segment_v2/column_statistics.h"
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "olap/rowset/segment_v2/page_io.h"
+#include "olap/rowset/segment_v2/primary_key_index.h"
+#include "olap/rowset/segment_v2/row_store_codec.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
+#include "olap/tablet.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/thread_context.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "util/threadpool.h"
+#include "vec/data_types/data_type_factory.hpp"
 
 namespace doris {
 namespace segment_v2 {
@@ -47,8 +59,7 @@ SegmentWriter::SegmentWriter(io::FileWriter* file_writer, uint32_t segment_id,
           _opts(opts),
           _file_writer(file_writer),
           _mem_tracker(MemTracker::create_virtual_tracker(
-                  -1, "SegmentWriter:Segment-" + std::to_string(segment_id))),
-          _olap_data_convertor(tablet_schema) {
+                  -1, "SegmentWriter:Segment-" + std::to_string(segment_id))) {
     CHECK_NOTNULL(file_writer);
     size_t num_short_key_column = _tablet_schema->num_short_key_columns();
     for (size_t cid = 0; cid < num_short_key_column; ++cid) {
@@ -56,6 +67,9 @@ SegmentWriter::SegmentWriter(io::FileWriter* file_writer, uint32_t segment_id,
         _short_key_coders.push_back(get_key_coder(column.type()));
         _short_key_index_size.push_back(column.index_length());
     }
+    for (size_t cid = 0; cid < _tablet_schema->num_key_columns(); ++cid) {
+        _key_coders.push_back(get_key_coder(_tablet_schema->column(cid).type()));
+    }
 }
 
 SegmentWriter::~SegmentWriter() {
@@ -80,27 +94,50 @@ void SegmentWriter::init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
 }
 
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (auto& column : _tablet_schema->columns()) {
+    std::vector<uint32_t> column_ids(_tablet_schema->num_columns());
+    std::iota(column_ids.begin(), column_ids.end(), 0);
+    return init(column_ids, true);
+}
+
+Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key) {
+    DCHECK(_column_writers.empty());
+    DCHECK(has_key || _num_rows_written > 0) << "the key columns should be written first";
+    _has_key = has_key;
+    _row_count = 0;
+    _olap_data_convertor =
+            std::make_unique<vectorized::OlapBlockDataConvertor>(_tablet_schema, col_ids);
+    _column_writers.reserve(col_ids.size());
+    for (auto cid : col_ids) {
+        const auto& column = _tablet_schema->column(cid);
         ColumnWriterOptions opts;
         opts.meta = _footer.add_columns();
 
-        init_column_meta(opts.meta, &column_id, column, _tablet_schema);
+        init_column_meta(opts.meta, &_next_column_meta_id, column, _tablet_schema);
+        auto encoding = _opts.column_encodings.find(column.unique_id());
+        if (encoding != _opts.column_encodings.end()) {
+            opts.meta->set_encoding(encoding->second);
+        }
 
         // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
         // and not support zone map for array type.
         opts.need_zone_map = column.is_key() || _tablet_schema->keys_type() != KeysType::AGG_KEYS;
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
+        opts.need_inverted_index = column.has_inverted_index();
+        opts.need_ngram_bloom_filter = column.has_ngram_bf_index();
+        opts.need_statistics = config::enable_column_statistics &&
+                               ColumnStatisticsCollector::need_statistics(column.type());
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             opts.need_zone_map = false;
-            if (opts.need_bloom_filter) {
+            if (opts.need_bloom_filter || opts.need_ngram_bloom_filter) {
                 return Status::NotSupported("Do not support bloom filter for array type");
             }
             if (opts.need_bitmap_index) {
                 return Status::NotSupported("Do not support bitmap index for array type");
             }
+            if (opts.need_inverted_index) {
+                return Status::NotSupported("Do not support inverted index for array type");
+            }
         }
 
         std::unique_ptr<ColumnWriter> writer;
@@ -108,15 +145,109 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
+    if (!_has_key) {
+        return Status::OK();
+    }
+    // the rows can only be encoded when all the columns are written at once
+    if (col_ids.size() == _tablet_schema->num_columns()) {
+        RETURN_IF_ERROR(_init_row_store());
+    }
     _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    if (_opts.enable_unique_key_merge_on_write) {
+        DCHECK(_tablet_schema->keys_type() == UNIQUE_KEYS);
+        _primary_key_index_builder.reset(new PrimaryKeyIndexBuilder(_file_writer));
+        RETURN_IF_ERROR(_primary_key_index_builder->init());
+    }
     return Status::OK();
 }
 
+Status SegmentWriter::_init_row_store() {
+    if (!_opts.enable_unique_key_merge_on_write || config::row_store_min_columns <= 0 ||
+        _tablet_schema->num_columns() < (size_t)config::row_store_min_columns) {
+        return Status::OK();
+    }
+    for (const auto& column : _tablet_schema->columns()) {
+        // the values of the complex types can't be encoded
+        FieldType type = column.type();
+        if (type == OLAP_FIELD_TYPE_HLL || type == OLAP_FIELD_TYPE_OBJECT ||
+            type == OLAP_FIELD_TYPE_QUANTILE_STATE) {
+            return Status::OK();
+        }
+    }
+    auto row_store = _footer.mutable_row_store();
+    for (const auto& column : _tablet_schema->columns()) {
+        row_store->add_column_unique_ids(column.unique_id());
+    }
+    _row_store_column = std::make_unique<TabletColumn>(OLAP_FIELD_AGGREGATION_NONE,
+                                                       OLAP_FIELD_TYPE_STRING, false);
+    ColumnWriterOptions opts;
+    opts.meta = row_store->mutable_column();
+    uint32_t column_id = 0;
+    init_column_meta(opts.meta, &column_id, *_row_store_column, _tablet_schema);
+    // the encoded rows are hardly repeated
+    opts.meta->set_encoding(PLAIN_ENCODING);
+    RETURN_IF_ERROR(ColumnWriter::create(opts, _row_store_column.get(), _file_writer,
+                                         &_row_store_writer));
+    return _row_store_writer->init();
+}
+
+Status SegmentWriter::_append_row_store(const vectorized::Block* block, size_t row_pos,
+                                        size_t num_rows) {
+    std::vector<vectorized::ColumnPtr> columns;
+    std::vector<const vectorized::IColumn*> row_columns;
+    std::vector<uint32_t> unique_ids;
+    for (size_t cid = 0; cid < block->columns(); ++cid) {
+        const auto& column = block->get_by_position(cid);
+        // the rows are decoded into the columns of the data types of the tablet schema
+        auto data_type = vectorized::DataTypeFactory::instance().create_data_type(
+                _tablet_schema->column(cid));
+        if (column.type->get_name() != data_type->get_name()) {
+            LOG(WARNING) << "no row store for segment " << _segment_id << ", column " << cid
+                         << " of block is " << column.type->get_name() << " instead of "
+                         << data_type->get_name();
+            _drop_row_store();
+            return Status::OK();
+        }
+        columns.push_back(column.column->convert_to_full_column_if_const());
+        if (!RowStoreCodec::is_supported(*columns.back())) {
+            LOG(WARNING) << "no row store for segment " << _segment_id << ", column " << cid
+                         << " of type " << data_type->get_name() << " can't be encoded";
+            _drop_row_store();
+            return Status::OK();
+        }
+        row_columns.push_back(columns.back().get());
+        unique_ids.push_back(_tablet_schema->column(cid).unique_id());
+    }
+    _row_store_buf.clear();
+    std::vector<size_t> row_ends;
+    row_ends.reserve(num_rows);
+    RowStoreCodec::encode_rows(row_columns, unique_ids, row_pos, num_rows, &_row_store_buf,
+                               &row_ends);
+    std::vector<Slice> rows(num_rows);
+    for (size_t i = 0, begin = 0; i < num_rows; begin = row_ends[i++]) {
+        rows[i] = Slice(_row_store_buf.data() + begin, row_ends[i] - begin);
+    }
+    return _row_store_writer->append(nullptr, rows.data(), num_rows);
+}
+
+void SegmentWriter::_drop_row_store() {
+    _row_store_writer.reset();
+    _row_store_column.reset();
+    _footer.clear_row_store();
+}
+
 Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_pos,
                                    size_t num_rows) {
     assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
            block->columns() == _column_writers.size());
-    _olap_data_convertor.set_source_content(block, row_pos, num_rows);
+    vectorized::Block full_block;
+    if (_opts.partial_update_info != nullptr && _has_key &&
+        _column_writers.size() == _tablet_schema->num_columns()) {
+        RETURN_IF_ERROR(_fill_missing_columns(block, row_pos, num_rows, &full_block));
+        block = &full_block;
+        row_pos = 0;
+    }
+    _olap_data_convertor->set_source_content(block, row_pos, num_rows);
 
     // find all row pos for short key indexes
     std::vector<size_t> short_key_pos;
@@ -124,29 +255,28 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
     // build a short key index using 1st rows for first block and `_short_key_row_pos - _row_count`
     // for next blocks.
     // Ensure we build a short key index using 1st rows only for the first block (ISSUE-9766).
-    if (UNLIKELY(_short_key_row_pos == 0 && _row_count == 0)) {
-        short_key_pos.push_back(0);
-    }
-    while (_short_key_row_pos + _opts.num_rows_per_block < _row_count + num_rows) {
-        _short_key_row_pos += _opts.num_rows_per_block;
-        short_key_pos.push_back(_short_key_row_pos - _row_count);
+    if (_has_key) {
+        if (UNLIKELY(_short_key_row_pos == 0 && _row_count == 0)) {
+            short_key_pos.push_back(0);
+        }
+        while (_short_key_row_pos + _opts.num_rows_per_block < _row_count + num_rows) {
+            _short_key_row_pos += _opts.num_rows_per_block;
+            short_key_pos.push_back(_short_key_row_pos - _row_count);
+        }
     }
 
     // convert column data from engine format to storage layer format
-    std::vector<vectorized::IOlapColumnDataAccessor*> short_key_columns;
-    size_t num_key_columns = _tablet_schema->num_short_key_columns();
-    for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
-        auto converted_result = _olap_data_convertor.convert_column_data(cid);
-        if (converted_result.first != Status::OK()) {
-            return converted_result.first;
-        }
-        if (cid < num_key_columns) {
-            short_key_columns.push_back(converted_result.second);
-        }
-        RETURN_IF_ERROR(_column_writers[cid]->append(converted_result.second->get_nullmap(),
-                                                     converted_result.second->get_data(),
-                                                     num_rows));
+    std::vector<vectorized::IOlapColumnDataAccessor*> converted_columns;
+    RETURN_IF_ERROR(_append_columns(num_rows, &converted_columns));
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_append_row_store(block, row_pos, num_rows));
     }
+    size_t num_key_columns = _has_key ? _tablet_schema->num_short_key_columns() : 0;
+    size_t num_full_key_columns = _has_key ? _key_coders.size() : 0;
+    std::vector<vectorized::IOlapColumnDataAccessor*> short_key_columns(
+            converted_columns.begin(), converted_columns.begin() + num_key_columns);
+    std::vector<vectorized::IOlapColumnDataAccessor*> key_columns(
+            converted_columns.begin(), converted_columns.begin() + num_full_key_columns);
 
     // create short key indexes
     std::vector<const void*> key_column_fields;
@@ -159,8 +289,139 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
         key_column_fields.clear();
     }
 
+    // build primary key index
+    if (_has_key && _primary_key_index_builder != nullptr) {
+        for (size_t pos = 0; pos < num_rows; ++pos) {
+            for (const auto& column : key_columns) {
+                key_column_fields.push_back(column->get_data_at(pos));
+            }
+            std::string encoded_key = _full_encode_keys(key_column_fields);
+            RETURN_IF_ERROR(_primary_key_index_builder->add_item(encoded_key));
+            key_column_fields.clear();
+        }
+    }
+
+    // record the key bounds, rows are appended in the order of keys
+    if (_has_key) {
+        auto encode_key_at = [&](size_t pos) {
+            for (const auto& column : key_columns) {
+                key_column_fields.push_back(column->get_data_at(pos));
+            }
+            std::string encoded_key = _full_encode_keys(key_column_fields);
+            key_column_fields.clear();
+            return encoded_key;
+        };
+        if (_row_count == 0) {
+            _min_encoded_key = encode_key_at(0);
+        }
+        _max_encoded_key = encode_key_at(num_rows - 1);
+    }
+
     _row_count += num_rows;
-    _olap_data_convertor.clear_source_content();
+    _olap_data_convertor->clear_source_content();
+    return Status::OK();
+}
+
+Status SegmentWriter::_fill_missing_columns(const vectorized::Block* block, size_t row_pos,
+                                            size_t num_rows, vectorized::Block* full_block) {
+    const auto& info = *_opts.partial_update_info;
+    _olap_data_convertor->set_source_content(block, row_pos, num_rows);
+    std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
+    for (size_t cid = 0; cid < _key_coders.size(); ++cid) {
+        auto converted_result = _olap_data_convertor->convert_column_data(cid);
+        RETURN_IF_ERROR(converted_result.first);
+        key_columns.push_back(converted_result.second);
+    }
+    std::vector<std::string> encoded_keys(num_rows);
+    std::vector<const void*> key_column_fields;
+    for (size_t pos = 0; pos < num_rows; ++pos) {
+        for (const auto& column : key_columns) {
+            key_column_fields.push_back(column->get_data_at(pos));
+        }
+        encoded_keys[pos] = _full_encode_keys(key_column_fields);
+        key_column_fields.clear();
+    }
+
+    vectorized::MutableColumns latest_columns;
+    for (auto cid : info.missing_cids) {
+        latest_columns.push_back(block->get_by_position(cid).column->clone_empty());
+    }
+    std::vector<bool> found;
+    auto st = info.tablet->read_latest_rows(encoded_keys, key_columns, info.rowsets, info.version,
+                                            info.missing_cids, &latest_columns, &found);
+    _olap_data_convertor->clear_source_content();
+    RETURN_IF_ERROR(st);
+
+    // the rows of new keys keep the values of the missing columns given by the load, which
+    // are the default values of the columns
+    *full_block = block->clone_empty();
+    auto columns = full_block->mutate_columns();
+    for (size_t cid = 0, i = 0; cid < columns.size(); ++cid) {
+        const auto& src = *block->get_by_position(cid).column;
+        if (i == info.missing_cids.size() || info.missing_cids[i] != cid) {
+            columns[cid]->insert_range_from(src, row_pos, num_rows);
+            continue;
+        }
+        for (size_t pos = 0; pos < num_rows; ++pos) {
+            if (found[pos]) {
+                columns[cid]->insert_from(*latest_columns[i], pos);
+            } else {
+                columns[cid]->insert_from(src, row_pos + pos);
+            }
+        }
+        ++i;
+    }
+    full_block->set_columns(std::move(columns));
+    return Status::OK();
+}
+
+Status SegmentWriter::_append_columns(
+        size_t num_rows, std::vector<vectorized::IOlapColumnDataAccessor*>* columns) {
+    size_t num_columns = _column_writers.size();
+    columns->resize(num_columns);
+    auto append_columns = [&](size_t begin, size_t end) -> Status {
+        for (size_t cid = begin; cid < end; ++cid) {
+            auto converted_result = _olap_data_convertor->convert_column_data(cid);
+            RETURN_IF_ERROR(converted_result.first);
+            (*columns)[cid] = converted_result.second;
+            RETURN_IF_ERROR(_column_writers[cid]->append(converted_result.second->get_nullmap(),
+                                                         converted_result.second->get_data(),
+                                                         num_rows));
+        }
+        return Status::OK();
+    };
+
+    ThreadPool* thread_pool = ExecEnv::GetInstance()->segment_writer_thread_pool();
+    size_t num_tasks = std::max(config::segment_writer_parallel_tasks, 1);
+    if (num_tasks <= 1 || thread_pool == nullptr ||
+        num_columns < (size_t)std::max(config::segment_writer_parallel_min_columns, 0)) {
+        return append_columns(0, num_columns);
+    }
+
+    // The columns are converted and encoded independently, and the pages of a column writer
+    // are kept in memory until `_write_data()`, so each task appends a contiguous group of
+    // columns and the segment file is still written column by column in order.
+    num_tasks = std::min(num_tasks, num_columns);
+    size_t columns_per_task = (num_columns + num_tasks - 1) / num_tasks;
+    std::vector<Status> statuses(num_tasks);
+    auto mem_tracker = tls_ctx()->_thread_mem_tracker_mgr->mem_tracker();
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT, num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+        size_t begin = i * columns_per_task;
+        size_t end = std::min(begin + columns_per_task, num_columns);
+        auto st = token->submit_func([&, i, begin, end]() {
+            SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(mem_tracker);
+            statuses[i] = append_columns(begin, end);
+        });
+        // run the task in place if the pool is full
+        if (!st.ok()) {
+            statuses[i] = append_columns(begin, end);
+        }
+    }
+    token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
     return Status::OK();
 }
 
@@ -196,8 +457,47 @@ std::string SegmentWriter::encode_short_keys(const std::vector<const void*> key_
     return encoded_keys;
 }
 
+std::string SegmentWriter::full_encode_keys(const TabletSchema& tablet_schema,
+                                            const std::vector<const KeyCoder*>& key_coders,
+                                            const std::vector<const void*>& key_column_fields) {
+    assert(key_column_fields.size() == key_coders.size());
+
+    std::string encoded_keys;
+    for (size_t cid = 0; cid < key_coders.size(); ++cid) {
+        auto field = key_column_fields[cid];
+        if (UNLIKELY(!field)) {
+            encoded_keys.push_back(KEY_NULL_FIRST_MARKER);
+            continue;
+        }
+        encoded_keys.push_back(KEY_NORMAL_MARKER);
+        FieldType type = tablet_schema.column(cid).type();
+        bool is_string = type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR ||
+                         type == OLAP_FIELD_TYPE_STRING;
+        if (!is_string || cid + 1 == key_coders.size()) {
+            key_coders[cid]->full_encode_ascending(field, &encoded_keys);
+            continue;
+        }
+        // A string that is not the last key column is escaped ('\0' -> "\0\1") and
+        // terminated by "\0\0", so that ("ab", "c") and ("a", "bc") are encoded
+        // differently while the byte order of the keys is kept.
+        auto slice = reinterpret_cast<const Slice*>(field);
+        for (size_t i = 0; i < slice->size; ++i) {
+            encoded_keys.push_back(slice->data[i]);
+            if (UNLIKELY(slice->data[i] == '\0')) {
+                encoded_keys.push_back('\1');
+            }
+        }
+        encoded_keys.push_back('\0');
+        encoded_keys.push_back('\0');
+    }
+    return encoded_keys;
+}
+
 template <typename RowType>
 Status SegmentWriter::append_row(const RowType& row) {
+    if (_row_store_writer != nullptr) {
+        _drop_row_store();
+    }
     for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
         auto cell = row.cell(cid);
         RETURN_IF_ERROR(_column_writers[cid]->append(cell));
@@ -209,6 +509,18 @@ Status SegmentWriter::append_row(const RowType& row) {
         encode_key(&encoded_key, row, _tablet_schema->num_short_key_columns());
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
     }
+    std::vector<const void*> key_column_fields;
+    for (size_t cid = 0; cid < _key_coders.size(); ++cid) {
+        auto cell = row.cell(cid);
+        key_column_fields.push_back(cell.is_null() ? nullptr : cell.cell_ptr());
+    }
+    _max_encoded_key = _full_encode_keys(key_column_fields);
+    if (_row_count == 0) {
+        _min_encoded_key = _max_encoded_key;
+    }
+    if (_primary_key_index_builder != nullptr) {
+        RETURN_IF_ERROR(_primary_key_index_builder->add_item(_max_encoded_key));
+    }
     ++_row_count;
     return Status::OK();
 }
@@ -226,7 +538,15 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
-    size += _index_builder->size();
+    if (_row_store_writer != nullptr) {
+        size += _row_store_writer->estimate_buffer_size();
+    }
+    if (_index_builder != nullptr) {
+        size += _index_builder->size();
+    }
+    if (_primary_key_index_builder != nullptr) {
+        size += _primary_key_index_builder->size();
+    }
 
     // update the mem_tracker of segment size
     _mem_tracker->consume(size - _mem_tracker->consumption());
@@ -234,6 +554,18 @@ uint64_t SegmentWriter::estimate_segment_size() {
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    RETURN_IF_ERROR(finalize_columns(index_size));
+    return finalize_footer(segment_file_size);
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
+    if (_has_key) {
+        _num_rows_written = _row_count;
+    } else if (_row_count != _num_rows_written) {
+        return Status::InternalError(
+                fmt::format("row count of column group {} does not match the segment's {}",
+                            _row_count, _num_rows_written));
+    }
     // check disk capacity
     if (_data_dir != nullptr && _data_dir->reach_capacity_limit((int64_t)estimate_segment_size())) {
         return Status::InternalError(
@@ -242,14 +574,39 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->finish());
     }
+    if (_row_store_writer != nullptr && _row_store_writer->get_next_rowid() != _row_count) {
+        // some rows are not appended as blocks
+        _drop_row_store();
+    }
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_row_store_writer->finish());
+    }
     RETURN_IF_ERROR(_write_data());
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_row_store_writer->write_data());
+    }
     uint64_t index_offset = _file_writer->bytes_appended();
     RETURN_IF_ERROR(_write_ordinal_index());
+    if (_row_store_writer != nullptr) {
+        RETURN_IF_ERROR(_row_store_writer->write_ordinal_index());
+    }
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
-    RETURN_IF_ERROR(_write_short_key_index());
+    RETURN_IF_ERROR(_write_inverted_index());
+    if (_has_key) {
+        RETURN_IF_ERROR(_write_short_key_index());
+        RETURN_IF_ERROR(_write_primary_key_index());
+    }
     *index_size = _file_writer->bytes_appended() - index_offset;
+    // the data of this column group has been written, release the memory of column writers
+    _column_writers.clear();
+    _row_store_writer.reset();
+    _olap_data_convertor.reset();
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size) {
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_file_writer->finalize());
     *segment_file_size = _file_writer->bytes_appended();
@@ -293,6 +650,13 @@ Status SegmentWriter::_write_bloom_filter_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_inverted_index() {
+    for (auto& column_writer : _column_writers) {
+        RETURN_IF_ERROR(column_writer->write_inverted_index());
+    }
+    return Status::OK();
+}
+
 Status SegmentWriter::_write_short_key_index() {
     std::vector<Slice> body;
     PageFooterPB footer;
@@ -304,8 +668,16 @@ Status SegmentWriter::_write_short_key_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_primary_key_index() {
+    if (_primary_key_index_builder == nullptr) {
+        return Status::OK();
+    }
+    CHECK(_primary_key_index_builder->num_rows() == _row_count);
+    return _primary_key_index_builder->finalize(_footer.mutable_primary_key_index_meta());
+}
+
 Status SegmentWriter::_write_footer() {
-    _footer.set_num_rows(_row_count);
+    _footer.set_num_rows(_num_rows_written);
 
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::string footer_buf;
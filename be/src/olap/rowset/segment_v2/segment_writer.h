@@ -18,6 +18,7 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <memory> // unique_ptr
 #include <string>
 #include <vector>
@@ -25,6 +26,8 @@
 #include "common/status.h" // Status
 #include "gen_cpp/segment_v2.pb.h"
 #include "gutil/macros.h"
+#include "util/faststring.h"
+#include "vec/common/arena.h"
 #include "vec/core/block.h"
 #include "vec/olap/olap_data_convertor.h"
 
@@ -41,6 +44,7 @@ class TabletSchema;
 class TabletColumn;
 class ShortKeyIndexBuilder;
 class KeyCoder;
+struct PartialUpdateInfo;
 
 namespace io {
 class FileWriter;
@@ -49,12 +53,21 @@ class FileWriter;
 namespace segment_v2 {
 
 class ColumnWriter;
+class PrimaryKeyIndexBuilder;
 
 extern const char* k_segment_magic;
 extern const uint32_t k_segment_magic_length;
 
 struct SegmentWriterOptions {
     uint32_t num_rows_per_block = 1024;
+    // build a primary key index for unique key tablets with merge-on-write enabled
+    bool enable_unique_key_merge_on_write = false;
+    // unique id -> encoding of the column, the other columns use DEFAULT_ENCODING,
+    // for the tools comparing the encodings of a column
+    std::map<int32_t, EncodingTypePB> column_encodings;
+    // set for a partial update, the missing columns of the blocks appended are filled with
+    // the latest rows of the same keys
+    std::shared_ptr<PartialUpdateInfo> partial_update_info;
 };
 
 class SegmentWriter {
@@ -66,6 +79,12 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Init the writer to write only the columns in `col_ids`, which is used by vertical
+    // compaction to write a segment column group by column group. The group with key
+    // columns (`has_key` is true) must be written first, and it decides the number of rows
+    // of the segment.
+    Status init(const std::vector<uint32_t>& col_ids, bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
@@ -77,11 +96,33 @@ public:
 
     uint32_t num_rows_written() const { return _row_count; }
 
+    uint32_t get_segment_id() const { return _segment_id; }
+
+    // The min and max keys of the rows written, encoded in memcomparable format.
+    // Only valid after the column group with key columns has been written.
+    const std::string& min_encoded_key() const { return _min_encoded_key; }
+    const std::string& max_encoded_key() const { return _max_encoded_key; }
+
+    // The metas of the columns are complete after the columns are finalized.
+    const SegmentFooterPB& footer() const { return _footer; }
+
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // Write the data and indexes of the current column group and release its column writers.
+    Status finalize_columns(uint64_t* index_size);
+    // Write the footer after all column groups are finalized.
+    Status finalize_footer(uint64_t* segment_file_size);
+
     static void init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
                                  const TabletColumn& column, const TabletSchema* tablet_schema);
 
+    // Encodes all key columns of a row into the memcomparable key of the primary key index,
+    // which keeps the order of rows and is unique for different keys. `key_column_fields`
+    // are the cells of the key columns, nullptr for null, and `key_coders` are their coders.
+    static std::string full_encode_keys(const TabletSchema& tablet_schema,
+                                        const std::vector<const KeyCoder*>& key_coders,
+                                        const std::vector<const void*>& key_column_fields);
+
 private:
     DISALLOW_COPY_AND_ASSIGN(SegmentWriter);
     Status _write_data();
@@ -89,12 +130,31 @@ private:
     Status _write_zone_map();
     Status _write_bitmap_index();
     Status _write_bloom_filter_index();
+    Status _write_inverted_index();
     Status _write_short_key_index();
+    Status _write_primary_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
+    // Convert and append the columns of the current block source to the column writers,
+    // the converted columns are returned in `columns`.
+    Status _append_columns(size_t num_rows,
+                           std::vector<vectorized::IOlapColumnDataAccessor*>* columns);
+    // create the writer of the row store if the segment should have one
+    Status _init_row_store();
+    // encode the rows of the block into the row store, dropping it if any column can't be encoded
+    Status _append_row_store(const vectorized::Block* block, size_t row_pos, size_t num_rows);
+    // no row store is written for this segment
+    void _drop_row_store();
+    // Copies the rows of `block` into `full_block`, with the missing columns of a partial
+    // update replaced by the values of the latest rows of the same keys.
+    Status _fill_missing_columns(const vectorized::Block* block, size_t row_pos, size_t num_rows,
+                                 vectorized::Block* full_block);
 
     std::string encode_short_keys(const std::vector<const void*> key_column_fields,
                                   bool null_first = true);
+    std::string _full_encode_keys(const std::vector<const void*>& key_column_fields) {
+        return full_encode_keys(*_tablet_schema, _key_coders, key_column_fields);
+    }
 
 private:
     uint32_t _segment_id;
@@ -110,12 +170,31 @@ private:
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
     std::shared_ptr<MemTracker> _mem_tracker;
+    // number of rows written into the current column group
     uint32_t _row_count = 0;
-
-    vectorized::OlapBlockDataConvertor _olap_data_convertor;
+    // whether the current column group contains the key columns
+    bool _has_key = true;
+    // number of rows of the segment, decided by the column group with key columns
+    uint32_t _num_rows_written = 0;
+    // column id of the next column meta in footer
+    uint32_t _next_column_meta_id = 0;
+
+    std::unique_ptr<vectorized::OlapBlockDataConvertor> _olap_data_convertor;
+    // writer of the hidden column storing the encoded rows, see RowStorePB
+    std::unique_ptr<TabletColumn> _row_store_column;
+    std::unique_ptr<ColumnWriter> _row_store_writer;
+    // the rows of the last block encoded by RowStoreCodec
+    faststring _row_store_buf;
     std::vector<const KeyCoder*> _short_key_coders;
     std::vector<uint16_t> _short_key_index_size;
     size_t _short_key_row_pos = 0;
+
+    // only valid when enable_unique_key_merge_on_write is true
+    std::unique_ptr<PrimaryKeyIndexBuilder> _primary_key_index_builder;
+    // used to encode the full keys for primary key index and key bounds
+    std::vector<const KeyCoder*> _key_coders;
+    std::string _min_encoded_key;
+    std::string _max_encoded_key;
 };
 
 } // namespace segment_v2
@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/vertical_beta_rowset_writer.h"
+
+#include "olap/rowset/segment_v2/segment_writer.h"
+
+namespace doris {
+
+VerticalBetaRowsetWriter::~VerticalBetaRowsetWriter() {
+    // ensure all files are closed before the base writer removes the files of failed rowset
+    _segment_writers.clear();
+}
+
+Status VerticalBetaRowsetWriter::add_columns(const vectorized::Block* block,
+                                             const std::vector<uint32_t>& col_ids, bool is_key,
+                                             uint32_t max_rows_per_segment) {
+    size_t num_rows = block->rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    if (is_key) {
+        if (UNLIKELY(_segment_writers.empty())) {
+            RETURN_NOT_OK(_create_segment_writer(col_ids, is_key));
+        }
+        // only the key group decides when to split a new segment
+        size_t row_avg_size_in_bytes = std::max((size_t)1, block->bytes() / num_rows);
+        size_t row_offset = 0;
+        do {
+            auto& writer = _segment_writers.back();
+            int64_t max_row_add = std::min(writer->max_row_to_add(row_avg_size_in_bytes),
+                                           (int64_t)max_rows_per_segment - writer->num_rows_written());
+            if (UNLIKELY(max_row_add < 1)) {
+                RETURN_NOT_OK(_flush_columns(&writer));
+                RETURN_NOT_OK(_create_segment_writer(col_ids, is_key));
+                continue;
+            }
+            size_t input_row_num = std::min(num_rows - row_offset, size_t(max_row_add));
+            RETURN_NOT_OK(_segment_writers.back()->append_block(block, row_offset, input_row_num));
+            row_offset += input_row_num;
+        } while (row_offset < num_rows);
+        _num_rows_written += num_rows;
+        return Status::OK();
+    }
+
+    // value columns are written into the segments created by the key group
+    size_t row_offset = 0;
+    while (row_offset < num_rows) {
+        if (UNLIKELY(_cur_writer_idx >= _segment_writers.size())) {
+            return Status::InternalError("value columns have more rows than key columns");
+        }
+        auto& writer = _segment_writers[_cur_writer_idx];
+        if (!_cur_writer_inited) {
+            RETURN_NOT_OK(writer->init(col_ids, is_key));
+            _cur_writer_inited = true;
+        }
+        size_t remaining = _segment_num_rows[_cur_writer_idx] - writer->num_rows_written();
+        if (remaining == 0) {
+            RETURN_NOT_OK(_flush_columns(&writer));
+            ++_cur_writer_idx;
+            _cur_writer_inited = false;
+            continue;
+        }
+        size_t input_row_num = std::min(num_rows - row_offset, remaining);
+        RETURN_NOT_OK(writer->append_block(block, row_offset, input_row_num));
+        row_offset += input_row_num;
+    }
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::flush_columns() {
+    if (_segment_writers.empty()) {
+        return Status::OK();
+    }
+    if (_segment_num_rows.size() < _segment_writers.size()) {
+        // the last segment of key group
+        RETURN_NOT_OK(_flush_columns(&_segment_writers.back()));
+    } else {
+        if (!_cur_writer_inited || _cur_writer_idx + 1 != _segment_writers.size()) {
+            return Status::InternalError("value columns have less rows than key columns");
+        }
+        RETURN_NOT_OK(_flush_columns(&_segment_writers[_cur_writer_idx]));
+    }
+    _cur_writer_idx = 0;
+    _cur_writer_inited = false;
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::final_flush() {
+    for (auto& segment_writer : _segment_writers) {
+        uint64_t segment_size = 0;
+        auto st = segment_writer->finalize_footer(&segment_size);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to finalize segment: " << st;
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        _total_data_size += segment_size;
+        _add_segment_column_statistics(*segment_writer);
+    }
+    _segment_writers.clear();
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::_create_segment_writer(const std::vector<uint32_t>& column_ids,
+                                                        bool is_key) {
+    std::unique_ptr<segment_v2::SegmentWriter> writer;
+    RETURN_NOT_OK(BetaRowsetWriter::_create_segment_writer(&writer, &column_ids, is_key));
+    _segment_writers.push_back(std::move(writer));
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::_flush_columns(
+        std::unique_ptr<segment_v2::SegmentWriter>* segment_writer) {
+    uint64_t index_size = 0;
+    auto st = (*segment_writer)->finalize_columns(&index_size);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to finalize columns of segment: " << st;
+        return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+    }
+    if (_segment_num_rows.size() < _segment_writers.size()) {
+        _segment_num_rows.push_back((*segment_writer)->num_rows_written());
+        _add_segment_key_bounds(**segment_writer);
+    }
+    _total_index_size += index_size;
+    return Status::OK();
+}
+
+} // namespace doris
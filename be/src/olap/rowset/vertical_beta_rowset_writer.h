@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "olap/rowset/beta_rowset_writer.h"
+
+namespace doris {
+
+// VerticalBetaRowsetWriter writes a rowset column group by column group, it is used
+// by vertical compaction. The column group with key columns must be added first, it
+// decides the number of segments and the number of rows of every segment. Then the
+// value column groups are added in the same row order, and the rows of every group
+// are written into the segments according to the row numbers of the key group.
+//
+// Usage:
+//      for (group : column_groups) {
+//          while (has more rows of group) {
+//              writer.add_columns(block, group, is_key, max_rows_per_segment);
+//          }
+//          writer.flush_columns();
+//      }
+//      writer.final_flush();
+//      writer.build();
+class VerticalBetaRowsetWriter : public BetaRowsetWriter {
+public:
+    VerticalBetaRowsetWriter() = default;
+    ~VerticalBetaRowsetWriter() override;
+
+    Status add_columns(const vectorized::Block* block, const std::vector<uint32_t>& col_ids,
+                       bool is_key, uint32_t max_rows_per_segment);
+
+    // flush the data of the current column group
+    Status flush_columns();
+
+    // flush the footers of all segments
+    Status final_flush();
+
+private:
+    // only key group will create segment writer
+    Status _create_segment_writer(const std::vector<uint32_t>& column_ids, bool is_key);
+
+    Status _flush_columns(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer);
+
+private:
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _segment_writers;
+    // number of rows of every segment, decided by the key group
+    std::vector<uint32_t> _segment_num_rows;
+    // the segment writer which is written by the current column group
+    size_t _cur_writer_idx = 0;
+    // whether the current segment writer is inited for the current column group
+    bool _cur_writer_inited = false;
+};
+
+} // namespace doris
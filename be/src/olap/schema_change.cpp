@@ -17,28 +17,42 @@
 
 #include "olap/schema_change.h"
 
+#include <atomic>
 #include <vector>
 
+#include "common/object_pool.h"
 #include "common/status.h"
 #include "gutil/integral_types.h"
+#include "io/fs/io_limiter.h"
 #include "olap/merger.h"
 #include "olap/olap_common.h"
 #include "olap/row.h"
 #include "olap/row_block.h"
 #include "olap/row_cursor.h"
 #include "olap/rowset/rowset_id_generator.h"
+#include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
+#include "olap/types.h"
 #include "olap/wrapper_field.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/columns/column.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
 #include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
+#include "vec/functions/simple_function_factory.h"
 #include "vec/olap/block_reader.h"
 
 using std::nothrow;
@@ -92,13 +106,13 @@ private:
 };
 
 RowBlockChanger::RowBlockChanger(const TabletSchema& tablet_schema, DescriptorTbl desc_tbl)
-        : _desc_tbl(desc_tbl) {
+        : _tablet_schema(tablet_schema), _desc_tbl(desc_tbl) {
     _schema_mapping.resize(tablet_schema.num_columns());
 }
 
 RowBlockChanger::RowBlockChanger(const TabletSchema& tablet_schema,
                                  const DeleteHandler* delete_handler, DescriptorTbl desc_tbl)
-        : _desc_tbl(desc_tbl) {
+        : _tablet_schema(tablet_schema), _desc_tbl(desc_tbl) {
     _schema_mapping.resize(tablet_schema.num_columns());
     _delete_handler = delete_handler;
 }
@@ -665,6 +679,135 @@ Status RowBlockChanger::change_row_block(const RowBlock* ref_block, int32_t data
 #undef TYPE_REINTERPRET_CAST
 #undef ASSIGN_DEFAULT_VALUE
 
+Status RowBlockChanger::change_block(vectorized::Block* ref_block,
+                                     vectorized::Block* new_block) const {
+    if (new_block->columns() != _schema_mapping.size()) {
+        LOG(WARNING) << "new block does not match with schema mapping rules. "
+                     << "block_schema_size=" << new_block->columns()
+                     << ", mapping_schema_size=" << _schema_mapping.size();
+        return Status::OLAPInternalError(OLAP_ERR_NOT_INITED);
+    }
+
+    const size_t row_num = ref_block->rows();
+    // the objects to evaluate the materialized view exprs, created at the first use
+    ObjectPool pool;
+    RuntimeState* state = nullptr;
+    std::unique_ptr<RowDescriptor> row_desc;
+
+    for (size_t i = 0; i < new_block->columns(); ++i) {
+        const TabletColumn& new_column = _tablet_schema.column(i);
+        const auto& new_type = new_block->get_by_position(i).type;
+        int32_t ref_idx = _schema_mapping[i].ref_column;
+        vectorized::ColumnPtr column;
+
+        if (ref_idx < 0) {
+            // new column, fill the default value the same as reading a segment without it
+            segment_v2::DefaultValueColumnIterator default_value_iter(
+                    new_column.has_default_value(), new_column.default_value(),
+                    new_column.is_nullable(), get_type_info(&new_column), new_column.length());
+            segment_v2::ColumnIteratorOptions iter_opts;
+            RETURN_IF_ERROR(default_value_iter.init(iter_opts));
+            auto mutable_column = new_type->create_column();
+            size_t num_rows = row_num;
+            RETURN_IF_ERROR(default_value_iter.next_batch(&num_rows, mutable_column));
+            column = std::move(mutable_column);
+        } else if (!_schema_mapping[i].materialized_function.empty()) {
+            // to_bitmap, hll_hash or count_field of the materialized view
+            if (_schema_mapping[i].expr == nullptr || _desc_tbl.get_row_tuples().empty()) {
+                LOG(WARNING) << "no expr of materialized function "
+                             << _schema_mapping[i].materialized_function
+                             << " for column=" << new_column.name();
+                return Status::OLAPInternalError(OLAP_ERR_SCHEMA_CHANGE_INFO_INVALID);
+            }
+            if (state == nullptr) {
+                state = pool.add(new RuntimeState());
+                state->set_desc_tbl(&_desc_tbl);
+                row_desc = std::make_unique<RowDescriptor>(
+                        _desc_tbl.get_tuple_descriptor(_desc_tbl.get_row_tuples()[0]), false);
+            }
+            vectorized::VExprContext* ctx = nullptr;
+            RETURN_IF_ERROR(
+                    vectorized::VExpr::create_expr_tree(&pool, *_schema_mapping[i].expr, &ctx));
+            Defer defer {[&]() { ctx->close(state); }};
+            RETURN_IF_ERROR(ctx->prepare(state, *row_desc));
+            RETURN_IF_ERROR(ctx->open(state));
+
+            int result_column_id = -1;
+            RETURN_IF_ERROR(ctx->execute(ref_block, &result_column_id));
+            column = ref_block->get_by_position(result_column_id)
+                             .column->convert_to_full_column_if_const();
+        } else {
+            const auto& ref_column = ref_block->get_by_position(ref_idx);
+            if (vectorized::remove_nullable(ref_column.type)
+                        ->equals(*vectorized::remove_nullable(new_type))) {
+                column = ref_column.column;
+            } else {
+                RETURN_IF_ERROR(_cast_column(ref_column, new_type, &column));
+            }
+        }
+
+        if (column->is_nullable() != new_type->is_nullable()) {
+            if (new_type->is_nullable()) {
+                column = vectorized::make_nullable(column);
+            } else {
+                const auto& nullable_column =
+                        assert_cast<const vectorized::ColumnNullable&>(*column);
+                if (nullable_column.has_null()) {
+                    return Status::DataQualityError(fmt::format(
+                            "null value can not be written to not nullable column {}",
+                            new_column.name()));
+                }
+                column = nullable_column.get_nested_column_ptr();
+            }
+        }
+        new_block->get_by_position(i).column = std::move(column);
+    }
+    return Status::OK();
+}
+
+Status RowBlockChanger::_cast_column(const vectorized::ColumnWithTypeAndName& ref_column,
+                                     const vectorized::DataTypePtr& new_type,
+                                     vectorized::ColumnPtr* new_column) const {
+    // cast to the nullable type, so the values failed to convert become null
+    // rather than making the cast fail
+    auto cast_type = vectorized::make_nullable(new_type);
+    const auto& cast_type_name = vectorized::DataTypeFactory::instance().get(cast_type);
+    auto cast_param_type = std::make_shared<vectorized::DataTypeString>();
+    const size_t row_num = ref_column.column->size();
+
+    vectorized::Block block;
+    block.insert(ref_column);
+    block.insert({cast_param_type->create_column_const(row_num, cast_type_name), cast_param_type,
+                  cast_type_name});
+    auto function = vectorized::SimpleFunctionFactory::instance().get_function(
+            "CAST", block.get_columns_with_type_and_name(), cast_type);
+    if (function == nullptr) {
+        return Status::NotSupported(fmt::format("can not cast {} to {}",
+                                                ref_column.type->get_name(),
+                                                new_type->get_name()));
+    }
+    block.insert({nullptr, cast_type, ""});
+    RETURN_IF_ERROR(function->execute(nullptr, block, {0, 1}, 2, row_num, false));
+
+    auto result = block.get_by_position(2).column->convert_to_full_column_if_const();
+    const auto& result_null_map =
+            assert_cast<const vectorized::ColumnNullable&>(*result).get_null_map_data();
+    const vectorized::NullMap* ref_null_map = nullptr;
+    if (ref_column.column->is_nullable()) {
+        ref_null_map = &assert_cast<const vectorized::ColumnNullable&>(*ref_column.column)
+                                .get_null_map_data();
+    }
+    for (size_t i = 0; i < row_num; ++i) {
+        if (result_null_map[i] && (ref_null_map == nullptr || !(*ref_null_map)[i])) {
+            return Status::DataQualityError(fmt::format(
+                    "failed to cast value of {} to {}, row: {}", ref_column.type->get_name(),
+                    new_type->get_name(), ref_column.type->to_string(*ref_column.column, i)));
+        }
+    }
+    *new_column = std::move(result);
+    return Status::OK();
+}
+
 RowBlockSorter::RowBlockSorter(RowBlockAllocator* row_block_allocator)
         : _row_block_allocator(row_block_allocator), _swap_row_block(nullptr) {}
 
@@ -1281,6 +1424,176 @@ bool SchemaChangeWithSorting::_external_sorting(vector<RowsetSharedPtr>& src_row
     return true;
 }
 
+Status VSchemaChangeDirectly::_inner_process(RowsetReaderSharedPtr rowset_reader,
+                                             RowsetWriter* rowset_writer,
+                                             TabletSharedPtr new_tablet,
+                                             TabletSharedPtr base_tablet) {
+    auto ref_block = base_tablet->tablet_schema().create_block();
+    const int origin_columns_size = ref_block.columns();
+    while (true) {
+        // the columns inserted by the exprs of the last block are erased
+        ref_block.clear_column_data(origin_columns_size);
+        Status res = rowset_reader->next_block(&ref_block);
+        if (!res) {
+            if (res.precise_code() == OLAP_ERR_DATA_EOF) {
+                break;
+            }
+            LOG(WARNING) << "failed to read block. res=" << res;
+            return res;
+        }
+        if (ref_block.rows() == 0) {
+            continue;
+        }
+
+        auto new_block = new_tablet->tablet_schema().create_block();
+        RETURN_IF_ERROR(_row_block_changer.change_block(&ref_block, &new_block));
+        RETURN_IF_ERROR(rowset_writer->add_block(&new_block));
+    }
+
+    if (!rowset_writer->flush()) {
+        return Status::OLAPInternalError(OLAP_ERR_ALTER_STATUS_ERR);
+    }
+    return Status::OK();
+}
+
+Status VSchemaChangeWithSorting::_inner_process(RowsetReaderSharedPtr rowset_reader,
+                                                RowsetWriter* rowset_writer,
+                                                TabletSharedPtr new_tablet,
+                                                TabletSharedPtr base_tablet) {
+    RowsetSharedPtr rowset = rowset_reader->rowset();
+    // the rowsets generated by internal sorting
+    std::vector<RowsetSharedPtr> src_rowsets;
+    Defer defer {[&]() {
+        // remove the intermediate rowsets generated by internal sorting
+        for (auto& row_set : src_rowsets) {
+            StorageEngine::instance()->add_unused_rowset(row_set);
+        }
+    }};
+
+    _temp_delta_versions.first = _temp_delta_versions.second;
+
+    SegmentsOverlapPB segments_overlap = rowset->rowset_meta()->segments_overlap();
+    int64_t oldest_write_timestamp = rowset->oldest_write_timestamp();
+    int64_t newest_write_timestamp = rowset->newest_write_timestamp();
+
+    auto internal_sorting = [&](vectorized::MutableBlock* mutable_block) -> Status {
+        RowsetSharedPtr sorted_rowset;
+        RETURN_IF_ERROR(_internal_sorting(
+                mutable_block, Version(_temp_delta_versions.second, _temp_delta_versions.second),
+                oldest_write_timestamp, newest_write_timestamp, new_tablet, segments_overlap,
+                &sorted_rowset));
+        src_rowsets.push_back(std::move(sorted_rowset));
+        // increase temp version
+        ++_temp_delta_versions.second;
+        return Status::OK();
+    };
+
+    auto ref_block = base_tablet->tablet_schema().create_block();
+    const int origin_columns_size = ref_block.columns();
+    auto new_block = new_tablet->tablet_schema().create_block();
+    auto mutable_block = vectorized::MutableBlock::build_mutable_block(&new_block);
+    while (true) {
+        ref_block.clear_column_data(origin_columns_size);
+        Status res = rowset_reader->next_block(&ref_block);
+        if (!res) {
+            if (res.precise_code() == OLAP_ERR_DATA_EOF) {
+                break;
+            }
+            LOG(WARNING) << "failed to read block. res=" << res;
+            return res;
+        }
+        if (ref_block.rows() == 0) {
+            continue;
+        }
+
+        {
+            auto changed_block = new_tablet->tablet_schema().create_block();
+            RETURN_IF_ERROR(_row_block_changer.change_block(&ref_block, &changed_block));
+            // copy the rows, the columns of changed_block may share the memory with ref_block
+            mutable_block.merge(changed_block);
+        }
+
+        if (mutable_block.allocated_bytes() >= _memory_limitation) {
+            // enter here while memory limitation is reached.
+            RETURN_IF_ERROR(internal_sorting(&mutable_block));
+        }
+    }
+
+    if (mutable_block.rows() > 0) {
+        RETURN_IF_ERROR(internal_sorting(&mutable_block));
+    }
+
+    if (src_rowsets.empty()) {
+        Status res = rowset_writer->flush();
+        if (!res) {
+            LOG(WARNING) << "create empty version for schema change failed."
+                         << " version=" << rowset_writer->version().first << "-"
+                         << rowset_writer->version().second;
+            return Status::OLAPInternalError(OLAP_ERR_ALTER_STATUS_ERR);
+        }
+        return Status::OK();
+    }
+    return _external_sorting(src_rowsets, rowset_writer, new_tablet);
+}
+
+Status VSchemaChangeWithSorting::_internal_sorting(
+        vectorized::MutableBlock* mutable_block, const Version& version,
+        int64_t oldest_write_timestamp, int64_t newest_write_timestamp, TabletSharedPtr new_tablet,
+        SegmentsOverlapPB segments_overlap, RowsetSharedPtr* rowset) {
+    auto block = mutable_block->to_block();
+    // sort by the key columns, null is the smallest as in the storage
+    vectorized::SortDescription sort_description;
+    for (size_t i = 0; i < new_tablet->tablet_schema().num_key_columns(); ++i) {
+        sort_description.emplace_back(i, 1, -1);
+    }
+    vectorized::sort_block(block, sort_description);
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    RETURN_IF_ERROR(new_tablet->create_rowset_writer(version, VISIBLE, segments_overlap,
+                                                     oldest_write_timestamp,
+                                                     newest_write_timestamp, &rowset_writer));
+    Defer defer {[&]() {
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
+                                                   rowset_writer->rowset_id().to_string());
+    }};
+    RETURN_IF_ERROR(rowset_writer->add_block(&block));
+    RETURN_IF_ERROR(rowset_writer->flush());
+    *rowset = rowset_writer->build();
+    if (*rowset == nullptr) {
+        LOG(WARNING) << "failed to build the sorted rowset. tablet=" << new_tablet->full_name();
+        return Status::OLAPInternalError(OLAP_ERR_ALTER_STATUS_ERR);
+    }
+
+    // reuse the memory of the columns for the next rows
+    block.clear_column_data();
+    *mutable_block = vectorized::MutableBlock::build_mutable_block(&block);
+    return Status::OK();
+}
+
+Status VSchemaChangeWithSorting::_external_sorting(std::vector<RowsetSharedPtr>& src_rowsets,
+                                                   RowsetWriter* rowset_writer,
+                                                   TabletSharedPtr new_tablet) {
+    std::vector<RowsetReaderSharedPtr> rs_readers;
+    for (auto& rowset : src_rowsets) {
+        RowsetReaderSharedPtr rs_reader;
+        RETURN_IF_ERROR(rowset->create_reader(&rs_reader));
+        rs_readers.push_back(rs_reader);
+    }
+
+    Merger::Statistics stats;
+    Status res = Merger::vmerge_rowsets(new_tablet, READER_ALTER_TABLE, rs_readers,
+                                        rowset_writer, &stats);
+    if (!res) {
+        LOG(WARNING) << "failed to merge rowsets. tablet=" << new_tablet->full_name()
+                     << ", version=" << rowset_writer->version().first << "-"
+                     << rowset_writer->version().second;
+        return res;
+    }
+    _add_merged_rows(stats.merged_rows);
+    _add_filtered_rows(stats.filtered_rows);
+    return Status::OK();
+}
+
 Status SchemaChangeHandler::process_alter_tablet_v2(const TAlterTabletReqV2& request) {
     LOG(INFO) << "begin to do request alter tablet: base_tablet_id=" << request.base_tablet_id
               << ", new_tablet_id=" << request.new_tablet_id
@@ -1315,6 +1628,7 @@ std::unordered_set<int64_t> SchemaChangeHandler::_tablet_ids_in_converting;
 // The admin should upgrade all BE and then upgrade FE.
 // Should delete the old code after upgrade finished.
 Status SchemaChangeHandler::_do_process_alter_tablet_v2(const TAlterTabletReqV2& request) {
+    io::IOLimiter::Scope io_limiter_scope;
     Status res = Status::OK();
     TabletSharedPtr base_tablet =
             StorageEngine::instance()->tablet_manager()->get_tablet(request.base_tablet_id);
@@ -1746,43 +2060,82 @@ Status SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangeParams
         return process_alter_exit();
     }
 
-    // b. Generate historical data converter
-    auto sc_procedure = get_sc_procedure(rb_changer, sc_sorting, sc_directly);
-
-    // c.Convert historical data
-    for (auto& rs_reader : sc_params.ref_rowset_readers) {
+    // b. Generate historical data converter and c. convert historical data.
+    // Every rowset is converted by its own procedure, on alter_tablet_rowset_parallelism
+    // threads, and the converted rowsets are added to the new tablet in the order of versions.
+    TabletSharedPtr new_tablet = sc_params.new_tablet;
+    const auto& rs_readers = sc_params.ref_rowset_readers;
+    std::vector<std::unique_ptr<RowsetWriter>> rowset_writers(rs_readers.size());
+    std::vector<Status> convert_status(rs_readers.size());
+    std::atomic<bool> convert_failed {false};
+    auto convert_rowset = [&](size_t idx) {
+        auto& rs_reader = rs_readers[idx];
+        if (convert_failed) {
+            convert_status[idx] = Status::Cancelled("failed to convert other rowsets");
+            return;
+        }
         VLOG_TRACE << "begin to convert a history rowset. version=" << rs_reader->version().first
                    << "-" << rs_reader->version().second;
 
-        // set status for monitor
-        // As long as there is a new_table as running, ref table is set as running
-        // NOTE If the first sub_table fails first, it will continue to go as normal here
-        TabletSharedPtr new_tablet = sc_params.new_tablet;
         // When tablet create new rowset writer, it may change rowset type, in this case
         // linked schema change will not be used.
-        std::unique_ptr<RowsetWriter> rowset_writer;
         Status status = new_tablet->create_rowset_writer(
                 rs_reader->version(), VISIBLE,
                 rs_reader->rowset()->rowset_meta()->segments_overlap(),
                 rs_reader->oldest_write_timestamp(), rs_reader->newest_write_timestamp(),
-                &rowset_writer);
+                &rowset_writers[idx]);
         if (!status.ok()) {
-            res = Status::OLAPInternalError(OLAP_ERR_ROWSET_BUILDER_INIT);
-            return process_alter_exit();
+            convert_status[idx] = Status::OLAPInternalError(OLAP_ERR_ROWSET_BUILDER_INIT);
+            convert_failed = true;
+            return;
         }
 
-        if (res = sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet,
-                                        sc_params.base_tablet);
-            !res) {
+        auto sc_procedure = get_sc_procedure(rb_changer, sc_sorting, sc_directly);
+        convert_status[idx] = sc_procedure->process(rs_reader, rowset_writers[idx].get(),
+                                                    new_tablet, sc_params.base_tablet);
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
+                                                   rowset_writers[idx]->rowset_id().to_string());
+        if (!convert_status[idx]) {
             LOG(WARNING) << "failed to process the version."
                          << " version=" << rs_reader->version().first << "-"
-                         << rs_reader->version().second;
-            new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
-                                                       rowset_writer->rowset_id().to_string());
+                         << rs_reader->version().second << ", res=" << convert_status[idx];
+            convert_failed = true;
+        }
+    };
+
+    size_t parallelism = std::min<size_t>(std::max(config::alter_tablet_rowset_parallelism, 1),
+                                          rs_readers.size());
+    if (parallelism <= 1) {
+        for (size_t i = 0; i < rs_readers.size(); ++i) {
+            convert_rowset(i);
+        }
+    } else {
+        std::unique_ptr<ThreadPool> convert_pool;
+        res = ThreadPoolBuilder("SchemaChangeConvertRowsetThreadPool")
+                      .set_min_threads(parallelism)
+                      .set_max_threads(parallelism)
+                      .build(&convert_pool);
+        if (!res) {
+            LOG(WARNING) << "failed to create the thread pool to convert rowsets. res=" << res;
+            return process_alter_exit();
+        }
+        for (size_t i = 0; i < rs_readers.size(); ++i) {
+            Status st = convert_pool->submit_func([&convert_rowset, i]() { convert_rowset(i); });
+            if (!st) {
+                convert_status[i] = st;
+                convert_failed = true;
+            }
+        }
+        convert_pool->wait();
+    }
+
+    for (size_t i = 0; i < rs_readers.size(); ++i) {
+        auto& rs_reader = rs_readers[i];
+        auto& rowset_writer = rowset_writers[i];
+        if (!convert_status[i]) {
+            res = convert_status[i];
             return process_alter_exit();
         }
-        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
-                                                   rowset_writer->rowset_id().to_string());
         // Add the new version of the data to the header
         // In order to prevent the occurrence of deadlock, we must first lock the old table, and then lock the new table
         std::lock_guard<std::mutex> lock(sc_params.new_tablet->get_push_lock());
@@ -1946,7 +2299,9 @@ Status SchemaChangeHandler::_parse_request(
             if (column_new.type() != column_old.type() ||
                 column_new.length() != column_old.length() ||
                 column_new.is_bf_column() != column_old.is_bf_column() ||
-                column_new.has_bitmap_index() != column_old.has_bitmap_index()) {
+                column_new.has_bitmap_index() != column_old.has_bitmap_index() ||
+                column_new.has_inverted_index() != column_old.has_inverted_index() ||
+                column_new.has_ngram_bf_index() != column_old.has_ngram_bf_index()) {
                 *sc_directly = true;
                 return Status::OK();
             }
@@ -1954,8 +2309,25 @@ Status SchemaChangeHandler::_parse_request(
     }
 
     if (base_tablet->delete_predicates().size() != 0) {
-        // there exists delete condition in header, can't do linked schema change
-        *sc_directly = true;
+        // The delete conditions are kept in the linked rowsets and applied on the new schema,
+        // so the columns they are on must be kept unchanged. Adding or dropping other value
+        // columns does not need to rewrite the data.
+        std::set<std::string> condition_columns;
+        if (!DeleteHandler::get_condition_columns(base_tablet->delete_predicates(),
+                                                  &condition_columns)) {
+            *sc_directly = true;
+            return Status::OK();
+        }
+        for (const auto& column_name : condition_columns) {
+            int32_t new_column_index = new_tablet->field_index(column_name);
+            if (new_column_index < 0 || base_tablet->field_index(column_name) < 0 ||
+                rb_changer->get_mutable_column_mapping(new_column_index)->ref_column !=
+                        base_tablet->field_index(column_name)) {
+                // there exists delete condition on the changed column, can't do linked schema change
+                *sc_directly = true;
+                return Status::OK();
+            }
+        }
     }
 
     if (base_tablet->tablet_meta()->preferred_rowset_type() !=
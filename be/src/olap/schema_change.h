@@ -52,7 +52,20 @@ public:
     Status change_row_block(const RowBlock* ref_block, int32_t data_version,
                             RowBlock* mutable_block, uint64_t* filtered_rows) const;
 
+    // Fill the columns of new_block from the columns of ref_block, which is read in the base
+    // schema. The columns of ref_block may be moved to new_block, so ref_block can only be
+    // cleared after.
+    // The rows to be deleted are filtered by the rowset reader already.
+    Status change_block(vectorized::Block* ref_block, vectorized::Block* new_block) const;
+
 private:
+    Status _cast_column(const vectorized::ColumnWithTypeAndName& ref_column,
+                        const vectorized::DataTypePtr& new_type,
+                        vectorized::ColumnPtr* new_column) const;
+
+    // the schema of new tablet
+    const TabletSchema& _tablet_schema;
+
     // @brief column-mapping specification of new schema
     SchemaMapping _schema_mapping;
 
@@ -207,6 +220,52 @@ private:
     DISALLOW_COPY_AND_ASSIGN(SchemaChangeWithSorting);
 };
 
+// @brief vectorized schema change without sorting.
+class VSchemaChangeDirectly : public SchemaChange {
+public:
+    explicit VSchemaChangeDirectly(const RowBlockChanger& row_block_changer)
+            : _row_block_changer(row_block_changer) {}
+    ~VSchemaChangeDirectly() override = default;
+
+private:
+    Status _inner_process(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer,
+                          TabletSharedPtr new_tablet, TabletSharedPtr base_tablet) override;
+
+    const RowBlockChanger& _row_block_changer;
+
+    DISALLOW_COPY_AND_ASSIGN(VSchemaChangeDirectly);
+};
+
+// @brief vectorized schema change with sorting.
+// The changed blocks are sorted and written to temporary rowsets every time they exceed
+// the memory limitation, and these rowsets are merged into the new rowset at last.
+class VSchemaChangeWithSorting : public SchemaChange {
+public:
+    VSchemaChangeWithSorting(const RowBlockChanger& row_block_changer, size_t memory_limitation)
+            : _row_block_changer(row_block_changer),
+              _memory_limitation(memory_limitation),
+              _temp_delta_versions(Version::mock()) {}
+    ~VSchemaChangeWithSorting() override = default;
+
+private:
+    Status _inner_process(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer,
+                          TabletSharedPtr new_tablet, TabletSharedPtr base_tablet) override;
+
+    Status _internal_sorting(vectorized::MutableBlock* mutable_block, const Version& version,
+                             int64_t oldest_write_timestamp, int64_t newest_write_timestamp,
+                             TabletSharedPtr new_tablet, SegmentsOverlapPB segments_overlap,
+                             RowsetSharedPtr* rowset);
+
+    Status _external_sorting(std::vector<RowsetSharedPtr>& src_rowsets,
+                             RowsetWriter* rowset_writer, TabletSharedPtr new_tablet);
+
+    const RowBlockChanger& _row_block_changer;
+    size_t _memory_limitation;
+    Version _temp_delta_versions;
+
+    DISALLOW_COPY_AND_ASSIGN(VSchemaChangeWithSorting);
+};
+
 class SchemaChangeHandler {
 public:
     static Status schema_version_convert(TabletSharedPtr base_tablet, TabletSharedPtr new_tablet,
@@ -218,6 +277,17 @@ public:
 
     static std::unique_ptr<SchemaChange> get_sc_procedure(const RowBlockChanger& rb_changer,
                                                           bool sc_sorting, bool sc_directly) {
+        if (config::enable_vectorized_alter_table) {
+            // the rowset readers return blocks rather than row blocks in this case
+            if (sc_sorting) {
+                return std::make_unique<VSchemaChangeWithSorting>(
+                        rb_changer, config::memory_limitation_per_thread_for_schema_change_bytes);
+            }
+            if (sc_directly) {
+                return std::make_unique<VSchemaChangeDirectly>(rb_changer);
+            }
+            return std::make_unique<LinkedSchemaChange>(rb_changer);
+        }
         if (sc_sorting) {
             return std::make_unique<SchemaChangeWithSorting>(
                     rb_changer, config::memory_limitation_per_thread_for_schema_change_bytes);
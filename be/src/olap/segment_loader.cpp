@@ -17,6 +17,7 @@
 
 #include "olap/segment_loader.h"
 
+#include "common/config.h"
 #include "olap/rowset/rowset.h"
 #include "util/stopwatch.hpp"
 
@@ -31,8 +32,13 @@ void SegmentLoader::create_global_instance(size_t capacity) {
 }
 
 SegmentLoader::SegmentLoader(size_t capacity) {
-    _cache = std::unique_ptr<Cache>(
-            new_lru_cache("SegmentLoader:SegmentCache", capacity, LRUCacheType::NUMBER));
+    CacheEvictionPolicy policy = CacheEvictionPolicy::LRU;
+    if (!parse_cache_eviction_policy(config::segment_cache_eviction_policy, &policy)) {
+        LOG(WARNING) << "unknown segment_cache_eviction_policy "
+                     << config::segment_cache_eviction_policy << ", use LRU";
+    }
+    _cache = std::unique_ptr<Cache>(new_lru_cache("SegmentLoader:SegmentCache", capacity,
+                                                  LRUCacheType::NUMBER, 16, policy));
 }
 
 bool SegmentLoader::_lookup(const SegmentLoader::CacheKey& key, SegmentCacheHandle* handle) {
@@ -81,6 +87,10 @@ Status SegmentLoader::load_segments(const BetaRowsetSharedPtr& rowset,
     return Status::OK();
 }
 
+void SegmentLoader::erase_segments(const RowsetId& rowset_id) {
+    _cache->erase(CacheKey(rowset_id).encode());
+}
+
 Status SegmentLoader::prune() {
     const int64_t curtime = UnixMillis();
     auto pred = [curtime](const void* value) -> bool {
@@ -84,6 +84,9 @@ public:
     Status load_segments(const BetaRowsetSharedPtr& rowset, SegmentCacheHandle* cache_handle,
                          bool use_cache = false);
 
+    // Drops the cached segments of the rowset, called after a segment is appended to it.
+    void erase_segments(const RowsetId& rowset_id);
+
     // Try to prune the segment cache if expired.
     Status prune();
 
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/segment_meta_cache.h"
+
+namespace doris {
+
+SegmentMetaCache* SegmentMetaCache::_s_instance = nullptr;
+
+void SegmentMetaCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity == 0) {
+        return;
+    }
+    static SegmentMetaCache instance(capacity);
+    _s_instance = &instance;
+}
+
+SegmentMetaCache::SegmentMetaCache(size_t capacity) {
+    _cache.reset(new_lru_cache("SegmentMetaCache", capacity, LRUCacheType::SIZE));
+}
+
+template <typename T>
+std::shared_ptr<const T> SegmentMetaCache::_lookup(const std::string& key) {
+    auto handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto value = *reinterpret_cast<std::shared_ptr<const T>*>(_cache->value(handle));
+    _cache->release(handle);
+    return value;
+}
+
+template <typename T>
+void SegmentMetaCache::_insert(const std::string& key, std::shared_ptr<const T> value,
+                               size_t charge) {
+    auto deleter = [](const doris::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const T>*>(value);
+    };
+    auto handle = _cache->insert(CacheKey(key), new std::shared_ptr<const T>(std::move(value)),
+                                 charge, deleter, CachePriority::NORMAL);
+    _cache->release(handle);
+}
+
+// The footers and the short key index pages of a segment share the path
+static std::string footer_key(const std::string& path) {
+    return "f:" + path;
+}
+
+static std::string short_key_index_key(const std::string& path) {
+    return "s:" + path;
+}
+
+std::shared_ptr<const segment_v2::SegmentFooterPB> SegmentMetaCache::lookup_footer(
+        const std::string& path) {
+    return _lookup<segment_v2::SegmentFooterPB>(footer_key(path));
+}
+
+void SegmentMetaCache::insert_footer(const std::string& path,
+                                     std::shared_ptr<const segment_v2::SegmentFooterPB> footer) {
+    size_t charge = footer->SpaceUsedLong();
+    _insert(footer_key(path), std::move(footer), charge);
+}
+
+std::shared_ptr<const ShortKeyIndexPage> SegmentMetaCache::lookup_short_key_index(
+        const std::string& path) {
+    return _lookup<ShortKeyIndexPage>(short_key_index_key(path));
+}
+
+void SegmentMetaCache::insert_short_key_index(const std::string& path,
+                                              std::shared_ptr<const ShortKeyIndexPage> page) {
+    size_t charge = sizeof(ShortKeyIndexPage) + page->body.capacity() +
+                    page->footer.SpaceUsedLong();
+    _insert(short_key_index_key(path), std::move(page), charge);
+}
+
+} // namespace doris
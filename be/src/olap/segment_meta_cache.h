@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "olap/lru_cache.h"
+
+namespace doris {
+
+// The short key index page of a segment, the decoder refers to 'body' directly.
+struct ShortKeyIndexPage {
+    std::string body;
+    segment_v2::ShortKeyFooterPB footer;
+};
+
+// SegmentMetaCache caches the parsed footers and the short key index pages of the segments by
+// their paths, which are much smaller than the segments cached by SegmentLoader with all their
+// column readers, so many more segments could be opened without reading them again, which is
+// costly on remote storage. The entries are charged by their memory.
+//
+// The segment files are never modified, so the entries are only evicted, never invalidated.
+class SegmentMetaCache {
+public:
+    // Caches nothing if capacity is 0.
+    static void create_global_instance(size_t capacity);
+
+    // nullptr if the cache is disabled or not created, e.g. in the tools.
+    static SegmentMetaCache* instance() { return _s_instance; }
+
+    explicit SegmentMetaCache(size_t capacity);
+
+    std::shared_ptr<const segment_v2::SegmentFooterPB> lookup_footer(const std::string& path);
+    void insert_footer(const std::string& path,
+                       std::shared_ptr<const segment_v2::SegmentFooterPB> footer);
+
+    std::shared_ptr<const ShortKeyIndexPage> lookup_short_key_index(const std::string& path);
+    void insert_short_key_index(const std::string& path,
+                                std::shared_ptr<const ShortKeyIndexPage> page);
+
+private:
+    template <typename T>
+    std::shared_ptr<const T> _lookup(const std::string& key);
+    template <typename T>
+    void _insert(const std::string& key, std::shared_ptr<const T> value, size_t charge);
+
+    static SegmentMetaCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris
@@ -17,13 +17,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
+#include "gutil/endian.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -240,6 +243,19 @@ public:
         return seek<false>(key);
     }
 
+    // Return both lower_bound(key) and upper_bound(key) with one search of the key prefixes.
+    std::pair<ShortKeyIndexIterator, ShortKeyIndexIterator> equal_range(const Slice& key) const {
+        DCHECK(_parsed);
+        uint64_t prefix = key_prefix(key);
+        uint32_t first = _search_prefix<false>(prefix);
+        uint32_t last = _search_prefix<true>(prefix);
+        auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
+        auto lower = std::lower_bound(ShortKeyIndexIterator(this, first),
+                                      ShortKeyIndexIterator(this, last), key, comparator);
+        auto upper = std::upper_bound(lower, ShortKeyIndexIterator(this, last), key, comparator);
+        return {lower, upper};
+    }
+
     uint32_t num_items() const {
         DCHECK(_parsed);
         return _footer.num_items();
@@ -256,15 +272,47 @@ public:
         return {_key_data.data + _offsets[ordinal], _offsets[ordinal + 1] - _offsets[ordinal]};
     }
 
+    // The first 8 bytes of the key as a big endian integer, padded with zeros. The order of
+    // the prefixes is consistent with the order of the keys: if prefix(a) < prefix(b) then
+    // a < b, so only the keys with the same prefix need to be compared byte by byte.
+    static uint64_t key_prefix(const Slice& key) {
+        uint64_t prefix = 0;
+        memcpy(&prefix, key.data, std::min<size_t>(key.size, sizeof(prefix)));
+        return BigEndian::FromHost64(prefix);
+    }
+
 private:
     template <bool lower_bound>
     ShortKeyIndexIterator seek(const Slice& key) const {
+        uint64_t prefix = key_prefix(key);
+        uint32_t first = _search_prefix<false>(prefix);
+        uint32_t last = _search_prefix<true>(prefix);
         auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
         if (lower_bound) {
-            return std::lower_bound(begin(), end(), key, comparator);
+            return std::lower_bound(ShortKeyIndexIterator(this, first),
+                                    ShortKeyIndexIterator(this, last), key, comparator);
         } else {
-            return std::upper_bound(begin(), end(), key, comparator);
+            return std::upper_bound(ShortKeyIndexIterator(this, first),
+                                    ShortKeyIndexIterator(this, last), key, comparator);
+        }
+    }
+
+    // The index of the first prefix not less than (or greater than if upper) 'prefix'. The
+    // loop has no branch depending on the data, so it doesn't suffer from branch mispredictions
+    // and the loads can be issued ahead.
+    template <bool upper>
+    uint32_t _search_prefix(uint64_t prefix) const {
+        const uint64_t* base = _key_prefixes.data();
+        size_t n = _key_prefixes.size();
+        if (n == 0) {
+            return 0;
+        }
+        while (n > 1) {
+            size_t half = n / 2;
+            base += (upper ? base[half] <= prefix : base[half] < prefix) ? half : 0;
+            n -= half;
         }
+        return base - _key_prefixes.data() + (upper ? *base <= prefix : *base < prefix);
     }
 
 private:
@@ -273,6 +321,8 @@ private:
     // All following fields are only valid after parse has been executed successfully
     segment_v2::ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
+    // key_prefix() of each key
+    std::vector<uint64_t> _key_prefixes;
     Slice _key_data;
 };
 
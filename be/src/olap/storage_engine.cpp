@@ -38,6 +38,7 @@
 #include "agent/task_worker_pool.h"
 #include "env/env.h"
 #include "env/env_util.h"
+#include "io/fs/local_file_system.h"
 #include "olap/base_compaction.h"
 #include "olap/cumulative_compaction.h"
 #include "olap/data_dir.h"
@@ -169,6 +170,9 @@ StorageEngine::~StorageEngine() {
     if (_tablet_meta_checkpoint_thread_pool) {
         _tablet_meta_checkpoint_thread_pool->shutdown();
     }
+    if (_publish_version_thread_pool) {
+        _publish_version_thread_pool->shutdown();
+    }
 }
 
 void StorageEngine::load_data_dirs(const std::vector<DataDir*>& data_dirs) {
@@ -190,7 +194,14 @@ void StorageEngine::load_data_dirs(const std::vector<DataDir*>& data_dirs) {
 
 Status StorageEngine::_open() {
     // NOTE: must init before _init_store_map.
-    _file_cache.reset(new_lru_cache("FileHandlerCache", config::file_descriptor_cache_capacity));
+    CacheEvictionPolicy file_cache_policy = CacheEvictionPolicy::LRU;
+    if (!parse_cache_eviction_policy(config::file_descriptor_cache_eviction_policy,
+                                     &file_cache_policy)) {
+        LOG(WARNING) << "unknown file_descriptor_cache_eviction_policy "
+                     << config::file_descriptor_cache_eviction_policy << ", use LRU";
+    }
+    _file_cache.reset(new_lru_cache("FileHandlerCache", config::file_descriptor_cache_capacity,
+                                    LRUCacheType::SIZE, 16, file_cache_policy));
 
     // init store_map
     RETURN_NOT_OK_STATUS_WITH_WARN(_init_store_map(), "_init_store_map failed");
@@ -416,7 +427,9 @@ int64_t StorageEngine::get_file_or_directory_size(const std::string& file_path)
 void StorageEngine::_start_disk_stat_monitor() {
     for (auto& it : _store_map) {
         it.second->health_check();
+        it.second->io_limiter()->adjust();
     }
+    io::global_local_filesystem()->io_limiter()->adjust();
 
     _update_storage_medium_type_count();
     bool some_tablets_were_dropped = _delete_tablets_on_unused_root_path();
@@ -592,6 +605,7 @@ void StorageEngine::stop() {
     THREAD_JOIN(_disk_stat_monitor_thread);
     THREAD_JOIN(_fd_cache_clean_thread);
     THREAD_JOIN(_tablet_checkpoint_tasks_producer_thread);
+    THREAD_JOIN(_page_cache_warm_up_thread);
 #undef THREAD_JOIN
 
 #define THREADS_JOIN(threads)            \
@@ -139,6 +139,9 @@ public:
     TxnManager* txn_manager() { return _txn_manager.get(); }
     MemTableFlushExecutor* memtable_flush_executor() { return _memtable_flush_executor.get(); }
 
+    // maybe nullptr before the background threads are started
+    ThreadPool* publish_version_thread_pool() { return _publish_version_thread_pool.get(); }
+
     bool check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id);
 
     RowsetId next_rowset_id() { return _rowset_id_generator->next_id(); };
@@ -267,6 +270,8 @@ private:
                                                 CompactionType compaction_type);
     void _pop_tablet_from_submitted_compaction(TabletSharedPtr tablet,
                                                CompactionType compaction_type);
+    // Adds `permits` to the permits held by the compaction tasks of `data_dir`.
+    void _update_disk_compaction_permits(DataDir* data_dir, int64_t permits);
 
     Status _init_stream_load_recorder(const std::string& stream_load_record_path);
 
@@ -278,6 +283,10 @@ private:
     
     void _cooldown_tasks_producer_callback();
 
+    // warm up the page cache with the pages saved in the data dirs, then save the cached
+    // pages periodically
+    void _page_cache_warm_up_callback();
+
 private:
     struct CompactionCandidate {
         CompactionCandidate(uint32_t nicumulative_compaction_, int64_t tablet_id_, uint32_t index_)
@@ -394,12 +403,16 @@ private:
 
     std::unique_ptr<ThreadPool> _tablet_meta_checkpoint_thread_pool;
 
+    std::unique_ptr<ThreadPool> _publish_version_thread_pool;
+
     CompactionPermitLimiter _permit_limiter;
 
     std::mutex _tablet_submitted_compaction_mutex;
     // a tablet can do base and cumulative compaction at same time
     std::map<DataDir*, std::unordered_set<TTabletId>> _tablet_submitted_cumu_compaction;
     std::map<DataDir*, std::unordered_set<TTabletId>> _tablet_submitted_base_compaction;
+    // the permits held by the running compaction tasks of each disk
+    std::map<DataDir*, int64_t> _disk_compaction_permits;
 
     std::atomic<int32_t> _wakeup_producer_flag {0};
 
@@ -418,6 +431,8 @@ private:
     std::unordered_map<DataDir*, int64_t> _running_cooldown_tasks_cnt;
     std::unordered_set<int64_t> _running_cooldown_tablets;
 
+    scoped_refptr<Thread> _page_cache_warm_up_thread;
+
     DISALLOW_COPY_AND_ASSIGN(StorageEngine);
 };
 
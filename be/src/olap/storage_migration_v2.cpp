@@ -347,6 +347,8 @@ Status StorageMigrationV2Handler::_convert_historical_rowsets(
         writer_context.segments_overlap = rs_reader->rowset()->rowset_meta()->segments_overlap();
         writer_context.oldest_write_timestamp = rs_reader->oldest_write_timestamp();
         writer_context.newest_write_timestamp = rs_reader->newest_write_timestamp();
+        writer_context.enable_unique_key_merge_on_write =
+                new_tablet->enable_unique_key_merge_on_write();
 
         std::unique_ptr<RowsetWriter> rowset_writer;
         Status status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
@@ -27,8 +27,10 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <mutex>
+#include <numeric>
 #include <set>
 #include <shared_mutex>
 #include <string>
@@ -36,18 +38,27 @@
 #include "common/config.h"
 #include "common/logging.h"
 #include "common/status.h"
+#include "io/fs/file_writer.h"
 #include "io/fs/path.h"
 #include "io/fs/remote_file_system.h"
 #include "olap/base_compaction.h"
 #include "olap/cumulative_compaction.h"
+#include "olap/delete_handler.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/reader.h"
 #include "olap/row_cursor.h"
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_meta_manager.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/column_statistics.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/schema_change.h"
+#include "olap/segment_loader.h"
 #include "olap/storage_engine.h"
 #include "olap/storage_policy_mgr.h"
 #include "olap/tablet_meta.h"
@@ -57,6 +68,8 @@
 #include "util/scoped_cleanup.h"
 #include "util/time.h"
 #include "util/trace.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/olap/olap_data_convertor.h"
 
 namespace doris {
 
@@ -68,6 +81,10 @@ using std::vector;
 
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(flush_bytes, MetricUnit::BYTES);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(flush_count, MetricUnit::OPERATIONS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(query_scan_filtered_rows, MetricUnit::ROWS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(query_scan_sorted_runs, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(query_scan_pages, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(query_scan_cached_pages, MetricUnit::NOUNIT);
 
 TabletSharedPtr Tablet::create_tablet_from_meta(TabletMetaSharedPtr tablet_meta,
                                                 const StorageParamPB& storage_param,
@@ -89,6 +106,7 @@ Tablet::Tablet(TabletMetaSharedPtr tablet_meta, const StorageParamPB& storage_pa
           _cumulative_compaction_type(cumulative_compaction_type),
           _last_record_scan_count(0),
           _last_record_scan_count_timestamp(time(nullptr)),
+          _last_record_read_amplification_timestamp(time(nullptr)),
           _is_clone_occurred(false),
           _last_missed_version(-1),
           _last_missed_time_s(0) {
@@ -98,6 +116,10 @@ Tablet::Tablet(TabletMetaSharedPtr tablet_meta, const StorageParamPB& storage_pa
 
     INT_COUNTER_METRIC_REGISTER(_metric_entity, flush_bytes);
     INT_COUNTER_METRIC_REGISTER(_metric_entity, flush_count);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_filtered_rows);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_sorted_runs);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_pages);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, query_scan_cached_pages);
 }
 
 Status Tablet::_init_once_action() {
@@ -187,6 +209,8 @@ Status Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& rowset
             break;
         }
         _tablet_meta = new_tablet_meta;
+        std::lock_guard<std::mutex> l(_continuous_version_cache_lock);
+        _continuous_version_cache.rs_metas_version = -1;
     } while (0);
 
     for (auto& version : versions_to_delete) {
@@ -393,6 +417,9 @@ RowsetSharedPtr Tablet::_rowset_with_largest_size() {
 // add inc rowset should not persist tablet meta, because it will be persisted when publish txn.
 Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     DCHECK(rowset != nullptr);
+    if (enable_unique_key_merge_on_write()) {
+        return _add_inc_rowset_with_delete_bitmap(rowset);
+    }
     std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
     if (_contains_rowset(rowset->rowset_id())) {
         return Status::OK();
@@ -408,12 +435,57 @@ Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     return Status::OK();
 }
 
+Status Tablet::_add_inc_rowset_with_delete_bitmap(const RowsetSharedPtr& rowset) {
+    std::lock_guard<std::mutex> update_lock(_rowset_update_lock);
+    std::vector<RowsetSharedPtr> specified_rowsets;
+    {
+        std::shared_lock rdlock(_meta_lock);
+        if (_contains_rowset(rowset->rowset_id())) {
+            return Status::OK();
+        }
+        RETURN_NOT_OK(_contains_version(rowset->version()));
+        for (auto& [version, rs] : _rs_version_map) {
+            if (version.second < rowset->start_version()) {
+                specified_rowsets.push_back(rs);
+            }
+        }
+    }
+    // newer rowsets first, the key is most likely to be found in them
+    std::sort(specified_rowsets.begin(), specified_rowsets.end(),
+              [](const RowsetSharedPtr& lhs, const RowsetSharedPtr& rhs) {
+                  return lhs->end_version() > rhs->end_version();
+              });
+    // the rowsets can't be removed by compaction while holding _rowset_update_lock,
+    // so it's safe to calculate the delete bitmap without _meta_lock
+    if (rowset->rowset_meta()->has_partial_update()) {
+        RETURN_NOT_OK(_resolve_partial_update_conflicts(rowset, specified_rowsets));
+    }
+    auto delete_bitmap = std::make_shared<DeleteBitmap>();
+    RETURN_NOT_OK(
+            calc_delete_bitmap(rowset, specified_rowsets, delete_bitmap, rowset->end_version()));
+
+    std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
+    RETURN_NOT_OK(_tablet_meta->add_rs_meta(rowset->rowset_meta()));
+    _rs_version_map[rowset->version()] = rowset;
+    _tablet_meta->delete_bitmap().merge(*delete_bitmap);
+
+    _timestamped_version_tracker.add_version(rowset->version());
+
+    ++_newly_created_rowset_num;
+    // the delete bitmap only lives in tablet meta, persist it with the rowset together
+    save_meta();
+    return Status::OK();
+}
+
 void Tablet::_delete_stale_rowset_by_version(const Version& version) {
     RowsetMetaSharedPtr rowset_meta = _tablet_meta->acquire_stale_rs_meta_by_version(version);
     if (rowset_meta == nullptr) {
         return;
     }
     _tablet_meta->delete_stale_rs_meta_by_version(version);
+    if (enable_unique_key_merge_on_write()) {
+        _tablet_meta->delete_bitmap().remove_rowset(rowset_meta->rowset_id());
+    }
     VLOG_NOTICE << "delete stale rowset. tablet=" << full_name() << ", version=" << version;
 }
 
@@ -763,6 +835,11 @@ const uint32_t Tablet::_calc_cumulative_compaction_score(
 }
 
 const uint32_t Tablet::_calc_base_compaction_score() const {
+    if (_cumulative_compaction_policy != nullptr &&
+        _cumulative_compaction_policy->name() == CUMULATIVE_TIME_SERIES_POLICY) {
+        // the rowsets before the cumulative point are closed in time series policy
+        return 0;
+    }
     uint32_t score = 0;
     const int64_t point = cumulative_layer_point();
     bool base_rowset_exist = false;
@@ -830,6 +907,18 @@ void Tablet::max_continuous_version_from_beginning(Version* version, Version* ma
 
 void Tablet::_max_continuous_version_from_beginning_unlocked(Version* version, Version* max_version,
                                                              bool* has_version_cross) const {
+    int64_t rs_metas_version = _tablet_meta->rs_metas_version();
+    {
+        std::lock_guard<std::mutex> l(_continuous_version_cache_lock);
+        if (_continuous_version_cache.rs_metas_version == rs_metas_version) {
+            *version = _continuous_version_cache.version;
+            if (max_version != nullptr && _continuous_version_cache.max_version.first >= 0) {
+                *max_version = _continuous_version_cache.max_version;
+            }
+            *has_version_cross = _continuous_version_cache.has_version_cross;
+            return;
+        }
+    }
     std::vector<Version> existing_versions;
     *has_version_cross = false;
     for (auto& rs : _tablet_meta->all_rs_metas()) {
@@ -857,6 +946,13 @@ void Tablet::_max_continuous_version_from_beginning_unlocked(Version* version, V
     if (max_version != nullptr && !existing_versions.empty()) {
         *max_version = existing_versions.back();
     }
+
+    std::lock_guard<std::mutex> l(_continuous_version_cache_lock);
+    _continuous_version_cache.rs_metas_version = rs_metas_version;
+    _continuous_version_cache.version = max_continuous_version;
+    _continuous_version_cache.max_version =
+            existing_versions.empty() ? Version(-1, -1) : existing_versions.back();
+    _continuous_version_cache.has_version_cross = *has_version_cross;
 }
 
 void Tablet::calculate_cumulative_point() {
@@ -1395,6 +1491,36 @@ void Tablet::build_tablet_report_info(TTabletInfo* tablet_info,
     tablet_info->__set_is_in_memory(_tablet_meta->tablet_schema().is_in_memory());
     tablet_info->__set_replica_id(replica_id());
     tablet_info->__set_remote_data_size(_tablet_meta->tablet_remote_size());
+    if (config::report_tablet_column_statistics) {
+        _build_column_statistics_report_unlocked(tablet_info);
+    }
+}
+
+void Tablet::_build_column_statistics_report_unlocked(TTabletInfo* tablet_info) const {
+    std::map<uint32_t, segment_v2::ColumnStatisticsPB> merged;
+    for (const auto& [version, rowset] : _rs_version_map) {
+        const auto& rowset_meta = rowset->rowset_meta();
+        if (rowset_meta->num_rows() == 0) {
+            continue;
+        }
+        if (rowset_meta->column_statistics().empty()) {
+            return;
+        }
+        for (const auto& statistics : rowset_meta->column_statistics()) {
+            segment_v2::ColumnStatisticsCollector::merge(statistics,
+                                                         &merged[statistics.unique_id()]);
+        }
+    }
+    std::vector<TColumnStatistics> column_statistics;
+    for (const auto& [unique_id, statistics] : merged) {
+        TColumnStatistics column;
+        column.__set_unique_id(unique_id);
+        column.__set_num_rows(statistics.num_rows());
+        column.__set_null_count(statistics.null_count());
+        column.__set_ndv(segment_v2::ColumnStatisticsCollector::estimate_ndv(statistics));
+        column_statistics.push_back(std::move(column));
+    }
+    tablet_info->__set_column_statistics(std::move(column_statistics));
 }
 
 // should use this method to get a copy of current tablet meta
@@ -1418,7 +1544,9 @@ double Tablet::calculate_scan_frequency() {
     time_t now = time(nullptr);
     int64_t current_count = query_scan_count->value();
     double interval = difftime(now, _last_record_scan_count_timestamp);
-    double scan_frequency = (current_count - _last_record_scan_count) * 60 / interval;
+    // avoid dividing by 0 right after a record
+    double scan_frequency =
+            (current_count - _last_record_scan_count) * 60 / std::max(interval, 1.0);
     if (interval >= config::tablet_scan_frequency_time_node_interval_second) {
         _last_record_scan_count = current_count;
         _last_record_scan_count_timestamp = now;
@@ -1426,6 +1554,36 @@ double Tablet::calculate_scan_frequency() {
     return scan_frequency;
 }
 
+void Tablet::record_query_scan(int64_t compressed_bytes_read, int64_t raw_rows_read,
+                               const OlapReaderStatistics& stats) {
+    query_scan_bytes->increment(compressed_bytes_read);
+    query_scan_rows->increment(raw_rows_read);
+    query_scan_count->increment(1);
+    // rows_stats_filtered and rows_bf_filtered are counted in rows_conditions_filtered
+    query_scan_filtered_rows->increment(
+            stats.rows_key_range_filtered + stats.rows_conditions_filtered +
+            stats.rows_bitmap_index_filtered + stats.rows_inverted_index_filtered +
+            stats.rows_del_filtered + stats.rows_vec_del_cond_filtered +
+            stats.rows_vec_cond_filtered);
+    query_scan_pages->increment(stats.total_pages_num);
+    query_scan_cached_pages->increment(stats.cached_pages_num);
+}
+
+double Tablet::calculate_read_amplification() {
+    time_t now = time(nullptr);
+    int64_t count = _read_amplification_count;
+    double read_amplification = count > 0 ? static_cast<double>(_read_amplification_sum) / count
+                                          : _last_read_amplification;
+    if (difftime(now, _last_record_read_amplification_timestamp) >=
+        config::tablet_scan_frequency_time_node_interval_second) {
+        _last_read_amplification = count > 0 ? read_amplification : 1.0;
+        _read_amplification_sum = 0;
+        _read_amplification_count = 0;
+        _last_record_read_amplification_timestamp = now;
+    }
+    return read_amplification;
+}
+
 Status Tablet::prepare_compaction_and_calculate_permits(CompactionType compaction_type,
                                                         TabletSharedPtr tablet, int64_t* permits) {
     std::vector<RowsetSharedPtr> compaction_rowsets;
@@ -1610,10 +1768,12 @@ Status Tablet::create_rowset_writer(const Version& version, const RowsetStatePB&
 Status Tablet::create_rowset_writer(const int64_t& txn_id, const PUniqueId& load_id,
                                     const RowsetStatePB& rowset_state,
                                     const SegmentsOverlapPB& overlap,
-                                    std::unique_ptr<RowsetWriter>* rowset_writer) {
+                                    std::unique_ptr<RowsetWriter>* rowset_writer,
+                                    std::shared_ptr<PartialUpdateInfo> partial_update_info) {
     RowsetWriterContext context;
     context.txn_id = txn_id;
     context.load_id = load_id;
+    context.partial_update_info = std::move(partial_update_info);
     context.rowset_state = rowset_state;
     context.segments_overlap = overlap;
     context.oldest_write_timestamp = -1;
@@ -1622,6 +1782,20 @@ Status Tablet::create_rowset_writer(const int64_t& txn_id, const PUniqueId& load
     return RowsetFactory::create_rowset_writer(context, rowset_writer);
 }
 
+Status Tablet::create_vertical_rowset_writer(
+        const Version& version, const RowsetStatePB& rowset_state, const SegmentsOverlapPB& overlap,
+        int64_t oldest_write_timestamp, int64_t newest_write_timestamp,
+        std::unique_ptr<RowsetWriter>* rowset_writer) {
+    RowsetWriterContext context;
+    context.version = version;
+    context.rowset_state = rowset_state;
+    context.segments_overlap = overlap;
+    context.oldest_write_timestamp = oldest_write_timestamp;
+    context.newest_write_timestamp = newest_write_timestamp;
+    _init_context_common_fields(context);
+    return RowsetFactory::create_rowset_writer(context, true, rowset_writer);
+}
+
 void Tablet::_init_context_common_fields(RowsetWriterContext& context) {
     context.rowset_id = StorageEngine::instance()->next_rowset_id();
     context.tablet_uid = tablet_uid();
@@ -1638,6 +1812,7 @@ void Tablet::_init_context_common_fields(RowsetWriterContext& context) {
     context.tablet_path = tablet_path();
     context.tablet_schema = &(tablet_schema());
     context.data_dir = data_dir();
+    context.enable_unique_key_merge_on_write = enable_unique_key_merge_on_write();
 }
 
 Status Tablet::create_rowset(RowsetMetaSharedPtr rowset_meta, RowsetSharedPtr* rowset) {
@@ -1804,4 +1979,570 @@ void Tablet::remove_all_remote_rowsets() {
     }
 }
 
+namespace {
+
+// Segments of a rowset with their primary key index iterators, which are opened once and
+// reused for looking up all the keys of a load.
+struct RowsetKeyLookupContext {
+    RowsetSharedPtr rowset;
+    SegmentCacheHandle segment_cache_handle;
+    std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>> index_iterators;
+
+    std::vector<segment_v2::SegmentSharedPtr>& segments() {
+        return segment_cache_handle.get_segments();
+    }
+};
+
+Status init_lookup_context(const RowsetSharedPtr& rowset, RowsetKeyLookupContext* ctx) {
+    ctx->rowset = rowset;
+    RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+            std::static_pointer_cast<BetaRowset>(rowset), &ctx->segment_cache_handle, true));
+    for (auto& segment : ctx->segments()) {
+        std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
+        RETURN_NOT_OK(segment->new_primary_key_iterator(&index_iterator));
+        ctx->index_iterators.push_back(std::move(index_iterator));
+    }
+    return Status::OK();
+}
+
+Status init_lookup_contexts(const std::vector<RowsetSharedPtr>& rowsets,
+                            std::vector<RowsetKeyLookupContext>* ctxs) {
+    ctxs->reserve(rowsets.size());
+    for (auto& rowset : rowsets) {
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        ctxs->emplace_back();
+        RETURN_NOT_OK(init_lookup_context(rowset, &ctxs->back()));
+    }
+    return Status::OK();
+}
+
+// `ctxs` is sorted by version in descending order, and the later segments in a rowset
+// overwrite the earlier ones, so the first row found which is not deleted is the visible one.
+Status lookup_row_key_in_contexts(const Slice& encoded_key,
+                                  std::vector<RowsetKeyLookupContext>& ctxs,
+                                  const DeleteBitmap& delete_bitmap, int64_t version,
+                                  RowLocation* row_location) {
+    for (auto& ctx : ctxs) {
+        auto& segments = ctx.segments();
+        for (int seg_id = segments.size() - 1; seg_id >= 0; --seg_id) {
+            RowLocation loc;
+            auto st = segments[seg_id]->lookup_row_key(encoded_key, &loc,
+                                                       ctx.index_iterators[seg_id].get());
+            if (st.is_not_found()) {
+                continue;
+            }
+            RETURN_NOT_OK(st);
+            loc.rowset_id = ctx.rowset->rowset_id();
+            if (delete_bitmap.contains_agg({loc.rowset_id, loc.segment_id, version}, loc.row_id)) {
+                continue;
+            }
+            *row_location = loc;
+            return Status::OK();
+        }
+    }
+    return Status::NotFound("can't find key in all rowsets");
+}
+
+} // namespace
+
+Status Tablet::lookup_row_key(const Slice& encoded_key,
+                              const std::vector<RowsetSharedPtr>& specified_rowsets,
+                              RowLocation* row_location, int64_t version) {
+    if (!enable_unique_key_merge_on_write()) {
+        return Status::NotSupported("lookup row key needs primary key index");
+    }
+    std::vector<RowsetKeyLookupContext> ctxs;
+    RETURN_NOT_OK(init_lookup_contexts(specified_rowsets, &ctxs));
+    return lookup_row_key_in_contexts(encoded_key, ctxs, _tablet_meta->delete_bitmap(), version,
+                                      row_location);
+}
+
+void Tablet::capture_rowsets_for_lookup(std::vector<RowsetSharedPtr>* rowsets, int64_t* version) {
+    {
+        std::shared_lock rdlock(_meta_lock);
+        for (auto& [_, rs] : _rs_version_map) {
+            rowsets->push_back(rs);
+        }
+    }
+    std::sort(rowsets->begin(), rowsets->end(),
+              [](const RowsetSharedPtr& lhs, const RowsetSharedPtr& rhs) {
+                  return lhs->end_version() > rhs->end_version();
+              });
+    *version = rowsets->empty() ? 0 : rowsets->front()->end_version();
+}
+
+Status Tablet::read_latest_rows(
+        const std::vector<std::string>& encoded_keys,
+        const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns,
+        const std::vector<RowsetSharedPtr>& specified_rowsets, int64_t version,
+        const std::vector<uint32_t>& cids, vectorized::MutableColumns* columns,
+        std::vector<bool>* found) {
+    if (!enable_unique_key_merge_on_write()) {
+        return Status::NotSupported("read latest rows needs primary key index");
+    }
+    DCHECK_EQ(cids.size(), columns->size());
+    DCHECK_EQ(key_columns.size(), num_key_columns());
+    std::vector<RowsetKeyLookupContext> ctxs;
+    RETURN_NOT_OK(init_lookup_contexts(specified_rowsets, &ctxs));
+
+    // The delete predicates of unique key tablets are only on the key columns, so they are
+    // evaluated on the keys looked up instead of the rows found.
+    DelPredicateArray delete_predicates;
+    for (const auto& rowset : specified_rowsets) {
+        if (rowset->rowset_meta()->has_delete_predicate()) {
+            *delete_predicates.Add() = rowset->rowset_meta()->delete_predicate();
+        }
+    }
+    DeleteHandler delete_handler;
+    RowCursor key_cursor;
+    if (!delete_predicates.empty()) {
+        RETURN_NOT_OK(delete_handler.init(tablet_schema(), delete_predicates, version));
+        RETURN_NOT_OK(key_cursor.init(tablet_schema(), num_key_columns()));
+    }
+    auto is_deleted_by_predicates = [&](size_t key_idx, int64_t data_version) {
+        if (delete_handler.empty()) {
+            return false;
+        }
+        for (size_t cid = 0; cid < key_columns.size(); ++cid) {
+            const void* cell = key_columns[cid]->get_data_at(key_idx);
+            if (cell == nullptr) {
+                key_cursor.set_null(cid);
+            } else {
+                key_cursor.set_not_null(cid);
+                key_cursor.set_field_content_shallow(cid, static_cast<const char*>(cell));
+            }
+        }
+        return delete_handler.is_filter_data(data_version, key_cursor);
+    };
+
+    // The rows found are read segment by segment in the order of row ids, a segment is
+    // identified by the index of its rowset in `ctxs` and its segment id.
+    using SegmentKey = std::pair<size_t, uint32_t>;
+    std::map<SegmentKey, std::vector<uint32_t>> segment_rows;
+    std::vector<SegmentKey> key_segments(encoded_keys.size());
+    std::vector<uint32_t> key_row_ids(encoded_keys.size());
+    found->assign(encoded_keys.size(), false);
+    for (size_t i = 0; i < encoded_keys.size(); ++i) {
+        RowLocation loc;
+        auto st = lookup_row_key_in_contexts(encoded_keys[i], ctxs, _tablet_meta->delete_bitmap(),
+                                             version, &loc);
+        if (st.is_not_found()) {
+            continue;
+        }
+        RETURN_NOT_OK(st);
+        size_t ctx_idx = 0;
+        while (ctxs[ctx_idx].rowset->rowset_id() != loc.rowset_id) {
+            ++ctx_idx;
+        }
+        if (is_deleted_by_predicates(i, ctxs[ctx_idx].rowset->end_version())) {
+            continue;
+        }
+        key_segments[i] = {ctx_idx, loc.segment_id};
+        key_row_ids[i] = loc.row_id;
+        segment_rows[key_segments[i]].push_back(loc.row_id);
+        (*found)[i] = true;
+    }
+
+    // the delete sign is read with the columns, the keys of the rows with it set are deleted
+    std::vector<uint32_t> read_cids = cids;
+    int32_t delete_sign_idx = tablet_schema().delete_sign_idx();
+    size_t delete_sign_pos = read_cids.size();
+    if (delete_sign_idx >= 0) {
+        delete_sign_pos = std::find(read_cids.begin(), read_cids.end(), delete_sign_idx) -
+                          read_cids.begin();
+        if (delete_sign_pos == read_cids.size()) {
+            read_cids.push_back(delete_sign_idx);
+        }
+    }
+    std::map<SegmentKey, vectorized::MutableColumns> segment_columns;
+    OlapReaderStatistics stats;
+    for (auto& [segment_key, row_ids] : segment_rows) {
+        std::sort(row_ids.begin(), row_ids.end());
+        row_ids.erase(std::unique(row_ids.begin(), row_ids.end()), row_ids.end());
+        auto& read_columns = segment_columns[segment_key];
+        for (auto& column : *columns) {
+            read_columns.push_back(column->clone_empty());
+        }
+        if (read_columns.size() < read_cids.size()) {
+            const auto& delete_sign = tablet_schema().column(delete_sign_idx);
+            read_columns.push_back(
+                    vectorized::DataTypeFactory::instance().create_data_type(delete_sign)
+                            ->create_column());
+        }
+        auto& segment = ctxs[segment_key.first].segments()[segment_key.second];
+        RETURN_NOT_OK(segment->read_columns_by_rowids(read_cids, row_ids.data(), row_ids.size(),
+                                                      &read_columns, &stats));
+    }
+    for (size_t i = 0; i < encoded_keys.size(); ++i) {
+        size_t pos = 0;
+        vectorized::MutableColumns* read_columns = nullptr;
+        if ((*found)[i]) {
+            auto& row_ids = segment_rows[key_segments[i]];
+            pos = std::lower_bound(row_ids.begin(), row_ids.end(), key_row_ids[i]) -
+                  row_ids.begin();
+            read_columns = &segment_columns[key_segments[i]];
+            if (delete_sign_idx >= 0 && (*read_columns)[delete_sign_pos]->get_int(pos) != 0) {
+                (*found)[i] = false;
+            }
+        }
+        if (!(*found)[i]) {
+            for (auto& column : *columns) {
+                column->insert_default();
+            }
+            continue;
+        }
+        for (size_t j = 0; j < columns->size(); ++j) {
+            (*columns)[j]->insert_from(*(*read_columns)[j], pos);
+        }
+    }
+    return Status::OK();
+}
+
+namespace {
+
+// Makes a column of the default value of `column` with one row in `dst`.
+Status create_default_column(const TabletColumn& column, vectorized::MutableColumnPtr& dst) {
+    segment_v2::DefaultValueColumnIterator iter(column.has_default_value(), column.default_value(),
+                                                column.is_nullable(), get_type_info(&column),
+                                                column.length());
+    segment_v2::ColumnIteratorOptions iter_opts;
+    RETURN_NOT_OK(iter.init(iter_opts));
+    size_t num_rows = 1;
+    return iter.next_batch(&num_rows, dst);
+}
+
+} // namespace
+
+Status Tablet::_resolve_partial_update_conflicts(
+        const RowsetSharedPtr& rowset, const std::vector<RowsetSharedPtr>& specified_rowsets) {
+    const auto& partial_update = rowset->rowset_meta()->partial_update();
+    std::vector<RowsetSharedPtr> newer_rowsets;
+    bool has_newer_delete_predicate = false;
+    for (const auto& rs : specified_rowsets) {
+        if (rs->end_version() > partial_update.snapshot_version()) {
+            newer_rowsets.push_back(rs);
+            has_newer_delete_predicate |= rs->rowset_meta()->has_delete_predicate();
+        }
+    }
+    if (newer_rowsets.empty() || rowset->num_segments() == 0) {
+        return Status::OK();
+    }
+    OlapStopWatch watch;
+    std::vector<RowsetKeyLookupContext> ctxs;
+    RETURN_NOT_OK(init_lookup_contexts(newer_rowsets, &ctxs));
+    // the segments are not cached, since a segment may be appended to the rowset
+    std::vector<segment_v2::SegmentSharedPtr> segments;
+    RETURN_NOT_OK(std::static_pointer_cast<BetaRowset>(rowset)->load_segments(&segments));
+    std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>> index_iterators;
+    for (auto& segment : segments) {
+        index_iterators.emplace_back();
+        RETURN_NOT_OK(segment->new_primary_key_iterator(&index_iterators.back()));
+    }
+
+    // The keys whose latest rows are in the newer rowsets are read again, and so are all the
+    // keys if a newer delete predicate may delete any of them. A key in the later segments of
+    // the load overwrites the same key in the earlier ones.
+    struct ConflictRow {
+        std::string key;
+        uint32_t segment_id;
+        uint32_t row_id;
+    };
+    std::vector<ConflictRow> conflict_rows;
+    const int64_t version = rowset->start_version() - 1;
+    const auto& delete_bitmap = _tablet_meta->delete_bitmap();
+    for (uint32_t seg_id = 0; seg_id < segments.size(); ++seg_id) {
+        RETURN_NOT_OK(segments[seg_id]->traverse_primary_keys(
+                [&](uint32_t row_id, const Slice& key) -> Status {
+                    RowLocation loc;
+                    for (uint32_t next_seg_id = seg_id + 1; next_seg_id < segments.size();
+                         ++next_seg_id) {
+                        auto st = segments[next_seg_id]->lookup_row_key(
+                                key, &loc, index_iterators[next_seg_id].get());
+                        if (st.ok()) {
+                            return Status::OK();
+                        }
+                        if (!st.is_not_found()) {
+                            return st;
+                        }
+                    }
+                    if (!has_newer_delete_predicate) {
+                        auto st = lookup_row_key_in_contexts(key, ctxs, delete_bitmap, version,
+                                                             &loc);
+                        if (st.is_not_found()) {
+                            return Status::OK();
+                        }
+                        RETURN_NOT_OK(st);
+                    }
+                    conflict_rows.push_back({key.to_string(), seg_id, row_id});
+                    return Status::OK();
+                }));
+    }
+    if (conflict_rows.empty()) {
+        return Status::OK();
+    }
+    // the rows of a segment are sorted by key
+    std::sort(conflict_rows.begin(), conflict_rows.end(),
+              [](const ConflictRow& lhs, const ConflictRow& rhs) { return lhs.key < rhs.key; });
+
+    // read the rows of the load segment by segment in the order of row ids
+    const auto& schema = tablet_schema();
+    std::vector<uint32_t> all_cids(schema.num_columns());
+    std::iota(all_cids.begin(), all_cids.end(), 0);
+    std::map<uint32_t, std::vector<uint32_t>> segment_rows;
+    for (const auto& row : conflict_rows) {
+        segment_rows[row.segment_id].push_back(row.row_id);
+    }
+    std::map<uint32_t, vectorized::MutableColumns> segment_columns;
+    OlapReaderStatistics stats;
+    for (auto& [seg_id, row_ids] : segment_rows) {
+        std::sort(row_ids.begin(), row_ids.end());
+        auto& read_columns = segment_columns[seg_id];
+        read_columns = schema.create_block().mutate_columns();
+        RETURN_NOT_OK(segments[seg_id]->read_columns_by_rowids(
+                all_cids, row_ids.data(), row_ids.size(), &read_columns, &stats));
+    }
+    auto load_block = schema.create_block();
+    auto load_columns = load_block.mutate_columns();
+    std::vector<std::string> encoded_keys;
+    for (auto& row : conflict_rows) {
+        const auto& row_ids = segment_rows[row.segment_id];
+        size_t pos = std::lower_bound(row_ids.begin(), row_ids.end(), row.row_id) -
+                     row_ids.begin();
+        const auto& read_columns = segment_columns[row.segment_id];
+        for (size_t cid = 0; cid < load_columns.size(); ++cid) {
+            load_columns[cid]->insert_from(*read_columns[cid], pos);
+        }
+        encoded_keys.push_back(std::move(row.key));
+    }
+    load_block.set_columns(std::move(load_columns));
+    segment_columns.clear();
+
+    // read the missing columns of the latest rows again, in all the rowsets before the load
+    const size_t num_rows = load_block.rows();
+    std::vector<uint32_t> missing_cids(partial_update.missing_cids().begin(),
+                                       partial_update.missing_cids().end());
+    vectorized::MutableColumns latest_columns;
+    for (auto cid : missing_cids) {
+        latest_columns.push_back(load_block.get_by_position(cid).column->clone_empty());
+    }
+    std::vector<bool> found;
+    {
+        vectorized::OlapBlockDataConvertor convertor(&schema);
+        convertor.set_source_content(&load_block, 0, num_rows);
+        std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
+        for (size_t cid = 0; cid < num_key_columns(); ++cid) {
+            auto converted_result = convertor.convert_column_data(cid);
+            RETURN_NOT_OK(converted_result.first);
+            key_columns.push_back(converted_result.second);
+        }
+        RETURN_NOT_OK(read_latest_rows(encoded_keys, key_columns, specified_rowsets, version,
+                                       missing_cids, &latest_columns, &found));
+    }
+
+    // The keys not found are deleted since the load started, whose missing columns are the
+    // default values like the new keys of the load. The column keeps the value of the load if
+    // it has no default value.
+    auto full_block = load_block.clone_empty();
+    auto full_columns = full_block.mutate_columns();
+    for (size_t cid = 0, i = 0; cid < full_columns.size(); ++cid) {
+        const auto& src = *load_block.get_by_position(cid).column;
+        if (i == missing_cids.size() || missing_cids[i] != cid) {
+            full_columns[cid]->insert_range_from(src, 0, num_rows);
+            continue;
+        }
+        auto default_column = src.clone_empty();
+        bool has_default = create_default_column(schema.column(cid), default_column).ok();
+        for (size_t pos = 0; pos < num_rows; ++pos) {
+            if (found[pos]) {
+                full_columns[cid]->insert_from(*latest_columns[i], pos);
+            } else if (has_default) {
+                full_columns[cid]->insert_from(*default_column, 0);
+            } else {
+                full_columns[cid]->insert_from(src, pos);
+            }
+        }
+        ++i;
+    }
+    full_block.set_columns(std::move(full_columns));
+
+    // append the rows as a new segment of the load
+    auto rowset_meta = rowset->rowset_meta();
+    auto segment_id = static_cast<uint32_t>(rowset->num_segments());
+    auto fs = rowset_meta->fs();
+    if (!fs) {
+        return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
+    }
+    std::unique_ptr<io::FileWriter> file_writer;
+    RETURN_NOT_OK(fs->create_file(
+            std::static_pointer_cast<BetaRowset>(rowset)->segment_file_path(segment_id),
+            &file_writer));
+    segment_v2::SegmentWriterOptions writer_options;
+    writer_options.enable_unique_key_merge_on_write = true;
+    segment_v2::SegmentWriter writer(file_writer.get(), segment_id, &schema, _data_dir, INT32_MAX,
+                                     writer_options);
+    RETURN_NOT_OK(writer.init(config::push_write_mbytes_per_sec));
+    RETURN_NOT_OK(writer.append_block(&full_block, 0, num_rows));
+    uint64_t segment_size = 0;
+    uint64_t index_size = 0;
+    RETURN_NOT_OK(writer.finalize(&segment_size, &index_size));
+    RETURN_NOT_OK(file_writer->close());
+
+    bool has_key_bounds = rowset_meta->has_segments_key_bounds();
+    rowset_meta->set_num_segments(segment_id + 1);
+    rowset_meta->set_num_rows(rowset_meta->num_rows() + num_rows);
+    rowset_meta->set_total_disk_size(rowset_meta->total_disk_size() + segment_size);
+    rowset_meta->set_data_disk_size(rowset_meta->data_disk_size() + segment_size);
+    rowset_meta->set_index_disk_size(rowset_meta->index_disk_size() + index_size);
+    rowset_meta->set_segments_overlap(OVERLAPPING);
+    if (has_key_bounds) {
+        KeyBoundsPB key_bounds;
+        key_bounds.set_min_key(writer.min_encoded_key());
+        key_bounds.set_max_key(writer.max_encoded_key());
+        rowset_meta->add_segment_key_bounds(key_bounds);
+    }
+    if (!rowset_meta->column_statistics().empty()) {
+        // the statistics are merged if the new segment has them for all the columns
+        std::map<int32_t, segment_v2::ColumnStatisticsPB> column_statistics;
+        for (const auto& statistics : rowset_meta->column_statistics()) {
+            column_statistics[statistics.unique_id()] = statistics;
+        }
+        bool merged = true;
+        for (const auto& column : writer.footer().columns()) {
+            if (!column.has_statistics()) {
+                merged = false;
+                break;
+            }
+            segment_v2::ColumnStatisticsCollector::merge(
+                    column.statistics(), &column_statistics[column.unique_id()]);
+        }
+        std::vector<segment_v2::ColumnStatisticsPB> merged_statistics;
+        if (merged) {
+            for (auto& [unique_id, statistics] : column_statistics) {
+                merged_statistics.push_back(std::move(statistics));
+            }
+        }
+        rowset_meta->set_column_statistics(merged_statistics);
+    }
+    SegmentLoader::instance()->erase_segments(rowset->rowset_id());
+    RETURN_NOT_OK(RowsetMetaManager::save(_data_dir->get_meta(), tablet_uid(),
+                                          rowset->rowset_id(), rowset_meta->get_rowset_pb()));
+    LOG(INFO) << "resolve partial update conflicts. tablet=" << full_name()
+              << ", rowset=" << rowset->rowset_id() << ", newer_rowsets=" << newer_rowsets.size()
+              << ", rows=" << num_rows << ", cost(us)=" << watch.get_elapse_time_us();
+    return Status::OK();
+}
+
+Status Tablet::calc_delete_bitmap(RowsetSharedPtr rowset,
+                                  const std::vector<RowsetSharedPtr>& specified_rowsets,
+                                  DeleteBitmapPtr delete_bitmap, int64_t version) {
+    if (rowset->num_segments() == 0) {
+        return Status::OK();
+    }
+    OlapStopWatch watch;
+    std::vector<RowsetKeyLookupContext> ctxs;
+    RETURN_NOT_OK(init_lookup_contexts(specified_rowsets, &ctxs));
+    RowsetKeyLookupContext self;
+    RETURN_NOT_OK(init_lookup_context(rowset, &self));
+
+    const auto& tablet_delete_bitmap = _tablet_meta->delete_bitmap();
+    const RowsetId& rowset_id = rowset->rowset_id();
+    auto& segments = self.segments();
+    uint64_t overwritten_rows = 0;
+    for (uint32_t seg_id = 0; seg_id < segments.size(); ++seg_id) {
+        RETURN_NOT_OK(segments[seg_id]->traverse_primary_keys(
+                [&](uint32_t row_id, const Slice& key) -> Status {
+                    RowLocation loc;
+                    // the same key in the earlier segments of this load is overwritten
+                    for (int prev_seg_id = static_cast<int>(seg_id) - 1; prev_seg_id >= 0;
+                         --prev_seg_id) {
+                        auto st = segments[prev_seg_id]->lookup_row_key(
+                                key, &loc, self.index_iterators[prev_seg_id].get());
+                        if (st.ok()) {
+                            delete_bitmap->add({rowset_id, loc.segment_id, version}, loc.row_id);
+                            ++overwritten_rows;
+                            return Status::OK();
+                        }
+                        if (!st.is_not_found()) {
+                            return st;
+                        }
+                    }
+                    auto st = lookup_row_key_in_contexts(key, ctxs, tablet_delete_bitmap,
+                                                         version - 1, &loc);
+                    if (st.ok()) {
+                        delete_bitmap->add({loc.rowset_id, loc.segment_id, version}, loc.row_id);
+                        ++overwritten_rows;
+                        return Status::OK();
+                    }
+                    return st.is_not_found() ? Status::OK() : st;
+                }));
+    }
+    LOG(INFO) << "calc delete bitmap. tablet=" << full_name() << ", rowset=" << rowset_id
+              << ", version=" << version << ", rows=" << rowset->num_rows()
+              << ", overwritten_rows=" << overwritten_rows
+              << ", cost(us)=" << watch.get_elapse_time_us();
+    return Status::OK();
+}
+
+Status Tablet::update_delete_bitmap_for_compaction(
+        const std::vector<RowsetSharedPtr>& input_rowsets, const RowsetSharedPtr& output_rowset) {
+    // the rows deleted by versions not larger than the output version have been dropped
+    // by compaction, only the later ones need to be transferred to the output rowset
+    std::vector<RowsetId> input_rowset_ids;
+    for (auto& rowset : input_rowsets) {
+        input_rowset_ids.push_back(rowset->rowset_id());
+    }
+    DeleteBitmap input_delete_bitmap = _tablet_meta->delete_bitmap().snapshot(
+            input_rowset_ids, std::numeric_limits<DeleteBitmap::Version>::max());
+    const int64_t output_version = output_rowset->end_version();
+
+    std::map<RowsetId, RowsetSharedPtr> input_rowset_map;
+    for (auto& rowset : input_rowsets) {
+        input_rowset_map.emplace(rowset->rowset_id(), rowset);
+    }
+    std::vector<RowsetKeyLookupContext> output_ctxs;
+    RETURN_NOT_OK(init_lookup_contexts({output_rowset}, &output_ctxs));
+    // The input rowsets with their segments loaded on demand
+    std::map<RowsetId, SegmentCacheHandle> input_segments;
+
+    DeleteBitmap output_delete_bitmap;
+    for (auto& [bmk, bitmap] : input_delete_bitmap.delete_bitmap) {
+        const auto& [rowset_id, segment_id, version] = bmk;
+        if (version <= output_version) {
+            continue;
+        }
+        if (output_ctxs.empty()) {
+            // all rows of input rowsets are deleted
+            break;
+        }
+        auto handle_it = input_segments.find(rowset_id);
+        if (handle_it == input_segments.end()) {
+            SegmentCacheHandle handle;
+            RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+                    std::static_pointer_cast<BetaRowset>(input_rowset_map[rowset_id]), &handle,
+                    true));
+            handle_it = input_segments.emplace(rowset_id, std::move(handle)).first;
+        }
+        auto& segment = handle_it->second.get_segments()[segment_id];
+        for (uint32_t row_id : bitmap) {
+            std::string key;
+            RETURN_NOT_OK(segment->read_key_by_rowid(row_id, &key));
+            RowLocation loc;
+            auto st = lookup_row_key_in_contexts(key, output_ctxs, output_delete_bitmap, 0, &loc);
+            if (st.is_not_found()) {
+                // the row has been deleted by an earlier version, so it is not in the output
+                continue;
+            }
+            RETURN_NOT_OK(st);
+            output_delete_bitmap.add({loc.rowset_id, loc.segment_id, version}, loc.row_id);
+        }
+    }
+    _tablet_meta->delete_bitmap().merge(output_delete_bitmap);
+    LOG(INFO) << "update delete bitmap for compaction. tablet=" << full_name()
+              << ", output_rowset=" << output_rowset->rowset_id()
+              << ", output_version=" << output_rowset->version();
+    return Status::OK();
+}
+
 } // namespace doris
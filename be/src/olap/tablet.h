@@ -38,6 +38,7 @@
 #include "olap/utils.h"
 #include "olap/version_graph.h"
 #include "util/once.h"
+#include "util/slice.h"
 
 namespace doris {
 
@@ -49,6 +50,11 @@ class CumulativeCompaction;
 class BaseCompaction;
 class RowsetWriter;
 struct RowsetWriterContext;
+struct PartialUpdateInfo;
+
+namespace vectorized {
+class IOlapColumnDataAccessor;
+} // namespace vectorized
 
 using TabletSharedPtr = std::shared_ptr<Tablet>;
 
@@ -250,6 +256,23 @@ public:
 
     double calculate_scan_frequency();
 
+    // Records the number of sorted runs merged by a query, i.e. the non-overlapping rowsets
+    // and the segments of the overlapping rowsets read, which is its read amplification.
+    void record_read_amplification(int64_t sorted_runs) {
+        _read_amplification_sum += sorted_runs;
+        _read_amplification_count++;
+        query_scan_sorted_runs->increment(sorted_runs);
+    }
+
+    // Records a scan of the tablet by a query when its scanner is closed.
+    void record_query_scan(int64_t compressed_bytes_read, int64_t raw_rows_read,
+                           const OlapReaderStatistics& stats);
+
+    // The average read amplification of the queries in the current interval of
+    // 'config::tablet_scan_frequency_time_node_interval_second', or in the last interval if no
+    // query yet, 1 if the tablet is not queried in the last interval either.
+    double calculate_read_amplification();
+
     Status prepare_compaction_and_calculate_permits(CompactionType compaction_type,
                                                     TabletSharedPtr tablet, int64_t* permits);
     void execute_compaction(CompactionType compaction_type);
@@ -281,9 +304,18 @@ public:
                                 int64_t newest_write_timestamp,
                                 std::unique_ptr<RowsetWriter>* rowset_writer);
 
-    Status create_rowset_writer(const int64_t& txn_id, const PUniqueId& load_id,
-                                const RowsetStatePB& rowset_state, const SegmentsOverlapPB& overlap,
-                                std::unique_ptr<RowsetWriter>* rowset_writer);
+    // `partial_update_info` is set if the load is a partial update, see PartialUpdateInfo
+    Status create_rowset_writer(
+            const int64_t& txn_id, const PUniqueId& load_id, const RowsetStatePB& rowset_state,
+            const SegmentsOverlapPB& overlap, std::unique_ptr<RowsetWriter>* rowset_writer,
+            std::shared_ptr<PartialUpdateInfo> partial_update_info = nullptr);
+
+    // create a rowset writer for vertical compaction
+    Status create_vertical_rowset_writer(const Version& version, const RowsetStatePB& rowset_state,
+                                         const SegmentsOverlapPB& overlap,
+                                         int64_t oldest_write_timestamp,
+                                         int64_t newest_write_timestamp,
+                                         std::unique_ptr<RowsetWriter>* rowset_writer);
 
     Status create_rowset(RowsetMetaSharedPtr rowset_meta, RowsetSharedPtr* rowset);
     // Cooldown to remote fs.
@@ -298,6 +330,54 @@ public:
     // Physically remove remote rowsets.
     void remove_all_remote_rowsets();
 
+    ////////////////////////////////////////////////////////////////////////////
+    // begin MoW functions
+    ////////////////////////////////////////////////////////////////////////////
+    bool enable_unique_key_merge_on_write() const {
+        return _tablet_meta->enable_unique_key_merge_on_write();
+    }
+
+    // Lookup the row location of `encoded_key`, the function sets `row_location` on success.
+    // NOTE: the method only works in unique key model with primary key index, you will got a
+    //       not supported error in other data model.
+    // `specified_rowsets` should be sorted by version in descending order, rows deleted by
+    // versions not larger than `version` are skipped.
+    Status lookup_row_key(const Slice& encoded_key,
+                          const std::vector<RowsetSharedPtr>& specified_rowsets,
+                          RowLocation* row_location, int64_t version);
+
+    // Gets all the rowsets sorted by version in descending order and the max version of them,
+    // in which the latest rows of the keys of a partial update are looked up.
+    void capture_rowsets_for_lookup(std::vector<RowsetSharedPtr>* rowsets, int64_t* version);
+
+    // Reads the columns `cids` of the visible rows of `encoded_keys` in `specified_rowsets` at
+    // `version`, appending one row for each key to `columns`, which is used to fill the columns
+    // missing in a partial update. The keys not found are appended with default values and
+    // have `found` set to false, so are the keys deleted by the delete sign or by the delete
+    // predicates of `specified_rowsets`, which are evaluated on `key_columns`, the key columns
+    // of the keys in olap format. Same requirements as lookup_row_key().
+    Status read_latest_rows(const std::vector<std::string>& encoded_keys,
+                            const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns,
+                            const std::vector<RowsetSharedPtr>& specified_rowsets,
+                            int64_t version, const std::vector<uint32_t>& cids,
+                            vectorized::MutableColumns* columns, std::vector<bool>* found);
+
+    // Marks the rows in `specified_rowsets` (and the earlier segments of `rowset` itself)
+    // which are overwritten by the keys of `rowset` as deleted at `version`.
+    Status calc_delete_bitmap(RowsetSharedPtr rowset,
+                              const std::vector<RowsetSharedPtr>& specified_rowsets,
+                              DeleteBitmapPtr delete_bitmap, int64_t version);
+
+    // Remaps the rows of `input_rowsets` deleted by versions after `output_rowset` to the
+    // rows of `output_rowset`, called when a compaction of merge-on-write tablet is committed.
+    Status update_delete_bitmap_for_compaction(const std::vector<RowsetSharedPtr>& input_rowsets,
+                                               const RowsetSharedPtr& output_rowset);
+
+    std::mutex& get_rowset_update_lock() { return _rowset_update_lock; }
+    ////////////////////////////////////////////////////////////////////////////
+    // end MoW functions
+    ////////////////////////////////////////////////////////////////////////////
+
 private:
     Status _init_once_action();
     void _print_missed_versions(const std::vector<Version>& missed_versions) const;
@@ -309,6 +389,9 @@ private:
     // max_version: the max version of this tablet
     void _max_continuous_version_from_beginning_unlocked(Version* version, Version* max_version,
                                                          bool* has_version_cross) const;
+    // Merge the column statistics of the visible rowsets into the report,
+    // nothing is reported if any rowset with data has no statistics.
+    void _build_column_statistics_report_unlocked(TTabletInfo* tablet_info) const;
     RowsetSharedPtr _rowset_with_largest_size();
     /// Delete stale rowset by version. This method not only delete the version in expired rowset map,
     /// but also delete the version in rowset meta vector.
@@ -324,6 +407,12 @@ private:
     // in the version tracker is greater than the threshold, rebuild the version tracker
     bool _reconstruct_version_tracker_if_necessary();
     void _init_context_common_fields(RowsetWriterContext& context);
+    Status _add_inc_rowset_with_delete_bitmap(const RowsetSharedPtr& rowset);
+    // The missing columns of a partial update are read from the rowsets visible when the load
+    // starts, the keys whose latest rows are changed by the rowsets published since then are
+    // read again and appended to `rowset` in a new segment, which overwrites the earlier rows.
+    Status _resolve_partial_update_conflicts(
+            const RowsetSharedPtr& rowset, const std::vector<RowsetSharedPtr>& specified_rowsets);
 
 public:
     static const int64_t K_INVALID_CUMULATIVE_POINT = -1;
@@ -340,6 +429,9 @@ private:
     std::mutex _cumulative_compaction_lock;
     std::mutex _schema_change_lock;
     std::shared_mutex _migration_lock;
+    // serializes the updates of delete bitmap and rowsets of merge-on-write tablets,
+    // i.e. publishing a load and committing a compaction
+    std::mutex _rowset_update_lock;
 
     // TODO(lingbin): There is a _meta_lock TabletMeta too, there should be a comment to
     // explain how these two locks work together.
@@ -378,6 +470,13 @@ private:
     // the timestamp of the last record.
     time_t _last_record_scan_count_timestamp;
 
+    // the sum and the number of the read amplifications recorded in the current interval
+    std::atomic<int64_t> _read_amplification_sum {0};
+    std::atomic<int64_t> _read_amplification_count {0};
+    // the average read amplification of the last interval and the time it starts
+    double _last_read_amplification = 1.0;
+    time_t _last_record_read_amplification_timestamp;
+
     std::shared_ptr<CumulativeCompaction> _cumulative_compaction;
     std::shared_ptr<BaseCompaction> _base_compaction;
     // whether clone task occurred during the tablet is in thread pool queue to wait for compaction
@@ -386,12 +485,30 @@ private:
     int64_t _last_missed_version;
     int64_t _last_missed_time_s;
 
+    // The continuous versions computed from the rowset metas, reused until the rowsets change
+    // to avoid sorting all the versions of every tablet in each tablet report.
+    struct ContinuousVersionCache {
+        int64_t rs_metas_version = -1;
+        Version version;
+        Version max_version;
+        bool has_version_cross = false;
+    };
+    mutable std::mutex _continuous_version_cache_lock;
+    mutable ContinuousVersionCache _continuous_version_cache;
+
     DISALLOW_COPY_AND_ASSIGN(Tablet);
 
 public:
     IntCounter* flush_bytes;
     IntCounter* flush_count;
     std::atomic<int64_t> publised_count = 0;
+
+    // the statistics of the queries on the tablet, besides the ones in BaseTablet, to find
+    // the hot tablets and their read amplification
+    IntCounter* query_scan_filtered_rows;
+    IntCounter* query_scan_sorted_runs;
+    IntCounter* query_scan_pages;
+    IntCounter* query_scan_cached_pages;
 };
 
 inline CumulativeCompactionPolicy* Tablet::cumulative_compaction_policy() {
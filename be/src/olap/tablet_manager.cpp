@@ -629,13 +629,15 @@ void TabletManager::find_tablet_have_alpha_rowset(std::vector<TabletSharedPtr>&
 TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
         CompactionType compaction_type, DataDir* data_dir,
         const std::unordered_set<TTabletId>& tablet_submitted_compaction, uint32_t* score,
-        std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy) {
+        std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy,
+        double* read_heat) {
     int64_t now_ms = UnixMillis();
     const string& compaction_type_str =
             compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
     double highest_score = 0.0;
     uint32_t compaction_score = 0;
     double tablet_scan_frequency = 0.0;
+    double tablet_read_heat = 0.0;
     TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rdlock(tablets_shard.lock);
@@ -682,17 +684,24 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
                     compaction_type, cumulative_compaction_policy);
 
             double scan_frequency = 0.0;
-            if (config::compaction_tablet_scan_frequency_factor != 0) {
+            double current_read_heat = 0.0;
+            if (config::compaction_tablet_scan_frequency_factor != 0 ||
+                config::compaction_tablet_read_heat_factor != 0 ||
+                config::compaction_preempt_read_heat_threshold > 0) {
                 scan_frequency = tablet_ptr->calculate_scan_frequency();
+                current_read_heat =
+                        scan_frequency * (tablet_ptr->calculate_read_amplification() - 1.0);
             }
 
             double tablet_score =
                     config::compaction_tablet_scan_frequency_factor * scan_frequency +
-                    config::compaction_tablet_compaction_score_factor * current_compaction_score;
+                    config::compaction_tablet_compaction_score_factor * current_compaction_score +
+                    config::compaction_tablet_read_heat_factor * current_read_heat;
             if (tablet_score > highest_score) {
                 highest_score = tablet_score;
                 compaction_score = current_compaction_score;
                 tablet_scan_frequency = scan_frequency;
+                tablet_read_heat = current_read_heat;
                 best_tablet = tablet_ptr;
             }
         }
@@ -704,8 +713,12 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
                       << ", tablet_id=" << best_tablet->tablet_id() << ", path=" << data_dir->path()
                       << ", compaction_score=" << compaction_score
                       << ", tablet_scan_frequency=" << tablet_scan_frequency
+                      << ", tablet_read_heat=" << tablet_read_heat
                       << ", highest_score=" << highest_score;
         *score = compaction_score;
+        if (read_heat != nullptr) {
+            *read_heat = tablet_read_heat;
+        }
     }
     return best_tablet;
 }
@@ -872,11 +885,20 @@ Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>
     DorisMetrics::instance()->report_all_tablets_requests_total->increment(1);
     HistogramStat tablet_version_num_hist;
     auto local_cache = std::make_shared<std::vector<TTabletStat>>();
+    // Only copy the tablet pointers under the shard locks, the report infos are built outside
+    // so that the creation and dropping of tablets are not blocked by the whole walk.
+    std::vector<TabletSharedPtr> shard_tablets;
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
-        for (const auto& item : tablets_shard.tablet_map) {
-            uint64_t tablet_id = item.first;
-            TabletSharedPtr tablet_ptr = item.second;
+        shard_tablets.clear();
+        {
+            std::shared_lock rdlock(tablets_shard.lock);
+            shard_tablets.reserve(tablets_shard.tablet_map.size());
+            for (const auto& item : tablets_shard.tablet_map) {
+                shard_tablets.push_back(item.second);
+            }
+        }
+        for (const auto& tablet_ptr : shard_tablets) {
+            uint64_t tablet_id = tablet_ptr->tablet_id();
             TTablet t_tablet;
             TTabletInfo tablet_info;
             tablet_ptr->build_tablet_report_info(&tablet_info, true);
@@ -887,9 +909,6 @@ Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>
                 tablet_info.__set_transaction_ids(find->second);
                 expire_txn_map.erase(find);
             }
-            t_tablet.tablet_infos.push_back(tablet_info);
-            tablet_version_num_hist.add(tablet_ptr->version_count());
-            tablets_info->emplace(tablet_id, t_tablet);
             TTabletStat t_tablet_stat;
             t_tablet_stat.__set_tablet_id(tablet_info.tablet_id);
             t_tablet_stat.__set_data_size(tablet_info.data_size);
@@ -897,6 +916,9 @@ Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>
             t_tablet_stat.__set_row_num(tablet_info.row_count);
             t_tablet_stat.__set_version_count(tablet_info.version_count);
             local_cache->emplace_back(std::move(t_tablet_stat));
+            tablet_version_num_hist.add(tablet_info.version_count);
+            t_tablet.tablet_infos.push_back(std::move(tablet_info));
+            tablets_info->emplace(tablet_id, std::move(t_tablet));
         }
     }
     {
@@ -1219,6 +1241,18 @@ void TabletManager::obtain_specific_quantity_tablets(vector<TabletInfo>& tablets
     }
 }
 
+void TabletManager::get_scanned_tablets(std::vector<TabletSharedPtr>* tablets) {
+    for (const auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rdlock(tablets_shard.lock);
+        for (const auto& item : tablets_shard.tablet_map) {
+            const TabletSharedPtr& tablet = item.second;
+            if (tablet != nullptr && tablet->query_scan_count->value() > 0) {
+                tablets->push_back(tablet);
+            }
+        }
+    }
+}
+
 std::shared_mutex& TabletManager::_get_tablets_shard_lock(TTabletId tabletId) {
     return _get_tablets_shard(tabletId).lock;
 }
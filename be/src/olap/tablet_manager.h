@@ -73,7 +73,8 @@ public:
     TabletSharedPtr find_best_tablet_to_compaction(
             CompactionType compaction_type, DataDir* data_dir,
             const std::unordered_set<TTabletId>& tablet_submitted_compaction, uint32_t* score,
-            std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
+            std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy,
+            double* read_heat = nullptr);
 
     TabletSharedPtr get_tablet(TTabletId tablet_id, bool include_deleted = false,
                                std::string* err = nullptr);
@@ -131,6 +132,9 @@ public:
 
     void obtain_specific_quantity_tablets(std::vector<TabletInfo>& tablets_info, int64_t num);
 
+    // Gets the tablets scanned by the queries since the BE started.
+    void get_scanned_tablets(std::vector<TabletSharedPtr>* tablets);
+
     void register_clone_tablet(int64_t tablet_id);
     void unregister_clone_tablet(int64_t tablet_id);
 
@@ -44,11 +44,15 @@ Status TabletMeta::create(const TCreateTabletReq& request, const TabletUid& tabl
             col_ordinal_to_unique_id, tablet_uid,
             request.__isset.tablet_type ? request.tablet_type : TTabletType::TABLET_TYPE_DISK,
             request.storage_medium, request.storage_param.storage_name, request.compression_type,
-            request.storage_policy));
+            request.storage_policy,
+            request.__isset.enable_unique_key_merge_on_write
+                    ? request.enable_unique_key_merge_on_write
+                    : false));
     return Status::OK();
 }
 
-TabletMeta::TabletMeta() : _tablet_uid(0, 0), _schema(new TabletSchema) {}
+TabletMeta::TabletMeta()
+        : _tablet_uid(0, 0), _schema(new TabletSchema), _delete_bitmap(new DeleteBitmap()) {}
 
 TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id,
                        int64_t replica_id, int32_t schema_hash, uint64_t shard_id,
@@ -56,8 +60,9 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
                        const std::unordered_map<uint32_t, uint32_t>& col_ordinal_to_unique_id,
                        TabletUid tablet_uid, TTabletType::type tabletType,
                        TStorageMedium::type t_storage_medium, const std::string& storage_name,
-                       TCompressionType::type compression_type, const std::string& storage_policy)
-        : _tablet_uid(0, 0), _schema(new TabletSchema) {
+                       TCompressionType::type compression_type, const std::string& storage_policy,
+                       bool enable_unique_key_merge_on_write)
+        : _tablet_uid(0, 0), _schema(new TabletSchema), _delete_bitmap(new DeleteBitmap()) {
     TabletMetaPB tablet_meta_pb;
     tablet_meta_pb.set_table_id(table_id);
     tablet_meta_pb.set_partition_id(partition_id);
@@ -76,6 +81,7 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
     tablet_meta_pb.set_storage_medium(fs::fs_util::get_storage_medium_pb(t_storage_medium));
     tablet_meta_pb.set_remote_storage_name(storage_name);
     tablet_meta_pb.set_storage_policy(storage_policy);
+    tablet_meta_pb.set_enable_unique_key_merge_on_write(enable_unique_key_merge_on_write);
     TabletSchemaPB* schema = tablet_meta_pb.mutable_schema();
     schema->set_num_short_key_columns(tablet_schema.short_key_column_count);
     schema->set_num_rows_per_row_block(config::default_num_rows_per_column_file_block);
@@ -157,6 +163,18 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
                         column->set_has_bitmap_index(true);
                         break;
                     }
+                } else if (index.index_type == TIndexType::type::INVERTED) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (iequal(tcolumn.column_name, index.columns[0])) {
+                        column->set_has_inverted_index(true);
+                        break;
+                    }
+                } else if (index.index_type == TIndexType::type::NGRAM_BF) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (iequal(tcolumn.column_name, index.columns[0])) {
+                        column->set_has_ngram_bf_index(true);
+                        break;
+                    }
                 }
             }
         }
@@ -191,13 +209,16 @@ TabletMeta::TabletMeta(const TabletMeta& b)
           _tablet_state(b._tablet_state),
           _schema(b._schema),
           _rs_metas(b._rs_metas),
+          _rs_metas_version(b._rs_metas_version),
           _stale_rs_metas(b._stale_rs_metas),
           _del_pred_array(b._del_pred_array),
           _in_restore_mode(b._in_restore_mode),
           _preferred_rowset_type(b._preferred_rowset_type),
           _remote_storage_name(b._remote_storage_name),
           _storage_medium(b._storage_medium),
-          _cooldown_resource(b._cooldown_resource) {};
+          _cooldown_resource(b._cooldown_resource),
+          _enable_unique_key_merge_on_write(b._enable_unique_key_merge_on_write),
+          _delete_bitmap(new DeleteBitmap(*b._delete_bitmap)) {};
 
 void TabletMeta::_init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn,
                                            ColumnPB* column) {
@@ -438,6 +459,7 @@ void TabletMeta::init_from_pb(const TabletMetaPB& tablet_meta_pb) {
         }
         _rs_metas.push_back(std::move(rs_meta));
     }
+    ++_rs_metas_version;
 
     for (auto& it : tablet_meta_pb.stale_rs_metas()) {
         RowsetMetaSharedPtr rs_meta(new AlphaRowsetMeta());
@@ -456,6 +478,11 @@ void TabletMeta::init_from_pb(const TabletMetaPB& tablet_meta_pb) {
     _remote_storage_name = tablet_meta_pb.remote_storage_name();
     _storage_medium = tablet_meta_pb.storage_medium();
     _cooldown_resource = tablet_meta_pb.storage_policy();
+    _enable_unique_key_merge_on_write = tablet_meta_pb.enable_unique_key_merge_on_write();
+
+    if (tablet_meta_pb.has_delete_bitmap()) {
+        _delete_bitmap->init_from_pb(tablet_meta_pb.delete_bitmap());
+    }
 }
 
 void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
@@ -505,6 +532,11 @@ void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
     tablet_meta_pb->set_remote_storage_name(_remote_storage_name);
     tablet_meta_pb->set_storage_medium(_storage_medium);
     tablet_meta_pb->set_storage_policy(_cooldown_resource);
+    tablet_meta_pb->set_enable_unique_key_merge_on_write(_enable_unique_key_merge_on_write);
+
+    if (_enable_unique_key_merge_on_write) {
+        _delete_bitmap->to_pb(tablet_meta_pb->mutable_delete_bitmap());
+    }
 }
 
 uint32_t TabletMeta::mem_size() const {
@@ -545,6 +577,7 @@ Status TabletMeta::add_rs_meta(const RowsetMetaSharedPtr& rs_meta) {
     }
 
     _rs_metas.push_back(rs_meta);
+    ++_rs_metas_version;
     if (rs_meta->has_delete_predicate()) {
         add_delete_predicate(rs_meta->delete_predicate(), rs_meta->version().first);
     }
@@ -561,6 +594,7 @@ void TabletMeta::delete_rs_meta_by_version(const Version& version,
                 deleted_rs_metas->push_back(*it);
             }
             _rs_metas.erase(it);
+            ++_rs_metas_version;
             return;
         } else {
             ++it;
@@ -593,6 +627,7 @@ void TabletMeta::modify_rs_metas(const std::vector<RowsetMetaSharedPtr>& to_add,
     }
     // put to_add rowsets in _rs_metas.
     _rs_metas.insert(_rs_metas.end(), to_add.begin(), to_add.end());
+    ++_rs_metas_version;
 }
 
 // Use the passing "rs_metas" to replace the rs meta in this tablet meta
@@ -602,6 +637,7 @@ void TabletMeta::modify_rs_metas(const std::vector<RowsetMetaSharedPtr>& to_add,
 void TabletMeta::revise_rs_metas(std::vector<RowsetMetaSharedPtr>&& rs_metas) {
     std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
     _rs_metas = std::move(rs_metas);
+    ++_rs_metas_version;
     _stale_rs_metas.clear();
 }
 
@@ -722,6 +758,7 @@ bool operator==(const TabletMeta& a, const TabletMeta& b) {
     if (a._storage_medium != b._storage_medium) return false;
     if (a._remote_storage_name != b._remote_storage_name) return false;
     if (a._cooldown_resource != b._cooldown_resource) return false;
+    if (a._enable_unique_key_merge_on_write != b._enable_unique_key_merge_on_write) return false;
     return true;
 }
 
@@ -729,4 +766,163 @@ bool operator!=(const TabletMeta& a, const TabletMeta& b) {
     return !(a == b);
 }
 
+DeleteBitmap::DeleteBitmap(const DeleteBitmap& o) {
+    std::shared_lock l(o.lock);
+    delete_bitmap = o.delete_bitmap;
+}
+
+DeleteBitmap& DeleteBitmap::operator=(const DeleteBitmap& o) {
+    if (this == &o) {
+        return *this;
+    }
+    std::map<BitmapKey, roaring::Roaring> copied;
+    {
+        std::shared_lock l(o.lock);
+        copied = o.delete_bitmap;
+    }
+    std::lock_guard l(lock);
+    delete_bitmap = std::move(copied);
+    return *this;
+}
+
+DeleteBitmap DeleteBitmap::snapshot(const std::vector<RowsetId>& rowset_ids,
+                                    Version max_version) const {
+    DeleteBitmap dbm;
+    std::shared_lock l(lock);
+    for (auto& rowset_id : rowset_ids) {
+        for (auto it = delete_bitmap.lower_bound({rowset_id, 0, 0});
+             it != delete_bitmap.end() && std::get<0>(it->first) == rowset_id; ++it) {
+            if (std::get<2>(it->first) <= max_version) {
+                dbm.delete_bitmap.emplace(it->first, it->second);
+            }
+        }
+    }
+    return dbm;
+}
+
+void DeleteBitmap::add(const BitmapKey& bmk, uint32_t row_id) {
+    std::lock_guard l(lock);
+    delete_bitmap[bmk].add(row_id);
+}
+
+bool DeleteBitmap::remove(const BitmapKey& bmk, uint32_t row_id) {
+    std::lock_guard l(lock);
+    auto it = delete_bitmap.find(bmk);
+    if (it == delete_bitmap.end()) {
+        return false;
+    }
+    return it->second.removeChecked(row_id);
+}
+
+void DeleteBitmap::remove(const BitmapKey& start, const BitmapKey& end) {
+    std::lock_guard l(lock);
+    for (auto it = delete_bitmap.lower_bound(start); it != delete_bitmap.end();) {
+        if (!(it->first < end)) {
+            break;
+        }
+        it = delete_bitmap.erase(it);
+    }
+}
+
+bool DeleteBitmap::contains(const BitmapKey& bmk, uint32_t row_id) const {
+    std::shared_lock l(lock);
+    auto it = delete_bitmap.find(bmk);
+    return it != delete_bitmap.end() && it->second.contains(row_id);
+}
+
+bool DeleteBitmap::contains_agg(const BitmapKey& bmk, uint32_t row_id) const {
+    std::shared_lock l(lock);
+    const auto& [rowset_id, segment_id, version] = bmk;
+    for (auto it = delete_bitmap.lower_bound({rowset_id, segment_id, 0});
+         it != delete_bitmap.end() && std::get<0>(it->first) == rowset_id &&
+         std::get<1>(it->first) == segment_id && std::get<2>(it->first) <= version;
+         ++it) {
+        if (it->second.contains(row_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DeleteBitmap::set(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap) {
+    std::lock_guard l(lock);
+    delete_bitmap[bmk] = segment_delete_bitmap;
+}
+
+Status DeleteBitmap::get(const BitmapKey& bmk, roaring::Roaring* segment_delete_bitmap) const {
+    std::shared_lock l(lock);
+    auto it = delete_bitmap.find(bmk);
+    if (it == delete_bitmap.end()) {
+        return Status::NotFound("delete bitmap not found");
+    }
+    *segment_delete_bitmap = it->second; // copy
+    return Status::OK();
+}
+
+std::shared_ptr<roaring::Roaring> DeleteBitmap::get_agg(const BitmapKey& bmk) const {
+    auto result = std::make_shared<roaring::Roaring>();
+    std::shared_lock l(lock);
+    const auto& [rowset_id, segment_id, version] = bmk;
+    for (auto it = delete_bitmap.lower_bound({rowset_id, segment_id, 0});
+         it != delete_bitmap.end() && std::get<0>(it->first) == rowset_id &&
+         std::get<1>(it->first) == segment_id && std::get<2>(it->first) <= version;
+         ++it) {
+        *result |= it->second;
+    }
+    return result;
+}
+
+void DeleteBitmap::merge(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap) {
+    std::lock_guard l(lock);
+    delete_bitmap[bmk] |= segment_delete_bitmap;
+}
+
+void DeleteBitmap::merge(const DeleteBitmap& other) {
+    if (this == &other) {
+        return;
+    }
+    std::lock_guard l(lock);
+    std::shared_lock ol(other.lock);
+    for (auto& [bmk, bitmap] : other.delete_bitmap) {
+        delete_bitmap[bmk] |= bitmap;
+    }
+}
+
+void DeleteBitmap::remove_rowset(const RowsetId& rowset_id) {
+    std::lock_guard l(lock);
+    for (auto it = delete_bitmap.lower_bound({rowset_id, 0, 0});
+         it != delete_bitmap.end() && std::get<0>(it->first) == rowset_id;) {
+        it = delete_bitmap.erase(it);
+    }
+}
+
+void DeleteBitmap::to_pb(DeleteBitmapPB* delete_bitmap_pb) const {
+    std::shared_lock l(lock);
+    for (auto& [bmk, bitmap] : delete_bitmap) {
+        delete_bitmap_pb->add_rowset_ids(std::get<0>(bmk).to_string());
+        delete_bitmap_pb->add_segment_ids(std::get<1>(bmk));
+        delete_bitmap_pb->add_versions(std::get<2>(bmk));
+        std::string bitmap_data(bitmap.getSizeInBytes(), '\0');
+        bitmap.write(bitmap_data.data());
+        *(delete_bitmap_pb->add_segment_delete_bitmaps()) = std::move(bitmap_data);
+    }
+}
+
+void DeleteBitmap::init_from_pb(const DeleteBitmapPB& delete_bitmap_pb) {
+    int rst_ids_size = delete_bitmap_pb.rowset_ids_size();
+    int seg_ids_size = delete_bitmap_pb.segment_ids_size();
+    int versions_size = delete_bitmap_pb.versions_size();
+    int seg_maps_size = delete_bitmap_pb.segment_delete_bitmaps_size();
+    CHECK(rst_ids_size == seg_ids_size && seg_ids_size == seg_maps_size &&
+          seg_maps_size == versions_size);
+    std::lock_guard l(lock);
+    delete_bitmap.clear();
+    for (int i = 0; i < rst_ids_size; ++i) {
+        RowsetId rst_id;
+        rst_id.init(delete_bitmap_pb.rowset_ids(i));
+        delete_bitmap[{rst_id, delete_bitmap_pb.segment_ids(i), delete_bitmap_pb.versions(i)}] =
+                roaring::Roaring::read(delete_bitmap_pb.segment_delete_bitmaps(i).data());
+    }
+}
+
 } // namespace doris
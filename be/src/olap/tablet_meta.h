@@ -18,9 +18,12 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <mutex>
+#include <roaring/roaring.hh>
 #include <shared_mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "common/logging.h"
@@ -67,7 +70,9 @@ class RowsetMeta;
 class Rowset;
 class DataDir;
 class TabletMeta;
+class DeleteBitmap;
 using TabletMetaSharedPtr = std::shared_ptr<TabletMeta>;
+using DeleteBitmapPtr = std::shared_ptr<DeleteBitmap>;
 
 // Class encapsulates meta of tablet.
 // The concurrency control is handled in Tablet Class, not in this class.
@@ -88,7 +93,8 @@ public:
                TabletUid tablet_uid, TTabletType::type tabletType,
                TStorageMedium::type t_storage_medium, const std::string& remote_storage_name,
                TCompressionType::type compression_type,
-               const std::string& storage_policy = std::string());
+               const std::string& storage_policy = std::string(),
+               bool enable_unique_key_merge_on_write = false);
     // If need add a filed in TableMeta, filed init copy in copy construct function
     TabletMeta(const TabletMeta& tablet_meta);
     TabletMeta(TabletMeta&& tablet_meta) = delete;
@@ -148,6 +154,9 @@ public:
     TabletSchema* mutable_tablet_schema();
 
     const std::vector<RowsetMetaSharedPtr>& all_rs_metas() const;
+    // bumped whenever the set of visible rowsets changes, so that the results derived from
+    // all_rs_metas() can be cached
+    int64_t rs_metas_version() const { return _rs_metas_version; }
     Status add_rs_meta(const RowsetMetaSharedPtr& rs_meta);
     void delete_rs_meta_by_version(const Version& version,
                                    std::vector<RowsetMetaSharedPtr>* deleted_rs_metas);
@@ -199,6 +208,11 @@ public:
         _cooldown_resource = std::move(resource);
     }
 
+    bool enable_unique_key_merge_on_write() const { return _enable_unique_key_merge_on_write; }
+
+    // Only meaningful for unique key tablets with merge-on-write enabled.
+    DeleteBitmap& delete_bitmap() { return *_delete_bitmap; }
+
 private:
     Status _save_meta(DataDir* data_dir);
     void _init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn, ColumnPB* column);
@@ -225,6 +239,7 @@ private:
     std::shared_ptr<TabletSchema> _schema;
 
     std::vector<RowsetMetaSharedPtr> _rs_metas;
+    int64_t _rs_metas_version = 0;
     // This variable _stale_rs_metas is used to record these rowsets‘ meta which are be compacted.
     // These stale rowsets meta are been removed when rowsets' pathVersion is expired,
     // this policy is judged and computed by TimestampedVersionTracker.
@@ -239,9 +254,87 @@ private:
     // FIXME(cyx): Currently `cooldown_resource` is equivalent to `storage_policy`.
     io::ResourceId _cooldown_resource;
 
+    // For unique key data model, the feature Merge-on-Write will leverage a primary
+    // key index and a delete-bitmap to mark duplicate keys as deleted in load stage,
+    // which can avoid the merging cost in read stage, and accelerate the aggregation
+    // query performance significantly.
+    bool _enable_unique_key_merge_on_write = false;
+    std::shared_ptr<DeleteBitmap> _delete_bitmap;
+
     mutable std::shared_mutex _meta_lock;
 };
 
+/**
+ * Wraps multiple bitmaps for recording rows (row id) that are deleted or
+ * overwritten.
+ *
+ * RowsetId and SegmentId are for locating segment, Version here is a single
+ * uint32_t means that at which "version" of the load causes the delete or
+ * overwrite.
+ *
+ * The start and end version of a load is the same, it's ok and straightforward
+ * to use a single uint32_t.
+ *
+ * e.g.
+ * There is a key "key1" in rowset id 1, version [1,1], segment id 1, row id 1.
+ * A new load also contains "key1", the rowset id 2, version [2,2], segment id 1
+ * the delete bitmap will be `{1,1,2} -> 1`, which means the "row id 1" in
+ * "rowset id 1, segment id 1" is deleted/overwritten by some loads at "version 2"
+ */
+class DeleteBitmap {
+public:
+    mutable std::shared_mutex lock;
+    using SegmentId = uint32_t;
+    using Version = uint64_t;
+    using BitmapKey = std::tuple<RowsetId, SegmentId, Version>;
+    std::map<BitmapKey, roaring::Roaring> delete_bitmap; // Ordered map
+
+    DeleteBitmap() = default;
+    DeleteBitmap(const DeleteBitmap& r);
+    DeleteBitmap& operator=(const DeleteBitmap& r);
+
+    // Makes a snapshot of the bitmaps of the given rowsets with version not
+    // larger than `max_version`.
+    DeleteBitmap snapshot(const std::vector<RowsetId>& rowset_ids, Version max_version) const;
+
+    // Marks the specific row deleted
+    void add(const BitmapKey& bmk, uint32_t row_id);
+
+    // Clears the deletion mark of the specific row, returns true if the row was marked
+    bool remove(const BitmapKey& bmk, uint32_t row_id);
+
+    // Removes bitmaps in range [lower_key, upper_key)
+    void remove(const BitmapKey& lower_key, const BitmapKey& upper_key);
+
+    // Checks if the given row is marked deleted
+    bool contains(const BitmapKey& bmk, uint32_t row_id) const;
+
+    // Checks if the given row is marked deleted by any version not larger
+    // than the version of `bmk`
+    bool contains_agg(const BitmapKey& bmk, uint32_t row_id) const;
+
+    // Sets the bitmap of specific segment, it may overwrite the origin one
+    void set(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap);
+
+    // Gets a copy of the bitmap of specific segment and version, returns NotFound
+    // if there is no such bitmap
+    Status get(const BitmapKey& bmk, roaring::Roaring* segment_delete_bitmap) const;
+
+    // Merges all bitmaps of the segment with version not larger than the version
+    // of `bmk`, returns an empty bitmap if nothing was deleted
+    std::shared_ptr<roaring::Roaring> get_agg(const BitmapKey& bmk) const;
+
+    // Merges the given delete bitmap into this one
+    void merge(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap);
+    void merge(const DeleteBitmap& other);
+
+    // Removes all bitmaps of the given rowset
+    void remove_rowset(const RowsetId& rowset_id);
+
+    void to_pb(DeleteBitmapPB* delete_bitmap_pb) const;
+    void init_from_pb(const DeleteBitmapPB& delete_bitmap_pb);
+};
+
 static const std::string SEQUENCE_COL = "__DORIS_SEQUENCE_COL__";
 
 inline TabletUid TabletMeta::tablet_uid() const {
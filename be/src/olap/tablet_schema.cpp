@@ -333,6 +333,8 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     } else {
         _has_bitmap_index = false;
     }
+    _has_inverted_index = column.has_inverted_index();
+    _has_ngram_bf_index = column.has_ngram_bf_index();
     _has_referenced_column = column.has_referenced_column_id();
     if (_has_referenced_column) {
         _referenced_column_id = column.referenced_column_id();
@@ -376,6 +378,12 @@ void TabletColumn::to_schema_pb(ColumnPB* column) {
     if (_has_bitmap_index) {
         column->set_has_bitmap_index(_has_bitmap_index);
     }
+    if (_has_inverted_index) {
+        column->set_has_inverted_index(_has_inverted_index);
+    }
+    if (_has_ngram_bf_index) {
+        column->set_has_ngram_bf_index(_has_ngram_bf_index);
+    }
     column->set_visible(_visible);
 
     if (_type == OLAP_FIELD_TYPE_ARRAY) {
@@ -570,6 +578,8 @@ bool operator==(const TabletColumn& a, const TabletColumn& b) {
         if (a._referenced_column != b._referenced_column) return false;
     }
     if (a._has_bitmap_index != b._has_bitmap_index) return false;
+    if (a._has_inverted_index != b._has_inverted_index) return false;
+    if (a._has_ngram_bf_index != b._has_ngram_bf_index) return false;
     return true;
 }
 
@@ -50,6 +50,8 @@ public:
     bool is_nullable() const { return _is_nullable; }
     bool is_bf_column() const { return _is_bf_column; }
     bool has_bitmap_index() const { return _has_bitmap_index; }
+    bool has_inverted_index() const { return _has_inverted_index; }
+    bool has_ngram_bf_index() const { return _has_ngram_bf_index; }
     bool is_length_variable_type() const {
         return _type == OLAP_FIELD_TYPE_CHAR || _type == OLAP_FIELD_TYPE_VARCHAR ||
                _type == OLAP_FIELD_TYPE_STRING || _type == OLAP_FIELD_TYPE_HLL ||
@@ -109,6 +111,8 @@ private:
     std::string _referenced_column;
 
     bool _has_bitmap_index = false;
+    bool _has_inverted_index = false;
+    bool _has_ngram_bf_index = false;
     bool _visible = true;
 
     TabletColumn* _parent = nullptr;
@@ -17,7 +17,10 @@
 
 #include "olap/task/engine_clone_task.h"
 
+#include <atomic>
+#include <mutex>
 #include <set>
+#include <thread>
 
 #include "env/env.h"
 #include "gen_cpp/BackendService.h"
@@ -26,6 +29,7 @@
 #include "gutil/strings/stringpiece.h"
 #include "gutil/strings/substitute.h"
 #include "http/http_client.h"
+#include "io/fs/io_limiter.h"
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_factory.h"
 #include "olap/snapshot_manager.h"
@@ -65,6 +69,7 @@ EngineCloneTask::EngineCloneTask(const TCloneReq& clone_req, const TMasterInfo&
 Status EngineCloneTask::execute() {
     // register the tablet to avoid it is deleted by gc thread during clone process
     SCOPED_ATTACH_TASK_THREAD(ThreadContext::TaskType::STORAGE, _mem_tracker);
+    io::IOLimiter::Scope io_limiter_scope;
     StorageEngine::instance()->tablet_manager()->register_clone_tablet(_clone_req.tablet_id);
     Status st = _do_clone();
     StorageEngine::instance()->tablet_manager()->unregister_clone_tablet(_clone_req.tablet_id);
@@ -445,19 +450,21 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     // If the header file is not exist, the table couldn't loaded by olap engine.
     // Avoid of data is not complete, we copy the header file at last.
     // The header file's name is end of .hdr.
-    for (int i = 0; i < file_name_list.size() - 1; ++i) {
+    size_t data_file_num = file_name_list.size();
+    for (int i = 0; i < file_name_list.size(); ++i) {
         StringPiece sp(file_name_list[i]);
         if (sp.ends_with(".hdr")) {
             std::swap(file_name_list[i], file_name_list[file_name_list.size() - 1]);
+            --data_file_num;
             break;
         }
     }
 
     // Get copy from remote
-    uint64_t total_file_size = 0;
+    std::atomic<uint64_t> total_file_size = 0;
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
+    auto download_file = [&](const std::string& file_name) {
         auto remote_file_url = remote_url_prefix + file_name;
 
         // get file length
@@ -488,11 +495,22 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
                   << " to: " << local_file_path << ". size(B): " << file_size
                   << ", timeout(s): " << estimate_timeout;
 
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path,
-                            file_size](HttpClient* client) {
+        // a failed download is resumed from the downloaded part at the next retry, and is
+        // restarted if resuming fails too, e.g. the remote BE doesn't support range requests.
+        bool resume = false;
+        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size,
+                            &resume](HttpClient* client) {
             RETURN_IF_ERROR(client->init(remote_file_url));
             client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
+            Status st = client->download(local_file_path, resume);
+            if (!st.ok()) {
+                if (resume) {
+                    std::error_code ec;
+                    std::filesystem::remove(local_file_path, ec);
+                }
+                resume = !resume;
+                return st;
+            }
 
             // Check file length
             uint64_t local_file_size = std::filesystem::file_size(local_file_path);
@@ -500,24 +518,64 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
                 LOG(WARNING) << "download file length error"
                              << ", remote_path=" << remote_file_url << ", file_size=" << file_size
                              << ", local_file_size=" << local_file_size;
+                resume = false;
                 return Status::InternalError("downloaded file size is not equal");
             }
             chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
             return Status::OK();
         };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
-    } // Clone files from remote backend
+        return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+    };
+
+    // Clone the data files from remote backend in parallel
+    std::atomic<size_t> next_file = 0;
+    std::mutex status_lock;
+    Status download_status = Status::OK();
+    auto download_worker = [&]() {
+        io::IOLimiter::Scope io_limiter_scope;
+        while (true) {
+            {
+                std::lock_guard l(status_lock);
+                if (!download_status.ok()) {
+                    return;
+                }
+            }
+            size_t i = next_file++;
+            if (i >= data_file_num) {
+                return;
+            }
+            Status st = download_file(file_name_list[i]);
+            if (!st.ok()) {
+                std::lock_guard l(status_lock);
+                download_status = st;
+                return;
+            }
+        }
+    };
+    int concurrency = std::max(config::clone_download_concurrency, 1);
+    std::vector<std::thread> download_threads;
+    for (int i = 1; i < concurrency && i < data_file_num; ++i) {
+        download_threads.emplace_back(download_worker);
+    }
+    download_worker();
+    for (auto& thread : download_threads) {
+        thread.join();
+    }
+    RETURN_IF_ERROR(download_status);
+    if (data_file_num < file_name_list.size()) {
+        RETURN_IF_ERROR(download_file(file_name_list.back()));
+    }
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
     double copy_rate = 0.0;
     if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+        copy_rate = total_file_size.load() / ((double)total_time_ms) / 1000;
     }
-    _copy_size = (int64_t)total_file_size;
+    _copy_size = (int64_t)total_file_size.load();
     _copy_time_ms = (int64_t)total_time_ms;
-    LOG(INFO) << "succeed to copy tablet " << _signature << ", total file size: " << total_file_size
-              << " B"
+    LOG(INFO) << "succeed to copy tablet " << _signature
+              << ", total file size: " << total_file_size.load() << " B"
               << ", cost: " << total_time_ms << " ms"
               << ", rate: " << copy_rate << " MB/s";
     return Status::OK();
@@ -22,6 +22,7 @@
 #include "olap/data_dir.h"
 #include "olap/rowset/rowset_meta_manager.h"
 #include "olap/tablet_manager.h"
+#include "util/threadpool.h"
 
 namespace doris {
 
@@ -58,9 +59,9 @@ Status EnginePublishVersionTask::finish() {
 
         Version version(par_ver_info.version, par_ver_info.version);
 
-        // each tablet
+        // group the tablets by data dir, the rowset metas of a data dir are saved at once
+        map<DataDir*, std::vector<std::pair<TabletSharedPtr, RowsetSharedPtr>>> data_dir_tablets;
         for (auto& tablet_rs : tablet_related_rs) {
-            Status publish_status = Status::OK();
             TabletInfo tablet_info = tablet_rs.first;
             RowsetSharedPtr rowset = tablet_rs.second;
             VLOG_CRITICAL << "begin to publish version on tablet. "
@@ -86,33 +87,71 @@ Status EnginePublishVersionTask::finish() {
                 res = Status::OLAPInternalError(OLAP_ERR_PUSH_TABLE_NOT_EXIST);
                 continue;
             }
+            data_dir_tablets[tablet->data_dir()].emplace_back(std::move(tablet), rowset);
+        }
 
-            publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
-                    partition_id, tablet, transaction_id, version);
-            if (publish_status != Status::OK()) {
-                LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
-                             << ", tablet_id=" << tablet_info.tablet_id
-                             << ", txn_id=" << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = publish_status;
-                continue;
+        std::vector<std::pair<TabletSharedPtr, RowsetSharedPtr>> published_tablets;
+        for (auto& [data_dir, tablets] : data_dir_tablets) {
+            std::vector<TabletInfo> tablet_infos;
+            for (auto& [tablet, rowset] : tablets) {
+                tablet_infos.push_back(tablet->get_tablet_info());
             }
+            std::vector<Status> publish_results;
+            StorageEngine::instance()->txn_manager()->publish_txn(
+                    data_dir->get_meta(), partition_id, transaction_id, tablet_infos, version,
+                    &publish_results);
+            for (size_t i = 0; i < tablets.size(); ++i) {
+                if (!publish_results[i].ok()) {
+                    LOG(WARNING) << "failed to publish version. rowset_id="
+                                 << tablets[i].second->rowset_id()
+                                 << ", tablet_id=" << tablet_infos[i].tablet_id
+                                 << ", txn_id=" << transaction_id;
+                    _error_tablet_ids->push_back(tablet_infos[i].tablet_id);
+                    res = publish_results[i];
+                    continue;
+                }
+                published_tablets.push_back(std::move(tablets[i]));
+            }
+        }
 
-            // add visible rowset to tablet
-            publish_status = tablet->add_inc_rowset(rowset);
+        // add visible rowset to tablet, which may calculate the delete bitmap of the rowset,
+        // so the tablets are done in parallel
+        std::vector<Status> add_results(published_tablets.size());
+        auto add_inc_rowset = [&published_tablets, &add_results](size_t i) {
+            auto& [tablet, rowset] = published_tablets[i];
+            add_results[i] = tablet->add_inc_rowset(rowset);
+        };
+        ThreadPool* thread_pool = StorageEngine::instance()->publish_version_thread_pool();
+        if (thread_pool != nullptr && published_tablets.size() > 1) {
+            auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+            for (size_t i = 0; i < published_tablets.size(); ++i) {
+                if (!token->submit_func([&add_inc_rowset, i]() { add_inc_rowset(i); }).ok()) {
+                    add_inc_rowset(i);
+                }
+            }
+            token->wait();
+        } else {
+            for (size_t i = 0; i < published_tablets.size(); ++i) {
+                add_inc_rowset(i);
+            }
+        }
+
+        for (size_t i = 0; i < published_tablets.size(); ++i) {
+            auto& [tablet, rowset] = published_tablets[i];
+            Status publish_status = add_results[i];
             if (publish_status != Status::OK() &&
                 publish_status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
                 LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id="
-                             << rowset->rowset_id() << ", tablet_id=" << tablet_info.tablet_id
+                             << rowset->rowset_id() << ", tablet_id=" << tablet->tablet_id()
                              << ", txn_id=" << transaction_id << ", res=" << publish_status;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
+                _error_tablet_ids->push_back(tablet->tablet_id());
                 res = publish_status;
                 continue;
             }
             if (_succ_tablet_ids != nullptr) {
-                _succ_tablet_ids->push_back(tablet_info.tablet_id);
+                _succ_tablet_ids->push_back(tablet->tablet_id());
             }
-            partition_related_tablet_infos.erase(tablet_info);
+            partition_related_tablet_infos.erase(tablet->get_tablet_info());
             VLOG_NOTICE << "publish version successfully on tablet. tablet=" << tablet->full_name()
                         << ", transaction_id=" << transaction_id << ", version=" << version.first
                         << ", res=" << publish_status;
@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/task/engine_pull_rowset_task.h"
+
+#include <sys/stat.h>
+
+#include <filesystem>
+
+#include "http/http_client.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_meta.h"
+
+namespace doris {
+
+const uint32_t PULL_ROWSET_MAX_RETRY = 3;
+
+EnginePullRowsetTask::EnginePullRowsetTask(const PTabletPullRowsetRequest& request)
+        : _request(request) {}
+
+Status EnginePullRowsetTask::execute() {
+    const RowsetMetaPB& rowset_meta_pb = _request.rowset_meta();
+    TabletSharedPtr tablet =
+            StorageEngine::instance()->tablet_manager()->get_tablet(rowset_meta_pb.tablet_id());
+    if (tablet == nullptr) {
+        return Status::InternalError(
+                fmt::format("tablet {} not found", rowset_meta_pb.tablet_id()));
+    }
+    auto rowset_meta = std::make_shared<RowsetMeta>();
+    if (!rowset_meta->init_from_pb(rowset_meta_pb)) {
+        return Status::InternalError(
+                fmt::format("invalid rowset meta of tablet {}", tablet->tablet_id()));
+    }
+    RowsetId remote_rowset_id = rowset_meta->rowset_id();
+    RowsetId rowset_id = StorageEngine::instance()->next_rowset_id();
+    rowset_meta->set_rowset_id(rowset_id);
+    rowset_meta->set_tablet_uid(tablet->tablet_uid());
+
+    {
+        std::shared_lock migration_rlock(tablet->get_migration_lock(), std::try_to_lock);
+        if (!migration_rlock.owns_lock()) {
+            return Status::OLAPInternalError(OLAP_ERR_RWLOCK_ERROR);
+        }
+        std::lock_guard<std::mutex> push_lock(tablet->get_push_lock());
+        RETURN_NOT_OK(StorageEngine::instance()->txn_manager()->prepare_txn(
+                _request.partition_id(), tablet, _request.txn_id(), _request.load_id()));
+    }
+
+    std::vector<std::string> local_files;
+    Status st = Status::OK();
+    for (const auto& [segment_id, file_size] : _request.segments_size()) {
+        if (tablet->data_dir()->reach_capacity_limit(file_size)) {
+            st = Status::InternalError("Disk reach capacity limit");
+            break;
+        }
+        std::string remote_file_url = fmt::format(
+                "http://{}:{}/api/_tablet/_download?token={}&file={}", _request.host(),
+                _request.http_port(), _request.token(),
+                BetaRowset::local_segment_path(_request.tablet_path(), remote_rowset_id,
+                                               segment_id));
+        local_files.push_back(
+                BetaRowset::local_segment_path(tablet->tablet_path(), rowset_id, segment_id));
+        st = _download_file(remote_file_url, local_files.back(), file_size);
+        if (!st.ok()) {
+            break;
+        }
+    }
+
+    RowsetSharedPtr rowset;
+    if (st.ok()) {
+        st = RowsetFactory::create_rowset(&tablet->tablet_schema(), tablet->tablet_path(),
+                                          rowset_meta, &rowset);
+    }
+    if (st.ok()) {
+        st = StorageEngine::instance()->txn_manager()->commit_txn(
+                _request.partition_id(), tablet, _request.txn_id(), _request.load_id(), rowset,
+                false);
+        if (st == Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
+            st = Status::OK();
+        }
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to pull rowset " << remote_rowset_id << " of tablet "
+                     << tablet->tablet_id() << " from " << _request.host()
+                     << ", txn_id=" << _request.txn_id() << ": " << st;
+        for (const auto& local_file : local_files) {
+            std::error_code ec;
+            std::filesystem::remove(local_file, ec);
+        }
+        return st;
+    }
+    LOG(INFO) << "pulled rowset " << remote_rowset_id << " of tablet " << tablet->tablet_id()
+              << " from " << _request.host() << " as " << rowset_id
+              << ", txn_id=" << _request.txn_id();
+    return Status::OK();
+}
+
+Status EnginePullRowsetTask::_download_file(const std::string& remote_file_url,
+                                            const std::string& local_file_path,
+                                            uint64_t file_size) {
+    uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
+    if (estimate_timeout < config::download_low_speed_time) {
+        estimate_timeout = config::download_low_speed_time;
+    }
+    auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path,
+                        file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(estimate_timeout * 1000);
+        RETURN_IF_ERROR(client->download(local_file_path));
+
+        // Check file length
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+        if (local_file_size != file_size) {
+            LOG(WARNING) << "download file length error"
+                         << ", remote_path=" << remote_file_url << ", file_size=" << file_size
+                         << ", local_file_size=" << local_file_size;
+            return Status::InternalError("downloaded file size is not equal");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(PULL_ROWSET_MAX_RETRY, 1, download_cb);
+}
+
+} // namespace doris
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef DORIS_BE_SRC_OLAP_TASK_ENGINE_PULL_ROWSET_TASK_H
+#define DORIS_BE_SRC_OLAP_TASK_ENGINE_PULL_ROWSET_TASK_H
+
+#include "gen_cpp/internal_service.pb.h"
+#include "olap/task/engine_task.h"
+
+namespace doris {
+
+// Pulls the rowset of a load from the replica which wrote it, for single replica load.
+// The segment files are downloaded into the tablet with a new rowset id, and the rowset is
+// committed to the txn the same as the rowset built by DeltaWriter.
+class EnginePullRowsetTask : public EngineTask {
+public:
+    virtual Status execute();
+
+public:
+    EnginePullRowsetTask(const PTabletPullRowsetRequest& request);
+
+    ~EnginePullRowsetTask() {}
+
+private:
+    Status _download_file(const std::string& remote_file_url, const std::string& local_file_path,
+                          uint64_t file_size);
+
+private:
+    const PTabletPullRowsetRequest& _request;
+}; // EngineTask
+
+} // namespace doris
+#endif //DORIS_BE_SRC_OLAP_TASK_ENGINE_PULL_ROWSET_TASK_H
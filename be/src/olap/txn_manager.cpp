@@ -313,6 +313,71 @@ Status TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id,
     }
 }
 
+void TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id,
+                             TTransactionId transaction_id,
+                             const std::vector<TabletInfo>& tablet_infos, const Version& version,
+                             std::vector<Status>* results) {
+    pair<int64_t, int64_t> key(partition_id, transaction_id);
+    results->assign(tablet_infos.size(), Status::OK());
+    std::vector<RowsetSharedPtr> rowsets(tablet_infos.size());
+    std::unique_lock<std::mutex> txn_lock(_get_txn_lock(transaction_id));
+    {
+        std::shared_lock rlock(_get_txn_map_lock(transaction_id));
+        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+        auto it = txn_tablet_map.find(key);
+        if (it != txn_tablet_map.end()) {
+            for (size_t i = 0; i < tablet_infos.size(); ++i) {
+                auto load_itr = it->second.find(tablet_infos[i]);
+                if (load_itr != it->second.end()) {
+                    rowsets[i] = load_itr->second.rowset;
+                }
+            }
+        }
+    }
+    std::vector<std::pair<TabletUid, RowsetMetaSharedPtr>> rowset_metas;
+    for (size_t i = 0; i < tablet_infos.size(); ++i) {
+        if (rowsets[i] == nullptr) {
+            (*results)[i] = Status::OLAPInternalError(OLAP_ERR_TRANSACTION_NOT_EXIST);
+            continue;
+        }
+        rowsets[i]->make_visible(version);
+        rowset_metas.emplace_back(tablet_infos[i].tablet_uid, rowsets[i]->rowset_meta());
+    }
+    // save meta need access disk, it maybe very slow, so that it is not in global txn lock,
+    // and the metas of all the tablets are saved at once.
+    Status save_status = RowsetMetaManager::save(meta, rowset_metas);
+    if (!save_status.ok()) {
+        LOG(WARNING) << "save committed rowsets failed. when publish txn, tablet num: "
+                     << rowset_metas.size() << ", txn id:" << transaction_id;
+        for (size_t i = 0; i < tablet_infos.size(); ++i) {
+            if (rowsets[i] != nullptr) {
+                (*results)[i] = Status::OLAPInternalError(OLAP_ERR_ROWSET_SAVE_FAILED);
+            }
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::shared_mutex> wrlock(_get_txn_map_lock(transaction_id));
+        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+        auto it = txn_tablet_map.find(key);
+        if (it != txn_tablet_map.end()) {
+            for (size_t i = 0; i < tablet_infos.size(); ++i) {
+                if (rowsets[i] != nullptr) {
+                    it->second.erase(tablet_infos[i]);
+                }
+            }
+            VLOG_NOTICE << "publish txn successfully."
+                        << " partition_id: " << key.first << ", txn_id: " << key.second
+                        << ", tablet num: " << rowset_metas.size() << ", version: " << version.first
+                        << "," << version.second;
+            if (it->second.empty()) {
+                txn_tablet_map.erase(it);
+                _clear_txn_partition_map_unlocked(transaction_id, partition_id);
+            }
+        }
+    }
+}
+
 // txn could be rollbacked if it does not have related rowset
 // if the txn has related rowset then could not rollback it, because it
 // may be committed in another thread and our current thread meets errors when writing to data file
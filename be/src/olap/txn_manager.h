@@ -104,6 +104,12 @@ public:
                        TTabletId tablet_id, SchemaHash schema_hash, TabletUid tablet_uid,
                        const Version& version);
 
+    // publish the txn on the tablets of the same data dir, whose rowset metas are saved in one
+    // write batch. `results` is the status of each tablet.
+    void publish_txn(OlapMeta* meta, TPartitionId partition_id, TTransactionId transaction_id,
+                     const std::vector<TabletInfo>& tablet_infos, const Version& version,
+                     std::vector<Status>* results);
+
     // delete the txn from manager if it is not committed(not have a valid rowset)
     Status rollback_txn(TPartitionId partition_id, TTransactionId transaction_id,
                         TTabletId tablet_id, SchemaHash schema_hash, TabletUid tablet_uid);
@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/operator.h"
+
+#include <sstream>
+#include <typeinfo>
+
+#include "exec/data_sink.h"
+#include "exec/exec_node.h"
+#include "vec/exec/vexchange_node.h"
+#include "vec/exec/volap_scan_node.h"
+
+namespace doris::pipeline {
+
+std::string Operator::debug_string() const {
+    std::stringstream ss;
+    ss << typeid(*this).name();
+    if (_node != nullptr) {
+        ss << "(node_id=" << _node->id() << ")";
+    }
+    return ss.str();
+}
+
+ScanSourceOperator::ScanSourceOperator(vectorized::VOlapScanNode* node)
+        : Operator(node), _scan_node(node) {}
+
+Status ScanSourceOperator::open(RuntimeState* state) {
+    return _scan_node->open(state);
+}
+
+bool ScanSourceOperator::can_read() {
+    return _scan_node->can_read();
+}
+
+Status ScanSourceOperator::get_block(RuntimeState* state, vectorized::Block* block, bool* eos) {
+    return _scan_node->get_next(state, block, eos);
+}
+
+ExchangeSourceOperator::ExchangeSourceOperator(vectorized::VExchangeNode* node)
+        : Operator(node), _exchange_node(node) {}
+
+Status ExchangeSourceOperator::open(RuntimeState* state) {
+    return _exchange_node->open(state);
+}
+
+bool ExchangeSourceOperator::can_read() {
+    return _exchange_node->can_read();
+}
+
+Status ExchangeSourceOperator::get_block(RuntimeState* state, vectorized::Block* block,
+                                         bool* eos) {
+    return _exchange_node->get_next(state, block, eos);
+}
+
+Status BlockingSourceOperator::get_block(RuntimeState* state, vectorized::Block* block,
+                                         bool* eos) {
+    return _node->get_next(state, block, eos);
+}
+
+Status BlockingSinkOperator::open(RuntimeState* state) {
+    return _node->open_self(state);
+}
+
+Status BlockingSinkOperator::sink(RuntimeState* state, vectorized::Block* block, bool eos) {
+    return _node->sink(state, block, eos);
+}
+
+Status StreamingOperator::open(RuntimeState* state) {
+    return _node->open_self(state);
+}
+
+Status StreamingOperator::get_block(RuntimeState* state, vectorized::Block* block, bool* eos) {
+    if (_node->need_more_input_data()) {
+        vectorized::Block input_block;
+        bool child_eos = false;
+        RETURN_IF_ERROR(_child->get_block(state, &input_block, &child_eos));
+        RETURN_IF_ERROR(_node->push(state, &input_block, child_eos));
+    }
+    return _node->pull(state, block, eos);
+}
+
+Status DataSinkOperator::open(RuntimeState* state) {
+    return _sink->open(state);
+}
+
+bool DataSinkOperator::can_write() {
+    return _sink_finished || _sink->can_write();
+}
+
+Status DataSinkOperator::sink(RuntimeState* state, vectorized::Block* block, bool eos) {
+    if (_sink_finished || block->rows() == 0) {
+        return Status::OK();
+    }
+    if (_before_send) {
+        _before_send();
+    }
+    auto st = _sink->send(state, block);
+    if (st.is_end_of_file()) {
+        _sink_finished = true;
+        return Status::OK();
+    }
+    return st;
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,169 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "vec/core/block.h"
+
+namespace doris {
+class DataSink;
+class ExecNode;
+class RuntimeState;
+
+namespace vectorized {
+class VExchangeNode;
+class VOlapScanNode;
+} // namespace vectorized
+
+namespace pipeline {
+
+class Operator;
+using OperatorPtr = std::shared_ptr<Operator>;
+
+// An operator of a pipeline, which drives an exec node or a data sink of the fragment.
+// The first operator of a pipeline is the source, which reads the blocks of a scan node,
+// an exchange node or a node breaking the pipelines, the last one is the sink, which writes
+// the blocks to a data sink or a node breaking the pipelines, and the ones between process
+// the blocks of their children in a streaming way.
+// A task only calls get_block() of the sources and sink() of the sinks if they are ready,
+// so that it never waits for the data in the thread.
+class Operator {
+public:
+    explicit Operator(ExecNode* node) : _node(node) {}
+    virtual ~Operator() = default;
+
+    virtual bool is_source() const { return false; }
+    virtual bool is_sink() const { return false; }
+
+    // Called in the thread of the task before the first block.
+    virtual Status open(RuntimeState* state) = 0;
+
+    // Whether get_block() returns without waiting for the data, only for the sources.
+    virtual bool can_read() { return true; }
+    // Whether sink() returns without waiting for the receivers, only for the sinks.
+    virtual bool can_write() { return true; }
+    // Whether the sink needs no more blocks, the task finishes early if so.
+    virtual bool is_finished() const { return false; }
+
+    // Returns a block, the block may be empty even if eos is false.
+    virtual Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) {
+        return Status::NotSupported("Not Implemented get_block");
+    }
+    // Consumes a block of the child, eos is true for the last block.
+    virtual Status sink(RuntimeState* state, vectorized::Block* block, bool eos) {
+        return Status::NotSupported("Not Implemented sink");
+    }
+
+    void set_child(OperatorPtr child) { _child = std::move(child); }
+
+    virtual std::string debug_string() const;
+
+protected:
+    // not owned, the nodes are closed with the plan of the fragment
+    ExecNode* _node;
+    OperatorPtr _child;
+};
+
+// Reads the blocks scanned by a VOlapScanNode.
+class ScanSourceOperator final : public Operator {
+public:
+    explicit ScanSourceOperator(vectorized::VOlapScanNode* node);
+
+    bool is_source() const override { return true; }
+    Status open(RuntimeState* state) override;
+    bool can_read() override;
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override;
+
+private:
+    vectorized::VOlapScanNode* _scan_node;
+};
+
+// Reads the blocks received by a VExchangeNode.
+class ExchangeSourceOperator final : public Operator {
+public:
+    explicit ExchangeSourceOperator(vectorized::VExchangeNode* node);
+
+    bool is_source() const override { return true; }
+    Status open(RuntimeState* state) override;
+    bool can_read() override;
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override;
+
+private:
+    vectorized::VExchangeNode* _exchange_node;
+};
+
+// Reads the results of a node breaking the pipelines, the pipeline depends on the one
+// sinking into the node, so the results are ready when the task runs.
+class BlockingSourceOperator final : public Operator {
+public:
+    explicit BlockingSourceOperator(ExecNode* node) : Operator(node) {}
+
+    bool is_source() const override { return true; }
+    // opened by the BlockingSinkOperator
+    Status open(RuntimeState* state) override { return Status::OK(); }
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override;
+};
+
+// Writes the blocks into a node breaking the pipelines by ExecNode::sink().
+class BlockingSinkOperator final : public Operator {
+public:
+    explicit BlockingSinkOperator(ExecNode* node) : Operator(node) {}
+
+    bool is_sink() const override { return true; }
+    Status open(RuntimeState* state) override;
+    Status sink(RuntimeState* state, vectorized::Block* block, bool eos) override;
+};
+
+// Processes the blocks by ExecNode::push() and ExecNode::pull().
+class StreamingOperator final : public Operator {
+public:
+    explicit StreamingOperator(ExecNode* node) : Operator(node) {}
+
+    Status open(RuntimeState* state) override;
+    Status get_block(RuntimeState* state, vectorized::Block* block, bool* eos) override;
+};
+
+// Sends the blocks to the data sink of the fragment, which is closed when the fragment
+// finishes. `before_send` is called before each block is sent, e.g. to collect the query
+// statistics.
+class DataSinkOperator final : public Operator {
+public:
+    DataSinkOperator(DataSink* sink, std::function<void()> before_send)
+            : Operator(nullptr), _sink(sink), _before_send(std::move(before_send)) {}
+
+    bool is_sink() const override { return true; }
+    Status open(RuntimeState* state) override;
+    bool can_write() override;
+    bool is_finished() const override { return _sink_finished; }
+    Status sink(RuntimeState* state, vectorized::Block* block, bool eos) override;
+
+    std::string debug_string() const override { return "DataSinkOperator"; }
+
+private:
+    DataSink* _sink;
+    std::function<void()> _before_send;
+    // the sink returns EndOfFile if it needs no more blocks, e.g. reached the limit
+    bool _sink_finished = false;
+};
+
+} // namespace pipeline
+} // namespace doris
@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline.h"
+
+#include <sstream>
+
+namespace doris::pipeline {
+
+void Pipeline::add_operator(OperatorPtr op) {
+    if (!_operators.empty()) {
+        _operators.back()->set_child(op);
+    }
+    _operators.emplace_back(std::move(op));
+}
+
+void Pipeline::add_dependency(const PipelinePtr& dependency) {
+    dependency->_parents.push_back(this);
+    _num_unfinished_dependencies++;
+}
+
+void Pipeline::finish() {
+    for (auto* parent : _parents) {
+        parent->_num_unfinished_dependencies--;
+    }
+}
+
+std::string Pipeline::debug_string() const {
+    std::stringstream ss;
+    ss << "Pipeline(id=" << _id << ", operators=[";
+    for (size_t i = 0; i < _operators.size(); ++i) {
+        if (i > 0) {
+            ss << " <- ";
+        }
+        ss << _operators[i]->debug_string();
+    }
+    ss << "])";
+    return ss.str();
+}
+
+} // namespace doris::pipeline
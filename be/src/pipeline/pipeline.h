@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "pipeline/operator.h"
+
+namespace doris::pipeline {
+
+class Pipeline;
+class PipelineFragmentContext;
+using PipelinePtr = std::shared_ptr<Pipeline>;
+
+// A chain of operators from a source to a sink, the blocks flow through the operators
+// without being materialized between them. A pipeline depends on the pipelines sinking
+// into the nodes its source reads from, and is only scheduled after they finish.
+class Pipeline {
+public:
+    Pipeline(int id, PipelineFragmentContext* context) : _id(id), _context(context) {}
+
+    int id() const { return _id; }
+    PipelineFragmentContext* context() const { return _context; }
+
+    // The operators are added from the sink to the source, each one is the child of the
+    // one added before.
+    void add_operator(OperatorPtr op);
+
+    const OperatorPtr& source() const { return _operators.back(); }
+    const OperatorPtr& sink() const { return _operators.front(); }
+    // the operator whose results are sunk
+    const OperatorPtr& root() const { return _operators[1]; }
+    const std::vector<OperatorPtr>& operators() const { return _operators; }
+
+    // This pipeline runs after `dependency` finishes.
+    void add_dependency(const PipelinePtr& dependency);
+    bool has_dependency() const { return _num_unfinished_dependencies.load() > 0; }
+
+    // Called when the task of the pipeline finishes, so the pipelines depending on it
+    // become runnable.
+    void finish();
+
+    std::string debug_string() const;
+
+private:
+    const int _id;
+    PipelineFragmentContext* _context;
+    std::vector<OperatorPtr> _operators;
+
+    std::atomic<int> _num_unfinished_dependencies {0};
+    // the pipelines depending on this one
+    std::vector<Pipeline*> _parents;
+};
+
+} // namespace doris::pipeline
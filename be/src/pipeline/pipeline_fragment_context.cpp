@@ -0,0 +1,180 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline_fragment_context.h"
+
+#include <fmt/format.h>
+
+#include "exec/data_sink.h"
+#include "exec/exec_node.h"
+#include "pipeline/task_scheduler.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/uid_util.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/exec/vexchange_node.h"
+#include "vec/exec/volap_scan_node.h"
+#include "vec/exec/vselect_node.h"
+#include "vec/exec/vsort_node.h"
+#include "vec/runtime/vdata_stream_mgr.h"
+
+namespace doris::pipeline {
+
+PipelineFragmentContext::PipelineFragmentContext(RuntimeState* state, ExecNode* plan,
+                                                 DataSink* sink,
+                                                 std::function<void()> before_send,
+                                                 FinishCallback finish_callback)
+        : _state(state),
+          _plan(plan),
+          _sink(sink),
+          _before_send(std::move(before_send)),
+          _finish_callback(std::move(finish_callback)) {}
+
+bool PipelineFragmentContext::is_supported(ExecNode* plan, DataSink* sink) {
+    if (sink == nullptr) {
+        return false;
+    }
+    std::function<bool(ExecNode*)> is_supported_node = [&](ExecNode* node) {
+        if (dynamic_cast<vectorized::VOlapScanNode*>(node) != nullptr) {
+            return true;
+        }
+        if (auto exchange_node = dynamic_cast<vectorized::VExchangeNode*>(node)) {
+            return !exchange_node->is_merging();
+        }
+        if (dynamic_cast<vectorized::VSelectNode*>(node) != nullptr ||
+            dynamic_cast<vectorized::AggregationNode*>(node) != nullptr ||
+            dynamic_cast<vectorized::VSortNode*>(node) != nullptr) {
+            return node->children().size() == 1 && is_supported_node(node->children()[0]);
+        }
+        return false;
+    };
+    return is_supported_node(plan);
+}
+
+PipelinePtr PipelineFragmentContext::_add_pipeline() {
+    auto pipeline = std::make_shared<Pipeline>(_pipelines.size(), this);
+    _pipelines.push_back(pipeline);
+    return pipeline;
+}
+
+Status PipelineFragmentContext::_build_pipelines(ExecNode* node, PipelinePtr cur_pipeline) {
+    if (auto scan_node = dynamic_cast<vectorized::VOlapScanNode*>(node)) {
+        cur_pipeline->add_operator(std::make_shared<ScanSourceOperator>(scan_node));
+        return Status::OK();
+    }
+    if (auto exchange_node = dynamic_cast<vectorized::VExchangeNode*>(node)) {
+        cur_pipeline->add_operator(std::make_shared<ExchangeSourceOperator>(exchange_node));
+        return Status::OK();
+    }
+
+    bool is_blocking = false;
+    if (dynamic_cast<vectorized::VSortNode*>(node) != nullptr) {
+        is_blocking = true;
+    } else if (auto agg_node = dynamic_cast<vectorized::AggregationNode*>(node)) {
+        is_blocking = !agg_node->is_streaming_preagg();
+    } else if (dynamic_cast<vectorized::VSelectNode*>(node) == nullptr) {
+        return Status::InternalError(
+                fmt::format("Unsupported node in pipeline, node_id={}", node->id()));
+    }
+
+    if (is_blocking) {
+        // the node breaks the pipelines, its results are read by the current pipeline
+        // after a new pipeline sinks all the blocks of its child into it
+        cur_pipeline->add_operator(std::make_shared<BlockingSourceOperator>(node));
+        auto sink_pipeline = _add_pipeline();
+        sink_pipeline->add_operator(std::make_shared<BlockingSinkOperator>(node));
+        cur_pipeline->add_dependency(sink_pipeline);
+        return _build_pipelines(node->children()[0], sink_pipeline);
+    }
+    cur_pipeline->add_operator(std::make_shared<StreamingOperator>(node));
+    return _build_pipelines(node->children()[0], cur_pipeline);
+}
+
+Status PipelineFragmentContext::prepare() {
+    DCHECK(is_supported(_plan, _sink));
+    auto root_pipeline = _add_pipeline();
+    root_pipeline->add_operator(std::make_shared<DataSinkOperator>(_sink, _before_send));
+    RETURN_IF_ERROR(_build_pipelines(_plan, root_pipeline));
+
+    auto profile = _state->runtime_profile();
+    for (auto& pipeline : _pipelines) {
+        DCHECK_GE(pipeline->operators().size(), 2);
+        VLOG_DEBUG << "fragment " << print_id(_state->fragment_instance_id()) << " "
+                   << pipeline->debug_string();
+        _tasks.emplace_back(new PipelineTask(pipeline.get(), _tasks.size(), _state, profile));
+    }
+    return Status::OK();
+}
+
+Status PipelineFragmentContext::submit() {
+    auto scheduler = _state->exec_env()->pipeline_task_scheduler();
+    if (scheduler == nullptr) {
+        return Status::InternalError("pipeline task scheduler is not initialized");
+    }
+    for (size_t i = 0; i < _tasks.size(); ++i) {
+        auto st = scheduler->schedule_task(_tasks[i].get());
+        if (st.ok()) {
+            continue;
+        }
+        if (i == 0) {
+            return st;
+        }
+        // the scheduled tasks are running, close the others to finish the fragment
+        cancel(st);
+        for (size_t j = i; j < _tasks.size(); ++j) {
+            _tasks[j]->set_state(PipelineTaskState::CANCELED);
+            _tasks[j]->pipeline()->finish();
+            close_a_task();
+        }
+        break;
+    }
+    return Status::OK();
+}
+
+void PipelineFragmentContext::cancel(const Status& status) {
+    {
+        std::lock_guard<std::mutex> l(_status_lock);
+        if (_exec_status.ok()) {
+            _exec_status = status;
+        }
+    }
+    _state->set_is_cancelled(true);
+    // wake up the senders waiting for the receivers of the fragment
+    _state->exec_env()->vstream_mgr()->cancel(_state->fragment_instance_id());
+}
+
+bool PipelineFragmentContext::is_canceled() const {
+    return _state->is_cancelled();
+}
+
+void PipelineFragmentContext::close_a_task() {
+    if (++_closed_tasks < _tasks.size()) {
+        return;
+    }
+    Status status;
+    {
+        std::lock_guard<std::mutex> l(_status_lock);
+        status = _exec_status;
+    }
+    if (status.ok() && _state->is_cancelled()) {
+        status = Status::Cancelled("Cancelled");
+    }
+    auto finish_callback = std::move(_finish_callback);
+    finish_callback(status);
+}
+
+} // namespace doris::pipeline
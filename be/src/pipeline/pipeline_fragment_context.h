@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/status.h"
+#include "pipeline/pipeline.h"
+#include "pipeline/pipeline_task.h"
+
+namespace doris {
+class DataSink;
+class ExecNode;
+class RuntimeState;
+
+namespace pipeline {
+
+// Executes the plan of a fragment instance in pipelines. The plan is split into pipelines
+// at the nodes which consume all the input before returning anything (the blocking sort
+// and aggregation), each pipeline runs as a task on the workers of TaskScheduler, and
+// a pipeline is scheduled after the ones it depends on finish.
+// Compared to running the whole fragment in a thread, a task yields its worker when its
+// source has no data or its sink is full, so the number of threads does not grow with the
+// number of concurrent fragments.
+//
+// The context does not own the plan, the sink and the runtime state, which are closed
+// by the PlanFragmentExecutor after `finish_callback` is called.
+class PipelineFragmentContext : public std::enable_shared_from_this<PipelineFragmentContext> {
+public:
+    using FinishCallback = std::function<void(const Status&)>;
+
+    PipelineFragmentContext(RuntimeState* state, ExecNode* plan, DataSink* sink,
+                            std::function<void()> before_send, FinishCallback finish_callback);
+
+    // Whether all the nodes of the plan could be executed in pipelines.
+    static bool is_supported(ExecNode* plan, DataSink* sink);
+
+    // Builds the pipelines and the tasks.
+    Status prepare();
+
+    // Schedules the tasks, `finish_callback` is called by the worker closing the last
+    // task. An error is only returned if no task is scheduled.
+    Status submit();
+
+    // Cancels the fragment on the error of a task, the tasks not finished yet find the
+    // cancellation the next time they run.
+    void cancel(const Status& status);
+    bool is_canceled() const;
+
+    // Called by the worker once a task finishes or fails.
+    void close_a_task();
+
+    RuntimeState* runtime_state() const { return _state; }
+
+private:
+    PipelinePtr _add_pipeline();
+    Status _build_pipelines(ExecNode* node, PipelinePtr cur_pipeline);
+
+    RuntimeState* _state;
+    ExecNode* _plan;
+    DataSink* _sink;
+    std::function<void()> _before_send;
+    FinishCallback _finish_callback;
+
+    std::vector<PipelinePtr> _pipelines;
+    std::vector<std::unique_ptr<PipelineTask>> _tasks;
+    std::atomic<size_t> _closed_tasks {0};
+
+    std::mutex _status_lock;
+    // the first error of the tasks
+    Status _exec_status;
+};
+
+} // namespace pipeline
+} // namespace doris
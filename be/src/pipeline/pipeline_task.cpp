@@ -0,0 +1,153 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/pipeline_task.h"
+
+#include <sstream>
+
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+#include "util/stopwatch.hpp"
+#include "util/time.h"
+
+namespace doris::pipeline {
+
+const char* get_state_name(PipelineTaskState state) {
+    switch (state) {
+    case PipelineTaskState::NOT_READY:
+        return "NOT_READY";
+    case PipelineTaskState::BLOCKED_FOR_DEPENDENCY:
+        return "BLOCKED_FOR_DEPENDENCY";
+    case PipelineTaskState::BLOCKED_FOR_SOURCE:
+        return "BLOCKED_FOR_SOURCE";
+    case PipelineTaskState::BLOCKED_FOR_SINK:
+        return "BLOCKED_FOR_SINK";
+    case PipelineTaskState::RUNNABLE:
+        return "RUNNABLE";
+    case PipelineTaskState::FINISHED:
+        return "FINISHED";
+    case PipelineTaskState::CANCELED:
+        return "CANCELED";
+    }
+    return "UNKNOWN";
+}
+
+PipelineTask::PipelineTask(Pipeline* pipeline, int index, RuntimeState* state,
+                           RuntimeProfile* parent_profile)
+        : _pipeline(pipeline),
+          _index(index),
+          _state(state),
+          _cur_state(pipeline->has_dependency() ? PipelineTaskState::BLOCKED_FOR_DEPENDENCY
+                                                : PipelineTaskState::RUNNABLE) {
+    _task_profile = parent_profile->create_child(
+            "PipelineTask (index=" + std::to_string(_index) +
+                    ", pipeline_id=" + std::to_string(pipeline->id()) + ")",
+            true, true);
+    _exec_timer = ADD_TIMER(_task_profile, "ExecuteTime");
+    _schedule_counts = ADD_COUNTER(_task_profile, "ScheduleCount", TUnit::UNIT);
+    _block_by_source_counts = ADD_COUNTER(_task_profile, "BlockedBySourceCount", TUnit::UNIT);
+    _block_by_sink_counts = ADD_COUNTER(_task_profile, "BlockedBySinkCount", TUnit::UNIT);
+}
+
+Status PipelineTask::_open() {
+    // the children are opened before their parents, as ExecNode::open() does
+    auto& operators = _pipeline->operators();
+    for (auto it = operators.rbegin(); it != operators.rend(); ++it) {
+        RETURN_IF_ERROR((*it)->open(_state));
+    }
+    _opened = true;
+    return Status::OK();
+}
+
+Status PipelineTask::execute(bool* eos) {
+    SCOPED_TIMER(_exec_timer);
+    COUNTER_UPDATE(_schedule_counts, 1);
+    *eos = false;
+    if (_state->is_cancelled()) {
+        return Status::Cancelled("Cancelled");
+    }
+    if (!_opened) {
+        RETURN_IF_ERROR(_open());
+    }
+
+    auto& source = _pipeline->source();
+    auto& root = _pipeline->root();
+    auto& sink = _pipeline->sink();
+    const int64_t time_slice_ns = config::pipeline_task_time_slice_ms * NANOS_PER_MILLIS;
+    MonotonicStopWatch watch;
+    watch.start();
+    while (!_state->is_cancelled()) {
+        if (!source->can_read()) {
+            COUNTER_UPDATE(_block_by_source_counts, 1);
+            set_state(PipelineTaskState::BLOCKED_FOR_SOURCE);
+            return Status::OK();
+        }
+        if (!sink->can_write()) {
+            COUNTER_UPDATE(_block_by_sink_counts, 1);
+            set_state(PipelineTaskState::BLOCKED_FOR_SINK);
+            return Status::OK();
+        }
+
+        vectorized::Block block;
+        bool source_eos = false;
+        RETURN_IF_ERROR(root->get_block(_state, &block, &source_eos));
+        RETURN_IF_ERROR(sink->sink(_state, &block, source_eos));
+        if (source_eos || sink->is_finished()) {
+            *eos = true;
+            set_state(PipelineTaskState::FINISHED);
+            return Status::OK();
+        }
+        if (watch.elapsed_time() > time_slice_ns) {
+            set_state(PipelineTaskState::RUNNABLE);
+            return Status::OK();
+        }
+    }
+    return Status::Cancelled("Cancelled");
+}
+
+bool PipelineTask::is_runnable() {
+    switch (_cur_state.load()) {
+    case PipelineTaskState::BLOCKED_FOR_DEPENDENCY:
+        if (_pipeline->has_dependency()) {
+            return false;
+        }
+        break;
+    case PipelineTaskState::BLOCKED_FOR_SOURCE:
+        if (!_pipeline->source()->can_read()) {
+            return false;
+        }
+        break;
+    case PipelineTaskState::BLOCKED_FOR_SINK:
+        if (!_pipeline->sink()->can_write()) {
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+    set_state(PipelineTaskState::RUNNABLE);
+    return true;
+}
+
+std::string PipelineTask::debug_string() const {
+    std::stringstream ss;
+    ss << "PipelineTask(index=" << _index << ", state=" << get_state_name(_cur_state.load())
+       << ", " << _pipeline->debug_string() << ")";
+    return ss.str();
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "common/status.h"
+#include "pipeline/pipeline.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+class RuntimeState;
+
+namespace pipeline {
+
+enum class PipelineTaskState : uint8_t {
+    NOT_READY = 0,
+    BLOCKED_FOR_DEPENDENCY = 1,
+    BLOCKED_FOR_SOURCE = 2,
+    BLOCKED_FOR_SINK = 3,
+    RUNNABLE = 4,
+    FINISHED = 5,
+    CANCELED = 6
+};
+
+const char* get_state_name(PipelineTaskState state);
+
+// The task runs a pipeline of a fragment instance. Each execute() processes the blocks of
+// the source until the source or the sink is not ready or the time slice of the task
+// runs out, then the task is put back to the scheduler, so a worker never waits for the
+// data and a long task can not starve the others.
+class PipelineTask {
+public:
+    PipelineTask(Pipeline* pipeline, int index, RuntimeState* state,
+                 RuntimeProfile* parent_profile);
+
+    // *eos is set if the pipeline has no more blocks to process, the state of the task
+    // tells why it stops otherwise.
+    Status execute(bool* eos);
+
+    // Re-checks if a blocked task could run now.
+    bool is_runnable();
+
+    PipelineTaskState get_state() const { return _cur_state; }
+    void set_state(PipelineTaskState state) { _cur_state = state; }
+    bool is_blocked() const {
+        return _cur_state == PipelineTaskState::BLOCKED_FOR_DEPENDENCY ||
+               _cur_state == PipelineTaskState::BLOCKED_FOR_SOURCE ||
+               _cur_state == PipelineTaskState::BLOCKED_FOR_SINK;
+    }
+
+    Pipeline* pipeline() const { return _pipeline; }
+    PipelineFragmentContext* fragment_context() const { return _pipeline->context(); }
+    RuntimeState* runtime_state() const { return _state; }
+
+    // the worker which run the task last time, the task prefers it for the cache
+    int get_previous_core_id() const { return _previous_core_id; }
+    void set_previous_core_id(int id) { _previous_core_id = id; }
+
+    std::string debug_string() const;
+
+private:
+    Status _open();
+
+    Pipeline* _pipeline;
+    const int _index;
+    RuntimeState* _state;
+    bool _opened = false;
+    std::atomic<PipelineTaskState> _cur_state;
+    int _previous_core_id = -1;
+
+    RuntimeProfile* _task_profile;
+    RuntimeProfile::Counter* _exec_timer = nullptr;
+    RuntimeProfile::Counter* _schedule_counts = nullptr;
+    RuntimeProfile::Counter* _block_by_source_counts = nullptr;
+    RuntimeProfile::Counter* _block_by_sink_counts = nullptr;
+};
+
+} // namespace pipeline
+} // namespace doris
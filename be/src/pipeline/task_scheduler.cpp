@@ -0,0 +1,287 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/task_scheduler.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "agent/cgroups_mgr.h"
+#include "common/config.h"
+#include "common/logging.h"
+#include "pipeline/pipeline_fragment_context.h"
+#include "runtime/runtime_state.h"
+#include "runtime/thread_context.h"
+#include "runtime/workload_group.h"
+#include "util/cpu_info.h"
+
+namespace doris::pipeline {
+
+TaskQueue::TaskQueue(size_t core_size)
+        : _core_size(core_size), _sub_queues(new SubQueue[core_size]) {
+    DCHECK_GT(core_size, 0);
+}
+
+void TaskQueue::close() {
+    _closed = true;
+    for (size_t i = 0; i < _core_size; ++i) {
+        std::lock_guard<std::mutex> l(_sub_queues[i].lock);
+        _sub_queues[i].cv.notify_all();
+    }
+}
+
+PipelineTask* TaskQueue::_try_take(size_t core_id, bool steal) {
+    auto& queue = _sub_queues[core_id];
+    std::lock_guard<std::mutex> l(queue.lock);
+    if (queue.tasks.empty()) {
+        return nullptr;
+    }
+    PipelineTask* task = nullptr;
+    // steal the task pushed last, which is least likely to be in the cache of the owner
+    if (steal) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+    } else {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+    }
+    return task;
+}
+
+PipelineTask* TaskQueue::take(size_t core_id) {
+    DCHECK_LT(core_id, _core_size);
+    while (!_closed) {
+        auto task = _try_take(core_id, false);
+        if (task != nullptr) {
+            return task;
+        }
+        for (size_t i = 1; i < _core_size; ++i) {
+            task = _try_take((core_id + i) % _core_size, true);
+            if (task != nullptr) {
+                return task;
+            }
+        }
+
+        auto& queue = _sub_queues[core_id];
+        std::unique_lock<std::mutex> l(queue.lock);
+        if (queue.tasks.empty() && !_closed) {
+            // use wait_for, the tasks pushed to the other queues could be stolen
+            queue.cv.wait_for(l, std::chrono::milliseconds(10));
+        }
+    }
+    return nullptr;
+}
+
+void TaskQueue::push_back(PipelineTask* task) {
+    int core_id = task->get_previous_core_id();
+    if (core_id < 0 || (size_t)core_id >= _core_size) {
+        core_id = _next_core_id++ % _core_size;
+    }
+    push_back(task, core_id);
+}
+
+void TaskQueue::push_back(PipelineTask* task, size_t core_id) {
+    DCHECK_LT(core_id, _core_size);
+    auto& queue = _sub_queues[core_id];
+    std::lock_guard<std::mutex> l(queue.lock);
+    queue.tasks.push_back(task);
+    queue.cv.notify_one();
+}
+
+BlockedTaskScheduler::BlockedTaskScheduler(std::shared_ptr<TaskQueue> task_queue)
+        : _task_queue(std::move(task_queue)) {}
+
+Status BlockedTaskScheduler::start() {
+    return Thread::create(
+            "PipelineTaskScheduler", "blocked_task_scheduler",
+            [this]() { this->_schedule(); }, &_thread);
+}
+
+void BlockedTaskScheduler::shutdown() {
+    if (_shutdown.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> l(_task_mutex);
+        _task_cond.notify_one();
+    }
+    if (_thread != nullptr) {
+        _thread->join();
+    }
+}
+
+void BlockedTaskScheduler::add_blocked_task(PipelineTask* task) {
+    std::lock_guard<std::mutex> l(_task_mutex);
+    _blocked_tasks.push_back(task);
+    _task_cond.notify_one();
+}
+
+void BlockedTaskScheduler::_schedule() {
+    std::vector<PipelineTask*> ready_tasks;
+    while (!_shutdown) {
+        {
+            std::unique_lock<std::mutex> l(_task_mutex);
+            if (_blocked_tasks.empty()) {
+                _task_cond.wait_for(l, std::chrono::milliseconds(10));
+                continue;
+            }
+            for (auto it = _blocked_tasks.begin(); it != _blocked_tasks.end();) {
+                auto task = *it;
+                // the cancelled task finds the cancellation and finishes in the worker
+                if (task->fragment_context()->is_canceled() || task->is_runnable()) {
+                    ready_tasks.push_back(task);
+                    it = _blocked_tasks.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            if (ready_tasks.empty()) {
+                // the readiness of the sources and the sinks is not notified, so poll them
+                _task_cond.wait_for(l, std::chrono::milliseconds(1));
+                continue;
+            }
+        }
+        for (auto task : ready_tasks) {
+            task->set_state(PipelineTaskState::RUNNABLE);
+            _task_queue->push_back(task);
+        }
+        ready_tasks.clear();
+    }
+    LOG(INFO) << "BlockedTaskScheduler schedule thread stop";
+}
+
+TaskScheduler::TaskScheduler() {
+    _core_size = config::pipeline_executor_size > 0 ? config::pipeline_executor_size
+                                                     : CpuInfo::num_cores();
+    _task_queue = std::make_shared<TaskQueue>(_core_size);
+    _blocked_task_scheduler = std::make_unique<BlockedTaskScheduler>(_task_queue);
+}
+
+TaskScheduler::~TaskScheduler() {
+    shutdown();
+}
+
+Status TaskScheduler::start() {
+    RETURN_IF_ERROR(ThreadPoolBuilder("PipelineTaskScheduler")
+                            .set_min_threads(_core_size)
+                            .set_max_threads(_core_size)
+                            .build(&_fix_thread_pool));
+    for (size_t i = 0; i < _core_size; ++i) {
+        RETURN_IF_ERROR(_fix_thread_pool->submit_func([this, i]() { _do_work(i); }));
+    }
+    RETURN_IF_ERROR(_blocked_task_scheduler->start());
+    LOG(INFO) << "pipeline task scheduler started with " << _core_size << " workers";
+    return Status::OK();
+}
+
+void TaskScheduler::shutdown() {
+    if (_shutdown.exchange(true)) {
+        return;
+    }
+    _task_queue->close();
+    if (_fix_thread_pool != nullptr) {
+        _fix_thread_pool->shutdown();
+    }
+    _blocked_task_scheduler->shutdown();
+}
+
+Status TaskScheduler::schedule_task(PipelineTask* task) {
+    if (_shutdown) {
+        return Status::InternalError("pipeline task scheduler is shut down");
+    }
+    if (task->is_blocked()) {
+        _blocked_task_scheduler->add_blocked_task(task);
+    } else {
+        _task_queue->push_back(task);
+    }
+    return Status::OK();
+}
+
+void TaskScheduler::_do_work(size_t index) {
+    if (config::pipeline_executor_bind_cores) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(index % CpuInfo::get_max_num_cores(), &cpu_set);
+        int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        if (ret != 0) {
+            LOG(WARNING) << "failed to bind pipeline worker " << index << " to the core, "
+                         << "errno=" << ret;
+        }
+    }
+    // the workload group whose cgroup the worker is in, only the workers run the pipeline
+    // tasks so the cgroup is changed only when the group changes
+    std::string cgroup_group_name;
+    while (!_shutdown) {
+        auto task = _task_queue->take(index);
+        if (task == nullptr) {
+            continue;
+        }
+        // the last finished task may release the fragment, keep it until the task is closed
+        auto fragment_ctx = task->fragment_context()->shared_from_this();
+        task->set_previous_core_id(index);
+        _apply_cgroup(task, &cgroup_group_name);
+        bool eos = false;
+        Status status;
+        {
+#ifndef BE_TEST
+            SCOPED_ATTACH_TASK_THREAD(task->runtime_state(),
+                                      task->runtime_state()->instance_mem_tracker());
+#endif
+            status = task->execute(&eos);
+        }
+        if (!status.ok()) {
+            LOG(WARNING) << "pipeline task failed, " << task->debug_string()
+                         << ", status: " << status.get_error_msg();
+            fragment_ctx->cancel(status);
+            _close_task(task, PipelineTaskState::CANCELED);
+            continue;
+        }
+        if (eos) {
+            _close_task(task, PipelineTaskState::FINISHED);
+            continue;
+        }
+        if (task->is_blocked()) {
+            _blocked_task_scheduler->add_blocked_task(task);
+        } else {
+            _task_queue->push_back(task, index);
+        }
+    }
+}
+
+void TaskScheduler::_apply_cgroup(PipelineTask* task, std::string* cgroup_group_name) {
+    auto query_ctx = task->runtime_state()->get_query_fragments_ctx();
+    WorkloadGroup* group = query_ctx == nullptr ? nullptr : query_ctx->workload_group.get();
+    if (group == nullptr) {
+        if (!cgroup_group_name->empty()) {
+            CgroupsMgr::apply_system_cgroup();
+            cgroup_group_name->clear();
+        }
+    } else if (group->name() != *cgroup_group_name) {
+        group->apply_cgroup();
+        *cgroup_group_name = group->name();
+    }
+}
+
+void TaskScheduler::_close_task(PipelineTask* task, PipelineTaskState state) {
+    task->set_state(state);
+    // the pipelines depending on the task could run now, or find the cancellation
+    task->pipeline()->finish();
+    // must be the last access of the task, which may be released by the fragment
+    task->fragment_context()->close_a_task();
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "common/status.h"
+#include "gutil/ref_counted.h"
+#include "pipeline/pipeline_task.h"
+#include "util/thread.h"
+#include "util/threadpool.h"
+
+namespace doris::pipeline {
+
+// The queues of the runnable tasks, one for each worker. A worker takes the tasks of its
+// own queue first, and steals the ones of the other queues if its own is empty.
+class TaskQueue {
+public:
+    explicit TaskQueue(size_t core_size);
+
+    void close();
+
+    // Returns nullptr if the queue is closed.
+    PipelineTask* take(size_t core_id);
+
+    // The task is put to the queue of the worker which run it last time if any.
+    void push_back(PipelineTask* task);
+    void push_back(PipelineTask* task, size_t core_id);
+
+    size_t core_size() const { return _core_size; }
+
+private:
+    struct SubQueue {
+        std::mutex lock;
+        std::condition_variable cv;
+        std::deque<PipelineTask*> tasks;
+    };
+
+    PipelineTask* _try_take(size_t core_id, bool steal);
+
+    const size_t _core_size;
+    std::unique_ptr<SubQueue[]> _sub_queues;
+    std::atomic<size_t> _next_core_id {0};
+    std::atomic<bool> _closed {false};
+};
+
+// Polls the blocked tasks, and puts them back to the task queue once their dependencies,
+// sources or sinks are ready, or their fragments are cancelled.
+class BlockedTaskScheduler {
+public:
+    explicit BlockedTaskScheduler(std::shared_ptr<TaskQueue> task_queue);
+    ~BlockedTaskScheduler() = default;
+
+    Status start();
+    void shutdown();
+
+    void add_blocked_task(PipelineTask* task);
+
+private:
+    void _schedule();
+
+    std::shared_ptr<TaskQueue> _task_queue;
+
+    std::mutex _task_mutex;
+    std::condition_variable _task_cond;
+    std::list<PipelineTask*> _blocked_tasks;
+
+    scoped_refptr<Thread> _thread;
+    std::atomic<bool> _shutdown {false};
+};
+
+// Runs the pipeline tasks of all the fragments on a fixed number of workers, see
+// PipelineFragmentContext.
+class TaskScheduler {
+public:
+    TaskScheduler();
+    ~TaskScheduler();
+
+    Status start();
+    void shutdown();
+
+    Status schedule_task(PipelineTask* task);
+
+private:
+    void _do_work(size_t index);
+    void _close_task(PipelineTask* task, PipelineTaskState state);
+    // Moves the worker to the cgroup of the workload group of the task if it changes.
+    void _apply_cgroup(PipelineTask* task, std::string* cgroup_group_name);
+
+    size_t _core_size;
+    std::shared_ptr<TaskQueue> _task_queue;
+    std::unique_ptr<BlockedTaskScheduler> _blocked_task_scheduler;
+    std::unique_ptr<ThreadPool> _fix_thread_pool;
+    std::atomic<bool> _shutdown {false};
+};
+
+} // namespace doris::pipeline
@@ -115,6 +115,11 @@ Status BufferControlBlock::add_batch(std::unique_ptr<TFetchDataResult>& result)
     return Status::OK();
 }
 
+bool BufferControlBlock::can_add_batch() {
+    std::lock_guard<std::mutex> l(_lock);
+    return _is_cancelled || _batch_queue.empty();
+}
+
 Status BufferControlBlock::get_batch(TFetchDataResult* result) {
     std::unique_lock<std::mutex> l(_lock);
 
@@ -65,6 +65,9 @@ public:
     Status init();
     Status add_batch(std::unique_ptr<TFetchDataResult>& result);
 
+    // Whether add_batch() returns without waiting for the batches to be fetched.
+    bool can_add_batch();
+
     // get result from batch, use timeout?
     Status get_batch(TFetchDataResult* result);
 
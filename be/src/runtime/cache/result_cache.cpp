@@ -71,11 +71,101 @@ void ResultNodeList::clear() {
     }
     _node_count = 0;
 }
+ResultCache::ResultCache(int32 max_size, int32 elasticity_size) {
+    _max_size = max_size * 1024 * 1024;
+    _elasticity_size = elasticity_size * 1024 * 1024;
+    for (auto& shard : _shards) {
+        shard.reset(new ResultCacheShard());
+    }
+}
+
+void ResultCache::update(const PUpdateCacheRequest* request, PCacheResponse* response) {
+    get_shard(request->sql_key())->update(request, response);
+    prune();
+    update_monitor();
+}
+
+void ResultCache::fetch(const PFetchCacheRequest* request, PFetchCacheResult* result) {
+    get_shard(request->sql_key())->fetch(request, result);
+}
+
+bool ResultCache::contains(const UniqueId& sql_key) {
+    return get_shard(sql_key)->contains(sql_key);
+}
+
+/**
+ * enum PClearType {
+ *   CLEAR_ALL = 0,
+ *   PRUNE_CACHE = 1,
+ *   CLEAR_BEFORE_TIME = 2,
+ *   CLEAR_SQL_KEY = 3
+ * };
+ */
+void ResultCache::clear(const PClearCacheRequest* request, PCacheResponse* response) {
+    LOG(INFO) << "clear cache type" << request->clear_type()
+              << ", cache size:" << get_cache_size();
+    //0 clear, 1 prune, 2 before_time,3 sql_key
+    switch (request->clear_type()) {
+    case PClearType::CLEAR_ALL:
+        for (auto& shard : _shards) {
+            shard->clear();
+        }
+        break;
+    case PClearType::PRUNE_CACHE:
+        prune();
+        break;
+    default:
+        break;
+    }
+    update_monitor();
+    response->set_status(PCacheStatus::CACHE_OK);
+}
+
+size_t ResultCache::get_cache_size() const {
+    size_t cache_size = 0;
+    for (auto& shard : _shards) {
+        cache_size += shard->get_cache_size();
+    }
+    return cache_size;
+}
+
+void ResultCache::prune() {
+    if (get_cache_size() <= (_max_size + _elasticity_size)) {
+        return;
+    }
+    std::lock_guard<std::mutex> l(_prune_mtx);
+    size_t cache_size = get_cache_size();
+    if (cache_size <= (_max_size + _elasticity_size)) {
+        return;
+    }
+    LOG(INFO) << "begin prune cache, cache_size : " << cache_size << ", max_size : " << _max_size
+              << ", elasticity_size : " << _elasticity_size;
+    size_t shard_max_size = _max_size / NUM_SHARDS;
+    for (auto& shard : _shards) {
+        shard->prune(shard_max_size);
+    }
+    LOG(INFO) << "finish prune, cache_size : " << get_cache_size();
+}
+
+void ResultCache::update_monitor() {
+    size_t cache_size = 0;
+    size_t node_count = 0;
+    size_t partition_count = 0;
+    for (auto& shard : _shards) {
+        cache_size += shard->get_cache_size();
+        node_count += shard->get_node_count();
+        partition_count += shard->get_partition_count();
+    }
+    DorisMetrics::instance()->query_cache_memory_total_byte->set_value(cache_size);
+    DorisMetrics::instance()->query_cache_sql_total_count->set_value(node_count);
+    DorisMetrics::instance()->query_cache_partition_total_count->set_value(partition_count);
+}
+
 /**
  * Find the node and update partition data
  * New node, the node updated in the first partition will move to the tail of the list
  */
-void ResultCache::update(const PUpdateCacheRequest* request, PCacheResponse* response) {
+void ResultCacheShard::update(const PUpdateCacheRequest* request, PCacheResponse* response) {
     ResultNode* node;
     PCacheStatus status;
     bool update_first = false;
@@ -102,22 +192,18 @@ void ResultCache::update(const PUpdateCacheRequest* request, PCacheResponse* res
     _cache_size += node->get_data_size();
     _partition_count += node->get_partition_count();
     response->set_status(status);
-
-    prune();
-    update_monitor();
 }
 
 /**
  * Fetch cache through sql key, partition key, version and time
  */
-void ResultCache::fetch(const PFetchCacheRequest* request, PFetchCacheResult* result) {
+void ResultCacheShard::fetch(const PFetchCacheRequest* request, PFetchCacheResult* result) {
     bool hit_first = false;
-    ResultNodeMap::iterator node_it;
     const UniqueId sql_key = request->sql_key();
     LOG(INFO) << "fetch cache, sql key:" << sql_key;
     {
         CacheReadLock read_lock(_cache_mtx);
-        node_it = _node_map.find(sql_key);
+        auto node_it = _node_map.find(sql_key);
         if (node_it == _node_map.end()) {
             result->set_status(PCacheStatus::NO_SQL_KEY);
             LOG(INFO) << "no such sql key:" << sql_key;
@@ -148,44 +234,26 @@ void ResultCache::fetch(const PFetchCacheRequest* request, PFetchCacheResult* re
 
     if (hit_first) {
         CacheWriteLock write_lock(_cache_mtx);
-        _node_list.move_tail(node_it->second);
+        // the node may have been removed since the read lock was released
+        auto node_it = _node_map.find(sql_key);
+        if (node_it != _node_map.end()) {
+            _node_list.move_tail(node_it->second);
+        }
     }
 }
 
-bool ResultCache::contains(const UniqueId& sql_key) {
+bool ResultCacheShard::contains(const UniqueId& sql_key) {
     CacheReadLock read_lock(_cache_mtx);
     return _node_map.find(sql_key) != _node_map.end();
 }
 
-/**
- * enum PClearType {
- *   CLEAR_ALL = 0,
- *   PRUNE_CACHE = 1,
- *   CLEAR_BEFORE_TIME = 2,
- *   CLEAR_SQL_KEY = 3
- * };
- */
-void ResultCache::clear(const PClearCacheRequest* request, PCacheResponse* response) {
-    LOG(INFO) << "clear cache type" << request->clear_type()
-              << ", node size:" << _node_list.get_node_count() << ", map size:" << _node_map.size();
+void ResultCacheShard::clear() {
     CacheWriteLock write_lock(_cache_mtx);
-    //0 clear, 1 prune, 2 before_time,3 sql_key
-    switch (request->clear_type()) {
-    case PClearType::CLEAR_ALL:
-        _node_list.clear();
-        _node_map.clear();
-        _cache_size = 0;
-        _node_count = 0;
-        _partition_count = 0;
-        break;
-    case PClearType::PRUNE_CACHE:
-        prune();
-        break;
-    default:
-        break;
-    }
-    update_monitor();
-    response->set_status(PCacheStatus::CACHE_OK);
+    _node_list.clear();
+    _node_map.clear();
+    _cache_size = 0;
+    _node_count = 0;
+    _partition_count = 0;
 }
 
 //private method
@@ -220,14 +288,13 @@ ResultNode* find_min_time_node(ResultNode* result_node) {
 *   4,3,6,8
 *   5,7,9,11,13 //_tail
 */
-void ResultCache::prune() {
-    if (_cache_size <= (_max_size + _elasticity_size)) {
+void ResultCacheShard::prune(size_t max_size) {
+    CacheWriteLock write_lock(_cache_mtx);
+    if (_cache_size <= max_size) {
         return;
     }
-    LOG(INFO) << "begin prune cache, cache_size : " << _cache_size << ", max_size : " << _max_size
-              << ", elasticity_size : " << _elasticity_size;
     ResultNode* result_node = _node_list.get_head();
-    while (_cache_size > _max_size) {
+    while (_cache_size > max_size) {
         if (result_node == nullptr) {
             break;
         }
@@ -246,17 +313,18 @@ void ResultCache::prune() {
             result_node = next_node;
         }
     }
-    LOG(INFO) << "finish prune, cache_size : " << _cache_size;
     _node_count = _node_map.size();
-    _cache_size = 0;
-    _partition_count = 0;
+    size_t cache_size = 0;
+    size_t partition_count = 0;
     for (auto node_it = _node_map.begin(); node_it != _node_map.end(); node_it++) {
-        _partition_count += node_it->second->get_partition_count();
-        _cache_size += node_it->second->get_data_size();
+        partition_count += node_it->second->get_partition_count();
+        cache_size += node_it->second->get_data_size();
     }
+    _cache_size = cache_size;
+    _partition_count = partition_count;
 }
 
-void ResultCache::remove(ResultNode* result_node) {
+void ResultCacheShard::remove(ResultNode* result_node) {
     auto node_it = _node_map.find(result_node->get_sql_key());
     if (node_it != _node_map.end()) {
         _node_map.erase(node_it);
@@ -265,10 +333,4 @@ void ResultCache::remove(ResultNode* result_node) {
     }
 }
 
-void ResultCache::update_monitor() {
-    DorisMetrics::instance()->query_cache_memory_total_byte->set_value(_cache_size);
-    DorisMetrics::instance()->query_cache_sql_total_count->set_value(_node_count);
-    DorisMetrics::instance()->query_cache_partition_total_count->set_value(_partition_count);
-}
-
 } // namespace doris
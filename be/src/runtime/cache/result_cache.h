@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
@@ -29,6 +30,7 @@
 #include <thread>
 
 #include "common/config.h"
+#include "gutil/macros.h"
 #include "runtime/cache/cache_utils.h"
 #include "runtime/cache/result_node.h"
 #include "runtime/mem_pool.h"
@@ -69,33 +71,30 @@ private:
 };
 
 /**
- * Cache results of query, including the entire result set or the result set of divided partitions.
+ * One shard of the result cache, caching the results of the sql keys hashed to it.
  * Two data structures, one is unordered_map and the other is a doubly linked list, corresponding to a result node.
  * If the cache is hit, the node will be moved to the end of the linked list.
- * If the cache is cleared, nodes that are expired or have not been accessed for a long time will be cleared.
+ * If the cache is pruned, nodes that have not been accessed for a long time will be cleared.
  */
-class ResultCache {
+class ResultCacheShard {
 public:
-    ResultCache(int32 max_size, int32 elasticity_size) {
-        _max_size = max_size * 1024 * 1024;
-        _elasticity_size = elasticity_size * 1024 * 1024;
-        _cache_size = 0;
-        _node_count = 0;
-        _partition_count = 0;
-    }
+    ResultCacheShard() = default;
+    ~ResultCacheShard() = default;
 
-    virtual ~ResultCache() {}
     void update(const PUpdateCacheRequest* request, PCacheResponse* response);
     void fetch(const PFetchCacheRequest* request, PFetchCacheResult* result);
     bool contains(const UniqueId& sql_key);
-    void clear(const PClearCacheRequest* request, PCacheResponse* response);
+    void clear();
+    // prune the least recently read partitions until the size of the shard is not larger than
+    // max_size
+    void prune(size_t max_size);
 
-    size_t get_cache_size() { return _cache_size; }
+    size_t get_cache_size() const { return _cache_size.load(std::memory_order_relaxed); }
+    size_t get_node_count() const { return _node_count.load(std::memory_order_relaxed); }
+    size_t get_partition_count() const { return _partition_count.load(std::memory_order_relaxed); }
 
 private:
-    void prune();
     void remove(ResultNode* result_node);
-    void update_monitor();
 
     //At the same time, multithreaded reading
     //Single thread updating and cleaning(only single be, Fe is not affected)
@@ -103,11 +102,47 @@ private:
     ResultNodeMap _node_map;
     //List of result nodes corresponding to SqlKey,last recently used at the tail
     ResultNodeList _node_list;
-    size_t _cache_size;
+    // written under _cache_mtx, read without it to aggregate the sizes of all shards
+    std::atomic<size_t> _cache_size {0};
+    std::atomic<size_t> _node_count {0};
+    std::atomic<size_t> _partition_count {0};
+
+    DISALLOW_COPY_AND_ASSIGN(ResultCacheShard);
+};
+
+/**
+ * Cache results of query, including the entire result set or the result set of divided partitions.
+ * The sql keys are hashed to several shards, so that the queries of different sql keys do not
+ * contend for a single lock. The memory limit applies to the whole cache, when it is exceeded
+ * every shard is pruned to its share of the limit.
+ */
+class ResultCache {
+public:
+    ResultCache(int32 max_size, int32 elasticity_size);
+
+    virtual ~ResultCache() {}
+    void update(const PUpdateCacheRequest* request, PCacheResponse* response);
+    void fetch(const PFetchCacheRequest* request, PFetchCacheResult* result);
+    bool contains(const UniqueId& sql_key);
+    void clear(const PClearCacheRequest* request, PCacheResponse* response);
+
+    size_t get_cache_size() const;
+
+private:
+    static constexpr int NUM_SHARDS = 16;
+
+    ResultCacheShard* get_shard(const UniqueId& sql_key) {
+        return _shards[sql_key.hash() % NUM_SHARDS].get();
+    }
+
+    void prune();
+    void update_monitor();
+
     size_t _max_size;
     double _elasticity_size;
-    size_t _node_count;
-    size_t _partition_count;
+    std::unique_ptr<ResultCacheShard> _shards[NUM_SHARDS];
+    // only one thread prunes the shards at a time
+    std::mutex _prune_mtx;
 
 private:
     ResultCache();
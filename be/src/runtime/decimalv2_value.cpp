@@ -29,25 +29,6 @@ static inline int128_t abs(const int128_t& x) {
     return (x < 0) ? -x : x;
 }
 
-// x>=0 && y>=0
-static int do_add(int128_t x, int128_t y, int128_t* result) {
-    int error = E_DEC_OK;
-    if (DecimalV2Value::MAX_DECIMAL_VALUE - x >= y) {
-        *result = x + y;
-    } else {
-        *result = DecimalV2Value::MAX_DECIMAL_VALUE;
-        error = E_DEC_OVERFLOW;
-    }
-    return error;
-}
-
-// x>=0 && y>=0
-static int do_sub(int128_t x, int128_t y, int128_t* result) {
-    int error = E_DEC_OK;
-    *result = x - y;
-    return error;
-}
-
 // clear leading zero for __int128
 static int clz128(unsigned __int128 v) {
     if (v == 0) return sizeof(__int128);
@@ -59,20 +40,45 @@ static int clz128(unsigned __int128 v) {
     }
 }
 
+// Divides a non-negative value by ONE_BILLION in 32 bits limbs, the 64 bits divisions by the
+// constant compile to multiplications while a 128 bits division calls __divti3.
+static inline int128_t div_by_billion(int128_t v, uint32_t* remainder) {
+    auto u = static_cast<unsigned __int128>(v);
+    auto hi = static_cast<uint64_t>(u >> 64);
+    auto lo = static_cast<uint64_t>(u);
+    if (hi == 0) {
+        *remainder = lo % DecimalV2Value::ONE_BILLION;
+        return lo / DecimalV2Value::ONE_BILLION;
+    }
+    const uint64_t limbs[] = {hi >> 32, hi & 0xFFFFFFFF, lo >> 32, lo & 0xFFFFFFFF};
+    unsigned __int128 quotient = 0;
+    uint64_t rem = 0;
+    for (uint64_t limb : limbs) {
+        uint64_t cur = (rem << 32) | limb;
+        quotient = (quotient << 32) | (cur / DecimalV2Value::ONE_BILLION);
+        rem = cur % DecimalV2Value::ONE_BILLION;
+    }
+    *remainder = rem;
+    return static_cast<int128_t>(quotient);
+}
+
 // x>0 && y>0
 static int do_mul(int128_t x, int128_t y, int128_t* result) {
     int error = E_DEC_OK;
     int128_t max128 = ~(static_cast<int128_t>(1ll) << 127);
 
+    // the product can't overflow with more than 128 leading zero bits in total, which skips the
+    // 128 bits division for the usual values
     int leading_zero_bits = clz128(x) + clz128(y);
-    if (leading_zero_bits < sizeof(int128_t) || max128 / x < y) {
+    if (leading_zero_bits < sizeof(int128_t) || (leading_zero_bits <= 128 && max128 / x < y)) {
         *result = DecimalV2Value::MAX_DECIMAL_VALUE;
         error = E_DEC_OVERFLOW;
         return error;
     }
 
     int128_t product = x * y;
-    *result = product / DecimalV2Value::ONE_BILLION;
+    uint32_t remainder = 0;
+    *result = div_by_billion(product, &remainder);
 
     // overflow
     if (*result > DecimalV2Value::MAX_DECIMAL_VALUE) {
@@ -82,7 +88,6 @@ static int do_mul(int128_t x, int128_t y, int128_t* result) {
     }
 
     // truncate with round
-    int128_t remainder = product % DecimalV2Value::ONE_BILLION;
     if (remainder != 0) {
         error = E_DEC_TRUNCATED;
         if (remainder >= (DecimalV2Value::ONE_BILLION >> 1)) {
@@ -118,59 +123,6 @@ static int do_mod(int128_t x, int128_t y, int128_t* result) {
     return error;
 }
 
-DecimalV2Value operator+(const DecimalV2Value& v1, const DecimalV2Value& v2) {
-    int128_t result;
-    int128_t x = v1.value();
-    int128_t y = v2.value();
-    if (x == 0) {
-        result = y;
-    } else if (y == 0) {
-        result = x;
-    } else if (x > 0) {
-        if (y > 0) {
-            do_add(x, y, &result);
-        } else {
-            do_sub(x, -y, &result);
-        }
-    } else { // x < 0
-        if (y > 0) {
-            do_sub(y, -x, &result);
-        } else {
-            do_add(-x, -y, &result);
-            result = -result;
-        }
-    }
-
-    return DecimalV2Value(result);
-}
-
-DecimalV2Value operator-(const DecimalV2Value& v1, const DecimalV2Value& v2) {
-    int128_t result;
-    int128_t x = v1.value();
-    int128_t y = v2.value();
-    if (x == 0) {
-        result = -y;
-    } else if (y == 0) {
-        result = x;
-    } else if (x > 0) {
-        if (y > 0) {
-            do_sub(x, y, &result);
-        } else {
-            do_add(x, -y, &result);
-        }
-    } else { // x < 0
-        if (y > 0) {
-            do_add(-x, y, &result);
-            result = -result;
-        } else {
-            do_sub(-x, -y, &result);
-            result = -result;
-        }
-    }
-
-    return DecimalV2Value(result);
-}
-
 DecimalV2Value operator*(const DecimalV2Value& v1, const DecimalV2Value& v2) {
     int128_t result;
     int128_t x = v1.value();
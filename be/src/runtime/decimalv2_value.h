@@ -300,8 +300,32 @@ private:
     int128_t _value;
 };
 
-DecimalV2Value operator+(const DecimalV2Value& v1, const DecimalV2Value& v2);
-DecimalV2Value operator-(const DecimalV2Value& v1, const DecimalV2Value& v2);
+// The addition and subtraction are inlined to be cheap in the vectorized loops, the valid values
+// are far from the int128 limits, so only the results of the same signs need to saturate.
+inline DecimalV2Value operator+(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    int128_t x = v1.value();
+    int128_t y = v2.value();
+    int128_t result = x + y;
+    if (x > 0 && y > 0 && result > DecimalV2Value::MAX_DECIMAL_VALUE) {
+        result = DecimalV2Value::MAX_DECIMAL_VALUE;
+    } else if (x < 0 && y < 0 && result < -DecimalV2Value::MAX_DECIMAL_VALUE) {
+        result = -DecimalV2Value::MAX_DECIMAL_VALUE;
+    }
+    return DecimalV2Value(result);
+}
+
+inline DecimalV2Value operator-(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    int128_t x = v1.value();
+    int128_t y = v2.value();
+    int128_t result = x - y;
+    if (x > 0 && y < 0 && result > DecimalV2Value::MAX_DECIMAL_VALUE) {
+        result = DecimalV2Value::MAX_DECIMAL_VALUE;
+    } else if (x < 0 && y > 0 && result < -DecimalV2Value::MAX_DECIMAL_VALUE) {
+        result = -DecimalV2Value::MAX_DECIMAL_VALUE;
+    }
+    return DecimalV2Value(result);
+}
+
 DecimalV2Value operator*(const DecimalV2Value& v1, const DecimalV2Value& v2);
 DecimalV2Value operator/(const DecimalV2Value& v1, const DecimalV2Value& v2);
 DecimalV2Value operator%(const DecimalV2Value& v1, const DecimalV2Value& v2);
@@ -25,7 +25,12 @@
 
 namespace doris {
 namespace vectorized {
+class BlockSpillManager;
+class ScannerScheduler;
 class VDataStreamMgr;
+} // namespace vectorized
+namespace pipeline {
+class TaskScheduler;
 }
 class BfdParser;
 class BrokerMgr;
@@ -41,6 +46,7 @@ class EtlJobMgr;
 class EvHttpServer;
 class ExternalScanContextMgr;
 class FragmentMgr;
+class MemoryReservationMgr;
 class ResultCache;
 class LoadPathMgr;
 class LoadStreamMgr;
@@ -57,7 +63,9 @@ class LoadChannelMgr;
 class ThreadResourceMgr;
 class TmpFileMgr;
 class WebPageHandler;
+class WorkloadGroupMgr;
 class StreamLoadExecutor;
+class GroupCommitMgr;
 class RoutineLoadTaskExecutor;
 class SmallFileMgr;
 class StoragePolicyMgr;
@@ -123,9 +131,17 @@ public:
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
     PriorityThreadPool* scan_thread_pool() { return _scan_thread_pool; }
     ThreadPool* limited_scan_thread_pool() { return _limited_scan_thread_pool.get(); }
+    vectorized::ScannerScheduler* scanner_scheduler() { return _scanner_scheduler; }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
     ThreadPool* send_batch_thread_pool() { return _send_batch_thread_pool.get(); }
+    ThreadPool* join_build_thread_pool() { return _join_build_thread_pool.get(); }
+    ThreadPool* file_upload_thread_pool() { return _file_upload_thread_pool.get(); }
+    ThreadPool* segment_writer_thread_pool() { return _segment_writer_thread_pool.get(); }
+    pipeline::TaskScheduler* pipeline_task_scheduler() { return _pipeline_task_scheduler; }
     CgroupsMgr* cgroups_mgr() { return _cgroups_mgr; }
+    WorkloadGroupMgr* workload_group_mgr() { return _workload_group_mgr; }
+    // nullptr if `enable_query_memory_admission` is false
+    MemoryReservationMgr* memory_reservation_mgr() { return _memory_reservation_mgr; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
     ResultCache* result_cache() { return _result_cache; }
     TMasterInfo* master_info() { return _master_info; }
@@ -133,6 +149,7 @@ public:
     LoadPathMgr* load_path_mgr() { return _load_path_mgr; }
     DiskIoMgr* disk_io_mgr() { return _disk_io_mgr; }
     TmpFileMgr* tmp_file_mgr() { return _tmp_file_mgr; }
+    vectorized::BlockSpillManager* block_spill_mgr() { return _block_spill_mgr; }
     BfdParser* bfd_parser() const { return _bfd_parser; }
     BrokerMgr* broker_mgr() const { return _broker_mgr; }
     BrpcClientCache<PBackendService_Stub>* brpc_internal_client_cache() const {
@@ -154,6 +171,7 @@ public:
     void set_storage_engine(StorageEngine* storage_engine) { _storage_engine = storage_engine; }
 
     StreamLoadExecutor* stream_load_executor() { return _stream_load_executor; }
+    GroupCommitMgr* group_commit_mgr() { return _group_commit_mgr; }
     RoutineLoadTaskExecutor* routine_load_task_executor() { return _routine_load_task_executor; }
     HeartbeatFlags* heartbeat_flags() { return _heartbeat_flags; }
 
@@ -202,10 +220,22 @@ private:
     // TODO(cmy): find a better way to unify these 2 pools.
     PriorityThreadPool* _scan_thread_pool = nullptr;
     std::unique_ptr<ThreadPool> _limited_scan_thread_pool;
+    // Schedules the scanners of the vectorized olap scan nodes to _scan_thread_pool.
+    vectorized::ScannerScheduler* _scanner_scheduler = nullptr;
 
     std::unique_ptr<ThreadPool> _send_batch_thread_pool;
+    // Threads building the hash tables of hash join in parallel.
+    std::unique_ptr<ThreadPool> _join_build_thread_pool;
+    // Threads closing the finished result files of outfile, which uploads them to S3.
+    std::unique_ptr<ThreadPool> _file_upload_thread_pool;
+    // Threads converting and encoding the columns of the blocks written to wide segments.
+    std::unique_ptr<ThreadPool> _segment_writer_thread_pool;
+    // Workers running the tasks of the fragments executed in pipelines.
+    pipeline::TaskScheduler* _pipeline_task_scheduler = nullptr;
     PriorityThreadPool* _etl_thread_pool = nullptr;
     CgroupsMgr* _cgroups_mgr = nullptr;
+    WorkloadGroupMgr* _workload_group_mgr = nullptr;
+    MemoryReservationMgr* _memory_reservation_mgr = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
     ResultCache* _result_cache = nullptr;
     TMasterInfo* _master_info = nullptr;
@@ -213,6 +243,7 @@ private:
     LoadPathMgr* _load_path_mgr = nullptr;
     DiskIoMgr* _disk_io_mgr = nullptr;
     TmpFileMgr* _tmp_file_mgr = nullptr;
+    vectorized::BlockSpillManager* _block_spill_mgr = nullptr;
 
     BfdParser* _bfd_parser = nullptr;
     BrokerMgr* _broker_mgr = nullptr;
@@ -227,6 +258,7 @@ private:
     StorageEngine* _storage_engine = nullptr;
 
     StreamLoadExecutor* _stream_load_executor = nullptr;
+    GroupCommitMgr* _group_commit_mgr = nullptr;
     RoutineLoadTaskExecutor* _routine_load_task_executor = nullptr;
     SmallFileMgr* _small_file_mgr = nullptr;
     HeartbeatFlags* _heartbeat_flags = nullptr;
@@ -21,10 +21,16 @@
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "gen_cpp/TPaloBrokerService.h"
+#include "io/cache/file_block_cache.h"
+#include "olap/delete_predicate_bitmap_cache.h"
 #include "olap/page_cache.h"
+#include "olap/page_cache_warmer.h"
 #include "olap/segment_loader.h"
+#include "olap/row_cache.h"
+#include "olap/segment_meta_cache.h"
 #include "olap/storage_engine.h"
 #include "olap/storage_policy_mgr.h"
+#include "pipeline/task_scheduler.h"
 #include "runtime/broker_mgr.h"
 #include "runtime/bufferpool/buffer_pool.h"
 #include "runtime/bufferpool/reservation_tracker.h"
@@ -42,14 +48,17 @@
 #include "runtime/load_path_mgr.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/mem_tracker_task_pool.h"
+#include "runtime/memory_reservation_mgr.h"
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/small_file_mgr.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/thread_resource_mgr.h"
 #include "runtime/tmp_file_mgr.h"
+#include "runtime/workload_group_mgr.h"
 #include "util/bfd_parser.h"
 #include "util/brpc_client_cache.h"
 #include "util/doris_metrics.h"
@@ -59,6 +68,9 @@
 #include "util/pretty_printer.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/priority_work_stealing_thread_pool.hpp"
+#include "vec/core/block_spill_manager.h"
+#include "vec/exec/scan/scanner_scheduler.h"
+#include "vec/functions/regex_cache.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 
 namespace doris {
@@ -116,15 +128,40 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::doris_scanner_thread_pool_queue_size)
             .build(&_limited_scan_thread_pool);
 
+    _scanner_scheduler = new vectorized::ScannerScheduler();
+    RETURN_IF_ERROR(_scanner_scheduler->init(this));
+
     ThreadPoolBuilder("SendBatchThreadPool")
             .set_min_threads(1)
             .set_max_threads(config::send_batch_thread_pool_thread_num)
             .set_max_queue_size(config::send_batch_thread_pool_queue_size)
             .build(&_send_batch_thread_pool);
 
+    ThreadPoolBuilder("JoinBuildThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::hash_join_build_thread_pool_thread_num)
+            .set_max_queue_size(config::hash_join_build_thread_pool_queue_size)
+            .build(&_join_build_thread_pool);
+
+    ThreadPoolBuilder("FileUploadThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::file_upload_thread_pool_thread_num)
+            .set_max_queue_size(config::file_upload_thread_pool_queue_size)
+            .build(&_file_upload_thread_pool);
+
+    ThreadPoolBuilder("SegmentWriterThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::segment_writer_thread_pool_thread_num)
+            .set_max_queue_size(config::segment_writer_thread_pool_queue_size)
+            .build(&_segment_writer_thread_pool);
+
+    _pipeline_task_scheduler = new pipeline::TaskScheduler();
+    RETURN_IF_ERROR(_pipeline_task_scheduler->start());
+
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size,
                                               config::etl_thread_pool_queue_size);
     _cgroups_mgr = new CgroupsMgr(this, config::doris_cgroups);
+    _workload_group_mgr = new WorkloadGroupMgr(this);
     _fragment_mgr = new FragmentMgr(this);
     _result_cache = new ResultCache(config::query_cache_max_size_mb,
                                     config::query_cache_elasticity_size_mb);
@@ -133,6 +170,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _load_path_mgr = new LoadPathMgr(this);
     _disk_io_mgr = new DiskIoMgr();
     _tmp_file_mgr = new TmpFileMgr(this);
+    _block_spill_mgr = new vectorized::BlockSpillManager(_tmp_file_mgr);
     _bfd_parser = BfdParser::create();
     _broker_mgr = new BrokerMgr(this);
     _load_channel_mgr = new LoadChannelMgr();
@@ -140,6 +178,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _internal_client_cache = new BrpcClientCache<PBackendService_Stub>();
     _function_client_cache = new BrpcClientCache<PFunctionService_Stub>();
     _stream_load_executor = new StreamLoadExecutor(this);
+    _group_commit_mgr = new GroupCommitMgr(this);
     _routine_load_task_executor = new RoutineLoadTaskExecutor(this);
     _small_file_mgr = new SmallFileMgr(this, config::small_file_dir);
     _storage_policy_mgr = new StoragePolicyMgr();
@@ -158,6 +197,14 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _broker_mgr->init();
     _small_file_mgr->init();
     _init_mem_tracker();
+    if (config::enable_query_memory_admission) {
+        int64_t capacity = _query_pool_mem_tracker->limit();
+        if (capacity > 0) {
+            capacity = capacity * config::query_admission_mem_limit_percent / 100;
+        }
+        _memory_reservation_mgr = new MemoryReservationMgr(
+                capacity, [this]() { return _query_pool_mem_tracker->consumption(); });
+    }
 
     RETURN_IF_ERROR(_load_channel_mgr->init(MemTracker::get_process_tracker()->limit()));
     _heartbeat_flags = new HeartbeatFlags();
@@ -254,16 +301,46 @@ Status ExecEnv::_init_mem_tracker() {
     }
     int32_t index_percentage = config::index_page_cache_percentage;
     uint32_t num_shards = config::storage_page_cache_shard_size;
-    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards);
+    CacheEvictionPolicy eviction_policy = CacheEvictionPolicy::LRU;
+    if (!parse_cache_eviction_policy(config::storage_page_cache_eviction_policy,
+                                     &eviction_policy)) {
+        LOG(WARNING) << "unknown storage_page_cache_eviction_policy "
+                     << config::storage_page_cache_eviction_policy << ", use LRU";
+    }
+    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards,
+                                          eviction_policy);
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
               << ", origin config value: " << config::storage_page_cache_limit;
+    int64_t decoded_cache_limit =
+            ParseUtil::parse_mem_spec(config::decoded_page_cache_limit, global_memory_limit_bytes,
+                                      MemInfo::physical_mem(), &is_percent);
+    if (config::enable_page_cache_warm_up && !config::disable_storage_page_cache) {
+        PageCacheWarmer::create_global_instance(config::page_cache_warm_up_max_pages);
+    }
+    if (decoded_cache_limit > 0) {
+        DecodedPageCache::create_global_cache(decoded_cache_limit, num_shards);
+        LOG(INFO) << "Decoded page cache memory limit: "
+                  << PrettyPrinter::print(decoded_cache_limit, TUnit::BYTES);
+    }
 
     SegmentLoader::create_global_instance(config::segment_cache_capacity);
+    SegmentMetaCache::create_global_instance(config::segment_meta_cache_bytes);
+    RowCache::create_global_instance(config::row_cache_bytes);
+    DeletePredicateBitmapCache::create_global_instance(
+            config::delete_predicate_bitmap_cache_bytes);
+    vectorized::RegexCache::create_global_instance(config::regex_cache_bytes);
+
+    if (config::enable_file_cache) {
+        RETURN_IF_ERROR(io::FileBlockCache::create_global_cache(
+                config::file_cache_path, config::file_cache_max_size,
+                config::file_cache_block_size));
+    }
 
     // 4. init other managers
     RETURN_IF_ERROR(_disk_io_mgr->init(global_memory_limit_bytes));
     RETURN_IF_ERROR(_tmp_file_mgr->init());
+    RETURN_IF_ERROR(_block_spill_mgr->init());
 
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
@@ -311,14 +388,26 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_load_channel_mgr);
     SAFE_DELETE(_broker_mgr);
     SAFE_DELETE(_bfd_parser);
+    SAFE_DELETE(_block_spill_mgr);
     SAFE_DELETE(_tmp_file_mgr);
     SAFE_DELETE(_disk_io_mgr);
     SAFE_DELETE(_load_path_mgr);
     SAFE_DELETE(_etl_job_mgr);
     SAFE_DELETE(_master_info);
+    if (_pipeline_task_scheduler != nullptr) {
+        _pipeline_task_scheduler->shutdown();
+    }
+    SAFE_DELETE(_pipeline_task_scheduler);
     SAFE_DELETE(_fragment_mgr);
+    // after the queries holding the reservations
+    SAFE_DELETE(_memory_reservation_mgr);
+    SAFE_DELETE(_workload_group_mgr);
     SAFE_DELETE(_cgroups_mgr);
     SAFE_DELETE(_etl_thread_pool);
+    if (_scanner_scheduler != nullptr) {
+        _scanner_scheduler->stop();
+    }
+    SAFE_DELETE(_scanner_scheduler);
     SAFE_DELETE(_scan_thread_pool);
     SAFE_DELETE(_thread_mgr);
     SAFE_DELETE(_broker_client_cache);
@@ -327,6 +416,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_result_mgr);
     SAFE_DELETE(_result_queue_mgr);
     SAFE_DELETE(_stream_mgr);
+    SAFE_DELETE(_group_commit_mgr);
     SAFE_DELETE(_stream_load_executor);
     SAFE_DELETE(_routine_load_task_executor);
     SAFE_DELETE(_external_scan_context_mgr);
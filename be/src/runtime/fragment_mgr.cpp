@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <sstream>
+#include <unordered_set>
 
 #include "agent/cgroups_mgr.h"
 #include "common/object_pool.h"
@@ -44,6 +45,7 @@
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_pipe.h"
 #include "runtime/thread_context.h"
+#include "runtime/workload_group_mgr.h"
 #include "service/backend_options.h"
 #include "util/debug_util.h"
 #include "util/doris_metrics.h"
@@ -57,6 +59,7 @@ namespace doris {
 
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(plan_fragment_count, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(timeout_canceled_fragment_count, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(descriptor_table_cache_hit_count, MetricUnit::NOUNIT);
 
 std::string to_load_error_http_path(const std::string& file_name) {
     if (file_name.empty()) {
@@ -92,6 +95,20 @@ public:
 
     Status execute();
 
+    // Whether the fragment could be executed in pipelines, which is not waiting for the
+    // execution trigger.
+    bool can_execute_in_pipeline() {
+        // the pipeline workers do not wait, a queued query is executed in a thread
+        bool admitted = _fragments_ctx == nullptr ||
+                        _fragments_ctx->memory_reservation == nullptr ||
+                        _fragments_ctx->memory_reservation->is_admitted();
+        return !_need_wait_execution_trigger && admitted && _executor.can_execute_in_pipeline();
+    }
+
+    // Executes the fragment in pipelines, the executor is closed before finish_callback
+    // is called by the pipeline worker.
+    Status execute_in_pipeline(std::function<void()> finish_callback);
+
     Status cancel_before_execute();
 
     Status cancel(const PPlanFragmentCancelReason& reason, const std::string& msg = "");
@@ -235,10 +252,20 @@ Status FragmentExecState::execute() {
         // is prepared but need to wait for the signal to do the rest execution.
         _fragments_ctx->wait_for_start();
     }
+    if (_fragments_ctx != nullptr && _fragments_ctx->memory_reservation != nullptr) {
+        // wait until the memory of the query is admitted, the fragments timed out are
+        // cancelled by the cancel worker of FragmentMgr
+        while (!_cancelled && !_fragments_ctx->memory_reservation->wait_for_admission(100)) {
+        }
+    }
     int64_t duration_ns = 0;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        CgroupsMgr::apply_system_cgroup();
+        if (_fragments_ctx != nullptr && _fragments_ctx->workload_group != nullptr) {
+            _fragments_ctx->workload_group->apply_cgroup();
+        } else {
+            CgroupsMgr::apply_system_cgroup();
+        }
         WARN_IF_ERROR(_executor.open(), strings::Substitute("Got error while opening fragment $0",
                                                             print_id(_fragment_instance_id)));
         _executor.close();
@@ -248,6 +275,24 @@ Status FragmentExecState::execute() {
     return Status::OK();
 }
 
+Status FragmentExecState::execute_in_pipeline(std::function<void()> finish_callback) {
+    int64_t start_ns = MonotonicNanos();
+    return _executor.execute_in_pipeline(
+            [this, start_ns, finish_callback = std::move(finish_callback)]() {
+                {
+#ifndef BE_TEST
+                    SCOPED_ATTACH_TASK_THREAD(executor()->runtime_state(),
+                                              executor()->runtime_state()->instance_mem_tracker());
+#endif
+                    _executor.close();
+                }
+                DorisMetrics::instance()->fragment_requests_total->increment(1);
+                DorisMetrics::instance()->fragment_request_duration_us->increment(
+                        (MonotonicNanos() - start_ns) / 1000);
+                finish_callback();
+            });
+}
+
 Status FragmentExecState::cancel_before_execute() {
     // set status as 'abort', cuz cancel() won't effect the status arg of DataSink::close().
 #ifndef BE_TEST
@@ -427,9 +472,11 @@ FragmentMgr::FragmentMgr(ExecEnv* exec_env)
         : _exec_env(exec_env),
           _fragment_map(),
           _fragments_ctx_map(),
-          _stop_background_threads_latch(1) {
+          _stop_background_threads_latch(1),
+          _desc_tbl_cache(std::max(config::descriptor_table_cache_capacity, 0)) {
     _entity = DorisMetrics::instance()->metric_registry()->register_entity("FragmentMgr");
     INT_UGAUGE_METRIC_REGISTER(_entity, timeout_canceled_fragment_count);
+    INT_COUNTER_METRIC_REGISTER(_entity, descriptor_table_cache_hit_count);
     REGISTER_HOOK_METRIC(plan_fragment_count, [this]() {
         std::lock_guard<std::mutex> lock(_lock);
         return _fragment_map.size();
@@ -448,6 +495,15 @@ FragmentMgr::FragmentMgr(ExecEnv* exec_env)
                 .set_max_queue_size(config::fragment_pool_queue_size)
                 .build(&_thread_pool);
     CHECK(s.ok()) << s.to_string();
+
+    if (config::fragment_prepare_thread_pool_thread_num > 0) {
+        s = ThreadPoolBuilder("FragmentPrepareThreadPool")
+                    .set_min_threads(1)
+                    .set_max_threads(config::fragment_prepare_thread_pool_thread_num)
+                    .set_max_queue_size(config::fragment_prepare_thread_pool_queue_size)
+                    .build(&_prepare_thread_pool);
+        CHECK(s.ok()) << s.to_string();
+    }
 }
 
 FragmentMgr::~FragmentMgr() {
@@ -459,6 +515,9 @@ FragmentMgr::~FragmentMgr() {
     // Stop all the worker, should wait for a while?
     // _thread_pool->wait_for();
     _thread_pool->shutdown();
+    if (_prepare_thread_pool != nullptr) {
+        _prepare_thread_pool->shutdown();
+    }
 
     // Only me can delete
     {
@@ -481,7 +540,11 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state, Fi
                               exec_state->executor()->runtime_state()->instance_mem_tracker());
 #endif
     exec_state->execute();
+    _finish_fragment(exec_state, cb);
+}
 
+void FragmentMgr::_finish_fragment(std::shared_ptr<FragmentExecState> exec_state,
+                                   FinishCallback cb) {
     std::shared_ptr<QueryFragmentsCtx> fragments_ctx = exec_state->get_fragments_ctx();
     bool all_done = false;
     if (fragments_ctx != nullptr) {
@@ -576,6 +639,53 @@ std::shared_ptr<StreamLoadPipe> FragmentMgr::get_pipe(const TUniqueId& fragment_
     }
 }
 
+Status FragmentMgr::exec_plan_fragments(TExecPlanFragmentParamsList& params_list) {
+    auto& all_params = params_list.paramsList;
+    for (size_t i = 0; i < all_params.size(); ++i) {
+        if (all_params[i].reuse_prev_fragment) {
+            if (i == 0) {
+                return Status::InternalError("the first fragment instance has no plan");
+            }
+            all_params[i].__set_fragment(all_params[i - 1].fragment);
+        }
+    }
+
+    // the instances with the full params create the query fragments context the simplified
+    // ones depend on, so they go first
+    std::vector<const TExecPlanFragmentParams*> simplified_params;
+    for (const auto& params : all_params) {
+        if (params.is_simplified_param) {
+            simplified_params.push_back(&params);
+        } else {
+            RETURN_IF_ERROR(exec_plan_fragment(params));
+        }
+    }
+    if (_prepare_thread_pool == nullptr || simplified_params.size() <= 1) {
+        for (auto* params : simplified_params) {
+            RETURN_IF_ERROR(exec_plan_fragment(*params));
+        }
+        return Status::OK();
+    }
+
+    std::vector<Status> statuses(simplified_params.size());
+    CountDownLatch latch(simplified_params.size());
+    for (size_t i = 0; i < simplified_params.size(); ++i) {
+        auto prepare = [this, &simplified_params, &statuses, &latch, i]() {
+            statuses[i] = exec_plan_fragment(*simplified_params[i]);
+            latch.count_down();
+        };
+        if (!_prepare_thread_pool->submit_func(prepare).ok()) {
+            // the pool is full, prepare it in this thread
+            prepare();
+        }
+    }
+    latch.wait();
+    for (const auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, FinishCallback cb) {
     const TUniqueId& fragment_instance_id = params.params.fragment_instance_id;
     {
@@ -605,8 +715,7 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
         // Create the query fragments context.
         fragments_ctx.reset(new QueryFragmentsCtx(params.fragment_num_on_host, _exec_env));
         fragments_ctx->query_id = params.params.query_id;
-        RETURN_IF_ERROR(DescriptorTbl::create(&(fragments_ctx->obj_pool), params.desc_tbl,
-                                              &(fragments_ctx->desc_tbl)));
+        RETURN_IF_ERROR(_create_desc_tbl(params.desc_tbl, fragments_ctx.get()));
         fragments_ctx->coord_addr = params.coord;
         fragments_ctx->query_globals = params.query_globals;
 
@@ -621,6 +730,28 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
             if (params.query_options.__isset.resource_limit) {
                 fragments_ctx->set_thread_token(params.query_options.resource_limit.cpu_limit);
             }
+            if (params.query_options.__isset.workload_group &&
+                !params.query_options.workload_group.empty()) {
+                const auto& group_name = params.query_options.workload_group;
+                fragments_ctx->workload_group =
+                        _exec_env->workload_group_mgr()->get_group(group_name);
+                if (fragments_ctx->workload_group == nullptr) {
+                    // the groups are managed by each BE, do not fail the query
+                    LOG(WARNING) << "workload group " << group_name << " of query "
+                                 << print_id(fragments_ctx->query_id)
+                                 << " does not exist, run it without any group";
+                }
+            }
+        }
+
+        if (_exec_env->memory_reservation_mgr() != nullptr) {
+            int64_t reservation = config::query_initial_reservation_bytes;
+            if (params.__isset.query_options && params.query_options.__isset.mem_limit &&
+                params.query_options.mem_limit > 0) {
+                reservation = std::min(reservation, params.query_options.mem_limit);
+            }
+            fragments_ctx->memory_reservation = _exec_env->memory_reservation_mgr()->reserve(
+                    fragments_ctx->query_id, reservation);
         }
 
         {
@@ -657,6 +788,17 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
         _cv.notify_all();
     }
 
+    if (exec_state->can_execute_in_pipeline()) {
+        auto st = exec_state->execute_in_pipeline(
+                [this, exec_state, cb]() { _finish_fragment(exec_state, cb); });
+        if (st.ok()) {
+            return Status::OK();
+        }
+        // nothing is executed, fall back to execute the fragment in a thread
+        LOG(WARNING) << "failed to execute fragment " << print_id(fragment_instance_id)
+                     << " in pipelines: " << st.get_error_msg();
+    }
+
     auto st = _thread_pool->submit_func(
             std::bind<void>(&FragmentMgr::_exec_actual, this, exec_state, cb));
     if (!st.ok()) {
@@ -721,10 +863,66 @@ void FragmentMgr::cancel_worker() {
             LOG(INFO) << "FragmentMgr cancel worker going to cancel timeout fragment "
                       << print_id(id);
         }
+        _cancel_queries_exceeding_group_mem_limit();
     } while (!_stop_background_threads_latch.wait_for(std::chrono::seconds(1)));
     LOG(INFO) << "FragmentMgr cancel worker is going to exit.";
 }
 
+Status FragmentMgr::_create_desc_tbl(const TDescriptorTable& thrift_tbl,
+                                     QueryFragmentsCtx* ctx) {
+    if (config::descriptor_table_cache_capacity <= 0) {
+        return DescriptorTbl::create(&(ctx->obj_pool), thrift_tbl, &(ctx->desc_tbl));
+    }
+    // the whole serialized table is the key, so that a table is never shared by mistake
+    ThriftSerializer serializer(false, 4096);
+    uint8_t* buf = nullptr;
+    uint32_t len = 0;
+    RETURN_IF_ERROR(serializer.serialize(const_cast<TDescriptorTable*>(&thrift_tbl), &len, &buf));
+    std::string key(reinterpret_cast<const char*>(buf), len);
+
+    std::shared_ptr<SharedDescriptorTbl> shared_tbl;
+    {
+        std::lock_guard<std::mutex> l(_desc_tbl_cache_lock);
+        _desc_tbl_cache.get(key, &shared_tbl);
+    }
+    if (shared_tbl != nullptr) {
+        descriptor_table_cache_hit_count->increment(1);
+    } else {
+        shared_tbl = std::make_shared<SharedDescriptorTbl>();
+        RETURN_IF_ERROR(
+                DescriptorTbl::create(&shared_tbl->obj_pool, thrift_tbl, &shared_tbl->desc_tbl));
+        std::lock_guard<std::mutex> l(_desc_tbl_cache_lock);
+        _desc_tbl_cache.put(key, shared_tbl);
+    }
+    ctx->shared_desc_tbl = shared_tbl;
+    ctx->desc_tbl = shared_tbl->desc_tbl;
+    return Status::OK();
+}
+
+void FragmentMgr::_cancel_queries_exceeding_group_mem_limit() {
+    std::vector<TUniqueId> query_ids;
+    _exec_env->workload_group_mgr()->get_queries_to_cancel(&query_ids);
+    if (query_ids.empty()) {
+        return;
+    }
+    std::unordered_set<TUniqueId> queries(query_ids.begin(), query_ids.end());
+    std::vector<TUniqueId> to_cancel;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (auto& it : _fragment_map) {
+            if (queries.count(it.second->query_id()) > 0) {
+                to_cancel.push_back(it.second->fragment_instance_id());
+            }
+        }
+    }
+    for (auto& id : to_cancel) {
+        LOG(INFO) << "FragmentMgr cancel worker going to cancel fragment " << print_id(id)
+                  << ", which uses the most memory of its workload group";
+        cancel(id, PPlanFragmentCancelReason::MEMORY_LIMIT_EXCEED,
+               "the workload group of the query exceeds its memory limit");
+    }
+}
+
 void FragmentMgr::debug(std::stringstream& ss) {
     // Keep things simple
     std::lock_guard<std::mutex> lock(_lock);
@@ -33,6 +33,7 @@
 #include "runtime_filter_mgr.h"
 #include "util/countdown_latch.h"
 #include "util/hash_util.hpp"
+#include "util/lru_cache.hpp"
 #include "util/metrics.h"
 #include "util/thread.h"
 
@@ -48,6 +49,8 @@ class TExecPlanFragmentParamsList;
 class TUniqueId;
 class RuntimeFilterMergeController;
 class StreamLoadPipe;
+class TDescriptorTable;
+struct SharedDescriptorTbl;
 
 std::string to_load_error_http_path(const std::string& file_name);
 
@@ -62,6 +65,11 @@ public:
     // execute one plan fragment
     Status exec_plan_fragment(const TExecPlanFragmentParams& params);
 
+    // Executes the fragment instances of a query sent in one request. The instances sharing
+    // the query fragments context created by an earlier one are prepared in parallel.
+    // The plans shared by the instances are filled in `params_list`.
+    Status exec_plan_fragments(TExecPlanFragmentParamsList& params_list);
+
     // TODO(zc): report this is over
     Status exec_plan_fragment(const TExecPlanFragmentParams& params, FinishCallback cb);
 
@@ -96,6 +104,16 @@ public:
 private:
     void _exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
 
+    // Removes the finished fragment and calls cb.
+    void _finish_fragment(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
+
+    // Cancels the query using the most memory of each workload group beyond its memory limit.
+    void _cancel_queries_exceeding_group_mem_limit();
+
+    // Sets the descriptor table of the query, the one created for the same thrift table
+    // by an earlier query is reused if it is still cached.
+    Status _create_desc_tbl(const TDescriptorTable& thrift_tbl, QueryFragmentsCtx* ctx);
+
     // This is input params
     ExecEnv* _exec_env;
 
@@ -112,11 +130,19 @@ private:
     scoped_refptr<Thread> _cancel_thread;
     // every job is a pool
     std::unique_ptr<ThreadPool> _thread_pool;
+    // prepares the instances of exec_plan_fragments(), nullptr if they are prepared in turn
+    std::unique_ptr<ThreadPool> _prepare_thread_pool;
 
     std::shared_ptr<MetricEntity> _entity = nullptr;
     UIntGauge* timeout_canceled_fragment_count = nullptr;
 
     RuntimeFilterMergeController _runtimefilter_controller;
+
+    std::mutex _desc_tbl_cache_lock;
+    // serialized TDescriptorTable -> descriptor table, the repeated queries of the same plan
+    // have the same descriptor tables
+    LruCache<std::string, std::shared_ptr<SharedDescriptorTbl>> _desc_tbl_cache;
+    IntCounter* descriptor_table_cache_hit_count = nullptr;
 };
 
 } // namespace doris
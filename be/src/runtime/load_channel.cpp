@@ -117,6 +117,24 @@ void LoadChannel::handle_mem_exceed_limit(bool force) {
     }
 }
 
+void LoadChannel::get_active_memtable_mem_consumption(std::vector<WriterMemItem>* writers_mem) {
+    std::vector<std::shared_ptr<TabletsChannel>> channels;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto& it : _tablets_channels) {
+            channels.push_back(it.second);
+        }
+    }
+    std::vector<std::pair<int64_t, int64_t>> tablets_mem;
+    for (auto& channel : channels) {
+        tablets_mem.clear();
+        channel->get_active_memtable_mem_consumption(&tablets_mem);
+        for (auto& [tablet_id, mem_size] : tablets_mem) {
+            writers_mem->push_back({channel, tablet_id, mem_size});
+        }
+    }
+}
+
 // lock should be held when calling this method
 bool LoadChannel::_find_largest_consumption_channel(std::shared_ptr<TabletsChannel>* channel) {
     int64_t max_consume = 0;
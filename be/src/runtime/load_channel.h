@@ -21,6 +21,7 @@
 #include <ostream>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/PaloInternalService_types.h"
@@ -35,6 +36,13 @@ namespace doris {
 
 class Cache;
 
+// the memtable accepting writes of a tablet in a load
+struct WriterMemItem {
+    std::shared_ptr<TabletsChannel> channel;
+    int64_t tablet_id;
+    int64_t mem_size;
+};
+
 // A LoadChannel manages tablets channels for all indexes
 // corresponding to a certain load job
 class LoadChannel {
@@ -48,8 +56,10 @@ public:
     Status open(const PTabletWriterOpenRequest& request);
 
     // this batch must belong to a index in one transaction
+    // `ctx` is passed to TabletsChannel::add_batch()
     template <typename TabletWriterAddRequest, typename TabletWriterAddResult>
-    Status add_batch(const TabletWriterAddRequest& request, TabletWriterAddResult* response);
+    Status add_batch(const TabletWriterAddRequest& request, TabletWriterAddResult* response,
+                     TabletWriterAddContext* ctx = nullptr);
 
     // return true if this load channel has been opened and all tablets channels are closed then.
     bool is_finished();
@@ -68,6 +78,9 @@ public:
 
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
 
+    // append the memtables accepting writes of all tablets channels to 'writers_mem'
+    void get_active_memtable_mem_consumption(std::vector<WriterMemItem>* writers_mem);
+
     int64_t timeout() const { return _timeout_s; }
 
     bool is_high_priority() const { return _is_high_priority; }
@@ -82,8 +95,10 @@ protected:
         bool finished = false;
         auto index_id = request.index_id();
         RETURN_IF_ERROR(channel->close(request.sender_id(), request.backend_id(), &finished,
-                                       request.partition_ids(), response->mutable_tablet_vec(),
-                                       response->mutable_tablet_errors()));
+                                       request.partition_ids(), request.slave_tablet_nodes(),
+                                       response->mutable_tablet_vec(),
+                                       response->mutable_tablet_errors(),
+                                       response->mutable_success_slave_tablet_node_ids()));
         if (finished) {
             std::lock_guard<std::mutex> l(_lock);
             _tablets_channels.erase(index_id);
@@ -128,7 +143,7 @@ private:
 
 template <typename TabletWriterAddRequest, typename TabletWriterAddResult>
 Status LoadChannel::add_batch(const TabletWriterAddRequest& request,
-                              TabletWriterAddResult* response) {
+                              TabletWriterAddResult* response, TabletWriterAddContext* ctx) {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     int64_t index_id = request.index_id();
     // 1. get tablets channel
@@ -145,13 +160,16 @@ Status LoadChannel::add_batch(const TabletWriterAddRequest& request,
     // 3. add batch to tablets channel
     if constexpr (std::is_same_v<TabletWriterAddRequest, PTabletWriterAddBatchRequest>) {
         if (request.has_row_batch()) {
-            RETURN_IF_ERROR(channel->add_batch(request, response));
+            RETURN_IF_ERROR(channel->add_batch(request, response, ctx));
         }
     } else {
         if (request.has_block()) {
-            RETURN_IF_ERROR(channel->add_batch(request, response));
+            RETURN_IF_ERROR(channel->add_batch(request, response, ctx));
         }
     }
+    if (ctx != nullptr && ctx->parked) {
+        return Status::OK();
+    }
 
     // 4. handle eos
     if (request.has_eos() && request.eos()) {
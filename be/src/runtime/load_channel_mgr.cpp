@@ -17,6 +17,8 @@
 
 #include "runtime/load_channel_mgr.h"
 
+#include <algorithm>
+
 #include "gutil/strings/substitute.h"
 #include "runtime/load_channel.h"
 #include "runtime/mem_tracker.h"
@@ -24,6 +26,7 @@
 #include "service/backend_options.h"
 #include "util/doris_metrics.h"
 #include "util/stopwatch.hpp"
+#include "util/time.h"
 
 namespace doris {
 
@@ -148,36 +151,120 @@ void LoadChannelMgr::_finish_load_channel(const UniqueId load_id) {
 }
 
 void LoadChannelMgr::_handle_mem_exceed_limit() {
-    // lock so that only one thread can check mem limit
-    std::lock_guard<std::mutex> l(_lock);
-    if (!_mem_tracker->limit_exceeded()) {
+    int64_t limit = _mem_tracker->limit();
+    if (limit <= 0) {
+        return;
+    }
+    int64_t soft_limit = limit * config::load_process_soft_mem_limit_percent / 100;
+    soft_limit = std::min(soft_limit, limit);
+    int64_t consumption = _mem_tracker->consumption();
+    if (consumption < soft_limit) {
         return;
     }
+    _schedule_memtable_flush(soft_limit);
 
-    int64_t max_consume = 0;
-    std::shared_ptr<LoadChannel> channel;
-    for (auto& kv : _load_channels) {
-        if (kv.second->is_high_priority()) {
-            // do not select high priority channel to reduce memory
-            // to avoid blocking them.
-            continue;
+    if (consumption < limit) {
+        // soft back pressure, the closer to the limit the longer the sender waits
+        int64_t delay_ms = config::load_process_max_back_pressure_delay_ms *
+                           (consumption - soft_limit) / std::max<int64_t>(limit - soft_limit, 1);
+        if (delay_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
         }
-        if (kv.second->mem_consumption() > max_consume) {
-            max_consume = kv.second->mem_consumption();
-            channel = kv.second;
+        return;
+    }
+
+    // wait for the flushes to release memory
+    MonotonicStopWatch watch;
+    watch.start();
+    while (_mem_tracker->consumption() >= limit) {
+        if (watch.elapsed_time() / NANOS_PER_MILLIS >= config::load_process_mem_limit_wait_ms) {
+            LOG(WARNING) << "load mem consumption " << _mem_tracker->consumption()
+                         << " still exceeds limit " << limit << " after waiting "
+                         << config::load_process_mem_limit_wait_ms << "ms";
+            break;
         }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        _schedule_memtable_flush(soft_limit);
     }
-    if (max_consume == 0) {
-        // should not happen, add log to observe
-        LOG(WARNING) << "failed to find suitable load channel when total load mem limit exceed";
+}
+
+void LoadChannelMgr::_schedule_memtable_flush(int64_t soft_limit) {
+    std::unique_lock<std::mutex> schedule_lock(_flush_schedule_lock, std::try_to_lock);
+    if (!schedule_lock.owns_lock()) {
+        // another thread is scheduling
+        return;
+    }
+    int64_t consumption = _mem_tracker->consumption();
+    if (consumption < soft_limit) {
         return;
     }
-    DCHECK(channel.get() != nullptr);
 
-    // force reduce mem limit of the selected channel
-    LOG(INFO) << "reducing memory of " << *channel << " because total load mem consumption "
-              << _mem_tracker->consumption() << " has exceeded limit " << _mem_tracker->limit();
-    channel->handle_mem_exceed_limit(true);
+    std::vector<std::shared_ptr<LoadChannel>> channels;
+    std::vector<std::shared_ptr<LoadChannel>> high_priority_channels;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto& kv : _load_channels) {
+            if (kv.second->is_high_priority()) {
+                high_priority_channels.push_back(kv.second);
+            } else {
+                channels.push_back(kv.second);
+            }
+        }
+    }
+    // do not flush the memtables of high priority loads to avoid blocking them,
+    // they are only counted to find out how much memory is being flushed.
+    std::vector<WriterMemItem> high_priority_writers;
+    for (auto& channel : high_priority_channels) {
+        channel->get_active_memtable_mem_consumption(&high_priority_writers);
+    }
+    std::vector<WriterMemItem> writers;
+    for (auto& channel : channels) {
+        channel->get_active_memtable_mem_consumption(&writers);
+    }
+
+    int64_t active_mem = 0;
+    for (auto& writer : high_priority_writers) {
+        active_mem += writer.mem_size;
+    }
+    for (auto& writer : writers) {
+        active_mem += writer.mem_size;
+    }
+    // the memory not held by the active memtables will be released by the flushes in progress
+    int64_t flushing_mem = std::max<int64_t>(consumption - active_mem, 0);
+    int64_t mem_to_flush = consumption - soft_limit;
+    if (flushing_mem >= mem_to_flush) {
+        return;
+    }
+
+    std::sort(writers.begin(), writers.end(),
+              [](const WriterMemItem& lhs, const WriterMemItem& rhs) {
+                  return lhs.mem_size > rhs.mem_size;
+              });
+    int counter = 0;
+    int64_t submitted_mem = 0;
+    for (auto& writer : writers) {
+        if (flushing_mem + submitted_mem >= mem_to_flush || writer.mem_size <= 0) {
+            break;
+        }
+        Status st = writer.channel->flush_active_memtable(writer.tablet_id);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to flush memtable of tablet " << writer.tablet_id
+                         << " to reduce load mem consumption, err: " << st;
+            continue;
+        }
+        ++counter;
+        submitted_mem += writer.mem_size;
+    }
+    if (counter > 0) {
+        LOG(INFO) << "flush " << counter << " memtables of " << submitted_mem
+                  << " bytes to reduce load mem consumption " << consumption
+                  << ", flushing: " << flushing_mem << ", soft limit: " << soft_limit
+                  << ", limit: " << _mem_tracker->limit();
+    } else if (flushing_mem == 0) {
+        // should not happen, add log to observe
+        LOG_EVERY_N(WARNING, 100) << "failed to find suitable memtable to flush when load mem consumption "
+                     << consumption << " exceeds soft limit " << soft_limit;
+    }
 }
 
 Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
@@ -52,8 +52,10 @@ public:
     // open a new load channel if not exist
     Status open(const PTabletWriterOpenRequest& request);
 
+    // `ctx` is passed to TabletsChannel::add_batch()
     template <typename TabletWriterAddRequest, typename TabletWriterAddResult>
-    Status add_batch(const TabletWriterAddRequest& request, TabletWriterAddResult* response);
+    Status add_batch(const TabletWriterAddRequest& request, TabletWriterAddResult* response,
+                     TabletWriterAddContext* ctx = nullptr);
 
     // cancel all tablet stream for 'load_id' load
     Status cancel(const PTabletWriterCancelRequest& request);
@@ -71,9 +73,13 @@ private:
                              const UniqueId& load_id, const Request& request);
 
     void _finish_load_channel(UniqueId load_id);
-    // check if the total load mem consumption exceeds limit.
-    // If yes, it will pick a load channel to try to reduce memory consumption.
+    // check if the total load mem consumption exceeds the soft limit.
+    // If yes, it will flush the largest memtables of all loads in background, and delay the
+    // caller to slow down the senders, or block it until the consumption drops below the limit.
     void _handle_mem_exceed_limit();
+    // submit the largest memtables to flush queue until the memtables being flushed bring the
+    // consumption down to 'soft_limit'.
+    void _schedule_memtable_flush(int64_t soft_limit);
 
     Status _start_bg_worker();
 
@@ -86,6 +92,8 @@ protected:
 
     // check the total load mem consumption of this Backend
     std::shared_ptr<MemTracker> _mem_tracker;
+    // only one thread schedules the memtables to flush at a time
+    std::mutex _flush_schedule_lock;
 
     CountDownLatch _stop_background_threads_latch;
     // thread to clean timeout load channels
@@ -118,7 +126,7 @@ Status LoadChannelMgr::_get_load_channel(std::shared_ptr<LoadChannel>& channel,
 
 template <typename TabletWriterAddRequest, typename TabletWriterAddResult>
 Status LoadChannelMgr::add_batch(const TabletWriterAddRequest& request,
-                                 TabletWriterAddResult* response) {
+                                 TabletWriterAddResult* response, TabletWriterAddContext* ctx) {
     UniqueId load_id(request.id());
     // 1. get load channel
     std::shared_ptr<LoadChannel> channel;
@@ -138,7 +146,10 @@ Status LoadChannelMgr::add_batch(const TabletWriterAddRequest& request,
     // 3. add batch to load channel
     // batch may not exist in request(eg: eos request without batch),
     // this case will be handled in load channel's add batch method.
-    RETURN_IF_ERROR(channel->add_batch(request, response));
+    RETURN_IF_ERROR(channel->add_batch(request, response, ctx));
+    if (ctx != nullptr && ctx->parked) {
+        return Status::OK();
+    }
 
     // 4. handle finish
     if (channel->is_finished()) {
@@ -179,7 +179,7 @@ void MemTracker::init_virtual() {
 }
 
 MemTracker::~MemTracker() {
-    consume(_untracked_mem.exchange(0)); // before memory_leak_check
+    consume(exchange_untracked_mem()); // before memory_leak_check
     // TCMalloc hook will be triggered during destructor memtracker, may cause crash.
     if (_label == "Process") STOP_THREAD_LOCAL_MEM_TRACKER(false);
     if (!_virtual && config::memory_leak_detection) MemTracker::memory_leak_check(this);
@@ -192,7 +192,7 @@ MemTracker::~MemTracker() {
             _child_tracker_it = _parent->_child_trackers.end();
         }
     }
-    DCHECK_EQ(_untracked_mem, 0);
+    DCHECK_EQ(exchange_untracked_mem(), 0);
 }
 
 void MemTracker::transfer_to_relative(MemTracker* dst, int64_t bytes) {
@@ -324,6 +324,8 @@ Status MemTracker::mem_limit_exceeded(RuntimeState* state, const std::string& de
 
 bool MemTracker::gc_memory(int64_t max_consumption) {
     if (max_consumption < 0) return true;
+    // Most trackers have no GC function, do not serialize the failed consumers on the lock.
+    if (_gc_functions.empty()) return consumption() > max_consumption;
     lock_guard<std::mutex> l(_gc_lock);
     int64_t pre_gc_consumption = consumption();
     // Check if someone gc'd before us
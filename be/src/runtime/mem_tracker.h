@@ -28,6 +28,7 @@
 
 #include "common/config.h"
 #include "common/status.h"
+#include "util/core_local.h"
 #include "util/mem_info.h"
 #include "util/runtime_profile.h"
 #include "util/spinlock.h"
@@ -196,21 +197,31 @@ public:
         }
     }
 
-    // When the accumulated untracked memory value exceeds the upper limit,
+    // When the accumulated untracked memory value of the current core exceeds the quantum,
     // the current value is returned and set to 0.
-    // Thread safety.
+    // Thread safety. The untracked memory is cached per core, so the threads consuming the
+    // same tracker do not contend on one atomic, and the tracker lags behind the real
+    // consumption by at most untracked_mem_quantum() on each core.
     int64_t add_untracked_mem(int64_t bytes) {
-        _untracked_mem += bytes;
-        if (std::abs(_untracked_mem) >= config::mem_tracker_consume_min_size_bytes) {
-            return _untracked_mem.exchange(0);
+        int64_t* untracked_mem = _untracked_mem.access();
+        int64_t value = __atomic_add_fetch(untracked_mem, bytes, __ATOMIC_RELAXED);
+        if (std::abs(value) >= untracked_mem_quantum()) {
+            return __atomic_exchange_n(untracked_mem, 0, __ATOMIC_RELAXED);
         }
         return 0;
     }
 
+    // The untracked memory cached on a core, mem_tracker_consume_min_size_bytes is shared
+    // by all the cores, but at least 64KB on each core to keep the consumption batched.
+    int64_t untracked_mem_quantum() const {
+        int64_t quantum = config::mem_tracker_consume_min_size_bytes / _untracked_mem.size();
+        return std::max<int64_t>(quantum, 64 * 1024);
+    }
+
     // In most cases, no need to call flush_untracked_mem on the child tracker,
     // because when it is destructed, theoretically all its children have been destructed.
     void flush_untracked_mem() {
-        consume(_untracked_mem.exchange(0));
+        consume(exchange_untracked_mem());
         for (const auto& tracker_weak : _child_trackers) {
             std::shared_ptr<MemTracker> tracker = tracker_weak.lock();
             if (tracker) tracker->flush_untracked_mem();
@@ -241,7 +252,7 @@ public:
         if (consume_bytes != 0) {
             Status st = try_consume(consume_bytes);
             if (!st) {
-                _untracked_mem += consume_bytes;
+                __atomic_add_fetch(_untracked_mem.access(), consume_bytes, __ATOMIC_RELAXED);
                 return st;
             }
         }
@@ -352,6 +363,13 @@ public:
             if (tracker) tracker->_limit_trackers.push_back(this);
         }
     }
+    // Changes the limit of a tracker which already has a limit, the ancestors and the
+    // children see the new limit at once.
+    void update_limit(int64_t limit) {
+        DCHECK(has_limit());
+        DCHECK_GE(limit, 0);
+        _limit = limit;
+    }
     bool has_limit() const { return _limit >= 0; }
 
     Status check_limit(int64_t bytes) {
@@ -474,6 +492,15 @@ private:
         return Status::OK();
     }
 
+    // Returns the untracked memory of all the cores and sets them to 0.
+    int64_t exchange_untracked_mem() {
+        int64_t bytes = 0;
+        for (size_t i = 0; i < _untracked_mem.size(); ++i) {
+            bytes += __atomic_exchange_n(_untracked_mem.access_at_core(i), 0, __ATOMIC_RELAXED);
+        }
+        return bytes;
+    }
+
     // Walks the MemTracker hierarchy and populates _all_trackers and
     // limit_trackers_
     void init();
@@ -511,8 +538,8 @@ private:
     std::shared_ptr<RuntimeProfile::HighWaterMarkCounter> _consumption; // in bytes
 
     // Consume size smaller than mem_tracker_consume_min_size_bytes will continue to accumulate
-    // to avoid frequent calls to consume/release of MemTracker.
-    std::atomic<int64_t> _untracked_mem = 0;
+    // to avoid frequent calls to consume/release of MemTracker. Accessed with atomic builtins.
+    CoreLocalValue<int64_t> _untracked_mem;
 
     std::vector<MemTracker*> _all_trackers;   // this tracker plus all of its ancestors
     std::vector<MemTracker*> _limit_trackers; // _all_trackers with valid limits
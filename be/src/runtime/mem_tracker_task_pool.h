@@ -34,8 +34,10 @@ public:
                                                                int64_t mem_limit,
                                                                const std::string& label,
                                                                std::shared_ptr<MemTracker> parent);
-    std::shared_ptr<MemTracker> register_query_mem_tracker(const std::string& query_id,
-                                                           int64_t mem_limit);
+    // The parent of the query tracker is the query pool tracker if 'parent' is nullptr.
+    std::shared_ptr<MemTracker> register_query_mem_tracker(
+            const std::string& query_id, int64_t mem_limit,
+            std::shared_ptr<MemTracker> parent = nullptr);
     std::shared_ptr<MemTracker> register_load_mem_tracker(const std::string& load_id,
                                                           int64_t mem_limit);
 
@@ -38,6 +38,7 @@ ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_local_core_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_other_core_alloc_count, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_other_numa_node_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_free_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_cost_ns, MetricUnit::NANOSECONDS);
@@ -45,6 +46,7 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_free_cost_ns, MetricUnit:
 
 static IntCounter* chunk_pool_local_core_alloc_count;
 static IntCounter* chunk_pool_other_core_alloc_count;
+static IntCounter* chunk_pool_other_numa_node_alloc_count;
 static IntCounter* chunk_pool_system_alloc_count;
 static IntCounter* chunk_pool_system_free_count;
 static IntCounter* chunk_pool_system_alloc_cost_ns;
@@ -128,6 +130,8 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
             DorisMetrics::instance()->metric_registry()->register_entity("chunk_allocator");
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_local_core_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_other_core_alloc_count);
+    INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity,
+                                chunk_pool_other_numa_node_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_free_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_alloc_cost_ns);
@@ -136,7 +140,7 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
 
 Status ChunkAllocator::allocate(size_t size, Chunk* chunk, MemTracker* tracker, bool check_limits) {
     MemTracker* reset_tracker =
-            tracker ? tracker : tls_ctx()->_thread_mem_tracker_mgr->mem_tracker().get();
+            tracker ? tracker : tls_ctx()->_thread_mem_tracker_mgr->raw_mem_tracker();
     // In advance, transfer the memory ownership of allocate from ChunkAllocator::tracker to the parameter tracker.
     // Next, if the allocate is successful, it will exit normally;
     // if the allocate fails, return this part of the memory to the parameter tracker.
@@ -159,17 +163,19 @@ Status ChunkAllocator::allocate(size_t size, Chunk* chunk, MemTracker* tracker,
         return Status::OK();
     }
     if (_reserved_bytes > size) {
-        // try to allocate from other core's arena
-        ++core_id;
-        for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                DCHECK_GE(_reserved_bytes, 0);
-                _reserved_bytes.fetch_sub(size);
-                chunk_pool_other_core_alloc_count->increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
-                return Status::OK();
-            }
+        // try to allocate from other core's arena, the memory of the other NUMA nodes is
+        // not reused if NUMA affinity is enabled
+        bool popped = _pop_from_other_arenas(size, core_id, true, chunk);
+        if (!popped && !CpuInfo::is_numa_affinity_enabled() &&
+            _pop_from_other_arenas(size, core_id, false, chunk)) {
+            popped = true;
+            chunk_pool_other_numa_node_alloc_count->increment(1);
+        }
+        if (popped) {
+            DCHECK_GE(_reserved_bytes, 0);
+            _reserved_bytes.fetch_sub(size);
+            chunk_pool_other_core_alloc_count->increment(1);
+            return Status::OK();
         }
     }
 
@@ -190,13 +196,42 @@ Status ChunkAllocator::allocate(size_t size, Chunk* chunk, MemTracker* tracker,
     return Status::OK();
 }
 
+bool ChunkAllocator::_pop_from_other_arenas(size_t size, int core_id, bool same_numa_node,
+                                            Chunk* chunk) {
+    if (same_numa_node) {
+        const auto& cores = CpuInfo::get_cores_of_same_numa_node(core_id);
+        int idx = CpuInfo::get_numa_node_core_idx(core_id);
+        for (int i = 1; i < cores.size(); ++i) {
+            int other = cores[(idx + i) % cores.size()];
+            if (_arenas[other]->pop_free_chunk(size, &chunk->data)) {
+                // reset chunk's core_id to other
+                chunk->core_id = other;
+                return true;
+            }
+        }
+        return false;
+    }
+    int numa_node = CpuInfo::get_numa_node_of_core(core_id);
+    for (int i = 1; i < _arenas.size(); ++i) {
+        int other = (core_id + i) % _arenas.size();
+        if (CpuInfo::get_numa_node_of_core(other) == numa_node) {
+            continue;
+        }
+        if (_arenas[other]->pop_free_chunk(size, &chunk->data)) {
+            chunk->core_id = other;
+            return true;
+        }
+    }
+    return false;
+}
+
 void ChunkAllocator::free(const Chunk& chunk, MemTracker* tracker) {
     // The chunk's memory ownership is transferred from tls tracker to ChunkAllocator.
     if (tracker) {
         tracker->transfer_to(_mem_tracker.get(), chunk.size);
     } else {
-        tls_ctx()->_thread_mem_tracker_mgr->mem_tracker()->transfer_to(_mem_tracker.get(),
-                                                                       chunk.size);
+        tls_ctx()->_thread_mem_tracker_mgr->raw_mem_tracker()->transfer_to(_mem_tracker.get(),
+                                                                           chunk.size);
     }
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     if (chunk.core_id == -1) {
@@ -38,7 +38,9 @@ class Status;
 // ChunkAllocator has one ChunkArena for each CPU core, it will try to allocate
 // memory from current core arena firstly. In this way, there will be no lock contention
 // between concurrently-running threads. If this fails, ChunkAllocator will try to allocate
-// memory from other core's arena.
+// memory from other core's arena, the arenas of the cores on the same NUMA node first.
+// If NUMA affinity is enabled, the chunks are never reused across the NUMA nodes, a chunk
+// cached on the other node is left there and a local one is allocated from system.
 //
 // Memory Reservation
 // ChunkAllocator has a limit about how much free chunk bytes it can reserve, above which
@@ -75,6 +77,10 @@ public:
     void free(const Chunk& chunk, MemTracker* tracker = nullptr);
 
 private:
+    // Pops a free chunk from the arenas of the other cores than core_id, on the same NUMA
+    // node of core_id if same_numa_node is true, otherwise on the other nodes.
+    bool _pop_from_other_arenas(size_t size, int core_id, bool same_numa_node, Chunk* chunk);
+
     static ChunkAllocator* _s_instance;
 
     size_t _reserve_bytes_limit;
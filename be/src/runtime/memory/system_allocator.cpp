@@ -19,11 +19,17 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <linux/mempolicy.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <vector>
 
 #include "common/config.h"
 #include "common/logging.h"
 #include "runtime/thread_context.h"
+#include "util/cpu_info.h"
 
 namespace doris {
 
@@ -76,7 +82,27 @@ uint8_t* SystemAllocator::allocate_via_mmap(size_t length) {
         RELEASE_THREAD_LOCAL_MEM_TRACKER(length);
         return nullptr;
     }
+    if (CpuInfo::is_numa_affinity_enabled()) {
+        bind_to_numa_node(ptr, length, CpuInfo::get_current_numa_node());
+    }
     return ptr;
 }
 
+void SystemAllocator::bind_to_numa_node(uint8_t* ptr, size_t length, int node) {
+    // The pages are not faulted in yet, prefer the node rather than bind to it, so the
+    // allocation does not fail when the node runs out of memory. mbind is called via
+    // syscall to not depend on libnuma.
+    constexpr size_t kMaskBits = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> node_mask(CpuInfo::get_max_num_numa_nodes() / kMaskBits + 1, 0);
+    node_mask[node / kMaskBits] |= 1UL << (node % kMaskBits);
+    long res = syscall(SYS_mbind, ptr, length, MPOL_PREFERRED, node_mask.data(),
+                       node_mask.size() * kMaskBits, 0);
+    if (res != 0) {
+        char buf[64];
+        LOG_FIRST_N(WARNING, 5) << "fail to bind memory to NUMA node " << node
+                                << " via mbind, errno=" << errno
+                                << ", errmsg=" << strerror_r(errno, buf, 64);
+    }
+}
+
 } // namespace doris
@@ -23,7 +23,8 @@
 namespace doris {
 
 // Allocate memory from system allocator, this allocator can be configured
-// to allocate memory via mmap or malloc.
+// to allocate memory via mmap or malloc. The memory allocated via mmap is placed on
+// the NUMA node of the allocating thread if NUMA affinity is enabled.
 class SystemAllocator {
 public:
     static uint8_t* allocate(size_t length);
@@ -33,6 +34,7 @@ public:
 private:
     static uint8_t* allocate_via_mmap(size_t length);
     static uint8_t* allocate_via_malloc(size_t length);
+    static void bind_to_numa_node(uint8_t* ptr, size_t length, int node);
 };
 
 } // namespace doris
@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory_reservation_mgr.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/exec_env.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+QueryMemoryReservation::~QueryMemoryReservation() {
+    _mgr->_release(this);
+}
+
+bool QueryMemoryReservation::is_admitted() const {
+    std::lock_guard l(_mgr->_lock);
+    return _admitted;
+}
+
+bool QueryMemoryReservation::wait_for_admission(int64_t timeout_ms) {
+    std::unique_lock l(_mgr->_lock);
+    if (!_admitted) {
+        // the consumption of the queries is not notified, try again on timeout
+        _mgr->_admit_locked();
+    }
+    return _mgr->_cv.wait_for(l, std::chrono::milliseconds(timeout_ms),
+                              [this]() { return _admitted; });
+}
+
+std::shared_ptr<QueryMemoryReservation> MemoryReservationMgr::reserve(const TUniqueId& query_id,
+                                                                      int64_t bytes) {
+    std::shared_ptr<QueryMemoryReservation> reservation(
+            new QueryMemoryReservation(this, query_id, std::max<int64_t>(bytes, 0)));
+    std::lock_guard l(_lock);
+    _queue.push_back(reservation.get());
+    _admit_locked();
+    if (!reservation->_admitted) {
+        LOG(INFO) << "query " << print_id(query_id) << " is queued for memory, reservation: "
+                  << bytes << ", reserved: " << _reserved_bytes << ", queued: " << _queue.size();
+    }
+    return reservation;
+}
+
+int64_t MemoryReservationMgr::reserved_bytes() const {
+    std::lock_guard l(_lock);
+    return _reserved_bytes;
+}
+
+int MemoryReservationMgr::queued_num() const {
+    std::lock_guard l(_lock);
+    return _queue.size();
+}
+
+int64_t MemoryReservationMgr::spill_threshold(int64_t threshold) {
+    auto* mgr = ExecEnv::GetInstance()->memory_reservation_mgr();
+    if (mgr == nullptr || mgr->queued_num() == 0) {
+        return threshold;
+    }
+    return threshold * config::spill_threshold_percent_under_pressure / 100;
+}
+
+void MemoryReservationMgr::_release(QueryMemoryReservation* reservation) {
+    std::lock_guard l(_lock);
+    if (reservation->_admitted) {
+        _reserved_bytes -= reservation->_bytes;
+    } else {
+        _queue.erase(std::find(_queue.begin(), _queue.end(), reservation));
+    }
+    _admit_locked();
+}
+
+void MemoryReservationMgr::_admit_locked() {
+    bool admitted = false;
+    while (!_queue.empty() && _can_admit_locked(_queue.front()->_bytes)) {
+        auto* reservation = _queue.front();
+        _queue.pop_front();
+        reservation->_admitted = true;
+        _reserved_bytes += reservation->_bytes;
+        admitted = true;
+    }
+    if (admitted) {
+        _cv.notify_all();
+    }
+}
+
+bool MemoryReservationMgr::_can_admit_locked(int64_t bytes) const {
+    if (_capacity <= 0 || _reserved_bytes == 0) {
+        return true;
+    }
+    int64_t used = std::max(_reserved_bytes, _consumption ? _consumption() : 0);
+    return used + bytes <= _capacity;
+}
+
+} // namespace doris
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "gen_cpp/Types_types.h"
+
+namespace doris {
+
+class MemoryReservationMgr;
+
+// The memory reserved by a query on this BE when its first fragment arrives, the fragments
+// do not start until the reservation is admitted. It is released when destroyed.
+class QueryMemoryReservation {
+public:
+    ~QueryMemoryReservation();
+
+    const TUniqueId& query_id() const { return _query_id; }
+    int64_t bytes() const { return _bytes; }
+
+    bool is_admitted() const;
+    // Returns whether the reservation is admitted in `timeout_ms`.
+    bool wait_for_admission(int64_t timeout_ms);
+
+private:
+    friend class MemoryReservationMgr;
+
+    QueryMemoryReservation(MemoryReservationMgr* mgr, const TUniqueId& query_id, int64_t bytes)
+            : _mgr(mgr), _query_id(query_id), _bytes(bytes) {}
+
+    MemoryReservationMgr* _mgr;
+    const TUniqueId _query_id;
+    const int64_t _bytes;
+    // protected by the lock of _mgr
+    bool _admitted = false;
+};
+
+// Admits the queries by their memory reservations against the memory of the query pool.
+// A reservation is admitted if the reserved bytes, or the memory consumed by the queries if
+// it is larger, plus the reservation fit in the capacity, otherwise it is queued and
+// admitted in order once the memory is released. A reservation is always admitted if
+// nothing is reserved, so that a large query is never queued forever.
+//
+// The spilling operators cooperate by spilling earlier while any query is queued, see
+// spill_threshold().
+class MemoryReservationMgr {
+public:
+    // `capacity` <= 0 means no limit, `consumption` returns the memory consumed by queries.
+    MemoryReservationMgr(int64_t capacity, std::function<int64_t()> consumption)
+            : _capacity(capacity), _consumption(std::move(consumption)) {}
+
+    std::shared_ptr<QueryMemoryReservation> reserve(const TUniqueId& query_id, int64_t bytes);
+
+    int64_t reserved_bytes() const;
+    int queued_num() const;
+
+    // The threshold of a spilling operator, lowered by `spill_threshold_percent_under_pressure`
+    // while queries are queued for memory. Returns `threshold` itself if there is no
+    // MemoryReservationMgr in ExecEnv.
+    static int64_t spill_threshold(int64_t threshold);
+
+private:
+    friend class QueryMemoryReservation;
+
+    void _release(QueryMemoryReservation* reservation);
+    void _admit_locked();
+    bool _can_admit_locked(int64_t bytes) const;
+
+    const int64_t _capacity;
+    const std::function<int64_t()> _consumption;
+
+    mutable std::mutex _lock;
+    std::condition_variable _cv;
+    int64_t _reserved_bytes = 0;
+    // the reservations not admitted yet, in order of arrival
+    std::deque<QueryMemoryReservation*> _queue;
+};
+
+} // namespace doris
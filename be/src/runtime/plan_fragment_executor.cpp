@@ -29,6 +29,7 @@
 #include "exec/exec_node.h"
 #include "exec/scan_node.h"
 #include "exprs/expr.h"
+#include "pipeline/pipeline_fragment_context.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
@@ -223,6 +224,17 @@ Status PlanFragmentExecutor::open() {
     // may block
     // TODO: if no report thread is started, make sure to send a final profile
     // at end, otherwise the coordinator hangs in case we finish w/ an error
+    _start_report_thread();
+    Status status = Status::OK();
+    if (_runtime_state->enable_vectorized_exec()) {
+        status = open_vectorized_internal();
+    } else {
+        status = open_internal();
+    }
+    return _handle_execution_status(status);
+}
+
+void PlanFragmentExecutor::_start_report_thread() {
     if (_is_report_success && _report_status_cb && config::status_report_interval > 0) {
         std::unique_lock<std::mutex> l(_report_thread_lock);
         _report_thread = std::thread(&PlanFragmentExecutor::report_profile, this);
@@ -230,13 +242,9 @@ Status PlanFragmentExecutor::open() {
         // with stop_report_thread()
         _report_thread_started_cv.wait(l);
     }
-    Status status = Status::OK();
-    if (_runtime_state->enable_vectorized_exec()) {
-        status = open_vectorized_internal();
-    } else {
-        status = open_internal();
-    }
+}
 
+Status PlanFragmentExecutor::_handle_execution_status(Status status) {
     if (!status.ok() && !status.is_cancelled() && _runtime_state->log_has_space()) {
         // Log error message in addition to returning in Status. Queries that do not
         // fetch results (e.g. insert) may not receive the message directly and can
@@ -255,6 +263,72 @@ Status PlanFragmentExecutor::open() {
     return status;
 }
 
+bool PlanFragmentExecutor::can_execute_in_pipeline() {
+    return config::enable_pipeline_engine && _prepared &&
+           _runtime_state->enable_vectorized_exec() &&
+           pipeline::PipelineFragmentContext::is_supported(_plan, _sink.get());
+}
+
+Status PlanFragmentExecutor::execute_in_pipeline(std::function<void()> finish_callback) {
+    DCHECK(can_execute_in_pipeline());
+    auto ctx = std::make_shared<pipeline::PipelineFragmentContext>(
+            _runtime_state.get(), _plan, _sink.get(),
+            [this]() {
+                // Collect this plan and sub plan statistics, and send to parent plan.
+                if (_collect_query_statistics_with_every_batch) {
+                    _collect_query_statistics();
+                }
+            },
+            [this](const Status& status) { _pipeline_finished(status); });
+    RETURN_IF_ERROR(ctx->prepare());
+
+    TAG(LOG(INFO))
+            .log("PlanFragmentExecutor::execute_in_pipeline")
+            .query_id(_query_id)
+            .instance_id(_runtime_state->fragment_instance_id());
+    _pipeline_ctx = ctx;
+    _pipeline_finish_callback = std::move(finish_callback);
+    _start_report_thread();
+    Status st = ctx->submit();
+    if (!st.ok()) {
+        stop_report_thread();
+        _pipeline_finish_callback = nullptr;
+        _pipeline_ctx.reset();
+    }
+    return st;
+}
+
+void PlanFragmentExecutor::_pipeline_finished(Status status) {
+    {
+        SCOPED_ATTACH_TASK_THREAD(_runtime_state.get(), _runtime_state->instance_mem_tracker());
+        if (status.ok()) {
+            status = _close_sink_in_pipeline();
+        }
+        _handle_execution_status(status);
+    }
+    // the executor may be released by the callback
+    auto finish_callback = std::move(_pipeline_finish_callback);
+    finish_callback();
+}
+
+Status PlanFragmentExecutor::_close_sink_in_pipeline() {
+    SCOPED_TIMER(profile()->total_time_counter());
+    _collect_query_statistics();
+    Status status;
+    {
+        std::lock_guard<std::mutex> l(_status_lock);
+        status = _status;
+    }
+    RETURN_IF_ERROR(_sink->close(runtime_state(), status));
+    // Setting to NULL ensures that the d'tor won't double-close the sink.
+    _sink.reset(nullptr);
+    _done = true;
+
+    stop_report_thread();
+    send_report(true);
+    return Status::OK();
+}
+
 Status PlanFragmentExecutor::open_vectorized_internal() {
     {
         SCOPED_CPU_TIMER(_fragment_cpu_timer);
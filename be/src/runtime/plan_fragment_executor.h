@@ -22,6 +22,7 @@
 
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "common/object_pool.h"
@@ -50,6 +51,10 @@ class TPlanFragment;
 class TPlanFragmentExecParams;
 class TPlanExecParams;
 
+namespace pipeline {
+class PipelineFragmentContext;
+}
+
 // PlanFragmentExecutor handles all aspects of the execution of a single plan fragment,
 // including setup and tear-down, both in the success and error case.
 // Tear-down frees all memory allocated for this plan fragment and closes all data
@@ -112,6 +117,16 @@ public:
     // time when open() returns, and the status-reporting thread will have been stopped.
     Status open();
 
+    // Whether the fragment could be executed by execute_in_pipeline(), see
+    // config::enable_pipeline_engine.
+    bool can_execute_in_pipeline();
+
+    // Executes the fragment in pipelines instead of open(), it returns once the tasks are
+    // scheduled and `finish_callback` is called by a pipeline worker when the execution
+    // finishes, the executor could be closed then. If an error is returned, nothing is
+    // executed and the fragment could still be executed by open().
+    Status execute_in_pipeline(std::function<void()> finish_callback);
+
     // Return results through 'batch'. Sets '*batch' to nullptr if no more results.
     // '*batch' is owned by PlanFragmentExecutor and must not be deleted.
     // When *batch == nullptr, get_next() should not be called anymore. Also, report_status_cb
@@ -199,6 +214,10 @@ private:
     std::unique_ptr<RowBatch> _row_batch;
     std::unique_ptr<doris::vectorized::Block> _block;
 
+    // Set if the fragment is executed in pipelines.
+    std::shared_ptr<pipeline::PipelineFragmentContext> _pipeline_ctx;
+    std::function<void()> _pipeline_finish_callback;
+
     // Number of rows returned by this fragment
     RuntimeProfile::Counter* _rows_produced_counter;
 
@@ -243,6 +262,16 @@ private:
     Status open_internal();
     Status open_vectorized_internal();
 
+    // Logs the error of the execution and sets _status.
+    Status _handle_execution_status(Status status);
+
+    void _start_report_thread();
+
+    // Called by the pipeline worker finishing the last task of the fragment.
+    void _pipeline_finished(Status status);
+    // The end of open_vectorized_internal() in pipelines.
+    Status _close_sink_in_pipeline();
+
     // Executes get_next() logic and returns resulting status.
     Status get_next_internal(RowBatch** batch);
     Status get_vectorized_internal(::doris::vectorized::Block** block);
@@ -25,14 +25,26 @@
 #include "gen_cpp/Types_types.h"               // for TUniqueId
 #include "runtime/datetime_value.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory_reservation_mgr.h"
+#include "runtime/runtime_filter_mgr.h"
+#include "runtime/workload_group.h"
 #include "util/threadpool.h"
+#include "vec/runtime/shared_hash_table_controller.h"
 
 namespace doris {
 
+class DescriptorTbl;
+
+// A descriptor table shared by the queries of the same thrift descriptor table, the table
+// is not modified once created.
+struct SharedDescriptorTbl {
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+};
+
 // Save the common components of fragments in a query.
 // Some components like DescriptorTbl may be very large
 // that will slow down each execution of fragments when DeSer them every time.
-class DescriptorTbl;
 class QueryFragmentsCtx {
 public:
     QueryFragmentsCtx(int total_fragment_num, ExecEnv* exec_env)
@@ -62,6 +74,10 @@ public:
 
     ThreadPoolToken* get_token() { return _thread_token.get(); }
 
+    vectorized::SharedHashTableController* get_shared_hash_table_controller() {
+        return &_shared_hash_table_controller;
+    }
+
     void set_ready_to_execute() {
         {
             std::lock_guard<std::mutex> l(_start_lock);
@@ -80,6 +96,8 @@ public:
 public:
     TUniqueId query_id;
     DescriptorTbl* desc_tbl;
+    // the owner of desc_tbl if it is shared with other queries
+    std::shared_ptr<SharedDescriptorTbl> shared_desc_tbl;
     bool set_rsc_info = false;
     std::string user;
     std::string group;
@@ -96,6 +114,12 @@ public:
     std::atomic<int> fragment_num;
     int timeout_second;
     ObjectPool obj_pool;
+    // The workload group of the query, nullptr if the query does not belong to any group.
+    std::shared_ptr<WorkloadGroup> workload_group;
+    // The memory reserved by the query, nullptr if there is no admission control.
+    std::shared_ptr<QueryMemoryReservation> memory_reservation;
+    // Merges the runtime filters built by the instances of this query on this BE.
+    RuntimeFilterLocalMerger runtime_filter_local_merger;
 
 private:
     ExecEnv* _exec_env;
@@ -108,6 +132,9 @@ private:
     // If this token is not set, the scanner will be executed in "_scan_thread_pool" in exec env.
     std::unique_ptr<ThreadPoolToken> _thread_token;
 
+    // Shares the hash tables of broadcast joins among the instances of this query.
+    vectorized::SharedHashTableController _shared_hash_table_controller;
+
     std::mutex _start_lock;
     std::condition_variable _start_cond;
     // Only valid when _need_wait_execution_trigger is set to true in FragmentExecState.
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gutil/strings/split.h"
@@ -173,16 +174,44 @@ Status KafkaDataConsumer::assign_topic_partitions(
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
+Status KafkaDataConsumer::group_consume(BlockingQueue<KafkaMessageBatch*>* queue,
                                         int64_t max_running_time_ms) {
     static constexpr int MAX_RETRY_TIMES_FOR_TRANSPORT_FAILURE = 3;
+    // a batch is put once its msgs reach this size, whatever the batch size is
+    static constexpr size_t MAX_BATCH_BYTES = 64 * 1024;
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id
               << ", max running time(ms): " << left_time;
 
+    const size_t max_batch_size =
+            config::enable_routine_load_adaptive_consume
+                    ? std::max(config::routine_load_max_consume_batch_size, 1)
+                    : 1;
     int64_t received_rows = 0;
     int64_t put_rows = 0;
     int32_t retry_times = 0;
+    size_t batch_size = 1;
+    size_t batch_bytes = 0;
+    std::unique_ptr<KafkaMessageBatch> batch;
+    // return false if the queue is shutdown
+    auto put_batch = [&]() {
+        // the group is waiting for msgs, so the pipe keeps up with the consumers
+        bool group_waiting = queue->get_size() == 0;
+        size_t num_msgs = batch->size();
+        if (!queue->blocking_put(batch.get())) {
+            return false;
+        }
+        batch.release(); // release the ownership, msgs will be deleted after being processed
+        put_rows += num_msgs;
+        batch_bytes = 0;
+        if (group_waiting) {
+            batch_size = std::min(batch_size * 2, max_batch_size);
+        } else {
+            batch_size = std::max<size_t>(batch_size / 2, 1);
+        }
+        return true;
+    };
+
     Status st = Status::OK();
     MonotonicStopWatch consumer_watch;
     MonotonicStopWatch watch;
@@ -200,9 +229,11 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
         }
 
         bool done = false;
-        // consume 1 message at a time
+        // consume 1 message at a time, do not wait if there are msgs to put
+        bool has_pending = batch != nullptr && !batch->empty();
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        std::unique_ptr<RdKafka::Message> msg(
+                _k_consumer->consume(has_pending ? 0 : 1000 /* timeout, ms */));
         consumer_watch.stop();
         switch (msg->err()) {
         case RdKafka::ERR_NO_ERROR:
@@ -210,16 +241,24 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
                 // ignore msg with length 0.
                 // put empty msg into queue will cause the load process shutting down.
                 break;
-            } else if (!queue->blocking_put(msg.get())) {
+            }
+            if (batch == nullptr) {
+                batch.reset(new KafkaMessageBatch());
+            }
+            batch_bytes += msg->len();
+            batch->push_back(std::move(msg));
+            if (batch->size() >= batch_size || batch_bytes >= MAX_BATCH_BYTES) {
                 // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
+                done = !put_batch();
             }
             ++received_rows;
             break;
         case RdKafka::ERR__TIMED_OUT:
+            if (has_pending) {
+                // no more msgs fetched, put the ones in hand
+                done = !put_batch();
+                break;
+            }
             // leave the status as OK, because this may happened
             // if there is no data in kafka.
             LOG(INFO) << "kafka consume timeout: " << _id;
@@ -243,12 +282,16 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
             break;
         }
     }
+    if (st.ok() && batch != nullptr && !batch->empty()) {
+        put_batch();
+    }
 
     LOG(INFO) << "kafka consumer done: " << _id << ", grp: " << _grp_id
               << ". cancelled: " << _cancelled << ", left time(ms): " << left_time
               << ", total cost(ms): " << watch.elapsed_time() / 1000 / 1000
               << ", consume cost(ms): " << consumer_watch.elapsed_time() / 1000 / 1000
-              << ", received rows: " << received_rows << ", put rows: " << put_rows;
+              << ", received rows: " << received_rows << ", put rows: " << put_rows
+              << ", batch size: " << batch_size;
 
     return st;
 }
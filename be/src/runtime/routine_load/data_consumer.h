@@ -18,8 +18,10 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -78,6 +80,10 @@ protected:
 };
 
 class PIntegerPair;
+
+// the messages a kafka consumer puts into the queue of its group at once
+using KafkaMessageBatch = std::vector<std::unique_ptr<RdKafka::Message>>;
+
 class KafkaEventCb : public RdKafka::EventCb {
 public:
     void event_cb(RdKafka::Event& event) {
@@ -137,8 +143,10 @@ public:
     Status assign_topic_partitions(const std::map<int32_t, int64_t>& begin_partition_offset,
                                    const std::string& topic, StreamLoadContext* ctx);
 
-    // start the consumer and put msgs to queue
-    Status group_consume(BlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    // start the consumer and put msgs to queue.
+    // If enable_routine_load_adaptive_consume is true, the msgs already fetched are put in
+    // batches, which grow while the group is waiting for msgs and shrink when it falls behind.
+    Status group_consume(BlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
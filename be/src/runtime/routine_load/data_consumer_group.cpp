@@ -16,6 +16,12 @@
 // under the License.
 #include "runtime/routine_load/data_consumer_group.h"
 
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+#include "common/config.h"
+#include "gen_cpp/internal_service.pb.h"
 #include "librdkafka/rdkafka.h"
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/routine_load/data_consumer.h"
@@ -31,11 +37,15 @@ Status KafkaDataConsumerGroup::assign_topic_partitions(StreamLoadContext* ctx) {
     // divide partitions
     int consumer_size = _consumers.size();
     std::vector<std::map<int32_t, int64_t>> divide_parts(consumer_size);
-    int i = 0;
-    for (auto& kv : ctx->kafka_info->begin_offset) {
-        int idx = i % consumer_size;
-        divide_parts[idx].emplace(kv.first, kv.second);
-        i++;
+    if (!config::enable_routine_load_adaptive_consume || consumer_size == 1 ||
+        !_divide_partitions_by_lag(ctx, &divide_parts)) {
+        divide_parts.assign(consumer_size, {});
+        int i = 0;
+        for (auto& kv : ctx->kafka_info->begin_offset) {
+            int idx = i % consumer_size;
+            divide_parts[idx].emplace(kv.first, kv.second);
+            i++;
+        }
     }
 
     // assign partitions to consumers equally
@@ -48,14 +58,59 @@ Status KafkaDataConsumerGroup::assign_topic_partitions(StreamLoadContext* ctx) {
     return Status::OK();
 }
 
+bool KafkaDataConsumerGroup::_divide_partitions_by_lag(
+        StreamLoadContext* ctx, std::vector<std::map<int32_t, int64_t>>* divide_parts) {
+    std::vector<int32_t> partition_ids;
+    for (auto& kv : ctx->kafka_info->begin_offset) {
+        partition_ids.push_back(kv.first);
+    }
+    std::vector<PIntegerPair> latest_offsets;
+    Status st = std::static_pointer_cast<KafkaDataConsumer>(_consumers[0])
+                        ->get_latest_offsets_for_partitions(partition_ids, &latest_offsets);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to get the lag of partitions, assign them equally. grp: "
+                     << _grp_id << ", err: " << st;
+        return false;
+    }
+
+    // (lag, partition id)
+    std::vector<std::pair<int64_t, int32_t>> lags;
+    for (auto& offset : latest_offsets) {
+        int64_t begin_offset = ctx->kafka_info->begin_offset[offset.key()];
+        lags.emplace_back(std::max<int64_t>(offset.val() - begin_offset, 0), offset.key());
+    }
+    std::sort(lags.begin(), lags.end(), std::greater<>());
+
+    // assign the partition with the largest lag to the consumer with the least lag,
+    // the consumer with less partitions first if their lag is the same.
+    int consumer_size = _consumers.size();
+    std::vector<int64_t> consumer_lags(consumer_size, 0);
+    std::stringstream ss;
+    for (auto& [lag, partition_id] : lags) {
+        int idx = 0;
+        for (int i = 1; i < consumer_size; ++i) {
+            if (consumer_lags[i] < consumer_lags[idx] ||
+                (consumer_lags[i] == consumer_lags[idx] &&
+                 (*divide_parts)[i].size() < (*divide_parts)[idx].size())) {
+                idx = i;
+            }
+        }
+        consumer_lags[idx] += lag;
+        (*divide_parts)[idx].emplace(partition_id, ctx->kafka_info->begin_offset[partition_id]);
+        ss << "[" << partition_id << ": " << lag << " -> " << idx << "] ";
+    }
+    LOG(INFO) << "divide partitions by lag. grp: " << _grp_id << ", " << ss.str();
+    return true;
+}
+
 KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
     // clean the msgs left in queue
     _queue.shutdown();
     while (true) {
-        RdKafka::Message* msg;
-        if (_queue.blocking_get(&msg)) {
-            delete msg;
-            msg = nullptr;
+        KafkaMessageBatch* batch;
+        if (_queue.blocking_get(&batch)) {
+            delete batch;
+            batch = nullptr;
         } else {
             break;
         }
@@ -108,7 +163,9 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
 
     //improve performance
     Status (KafkaConsumerPipe::*append_data)(const char* data, size_t size);
-    if (ctx->format == TFileFormatType::FORMAT_JSON) {
+    if (ctx->format == TFileFormatType::FORMAT_JSON ||
+        ctx->format == TFileFormatType::FORMAT_PROTOBUF) {
+        // each message is read by read_one_message()
         append_data = &KafkaConsumerPipe::append_json;
     } else {
         append_data = &KafkaConsumerPipe::append_with_line_delimiter;
@@ -149,33 +206,40 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             return Status::OK();
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
+        KafkaMessageBatch* batch;
+        bool res = _queue.blocking_get(&batch);
         if (res) {
-            VLOG_NOTICE << "get kafka message"
-                        << ", partition: " << msg->partition() << ", offset: " << msg->offset()
-                        << ", len: " << msg->len();
-
-            Status st = (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()),
-                                                         static_cast<size_t>(msg->len()));
-            if (st.ok()) {
-                left_rows--;
-                left_bytes -= msg->len();
-                cmt_offset[msg->partition()] = msg->offset();
-                VLOG_NOTICE << "consume partition[" << msg->partition() << " - " << msg->offset()
-                            << "]";
-            } else {
-                // failed to append this msg, we must stop
-                LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
-                eos = true;
-                {
-                    std::unique_lock<std::mutex> lock(_mutex);
-                    if (result_st.ok()) {
-                        result_st = st;
+            std::unique_ptr<KafkaMessageBatch> batch_holder(batch);
+            for (auto& msg : *batch) {
+                if (eos || left_rows <= 0 || left_bytes <= 0) {
+                    // the offsets of the rest msgs are not committed,
+                    // so they will be consumed again by the next task.
+                    break;
+                }
+                VLOG_NOTICE << "get kafka message"
+                            << ", partition: " << msg->partition() << ", offset: " << msg->offset()
+                            << ", len: " << msg->len();
+
+                Status st = (kafka_pipe.get()->*append_data)(
+                        static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()));
+                if (st.ok()) {
+                    left_rows--;
+                    left_bytes -= msg->len();
+                    cmt_offset[msg->partition()] = msg->offset();
+                    VLOG_NOTICE << "consume partition[" << msg->partition() << " - "
+                                << msg->offset() << "]";
+                } else {
+                    // failed to append this msg, we must stop
+                    LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
+                    eos = true;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (result_st.ok()) {
+                            result_st = st;
+                        }
                     }
                 }
             }
-            delete msg;
         } else {
             // queue is empty and shutdown
             eos = true;
@@ -188,7 +252,7 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
 }
 
 void KafkaDataConsumerGroup::actual_consume(std::shared_ptr<DataConsumer> consumer,
-                                            BlockingQueue<RdKafka::Message*>* queue,
+                                            BlockingQueue<KafkaMessageBatch*>* queue,
                                             int64_t max_running_time_ms, ConsumeFinishCallback cb) {
     Status st = std::static_pointer_cast<KafkaDataConsumer>(consumer)->group_consume(
             queue, max_running_time_ms);
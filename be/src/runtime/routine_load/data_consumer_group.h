@@ -68,18 +68,24 @@ public:
     virtual ~KafkaDataConsumerGroup();
 
     virtual Status start_all(StreamLoadContext* ctx) override;
-    // assign topic partitions to all consumers equally
+    // assign topic partitions to all consumers equally.
+    // If enable_routine_load_adaptive_consume is true, the partitions are assigned so that
+    // the consumers have about the same lag to consume.
     Status assign_topic_partitions(StreamLoadContext* ctx);
 
 private:
     // start a single consumer
     void actual_consume(std::shared_ptr<DataConsumer> consumer,
-                        BlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                        BlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                         ConsumeFinishCallback cb);
 
+    // divide the partitions by their lag, return false if failed to get the lag
+    bool _divide_partitions_by_lag(StreamLoadContext* ctx,
+                                   std::vector<std::map<int32_t, int64_t>>* divide_parts);
+
 private:
     // blocking queue to receive msgs from all consumers
-    BlockingQueue<RdKafka::Message*> _queue;
+    BlockingQueue<KafkaMessageBatch*> _queue;
 };
 
 } // end namespace doris
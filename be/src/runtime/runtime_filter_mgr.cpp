@@ -20,11 +20,13 @@
 #include <string>
 
 #include "client_cache.h"
+#include "common/config.h"
 #include "exprs/runtime_filter.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/query_fragments_ctx.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "service/brpc.h"
@@ -105,6 +107,19 @@ Status RuntimeFilterMgr::regist_filter(const RuntimeFilterRole role, const TRunt
     RETURN_IF_ERROR(IRuntimeFilter::create(_state, &_pool, &desc, &options, role, node_id,
                                            &filter_mgr_val.filter));
 
+    QueryFragmentsCtx* query_ctx = _state->get_query_fragments_ctx();
+    auto num_iter = _builder_num_on_host.find(key);
+    if (role == RuntimeFilterRole::PRODUCER && desc.has_remote_targets && query_ctx != nullptr &&
+        num_iter != _builder_num_on_host.end() && num_iter->second > 1) {
+        bool local_merge = false;
+        RETURN_IF_ERROR(query_ctx->runtime_filter_local_merger.register_producer(
+                desc, options, num_iter->second, &local_merge));
+        if (local_merge) {
+            filter_mgr_val.filter->set_local_merger(&query_ctx->runtime_filter_local_merger,
+                                                    num_iter->second);
+        }
+    }
+
     filter_map->emplace(key, filter_mgr_val);
 
     return Status::OK();
@@ -126,6 +141,7 @@ void RuntimeFilterMgr::set_runtime_filter_params(
         const TRuntimeFilterParams& runtime_filter_params) {
     this->_merge_addr = runtime_filter_params.runtime_filter_merge_addr;
     this->_has_merge_addr = true;
+    this->_builder_num_on_host = runtime_filter_params.runtime_filter_builder_num_on_host;
 }
 
 Status RuntimeFilterMgr::get_merge_addr(TNetworkAddress* addr) {
@@ -137,6 +153,57 @@ Status RuntimeFilterMgr::get_merge_addr(TNetworkAddress* addr) {
     return Status::InternalError("not found merge addr");
 }
 
+RuntimeFilterLocalMerger::RuntimeFilterLocalMerger() {
+    _mem_tracker = MemTracker::create_tracker(-1, "RuntimeFilterLocalMerger", nullptr);
+}
+
+Status RuntimeFilterLocalMerger::register_producer(const TRuntimeFilterDesc& desc,
+                                                   const TQueryOptions& options, int producer_num,
+                                                   bool* local_merge) {
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    std::lock_guard<std::mutex> guard(_filter_map_mutex);
+    auto iter = _filter_map.find(desc.filter_id);
+    if (iter == _filter_map.end()) {
+        LocalMergeVal& val = _filter_map[desc.filter_id];
+        val.producer_num = producer_num;
+        if (config::enable_runtime_filter_local_merge) {
+            val.runtime_filter_desc = desc;
+            val.filter = _pool.add(new IRuntimeFilter(nullptr, &_pool));
+            RETURN_IF_ERROR(val.filter->init_with_desc(&val.runtime_filter_desc, &options));
+        }
+        *local_merge = val.filter != nullptr;
+        return Status::OK();
+    }
+    if (iter->second.producer_num != producer_num) {
+        return Status::InternalError("runtime filter params meet error");
+    }
+    *local_merge = iter->second.filter != nullptr;
+    return Status::OK();
+}
+
+Status RuntimeFilterLocalMerger::merge(const PMergeFilterRequest* request, const char* data,
+                                       IRuntimeFilter** merged_filter) {
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    *merged_filter = nullptr;
+    std::lock_guard<std::mutex> guard(_filter_map_mutex);
+    auto iter = _filter_map.find(request->filter_id());
+    if (iter == _filter_map.end() || iter->second.filter == nullptr) {
+        return Status::InvalidArgument("unknown filter id");
+    }
+    LocalMergeVal& val = iter->second;
+    MergeRuntimeFilterParams params;
+    params.data = data;
+    params.request = request;
+    RuntimeFilterWrapperHolder holder;
+    RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(&params, &_pool, holder.getHandle()));
+    RETURN_IF_ERROR(val.filter->merge_from(holder.getHandle()->get()));
+    DCHECK_LT(val.arrived_num, val.producer_num);
+    if (++val.arrived_num == val.producer_num) {
+        *merged_filter = val.filter;
+    }
+    return Status::OK();
+}
+
 Status RuntimeFilterMergeControllerEntity::_init_with_desc(
         const TRuntimeFilterDesc* runtime_filter_desc, const TQueryOptions* query_options,
         const std::vector<doris::TRuntimeFilterTargetParams>* target_info,
@@ -209,8 +276,11 @@ Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* requ
         RuntimeFilterWrapperHolder holder;
         RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(&params, pool, holder.getHandle()));
         RETURN_IF_ERROR(cntVal->filter->merge_from(holder.getHandle()->get()));
-        cntVal->arrive_id.insert(UniqueId(request->fragment_id()).to_string());
-        merged_size = cntVal->arrive_id.size();
+        if (cntVal->arrive_id.insert(UniqueId(request->fragment_id()).to_string()).second) {
+            cntVal->arrived_num +=
+                    request->has_merged_instance_num() ? request->merged_instance_num() : 1;
+        }
+        merged_size = cntVal->arrived_num;
         // TODO: avoid log when we had acquired a lock
         VLOG_ROW << "merge size:" << merged_size << ":" << cntVal->producer_size;
         DCHECK_LE(merged_size, cntVal->producer_size);
@@ -235,7 +305,12 @@ Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* requ
         bool has_attachment = false;
         RETURN_IF_ERROR(cntVal->filter->serialize(&apply_request, &data, &len));
         if (data != nullptr && len > 0) {
-            request_attachment.append(data, len);
+            if (apply_request.has_bloom_filter()) {
+                IRuntimeFilter::append_bloom_filter_to_attachment(
+                        apply_request.mutable_bloom_filter(), data, len, &request_attachment);
+            } else {
+                request_attachment.append(data, len);
+            }
             has_attachment = true;
         }
 
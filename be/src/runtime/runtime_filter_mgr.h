@@ -96,6 +96,45 @@ private:
     TNetworkAddress _merge_addr;
 
     bool _has_merge_addr;
+
+    // filter-id -> the number of the producers on this BE
+    std::map<int32_t, int32_t> _builder_num_on_host;
+};
+
+// Merges the filters of the producer instances of a query on one BE before they are sent
+// to the merge instance, which then receives one filter from each BE rather than one from
+// each producer instance.
+// owned by QueryFragmentsCtx
+class RuntimeFilterLocalMerger {
+public:
+    RuntimeFilterLocalMerger();
+    ~RuntimeFilterLocalMerger() = default;
+
+    // Called by each of the `producer_num` producers on this BE when registering the filter.
+    // *local_merge is set to whether the filter of the producer should be merged here,
+    // which is decided by the first producer.
+    Status register_producer(const TRuntimeFilterDesc& desc, const TQueryOptions& options,
+                             int producer_num, bool* local_merge);
+
+    // Merge the serialized filter of a producer. *merged_filter is set to the filter merged
+    // from all the producers when the last one arrives, and nullptr before.
+    Status merge(const PMergeFilterRequest* request, const char* data,
+                 IRuntimeFilter** merged_filter);
+
+private:
+    struct LocalMergeVal {
+        int producer_num;
+        int arrived_num = 0;
+        TRuntimeFilterDesc runtime_filter_desc;
+        // nullptr if the filter is not merged on this BE
+        IRuntimeFilter* filter = nullptr;
+    };
+
+    std::mutex _filter_map_mutex;
+    std::shared_ptr<MemTracker> _mem_tracker;
+    ObjectPool _pool;
+    // filter-id -> val
+    std::map<int32_t, LocalMergeVal> _filter_map;
 };
 
 // controller -> <query-id, entity>
@@ -129,6 +168,8 @@ private:
         std::vector<doris::TRuntimeFilterTargetParams> target_info;
         IRuntimeFilter* filter;
         std::unordered_set<std::string> arrive_id; // fragment_instance_id ?
+        // the producers merged, a request may carry the filters merged on one BE
+        int arrived_num = 0;
         std::shared_ptr<MemTracker> tracker;
         std::shared_ptr<ObjectPool> pool;
     };
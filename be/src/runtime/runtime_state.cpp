@@ -39,11 +39,13 @@
 #include "runtime/mem_tracker.h"
 #include "runtime/mem_tracker_task_pool.h"
 #include "runtime/runtime_filter_mgr.h"
+#include "runtime/thread_context.h"
 #include "util/file_utils.h"
 #include "util/load_error_hub.h"
 #include "util/pretty_printer.h"
 #include "util/timezone_utils.h"
 #include "util/uid_util.h"
+#include "vec/common/column_buffer_pool.h"
 
 namespace doris {
 
@@ -145,6 +147,11 @@ RuntimeState::RuntimeState()
 }
 
 RuntimeState::~RuntimeState() {
+    // the columns released below must not be returned to the pool being destructed
+    if (_column_buffer_pool != nullptr &&
+        tls_ctx()->_column_buffer_pool == _column_buffer_pool.get()) {
+        tls_ctx()->_column_buffer_pool = nullptr;
+    }
     _block_mgr2.reset();
     // close error log file
     if (_error_log_file != nullptr && _error_log_file->is_open()) {
@@ -229,9 +236,15 @@ Status RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
     mem_tracker_counter->set(bytes_limit);
 
     if (query_type() == TQueryType::SELECT) {
+        std::shared_ptr<WorkloadGroup> workload_group =
+                _query_ctx == nullptr ? nullptr : _query_ctx->workload_group;
         _query_mem_tracker =
                 _exec_env->task_pool_mem_tracker_registry()->register_query_mem_tracker(
-                        print_id(query_id), bytes_limit);
+                        print_id(query_id), bytes_limit,
+                        workload_group == nullptr ? nullptr : workload_group->mem_tracker());
+        if (workload_group != nullptr) {
+            workload_group->add_query(query_id, _query_mem_tracker);
+        }
     } else if (query_type() == TQueryType::LOAD) {
         _query_mem_tracker = _exec_env->task_pool_mem_tracker_registry()->register_load_mem_tracker(
                 print_id(query_id), bytes_limit);
@@ -245,6 +258,11 @@ Status RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
 
     RETURN_IF_ERROR(init_buffer_poolstate());
 
+    if (config::column_buffer_pool_bytes_per_instance > 0) {
+        _column_buffer_pool = std::make_unique<vectorized::ColumnBufferPool>(
+                config::column_buffer_pool_bytes_per_instance);
+    }
+
     _initial_reservations = _obj_pool->add(
             new InitialReservations(_obj_pool.get(), _buffer_reservation, nullptr,
                                     _query_options.initial_reservation_total_claims));
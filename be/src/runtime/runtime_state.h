@@ -60,6 +60,10 @@ class InitialReservations;
 class RowDescriptor;
 class RuntimeFilterMgr;
 
+namespace vectorized {
+class ColumnBufferPool;
+} // namespace vectorized
+
 // A collection of items that are part of the global state of a
 // query and shared across all execution nodes of that query.
 class RuntimeState {
@@ -128,6 +132,8 @@ public:
     ExecEnv* exec_env() { return _exec_env; }
     std::shared_ptr<MemTracker> query_mem_tracker() { return _query_mem_tracker; }
     std::shared_ptr<MemTracker> instance_mem_tracker() { return _instance_mem_tracker; }
+    // The pool of the freed column buffers of the instance, nullptr if disabled.
+    vectorized::ColumnBufferPool* column_buffer_pool() const { return _column_buffer_pool.get(); }
     ThreadResourceMgr::ResourcePool* resource_pool() { return _resource_pool; }
 
     void set_fragment_root_id(PlanNodeId id) {
@@ -325,6 +331,18 @@ public:
 
     bool enable_spill() const { return _query_options.enable_spilling; }
 
+    bool disable_file_cache() const { return _query_options.disable_file_cache; }
+
+    bool fill_storage_page_cache() const { return _query_options.fill_storage_page_cache; }
+
+    const std::string& fragment_transmission_compression_codec() const {
+        return _query_options.fragment_transmission_compression_codec;
+    }
+
+    int fragment_transmission_compression_level() const {
+        return _query_options.fragment_transmission_compression_level;
+    }
+
     int32_t runtime_filter_wait_time_ms() const {
         return _query_options.runtime_filter_wait_time_ms;
     }
@@ -390,6 +408,8 @@ private:
     // Memory usage of this fragment instance
     std::shared_ptr<MemTracker> _instance_mem_tracker;
 
+    std::unique_ptr<vectorized::ColumnBufferPool> _column_buffer_pool;
+
     // put runtime state before _obj_pool, so that it will be deconstructed after
     // _obj_pool. Because some of object in _obj_pool will use profile when deconstructing.
     RuntimeProfile _profile;
@@ -516,7 +536,7 @@ private:
     /// TODO: not needed if we call ReleaseResources() in a timely manner (IMPALA-1575).
     std::atomic<int32_t> _initial_reservation_refcnt {0};
 
-    QueryFragmentsCtx* _query_ctx;
+    QueryFragmentsCtx* _query_ctx = nullptr;
 
     // true if max_filter_ratio is 0
     bool _load_zero_tolerance = false;
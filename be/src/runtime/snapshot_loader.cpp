@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "gen_cpp/FrontendService.h"
@@ -35,6 +36,7 @@
 #include "util/broker_storage_backend.h"
 #include "util/file_utils.h"
 #include "util/s3_storage_backend.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 namespace doris {
@@ -82,16 +84,13 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
     int tmp_counter = 1;
     RETURN_IF_ERROR(_report_every(0, &tmp_counter, 0, 0, TTaskType::type::UPLOAD));
 
-    Status status = Status::OK();
     // 1. validate local tablet snapshot paths
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, true));
 
-    // 2. for each src path, upload it to remote storage
-    // we report to frontend for every 10 files, and we will cancel the job if
-    // the job has already been cancelled in frontend.
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
+    // 2. for each src path, upload it to remote storage.
+    // the tablets are uploaded concurrently, so the checksum of a file is calculated
+    // while the files of other tablets are being transferred.
+    std::vector<std::function<Status()>> tasks;
     for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++) {
         const std::string& src_path = iter->first;
         const std::string& dest_path = iter->second;
@@ -100,74 +99,82 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
         int32_t schema_hash = 0;
         RETURN_IF_ERROR(
                 _get_tablet_id_and_schema_hash_from_file_path(src_path, &tablet_id, &schema_hash));
+        // the entries are created here, each task only fills its own one
+        std::vector<std::string>* files_with_checksum = &(*tablet_files)[tablet_id];
+        tasks.emplace_back([this, &src_path, &dest_path, files_with_checksum]() {
+            return _upload_tablet(src_path, dest_path, files_with_checksum);
+        });
+    }
+    RETURN_IF_ERROR(_run_transfer_tasks(tasks, TTaskType::type::UPLOAD));
+
+    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
+    return Status::OK();
+}
+
+Status SnapshotLoader::_upload_tablet(const std::string& src_path, const std::string& dest_path,
+                                      std::vector<std::string>* local_files_with_checksum) {
+    // 1. get existing files from remote path
+    std::map<std::string, FileStat> remote_files;
+    RETURN_IF_ERROR(_storage_backend->list(dest_path, true, false, &remote_files));
 
-        // 2.1 get existing files from remote path
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_storage_backend->list(dest_path, true, false, &remote_files));
+    for (auto& tmp : remote_files) {
+        VLOG_CRITICAL << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
+    }
+
+    // 2. list local files
+    std::vector<std::string> local_files;
+    RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
 
-        for (auto& tmp : remote_files) {
-            VLOG_CRITICAL << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
+    // 3. iterate local files
+    for (auto it = local_files.begin(); it != local_files.end(); it++) {
+        if (_transfer_stopped) {
+            return Status::Cancelled("snapshot upload is stopped");
         }
 
-        // 2.2 list local files
-        std::vector<std::string> local_files;
-        std::vector<std::string> local_files_with_checksum;
-        RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
-
-        // 2.3 iterate local files
-        for (auto it = local_files.begin(); it != local_files.end(); it++) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num,
-                                          TTaskType::type::UPLOAD));
-
-            const std::string& local_file = *it;
-            // calc md5sum of localfile
-            std::string md5sum;
-            status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << local_file << ": "
-                   << status.get_error_msg();
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG_CRITICAL << "get file checksum: " << local_file << ": " << md5sum;
-            local_files_with_checksum.push_back(local_file + "." + md5sum);
-
-            // check if this local file need upload
-            bool need_upload = false;
-            auto find = remote_files.find(local_file);
-            if (find != remote_files.end()) {
-                if (md5sum != find->second.md5) {
-                    // remote storage file exist, but with different checksum
-                    LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first
-                                 << ", local: " << md5sum;
-                    // TODO(cmy): save these files and delete them later
-                    need_upload = true;
-                }
-            } else {
+        const std::string& local_file = *it;
+        // calc md5sum of localfile
+        std::string md5sum;
+        Status status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
+        if (!status.ok()) {
+            std::stringstream ss;
+            ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
+            LOG(WARNING) << ss.str();
+            return Status::InternalError(ss.str());
+        }
+        VLOG_CRITICAL << "get file checksum: " << local_file << ": " << md5sum;
+        local_files_with_checksum->push_back(local_file + "." + md5sum);
+
+        // check if this local file need upload. the files uploaded by a previous
+        // attempt of this task have the same checksum and are skipped.
+        bool need_upload = false;
+        auto find = remote_files.find(local_file);
+        if (find != remote_files.end()) {
+            if (md5sum != find->second.md5) {
+                // remote storage file exist, but with different checksum
+                LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first
+                             << ", local: " << md5sum;
+                // TODO(cmy): save these files and delete them later
                 need_upload = true;
             }
+        } else {
+            need_upload = true;
+        }
 
-            if (!need_upload) {
-                VLOG_CRITICAL << "file exist in remote path, no need to upload: " << local_file;
-                continue;
-            }
-
-            // upload
-            std::string full_remote_file = dest_path + "/" + local_file;
-            std::string full_local_file = src_path + "/" + local_file;
-            RETURN_IF_ERROR(_storage_backend->upload_with_checksum(full_local_file,
-                                                                   full_remote_file, md5sum));
-        } // end for each tablet's local files
+        if (!need_upload) {
+            VLOG_CRITICAL << "file exist in remote path, no need to upload: " << local_file;
+            continue;
+        }
 
-        tablet_files->emplace(tablet_id, local_files_with_checksum);
-        finished_num++;
-        LOG(INFO) << "finished to write tablet to remote. local path: " << src_path
-                  << ", remote path: " << dest_path;
-    } // end for each tablet path
+        // upload
+        std::string full_remote_file = dest_path + "/" + local_file;
+        std::string full_local_file = src_path + "/" + local_file;
+        RETURN_IF_ERROR(
+                _storage_backend->upload_with_checksum(full_local_file, full_remote_file, md5sum));
+    } // end for each tablet's local files
 
-    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
-    return status;
+    LOG(INFO) << "finished to write tablet to remote. local path: " << src_path
+              << ", remote path: " << dest_path;
+    return Status::OK();
 }
 
 /*
@@ -188,14 +195,12 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
     int tmp_counter = 1;
     RETURN_IF_ERROR(_report_every(0, &tmp_counter, 0, 0, TTaskType::type::DOWNLOAD));
 
-    Status status = Status::OK();
     // 1. validate local tablet snapshot paths
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, false));
 
-    // 2. for each src path, download it to local storage
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
+    // 2. for each src path, download it to local storage, the tablets are downloaded
+    // concurrently
+    std::vector<std::function<Status()>> tasks;
     for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++) {
         const std::string& remote_path = iter->first;
         const std::string& local_path = iter->second;
@@ -211,147 +216,212 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         VLOG_CRITICAL << "get local tablet id: " << local_tablet_id
                       << ", schema hash: " << schema_hash
                       << ", remote tablet id: " << remote_tablet_id;
+        tasks.emplace_back([this, &remote_path, &local_path, local_tablet_id, remote_tablet_id]() {
+            return _download_tablet(remote_path, local_path, local_tablet_id, remote_tablet_id);
+        });
+    }
+    RETURN_IF_ERROR(_run_transfer_tasks(tasks, TTaskType::type::DOWNLOAD));
 
-        // 2.1. get local files
-        std::vector<std::string> local_files;
-        RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
+    LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
+    return Status::OK();
+}
 
-        // 2.2. get remote files
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_storage_backend->list(remote_path, true, false, &remote_files));
-        if (remote_files.empty()) {
-            std::stringstream ss;
-            ss << "get nothing from remote path: " << remote_path;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
-        }
+Status SnapshotLoader::_download_tablet(const std::string& remote_path,
+                                        const std::string& local_path, int64_t local_tablet_id,
+                                        int64_t remote_tablet_id) {
+    // 1. get local files
+    std::vector<std::string> local_files;
+    RETURN_IF_ERROR(_get_existing_files_from_local(local_path, &local_files));
+
+    // 2. get remote files
+    std::map<std::string, FileStat> remote_files;
+    RETURN_IF_ERROR(_storage_backend->list(remote_path, true, false, &remote_files));
+    if (remote_files.empty()) {
+        std::stringstream ss;
+        ss << "get nothing from remote path: " << remote_path;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
 
-        TabletSharedPtr tablet =
-                _env->storage_engine()->tablet_manager()->get_tablet(local_tablet_id);
-        if (tablet == nullptr) {
-            std::stringstream ss;
-            ss << "failed to get local tablet: " << local_tablet_id;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
+    TabletSharedPtr tablet = _env->storage_engine()->tablet_manager()->get_tablet(local_tablet_id);
+    if (tablet == nullptr) {
+        std::stringstream ss;
+        ss << "failed to get local tablet: " << local_tablet_id;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    DataDir* data_dir = tablet->data_dir();
+
+    for (auto& iter : remote_files) {
+        if (_transfer_stopped) {
+            return Status::Cancelled("snapshot download is stopped");
         }
-        DataDir* data_dir = tablet->data_dir();
-
-        for (auto& iter : remote_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num,
-                                          TTaskType::type::DOWNLOAD));
-
-            bool need_download = false;
-            const std::string& remote_file = iter.first;
-            const FileStat& file_stat = iter.second;
-            auto find = std::find(local_files.begin(), local_files.end(), remote_file);
-            if (find == local_files.end()) {
-                // remote file does not exist in local, download it
+
+        bool need_download = false;
+        const std::string& remote_file = iter.first;
+        const FileStat& file_stat = iter.second;
+        auto find = std::find(local_files.begin(), local_files.end(), remote_file);
+        if (find == local_files.end()) {
+            // remote file does not exist in local, download it
+            need_download = true;
+        } else {
+            if (_end_with(remote_file, ".hdr")) {
+                // this is a header file, download it.
                 need_download = true;
             } else {
-                if (_end_with(remote_file, ".hdr")) {
-                    // this is a header file, download it.
+                // check checksum, the files downloaded by a previous attempt are skipped
+                std::string local_md5sum;
+                Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
+                if (!st.ok()) {
+                    LOG(WARNING) << "failed to get md5sum of local file: " << remote_file
+                                 << ". msg: " << st.get_error_msg() << ". download it";
                     need_download = true;
                 } else {
-                    // check checksum
-                    std::string local_md5sum;
-                    Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
-                    if (!st.ok()) {
-                        LOG(WARNING) << "failed to get md5sum of local file: " << remote_file
-                                     << ". msg: " << st.get_error_msg() << ". download it";
+                    VLOG_CRITICAL << "get local file checksum: " << remote_file << ": "
+                                  << local_md5sum;
+                    if (file_stat.md5 != local_md5sum) {
+                        // file's checksum does not equal, download it.
                         need_download = true;
-                    } else {
-                        VLOG_CRITICAL << "get local file checksum: " << remote_file << ": "
-                                      << local_md5sum;
-                        if (file_stat.md5 != local_md5sum) {
-                            // file's checksum does not equal, download it.
-                            need_download = true;
-                        }
                     }
                 }
             }
+        }
 
-            if (!need_download) {
-                LOG(INFO) << "remote file already exist in local, no need to download."
-                          << ", file: " << remote_file;
-                continue;
-            }
+        if (!need_download) {
+            LOG(INFO) << "remote file already exist in local, no need to download."
+                      << ", file: " << remote_file;
+            continue;
+        }
 
-            // begin to download
-            std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
-            std::string local_file_name;
-            // we need to replace the tablet_id in remote file name with local tablet id
-            RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
-            std::string full_local_file = local_path + "/" + local_file_name;
-            LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
-            size_t file_len = file_stat.size;
-
-            // check disk capacity
-            if (data_dir->reach_capacity_limit(file_len)) {
-                return Status::InternalError("capacity limit reached");
-            }
-            // remove file which will be downloaded now.
-            // this file will be added to local_files if it be downloaded successfully.
+        // begin to download
+        std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
+        std::string local_file_name;
+        // we need to replace the tablet_id in remote file name with local tablet id
+        RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
+        std::string full_local_file = local_path + "/" + local_file_name;
+        LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
+        size_t file_len = file_stat.size;
+
+        // check disk capacity
+        if (data_dir->reach_capacity_limit(file_len)) {
+            return Status::InternalError("capacity limit reached");
+        }
+        // remove file which will be downloaded now.
+        // this file will be added to local_files if it be downloaded successfully.
+        if (find != local_files.end()) {
             local_files.erase(find);
-            RETURN_IF_ERROR(_storage_backend->download(full_remote_file, full_local_file));
-
-            // 3. check md5 of the downloaded file
-            std::string downloaded_md5sum;
-            status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << full_local_file
-                   << ", err: " << status.get_error_msg();
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG_CRITICAL << "get downloaded file checksum: " << full_local_file << ": "
-                          << downloaded_md5sum;
-            if (downloaded_md5sum != file_stat.md5) {
-                std::stringstream ss;
-                ss << "invalid md5 of downloaded file: " << full_local_file
-                   << ", expected: " << file_stat.md5 << ", get: " << downloaded_md5sum;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
+        }
+        RETURN_IF_ERROR(_storage_backend->download(full_remote_file, full_local_file));
 
-            // local_files always keep the updated local files
-            local_files.push_back(local_file_name);
-            LOG(INFO) << "finished to download file via broker. file: " << full_local_file
-                      << ", length: " << file_len;
-        } // end for all remote files
-
-        // finally, delete local files which are not in remote
-        for (const auto& local_file : local_files) {
-            // replace the tablet id in local file name with the remote tablet id,
-            // in order to compare the file name.
-            std::string new_name;
-            Status st = _replace_tablet_id(local_file, remote_tablet_id, &new_name);
-            if (!st.ok()) {
-                LOG(WARNING) << "failed to replace tablet id. unknown local file: "
-                             << st.get_error_msg() << ". ignore it";
-                continue;
-            }
-            VLOG_CRITICAL << "new file name after replace tablet id: " << new_name;
-            const auto& find = remote_files.find(new_name);
-            if (find != remote_files.end()) {
-                continue;
-            }
+        // 3. check md5 of the downloaded file
+        std::string downloaded_md5sum;
+        Status status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
+        if (!status.ok()) {
+            std::stringstream ss;
+            ss << "failed to get md5sum of file: " << full_local_file
+               << ", err: " << status.get_error_msg();
+            LOG(WARNING) << ss.str();
+            return Status::InternalError(ss.str());
+        }
+        VLOG_CRITICAL << "get downloaded file checksum: " << full_local_file << ": "
+                      << downloaded_md5sum;
+        if (downloaded_md5sum != file_stat.md5) {
+            std::stringstream ss;
+            ss << "invalid md5 of downloaded file: " << full_local_file
+               << ", expected: " << file_stat.md5 << ", get: " << downloaded_md5sum;
+            LOG(WARNING) << ss.str();
+            return Status::InternalError(ss.str());
+        }
 
-            // delete
-            std::string full_local_file = local_path + "/" + local_file;
-            VLOG_CRITICAL << "begin to delete local snapshot file: " << full_local_file
-                          << ", it does not exist in remote";
-            if (remove(full_local_file.c_str()) != 0) {
-                LOG(WARNING) << "failed to delete unknown local file: " << full_local_file
-                             << ", ignore it";
-            }
+        // local_files always keep the updated local files
+        local_files.push_back(local_file_name);
+        LOG(INFO) << "finished to download file via broker. file: " << full_local_file
+                  << ", length: " << file_len;
+    } // end for all remote files
+
+    // finally, delete local files which are not in remote
+    for (const auto& local_file : local_files) {
+        // replace the tablet id in local file name with the remote tablet id,
+        // in order to compare the file name.
+        std::string new_name;
+        Status st = _replace_tablet_id(local_file, remote_tablet_id, &new_name);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to replace tablet id. unknown local file: "
+                         << st.get_error_msg() << ". ignore it";
+            continue;
+        }
+        VLOG_CRITICAL << "new file name after replace tablet id: " << new_name;
+        const auto& find = remote_files.find(new_name);
+        if (find != remote_files.end()) {
+            continue;
         }
 
-        finished_num++;
-    } // end for src_to_dest_path
+        // delete
+        std::string full_local_file = local_path + "/" + local_file;
+        VLOG_CRITICAL << "begin to delete local snapshot file: " << full_local_file
+                      << ", it does not exist in remote";
+        if (remove(full_local_file.c_str()) != 0) {
+            LOG(WARNING) << "failed to delete unknown local file: " << full_local_file
+                         << ", ignore it";
+        }
+    }
+    return Status::OK();
+}
 
-    LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
-    return status;
+Status SnapshotLoader::_run_transfer_tasks(const std::vector<std::function<Status()>>& tasks,
+                                           TTaskType::type type) {
+    std::unique_ptr<ThreadPool> pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("SnapshotTransferPool")
+                            .set_min_threads(1)
+                            .set_max_threads(std::max(1, config::snapshot_transfer_thread_num))
+                            .build(&pool));
+
+    // the first failed task stops all the others, its error is returned
+    std::mutex error_lock;
+    Status first_error = Status::OK();
+    std::atomic<int32_t> finished_num {0};
+    _transfer_stopped = false;
+    auto stop = [&](const Status& st) {
+        std::lock_guard<std::mutex> l(error_lock);
+        if (first_error.ok()) {
+            first_error = st;
+        }
+        _transfer_stopped = true;
+    };
+
+    for (const auto& task : tasks) {
+        Status st = pool->submit_func([&]() {
+            if (_transfer_stopped) {
+                return;
+            }
+            Status task_st = task();
+            if (!task_st.ok()) {
+                stop(task_st);
+            } else {
+                finished_num++;
+            }
+        });
+        if (!st.ok()) {
+            stop(st);
+            break;
+        }
+    }
+
+    // we report the progress to frontend periodically, and we will cancel the job if
+    // the job has already been cancelled in frontend.
+    int32_t total_num = tasks.size();
+    int report_counter = 0;
+    while (!pool->wait_for(std::chrono::seconds(1))) {
+        if (_transfer_stopped) {
+            continue;
+        }
+        Status st = _report_every(10, &report_counter, finished_num, total_num, type);
+        if (!st.ok()) {
+            stop(st);
+        }
+    }
+    pool->shutdown();
+    return first_error;
 }
 
 // move the snapshot files in snapshot_path
@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -42,6 +44,7 @@ struct FileStat;
  *
  * It will try to get the existing files in remote storage,
  * and only upload the incremental part of files.
+ * The tablets are uploaded concurrently by snapshot_transfer_thread_num threads.
  *
  * Download:
  * download() will download the remote tablet snapshot files
@@ -93,6 +96,17 @@ private:
     Status _report_every(int report_threshold, int* counter, int finished_num, int total_num,
                          TTaskType::type type);
 
+    Status _upload_tablet(const std::string& src_path, const std::string& dest_path,
+                          std::vector<std::string>* local_files_with_checksum);
+
+    Status _download_tablet(const std::string& remote_path, const std::string& local_path,
+                            int64_t local_tablet_id, int64_t remote_tablet_id);
+
+    // Runs the tasks concurrently and reports the progress to frontend until all of them
+    // are finished. The first failure or a cancellation stops the tasks not finished yet.
+    Status _run_transfer_tasks(const std::vector<std::function<Status()>>& tasks,
+                               TTaskType::type type);
+
 private:
     ExecEnv* _env;
     int64_t _job_id;
@@ -100,6 +114,8 @@ private:
     const TNetworkAddress _broker_addr;
     const std::map<std::string, std::string> _prop;
     std::unique_ptr<StorageBackend> _storage_backend;
+    // set when the running transfer tasks should give up
+    std::atomic<bool> _transfer_stopped {false};
 };
 
 } // end namespace doris
@@ -0,0 +1,262 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load/group_commit_mgr.h"
+
+#include <thrift/protocol/TDebugProtocol.h>
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "gen_cpp/FrontendService.h"
+#include "runtime/client_cache.h"
+#include "runtime/exec_env.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+#include "util/thrift_rpc_helper.h"
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+#ifdef BE_TEST
+extern TStreamLoadPutResult k_stream_load_put_result;
+#endif
+
+GroupCommitMgr::GroupCommitLoad::~GroupCommitLoad() {
+    if (ctx != nullptr && ctx->unref()) {
+        delete ctx;
+    }
+}
+
+Status GroupCommitMgr::group_commit(StreamLoadContext* ctx) {
+    // The body of the request is fully received and buffered in its own pipe, it is moved
+    // to the group as a whole so the rows of different requests are not interleaved.
+    auto request_pipe = std::static_pointer_cast<StreamLoadPipe>(ctx->body_sink);
+    const TStreamLoadPutRequest& request = ctx->put_request;
+    char line_delimiter = request.__isset.line_delimiter ? request.line_delimiter[0] : '\n';
+    std::vector<ByteBufferPtr> buffers;
+    int64_t rows = 0;
+    bool ends_with_delimiter = true;
+    while (true) {
+        ByteBufferPtr buf;
+        RETURN_IF_ERROR(request_pipe->read_buffer(&buf));
+        if (buf == nullptr) {
+            break;
+        }
+        if (!buf->has_remaining()) {
+            continue;
+        }
+        rows += std::count(buf->ptr + buf->pos, buf->ptr + buf->limit, line_delimiter);
+        ends_with_delimiter = buf->ptr[buf->limit - 1] == line_delimiter;
+        buffers.push_back(std::move(buf));
+    }
+    if (!ends_with_delimiter) {
+        // the last line must not be joined with the first line of the next request
+        auto buf = ByteBuffer::allocate(1);
+        buf->put_bytes(&line_delimiter, 1);
+        buf->flip();
+        buffers.push_back(std::move(buf));
+        rows++;
+    }
+    int64_t bytes = 0;
+    for (auto& buf : buffers) {
+        bytes += buf->remaining();
+    }
+
+    // The requests of a group share one plan, so all the load parameters are in the key,
+    // except the ids of each request.
+    TStreamLoadPutRequest key_request = request;
+    key_request.txnId = -1;
+    key_request.__set_loadId(TUniqueId());
+    std::string key = apache::thrift::ThriftDebugString(key_request);
+
+    while (true) {
+        std::shared_ptr<GroupCommitLoad> load;
+        bool is_first = false;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            auto it = _loads.find(key);
+            if (it == _loads.end()) {
+                load = std::make_shared<GroupCommitLoad>();
+                _loads.emplace(key, load);
+                is_first = true;
+            } else {
+                load = it->second;
+            }
+        }
+        {
+            std::unique_lock<std::mutex> l(load->lock);
+            if (is_first) {
+                Status st = _begin_load(load.get(), ctx);
+                if (!st.ok()) {
+                    LOG(WARNING) << "begin group commit load failed, errmsg="
+                                 << st.get_error_msg() << ", " << ctx->brief();
+                    load->closed = true;
+                    load->status = st;
+                    if (load->pipe != nullptr) {
+                        load->pipe->cancel(st.get_error_msg());
+                    }
+                    {
+                        std::lock_guard<std::mutex> map_lock(_lock);
+                        _loads.erase(key);
+                    }
+                    load->promise.set_value(st);
+                    return st;
+                }
+            }
+            if (load->closed) {
+                if (!load->status.ok()) {
+                    return load->status;
+                }
+                // the group is being committed, append to a new one
+                continue;
+            }
+            for (auto& buf : buffers) {
+                RETURN_IF_ERROR(load->pipe->append(buf));
+            }
+            load->bytes += bytes;
+            if (load->bytes >= config::group_commit_max_bytes) {
+                load->cond.notify_all();
+            }
+        }
+        if (is_first) {
+            _commit_load(key, load);
+        }
+
+        Status st = load->future.get();
+        StreamLoadContext* group_ctx = load->ctx;
+        ctx->label = group_ctx->label;
+        ctx->txn_id = group_ctx->txn_id;
+        if (group_ctx->number_filtered_rows == 0 && group_ctx->number_unselected_rows == 0) {
+            ctx->number_total_rows = rows;
+            ctx->number_loaded_rows = rows;
+        } else {
+            // the filtered rows can't be attributed to the requests, report the whole group
+            ctx->number_total_rows = group_ctx->number_total_rows;
+            ctx->number_loaded_rows = group_ctx->number_loaded_rows;
+            ctx->number_filtered_rows = group_ctx->number_filtered_rows;
+            ctx->number_unselected_rows = group_ctx->number_unselected_rows;
+            ctx->error_url = group_ctx->error_url;
+        }
+        ctx->loaded_bytes = bytes;
+        ctx->begin_txn_cost_nanos = group_ctx->begin_txn_cost_nanos;
+        ctx->stream_load_put_cost_nanos = group_ctx->stream_load_put_cost_nanos;
+        ctx->commit_and_publish_txn_cost_nanos = group_ctx->commit_and_publish_txn_cost_nanos;
+        return st;
+    }
+}
+
+Status GroupCommitMgr::_begin_load(GroupCommitLoad* load, StreamLoadContext* ctx) {
+    auto group_ctx = new StreamLoadContext(_exec_env);
+    group_ctx->ref();
+    load->ctx = group_ctx;
+
+    group_ctx->load_type = TLoadType::MANUL_LOAD;
+    group_ctx->load_src_type = TLoadSourceType::RAW;
+    group_ctx->db = ctx->db;
+    group_ctx->table = ctx->table;
+    group_ctx->auth = ctx->auth;
+    group_ctx->label = "group_commit_" + generate_uuid_string();
+    group_ctx->timeout_second = ctx->timeout_second;
+    group_ctx->max_filter_ratio = ctx->max_filter_ratio;
+    group_ctx->format = ctx->format;
+    group_ctx->use_streaming = true;
+
+    int64_t begin_txn_start_time = MonotonicNanos();
+    RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(group_ctx));
+    group_ctx->begin_txn_cost_nanos = MonotonicNanos() - begin_txn_start_time;
+
+    load->pipe = std::make_shared<StreamLoadPipe>();
+    RETURN_IF_ERROR(_exec_env->load_stream_mgr()->put(group_ctx->id, load->pipe));
+    group_ctx->body_sink = load->pipe;
+
+    TStreamLoadPutRequest request = ctx->put_request;
+    request.txnId = group_ctx->txn_id;
+    request.__set_loadId(group_ctx->id.to_thrift());
+#ifndef BE_TEST
+    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
+    int64_t stream_load_put_start_time = MonotonicNanos();
+    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
+            master_addr.hostname, master_addr.port,
+            [&request, group_ctx](FrontendServiceConnection& client) {
+                client->streamLoadPut(group_ctx->put_result, request);
+            }));
+    group_ctx->stream_load_put_cost_nanos = MonotonicNanos() - stream_load_put_start_time;
+#else
+    group_ctx->put_result = k_stream_load_put_result;
+#endif
+    Status plan_status(group_ctx->put_result.status);
+    if (!plan_status.ok()) {
+        LOG(WARNING) << "plan group commit load failed. errmsg=" << plan_status.get_error_msg()
+                     << group_ctx->brief();
+        return plan_status;
+    }
+
+    load->deadline = std::chrono::steady_clock::now() +
+                     std::chrono::milliseconds(config::group_commit_interval_ms);
+    LOG(INFO) << "begin group commit load." << group_ctx->brief() << ", db=" << group_ctx->db
+              << ", tbl=" << group_ctx->table;
+    return _exec_env->stream_load_executor()->execute_plan_fragment(group_ctx);
+}
+
+void GroupCommitMgr::_commit_load(const std::string& key,
+                                  const std::shared_ptr<GroupCommitLoad>& load) {
+    {
+        std::unique_lock<std::mutex> l(load->lock);
+        load->cond.wait_until(l, load->deadline, [&load] {
+            return load->bytes >= config::group_commit_max_bytes;
+        });
+        load->closed = true;
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _loads.find(key);
+        if (it != _loads.end() && it->second == load) {
+            _loads.erase(it);
+        }
+    }
+
+    StreamLoadContext* group_ctx = load->ctx;
+    Status st = load->pipe->finish();
+    if (st.ok()) {
+        st = group_ctx->future.get();
+    }
+    if (st.ok()) {
+        int64_t commit_and_publish_start_time = MonotonicNanos();
+        st = _exec_env->stream_load_executor()->commit_txn(group_ctx);
+        group_ctx->commit_and_publish_txn_cost_nanos =
+                MonotonicNanos() - commit_and_publish_start_time;
+    }
+    if (!st.ok() && st.code() != TStatusCode::PUBLISH_TIMEOUT) {
+        LOG(WARNING) << "group commit load failed, errmsg=" << st.get_error_msg() << ", "
+                     << group_ctx->brief();
+        load->pipe->cancel(st.get_error_msg());
+        if (group_ctx->need_rollback) {
+            _exec_env->stream_load_executor()->rollback_txn(group_ctx);
+            group_ctx->need_rollback = false;
+        }
+    } else {
+        LOG(INFO) << "finish group commit load." << group_ctx->brief()
+                  << ", bytes=" << load->bytes;
+    }
+    load->promise.set_value(st);
+}
+
+} // namespace doris
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "gen_cpp/FrontendService_types.h"
+
+namespace doris {
+
+class ExecEnv;
+class StreamLoadContext;
+class StreamLoadPipe;
+
+// GroupCommitMgr appends the concurrent small stream loads into the same table with the
+// same load parameters to a shared internal load, which is committed with one transaction
+// once it receives `group_commit_max_bytes` or `group_commit_interval_ms` elapses.
+// This saves the transactions, rowsets and versions of the high-frequency small loads.
+class GroupCommitMgr {
+public:
+    GroupCommitMgr(ExecEnv* exec_env) : _exec_env(exec_env) {}
+    ~GroupCommitMgr() = default;
+
+    // Append the whole body received by 'ctx' to the group load of its table, and wait
+    // for the group to be committed. The label, txn id and result of the group are set
+    // to 'ctx'.
+    Status group_commit(StreamLoadContext* ctx);
+
+private:
+    struct GroupCommitLoad {
+        ~GroupCommitLoad();
+
+        std::mutex lock;
+        std::condition_variable cond;
+        // the internal load, set up by the first request of the group
+        StreamLoadContext* ctx = nullptr;
+        std::shared_ptr<StreamLoadPipe> pipe;
+        int64_t bytes = 0;
+        std::chrono::steady_clock::time_point deadline;
+        // no more request can be appended once closed
+        bool closed = false;
+        Status status;
+
+        std::promise<Status> promise;
+        std::shared_future<Status> future = promise.get_future().share();
+    };
+
+    // begin the transaction of the group and start the internal load
+    Status _begin_load(GroupCommitLoad* load, StreamLoadContext* ctx);
+    // wait for the thresholds, then close and commit the group
+    void _commit_load(const std::string& key, const std::shared_ptr<GroupCommitLoad>& load);
+
+    ExecEnv* _exec_env;
+
+    std::mutex _lock;
+    // group key -> the group load accepting requests
+    std::unordered_map<std::string, std::shared_ptr<GroupCommitLoad>> _loads;
+};
+
+} // namespace doris
@@ -166,6 +166,11 @@ public:
 
     TStreamLoadPutResult put_result;
 
+    // if true, the body is appended to a group load with the other small loads,
+    // which is planned by put_request
+    bool group_commit = false;
+    TStreamLoadPutRequest put_request;
+
     std::vector<TTabletCommitInfo> commit_infos;
 
     std::promise<Status> promise;
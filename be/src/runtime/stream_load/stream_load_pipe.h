@@ -148,6 +148,30 @@ public:
         return Status::OK();
     }
 
+    bool support_read_buffer() const override { return !_use_proto; }
+
+    Status read_buffer(ByteBufferPtr* buf) override {
+        std::unique_lock<std::mutex> l(_lock);
+        while (!_cancelled && !_finished && _buf_queue.empty()) {
+            _get_cond.wait(l);
+        }
+        // cancelled
+        if (_cancelled) {
+            return Status::InternalError("cancelled: " + _cancelled_reason);
+        }
+        // finished
+        if (_buf_queue.empty()) {
+            DCHECK(_finished);
+            buf->reset();
+            return Status::OK();
+        }
+        *buf = _buf_queue.front();
+        _buf_queue.pop_front();
+        _buffered_bytes -= (*buf)->limit;
+        _put_cond.notify_one();
+        return Status::OK();
+    }
+
     Status readat(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) override {
         return Status::InternalError("Not implemented");
     }
@@ -19,9 +19,13 @@
 
 #include "exec/tablet_info.h"
 #include "olap/memtable.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/thread_context.h"
 #include "runtime/tuple_row.h"
+#include "service/brpc.h"
+#include "util/brpc_client_cache.h"
+#include "util/defer_op.h"
 #include "util/doris_metrics.h"
 
 namespace doris {
@@ -70,6 +74,7 @@ Status TabletsChannel::open(const PTabletWriterOpenRequest& request) {
 
     _num_remaining_senders = request.num_senders();
     _next_seqs.resize(_num_remaining_senders, 0);
+    _parked_packets.resize(_num_remaining_senders);
     _closed_senders.Reset(_num_remaining_senders);
 
     RETURN_IF_ERROR(_open_all_writers(request));
@@ -78,10 +83,21 @@ Status TabletsChannel::open(const PTabletWriterOpenRequest& request) {
     return Status::OK();
 }
 
-Status TabletsChannel::close(int sender_id, int64_t backend_id, bool* finished,
-                             const google::protobuf::RepeatedField<int64_t>& partition_ids,
-                             google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
-                             google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors) {
+Status TabletsChannel::close(
+        int sender_id, int64_t backend_id, bool* finished,
+        const google::protobuf::RepeatedField<int64_t>& partition_ids,
+        const google::protobuf::Map<int64_t, PSlaveTabletNodes>& slave_tablet_nodes,
+        google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
+        google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors,
+        google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>*
+                success_slave_tablet_node_ids) {
+    // resumed after the lock is released, the packets fail as the channel is finished
+    std::vector<std::function<void()>> parked_packets;
+    Defer resume_parked_packets {[&]() {
+        for (auto& resume : parked_packets) {
+            resume();
+        }
+    }};
     std::lock_guard<std::mutex> l(_lock);
     if (_state == kFinished) {
         return _close_status;
@@ -101,6 +117,7 @@ Status TabletsChannel::close(int sender_id, int64_t backend_id, bool* finished,
     *finished = (_num_remaining_senders == 0);
     if (*finished) {
         _state = kFinished;
+        parked_packets = _take_parked_packets(-1);
         // All senders are closed
         // 1. close all delta writers
         std::vector<DeltaWriter*> need_wait_writers;
@@ -131,10 +148,74 @@ Status TabletsChannel::close(int sender_id, int64_t backend_id, bool* finished,
             // tablet_vec will only contains success tablet, and then let FE judge it.
             _close_wait(writer, tablet_vec, tablet_errors);
         }
+
+        // 3. let the slave replicas pull the rowsets of single replica load
+        if (!slave_tablet_nodes.empty()) {
+            _pull_rowsets_by_slaves(*tablet_vec, slave_tablet_nodes,
+                                    success_slave_tablet_node_ids);
+        }
     }
     return Status::OK();
 }
 
+void TabletsChannel::_pull_rowsets_by_slaves(
+        const google::protobuf::RepeatedPtrField<PTabletInfo>& tablet_vec,
+        const google::protobuf::Map<int64_t, PSlaveTabletNodes>& slave_tablet_nodes,
+        google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>*
+                success_slave_tablet_node_ids) {
+    struct PullRowsetCall {
+        int64_t tablet_id;
+        int64_t node_id;
+        PTabletPullRowsetRequest request;
+        PTabletPullRowsetResult result;
+        brpc::Controller cntl;
+    };
+    // the slaves of all tablets pull in parallel
+    std::vector<std::unique_ptr<PullRowsetCall>> calls;
+    for (const auto& tablet : tablet_vec) {
+        auto nodes_it = slave_tablet_nodes.find(tablet.tablet_id());
+        if (nodes_it == slave_tablet_nodes.end()) {
+            continue;
+        }
+        PTabletPullRowsetRequest request;
+        Status st = _tablet_writers[tablet.tablet_id()]->fill_pull_rowset_request(&request);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to pull rowset of tablet " << tablet.tablet_id()
+                         << " by slave replicas, txn_id=" << _txn_id << ", err=" << st;
+            continue;
+        }
+        for (const auto& node : nodes_it->second.slave_nodes()) {
+            auto stub = ExecEnv::GetInstance()->brpc_internal_client_cache()->get_client(
+                    node.host(), node.async_internal_port());
+            if (stub == nullptr) {
+                LOG(WARNING) << "failed to get brpc stub of " << node.host() << ":"
+                             << node.async_internal_port();
+                continue;
+            }
+            auto call = std::make_unique<PullRowsetCall>();
+            call->tablet_id = tablet.tablet_id();
+            call->node_id = node.id();
+            call->request = request;
+            call->cntl.set_timeout_ms(config::slave_replica_pull_rowset_timeout_sec * 1000);
+            stub->tablet_pull_rowset(&call->cntl, &call->request, &call->result,
+                                     brpc::DoNothing());
+            calls.push_back(std::move(call));
+        }
+    }
+    for (auto& call : calls) {
+        brpc::Join(call->cntl.call_id());
+        Status st = call->cntl.Failed() ? Status::InternalError(call->cntl.ErrorText())
+                                        : Status(call->result.status());
+        if (st.ok()) {
+            (*success_slave_tablet_node_ids)[call->tablet_id].add_slave_node_ids(call->node_id);
+        } else {
+            LOG(WARNING) << "slave replica on node " << call->node_id
+                         << " failed to pull rowset of tablet " << call->tablet_id
+                         << ", txn_id=" << _txn_id << ", err=" << st;
+        }
+    }
+}
+
 void TabletsChannel::_close_wait(DeltaWriter* writer,
                                  google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
                                  google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors) {
@@ -208,6 +289,29 @@ Status TabletsChannel::reduce_mem_usage(int64_t mem_limit) {
     return Status::OK();
 }
 
+void TabletsChannel::get_active_memtable_mem_consumption(
+        std::vector<std::pair<int64_t, int64_t>>* writers_mem) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_state == kFinished) {
+        return;
+    }
+    for (auto& it : _tablet_writers) {
+        writers_mem->emplace_back(it.first, it.second->active_memtable_mem_consumption());
+    }
+}
+
+Status TabletsChannel::flush_active_memtable(int64_t tablet_id) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_state == kFinished) {
+        return _close_status;
+    }
+    auto it = _tablet_writers.find(tablet_id);
+    if (it == _tablet_writers.end()) {
+        return Status::OK();
+    }
+    return it->second->flush_active_memtable();
+}
+
 Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& request) {
     std::vector<SlotDescriptor*>* index_slots = nullptr;
     int32_t schema_hash = 0;
@@ -234,6 +338,8 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& request
         wrequest.tuple_desc = _tuple_desc;
         wrequest.slots = index_slots;
         wrequest.is_high_priority = _is_high_priority;
+        wrequest.is_partial_update = _schema->is_partial_update();
+        wrequest.partial_update_input_columns = &_schema->partial_update_input_columns();
 
         DeltaWriter* writer = nullptr;
         auto st = DeltaWriter::open(&wrequest, &writer, _is_vec);
@@ -254,17 +360,42 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& request
 
 Status TabletsChannel::cancel() {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
-    std::lock_guard<std::mutex> l(_lock);
-    if (_state == kFinished) {
-        return _close_status;
+    std::vector<std::function<void()>> parked_packets;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_state == kFinished) {
+            return _close_status;
+        }
+        for (auto& it : _tablet_writers) {
+            it.second->cancel();
+        }
+        _state = kFinished;
+        parked_packets = _take_parked_packets(-1);
     }
-    for (auto& it : _tablet_writers) {
-        it.second->cancel();
+    for (auto& resume : parked_packets) {
+        resume();
     }
-    _state = kFinished;
     return Status::OK();
 }
 
+std::vector<std::function<void()>> TabletsChannel::_take_parked_packets(int sender_id) {
+    std::vector<std::function<void()>> resumes;
+    for (int id = 0; id < static_cast<int>(_parked_packets.size()); ++id) {
+        if (sender_id >= 0 && id != sender_id) {
+            continue;
+        }
+        auto& parked_packets = _parked_packets[id];
+        for (auto it = parked_packets.begin(); it != parked_packets.end();) {
+            if (sender_id >= 0 && it->first != _next_seqs[id]) {
+                break;
+            }
+            resumes.push_back(std::move(it->second));
+            it = parked_packets.erase(it);
+        }
+    }
+    return resumes;
+}
+
 std::string TabletsChannelKey::to_string() const {
     std::stringstream ss;
     ss << *this;
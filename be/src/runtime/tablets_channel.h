@@ -18,6 +18,8 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -57,6 +59,18 @@ std::ostream& operator<<(std::ostream& os, const TabletsChannelKey& key);
 class DeltaWriter;
 class OlapTableSchemaParam;
 
+// A sender may have several add batch packets in flight. A packet arriving before the earlier
+// packets of its sender is parked in the tablets channel instead of blocking the thread, and
+// `resume` is called to process the request again once the packet before it is done, or the
+// channel is closed or cancelled.
+struct TabletWriterAddContext {
+    // set by the caller, moved into the channel if the packet is parked
+    std::function<void()> resume;
+    // set if the packet is parked, the caller must keep the request and its closure until
+    // `resume` is called
+    bool parked = false;
+};
+
 // Write channel for a particular (load, index).
 class TabletsChannel {
 public:
@@ -67,17 +81,24 @@ public:
     Status open(const PTabletWriterOpenRequest& request);
 
     // no-op when this channel has been closed or cancelled
+    // A packet out of order is parked if `ctx` is given, otherwise it's rejected.
     template <typename TabletWriterAddRequest, typename TabletWriterAddResult>
-    Status add_batch(const TabletWriterAddRequest& request, TabletWriterAddResult* response);
+    Status add_batch(const TabletWriterAddRequest& request, TabletWriterAddResult* response,
+                     TabletWriterAddContext* ctx = nullptr);
 
     // Mark sender with 'sender_id' as closed.
     // If all senders are closed, close this channel, set '*finished' to true, update 'tablet_vec'
     // to include all tablets written in this channel.
     // no-op when this channel has been closed or cancelled
+    // The slave replicas in 'slave_tablet_nodes' pull the rowsets of the written tablets, and the
+    // ones succeeded are added to 'success_slave_tablet_node_ids'.
     Status close(int sender_id, int64_t backend_id, bool* finished,
                  const google::protobuf::RepeatedField<int64_t>& partition_ids,
+                 const google::protobuf::Map<int64_t, PSlaveTabletNodes>& slave_tablet_nodes,
                  google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
-                 google::protobuf::RepeatedPtrField<PTabletError>* tablet_error);
+                 google::protobuf::RepeatedPtrField<PTabletError>* tablet_error,
+                 google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>*
+                         success_slave_tablet_node_ids);
 
     // no-op when this channel has been closed or cancelled
     Status cancel();
@@ -88,11 +109,25 @@ public:
     // no-op when this channel has been closed or cancelled
     Status reduce_mem_usage(int64_t mem_limit);
 
+    // append (tablet id, memory of the memtable accepting writes) of all writers to 'writers_mem'.
+    // no-op when this channel has been closed or cancelled
+    void get_active_memtable_mem_consumption(
+            std::vector<std::pair<int64_t, int64_t>>* writers_mem);
+
+    // submit the memtable accepting writes of the tablet to flush queue without waiting.
+    // no-op when this channel has been closed or cancelled
+    Status flush_active_memtable(int64_t tablet_id);
+
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
 
 private:
     template <typename Request>
-    Status _get_current_seq(int64_t& cur_seq, const Request& request);
+    Status _get_current_seq(int64_t& cur_seq, const Request& request,
+                            TabletWriterAddContext* ctx);
+
+    // Takes out the parked packets to resume, the next one of `sender_id` if it's not less than
+    // 0, otherwise all of them. REQUIRES: _lock is held
+    std::vector<std::function<void()>> _take_parked_packets(int sender_id);
 
     // open all writer
     Status _open_all_writers(const PTabletWriterOpenRequest& request);
@@ -102,6 +137,14 @@ private:
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
                      google::protobuf::RepeatedPtrField<PTabletError>* tablet_error);
 
+    // ask the slave replicas of single replica load to pull the rowsets of the tablets in
+    // 'tablet_vec', and wait for them.
+    void _pull_rowsets_by_slaves(
+            const google::protobuf::RepeatedPtrField<PTabletInfo>& tablet_vec,
+            const google::protobuf::Map<int64_t, PSlaveTabletNodes>& slave_tablet_nodes,
+            google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>*
+                    success_slave_tablet_node_ids);
+
     // id of this load channel
     TabletsChannelKey _key;
 
@@ -127,6 +170,8 @@ private:
     // next sequence we expect
     int _num_remaining_senders = 0;
     std::vector<int64_t> _next_seqs;
+    // sender id -> packet seq -> resume of the packet, which arrives before the previous ones
+    std::vector<std::map<int64_t, std::function<void()>>> _parked_packets;
     Bitmap _closed_senders;
     // status to return when operate on an already closed/cancelled channel
     // currently it's OK.
@@ -151,7 +196,8 @@ private:
 };
 
 template <typename Request>
-Status TabletsChannel::_get_current_seq(int64_t& cur_seq, const Request& request) {
+Status TabletsChannel::_get_current_seq(int64_t& cur_seq, const Request& request,
+                                        TabletWriterAddContext* ctx) {
     std::lock_guard<std::mutex> l(_lock);
     if (_state != kOpened) {
         return _state == kFinished
@@ -160,6 +206,18 @@ Status TabletsChannel::_get_current_seq(int64_t& cur_seq, const Request& request
                                                                    _key.to_string(), _state));
     }
     cur_seq = _next_seqs[request.sender_id()];
+    // the previous packets in flight are not done, process this one after them
+    if (request.packet_seq() > cur_seq && ctx != nullptr && ctx->resume) {
+        auto& parked_packets = _parked_packets[request.sender_id()];
+        if (parked_packets.count(request.packet_seq()) > 0) {
+            return Status::InternalError(strings::Substitute(
+                    "duplicated data packet, sender_id=$0, packet_seq=$1", request.sender_id(),
+                    request.packet_seq()));
+        }
+        parked_packets.emplace(request.packet_seq(), std::move(ctx->resume));
+        ctx->parked = true;
+        return Status::OK();
+    }
     // check packet
     if (request.packet_seq() > cur_seq) {
         LOG(WARNING) << "lost data packet, expect_seq=" << cur_seq
@@ -171,12 +229,12 @@ Status TabletsChannel::_get_current_seq(int64_t& cur_seq, const Request& request
 
 template <typename TabletWriterAddRequest, typename TabletWriterAddResult>
 Status TabletsChannel::add_batch(const TabletWriterAddRequest& request,
-                                 TabletWriterAddResult* response) {
+                                 TabletWriterAddResult* response, TabletWriterAddContext* ctx) {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     int64_t cur_seq = 0;
 
-    auto status = _get_current_seq(cur_seq, request);
-    if (UNLIKELY(!status.ok())) {
+    auto status = _get_current_seq(cur_seq, request, ctx);
+    if (UNLIKELY(!status.ok()) || (ctx != nullptr && ctx->parked)) {
         return status;
     }
 
@@ -234,9 +292,14 @@ Status TabletsChannel::add_batch(const TabletWriterAddRequest& request,
         }
     }
 
+    std::vector<std::function<void()>> parked_packets;
     {
         std::lock_guard<std::mutex> l(_lock);
         _next_seqs[request.sender_id()] = cur_seq + 1;
+        parked_packets = _take_parked_packets(request.sender_id());
+    }
+    for (auto& resume : parked_packets) {
+        resume();
     }
     return Status::OK();
 }
@@ -87,9 +87,11 @@ AttachTaskThread::AttachTaskThread(const RuntimeState* runtime_state,
                       print_id(runtime_state->query_id()), runtime_state->fragment_instance_id(),
                       mem_tracker);
 #endif
+    tls_ctx()->_column_buffer_pool = runtime_state->column_buffer_pool();
 }
 
 AttachTaskThread::~AttachTaskThread() {
+    tls_ctx()->_column_buffer_pool = nullptr;
 #ifdef USE_MEM_TRACKER
     tls_ctx()->detach();
     DorisMetrics::instance()->attach_task_thread_count->increment(1);
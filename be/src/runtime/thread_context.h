@@ -28,6 +28,7 @@
 #include "gen_cpp/PaloInternalService_types.h" // for TQueryType
 #include "runtime/thread_mem_tracker_mgr.h"
 #include "runtime/threadlocal.h"
+#include "util/sampling_profiler.h"
 
 // Attach to task when thread starts
 #define SCOPED_ATTACH_TASK_THREAD(type, ...) \
@@ -88,6 +89,10 @@ namespace doris {
 
 class TUniqueId;
 
+namespace vectorized {
+class ColumnBufferPool;
+} // namespace vectorized
+
 extern bthread_key_t btls_key;
 
 // The thread context saves some info about a working thread.
@@ -131,14 +136,17 @@ public:
         _type = type;
         _task_id = task_id;
         _fragment_instance_id = fragment_instance_id;
+        SamplingProfiler::set_thread_fragment_instance(fragment_instance_id);
         _thread_mem_tracker_mgr->attach_task(TaskTypeStr[_type], task_id, fragment_instance_id,
                                              mem_tracker);
     }
 
     void detach() {
+        _column_buffer_pool = nullptr;
         _type = TaskType::UNKNOWN;
         _task_id = "";
         _fragment_instance_id = TUniqueId();
+        SamplingProfiler::set_thread_fragment_instance(TUniqueId());
         _thread_mem_tracker_mgr->detach_task();
     }
 
@@ -173,6 +181,8 @@ public:
     // to nullptr, but the object it points to is not initialized. At this time, when the memory
     // is released somewhere, the TCMalloc hook is triggered to cause the crash.
     std::unique_ptr<ThreadMemTrackerMgr> _thread_mem_tracker_mgr;
+    // The column buffer pool of the fragment instance attached, used by vectorized::Allocator.
+    vectorized::ColumnBufferPool* _column_buffer_pool = nullptr;
 
 private:
     std::string _thread_id;
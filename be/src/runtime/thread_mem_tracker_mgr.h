@@ -122,6 +122,9 @@ public:
     bool is_attach_task() { return _task_id != ""; }
 
     std::shared_ptr<MemTracker> mem_tracker();
+    // Does not copy the shared_ptr, whose use count is shared by all the threads attached to
+    // the same tracker, on the hot paths.
+    MemTracker* raw_mem_tracker();
 
     void update_check_limit(bool check_limit) { _check_limit = check_limit; }
 
@@ -272,18 +275,19 @@ inline void ThreadMemTrackerMgr::cache_consume(int64_t size) {
             noncache_try_consume(_untracked_mem);
             _check_limit = true;
         } else {
-            mem_tracker()->consume(_untracked_mem);
+            raw_mem_tracker()->consume(_untracked_mem);
         }
         _untracked_mem = 0;
     }
 }
 
 inline void ThreadMemTrackerMgr::noncache_try_consume(int64_t size) {
-    Status st = mem_tracker()->try_consume(size);
+    MemTracker* tracker = raw_mem_tracker();
+    Status st = tracker->try_consume(size);
     if (!st) {
         // The memory has been allocated, so when TryConsume fails, need to continue to complete
         // the consume to ensure the accuracy of the statistics.
-        mem_tracker()->consume(size);
+        tracker->consume(size);
         exceeded(size, st);
     }
 }
@@ -304,4 +308,10 @@ inline std::shared_ptr<MemTracker> ThreadMemTrackerMgr::mem_tracker() {
     return _mem_trackers[_tracker_id];
 }
 
+inline MemTracker* ThreadMemTrackerMgr::raw_mem_tracker() {
+    DCHECK(_mem_trackers.find(_tracker_id) != _mem_trackers.end()) << print_debug_string();
+    DCHECK(_mem_trackers[_tracker_id]) << print_debug_string();
+    return _mem_trackers[_tracker_id].get();
+}
+
 } // namespace doris
@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/workload_group.h"
+
+#include <fmt/format.h>
+
+#include <cctype>
+#include <limits>
+
+#include "agent/cgroups_mgr.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "util/pretty_printer.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const std::string WorkloadGroup::CGROUP_USER = "workload_group";
+
+Status WorkloadGroupInfo::validate() const {
+    if (name.empty()) {
+        return Status::InvalidArgument("the name of workload group is empty");
+    }
+    for (char c : name) {
+        if (!isalnum(c) && c != '_' && c != '-') {
+            return Status::InvalidArgument(
+                    fmt::format("invalid workload group name {}, only letters, digits, '_' "
+                                "and '-' are allowed",
+                                name));
+        }
+    }
+    // the range of cpu.shares of cgroup v1
+    if (cpu_share < 2 || cpu_share > 262144) {
+        return Status::InvalidArgument(
+                fmt::format("cpu_share of workload group should be in [2, 262144], but got {}",
+                            cpu_share));
+    }
+    if (memory_limit == 0 || memory_limit < -1) {
+        return Status::InvalidArgument(fmt::format(
+                "memory_limit of workload group should be positive or -1, but got {}",
+                memory_limit));
+    }
+    if (scan_thread_num == 0 || scan_thread_num < -1) {
+        return Status::InvalidArgument(fmt::format(
+                "scan_thread_num of workload group should be positive or -1, but got {}",
+                scan_thread_num));
+    }
+    return Status::OK();
+}
+
+std::string WorkloadGroupInfo::debug_string() const {
+    return fmt::format("name={}, cpu_share={}, memory_limit={}, scan_thread_num={}, "
+                       "memory_policy={}",
+                       name, cpu_share,
+                       memory_limit > 0 ? PrettyPrinter::print(memory_limit, TUnit::BYTES) : "-1",
+                       scan_thread_num,
+                       memory_policy == WorkloadGroupMemoryPolicy::CANCEL ? "cancel" : "fail");
+}
+
+// The limit of the group trackers without a hard limit.
+static int64_t max_group_mem_limit(const std::shared_ptr<MemTracker>& parent) {
+    return parent->has_limit() ? parent->limit() : std::numeric_limits<int64_t>::max();
+}
+
+WorkloadGroup::WorkloadGroup(const WorkloadGroupInfo& info)
+        : _name(info.name), _info(info), _scan_thread_num(info.scan_thread_num) {
+    auto parent = ExecEnv::GetInstance()->query_pool_mem_tracker();
+    if (parent == nullptr) {
+        // the query pool is not initialized in unit tests
+        parent = MemTracker::get_process_tracker();
+    }
+    // the tracker always has a limit, which is changed in place by _update_tracker_limit()
+    _mem_tracker = MemTracker::create_tracker(max_group_mem_limit(parent), "WorkloadGroup:" + _name,
+                                              parent, MemTrackerLevel::OVERVIEW);
+    _update_tracker_limit();
+}
+
+WorkloadGroup::~WorkloadGroup() = default;
+
+WorkloadGroupInfo WorkloadGroup::info() const {
+    std::lock_guard<std::mutex> l(_lock);
+    return _info;
+}
+
+void WorkloadGroup::update(const WorkloadGroupInfo& info) {
+    DCHECK_EQ(info.name, _name);
+    std::lock_guard<std::mutex> l(_lock);
+    _info = info;
+    _scan_thread_num = info.scan_thread_num;
+    _update_tracker_limit();
+}
+
+void WorkloadGroup::_update_tracker_limit() {
+    // With the CANCEL policy the group may go beyond its limit, the queries are cancelled by
+    // the cancel worker of FragmentMgr instead.
+    int64_t limit = max_group_mem_limit(_mem_tracker->parent());
+    if (_info.memory_policy == WorkloadGroupMemoryPolicy::FAIL && _info.memory_limit > 0) {
+        limit = std::min(limit, _info.memory_limit);
+    }
+    _mem_tracker->update_limit(limit);
+}
+
+int WorkloadGroup::acquire_scan_slots(int num, bool at_least_one) {
+    int running = _running_scan_num.load();
+    int granted = 0;
+    do {
+        int quota = _scan_thread_num.load();
+        granted = quota < 0 ? num : std::min(num, std::max(quota - running, 0));
+        if (granted == 0 && at_least_one && num > 0) {
+            granted = 1;
+        }
+        if (granted == 0) {
+            return 0;
+        }
+    } while (!_running_scan_num.compare_exchange_weak(running, running + granted));
+    return granted;
+}
+
+void WorkloadGroup::release_scan_slots(int num) {
+    _running_scan_num -= num;
+    DCHECK_GE(_running_scan_num.load(), 0);
+}
+
+void WorkloadGroup::add_query(const TUniqueId& query_id,
+                              const std::shared_ptr<MemTracker>& tracker) {
+    std::lock_guard<std::mutex> l(_lock);
+    _queries[query_id] = tracker;
+}
+
+bool WorkloadGroup::get_query_to_cancel(TUniqueId* query_id) {
+    std::lock_guard<std::mutex> l(_lock);
+    bool exceeded = _info.memory_policy == WorkloadGroupMemoryPolicy::CANCEL &&
+                    _info.memory_limit > 0 && _mem_tracker->consumption() > _info.memory_limit;
+    int64_t max_consumption = -1;
+    for (auto it = _queries.begin(); it != _queries.end();) {
+        auto tracker = it->second.lock();
+        if (tracker == nullptr) {
+            it = _queries.erase(it);
+            continue;
+        }
+        if (exceeded && tracker->consumption() > max_consumption) {
+            max_consumption = tracker->consumption();
+            *query_id = it->first;
+        }
+        ++it;
+    }
+    return exceeded && max_consumption >= 0;
+}
+
+void WorkloadGroup::apply_cgroup() const {
+    CgroupsMgr::apply_cgroup(CGROUP_USER, _name);
+}
+
+std::string WorkloadGroup::debug_string() const {
+    std::lock_guard<std::mutex> l(_lock);
+    return fmt::format("WorkloadGroup({}, memory_used={}, running_scan_num={}, query_num={})",
+                       _info.debug_string(),
+                       PrettyPrinter::print(_mem_tracker->consumption(), TUnit::BYTES),
+                       _running_scan_num.load(), _queries.size());
+}
+
+} // namespace doris
@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "util/hash_util.hpp"
+
+namespace doris {
+
+class MemTracker;
+
+// What to do when the queries of a workload group use more memory than its limit.
+enum class WorkloadGroupMemoryPolicy {
+    // The allocations of the queries fail once the limit is reached.
+    FAIL = 0,
+    // The queries may go beyond the limit, but the query of the group using the most memory
+    // is cancelled until the group is back under the limit.
+    CANCEL = 1,
+};
+
+struct WorkloadGroupInfo {
+    std::string name;
+    // The relative weight of the cpu time of the execution threads, written to the
+    // cpu.shares of the cgroup of the group.
+    int cpu_share = 1024;
+    // The memory limit of all the queries of the group in bytes, -1 means no limit.
+    int64_t memory_limit = -1;
+    // The max number of the running scanners of the group in the scanner pool,
+    // -1 means no quota.
+    int scan_thread_num = -1;
+    WorkloadGroupMemoryPolicy memory_policy = WorkloadGroupMemoryPolicy::FAIL;
+
+    Status validate() const;
+    std::string debug_string() const;
+};
+
+// A workload group shares the resources of a BE among its queries.
+//
+// - Memory: the query mem trackers of the group are the children of the group tracker, which
+//   is a child of the query pool tracker, so the group limit is enforced by the MemTracker
+//   hierarchy.
+// - Scan threads: the scanners of the group take quota from the group before they are
+//   submitted to the scanner pool, see ScannerContext.
+// - CPU: the execution threads of the group are moved to the cgroup of the group, under
+//   `<doris_cgroups>/workload_group/<name>`, when cgroups are configured.
+//
+// The resources are updated in place at runtime, the queries running already see the new
+// settings at once.
+class WorkloadGroup {
+public:
+    // The cgroup "user" of the workload groups, every group is a level under it.
+    static const std::string CGROUP_USER;
+
+    explicit WorkloadGroup(const WorkloadGroupInfo& info);
+    ~WorkloadGroup();
+
+    const std::string& name() const { return _name; }
+    WorkloadGroupInfo info() const;
+
+    void update(const WorkloadGroupInfo& info);
+
+    std::shared_ptr<MemTracker> mem_tracker() const { return _mem_tracker; }
+
+    // Takes up to `num` scan slots, returns the number taken. If `at_least_one` is true, a
+    // slot is taken even if the quota is used up, which keeps a query from being starved
+    // when nothing of it is running.
+    int acquire_scan_slots(int num, bool at_least_one);
+    void release_scan_slots(int num);
+    int running_scan_num() const { return _running_scan_num.load(); }
+
+    void add_query(const TUniqueId& query_id, const std::shared_ptr<MemTracker>& tracker);
+    // Returns false if the group is under its memory limit or the policy is not CANCEL,
+    // otherwise sets `query_id` to the query of the group using the most memory.
+    bool get_query_to_cancel(TUniqueId* query_id);
+
+    // Moves the calling thread to the cgroup of the group.
+    void apply_cgroup() const;
+
+    std::string debug_string() const;
+
+private:
+    void _update_tracker_limit();
+
+    const std::string _name;
+
+    mutable std::mutex _lock;
+    // protected by _lock
+    WorkloadGroupInfo _info;
+    std::unordered_map<TUniqueId, std::weak_ptr<MemTracker>> _queries;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+    std::atomic<int> _scan_thread_num;
+    std::atomic<int> _running_scan_num {0};
+};
+
+} // namespace doris
@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/workload_group_mgr.h"
+
+#include "agent/cgroups_mgr.h"
+#include "common/logging.h"
+#include "runtime/exec_env.h"
+
+namespace doris {
+
+WorkloadGroupMgr::WorkloadGroupMgr(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+WorkloadGroupMgr::~WorkloadGroupMgr() = default;
+
+Status WorkloadGroupMgr::create_or_update_group(const WorkloadGroupInfo& info) {
+    RETURN_IF_ERROR(info.validate());
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _groups.find(info.name);
+    if (it == _groups.end()) {
+        _groups.emplace(info.name, std::make_shared<WorkloadGroup>(info));
+        LOG(INFO) << "create workload group: " << info.debug_string();
+    } else {
+        it->second->update(info);
+        LOG(INFO) << "update workload group: " << info.debug_string();
+    }
+    _update_cgroup(info);
+    return Status::OK();
+}
+
+Status WorkloadGroupMgr::drop_group(const std::string& name) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_groups.erase(name) == 0) {
+        return Status::NotFound("workload group " + name + " does not exist");
+    }
+    LOG(INFO) << "drop workload group: " << name;
+    return Status::OK();
+}
+
+std::shared_ptr<WorkloadGroup> WorkloadGroupMgr::get_group(const std::string& name) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _groups.find(name);
+    return it == _groups.end() ? nullptr : it->second;
+}
+
+void WorkloadGroupMgr::get_groups(std::vector<std::shared_ptr<WorkloadGroup>>* groups) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& [_, group] : _groups) {
+        groups->push_back(group);
+    }
+}
+
+void WorkloadGroupMgr::get_queries_to_cancel(std::vector<TUniqueId>* query_ids) {
+    std::vector<std::shared_ptr<WorkloadGroup>> groups;
+    get_groups(&groups);
+    for (auto& group : groups) {
+        TUniqueId query_id;
+        if (group->get_query_to_cancel(&query_id)) {
+            query_ids->push_back(query_id);
+        }
+    }
+}
+
+void WorkloadGroupMgr::_update_cgroup(const WorkloadGroupInfo& info) {
+    auto cgroups_mgr = _exec_env->cgroups_mgr();
+    if (cgroups_mgr == nullptr || !cgroups_mgr->is_cgroups_init_success()) {
+        return;
+    }
+    // the groups share the cpu of the "workload_group" cgroup by their own cpu.shares
+    WARN_IF_ERROR(cgroups_mgr->modify_user_cgroups(WorkloadGroup::CGROUP_USER,
+                                                   {{"cpu.shares", 1024}},
+                                                   {{info.name, info.cpu_share}}),
+                  "failed to update the cgroup of workload group " + info.name);
+}
+
+} // namespace doris
@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "runtime/workload_group.h"
+
+namespace doris {
+
+class ExecEnv;
+
+// Manages the workload groups of the BE, the groups are created, updated and dropped at
+// runtime through the http api, and a query joins a group by the `workload_group` query
+// option. Owned by ExecEnv.
+class WorkloadGroupMgr {
+public:
+    explicit WorkloadGroupMgr(ExecEnv* exec_env);
+    ~WorkloadGroupMgr();
+
+    // Creates the group if it does not exist, otherwise updates it in place.
+    Status create_or_update_group(const WorkloadGroupInfo& info);
+    // The queries running in the group keep using it until they finish.
+    Status drop_group(const std::string& name);
+
+    // Returns nullptr if the group does not exist.
+    std::shared_ptr<WorkloadGroup> get_group(const std::string& name);
+    void get_groups(std::vector<std::shared_ptr<WorkloadGroup>>* groups);
+
+    // Called by the cancel worker of FragmentMgr periodically, gets the queries to cancel of
+    // the groups going beyond their memory limit with the CANCEL policy, one for each group.
+    void get_queries_to_cancel(std::vector<TUniqueId>* query_ids);
+
+private:
+    // Creates the cgroup of the group and sets its cpu.shares, does nothing if cgroups
+    // are not configured.
+    void _update_cgroup(const WorkloadGroupInfo& info);
+
+    ExecEnv* _exec_env;
+
+    std::mutex _lock;
+    std::unordered_map<std::string, std::shared_ptr<WorkloadGroup>> _groups;
+};
+
+} // namespace doris
@@ -30,7 +30,9 @@
 #include <brpc/protocol.h>
 #include <brpc/reloadable_flags.h>
 #include <brpc/server.h>
+#include <brpc/stream.h>
 #include <bthread/bthread.h>
+#include <bthread/countdown_event.h>
 #include <bthread/types.h>
 #include <butil/containers/flat_map.h>
 #include <butil/containers/flat_map_inl.h>
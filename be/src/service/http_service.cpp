@@ -27,6 +27,7 @@
 #include "http/action/metrics_action.h"
 #include "http/action/mini_load.h"
 #include "http/action/pprof_actions.h"
+#include "http/action/query_trace_action.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/reset_rpc_channel_action.h"
 #include "http/action/restore_tablet_action.h"
@@ -36,6 +37,8 @@
 #include "http/action/tablet_migration_action.h"
 #include "http/action/tablets_distribution_action.h"
 #include "http/action/tablets_info_action.h"
+#include "http/action/tablets_scan_stats_action.h"
+#include "http/action/workload_group_action.h"
 #include "http/default_path_handlers.h"
 #include "http/ev_http_server.h"
 #include "http/http_method.h"
@@ -102,6 +105,11 @@ Status HttpService::start() {
     _ev_http_server->register_handler(HttpMethod::GET, "/api/tablets_distribution",
                                       tablets_distribution_action);
 
+    // Register Tablets Scan Stats action
+    TabletsScanStatsAction* tablets_scan_stats_action = _pool.add(new TabletsScanStatsAction());
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/tablets_scan_stats",
+                                      tablets_scan_stats_action);
+
     // Register tablet migration action
     TabletMigrationAction* tablet_migration_action = _pool.add(new TabletMigrationAction());
     _ev_http_server->register_handler(HttpMethod::GET, "/api/tablet_migration",
@@ -158,6 +166,17 @@ Status HttpService::start() {
     ConfigAction* show_config_action = _pool.add(new ConfigAction(ConfigActionType::SHOW_CONFIG));
     _ev_http_server->register_handler(HttpMethod::GET, "/api/show_config", show_config_action);
 
+    WorkloadGroupAction* workload_group_action = _pool.add(new WorkloadGroupAction(_env));
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/workload_group",
+                                      workload_group_action);
+    _ev_http_server->register_handler(HttpMethod::POST, "/api/workload_group",
+                                      workload_group_action);
+    _ev_http_server->register_handler(HttpMethod::DELETE, "/api/workload_group",
+                                      workload_group_action);
+
+    QueryTraceAction* query_trace_action = _pool.add(new QueryTraceAction());
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/query_trace", query_trace_action);
+
     // 3 check action
     CheckRPCChannelAction* check_rpc_channel_action = _pool.add(new CheckRPCChannelAction(_env));
     _ev_http_server->register_handler(HttpMethod::GET,
@@ -20,6 +20,7 @@
 #include "common/config.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "olap/task/engine_pull_rowset_task.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/exec_env.h"
@@ -31,13 +32,18 @@
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "service/brpc.h"
+#include "service/point_query_executor.h"
 #include "util/brpc_client_cache.h"
+#include "util/doris_metrics.h"
 #include "util/md5.h"
 #include "util/proto_util.h"
 #include "util/string_util.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 #include "vec/runtime/vdata_stream_mgr.h"
+#include "vec/runtime/vexchange_relay.h"
+#include "vec/runtime/vexchange_stream.h"
 
 namespace doris {
 
@@ -72,7 +78,9 @@ private:
 };
 
 PInternalServiceImpl::PInternalServiceImpl(ExecEnv* exec_env)
-        : _exec_env(exec_env), _tablet_worker_pool(config::number_tablet_writer_threads, 10240) {
+        : _exec_env(exec_env),
+          _tablet_worker_pool(config::number_tablet_writer_threads, 10240),
+          _slave_replica_worker_pool(config::number_slave_replica_download_threads, 10240) {
     REGISTER_HOOK_METRIC(add_batch_task_queue_size,
                          [this]() { return _tablet_worker_pool.get_queue_size(); });
     CHECK_EQ(0, bthread_key_create(&btls_key, thread_context_deleter));
@@ -238,26 +246,46 @@ void PInternalServiceImpl::_tablet_writer_add_block(google::protobuf::RpcControl
              << ", current_queued_size=" << _tablet_worker_pool.get_queue_size();
     int64_t submit_task_time_ns = MonotonicNanos();
     _tablet_worker_pool.offer([request, response, done, submit_task_time_ns, this]() {
-        int64_t wait_execution_time_ns = MonotonicNanos() - submit_task_time_ns;
-        brpc::ClosureGuard closure_guard(done);
-        int64_t execution_time_ns = 0;
-        {
-            SCOPED_RAW_TIMER(&execution_time_ns);
-            SCOPED_ATTACH_TASK_THREAD(ThreadContext::TaskType::LOAD,
-                                      _exec_env->load_channel_mgr()->mem_tracker());
+        _add_block_in_worker(request, response, done, submit_task_time_ns);
+    });
+}
 
-            auto st = _exec_env->load_channel_mgr()->add_batch(*request, response);
-            if (!st.ok()) {
-                LOG(WARNING) << "tablet writer add block failed, message=" << st.get_error_msg()
-                             << ", id=" << request->id() << ", index_id=" << request->index_id()
-                             << ", sender_id=" << request->sender_id()
-                             << ", backend id=" << request->backend_id();
-            }
-            st.to_protobuf(response->mutable_status());
+void PInternalServiceImpl::_add_block_in_worker(const PTabletWriterAddBlockRequest* request,
+                                                PTabletWriterAddBlockResult* response,
+                                                google::protobuf::Closure* done,
+                                                int64_t submit_task_time_ns) {
+    int64_t wait_execution_time_ns = MonotonicNanos() - submit_task_time_ns;
+    brpc::ClosureGuard closure_guard(done);
+    int64_t execution_time_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&execution_time_ns);
+        SCOPED_ATTACH_TASK_THREAD(ThreadContext::TaskType::LOAD,
+                                  _exec_env->load_channel_mgr()->mem_tracker());
+
+        // the time parked is counted in the wait time
+        TabletWriterAddContext ctx;
+        ctx.resume = [request, response, done, submit_task_time_ns, this]() {
+            _tablet_worker_pool.offer([request, response, done, submit_task_time_ns, this]() {
+                _add_block_in_worker(request, response, done, submit_task_time_ns);
+            });
+        };
+        auto st = _exec_env->load_channel_mgr()->add_batch(*request, response, &ctx);
+        if (ctx.parked) {
+            closure_guard.release();
+            return;
         }
-        response->set_execution_time_us(execution_time_ns / NANOS_PER_MICRO);
-        response->set_wait_execution_time_us(wait_execution_time_ns / NANOS_PER_MICRO);
-    });
+        if (!st.ok()) {
+            LOG(WARNING) << "tablet writer add block failed, message=" << st.get_error_msg()
+                         << ", id=" << request->id() << ", index_id=" << request->index_id()
+                         << ", sender_id=" << request->sender_id()
+                         << ", backend id=" << request->backend_id();
+        }
+        st.to_protobuf(response->mutable_status());
+    }
+    response->set_execution_time_us(execution_time_ns / NANOS_PER_MICRO);
+    response->set_wait_execution_time_us(wait_execution_time_ns / NANOS_PER_MICRO);
+    DorisMetrics::instance()->tablet_writer_add_block_latency_us->add(
+            (execution_time_ns + wait_execution_time_ns) / NANOS_PER_MICRO);
 }
 
 void PInternalServiceImpl::tablet_writer_add_batch(google::protobuf::RpcController* cntl_base,
@@ -354,11 +382,7 @@ Status PInternalServiceImpl::_exec_plan_fragment(const std::string& ser_request,
             uint32_t len = ser_request.size();
             RETURN_IF_ERROR(deserialize_thrift_msg(buf, &len, compact, &t_request));
         }
-
-        for (const TExecPlanFragmentParams& params : t_request.paramsList) {
-            RETURN_IF_ERROR(_exec_env->fragment_mgr()->exec_plan_fragment(params));
-        }
-        return Status::OK();
+        return _exec_env->fragment_mgr()->exec_plan_fragments(t_request);
     } else {
         return Status::InternalError("invalid version");
     }
@@ -638,6 +662,7 @@ void PInternalServiceImpl::_transmit_block(google::protobuf::RpcController* cntl
                                            PTransmitDataResult* response,
                                            google::protobuf::Closure* done,
                                            const Status& extract_st) {
+    int64_t start_ns = MonotonicNanos();
     std::string query_id;
     TUniqueId finst_id;
     std::shared_ptr<MemTracker> query_tracker;
@@ -660,6 +685,11 @@ void PInternalServiceImpl::_transmit_block(google::protobuf::RpcController* cntl
     // give response a default value to avoid null pointers in high concurrency.
     Status st;
     st.to_protobuf(response->mutable_status());
+    if (extract_st.ok() && request->relay_destinations_size() > 0) {
+        // relay the block to the other receivers first, and answer when all of them are done
+        done = vectorized::ExchangeRelayClosure::relay(
+                _exec_env, static_cast<brpc::Controller*>(cntl_base), *request, done);
+    }
     if (extract_st.ok()) {
         st = _exec_env->vstream_mgr()->transmit_block(request, &done);
         if (!st.ok()) {
@@ -674,6 +704,8 @@ void PInternalServiceImpl::_transmit_block(google::protobuf::RpcController* cntl
         st.to_protobuf(response->mutable_status());
         done->Run();
     }
+    DorisMetrics::instance()->transmit_block_latency_us->add((MonotonicNanos() - start_ns) /
+                                                             NANOS_PER_MICRO);
 }
 
 void PInternalServiceImpl::check_rpc_channel(google::protobuf::RpcController* controller,
@@ -749,4 +781,61 @@ void PInternalServiceImpl::hand_shake(google::protobuf::RpcController* cntl_base
     response->mutable_status()->set_status_code(0);
 }
 
+void PInternalServiceImpl::open_exchange_stream(google::protobuf::RpcController* cntl_base,
+                                                const POpenExchangeStreamRequest* request,
+                                                POpenExchangeStreamResult* response,
+                                                google::protobuf::Closure* done) {
+    SCOPED_SWITCH_BTHREAD();
+    brpc::ClosureGuard closure_guard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+    auto handler = new vectorized::ExchangeStreamHandler(_exec_env);
+    brpc::StreamOptions options;
+    options.handler = handler;
+    brpc::StreamId stream_id;
+    Status st;
+    if (brpc::StreamAccept(&stream_id, *cntl, &options) != 0) {
+        delete handler;
+        st = Status::InternalError("failed to accept exchange stream");
+        LOG(WARNING) << st << ", fragment_instance_id=" << print_id(request->finst_id())
+                     << ", node=" << request->node_id();
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
+// Runs in the brpc worker directly rather than in a thread pool, the lookups are expected to
+// be short, mostly served by the row cache and the page cache.
+void PInternalServiceImpl::tablet_key_lookup(google::protobuf::RpcController* controller,
+                                             const PTabletKeyLookupRequest* request,
+                                             PTabletKeyLookupResponse* response,
+                                             google::protobuf::Closure* done) {
+    SCOPED_SWITCH_BTHREAD();
+    brpc::ClosureGuard closure_guard(done);
+    PointQueryExecutor executor;
+    Status st = executor.init(request, response);
+    if (st.ok()) {
+        st = executor.lookup();
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to look up keys in tablet " << request->tablet_id() << ": " << st;
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
+void PInternalServiceImpl::tablet_pull_rowset(google::protobuf::RpcController* controller,
+                                              const PTabletPullRowsetRequest* request,
+                                              PTabletPullRowsetResult* response,
+                                              google::protobuf::Closure* done) {
+    bool ret = _slave_replica_worker_pool.offer([request, response, done]() {
+        brpc::ClosureGuard closure_guard(done);
+        EnginePullRowsetTask task(*request);
+        Status st = task.execute();
+        st.to_protobuf(response->mutable_status());
+    });
+    if (!ret) {
+        brpc::ClosureGuard closure_guard(done);
+        Status::InternalError("failed to offer the pull rowset task")
+                .to_protobuf(response->mutable_status());
+    }
+}
+
 } // namespace doris
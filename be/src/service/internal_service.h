@@ -149,6 +149,21 @@ public:
     void hand_shake(google::protobuf::RpcController* controller, const PHandShakeRequest* request,
                     PHandShakeResponse* response, google::protobuf::Closure* done) override;
 
+    void open_exchange_stream(google::protobuf::RpcController* controller,
+                              const POpenExchangeStreamRequest* request,
+                              POpenExchangeStreamResult* response,
+                              google::protobuf::Closure* done) override;
+
+    void tablet_key_lookup(google::protobuf::RpcController* controller,
+                           const PTabletKeyLookupRequest* request,
+                           PTabletKeyLookupResponse* response,
+                           google::protobuf::Closure* done) override;
+
+    void tablet_pull_rowset(google::protobuf::RpcController* controller,
+                            const PTabletPullRowsetRequest* request,
+                            PTabletPullRowsetResult* response,
+                            google::protobuf::Closure* done) override;
+
 private:
     Status _exec_plan_fragment(const std::string& s_request, PFragmentRequestVersion version,
                                bool compact);
@@ -175,9 +190,17 @@ private:
                                   PTabletWriterAddBlockResult* response,
                                   google::protobuf::Closure* done);
 
+    // Runs in _tablet_worker_pool. A request arriving before the earlier ones of its sender is
+    // parked in the tablets channel with `done`, and offered to the pool again to resume.
+    void _add_block_in_worker(const PTabletWriterAddBlockRequest* request,
+                              PTabletWriterAddBlockResult* response,
+                              google::protobuf::Closure* done, int64_t submit_task_time_ns);
+
 private:
     ExecEnv* _exec_env;
     PriorityThreadPool _tablet_worker_pool;
+    // runs the pulls of the rowsets of single replica load
+    PriorityThreadPool _slave_replica_worker_pool;
 };
 
 } // namespace doris
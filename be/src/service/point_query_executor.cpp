@@ -0,0 +1,195 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "service/point_query_executor.h"
+
+#include <algorithm>
+#include <numeric>
+#include <shared_mutex>
+
+#include "olap/key_coder.h"
+#include "olap/row_cache.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/segment_loader.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "olap/tuple.h"
+
+namespace doris {
+
+Status PointQueryExecutor::init(const PTabletKeyLookupRequest* request,
+                                PTabletKeyLookupResponse* response) {
+    _request = request;
+    _response = response;
+    _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request->tablet_id());
+    if (_tablet == nullptr) {
+        return Status::NotFound(fmt::format("tablet {} not found", request->tablet_id()));
+    }
+    if (_tablet->keys_type() != UNIQUE_KEYS || !_tablet->enable_unique_key_merge_on_write()) {
+        return Status::NotSupported(fmt::format(
+                "point query needs the primary key index of merge-on-write unique key tablet, "
+                "tablet {} is not",
+                request->tablet_id()));
+    }
+
+    const auto& schema = _tablet->tablet_schema();
+    for (size_t cid = 0; cid < schema.num_key_columns(); ++cid) {
+        _key_coders.push_back(get_key_coder(schema.column(cid).type()));
+    }
+    _all_cids.resize(schema.num_columns());
+    std::iota(_all_cids.begin(), _all_cids.end(), 0);
+    if (request->output_columns_size() == 0) {
+        _output_cids = _all_cids;
+    }
+    for (const auto& name : request->output_columns()) {
+        int32_t cid = schema.field_index(name);
+        if (cid < 0) {
+            return Status::InvalidArgument(
+                    fmt::format("column {} not found in tablet {}", name, request->tablet_id()));
+        }
+        _output_cids.push_back(cid);
+    }
+
+    {
+        std::shared_lock rdlock(_tablet->get_header_lock());
+        _version = _tablet->max_version().second;
+        RETURN_IF_ERROR(_tablet->capture_consistent_rowsets({0, _version}, &_rowsets));
+    }
+    // newer rowsets first, in which the visible rows are looked up first
+    std::sort(_rowsets.begin(), _rowsets.end(),
+              [](const RowsetSharedPtr& lhs, const RowsetSharedPtr& rhs) {
+                  return lhs->end_version() > rhs->end_version();
+              });
+    // DELETE FROM writes delete predicates into rowsets rather than the delete bitmap, they
+    // are not applied to the rows looked up until compaction removes them
+    for (const auto& rowset : _rowsets) {
+        if (rowset->rowset_meta()->has_delete_predicate()) {
+            return Status::NotSupported(fmt::format(
+                    "point query doesn't support delete predicates, tablet {} has one in rowset "
+                    "{} of version {}",
+                    request->tablet_id(), rowset->rowset_id().to_string(),
+                    rowset->end_version()));
+        }
+    }
+    return Status::OK();
+}
+
+Status PointQueryExecutor::lookup() {
+    auto output_block = _tablet->tablet_schema().create_block(_output_cids);
+    auto columns = output_block.mutate_columns();
+    for (const auto& key_tuple : _request->key_tuples()) {
+        std::string encoded_key;
+        RETURN_IF_ERROR(_encode_key(key_tuple, &encoded_key));
+        RowLocation location;
+        auto st = _tablet->lookup_row_key(encoded_key, _rowsets, &location, _version);
+        if (st.is_not_found()) {
+            _response->add_found(false);
+            continue;
+        }
+        RETURN_IF_ERROR(st);
+        std::shared_ptr<const vectorized::Block> row;
+        RETURN_IF_ERROR(_read_row(location, &row));
+        // the latest row of a key deleted by a load with delete sign is not visible either
+        if (_is_deleted(*row)) {
+            _response->add_found(false);
+            continue;
+        }
+        for (size_t i = 0; i < _output_cids.size(); ++i) {
+            columns[i]->insert_from(*row->get_by_position(_output_cids[i]).column, 0);
+        }
+        _response->add_found(true);
+    }
+    output_block.set_columns(std::move(columns));
+
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    RETURN_IF_ERROR(output_block.serialize(_response->mutable_row_block(), &uncompressed_bytes,
+                                           &compressed_bytes));
+    _response->set_version(_version);
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_encode_key(const PKeyTuple& key_tuple, std::string* encoded_key) {
+    const auto& schema = _tablet->tablet_schema();
+    if (static_cast<size_t>(key_tuple.key_column_rep_size()) != schema.num_key_columns()) {
+        return Status::InvalidArgument(fmt::format(
+                "point query needs the values of all the {} key columns, but got {}",
+                schema.num_key_columns(), key_tuple.key_column_rep_size()));
+    }
+    std::vector<std::string> values(key_tuple.key_column_rep().begin(),
+                                    key_tuple.key_column_rep().end());
+    OlapTuple tuple;
+    for (int i = 0; i < key_tuple.key_column_rep_size(); ++i) {
+        bool is_null = i < key_tuple.key_column_null_size() && key_tuple.key_column_null(i);
+        tuple.add_value(values[i], is_null);
+    }
+    RowCursor cursor;
+    RETURN_IF_ERROR(cursor.init_scan_key(schema, values));
+    RETURN_IF_ERROR(cursor.from_tuple(tuple));
+
+    std::vector<const void*> key_column_fields;
+    for (size_t cid = 0; cid < schema.num_key_columns(); ++cid) {
+        key_column_fields.push_back(cursor.is_null(cid) ? nullptr : cursor.cell_ptr(cid));
+    }
+    *encoded_key = segment_v2::SegmentWriter::full_encode_keys(schema, _key_coders,
+                                                               key_column_fields);
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_read_row(const RowLocation& location,
+                                     std::shared_ptr<const vectorized::Block>* row) {
+    auto row_cache = RowCache::instance();
+    if (row_cache != nullptr) {
+        *row = row_cache->lookup(location);
+        if (*row != nullptr) {
+            return Status::OK();
+        }
+    }
+
+    auto it = std::find_if(_rowsets.begin(), _rowsets.end(), [&](const RowsetSharedPtr& rs) {
+        return rs->rowset_id() == location.rowset_id;
+    });
+    DCHECK(it != _rowsets.end());
+    SegmentCacheHandle segment_cache_handle;
+    RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(
+            std::static_pointer_cast<BetaRowset>(*it), &segment_cache_handle, true));
+    auto& segments = segment_cache_handle.get_segments();
+    DCHECK_LT(location.segment_id, segments.size());
+
+    auto block = std::make_shared<vectorized::Block>(_tablet->tablet_schema().create_block());
+    auto columns = block->mutate_columns();
+    RETURN_IF_ERROR(
+            segments[location.segment_id]->read_row_by_rowid(location.row_id, _all_cids, &columns));
+    block->set_columns(std::move(columns));
+    if (row_cache != nullptr) {
+        row_cache->insert(location, block);
+    }
+    *row = std::move(block);
+    return Status::OK();
+}
+
+bool PointQueryExecutor::_is_deleted(const vectorized::Block& row) const {
+    int32_t delete_sign_idx = _tablet->tablet_schema().delete_sign_idx();
+    if (delete_sign_idx < 0) {
+        return false;
+    }
+    return row.get_by_position(delete_sign_idx).column->get_int(0) != 0;
+}
+
+} // namespace doris
@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/rowset.h"
+#include "olap/tablet.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+class KeyCoder;
+
+// Serves the point queries on the primary keys of merge-on-write unique key tablets without
+// planning fragments: the rows are located by the primary key indexes of the segments, read
+// from the segments directly or from RowCache, and returned in one block.
+//
+// Usage:
+//      PointQueryExecutor executor;
+//      RETURN_IF_ERROR(executor.init(request, response));
+//      RETURN_IF_ERROR(executor.lookup());
+class PointQueryExecutor {
+public:
+    // Resolves the tablet and captures the rowsets of its latest version, returns NotSupported
+    // if any of them has a delete predicate.
+    Status init(const PTabletKeyLookupRequest* request, PTabletKeyLookupResponse* response);
+
+    // Looks up the keys of the request and sets the rows found in the response.
+    Status lookup();
+
+private:
+    Status _encode_key(const PKeyTuple& key_tuple, std::string* encoded_key);
+
+    // Reads the full row at `location`, from RowCache if cached.
+    Status _read_row(const RowLocation& location, std::shared_ptr<const vectorized::Block>* row);
+
+    bool _is_deleted(const vectorized::Block& row) const;
+
+    const PTabletKeyLookupRequest* _request = nullptr;
+    PTabletKeyLookupResponse* _response = nullptr;
+
+    TabletSharedPtr _tablet;
+    int64_t _version = -1;
+    // sorted by version in descending order
+    std::vector<RowsetSharedPtr> _rowsets;
+    std::vector<const KeyCoder*> _key_coders;
+    // the columns of the tablet schema to return
+    std::vector<uint32_t> _output_cids;
+    // all the columns of the tablet schema, which are read for each row
+    std::vector<uint32_t> _all_cids;
+};
+
+} // namespace doris
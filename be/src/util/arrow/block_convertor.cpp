@@ -0,0 +1,225 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/arrow/block_convertor.h"
+
+#include <arrow/array.h>
+#include <arrow/array/builder_binary.h>
+#include <arrow/array/builder_decimal.h>
+#include <arrow/array/builder_primitive.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/status.h>
+#include <arrow/type.h>
+#include <arrow/visit_type_inline.h>
+#include <arrow/visitor.h>
+
+#include <vector>
+
+#include "util/arrow/utils.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+
+namespace doris {
+
+// Convert Block to an Arrow::Array
+// The fixed length columns are appended to the builders in bulk from their continuous
+// memory, only the types Arrow has no counterpart for are converted to text row by row.
+class FromBlockConverter : public arrow::TypeVisitor {
+public:
+    FromBlockConverter(const vectorized::Block& block, const std::shared_ptr<arrow::Schema>& schema,
+                       arrow::MemoryPool* pool)
+            : _block(block), _schema(schema), _pool(pool), _cur_field_idx(-1) {}
+
+    ~FromBlockConverter() override = default;
+
+    // Use base class function
+    using arrow::TypeVisitor::Visit;
+
+#define PRIMITIVE_VISIT(TYPE) \
+    arrow::Status Visit(const arrow::TYPE& type) override { return _visit(type); }
+
+    PRIMITIVE_VISIT(Int8Type);
+    PRIMITIVE_VISIT(Int16Type);
+    PRIMITIVE_VISIT(Int32Type);
+    PRIMITIVE_VISIT(Int64Type);
+    PRIMITIVE_VISIT(FloatType);
+    PRIMITIVE_VISIT(DoubleType);
+
+#undef PRIMITIVE_VISIT
+
+    // process string-transformable field
+    arrow::Status Visit(const arrow::StringType& type) override {
+        arrow::StringBuilder builder(_pool);
+        size_t num_rows = _block.rows();
+        ARROW_RETURN_NOT_OK(builder.Reserve(num_rows));
+        const auto* string_column = vectorized::check_and_get_column<vectorized::ColumnString>(
+                _cur_nested_column);
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (_is_null(i)) {
+                ARROW_RETURN_NOT_OK(builder.AppendNull());
+                continue;
+            }
+            if (string_column != nullptr) {
+                auto value = string_column->get_data_at(i);
+                ARROW_RETURN_NOT_OK(builder.Append(value.data, value.size));
+            } else {
+                // date, datetime, largeint and so on are presented as text
+                auto value = _cur_nested_type->to_string(*_cur_nested_column, i);
+                ARROW_RETURN_NOT_OK(builder.Append(value.data(), value.size()));
+            }
+        }
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    // process doris DecimalV2
+    arrow::Status Visit(const arrow::Decimal128Type& type) override {
+        const auto* decimal_column =
+                vectorized::check_and_get_column<vectorized::ColumnDecimal<vectorized::Decimal128>>(
+                        _cur_nested_column);
+        if (decimal_column == nullptr) {
+            return _type_mismatch();
+        }
+        std::shared_ptr<arrow::DataType> s_decimal_ptr =
+                std::make_shared<arrow::Decimal128Type>(27, 9);
+        arrow::Decimal128Builder builder(s_decimal_ptr, _pool);
+        size_t num_rows = _block.rows();
+        ARROW_RETURN_NOT_OK(builder.Reserve(num_rows));
+        const auto& data = decimal_column->get_data();
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (_is_null(i)) {
+                ARROW_RETURN_NOT_OK(builder.AppendNull());
+                continue;
+            }
+            vectorized::Int128 v = data[i].value;
+            arrow::Decimal128 value(static_cast<int64_t>(v >> 64), static_cast<uint64_t>(v));
+            ARROW_RETURN_NOT_OK(builder.Append(value));
+        }
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    // process boolean
+    arrow::Status Visit(const arrow::BooleanType& type) override {
+        const auto* bool_column =
+                vectorized::check_and_get_column<vectorized::ColumnUInt8>(_cur_nested_column);
+        if (bool_column == nullptr) {
+            return _type_mismatch();
+        }
+        arrow::BooleanBuilder builder(_pool);
+        ARROW_RETURN_NOT_OK(builder.AppendValues(bool_column->get_data().data(), _block.rows(),
+                                                 _valid_bytes()));
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    Status convert(std::shared_ptr<arrow::RecordBatch>* out);
+
+private:
+    template <typename T>
+    typename std::enable_if<std::is_base_of<arrow::PrimitiveCType, T>::value, arrow::Status>::type
+    _visit(const T& type) {
+        using ColumnType = vectorized::ColumnVector<typename T::c_type>;
+        const auto* column = vectorized::check_and_get_column<ColumnType>(_cur_nested_column);
+        if (column == nullptr) {
+            return _type_mismatch();
+        }
+        arrow::NumericBuilder<T> builder(_pool);
+        ARROW_RETURN_NOT_OK(
+                builder.AppendValues(column->get_data().data(), _block.rows(), _valid_bytes()));
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    bool _is_null(size_t row) const {
+        return _cur_null_map != nullptr && (*_cur_null_map)[row] != 0;
+    }
+
+    // Arrow marks the valid values while Doris marks the null ones
+    const uint8_t* _valid_bytes() {
+        if (_cur_null_map == nullptr) {
+            return nullptr;
+        }
+        _cur_valid_bytes.resize(_cur_null_map->size());
+        for (size_t i = 0; i < _cur_null_map->size(); ++i) {
+            _cur_valid_bytes[i] = !(*_cur_null_map)[i];
+        }
+        return _cur_valid_bytes.data();
+    }
+
+    arrow::Status _type_mismatch() const {
+        return arrow::Status::TypeError("column ", _block.get_by_position(_cur_field_idx).name,
+                                        " of type ", _cur_nested_type->get_name(),
+                                        " can't be converted to ",
+                                        _schema->field(_cur_field_idx)->type()->ToString());
+    }
+
+private:
+    const vectorized::Block& _block;
+    const std::shared_ptr<arrow::Schema>& _schema;
+    arrow::MemoryPool* _pool;
+
+    size_t _cur_field_idx;
+    vectorized::ColumnPtr _cur_column;
+    const vectorized::IColumn* _cur_nested_column = nullptr;
+    vectorized::DataTypePtr _cur_nested_type;
+    const vectorized::NullMap* _cur_null_map = nullptr;
+    std::vector<uint8_t> _cur_valid_bytes;
+
+    std::vector<std::shared_ptr<arrow::Array>> _arrays;
+};
+
+Status FromBlockConverter::convert(std::shared_ptr<arrow::RecordBatch>* out) {
+    size_t num_fields = _schema->num_fields();
+    if (_block.columns() != num_fields) {
+        return Status::InvalidArgument("number fields not match");
+    }
+
+    _arrays.resize(num_fields);
+
+    for (size_t idx = 0; idx < num_fields; ++idx) {
+        _cur_field_idx = idx;
+        const auto& column_with_type = _block.get_by_position(idx);
+        _cur_column = column_with_type.column->convert_to_full_column_if_const();
+        _cur_nested_type = vectorized::remove_nullable(column_with_type.type);
+        if (const auto* nullable_column =
+                    vectorized::check_and_get_column<vectorized::ColumnNullable>(*_cur_column)) {
+            _cur_nested_column = &nullable_column->get_nested_column();
+            _cur_null_map = &nullable_column->get_null_map_data();
+        } else {
+            _cur_nested_column = _cur_column.get();
+            _cur_null_map = nullptr;
+        }
+        auto arrow_st = arrow::VisitTypeInline(*_schema->field(idx)->type(), this);
+        if (!arrow_st.ok()) {
+            return to_status(arrow_st);
+        }
+    }
+    *out = arrow::RecordBatch::Make(_schema, _block.rows(), std::move(_arrays));
+    return Status::OK();
+}
+
+Status convert_to_arrow_batch(const vectorized::Block& block,
+                              const std::shared_ptr<arrow::Schema>& schema,
+                              arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result) {
+    FromBlockConverter converter(block, schema, pool);
+    return converter.convert(result);
+}
+
+} // namespace doris
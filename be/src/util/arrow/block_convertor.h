@@ -0,0 +1,49 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "common/status.h"
+
+// This file will convert Doris Block to Arrow's RecordBatch column by column,
+// Block is used by Doris vectorized query engine to exchange data between
+// each execute node.
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatch;
+class Schema;
+
+} // namespace arrow
+
+namespace doris {
+
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
+// Convert a Doris Block to an Arrow RecordBatch. The columns of the block are matched to the
+// fields of the given Arrow Schema by position. Memory used by result RecordBatch will be
+// allocated from input pool.
+Status convert_to_arrow_batch(const vectorized::Block& block,
+                              const std::shared_ptr<arrow::Schema>& schema,
+                              arrow::MemoryPool* pool, std::shared_ptr<arrow::RecordBatch>* result);
+
+} // namespace doris
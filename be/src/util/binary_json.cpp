@@ -0,0 +1,390 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/binary_json.h"
+
+#include <fmt/format.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/logging.h"
+#include "exprs/json_functions.h"
+#include "util/coding.h"
+
+namespace doris {
+
+// type, total size and count of an array or object
+static constexpr size_t CONTAINER_HEADER_SIZE = 1 + sizeof(uint32_t) * 2;
+static constexpr size_t STRING_HEADER_SIZE = 1 + sizeof(uint32_t);
+
+static void set_uint32(std::string* dst, size_t pos, uint32_t val) {
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(dst->data() + pos), val);
+}
+
+static void append_container_header(BinaryJsonValue::Type type, uint32_t count,
+                                    std::string* dst) {
+    dst->push_back(type);
+    put_fixed32_le(dst, 0);
+    put_fixed32_le(dst, count);
+    dst->resize(dst->size() + sizeof(uint32_t) * count);
+}
+
+static void encode_value(const rapidjson::Value& value, std::string* dst) {
+    switch (value.GetType()) {
+    case rapidjson::kNullType:
+        dst->push_back(BinaryJsonValue::NULL_VALUE);
+        break;
+    case rapidjson::kTrueType:
+        dst->push_back(BinaryJsonValue::TRUE_VALUE);
+        break;
+    case rapidjson::kFalseType:
+        dst->push_back(BinaryJsonValue::FALSE_VALUE);
+        break;
+    case rapidjson::kNumberType:
+        if (value.IsInt64()) {
+            dst->push_back(BinaryJsonValue::INT64);
+            put_fixed64_le(dst, static_cast<uint64_t>(value.GetInt64()));
+        } else {
+            // the uint64 values out of the range of int64 are kept as double like rapidjson
+            double d = value.GetDouble();
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            dst->push_back(BinaryJsonValue::DOUBLE);
+            put_fixed64_le(dst, bits);
+        }
+        break;
+    case rapidjson::kStringType:
+        dst->push_back(BinaryJsonValue::STRING);
+        put_fixed32_le(dst, value.GetStringLength());
+        dst->append(value.GetString(), value.GetStringLength());
+        break;
+    case rapidjson::kArrayType: {
+        size_t start = dst->size();
+        uint32_t count = value.Size();
+        append_container_header(BinaryJsonValue::ARRAY, count, dst);
+        for (uint32_t i = 0; i < count; ++i) {
+            set_uint32(dst, start + CONTAINER_HEADER_SIZE + sizeof(uint32_t) * i,
+                       dst->size() - start);
+            encode_value(value[i], dst);
+        }
+        set_uint32(dst, start + 1, dst->size() - start);
+        break;
+    }
+    case rapidjson::kObjectType: {
+        std::vector<const rapidjson::Value::Member*> members;
+        members.reserve(value.MemberCount());
+        for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+            members.push_back(&*it);
+        }
+        auto key_of = [](const rapidjson::Value::Member* member) {
+            return std::string_view(member->name.GetString(), member->name.GetStringLength());
+        };
+        std::stable_sort(members.begin(), members.end(),
+                         [&](auto* lhs, auto* rhs) { return key_of(lhs) < key_of(rhs); });
+        members.erase(std::unique(members.begin(), members.end(),
+                                  [&](auto* lhs, auto* rhs) { return key_of(lhs) == key_of(rhs); }),
+                      members.end());
+
+        size_t start = dst->size();
+        append_container_header(BinaryJsonValue::OBJECT, members.size(), dst);
+        for (uint32_t i = 0; i < members.size(); ++i) {
+            set_uint32(dst, start + CONTAINER_HEADER_SIZE + sizeof(uint32_t) * i,
+                       dst->size() - start);
+            auto key = key_of(members[i]);
+            put_fixed32_le(dst, key.size());
+            dst->append(key.data(), key.size());
+            encode_value(members[i]->value, dst);
+        }
+        set_uint32(dst, start + 1, dst->size() - start);
+        break;
+    }
+    }
+}
+
+Status BinaryJsonValue::parse(const std::string_view& json, std::string* dst) {
+    rapidjson::Document document;
+    document.Parse(json.data(), json.size());
+    if (document.HasParseError()) {
+        return Status::InvalidArgument(
+                fmt::format("invalid json at offset {}: {}", document.GetErrorOffset(),
+                            rapidjson::GetParseError_En(document.GetParseError())));
+    }
+    dst->clear();
+    encode(document, dst);
+    return Status::OK();
+}
+
+void BinaryJsonValue::encode(const rapidjson::Value& value, std::string* dst) {
+    encode_value(value, dst);
+}
+
+Status BinaryJsonValue::check(const char* data, size_t size) {
+    if (size == 0) {
+        return Status::Corruption("empty binary json value");
+    }
+    BinaryJsonValue value(data, size);
+    switch (value.type()) {
+    case NULL_VALUE:
+    case TRUE_VALUE:
+    case FALSE_VALUE:
+        if (size == 1) {
+            return Status::OK();
+        }
+        break;
+    case INT64:
+    case DOUBLE:
+        if (size == 1 + sizeof(uint64_t)) {
+            return Status::OK();
+        }
+        break;
+    case STRING:
+        if (size >= STRING_HEADER_SIZE && STRING_HEADER_SIZE + value._read_uint32(1) == size) {
+            return Status::OK();
+        }
+        break;
+    case ARRAY:
+    case OBJECT: {
+        if (size < CONTAINER_HEADER_SIZE || value._read_uint32(1) != size) {
+            break;
+        }
+        uint64_t count = value.count();
+        uint64_t min_offset = CONTAINER_HEADER_SIZE + sizeof(uint32_t) * count;
+        if (min_offset > size) {
+            break;
+        }
+        uint64_t prev_offset = min_offset;
+        std::string_view prev_key;
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t offset = value._read_uint32(CONTAINER_HEADER_SIZE + sizeof(uint32_t) * i);
+            uint64_t end = i + 1 < count ? value._read_uint32(CONTAINER_HEADER_SIZE +
+                                                              sizeof(uint32_t) * (i + 1))
+                                         : size;
+            if (offset != prev_offset || end <= offset || end > size) {
+                return Status::Corruption(
+                        fmt::format("invalid offset {} of binary json element {}", offset, i));
+            }
+            prev_offset = end;
+            if (value.type() == ARRAY) {
+                RETURN_IF_ERROR(check(data + offset, end - offset));
+                continue;
+            }
+            if (end - offset < sizeof(uint32_t)) {
+                return Status::Corruption(fmt::format("invalid binary json member {}", i));
+            }
+            uint64_t key_end = offset + sizeof(uint32_t) + value._read_uint32(offset);
+            if (key_end >= end) {
+                return Status::Corruption(fmt::format("invalid binary json member {}", i));
+            }
+            std::string_view key(data + offset + sizeof(uint32_t),
+                                 key_end - offset - sizeof(uint32_t));
+            if (i > 0 && key <= prev_key) {
+                return Status::Corruption(fmt::format("unsorted binary json member {}", i));
+            }
+            prev_key = key;
+            RETURN_IF_ERROR(check(data + key_end, end - key_end));
+        }
+        if (count == 0 && size != CONTAINER_HEADER_SIZE) {
+            break;
+        }
+        return Status::OK();
+    }
+    default:
+        return Status::Corruption(
+                fmt::format("unknown binary json type {}", static_cast<int>(value.type())));
+    }
+    return Status::Corruption(fmt::format("invalid size {} of binary json type {}", size,
+                                          static_cast<int>(value.type())));
+}
+
+uint32_t BinaryJsonValue::_read_uint32(size_t pos) const {
+    DCHECK_LE(pos + sizeof(uint32_t), _size);
+    return decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data + pos));
+}
+
+int64_t BinaryJsonValue::get_int64() const {
+    DCHECK_EQ(type(), INT64);
+    return static_cast<int64_t>(decode_fixed64_le(reinterpret_cast<const uint8_t*>(_data + 1)));
+}
+
+double BinaryJsonValue::get_double() const {
+    DCHECK_EQ(type(), DOUBLE);
+    uint64_t bits = decode_fixed64_le(reinterpret_cast<const uint8_t*>(_data + 1));
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+std::string_view BinaryJsonValue::get_string() const {
+    DCHECK_EQ(type(), STRING);
+    return std::string_view(_data + STRING_HEADER_SIZE, _read_uint32(1));
+}
+
+uint32_t BinaryJsonValue::count() const {
+    DCHECK(type() == ARRAY || type() == OBJECT);
+    return _read_uint32(1 + sizeof(uint32_t));
+}
+
+BinaryJsonValue BinaryJsonValue::element(uint32_t idx) const {
+    if (type() != ARRAY) {
+        return BinaryJsonValue();
+    }
+    uint32_t n = count();
+    if (idx >= n) {
+        return BinaryJsonValue();
+    }
+    uint32_t offset = _read_uint32(CONTAINER_HEADER_SIZE + sizeof(uint32_t) * idx);
+    uint32_t end = idx + 1 < n ? _read_uint32(CONTAINER_HEADER_SIZE + sizeof(uint32_t) * (idx + 1))
+                               : _size;
+    return BinaryJsonValue(_data + offset, end - offset);
+}
+
+BinaryJsonValue BinaryJsonValue::_member(uint32_t idx, std::string_view* key) const {
+    DCHECK_EQ(type(), OBJECT);
+    uint32_t n = count();
+    DCHECK_LT(idx, n);
+    uint32_t offset = _read_uint32(CONTAINER_HEADER_SIZE + sizeof(uint32_t) * idx);
+    uint32_t end = idx + 1 < n ? _read_uint32(CONTAINER_HEADER_SIZE + sizeof(uint32_t) * (idx + 1))
+                               : _size;
+    uint32_t key_size = _read_uint32(offset);
+    uint32_t value_offset = offset + sizeof(uint32_t) + key_size;
+    *key = std::string_view(_data + offset + sizeof(uint32_t), key_size);
+    return BinaryJsonValue(_data + value_offset, end - value_offset);
+}
+
+std::string_view BinaryJsonValue::member_key(uint32_t idx) const {
+    std::string_view key;
+    _member(idx, &key);
+    return key;
+}
+
+BinaryJsonValue BinaryJsonValue::member_value(uint32_t idx) const {
+    std::string_view key;
+    return _member(idx, &key);
+}
+
+BinaryJsonValue BinaryJsonValue::find_member(const std::string_view& key) const {
+    if (type() != OBJECT) {
+        return BinaryJsonValue();
+    }
+    uint32_t lo = 0;
+    uint32_t hi = count();
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        std::string_view mid_key;
+        BinaryJsonValue value = _member(mid, &mid_key);
+        int cmp = mid_key.compare(key);
+        if (cmp == 0) {
+            return value;
+        } else if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return BinaryJsonValue();
+}
+
+Status BinaryJsonValue::find_path(const std::vector<JsonPath>& paths,
+                                  BinaryJsonValue* result) const {
+    *result = BinaryJsonValue();
+    if (paths.empty() || !paths[0].is_valid) {
+        return Status::OK();
+    }
+    BinaryJsonValue value = *this;
+    for (size_t i = 1; i < paths.size(); ++i) {
+        const JsonPath& path = paths[i];
+        if (!path.is_valid) {
+            return Status::OK();
+        }
+        if (!path.key.empty()) {
+            if (value.type() == ARRAY) {
+                return Status::NotSupported("the key of a json array selects several values");
+            }
+            value = value.find_member(path.key);
+            if (!value.is_valid()) {
+                return Status::OK();
+            }
+        }
+        if (path.idx != -1) {
+            if (value.type() != ARRAY) {
+                return Status::OK();
+            }
+            if (path.idx == -2) {
+                return Status::NotSupported("[*] of a json array selects several values");
+            }
+            value = value.element(path.idx);
+            if (!value.is_valid()) {
+                return Status::OK();
+            }
+        }
+    }
+    *result = value;
+    return Status::OK();
+}
+
+static void write_value(const BinaryJsonValue& value,
+                        rapidjson::Writer<rapidjson::StringBuffer>* writer) {
+    switch (value.type()) {
+    case BinaryJsonValue::NULL_VALUE:
+        writer->Null();
+        break;
+    case BinaryJsonValue::TRUE_VALUE:
+    case BinaryJsonValue::FALSE_VALUE:
+        writer->Bool(value.get_bool());
+        break;
+    case BinaryJsonValue::INT64:
+        writer->Int64(value.get_int64());
+        break;
+    case BinaryJsonValue::DOUBLE:
+        writer->Double(value.get_double());
+        break;
+    case BinaryJsonValue::STRING: {
+        auto str = value.get_string();
+        writer->String(str.data(), str.size());
+        break;
+    }
+    case BinaryJsonValue::ARRAY:
+        writer->StartArray();
+        for (uint32_t i = 0; i < value.count(); ++i) {
+            write_value(value.element(i), writer);
+        }
+        writer->EndArray();
+        break;
+    case BinaryJsonValue::OBJECT:
+        writer->StartObject();
+        for (uint32_t i = 0; i < value.count(); ++i) {
+            auto key = value.member_key(i);
+            writer->Key(key.data(), key.size());
+            write_value(value.member_value(i), writer);
+        }
+        writer->EndObject();
+        break;
+    }
+}
+
+std::string BinaryJsonValue::to_json() const {
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    write_value(*this, &writer);
+    return std::string(buf.GetString(), buf.GetSize());
+}
+
+} // namespace doris
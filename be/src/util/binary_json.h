@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/status.h"
+
+namespace doris {
+
+struct JsonPath;
+
+// A binary encoding of a parsed json document, the members and elements of the
+// nested values are indexed by offsets, so a path is looked up in O(depth) without
+// parsing the text again.
+//
+// Every value starts with a one byte type, followed by
+//   INT64, DOUBLE: 8 bytes little endian
+//   STRING:        uint32 length, bytes
+//   ARRAY:         uint32 total size, uint32 count, uint32 offset[count], elements
+//   OBJECT:        uint32 total size, uint32 count, uint32 offset[count], members
+// where a member is a uint32 key length, the key bytes and the value. The offsets are
+// relative to the start of the array or object, and the members are sorted by key to be
+// found by binary search. Only the first member of duplicated keys is kept, the same
+// one found by rapidjson.
+class BinaryJsonValue {
+public:
+    enum Type : uint8_t {
+        NULL_VALUE = 0,
+        TRUE_VALUE = 1,
+        FALSE_VALUE = 2,
+        INT64 = 3,
+        DOUBLE = 4,
+        STRING = 5,
+        ARRAY = 6,
+        OBJECT = 7,
+    };
+
+    BinaryJsonValue() = default;
+    // the data must have been checked by check() or encoded by encode()
+    BinaryJsonValue(const char* data, size_t size) : _data(data), _size(size) {}
+
+    // Parses the json text and encodes it to dst.
+    static Status parse(const std::string_view& json, std::string* dst);
+    static void encode(const rapidjson::Value& value, std::string* dst);
+    // Checks the layout of the encoded data read from outside.
+    static Status check(const char* data, size_t size);
+
+    bool is_valid() const { return _data != nullptr && _size > 0; }
+    Type type() const { return static_cast<Type>(_data[0]); }
+    bool is_null() const { return type() == NULL_VALUE; }
+
+    bool get_bool() const { return type() == TRUE_VALUE; }
+    int64_t get_int64() const;
+    double get_double() const;
+    std::string_view get_string() const;
+
+    // the number of elements of an array or members of an object
+    uint32_t count() const;
+    BinaryJsonValue element(uint32_t idx) const;
+    std::string_view member_key(uint32_t idx) const;
+    BinaryJsonValue member_value(uint32_t idx) const;
+    // Returns an invalid value if the object does not have the key.
+    BinaryJsonValue find_member(const std::string_view& key) const;
+
+    // Looks up the json paths parsed by JsonFunctions. The paths which select several
+    // values, a key of an array or the [*] of an array, return NotSupported and should
+    // be evaluated on the parsed document instead.
+    Status find_path(const std::vector<JsonPath>& paths, BinaryJsonValue* result) const;
+
+    // Writes the value as json text, the members are in the order of their keys.
+    std::string to_json() const;
+
+private:
+    uint32_t _read_uint32(size_t pos) const;
+    BinaryJsonValue _member(uint32_t idx, std::string_view* key) const;
+
+    const char* _data = nullptr;
+    size_t _size = 0;
+};
+
+} // namespace doris
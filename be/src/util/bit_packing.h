@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "util/faststring.h"
+
+namespace doris {
+
+// Utilities to pack unsigned integers of a fixed bit width into a little-endian byte stream.
+// Values are laid out back to back starting from the least significant bit, so n values of
+// width w occupy exactly ceil(n * w / 8) bytes.
+//
+// The unpacking loop does unaligned 8 bytes loads, the caller must make sure that there are
+// at least 8 readable bytes after the end of the packed data (see PADDING_BYTES). The loop
+// has no data dependent branch for widths up to 56 so that the compiler is able to vectorize
+// it.
+class BitPacking {
+public:
+    static constexpr size_t PADDING_BYTES = 8;
+
+    // Return the number of bits needed to represent v, 0 for v == 0.
+    static inline int bit_width(uint64_t v) { return v == 0 ? 0 : 64 - __builtin_clzll(v); }
+
+    static inline size_t packed_bytes(size_t num_values, int width) {
+        return (num_values * width + 7) / 8;
+    }
+
+    // Append 'num_values' values of 'width' bits to 'out'.
+    static void pack(const uint64_t* values, size_t num_values, int width, faststring* out) {
+        if (width == 0) {
+            return;
+        }
+        size_t orig_size = out->size();
+        out->resize(orig_size + packed_bytes(num_values, width));
+        uint8_t* dst = out->data() + orig_size;
+        uint64_t acc = 0;
+        int acc_bits = 0;
+        for (size_t i = 0; i < num_values; ++i) {
+            uint64_t v = values[i];
+            acc |= v << acc_bits;
+            if (acc_bits + width >= 64) {
+                memcpy(dst, &acc, sizeof(acc));
+                dst += sizeof(acc);
+                // bits of v which don't fit in the flushed word
+                acc = acc_bits == 0 ? 0 : v >> (64 - acc_bits);
+                acc_bits = acc_bits + width - 64;
+            } else {
+                acc_bits += width;
+            }
+        }
+        memcpy(dst, &acc, (acc_bits + 7) / 8);
+    }
+
+    // Unpack 'num_values' values of 'width' bits into 'out', starting from the 'first'-th value
+    // packed in 'in'.
+    static void unpack(const uint8_t* in, size_t first, size_t num_values, int width,
+                       uint64_t* out) {
+        if (width == 0) {
+            memset(out, 0, num_values * sizeof(uint64_t));
+            return;
+        }
+        const uint64_t mask = width == 64 ? ~0ULL : ((1ULL << width) - 1);
+        if (width <= 56) {
+            for (size_t i = 0; i < num_values; ++i) {
+                size_t bit = (first + i) * width;
+                uint64_t word;
+                memcpy(&word, in + (bit >> 3), sizeof(word));
+                out[i] = (word >> (bit & 7)) & mask;
+            }
+            return;
+        }
+        for (size_t i = 0; i < num_values; ++i) {
+            size_t bit = (first + i) * width;
+            int shift = bit & 7;
+            uint64_t word;
+            memcpy(&word, in + (bit >> 3), sizeof(word));
+            uint64_t v = word >> shift;
+            if (shift + width > 64) {
+                v |= static_cast<uint64_t>(in[(bit >> 3) + 8]) << (64 - shift);
+            }
+            out[i] = v & mask;
+        }
+    }
+};
+
+} // namespace doris
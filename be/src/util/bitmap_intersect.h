@@ -173,6 +173,14 @@ public:
         }
     }
 
+    // Unions all the bitmaps of the key at once.
+    void update(const T& key, const std::vector<const BitmapValue*>& bitmaps) {
+        auto it = _bitmaps.find(key);
+        if (it != _bitmaps.end()) {
+            it->second.fastunion(bitmaps);
+        }
+    }
+
     void merge(const BitmapIntersect& other) {
         for (auto& kv : other._bitmaps) {
             if (_bitmaps.find(kv.first) != _bitmaps.end()) {
@@ -30,6 +30,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/logging.h"
 #include "udf/udf.h"
@@ -893,10 +894,21 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // the 32-bit bitmaps of the same high bytes are unioned at once by CRoaring, which
+        // unions the containers lazily and repairs their cardinalities at last
+        phmap::btree_map<uint32_t, std::vector<const roaring::Roaring*>> groups;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                groups[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [key, group] : groups) {
+            if (group.size() == 1) {
+                ans.emplaceOrInsert(key, *group[0]);
+            } else {
+                ans.emplaceOrInsert(key, roaring::Roaring::fastunion(group.size(), group.data()));
+            }
         }
         return ans;
     }
@@ -1252,6 +1264,53 @@ public:
         return *this;
     }
 
+    // Compute the union between the current bitmap and all the provided bitmaps, which is
+    // much faster than |= one by one when many of them are bitmaps.
+    // Possible type transitions are the same as |=.
+    BitmapValue& fastunion(const std::vector<const BitmapValue*>& values) {
+        if (values.size() == 1) {
+            return *this |= *values[0];
+        }
+        std::vector<const detail::Roaring64Map*> bitmaps;
+        std::vector<uint64_t> single_values;
+        for (const auto* value : values) {
+            switch (value->_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                single_values.push_back(value->_sv);
+                break;
+            case BITMAP:
+                bitmaps.push_back(&value->_bitmap);
+                break;
+            }
+        }
+        if (!bitmaps.empty()) {
+            switch (_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                single_values.push_back(_sv);
+                break;
+            case BITMAP:
+                bitmaps.push_back(&_bitmap);
+                break;
+            }
+            if (bitmaps.size() == 1) {
+                if (bitmaps[0] != &_bitmap) {
+                    _bitmap = *bitmaps[0];
+                }
+            } else {
+                _bitmap = detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data());
+            }
+            _type = BITMAP;
+        }
+        for (auto single_value : single_values) {
+            add(single_value);
+        }
+        return *this;
+    }
+
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
     // SINGLE -> EMPTY
@@ -1560,6 +1619,40 @@ public:
         return true;
     }
 
+    // Union with the serialized bitmap. No BitmapValue is built for it, the single values
+    // are added directly and a bitmap is read in place if this is empty.
+    bool union_serialized(const char* src) {
+        switch (*src) {
+        case BitmapTypeCode::EMPTY:
+            break;
+        case BitmapTypeCode::SINGLE32:
+            add(decode_fixed32_le(reinterpret_cast<const uint8_t*>(src + 1)));
+            break;
+        case BitmapTypeCode::SINGLE64:
+            add(decode_fixed64_le(reinterpret_cast<const uint8_t*>(src + 1)));
+            break;
+        case BitmapTypeCode::BITMAP32:
+        case BitmapTypeCode::BITMAP64:
+            switch (_type) {
+            case EMPTY:
+                return deserialize(src);
+            case SINGLE: {
+                uint64_t sv = _sv;
+                deserialize(src);
+                _bitmap.add(sv);
+                break;
+            }
+            case BITMAP:
+                _bitmap |= detail::Roaring64Map::read(src);
+                break;
+            }
+            break;
+        default:
+            return false;
+        }
+        return true;
+    }
+
     doris_udf::BigIntVal minimum() const {
         switch (_type) {
         case SINGLE:
@@ -22,11 +22,13 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zdict.h>
 #include <zstd.h>
 #include <zstd_errors.h>
 
 #include <limits>
 
+#include "common/logging.h"
 #include "gutil/strings/substitute.h"
 #include "util/faststring.h"
 
@@ -47,6 +49,8 @@ Status BlockCompressionCodec::compress(const std::vector<Slice>& inputs, Slice*
 
 class Lz4BlockCompression : public BlockCompressionCodec {
 public:
+    segment_v2::CompressionTypePB type() const override { return segment_v2::LZ4; }
+
     static const Lz4BlockCompression* instance() {
         static Lz4BlockCompression s_instance;
         return &s_instance;
@@ -90,6 +94,8 @@ public:
 // Used for LZ4 frame format, decompress speed is two times faster than LZ4.
 class Lz4fBlockCompression : public BlockCompressionCodec {
 public:
+    segment_v2::CompressionTypePB type() const override { return segment_v2::LZ4F; }
+
     Status init() override {
         auto ret1 = LZ4F_createCompressionContext(&ctx_c, LZ4F_VERSION);
         if (LZ4F_isError(ret1)) {
@@ -274,6 +280,8 @@ private:
 
 class SnappyBlockCompression : public BlockCompressionCodec {
 public:
+    segment_v2::CompressionTypePB type() const override { return segment_v2::SNAPPY; }
+
     static const SnappyBlockCompression* instance() {
         static SnappyBlockCompression s_instance;
         return &s_instance;
@@ -308,6 +316,8 @@ public:
 
 class ZlibBlockCompression : public BlockCompressionCodec {
 public:
+    segment_v2::CompressionTypePB type() const override { return segment_v2::ZLIB; }
+
     static const ZlibBlockCompression* instance() {
         static ZlibBlockCompression s_instance;
         return &s_instance;
@@ -380,6 +390,15 @@ public:
 // for ZSTD compression and decompression, with BOTH fast and high compression ratio
 class ZstdBlockCompression : public BlockCompressionCodec {
 public:
+    segment_v2::CompressionTypePB type() const override { return segment_v2::ZSTD; }
+
+    explicit ZstdBlockCompression(int compression_level = ZSTD_CLEVEL_DEFAULT)
+            : _compression_level(compression_level) {}
+
+    // compress and decompress with `dict`, the compression level of the dictionary is used
+    explicit ZstdBlockCompression(std::shared_ptr<const ZstdDictionary> dict)
+            : _compression_level(ZSTD_CLEVEL_DEFAULT), _dict(std::move(dict)) {}
+
     // reenterable initialization for compress/decompress context
     inline Status init() override {
         if (!ctx_c) {
@@ -427,12 +446,26 @@ public:
             return Status::InvalidArgument(strings::Substitute(
                     "ZSTD_CCtx_reset error: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
         }
-        // set compression level to default 3
-        ret = ZSTD_CCtx_setParameter(ctx_c, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
-        if (ZSTD_isError(ret)) {
-            return Status::InvalidArgument(
-                    strings::Substitute("ZSTD_CCtx_setParameter compression level error: $0",
-                                        ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        // the referenced dictionary is kept by a session reset
+        if (_dict != nullptr && !_cdict_referenced) {
+            ZSTD_CDict* cdict = nullptr;
+            RETURN_IF_ERROR(_dict->get_cdict(&cdict));
+            ret = ZSTD_CCtx_refCDict(ctx_c, cdict);
+            if (ZSTD_isError(ret)) {
+                return Status::InvalidArgument(
+                        strings::Substitute("ZSTD_CCtx_refCDict error: $0",
+                                            ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+            }
+            _cdict_referenced = true;
+        }
+        // the compression level is 3 by default, it is decided by the dictionary if any
+        if (_dict == nullptr) {
+            ret = ZSTD_CCtx_setParameter(ctx_c, ZSTD_c_compressionLevel, _compression_level);
+            if (ZSTD_isError(ret)) {
+                return Status::InvalidArgument(
+                        strings::Substitute("ZSTD_CCtx_setParameter compression level error: $0",
+                                            ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+            }
         }
         // set checksum flag to 1
         ret = ZSTD_CCtx_setParameter(ctx_c, ZSTD_c_checksumFlag, 1);
@@ -488,6 +521,17 @@ public:
             return Status::InvalidArgument(strings::Substitute(
                     "ZSTD_DCtx_reset error: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
         }
+        if (_dict != nullptr && !_ddict_referenced) {
+            ZSTD_DDict* ddict = nullptr;
+            RETURN_IF_ERROR(_dict->get_ddict(&ddict));
+            ret = ZSTD_DCtx_refDDict(ctx_d, ddict);
+            if (ZSTD_isError(ret)) {
+                return Status::InvalidArgument(
+                        strings::Substitute("ZSTD_DCtx_refDDict error: $0",
+                                            ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+            }
+            _ddict_referenced = true;
+        }
 
         ZSTD_inBuffer in_buf = {input.data, input.size, 0};
         ZSTD_outBuffer out_buf = {output->data, output->size, 0};
@@ -519,10 +563,19 @@ private:
     // will be reused by compress/decompress
     ZSTD_CCtx* ctx_c = nullptr;
     ZSTD_DCtx* ctx_d = nullptr;
+    int _compression_level;
+    std::shared_ptr<const ZstdDictionary> _dict;
+    mutable bool _cdict_referenced = false;
+    mutable bool _ddict_referenced = false;
 };
 
 Status get_block_compression_codec(segment_v2::CompressionTypePB type,
                                    std::unique_ptr<BlockCompressionCodec>& codec) {
+    return get_block_compression_codec(type, 0, codec);
+}
+
+Status get_block_compression_codec(segment_v2::CompressionTypePB type, int compression_level,
+                                   std::unique_ptr<BlockCompressionCodec>& codec) {
     BlockCompressionCodec* ptr = nullptr;
     switch (type) {
     case segment_v2::CompressionTypePB::NO_COMPRESSION:
@@ -541,7 +594,8 @@ Status get_block_compression_codec(segment_v2::CompressionTypePB type,
         ptr = new ZlibBlockCompression();
         break;
     case segment_v2::CompressionTypePB::ZSTD:
-        ptr = new ZstdBlockCompression();
+        ptr = compression_level > 0 ? new ZstdBlockCompression(compression_level)
+                                    : new ZstdBlockCompression();
         break;
     default:
         return Status::NotFound(strings::Substitute("unknown compression type($0)", type));
@@ -559,4 +613,65 @@ Status get_block_compression_codec(segment_v2::CompressionTypePB type,
     return st;
 }
 
+ZstdDictionary::~ZstdDictionary() {
+    if (_cdict != nullptr) ZSTD_freeCDict(_cdict);
+    if (_ddict != nullptr) ZSTD_freeDDict(_ddict);
+}
+
+Status ZstdDictionary::get_cdict(ZSTD_CDict** cdict) const {
+    std::call_once(_cdict_once, [this]() {
+        _cdict = ZSTD_createCDict(_content.data(), _content.size(), ZSTD_CLEVEL_DEFAULT);
+    });
+    if (_cdict == nullptr) {
+        return Status::InvalidArgument("Fail to ZSTD_createCDict");
+    }
+    *cdict = _cdict;
+    return Status::OK();
+}
+
+Status ZstdDictionary::get_ddict(ZSTD_DDict** ddict) const {
+    std::call_once(_ddict_once, [this]() {
+        _ddict = ZSTD_createDDict(_content.data(), _content.size());
+    });
+    if (_ddict == nullptr) {
+        return Status::InvalidArgument("Fail to ZSTD_createDDict");
+    }
+    *ddict = _ddict;
+    return Status::OK();
+}
+
+Status get_zstd_dict_compression_codec(std::shared_ptr<const ZstdDictionary> dict,
+                                       std::unique_ptr<BlockCompressionCodec>& codec) {
+    std::unique_ptr<BlockCompressionCodec> ptr(new ZstdBlockCompression(std::move(dict)));
+    RETURN_IF_ERROR(ptr->init());
+    codec = std::move(ptr);
+    return Status::OK();
+}
+
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size,
+                             std::string* dict) {
+    dict->clear();
+    faststring buffer;
+    std::vector<size_t> sample_sizes;
+    for (auto& sample : samples) {
+        if (sample.size > 0) {
+            buffer.append(sample.data, sample.size);
+            sample_sizes.push_back(sample.size);
+        }
+    }
+    if (sample_sizes.empty() || max_dict_size == 0) {
+        return Status::OK();
+    }
+    dict->resize(max_dict_size);
+    size_t ret = ZDICT_trainFromBuffer(dict->data(), max_dict_size, buffer.data(),
+                                       sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(ret)) {
+        VLOG_DEBUG << "Fail to train zstd dictionary: " << ZDICT_getErrorName(ret);
+        dict->clear();
+        return Status::OK();
+    }
+    dict->resize(ret);
+    return Status::OK();
+}
+
 } // namespace doris
@@ -18,12 +18,18 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
 #include "util/slice.h"
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace doris {
 
 // This class is used to encapsulate Compression/Decompression algorithm.
@@ -57,6 +63,8 @@ public:
 
     // Returns an upper bound on the max compressed length.
     virtual size_t max_compressed_len(size_t len) const = 0;
+
+    virtual segment_v2::CompressionTypePB type() const = 0;
 };
 
 // Get a BlockCompressionCodec through type.
@@ -70,4 +78,38 @@ public:
 Status get_block_compression_codec(segment_v2::CompressionTypePB type,
                                    std::unique_ptr<BlockCompressionCodec>& codec);
 
+// Same as above, compression_level is only used by ZSTD, 0 means the default level.
+Status get_block_compression_codec(segment_v2::CompressionTypePB type, int compression_level,
+                                   std::unique_ptr<BlockCompressionCodec>& codec);
+
+// A ZSTD dictionary. The digested dictionaries for compression and decompression are created
+// on the first use and only read afterwards, so a dictionary can be shared by the codecs of
+// all threads, while each codec owns its context.
+class ZstdDictionary {
+public:
+    explicit ZstdDictionary(std::string content) : _content(std::move(content)) {}
+    ~ZstdDictionary();
+
+    const std::string& content() const { return _content; }
+
+    Status get_cdict(ZSTD_CDict_s** cdict) const;
+    Status get_ddict(ZSTD_DDict_s** ddict) const;
+
+private:
+    std::string _content;
+    mutable std::once_flag _cdict_once;
+    mutable ZSTD_CDict_s* _cdict = nullptr;
+    mutable std::once_flag _ddict_once;
+    mutable ZSTD_DDict_s* _ddict = nullptr;
+};
+
+// Get a ZSTD codec compressing and decompressing with `dict`.
+Status get_zstd_dict_compression_codec(std::shared_ptr<const ZstdDictionary> dict,
+                                       std::unique_ptr<BlockCompressionCodec>& codec);
+
+// Train a ZSTD dictionary of at most `max_dict_size` bytes from `samples`. `dict` is left empty
+// if no dictionary can be trained from them, e.g. the samples are too few or too small.
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size,
+                             std::string* dict);
+
 } // namespace doris
@@ -35,7 +35,18 @@ struct ByteBuffer {
         return ptr;
     }
 
-    ~ByteBuffer() { delete[] ptr; }
+    // Wrap 'size' bytes of memory owned by 'owner' without copying, the memory
+    // is kept alive by the buffer.
+    static ByteBufferPtr wrap(char* data, size_t size, std::shared_ptr<void> owner) {
+        ByteBufferPtr ptr(new ByteBuffer(data, size, std::move(owner)));
+        return ptr;
+    }
+
+    ~ByteBuffer() {
+        if (_owner == nullptr) {
+            delete[] ptr;
+        }
+    }
 
     void put_bytes(const char* data, size_t size) {
         memcpy(ptr + pos, data, size);
@@ -64,6 +75,12 @@ struct ByteBuffer {
 private:
     ByteBuffer(size_t capacity_)
             : ptr(new char[capacity_]), pos(0), limit(capacity_), capacity(capacity_) {}
+
+    ByteBuffer(char* data, size_t size, std::shared_ptr<void> owner)
+            : ptr(data), pos(0), limit(size), capacity(size), _owner(std::move(owner)) {}
+
+    // the owner of the wrapped memory, nullptr if ptr is allocated by the buffer
+    std::shared_ptr<void> _owner;
 };
 
 } // namespace doris
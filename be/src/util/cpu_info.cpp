@@ -37,6 +37,7 @@
 #include <spe.h>
 #endif
 
+#include <pthread.h>
 #include <sched.h>
 #include <stdlib.h>
 #include <string.h>
@@ -316,6 +317,30 @@ int CpuInfo::get_current_core() {
 #endif
 }
 
+bool CpuInfo::is_numa_affinity_enabled() {
+    return config::enable_numa_affinity && max_num_numa_nodes_ > 1;
+}
+
+bool CpuInfo::bind_current_thread_to_numa_node(int node) {
+    DCHECK_LE(0, node);
+    DCHECK_LT(node, max_num_numa_nodes_);
+    const auto& cores = numa_node_to_cores_[node];
+    if (cores.empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int core : cores) {
+        CPU_SET(core, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+        LOG(WARNING) << "failed to bind the thread to NUMA node " << node << ", errno=" << ret;
+        return false;
+    }
+    return true;
+}
+
 void CpuInfo::_get_cache_info(long cache_sizes[NUM_CACHE_LEVELS],
                               long cache_line_sizes[NUM_CACHE_LEVELS]) {
 #ifdef __APPLE__
@@ -139,6 +139,18 @@ public:
         return numa_node_core_idx_[core];
     }
 
+    /// Returns the NUMA node of the core that the current thread is running on, the thread
+    /// may be migrated to another node at any time unless it is bound to the node.
+    static int get_current_numa_node() { return get_numa_node_of_core(get_current_core()); }
+
+    /// Whether NUMA affinity is enabled by config::enable_numa_affinity and there is more
+    /// than one NUMA node.
+    static bool is_numa_affinity_enabled();
+
+    /// Binds the current thread to the cores of the NUMA node 'node', which must be in the
+    /// range [0, GetMaxNumNumaNodes()). Returns false if failed.
+    static bool bind_current_thread_to_numa_node(int node);
+
     /// Returns the model name of the cpu (e.g. Intel i7-2600)
     static std::string model_name() {
         DCHECK(initialized_);
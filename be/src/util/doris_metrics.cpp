@@ -87,6 +87,7 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(base_compaction_bytes_total, MetricUnit::BY
                                      compaction_bytes_total, Labels({{"type", "base"}}));
 DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(cumulative_compaction_bytes_total, MetricUnit::BYTES, "",
                                      compaction_bytes_total, Labels({{"type", "cumulative"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(compaction_io_throttled_ms, MetricUnit::MILLISECONDS);
 
 DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(meta_write_request_total, MetricUnit::REQUESTS, "",
                                      meta_request_total, Labels({{"type", "write"}}));
@@ -140,6 +141,7 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(switch_thread_mem_tracker_err_cb_count, Met
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(switch_bthread_count, MetricUnit::NOUNIT);
 
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memory_pool_bytes_total, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(huge_page_allocated_bytes, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(process_thread_num, MetricUnit::NOUNIT);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(process_fd_num_used, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(process_fd_num_limit_soft, MetricUnit::NOUNIT);
@@ -153,6 +155,14 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(compaction_waitting_permits, MetricUnit::NOUN
 
 DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(tablet_version_num_distribution, MetricUnit::NOUNIT);
 
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(page_read_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(segment_open_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(memtable_flush_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(transmit_block_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(tablet_writer_add_block_latency_us,
+                                       MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(scanner_queue_wait_us, MetricUnit::MICROSECONDS);
+
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(push_request_write_bytes_per_second, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(query_scan_bytes_per_second, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(max_disk_io_util_percent, MetricUnit::PERCENT);
@@ -189,6 +199,25 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(local_bytes_written_total, MetricUnit::FILE
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(local_file_open_reading, MetricUnit::FILESYSTEM);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(s3_file_open_reading, MetricUnit::FILESYSTEM);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(local_file_open_writing, MetricUnit::FILESYSTEM);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(s3_prefetch_request_total, MetricUnit::REQUESTS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(s3_prefetch_hit_bytes_total, MetricUnit::BYTES);
+
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(file_cache_hit_total, MetricUnit::OPERATIONS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(file_cache_miss_total, MetricUnit::OPERATIONS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(file_cache_bytes_read_total, MetricUnit::BYTES);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(file_cache_bytes_written_total, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(file_cache_used_bytes, MetricUnit::BYTES);
+
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(startup_loading_data_dirs, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(startup_tablet_metas, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(startup_loaded_tablet_metas_total, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(startup_rowset_metas, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(startup_loaded_rowset_metas_total, MetricUnit::NOUNIT);
+
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(scanner_thread_pool_stolen_task_total,
+                                     MetricUnit::OPERATIONS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(scanner_thread_pool_remote_numa_stolen_task_total,
+                                     MetricUnit::OPERATIONS);
 
 const std::string DorisMetrics::_s_registry_name = "doris_be";
 const std::string DorisMetrics::_s_hook_name = "doris_metrics";
@@ -246,6 +275,7 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, base_compaction_bytes_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, cumulative_compaction_deltas_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, cumulative_compaction_bytes_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, compaction_io_throttled_ms);
 
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, meta_write_request_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, meta_write_request_duration_us);
@@ -268,6 +298,7 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, memtable_flush_duration_us);
 
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, memory_pool_bytes_total);
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, huge_page_allocated_bytes);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, process_thread_num);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, process_fd_num_used);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, process_fd_num_limit_soft);
@@ -281,6 +312,13 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
 
     HISTOGRAM_METRIC_REGISTER(_server_metric_entity, tablet_version_num_distribution);
 
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, page_read_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, segment_open_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, memtable_flush_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, transmit_block_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, tablet_writer_add_block_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, scanner_queue_wait_us);
+
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, push_request_write_bytes_per_second);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, query_scan_bytes_per_second);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, max_disk_io_util_percent);
@@ -325,6 +363,24 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, local_file_open_reading);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, s3_file_open_reading);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, local_file_open_writing);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, s3_prefetch_request_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, s3_prefetch_hit_bytes_total);
+
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, file_cache_hit_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, file_cache_miss_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, file_cache_bytes_read_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, file_cache_bytes_written_total);
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, file_cache_used_bytes);
+
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, startup_loading_data_dirs);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, startup_tablet_metas);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, startup_loaded_tablet_metas_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, startup_rowset_metas);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, startup_loaded_rowset_metas_total);
+
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, scanner_thread_pool_stolen_task_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity,
+                                scanner_thread_pool_remote_numa_stolen_task_total);
 }
 
 void DorisMetrics::initialize(bool init_system_metrics, const std::set<std::string>& disk_devices,
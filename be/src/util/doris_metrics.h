@@ -94,6 +94,7 @@ public:
     IntCounter* base_compaction_bytes_total;
     IntCounter* cumulative_compaction_deltas_total;
     IntCounter* cumulative_compaction_bytes_total;
+    IntCounter* compaction_io_throttled_ms;
 
     IntCounter* publish_task_request_total;
     IntCounter* publish_task_failed_total;
@@ -133,6 +134,8 @@ public:
     IntCounter* switch_bthread_count;
 
     IntGauge* memory_pool_bytes_total;
+    // the bytes of the hash tables advised to be backed by transparent huge pages
+    IntGauge* huge_page_allocated_bytes;
     IntGauge* process_thread_num;
     IntGauge* process_fd_num_used;
     IntGauge* process_fd_num_limit_soft;
@@ -151,6 +154,17 @@ public:
 
     HistogramMetric* tablet_version_num_distribution;
 
+    // The latencies on the hot paths
+    // the reads of the pages missing in the page cache
+    CoreLocalHistogramMetric* page_read_latency_us;
+    CoreLocalHistogramMetric* segment_open_latency_us;
+    CoreLocalHistogramMetric* memtable_flush_latency_us;
+    // the handling of the rpcs on the receivers
+    CoreLocalHistogramMetric* transmit_block_latency_us;
+    CoreLocalHistogramMetric* tablet_writer_add_block_latency_us;
+    // the time the scanners wait in the queue of the scan thread pool
+    CoreLocalHistogramMetric* scanner_queue_wait_us;
+
     // The following metrics will be calculated
     // by metric calculator
     IntGauge* push_request_write_bytes_per_second;
@@ -181,6 +195,22 @@ public:
     IntGauge* local_file_open_reading;
     IntGauge* s3_file_open_reading;
     IntGauge* local_file_open_writing;
+    IntCounter* s3_prefetch_request_total;
+    IntCounter* s3_prefetch_hit_bytes_total;
+
+    // Metrics related with the file cache of remote files
+    IntCounter* file_cache_hit_total;
+    IntCounter* file_cache_miss_total;
+    IntCounter* file_cache_bytes_read_total;
+    IntCounter* file_cache_bytes_written_total;
+    IntGauge* file_cache_used_bytes;
+
+    // Progress of loading the tablets of the data dirs at startup
+    IntGauge* startup_loading_data_dirs;
+    IntCounter* startup_tablet_metas;
+    IntCounter* startup_loaded_tablet_metas_total;
+    IntCounter* startup_rowset_metas;
+    IntCounter* startup_loaded_rowset_metas_total;
 
     // Size of some global containers
     UIntGauge* rowset_count_generated_and_in_use;
@@ -214,6 +244,10 @@ public:
     UIntGauge* query_cache_partition_total_count;
 
     UIntGauge* scanner_thread_pool_queue_size;
+    // Tasks of the work-stealing scanner pool run by a worker other than the one queued on,
+    // and the ones of them stolen from a worker on another NUMA node.
+    IntCounter* scanner_thread_pool_stolen_task_total;
+    IntCounter* scanner_thread_pool_remote_numa_stolen_task_total;
     UIntGauge* etl_thread_pool_queue_size;
     UIntGauge* add_batch_task_queue_size;
     UIntGauge* send_batch_thread_pool_thread_num;
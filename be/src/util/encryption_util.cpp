@@ -148,120 +148,97 @@ static void create_key(const unsigned char* origin_key, uint32_t key_length, uin
     }
 }
 
-static int do_encrypt(EVP_CIPHER_CTX* cipher_ctx, const EVP_CIPHER* cipher,
-                      const unsigned char* source, uint32_t source_length,
-                      const unsigned char* encrypt_key, const unsigned char* iv, bool padding,
-                      unsigned char* encrypt, int* length_ptr) {
-    int ret = EVP_EncryptInit(cipher_ctx, cipher, encrypt_key, iv);
-    if (ret == 0) {
-        return ret;
-    }
-    ret = EVP_CIPHER_CTX_set_padding(cipher_ctx, padding);
-    if (ret == 0) {
-        return ret;
-    }
-    int u_len = 0;
-    ret = EVP_EncryptUpdate(cipher_ctx, encrypt, &u_len, source, source_length);
-    if (ret == 0) {
-        return ret;
-    }
-    int f_len = 0;
-    ret = EVP_EncryptFinal(cipher_ctx, encrypt + u_len, &f_len);
-    *length_ptr = u_len + f_len;
-    return ret;
-}
-
 int EncryptionUtil::encrypt(EncryptionMode mode, const unsigned char* source,
                             uint32_t source_length, const unsigned char* key, uint32_t key_length,
                             const char* iv_str, bool padding, unsigned char* encrypt) {
-    const EVP_CIPHER* cipher = get_evp_type(mode);
-    /* The encrypt key to be used for encryption */
-    unsigned char encrypt_key[ENCRYPTION_MAX_KEY_LENGTH / 8];
-    create_key(key, key_length, encrypt_key, mode);
+    EncryptionContext ctx;
+    return ctx.encrypt(mode, source, source_length, key, key_length, iv_str, padding, encrypt);
+}
+
+int EncryptionUtil::decrypt(EncryptionMode mode, const unsigned char* encrypt,
+                            uint32_t encrypt_length, const unsigned char* key, uint32_t key_length,
+                            const char* iv_str, bool padding, unsigned char* decrypt_content) {
+    EncryptionContext ctx;
+    return ctx.decrypt(mode, encrypt, encrypt_length, key, key_length, iv_str, padding,
+                       decrypt_content);
+}
+
+EncryptionContext::EncryptionContext() : _cipher_ctx(EVP_CIPHER_CTX_new()) {}
+
+EncryptionContext::~EncryptionContext() {
+    EVP_CIPHER_CTX_free(_cipher_ctx);
+}
 
+bool EncryptionContext::_init(EncryptionMode mode, const unsigned char* key, uint32_t key_length,
+                              const char* iv_str, bool padding, bool is_encrypt) {
+    const EVP_CIPHER* cipher = get_evp_type(mode);
+    if (cipher == nullptr || _cipher_ctx == nullptr) {
+        return false;
+    }
     int iv_length = EVP_CIPHER_iv_length(cipher);
-    if (cipher == nullptr || (iv_length > 0 && !iv_str)) {
-        return AES_BAD_DATA;
+    if (iv_length > 0 && !iv_str) {
+        return false;
     }
-    char* init_vec = nullptr;
-    std::string iv_default("DORISDORISDORIS_");
-
+    unsigned char* init_vec = nullptr;
+    unsigned char iv[EVP_MAX_IV_LENGTH + 1];
     if (iv_str) {
-        init_vec = &iv_default[0];
-        memcpy(init_vec, iv_str, strnlen(iv_str, EVP_MAX_IV_LENGTH));
-        init_vec[iv_length] = '\0';
+        memcpy(iv, "DORISDORISDORIS_", EVP_MAX_IV_LENGTH + 1);
+        memcpy(iv, iv_str, strnlen(iv_str, EVP_MAX_IV_LENGTH));
+        iv[iv_length] = '\0';
+        init_vec = iv;
     }
-    EVP_CIPHER_CTX* cipher_ctx = EVP_CIPHER_CTX_new();
-    EVP_CIPHER_CTX_reset(cipher_ctx);
-    int length = 0;
-    int ret = do_encrypt(cipher_ctx, cipher, source, source_length, encrypt_key,
-                         reinterpret_cast<unsigned char*>(init_vec), padding, encrypt, &length);
-    EVP_CIPHER_CTX_free(cipher_ctx);
-    if (ret == 0) {
-        ERR_clear_error();
-        return AES_BAD_DATA;
+
+    int ret = 0;
+    if (_initialized && _mode == mode && _is_encrypt == is_encrypt && _key.size() == key_length &&
+        memcmp(_key.data(), key, key_length) == 0) {
+        // only reset the iv and the state, the key schedule is kept
+        ret = EVP_CipherInit_ex(_cipher_ctx, nullptr, nullptr, nullptr, init_vec, is_encrypt);
     } else {
-        return length;
+        _initialized = false;
+        /* The encrypt key to be used for encryption */
+        unsigned char encrypt_key[ENCRYPTION_MAX_KEY_LENGTH / 8];
+        create_key(key, key_length, encrypt_key, mode);
+        ret = EVP_CipherInit_ex(_cipher_ctx, cipher, nullptr, encrypt_key, init_vec, is_encrypt);
+        if (ret != 0) {
+            _initialized = true;
+            _mode = mode;
+            _is_encrypt = is_encrypt;
+            _key.assign(reinterpret_cast<const char*>(key), key_length);
+        }
     }
+    return ret != 0 && EVP_CIPHER_CTX_set_padding(_cipher_ctx, padding) != 0;
 }
 
-static int do_decrypt(EVP_CIPHER_CTX* cipher_ctx, const EVP_CIPHER* cipher,
-                      const unsigned char* encrypt, uint32_t encrypt_length,
-                      const unsigned char* encrypt_key, const unsigned char* iv, bool padding,
-                      unsigned char* decrypt_content, int* length_ptr) {
-    int ret = EVP_DecryptInit(cipher_ctx, cipher, encrypt_key, iv);
-    if (ret == 0) {
-        return ret;
-    }
-    ret = EVP_CIPHER_CTX_set_padding(cipher_ctx, padding);
-    if (ret == 0) {
-        return ret;
-    }
+int EncryptionContext::encrypt(EncryptionMode mode, const unsigned char* source,
+                               uint32_t source_length, const unsigned char* key,
+                               uint32_t key_length, const char* iv_str, bool padding,
+                               unsigned char* encrypt) {
     int u_len = 0;
-    ret = EVP_DecryptUpdate(cipher_ctx, decrypt_content, &u_len, encrypt, encrypt_length);
-    if (ret == 0) {
-        return ret;
-    }
     int f_len = 0;
-    ret = EVP_DecryptFinal_ex(cipher_ctx, decrypt_content + u_len, &f_len);
-    *length_ptr = u_len + f_len;
-    return ret;
-}
-
-int EncryptionUtil::decrypt(EncryptionMode mode, const unsigned char* encrypt,
-                            uint32_t encrypt_length, const unsigned char* key, uint32_t key_length,
-                            const char* iv_str, bool padding, unsigned char* decrypt_content) {
-    const EVP_CIPHER* cipher = get_evp_type(mode);
-
-    /* The encrypt key to be used for decryption */
-    unsigned char encrypt_key[ENCRYPTION_MAX_KEY_LENGTH / 8];
-    create_key(key, key_length, encrypt_key, mode);
-
-    int iv_length = EVP_CIPHER_iv_length(cipher);
-    if (cipher == nullptr || (iv_length > 0 && !iv_str)) {
+    if (!_init(mode, key, key_length, iv_str, padding, true) ||
+        EVP_EncryptUpdate(_cipher_ctx, encrypt, &u_len, source, source_length) == 0 ||
+        EVP_EncryptFinal_ex(_cipher_ctx, encrypt + u_len, &f_len) == 0) {
+        _initialized = false;
+        ERR_clear_error();
         return AES_BAD_DATA;
     }
-    char* init_vec = nullptr;
-    std::string iv_default("DORISDORISDORIS_");
+    return u_len + f_len;
+}
 
-    if (iv_str) {
-        init_vec = &iv_default[0];
-        memcpy(init_vec, iv_str, strnlen(iv_str, EVP_MAX_IV_LENGTH));
-        init_vec[iv_length] = '\0';
-    }
-    EVP_CIPHER_CTX* cipher_ctx = EVP_CIPHER_CTX_new();
-    EVP_CIPHER_CTX_reset(cipher_ctx);
-    int length = 0;
-    int ret = do_decrypt(cipher_ctx, cipher, encrypt, encrypt_length, encrypt_key,
-                         reinterpret_cast<unsigned char*>(init_vec), padding, decrypt_content,
-                         &length);
-    EVP_CIPHER_CTX_free(cipher_ctx);
-    if (ret > 0) {
-        return length;
-    } else {
+int EncryptionContext::decrypt(EncryptionMode mode, const unsigned char* encrypt,
+                               uint32_t encrypt_length, const unsigned char* key,
+                               uint32_t key_length, const char* iv_str, bool padding,
+                               unsigned char* decrypt_content) {
+    int u_len = 0;
+    int f_len = 0;
+    if (!_init(mode, key, key_length, iv_str, padding, false) ||
+        EVP_DecryptUpdate(_cipher_ctx, decrypt_content, &u_len, encrypt, encrypt_length) == 0 ||
+        EVP_DecryptFinal_ex(_cipher_ctx, decrypt_content + u_len, &f_len) == 0) {
+        _initialized = false;
         ERR_clear_error();
         return AES_BAD_DATA;
     }
+    return u_len + f_len;
 }
 
 } // namespace doris
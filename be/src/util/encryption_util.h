@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include <openssl/ossl_typ.h>
 #include <stdint.h>
 
+#include <string>
+
 namespace doris {
 
 enum EncryptionMode {
@@ -66,4 +69,34 @@ public:
                        bool padding, unsigned char* decrypt_content);
 };
 
+// Encrypts or decrypts many values, e.g. the rows of a column, with one cipher context.
+// The key schedule of the last mode and key is kept, so the rows with the same key only
+// reset the iv. The buffer written must have room for the length of the input plus 16.
+// Not thread safe.
+class EncryptionContext {
+public:
+    EncryptionContext();
+    ~EncryptionContext();
+
+    // Returns the length of the result, or AES_BAD_DATA.
+    int encrypt(EncryptionMode mode, const unsigned char* source, uint32_t source_length,
+                const unsigned char* key, uint32_t key_length, const char* iv_str, bool padding,
+                unsigned char* encrypt);
+
+    int decrypt(EncryptionMode mode, const unsigned char* encrypt, uint32_t encrypt_length,
+                const unsigned char* key, uint32_t key_length, const char* iv_str, bool padding,
+                unsigned char* decrypt_content);
+
+private:
+    bool _init(EncryptionMode mode, const unsigned char* key, uint32_t key_length,
+               const char* iv_str, bool padding, bool is_encrypt);
+
+    EVP_CIPHER_CTX* _cipher_ctx;
+    // the mode and the key _cipher_ctx is initialized with
+    bool _initialized = false;
+    EncryptionMode _mode;
+    bool _is_encrypt;
+    std::string _key;
+};
+
 } // namespace doris
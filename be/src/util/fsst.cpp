@@ -0,0 +1,234 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/fsst.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "common/compiler_util.h"
+#include "gutil/strings/substitute.h"
+
+namespace doris {
+
+// the number of rounds to refine the symbol table in build()
+static constexpr int BUILD_ROUNDS = 5;
+// pseudo codes of escaped bytes in build(), byte b is ESCAPED_BYTE_BASE + b
+static constexpr int ESCAPED_BYTE_BASE = 256;
+static constexpr int NUM_PSEUDO_CODES = ESCAPED_BYTE_BASE + 256;
+
+FsstSymbolTable::FsstSymbolTable() : _num_symbols(0) {
+    _finalize();
+}
+
+void FsstSymbolTable::_finalize() {
+    // symbols in _sorted_codes are sorted by the first byte, then by the length descending
+    for (int i = 0; i < _num_symbols; ++i) {
+        _sorted_codes[i] = i;
+    }
+    std::sort(_sorted_codes, _sorted_codes + _num_symbols, [this](uint8_t l, uint8_t r) {
+        uint8_t l_first = _symbols[l].value & 0xFF;
+        uint8_t r_first = _symbols[r].value & 0xFF;
+        if (l_first != r_first) {
+            return l_first < r_first;
+        }
+        return _symbols[l].length > _symbols[r].length;
+    });
+    int pos = 0;
+    for (int b = 0; b < 256; ++b) {
+        _first_byte_begin[b] = pos;
+        while (pos < _num_symbols && (_symbols[_sorted_codes[pos]].value & 0xFF) == b) {
+            ++pos;
+        }
+    }
+    _first_byte_begin[256] = pos;
+}
+
+int FsstSymbolTable::_find_longest_symbol(const uint8_t* data, size_t size) const {
+    for (int i = _first_byte_begin[data[0]]; i < _first_byte_begin[data[0] + 1]; ++i) {
+        uint8_t code = _sorted_codes[i];
+        const Symbol& symbol = _symbols[code];
+        if (symbol.length <= size && memcmp(&symbol.value, data, symbol.length) == 0) {
+            return code;
+        }
+    }
+    return -1;
+}
+
+void FsstSymbolTable::build(const std::vector<Slice>& samples) {
+    _num_symbols = 0;
+    _finalize();
+    std::vector<uint64_t> single_counts(NUM_PSEUDO_CODES);
+    std::map<std::pair<int, int>, uint64_t> pair_counts;
+    for (int round = 0; round < BUILD_ROUNDS; ++round) {
+        // count the symbols and the pairs of consecutive symbols when compressing the samples
+        // with the current table
+        std::fill(single_counts.begin(), single_counts.end(), 0);
+        pair_counts.clear();
+        for (const Slice& sample : samples) {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(sample.data);
+            int prev = -1;
+            for (size_t i = 0; i < sample.size;) {
+                int code = _find_longest_symbol(data + i, sample.size - i);
+                if (code >= 0) {
+                    i += _symbols[code].length;
+                } else {
+                    code = ESCAPED_BYTE_BASE + data[i];
+                    ++i;
+                }
+                ++single_counts[code];
+                if (prev >= 0) {
+                    ++pair_counts[{prev, code}];
+                }
+                prev = code;
+            }
+        }
+
+        // the gain of a candidate is the number of bytes it covers
+        auto symbol_of = [this](int code) {
+            if (code >= ESCAPED_BYTE_BASE) {
+                Symbol symbol;
+                symbol.value = code - ESCAPED_BYTE_BASE;
+                symbol.length = 1;
+                return symbol;
+            }
+            return _symbols[code];
+        };
+        std::map<std::pair<uint64_t, uint8_t>, uint64_t> gains;
+        for (int code = 0; code < NUM_PSEUDO_CODES; ++code) {
+            if (single_counts[code] > 0) {
+                Symbol symbol = symbol_of(code);
+                gains[{symbol.value, symbol.length}] += single_counts[code] * symbol.length;
+            }
+        }
+        for (auto& [codes, count] : pair_counts) {
+            Symbol first = symbol_of(codes.first);
+            Symbol second = symbol_of(codes.second);
+            int length = first.length + second.length;
+            if (length > MAX_SYMBOL_LENGTH) {
+                continue;
+            }
+            uint64_t value = first.value | (second.value << (8 * first.length));
+            gains[{value, length}] += count * length;
+        }
+
+        std::vector<std::pair<uint64_t, std::pair<uint64_t, uint8_t>>> candidates;
+        candidates.reserve(gains.size());
+        for (auto& [symbol, gain] : gains) {
+            candidates.emplace_back(gain, symbol);
+        }
+        size_t num = std::min<size_t>(MAX_SYMBOLS, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + num, candidates.end(),
+                          [](const auto& l, const auto& r) {
+                              // ties are broken by the symbols to be deterministic
+                              return l.first > r.first ||
+                                     (l.first == r.first && l.second < r.second);
+                          });
+        _num_symbols = num;
+        for (size_t i = 0; i < num; ++i) {
+            _symbols[i].value = candidates[i].second.first;
+            _symbols[i].length = candidates[i].second.second;
+        }
+        _finalize();
+    }
+}
+
+void FsstSymbolTable::compress(const Slice& value, faststring* out) const {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(value.data);
+    size_t orig_size = out->size();
+    // at most 2 bytes for each input byte
+    out->resize(orig_size + value.size * 2);
+    uint8_t* dst = out->data() + orig_size;
+    for (size_t i = 0; i < value.size;) {
+        int code = _find_longest_symbol(data + i, value.size - i);
+        if (code >= 0) {
+            *dst++ = code;
+            i += _symbols[code].length;
+        } else {
+            *dst++ = ESCAPE_CODE;
+            *dst++ = data[i++];
+        }
+    }
+    out->resize(dst - out->data());
+}
+
+size_t FsstSymbolTable::decompress(const Slice& in, uint8_t* out) const {
+    return decompress_prefix(in, in.size * MAX_SYMBOL_LENGTH, out);
+}
+
+size_t FsstSymbolTable::decompress_prefix(const Slice& in, size_t limit, uint8_t* out) const {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(in.data);
+    size_t pos = 0;
+    for (size_t i = 0; i < in.size && pos < limit;) {
+        uint8_t code = data[i++];
+        if (LIKELY(code != ESCAPE_CODE)) {
+            // always copy 8 bytes, only the length of the symbol is taken
+            memcpy(out + pos, &_symbols[code].value, sizeof(uint64_t));
+            pos += _symbols[code].length;
+        } else if (i < in.size) {
+            out[pos++] = data[i++];
+        }
+    }
+    return pos;
+}
+
+void FsstSymbolTable::serialize(faststring* out) const {
+    out->push_back(static_cast<char>(_num_symbols));
+    for (int i = 0; i < _num_symbols; ++i) {
+        out->push_back(static_cast<char>(_symbols[i].length));
+        out->append(&_symbols[i].value, _symbols[i].length);
+    }
+}
+
+Status FsstSymbolTable::deserialize(const Slice& data, size_t* size) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data.data);
+    const uint8_t* end = ptr + data.size;
+    if (ptr == end) {
+        return Status::Corruption("empty fsst symbol table");
+    }
+    int num_symbols = *ptr++;
+    if (num_symbols > MAX_SYMBOLS) {
+        return Status::Corruption(
+                strings::Substitute("invalid number of fsst symbols: $0", num_symbols));
+    }
+    for (int i = 0; i < num_symbols; ++i) {
+        if (ptr == end) {
+            return Status::Corruption("truncated fsst symbol table");
+        }
+        uint8_t length = *ptr++;
+        if (length == 0 || length > MAX_SYMBOL_LENGTH || end - ptr < length) {
+            return Status::Corruption(
+                    strings::Substitute("invalid fsst symbol of length $0", length));
+        }
+        _symbols[i].value = 0;
+        memcpy(&_symbols[i].value, ptr, length);
+        _symbols[i].length = length;
+        ptr += length;
+    }
+    // the codes not in the table decode to nothing
+    for (int i = num_symbols; i <= MAX_SYMBOLS; ++i) {
+        _symbols[i] = Symbol();
+    }
+    _num_symbols = num_symbols;
+    _finalize();
+    *size = ptr - reinterpret_cast<const uint8_t*>(data.data);
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/status.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace doris {
+
+// A symbol table of FSST (Fast Static Symbol Table) string compression, see
+// "FSST: Fast Random Access String Compression" (VLDB 2020).
+//
+// Up to 255 symbols of 1 to 8 bytes are replaced by 1 byte codes, the bytes which aren't
+// covered by any symbol are escaped by the code 255. Each value is compressed separately so
+// that values can be decompressed individually. Compression always takes the longest symbol
+// matching the input, so equal values are compressed to equal bytes and equality can be
+// checked on compressed values.
+class FsstSymbolTable {
+public:
+    static constexpr int MAX_SYMBOLS = 255;
+    static constexpr uint8_t ESCAPE_CODE = 255;
+    static constexpr int MAX_SYMBOL_LENGTH = 8;
+
+    FsstSymbolTable();
+
+    // Build the symbol table from the sample values, the old symbols are dropped.
+    void build(const std::vector<Slice>& samples);
+
+    // Append the compressed value to 'out'.
+    void compress(const Slice& value, faststring* out) const;
+
+    // Decompress 'in' to 'out', which must have at least max_decompressed_size(in.size)
+    // bytes, return the size of the decompressed value.
+    size_t decompress(const Slice& in, uint8_t* out) const;
+
+    // Decompress until at least 'limit' bytes are decompressed, 'out' must have at least
+    // limit + MAX_SYMBOL_LENGTH bytes. Return the size of the decompressed bytes, which may be
+    // more than 'limit'.
+    size_t decompress_prefix(const Slice& in, size_t limit, uint8_t* out) const;
+
+    static size_t max_decompressed_size(size_t compressed_size) {
+        return compressed_size * MAX_SYMBOL_LENGTH + MAX_SYMBOL_LENGTH;
+    }
+
+    // Format: NumSymbols(1), then Length(1) + Bytes(Length) of each symbol.
+    void serialize(faststring* out) const;
+    // Parse the symbol table from the beginning of data, set the bytes it takes to 'size'.
+    Status deserialize(const Slice& data, size_t* size);
+
+    int num_symbols() const { return _num_symbols; }
+
+private:
+    struct Symbol {
+        // the bytes of the symbol, the unused bytes are zero
+        uint64_t value = 0;
+        uint8_t length = 0;
+    };
+
+    // rebuild _first_byte_begin and _sorted_codes after the symbols are changed
+    void _finalize();
+    // the code of the longest symbol which is a prefix of data, -1 if there isn't any
+    int _find_longest_symbol(const uint8_t* data, size_t size) const;
+
+    Symbol _symbols[MAX_SYMBOLS + 1];
+    int _num_symbols;
+    // the codes for symbols started with byte b are _sorted_codes[_first_byte_begin[b] ..
+    // _first_byte_begin[b + 1]), longer symbols first
+    uint16_t _first_byte_begin[257];
+    uint8_t _sorted_codes[MAX_SYMBOLS];
+};
+
+} // namespace doris
@@ -206,6 +206,43 @@ rj::Value HistogramMetric::to_json_value(rj::Document::AllocatorType& allocator)
     return json_value;
 }
 
+CoreLocalHistogramMetric::CoreLocalHistogramMetric() {
+    size_t num_cpus = std::thread::hardware_concurrency();
+    _num_cores = 8;
+    while (_num_cores < num_cpus) {
+        _num_cores <<= 1;
+    }
+    _stats.reset(new CoreStat[_num_cores]);
+}
+
+void CoreLocalHistogramMetric::merge_to(HistogramMetric* metric) const {
+    HistogramStat stats;
+    for (size_t i = 0; i < _num_cores; ++i) {
+        stats.merge(_stats[i].stat);
+    }
+    metric->set_histogram(stats);
+}
+
+std::string CoreLocalHistogramMetric::to_string() const {
+    HistogramMetric metric;
+    merge_to(&metric);
+    return metric.to_string();
+}
+
+std::string CoreLocalHistogramMetric::to_prometheus(const std::string& display_name,
+                                                    const Labels& entity_labels,
+                                                    const Labels& metric_labels) const {
+    HistogramMetric metric;
+    merge_to(&metric);
+    return metric.to_prometheus(display_name, entity_labels, metric_labels);
+}
+
+rj::Value CoreLocalHistogramMetric::to_json_value(rj::Document::AllocatorType& allocator) const {
+    HistogramMetric metric;
+    merge_to(&metric);
+    return metric.to_json_value(allocator);
+}
+
 std::string MetricPrototype::simple_name() const {
     return group_name.empty() ? name : group_name;
 }
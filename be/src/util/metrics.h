@@ -23,6 +23,7 @@
 #include <atomic>
 #include <functional>
 #include <iomanip>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <set>
@@ -206,6 +207,41 @@ protected:
     HistogramStat _stats;
 };
 
+// HistogramMetric to record on the hot paths, e.g. the latencies of page reads and rpcs.
+// The values are added into the stat of the current core without any lock, so the threads
+// do not contend on the same cache lines, and the stats of all the cores are merged when
+// the metric is output.
+class CoreLocalHistogramMetric : public Metric {
+public:
+    CoreLocalHistogramMetric();
+    virtual ~CoreLocalHistogramMetric() {}
+
+    CoreLocalHistogramMetric(const CoreLocalHistogramMetric&) = delete;
+    CoreLocalHistogramMetric& operator=(const CoreLocalHistogramMetric&) = delete;
+
+    void add(uint64_t value) {
+        size_t core = sched_getcpu();
+        _stats[core & (_num_cores - 1)].stat.add(value);
+    }
+
+    // Sets the stats of all the cores into metric.
+    void merge_to(HistogramMetric* metric) const;
+
+    std::string to_string() const override;
+    std::string to_prometheus(const std::string& display_name, const Labels& entity_labels,
+                              const Labels& metric_labels) const override;
+    rj::Value to_json_value(rj::Document::AllocatorType& allocator) const override;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) CoreStat {
+        HistogramStat stat;
+    };
+
+    // a power of 2 not less than the number of the cores
+    size_t _num_cores;
+    std::unique_ptr<CoreStat[]> _stats;
+};
+
 template <typename T>
 class AtomicCounter : public AtomicMetric<T> {
 public:
@@ -315,6 +351,10 @@ public:
 #define HISTOGRAM_METRIC_REGISTER(entity, metric) \
     metric = (HistogramMetric*)(entity->register_metric<HistogramMetric>(&METRIC_##metric))
 
+#define CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(entity, metric) \
+    metric = (CoreLocalHistogramMetric*)(entity->register_metric<CoreLocalHistogramMetric>( \
+            &METRIC_##metric))
+
 #define METRIC_DEREGISTER(entity, metric) entity->deregister_metric(&METRIC_##metric)
 
 // For 'metrics' in MetricEntity.
@@ -77,6 +77,10 @@ MysqlRowBuffer::~MysqlRowBuffer() {
 
 void MysqlRowBuffer::open_dynamic_mode() {
     if (!_dynamic_mode) {
+        // 1 for flag, 8 for length
+        if (0 != reserve(9)) {
+            LOG(FATAL) << "mysql row buffer reserve failed.";
+        }
         *_pos++ = NEXT_EIGHT_BYTE;
         // write length when dynamic mode close
         _len_pos = _pos;
@@ -121,6 +125,9 @@ int MysqlRowBuffer::reserve(int64_t size) {
     }
 
     _pos = new_buf + (_pos - _buf);
+    if (_len_pos != nullptr) {
+        _len_pos = new_buf + (_len_pos - _buf);
+    }
     _buf = new_buf;
     _buf_size = alloc_size;
 
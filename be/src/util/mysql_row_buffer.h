@@ -73,6 +73,10 @@ public:
     int push_string(const char* str, int64_t length);
     int push_null();
 
+    // make sure there are at least size bytes available after pos, so that a whole column
+    // can be pushed without growing the buffer again and again
+    int reserve(int64_t size);
+
     // this function reserved size, change the pos step size, return old pos
     // Becareful when use the returned pointer.
     char* reserved(int64_t size);
@@ -116,8 +120,6 @@ public:
     void close_dynamic_mode();
 
 private:
-    int reserve(int64_t size);
-
     char* _pos;
     char* _buf;
     int64_t _buf_size;
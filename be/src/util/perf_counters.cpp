@@ -25,10 +25,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 #include "util/debug_util.h"
@@ -514,4 +517,139 @@ void PerfCounters::pretty_print(ostream* s) const {
     stream << std::endl;
 }
 
+static PerfCounters::Counter to_perf_counter(ThreadPerfCounters::Counter counter) {
+    switch (counter) {
+    case ThreadPerfCounters::CPU_CYCLES:
+        return PerfCounters::PERF_COUNTER_HW_CPU_CYCLES;
+    case ThreadPerfCounters::INSTRUCTIONS:
+        return PerfCounters::PERF_COUNTER_HW_INSTRUCTIONS;
+    case ThreadPerfCounters::LLC_MISSES:
+        return PerfCounters::PERF_COUNTER_HW_CACHE_MISSES;
+    case ThreadPerfCounters::BRANCH_MISSES:
+    default:
+        return PerfCounters::PERF_COUNTER_HW_BRANCH_MISSES;
+    }
+}
+
+ThreadPerfCounters::ThreadPerfCounters() {
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        auto counter = static_cast<Counter>(i);
+        perf_event_attr attr;
+        init_event_attr(&attr, to_perf_counter(counter));
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // the calling thread on any cpu
+        int fd = sys_perf_event_open(&attr, 0, -1, _group_fd, 0);
+        if (fd < 0) {
+            // without the leader, e.g. in a container, none is available
+            if (_group_fd == -1) {
+                return;
+            }
+            continue;
+        }
+        if (_group_fd == -1) {
+            _group_fd = fd;
+        }
+        _fds.push_back(fd);
+        _counters.push_back(counter);
+    }
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() {
+    for (int fd : _fds) {
+        ::close(fd);
+    }
+}
+
+ThreadPerfCounters* ThreadPerfCounters::current() {
+    static thread_local std::unique_ptr<ThreadPerfCounters> counters;
+    static thread_local bool opened = false;
+    if (!opened) {
+        opened = true;
+        std::unique_ptr<ThreadPerfCounters> c(new ThreadPerfCounters());
+        if (c->_group_fd != -1) {
+            counters = std::move(c);
+        }
+    }
+    return counters.get();
+}
+
+void ThreadPerfCounters::read(Values* values) const {
+    values->fill(0);
+    // PERF_FORMAT_GROUP: the number of counters and their values
+    uint64_t buffer[NUM_COUNTERS + 1];
+    ssize_t size = ::read(_group_fd, buffer, sizeof(buffer));
+    if (size < (ssize_t)sizeof(uint64_t)) {
+        return;
+    }
+    size_t num = std::min<uint64_t>(buffer[0], _counters.size());
+    for (size_t i = 0; i < num; ++i) {
+        (*values)[_counters[i]] = buffer[i + 1];
+    }
+}
+
+const char* ThreadPerfCounters::name(Counter counter) {
+    switch (counter) {
+    case CPU_CYCLES:
+        return "PerfCycles";
+    case INSTRUCTIONS:
+        return "PerfInstructions";
+    case LLC_MISSES:
+        return "PerfLLCMisses";
+    case BRANCH_MISSES:
+        return "PerfBranchMisses";
+    default:
+        return "PerfUnknown";
+    }
+}
+
+ProfilePerfCounters::ProfilePerfCounters(RuntimeProfile* profile) {
+    for (int i = 0; i < ThreadPerfCounters::NUM_COUNTERS; ++i) {
+        auto counter = static_cast<ThreadPerfCounters::Counter>(i);
+        _counters[i] = ADD_COUNTER(profile, ThreadPerfCounters::name(counter), TUnit::UNIT);
+    }
+}
+
+void ProfilePerfCounters::update(const ThreadPerfCounters::Values& start,
+                                 const ThreadPerfCounters::Values& end) {
+    for (int i = 0; i < ThreadPerfCounters::NUM_COUNTERS; ++i) {
+        COUNTER_UPDATE(_counters[i], end[i] - start[i]);
+    }
+}
+
+// the innermost scope of the thread
+static thread_local ScopedPerfCounters* current_scope = nullptr;
+
+ScopedPerfCounters::ScopedPerfCounters(ProfilePerfCounters* counters) : _counters(counters) {
+    if (_counters == nullptr) {
+        return;
+    }
+    _thread_counters = ThreadPerfCounters::current();
+    if (_thread_counters == nullptr) {
+        _counters = nullptr;
+        return;
+    }
+    _thread_counters->read(&_start);
+    _parent = current_scope;
+    if (_parent != nullptr) {
+        _parent->_counters->update(_parent->_start, _start);
+    }
+    current_scope = this;
+}
+
+ScopedPerfCounters::~ScopedPerfCounters() {
+    if (_counters == nullptr) {
+        return;
+    }
+    ThreadPerfCounters::Values end;
+    _thread_counters->read(&end);
+    _counters->update(_start, end);
+    current_scope = _parent;
+    if (_parent != nullptr) {
+        // the parent goes on from here
+        _parent->_start = end;
+    }
+}
+
 } // namespace doris
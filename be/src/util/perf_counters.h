@@ -20,11 +20,13 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include "util/debug_util.h"
+#include "util/runtime_profile.h"
 
 // This is a utility class that aggregates counters from the kernel.  These counters
 // come from different sources.
@@ -139,4 +141,67 @@ private:
     int _group_fd;
 };
 
+// The hardware counters of the calling thread, opened once for each thread and read at once
+// as a group.
+class ThreadPerfCounters {
+public:
+    enum Counter {
+        CPU_CYCLES = 0,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_COUNTERS,
+    };
+
+    using Values = std::array<int64_t, NUM_COUNTERS>;
+
+    // The counters of the calling thread, nullptr if they are not available, e.g. not allowed
+    // by perf_event_paranoid.
+    static ThreadPerfCounters* current();
+
+    ~ThreadPerfCounters();
+
+    // The counters not available are 0.
+    void read(Values* values) const;
+
+    static const char* name(Counter counter);
+
+private:
+    ThreadPerfCounters();
+
+    int _group_fd = -1;
+    std::vector<int> _fds;
+    // the counters in the order of the group
+    std::vector<Counter> _counters;
+};
+
+// The hardware counters of an operator in its runtime profile.
+class ProfilePerfCounters {
+public:
+    explicit ProfilePerfCounters(RuntimeProfile* profile);
+
+    void update(const ThreadPerfCounters::Values& start, const ThreadPerfCounters::Values& end);
+
+private:
+    RuntimeProfile::Counter* _counters[ThreadPerfCounters::NUM_COUNTERS];
+};
+
+// Counts the hardware events of a scope of the calling thread into 'counters', excluding the
+// nested scopes, so an operator does not count the work of its children. Does nothing if
+// 'counters' is nullptr.
+class ScopedPerfCounters {
+public:
+    explicit ScopedPerfCounters(ProfilePerfCounters* counters);
+    ~ScopedPerfCounters();
+
+private:
+    ProfilePerfCounters* _counters;
+    ThreadPerfCounters* _thread_counters = nullptr;
+    ScopedPerfCounters* _parent = nullptr;
+    ThreadPerfCounters::Values _start;
+};
+
+#define SCOPED_PERF_COUNTERS(counters) \
+    ScopedPerfCounters MACRO_CONCAT(SCOPED_PERF_COUNTERS, __COUNTER__)(counters)
+
 } // namespace doris
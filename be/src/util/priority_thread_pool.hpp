@@ -39,6 +39,8 @@ public:
         int priority;
         WorkFunction work_function;
         int queue_id;
+        // the NUMA node preferred to run the task, -1 means any node
+        int numa_node = -1;
         bool operator<(const Task& o) const { return priority < o.priority; }
 
         Task& operator++() {
@@ -17,31 +17,59 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <queue>
+#include <random>
 #include <thread>
+#include <vector>
 
-#include "util/blocking_priority_queue.hpp"
+#include "common/config.h"
+#include "util/cpu_info.h"
+#include "util/doris_metrics.h"
+#include "util/priority_thread_pool.hpp"
+#include "util/spinlock.h"
 #include "util/thread_group.h"
 
 namespace doris {
 
-// Work-Stealing threadpool which processes items (of type T) in parallel which were placed on multi
-// blocking queues by Offer(). Each item is processed by a single user-supplied method.
+// Work-Stealing threadpool which processes items (of type T) in parallel which were placed on
+// the queues of the workers by Offer(). Each item is processed by a single user-supplied method.
+//
+// Every worker owns a priority queue guarded by its own spin lock, so the workers do not contend
+// on a shared queue. The workers are divided into `num_queues` groups, usually one group per
+// disk, and a task is put on the queue of a worker of the group `task.queue_id` in round-robin.
+// A worker runs the tasks of its own queue first, then steals from the other workers, preferring
+// the workers of the same group, then the ones last running on the same NUMA node, starting from
+// a random victim each time. Idle workers park on a condition variable until a task is offered.
+//
+// If NUMA affinity is enabled, the workers are bound to the NUMA nodes in round-robin, and a
+// task preferring a node is put on the queue of a worker of the group on that node if any.
 class PriorityWorkStealingThreadPool : public PriorityThreadPool {
 public:
     // Creates a new thread pool and start num_threads threads.
     //  -- num_threads: how many threads are part of this pool
-    //  -- num_queues: how many queues are part of this pool
-    //  -- queue_size: the maximum size of the queue on which work items are offered. If the
-    //     queue exceeds this size, subsequent calls to Offer will block until there is
-    //     capacity available.
+    //  -- num_queues: how many groups of the workers are part of this pool
+    //  -- queue_size: the maximum number of the queued tasks of a group. If the group exceeds
+    //     this size, subsequent calls to Offer will block until there is capacity available.
     PriorityWorkStealingThreadPool(uint32_t num_threads, uint32_t num_queues, uint32_t queue_size)
-            : PriorityThreadPool(0, 0) {
+            : PriorityThreadPool(0, 0), _queue_size(queue_size) {
         DCHECK_GT(num_queues, 0);
         DCHECK_GE(num_threads, num_queues);
-        // init _work_queues first because the work thread needs it
         for (int i = 0; i < num_queues; ++i) {
-            _work_queues.emplace_back(std::make_shared<BlockingPriorityQueue<Task>>(queue_size));
+            _groups.emplace_back(std::make_unique<WorkerGroup>());
+        }
+        // init _workers first because the work thread needs it
+        _bind_numa_node = CpuInfo::is_numa_affinity_enabled();
+        for (int i = 0; i < num_threads; ++i) {
+            _workers.emplace_back(std::make_unique<Worker>());
+            _workers[i]->group_id = i % num_queues;
+            if (_bind_numa_node) {
+                // spread the workers of every group over the nodes
+                _workers[i]->numa_node = (i / num_queues) % CpuInfo::get_max_num_numa_nodes();
+            }
+            _groups[i % num_queues]->workers.push_back(i);
         }
         for (int i = 0; i < num_threads; ++i) {
             _threads.create_thread(std::bind<void>(
@@ -65,11 +93,34 @@ public:
     //
     // Returns true if the work item was successfully added to the queue, false otherwise
     // (which typically means that the thread pool has already been shut down).
-    bool offer(Task task) override { return _work_queues[task.queue_id]->blocking_put(task); }
+    bool offer(Task task) override {
+        auto& group = *_groups[task.queue_id % _groups.size()];
+        if (group.num_tasks.load() >= _queue_size) {
+            std::unique_lock<std::mutex> l(_put_lock);
+            _num_blocked_puts++;
+            _put_cv.wait(l, [&] { return is_shutdown() || group.num_tasks.load() < _queue_size; });
+            _num_blocked_puts--;
+        }
+        if (is_shutdown()) {
+            return false;
+        }
+        // the capacity is checked without a lock, it may be exceeded a little by the
+        // concurrent offers
+        group.num_tasks++;
+        auto& worker = *_workers[_choose_worker(&group, task.numa_node)];
+        {
+            std::lock_guard<SpinLock> l(worker.lock);
+            worker.tasks.push(std::move(task));
+            worker.num_tasks++;
+        }
+        _num_tasks++;
+        _wake_up_idle_worker();
+        return true;
+    }
 
     bool offer(WorkFunction func) override {
         PriorityThreadPool::Task task = {0, func, 0};
-        return _work_queues[task.queue_id]->blocking_put(task);
+        return offer(std::move(task));
     }
 
     // Shuts the thread pool down, causing the work queue to cease accepting offered work
@@ -78,18 +129,15 @@ public:
     // terminate.
     void shutdown() override {
         PriorityThreadPool::shutdown();
-        for (auto work_queue : _work_queues) {
-            work_queue->shutdown();
+        {
+            std::lock_guard<std::mutex> l(_idle_lock);
+            _idle_cv.notify_all();
         }
+        std::lock_guard<std::mutex> l(_put_lock);
+        _put_cv.notify_all();
     }
 
-    uint32_t get_queue_size() const override {
-        uint32_t size = 0;
-        for (auto work_queue : _work_queues) {
-            size += work_queue->get_size();
-        }
-        return size;
-    }
+    uint32_t get_queue_size() const override { return _num_tasks.load(); }
 
     // Blocks until the work queue is empty, and then calls shutdown to stop the worker
     // threads and Join to wait until they are finished.
@@ -106,41 +154,172 @@ public:
     }
 
 private:
+    struct alignas(64) Worker {
+        SpinLock lock;
+        // guarded by lock
+        std::priority_queue<Task> tasks;
+        int upgrade_counter = 0;
+        // the size of tasks, read by the thieves without the lock
+        std::atomic<int> num_tasks {0};
+        int group_id = 0;
+        // the NUMA node the worker is bound to, or of the core it ran on lately if not bound
+        std::atomic<int> numa_node {0};
+    };
+
+    struct WorkerGroup {
+        std::vector<int> workers;
+        std::atomic<uint32_t> next_worker {0};
+        // the queued tasks of all the workers with the queue id of the group
+        std::atomic<uint32_t> num_tasks {0};
+    };
+
+    enum class StealScope { SAME_GROUP, SAME_NUMA_NODE, ANY };
+
     // Driver method for each thread in the pool. Continues to read work from the queue
     // until the pool is shutdown.
     void work_thread(int thread_id) {
-        auto queue_id = thread_id % _work_queues.size();
-        auto steal_queue_id = (queue_id + 1) % _work_queues.size();
+        if (_bind_numa_node) {
+            CpuInfo::bind_current_thread_to_numa_node(_workers[thread_id]->numa_node);
+        }
+        std::minstd_rand rand(thread_id + 1);
         while (!is_shutdown()) {
             Task task;
-            // avoid blocking get
-            bool is_other_queues_empty = true;
-            // steal work in round-robin if nothing to do
-            while (_work_queues[queue_id]->get_size() == 0 && queue_id != steal_queue_id &&
-                   !is_shutdown()) {
-                if (_work_queues[steal_queue_id]->non_blocking_get(&task)) {
-                    is_other_queues_empty = false;
-                    task.work_function();
-                }
-                steal_queue_id = (steal_queue_id + 1) % _work_queues.size();
+            if (_take_task(thread_id, &rand, &task)) {
+                task.work_function();
+            } else {
+                _wait_for_task();
             }
-            if (queue_id == steal_queue_id) {
-                steal_queue_id = (steal_queue_id + 1) % _work_queues.size();
+        }
+    }
+
+    bool _take_task(int id, std::minstd_rand* rand, Task* task) {
+        auto& self = *_workers[id];
+        int numa_node = self.numa_node;
+        if (!_bind_numa_node) {
+            numa_node = CpuInfo::get_current_numa_node();
+            self.numa_node = numa_node;
+        }
+        if (self.num_tasks.load() > 0) {
+            std::lock_guard<SpinLock> l(self.lock);
+            if (_pop_locked(&self, task)) {
+                return true;
             }
-            if (is_other_queues_empty &&
-                _work_queues[queue_id]->blocking_get(
-                        &task, config::doris_blocking_priority_queue_wait_timeout_ms)) {
-                task.work_function();
+        }
+        if (_num_tasks.load() == 0) {
+            return false;
+        }
+        size_t start = (*rand)() % _workers.size();
+        for (auto scope : {StealScope::SAME_GROUP, StealScope::SAME_NUMA_NODE, StealScope::ANY}) {
+            for (size_t i = 0; i < _workers.size(); ++i) {
+                auto& victim = *_workers[(start + i) % _workers.size()];
+                if (&victim == &self || victim.num_tasks.load() == 0) {
+                    continue;
+                }
+                bool same_group = victim.group_id == self.group_id;
+                bool same_node = victim.numa_node.load() == numa_node;
+                if ((scope == StealScope::SAME_GROUP && !same_group) ||
+                    (scope == StealScope::SAME_NUMA_NODE && (same_group || !same_node)) ||
+                    (scope == StealScope::ANY && (same_group || same_node))) {
+                    continue;
+                }
+                // do not wait for the worker or the other thieves
+                std::unique_lock<SpinLock> l(victim.lock, std::try_to_lock);
+                if (l.owns_lock() && _pop_locked(&victim, task)) {
+                    DorisMetrics::instance()->scanner_thread_pool_stolen_task_total->increment(1);
+                    if (!same_node) {
+                        DorisMetrics::instance()
+                                ->scanner_thread_pool_remote_numa_stolen_task_total->increment(1);
+                    }
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Picks the next worker of the group in round-robin, the next one on numa_node if any.
+    int _choose_worker(WorkerGroup* group, int numa_node) {
+        uint32_t next = group->next_worker++;
+        size_t num_workers = group->workers.size();
+        if (numa_node >= 0 && _bind_numa_node) {
+            for (size_t i = 0; i < num_workers; ++i) {
+                int id = group->workers[(next + i) % num_workers];
+                if (_workers[id]->numa_node.load() == numa_node) {
+                    return id;
+                }
             }
-            if (_work_queues[queue_id]->get_size() == 0) {
-                _empty_cv.notify_all();
+        }
+        return group->workers[next % num_workers];
+    }
+
+    bool _pop_locked(Worker* worker, Task* task) {
+        if (worker->tasks.empty()) {
+            return false;
+        }
+        // 定期提高队列中残留的任务优先级
+        // 保证优先级较低的大查询不至于完全饿死
+        if (worker->upgrade_counter > config::priority_queue_remaining_tasks_increased_frequency) {
+            std::priority_queue<Task> tmp_queue;
+            while (!worker->tasks.empty()) {
+                Task v = worker->tasks.top();
+                worker->tasks.pop();
+                ++v;
+                tmp_queue.push(v);
             }
+            std::swap(worker->tasks, tmp_queue);
+            worker->upgrade_counter = 0;
+        }
+        *task = worker->tasks.top();
+        worker->tasks.pop();
+        ++worker->upgrade_counter;
+        worker->num_tasks--;
+
+        _groups[task->queue_id % _groups.size()]->num_tasks--;
+        if (_num_blocked_puts.load() > 0) {
+            std::lock_guard<std::mutex> l(_put_lock);
+            _put_cv.notify_all();
+        }
+        if (--_num_tasks == 0) {
+            std::lock_guard<std::mutex> l(_lock);
+            _empty_cv.notify_all();
+        }
+        return true;
+    }
+
+    void _wait_for_task() {
+        std::unique_lock<std::mutex> l(_idle_lock);
+        // pairs with the check of _num_idle_workers in _wake_up_idle_worker()
+        _num_idle_workers++;
+        if (_num_tasks.load() == 0 && !is_shutdown()) {
+            _idle_cv.wait_for(l, std::chrono::milliseconds(
+                                         config::doris_blocking_priority_queue_wait_timeout_ms));
+        }
+        _num_idle_workers--;
+    }
+
+    void _wake_up_idle_worker() {
+        if (_num_idle_workers.load() > 0) {
+            std::lock_guard<std::mutex> l(_idle_lock);
+            _idle_cv.notify_one();
         }
     }
 
-    // Queue on which work items are held until a thread is available to process them in
-    // FIFO order.
-    std::vector<std::shared_ptr<BlockingPriorityQueue<Task>>> _work_queues;
+    const uint32_t _queue_size;
+    // whether the workers are bound to the NUMA nodes
+    bool _bind_numa_node = false;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::unique_ptr<WorkerGroup>> _groups;
+    // the queued tasks of all the workers
+    std::atomic<uint32_t> _num_tasks {0};
+
+    std::mutex _idle_lock;
+    std::condition_variable _idle_cv;
+    std::atomic<int> _num_idle_workers {0};
+
+    // for the offers blocked by a full group
+    std::mutex _put_lock;
+    std::condition_variable _put_cv;
+    std::atomic<int> _num_blocked_puts {0};
 };
 
-} // namespace doris
\ No newline at end of file
+} // namespace doris
@@ -264,21 +264,15 @@ void QuantileState<T>::merge(QuantileState<T>& other) {
             if (_explicit_data.size() + other._explicit_data.size() > QUANTILE_STATE_EXPLICIT_NUM) {
                 _type = TDIGEST;
                 _tdigest_ptr = std::make_unique<TDigest>(_compression);
-                for (int i = 0; i < _explicit_data.size(); i++) {
-                    _tdigest_ptr->add(_explicit_data[i]);
-                }
-                for (int i = 0; i < other._explicit_data.size(); i++) {
-                    _tdigest_ptr->add(other._explicit_data[i]);
-                }
+                _tdigest_ptr->add(_explicit_data.data(), _explicit_data.size());
+                _tdigest_ptr->add(other._explicit_data.data(), other._explicit_data.size());
             } else {
                 _explicit_data.insert(_explicit_data.end(), other._explicit_data.begin(),
                                       other._explicit_data.end());
             }
             break;
         case TDIGEST:
-            for (int i = 0; i < other._explicit_data.size(); i++) {
-                _tdigest_ptr->add(other._explicit_data[i]);
-            }
+            _tdigest_ptr->add(other._explicit_data.data(), other._explicit_data.size());
             break;
         default:
             break;
@@ -299,9 +293,7 @@ void QuantileState<T>::merge(QuantileState<T>& other) {
         case EXPLICIT:
             _type = TDIGEST;
             _tdigest_ptr = std::move(other._tdigest_ptr);
-            for (int i = 0; i < _explicit_data.size(); i++) {
-                _tdigest_ptr->add(_explicit_data[i]);
-            }
+            _tdigest_ptr->add(_explicit_data.data(), _explicit_data.size());
             break;
         case TDIGEST:
             _tdigest_ptr->merge(other._tdigest_ptr.get());
@@ -331,9 +323,8 @@ void QuantileState<T>::add_value(const T& value) {
     case EXPLICIT:
         if (_explicit_data.size() == QUANTILE_STATE_EXPLICIT_NUM) {
             _tdigest_ptr = std::make_unique<TDigest>(_compression);
-            for (int i = 0; i < _explicit_data.size(); i++) {
-                _tdigest_ptr->add(_explicit_data[i]);
-            }
+            _tdigest_ptr->add(_explicit_data.data(), _explicit_data.size());
+            _tdigest_ptr->add(value);
             _explicit_data.clear();
             _explicit_data.shrink_to_fit();
             _type = TDIGEST;
@@ -0,0 +1,291 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/query_trace.h"
+
+#include <fmt/format.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "common/compiler_util.h"
+#include "runtime/thread_context.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+class QueryTracer::ThreadBuffer {
+public:
+    explicit ThreadBuffer(size_t capacity)
+            : _slots(new Slot[capacity]), _capacity(capacity), _thread_id(syscall(SYS_gettid)) {}
+
+    // Only called by the owner thread.
+    void add(const char* category, const char* name, const TUniqueId& fragment_instance_id,
+             int64_t start_ns, int64_t duration_ns) {
+        Slot& slot = _slots[_next++ % _capacity];
+        uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+        // odd while the slot is written
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.category.store(category, std::memory_order_relaxed);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.instance_hi.store(fragment_instance_id.hi, std::memory_order_relaxed);
+        slot.instance_lo.store(fragment_instance_id.lo, std::memory_order_relaxed);
+        slot.start_ns.store(start_ns, std::memory_order_relaxed);
+        slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+        slot.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    void copy_to(const TUniqueId* query_id, int64_t min_start_ns,
+                 std::vector<QueryTraceEvent>* events) const {
+        for (size_t i = 0; i < _capacity; ++i) {
+            const Slot& slot = _slots[i];
+            uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq == 0 || (seq & 1) != 0) {
+                continue;
+            }
+            QueryTraceEvent event;
+            event.category = slot.category.load(std::memory_order_relaxed);
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.fragment_instance_id.hi = slot.instance_hi.load(std::memory_order_relaxed);
+            event.fragment_instance_id.lo = slot.instance_lo.load(std::memory_order_relaxed);
+            event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+            event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) {
+                // overwritten while copying
+                continue;
+            }
+            if (event.start_ns < min_start_ns) {
+                continue;
+            }
+            if (query_id != nullptr && event.fragment_instance_id.hi != query_id->hi) {
+                continue;
+            }
+            event.thread_id = _thread_id;
+            events->push_back(event);
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq {0};
+        std::atomic<const char*> category {nullptr};
+        std::atomic<const char*> name {nullptr};
+        std::atomic<int64_t> instance_hi {0};
+        std::atomic<int64_t> instance_lo {0};
+        std::atomic<int64_t> start_ns {0};
+        std::atomic<int64_t> duration_ns {0};
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    const size_t _capacity;
+    const int64_t _thread_id;
+    uint64_t _next = 0;
+};
+
+struct QueryTracer::ThreadBufferHolder {
+    ~ThreadBufferHolder() {
+        if (buffer != nullptr) {
+            QueryTracer::instance()->_deregister(buffer);
+        }
+    }
+
+    ThreadBuffer* buffer = nullptr;
+};
+
+QueryTracer* QueryTracer::instance() {
+    // never destroyed, the threads may exit after the static destructors run
+    static QueryTracer* tracer = new QueryTracer();
+    return tracer;
+}
+
+QueryTracer::ThreadBuffer* QueryTracer::_thread_buffer() {
+    static thread_local ThreadBufferHolder holder;
+    if (UNLIKELY(holder.buffer == nullptr)) {
+        auto buffer = std::make_shared<ThreadBuffer>(
+                std::max(config::query_trace_thread_buffer_events, 1));
+        std::lock_guard l(_lock);
+        _buffers.push_back(buffer);
+        holder.buffer = buffer.get();
+    }
+    return holder.buffer;
+}
+
+void QueryTracer::_deregister(ThreadBuffer* buffer) {
+    std::lock_guard l(_lock);
+    auto it = std::find_if(_buffers.begin(), _buffers.end(),
+                           [buffer](const auto& b) { return b.get() == buffer; });
+    if (it != _buffers.end()) {
+        _buffers.erase(it);
+    }
+}
+
+void QueryTracer::add(const char* category, const char* name, int64_t start_ns,
+                      int64_t end_ns) {
+    _thread_buffer()->add(category, name, tls_ctx()->fragment_instance_id(), start_ns,
+                          end_ns - start_ns);
+}
+
+void QueryTracer::get_events(const TUniqueId* query_id, std::vector<QueryTraceEvent>* events) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard l(_lock);
+        buffers = _buffers;
+    }
+    int64_t min_start_ns = _clear_ns.load(std::memory_order_relaxed);
+    for (auto& buffer : buffers) {
+        buffer->copy_to(query_id, min_start_ns, events);
+    }
+    std::sort(events->begin(), events->end(),
+              [](const QueryTraceEvent& a, const QueryTraceEvent& b) {
+                  return a.start_ns < b.start_ns;
+              });
+}
+
+void QueryTracer::clear() {
+    _clear_ns.store(MonotonicNanos(), std::memory_order_relaxed);
+}
+
+// the offset from the monotonic time of the spans to the unix time
+static int64_t unix_offset_ns() {
+    return UnixMicros() * 1000 - MonotonicNanos();
+}
+
+std::string QueryTracer::to_chrome_trace(const std::vector<QueryTraceEvent>& events) {
+    int64_t offset_ns = unix_offset_ns();
+    int64_t pid = getpid();
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    for (auto& event : events) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(event.name);
+        writer.Key("cat");
+        writer.String(event.category);
+        writer.Key("ph");
+        writer.String("X");
+        // in microseconds
+        writer.Key("ts");
+        writer.Double((event.start_ns + offset_ns) / 1000.0);
+        writer.Key("dur");
+        writer.Double(event.duration_ns / 1000.0);
+        writer.Key("pid");
+        writer.Int64(pid);
+        writer.Key("tid");
+        writer.Int64(event.thread_id);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("fragment_instance_id");
+        writer.String(print_id(event.fragment_instance_id).c_str());
+        writer.EndObject();
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("displayTimeUnit");
+    writer.String("ns");
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+static void write_string_attribute(rapidjson::Writer<rapidjson::StringBuffer>* writer,
+                                   const char* key, const std::string& value) {
+    writer->StartObject();
+    writer->Key("key");
+    writer->String(key);
+    writer->Key("value");
+    writer->StartObject();
+    writer->Key("stringValue");
+    writer->String(value.c_str());
+    writer->EndObject();
+    writer->EndObject();
+}
+
+std::string QueryTracer::to_otlp_json(const std::vector<QueryTraceEvent>& events,
+                                      const TUniqueId* query_id) {
+    int64_t offset_ns = unix_offset_ns();
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("resourceSpans");
+    writer.StartArray();
+    writer.StartObject();
+    writer.Key("resource");
+    writer.StartObject();
+    writer.Key("attributes");
+    writer.StartArray();
+    write_string_attribute(&writer, "service.name", "doris_be");
+    writer.EndArray();
+    writer.EndObject();
+    writer.Key("scopeSpans");
+    writer.StartArray();
+    writer.StartObject();
+    writer.Key("scope");
+    writer.StartObject();
+    writer.Key("name");
+    writer.String("doris.query_trace");
+    writer.EndObject();
+    writer.Key("spans");
+    writer.StartArray();
+    uint64_t span_id = 0;
+    for (auto& event : events) {
+        // the low bits of the query id are unknown without query_id
+        int64_t trace_lo = query_id != nullptr ? query_id->lo : 0;
+        std::string trace_id = fmt::format("{:016x}{:016x}",
+                                           (uint64_t)event.fragment_instance_id.hi,
+                                           (uint64_t)trace_lo);
+        uint64_t start_ns = event.start_ns + offset_ns;
+        writer.StartObject();
+        writer.Key("traceId");
+        writer.String(trace_id.c_str());
+        writer.Key("spanId");
+        writer.String(fmt::format("{:016x}", ++span_id).c_str());
+        writer.Key("name");
+        writer.String(event.name);
+        // SPAN_KIND_INTERNAL
+        writer.Key("kind");
+        writer.Int(1);
+        // 64-bit integers are strings in the JSON mapping of protobuf
+        writer.Key("startTimeUnixNano");
+        writer.String(std::to_string(start_ns).c_str());
+        writer.Key("endTimeUnixNano");
+        writer.String(std::to_string(start_ns + event.duration_ns).c_str());
+        writer.Key("attributes");
+        writer.StartArray();
+        write_string_attribute(&writer, "category", event.category);
+        write_string_attribute(&writer, "fragment_instance_id",
+                               print_id(event.fragment_instance_id));
+        write_string_attribute(&writer, "thread.id", std::to_string(event.thread_id));
+        writer.EndArray();
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    writer.EndArray();
+    writer.EndObject();
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+} // namespace doris
@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gen_cpp/Types_types.h"
+#include "gutil/macros.h"
+#include "util/time.h"
+
+namespace doris {
+
+// A span of work done for a fragment instance, e.g. reading a block by a scanner or waiting
+// for a runtime filter. The names are static strings.
+struct QueryTraceEvent {
+    const char* category = nullptr;
+    const char* name = nullptr;
+    TUniqueId fragment_instance_id;
+    int64_t thread_id = 0;
+    // monotonic time
+    int64_t start_ns = 0;
+    int64_t duration_ns = 0;
+};
+
+// Records the spans of the queries into a ring buffer of each thread, to show the timeline
+// of the operators which the counters of the runtime profile sum up. Nothing is recorded
+// unless config::enable_query_trace is set.
+//
+// A thread writes its buffer without any lock, the slots carry a sequence number to let the
+// readers drop a slot overwritten while it is copied. The oldest spans of a thread are dropped
+// once the buffer is full, and all spans of a thread are dropped when it exits.
+class QueryTracer {
+public:
+    static QueryTracer* instance();
+
+    static bool enabled() { return config::enable_query_trace; }
+
+    // Records a span of the fragment instance attached to the current thread.
+    void add(const char* category, const char* name, int64_t start_ns, int64_t end_ns);
+
+    // Copies the recorded spans of the query, all the spans if query_id is nullptr, ordered
+    // by start time. The fragment instances of a query share the high bits of its id.
+    void get_events(const TUniqueId* query_id, std::vector<QueryTraceEvent>* events);
+
+    // Drops all the recorded spans.
+    void clear();
+
+    // Chrome trace event format, loaded by chrome://tracing or Perfetto.
+    static std::string to_chrome_trace(const std::vector<QueryTraceEvent>& events);
+
+    // OTLP JSON of the spans, one trace per query.
+    // query_id, if given, is the trace id of the spans.
+    static std::string to_otlp_json(const std::vector<QueryTraceEvent>& events,
+                                    const TUniqueId* query_id);
+
+private:
+    class ThreadBuffer;
+    struct ThreadBufferHolder;
+
+    QueryTracer() = default;
+
+    ThreadBuffer* _thread_buffer();
+    void _deregister(ThreadBuffer* buffer);
+
+    std::mutex _lock;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+    // the spans started before are cleared
+    std::atomic<int64_t> _clear_ns {0};
+};
+
+class ScopedQueryTrace {
+public:
+    ScopedQueryTrace(const char* category, const char* name)
+            : _category(category),
+              _name(name),
+              _start_ns(QueryTracer::enabled() ? MonotonicNanos() : 0) {}
+
+    ~ScopedQueryTrace() {
+        if (_start_ns != 0) {
+            QueryTracer::instance()->add(_category, _name, _start_ns, MonotonicNanos());
+        }
+    }
+
+private:
+    const char* _category;
+    const char* _name;
+    int64_t _start_ns;
+};
+
+#define SCOPED_QUERY_TRACE(category, name) \
+    ScopedQueryTrace VARNAME_LINENUM(query_trace)(category, name)
+
+} // namespace doris
@@ -17,6 +17,7 @@
 
 #include "util/s3_storage_backend.h"
 
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/CopyObjectRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
@@ -24,6 +25,7 @@
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/transfer/TransferManager.h>
 
 #include <boost/algorithm/string.hpp>
 #include <filesystem>
@@ -31,6 +33,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/strip.h"
 #include "util/s3_uri.h"
@@ -66,6 +69,10 @@ S3StorageBackend::S3StorageBackend(const std::map<std::string, std::string>& pro
         : _properties(prop) {
     _client = ClientFactory::instance().create(_properties);
     DCHECK(_client) << "init aws s3 client error.";
+    // the snapshot loader uploads several files at once, each of them may be split into parts
+    _executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+            "S3StorageBackend", std::max(config::s3_transfer_executor_pool_size,
+                                         config::snapshot_transfer_thread_num));
 }
 
 S3StorageBackend::~S3StorageBackend() {}
@@ -110,20 +117,23 @@ Status S3StorageBackend::direct_download(const std::string& remote, std::string*
 Status S3StorageBackend::upload(const std::string& local, const std::string& remote) {
     CHECK_S3_CLIENT(_client);
     CHECK_S3_PATH(uri, remote);
-    Aws::S3::Model::PutObjectRequest request;
-    request.WithBucket(uri.get_bucket()).WithKey(uri.get_key());
-
-    const std::shared_ptr<Aws::IOStream> input_data = Aws::MakeShared<Aws::FStream>(
-            local.c_str(), local.c_str(), std::ios_base::in | std::ios_base::binary);
-    if (input_data->good()) {
-        request.SetBody(input_data);
-    }
-    if (!input_data->good()) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(local, ec)) {
         return Status::InternalError("failed to read file: " + local);
     }
-    Aws::S3::Model::PutObjectOutcome response = _client->PutObject(request);
-
-    RETRUN_S3_STATUS(response);
+    // large files are uploaded as multipart uploads, whose parts are sent concurrently
+    Aws::Transfer::TransferManagerConfiguration transfer_config(_executor.get());
+    transfer_config.s3Client = _client;
+    auto transfer_manager = Aws::Transfer::TransferManager::Create(transfer_config);
+    auto handle = transfer_manager->UploadFile(local, uri.get_bucket(), uri.get_key(),
+                                               "application/octet-stream",
+                                               Aws::Map<Aws::String, Aws::String>());
+    handle->WaitUntilFinished();
+    if (handle->GetStatus() != Aws::Transfer::TransferStatus::COMPLETED) {
+        return Status::IOError("s3 upload error: " + handle->GetLastError().GetMessage() +
+                               ", local: " + local + ", remote: " + remote);
+    }
+    return Status::OK();
 }
 
 Status S3StorageBackend::list(const std::string& remote_path, bool contain_md5, bool recursion,
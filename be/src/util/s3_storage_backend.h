@@ -23,6 +23,9 @@ namespace Aws {
 namespace S3 {
 class S3Client;
 } // namespace S3
+namespace Utils::Threading {
+class PooledThreadExecutor;
+} // namespace Utils::Threading
 } // namespace Aws
 
 namespace doris {
@@ -55,6 +58,8 @@ private:
     std::string error_msg(const AwsOutcome& outcome);
     const std::map<std::string, std::string>& _properties;
     std::shared_ptr<Aws::S3::S3Client> _client;
+    // runs the transfers of the multipart uploads
+    std::shared_ptr<Aws::Utils::Threading::PooledThreadExecutor> _executor;
 };
 
 } // end namespace doris
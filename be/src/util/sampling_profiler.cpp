@@ -0,0 +1,196 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/sampling_profiler.h"
+
+#include <fmt/format.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/stacktrace.hpp>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+namespace {
+
+constexpr int MAX_DEPTH = 64;
+
+struct Sample {
+    std::atomic<bool> ready {false};
+    int64_t instance_hi;
+    int64_t instance_lo;
+    int depth;
+    boost::stacktrace::frame::native_frame_ptr_t frames[MAX_DEPTH + 1];
+};
+
+thread_local int64_t thread_instance_hi = 0;
+thread_local int64_t thread_instance_lo = 0;
+
+std::mutex profile_lock;
+// Never freed, a signal handler may still be running after the timer is stopped.
+Sample* samples = nullptr;
+size_t num_samples = 0;
+std::atomic<bool> sampling {false};
+std::atomic<size_t> next_sample {0};
+
+void on_sigprof(int, siginfo_t*, void*) {
+    if (!sampling.load(std::memory_order_relaxed)) {
+        return;
+    }
+    int saved_errno = errno;
+    size_t i = next_sample.fetch_add(1, std::memory_order_relaxed);
+    if (i < num_samples) {
+        Sample& sample = samples[i];
+        sample.instance_hi = thread_instance_hi;
+        sample.instance_lo = thread_instance_lo;
+        // skip this handler and the signal trampoline
+        size_t depth = boost::stacktrace::safe_dump_to(2, sample.frames, sizeof(sample.frames));
+        // including the terminating null frame
+        sample.depth = depth > 0 ? depth - 1 : 0;
+        sample.ready.store(true, std::memory_order_release);
+    }
+    errno = saved_errno;
+}
+
+const std::string& symbolize(boost::stacktrace::frame::native_frame_ptr_t address,
+                             std::unordered_map<const void*, std::string>* symbols) {
+    auto it = symbols->find(address);
+    if (it == symbols->end()) {
+        std::string name = boost::stacktrace::frame(address).name();
+        if (name.empty()) {
+            name = fmt::format("{}", address);
+        }
+        // ';' separate the frames of a folded stack
+        std::replace(name.begin(), name.end(), ';', ':');
+        it = symbols->emplace(address, std::move(name)).first;
+    }
+    return it->second;
+}
+
+} // namespace
+
+void SamplingProfiler::set_thread_fragment_instance(const TUniqueId& fragment_instance_id) {
+    thread_instance_hi = fragment_instance_id.hi;
+    thread_instance_lo = fragment_instance_id.lo;
+}
+
+Status SamplingProfiler::profile(int seconds, int frequency, const TUniqueId* query_id,
+                                 std::string* folded_stacks) {
+    if (seconds <= 0 || frequency <= 0 || frequency > 1000) {
+        return Status::InvalidArgument(
+                fmt::format("invalid seconds {} or frequency {}", seconds, frequency));
+    }
+    std::unique_lock l(profile_lock, std::try_to_lock);
+    if (!l.owns_lock()) {
+        return Status::InternalError("the sampling profiler is already running");
+    }
+    if (samples == nullptr) {
+        num_samples = std::max(config::sampling_profiler_max_samples, 1);
+        samples = new Sample[num_samples];
+    }
+    for (size_t i = 0; i < num_samples; ++i) {
+        samples[i].ready.store(false, std::memory_order_relaxed);
+    }
+    next_sample.store(0, std::memory_order_relaxed);
+    // the first unwinding may load the unwinder, which is not allowed in the signal handler
+    boost::stacktrace::frame::native_frame_ptr_t warm_up[4];
+    boost::stacktrace::safe_dump_to(warm_up, sizeof(warm_up));
+
+    struct sigaction action;
+    struct sigaction old_action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = on_sigprof;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &old_action) != 0) {
+        return Status::InternalError(
+                fmt::format("failed to install the handler of SIGPROF: {}", strerror(errno)));
+    }
+    sampling.store(true, std::memory_order_relaxed);
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 1000000 / frequency;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        sampling.store(false, std::memory_order_relaxed);
+        sigaction(SIGPROF, &old_action, nullptr);
+        return Status::InternalError(
+                fmt::format("failed to start the profiling timer: {}", strerror(errno)));
+    }
+    sleep(seconds);
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    sampling.store(false, std::memory_order_relaxed);
+    // a pending SIGPROF must not terminate the process
+    if (old_action.sa_handler == SIG_DFL) {
+        old_action.sa_handler = SIG_IGN;
+    }
+    sigaction(SIGPROF, &old_action, nullptr);
+
+    size_t num = std::min(next_sample.load(std::memory_order_relaxed), num_samples);
+    std::unordered_map<const void*, std::string> symbols;
+    std::map<std::string, int64_t> stacks;
+    for (size_t i = 0; i < num; ++i) {
+        const Sample& sample = samples[i];
+        if (!sample.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (query_id != nullptr && sample.instance_hi != query_id->hi) {
+            continue;
+        }
+        std::string stack;
+        if (sample.instance_hi == 0 && sample.instance_lo == 0) {
+            stack = "no_fragment";
+        } else {
+            TUniqueId instance_id;
+            instance_id.hi = sample.instance_hi;
+            instance_id.lo = sample.instance_lo;
+            stack = "fragment_" + print_id(instance_id);
+        }
+        for (int j = sample.depth - 1; j >= 0; --j) {
+            stack.push_back(';');
+            stack.append(symbolize(sample.frames[j], &symbols));
+        }
+        ++stacks[stack];
+    }
+    folded_stacks->clear();
+    for (auto& [stack, count] : stacks) {
+        folded_stacks->append(stack);
+        folded_stacks->push_back(' ');
+        folded_stacks->append(std::to_string(count));
+        folded_stacks->push_back('\n');
+    }
+    if (next_sample.load(std::memory_order_relaxed) > num_samples) {
+        LOG(WARNING) << "sampling profiler dropped "
+                     << next_sample.load(std::memory_order_relaxed) - num_samples
+                     << " samples, sampling_profiler_max_samples=" << num_samples;
+    }
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+
+namespace doris {
+
+// Samples the stacks of the threads consuming CPU by SIGPROF and tags each sample with the
+// fragment instance attached to the thread, to find out which query is burning CPU.
+//
+// The signal handler appends the samples into a buffer allocated in advance without any
+// lock. SIGPROF is shared with the CPU profiler of gperftools, they must not run at the
+// same time.
+class SamplingProfiler {
+public:
+    // Sets the fragment instance of the samples of the calling thread, TUniqueId() if none.
+    static void set_thread_fragment_instance(const TUniqueId& fragment_instance_id);
+
+    // Samples for 'seconds' at 'frequency' samples per second of CPU time, and returns the
+    // samples as folded stacks to be drawn by flamegraph.pl, one line of
+    // "fragment_<id>;<root frame>;...;<leaf frame> <count>" for each stack. Only the samples
+    // of the query are returned if query_id is not nullptr, the fragment instances of a query
+    // share the high bits of its id.
+    static Status profile(int seconds, int frequency, const TUniqueId* query_id,
+                          std::string* folded_stacks);
+};
+
+} // namespace doris
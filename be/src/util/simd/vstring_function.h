@@ -127,10 +127,14 @@ public:
     }
 
     // Gcc will do auto simd in this function
-    static bool is_ascii(const StringVal& str) {
-        char or_code = 0;
-        for (size_t i = 0; i < str.len; i++) {
-            or_code |= str.ptr[i];
+    static bool is_ascii(const StringVal& str) { return is_ascii(str.ptr, str.len); }
+
+    // Used on the whole chars buffer of a string column to choose the ascii path of a
+    // function once per column rather than decoding UTF-8 row by row.
+    static bool is_ascii(const uint8_t* data, size_t len) {
+        uint8_t or_code = 0;
+        for (size_t i = 0; i < len; i++) {
+            or_code |= data[i];
         }
         return !(or_code & 0x80);
     }
@@ -155,8 +155,8 @@ public:
             : _compression(compression),
               _max_processed(processedSize(mergedSize, compression)),
               _max_unprocessed(unprocessedSize(unmergedSize, compression)) {
-        _processed.reserve(_max_processed);
-        _unprocessed.reserve(_max_unprocessed + 1);
+        // The buffers grow with the values added, a digest per group of an aggregation
+        // should not cost the whole 8 * compression centroids up front.
     }
 
     TDigest(std::vector<Centroid>&& processed, std::vector<Centroid>&& unprocessed,
@@ -428,6 +428,30 @@ public:
         return true;
     }
 
+    // add a batch of values with weight 1, the values are sorted and merged into the processed
+    // centroids once per _max_unprocessed values instead of being checked one by one.
+    template <typename T>
+    void add(const T* values, size_t count) {
+        while (count > 0) {
+            // fill the buffer up to one above the limit, where add(x) would process it
+            const size_t room = _max_unprocessed >= _unprocessed.size()
+                                        ? _max_unprocessed - _unprocessed.size() + 1
+                                        : 1;
+            const size_t chunk = std::min(count, room);
+            _unprocessed.reserve(_unprocessed.size() + chunk);
+            for (size_t i = 0; i < chunk; ++i) {
+                const Value x = static_cast<Value>(values[i]);
+                if (!std::isnan(x)) {
+                    _unprocessed.emplace_back(x, 1);
+                    _unprocessed_weight += 1;
+                }
+            }
+            values += chunk;
+            count -= chunk;
+            processIfNecessary();
+        }
+    }
+
     void add(std::vector<Centroid>::const_iterator iter,
              std::vector<Centroid>::const_iterator end) {
         while (iter != end) {
@@ -441,13 +465,21 @@ public:
         }
     }
 
+    // Only the processed centroids are serialized, the buffered values are merged first so
+    // that a digest shuffled or stored costs at most about 2 * compression centroids.
     uint32_t serialized_size() {
+        if (haveUnprocessed()) {
+            process();
+        }
         return sizeof(uint32_t) + sizeof(Value) * 5 + sizeof(Index) * 2 + sizeof(uint32_t) * 3 +
                _processed.size() * sizeof(Centroid) + _unprocessed.size() * sizeof(Centroid) +
                _cumulative.size() * sizeof(Weight);
     }
 
     size_t serialize(uint8_t* writer) {
+        if (haveUnprocessed()) {
+            process();
+        }
         uint8_t* dst = writer;
         uint32_t total_size = serialized_size();
         memcpy(writer, &total_size, sizeof(uint32_t));
@@ -31,6 +31,7 @@ namespace doris::vectorized {
 class Arena;
 class IColumn;
 class IDataType;
+class SharedDistinctKeys;
 
 using DataTypePtr = std::shared_ptr<const IDataType>;
 using DataTypes = std::vector<DataTypePtr>;
@@ -98,12 +99,31 @@ public:
     virtual void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
                              Arena* arena) const = 0;
 
+    /// Merges the serialized state into place. rhs is a buffer of size_of_data() to deserialize
+    /// the state into, the functions which merge from the serialized bytes directly ignore it.
+    virtual void deserialize_and_merge(AggregateDataPtr __restrict place,
+                                       AggregateDataPtr __restrict rhs, BufferReadable& buf,
+                                       Arena* arena) const {
+        create(rhs);
+        deserialize(rhs, buf, arena);
+        merge(place, rhs, arena);
+        destroy(rhs);
+    }
+
     /// Returns true if a function requires Arena to handle own states (see add(), merge(), deserialize()).
     virtual bool allocates_memory_in_arena() const { return false; }
 
     /// Inserts results into a column.
     virtual void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const = 0;
 
+    /// Returns the function of the same result whose distinct keys are in `keys`, shared by the
+    /// distinct functions of an aggregation, or nullptr if the function is not a distinct one
+    /// able to share them. The keys of the states can be serialized only if `keep_keys`.
+    virtual std::shared_ptr<IAggregateFunction> create_shared_distinct(
+            const std::shared_ptr<SharedDistinctKeys>& keys, bool keep_keys) const {
+        return nullptr;
+    }
+
     /** Returns true for aggregate functions of type -State.
       * They are executed as other aggregate functions, but not finalized (return an aggregation state that can be combined with another).
       */
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "exprs/anyval_util.h"
 #include "olap/hll.h"
 #include "udf/udf.h"
@@ -31,14 +33,22 @@ namespace doris::vectorized {
 struct AggregateFunctionApproxCountDistinctData {
     HyperLogLog hll_data;
 
+    static uint64_t hash(StringRef value) {
+        return AnyValUtil::hash64_murmur(value.to_string_val(), HashUtil::MURMUR_SEED);
+    }
+
     void add(StringRef value) {
-        StringVal sv = value.to_string_val();
-        uint64_t hash_value = AnyValUtil::hash64_murmur(sv, HashUtil::MURMUR_SEED);
+        uint64_t hash_value = hash(value);
         if (hash_value != 0) {
             hll_data.update(hash_value);
         }
     }
 
+    // the hash values of 0, which are not counted, must have been skipped
+    void add_batch(const uint64_t* hash_values, size_t num) {
+        hll_data.update_batch(hash_values, num);
+    }
+
     void merge(const AggregateFunctionApproxCountDistinctData& rhs) {
         hll_data.merge(rhs.hll_data);
     }
@@ -83,6 +93,21 @@ public:
         this->data(place).add(static_cast<const ColumnDataType*>(columns[0])->get_data_at(row_num));
     }
 
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        const auto* column = static_cast<const ColumnDataType*>(columns[0]);
+        std::vector<uint64_t> hash_values;
+        hash_values.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            uint64_t hash_value =
+                    AggregateFunctionApproxCountDistinctData::hash(column->get_data_at(i));
+            if (hash_value != 0) {
+                hash_values.push_back(hash_value);
+            }
+        }
+        this->data(place).add_batch(hash_values.data(), hash_values.size());
+    }
+
     void reset(AggregateDataPtr place) const override { this->data(place).reset(); }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
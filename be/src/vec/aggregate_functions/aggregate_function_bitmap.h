@@ -17,6 +17,10 @@
 
 #pragma once
 
+#include <parallel_hashmap/phmap.h>
+
+#include <vector>
+
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column_complex.h"
 #include "vec/columns/column_nullable.h"
@@ -79,9 +83,52 @@ struct AggregateFunctionBitmapData {
 
     void read(BufferReadable& buf) { DataTypeBitMap::deserialize_as_stream(value, buf); }
 
+    // Merges the serialized bitmap without a BitmapValue built for it, only for the union.
+    void read_and_merge(BufferReadable& buf) {
+        static_assert(std::is_same_v<Op, AggregateFunctionBitmapUnionOp>);
+        StringRef ref;
+        read_string_binary(ref, buf);
+        value.union_serialized(ref.data);
+    }
+
     BitmapValue& get() { return value; }
 };
 
+// Unions the bitmaps of the rows of every place at once instead of row by row.
+struct AggregateFunctionBitmapBatchUnion {
+    using Data = AggregateFunctionBitmapData<AggregateFunctionBitmapUnionOp>;
+
+    // null_map is nullptr if the column is not nullable
+    static void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                          const ColumnBitmap& column, const NullMap* null_map) {
+        const auto& data = column.get_data();
+        phmap::flat_hash_map<AggregateDataPtr, std::vector<const BitmapValue*>> place_bitmaps;
+        for (size_t i = 0; i < batch_size; ++i) {
+            if (null_map == nullptr || !(*null_map)[i]) {
+                place_bitmaps[places[i] + place_offset].push_back(&data[i]);
+            }
+        }
+        for (const auto& [place, bitmaps] : place_bitmaps) {
+            reinterpret_cast<Data*>(place)->get().fastunion(bitmaps);
+        }
+    }
+
+    static void add_batch_single_place(size_t batch_size, AggregateDataPtr place,
+                                       const ColumnBitmap& column, const NullMap* null_map) {
+        const auto& data = column.get_data();
+        std::vector<const BitmapValue*> bitmaps;
+        bitmaps.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            if (null_map == nullptr || !(*null_map)[i]) {
+                bitmaps.push_back(&data[i]);
+            }
+        }
+        if (!bitmaps.empty()) {
+            reinterpret_cast<Data*>(place)->get().fastunion(bitmaps);
+        }
+    }
+};
+
 template <typename Op>
 class AggregateFunctionBitmapOp final
         : public IAggregateFunctionDataHelper<AggregateFunctionBitmapData<Op>,
@@ -90,6 +137,8 @@ public:
     using ResultDataType = BitmapValue;
     using ColVecType = ColumnBitmap;
     using ColVecResult = ColumnBitmap;
+    using Base = IAggregateFunctionDataHelper<AggregateFunctionBitmapData<Op>,
+                                              AggregateFunctionBitmapOp<Op>>;
 
     String get_name() const override { return Op::name; }
 
@@ -105,6 +154,27 @@ public:
         this->data(place).add(column.get_data()[row_num]);
     }
 
+    void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                   const IColumn** columns, Arena* arena) const override {
+        if constexpr (std::is_same_v<Op, AggregateFunctionBitmapUnionOp>) {
+            AggregateFunctionBitmapBatchUnion::add_batch(
+                    batch_size, places, place_offset,
+                    static_cast<const ColVecType&>(*columns[0]), nullptr);
+        } else {
+            Base::add_batch(batch_size, places, place_offset, columns, arena);
+        }
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if constexpr (std::is_same_v<Op, AggregateFunctionBitmapUnionOp>) {
+            AggregateFunctionBitmapBatchUnion::add_batch_single_place(
+                    batch_size, place, static_cast<const ColVecType&>(*columns[0]), nullptr);
+        } else {
+            Base::add_batch_single_place(batch_size, place, columns, arena);
+        }
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                Arena*) const override {
         this->data(place).merge(
@@ -120,6 +190,15 @@ public:
         this->data(place).read(buf);
     }
 
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict rhs,
+                               BufferReadable& buf, Arena* arena) const override {
+        if constexpr (std::is_same_v<Op, AggregateFunctionBitmapUnionOp>) {
+            this->data(place).read_and_merge(buf);
+        } else {
+            Base::deserialize_and_merge(place, rhs, buf, arena);
+        }
+    }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         auto& column = static_cast<ColVecResult&>(to);
         column.get_data().push_back(
@@ -136,6 +215,8 @@ public:
     // using ColVecType = ColumnBitmap;
     using ColVecResult = ColumnVector<Int64>;
     using AggFunctionData = AggregateFunctionBitmapData<AggregateFunctionBitmapUnionOp>;
+    using Base = IAggregateFunctionDataHelper<AggFunctionData,
+                                              AggregateFunctionBitmapCount<nullable, ColVecType>>;
 
     AggregateFunctionBitmapCount(const DataTypes& argument_types_)
             : IAggregateFunctionDataHelper<
@@ -160,6 +241,41 @@ public:
         }
     }
 
+    void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                   const IColumn** columns, Arena* arena) const override {
+        if constexpr (std::is_same_v<ColVecType, ColumnBitmap>) {
+            const NullMap* null_map = nullptr;
+            const IColumn* column = columns[0];
+            if constexpr (nullable) {
+                const auto& nullable_column = assert_cast<const ColumnNullable&>(*columns[0]);
+                null_map = &nullable_column.get_null_map_data();
+                column = &nullable_column.get_nested_column();
+            }
+            AggregateFunctionBitmapBatchUnion::add_batch(
+                    batch_size, places, place_offset, static_cast<const ColVecType&>(*column),
+                    null_map);
+        } else {
+            Base::add_batch(batch_size, places, place_offset, columns, arena);
+        }
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if constexpr (std::is_same_v<ColVecType, ColumnBitmap>) {
+            const NullMap* null_map = nullptr;
+            const IColumn* column = columns[0];
+            if constexpr (nullable) {
+                const auto& nullable_column = assert_cast<const ColumnNullable&>(*columns[0]);
+                null_map = &nullable_column.get_null_map_data();
+                column = &nullable_column.get_nested_column();
+            }
+            AggregateFunctionBitmapBatchUnion::add_batch_single_place(
+                    batch_size, place, static_cast<const ColVecType&>(*column), null_map);
+        } else {
+            Base::add_batch_single_place(batch_size, place, columns, arena);
+        }
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                Arena*) const override {
         this->data(place).merge(const_cast<AggFunctionData&>(this->data(rhs)).get());
@@ -174,6 +290,11 @@ public:
         this->data(place).read(buf);
     }
 
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict rhs,
+                               BufferReadable& buf, Arena* arena) const override {
+        this->data(place).read_and_merge(buf);
+    }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         auto& value_data = const_cast<AggFunctionData&>(this->data(place)).get();
         auto& column = static_cast<ColVecResult&>(to);
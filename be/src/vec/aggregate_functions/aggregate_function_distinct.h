@@ -21,12 +21,14 @@
 #pragma once
 
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/aggregate_function_distinct_shared.h"
 #include "vec/aggregate_functions/key_holder_helpers.h"
 #include "vec/common/aggregation_common.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/field_visitors.h"
 #include "vec/common/hash_table/hash_set.h"
 #include "vec/common/hash_table/hash_table.h"
+#include "vec/common/hash_table/small_set.h"
 #include "vec/common/sip_hash.h"
 #include "vec/io/io_helper.h"
 
@@ -34,8 +36,12 @@ namespace doris::vectorized {
 
 template <typename T>
 struct AggregateFunctionDistinctSingleNumericData {
+    using Key = T;
+    static constexpr bool is_single_numeric = true;
+
     /// When creating, the hash table must be small.
-    using Set = HashSetWithStackMemory<T, DefaultHash<T>, 4>;
+    using Set = SmallSetWithFallback<T, HashSetWithStackMemory<T, DefaultHash<T>, 4>,
+                                     std::clamp<size_t>(64 / sizeof(T), 1, 8)>;
     using Self = AggregateFunctionDistinctSingleNumericData<T>;
     Set set;
 
@@ -53,9 +59,7 @@ struct AggregateFunctionDistinctSingleNumericData {
     MutableColumns get_arguments(const DataTypes& argument_types) const {
         MutableColumns argument_columns;
         argument_columns.emplace_back(argument_types[0]->create_column());
-        for (const auto& elem : set) {
-            argument_columns[0]->insert(elem.get_value());
-        }
+        set.for_each([&](const T& value) { argument_columns[0]->insert(value); });
 
         return argument_columns;
     }
@@ -65,6 +69,7 @@ struct AggregateFunctionDistinctGenericData {
     /// When creating, the hash table must be small.
     using Set = HashSetWithSavedHashWithStackMemory<StringRef, StringRefHash, 4>;
     using Self = AggregateFunctionDistinctGenericData;
+    static constexpr bool is_single_numeric = false;
     Set set;
 
     void merge(const Self& rhs, Arena* arena) {
@@ -229,6 +234,18 @@ public:
     DataTypePtr get_return_type() const override { return nested_func->get_return_type(); }
 
     bool allocates_memory_in_arena() const override { return true; }
+
+    AggregateFunctionPtr create_shared_distinct(const SharedDistinctKeysPtr& keys,
+                                                bool keep_keys) const override {
+        if constexpr (Data::is_single_numeric) {
+            using Key = typename Data::Key;
+            return std::make_shared<AggregateFunctionSharedDistinct<Key, Key>>(
+                    get_name(), nested_func, this->argument_types, this->parameters, keys,
+                    keep_keys);
+        } else {
+            return nullptr;
+        }
+    }
 };
 
 } // namespace doris::vectorized
@@ -0,0 +1,309 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_vector.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_set.h"
+#include "vec/common/sip_hash.h"
+#include "vec/common/uint128.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/io/io_helper.h"
+
+namespace doris::vectorized {
+
+/** The distinct keys of all the multi_distinct_* functions of an aggregation.
+  *
+  * Every state gets an id, and its keys are put into one hash set as (key, id), like the
+  * group by keys plus the distinct argument of a query with a single distinct function.
+  * The groups then share one hash table for all the distinct functions, instead of one
+  * hash set in every group for each function.
+  *
+  * The ids are never reused, so the keys of a destroyed state are never found again but
+  * take memory until the aggregation is closed. Only the aggregations whose states live
+  * until the end share the keys.
+  */
+class SharedDistinctKeys {
+public:
+    UInt64 next_state_id() { return ++_last_state_id; }
+
+    /// Returns true if the key is not in the state yet.
+    bool insert(UInt64 state_id, const UInt128& key) {
+        Set::LookupResult it;
+        bool inserted;
+        _keys.emplace(UInt256 {key.low, key.high, state_id, 0}, it, inserted);
+        return inserted;
+    }
+
+    Arena* arena() { return &_arena; }
+
+    size_t size() const { return _keys.size(); }
+
+    size_t allocated_bytes() const { return _keys.get_buffer_size_in_bytes() + _arena.size(); }
+
+private:
+    using Set = HashSet<UInt256, HashCRC32<UInt256>>;
+
+    Set _keys;
+    /// the keys of the states in the order of insertion, see SharedDistinctData
+    Arena _arena;
+    UInt64 _last_state_id = 0;
+};
+
+using SharedDistinctKeysPtr = std::shared_ptr<SharedDistinctKeys>;
+
+template <typename Key>
+struct SharedDistinctData {
+    struct Node {
+        Key key;
+        Node* next;
+    };
+
+    UInt64 id = 0;
+    size_t size = 0;
+    /// the keys of the state, only kept if the state is serialized
+    Node* head = nullptr;
+};
+
+/** The multi_distinct_* function with the keys in SharedDistinctKeys.
+  *
+  * T is the type of the argument and Key is the key of the hash set of the function not
+  * shared. The keys are serialized the same as that hash set, so the states are compatible
+  * with the ones of the function not shared. Without a nested function the result is the
+  * number of keys, otherwise every new key is added into the nested function once.
+  */
+template <typename T, typename Key>
+class AggregateFunctionSharedDistinct final
+        : public IAggregateFunctionHelper<AggregateFunctionSharedDistinct<T, Key>> {
+private:
+    using Data = SharedDistinctData<Key>;
+    using Node = typename Data::Node;
+
+    static_assert(sizeof(Key) <= sizeof(UInt128));
+
+    String _name;
+    AggregateFunctionPtr _nested_function;
+    SharedDistinctKeysPtr _keys;
+    bool _keep_keys;
+    size_t _prefix_size;
+
+    static Data& data(AggregateDataPtr __restrict place) { return *reinterpret_cast<Data*>(place); }
+    static const Data& data(ConstAggregateDataPtr __restrict place) {
+        return *reinterpret_cast<const Data*>(place);
+    }
+
+    AggregateDataPtr nested_place(AggregateDataPtr __restrict place) const noexcept {
+        return place + _prefix_size;
+    }
+
+    ConstAggregateDataPtr nested_place(ConstAggregateDataPtr __restrict place) const noexcept {
+        return place + _prefix_size;
+    }
+
+    static Key get_key(const IColumn& column, size_t row_num) {
+        if constexpr (std::is_same_v<T, String>) {
+            StringRef value = column.get_data_at(row_num);
+
+            UInt128 key;
+            SipHash hash;
+            hash.update(value.data, value.size);
+            hash.get128(key.low, key.high);
+            return key;
+        } else if constexpr (std::is_same_v<T, Decimal128>) {
+            return assert_cast<const ColumnDecimal<Decimal128>&>(column).get_data()[row_num];
+        } else {
+            return assert_cast<const ColumnVector<T>&>(column).get_data()[row_num];
+        }
+    }
+
+    bool insert(AggregateDataPtr __restrict place, Key key) const {
+        if constexpr (std::is_floating_point_v<Key>) {
+            // -0.0 is equal to 0.0 in the hash set of the function not shared
+            if (key == 0) {
+                key = 0;
+            }
+        }
+        UInt128 value(0, 0);
+        memcpy(&value, &key, sizeof(Key));
+
+        auto& state = data(place);
+        if (!_keys->insert(state.id, value)) {
+            return false;
+        }
+        ++state.size;
+        if (_keep_keys) {
+            auto* node = _keys->arena()->alloc<Node>();
+            node->key = key;
+            node->next = state.head;
+            state.head = node;
+        }
+        return true;
+    }
+
+    /// Inserts the `size` keys returned by `next_key`, the new ones are added into the nested
+    /// function in one batch.
+    template <typename NextKey>
+    void insert_keys(AggregateDataPtr __restrict place, size_t size, NextKey&& next_key,
+                     Arena* arena) const {
+        if constexpr (std::is_same_v<T, Key>) {
+            if (_nested_function != nullptr) {
+                auto new_keys = ColumnVector<T>::create();
+                for (size_t i = 0; i < size; ++i) {
+                    Key key = next_key();
+                    if (insert(place, key)) {
+                        new_keys->get_data().push_back(key);
+                    }
+                }
+                const IColumn* column = new_keys.get();
+                _nested_function->add_batch_single_place(new_keys->size(), nested_place(place),
+                                                         &column, arena);
+                return;
+            }
+        }
+        for (size_t i = 0; i < size; ++i) {
+            insert(place, next_key());
+        }
+    }
+
+    void read_keys(AggregateDataPtr __restrict place, BufferReadable& buf, Arena* arena) const {
+        size_t size = 0;
+        read_var_uint(size, buf);
+        insert_keys(
+                place, size,
+                [&buf]() {
+                    Key key;
+                    read_binary(key, buf);
+                    return key;
+                },
+                arena);
+    }
+
+public:
+    AggregateFunctionSharedDistinct(String name, AggregateFunctionPtr nested_function,
+                                    const DataTypes& arguments, const Array& params,
+                                    SharedDistinctKeysPtr keys, bool keep_keys)
+            : IAggregateFunctionHelper<AggregateFunctionSharedDistinct<T, Key>>(arguments,
+                                                                                params),
+              _name(std::move(name)),
+              _nested_function(std::move(nested_function)),
+              _keys(std::move(keys)),
+              _keep_keys(keep_keys) {
+        DCHECK(_nested_function == nullptr || (std::is_same_v<T, Key>));
+        size_t alignment = align_of_data();
+        _prefix_size = (sizeof(Data) + alignment - 1) / alignment * alignment;
+    }
+
+    String get_name() const override { return _name; }
+
+    DataTypePtr get_return_type() const override {
+        return _nested_function != nullptr ? _nested_function->get_return_type()
+                                           : std::make_shared<DataTypeInt64>();
+    }
+
+    void create(AggregateDataPtr __restrict place) const override {
+        new (place) Data;
+        data(place).id = _keys->next_state_id();
+        if (_nested_function != nullptr) {
+            _nested_function->create(nested_place(place));
+        }
+    }
+
+    void destroy(AggregateDataPtr __restrict place) const noexcept override {
+        data(place).~Data();
+        if (_nested_function != nullptr) {
+            _nested_function->destroy(nested_place(place));
+        }
+    }
+
+    void reset(AggregateDataPtr place) const override {
+        destroy(place);
+        create(place);
+    }
+
+    bool has_trivial_destructor() const override {
+        return _nested_function == nullptr || _nested_function->has_trivial_destructor();
+    }
+
+    size_t size_of_data() const override {
+        return _prefix_size + (_nested_function != nullptr ? _nested_function->size_of_data() : 0);
+    }
+
+    size_t align_of_data() const override {
+        return _nested_function != nullptr
+                       ? std::max(alignof(Data), _nested_function->align_of_data())
+                       : alignof(Data);
+    }
+
+    void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+             Arena* arena) const override {
+        if (insert(place, get_key(*columns[0], row_num)) && _nested_function != nullptr) {
+            _nested_function->add(nested_place(place), columns, row_num, arena);
+        }
+    }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
+               Arena* arena) const override {
+        DCHECK(_keep_keys);
+        const Node* node = data(rhs).head;
+        insert_keys(
+                place, data(rhs).size,
+                [&node]() {
+                    Key key = node->key;
+                    node = node->next;
+                    return key;
+                },
+                arena);
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        DCHECK(_keep_keys);
+        write_var_uint(data(place).size, buf);
+        for (const Node* node = data(place).head; node != nullptr; node = node->next) {
+            write_binary(node->key, buf);
+        }
+    }
+
+    void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
+                     Arena* arena) const override {
+        read_keys(place, buf, arena);
+    }
+
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict rhs,
+                               BufferReadable& buf, Arena* arena) const override {
+        read_keys(place, buf, arena);
+    }
+
+    void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
+        if (_nested_function != nullptr) {
+            _nested_function->insert_result_into(nested_place(place), to);
+        } else {
+            assert_cast<ColumnInt64&>(to).get_data().push_back(data(place).size);
+        }
+    }
+};
+
+} // namespace doris::vectorized
@@ -20,30 +20,48 @@
 #include "common/status.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/common/arena.h"
 #include "vec/common/string_ref.h"
 #include "vec/data_types/data_type_string.h"
 #include "vec/io/io_helper.h"
 
 namespace doris::vectorized {
 
+// The concatenated string is kept as a list of chunks allocated from the arena of the
+// aggregation, so the bytes already appended are never copied again while the group grows,
+// and they are concatenated only once into the result column.
 struct AggregateFunctionGroupConcatData {
-    std::string data;
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+        size_t capacity;
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+        const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    static constexpr size_t MIN_CHUNK_SIZE = 64;
+    static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024;
+
+    Chunk* head = nullptr;
+    Chunk* tail = nullptr;
+    size_t size = 0;
     std::string separator;
     bool inited = false;
+    // the window functions pass no arena, the chunks are allocated from this one then
+    std::unique_ptr<Arena> own_arena;
 
-    void add(StringRef ref, StringRef sep) {
+    void add(StringRef ref, StringRef sep, Arena* arena) {
         if (!inited) {
             inited = true;
             separator.assign(sep.data, sep.data + sep.size);
         } else {
-            data += separator;
+            append(separator.data(), separator.size(), arena);
         }
-
-        data.resize(data.length() + ref.size);
-        memcpy(data.data() + data.length() - ref.size, ref.data, ref.size);
+        append(ref.data, ref.size, arena);
     }
 
-    void merge(const AggregateFunctionGroupConcatData& rhs) {
+    void merge(const AggregateFunctionGroupConcatData& rhs, Arena* arena) {
         if (!rhs.inited) {
             return;
         }
@@ -51,48 +69,128 @@ struct AggregateFunctionGroupConcatData {
         if (!inited) {
             inited = true;
             separator = rhs.separator;
-            data = rhs.data;
         } else {
-            data += separator;
-            data += rhs.data;
+            append(separator.data(), separator.size(), arena);
+        }
+        for (const Chunk* chunk = rhs.head; chunk != nullptr; chunk = chunk->next) {
+            append(chunk->data(), chunk->size, arena);
+        }
+    }
+
+    // Merges the serialized state without materializing it first.
+    void read_and_merge(BufferReadable& buf, Arena* arena) {
+        StringRef data;
+        StringRef sep;
+        bool rhs_inited = false;
+        read_binary(data, buf);
+        read_binary(sep, buf);
+        read_binary(rhs_inited, buf);
+        if (!rhs_inited) {
+            return;
+        }
+
+        if (!inited) {
+            inited = true;
+            separator.assign(sep.data, sep.data + sep.size);
+        } else {
+            append(separator.data(), separator.size(), arena);
+        }
+        append(data.data, data.size, arena);
+    }
+
+    void append(const char* data, size_t length, Arena* arena) {
+        while (length > 0) {
+            if (tail == nullptr || tail->size == tail->capacity) {
+                add_chunk(length, arena);
+            }
+            size_t n = std::min(length, tail->capacity - tail->size);
+            memcpy(tail->data() + tail->size, data, n);
+            tail->size += n;
+            size += n;
+            data += n;
+            length -= n;
         }
     }
 
-    std::string get() const { return data; }
+    void add_chunk(size_t min_capacity, Arena* arena) {
+        if (arena == nullptr) {
+            if (own_arena == nullptr) {
+                own_arena = std::make_unique<Arena>();
+            }
+            arena = own_arena.get();
+        }
+        // grows geometrically up to MAX_CHUNK_SIZE, a larger value gets a chunk of its own size
+        size_t capacity =
+                tail == nullptr ? MIN_CHUNK_SIZE : std::min(tail->capacity * 2, MAX_CHUNK_SIZE);
+        capacity = std::max(capacity, min_capacity);
+        auto* chunk = reinterpret_cast<Chunk*>(
+                arena->aligned_alloc(sizeof(Chunk) + capacity, alignof(Chunk)));
+        chunk->next = nullptr;
+        chunk->size = 0;
+        chunk->capacity = capacity;
+        if (tail == nullptr) {
+            head = chunk;
+        } else {
+            tail->next = chunk;
+        }
+        tail = chunk;
+    }
+
+    void insert_result_into(ColumnString& to) const {
+        auto& chars = to.get_chars();
+        const size_t old_size = chars.size();
+        chars.resize(old_size + size + 1);
+        char* pos = reinterpret_cast<char*>(chars.data() + old_size);
+        for (const Chunk* chunk = head; chunk != nullptr; chunk = chunk->next) {
+            memcpy(pos, chunk->data(), chunk->size);
+            pos += chunk->size;
+        }
+        *pos = 0;
+        to.get_offsets().push_back(chars.size());
+    }
 
     void write(BufferWritable& buf) const {
-        write_binary(data, buf);
+        write_var_uint(size, buf);
+        for (const Chunk* chunk = head; chunk != nullptr; chunk = chunk->next) {
+            buf.write(chunk->data(), chunk->size);
+        }
         write_binary(separator, buf);
         write_binary(inited, buf);
     }
 
-    void read(BufferReadable& buf) {
+    void read(BufferReadable& buf, Arena* arena) {
+        StringRef data;
         read_binary(data, buf);
+        append(data.data, data.size, arena);
         read_binary(separator, buf);
         read_binary(inited, buf);
     }
 
     void reset() {
-        data = "";
+        // the chunks allocated from the arena of the aggregation are released with it
+        head = nullptr;
+        tail = nullptr;
+        size = 0;
         separator = "";
         inited = false;
+        own_arena.reset();
     }
 };
 
 struct AggregateFunctionGroupConcatImplStr {
     static const std::string separator;
     static void add(AggregateFunctionGroupConcatData& __restrict place, const IColumn** columns,
-                    size_t row_num) {
+                    size_t row_num, Arena* arena) {
         place.add(static_cast<const ColumnString&>(*columns[0]).get_data_at(row_num),
-                  StringRef(separator.data(), separator.length()));
+                  StringRef(separator.data(), separator.length()), arena);
     }
 };
 
 struct AggregateFunctionGroupConcatImplStrStr {
     static void add(AggregateFunctionGroupConcatData& __restrict place, const IColumn** columns,
-                    size_t row_num) {
+                    size_t row_num, Arena* arena) {
         place.add(static_cast<const ColumnString&>(*columns[0]).get_data_at(row_num),
-                  static_cast<const ColumnString&>(*columns[1]).get_data_at(row_num));
+                  static_cast<const ColumnString&>(*columns[1]).get_data_at(row_num), arena);
     }
 };
 
@@ -111,15 +209,15 @@ public:
     DataTypePtr get_return_type() const override { return std::make_shared<DataTypeString>(); }
 
     void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
-             Arena*) const override {
-        Impl::add(this->data(place), columns, row_num);
+             Arena* arena) const override {
+        Impl::add(this->data(place), columns, row_num, arena);
     }
 
     void reset(AggregateDataPtr place) const override { this->data(place).reset(); }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
-               Arena*) const override {
-        this->data(place).merge(this->data(rhs));
+               Arena* arena) const override {
+        this->data(place).merge(this->data(rhs), arena);
     }
 
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
@@ -127,13 +225,19 @@ public:
     }
 
     void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
-                     Arena*) const override {
-        this->data(place).read(buf);
+                     Arena* arena) const override {
+        this->data(place).read(buf, arena);
     }
 
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict,
+                               BufferReadable& buf, Arena* arena) const override {
+        this->data(place).read_and_merge(buf, arena);
+    }
+
+    bool allocates_memory_in_arena() const override { return true; }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
-        std::string result = this->data(place).get();
-        static_cast<ColumnString&>(to).insert_data(result.c_str(), result.length());
+        this->data(place).insert_result_into(static_cast<ColumnString&>(to));
     }
 };
 
@@ -49,6 +49,13 @@ struct AggregateFunctionHLLData {
         dst_hll.deserialize(Slice(ref.data, ref.size));
     }
 
+    // Merges the serialized registers into dst_hll without an HyperLogLog built for them.
+    void read_and_merge(BufferReadable& buf) {
+        StringRef ref;
+        read_binary(ref, buf);
+        dst_hll.merge_serialized(Slice(ref.data, ref.size));
+    }
+
     Int64 get_cardinality() const { return dst_hll.estimate_cardinality(); }
 
     HyperLogLog get() const { return dst_hll; }
@@ -129,6 +136,11 @@ public:
         this->data(place).read(buf);
     }
 
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict rhs,
+                               BufferReadable& buf, Arena*) const override {
+        this->data(place).read_and_merge(buf);
+    }
+
     void reset(AggregateDataPtr __restrict place) const override { this->data(place).reset(); }
 };
 
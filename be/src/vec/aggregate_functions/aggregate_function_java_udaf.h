@@ -301,15 +301,26 @@ public:
 
     DataTypePtr get_return_type() const override { return _return_type; }
 
-    // TODO: here calling add operator maybe only hava done one row, this performance may be poorly
-    // so it's possible to maintain a hashtable in FE, the key is place address, value is the object
-    // then we can calling add_bacth function and calculate the whole batch at once,
-    // and avoid calling jni multiple times.
     void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
              Arena*) const override {
         this->data(place).add(columns, row_num, row_num + 1, argument_types);
     }
 
+    // Every place has its own java executor, so the consecutive rows of the same place are
+    // added by one jni call, instead of calling into java for every row.
+    void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
+                   const IColumn** columns, Arena*) const override {
+        size_t start = 0;
+        while (start < batch_size) {
+            size_t end = start + 1;
+            while (end < batch_size && places[end] == places[start]) {
+                ++end;
+            }
+            this->data(places[start] + place_offset).add(columns, start, end, argument_types);
+            start = end;
+        }
+    }
+
     // TODO: Here we calling method by jni, And if we get a thrown from FE,
     // But can't let user known the error, only return directly and output error to log file.
     void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
@@ -317,6 +328,21 @@ public:
         this->data(place).add(columns, 0, batch_size, argument_types);
     }
 
+    void add_batch_range(size_t batch_begin, size_t batch_end, AggregateDataPtr place,
+                         const IColumn** columns, Arena*, bool has_null) override {
+        this->data(place).add(columns, batch_begin, batch_end + 1, argument_types);
+    }
+
+    void add_range_single_place(int64_t partition_start, int64_t partition_end, int64_t frame_start,
+                                int64_t frame_end, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        frame_start = std::max<int64_t>(frame_start, partition_start);
+        frame_end = std::min<int64_t>(frame_end, partition_end);
+        if (frame_start < frame_end) {
+            this->data(place).add(columns, frame_start, frame_end, argument_types);
+        }
+    }
+
     void reset(AggregateDataPtr place) const override {}
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
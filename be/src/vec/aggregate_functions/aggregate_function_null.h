@@ -151,6 +151,19 @@ public:
         }
     }
 
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict rhs,
+                               BufferReadable& buf, Arena* arena) const override {
+        bool flag = true;
+        if (result_is_nullable) {
+            read_binary(flag, buf);
+        }
+        if (flag) {
+            set_flag(place);
+            nested_function->deserialize_and_merge(nested_place(place), nested_place(rhs), buf,
+                                                   arena);
+        }
+    }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         if constexpr (result_is_nullable) {
             ColumnNullable& to_concrete = assert_cast<ColumnNullable&>(to);
@@ -235,6 +248,16 @@ public:
                     batch_begin, batch_end, this->nested_place(place), &nested_column, arena);
         }
     }
+
+    AggregateFunctionPtr create_shared_distinct(const std::shared_ptr<SharedDistinctKeys>& keys,
+                                                bool keep_keys) const override {
+        auto nested_function = this->nested_function->create_shared_distinct(keys, keep_keys);
+        if (nested_function == nullptr) {
+            return nullptr;
+        }
+        return std::make_shared<AggregateFunctionNullUnary>(nested_function, this->argument_types,
+                                                            this->parameters);
+    }
 };
 
 template <bool result_is_nullable>
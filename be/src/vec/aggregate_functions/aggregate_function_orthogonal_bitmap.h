@@ -50,6 +50,24 @@ public:
         }
     }
 
+    void add_batch(const IColumn** columns, size_t batch_size) {
+        const auto& bitmap_col = static_cast<const ColumnBitmap&>(*columns[0]);
+        const auto& data_col = static_cast<const ColVecData&>(*columns[1]);
+        // the bitmaps of a key are unioned at once, there are only a few keys
+        std::map<T, std::vector<const BitmapValue*>> key_bitmaps;
+        for (size_t i = 0; i < batch_size; ++i) {
+            if constexpr (IsNumber<T>) {
+                key_bitmaps[data_col.get_element(i)].push_back(&bitmap_col.get_element(i));
+            } else {
+                key_bitmaps[StringValue(data_col.get_data_at(i))].push_back(
+                        &bitmap_col.get_element(i));
+            }
+        }
+        for (const auto& [key, bitmaps] : key_bitmaps) {
+            bitmap.update(key, bitmaps);
+        }
+    }
+
     void init_add_key(const IColumn** columns, size_t row_num, int argument_size) {
         if (first_init) {
             DCHECK(argument_size > 1);
@@ -185,6 +203,15 @@ struct OrthBitmapUnionCountData {
         const auto& column = static_cast<const ColumnBitmap&>(*columns[0]);
         value |= column.get_data()[row_num];
     }
+
+    void add_batch(const IColumn** columns, size_t batch_size) {
+        const auto& data = static_cast<const ColumnBitmap&>(*columns[0]).get_data();
+        std::vector<const BitmapValue*> bitmaps(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            bitmaps[i] = &data[i];
+        }
+        value.fastunion(bitmaps);
+    }
     void merge(const OrthBitmapUnionCountData& rhs) { result += rhs.result; }
 
     void write(BufferWritable& buf) {
@@ -223,6 +250,15 @@ public:
         this->data(place).add(columns, row_num);
     }
 
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if (batch_size == 0) {
+            return;
+        }
+        this->data(place).init_add_key(columns, 0, _argument_size);
+        this->data(place).add_batch(columns, batch_size);
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                Arena*) const override {
         this->data(place).merge(this->data(rhs));
@@ -108,6 +108,11 @@ struct PercentileApproxState {
         target_quantile = quantile;
     }
 
+    void add_batch(const double* sources, size_t count, double quantile) {
+        digest->add(sources, count);
+        target_quantile = quantile;
+    }
+
     void reset() {
         target_quantile = INIT_QUANTILE;
         init_flag = false;
@@ -218,6 +223,24 @@ public:
             this->data(place).add(sources.get_float64(row_num), quantile.get_float64(row_num));
         }
     }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if constexpr (is_nullable) {
+            AggregateFunctionPercentileApprox::add_batch_single_place(batch_size, place, columns,
+                                                                      arena);
+        } else {
+            if (batch_size == 0) {
+                return;
+            }
+            const auto& sources = static_cast<const ColumnVector<Float64>&>(*columns[0]);
+            const auto& quantile = static_cast<const ColumnVector<Float64>&>(*columns[1]);
+
+            this->data(place).init();
+            this->data(place).add_batch(sources.get_data().data(), batch_size,
+                                        quantile.get_float64(batch_size - 1));
+        }
+    }
 };
 
 template <bool is_nullable>
@@ -259,6 +282,25 @@ public:
             this->data(place).add(sources.get_float64(row_num), quantile.get_float64(row_num));
         }
     }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if constexpr (is_nullable) {
+            AggregateFunctionPercentileApprox::add_batch_single_place(batch_size, place, columns,
+                                                                      arena);
+        } else {
+            if (batch_size == 0) {
+                return;
+            }
+            const auto& sources = static_cast<const ColumnVector<Float64>&>(*columns[0]);
+            const auto& quantile = static_cast<const ColumnVector<Float64>&>(*columns[1]);
+            const auto& compression = static_cast<const ColumnVector<Float64>&>(*columns[2]);
+
+            this->data(place).init(compression.get_float64(0));
+            this->data(place).add_batch(sources.get_data().data(), batch_size,
+                                        quantile.get_float64(batch_size - 1));
+        }
+    }
 };
 
 struct PercentileState {
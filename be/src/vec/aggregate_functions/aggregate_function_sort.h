@@ -0,0 +1,186 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/arena.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/sort_description.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/io/io_helper.h"
+
+namespace doris::vectorized {
+
+// The arguments of all the rows added, the columns are always nullable so that the states
+// of the update and the merge phases have the same layout.
+struct AggregateFunctionSortData {
+    MutableColumns columns;
+
+    explicit AggregateFunctionSortData(const DataTypes& types) {
+        for (const auto& type : types) {
+            columns.push_back(type->create_column());
+        }
+    }
+
+    size_t rows() const { return columns[0]->size(); }
+
+    void add(const IColumn** src, size_t row_num) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (src[i]->is_nullable()) {
+                columns[i]->insert_from(*src[i], row_num);
+            } else {
+                assert_cast<ColumnNullable&>(*columns[i]).insert_from_not_nullable(*src[i],
+                                                                                  row_num);
+            }
+        }
+    }
+
+    void merge(const AggregateFunctionSortData& rhs) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            columns[i]->insert_range_from(*rhs.columns[i], 0, rhs.rows());
+        }
+    }
+
+    void write(const DataTypes& types, BufferWritable& buf) const {
+        std::string column_buf;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            column_buf.resize(types[i]->get_uncompressed_serialized_bytes(*columns[i]));
+            types[i]->serialize(*columns[i], column_buf.data());
+            write_binary(column_buf, buf);
+        }
+    }
+
+    void read(const DataTypes& types, BufferReadable& buf) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            StringRef column_buf;
+            read_binary(column_buf, buf);
+            types[i]->deserialize(column_buf.data, columns[i].get());
+        }
+    }
+
+    void reset() {
+        for (auto& column : columns) {
+            column = column->clone_empty();
+        }
+    }
+
+    // Returns the rows in the order of the sort keys, the rows with equal keys keep the
+    // order they were added in.
+    void sort(const SortDescription& sort_desc, IColumn::Permutation* perm) const {
+        perm->resize(rows());
+        std::iota(perm->begin(), perm->end(), 0);
+        std::stable_sort(perm->begin(), perm->end(), [&](size_t lhs, size_t rhs) {
+            for (const auto& desc : sort_desc) {
+                const auto& column = *columns[desc.column_number];
+                int res = desc.direction *
+                          column.compare_at(lhs, rhs, column, desc.nulls_direction);
+                if (res != 0) {
+                    return res < 0;
+                }
+            }
+            return false;
+        });
+    }
+};
+
+// Feeds the nested function with the rows sorted by the sort keys, e.g. for
+// group_concat(name ORDER BY id). The rows are buffered in the state and the nested function
+// only sees them at finalize. The arguments of the nested function come first, followed by
+// the sort keys.
+class AggregateFunctionSort final
+        : public IAggregateFunctionDataHelper<AggregateFunctionSortData, AggregateFunctionSort> {
+public:
+    AggregateFunctionSort(const AggregateFunctionPtr& nested_function,
+                          const DataTypes& argument_types_, const SortDescription& sort_desc)
+            : IAggregateFunctionDataHelper<AggregateFunctionSortData, AggregateFunctionSort>(
+                      argument_types_, {}),
+              _nested_function(nested_function),
+              _sort_desc(sort_desc) {}
+
+    // The last sort_desc.size() ones of argument_types are the sort keys, the nested function
+    // should be created with the nullable types of the others.
+    static AggregateFunctionPtr create(const AggregateFunctionPtr& nested_function,
+                                       const DataTypes& argument_types,
+                                       const SortDescription& sort_desc) {
+        if (nested_function == nullptr) {
+            return nullptr;
+        }
+        DataTypes types;
+        for (const auto& type : argument_types) {
+            types.push_back(make_nullable(type));
+        }
+        return std::make_shared<AggregateFunctionSort>(nested_function, types, sort_desc);
+    }
+
+    String get_name() const override { return _nested_function->get_name(); }
+
+    DataTypePtr get_return_type() const override { return _nested_function->get_return_type(); }
+
+    void create(AggregateDataPtr __restrict place) const override {
+        new (place) AggregateFunctionSortData(this->argument_types);
+    }
+
+    void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+             Arena*) const override {
+        this->data(place).add(columns, row_num);
+    }
+
+    void reset(AggregateDataPtr place) const override { this->data(place).reset(); }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
+               Arena*) const override {
+        this->data(place).merge(this->data(rhs));
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        this->data(place).write(this->argument_types, buf);
+    }
+
+    void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
+                     Arena*) const override {
+        this->data(place).read(this->argument_types, buf);
+    }
+
+    void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
+        const auto& data = this->data(place);
+        IColumn::Permutation perm;
+        data.sort(_sort_desc, &perm);
+
+        size_t num_args = this->argument_types.size() - _sort_desc.size();
+        std::vector<const IColumn*> columns(num_args);
+        for (size_t i = 0; i < num_args; ++i) {
+            columns[i] = data.columns[i].get();
+        }
+        AggregateFunctionGuard guard(_nested_function.get());
+        Arena arena;
+        for (auto row : perm) {
+            _nested_function->add(guard.data(), columns.data(), row, &arena);
+        }
+        _nested_function->insert_result_into(guard.data(), to);
+    }
+
+private:
+    AggregateFunctionPtr _nested_function;
+    SortDescription _sort_desc;
+};
+
+} // namespace doris::vectorized
@@ -24,11 +24,13 @@
 
 #include "gutil/hash/city.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/aggregate_function_distinct_shared.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/common/aggregation_common.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/bit_cast.h"
 #include "vec/common/hash_table/hash_set.h"
+#include "vec/common/hash_table/small_set.h"
 #include "vec/common/typeid_cast.h"
 #include "vec/data_types/data_type_number.h"
 
@@ -41,8 +43,11 @@ struct AggregateFunctionUniqExactData {
     using Key = T;
 
     /// When creating, the hash table must be small.
-    using Set = HashSet<Key, HashCRC32<Key>, HashTableGrower<4>,
-                        HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 4)>>;
+    using Set = SmallSetWithFallback<
+            Key,
+            HashSet<Key, HashCRC32<Key>, HashTableGrower<4>,
+                    HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 4)>>,
+            std::clamp<size_t>(64 / sizeof(Key), 1, 8)>;
 
     Set set;
 
@@ -55,8 +60,11 @@ struct AggregateFunctionUniqExactData<String> {
     using Key = UInt128;
 
     /// When creating, the hash table must be small.
-    using Set = HashSet<Key, UInt128TrivialHash, HashTableGrower<3>,
-                        HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 3)>>;
+    using Set = SmallSetWithFallback<
+            Key,
+            HashSet<Key, UInt128TrivialHash, HashTableGrower<3>,
+                    HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 3)>>,
+            4>;
 
     Set set;
 
@@ -123,9 +131,20 @@ public:
         this->data(place).set.read(buf);
     }
 
+    void deserialize_and_merge(AggregateDataPtr __restrict place, AggregateDataPtr __restrict rhs,
+                               BufferReadable& buf, Arena* arena) const override {
+        this->data(place).set.read_and_merge(buf);
+    }
+
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
         assert_cast<ColumnInt64&>(to).get_data().push_back(this->data(place).set.size());
     }
+
+    AggregateFunctionPtr create_shared_distinct(const SharedDistinctKeysPtr& keys,
+                                                bool keep_keys) const override {
+        return std::make_shared<AggregateFunctionSharedDistinct<T, typename Data::Key>>(
+                get_name(), nullptr, this->argument_types, this->parameters, keys, keep_keys);
+    }
 };
 
 } // namespace doris::vectorized
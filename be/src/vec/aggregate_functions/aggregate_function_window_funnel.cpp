@@ -28,6 +28,12 @@ AggregateFunctionPtr create_aggregate_function_window_funnel(const std::string&
                                                              const DataTypes& argument_types,
                                                              const Array& parameters,
                                                              const bool result_is_nullable) {
+    if (argument_types.size() > AggregateFunctionWindowFunnel::NON_EVENT_NUM +
+                                        WindowFunnelState::MAX_EVENT_LEVEL) {
+        LOG(WARNING) << fmt::format("Aggregate function {} supports at most {} events", name,
+                                    WindowFunnelState::MAX_EVENT_LEVEL);
+        return nullptr;
+    }
     return std::make_shared<AggregateFunctionWindowFunnel>(argument_types);
 }
 
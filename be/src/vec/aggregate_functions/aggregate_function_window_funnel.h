@@ -30,7 +30,12 @@
 namespace doris::vectorized {
 
 struct WindowFunnelState {
-    std::vector<std::pair<VecDateTimeValue, int>> events;
+    // The conditions matched by the rows of one timestamp are kept as a single event with a
+    // bitmask of the levels, so the state grows with the rows instead of rows * levels.
+    using LevelMask = uint64_t;
+    static constexpr int MAX_EVENT_LEVEL = sizeof(LevelMask) * 8;
+
+    std::vector<std::pair<VecDateTimeValue, LevelMask>> events;
     int max_event_level;
     bool sorted;
     int64_t window;
@@ -45,45 +50,52 @@ struct WindowFunnelState {
         sorted = true;
         max_event_level = 0;
         window = 0;
+        events.clear();
         events.shrink_to_fit();
     }
 
-    void add(const VecDateTimeValue& timestamp, int event_idx, int event_num, int64_t win) {
+    void add(const VecDateTimeValue& timestamp, LevelMask levels, int event_num, int64_t win) {
         window = win;
         max_event_level = event_num;
-        if (sorted && events.size() > 0) {
+        if (levels == 0) {
+            return;
+        }
+        if (sorted && !events.empty()) {
             if (events.back().first == timestamp) {
-                sorted = events.back().second <= event_idx;
-            } else {
-                sorted = events.back().first < timestamp;
+                events.back().second |= levels;
+                return;
             }
+            sorted = events.back().first < timestamp;
         }
-        events.emplace_back(timestamp, event_idx);
+        events.emplace_back(timestamp, levels);
     }
 
     void sort() {
         if (sorted) {
             return;
         }
-        std::stable_sort(events.begin(), events.end());
+        std::sort(events.begin(), events.end(),
+                  [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        _coalesce();
+        sorted = true;
     }
 
     int get() const {
-        std::vector<std::optional<VecDateTimeValue>> events_timestamp(max_event_level);
-        for (int64_t i = 0; i < events.size(); i++) {
-            const int& event_idx = events[i].second;
-            const VecDateTimeValue& timestamp = events[i].first;
-            if (event_idx == 0) {
-                events_timestamp[0] = timestamp;
-                continue;
-            }
-            if (events_timestamp[event_idx - 1].has_value()) {
-                const VecDateTimeValue& first_timestamp = events_timestamp[event_idx - 1].value();
-                VecDateTimeValue last_timestamp = first_timestamp;
-                TimeInterval interval(SECOND, window, false);
-                last_timestamp.date_add_interval(interval, SECOND);
-
-                if (timestamp <= last_timestamp) {
+        DCHECK(sorted);
+        // the first timestamp of the chains reaching each level, in seconds, -1 if none
+        std::vector<int64_t> events_timestamp(max_event_level, -1);
+        for (const auto& [timestamp, levels] : events) {
+            const int64_t seconds = _to_seconds(timestamp);
+            // the levels of one timestamp are handled in ascending order, as if the
+            // conditions were separate events sorted by level
+            for (LevelMask mask = levels; mask != 0; mask &= mask - 1) {
+                const int event_idx = __builtin_ctzll(mask);
+                if (event_idx == 0) {
+                    events_timestamp[0] = seconds;
+                    continue;
+                }
+                const int64_t first_timestamp = events_timestamp[event_idx - 1];
+                if (first_timestamp >= 0 && seconds - first_timestamp <= window) {
                     events_timestamp[event_idx] = first_timestamp;
                     if (event_idx + 1 == max_event_level) {
                         // Usually, max event level is small.
@@ -94,7 +106,7 @@ struct WindowFunnelState {
         }
 
         for (int64_t i = events_timestamp.size() - 1; i >= 0; i--) {
-            if (events_timestamp[i].has_value()) {
+            if (events_timestamp[i] >= 0) {
                 return i + 1;
             }
         }
@@ -107,36 +119,44 @@ struct WindowFunnelState {
             return;
         }
 
+        // the serialized states are sorted, so the merge phase only merges two sorted runs
+        sort();
         int64_t orig_size = events.size();
         events.insert(std::end(events), std::begin(other.events), std::end(other.events));
         const auto begin = std::begin(events);
         const auto middle = std::next(events.begin(), orig_size);
         const auto end = std::end(events);
+        auto less = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
         if (!other.sorted) {
-            std::stable_sort(middle, end);
-        }
-
-        if (!sorted) {
-            std::stable_sort(begin, middle);
+            std::sort(middle, end, less);
         }
-        std::inplace_merge(begin, middle, end);
+        std::inplace_merge(begin, middle, end, less);
+        _coalesce();
         max_event_level = max_event_level > 0 ? max_event_level : other.max_event_level;
         window = window > 0 ? window : other.window;
 
         sorted = true;
     }
 
+    // Keeps the (timestamp, level) pairs of the original format, in sorted order, so BEs of
+    // different versions can still exchange the states.
     void write(BufferWritable& out) const {
+        DCHECK(sorted);
+        int64_t size = 0;
+        for (const auto& event : events) {
+            size += __builtin_popcountll(event.second);
+        }
         write_var_int(max_event_level, out);
         write_var_int(window, out);
-        write_var_int(events.size(), out);
+        write_var_int(size, out);
 
-        for (int64_t i = 0; i < events.size(); i++) {
+        for (const auto& [time_value, levels] : events) {
             int64_t timestamp =
-                    binary_cast<vectorized::VecDateTimeValue, vectorized::Int64>(events[i].first);
-            int event_idx = events[i].second;
-            write_var_int(timestamp, out);
-            write_var_int(event_idx, out);
+                    binary_cast<vectorized::VecDateTimeValue, vectorized::Int64>(time_value);
+            for (LevelMask mask = levels; mask != 0; mask &= mask - 1) {
+                write_var_int(timestamp, out);
+                write_var_int(__builtin_ctzll(mask), out);
+            }
         }
     }
 
@@ -147,6 +167,7 @@ struct WindowFunnelState {
         read_var_int(window, in);
         int64_t size = 0;
         read_var_int(size, in);
+        events.reserve(events.size() + size);
         for (int64_t i = 0; i < size; i++) {
             int64_t timestamp;
             int64_t event_idx;
@@ -155,9 +176,31 @@ struct WindowFunnelState {
             read_var_int(event_idx, in);
             VecDateTimeValue time_value =
                     binary_cast<vectorized::Int64, vectorized::VecDateTimeValue>(timestamp);
-            add(time_value, (int)event_idx, max_event_level, window);
+            add(time_value, LevelMask(1) << event_idx, max_event_level, window);
         }
     }
+
+private:
+    static int64_t _to_seconds(const VecDateTimeValue& timestamp) {
+        return timestamp.daynr() * 24 * 3600 + timestamp.hour() * 3600 + timestamp.minute() * 60 +
+               timestamp.second();
+    }
+
+    // merges the adjacent events of the same timestamp, the events must be sorted
+    void _coalesce() {
+        if (events.empty()) {
+            return;
+        }
+        size_t last = 0;
+        for (size_t i = 1; i < events.size(); ++i) {
+            if (events[i].first == events[last].first) {
+                events[last].second |= events[i].second;
+            } else {
+                events[++last] = events[i];
+            }
+        }
+        events.resize(last + 1);
+    }
 };
 
 class AggregateFunctionWindowFunnel
@@ -167,6 +210,9 @@ public:
             : IAggregateFunctionDataHelper<WindowFunnelState, AggregateFunctionWindowFunnel>(
                       argument_types_, {}) {}
 
+    // window, mode and timestamp come before the event conditions
+    static constexpr int NON_EVENT_NUM = 3;
+
     String get_name() const override { return "window_funnel"; }
 
     DataTypePtr get_return_type() const override { return std::make_shared<DataTypeInt32>(); }
@@ -181,15 +227,14 @@ public:
         // be/src/olap/row_block2.cpp copy_data_to_column
         const auto& timestamp =
                 static_cast<const ColumnVector<VecDateTimeValue>&>(*columns[2]).get_data()[row_num];
-        const int NON_EVENT_NUM = 3;
+        WindowFunnelState::LevelMask levels = 0;
         for (int i = NON_EVENT_NUM; i < get_argument_types().size(); i++) {
             const auto& is_set =
                     static_cast<const ColumnVector<UInt8>&>(*columns[i]).get_data()[row_num];
-            if (is_set) {
-                this->data(place).add(timestamp, i - NON_EVENT_NUM,
-                                      get_argument_types().size() - NON_EVENT_NUM, window);
-            }
+            levels |= WindowFunnelState::LevelMask(is_set != 0) << (i - NON_EVENT_NUM);
         }
+        this->data(place).add(timestamp, levels, get_argument_types().size() - NON_EVENT_NUM,
+                              window);
     }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
@@ -198,6 +243,7 @@ public:
     }
 
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        this->data(const_cast<AggregateDataPtr>(place)).sort();
         this->data(place).write(buf);
     }
 
@@ -22,8 +22,10 @@
 
 #include <sstream>
 
+#include "runtime/raw_value.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
+#include "vec/common/sip_hash.h"
 #include "vec/core/field.h"
 
 namespace doris::vectorized {
@@ -46,6 +48,36 @@ void IColumn::insert_from(const IColumn& src, size_t n) {
     insert(src[n]);
 }
 
+void IColumn::update_hashes_with_value(std::vector<SipHash>& hashes,
+                                       const uint8_t* __restrict null_data) const {
+    DCHECK_EQ(hashes.size(), size());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        if (null_data && null_data[i]) {
+            hashes[i].update(0);
+        } else {
+            update_hash_with_value(i, hashes[i]);
+        }
+    }
+}
+
+void IColumn::update_crcs_with_value(std::vector<uint32_t>& hashes, const TypeDescriptor& type,
+                                     const uint8_t* __restrict null_data) const {
+    DCHECK_EQ(hashes.size(), size());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        if (null_data && null_data[i]) {
+            hashes[i] = null_crc(hashes[i]);
+        } else {
+            auto val = get_data_at(i);
+            hashes[i] = RawValue::zlib_crc32(val.data, val.size, type, hashes[i]);
+        }
+    }
+}
+
+uint32_t IColumn::null_crc(uint32_t hash) {
+    static const int32_t NULL_VALUE = 0;
+    return HashUtil::zlib_crc_hash(&NULL_VALUE, sizeof(NULL_VALUE), hash);
+}
+
 bool is_column_nullable(const IColumn& column) {
     return check_column<ColumnNullable>(column);
 }
@@ -30,6 +30,10 @@
 
 class SipHash;
 
+namespace doris {
+struct TypeDescriptor;
+}
+
 namespace doris::vectorized {
 
 class Arena;
@@ -71,6 +75,10 @@ public:
     /// If column is ColumnDictionary, and is a range comparison predicate, convert dict encoding
     virtual void convert_dict_codes_if_necessary() {}
 
+    /// If column isn't ColumnDictionary, return itself.
+    /// If column is ColumnDictionary, transforms it to string column of the values of the codes.
+    virtual Ptr convert_to_string_column_if_dictionary() const { return get_ptr(); }
+
     /// Creates empty column with the same type.
     virtual MutablePtr clone_empty() const { return clone_resized(0); }
 
@@ -248,6 +256,18 @@ public:
     ///  passed bytes to hash must identify sequence of values unambiguously.
     virtual void update_hash_with_value(size_t n, SipHash& hash) const = 0;
 
+    /// Update the i-th hash with the i-th value for all the values of the column, equal to
+    /// calling update_hash_with_value() row by row. The rows marked in null_data are hashed
+    /// as null like ColumnNullable does.
+    virtual void update_hashes_with_value(std::vector<SipHash>& hashes,
+                                          const uint8_t* __restrict null_data = nullptr) const;
+
+    /// Update the i-th hash with the crc32 of the i-th value as RawValue::zlib_crc32() does,
+    /// which is the hash of the bucket shuffle and the tablet distribution. The rows marked
+    /// in null_data are hashed as an int 0.
+    virtual void update_crcs_with_value(std::vector<uint32_t>& hashes, const TypeDescriptor& type,
+                                        const uint8_t* __restrict null_data = nullptr) const;
+
     /** Removes elements that don't match the filter.
       * Is used in WHERE and HAVING operations.
       * If result_size_hint > 0, then makes advance reserve(result_size_hint) for the result column;
@@ -257,6 +277,15 @@ public:
     using Filter = PaddedPODArray<UInt8>;
     virtual Ptr filter(const Filter& filt, ssize_t result_size_hint) const = 0;
 
+    /// The same as filter, but removes the elements from this column instead of copying the
+    /// matched ones into a new column, which saves allocating and writing a second column
+    /// when the column is not shared. The default implementation copies twice.
+    virtual void filter_inplace(const Filter& filt) {
+        auto filtered = filter(filt, -1);
+        clear();
+        insert_range_from(*filtered, 0, filtered->size());
+    }
+
     /**
      *  used by lazy materialization to filter column by selected rowids
      *  Q: Why use IColumn* as args type instead of MutablePtr or ImmutablePtr ?
@@ -489,6 +518,9 @@ protected:
     /// In derived classes (that use final keyword), implement scatter method as call to scatter_impl.
     template <typename Derived>
     std::vector<MutablePtr> scatter_impl(ColumnIndex num_columns, const Selector& selector) const;
+
+    /// The crc32 of a null value hashed by update_crcs_with_value().
+    static uint32_t null_crc(uint32_t hash);
 };
 
 using ColumnPtr = IColumn::Ptr;
@@ -236,9 +236,9 @@ public:
 
     void replicate(const uint32_t* counts, size_t target_size, IColumn& column) const override;
 
-    [[noreturn]] MutableColumns scatter(IColumn::ColumnIndex num_columns,
-                                        const IColumn::Selector& selector) const override {
-        LOG(FATAL) << "scatter not implemented";
+    MutableColumns scatter(IColumn::ColumnIndex num_columns,
+                           const IColumn::Selector& selector) const override {
+        return this->template scatter_impl<Self>(num_columns, selector);
     }
 
     void replace_column_data(const IColumn& rhs, size_t row, size_t self_row = 0) override {
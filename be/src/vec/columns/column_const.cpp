@@ -46,6 +46,14 @@ ColumnPtr ColumnConst::remove_low_cardinality() const {
     return ColumnConst::create(data->convert_to_full_column_if_low_cardinality(), s);
 }
 
+void ColumnConst::filter_inplace(const Filter& filt) {
+    if (s != filt.size()) {
+        LOG(FATAL) << fmt::format("Size of filter ({}) doesn't match size of column ({})",
+                                  filt.size(), s);
+    }
+    s = count_bytes_in_filter(filt);
+}
+
 ColumnPtr ColumnConst::filter(const Filter& filt, ssize_t /*result_size_hint*/) const {
     if (s != filt.size()) {
         LOG(FATAL) << fmt::format("Size of filter ({}) doesn't match size of column ({})",
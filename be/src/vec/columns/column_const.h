@@ -117,6 +117,7 @@ public:
     }
 
     ColumnPtr filter(const Filter& filt, ssize_t result_size_hint) const override;
+    void filter_inplace(const Filter& filt) override;
     ColumnPtr replicate(const Offsets& offsets) const override;
     void replicate(const uint32_t* counts, size_t target_size, IColumn& column) const override;
     ColumnPtr permute(const Permutation& perm, size_t limit) const override;
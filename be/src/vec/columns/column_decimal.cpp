@@ -20,6 +20,9 @@
 
 #include "vec/columns/column_decimal.h"
 
+#include "runtime/decimalv2_value.h"
+#include "runtime/types.h"
+#include "util/hash_util.hpp"
 #include "util/simd/bits.h"
 #include "vec/common/arena.h"
 #include "vec/common/assert_cast.h"
@@ -71,6 +74,47 @@ void ColumnDecimal<T>::update_hash_with_value(size_t n, SipHash& hash) const {
     hash.update(data[n]);
 }
 
+template <typename T>
+void ColumnDecimal<T>::update_hashes_with_value(std::vector<SipHash>& hashes,
+                                                const uint8_t* __restrict null_data) const {
+    DCHECK_EQ(hashes.size(), size());
+    if (null_data) {
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            if (null_data[i]) {
+                hashes[i].update(0);
+            } else {
+                hashes[i].update(data[i]);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            hashes[i].update(data[i]);
+        }
+    }
+}
+
+template <typename T>
+void ColumnDecimal<T>::update_crcs_with_value(std::vector<uint32_t>& hashes,
+                                              const TypeDescriptor& type,
+                                              const uint8_t* __restrict null_data) const {
+    if (type.type != TYPE_DECIMALV2) {
+        IColumn::update_crcs_with_value(hashes, type, null_data);
+        return;
+    }
+    DCHECK_EQ(hashes.size(), size());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        if (null_data && null_data[i]) {
+            hashes[i] = null_crc(hashes[i]);
+        } else {
+            DecimalV2Value value(static_cast<int128_t>(data[i].value));
+            int64_t int_val = value.int_value();
+            int32_t frac_val = value.frac_value();
+            uint32_t hash = HashUtil::zlib_crc_hash(&int_val, sizeof(int_val), hashes[i]);
+            hashes[i] = HashUtil::zlib_crc_hash(&frac_val, sizeof(frac_val), hash);
+        }
+    }
+}
+
 template <typename T>
 void ColumnDecimal<T>::get_permutation(bool reverse, size_t limit, int,
                                        IColumn::Permutation& res) const {
@@ -146,6 +190,24 @@ void ColumnDecimal<T>::insert_range_from(const IColumn& src, size_t start, size_
     memcpy(data.data() + old_size, &src_vec.data[start], length * sizeof(data[0]));
 }
 
+template <typename T>
+void ColumnDecimal<T>::filter_inplace(const IColumn::Filter& filt) {
+    size_t size = data.size();
+    if (size != filt.size()) {
+        LOG(FATAL) << "Size of filter doesn't match size of column.";
+    }
+
+    const UInt8* __restrict filt_pos = filt.data();
+    auto* __restrict data_pos = data.data();
+    size_t result_size = 0;
+    // branchless, each element is written to its position in the result
+    for (size_t i = 0; i < size; ++i) {
+        data_pos[result_size] = data_pos[i];
+        result_size += filt_pos[i] != 0;
+    }
+    data.resize(result_size);
+}
+
 template <typename T>
 ColumnPtr ColumnDecimal<T>::filter(const IColumn::Filter& filt, ssize_t result_size_hint) const {
     size_t size = data.size();
@@ -32,14 +32,15 @@ namespace doris::vectorized {
 /**
  * For low cardinality string columns, using ColumnDictionary can reduce memory
  * usage and improve query efficiency.
- * For equal predicate comparisons, convert the predicate constant to encodings
- * according to the dictionary, so that encoding comparisons are used instead
- * of string comparisons to improve performance.
- * For range comparison predicates, it is necessary to sort the dictionary
- * contents, convert the encoding column, and then compare the encoding directly.
+ * For predicates like comparisons, IN and LIKE, evaluate the predicate once for
+ * each value of the dictionary to get the flags of the encodings, so that the
+ * rows are filtered by looking up their encodings instead of string comparisons
+ * to improve performance.
  * If the read data page contains plain-encoded data pages, the dictionary
- * columns are converted into PredicateColumn for processing.
- * Currently ColumnDictionary is only used for storage layer.
+ * columns are converted into PredicateColumn for processing, the following
+ * blocks use dictionary columns again.
+ * Except the group by keys of the aggregations over the scan, see
+ * create_owned_column(), ColumnDictionary is only used for storage layer.
  */
 template <typename T>
 class ColumnDictionary final : public COWHelper<IColumn, ColumnDictionary<T>> {
@@ -102,7 +103,9 @@ public:
     // TODO: Make dict memory usage more precise
     size_t byte_size() const override { return _codes.size() * sizeof(_codes[0]); }
 
-    size_t allocated_bytes() const override { return byte_size(); }
+    size_t allocated_bytes() const override {
+        return byte_size() + (_owned_values ? _owned_values->allocated_bytes() : 0);
+    }
 
     void protect() override {}
 
@@ -225,6 +228,7 @@ public:
         if (!is_dict_sorted()) {
             _dict.sort();
             _dict_sorted = true;
+            _code_flags.clear();
         }
 
         if (!is_dict_code_converted()) {
@@ -252,10 +256,73 @@ public:
         return _dict.find_codes(values, selected);
     }
 
+    // Get the flags indexed by the codes, whether the value of each code satisfies `pred`.
+    // The flags are computed once for each `key`, i.e. the predicate, and cached until the
+    // dictionary changes.
+    template <typename Pred>
+    const std::vector<vectorized::UInt8>& find_codes_by_predicate(const void* key,
+                                                                   Pred&& pred) const {
+        auto& flags = _code_flags[key];
+        if (flags.size() != _dict.size()) {
+            _dict.find_codes_by_predicate(pred, flags);
+        }
+        return flags;
+    }
+
     bool is_dict_sorted() const { return _dict_sorted; }
 
     bool is_dict_code_converted() const { return _dict_code_converted; }
 
+    ColumnPtr convert_to_string_column_if_dictionary() const override {
+        auto res = vectorized::ColumnString::create();
+        res->reserve(_codes.size());
+        for (size_t i = 0; i < _codes.size(); ++i) {
+            const auto& value = _dict.get_value(_codes[i]);
+            res->insert_data(value.ptr, value.len);
+        }
+        return res;
+    }
+
+    // Create a dictionary column of the selected rows. Its dictionary only keeps the values
+    // of the selected rows and owns the memory of them, so the column can be passed out of
+    // the storage layer while the dictionary of the page is freed.
+    MutableColumnPtr create_owned_column(const uint16_t* sel, size_t sel_size) const {
+        auto res = ColumnDictionary::create(_type);
+        // code in this column -> code in the result column
+        std::vector<T> code_map(_dict.size(), -1);
+        std::vector<T> used_codes;
+        res->_codes.resize(sel_size);
+        for (size_t i = 0; i < sel_size; ++i) {
+            T code = _codes[sel[i]];
+            if (code >= 0) {
+                if (code_map[code] < 0) {
+                    code_map[code] = used_codes.size();
+                    used_codes.push_back(code);
+                }
+                code = code_map[code];
+            }
+            res->_codes[i] = code;
+        }
+
+        res->_owned_values = vectorized::ColumnString::create();
+        for (T code : used_codes) {
+            const auto& value = _dict.get_value(code);
+            res->_owned_values->insert_data(value.ptr, value.len);
+        }
+        // the values are not moved any more
+        res->_dict.reserve(used_codes.size());
+        for (size_t i = 0; i < used_codes.size(); ++i) {
+            auto ref = res->_owned_values->get_data_at(i);
+            StringValue value(const_cast<char*>(ref.data), ref.size);
+            res->_dict.insert_value(value);
+        }
+        return res;
+    }
+
+    size_t dict_size() const { return _dict.size(); }
+
+    const StringValue& get_value(T code) const { return _dict.get_value(code); }
+
     MutableColumnPtr convert_to_predicate_column_if_dictionary() override {
         auto res = vectorized::PredicateColumnType<StringValue>::create();
         res->reserve(_reserve_size);
@@ -266,6 +333,7 @@ public:
         }
         clear();
         _dict.clear();
+        _code_flags.clear();
         return res;
     }
 
@@ -297,6 +365,10 @@ public:
             return code >= _dict_data.size() ? _null_value : _dict_data[code];
         }
 
+        inline const StringValue& get_value(T code) const {
+            return code >= _dict_data.size() ? _null_value : _dict_data[code];
+        }
+
         // The function is only used in the runtime filter feature
         inline void generate_hash_values_for_runtime_filter(FieldType type) {
             if (_hash_values.empty()) {
@@ -351,6 +423,15 @@ public:
             return greater ? bound - greater + eq : bound - eq;
         }
 
+        template <typename Pred>
+        void find_codes_by_predicate(Pred&& pred, std::vector<vectorized::UInt8>& selected) const {
+            size_t dict_word_num = _dict_data.size();
+            selected.resize(dict_word_num);
+            for (size_t i = 0; i < dict_word_num; ++i) {
+                selected[i] = pred(_dict_data[i]);
+            }
+        }
+
         void find_codes(const phmap::flat_hash_set<StringValue>& values,
                         std::vector<vectorized::UInt8>& selected) const {
             size_t dict_word_num = _dict_data.size();
@@ -388,6 +469,8 @@ public:
 
         bool empty() { return _dict_data.empty(); }
 
+        size_t size() const { return _dict_data.size(); }
+
     private:
         StringValue _null_value = StringValue();
         StringValue::Comparator _comparator;
@@ -410,8 +493,12 @@ private:
     bool _dict_sorted = false;
     bool _dict_code_converted = false;
     Dictionary _dict;
+    // predicate -> whether the value of each code satisfies the predicate
+    mutable phmap::flat_hash_map<const void*, std::vector<vectorized::UInt8>> _code_flags;
     Container _codes;
     FieldType _type;
+    // the values of the dictionary, only for the columns created by create_owned_column()
+    vectorized::ColumnString::MutablePtr _owned_values;
 };
 
 template class ColumnDictionary<int32_t>;
@@ -89,6 +89,8 @@ public:
         return clone_dummy(count_bytes_in_filter(filt));
     }
 
+    void filter_inplace(const Filter& filt) override { s = count_bytes_in_filter(filt); }
+
     ColumnPtr permute(const Permutation& perm, size_t limit) const override {
         if (s != perm.size()) {
             LOG(FATAL) << "Size of permutation doesn't match size of column.";
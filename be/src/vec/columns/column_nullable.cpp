@@ -50,6 +50,25 @@ void ColumnNullable::update_hash_with_value(size_t n, SipHash& hash) const {
         get_nested_column().update_hash_with_value(n, hash);
 }
 
+void ColumnNullable::update_hashes_with_value(std::vector<SipHash>& hashes,
+                                              const uint8_t* __restrict null_data) const {
+    if (null_data != nullptr) {
+        IColumn::update_hashes_with_value(hashes, null_data);
+        return;
+    }
+    get_nested_column().update_hashes_with_value(hashes, get_null_map_data().data());
+}
+
+void ColumnNullable::update_crcs_with_value(std::vector<uint32_t>& hashes,
+                                            const TypeDescriptor& type,
+                                            const uint8_t* __restrict null_data) const {
+    if (null_data != nullptr) {
+        IColumn::update_crcs_with_value(hashes, type, null_data);
+        return;
+    }
+    get_nested_column().update_crcs_with_value(hashes, type, get_null_map_data().data());
+}
+
 MutableColumnPtr ColumnNullable::clone_resized(size_t new_size) const {
     MutableColumnPtr new_nested_col = get_nested_column().clone_resized(new_size);
     auto new_null_map = ColumnUInt8::create();
@@ -194,6 +213,11 @@ ColumnPtr ColumnNullable::filter(const Filter& filt, ssize_t result_size_hint) c
     return ColumnNullable::create(filtered_data, filtered_null_map);
 }
 
+void ColumnNullable::filter_inplace(const Filter& filt) {
+    get_nested_column().filter_inplace(filt);
+    get_null_map_column().filter_inplace(filt);
+}
+
 Status ColumnNullable::filter_by_selector(const uint16_t* sel, size_t sel_size, IColumn* col_ptr) {
     const ColumnNullable* nullable_col_ptr = reinterpret_cast<const ColumnNullable*>(col_ptr);
     ColumnPtr nest_col_ptr = nullable_col_ptr->nested_column;
@@ -134,6 +134,7 @@ public:
 
     void pop_back(size_t n) override;
     ColumnPtr filter(const Filter& filt, ssize_t result_size_hint) const override;
+    void filter_inplace(const Filter& filt) override;
     Status filter_by_selector(const uint16_t* sel, size_t sel_size, IColumn* col_ptr) override;
     ColumnPtr permute(const Permutation& perm, size_t limit) const override;
     //    ColumnPtr index(const IColumn & indexes, size_t limit) const override;
@@ -148,6 +149,10 @@ public:
     ColumnPtr replicate(const Offsets& replicate_offsets) const override;
     void replicate(const uint32_t* counts, size_t target_size, IColumn& column) const override;
     void update_hash_with_value(size_t n, SipHash& hash) const override;
+    void update_hashes_with_value(std::vector<SipHash>& hashes,
+                                  const uint8_t* __restrict null_data = nullptr) const override;
+    void update_crcs_with_value(std::vector<uint32_t>& hashes, const TypeDescriptor& type,
+                                const uint8_t* __restrict null_data = nullptr) const override;
     void get_extremes(Field& min, Field& max) const override;
 
     MutableColumns scatter(ColumnIndex num_columns, const Selector& selector) const override {
@@ -280,6 +285,14 @@ public:
         get_nested_column().convert_dict_codes_if_necessary();
     }
 
+    ColumnPtr convert_to_string_column_if_dictionary() const override {
+        if (!get_nested_column().is_column_dictionary()) {
+            return get_ptr();
+        }
+        return ColumnNullable::create(get_nested_column().convert_to_string_column_if_dictionary(),
+                                      get_null_map_column_ptr());
+    }
+
 private:
     WrappedPtr nested_column;
     WrappedPtr null_map;
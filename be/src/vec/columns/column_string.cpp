@@ -20,6 +20,7 @@
 
 #include "vec/columns/column_string.h"
 
+#include "util/hash_util.hpp"
 #include "vec/columns/collator.h"
 #include "vec/columns/columns_common.h"
 #include "vec/common/arena.h"
@@ -64,6 +65,18 @@ MutableColumnPtr ColumnString::clone_resized(size_t to_size) const {
     return res;
 }
 
+void ColumnString::update_crcs_with_value(std::vector<uint32_t>& hashes, const TypeDescriptor&,
+                                          const uint8_t* __restrict null_data) const {
+    DCHECK_EQ(hashes.size(), size());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        if (null_data && null_data[i]) {
+            hashes[i] = null_crc(hashes[i]);
+        } else {
+            hashes[i] = HashUtil::zlib_crc_hash(&chars[offset_at(i)], size_at(i) - 1, hashes[i]);
+        }
+    }
+}
+
 void ColumnString::insert_range_from(const IColumn& src, size_t start, size_t length) {
     if (length == 0) return;
 
@@ -116,6 +129,32 @@ ColumnPtr ColumnString::filter(const Filter& filt, ssize_t result_size_hint) con
     return res;
 }
 
+void ColumnString::filter_inplace(const Filter& filt) {
+    size_t size = offsets.size();
+    if (size != filt.size()) {
+        LOG(FATAL) << "Size of filter doesn't match size of column.";
+    }
+
+    size_t result_size = 0;
+    Offset prev_offset = 0;
+    Offset result_offset = 0;
+    for (size_t i = 0; i < size; ++i) {
+        // the offsets before i are overwritten, so the start of the string is kept
+        Offset offset = offsets[i];
+        if (filt[i]) {
+            size_t length = offset - prev_offset;
+            if (result_offset != prev_offset) {
+                memmove(chars.data() + result_offset, chars.data() + prev_offset, length);
+            }
+            result_offset += length;
+            offsets[result_size++] = result_offset;
+        }
+        prev_offset = offset;
+    }
+    chars.resize(result_offset);
+    offsets.resize(result_size);
+}
+
 ColumnPtr ColumnString::permute(const Permutation& perm, size_t limit) const {
     size_t size = offsets.size();
 
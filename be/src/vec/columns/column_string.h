@@ -203,12 +203,32 @@ public:
         hash.update(reinterpret_cast<const char*>(&chars[offset]), string_size);
     }
 
+    void update_hashes_with_value(std::vector<SipHash>& hashes,
+                                  const uint8_t* __restrict null_data = nullptr) const override {
+        DCHECK_EQ(hashes.size(), size());
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            if (null_data && null_data[i]) {
+                hashes[i].update(0);
+            } else {
+                size_t string_size = size_at(i);
+                size_t offset = offset_at(i);
+                hashes[i].update(reinterpret_cast<const char*>(&string_size),
+                                 sizeof(string_size));
+                hashes[i].update(reinterpret_cast<const char*>(&chars[offset]), string_size);
+            }
+        }
+    }
+
+    void update_crcs_with_value(std::vector<uint32_t>& hashes, const TypeDescriptor& type,
+                                const uint8_t* __restrict null_data = nullptr) const override;
+
     void insert_range_from(const IColumn& src, size_t start, size_t length) override;
 
     void insert_indices_from(const IColumn& src, const int* indices_begin,
                              const int* indices_end) override;
 
     ColumnPtr filter(const Filter& filt, ssize_t result_size_hint) const override;
+    void filter_inplace(const Filter& filt) override;
 
     ColumnPtr permute(const Permutation& perm, size_t limit) const override;
 
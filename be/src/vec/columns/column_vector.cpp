@@ -27,6 +27,8 @@
 #include <cstring>
 
 #include "runtime/datetime_value.h"
+#include "runtime/types.h"
+#include "util/hash_util.hpp"
 #include "util/simd/bits.h"
 #include "vec/common/arena.h"
 #include "vec/common/assert_cast.h"
@@ -57,6 +59,50 @@ void ColumnVector<T>::update_hash_with_value(size_t n, SipHash& hash) const {
     hash.update(data[n]);
 }
 
+template <typename T>
+void ColumnVector<T>::update_hashes_with_value(std::vector<SipHash>& hashes,
+                                               const uint8_t* __restrict null_data) const {
+    DCHECK_EQ(hashes.size(), size());
+    if (null_data) {
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            if (null_data[i]) {
+                hashes[i].update(0);
+            } else {
+                hashes[i].update(data[i]);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            hashes[i].update(data[i]);
+        }
+    }
+}
+
+template <typename T>
+void ColumnVector<T>::update_crcs_with_value(std::vector<uint32_t>& hashes,
+                                             const TypeDescriptor& type,
+                                             const uint8_t* __restrict null_data) const {
+    // the dates are hashed by their text
+    if (type.type == TYPE_DATE || type.type == TYPE_DATETIME) {
+        IColumn::update_crcs_with_value(hashes, type, null_data);
+        return;
+    }
+    DCHECK_EQ(hashes.size(), size());
+    if (null_data) {
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            if (null_data[i]) {
+                hashes[i] = null_crc(hashes[i]);
+            } else {
+                hashes[i] = HashUtil::zlib_crc_hash(&data[i], sizeof(T), hashes[i]);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            hashes[i] = HashUtil::zlib_crc_hash(&data[i], sizeof(T), hashes[i]);
+        }
+    }
+}
+
 template <typename T>
 struct ColumnVector<T>::less {
     const Self& parent;
@@ -241,6 +287,24 @@ void ColumnVector<T>::insert_indices_from(const IColumn& src, const int* indices
     }
 }
 
+template <typename T>
+void ColumnVector<T>::filter_inplace(const IColumn::Filter& filt) {
+    size_t size = data.size();
+    if (size != filt.size()) {
+        LOG(FATAL) << "Size of filter doesn't match size of column.";
+    }
+
+    const UInt8* __restrict filt_pos = filt.data();
+    auto* __restrict data_pos = data.data();
+    size_t result_size = 0;
+    // branchless, each element is written to its position in the result
+    for (size_t i = 0; i < size; ++i) {
+        data_pos[result_size] = data_pos[i];
+        result_size += filt_pos[i] != 0;
+    }
+    data.resize(result_size);
+}
+
 template <typename T>
 ColumnPtr ColumnVector<T>::filter(const IColumn::Filter& filt, ssize_t result_size_hint) const {
     size_t size = data.size();
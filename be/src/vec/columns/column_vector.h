@@ -224,6 +224,10 @@ public:
     const char* deserialize_and_insert_from_arena(const char* pos) override;
 
     void update_hash_with_value(size_t n, SipHash& hash) const override;
+    void update_hashes_with_value(std::vector<SipHash>& hashes,
+                                  const uint8_t* __restrict null_data = nullptr) const override;
+    void update_crcs_with_value(std::vector<uint32_t>& hashes, const TypeDescriptor& type,
+                                const uint8_t* __restrict null_data = nullptr) const override;
 
     size_t byte_size() const override { return data.size() * sizeof(data[0]); }
 
@@ -296,6 +300,7 @@ public:
     }
 
     ColumnPtr filter(const IColumn::Filter& filt, ssize_t result_size_hint) const override;
+    void filter_inplace(const IColumn::Filter& filt) override;
 
     // note(wb) this method is only used in storage layer now
     Status filter_by_selector(const uint16_t* sel, size_t sel_size, IColumn* col_ptr) override {
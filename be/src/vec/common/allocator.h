@@ -28,8 +28,10 @@
 
 #include <exception>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "runtime/thread_context.h"
+#include "util/doris_metrics.h"
 
 #ifdef NDEBUG
 #define ALLOCATOR_ASLR 0
@@ -52,6 +54,7 @@
 #define DISABLE_MREMAP 1
 #endif
 #include "vec/common/allocator_fwd.h"
+#include "vec/common/column_buffer_pool.h"
 #include "vec/common/exception.h"
 #include "vec/common/mremap.h"
 
@@ -87,6 +90,14 @@ static constexpr size_t MMAP_THRESHOLD = 4096;
 static constexpr size_t MMAP_MIN_ALIGNMENT = 4096;
 static constexpr size_t MALLOC_MIN_ALIGNMENT = 8;
 
+/**
+  * The allocators using huge pages mmap the memory ranges from a lower threshold,
+  * so that the large hash tables are backed by transparent huge pages, which reduces
+  * the TLB misses of the random accesses.
+  */
+static constexpr size_t HUGE_PAGE_SIZE = 2 * (1ULL << 20);
+static constexpr size_t HUGE_PAGE_MMAP_THRESHOLD = std::min(MMAP_THRESHOLD, 2 * HUGE_PAGE_SIZE);
+
 /** Responsible for allocating / freeing memory. Used, for example, in PODArray, Arena.
   * Also used in hash tables.
   * The interface is different from std::allocator
@@ -96,8 +107,10 @@ static constexpr size_t MALLOC_MIN_ALIGNMENT = 8;
   * - the possibility of zeroing memory (used in hash tables);
   * - random hint address for mmap
   * - mmap_threshold for using mmap less or more
+  * - huge pages for the large memory ranges, if use_huge_pages and
+  *   config::enable_huge_pages_for_hash_table
   */
-template <bool clear_memory_, bool mmap_populate>
+template <bool clear_memory_, bool mmap_populate, bool use_huge_pages>
 class Allocator {
 public:
     /// Allocate memory range.
@@ -117,7 +130,7 @@ public:
         if (old_size == new_size) {
             /// nothing to do.
             /// BTW, it's not possible to change alignment while doing realloc.
-        } else if (old_size < MMAP_THRESHOLD && new_size < MMAP_THRESHOLD &&
+        } else if (old_size < mmap_threshold && new_size < mmap_threshold &&
                    alignment <= MALLOC_MIN_ALIGNMENT) {
             /// Resize malloc'd memory region with no special alignment requirement.
             // CurrentMemoryTracker::realloc(old_size, new_size);
@@ -133,7 +146,7 @@ public:
             if constexpr (clear_memory)
                 if (new_size > old_size)
                     memset(reinterpret_cast<char*>(buf) + old_size, 0, new_size - old_size);
-        } else if (old_size >= MMAP_THRESHOLD && new_size >= MMAP_THRESHOLD) {
+        } else if (old_size >= mmap_threshold && new_size >= mmap_threshold) {
             /// Resize mmap'd memory region.
             // CurrentMemoryTracker::realloc(old_size, new_size);
             CONSUME_THREAD_LOCAL_MEM_TRACKER(new_size - old_size);
@@ -148,6 +161,11 @@ public:
                                                           std::to_string(new_size) + ".",
                                                   doris::TStatusCode::VEC_CANNOT_MREMAP);
             }
+            // the range keeps the advice when remapped
+            if (huge_pages_enabled()) {
+                doris::DorisMetrics::instance()->huge_page_allocated_bytes->increment(
+                        (int64_t)new_size - (int64_t)old_size);
+            }
 
             /// No need for zero-fill, because mmap guarantees it.
 
@@ -157,7 +175,7 @@ public:
                 if (new_size > old_size)
                     memset(reinterpret_cast<char*>(buf) + old_size, 0, new_size - old_size);
             }
-        } else if (new_size < MMAP_THRESHOLD) {
+        } else if (new_size < mmap_threshold) {
             /// Small allocs that requires a copy. Assume there's enough memory in system. Call CurrentMemoryTracker once.
             // CurrentMemoryTracker::realloc(old_size, new_size);
 
@@ -194,11 +212,52 @@ protected:
 #endif
             ;
 
+    static constexpr size_t mmap_threshold =
+            use_huge_pages ? HUGE_PAGE_MMAP_THRESHOLD : MMAP_THRESHOLD;
+
+    // The path of a range depends on mmap_threshold only, the config decides whether the
+    // mmap-ed ranges are advised to use huge pages. It is immutable, so a range is counted
+    // in the metric when allocated iff it is when freed.
+    static bool huge_pages_enabled() {
+        return use_huge_pages && doris::config::enable_huge_pages_for_hash_table;
+    }
+
 private:
+    // Maps a range aligned to the huge page size and advises the kernel to back it by
+    // transparent huge pages. The pages are populated after the advice, otherwise they are
+    // faulted in as normal pages.
+    void* mmap_huge_pages(size_t size) {
+        size_t mapped_size = size + HUGE_PAGE_SIZE;
+        void* mapped = mmap(get_mmap_hint(), mapped_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == mapped) {
+            return mapped;
+        }
+        char* begin = reinterpret_cast<char*>(mapped);
+        char* end = begin + mapped_size;
+        char* aligned = reinterpret_cast<char*>(
+                (reinterpret_cast<uintptr_t>(begin) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+        char* aligned_end = aligned + ((size + MMAP_MIN_ALIGNMENT - 1) & ~(MMAP_MIN_ALIGNMENT - 1));
+        if (aligned > begin) {
+            munmap(begin, aligned - begin);
+        }
+        if (end > aligned_end) {
+            munmap(aligned_end, end - aligned_end);
+        }
+        if (0 != madvise(aligned, size, MADV_HUGEPAGE)) {
+            LOG_FIRST_N(WARNING, 1) << "Allocator: madvise(MADV_HUGEPAGE) failed, errno=" << errno;
+        }
+        doris::DorisMetrics::instance()->huge_page_allocated_bytes->increment(size);
+        if constexpr (mmap_populate) {
+            memset(aligned, 0, size);
+        }
+        return aligned;
+    }
+
     void* alloc_no_track(size_t size, size_t alignment) {
         void* buf;
 
-        if (size >= MMAP_THRESHOLD) {
+        if (size >= mmap_threshold) {
             if (alignment > MMAP_MIN_ALIGNMENT)
                 throw doris::vectorized::Exception(
                         fmt::format(
@@ -207,7 +266,11 @@ private:
                         doris::TStatusCode::VEC_BAD_ARGUMENTS);
 
             CONSUME_THREAD_LOCAL_MEM_TRACKER(size);
-            buf = mmap(get_mmap_hint(), size, PROT_READ | PROT_WRITE, mmap_flags, -1, 0);
+            if (huge_pages_enabled()) {
+                buf = mmap_huge_pages(size);
+            } else {
+                buf = mmap(get_mmap_hint(), size, PROT_READ | PROT_WRITE, mmap_flags, -1, 0);
+            }
             if (MAP_FAILED == buf) {
                 RELEASE_THREAD_LOCAL_MEM_TRACKER(size);
                 doris::vectorized::throwFromErrno(fmt::format("Allocator: Cannot mmap {}.", size),
@@ -217,6 +280,12 @@ private:
             /// No need for zero-fill, because mmap guarantees it.
         } else {
             if (alignment <= MALLOC_MIN_ALIGNMENT) {
+                // reuse the buffer freed by the fragment instance attached if any
+                auto pool = doris::tls_ctx()->_column_buffer_pool;
+                if (pool != nullptr && (buf = pool->get(size)) != nullptr) {
+                    if constexpr (clear_memory) memset(buf, 0, size);
+                    return buf;
+                }
                 if constexpr (clear_memory)
                     buf = ::calloc(size, 1);
                 else
@@ -242,14 +311,21 @@ private:
     }
 
     void free_no_track(void* buf, size_t size) {
-        if (size >= MMAP_THRESHOLD) {
+        if (size >= mmap_threshold) {
             if (0 != munmap(buf, size)) {
                 doris::vectorized::throwFromErrno(fmt::format("Allocator: Cannot munmap {}.", size),
                                                   doris::TStatusCode::VEC_CANNOT_MUNMAP);
             } else {
                 RELEASE_THREAD_LOCAL_MEM_TRACKER(size);
+                if (huge_pages_enabled()) {
+                    doris::DorisMetrics::instance()->huge_page_allocated_bytes->increment(-(int64_t)size);
+                }
             }
         } else {
+            auto pool = doris::tls_ctx()->_column_buffer_pool;
+            if (pool != nullptr && pool->put(buf, size)) {
+                return;
+            }
             ::free(buf);
         }
     }
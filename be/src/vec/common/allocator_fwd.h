@@ -23,7 +23,7 @@
   */
 #pragma once
 
-template <bool clear_memory_, bool mmap_populate = false>
+template <bool clear_memory_, bool mmap_populate = false, bool use_huge_pages = false>
 class Allocator;
 
 template <typename Base, size_t N = 64, size_t Alignment = 1>
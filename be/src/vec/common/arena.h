@@ -271,6 +271,18 @@ public:
         return res;
     }
 
+    /// Free all chunks except the head one and reset it, so the arena could be reused
+    /// without deallocating and allocating memory again.
+    void clear() {
+        if (head->prev) {
+            delete head->prev;
+            head->prev = nullptr;
+        }
+        ASAN_POISON_MEMORY_REGION(head->begin, head->size());
+        head->pos = head->begin;
+        size_in_bytes = head->size();
+    }
+
     /// Size of chunks in bytes.
     size_t size() const { return size_in_bytes; }
 
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/column_buffer_pool.h"
+
+#include <cstdlib>
+#include <mutex>
+
+namespace doris::vectorized {
+
+ColumnBufferPool::ColumnBufferPool(int64_t capacity) : _capacity(capacity) {}
+
+ColumnBufferPool::~ColumnBufferPool() {
+    for (auto& free_list : _free_lists) {
+        for (void* buf : free_list.buffers) {
+            ::free(buf);
+        }
+    }
+}
+
+void* ColumnBufferPool::get(size_t size) {
+    int size_class = _size_class(size);
+    if (size_class < 0) {
+        return nullptr;
+    }
+    auto& free_list = _free_lists[size_class];
+    void* buf = nullptr;
+    {
+        std::lock_guard<SpinLock> l(free_list.lock);
+        if (free_list.buffers.empty()) {
+            return nullptr;
+        }
+        buf = free_list.buffers.back();
+        free_list.buffers.pop_back();
+    }
+    _cached_bytes -= size;
+    _hit_count++;
+    return buf;
+}
+
+bool ColumnBufferPool::put(void* buf, size_t size) {
+    int size_class = _size_class(size);
+    if (size_class < 0) {
+        return false;
+    }
+    // the capacity may be exceeded a little by the concurrent puts
+    if (_cached_bytes.load() + (int64_t)size > _capacity) {
+        return false;
+    }
+    _cached_bytes += size;
+    auto& free_list = _free_lists[size_class];
+    std::lock_guard<SpinLock> l(free_list.lock);
+    free_list.buffers.push_back(buf);
+    return true;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,80 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "util/spinlock.h"
+
+namespace doris::vectorized {
+
+// A pool of the freed buffers of the columns of a fragment instance, so the blocks of the
+// next batches, e.g. created by Block::clone_empty() or deserialized from the exchange,
+// reuse the memory instead of asking malloc again.
+//
+// Allocator takes the buffers from and returns them to the pool of the fragment attached to
+// the current thread, see AttachTaskThread. Only the malloc-ed buffers with a power-of-two
+// size between MIN_BUFFER_SIZE and MAX_BUFFER_SIZE are pooled, which are most of the PODArray
+// buffers since they grow by doubling. The buffers are kept by size only, the type of the
+// column does not matter for raw memory. The pool caches at most `capacity` bytes, and frees
+// the buffers when destructed.
+// This class is thread-safe.
+class ColumnBufferPool {
+public:
+    static constexpr size_t MIN_BUFFER_SIZE = 4096;
+    static constexpr size_t MAX_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    explicit ColumnBufferPool(int64_t capacity);
+    ~ColumnBufferPool();
+
+    // Returns a free buffer of 'size' bytes, nullptr if there is none.
+    void* get(size_t size);
+
+    // Returns true if the buffer is taken by the pool, otherwise the caller should free it.
+    bool put(void* buf, size_t size);
+
+    int64_t cached_bytes() const { return _cached_bytes.load(); }
+    int64_t hit_count() const { return _hit_count.load(); }
+
+private:
+    static constexpr int MIN_SIZE_CLASS = 12; // 4KB
+    static constexpr int NUM_SIZE_CLASSES = 11; // up to 4MB
+
+    // Returns -1 if the buffers of 'size' are not pooled.
+    static int _size_class(size_t size) {
+        if (size < MIN_BUFFER_SIZE || size > MAX_BUFFER_SIZE || (size & (size - 1)) != 0) {
+            return -1;
+        }
+        return __builtin_ctzll(size) - MIN_SIZE_CLASS;
+    }
+
+    struct FreeList {
+        SpinLock lock;
+        std::vector<void*> buffers;
+    };
+
+    const int64_t _capacity;
+    std::atomic<int64_t> _cached_bytes {0};
+    std::atomic<int64_t> _hit_count {0};
+    FreeList _free_lists[NUM_SIZE_CLASSES];
+};
+
+} // namespace doris::vectorized
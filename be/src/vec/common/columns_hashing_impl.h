@@ -138,6 +138,15 @@ public:
         return find_key_impl(key_holder_get_key(key_holder), data);
     }
 
+    /// Same as find_key, with the hash value of the row calculated by get_hash before.
+    template <typename Data>
+    ALWAYS_INLINE FindResult find_key_with_hash(Data& data, size_t row, size_t hash_value,
+                                                Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
+        auto key = key_holder_get_key(key_holder);
+        return find_key_impl(key, data, [&]() { return data.find(key, hash_value); });
+    }
+
     template <typename Data>
     ALWAYS_INLINE size_t get_hash(const Data& data, size_t row, Arena& pool) {
         auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
@@ -209,6 +218,11 @@ protected:
 
     template <typename Data, typename Key>
     ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data) {
+        return find_key_impl(key, data, [&]() { return data.find(key); });
+    }
+
+    template <typename Data, typename Key, typename Find>
+    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data, Find&& find) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.check(key)) {
                 if constexpr (has_mapped)
@@ -218,7 +232,7 @@ protected:
             }
         }
 
-        auto it = data.find(key);
+        auto it = find();
 
         if constexpr (consecutive_keys_optimization) {
             cache.found = it != nullptr;
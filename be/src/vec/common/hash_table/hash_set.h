@@ -48,6 +48,24 @@ public:
         for (size_t i = 0; i < rhs.grower.buf_size(); ++i)
             if (!rhs.buf[i].is_zero(*this)) this->insert(Cell::get_key(rhs.buf[i].get_value()));
     }
+
+    /// Merges a set serialized by write() without materializing it as a second table,
+    /// the union holds at least as many elements as the larger of the two sets.
+    void read_and_merge(doris::vectorized::BufferReadable& rb) {
+        Cell::State::read(rb);
+
+        size_t rhs_size = 0;
+        doris::vectorized::read_var_uint(rhs_size, rb);
+        if (rhs_size > this->size()) {
+            this->expanse_for_add_elem(rhs_size - this->size());
+        }
+
+        for (size_t i = 0; i < rhs_size; ++i) {
+            Cell x;
+            x.read(rb);
+            this->insert(Cell::get_key(x.get_value()));
+        }
+    }
 };
 
 template <typename Key, typename Hash, typename TState = HashTableNoState>
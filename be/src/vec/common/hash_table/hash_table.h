@@ -760,6 +760,10 @@ public:
         __builtin_prefetch(&buf[place_value]);
     }
 
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) {
+        __builtin_prefetch(&buf[grower.place(hash_value)]);
+    }
+
     /// Reinsert node pointed to by iterator
     void ALWAYS_INLINE reinsert(iterator& it, size_t hash_value) {
         reinsert(*it.get_ptr(), hash_value);
@@ -26,8 +26,11 @@
   * We are going to use the entire memory we allocated when resizing a hash
   * table, so it makes sense to pre-fault the pages so that page faults don't
   * interrupt the resize loop. Set the allocator parameter accordingly.
+  * The large hash tables are accessed randomly, so they opt in huge pages to reduce
+  * the TLB misses.
   */
-using HashTableAllocator = Allocator<true /* clear_memory */, true /* mmap_populate */>;
+using HashTableAllocator =
+        Allocator<true /* clear_memory */, true /* mmap_populate */, true /* use_huge_pages */>;
 
 template <size_t N = 64>
 using HashTableAllocatorWithStackMemory = AllocatorWithStackMemory<HashTableAllocator, N>;
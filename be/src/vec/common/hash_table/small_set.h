@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+#include "vec/io/io_helper.h"
+
+/** A set which keeps at most N keys in a plain array, and moves them to the hash set `Set`
+  * once more keys are inserted.
+  *
+  * It is the state of the distinct aggregate functions. With many groups, most groups
+  * only hold a few keys, so the preallocated cells of a hash set in every group would take
+  * most of the memory, once for each distinct function of the query.
+  *
+  * The serialized format is the same as the one of HashTable, so the two are compatible.
+  */
+template <typename Key, typename Set, size_t N>
+class SmallSetWithFallback {
+public:
+    size_t size() const { return _large != nullptr ? _large->size() : _small_size; }
+
+    void insert(const Key& key) {
+        if (_large != nullptr) {
+            _large->insert(key);
+            return;
+        }
+        if (std::find(_small, _small + _small_size, key) != _small + _small_size) {
+            return;
+        }
+        if (_small_size < N) {
+            _small[_small_size++] = key;
+            return;
+        }
+        _large = std::make_unique<Set>();
+        for (size_t i = 0; i < _small_size; ++i) {
+            _large->insert(_small[i]);
+        }
+        _large->insert(key);
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        if (_large != nullptr) {
+            for (const auto& cell : *_large) {
+                func(cell.get_value());
+            }
+        } else {
+            std::for_each(_small, _small + _small_size, func);
+        }
+    }
+
+    void merge(const SmallSetWithFallback& rhs) {
+        rhs.for_each([this](const Key& key) { insert(key); });
+    }
+
+    void write(doris::vectorized::BufferWritable& wb) const {
+        doris::vectorized::write_var_uint(size(), wb);
+        for_each([&wb](const Key& key) { doris::vectorized::write_binary(key, wb); });
+    }
+
+    void read(doris::vectorized::BufferReadable& rb) {
+        _large.reset();
+        _small_size = 0;
+        read_and_merge(rb);
+    }
+
+    void read_and_merge(doris::vectorized::BufferReadable& rb) {
+        size_t size = 0;
+        doris::vectorized::read_var_uint(size, rb);
+        for (size_t i = 0; i < size; ++i) {
+            Key key;
+            doris::vectorized::read_binary(key, rb);
+            insert(key);
+        }
+    }
+
+private:
+    Key _small[N];
+    size_t _small_size = 0;
+    std::unique_ptr<Set> _large;
+};
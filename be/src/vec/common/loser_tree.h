@@ -0,0 +1,134 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace doris::vectorized {
+
+/// Tournament tree of losers used to merge k sorted inputs.
+///
+/// Every inner node keeps the loser of the match between the winners of its two subtrees,
+/// so when the top is advanced only the matches on the path from its leaf to the root are
+/// replayed: exactly log(k) comparisons, instead of about 2 * log(k) of a binary heap.
+///
+/// `Greater` has the same meaning as the comparator of std::priority_queue: greater(a, b)
+/// returns true if a should be output after b.
+template <typename T, typename Greater>
+class LoserTree {
+public:
+    explicit LoserTree(Greater greater = Greater()) : _greater(std::move(greater)) {}
+
+    /// Build the tree with the current items of all the inputs.
+    void init(std::vector<T> items) {
+        _items = std::move(items);
+        const size_t k = _items.size();
+        _active.assign(k, true);
+        _num_active = k;
+        _losers.assign(k, 0);
+        _winner = 0;
+        if (k <= 1) {
+            return;
+        }
+
+        // leaf i is the node k + i, the children of node n are 2n and 2n + 1
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            winners[k + i] = i;
+        }
+        for (size_t node = k - 1; node > 0; --node) {
+            size_t lhs = winners[2 * node];
+            size_t rhs = winners[2 * node + 1];
+            if (_beats(lhs, rhs)) {
+                winners[node] = lhs;
+                _losers[node] = rhs;
+            } else {
+                winners[node] = rhs;
+                _losers[node] = lhs;
+            }
+        }
+        _winner = winners[1];
+    }
+
+    bool empty() const { return _num_active == 0; }
+
+    size_t size() const { return _num_active; }
+
+    T& top() { return _items[_winner]; }
+
+    /// Index of the input of the top item in the items passed to init().
+    size_t top_index() const { return _winner; }
+
+    /// The top item has been advanced to the next item of its input.
+    void update_top() { _replay(_winner); }
+
+    /// The input of the top item is exhausted.
+    void pop_top() {
+        _active[_winner] = false;
+        --_num_active;
+        _replay(_winner);
+    }
+
+    /// The best item except the top one, nullptr if there is no other one. It is the best of
+    /// the losers on the path of the top, so it costs log(k) comparisons.
+    T* second() {
+        if (_num_active <= 1) {
+            return nullptr;
+        }
+        size_t best = _items.size();
+        for (size_t node = (_winner + _items.size()) / 2; node > 0; node /= 2) {
+            size_t loser = _losers[node];
+            if (!_active[loser]) {
+                continue;
+            }
+            if (best == _items.size() || !_beats(best, loser)) {
+                best = loser;
+            }
+        }
+        return best == _items.size() ? nullptr : &_items[best];
+    }
+
+private:
+    bool _beats(size_t lhs, size_t rhs) {
+        if (!_active[rhs]) return true;
+        if (!_active[lhs]) return false;
+        return !_greater(_items[lhs], _items[rhs]);
+    }
+
+    void _replay(size_t leaf) {
+        size_t winner = leaf;
+        for (size_t node = (leaf + _items.size()) / 2; node > 0; node /= 2) {
+            if (!_beats(winner, _losers[node])) {
+                std::swap(winner, _losers[node]);
+            }
+        }
+        _winner = winner;
+    }
+
+    Greater _greater;
+    std::vector<T> _items;
+    std::vector<bool> _active;
+    // loser of the match of each inner node, node 0 is not used
+    std::vector<size_t> _losers;
+    size_t _winner = 0;
+    size_t _num_active = 0;
+};
+
+} // namespace doris::vectorized
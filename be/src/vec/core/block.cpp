@@ -23,6 +23,7 @@
 #include <fmt/format.h>
 #include <snappy.h>
 
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <iterator>
@@ -34,6 +35,7 @@
 #include "runtime/tuple.h"
 #include "runtime/tuple_row.h"
 #include "udf/udf.h"
+#include "util/block_compression.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
@@ -74,10 +76,29 @@ Block::Block(const std::vector<SlotDescriptor*>& slots, size_t block_size) {
     }
 }
 
+// The codecs are not thread safe and the zstd ones are expensive to create, so they are
+// cached per thread.
+static BlockCompressionCodec* get_decompression_codec(segment_v2::CompressionTypePB type) {
+    thread_local std::unique_ptr<BlockCompressionCodec>
+            codecs[segment_v2::CompressionTypePB_ARRAYSIZE];
+    auto& codec = codecs[type];
+    if (codec == nullptr) {
+        Status st = get_block_compression_codec(type, codec);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to get the decompression codec of " << type << ": " << st;
+        }
+    }
+    return codec.get();
+}
+
 Block::Block(const PBlock& pblock) {
     const char* buf = nullptr;
     std::string compression_scratch;
-    if (pblock.compressed()) {
+    // the blocks sent by the old versions are compressed by snappy without compression_type
+    bool snappy_compressed = pblock.compressed() && (!pblock.has_compression_type() ||
+                                                     pblock.compression_type() ==
+                                                             segment_v2::CompressionTypePB::SNAPPY);
+    if (snappy_compressed) {
         // Decompress
         const char* compressed_data = pblock.column_values().c_str();
         size_t compressed_size = pblock.column_values().size();
@@ -90,6 +111,15 @@ Block::Block(const PBlock& pblock) {
                 snappy::RawUncompress(compressed_data, compressed_size, compression_scratch.data());
         DCHECK(success) << "snappy::RawUncompress failed";
         buf = compression_scratch.data();
+    } else if (pblock.compressed()) {
+        BlockCompressionCodec* codec = get_decompression_codec(pblock.compression_type());
+        CHECK(codec != nullptr) << "unknown compression type " << pblock.compression_type();
+        compression_scratch.resize(pblock.uncompressed_size());
+        Slice uncompressed_slice(compression_scratch.data(), compression_scratch.size());
+        Status st = codec->decompress(Slice(pblock.column_values()), &uncompressed_slice);
+        DCHECK(st.ok()) << "failed to decompress block: " << st;
+        DCHECK_EQ(uncompressed_slice.size, compression_scratch.size());
+        buf = compression_scratch.data();
     } else {
         buf = pblock.column_values().data();
     }
@@ -561,9 +591,29 @@ void Block::clear() {
     info = BlockInfo();
     data.clear();
     index_by_name.clear();
+    reusable_results.clear();
+}
+
+// A column shared with other blocks, directly or by its sub-columns, can't be cleared in place.
+static bool is_column_exclusive(const IColumn& column) {
+    bool exclusive = column.use_count() == 1;
+    const_cast<IColumn&>(column).for_each_subcolumn([&](IColumn::WrappedPtr& subcolumn) {
+        exclusive = exclusive && is_column_exclusive(*subcolumn);
+    });
+    return exclusive;
 }
 
 void Block::clear_column_data(int column_size) noexcept {
+    // the expr results of the batch are not reusable by the next one, the columns before
+    // column_size are kept as they are part of the block
+    if (!reusable_results.empty()) {
+        for (int i = data.size() - 1; i >= 0 && (column_size == -1 || i >= column_size); --i) {
+            if (reusable_results.count(data[i].name)) {
+                erase(i);
+            }
+        }
+        reusable_results.clear();
+    }
     // data.size() greater than column_size, means here have some
     // function exec result in block, need erase it here
     if (column_size != -1 and data.size() > column_size) {
@@ -572,8 +622,11 @@ void Block::clear_column_data(int column_size) noexcept {
         }
     }
     for (auto& d : data) {
-        DCHECK(d.column->use_count() == 1);
-        (*std::move(d.column)).assume_mutable()->clear();
+        if (is_column_exclusive(*d.column)) {
+            (*std::move(d.column)).assume_mutable()->clear();
+        } else {
+            d.column = d.column->clone_empty();
+        }
     }
 }
 
@@ -581,11 +634,13 @@ void Block::swap(Block& other) noexcept {
     std::swap(info, other.info);
     data.swap(other.data);
     index_by_name.swap(other.index_by_name);
+    reusable_results.swap(other.reusable_results);
 }
 
 void Block::swap(Block&& other) noexcept {
     clear();
     data = std::move(other.data);
+    reusable_results = std::move(other.reusable_results);
     initialize_index_by_name();
 }
 
@@ -605,9 +660,27 @@ void filter_block_internal(Block* block, const IColumn::Filter& filter, uint32_t
         }
     } else {
         if (count != block->rows()) {
+            // the columns shared by several positions are filtered once
+            std::vector<std::pair<ColumnPtr, ColumnPtr>> filtered_columns;
             for (size_t i = 0; i < column_to_keep; ++i) {
-                block->get_by_position(i).column =
-                        block->get_by_position(i).column->filter(filter, 0);
+                auto& column = block->get_by_position(i).column;
+                if (column->use_count() == 1) {
+                    // nobody else sees the column, remove the rows in place instead of
+                    // copying the rows left into a new column
+                    auto mutable_column = std::move(*column).mutate();
+                    mutable_column->filter_inplace(filter);
+                    column = std::move(mutable_column);
+                    continue;
+                }
+                auto it = std::find_if(filtered_columns.begin(), filtered_columns.end(),
+                                       [&](const auto& pair) { return pair.first == column; });
+                if (it != filtered_columns.end()) {
+                    column = it->second;
+                } else {
+                    auto filtered_column = column->filter(filter, count);
+                    filtered_columns.emplace_back(column, filtered_column);
+                    column = std::move(filtered_column);
+                }
             }
         }
     }
@@ -667,6 +740,21 @@ Status Block::filter_block(Block* block, int filter_column_id, int column_to_kee
 
 Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
                         bool allow_transfer_large_data) const {
+    if (!config::compress_rowbatches) {
+        return serialize(pblock, uncompressed_bytes, compressed_bytes,
+                         segment_v2::CompressionTypePB::NO_COMPRESSION, nullptr,
+                         allow_transfer_large_data);
+    }
+    std::unique_ptr<BlockCompressionCodec> codec;
+    RETURN_IF_ERROR(get_block_compression_codec(segment_v2::CompressionTypePB::SNAPPY, codec));
+    return serialize(pblock, uncompressed_bytes, compressed_bytes,
+                     segment_v2::CompressionTypePB::SNAPPY, codec.get(),
+                     allow_transfer_large_data);
+}
+
+Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
+                        segment_v2::CompressionTypePB compression_type,
+                        BlockCompressionCodec* codec, bool allow_transfer_large_data) const {
     // calc uncompressed size for allocation
     size_t content_uncompressed_size = 0;
     for (const auto& c : *this) {
@@ -696,10 +784,13 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
         buf = c.type->serialize(*(c.column), buf);
     }
     *uncompressed_bytes = content_uncompressed_size;
+    *compressed_bytes = content_uncompressed_size;
 
     // compress
-    if (config::compress_rowbatches && content_uncompressed_size > 0) {
-        size_t max_compressed_size = snappy::MaxCompressedLength(content_uncompressed_size);
+    size_t max_compressed_size =
+            codec == nullptr ? 0 : codec->max_compressed_len(content_uncompressed_size);
+    // max_compressed_size is 0 if the content is too large for the codec
+    if (max_compressed_size > 0 && content_uncompressed_size > 0) {
         std::string compression_scratch;
         try {
             // Try compressing the content to compression_scratch,
@@ -714,18 +805,18 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
             LOG(WARNING) << msg;
             return Status::BufferAllocFailed(msg);
         }
-        size_t compressed_size = 0;
-        char* compressed_output = compression_scratch.data();
-        snappy::RawCompress(column_values->data(), content_uncompressed_size, compressed_output,
-                            &compressed_size);
+        Slice compressed_slice(compression_scratch.data(), max_compressed_size);
+        RETURN_IF_ERROR(codec->compress(Slice(column_values->data(), content_uncompressed_size),
+                                        &compressed_slice));
+        size_t compressed_size = compressed_slice.size;
 
         if (LIKELY(compressed_size < content_uncompressed_size)) {
             compression_scratch.resize(compressed_size);
             column_values->swap(compression_scratch);
             pblock->set_compressed(true);
+            pblock->set_compression_type(compression_type);
+            pblock->set_uncompressed_size(content_uncompressed_size);
             *compressed_bytes = compressed_size;
-        } else {
-            *compressed_bytes = content_uncompressed_size;
         }
 
         VLOG_ROW << "uncompressed size: " << content_uncompressed_size
@@ -40,6 +40,7 @@
 
 namespace doris {
 
+class BlockCompressionCodec;
 class MemPool;
 class RowBatch;
 class RowDescriptor;
@@ -64,6 +65,9 @@ private:
 
     Container data;
     IndexByName index_by_name;
+    // The names of the expr results reusable by the identical exprs executed on the block,
+    // only within the current batch.
+    phmap::flat_hash_set<String> reusable_results;
 
 public:
     BlockInfo info;
@@ -229,6 +233,12 @@ public:
     // Else clear column [0, column_size) delete column [column_size, data.size)
     void clear_column_data(int column_size = -1) noexcept;
 
+    // Marks the column at the position as an expr result reusable by the identical exprs
+    // executed on the block. The marks are dropped by clear_column_data(), which erases the
+    // marked columns, so the next batch of a reused block never finds a stale result.
+    void mark_reusable_result(size_t position) { reusable_results.insert(data[position].name); }
+    bool is_reusable_result(const String& name) const { return reusable_results.count(name); }
+
     bool mem_reuse() { return !data.empty(); }
 
     bool is_empty_column() { return data.empty(); }
@@ -256,8 +266,14 @@ public:
         }
     }
 
-    // serialize block to PBlock
+    // serialize block to PBlock, compressed by snappy if compress_rowbatches is set
+    Status serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
+                     bool allow_transfer_large_data = false) const;
+
+    // serialize block to PBlock, compressed by codec of compression_type, the values are
+    // not compressed if codec is nullptr or the compressed ones are not smaller
     Status serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
+                     segment_v2::CompressionTypePB compression_type, BlockCompressionCodec* codec,
                      bool allow_transfer_large_data = false) const;
 
     // serialize block to PRowbatch
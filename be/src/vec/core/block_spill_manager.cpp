@@ -0,0 +1,116 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/block_spill_manager.h"
+
+#include <fmt/format.h>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "runtime/exec_env.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/threadpool.h"
+#include "util/uid_util.h"
+
+namespace doris::vectorized {
+
+BlockSpillManager::~BlockSpillManager() {
+    if (_io_thread_pool != nullptr) {
+        _io_thread_pool->shutdown();
+    }
+}
+
+Status BlockSpillManager::init() {
+    if (config::spill_io_thread_pool_thread_num <= 0) {
+        return Status::OK();
+    }
+    return ThreadPoolBuilder("SpillIOThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::spill_io_thread_pool_thread_num)
+            .set_max_queue_size(config::spill_io_thread_pool_queue_size)
+            .build(&_io_thread_pool);
+}
+
+std::string BlockSpillManager::gen_spill_path(const TUniqueId& query_id,
+                                              const std::string& prefix) {
+    std::vector<TmpFileMgr::DeviceId> devices = _tmp_file_mgr->active_tmp_devices();
+    std::string tmp_dir;
+    if (devices.empty()) {
+        // all devices are blacklisted, let the writer fail on any one of them
+        tmp_dir = _tmp_file_mgr->get_tmp_dir_path(0);
+    } else {
+        tmp_dir = _tmp_file_mgr->get_tmp_dir_path(devices[_next_device++ % devices.size()]);
+    }
+    return fmt::format("{}/{}_{}_{}.spill", tmp_dir, print_id(query_id), prefix,
+                       UniqueId::gen_uid().to_string());
+}
+
+Status BlockSpillManager::acquire_space(const TUniqueId& query_id, const std::string& path,
+                                        int64_t bytes) {
+    std::lock_guard l(_lock);
+    int64_t& query_bytes = _query_bytes[query_id];
+    if (config::spill_max_bytes_per_query >= 0 &&
+        query_bytes + bytes > config::spill_max_bytes_per_query) {
+        if (query_bytes == 0) {
+            _query_bytes.erase(query_id);
+        }
+        return Status::InternalError(
+                fmt::format("query {} spilled too much data, spilled bytes: {}, limit: {}",
+                            print_id(query_id), query_bytes + bytes,
+                            config::spill_max_bytes_per_query));
+    }
+    query_bytes += bytes;
+    auto& file_bytes = _file_bytes[path];
+    file_bytes.first = query_id;
+    file_bytes.second += bytes;
+    return Status::OK();
+}
+
+Status BlockSpillManager::remove_spill_file(const std::string& path) {
+    {
+        std::lock_guard l(_lock);
+        auto it = _file_bytes.find(path);
+        if (it != _file_bytes.end()) {
+            auto query_it = _query_bytes.find(it->second.first);
+            DCHECK(query_it != _query_bytes.end());
+            if (query_it != _query_bytes.end()) {
+                query_it->second -= it->second.second;
+                if (query_it->second <= 0) {
+                    _query_bytes.erase(query_it);
+                }
+            }
+            _file_bytes.erase(it);
+        }
+    }
+    return Env::Default()->delete_file(path);
+}
+
+int64_t BlockSpillManager::spilled_bytes(const TUniqueId& query_id) const {
+    std::lock_guard l(_lock);
+    auto it = _query_bytes.find(query_id);
+    return it == _query_bytes.end() ? 0 : it->second;
+}
+
+Status BlockSpillManager::remove_file(const std::string& path) {
+    auto* manager = ExecEnv::GetInstance()->block_spill_mgr();
+    if (manager == nullptr) {
+        return Env::Default()->delete_file(path);
+    }
+    return manager->remove_spill_file(path);
+}
+
+} // namespace doris::vectorized
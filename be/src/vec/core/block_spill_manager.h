@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "util/hash_util.hpp"
+
+namespace doris {
+class ThreadPool;
+class TmpFileMgr;
+
+namespace vectorized {
+
+// The spill files of the vectorized aggregation, sort and hash join nodes are managed here:
+// they are striped across the tmp dirs on the disks of `storage_root_path`, written by a
+// shared io thread pool, and the bytes a query spills are limited by
+// `spill_max_bytes_per_query`.
+class BlockSpillManager {
+public:
+    explicit BlockSpillManager(TmpFileMgr* tmp_file_mgr) : _tmp_file_mgr(tmp_file_mgr) {}
+    ~BlockSpillManager();
+
+    Status init();
+
+    // Generate a spill file path, the tmp dirs of the disks are used in turn.
+    std::string gen_spill_path(const TUniqueId& query_id, const std::string& prefix);
+
+    // The pool writing the spilled blocks, nullptr if they are written synchronously.
+    ThreadPool* io_thread_pool() { return _io_thread_pool.get(); }
+
+    // Account 'bytes' written to spill file 'path' to the query, returns error if the
+    // spilled bytes of the query exceed `spill_max_bytes_per_query`.
+    Status acquire_space(const TUniqueId& query_id, const std::string& path, int64_t bytes);
+
+    // Remove the spill file and release the space accounted to it.
+    Status remove_spill_file(const std::string& path);
+
+    int64_t spilled_bytes(const TUniqueId& query_id) const;
+
+    // Remove the spill file by the manager of ExecEnv, or directly if there is none.
+    static Status remove_file(const std::string& path);
+
+private:
+    TmpFileMgr* _tmp_file_mgr;
+    std::unique_ptr<ThreadPool> _io_thread_pool;
+    std::atomic<uint32_t> _next_device {0};
+
+    mutable std::mutex _lock;
+    std::unordered_map<TUniqueId, int64_t> _query_bytes;
+    // path -> (query id, bytes)
+    std::unordered_map<std::string, std::pair<TUniqueId, int64_t>> _file_bytes;
+};
+
+} // namespace vectorized
+} // namespace doris
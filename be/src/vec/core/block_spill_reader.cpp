@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/block_spill_reader.h"
+
+#include <fmt/format.h>
+
+#include "env/env.h"
+#include "gen_cpp/data.pb.h"
+#include "util/coding.h"
+#include "vec/core/block.h"
+#include "vec/core/block_spill_manager.h"
+
+namespace doris::vectorized {
+
+BlockSpillReader::~BlockSpillReader() {
+    close();
+}
+
+Status BlockSpillReader::open() {
+    DCHECK(_file == nullptr);
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(_path, &_file));
+    return _file->size(&_file_size);
+}
+
+Status BlockSpillReader::read(Block* block, bool* eos) {
+    DCHECK(_file != nullptr);
+    if (_offset >= _file_size) {
+        *eos = true;
+        return Status::OK();
+    }
+    *eos = false;
+
+    uint8_t len_buf[sizeof(uint64_t)];
+    Slice len_slice(len_buf, sizeof(len_buf));
+    RETURN_IF_ERROR(_file->read_at(_offset, &len_slice));
+    uint64_t len = decode_fixed64_le(len_buf);
+    _offset += sizeof(len_buf);
+    if (_offset + len > _file_size) {
+        return Status::Corruption(fmt::format("spill file {} is truncated, offset={}, len={}",
+                                              _path, _offset, len));
+    }
+
+    _buffer.resize(len);
+    Slice data_slice(_buffer.data(), len);
+    RETURN_IF_ERROR(_file->read_at(_offset, &data_slice));
+    _offset += len;
+
+    PBlock pblock;
+    if (!pblock.ParseFromString(_buffer)) {
+        return Status::Corruption(fmt::format("failed to parse spill block from {}", _path));
+    }
+    block->swap(Block(pblock));
+    return Status::OK();
+}
+
+Status BlockSpillReader::close() {
+    if (_file == nullptr) {
+        return Status::OK();
+    }
+    _file.reset();
+    _buffer.clear();
+    if (_delete_after_read) {
+        return BlockSpillManager::remove_file(_path);
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
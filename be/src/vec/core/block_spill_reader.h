@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+
+namespace doris {
+class RandomAccessFile;
+
+namespace vectorized {
+class Block;
+
+// Reads back the blocks written by BlockSpillWriter, in the order they were written.
+class BlockSpillReader {
+public:
+    // If 'delete_after_read' is true, the spill file is removed when the reader is closed.
+    BlockSpillReader(std::string path, bool delete_after_read = true)
+            : _path(std::move(path)), _delete_after_read(delete_after_read) {}
+    ~BlockSpillReader();
+
+    Status open();
+
+    // Read next block, set 'eos' to true when all blocks are read.
+    Status read(Block* block, bool* eos);
+
+    Status close();
+
+    const std::string& path() const { return _path; }
+
+private:
+    std::string _path;
+    bool _delete_after_read;
+    std::unique_ptr<RandomAccessFile> _file;
+    uint64_t _file_size = 0;
+    uint64_t _offset = 0;
+    std::string _buffer;
+};
+
+using BlockSpillReaderUPtr = std::unique_ptr<BlockSpillReader>;
+
+} // namespace vectorized
+} // namespace doris
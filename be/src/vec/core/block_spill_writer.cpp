@@ -0,0 +1,145 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/block_spill_writer.h"
+
+#include <fmt/format.h>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "gen_cpp/data.pb.h"
+#include "runtime/exec_env.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/block_compression.h"
+#include "util/coding.h"
+#include "util/threadpool.h"
+#include "util/uid_util.h"
+#include "vec/core/block.h"
+#include "vec/core/block_spill_manager.h"
+
+namespace doris::vectorized {
+
+BlockSpillWriter::~BlockSpillWriter() {
+    if (_file != nullptr) {
+        close();
+    }
+}
+
+std::string BlockSpillWriter::gen_spill_path(const TUniqueId& query_id,
+                                             const std::string& prefix) {
+    auto* manager = ExecEnv::GetInstance()->block_spill_mgr();
+    if (manager != nullptr) {
+        return manager->gen_spill_path(query_id, prefix);
+    }
+    std::string tmp_dir = ExecEnv::GetInstance()->tmp_file_mgr()->get_tmp_dir_path();
+    return fmt::format("{}/{}_{}_{}.spill", tmp_dir, print_id(query_id), prefix,
+                       UniqueId::gen_uid().to_string());
+}
+
+Status BlockSpillWriter::open() {
+    DCHECK(_file == nullptr);
+    RETURN_IF_ERROR(get_block_compression_codec(segment_v2::CompressionTypePB::LZ4, _codec));
+    RETURN_IF_ERROR(Env::Default()->new_writable_file(_path, &_file));
+    if (_manager != nullptr && _manager->io_thread_pool() != nullptr) {
+        // the records of a file are appended in order
+        _io_token = _manager->io_thread_pool()->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+    return Status::OK();
+}
+
+Status BlockSpillWriter::write(const Block& block) {
+    DCHECK(_file != nullptr);
+    if (block.rows() == 0) {
+        return Status::OK();
+    }
+
+    RETURN_IF_ERROR(_async_status());
+
+    PBlock pblock;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    RETURN_IF_ERROR(block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes,
+                                    segment_v2::CompressionTypePB::LZ4, _codec.get(), true));
+
+    // the record is the length of the serialized PBlock followed by it
+    auto record = std::make_shared<std::string>(sizeof(uint64_t), '\0');
+    if (!pblock.AppendToString(record.get())) {
+        return Status::InternalError(fmt::format("failed to serialize spill block to {}", _path));
+    }
+    encode_fixed64_le(reinterpret_cast<uint8_t*>(record->data()),
+                      record->size() - sizeof(uint64_t));
+    int64_t record_bytes = record->size();
+    if (_manager != nullptr) {
+        RETURN_IF_ERROR(_manager->acquire_space(_query_id, _path, record_bytes));
+    }
+
+    ++_written_blocks;
+    _written_rows += block.rows();
+    _written_bytes += record_bytes;
+
+    if (_io_token == nullptr) {
+        return _append(*record);
+    }
+    if (_pending_bytes.load() + record_bytes > config::spill_io_pending_bytes_per_writer) {
+        _io_token->wait();
+        RETURN_IF_ERROR(_async_status());
+    }
+    _pending_bytes += record_bytes;
+    Status st = _io_token->submit_func([this, record, record_bytes]() {
+        if (_async_status().ok()) {
+            Status st = _append(*record);
+            if (!st.ok()) {
+                std::lock_guard l(_status_lock);
+                _status = st;
+            }
+        }
+        _pending_bytes -= record_bytes;
+    });
+    if (!st.ok()) {
+        // the pool is full or shut down, append it here after the pending ones
+        _pending_bytes -= record_bytes;
+        _io_token->wait();
+        RETURN_IF_ERROR(_async_status());
+        return _append(*record);
+    }
+    return Status::OK();
+}
+
+Status BlockSpillWriter::_append(const std::string& record) {
+    return _file->append(Slice(record));
+}
+
+Status BlockSpillWriter::_async_status() {
+    std::lock_guard l(_status_lock);
+    return _status;
+}
+
+Status BlockSpillWriter::close() {
+    if (_file == nullptr) {
+        return Status::OK();
+    }
+    if (_io_token != nullptr) {
+        _io_token->wait();
+        _io_token.reset();
+    }
+    Status st = _async_status();
+    Status close_st = _file->close();
+    _file.reset();
+    return st.ok() ? close_st : st;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+
+namespace doris {
+class BlockCompressionCodec;
+class ThreadPoolToken;
+class WritableFile;
+
+namespace vectorized {
+class Block;
+class BlockSpillManager;
+
+// Writes a sequence of blocks to a local spill file.
+// Every block is serialized to a PBlock compressed by LZ4 and stored as a length prefixed
+// record, the file can be read back in the same order by BlockSpillReader.
+// If 'manager' is given, the written bytes are accounted to query 'query_id', and the
+// records are appended by the spill io thread pool of the manager, in which case an error
+// of appending is returned by a later write() or close().
+class BlockSpillWriter {
+public:
+    explicit BlockSpillWriter(std::string path, BlockSpillManager* manager = nullptr,
+                              const TUniqueId& query_id = TUniqueId())
+            : _path(std::move(path)), _manager(manager), _query_id(query_id) {}
+    ~BlockSpillWriter();
+
+    // Generate a unique spill file path in one of the tmp dirs managed by TmpFileMgr,
+    // the tmp dirs of the disks are used in turn.
+    static std::string gen_spill_path(const TUniqueId& query_id, const std::string& prefix);
+
+    Status open();
+
+    Status write(const Block& block);
+
+    // Wait for the pending appends and close the file.
+    Status close();
+
+    const std::string& path() const { return _path; }
+
+    int64_t written_blocks() const { return _written_blocks; }
+    int64_t written_rows() const { return _written_rows; }
+    int64_t written_bytes() const { return _written_bytes; }
+
+private:
+    Status _append(const std::string& record);
+    Status _async_status();
+
+    std::string _path;
+    BlockSpillManager* _manager;
+    TUniqueId _query_id;
+    std::unique_ptr<WritableFile> _file;
+    std::unique_ptr<BlockCompressionCodec> _codec;
+
+    std::unique_ptr<ThreadPoolToken> _io_token;
+    std::atomic<int64_t> _pending_bytes {0};
+    std::mutex _status_lock;
+    // the first error of the async appends
+    Status _status;
+
+    int64_t _written_blocks = 0;
+    int64_t _written_rows = 0;
+    int64_t _written_bytes = 0;
+};
+
+using BlockSpillWriterUPtr = std::unique_ptr<BlockSpillWriter>;
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,171 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/normalized_key.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+#define APPLY_FOR_NORMALIZED_INTEGER_TYPES(M) \
+    M(UInt8)                                  \
+    M(UInt16)                                 \
+    M(UInt32)                                 \
+    M(UInt64)                                 \
+    M(Int8)                                   \
+    M(Int16)                                  \
+    M(Int32)                                  \
+    M(Int64)                                  \
+    M(Int128)
+
+/// Write the first `size` bytes of the big endian integers of the column to the keys.
+template <typename T>
+void encode_integers(const IColumn& column, const NullMap* null_map, int direction,
+                     size_t offset, size_t size, UInt8* keys) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    constexpr size_t value_bytes = sizeof(T);
+    const auto& data = assert_cast<const ColumnVector<T>&>(column).get_data();
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (null_map != nullptr && (*null_map)[i]) {
+            continue;
+        }
+        UnsignedT value = static_cast<UnsignedT>(data[i]);
+        if constexpr (std::is_signed_v<T>) {
+            value ^= UnsignedT(1) << (value_bytes * 8 - 1);
+        }
+        if (direction < 0) {
+            value = ~value;
+        }
+        UInt8* key = keys + i * NormalizedKeys::KEY_SIZE + offset;
+        for (size_t b = 0; b < size; ++b) {
+            key[b] = static_cast<UInt8>(value >> ((value_bytes - 1 - b) * 8));
+        }
+    }
+}
+
+void encode_strings(const ColumnString& column, const NullMap* null_map, int direction,
+                    size_t offset, UInt8* keys) {
+    size_t size = NormalizedKeys::KEY_SIZE - offset;
+    for (size_t i = 0; i < column.size(); ++i) {
+        UInt8* key = keys + i * NormalizedKeys::KEY_SIZE + offset;
+        if (null_map != nullptr && (*null_map)[i]) {
+            continue;
+        }
+        auto value = column.get_data_at(i);
+        memcpy(key, value.data, std::min(size, value.size));
+        if (direction < 0) {
+            for (size_t b = 0; b < size; ++b) {
+                key[b] = ~key[b];
+            }
+        }
+    }
+}
+
+/// The number of bytes of the values of the column, 0 for strings and -1 if the column
+/// could not be encoded.
+int value_bytes(const IColumn& column) {
+#define M(T) \
+    if (check_and_get_column<ColumnVector<T>>(column)) return sizeof(T);
+    APPLY_FOR_NORMALIZED_INTEGER_TYPES(M)
+#undef M
+    if (check_and_get_column<ColumnString>(column)) {
+        return 0;
+    }
+    return -1;
+}
+
+} // namespace
+
+bool NormalizedKeys::build(const ColumnRawPtrs& columns, const SortDescription& description) {
+    _data.clear();
+    _complete = true;
+    _layout = 0;
+    if (columns.empty() || columns[0]->empty()) {
+        return false;
+    }
+    size_t rows = columns[0]->size();
+    size_t offset = 0;
+    std::vector<UInt8> data(rows * KEY_SIZE, 0);
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const auto& desc = description[c];
+        const IColumn* column = columns[c];
+        if (offset == KEY_SIZE || desc.collator || is_column_const(*column)) {
+            _complete = false;
+            break;
+        }
+        const NullMap* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            column = &nullable->get_nested_column();
+            null_map = &nullable->get_null_map_data();
+        }
+        int bytes = value_bytes(*column);
+        if (bytes < 0) {
+            _complete = false;
+            break;
+        }
+        _layout = _layout * 31 + bytes * 2 + (null_map != nullptr) + 1;
+
+        if (null_map != nullptr) {
+            // the NULLs sort after the values if direction * nulls_direction > 0
+            const bool nulls_greater = desc.direction * desc.nulls_direction > 0;
+            for (size_t i = 0; i < rows; ++i) {
+                data[i * KEY_SIZE + offset] = (*null_map)[i] == nulls_greater;
+            }
+            if (++offset == KEY_SIZE) {
+                _complete = false;
+                break;
+            }
+        }
+
+        if (bytes == 0) {
+            encode_strings(assert_cast<const ColumnString&>(*column), null_map, desc.direction,
+                           offset, data.data());
+            offset = KEY_SIZE;
+            _complete = false;
+            break;
+        }
+        size_t size = std::min<size_t>(bytes, KEY_SIZE - offset);
+#define M(T)                                                                                 \
+    if (check_and_get_column<ColumnVector<T>>(*column)) {                                    \
+        encode_integers<T>(*column, null_map, desc.direction, offset, size, data.data());    \
+    }
+        APPLY_FOR_NORMALIZED_INTEGER_TYPES(M)
+#undef M
+        offset += size;
+        if (size < static_cast<size_t>(bytes)) {
+            _complete = false;
+            break;
+        }
+    }
+    if (offset == 0) {
+        _complete = false;
+        return false;
+    }
+    _data.swap(data);
+    return true;
+}
+
+#undef APPLY_FOR_NORMALIZED_INTEGER_TYPES
+
+} // namespace doris::vectorized
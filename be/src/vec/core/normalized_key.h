@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "vec/columns/column.h"
+#include "vec/core/sort_description.h"
+
+namespace doris::vectorized {
+
+/** Order preserving binary prefixes of the sort keys of a block, a row sorts before another
+  * if its key is less by memcmp. The sort columns are encoded in order into the fixed size
+  * keys, a NULL flag byte first if the column is nullable, then the big endian integers with
+  * the sign bit flipped, or the leading bytes of the strings, inverted for descending order.
+  * Once a column can't be encoded fully, e.g. a string or an unsupported type, the keys only
+  * decide the rows whose keys differ, the equal ones are compared by the columns.
+  */
+class NormalizedKeys {
+public:
+    static constexpr size_t KEY_SIZE = 16;
+
+    /// Encode the rows of `columns` sorted by `description`, returns false if not even the
+    /// first column could be encoded.
+    bool build(const ColumnRawPtrs& columns, const SortDescription& description);
+
+    bool empty() const { return _data.empty(); }
+
+    /// Whether the keys compare the same as the sort columns, no tie breaker is needed.
+    bool complete() const { return _complete; }
+
+    /// Whether the keys of the two blocks are encoded the same and could be compared.
+    bool compatible_with(const NormalizedKeys& rhs) const {
+        return !empty() && !rhs.empty() && _layout == rhs._layout;
+    }
+
+    int compare(size_t row, const NormalizedKeys& rhs, size_t rhs_row) const {
+        return memcmp(key(row), rhs.key(rhs_row), KEY_SIZE);
+    }
+
+    const UInt8* key(size_t row) const { return _data.data() + row * KEY_SIZE; }
+
+private:
+    std::vector<UInt8> _data;
+    bool _complete = false;
+    // the types and nullabilities of the columns encoded
+    size_t _layout = 0;
+};
+
+} // namespace doris::vectorized
@@ -22,8 +22,12 @@
 
 #include <pdqsort.h>
 
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/radix_sort.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/core/normalized_key.h"
 
 namespace doris::vectorized {
 
@@ -101,6 +105,137 @@ struct PartialSortingLessWithCollation {
     }
 };
 
+namespace {
+/// Below this number of rows the comparison sort is better than radix sort.
+constexpr size_t RADIX_SORT_MIN_ROWS = 256;
+
+struct PackedKeyWithIndex {
+    UInt64 key;
+    UInt32 index;
+};
+
+struct PackedKeyRadixSortTraits : RadixSortNumTraits<UInt64> {
+    using Element = PackedKeyWithIndex;
+    static UInt64& extract_key(Element& elem) { return elem.key; }
+};
+
+#define APPLY_FOR_PACKED_KEY_TYPES(M) \
+    M(UInt8)                          \
+    M(UInt16)                         \
+    M(UInt32)                         \
+    M(UInt64)                         \
+    M(Int8)                           \
+    M(Int16)                          \
+    M(Int32)                          \
+    M(Int64)
+
+/// Number of bits of the key packed from the column, 0 if the column could not be packed.
+size_t packed_key_bits(const IColumn& column) {
+#define M(T) \
+    if (check_and_get_column<ColumnVector<T>>(column)) return sizeof(T) * 8;
+    APPLY_FOR_PACKED_KEY_TYPES(M)
+#undef M
+    return 0;
+}
+
+/// Append the bits of the column to the lower end of keys. The sign bit is flipped so the
+/// order of unsigned keys is the order of signed values, and the bits are inverted for
+/// descending order. A nullable column takes one more bit to order NULLs before or after
+/// the values.
+template <typename T>
+void append_packed_key(const IColumn& column, const NullMap* null_map, int direction,
+                       int nulls_direction, PaddedPODArray<PackedKeyWithIndex>& keys) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    constexpr size_t value_bits = sizeof(T) * 8;
+    constexpr UInt64 value_mask =
+            value_bits == 64 ? ~UInt64(0) : (UInt64(1) << (value_bits % 64)) - 1;
+
+    const auto& data = assert_cast<const ColumnVector<T>&>(column).get_data();
+    const bool nulls_greater = direction * nulls_direction > 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        UInt64 value = static_cast<UnsignedT>(data[i]);
+        if constexpr (std::is_signed_v<T>) {
+            value ^= UInt64(1) << (value_bits - 1);
+        }
+        if (direction < 0) {
+            value = ~value & value_mask;
+        }
+
+        UInt64& key = keys[i].key;
+        if (null_map != nullptr) {
+            bool is_null = (*null_map)[i];
+            key = (key << 1) | (is_null == nulls_greater);
+            if (is_null) {
+                value = 0;
+            }
+        }
+        if constexpr (value_bits == 64) {
+            key = value;
+        } else {
+            key = (key << value_bits) | value;
+        }
+    }
+}
+
+/// Sort by radix sort if all the sort columns are integers (date and datetime included)
+/// whose bits could be packed into one UInt64 key, return false if not.
+bool sort_by_packed_keys(const ColumnsWithSortDescriptions& columns, size_t rows,
+                         IColumn::Permutation& perm) {
+    if (rows < RADIX_SORT_MIN_ROWS || rows > std::numeric_limits<UInt32>::max()) {
+        return false;
+    }
+
+    size_t total_bits = 0;
+    for (const auto& [column, desc] : columns) {
+        if (desc.collator) {
+            return false;
+        }
+        const IColumn* nested_column = column;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            nested_column = &nullable->get_nested_column();
+            ++total_bits;
+        }
+        size_t bits = packed_key_bits(*nested_column);
+        if (bits == 0) {
+            return false;
+        }
+        total_bits += bits;
+    }
+    if (total_bits > 64) {
+        return false;
+    }
+
+    PaddedPODArray<PackedKeyWithIndex> keys(rows);
+    for (UInt32 i = 0; i < rows; ++i) {
+        keys[i] = {0, i};
+    }
+    for (const auto& [column, desc] : columns) {
+        const IColumn* nested_column = column;
+        const NullMap* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            nested_column = &nullable->get_nested_column();
+            null_map = &nullable->get_null_map_data();
+        }
+#define M(T)                                                                              \
+    if (check_and_get_column<ColumnVector<T>>(*nested_column)) {                          \
+        append_packed_key<T>(*nested_column, null_map, desc.direction, desc.nulls_direction, \
+                             keys);                                                       \
+        continue;                                                                         \
+    }
+        APPLY_FOR_PACKED_KEY_TYPES(M)
+#undef M
+    }
+
+    RadixSort<PackedKeyRadixSortTraits>::execute_lsd(keys.data(), rows);
+    for (size_t i = 0; i < rows; ++i) {
+        perm[i] = keys[i].index;
+    }
+    return true;
+}
+
+#undef APPLY_FOR_PACKED_KEY_TYPES
+} // namespace
+
 void sort_block(Block& block, const SortDescription& description, UInt64 limit) {
     if (!block) return;
 
@@ -128,10 +263,28 @@ void sort_block(Block& block, const SortDescription& description, UInt64 limit)
 
         ColumnsWithSortDescriptions columns_with_sort_desc =
                 get_columns_with_sort_description(block, description);
-        {
+        if (!sort_by_packed_keys(columns_with_sort_desc, size, perm)) {
             PartialSortingLess less(columns_with_sort_desc);
-
-            if (limit)
+            NormalizedKeys keys;
+            ColumnRawPtrs sort_columns;
+            for (const auto& [column, _] : columns_with_sort_desc) {
+                sort_columns.push_back(column);
+            }
+
+            if (keys.build(sort_columns, description)) {
+                // most rows are decided by the keys, the columns only break the ties
+                auto key_less = [&](size_t a, size_t b) {
+                    int res = keys.compare(a, keys, b);
+                    if (res != 0 || keys.complete()) {
+                        return res < 0;
+                    }
+                    return less(a, b);
+                };
+                if (limit)
+                    std::partial_sort(perm.begin(), perm.begin() + limit, perm.end(), key_less);
+                else
+                    pdqsort(perm.begin(), perm.end(), key_less);
+            } else if (limit)
                 std::partial_sort(perm.begin(), perm.begin() + limit, perm.end(), less);
             else
                 pdqsort(perm.begin(), perm.end(), less);
@@ -26,6 +26,7 @@
 #include "vec/common/typeid_cast.h"
 #include "vec/core/block.h"
 #include "vec/core/column_numbers.h"
+#include "vec/core/normalized_key.h"
 #include "vec/core/sort_description.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/runtime/vdata_stream_recvr.h"
@@ -52,6 +53,10 @@ struct SortCursorImpl {
     /** Is there at least one column with Collator. */
     bool has_collation = false;
 
+    /// Only built for multiple sort columns, the rows of different cursors are compared by
+    /// them first if they are encoded the same.
+    NormalizedKeys normalized_keys;
+
     SortCursorImpl() = default;
     virtual ~SortCursorImpl() = default;
 
@@ -95,6 +100,9 @@ struct SortCursorImpl {
 
         pos = 0;
         rows = all_columns[0]->size();
+        if (sort_columns_size > 1) {
+            normalized_keys.build(sort_columns, desc);
+        }
     }
 
     bool isFirst() const { return pos == 0; }
@@ -163,6 +171,13 @@ struct SortCursor {
 
     /// The specified row of this cursor is greater than the specified row of another cursor.
     int8_t greater_at(const SortCursor& rhs, size_t lhs_pos, size_t rhs_pos) const {
+        const auto& keys = impl->normalized_keys;
+        if (keys.compatible_with(rhs.impl->normalized_keys)) {
+            int res = keys.compare(lhs_pos, rhs.impl->normalized_keys, rhs_pos);
+            if (res > 0) return 1;
+            if (res < 0) return -1;
+            if (keys.complete()) return 0;
+        }
         for (size_t i = 0; i < impl->sort_columns_size; ++i) {
             int direction = impl->desc[i].direction;
             int nulls_direction = impl->desc[i].nulls_direction;
@@ -31,6 +31,9 @@ struct RowRef {
     // Use in right join to mark row is visited
     // TODO: opt the varaible to use it only need
     bool visited = false;
+    // Use in intersect node to record how many children in a row matched the row,
+    // it fits in the padding so the size of RowRef is unchanged
+    uint16_t matched_children = 0;
 
     RowRef() {}
     RowRef(size_t row_num_count, uint8_t block_offset_, bool is_visited = false)
@@ -17,10 +17,19 @@
 
 #include "vec/exec/join/vhash_join_node.h"
 
+#include <numeric>
+
+#include "common/config.h"
+#include "env/env.h"
 #include "gen_cpp/PlanNodes_types.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/memory_reservation_mgr.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
+#include "vec/common/sip_hash.h"
+#include "vec/core/block_spill_manager.h"
 #include "vec/core/materialize_block.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -72,7 +81,7 @@ struct ProcessHashTableBuild {
         }
         hash_table_ctx.hash_table.reset_resize_timer();
 
-        vector<int>& inserted_rows = _join_node->_inserted_rows[&_acquired_block];
+        vector<int>& inserted_rows = (*_join_node->_inserted_rows)[&_acquired_block];
         if (has_runtime_filter) {
             inserted_rows.reserve(_batch_size);
         }
@@ -85,9 +94,9 @@ struct ProcessHashTableBuild {
             }
 
             auto emplace_result =
-                    key_getter.emplace_key(hash_table_ctx.hash_table, k, _join_node->_arena);
+                    key_getter.emplace_key(hash_table_ctx.hash_table, k, *_join_node->_arena);
             if (k + 1 < _rows) {
-                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, _join_node->_arena);
+                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, *_join_node->_arena);
             }
 
             if (emplace_result.is_inserted()) {
@@ -98,7 +107,7 @@ struct ProcessHashTableBuild {
             } else {
                 if constexpr (!build_unique) {
                     /// The first element of the list is stored in the value of the hash table, the rest in the pool.
-                    emplace_result.get_mapped().insert({k, _offset}, _join_node->_arena);
+                    emplace_result.get_mapped().insert({k, _offset}, *_join_node->_arena);
                     if (has_runtime_filter) {
                         inserted_rows.push_back(k);
                     }
@@ -124,6 +133,177 @@ private:
     uint8_t _offset;
 };
 
+// Insert the rows of a build block into a two level hash table by multiple threads. The rows
+// are partitioned by the bucket of the first level they belong to, and every thread only
+// inserts into its own buckets, so no lock is needed. Each thread keeps the serialized keys and
+// the row lists in its own arena.
+template <class HashTableContext, bool ignore_null, bool build_unique>
+struct ProcessHashTableParallelBuild {
+    using KeyGetter = typename HashTableContext::State;
+    using Mapped = typename HashTableContext::Mapped;
+    using HashTable = typename HashTableContext::HashTable;
+    static constexpr size_t NUM_BUCKETS = HashTable::NUM_BUCKETS;
+    static_assert(NUM_BUCKETS <= 256, "the bucket of a row is stored in uint8_t");
+
+    ProcessHashTableParallelBuild(int rows, Block& acquired_block, ColumnRawPtrs& build_raw_ptrs,
+                                  HashJoinNode* join_node, uint8_t offset, int parallelism)
+            : _rows(rows),
+              _acquired_block(acquired_block),
+              _build_raw_ptrs(build_raw_ptrs),
+              _join_node(join_node),
+              _offset(offset),
+              _parallelism(parallelism) {}
+
+    Status operator()(RuntimeState* state, HashTableContext& hash_table_ctx,
+                      ConstNullMapPtr null_map, bool has_runtime_filter) {
+        auto& hash_table = hash_table_ctx.hash_table;
+        int64_t old_bucket_bytes = hash_table.get_buffer_size_in_bytes();
+
+        Defer defer {[&]() {
+            int64_t bucket_size = hash_table.get_buffer_size_in_cells();
+            int64_t bucket_bytes = hash_table.get_buffer_size_in_bytes();
+            _join_node->_hash_table_mem_tracker->consume(bucket_bytes - old_bucket_bytes);
+            _join_node->_mem_used += bucket_bytes - old_bucket_bytes;
+            COUNTER_SET(_join_node->_build_buckets_counter, bucket_size);
+        }};
+
+        auto& arenas = _join_node->_parallel_build_arenas;
+        while (arenas.size() < _parallelism) {
+            arenas.emplace_back(std::make_shared<Arena>());
+        }
+        _row_buckets.resize(_rows);
+        _partition_rows.resize(_parallelism);
+        _bucket_rows.resize(_parallelism);
+        _inserted_rows.resize(_parallelism);
+
+        auto token = state->exec_env()->join_build_thread_pool()->new_token(
+                ThreadPool::ExecutionMode::CONCURRENT, _parallelism);
+        auto run_tasks = [&](const std::function<void(int)>& task) {
+            for (int i = 0; i < _parallelism; ++i) {
+                auto st = token->submit_func([&, i]() {
+                    SCOPED_ATTACH_TASK_THREAD(state, _join_node->mem_tracker());
+                    task(i);
+                });
+                // run the task in place if the pool is full
+                if (!st.ok()) {
+                    task(i);
+                }
+            }
+            token->wait();
+        };
+
+        {
+            SCOPED_TIMER(_join_node->_build_table_partition_timer);
+            run_tasks([&](int range) { _partition_range(hash_table, null_map, range); });
+        }
+
+        SCOPED_TIMER(_join_node->_build_table_insert_timer);
+        hash_table.reset_resize_timer();
+        run_tasks([&](int partition) {
+            _build_partition(hash_table, *arenas[partition], partition, has_runtime_filter);
+        });
+        COUNTER_UPDATE(_join_node->_build_table_expanse_timer, hash_table.get_resize_timer_value());
+        COUNTER_UPDATE(_join_node->_parallel_build_blocks_counter, 1);
+
+        if (has_runtime_filter) {
+            vector<int>& inserted_rows = (*_join_node->_inserted_rows)[&_acquired_block];
+            for (auto& rows : _inserted_rows) {
+                inserted_rows.insert(inserted_rows.end(), rows.begin(), rows.end());
+            }
+        }
+        return Status::OK();
+    }
+
+private:
+    // Compute the bucket of the rows in the `range`-th slice of the block, the bucket `b`
+    // belongs to the partition `b % _parallelism`.
+    void _partition_range(HashTable& hash_table, ConstNullMapPtr null_map, int range) {
+        size_t begin = static_cast<size_t>(_rows) * range / _parallelism;
+        size_t end = static_cast<size_t>(_rows) * (range + 1) / _parallelism;
+        KeyGetter key_getter(_build_raw_ptrs, _join_node->_build_key_sz, nullptr);
+        // the serialized keys are only needed to compute the hash values
+        Arena hash_arena;
+
+        auto& partition_rows = _partition_rows[range];
+        partition_rows.resize(_parallelism);
+        auto& bucket_rows = _bucket_rows[range];
+        bucket_rows.assign(NUM_BUCKETS, 0);
+        for (size_t k = begin; k < end; ++k) {
+            if constexpr (ignore_null) {
+                if ((*null_map)[k]) {
+                    continue;
+                }
+            }
+            size_t bucket =
+                    HashTable::get_bucket_from_hash(key_getter.get_hash(hash_table, k, hash_arena));
+            _row_buckets[k] = bucket;
+            partition_rows[bucket % _parallelism].push_back(k);
+            ++bucket_rows[bucket];
+            if ((k & 4095) == 4095) {
+                hash_arena.clear();
+            }
+        }
+    }
+
+    void _build_partition(HashTable& hash_table, Arena& arena, int partition,
+                          bool has_runtime_filter) {
+        // only not build_unique, we need expanse hash table before insert data
+        if constexpr (!build_unique) {
+            for (size_t bucket = partition; bucket < NUM_BUCKETS; bucket += _parallelism) {
+                size_t rows = 0;
+                for (auto& bucket_rows : _bucket_rows) {
+                    rows += bucket_rows[bucket];
+                }
+                hash_table.impls[bucket].expanse_for_add_elem(rows);
+            }
+        }
+
+        KeyGetter key_getter(_build_raw_ptrs, _join_node->_build_key_sz, nullptr);
+        auto& inserted_rows = _inserted_rows[partition];
+        for (auto& range_rows : _partition_rows) {
+            const auto& rows = range_rows[partition];
+            for (size_t i = 0; i < rows.size(); ++i) {
+                size_t k = rows[i];
+                auto& bucket_table = hash_table.impls[_row_buckets[k]];
+                auto emplace_result = key_getter.emplace_key(bucket_table, k, arena);
+                if (i + 1 < rows.size()) {
+                    key_getter.prefetch(hash_table.impls[_row_buckets[rows[i + 1]]], rows[i + 1],
+                                        arena);
+                }
+
+                if (emplace_result.is_inserted()) {
+                    new (&emplace_result.get_mapped()) Mapped({k, _offset});
+                    if (has_runtime_filter) {
+                        inserted_rows.push_back(k);
+                    }
+                } else {
+                    if constexpr (!build_unique) {
+                        /// The first element of the list is stored in the value of the hash table, the rest in the pool.
+                        emplace_result.get_mapped().insert({k, _offset}, arena);
+                        if (has_runtime_filter) {
+                            inserted_rows.push_back(k);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    const int _rows;
+    Block& _acquired_block;
+    ColumnRawPtrs& _build_raw_ptrs;
+    HashJoinNode* _join_node;
+    uint8_t _offset;
+    const int _parallelism;
+
+    std::vector<uint8_t> _row_buckets;
+    // rows of each partition in each range, indexed by [range][partition]
+    std::vector<std::vector<std::vector<uint32_t>>> _partition_rows;
+    // row count of each bucket in each range, indexed by [range][bucket]
+    std::vector<std::vector<uint32_t>> _bucket_rows;
+    std::vector<vector<int>> _inserted_rows;
+};
+
 template <class HashTableContext>
 struct ProcessRuntimeFilterBuild {
     ProcessRuntimeFilterBuild(HashJoinNode* join_node) : _join_node(join_node) {}
@@ -138,10 +318,10 @@ struct ProcessRuntimeFilterBuild {
 
         RETURN_IF_ERROR(runtime_filter_slots.init(state, hash_table_ctx.hash_table.get_size()));
 
-        if (!runtime_filter_slots.empty() && !_join_node->_inserted_rows.empty()) {
+        if (!runtime_filter_slots.empty() && !_join_node->_inserted_rows->empty()) {
             {
                 SCOPED_TIMER(_join_node->_push_compute_timer);
-                runtime_filter_slots.insert(_join_node->_inserted_rows);
+                runtime_filter_slots.insert(*_join_node->_inserted_rows);
             }
         }
         {
@@ -162,11 +342,12 @@ struct ProcessHashTableProbe {
             : _join_node(join_node),
               _batch_size(batch_size),
               _probe_rows(probe_rows),
-              _build_blocks(join_node->_build_blocks),
+              _build_blocks(*join_node->_build_blocks),
               _probe_block(join_node->_probe_block),
               _probe_index(join_node->_probe_index),
               _probe_raw_ptrs(join_node->_probe_columns),
               _items_counts(join_node->_items_counts),
+              _probe_hashes(join_node->_probe_hashes),
               _build_block_offsets(join_node->_build_block_offsets),
               _build_block_rows(join_node->_build_block_rows),
               _rows_returned_counter(join_node->_rows_returned_counter),
@@ -174,6 +355,61 @@ struct ProcessHashTableProbe {
               _build_side_output_timer(join_node->_build_side_output_timer),
               _probe_side_output_timer(join_node->_probe_side_output_timer) {}
 
+    // Hashes all the keys of a new probe block at first, so that the buckets of the keys
+    // PREFETCH_STEP rows ahead can be prefetched while probing, instead of stalling on the
+    // cache miss of every key of a large hash table.
+    static constexpr int PREFETCH_STEP = 64;
+
+    template <typename KeyGetter>
+    void init_probe_hashes(HashTableContext& hash_table_ctx, KeyGetter& key_getter) {
+        if constexpr (HashTableContext::batched_probe) {
+            if (_probe_index != 0 || use_direct_map(hash_table_ctx)) {
+                return;
+            }
+            auto& hash_table = hash_table_ctx.hash_table;
+            _probe_hashes.resize(_probe_rows);
+            for (size_t i = 0; i < _probe_rows; ++i) {
+                _probe_hashes[i] = key_getter.get_hash(hash_table, i, _arena);
+            }
+            for (size_t i = 0; i < std::min<size_t>(PREFETCH_STEP, _probe_rows); ++i) {
+                hash_table.prefetch_by_hash(_probe_hashes[i]);
+            }
+        }
+    }
+
+    static bool use_direct_map(const HashTableContext& hash_table_ctx) {
+        if constexpr (HashTableContext::direct_mappable) {
+            return !hash_table_ctx.direct_map.empty();
+        }
+        return false;
+    }
+
+    template <typename KeyGetter>
+    auto find_probe_key(HashTableContext& hash_table_ctx, KeyGetter& key_getter) {
+        using FindResult = typename KeyGetter::FindResult;
+        auto& hash_table = hash_table_ctx.hash_table;
+        if constexpr (HashTableContext::direct_mappable) {
+            if (use_direct_map(hash_table_ctx)) {
+                // the keys less than the min wrap around to be out of the range as well
+                size_t index = size_t(key_getter.get_key_holder(_probe_index, _arena) -
+                                      hash_table_ctx.direct_map_min);
+                auto mapped = index < hash_table_ctx.direct_map.size()
+                                      ? hash_table_ctx.direct_map[index]
+                                      : nullptr;
+                return FindResult(mapped, mapped != nullptr);
+            }
+        }
+        if constexpr (HashTableContext::batched_probe) {
+            if (_probe_index + PREFETCH_STEP < _probe_rows) {
+                hash_table.prefetch_by_hash(_probe_hashes[_probe_index + PREFETCH_STEP]);
+            }
+            return key_getter.find_key_with_hash(hash_table, _probe_index,
+                                                 _probe_hashes[_probe_index], _arena);
+        } else {
+            return key_getter.find_key(hash_table, _probe_index, _arena);
+        }
+    }
+
     // output build side result column
     template <bool have_other_join_conjunct = false>
     void build_side_output_column(MutableColumns& mcol, int column_offset, int column_length,
@@ -275,6 +511,7 @@ struct ProcessHashTableProbe {
 
         {
             SCOPED_TIMER(_search_hashtable_timer);
+            init_probe_hashes(hash_table_ctx, key_getter);
             for (; _probe_index < _probe_rows;) {
                 if constexpr (ignore_null) {
                     if ((*null_map)[_probe_index]) {
@@ -284,11 +521,9 @@ struct ProcessHashTableProbe {
                 }
                 int last_offset = current_offset;
                 auto find_result = (*null_map)[_probe_index]
-                                           ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
-                                                                          _probe_index,
-                                                                          _arena)) {nullptr, false}
-                                           : key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 _probe_index, _arena);
+                                           ? decltype(find_probe_key(hash_table_ctx,
+                                                                     key_getter)) {nullptr, false}
+                                           : find_probe_key(hash_table_ctx, key_getter);
 
                 if constexpr (JoinOpType::value == TJoinOp::LEFT_ANTI_JOIN) {
                     if (!find_result.is_found()) {
@@ -313,9 +548,11 @@ struct ProcessHashTableProbe {
                             }
                         } else {
                             // prefetch is more useful while matching to multiple rows
-                            if (_probe_index + 2 < _probe_rows)
-                                key_getter.prefetch(hash_table_ctx.hash_table, _probe_index + 2,
-                                                    _arena);
+                            if constexpr (!HashTableContext::batched_probe) {
+                                if (_probe_index + 2 < _probe_rows)
+                                    key_getter.prefetch(hash_table_ctx.hash_table,
+                                                        _probe_index + 2, _arena);
+                            }
 
                             for (auto it = mapped.begin(); it.ok(); ++it) {
                                 if constexpr (!is_right_semi_anti_join) {
@@ -394,6 +631,7 @@ struct ProcessHashTableProbe {
 
         int current_offset = 0;
 
+        init_probe_hashes(hash_table_ctx, key_getter);
         for (; _probe_index < _probe_rows;) {
             // ignore null rows
             if constexpr (ignore_null) {
@@ -406,9 +644,8 @@ struct ProcessHashTableProbe {
             auto last_offset = current_offset;
             auto find_result =
                     (*null_map)[_probe_index]
-                            ? decltype(key_getter.find_key(hash_table_ctx.hash_table, _probe_index,
-                                                           _arena)) {nullptr, false}
-                            : key_getter.find_key(hash_table_ctx.hash_table, _probe_index, _arena);
+                            ? decltype(find_probe_key(hash_table_ctx, key_getter)) {nullptr, false}
+                            : find_probe_key(hash_table_ctx, key_getter);
 
             if (find_result.is_found()) {
                 auto& mapped = find_result.get_mapped();
@@ -639,6 +876,7 @@ private:
     Arena _arena;
 
     std::vector<uint32_t>& _items_counts;
+    std::vector<size_t>& _probe_hashes;
     std::vector<int8_t>& _build_block_offsets;
     std::vector<int>& _build_block_rows;
 
@@ -664,14 +902,21 @@ HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const Descr
           _is_outer_join(_match_all_build || _match_all_probe),
           _hash_output_slot_ids(tnode.hash_join_node.__isset.hash_output_slot_ids
                                         ? tnode.hash_join_node.hash_output_slot_ids
-                                        : std::vector<SlotId> {}) {
+                                        : std::vector<SlotId> {}),
+          _is_broadcast_join(tnode.hash_join_node.__isset.is_broadcast_join &&
+                             tnode.hash_join_node.is_broadcast_join) {
     _runtime_filter_descs = tnode.runtime_filters;
     init_join_op();
 
+    _arena = std::make_shared<Arena>();
+    _hash_table_variants = std::make_shared<JoinHashTableVariants>();
+    _build_blocks = std::make_shared<std::vector<Block>>();
+    _inserted_rows = std::make_shared<std::unordered_map<const Block*, std::vector<int>>>();
+
     // avoid vector expand change block address.
     // one block can store 4g data, _build_blocks can store 128*4g data.
     // if probe data bigger than 512g, runtime filter maybe will core dump when insert data.
-    _build_blocks.reserve(128);
+    _build_blocks->reserve(128);
 }
 
 HashJoinNode::~HashJoinNode() = default;
@@ -777,6 +1022,9 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _build_expr_call_timer = ADD_TIMER(build_phase_profile, "BuildExprCallTime");
     _build_table_expanse_timer = ADD_TIMER(build_phase_profile, "BuildTableExpanseTime");
     _build_rows_counter = ADD_COUNTER(build_phase_profile, "BuildRows", TUnit::UNIT);
+    _build_table_partition_timer = ADD_TIMER(build_phase_profile, "BuildTablePartitionTime");
+    _parallel_build_blocks_counter =
+            ADD_COUNTER(build_phase_profile, "ParallelBuildBlocks", TUnit::UNIT);
 
     // Probe phase
     auto probe_phase_profile = runtime_profile()->create_child("ProbePhase", true, true);
@@ -792,6 +1040,14 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _push_compute_timer = ADD_TIMER(runtime_profile(), "PushDownComputeTime");
     _build_buckets_counter = ADD_COUNTER(runtime_profile(), "BuildBuckets", TUnit::UNIT);
 
+    _enable_spill = state->enable_spill();
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_partitions_counter = ADD_COUNTER(runtime_profile(), "SpillPartitions", TUnit::UNIT);
+    _spill_build_rows_counter = ADD_COUNTER(runtime_profile(), "SpillBuildRows", TUnit::UNIT);
+    _spill_build_bytes_counter = ADD_COUNTER(runtime_profile(), "SpillBuildBytes", TUnit::BYTES);
+    _spill_probe_rows_counter = ADD_COUNTER(runtime_profile(), "SpillProbeRows", TUnit::UNIT);
+    _spill_probe_bytes_counter = ADD_COUNTER(runtime_profile(), "SpillProbeBytes", TUnit::BYTES);
+
     RETURN_IF_ERROR(
             VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
     RETURN_IF_ERROR(
@@ -810,6 +1066,17 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     // Hash Table Init
     _hash_table_init();
 
+    if (_should_share_hash_table(state)) {
+        _shared_hash_table_controller =
+                state->get_query_fragments_ctx()->get_shared_hash_table_controller();
+        _use_shared_hash_table = !_shared_hash_table_controller->should_build_hash_table(
+                state->fragment_instance_id(), id());
+        // the partitions of a spilled hash table are built one by one, they can't be shared
+        _enable_spill = false;
+        runtime_profile()->add_info_string("SharedHashTableFrom",
+                                           _use_shared_hash_table ? "other instance" : "self");
+    }
+
     _build_block_offsets.resize(state->batch_size());
     _build_block_rows.resize(state->batch_size());
     return Status::OK();
@@ -825,6 +1092,7 @@ Status HashJoinNode::close(RuntimeState* state) {
     if (_vother_join_conjunct_ptr) (*_vother_join_conjunct_ptr)->close(state);
 
     _hash_table_mem_tracker->release(_mem_used);
+    _remove_spill_files();
 
     return ExecNode::close(state);
 }
@@ -835,8 +1103,14 @@ Status HashJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
 
 Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_TIMER(_probe_timer);
 
+    if (_is_spilled && !_is_probe_spilled) {
+        RETURN_IF_ERROR(_spill_probe_side(state));
+        RETURN_IF_ERROR(_prepare_next_spill_partition(state));
+    }
+
     size_t probe_rows = _probe_block.rows();
     if ((probe_rows == 0 || _probe_index == probe_rows) && !_probe_eos) {
         _probe_index = 0;
@@ -854,7 +1128,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
 
         do {
             SCOPED_TIMER(_probe_next_timer);
-            RETURN_IF_ERROR(child(0)->get_next(state, &_probe_block, &_probe_eos));
+            RETURN_IF_ERROR(_get_next_probe_block(state, &_probe_block, &_probe_eos));
         } while (_probe_block.rows() == 0 && !_probe_eos);
 
         probe_rows = _probe_block.rows();
@@ -881,7 +1155,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
                         }
                         __builtin_unreachable();
                     },
-                    _hash_table_variants);
+                    *_hash_table_variants);
 
             RETURN_IF_ERROR(st);
         }
@@ -928,7 +1202,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
                         }
                     }
                 },
-                _hash_table_variants, _join_op_variants,
+                *_hash_table_variants, _join_op_variants,
                 make_bool_variant(_have_other_join_conjunct),
                 make_bool_variant(_probe_ignore_null));
     } else if (_probe_eos) {
@@ -948,7 +1222,15 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
                             LOG(FATAL) << "FATAL: uninited hash table";
                         }
                     },
-                    _hash_table_variants, _join_op_variants);
+                    *_hash_table_variants, _join_op_variants);
+            // the current spilled partition is finished, move on to the next one
+            if (st.ok() && *eos && _has_next_spill_partition()) {
+                RETURN_IF_ERROR(_prepare_next_spill_partition(state));
+                *eos = false;
+            }
+        } else if (_has_next_spill_partition()) {
+            RETURN_IF_ERROR(_prepare_next_spill_partition(state));
+            return Status::OK();
         } else {
             *eos = true;
             return Status::OK();
@@ -966,6 +1248,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
 
 Status HashJoinNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     RETURN_IF_ERROR(ExecNode::open(state));
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
@@ -994,13 +1277,96 @@ Status HashJoinNode::open(RuntimeState* state) {
 
 void HashJoinNode::_hash_table_build_thread(RuntimeState* state, std::promise<Status>* status) {
     SCOPED_ATTACH_TASK_THREAD(state, mem_tracker());
-    status->set_value(_hash_table_build(state));
+    if (_use_shared_hash_table) {
+        status->set_value(_acquire_shared_hash_table(state));
+        return;
+    }
+    Status st = _hash_table_build(state);
+    if (_shared_hash_table_controller != nullptr) {
+        // the waiting instances are notified even if the build failed
+        _publish_shared_hash_table(st);
+    }
+    status->set_value(st);
+}
+
+bool HashJoinNode::_should_share_hash_table(RuntimeState* state) const {
+    return config::enable_share_hash_table_for_broadcast_join && _is_broadcast_join &&
+           state->get_query_fragments_ctx() != nullptr && !_match_all_build &&
+           !_is_right_semi_anti && !_have_other_join_conjunct;
+}
+
+Status HashJoinNode::_acquire_shared_hash_table(RuntimeState* state) {
+    // The build side is not needed, the blocks sent to its receiver are dropped after it
+    // is closed.
+    RETURN_IF_ERROR(child(1)->close(state));
+
+    SCOPED_TIMER(_build_timer);
+    SharedHashTableContextPtr context;
+    RETURN_IF_ERROR(_shared_hash_table_controller->wait_for_signal(state, id(), &context));
+    _hash_table_variants =
+            std::static_pointer_cast<JoinHashTableVariants>(context->hash_table_variants);
+    _build_blocks = context->blocks;
+    _arena = context->arena;
+    _parallel_build_arenas = context->parallel_build_arenas;
+    _inserted_rows = context->inserted_rows;
+
+    // every instance publishes the runtime filters to its own consumers
+    return _build_runtime_filters(state);
+}
+
+void HashJoinNode::_publish_shared_hash_table(const Status& status) {
+    auto context = std::make_shared<SharedHashTableContext>();
+    context->status = status;
+    context->hash_table_variants = _hash_table_variants;
+    context->blocks = _build_blocks;
+    context->arena = _arena;
+    context->parallel_build_arenas = _parallel_build_arenas;
+    context->inserted_rows = _inserted_rows;
+    _shared_hash_table_controller->signal(id(), std::move(context));
 }
 
 Status HashJoinNode::_hash_table_build(RuntimeState* state) {
     RETURN_IF_ERROR(child(1)->open(state));
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER_ERR_CB("Hash join, while constructing the hash table.");
     SCOPED_TIMER(_build_timer);
+    RETURN_IF_ERROR(_build_hash_table_from(
+            state, [&](Block* block, bool* eos) { return child(1)->get_next(state, block, eos); },
+            _enable_spill));
+
+    if (_is_spilled) {
+        for (auto& writer : _spill_build_writers) {
+            RETURN_IF_ERROR(writer->close());
+            COUNTER_UPDATE(_spill_build_rows_counter, writer->written_rows());
+            COUNTER_UPDATE(_spill_build_bytes_counter, writer->written_bytes());
+        }
+        _spill_build_writers.clear();
+        if (_spill_runtime_filter_slots != nullptr) {
+            SCOPED_TIMER(_push_down_timer);
+            _spill_runtime_filter_slots->publish();
+        }
+        return Status::OK();
+    }
+
+    return _build_runtime_filters(state);
+}
+
+Status HashJoinNode::_build_runtime_filters(RuntimeState* state) {
+    return std::visit(
+            [&](auto&& arg) -> Status {
+                using HashTableCtxType = std::decay_t<decltype(arg)>;
+                if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
+                    ProcessRuntimeFilterBuild<HashTableCtxType> runtime_filter_build_process(this);
+                    return runtime_filter_build_process(state, arg);
+                } else {
+                    LOG(FATAL) << "FATAL: uninited hash table";
+                }
+            },
+            *_hash_table_variants);
+}
+
+Status HashJoinNode::_build_hash_table_from(RuntimeState* state,
+                                            const std::function<Status(Block*, bool*)>& get_block,
+                                            bool allow_spill) {
     MutableBlock mutable_block(child(1)->row_desc().tuple_descriptors());
 
     uint8_t index = 0;
@@ -1012,7 +1378,12 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
         block.clear_column_data();
         RETURN_IF_CANCELLED(state);
 
-        RETURN_IF_ERROR(child(1)->get_next(state, &block, &eos));
+        RETURN_IF_ERROR(get_block(&block, &eos));
+        if (allow_spill && _is_spilled) {
+            RETURN_IF_ERROR(_spill_build_block(block));
+            continue;
+        }
+
         _hash_table_mem_tracker->consume(block.allocated_bytes());
         _mem_used += block.allocated_bytes();
 
@@ -1020,13 +1391,18 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
             mutable_block.merge(block);
         }
 
+        if (allow_spill && _should_spill()) {
+            RETURN_IF_ERROR(_spill_build_side(state, mutable_block));
+            continue;
+        }
+
         // make one block for each 4 gigabytes
         constexpr static auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
         if (UNLIKELY(_mem_used - last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
-            _build_blocks.emplace_back(mutable_block.to_block());
+            _build_blocks->emplace_back(mutable_block.to_block());
             // TODO:: Rethink may we should do the proess after we recevie all build blocks ?
             // which is better.
-            RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[index], index));
 
             mutable_block = MutableBlock();
             ++index;
@@ -1034,20 +1410,248 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
         }
     }
 
-    _build_blocks.emplace_back(mutable_block.to_block());
-    RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+    if (allow_spill && _is_spilled) {
+        return Status::OK();
+    }
+    _build_blocks->emplace_back(mutable_block.to_block());
+    RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[index], index));
+    _init_direct_map();
+    return Status::OK();
+}
 
-    return std::visit(
-            [&](auto&& arg) -> Status {
+void HashJoinNode::_init_direct_map() {
+    std::visit(
+            [&](auto&& arg) {
                 using HashTableCtxType = std::decay_t<decltype(arg)>;
                 if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
-                    ProcessRuntimeFilterBuild<HashTableCtxType> runtime_filter_build_process(this);
-                    return runtime_filter_build_process(state, arg);
+                    if constexpr (HashTableCtxType::direct_mappable) {
+                        int64_t bytes = arg.init_direct_map();
+                        _hash_table_mem_tracker->consume(bytes);
+                        _mem_used += bytes;
+                        if (!arg.direct_map.empty()) {
+                            add_runtime_exec_option("Direct Mapped Build Keys");
+                        }
+                    }
                 } else {
                     LOG(FATAL) << "FATAL: uninited hash table";
                 }
             },
-            _hash_table_variants);
+            *_hash_table_variants);
+}
+
+bool HashJoinNode::_should_spill() const {
+    return !_is_spilled &&
+           _mem_used > MemoryReservationMgr::spill_threshold(
+                               config::spill_hash_join_threshold_bytes);
+}
+
+Status HashJoinNode::_spill_build_side(RuntimeState* state, MutableBlock& mutable_block) {
+    SCOPED_TIMER(_spill_timer);
+    _is_spilled = true;
+
+    int partition_count = std::max(config::spill_hash_join_partition_count, 1);
+    for (int i = 0; i < partition_count; ++i) {
+        _spill_build_paths.emplace_back(
+                BlockSpillWriter::gen_spill_path(state->query_id(), "hash_join_build"));
+        _spill_probe_paths.emplace_back(
+                BlockSpillWriter::gen_spill_path(state->query_id(), "hash_join_probe"));
+        auto writer = std::make_unique<BlockSpillWriter>(
+                _spill_build_paths.back(), state->exec_env()->block_spill_mgr(), state->query_id());
+        RETURN_IF_ERROR(writer->open());
+        _spill_build_writers.emplace_back(std::move(writer));
+    }
+    COUNTER_SET(_spill_partitions_counter, (int64_t)partition_count);
+
+    if (!_runtime_filter_descs.empty()) {
+        _spill_runtime_filter_slots = std::make_unique<VRuntimeFilterSlots>(
+                _probe_expr_ctxs, _build_expr_ctxs, _runtime_filter_descs);
+        // the build side is already known to be too large for IN filters
+        RETURN_IF_ERROR(
+                _spill_runtime_filter_slots->init(state, std::numeric_limits<int64_t>::max()));
+    }
+
+    for (auto& block : *_build_blocks) {
+        RETURN_IF_ERROR(_spill_build_block(block));
+    }
+    Block block = mutable_block.to_block();
+    RETURN_IF_ERROR(_spill_build_block(block));
+    mutable_block = MutableBlock();
+
+    _reset_hash_table();
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_build_block(Block& block) {
+    if (block.rows() == 0) {
+        return Status::OK();
+    }
+    size_t column_count = _right_table_data_types.size();
+    RETURN_IF_ERROR(_spill_block_by_partition(block, _build_expr_ctxs, column_count,
+                                              _spill_build_writers));
+
+    if (_spill_runtime_filter_slots != nullptr && !_spill_runtime_filter_slots->empty()) {
+        SCOPED_TIMER(_push_compute_timer);
+        std::unordered_map<const Block*, std::vector<int>> inserted_rows;
+        auto& rows = inserted_rows[&block];
+        rows.resize(block.rows());
+        std::iota(rows.begin(), rows.end(), 0);
+        _spill_runtime_filter_slots->insert(inserted_rows);
+    }
+
+    // drop the join key columns evaluated while partitioning
+    while (block.columns() > column_count) {
+        block.erase(block.columns() - 1);
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_probe_side(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    _is_probe_spilled = true;
+
+    for (const auto& path : _spill_probe_paths) {
+        auto writer = std::make_unique<BlockSpillWriter>(
+                path, state->exec_env()->block_spill_mgr(), state->query_id());
+        RETURN_IF_ERROR(writer->open());
+        _spill_probe_writers.emplace_back(std::move(writer));
+    }
+
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        Block block;
+        {
+            SCOPED_TIMER(_probe_next_timer);
+            RETURN_IF_ERROR(child(0)->get_next(state, &block, &eos));
+        }
+        RETURN_IF_ERROR(_spill_block_by_partition(block, _probe_expr_ctxs,
+                                                  _left_table_data_types.size(),
+                                                  _spill_probe_writers));
+    }
+
+    for (auto& writer : _spill_probe_writers) {
+        RETURN_IF_ERROR(writer->close());
+        COUNTER_UPDATE(_spill_probe_rows_counter, writer->written_rows());
+        COUNTER_UPDATE(_spill_probe_bytes_counter, writer->written_bytes());
+    }
+    _spill_probe_writers.clear();
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_block_by_partition(Block& block, const VExprContexts& expr_ctxs,
+                                               size_t column_count,
+                                               std::vector<BlockSpillWriterUPtr>& writers) {
+    size_t rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+
+    size_t partition_count = writers.size();
+    IColumn::Selector selector(rows);
+    {
+        std::vector<SipHash> siphashs(rows);
+        for (auto ctx : expr_ctxs) {
+            int result_col_id = -1;
+            RETURN_IF_ERROR(ctx->execute(&block, &result_col_id));
+            auto column =
+                    block.get_by_position(result_col_id).column->convert_to_full_column_if_const();
+            // Only hash the nested column, a key may be nullable on one side of the join
+            // but not on the other, and both must fall into the same partition.
+            if (auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+                const auto& nested = nullable->get_nested_column();
+                const auto& null_map = nullable->get_null_map_data();
+                for (size_t j = 0; j < rows; ++j) {
+                    if (null_map[j]) {
+                        siphashs[j].update(static_cast<UInt8>(0));
+                    } else {
+                        nested.update_hash_with_value(j, siphashs[j]);
+                    }
+                }
+            } else {
+                for (size_t j = 0; j < rows; ++j) {
+                    column->update_hash_with_value(j, siphashs[j]);
+                }
+            }
+        }
+        for (size_t j = 0; j < rows; ++j) {
+            selector[j] = siphashs[j].get64() % partition_count;
+        }
+    }
+
+    std::vector<MutableColumns> partition_columns(partition_count);
+    for (size_t i = 0; i < column_count; ++i) {
+        auto scattered = block.get_by_position(i).column->scatter(partition_count, selector);
+        for (size_t p = 0; p < partition_count; ++p) {
+            partition_columns[p].emplace_back(std::move(scattered[p]));
+        }
+    }
+
+    for (size_t p = 0; p < partition_count; ++p) {
+        if (partition_columns[p][0]->empty()) {
+            continue;
+        }
+        Block partition_block;
+        for (size_t i = 0; i < column_count; ++i) {
+            const auto& column_with_type = block.get_by_position(i);
+            partition_block.insert({std::move(partition_columns[p][i]), column_with_type.type,
+                                    column_with_type.name});
+        }
+        RETURN_IF_ERROR(writers[p]->write(partition_block));
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_prepare_next_spill_partition(RuntimeState* state) {
+    DCHECK(_has_next_spill_partition());
+    _reset_hash_table();
+    _spill_probe_reader.reset();
+
+    {
+        SCOPED_TIMER(_build_timer);
+        BlockSpillReader build_reader(_spill_build_paths[_spill_partition_index]);
+        RETURN_IF_ERROR(build_reader.open());
+        RETURN_IF_ERROR(_build_hash_table_from(
+                state, [&](Block* block, bool* eos) { return build_reader.read(block, eos); },
+                false));
+        RETURN_IF_ERROR(build_reader.close());
+    }
+
+    _spill_probe_reader =
+            std::make_unique<BlockSpillReader>(_spill_probe_paths[_spill_partition_index]);
+    RETURN_IF_ERROR(_spill_probe_reader->open());
+    ++_spill_partition_index;
+    _probe_eos = false;
+    return Status::OK();
+}
+
+Status HashJoinNode::_get_next_probe_block(RuntimeState* state, Block* block, bool* eos) {
+    if (_spill_probe_reader != nullptr) {
+        return _spill_probe_reader->read(block, eos);
+    }
+    return child(0)->get_next(state, block, eos);
+}
+
+void HashJoinNode::_reset_hash_table() {
+    _hash_table_init();
+    _arena->clear();
+    _parallel_build_arenas.clear();
+    _build_blocks->clear();
+    _inserted_rows->clear();
+    _hash_table_mem_tracker->release(_mem_used);
+    _mem_used = 0;
+}
+
+void HashJoinNode::_remove_spill_files() {
+    _spill_build_writers.clear();
+    _spill_probe_writers.clear();
+    _spill_probe_reader.reset();
+    // the files of the joined partitions have been removed by spill readers
+    for (size_t i = _spill_partition_index; i < _spill_build_paths.size(); ++i) {
+        BlockSpillManager::remove_file(_spill_build_paths[i]);
+        if (_is_probe_spilled) {
+            BlockSpillManager::remove_file(_spill_probe_paths[i]);
+        }
+    }
 }
 
 // TODO:: unify the code of extract probe join column
@@ -1161,17 +1765,27 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
                 }
                 __builtin_unreachable();
             },
-            _hash_table_variants);
+            *_hash_table_variants);
 
     bool has_runtime_filter = !_runtime_filter_descs.empty();
+    bool build_in_parallel = _should_build_in_parallel(state, rows);
+    int parallelism = config::hash_join_parallel_build_threads;
 
     std::visit(
             [&](auto&& arg) {
                 using HashTableCtxType = std::decay_t<decltype(arg)>;
                 if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
-#define CALL_BUILD_FUNCTION(HAS_NULL, BUILD_UNIQUE)                                           \
-    ProcessHashTableBuild<HashTableCtxType, HAS_NULL, BUILD_UNIQUE> hash_table_build_process( \
-            rows, block, raw_ptrs, this, state->batch_size(), offset);                        \
+#define CALL_BUILD_FUNCTION(HAS_NULL, BUILD_UNIQUE)                                               \
+    if constexpr (HashTableCtxType::two_level) {                                                  \
+        if (build_in_parallel) {                                                                  \
+            ProcessHashTableParallelBuild<HashTableCtxType, HAS_NULL, BUILD_UNIQUE>               \
+                    hash_table_build_process(rows, block, raw_ptrs, this, offset, parallelism);   \
+            st = hash_table_build_process(state, arg, &null_map_val, has_runtime_filter);         \
+            return;                                                                               \
+        }                                                                                         \
+    }                                                                                             \
+    ProcessHashTableBuild<HashTableCtxType, HAS_NULL, BUILD_UNIQUE> hash_table_build_process(     \
+            rows, block, raw_ptrs, this, state->batch_size(), offset);                            \
     st = hash_table_build_process(arg, &null_map_val, has_runtime_filter);
                     if (std::pair {has_null, _build_unique} == std::pair {true, true}) {
                         CALL_BUILD_FUNCTION(true, true);
@@ -1186,38 +1800,74 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
                     LOG(FATAL) << "FATAL: uninited hash table";
                 }
             },
-            _hash_table_variants);
+            *_hash_table_variants);
 
     return st;
 }
 
+bool HashJoinNode::_should_build_in_parallel(RuntimeState* state, size_t rows) {
+    if (config::hash_join_parallel_build_threads <= 1 ||
+        rows < config::hash_join_parallel_build_min_rows ||
+        state->exec_env() == nullptr || state->exec_env()->join_build_thread_pool() == nullptr) {
+        return false;
+    }
+
+    return std::visit(
+            [&](auto&& arg) -> bool {
+                using HashTableCtxType = std::decay_t<decltype(arg)>;
+                if constexpr (std::is_same_v<HashTableCtxType, std::monostate>) {
+                    return false;
+                } else if constexpr (HashTableCtxType::two_level) {
+                    return true;
+                } else {
+                    using TwoLevelCtxType = typename HashTableCtxType::TwoLevelContext;
+                    if constexpr (std::is_void_v<TwoLevelCtxType>) {
+                        return false;
+                    } else {
+                        // copy the rows of the previous build blocks before `arg` is replaced
+                        int64_t old_bucket_bytes = arg.hash_table.get_buffer_size_in_bytes();
+                        typename TwoLevelCtxType::HashTable two_level_table(arg.hash_table);
+                        auto& two_level_ctx =
+                                _hash_table_variants->template emplace<TwoLevelCtxType>();
+                        two_level_ctx.hash_table = std::move(two_level_table);
+
+                        int64_t bucket_bytes = two_level_ctx.hash_table.get_buffer_size_in_bytes();
+                        _hash_table_mem_tracker->consume(bucket_bytes - old_bucket_bytes);
+                        _mem_used += bucket_bytes - old_bucket_bytes;
+                        return true;
+                    }
+                }
+            },
+            *_hash_table_variants);
+}
+
 void HashJoinNode::_hash_table_init() {
     if (_build_expr_ctxs.size() == 1 && !_build_not_ignore_null[0]) {
         // Single column optimization
         switch (_build_expr_ctxs[0]->root()->result_type()) {
         case TYPE_BOOLEAN:
         case TYPE_TINYINT:
-            _hash_table_variants.emplace<I8HashTableContext>();
+            _hash_table_variants->emplace<I8HashTableContext>();
             break;
         case TYPE_SMALLINT:
-            _hash_table_variants.emplace<I16HashTableContext>();
+            _hash_table_variants->emplace<I16HashTableContext>();
             break;
         case TYPE_INT:
         case TYPE_FLOAT:
-            _hash_table_variants.emplace<I32HashTableContext>();
+            _hash_table_variants->emplace<I32HashTableContext>();
             break;
         case TYPE_BIGINT:
         case TYPE_DOUBLE:
         case TYPE_DATETIME:
         case TYPE_DATE:
-            _hash_table_variants.emplace<I64HashTableContext>();
+            _hash_table_variants->emplace<I64HashTableContext>();
             break;
         case TYPE_LARGEINT:
         case TYPE_DECIMALV2:
-            _hash_table_variants.emplace<I128HashTableContext>();
+            _hash_table_variants->emplace<I128HashTableContext>();
             break;
         default:
-            _hash_table_variants.emplace<SerializedHashTableContext>();
+            _hash_table_variants->emplace<SerializedHashTableContext>();
         }
         return;
     }
@@ -1253,24 +1903,24 @@ void HashJoinNode::_hash_table_init() {
         // TODO: may we should support uint256 in the future
         if (has_null) {
             if (std::tuple_size<KeysNullMap<UInt64>>::value + key_byte_size <= sizeof(UInt64)) {
-                _hash_table_variants.emplace<I64FixedKeyHashTableContext<true>>();
+                _hash_table_variants->emplace<I64FixedKeyHashTableContext<true>>();
             } else if (std::tuple_size<KeysNullMap<UInt128>>::value + key_byte_size <=
                        sizeof(UInt128)) {
-                _hash_table_variants.emplace<I128FixedKeyHashTableContext<true>>();
+                _hash_table_variants->emplace<I128FixedKeyHashTableContext<true>>();
             } else {
-                _hash_table_variants.emplace<I256FixedKeyHashTableContext<true>>();
+                _hash_table_variants->emplace<I256FixedKeyHashTableContext<true>>();
             }
         } else {
             if (key_byte_size <= sizeof(UInt64)) {
-                _hash_table_variants.emplace<I64FixedKeyHashTableContext<false>>();
+                _hash_table_variants->emplace<I64FixedKeyHashTableContext<false>>();
             } else if (key_byte_size <= sizeof(UInt128)) {
-                _hash_table_variants.emplace<I128FixedKeyHashTableContext<false>>();
+                _hash_table_variants->emplace<I128FixedKeyHashTableContext<false>>();
             } else {
-                _hash_table_variants.emplace<I256FixedKeyHashTableContext<false>>();
+                _hash_table_variants->emplace<I256FixedKeyHashTableContext<false>>();
             }
         }
     } else {
-        _hash_table_variants.emplace<SerializedHashTableContext>();
+        _hash_table_variants->emplace<SerializedHashTableContext>();
     }
 }
 
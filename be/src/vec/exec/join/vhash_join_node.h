@@ -25,18 +25,30 @@
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/hash_map.h"
 #include "vec/common/hash_table/hash_table.h"
+#include "vec/common/hash_table/two_level_hash_map.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exec/join/join_op.h"
 #include "vec/exec/join/vacquire_list.hpp"
 #include "vec/functions/function.h"
+#include "vec/runtime/shared_hash_table_controller.h"
 
 namespace doris {
 namespace vectorized {
 
-struct SerializedHashTableContext {
+template <bool is_two_level>
+struct SerializedHashTableContextImpl {
     using Mapped = RowRefList;
-    using HashTable = HashMap<StringRef, Mapped>;
+    using HashTable = std::conditional_t<is_two_level, TwoLevelHashMap<StringRef, Mapped>,
+                                         HashMap<StringRef, Mapped>>;
     using State = ColumnsHashing::HashMethodSerialized<typename HashTable::value_type, Mapped>;
     using Iter = typename HashTable::iterator;
+    static constexpr bool two_level = is_two_level;
+    // hashing the keys ahead would serialize them twice
+    static constexpr bool batched_probe = false;
+    static constexpr bool direct_mappable = false;
+    using TwoLevelContext =
+            std::conditional_t<is_two_level, void, SerializedHashTableContextImpl<true>>;
 
     HashTable hash_table;
     Iter iter;
@@ -50,25 +62,68 @@ struct SerializedHashTableContext {
     }
 };
 
+using SerializedHashTableContext = SerializedHashTableContextImpl<false>;
+using SerializedTwoLevelHashTableContext = SerializedHashTableContextImpl<true>;
+
 // T should be UInt32 UInt64 UInt128
-template <class T>
+template <class T, bool is_two_level = false>
 struct PrimaryTypeHashTableContext {
     using Mapped = RowRefList;
-    using HashTable = HashMap<T, Mapped, HashCRC32<T>>;
+    using HashTable = std::conditional_t<is_two_level, TwoLevelHashMap<T, Mapped, HashCRC32<T>>,
+                                         HashMap<T, Mapped, HashCRC32<T>>>;
     using State =
             ColumnsHashing::HashMethodOneNumber<typename HashTable::value_type, Mapped, T, false>;
     using Iter = typename HashTable::iterator;
+    static constexpr bool two_level = is_two_level;
+    static constexpr bool batched_probe = true;
+    static constexpr bool direct_mappable = std::is_integral_v<T>;
+    // the key domain of int8 and int16 is too small to be worth building in parallel
+    using TwoLevelContext = std::conditional_t<is_two_level || sizeof(T) <= sizeof(UInt16), void,
+                                               PrimaryTypeHashTableContext<T, true>>;
 
     HashTable hash_table;
     Iter iter;
     bool inited = false;
 
+    // Set by init_direct_map() if the keys are dense, e.g. surrogate keys, the mapped of a
+    // key in the hash table is then at direct_map[key - direct_map_min], or is nullptr if
+    // the key doesn't exist, so the probe doesn't need to hash the key and search buckets.
+    std::vector<Mapped*> direct_map;
+    T direct_map_min = 0;
+
     void init_once() {
         if (!inited) {
             inited = true;
             iter = hash_table.begin();
         }
     }
+
+    // Called after the hash table has been built, the pointers to the mapped stay valid
+    // since nothing is inserted afterwards. Returns the bytes allocated for the direct map.
+    size_t init_direct_map() {
+        direct_map.clear();
+        if constexpr (direct_mappable) {
+            if (hash_table.size() == 0) {
+                return 0;
+            }
+            T min_key = std::numeric_limits<T>::max();
+            T max_key = std::numeric_limits<T>::min();
+            for (auto it = hash_table.begin(); it != hash_table.end(); ++it) {
+                min_key = std::min(min_key, it->get_first());
+                max_key = std::max(max_key, it->get_first());
+            }
+            // at least half of the keys in the range exist
+            if (size_t(max_key - min_key) >= 2 * hash_table.size()) {
+                return 0;
+            }
+            direct_map.resize(max_key - min_key + 1, nullptr);
+            for (auto it = hash_table.begin(); it != hash_table.end(); ++it) {
+                direct_map[it->get_first() - min_key] = &it->get_second();
+            }
+            direct_map_min = min_key;
+        }
+        return direct_map.capacity() * sizeof(Mapped*);
+    }
 };
 
 // TODO: use FixedHashTable instead of HashTable
@@ -79,13 +134,24 @@ using I64HashTableContext = PrimaryTypeHashTableContext<UInt64>;
 using I128HashTableContext = PrimaryTypeHashTableContext<UInt128>;
 using I256HashTableContext = PrimaryTypeHashTableContext<UInt256>;
 
-template <class T, bool has_null>
+using I32TwoLevelHashTableContext = PrimaryTypeHashTableContext<UInt32, true>;
+using I64TwoLevelHashTableContext = PrimaryTypeHashTableContext<UInt64, true>;
+using I128TwoLevelHashTableContext = PrimaryTypeHashTableContext<UInt128, true>;
+using I256TwoLevelHashTableContext = PrimaryTypeHashTableContext<UInt256, true>;
+
+template <class T, bool has_null, bool is_two_level = false>
 struct FixedKeyHashTableContext {
     using Mapped = RowRefList;
-    using HashTable = HashMap<T, Mapped, HashCRC32<T>>;
+    using HashTable = std::conditional_t<is_two_level, TwoLevelHashMap<T, Mapped, HashCRC32<T>>,
+                                         HashMap<T, Mapped, HashCRC32<T>>>;
     using State = ColumnsHashing::HashMethodKeysFixed<typename HashTable::value_type, T, Mapped,
                                                       has_null, false>;
     using Iter = typename HashTable::iterator;
+    static constexpr bool two_level = is_two_level;
+    static constexpr bool batched_probe = true;
+    static constexpr bool direct_mappable = false;
+    using TwoLevelContext =
+            std::conditional_t<is_two_level, void, FixedKeyHashTableContext<T, has_null, true>>;
 
     HashTable hash_table;
     Iter iter;
@@ -108,6 +174,15 @@ using I128FixedKeyHashTableContext = FixedKeyHashTableContext<UInt128, has_null>
 template <bool has_null>
 using I256FixedKeyHashTableContext = FixedKeyHashTableContext<UInt256, has_null>;
 
+template <bool has_null>
+using I64FixedKeyTwoLevelHashTableContext = FixedKeyHashTableContext<UInt64, has_null, true>;
+
+template <bool has_null>
+using I128FixedKeyTwoLevelHashTableContext = FixedKeyHashTableContext<UInt128, has_null, true>;
+
+template <bool has_null>
+using I256FixedKeyTwoLevelHashTableContext = FixedKeyHashTableContext<UInt256, has_null, true>;
+
 using HashTableVariants =
         std::variant<std::monostate, SerializedHashTableContext, I8HashTableContext,
                      I16HashTableContext, I32HashTableContext, I64HashTableContext,
@@ -116,6 +191,20 @@ using HashTableVariants =
                      I128FixedKeyHashTableContext<false>, I256FixedKeyHashTableContext<true>,
                      I256FixedKeyHashTableContext<false>>;
 
+// The hash join additionally supports the two level hash tables, which are the partition
+// directory of the parallel build: every bucket of the first level is built by one thread.
+using JoinHashTableVariants = std::variant<
+        std::monostate, SerializedHashTableContext, I8HashTableContext, I16HashTableContext,
+        I32HashTableContext, I64HashTableContext, I128HashTableContext, I256HashTableContext,
+        I64FixedKeyHashTableContext<true>, I64FixedKeyHashTableContext<false>,
+        I128FixedKeyHashTableContext<true>, I128FixedKeyHashTableContext<false>,
+        I256FixedKeyHashTableContext<true>, I256FixedKeyHashTableContext<false>,
+        SerializedTwoLevelHashTableContext, I32TwoLevelHashTableContext,
+        I64TwoLevelHashTableContext, I128TwoLevelHashTableContext, I256TwoLevelHashTableContext,
+        I64FixedKeyTwoLevelHashTableContext<true>, I64FixedKeyTwoLevelHashTableContext<false>,
+        I128FixedKeyTwoLevelHashTableContext<true>, I128FixedKeyTwoLevelHashTableContext<false>,
+        I256FixedKeyTwoLevelHashTableContext<true>, I256FixedKeyTwoLevelHashTableContext<false>>;
+
 using JoinOpVariants =
         std::variant<std::integral_constant<TJoinOp::type, TJoinOp::INNER_JOIN>,
                      std::integral_constant<TJoinOp::type, TJoinOp::LEFT_SEMI_JOIN>,
@@ -153,7 +242,7 @@ public:
     virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
     virtual Status get_next(RuntimeState* state, Block* block, bool* eos) override;
     virtual Status close(RuntimeState* state) override;
-    HashTableVariants& get_hash_table_variants() { return _hash_table_variants; }
+    JoinHashTableVariants& get_hash_table_variants() { return _hash_table_variants; }
     void init_join_op();
 
 private:
@@ -198,14 +287,20 @@ private:
     RuntimeProfile::Counter* _search_hashtable_timer;
     RuntimeProfile::Counter* _build_side_output_timer;
     RuntimeProfile::Counter* _probe_side_output_timer;
+    RuntimeProfile::Counter* _build_table_partition_timer;
+    RuntimeProfile::Counter* _parallel_build_blocks_counter;
 
     int64_t _hash_table_rows;
     int64_t _mem_used;
 
-    Arena _arena;
-    HashTableVariants _hash_table_variants;
+    // The hash table and the build blocks and arenas it refers to, they are shared with the
+    // other instances of a broadcast join on this BE, see `_should_share_hash_table`.
+    std::shared_ptr<Arena> _arena;
+    std::shared_ptr<JoinHashTableVariants> _hash_table_variants;
+    // the arenas hold the keys and row lists inserted by the threads of the parallel build
+    std::vector<std::shared_ptr<Arena>> _parallel_build_arenas;
 
-    std::vector<Block> _build_blocks;
+    std::shared_ptr<std::vector<Block>> _build_blocks;
     Block _probe_block;
     ColumnRawPtrs _probe_columns;
     ColumnUInt8::MutablePtr _null_map_column;
@@ -228,6 +323,8 @@ private:
     RowDescriptor _row_desc_for_other_join_conjunt;
 
     std::vector<uint32_t> _items_counts;
+    // the hash values of the keys of the probe block
+    std::vector<size_t> _probe_hashes;
     std::vector<int8_t> _build_block_offsets;
     std::vector<int> _build_block_rows;
 
@@ -237,13 +334,93 @@ private:
     std::vector<bool> _left_output_slot_flags;
     std::vector<bool> _right_output_slot_flags;
 
+    // Grace hash join: once the build side exceeds `spill_hash_join_threshold_bytes`, both
+    // sides are hash partitioned on the join keys to spill files, then every partition is
+    // joined in memory one by one.
+    bool _enable_spill = false;
+    bool _is_spilled = false;
+    bool _is_probe_spilled = false;
+    int _spill_partition_index = 0;
+    std::vector<std::string> _spill_build_paths;
+    std::vector<std::string> _spill_probe_paths;
+    std::vector<BlockSpillWriterUPtr> _spill_build_writers;
+    std::vector<BlockSpillWriterUPtr> _spill_probe_writers;
+    BlockSpillReaderUPtr _spill_probe_reader;
+    // runtime filters are fed with all build rows while partitioning, before the hash tables
+    // of the partitions are built.
+    std::unique_ptr<VRuntimeFilterSlots> _spill_runtime_filter_slots;
+
+    RuntimeProfile::Counter* _spill_timer;
+    RuntimeProfile::Counter* _spill_partitions_counter;
+    RuntimeProfile::Counter* _spill_build_rows_counter;
+    RuntimeProfile::Counter* _spill_build_bytes_counter;
+    RuntimeProfile::Counter* _spill_probe_rows_counter;
+    RuntimeProfile::Counter* _spill_probe_bytes_counter;
+
+    const bool _is_broadcast_join;
+    // the hash table is built by another instance of this broadcast join
+    bool _use_shared_hash_table = false;
+    SharedHashTableController* _shared_hash_table_controller = nullptr;
+
 private:
     void _hash_table_build_thread(RuntimeState* state, std::promise<Status>* status);
 
     Status _hash_table_build(RuntimeState* state);
 
+    Status _build_runtime_filters(RuntimeState* state);
+
+    // Only the broadcast joins which never modify the hash table while probing can share it.
+    bool _should_share_hash_table(RuntimeState* state) const;
+
+    // Wait for the hash table built by another instance, and publish the runtime filters.
+    Status _acquire_shared_hash_table(RuntimeState* state);
+
+    void _publish_shared_hash_table(const Status& status);
+
+    // Build the hash table from the blocks returned by `get_block`, switch to grace hash join
+    // when `allow_spill` is true and the build side grows over the spill threshold.
+    Status _build_hash_table_from(RuntimeState* state,
+                                  const std::function<Status(Block*, bool*)>& get_block,
+                                  bool allow_spill);
+
+    bool _should_spill() const;
+
+    // Partition the in-memory build blocks to spill files and drop the hash table.
+    Status _spill_build_side(RuntimeState* state, MutableBlock& mutable_block);
+
+    Status _spill_build_block(Block& block);
+
+    // Read the whole probe side and partition it to spill files.
+    Status _spill_probe_side(RuntimeState* state);
+
+    // Scatter the first `column_count` columns of `block` to `writers` by the hash of the
+    // join keys evaluated by `expr_ctxs`.
+    Status _spill_block_by_partition(Block& block, const VExprContexts& expr_ctxs,
+                                     size_t column_count,
+                                     std::vector<BlockSpillWriterUPtr>& writers);
+
+    bool _has_next_spill_partition() const {
+        return _is_spilled && _spill_partition_index < _spill_build_paths.size();
+    }
+
+    // Build the hash table of the next spilled partition and start probing it.
+    Status _prepare_next_spill_partition(RuntimeState* state);
+
+    Status _get_next_probe_block(RuntimeState* state, Block* block, bool* eos);
+
+    void _reset_hash_table();
+
+    // Indexes the mapped of the hash table by the keys directly if they are dense.
+    void _init_direct_map();
+
+    void _remove_spill_files();
+
     Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
 
+    // Whether a build block of `rows` rows should be inserted by multiple threads, the hash
+    // table is converted to the two level one the first time.
+    bool _should_build_in_parallel(RuntimeState* state, size_t rows);
+
     Status extract_build_join_column(Block& block, NullMap& null_map, ColumnRawPtrs& raw_ptrs,
                                      bool& ignore_null, RuntimeProfile::Counter& expr_call_timer);
 
@@ -255,6 +432,9 @@ private:
     template <class HashTableContext, bool ignore_null, bool build_unique>
     friend struct ProcessHashTableBuild;
 
+    template <class HashTableContext, bool ignore_null, bool build_unique>
+    friend struct ProcessHashTableParallelBuild;
+
     template <class HashTableContext, class JoinOpType, bool ignore_null>
     friend struct ProcessHashTableProbe;
 
@@ -262,7 +442,7 @@ private:
     friend struct ProcessRuntimeFilterBuild;
 
     std::vector<TRuntimeFilterDesc> _runtime_filter_descs;
-    std::unordered_map<const Block*, std::vector<int>> _inserted_rows;
+    std::shared_ptr<std::unordered_map<const Block*, std::vector<int>>> _inserted_rows;
 };
 } // namespace vectorized
 } // namespace doris
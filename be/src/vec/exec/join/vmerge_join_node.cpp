@@ -0,0 +1,418 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vmerge_join_node.h"
+
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/utils/util.hpp"
+
+namespace doris::vectorized {
+
+namespace {
+
+void insert_range(IColumn& dst, const IColumn& src, size_t start, size_t length) {
+    if (dst.is_nullable() && !src.is_nullable()) {
+        assert_cast<ColumnNullable&>(dst).insert_range_from_not_nullable(src, start, length);
+    } else {
+        dst.insert_range_from(src, start, length);
+    }
+}
+
+void insert_many(IColumn& dst, const IColumn& src, size_t position, size_t length) {
+    if (dst.is_nullable() && !src.is_nullable()) {
+        assert_cast<ColumnNullable&>(dst).insert_many_from_not_nullable(src, position, length);
+    } else {
+        dst.insert_many_from(src, position, length);
+    }
+}
+
+} // namespace
+
+bool VMergeJoinNode::JoinKeys::has_null(size_t row) const {
+    for (auto null_map : null_maps) {
+        if (null_map != nullptr && (*null_map)[row]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VMergeJoinNode::JoinKeys::reset(const Block& block, const std::vector<int>& ids) {
+    column_ids = ids;
+    columns.clear();
+    null_maps.clear();
+    for (int id : column_ids) {
+        const auto& column = block.get_by_position(id).column;
+        if (auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            columns.push_back(&nullable->get_nested_column());
+            null_maps.push_back(&nullable->get_null_map_data());
+        } else {
+            columns.push_back(column.get());
+            null_maps.push_back(nullptr);
+        }
+    }
+}
+
+VMergeJoinNode::VMergeJoinNode(ObjectPool* pool, const TPlanNode& tnode,
+                               const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status VMergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    DCHECK(tnode.__isset.merge_join_node);
+    const auto& merge_join_node = tnode.merge_join_node;
+    _join_op = merge_join_node.__isset.join_op ? merge_join_node.join_op : TJoinOp::INNER_JOIN;
+    switch (_join_op) {
+    case TJoinOp::INNER_JOIN:
+    case TJoinOp::LEFT_OUTER_JOIN:
+        break;
+    case TJoinOp::LEFT_SEMI_JOIN:
+    case TJoinOp::LEFT_ANTI_JOIN:
+        _output_right = false;
+        break;
+    default:
+        return Status::NotSupported(
+                fmt::format("Merge join doesn't support join op {}", _join_op));
+    }
+
+    for (const auto& eq_join_conjunct : merge_join_node.cmp_conjuncts) {
+        if (eq_join_conjunct.__isset.opcode &&
+            eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
+            return Status::NotSupported("Merge join doesn't support null safe equal");
+        }
+        VExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
+        _left_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
+        _right_expr_ctxs.push_back(ctx);
+    }
+    if (_left_expr_ctxs.empty()) {
+        return Status::InternalError("Merge join requires equal join conjuncts");
+    }
+
+    _row_desc_for_other_join_conjunct = RowDescriptor(child(0)->row_desc(), child(1)->row_desc());
+    if (merge_join_node.__isset.vother_join_conjunct) {
+        // the other join conjuncts decide if a left row matches in the outer, semi and anti
+        // joins, which would need to buffer the left rows
+        if (_join_op != TJoinOp::INNER_JOIN) {
+            return Status::NotSupported(
+                    "Merge join only supports other join conjuncts in inner join");
+        }
+        _vother_join_conjunct_ptr.reset(new VExprContext*);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, merge_join_node.vother_join_conjunct,
+                                                _vother_join_conjunct_ptr.get()));
+    }
+    return Status::OK();
+}
+
+Status VMergeJoinNode::prepare(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
+
+    RETURN_IF_ERROR(
+            VExpr::prepare(_left_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(
+            VExpr::prepare(_right_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR((*_vother_join_conjunct_ptr)
+                                ->prepare(state, _row_desc_for_other_join_conjunct,
+                                          expr_mem_tracker()));
+    }
+
+    // the keys of the two sides are compared by the columns directly
+    for (size_t i = 0; i < _left_expr_ctxs.size(); ++i) {
+        auto left_type = remove_nullable(_left_expr_ctxs[i]->root()->data_type());
+        auto right_type = remove_nullable(_right_expr_ctxs[i]->root()->data_type());
+        if (!left_type->equals(*right_type)) {
+            return Status::NotSupported(
+                    fmt::format("Merge join keys have different types: {} vs {}",
+                                left_type->get_name(), right_type->get_name()));
+        }
+    }
+
+    _num_left_columns = VectorizedUtils::get_data_types(child(0)->row_desc()).size();
+    _num_right_columns = VectorizedUtils::get_data_types(child(1)->row_desc()).size();
+
+    _left_rows_counter = ADD_COUNTER(runtime_profile(), "LeftRows", TUnit::UNIT);
+    _right_rows_counter = ADD_COUNTER(runtime_profile(), "RightRows", TUnit::UNIT);
+    _max_group_rows_counter = ADD_COUNTER(runtime_profile(), "MaxRowsOfKey", TUnit::UNIT);
+    return Status::OK();
+}
+
+Status VMergeJoinNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_CANCELLED(state);
+
+    RETURN_IF_ERROR(VExpr::open(_left_expr_ctxs, state));
+    RETURN_IF_ERROR(VExpr::open(_right_expr_ctxs, state));
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR((*_vother_join_conjunct_ptr)->open(state));
+    }
+    RETURN_IF_ERROR(child(0)->open(state));
+    RETURN_IF_ERROR(child(1)->open(state));
+    return Status::OK();
+}
+
+Status VMergeJoinNode::_fetch_block(RuntimeState* state, int child_id,
+                                    const VExprContexts& ctxs, Block* block, JoinKeys* keys,
+                                    bool* eos) {
+    keys->reset(*block, {});
+    do {
+        RETURN_IF_CANCELLED(state);
+        release_block_memory(*block, child_id);
+        RETURN_IF_ERROR(child(child_id)->get_next(state, block, eos));
+    } while (block->rows() == 0 && !*eos);
+    if (block->rows() == 0) {
+        return Status::OK();
+    }
+
+    for (size_t i = 0; i < block->columns(); ++i) {
+        auto& column = block->get_by_position(i).column;
+        column = column->convert_to_full_column_if_const();
+    }
+    std::vector<int> column_ids;
+    for (auto ctx : ctxs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(ctx->execute(block, &result_column_id));
+        auto& column = block->get_by_position(result_column_id).column;
+        column = column->convert_to_full_column_if_const();
+        column_ids.push_back(result_column_id);
+    }
+    keys->reset(*block, column_ids);
+    return Status::OK();
+}
+
+int VMergeJoinNode::_compare(const JoinKeys& lhs, size_t lhs_row, const JoinKeys& rhs,
+                             size_t rhs_row) {
+    for (size_t i = 0; i < lhs.columns.size(); ++i) {
+        int res = lhs.columns[i]->compare_at(lhs_row, rhs_row, *rhs.columns[i], 1);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+Status VMergeJoinNode::_seek_group(RuntimeState* state) {
+    _group.clear();
+    _group_keys.reset(_group, {});
+
+    // skip the build rows less than the left row
+    while (true) {
+        if (_right_pos == _right_block.rows()) {
+            if (_right_eos) {
+                return Status::OK();
+            }
+            RETURN_IF_ERROR(_fetch_block(state, 1, _right_expr_ctxs, &_right_block,
+                                         &_right_keys, &_right_eos));
+            _right_pos = 0;
+            COUNTER_UPDATE(_right_rows_counter, _right_block.rows());
+            continue;
+        }
+        if (_right_keys.has_null(_right_pos) ||
+            _compare(_right_keys, _right_pos, _left_keys, _left_pos) < 0) {
+            ++_right_pos;
+            continue;
+        }
+        break;
+    }
+
+    // The group has all the columns of the build block, including the computed keys, so
+    // the keys of the group are at the same positions as in the build block.
+    MutableColumns columns = _right_block.clone_empty_columns();
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columns[i]->insert_from(*_right_block.get_by_position(i).column, _right_pos);
+    }
+    _group = _right_block.clone_with_columns(std::move(columns));
+    ++_right_pos;
+
+    _group_keys.reset(_group, _right_keys.column_ids);
+    RETURN_IF_ERROR(_extend_group(state));
+
+    if ((int64_t)_group.rows() > _max_group_rows_counter->value()) {
+        COUNTER_SET(_max_group_rows_counter, (int64_t)_group.rows());
+    }
+    return Status::OK();
+}
+
+Status VMergeJoinNode::_extend_group(RuntimeState* state) {
+    // the columns of the group are only appended to, so the key pointers stay valid
+    std::vector<IColumn*> columns(_group.columns());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columns[i] = &_group.get_by_position(i).column->assume_mutable_ref();
+    }
+
+    while (true) {
+        if (_right_pos == _right_block.rows()) {
+            if (_right_eos) {
+                break;
+            }
+            RETURN_IF_ERROR(_fetch_block(state, 1, _right_expr_ctxs, &_right_block,
+                                         &_right_keys, &_right_eos));
+            _right_pos = 0;
+            COUNTER_UPDATE(_right_rows_counter, _right_block.rows());
+            continue;
+        }
+
+        // copy the rows with the same key in ranges, skipping the ones with null keys
+        size_t rows = _right_block.rows();
+        size_t end = _right_pos;
+        bool key_changed = false;
+        while (end < rows) {
+            if (_right_keys.has_null(end)) {
+                break;
+            }
+            if (_compare(_right_keys, end, _group_keys, 0) != 0) {
+                key_changed = true;
+                break;
+            }
+            ++end;
+        }
+        for (size_t i = 0; i < columns.size(); ++i) {
+            columns[i]->insert_range_from(*_right_block.get_by_position(i).column, _right_pos,
+                                          end - _right_pos);
+        }
+        _right_pos = end;
+        if (key_changed) {
+            break;
+        }
+        if (_right_pos < rows) {
+            // the row with null key
+            ++_right_pos;
+        }
+    }
+    return Status::OK();
+}
+
+void VMergeJoinNode::_output_rows(MutableColumns& columns, size_t group_start,
+                                  size_t group_rows) {
+    for (size_t i = 0; i < _num_left_columns; ++i) {
+        insert_many(*columns[i], *_left_block.get_by_position(i).column, _left_pos, group_rows);
+    }
+    for (size_t i = 0; i < _num_right_columns; ++i) {
+        insert_range(*columns[_num_left_columns + i], *_group.get_by_position(i).column,
+                     group_start, group_rows);
+    }
+}
+
+void VMergeJoinNode::_output_left_row(MutableColumns& columns) {
+    for (size_t i = 0; i < _num_left_columns; ++i) {
+        insert_many(*columns[i], *_left_block.get_by_position(i).column, _left_pos, 1);
+    }
+    if (_output_right) {
+        for (size_t i = 0; i < _num_right_columns; ++i) {
+            DCHECK(columns[_num_left_columns + i]->is_nullable());
+            columns[_num_left_columns + i]->insert_default();
+        }
+    }
+}
+
+Status VMergeJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
+    RETURN_IF_CANCELLED(state);
+
+    MutableBlock mutable_block(VectorizedUtils::create_empty_columnswithtypename(row_desc()));
+    auto& columns = mutable_block.mutable_columns();
+    DCHECK_EQ(columns.size(), _num_left_columns + (_output_right ? _num_right_columns : 0));
+
+    // no more left row can match after the build rows are exhausted
+    const bool need_unmatched =
+            _join_op == TJoinOp::LEFT_OUTER_JOIN || _join_op == TJoinOp::LEFT_ANTI_JOIN;
+    const size_t batch_size = state->batch_size();
+    while (mutable_block.rows() < batch_size) {
+        if (_left_pos == _left_block.rows()) {
+            if (_left_eos) {
+                break;
+            }
+            RETURN_IF_ERROR(_fetch_block(state, 0, _left_expr_ctxs, &_left_block, &_left_keys,
+                                         &_left_eos));
+            _left_pos = 0;
+            COUNTER_UPDATE(_left_rows_counter, _left_block.rows());
+            continue;
+        }
+
+        if (!_left_row_sought) {
+            _left_row_sought = true;
+            _left_row_matched = false;
+            _group_pos = 0;
+            if (!_left_keys.has_null(_left_pos)) {
+                if (_group.rows() == 0 || _compare(_left_keys, _left_pos, _group_keys, 0) > 0) {
+                    RETURN_IF_ERROR(_seek_group(state));
+                }
+                _left_row_matched = _group.rows() != 0 &&
+                                    _compare(_left_keys, _left_pos, _group_keys, 0) == 0;
+            }
+            if (!need_unmatched && _group.rows() == 0 && _right_eos &&
+                _right_pos == _right_block.rows()) {
+                _left_eos = true;
+                _left_pos = _left_block.rows();
+                break;
+            }
+        }
+
+        if (_left_row_matched) {
+            if (_join_op == TJoinOp::LEFT_SEMI_JOIN) {
+                _output_left_row(columns);
+            } else if (_join_op != TJoinOp::LEFT_ANTI_JOIN) {
+                size_t rows = std::min(_group.rows() - _group_pos,
+                                       batch_size - mutable_block.rows());
+                _output_rows(columns, _group_pos, rows);
+                _group_pos += rows;
+                if (_group_pos < _group.rows()) {
+                    continue;
+                }
+            }
+        } else if (need_unmatched) {
+            _output_left_row(columns);
+        }
+        ++_left_pos;
+        _left_row_sought = false;
+    }
+
+    output_block->swap(mutable_block.to_block());
+    *eos = _left_eos && _left_pos == _left_block.rows();
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR(VExprContext::filter_block(_vother_join_conjunct_ptr, output_block,
+                                                   output_block->columns()));
+    }
+    RETURN_IF_ERROR(
+            VExprContext::filter_block(_vconjunct_ctx_ptr, output_block, output_block->columns()));
+    reached_limit(output_block, eos);
+    return Status::OK();
+}
+
+Status VMergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    VExpr::close(_left_expr_ctxs, state);
+    VExpr::close(_right_expr_ctxs, state);
+    if (_vother_join_conjunct_ptr) {
+        (*_vother_join_conjunct_ptr)->close(state);
+    }
+    return ExecNode::close(state);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "exec/exec_node.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris {
+namespace vectorized {
+
+// Node for the equi-joins of two children that are both sorted by the join keys in
+// ascending order, e.g. the colocated tablets of two tables read in key order. The two
+// children are consumed at the same pace, and only the build rows of the current join key
+// are kept in memory, so a join of huge tables doesn't need a hash table of the build side.
+//
+// The left child drives the join, INNER, LEFT OUTER, LEFT SEMI and LEFT ANTI joins are
+// supported, the other join conjuncts are only supported by the INNER join. The rows whose
+// join keys contain null never match, they may be anywhere in the inputs.
+class VMergeJoinNode final : public ExecNode {
+public:
+    VMergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VMergeJoinNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented VMergeJoinNode::get_next scalar");
+    }
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+private:
+    using VExprContexts = std::vector<VExprContext*>;
+
+    // The join keys of a block, computed by the join exprs into the appended columns.
+    struct JoinKeys {
+        // the positions of the key columns in the block, a slot ref key is the slot column
+        // itself while the other exprs append their results
+        std::vector<int> column_ids;
+        std::vector<const IColumn*> columns;
+        std::vector<const NullMap*> null_maps;
+        bool has_null(size_t row) const;
+        void reset(const Block& block, const std::vector<int>& ids);
+    };
+
+    // Reads the next non-empty block of the child and computes its join keys, the block is
+    // empty if the child has no more rows.
+    Status _fetch_block(RuntimeState* state, int child_id, const VExprContexts& ctxs,
+                        Block* block, JoinKeys* keys, bool* eos);
+
+    static int _compare(const JoinKeys& lhs, size_t lhs_row, const JoinKeys& rhs,
+                        size_t rhs_row);
+
+    // Makes _group hold all the build rows whose key equals the first build row not less
+    // than the current left row, and returns with an empty group if there is no such row.
+    Status _seek_group(RuntimeState* state);
+
+    // Appends the build rows with the same key as the first row of the group to it.
+    Status _extend_group(RuntimeState* state);
+
+    void _output_rows(MutableColumns& columns, size_t group_start, size_t group_rows);
+    // Outputs the current left row alone, with nulls for the build columns if they are output.
+    void _output_left_row(MutableColumns& columns);
+
+    TJoinOp::type _join_op;
+    VExprContexts _left_expr_ctxs;
+    VExprContexts _right_expr_ctxs;
+    std::unique_ptr<VExprContext*> _vother_join_conjunct_ptr;
+    RowDescriptor _row_desc_for_other_join_conjunct;
+
+    size_t _num_left_columns = 0;
+    size_t _num_right_columns = 0;
+    // the columns of the build side are not output by the semi and anti joins
+    bool _output_right = true;
+
+    Block _left_block;
+    JoinKeys _left_keys;
+    size_t _left_pos = 0;
+    bool _left_eos = false;
+
+    Block _right_block;
+    JoinKeys _right_keys;
+    size_t _right_pos = 0;
+    bool _right_eos = false;
+
+    // the build rows of the current key, and the join keys of them
+    Block _group;
+    JoinKeys _group_keys;
+    // the rows of the group before it have been joined with the current left row
+    size_t _group_pos = 0;
+    // the current left row has been compared with the group
+    bool _left_row_matched = false;
+    bool _left_row_sought = false;
+
+    RuntimeProfile::Counter* _left_rows_counter = nullptr;
+    RuntimeProfile::Counter* _right_rows_counter = nullptr;
+    RuntimeProfile::Counter* _max_group_rows_counter = nullptr;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,307 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/scanner_context.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/workload_group.h"
+#include "util/cpu_info.h"
+#include "vec/core/block.h"
+#include "vec/exec/scan/scanner_scheduler.h"
+#include "vec/exec/volap_scanner.h"
+
+namespace doris::vectorized {
+
+ScannerContext::ScannerContext(RuntimeState* state, VOlapScanNode* parent,
+                               const TupleDescriptor* tuple_desc,
+                               const std::list<VOlapScanner*>& scanners, int64_t limit,
+                               int64_t max_bytes_in_blocks_queue)
+        : _state(state),
+          _parent(parent),
+          _tuple_desc(tuple_desc),
+          _scheduler(state->exec_env()->scanner_scheduler()),
+          _max_bytes_in_queue(max_bytes_in_blocks_queue),
+          _scanners(scanners),
+          _num_scanners(scanners.size()),
+          _limit(limit) {
+    if (state->get_query_fragments_ctx() != nullptr) {
+        _workload_group = state->get_query_fragments_ctx()->workload_group;
+    }
+    _block_size = limit == -1 ? state->batch_size()
+                              : std::min(static_cast<int64_t>(state->batch_size()), limit);
+    auto doris_scanner_row_num =
+            limit == -1 ? config::doris_scanner_row_num
+                        : std::min(static_cast<int64_t>(config::doris_scanner_row_num), limit);
+    _block_per_scanner = (doris_scanner_row_num + (_block_size - 1)) / _block_size;
+
+    // the max number of the running scanners of the context
+    _max_thread_num = config::doris_scanner_queue_size;
+    if (config::doris_scanner_row_num > state->batch_size()) {
+        _max_thread_num /= config::doris_scanner_row_num / state->batch_size();
+    }
+    _max_thread_num = std::max(1, _max_thread_num);
+    _cur_max_thread_num = limit == -1 ? _max_thread_num : 1;
+
+    /*********************************
+     * 优先级调度基本策略:
+     * 1. 通过查询拆分的Range个数来确定初始nice值
+     *    Range个数越多，越倾向于认定为大查询，nice值越小
+     * 2. 通过查询累计读取的数据量来调整nice值
+     *    读取的数据越多，越倾向于认定为大查询，nice值越小
+     * 3. 通过nice值来判断查询的优先级
+     *    nice值越大的，越优先获得的查询资源
+     * 4. 定期提高队列内残留任务的优先级，避免大查询完全饿死
+     *********************************/
+    _nice = 18 + std::max(0, 2 - _num_scanners / 5);
+}
+
+ScannerContext::~ScannerContext() {
+    DCHECK_EQ(_num_running_scanners, 0);
+    DCHECK_EQ(_num_scheduling_ctx, 0);
+}
+
+Status ScannerContext::init() {
+    if (_scheduler == nullptr) {
+        return Status::InternalError("scanner scheduler is not initialized");
+    }
+    _block_mem_tracker = MemTracker::create_virtual_tracker(-1, "VOlapScanNode:Block");
+    if (CpuInfo::is_numa_affinity_enabled()) {
+        // the free blocks are allocated by the current thread, so mostly on its node
+        _numa_node = CpuInfo::get_current_numa_node();
+    }
+    auto pre_block_count =
+            std::min(_num_scanners, config::doris_scanner_thread_pool_thread_num) *
+            _block_per_scanner;
+    _free_blocks.reserve(pre_block_count);
+    for (int i = 0; i < pre_block_count; ++i) {
+        auto block = new Block(_tuple_desc->slots(), _block_size);
+        _allocated_bytes += block->allocated_bytes();
+        _free_blocks.emplace_back(block);
+    }
+    _block_mem_tracker->consume(_allocated_bytes);
+    return Status::OK();
+}
+
+Block* ScannerContext::get_free_block(bool* get_free_block) {
+    {
+        std::lock_guard<std::mutex> l(_free_blocks_lock);
+        if (!_free_blocks.empty()) {
+            auto block = _free_blocks.back();
+            _free_blocks.pop_back();
+            return block;
+        }
+    }
+    *get_free_block = false;
+
+    auto block = new Block(_tuple_desc->slots(), _block_size);
+    int64_t bytes = block->allocated_bytes();
+    _block_mem_tracker->consume(bytes);
+    std::lock_guard<std::mutex> l(_free_blocks_lock);
+    _allocated_bytes += bytes;
+    return block;
+}
+
+void ScannerContext::return_free_block(Block* block) {
+    std::lock_guard<std::mutex> l(_free_blocks_lock);
+    _free_blocks.emplace_back(block);
+}
+
+void ScannerContext::append_blocks_to_queue(const std::vector<Block*>& blocks) {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    for (auto b : blocks) {
+        _cur_bytes_in_queue += b->allocated_bytes();
+        _num_rows_queued += b->rows();
+        _blocks_queue.push_back(b);
+    }
+    // the scan node filters nothing, so the rows queued are enough for the limit
+    if (_limit != -1 && _num_rows_queued >= _limit) {
+        _limit_reached = true;
+    }
+    _blocks_queue_added_cv.notify_one();
+}
+
+Status ScannerContext::get_block_from_queue(Block** block, bool* eos) {
+    *block = nullptr;
+    std::unique_lock<std::mutex> l(_transfer_lock);
+    while (_process_status.ok() && !_is_finished && !_should_stop && _blocks_queue.empty()) {
+        if (_state->is_cancelled()) {
+            _process_status = Status::Cancelled("Cancelled");
+            break;
+        }
+        // use wait_for, not wait, in case to capture the state->is_cancelled()
+        _blocks_queue_added_cv.wait_for(l, std::chrono::seconds(1));
+    }
+    if (!_process_status.ok()) {
+        *eos = true;
+        return _process_status;
+    }
+    if (!_blocks_queue.empty()) {
+        *block = _blocks_queue.front();
+        _blocks_queue.pop_front();
+        _cur_bytes_in_queue -= (*block)->allocated_bytes();
+        *eos = false;
+        // the queue has space for the idle scanners now
+        _reschedule_locked();
+        return Status::OK();
+    }
+    *eos = true;
+    return Status::OK();
+}
+
+bool ScannerContext::has_block_or_finished() {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    return !_blocks_queue.empty() || _done_locked();
+}
+
+void ScannerContext::set_status_on_error(const Status& status) {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    if (_process_status.ok()) {
+        _process_status = status;
+        _blocks_queue_added_cv.notify_one();
+    }
+}
+
+Status ScannerContext::status() {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    return _process_status;
+}
+
+void ScannerContext::set_should_stop() {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    _should_stop = true;
+    _blocks_queue_added_cv.notify_one();
+}
+
+bool ScannerContext::done() {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    return _done_locked();
+}
+
+void ScannerContext::reschedule() {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    _reschedule_locked();
+}
+
+void ScannerContext::_reschedule_locked() {
+    if (_done_locked() || _num_scheduling_ctx > 0 || _scanners.empty() ||
+        _num_running_scanners >= _cur_max_thread_num) {
+        return;
+    }
+    // the consumer reschedules the context once it takes the blocks, a scanner is always
+    // scheduled if nothing is running or queued in case the queue is too small
+    if (!_has_enough_space_in_blocks_queue() &&
+        !(_blocks_queue.empty() && _num_running_scanners == 0)) {
+        return;
+    }
+    _num_scheduling_ctx++;
+    auto st = _scheduler->submit(this);
+    if (!st.ok()) {
+        _num_scheduling_ctx--;
+        _process_status = st;
+        _blocks_queue_added_cv.notify_one();
+    }
+}
+
+void ScannerContext::get_next_batch_of_scanners(std::list<VOlapScanner*>* scanners) {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    DCHECK_GT(_num_scheduling_ctx, 0);
+    if (!_done_locked()) {
+        // How many threads can apply to this query
+        int thread_slot_num = 0;
+        if (_has_enough_space_in_blocks_queue()) {
+            std::lock_guard<std::mutex> fl(_free_blocks_lock);
+            thread_slot_num = (_free_blocks.size() + _block_per_scanner - 1) / _block_per_scanner;
+        }
+        thread_slot_num =
+                std::min(thread_slot_num, _cur_max_thread_num - _num_running_scanners);
+        if (thread_slot_num <= 0 && _num_running_scanners == 0) {
+            thread_slot_num = 1;
+        }
+        thread_slot_num = std::min(thread_slot_num, static_cast<int>(_scanners.size()));
+        if (_workload_group != nullptr && thread_slot_num > 0) {
+            thread_slot_num = _workload_group->acquire_scan_slots(thread_slot_num,
+                                                                  _num_running_scanners == 0);
+        }
+        for (int i = 0; i < thread_slot_num; ++i) {
+            scanners->push_back(_scanners.front());
+            _scanners.pop_front();
+        }
+        _num_running_scanners += scanners->size();
+
+        // scanner_row_num = 16k
+        // 16k * 10 * 12 * 8 = 15M(>2s)  --> nice=10
+        // 16k * 20 * 22 * 8 = 55M(>6s)  --> nice=0
+        _total_assign_num += scanners->size();
+        int nice = _nice;
+        while (nice > 0 && _total_assign_num > (22 - nice) * (20 - nice) * 6) {
+            --nice;
+        }
+        _nice = nice;
+    }
+    _num_scheduling_ctx--;
+    _ctx_finish_cv.notify_one();
+}
+
+void ScannerContext::push_back_scanner_and_reschedule(VOlapScanner* scanner, bool eos) {
+    std::lock_guard<std::mutex> l(_transfer_lock);
+    if (eos) {
+        if (++_num_finished_scanners == _num_scanners) {
+            _is_finished = true;
+        }
+    } else {
+        _scanners.push_front(scanner);
+    }
+    _num_running_scanners--;
+    // the scanners so far are not enough for the limit
+    _cur_max_thread_num = std::min(_max_thread_num, _cur_max_thread_num * 2);
+    if (_workload_group != nullptr) {
+        _workload_group->release_scan_slots(1);
+    }
+    _reschedule_locked();
+    // The context may be released once the lock is released, notify under the lock.
+    _blocks_queue_added_cv.notify_one();
+    _ctx_finish_cv.notify_one();
+}
+
+void ScannerContext::clear_and_join() {
+    {
+        std::unique_lock<std::mutex> l(_transfer_lock);
+        _should_stop = true;
+        _ctx_finish_cv.wait(l, [this] {
+            return _num_running_scanners == 0 && _num_scheduling_ctx == 0;
+        });
+        std::for_each(_blocks_queue.begin(), _blocks_queue.end(), std::default_delete<Block>());
+        _blocks_queue.clear();
+        _cur_bytes_in_queue = 0;
+    }
+    std::lock_guard<std::mutex> l(_free_blocks_lock);
+    std::for_each(_free_blocks.begin(), _free_blocks.end(), std::default_delete<Block>());
+    _free_blocks.clear();
+    if (_block_mem_tracker != nullptr) {
+        _block_mem_tracker->release(_allocated_bytes);
+    }
+    _allocated_bytes = 0;
+}
+
+} // namespace doris::vectorized
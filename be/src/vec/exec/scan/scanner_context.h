@@ -0,0 +1,170 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/status.h"
+
+namespace doris {
+class MemTracker;
+class RuntimeState;
+class TupleDescriptor;
+class WorkloadGroup;
+
+namespace vectorized {
+
+class Block;
+class ScannerScheduler;
+class VOlapScanNode;
+class VOlapScanner;
+
+// The state shared by the scanners of a scan node, the scanner threads and the consumer.
+// The ScannerScheduler schedules the idle scanners of the context to the scan thread pool,
+// the scanners fill the blocks taken from the free block pool and append them to the
+// blocks queue, and the scan node takes the blocks in get_next() and returns them to
+// the pool.
+//
+// A context is (re)submitted to the scheduler whenever a scanner yields or a block is
+// consumed, as long as there are idle scanners and the blocks queue is not full, so no
+// thread waits for the queue on behalf of a scan node.
+class ScannerContext {
+public:
+    ScannerContext(RuntimeState* state, VOlapScanNode* parent,
+                   const TupleDescriptor* tuple_desc, const std::list<VOlapScanner*>& scanners,
+                   int64_t limit, int64_t max_bytes_in_blocks_queue);
+    ~ScannerContext();
+
+    // Preallocates the free blocks, should be called before submitted to the scheduler.
+    Status init();
+
+    // Called by the scan node, waits until there is a block in the queue or all the scanners
+    // finish. *block is set to nullptr and *eos to true if there are no more blocks.
+    Status get_block_from_queue(Block** block, bool* eos);
+    // Whether get_block_from_queue() returns without waiting.
+    bool has_block_or_finished();
+    void return_free_block(Block* block);
+
+    // Called by the scanners, *get_free_block is set to false if a new block is allocated.
+    Block* get_free_block(bool* get_free_block);
+    void append_blocks_to_queue(const std::vector<Block*>& blocks);
+    // Called at the end of a scanner thread as the last access of the context, the context
+    // may be released once it returns.
+    void push_back_scanner_and_reschedule(VOlapScanner* scanner, bool eos);
+
+    // Called by the scheduler.
+    void get_next_batch_of_scanners(std::list<VOlapScanner*>* scanners);
+    // The priority of the scanner tasks, the larger the higher, see ScannerScheduler.
+    int nice() const { return _nice; }
+    // Submits the context to the scheduler if the scanners could be scheduled and it is not
+    // submitted yet.
+    void reschedule();
+
+    void set_status_on_error(const Status& status);
+    Status status();
+
+    // No more blocks are needed, e.g. the limit is reached or the node is closed.
+    void set_should_stop();
+    // Whether the scanners should stop scanning.
+    bool done();
+
+    // Stops the scanners, waits for the running ones and the scheduling, then releases the
+    // blocks. Must be called before the scan node is closed.
+    void clear_and_join();
+
+    RuntimeState* state() const { return _state; }
+    VOlapScanNode* parent() const { return _parent; }
+    size_t block_size() const { return _block_size; }
+    WorkloadGroup* workload_group() const { return _workload_group.get(); }
+    // The NUMA node the free blocks are preallocated on, -1 if NUMA affinity is disabled.
+    int numa_node() const { return _numa_node; }
+
+private:
+    bool _has_enough_space_in_blocks_queue() const {
+        return _cur_bytes_in_queue < _max_bytes_in_queue / 2;
+    }
+    bool _done_locked() const {
+        return _is_finished || _should_stop || _limit_reached || !_process_status.ok();
+    }
+    void _reschedule_locked();
+
+    RuntimeState* _state;
+    VOlapScanNode* _parent;
+    const TupleDescriptor* _tuple_desc;
+    ScannerScheduler* _scheduler;
+    // the running scanners take the scan quota of the group
+    std::shared_ptr<WorkloadGroup> _workload_group;
+
+    // all the fields below are protected by _transfer_lock
+    std::mutex _transfer_lock;
+    // notified when a block is added to the queue or the context is done
+    std::condition_variable _blocks_queue_added_cv;
+    // notified when a scanner thread or a scheduling exits
+    std::condition_variable _ctx_finish_cv;
+
+    std::list<Block*> _blocks_queue;
+    int64_t _cur_bytes_in_queue = 0;
+    const int64_t _max_bytes_in_queue;
+
+    // the idle scanners
+    std::list<VOlapScanner*> _scanners;
+    int _num_running_scanners = 0;
+    int _num_finished_scanners = 0;
+    const int _num_scanners;
+    // 1 if the context is submitted to the scheduler and not handled yet
+    int _num_scheduling_ctx = 0;
+
+    Status _process_status;
+    bool _is_finished = false;
+    bool _should_stop = false;
+
+    // the limit of the scan node, the scanners stop once the rows queued reach it
+    const int64_t _limit;
+    int64_t _num_rows_queued = 0;
+    bool _limit_reached = false;
+
+    // The free block pool, the blocks are reused by the scanners rather than allocated for
+    // every batch.
+    std::mutex _free_blocks_lock;
+    std::vector<Block*> _free_blocks;
+    // bytes of all the blocks allocated, consumed to _block_mem_tracker
+    int64_t _allocated_bytes = 0;
+    std::shared_ptr<MemTracker> _block_mem_tracker;
+
+    size_t _block_size = 0;
+    int _block_per_scanner = 1;
+    int _max_thread_num = 1;
+    // The max number of the running scanners for now. With a limit, the scanners are started
+    // one by one, and the number doubles every time a scanner yields before the limit is
+    // reached, so the small limits are mostly served by a single scanner.
+    int _cur_max_thread_num = 1;
+    int _numa_node = -1;
+
+    // the nice of the scanner tasks, it decreases as more scanner tasks are scheduled, so
+    // the scanners of the small queries are scheduled first
+    std::atomic<int> _nice;
+    int _total_assign_num = 0;
+};
+
+} // namespace vectorized
+} // namespace doris
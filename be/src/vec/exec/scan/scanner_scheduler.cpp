@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/scanner_scheduler.h"
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/priority_thread_pool.hpp"
+#include "vec/exec/scan/scanner_context.h"
+#include "vec/exec/volap_scan_node.h"
+#include "vec/exec/volap_scanner.h"
+
+namespace doris::vectorized {
+
+ScannerScheduler::~ScannerScheduler() {
+    stop();
+}
+
+Status ScannerScheduler::init(ExecEnv* env) {
+    _scan_thread_pool = env->scan_thread_pool();
+    return ThreadPoolBuilder("ScannerSchedulerThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::doris_scanner_scheduler_thread_num)
+            .build(&_scheduler_pool);
+}
+
+void ScannerScheduler::stop() {
+    if (_is_closed.exchange(true)) {
+        return;
+    }
+    if (_scheduler_pool != nullptr) {
+        _scheduler_pool->shutdown();
+    }
+}
+
+Status ScannerScheduler::submit(ScannerContext* ctx) {
+    if (_is_closed) {
+        return Status::InternalError("scanner scheduler is stopped");
+    }
+    return _scheduler_pool->submit_func([this, ctx]() { _schedule_scanners(ctx); });
+}
+
+void ScannerScheduler::_schedule_scanners(ScannerContext* ctx) {
+    std::list<VOlapScanner*> scanners;
+    ctx->get_next_batch_of_scanners(&scanners);
+    // The context is only alive while its scanners are running, do not access it after
+    // the last scanner is offered.
+    if (scanners.empty()) {
+        return;
+    }
+    RuntimeState* state = ctx->state();
+    VOlapScanNode* parent = ctx->parent();
+    int nice = ctx->nice();
+
+    auto iter = scanners.begin();
+    while (iter != scanners.end()) {
+        VOlapScanner* scanner = *iter++;
+        PriorityThreadPool::Task task;
+        task.work_function = [parent, scanner]() { parent->scanner_thread(scanner); };
+        task.priority = nice;
+        task.queue_id = state->exec_env()->store_path_to_index(scanner->scan_disk());
+        task.numa_node = ctx->numa_node();
+        scanner->start_wait_worker_timer();
+        COUNTER_UPDATE(parent->_scanner_sched_counter, 1);
+        if (!_scan_thread_pool->offer(task)) {
+            LOG(WARNING) << "failed to assign scanner task to the scan thread pool";
+            ctx->set_status_on_error(
+                    Status::InternalError("failed to assign scanner task to thread pool"));
+            ctx->push_back_scanner_and_reschedule(scanner, false);
+        }
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "common/status.h"
+#include "util/threadpool.h"
+
+namespace doris {
+class ExecEnv;
+class PriorityThreadPool;
+
+namespace vectorized {
+
+class ScannerContext;
+
+// The BE-wide scheduler of the scanners of the olap scan nodes, which replaces the
+// transfer thread of each scan node.
+// A ScannerContext is submitted when its idle scanners could run, the scheduling threads
+// take a batch of the scanners from the context, as many as the free blocks and the
+// running scanners of the context allow, and offer them to the scan thread pool with the
+// priority of the context, so the small queries get the scan threads first.
+class ScannerScheduler {
+public:
+    ScannerScheduler() = default;
+    ~ScannerScheduler();
+
+    Status init(ExecEnv* env);
+    void stop();
+
+    Status submit(ScannerContext* ctx);
+
+private:
+    void _schedule_scanners(ScannerContext* ctx);
+
+    // the threads scheduling the submitted contexts
+    std::unique_ptr<ThreadPool> _scheduler_pool;
+    // not owned, the threads running the scanners
+    PriorityThreadPool* _scan_thread_pool = nullptr;
+    std::atomic<bool> _is_closed {false};
+};
+
+} // namespace vectorized
+} // namespace doris
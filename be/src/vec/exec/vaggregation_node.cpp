@@ -18,15 +18,27 @@
 #include "vec/exec/vaggregation_node.h"
 
 #include <memory>
+#include <set>
 
+#include "common/config.h"
+#include "env/env.h"
 #include "exec/exec_node.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
+#include "runtime/memory_reservation_mgr.h"
 #include "runtime/row_batch.h"
+#include "vec/columns/column_dictionary.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/sip_hash.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_manager.h"
+#include "vec/core/block_spill_reader.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_string.h"
+#include "vec/exec/volap_scan_node.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
 #include "vec/utils/util.hpp"
 
 namespace doris::vectorized {
@@ -72,6 +84,14 @@ static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
 static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
         sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
 
+// While the streaming preagg bypasses the hash table, one batch of every this many batches
+// is still aggregated to sample the reduction again, so the node follows the change of data.
+static constexpr int STREAMING_PREAGG_RESAMPLE_INTERVAL = 64;
+
+// The sorted streaming preagg falls back to the hash table if the rows aggregated are
+// reduced by less than half once this many rows are seen.
+static constexpr int64_t SORTED_PREAGG_SAMPLE_ROWS = 1 << 20;
+
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -84,7 +104,8 @@ AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
           _agg_data(),
           _build_timer(nullptr),
           _exec_timer(nullptr),
-          _merge_timer(nullptr) {
+          _merge_timer(nullptr),
+          _tnode(tnode) {
     if (tnode.agg_node.__isset.use_streaming_preaggregation) {
         _is_streaming_preagg = tnode.agg_node.use_streaming_preaggregation;
         if (_is_streaming_preagg) {
@@ -201,6 +222,7 @@ void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs)
 
 Status AggregationNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::prepare(state));
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     _build_timer = ADD_TIMER(runtime_profile(), "BuildTime");
@@ -208,13 +230,14 @@ Status AggregationNode::prepare(RuntimeState* state) {
     _merge_timer = ADD_TIMER(runtime_profile(), "MergeTime");
     _expr_timer = ADD_TIMER(runtime_profile(), "ExprTime");
     _get_results_timer = ADD_TIMER(runtime_profile(), "GetResultsTime");
+    _convert_to_two_level_timer = ADD_TIMER(runtime_profile(), "ConvertToTwoLevelTime");
     _data_mem_tracker =
             MemTracker::create_virtual_tracker(-1, "AggregationNode:Data", mem_tracker());
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
     _output_tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
     DCHECK_EQ(_intermediate_tuple_desc->slots().size(), _output_tuple_desc->slots().size());
     RETURN_IF_ERROR(
-            VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+            VExpr::prepare(_probe_expr_ctxs, state, _input_row_desc(), expr_mem_tracker()));
 
     _mem_pool = std::make_unique<MemPool>();
 
@@ -230,10 +253,17 @@ Status AggregationNode::prepare(RuntimeState* state) {
     for (int i = 0; i < _aggregate_evaluators.size(); ++i, ++j) {
         SlotDescriptor* intermediate_slot_desc = _intermediate_tuple_desc->slots()[j];
         SlotDescriptor* output_slot_desc = _output_tuple_desc->slots()[j];
-        RETURN_IF_ERROR(_aggregate_evaluators[i]->prepare(state, child(0)->row_desc(),
+        RETURN_IF_ERROR(_aggregate_evaluators[i]->prepare(state, _input_row_desc(),
                                                           _mem_pool.get(), intermediate_slot_desc,
                                                           output_slot_desc, mem_tracker()));
     }
+    _try_enable_scan_aggregation();
+    _try_enable_sorted_aggregation(state);
+    if (config::enable_low_cardinality_optimize && !_is_scan_aggregator && !_scan_aggregation &&
+        !_sorted_aggregation) {
+        _try_enable_dict_encoded_key();
+    }
+    _try_share_distinct_keys(state);
 
     // set profile timer to evaluators
     for (auto& evaluator : _aggregate_evaluators) {
@@ -305,9 +335,21 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
         if (_is_streaming_preagg) {
             runtime_profile()->append_exec_option("Streaming Preaggregation");
+            _streaming_pass_through_rows_counter =
+                    ADD_COUNTER(runtime_profile(), "StreamingPassThroughRows", TUnit::UNIT);
+            _streaming_bypass_counter =
+                    ADD_COUNTER(runtime_profile(), "StreamingBypassCount", TUnit::UNIT);
             _executor.pre_agg =
                     std::bind<Status>(&AggregationNode::_pre_agg_with_serialized_key, this,
                                       std::placeholders::_1, std::placeholders::_2);
+            if (_sorted_aggregation) {
+                runtime_profile()->append_exec_option("Sorted Streaming Preaggregation");
+                _sorted_agg_rows_counter =
+                        ADD_COUNTER(runtime_profile(), "SortedAggregationRows", TUnit::UNIT);
+                _executor.pre_agg =
+                        std::bind<Status>(&AggregationNode::_pre_agg_with_sorted_key, this,
+                                          std::placeholders::_1, std::placeholders::_2);
+            }
         }
 
         if (_needs_finalize) {
@@ -322,6 +364,26 @@ Status AggregationNode::prepare(RuntimeState* state) {
         _executor.update_memusage =
                 std::bind<void>(&AggregationNode::_update_memusage_with_serialized_key, this);
         _executor.close = std::bind<void>(&AggregationNode::_close_with_serialized_key, this);
+
+        if (_scan_aggregation) {
+            runtime_profile()->append_exec_option("Scan Aggregation");
+            // the blocks of the child are serialized the same as the spilled ones
+            _executor.execute = std::bind<Status>(&AggregationNode::_merge_spilled_block, this,
+                                                  std::placeholders::_1);
+            _executor.pre_agg =
+                    std::bind<Status>(&AggregationNode::_pass_through_scan_aggregated, this,
+                                      std::placeholders::_1, std::placeholders::_2);
+        }
+
+        _enable_spill = state->enable_spill() && !_is_streaming_preagg && !_is_scan_aggregator &&
+                        config::spill_aggregation_partition_count > 0;
+        if (_enable_spill) {
+            _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+            _spill_merge_timer = ADD_TIMER(runtime_profile(), "SpillMergeTime");
+            _spill_count = ADD_COUNTER(runtime_profile(), "SpillCount", TUnit::UNIT);
+            _spill_rows = ADD_COUNTER(runtime_profile(), "SpillRows", TUnit::UNIT);
+            _spill_bytes = ADD_COUNTER(runtime_profile(), "SpillBytes", TUnit::BYTES);
+        }
     }
 
     return Status::OK();
@@ -329,8 +391,28 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
 Status AggregationNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER_ERR_CB("aggregator, while execute open.");
+    RETURN_IF_ERROR(open_self(state));
+
+    RETURN_IF_ERROR(_children[0]->open(state));
+
+    // Streaming preaggregations do all processing in GetNext().
+    if (_is_streaming_preagg) return Status::OK();
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        release_block_memory(block);
+        RETURN_IF_ERROR(_children[0]->get_next(state, &block, &eos));
+        RETURN_IF_ERROR(sink(state, &block, eos));
+    }
+
+    return Status::OK();
+}
+
+Status AggregationNode::open_self(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::open(state));
 
     RETURN_IF_ERROR(VExpr::open(_probe_expr_ctxs, state));
@@ -339,29 +421,67 @@ Status AggregationNode::open(RuntimeState* state) {
         RETURN_IF_ERROR(_aggregate_evaluators[i]->open(state));
     }
 
-    RETURN_IF_ERROR(_children[0]->open(state));
-
-    // Streaming preaggregations do all processing in GetNext().
-    if (_is_streaming_preagg) return Status::OK();
     // move _create_agg_status to open not in during prepare,
     // because during prepare and open thread is not the same one,
     // this could cause unable to get JVM
-    if (_probe_expr_ctxs.empty()) {
+    if (!_is_streaming_preagg && _probe_expr_ctxs.empty()) {
         _create_agg_status(_agg_data.without_key);
     }
-    bool eos = false;
-    Block block;
-    while (!eos) {
-        RETURN_IF_CANCELLED(state);
-        release_block_memory(block);
-        RETURN_IF_ERROR(_children[0]->get_next(state, &block, &eos));
-        if (block.rows() == 0) {
-            continue;
-        }
-        RETURN_IF_ERROR(_executor.execute(&block));
+    return Status::OK();
+}
+
+Status AggregationNode::sink(RuntimeState* state, Block* block, bool eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER_ERR_CB("aggregator, while execute sink.");
+    if (block->rows() != 0) {
+        RETURN_IF_ERROR(_executor.execute(block));
         _executor.update_memusage();
+        if (_should_spill()) {
+            RETURN_IF_ERROR(_spill_hash_table(state));
+        }
+    }
+    if (!eos) {
+        return Status::OK();
     }
 
+    // once spilled, the data left in hash table is spilled too, then every partition
+    // could be merged and output independently.
+    if (!_spill_writers.empty()) {
+        RETURN_IF_ERROR(_spill_hash_table(state));
+        for (auto& writer : _spill_writers) {
+            RETURN_IF_ERROR(writer->close());
+        }
+        RETURN_IF_ERROR(_merge_spilled_partition(state));
+    }
+    return Status::OK();
+}
+
+Status AggregationNode::push(RuntimeState* state, Block* block, bool eos) {
+    DCHECK(_is_streaming_preagg);
+    RETURN_IF_CANCELLED(state);
+    _preagg_block.swap(*block);
+    _preagg_child_eos = eos;
+    return Status::OK();
+}
+
+Status AggregationNode::pull(RuntimeState* state, Block* block, bool* eos) {
+    DCHECK(_is_streaming_preagg);
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
+    SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER_ERR_CB("aggregator, while execute pull.");
+    if (_preagg_block.rows() != 0) {
+        RETURN_IF_ERROR(_executor.pre_agg(&_preagg_block, block));
+        release_block_memory(_preagg_block);
+    } else if (_preagg_child_eos) {
+        RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+    }
+    _num_rows_returned += block->rows();
+    _make_nullable_output_key(block);
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    _executor.update_memusage();
     return Status::OK();
 }
 
@@ -371,6 +491,7 @@ Status AggregationNode::get_next(RuntimeState* state, RowBatch* row_batch, bool*
 
 Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER_ERR_CB("aggregator, while execute get_next.");
 
@@ -394,6 +515,15 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
         COUNTER_SET(_rows_returned_counter, _num_rows_returned);
     } else {
         RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+        while (*eos && _has_unmerged_spilled_partition()) {
+            _destroy_and_reset_hash_table();
+            RETURN_IF_ERROR(_merge_spilled_partition(state));
+            *eos = false;
+            if (block->rows() != 0) {
+                break;
+            }
+            RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+        }
         _make_nullable_output_key(block);
         // dispose the having clause, should not be execute in prestreaming agg
         RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
@@ -410,6 +540,7 @@ Status AggregationNode::close(RuntimeState* state) {
     for (auto* aggregate_evaluator : _aggregate_evaluators) aggregate_evaluator->close(state);
     VExpr::close(_probe_expr_ctxs, state);
     if (_executor.close) _executor.close();
+    _remove_spill_files();
 
     return ExecNode::close(state);
 }
@@ -539,18 +670,10 @@ Status AggregationNode::_merge_without_key(Block* block) {
 
             for (int j = 0; j < rows; ++j) {
                 VectorBufferReader buffer_reader(((ColumnString*)(column.get()))->get_data_at(j));
-                _create_agg_status(deserialize_buffer.get());
-
-                _aggregate_evaluators[i]->function()->deserialize(
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
-
-                _aggregate_evaluators[i]->function()->merge(
+                _aggregate_evaluators[i]->function()->deserialize_and_merge(
                         _agg_data.without_key + _offsets_of_aggregate_states[i],
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i],
+                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
                         &_agg_arena_pool);
-
-                _destory_agg_status(deserialize_buffer.get());
             }
         } else {
             _aggregate_evaluators[i]->execute_single_add(
@@ -563,7 +686,9 @@ Status AggregationNode::_merge_without_key(Block* block) {
 
 void AggregationNode::_update_memusage_without_key() {
     _data_mem_tracker->consume(_agg_arena_pool.size() - _mem_usage_record.used_in_arena);
+    _data_mem_tracker->consume(_shared_distinct_keys_bytes() - _mem_usage_record.used_in_state);
     _mem_usage_record.used_in_arena = _agg_arena_pool.size();
+    _mem_usage_record.used_in_state = _shared_distinct_keys_bytes();
 }
 
 void AggregationNode::_close_without_key() {
@@ -633,6 +758,268 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
             _agg_data._aggregated_method_variant);
 }
 
+static bool is_slot_referenced(const VExpr* expr, int slot_id) {
+    if (expr->is_slot_ref() && static_cast<const VSlotRef*>(expr)->slot_id() == slot_id) {
+        return true;
+    }
+    for (const auto* child : expr->children()) {
+        if (is_slot_referenced(child, slot_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AggregationNode::_try_enable_dict_encoded_key() {
+    // The dictionary codes are only understood by the hash table, so the key must be a plain
+    // string slot which is not an argument of the aggregate functions, and the blocks of the
+    // scan node must not be cut by the limit.
+    if (_is_merge || _probe_expr_ctxs.size() != 1 ||
+        child(0)->type() != TPlanNodeType::OLAP_SCAN_NODE || child(0)->limit() != -1) {
+        return;
+    }
+    const VExpr* key_expr = _probe_expr_ctxs[0]->root();
+    if (!key_expr->is_slot_ref() ||
+        (key_expr->result_type() != TYPE_VARCHAR && key_expr->result_type() != TYPE_STRING)) {
+        return;
+    }
+    int slot_id = static_cast<const VSlotRef*>(key_expr)->slot_id();
+    for (auto* evaluator : _aggregate_evaluators) {
+        for (auto* ctx : evaluator->input_exprs_ctxs()) {
+            if (is_slot_referenced(ctx->root(), slot_id)) {
+                return;
+            }
+        }
+    }
+    static_cast<VOlapScanNode*>(child(0))->set_dict_output_slot(slot_id);
+}
+
+void AggregationNode::_try_enable_scan_aggregation() {
+    // The scanners can't tell how many rows the limit of the scan node needs, and the java
+    // udafs need the JVM attached to the thread.
+    if (!config::enable_scan_aggregation || _is_scan_aggregator || _is_merge ||
+        _probe_expr_ctxs.empty() || child(0)->type() != TPlanNodeType::OLAP_SCAN_NODE ||
+        child(0)->limit() != -1) {
+        return;
+    }
+    for (auto* evaluator : _aggregate_evaluators) {
+        if (evaluator->is_java_udaf()) {
+            return;
+        }
+    }
+    _scan_aggregation = true;
+    static_cast<VOlapScanNode*>(child(0))->set_scan_aggregation_node(this);
+}
+
+void AggregationNode::_try_enable_sorted_aggregation(RuntimeState* state) {
+    if (!config::enable_sorted_streaming_aggregation || !_is_streaming_preagg ||
+        _scan_aggregation || _is_scan_aggregator ||
+        child(0)->type() != TPlanNodeType::OLAP_SCAN_NODE) {
+        return;
+    }
+    // The rows of a tablet are returned ordered by the keys only when they are merged by
+    // the reader, i.e. the tables of AGG/UNIQUE keys without preaggregation. The rows of
+    // different scanners interleave, but the runs of equal keys are still long.
+    const auto& scan_node = static_cast<VOlapScanNode*>(child(0))->olap_scan_node();
+    if (!scan_node.__isset.keyType || scan_node.is_preaggregation ||
+        (scan_node.keyType != TKeysType::AGG_KEYS && scan_node.keyType != TKeysType::UNIQUE_KEYS) ||
+        _probe_expr_ctxs.size() > scan_node.key_column_name.size()) {
+        return;
+    }
+    // the grouping keys should be the first keys of the table in any order
+    std::set<std::string> key_prefix(
+            scan_node.key_column_name.begin(),
+            scan_node.key_column_name.begin() + _probe_expr_ctxs.size());
+    for (auto* ctx : _probe_expr_ctxs) {
+        const VExpr* key_expr = ctx->root();
+        if (!key_expr->is_slot_ref()) {
+            return;
+        }
+        auto* slot_desc = state->desc_tbl().get_slot_descriptor(
+                static_cast<const VSlotRef*>(key_expr)->slot_id());
+        if (slot_desc == nullptr || key_prefix.erase(slot_desc->col_name()) == 0) {
+            return;
+        }
+    }
+    _sorted_aggregation = true;
+}
+
+void AggregationNode::_try_share_distinct_keys(RuntimeState* state) {
+    // The states of the streaming, scan and spilled aggregations are destroyed before the node
+    // is closed, their keys would stay in the shared hash table.
+    if (!config::enable_shared_distinct_keys || _is_streaming_preagg || _scan_aggregation ||
+        _is_scan_aggregator || state->enable_spill()) {
+        return;
+    }
+    auto keys = std::make_shared<SharedDistinctKeys>();
+    std::vector<std::pair<AggFnEvaluator*, AggregateFunctionPtr>> shared_functions;
+    for (auto* evaluator : _aggregate_evaluators) {
+        // the serialized states need the keys of each state
+        auto function = evaluator->function()->create_shared_distinct(keys, !_needs_finalize);
+        if (function != nullptr) {
+            shared_functions.emplace_back(evaluator, std::move(function));
+        }
+    }
+    // a single distinct function is no better than with its own hash sets
+    if (shared_functions.size() < 2) {
+        return;
+    }
+    for (auto& [evaluator, function] : shared_functions) {
+        evaluator->set_function(std::move(function));
+    }
+    _shared_distinct_keys = std::move(keys);
+    runtime_profile()->append_exec_option("Shared Distinct Keys");
+}
+
+Status AggregationNode::create_scan_aggregator(RuntimeState* state,
+                                               std::unique_ptr<AggregationNode>* aggregator) {
+    DCHECK(_scan_aggregation);
+    // the having clause and the limit are applied by this node
+    TPlanNode tnode = _tnode;
+    tnode.__isset.vconjunct = false;
+    tnode.conjuncts.clear();
+    tnode.limit = -1;
+    tnode.agg_node.__set_use_streaming_preaggregation(false);
+    aggregator->reset(new AggregationNode(_pool, tnode, state->desc_tbl()));
+    auto& agg = **aggregator;
+    agg._is_scan_aggregator = true;
+    agg._scan_row_desc = &child(0)->row_desc();
+    RETURN_IF_ERROR(agg.init(tnode, state));
+    RETURN_IF_ERROR(agg.prepare(state));
+    return agg.open_self(state);
+}
+
+Status AggregationNode::flush_scan_aggregation(RuntimeState* state, Block* block, bool* eos) {
+    DCHECK(_is_scan_aggregator);
+    RETURN_IF_ERROR(_serialize_with_serialized_key_result(state, block, eos));
+    if (*eos) {
+        _destroy_and_reset_hash_table();
+        _executor.update_memusage();
+    }
+    return Status::OK();
+}
+
+size_t AggregationNode::scan_aggregation_groups() {
+    return std::visit([](auto&& agg_method) -> size_t { return agg_method.data.size(); },
+                      _agg_data._aggregated_method_variant);
+}
+
+Status AggregationNode::_pass_through_scan_aggregated(Block* in_block, Block* out_block) {
+    // the blocks are the output of the first phase aggregation already
+    out_block->swap(*in_block);
+    return Status::OK();
+}
+
+void AggregationNode::_emplace_into_hash_table_by_dict(AggregateDataPtr* places,
+                                                       const IColumn& key_column,
+                                                       size_t num_rows) {
+    const auto* nullable_col = check_and_get_column<ColumnNullable>(key_column);
+    const auto& dict_col = assert_cast<const ColumnDictI32&>(
+            nullable_col != nullptr ? nullable_col->get_nested_column() : key_column);
+    const auto& codes = dict_col.get_data();
+    size_t null_slot = dict_col.dict_size();
+
+    // code -> index of the distinct keys, the last one is for null
+    std::vector<int32_t> key_indexes(null_slot + 1, -1);
+    std::vector<uint32_t> row_keys(num_rows);
+    auto distinct_values = ColumnString::create();
+    auto distinct_null_map = ColumnUInt8::create();
+    for (size_t i = 0; i < num_rows; ++i) {
+        bool is_null = nullable_col != nullptr && nullable_col->is_null_at(i);
+        size_t slot = is_null ? null_slot : codes[i];
+        if (key_indexes[slot] < 0) {
+            key_indexes[slot] = distinct_values->size();
+            if (is_null) {
+                distinct_values->insert_default();
+            } else {
+                const auto& value = dict_col.get_value(codes[i]);
+                distinct_values->insert_data(value.ptr, value.len);
+            }
+            distinct_null_map->insert_value(is_null);
+        }
+        row_keys[i] = key_indexes[slot];
+    }
+
+    size_t num_keys = distinct_values->size();
+    MutableColumnPtr distinct_keys = std::move(distinct_values);
+    if (nullable_col != nullptr) {
+        distinct_keys =
+                ColumnNullable::create(std::move(distinct_keys), std::move(distinct_null_map));
+    }
+    ColumnRawPtrs distinct_key_columns {distinct_keys.get()};
+    PODArray<AggregateDataPtr> key_places(num_keys);
+    _emplace_into_hash_table(key_places.data(), distinct_key_columns, num_keys);
+
+    for (size_t i = 0; i < num_rows; ++i) {
+        places[i] = key_places[row_keys[i]];
+    }
+}
+
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places,
+                                               ColumnRawPtrs& key_columns, size_t num_rows) {
+    if (key_columns.size() == 1) {
+        const IColumn* key_column = key_columns[0];
+        if (const auto* nullable_col = check_and_get_column<ColumnNullable>(key_column)) {
+            key_column = &nullable_col->get_nested_column();
+        }
+        if (key_column->is_column_dictionary()) {
+            _emplace_into_hash_table_by_dict(places, *key_columns[0], num_rows);
+            return;
+        }
+    }
+
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using HashMethodType = std::decay_t<decltype(agg_method)>;
+                using AggState = typename HashMethodType::State;
+                AggState state(key_columns, _probe_key_sz, nullptr);
+                /// For all rows.
+                for (size_t i = 0; i < num_rows; ++i) {
+                    AggregateDataPtr aggregate_data = nullptr;
+
+                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
+
+                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
+                    if (emplace_result.is_inserted()) {
+                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
+                        emplace_result.set_mapped(nullptr);
+
+                        aggregate_data = _agg_arena_pool.aligned_alloc(
+                                _total_size_of_aggregate_states, _align_aggregate_states);
+                        _create_agg_status(aggregate_data);
+
+                        emplace_result.set_mapped(aggregate_data);
+                    } else
+                        aggregate_data = emplace_result.get_mapped();
+
+                    places[i] = aggregate_data;
+                    assert(places[i] != nullptr);
+                }
+            },
+            _agg_data._aggregated_method_variant);
+
+    _convert_to_two_level_if_needed();
+}
+
+void AggregationNode::_convert_to_two_level_if_needed() {
+    if (_agg_data.is_two_level() || !_agg_data.is_two_level_supported()) {
+        return;
+    }
+    bool should_convert = std::visit(
+            [&](auto&& agg_method) -> bool {
+                auto& data = agg_method.data;
+                return static_cast<int64_t>(data.size()) >
+                               config::two_level_aggregation_threshold_rows ||
+                       static_cast<int64_t>(data.get_buffer_size_in_bytes()) >
+                               config::two_level_aggregation_threshold_bytes;
+            },
+            _agg_data._aggregated_method_variant);
+    if (should_convert) {
+        SCOPED_TIMER(_convert_to_two_level_timer);
+        _agg_data.convert_to_two_level();
+    }
+}
+
 Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* in_block,
                                                      doris::vectorized::Block* out_block) {
     SCOPED_TIMER(_build_timer);
@@ -661,124 +1048,266 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
     // pressure. In either case we should always use the remaining space in the hash table
     // to avoid wasting memory.
     // But for fixed hash map, it never need to expand
+    // Besides, once the sampled batches show that aggregation is not paying off, the rows
+    // bypass the hash table directly, see `_update_preagg_bypass`.
     bool ret_flag = false;
+    size_t ht_rows_before = 0;
     std::visit(
             [&](auto&& agg_method) -> void {
-                if (auto& hash_tbl = agg_method.data; hash_tbl.add_elem_size_overflow(rows)) {
-                    // do not try to do agg, just init and serialize directly return the out_block
-                    if (!_should_expand_preagg_hash_tables()) {
-                        ret_flag = true;
-                        if (_streaming_pre_places.size() < rows) {
-                            _streaming_pre_places.reserve(rows);
-                            for (size_t i = _streaming_pre_places.size(); i < rows; ++i) {
-                                _streaming_pre_places.emplace_back(_agg_arena_pool.aligned_alloc(
-                                        _total_size_of_aggregate_states, _align_aggregate_states));
-                            }
-                        }
+                auto& hash_tbl = agg_method.data;
+                ht_rows_before = hash_tbl.size();
+                if (_preagg_bypass &&
+                    ++_preagg_bypass_batches % STREAMING_PREAGG_RESAMPLE_INTERVAL != 0) {
+                    ret_flag = true;
+                } else if (hash_tbl.add_elem_size_overflow(rows)) {
+                    ret_flag = !_should_expand_preagg_hash_tables();
+                }
+            },
+            _agg_data._aggregated_method_variant);
 
-                        for (size_t i = 0; i < rows; ++i) {
-                            _create_agg_status(_streaming_pre_places[i]);
-                        }
+    if (ret_flag) {
+        // do not try to do agg, just init and serialize directly return the out_block
+        COUNTER_UPDATE(_streaming_pass_through_rows_counter, rows);
+        // the keys are output as they are
+        std::vector<ColumnPtr> materialized_key_columns(key_size);
+        for (int i = 0; i < key_size; ++i) {
+            materialized_key_columns[i] = key_columns[i]->convert_to_string_column_if_dictionary();
+            key_columns[i] = materialized_key_columns[i].get();
+        }
+        if (_streaming_pre_places.size() < rows) {
+            _streaming_pre_places.reserve(rows);
+            for (size_t i = _streaming_pre_places.size(); i < rows; ++i) {
+                _streaming_pre_places.emplace_back(_agg_arena_pool.aligned_alloc(
+                        _total_size_of_aggregate_states, _align_aggregate_states));
+            }
+        }
 
-                        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-                            _aggregate_evaluators[i]->execute_batch_add(
-                                    in_block, _offsets_of_aggregate_states[i],
-                                    _streaming_pre_places.data(), &_agg_arena_pool);
-                        }
+        for (size_t i = 0; i < rows; ++i) {
+            _create_agg_status(_streaming_pre_places[i]);
+        }
 
-                        // will serialize value data to string column
-                        std::vector<VectorBufferWriter> value_buffer_writers;
-                        bool mem_reuse = out_block->mem_reuse();
-                        auto serialize_string_type = std::make_shared<DataTypeString>();
-                        MutableColumns value_columns;
-                        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-                            if (mem_reuse) {
-                                value_columns.emplace_back(
-                                        std::move(*out_block->get_by_position(i + key_size).column)
-                                                .mutate());
-                            } else {
-                                // slot type of value it should always be string type
-                                value_columns.emplace_back(serialize_string_type->create_column());
-                            }
-                            value_buffer_writers.emplace_back(
-                                    *reinterpret_cast<ColumnString*>(value_columns[i].get()));
-                        }
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
+                                                        _streaming_pre_places.data(),
+                                                        &_agg_arena_pool);
+        }
 
-                        for (size_t j = 0; j < rows; ++j) {
-                            for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                _aggregate_evaluators[i]->function()->serialize(
-                                        _streaming_pre_places[j] + _offsets_of_aggregate_states[i],
-                                        value_buffer_writers[i]);
-                                value_buffer_writers[i].commit();
-                            }
-                        }
+        // will serialize value data to string column
+        std::vector<VectorBufferWriter> value_buffer_writers;
+        bool mem_reuse = out_block->mem_reuse();
+        auto serialize_string_type = std::make_shared<DataTypeString>();
+        MutableColumns value_columns;
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            if (mem_reuse) {
+                value_columns.emplace_back(
+                        std::move(*out_block->get_by_position(i + key_size).column).mutate());
+            } else {
+                // slot type of value it should always be string type
+                value_columns.emplace_back(serialize_string_type->create_column());
+            }
+            value_buffer_writers.emplace_back(
+                    *reinterpret_cast<ColumnString*>(value_columns[i].get()));
+        }
 
-                        if (!mem_reuse) {
-                            ColumnsWithTypeAndName columns_with_schema;
-                            for (int i = 0; i < key_size; ++i) {
-                                columns_with_schema.emplace_back(
-                                        key_columns[i]->clone_resized(rows),
-                                        _probe_expr_ctxs[i]->root()->data_type(),
-                                        _probe_expr_ctxs[i]->root()->expr_name());
-                            }
-                            for (int i = 0; i < value_columns.size(); ++i) {
-                                columns_with_schema.emplace_back(std::move(value_columns[i]),
-                                                                 serialize_string_type, "");
-                            }
-                            out_block->swap(Block(columns_with_schema));
-                        } else {
-                            for (int i = 0; i < key_size; ++i) {
-                                std::move(*out_block->get_by_position(i).column)
-                                        .mutate()
-                                        ->insert_range_from(*key_columns[i], 0, rows);
-                            }
-                        }
-                    }
-                }
-            },
-            _agg_data._aggregated_method_variant);
+        for (size_t j = 0; j < rows; ++j) {
+            for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                _aggregate_evaluators[i]->function()->serialize(
+                        _streaming_pre_places[j] + _offsets_of_aggregate_states[i],
+                        value_buffer_writers[i]);
+                value_buffer_writers[i].commit();
+            }
+            // the places are reused by the next batch
+            _destory_agg_status(_streaming_pre_places[j]);
+        }
 
-    if (!ret_flag) {
-        std::visit(
-                [&](auto&& agg_method) -> void {
-                    using HashMethodType = std::decay_t<decltype(agg_method)>;
-                    using AggState = typename HashMethodType::State;
-                    AggState state(key_columns, _probe_key_sz, nullptr);
-                    /// For all rows.
-                    for (size_t i = 0; i < rows; ++i) {
-                        AggregateDataPtr aggregate_data = nullptr;
-
-                        auto emplace_result =
-                                state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                        /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                        if (emplace_result.is_inserted()) {
-                            /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                            emplace_result.set_mapped(nullptr);
-
-                            aggregate_data = _agg_arena_pool.aligned_alloc(
-                                    _total_size_of_aggregate_states, _align_aggregate_states);
-                            _create_agg_status(aggregate_data);
-
-                            emplace_result.set_mapped(aggregate_data);
-                        } else
-                            aggregate_data = emplace_result.get_mapped();
-
-                        places[i] = aggregate_data;
-                        assert(places[i] != nullptr);
-                    }
-                },
-                _agg_data._aggregated_method_variant);
+        if (!mem_reuse) {
+            ColumnsWithTypeAndName columns_with_schema;
+            for (int i = 0; i < key_size; ++i) {
+                columns_with_schema.emplace_back(key_columns[i]->clone_resized(rows),
+                                                 _probe_expr_ctxs[i]->root()->data_type(),
+                                                 _probe_expr_ctxs[i]->root()->expr_name());
+            }
+            for (int i = 0; i < value_columns.size(); ++i) {
+                columns_with_schema.emplace_back(std::move(value_columns[i]),
+                                                 serialize_string_type, "");
+            }
+            out_block->swap(Block(columns_with_schema));
+        } else {
+            for (int i = 0; i < key_size; ++i) {
+                std::move(*out_block->get_by_position(i).column)
+                        .mutate()
+                        ->insert_range_from(*key_columns[i], 0, rows);
+            }
+        }
+    } else {
+        _emplace_into_hash_table(places.data(), key_columns, rows);
 
         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
             _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
                                                         places.data(), &_agg_arena_pool);
         }
+        _update_preagg_bypass(rows, ht_rows_before);
     }
 
     return Status::OK();
 }
 
+Status AggregationNode::_pre_agg_with_sorted_key(Block* in_block, Block* out_block) {
+    if (!_sorted_aggregation) {
+        return _pre_agg_with_serialized_key(in_block, out_block);
+    }
+    SCOPED_TIMER(_build_timer);
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    {
+        SCOPED_TIMER(_expr_timer);
+        for (size_t i = 0; i < key_size; ++i) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(in_block, &result_column_id));
+            in_block->get_by_position(result_column_id).column =
+                    in_block->get_by_position(result_column_id)
+                            .column->convert_to_full_column_if_const();
+            key_columns[i] = in_block->get_by_position(result_column_id).column.get();
+        }
+    }
+
+    // the first row of every run of equal keys
+    size_t rows = in_block->rows();
+    std::vector<size_t> run_starts;
+    for (size_t j = 0; j < rows; ++j) {
+        bool new_run = j == 0;
+        for (size_t i = 0; i < key_size && !new_run; ++i) {
+            new_run = key_columns[i]->compare_at(j, j - 1, *key_columns[i], 1) != 0;
+        }
+        if (new_run) {
+            run_starts.push_back(j);
+        }
+    }
+    size_t runs = run_starts.size();
+
+    if (_streaming_pre_places.size() < runs) {
+        _streaming_pre_places.reserve(runs);
+        for (size_t i = _streaming_pre_places.size(); i < runs; ++i) {
+            _streaming_pre_places.emplace_back(_agg_arena_pool.aligned_alloc(
+                    _total_size_of_aggregate_states, _align_aggregate_states));
+        }
+    }
+    PODArray<AggregateDataPtr> places(rows);
+    for (size_t r = 0; r < runs; ++r) {
+        _create_agg_status(_streaming_pre_places[r]);
+        size_t end = r + 1 < runs ? run_starts[r + 1] : rows;
+        for (size_t j = run_starts[r]; j < end; ++j) {
+            places[j] = _streaming_pre_places[r];
+        }
+    }
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
+                                                    places.data(), &_agg_arena_pool);
+    }
+
+    // output one row for every run, the same as the rows passed through by the hash table
+    bool mem_reuse = out_block->mem_reuse();
+    auto serialize_string_type = std::make_shared<DataTypeString>();
+    MutableColumns output_key_columns;
+    MutableColumns value_columns;
+    std::vector<VectorBufferWriter> value_buffer_writers;
+    for (int i = 0; i < key_size; ++i) {
+        if (mem_reuse) {
+            output_key_columns.emplace_back(
+                    std::move(*out_block->get_by_position(i).column).mutate());
+        } else {
+            output_key_columns.emplace_back(key_columns[i]->clone_empty());
+        }
+        for (size_t r = 0; r < runs; ++r) {
+            output_key_columns[i]->insert_from(*key_columns[i], run_starts[r]);
+        }
+    }
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        if (mem_reuse) {
+            value_columns.emplace_back(
+                    std::move(*out_block->get_by_position(i + key_size).column).mutate());
+        } else {
+            value_columns.emplace_back(serialize_string_type->create_column());
+        }
+        value_buffer_writers.emplace_back(*reinterpret_cast<ColumnString*>(value_columns[i].get()));
+    }
+    for (size_t r = 0; r < runs; ++r) {
+        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+            _aggregate_evaluators[i]->function()->serialize(
+                    _streaming_pre_places[r] + _offsets_of_aggregate_states[i],
+                    value_buffer_writers[i]);
+            value_buffer_writers[i].commit();
+        }
+        // the places are reused by the next batch
+        _destory_agg_status(_streaming_pre_places[r]);
+    }
+    if (!mem_reuse) {
+        ColumnsWithTypeAndName columns_with_schema;
+        for (int i = 0; i < key_size; ++i) {
+            columns_with_schema.emplace_back(std::move(output_key_columns[i]),
+                                             _probe_expr_ctxs[i]->root()->data_type(),
+                                             _probe_expr_ctxs[i]->root()->expr_name());
+        }
+        for (int i = 0; i < value_columns.size(); ++i) {
+            columns_with_schema.emplace_back(std::move(value_columns[i]), serialize_string_type,
+                                             "");
+        }
+        out_block->swap(Block(columns_with_schema));
+    }
+    COUNTER_UPDATE(_sorted_agg_rows_counter, rows);
+
+    // the rows are not ordered by the keys actually, e.g. the rowsets of a single version
+    // tablet are not merged, let the hash table aggregate them
+    _sorted_agg_input_rows += rows;
+    _sorted_agg_output_rows += runs;
+    if (_sorted_agg_input_rows >= SORTED_PREAGG_SAMPLE_ROWS) {
+        if (_sorted_agg_output_rows * 2 > _sorted_agg_input_rows) {
+            _sorted_aggregation = false;
+        }
+        _sorted_agg_input_rows = 0;
+        _sorted_agg_output_rows = 0;
+    }
+    return Status::OK();
+}
+
+void AggregationNode::_update_preagg_bypass(size_t rows, size_t ht_rows_before) {
+    // the fixed hash maps of int8/int16 keys never grow, aggregating into them is always cheap
+    if (_agg_data._type == AggregatedDataVariants::Type::int8_key ||
+        _agg_data._type == AggregatedDataVariants::Type::int16_key) {
+        return;
+    }
+
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                auto& hash_tbl = agg_method.data;
+                size_t ht_mem = hash_tbl.get_buffer_size_in_bytes();
+                size_t new_keys = hash_tbl.size() - ht_rows_before;
+
+                // Aggregate into the hash table freely while it stays in the L2 cache.
+                int cache_level = 0;
+                while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
+                       ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
+                    ++cache_level;
+                }
+                if (cache_level == 0) {
+                    _preagg_bypass = false;
+                    return;
+                }
+
+                // The reduction of this batch is how many input rows were merged into each
+                // new key, bypass the following batches if it is under the minimum reduction
+                // of the current cache level.
+                double batch_reduction = static_cast<double>(rows) / std::max<size_t>(new_keys, 1);
+                bool bypass = batch_reduction <
+                              STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+                if (bypass && !_preagg_bypass) {
+                    COUNTER_UPDATE(_streaming_bypass_counter, 1);
+                }
+                _preagg_bypass = bypass;
+            },
+            _agg_data._aggregated_method_variant);
+}
+
 Status AggregationNode::_execute_with_serialized_key(Block* block) {
     SCOPED_TIMER(_build_timer);
     DCHECK(!_probe_expr_ctxs.empty());
@@ -800,35 +1329,7 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
 
-    std::visit(
-            [&](auto&& agg_method) -> void {
-                using HashMethodType = std::decay_t<decltype(agg_method)>;
-                using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
-                /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
-                    AggregateDataPtr aggregate_data = nullptr;
-
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                    if (emplace_result.is_inserted()) {
-                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                        emplace_result.set_mapped(nullptr);
-
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
-                        _create_agg_status(aggregate_data);
-
-                        emplace_result.set_mapped(aggregate_data);
-                    } else
-                        aggregate_data = emplace_result.get_mapped();
-
-                    places[i] = aggregate_data;
-                    assert(places[i] != nullptr);
-                }
-            },
-            _agg_data._aggregated_method_variant);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
@@ -1019,35 +1520,7 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
 
-    std::visit(
-            [&](auto&& agg_method) -> void {
-                using HashMethodType = std::decay_t<decltype(agg_method)>;
-                using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
-                /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
-                    AggregateDataPtr aggregate_data = nullptr;
-
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                    if (emplace_result.is_inserted()) {
-                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                        emplace_result.set_mapped(nullptr);
-
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
-                        _create_agg_status(aggregate_data);
-
-                        emplace_result.set_mapped(aggregate_data);
-                    } else
-                        aggregate_data = emplace_result.get_mapped();
-
-                    places[i] = aggregate_data;
-                    assert(places[i] != nullptr);
-                }
-            },
-            _agg_data._aggregated_method_variant);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
 
@@ -1060,18 +1533,10 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
 
             for (int j = 0; j < rows; ++j) {
                 VectorBufferReader buffer_reader(((ColumnString*)(column.get()))->get_data_at(j));
-                _create_agg_status(deserialize_buffer.get());
-
-                _aggregate_evaluators[i]->function()->deserialize(
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
-
-                _aggregate_evaluators[i]->function()->merge(
+                _aggregate_evaluators[i]->function()->deserialize_and_merge(
                         places.data()[j] + _offsets_of_aggregate_states[i],
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i],
+                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
                         &_agg_arena_pool);
-
-                _destory_agg_status(deserialize_buffer.get());
             }
         } else {
             _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
@@ -1087,9 +1552,10 @@ void AggregationNode::_update_memusage_with_serialized_key() {
                 auto& data = agg_method.data;
                 _data_mem_tracker->consume(_agg_arena_pool.size() -
                                            _mem_usage_record.used_in_arena);
-                _data_mem_tracker->consume(data.get_buffer_size_in_bytes() -
-                                           _mem_usage_record.used_in_state);
-                _mem_usage_record.used_in_state = data.get_buffer_size_in_bytes();
+                int64_t used_in_state =
+                        data.get_buffer_size_in_bytes() + _shared_distinct_keys_bytes();
+                _data_mem_tracker->consume(used_in_state - _mem_usage_record.used_in_state);
+                _mem_usage_record.used_in_state = used_in_state;
                 _mem_usage_record.used_in_arena = _agg_arena_pool.size();
             },
             _agg_data._aggregated_method_variant);
@@ -1110,6 +1576,171 @@ void AggregationNode::_close_with_serialized_key() {
     release_tracker();
 }
 
+bool AggregationNode::_should_spill() const {
+    if (!_enable_spill) {
+        return false;
+    }
+    return _mem_usage_record.used_in_arena + _mem_usage_record.used_in_state >=
+           MemoryReservationMgr::spill_threshold(config::spill_aggregation_threshold_bytes);
+}
+
+Status AggregationNode::_spill_hash_table(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    if (_spill_writers.empty()) {
+        int partition_count = config::spill_aggregation_partition_count;
+        for (int i = 0; i < partition_count; ++i) {
+            auto writer = std::make_unique<BlockSpillWriter>(
+                    BlockSpillWriter::gen_spill_path(state->query_id(),
+                                                     fmt::format("agg_{}_{}", id(), i)),
+                    state->exec_env()->block_spill_mgr(), state->query_id());
+            RETURN_IF_ERROR(writer->open());
+            _spill_writers.emplace_back(std::move(writer));
+        }
+        runtime_profile()->append_exec_option("Spilled");
+    }
+
+    // the hash table is serialized the same as the output of first phase aggregation,
+    // key columns followed by serialized aggregate states.
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        block.clear();
+        RETURN_IF_ERROR(_serialize_with_serialized_key_result(state, &block, &eos));
+        COUNTER_UPDATE(_spill_rows, block.rows());
+        RETURN_IF_ERROR(_spill_block_by_partition(block));
+    }
+
+    _destroy_and_reset_hash_table();
+    _executor.update_memusage();
+    COUNTER_UPDATE(_spill_count, 1);
+    return Status::OK();
+}
+
+Status AggregationNode::_spill_block_by_partition(const Block& block) {
+    size_t rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+
+    size_t partition_count = _spill_writers.size();
+    size_t key_size = _probe_expr_ctxs.size();
+    IColumn::Selector selector(rows);
+    {
+        std::vector<SipHash> siphashs(rows);
+        for (size_t i = 0; i < key_size; ++i) {
+            const auto& column = block.get_by_position(i).column;
+            for (size_t j = 0; j < rows; ++j) {
+                column->update_hash_with_value(j, siphashs[j]);
+            }
+        }
+        for (size_t j = 0; j < rows; ++j) {
+            selector[j] = siphashs[j].get64() % partition_count;
+        }
+    }
+
+    std::vector<MutableColumns> partition_columns(partition_count);
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto scattered = block.get_by_position(i).column->scatter(partition_count, selector);
+        for (size_t p = 0; p < partition_count; ++p) {
+            partition_columns[p].emplace_back(std::move(scattered[p]));
+        }
+    }
+
+    for (size_t p = 0; p < partition_count; ++p) {
+        if (partition_columns[p][0]->empty()) {
+            continue;
+        }
+        Block partition_block = block.clone_empty();
+        partition_block.set_columns(std::move(partition_columns[p]));
+        auto& writer = _spill_writers[p];
+        int64_t bytes_before = writer->written_bytes();
+        RETURN_IF_ERROR(writer->write(partition_block));
+        COUNTER_UPDATE(_spill_bytes, writer->written_bytes() - bytes_before);
+    }
+    return Status::OK();
+}
+
+Status AggregationNode::_merge_spilled_partition(RuntimeState* state) {
+    SCOPED_TIMER(_spill_merge_timer);
+    DCHECK(_has_unmerged_spilled_partition());
+    BlockSpillReader reader(_spill_writers[_spill_partition_index]->path());
+    RETURN_IF_ERROR(reader.open());
+    ++_spill_partition_index;
+
+    Block block;
+    bool eos = false;
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(reader.read(&block, &eos));
+        if (eos) {
+            break;
+        }
+        RETURN_IF_ERROR(_merge_spilled_block(&block));
+        _executor.update_memusage();
+    }
+    return reader.close();
+}
+
+Status AggregationNode::_merge_spilled_block(Block* block) {
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        key_columns[i] = block->get_by_position(i).column.get();
+    }
+
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
+
+    // all the aggregate states are spilled in serialized format, so merge them no matter
+    // the evaluator is merge or not.
+    std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        const auto* column =
+                assert_cast<const ColumnString*>(block->get_by_position(i + key_size).column.get());
+        for (int j = 0; j < rows; ++j) {
+            VectorBufferReader buffer_reader(column->get_data_at(j));
+            _aggregate_evaluators[i]->function()->deserialize_and_merge(
+                    places.data()[j] + _offsets_of_aggregate_states[i],
+                    deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
+                    &_agg_arena_pool);
+        }
+    }
+    return Status::OK();
+}
+
+void AggregationNode::_destroy_and_reset_hash_table() {
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                auto& data = agg_method.data;
+                data.for_each_mapped([&](auto& mapped) {
+                    if (mapped) {
+                        _destory_agg_status(mapped);
+                        mapped = nullptr;
+                    }
+                });
+                if (data.has_null_key_data()) {
+                    _destory_agg_status(data.get_null_key_data());
+                }
+            },
+            _agg_data._aggregated_method_variant);
+    _agg_data.reset();
+    _agg_arena_pool.clear();
+}
+
+void AggregationNode::_remove_spill_files() {
+    for (size_t i = 0; i < _spill_writers.size(); ++i) {
+        auto& writer = _spill_writers[i];
+        writer->close();
+        // the merged partitions have been removed by spill reader
+        if (i >= _spill_partition_index) {
+            BlockSpillManager::remove_file(writer->path());
+        }
+    }
+    _spill_writers.clear();
+}
+
 void AggregationNode::release_tracker() {
     _data_mem_tracker->release(_mem_usage_record.used_in_state + _mem_usage_record.used_in_arena);
 }
@@ -23,8 +23,11 @@
 #include "common/object_pool.h"
 #include "exec/exec_node.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/aggregate_function_distinct_shared.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/fixed_hash_map.h"
+#include "vec/common/hash_table/two_level_hash_map.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 
 namespace doris {
@@ -74,6 +77,8 @@ struct AggregationMethodSerialized {
 
 using AggregatedDataWithoutKey = AggregateDataPtr;
 using AggregatedDataWithStringKey = HashMapWithSavedHash<StringRef, AggregateDataPtr>;
+using AggregatedDataWithStringKeyTwoLevel =
+        TwoLevelHashMapWithSavedHash<StringRef, AggregateDataPtr>;
 
 /// For the case where there is one numeric key.
 /// FieldType is UInt8/16/32/64 for any type with corresponding bit width.
@@ -117,6 +122,13 @@ template <typename Base>
 struct AggregationDataWithNullKey : public Base {
     using Base::Base;
 
+    // Convert from the hash table of another level, the null key data is kept.
+    template <typename Other>
+    explicit AggregationDataWithNullKey(const Other& other)
+            : Base(other),
+              has_null_key(other.has_null_key_data()),
+              null_key_data(other.get_null_key_data()) {}
+
     bool& has_null_key_data() { return has_null_key; }
     AggregateDataPtr& get_null_key_data() { return null_key_data; }
     bool has_null_key_data() const { return has_null_key; }
@@ -253,6 +265,15 @@ using AggregatedDataWithUInt64Key = HashMap<UInt64, AggregateDataPtr, HashCRC32<
 using AggregatedDataWithUInt128Key = HashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
 using AggregatedDataWithUInt256Key = HashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
 
+using AggregatedDataWithUInt32KeyTwoLevel =
+        TwoLevelHashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
+using AggregatedDataWithUInt64KeyTwoLevel =
+        TwoLevelHashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
+using AggregatedDataWithUInt128KeyTwoLevel =
+        TwoLevelHashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
+using AggregatedDataWithUInt256KeyTwoLevel =
+        TwoLevelHashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
+
 using AggregatedDataWithNullableUInt8Key = AggregationDataWithNullKey<AggregatedDataWithUInt8Key>;
 using AggregatedDataWithNullableUInt16Key = AggregationDataWithNullKey<AggregatedDataWithUInt16Key>;
 using AggregatedDataWithNullableUInt32Key = AggregationDataWithNullKey<AggregatedDataWithUInt32Key>;
@@ -260,6 +281,13 @@ using AggregatedDataWithNullableUInt64Key = AggregationDataWithNullKey<Aggregate
 using AggregatedDataWithNullableUInt128Key =
         AggregationDataWithNullKey<AggregatedDataWithUInt128Key>;
 
+using AggregatedDataWithNullableUInt32KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt32KeyTwoLevel>;
+using AggregatedDataWithNullableUInt64KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt64KeyTwoLevel>;
+using AggregatedDataWithNullableUInt128KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt128KeyTwoLevel>;
+
 using AggregatedMethodVariants = std::variant<
         AggregationMethodSerialized<AggregatedDataWithStringKey>,
         AggregationMethodOneNumber<UInt8, AggregatedDataWithUInt8Key, false>,
@@ -282,7 +310,23 @@ using AggregatedMethodVariants = std::variant<
         AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, false>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, true>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, false>,
-        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>>;
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>,
+        AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>,
+        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt128, AggregatedDataWithUInt128KeyTwoLevel>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt32, AggregatedDataWithNullableUInt32KeyTwoLevel>>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt64, AggregatedDataWithNullableUInt64KeyTwoLevel>>,
+        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                UInt128, AggregatedDataWithNullableUInt128KeyTwoLevel>>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, true>>;
 
 struct AggregatedDataVariants {
     AggregatedDataVariants() = default;
@@ -307,9 +351,17 @@ struct AggregatedDataVariants {
     };
 
     Type _type = Type::EMPTY;
+    bool _is_nullable = false;
+    bool _is_two_level = false;
+
+    // Drop all the keys in hash table and reinit an empty one with the same type.
+    // Caller should destroy the aggregate states before reset.
+    void reset() { init(_type, _is_nullable); }
 
     void init(Type type, bool is_nullable = false) {
         _type = type;
+        _is_nullable = is_nullable;
+        _is_two_level = false;
         switch (_type) {
         case Type::without_key:
             break;
@@ -396,11 +448,129 @@ struct AggregatedDataVariants {
             DCHECK(false) << "Do not have a rigth agg data type";
         }
     }
+
+    bool is_two_level() const { return _is_two_level; }
+
+    // The fixed hash maps of int8/int16 keys never grow, so they have no two level version.
+    bool is_two_level_supported() const {
+        switch (_type) {
+        case Type::serialized:
+        case Type::int32_key:
+        case Type::int64_key:
+        case Type::int128_key:
+        case Type::int64_keys:
+        case Type::int128_keys:
+        case Type::int256_keys:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Move all the keys into a two level hash table, the aggregate states are kept as they are.
+    void convert_to_two_level() {
+        DCHECK(!_is_two_level && is_two_level_supported());
+        switch (_type) {
+        case Type::serialized:
+            _convert_to_two_level<AggregationMethodSerialized<AggregatedDataWithStringKey>,
+                                  AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>>();
+            break;
+        case Type::int32_key:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt32, AggregatedDataWithNullableUInt32Key>>,
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt32, AggregatedDataWithNullableUInt32KeyTwoLevel>>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>,
+                        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>>();
+            }
+            break;
+        case Type::int64_key:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt64, AggregatedDataWithNullableUInt64Key>>,
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt64, AggregatedDataWithNullableUInt64KeyTwoLevel>>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>,
+                        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>>();
+            }
+            break;
+        case Type::int128_key:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt128, AggregatedDataWithNullableUInt128Key>>,
+                        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                UInt128, AggregatedDataWithNullableUInt128KeyTwoLevel>>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodOneNumber<UInt128, AggregatedDataWithUInt128Key>,
+                        AggregationMethodOneNumber<UInt128,
+                                                   AggregatedDataWithUInt128KeyTwoLevel>>();
+            }
+            break;
+        case Type::int64_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>>();
+            }
+            break;
+        case Type::int128_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel,
+                                                   false>>();
+            }
+            break;
+        case Type::int256_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel,
+                                                   false>>();
+            }
+            break;
+        default:
+            DCHECK(false) << "Do not have a two level agg data type";
+            return;
+        }
+        _is_two_level = true;
+    }
+
+private:
+    template <typename Method, typename TwoLevelMethod>
+    void _convert_to_two_level() {
+        AggregatedMethodVariants two_level;
+        two_level.emplace<TwoLevelMethod>(std::get<Method>(_aggregated_method_variant));
+        _aggregated_method_variant = std::move(two_level);
+    }
 };
 
 using AggregatedDataVariantsPtr = std::shared_ptr<AggregatedDataVariants>;
 
-// not support spill
+// Support spill only when the node is not streaming preagg and has group by keys,
+// the hash table is serialized and hash partitioned to spill files when it exceeds
+// `spill_aggregation_threshold_bytes`, and merged back partition by partition at last.
 class AggregationNode : public ::doris::ExecNode {
 public:
     using Sizes = std::vector<size_t>;
@@ -414,6 +584,28 @@ public:
     virtual Status get_next(RuntimeState* state, Block* block, bool* eos);
     virtual Status close(RuntimeState* state);
 
+    Status open_self(RuntimeState* state) override;
+    // A streaming preaggregation processes the blocks by push() and pull() in pipelines,
+    // otherwise it breaks the pipelines and aggregates all the blocks by sink().
+    Status sink(RuntimeState* state, Block* block, bool eos) override;
+    Status push(RuntimeState* state, Block* block, bool eos) override;
+    Status pull(RuntimeState* state, Block* block, bool* eos) override;
+    bool need_more_input_data() const override {
+        return _preagg_block.rows() == 0 && !_preagg_child_eos;
+    }
+
+    bool is_streaming_preagg() const { return _is_streaming_preagg; }
+
+    // Create an aggregator which runs the aggregation of this node on the blocks of a scanner
+    // of the child scan node in the scanner thread, see config::enable_scan_aggregation. The
+    // blocks are aggregated by sink() with eos false, and serialized by flush_scan_aggregation().
+    Status create_scan_aggregator(RuntimeState* state,
+                                  std::unique_ptr<AggregationNode>* aggregator);
+    // Serialize the rows aggregated by a scan aggregator the same as the output of the first
+    // phase aggregation, and reset the hash table.
+    Status flush_scan_aggregation(RuntimeState* state, Block* block, bool* eos);
+    size_t scan_aggregation_groups();
+
 private:
     // group by k1,k2
     std::vector<VExprContext*> _probe_expr_ctxs;
@@ -452,17 +644,59 @@ private:
     RuntimeProfile::Counter* _merge_timer;
     RuntimeProfile::Counter* _expr_timer;
     RuntimeProfile::Counter* _get_results_timer;
+    RuntimeProfile::Counter* _convert_to_two_level_timer;
 
     bool _is_streaming_preagg;
     Block _preagg_block = Block();
+    // whether the last block of the child is pushed
+    bool _preagg_child_eos = false;
     bool _should_expand_hash_table = true;
+    // bypass the hash table of streaming preagg since the sampled reduction is too low
+    bool _preagg_bypass = false;
+    int64_t _preagg_bypass_batches = 0;
+    RuntimeProfile::Counter* _streaming_pass_through_rows_counter = nullptr;
+    RuntimeProfile::Counter* _streaming_bypass_counter = nullptr;
     std::vector<char*> _streaming_pre_places;
+    // Streaming preagg over the blocks ordered by the grouping keys, the consecutive rows of
+    // equal keys are aggregated without the hash table, see _pre_agg_with_sorted_key.
+    bool _sorted_aggregation = false;
+    int64_t _sorted_agg_input_rows = 0;
+    int64_t _sorted_agg_output_rows = 0;
+    RuntimeProfile::Counter* _sorted_agg_rows_counter = nullptr;
+
+    // Whether the blocks of the child are aggregated by the scan aggregators, they are merged
+    // by the hash table, or passed through by the streaming preaggregation.
+    bool _scan_aggregation = false;
+    const TPlanNode _tnode;
+    // the scan aggregator created by the node, it has no child but the row descriptor of the
+    // scan node
+    bool _is_scan_aggregator = false;
+    const RowDescriptor* _scan_row_desc = nullptr;
+
+    // the distinct keys shared by the multi_distinct_* functions, see _try_share_distinct_keys
+    SharedDistinctKeysPtr _shared_distinct_keys;
+
+    bool _enable_spill = false;
+    // one spill file for each hash partition, data of all the spilled rounds is appended
+    std::vector<BlockSpillWriterUPtr> _spill_writers;
+    // the next spilled partition to be merged back
+    size_t _spill_partition_index = 0;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_merge_timer = nullptr;
+    RuntimeProfile::Counter* _spill_count = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+    RuntimeProfile::Counter* _spill_bytes = nullptr;
 
 private:
     /// Return true if we should keep expanding hash tables in the preagg. If false,
     /// the preagg should pass through any rows it can't fit in its tables.
     bool _should_expand_preagg_hash_tables();
 
+    /// Sample the reduction of a batch aggregated by the streaming preagg, and decide whether
+    /// the following batches should bypass the hash table.
+    void _update_preagg_bypass(size_t rows, size_t ht_rows_before);
+
     void _make_nullable_output_key(Block* block);
 
     Status _create_agg_status(AggregateDataPtr data);
@@ -478,11 +712,50 @@ private:
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _serialize_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _pre_agg_with_serialized_key(Block* in_block, Block* out_block);
+    // Aggregate every run of the rows with equal keys into one row, it falls back to the hash
+    // table if the runs turn out to be too short to reduce the rows.
+    Status _pre_agg_with_sorted_key(Block* in_block, Block* out_block);
     Status _execute_with_serialized_key(Block* block);
     Status _merge_with_serialized_key(Block* block);
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    void _emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                  size_t num_rows);
+    // look up the rows of a dictionary column by their codes, only the distinct values of
+    // the block are looked up in the hash table
+    void _emplace_into_hash_table_by_dict(AggregateDataPtr* places, const IColumn& key_column,
+                                          size_t num_rows);
+    // let the scan node return the single string group by key as dictionary columns
+    void _try_enable_dict_encoded_key();
+    // let the scanners of the scan node aggregate their blocks
+    void _try_enable_scan_aggregation();
+    // aggregate the runs of equal keys if the scan node returns the rows ordered by the keys
+    void _try_enable_sorted_aggregation(RuntimeState* state);
+    // let the multi_distinct_* functions share one hash table of the distinct keys
+    void _try_share_distinct_keys(RuntimeState* state);
+    size_t _shared_distinct_keys_bytes() const {
+        return _shared_distinct_keys != nullptr ? _shared_distinct_keys->allocated_bytes() : 0;
+    }
+    Status _pass_through_scan_aggregated(Block* in_block, Block* out_block);
+    const RowDescriptor& _input_row_desc() {
+        return _is_scan_aggregator ? *_scan_row_desc : child(0)->row_desc();
+    }
+    // switch to a two level hash table once the single level one grows over the thresholds
+    void _convert_to_two_level_if_needed();
+
+    bool _should_spill() const;
+    // serialize the whole hash table to spill files and reset it
+    Status _spill_hash_table(RuntimeState* state);
+    Status _spill_block_by_partition(const Block& block);
+    // read one spilled partition and merge it into the empty hash table
+    Status _merge_spilled_partition(RuntimeState* state);
+    Status _merge_spilled_block(Block* block);
+    bool _has_unmerged_spilled_partition() const {
+        return _spill_partition_index < _spill_writers.size();
+    }
+    void _destroy_and_reset_hash_table();
+    void _remove_spill_files();
 
     void release_tracker();
 
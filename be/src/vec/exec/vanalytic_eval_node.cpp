@@ -17,6 +17,9 @@
 
 #include "vec/exec/vanalytic_eval_node.h"
 
+#include <algorithm>
+#include <set>
+
 #include "exprs/agg_fn_evaluator.h"
 #include "exprs/anyval_util.h"
 #include "runtime/descriptors.h"
@@ -146,6 +149,7 @@ Status VAnalyticEvalNode::init(const TPlanNode& tnode, RuntimeState* state) {
 
 Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::prepare(state));
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     DCHECK(child(0)->row_desc().is_prefix_of(row_desc()));
@@ -185,7 +189,28 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     }
     _fn_place_ptr =
             _agg_arena_pool.aligned_alloc(_total_size_of_aggregate_states, _align_aggregate_states);
-    _create_agg_status();
+    _create_agg_status(_fn_place_ptr);
+
+    // ROWS frames with a bounded end, e.g. moving average, slide the aggregate states instead of
+    // adding all the rows of the frame again for every row. The window functions (rank, lead...)
+    // can not merge their states, only the functions below is allowed.
+    if (_fn_scope == AnalyticFnScope::ROWS && _window.__isset.window_end &&
+        (_window.__isset.window_start ||
+         _window.window_end.type != TAnalyticWindowBoundaryType::CURRENT_ROW)) {
+        static const std::set<std::string> sliding_functions = {"sum", "count", "avg", "min",
+                                                                "max"};
+        _use_sliding_frame = std::all_of(
+                _agg_functions.begin(), _agg_functions.end(), [](AggFnEvaluator* evaluator) {
+                    return sliding_functions.count(evaluator->function()->get_name()) > 0;
+                });
+    }
+    if (_use_sliding_frame) {
+        _sliding_back_place = _agg_arena_pool.aligned_alloc(_total_size_of_aggregate_states,
+                                                            _align_aggregate_states);
+        _create_agg_status(_sliding_back_place);
+    }
+    _runtime_profile->add_info_string("SlidingFrame", _use_sliding_frame ? "true" : "false");
+
     _executor.insert_result =
             std::bind<void>(&VAnalyticEvalNode::_insert_result_info, this, std::placeholders::_1);
     _executor.execute =
@@ -214,6 +239,7 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
 
 Status VAnalyticEvalNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     RETURN_IF_ERROR(ExecNode::open(state));
     RETURN_IF_CANCELLED(state);
@@ -239,7 +265,13 @@ Status VAnalyticEvalNode::close(RuntimeState* state) {
     for (size_t i = 0; i < _agg_functions_size; ++i) VExpr::close(_agg_expr_ctxs[i], state);
     for (auto* agg_function : _agg_functions) agg_function->close(state);
 
-    _destory_agg_status();
+    _destory_agg_status(_fn_place_ptr);
+    if (_sliding_back_place != nullptr) {
+        _destory_agg_status(_sliding_back_place);
+    }
+    for (auto place : _suffix_places) {
+        _destory_agg_status(place);
+    }
     return ExecNode::close(state);
 }
 
@@ -249,6 +281,7 @@ Status VAnalyticEvalNode::get_next(RuntimeState* state, RowBatch* row_batch, boo
 
 Status VAnalyticEvalNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     RETURN_IF_CANCELLED(state);
@@ -316,6 +349,9 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
         if (*eos) {
             break;
         }
+        if (next_partition && _use_sliding_frame) {
+            _reset_sliding_frame();
+        }
 
         size_t current_block_rows = _input_blocks[_output_block_index].rows();
         while (_current_row_position < _partition_by_end.pos &&
@@ -329,7 +365,9 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
                 range_end.pos = _current_row_position +
                                 1; //going on calculate,add up data, no need to reset state
             } else {
-                _reset_agg_status();
+                if (!_use_sliding_frame) {
+                    _reset_agg_status(_fn_place_ptr);
+                }
                 if (!_window.__isset
                              .window_start) { //[preceding, offset]        --unbound: [preceding, following]
                     range_start.pos = _partition_by_start.pos;
@@ -338,7 +376,12 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
                 }
                 range_end.pos = _current_row_position + _rows_end_offset + 1;
             }
-            _executor.execute(_partition_by_start, _partition_by_end, range_start, range_end);
+            if (_use_sliding_frame) {
+                _execute_for_sliding_frame(_partition_by_start, _partition_by_end, range_start.pos,
+                                           range_end.pos);
+            } else {
+                _executor.execute(_partition_by_start, _partition_by_end, range_start, range_end);
+            }
             _executor.insert_result(current_block_rows);
         }
         if (_window_end_position == current_block_rows) {
@@ -532,7 +575,7 @@ bool VAnalyticEvalNode::_init_next_partition(BlockRowPos found_partition_end) {
         _partition_by_start = _partition_by_end;
         _partition_by_end = found_partition_end;
         _current_row_position = _partition_by_start.pos;
-        _reset_agg_status();
+        _reset_agg_status(_fn_place_ptr);
         return true;
     }
     return false;
@@ -585,14 +628,85 @@ Status VAnalyticEvalNode::_output_current_block(Block* block) {
 void VAnalyticEvalNode::_execute_for_win_func(BlockRowPos partition_start,
                                               BlockRowPos partition_end, BlockRowPos frame_start,
                                               BlockRowPos frame_end) {
+    _add_rows_to_place(_fn_place_ptr, partition_start.pos, partition_end.pos, frame_start.pos,
+                       frame_end.pos);
+}
+
+void VAnalyticEvalNode::_add_rows_to_place(AggregateDataPtr place, int64_t partition_start,
+                                           int64_t partition_end, int64_t frame_start,
+                                           int64_t frame_end) {
     for (size_t i = 0; i < _agg_functions_size; ++i) {
         std::vector<const IColumn*> _agg_columns;
         for (int j = 0; j < _agg_intput_columns[i].size(); ++j) {
             _agg_columns.push_back(_agg_intput_columns[i][j].get());
         }
         _agg_functions[i]->function()->add_range_single_place(
-                partition_start.pos, partition_end.pos, frame_start.pos, frame_end.pos,
-                _fn_place_ptr + _offsets_of_aggregate_states[i], _agg_columns.data(), nullptr);
+                partition_start, partition_end, frame_start, frame_end,
+                place + _offsets_of_aggregate_states[i], _agg_columns.data(), nullptr);
+    }
+}
+
+void VAnalyticEvalNode::_execute_for_sliding_frame(BlockRowPos partition_start,
+                                                   BlockRowPos partition_end, int64_t frame_start,
+                                                   int64_t frame_end) {
+    frame_start = std::min(std::max(frame_start, partition_start.pos), partition_end.pos);
+    frame_end = std::min(std::max(frame_end, frame_start), partition_end.pos);
+    DCHECK_GE(frame_start, _frame_start_pos);
+    DCHECK_GE(frame_end, _frame_end_pos);
+
+    if (frame_end > _frame_end_pos) {
+        _add_rows_to_place(_sliding_back_place, partition_start.pos, partition_end.pos,
+                           _frame_end_pos, frame_end);
+        _frame_end_pos = frame_end;
+    }
+    // some rows of the back state slide out of the frame, a state can not remove rows,
+    // so the rows still in the frame are moved to the suffix states
+    if (frame_start > _frame_mid_pos) {
+        _build_suffix_places(frame_start);
+    }
+    _frame_start_pos = frame_start;
+
+    _reset_agg_status(_fn_place_ptr);
+    if (_frame_start_pos < _frame_mid_pos) {
+        _merge_agg_status(_fn_place_ptr, _suffix_places[_frame_start_pos - _suffix_base_pos]);
+    }
+    _merge_agg_status(_fn_place_ptr, _sliding_back_place);
+}
+
+void VAnalyticEvalNode::_build_suffix_places(int64_t frame_start) {
+    size_t rows = _frame_end_pos - frame_start;
+    while (_suffix_places.size() < rows) {
+        auto place = _agg_arena_pool.aligned_alloc(_total_size_of_aggregate_states,
+                                                   _align_aggregate_states);
+        _create_agg_status(place);
+        _suffix_places.emplace_back(place);
+    }
+
+    for (int64_t pos = _frame_end_pos - 1; pos >= frame_start; --pos) {
+        auto place = _suffix_places[pos - frame_start];
+        _reset_agg_status(place);
+        if (pos + 1 < _frame_end_pos) {
+            _merge_agg_status(place, _suffix_places[pos + 1 - frame_start]);
+        }
+        _add_rows_to_place(place, _partition_by_start.pos, _partition_by_end.pos, pos, pos + 1);
+    }
+    _suffix_base_pos = frame_start;
+    _frame_mid_pos = _frame_end_pos;
+    _reset_agg_status(_sliding_back_place);
+}
+
+void VAnalyticEvalNode::_reset_sliding_frame() {
+    _suffix_base_pos = _partition_by_start.pos;
+    _frame_start_pos = _partition_by_start.pos;
+    _frame_mid_pos = _partition_by_start.pos;
+    _frame_end_pos = _partition_by_start.pos;
+    _reset_agg_status(_sliding_back_place);
+}
+
+void VAnalyticEvalNode::_merge_agg_status(AggregateDataPtr place, ConstAggregateDataPtr rhs) {
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        _agg_functions[i]->function()->merge(place + _offsets_of_aggregate_states[i],
+                                             rhs + _offsets_of_aggregate_states[i], nullptr);
     }
 }
 
@@ -621,23 +735,23 @@ Status VAnalyticEvalNode::_init_result_columns() {
     return Status::OK();
 }
 
-Status VAnalyticEvalNode::_reset_agg_status() {
+Status VAnalyticEvalNode::_reset_agg_status(AggregateDataPtr place) {
     for (size_t i = 0; i < _agg_functions_size; ++i) {
-        _agg_functions[i]->reset(_fn_place_ptr + _offsets_of_aggregate_states[i]);
+        _agg_functions[i]->reset(place + _offsets_of_aggregate_states[i]);
     }
     return Status::OK();
 }
 
-Status VAnalyticEvalNode::_create_agg_status() {
+Status VAnalyticEvalNode::_create_agg_status(AggregateDataPtr place) {
     for (size_t i = 0; i < _agg_functions_size; ++i) {
-        _agg_functions[i]->create(_fn_place_ptr + _offsets_of_aggregate_states[i]);
+        _agg_functions[i]->create(place + _offsets_of_aggregate_states[i]);
     }
     return Status::OK();
 }
 
-Status VAnalyticEvalNode::_destory_agg_status() {
+Status VAnalyticEvalNode::_destory_agg_status(AggregateDataPtr place) {
     for (size_t i = 0; i < _agg_functions_size; ++i) {
-        _agg_functions[i]->destroy(_fn_place_ptr + _offsets_of_aggregate_states[i]);
+        _agg_functions[i]->destroy(place + _offsets_of_aggregate_states[i]);
     }
     return Status::OK();
 }
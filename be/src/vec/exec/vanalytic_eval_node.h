@@ -60,11 +60,21 @@ private:
 
     void _execute_for_win_func(BlockRowPos partition_start, BlockRowPos partition_end,
                                BlockRowPos frame_start, BlockRowPos frame_end);
-
-    Status _reset_agg_status();
+    void _add_rows_to_place(AggregateDataPtr place, int64_t partition_start,
+                            int64_t partition_end, int64_t frame_start, int64_t frame_end);
+
+    // Evaluate the sliding ROWS frame [frame_start, frame_end) by merging the aggregate states,
+    // every row is added at most twice no matter how large the frame is.
+    void _execute_for_sliding_frame(BlockRowPos partition_start, BlockRowPos partition_end,
+                                    int64_t frame_start, int64_t frame_end);
+    void _build_suffix_places(int64_t frame_start);
+    void _reset_sliding_frame();
+    void _merge_agg_status(AggregateDataPtr place, ConstAggregateDataPtr rhs);
+
+    Status _reset_agg_status(AggregateDataPtr place);
     Status _init_result_columns();
-    Status _create_agg_status();
-    Status _destory_agg_status();
+    Status _create_agg_status(AggregateDataPtr place);
+    Status _destory_agg_status(AggregateDataPtr place);
     Status _insert_range_column(vectorized::Block* block, VExprContext* expr, IColumn* dst_column,
                                 size_t length);
 
@@ -134,6 +144,18 @@ private:
     Arena _agg_arena_pool;
     AggregateDataPtr _fn_place_ptr;
 
+    // Only valid if _use_sliding_frame. The states are kept as two stacks: the rows
+    // [_frame_mid_pos, _frame_end_pos) are added to _sliding_back_place, and the state of
+    // rows [pos, _frame_mid_pos) is _suffix_places[pos - _suffix_base_pos] for the rows
+    // [_frame_start_pos, _frame_mid_pos), so the frame is merged from at most two states.
+    bool _use_sliding_frame = false;
+    AggregateDataPtr _sliding_back_place = nullptr;
+    std::vector<AggregateDataPtr> _suffix_places;
+    int64_t _suffix_base_pos = 0;
+    int64_t _frame_start_pos = 0;
+    int64_t _frame_mid_pos = 0;
+    int64_t _frame_end_pos = 0;
+
     TTupleId _buffered_tuple_id = 0;
     TupleId _intermediate_tuple_id;
     TupleId _output_tuple_id;
@@ -73,7 +73,9 @@ Status VArrowScanner::_open_next_reader() {
         _cur_file_reader = _new_arrow_reader(file_reader.release(), _state->batch_size(),
                                              num_of_columns_from_file);
 
-        Status status = _cur_file_reader->init_reader(_src_slot_descs, _state->timezone());
+        Status status = _cur_file_reader->init_reader(_src_slot_descs, _state->timezone(),
+                                                      &_statistics_filter);
+        COUNTER_UPDATE(_filtered_row_groups_counter, _cur_file_reader->filtered_groups());
 
         if (status.is_end_of_file()) {
             continue;
@@ -227,22 +229,27 @@ Status VArrowScanner::_cast_src_block(Block* block) {
         if (slot_desc == nullptr) {
             continue;
         }
-        auto& arg = block->get_by_name(slot_desc->col_name());
-        // remove nullable here, let the get_function decide whether nullable
-        auto return_type = slot_desc->get_data_type_ptr();
-        ColumnsWithTypeAndName arguments {
-                arg,
-                {DataTypeString().create_column_const(
-                         arg.column->size(), remove_nullable(return_type)->get_family_name()),
-                 std::make_shared<DataTypeString>(), ""}};
-        auto func_cast =
-                SimpleFunctionFactory::instance().get_function("CAST", arguments, return_type);
-        RETURN_IF_ERROR(func_cast->execute(nullptr, *block, {i}, i, arg.column->size()));
-        block->get_by_position(i).type = std::move(return_type);
+        RETURN_IF_ERROR(_cast_src_column(block, i, slot_desc));
     }
     return Status::OK();
 }
 
+Status VArrowScanner::_cast_src_column(Block* block, size_t position, SlotDescriptor* slot_desc) {
+    auto& arg = block->get_by_name(slot_desc->col_name());
+    // remove nullable here, let the get_function decide whether nullable
+    auto return_type = slot_desc->get_data_type_ptr();
+    ColumnsWithTypeAndName arguments {
+            arg,
+            {DataTypeString().create_column_const(arg.column->size(),
+                                                  remove_nullable(return_type)->get_family_name()),
+             std::make_shared<DataTypeString>(), ""}};
+    auto func_cast = SimpleFunctionFactory::instance().get_function("CAST", arguments, return_type);
+    RETURN_IF_ERROR(
+            func_cast->execute(nullptr, *block, {position}, position, arg.column->size()));
+    block->get_by_position(position).type = std::move(return_type);
+    return Status::OK();
+}
+
 Status VArrowScanner::_append_batch_to_src_block(Block* block) {
     size_t num_elements = std::min<size_t>((_state->batch_size() - block->rows()),
                                            (_batch->num_rows() - _arrow_batch_cur_idx));
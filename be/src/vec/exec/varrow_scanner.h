@@ -62,6 +62,10 @@ protected:
     virtual ArrowReaderWrap* _new_arrow_reader(FileReader* file_reader, int64_t batch_size,
                                                int32_t num_of_columns_from_file) = 0;
 
+    // cast the column of `slot_desc` at `position` from primitive type(PT0) to the type
+    // in src desc(PT1)
+    Status _cast_src_column(Block* block, size_t position, SlotDescriptor* slot_desc);
+
 private:
     // Read next buffer from reader
     Status _open_next_reader();
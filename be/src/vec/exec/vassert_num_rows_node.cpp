@@ -40,6 +40,7 @@ VAssertNumRowsNode::VAssertNumRowsNode(ObjectPool* pool, const TPlanNode& tnode,
 
 Status VAssertNumRowsNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::open(state));
     // ISSUE-3435
     RETURN_IF_ERROR(child(0)->open(state));
@@ -49,6 +50,7 @@ Status VAssertNumRowsNode::open(RuntimeState* state) {
 Status VAssertNumRowsNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(child(0)->get_next(state, block, eos));
     _num_rows_returned += block->rows();
     bool assert_res = false;
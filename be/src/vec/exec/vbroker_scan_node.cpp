@@ -30,6 +30,7 @@
 #include "vec/exec/vjson_scanner.h"
 #include "vec/exec/vorc_scanner.h"
 #include "vec/exec/vparquet_scanner.h"
+#include "vec/exec/vprotobuf_scanner.h"
 #include "vec/exprs/vexpr_context.h"
 
 namespace doris::vectorized {
@@ -87,6 +88,7 @@ Status VBrokerScanNode::prepare(RuntimeState* state) {
 
 Status VBrokerScanNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     RETURN_IF_ERROR(ExecNode::open(state));
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
@@ -108,6 +110,7 @@ Status VBrokerScanNode::start_scanners() {
 
 Status VBrokerScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     // check if CANCELLED.
     if (state->is_cancelled()) {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
@@ -202,6 +205,7 @@ Status VBrokerScanNode::close(RuntimeState* state) {
     }
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::CLOSE));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     _scan_finished.store(true);
     _queue_writer_cond.notify_all();
     _queue_reader_cond.notify_all();
@@ -322,6 +326,11 @@ std::unique_ptr<BaseScanner> VBrokerScanNode::create_scanner(const TBrokerScanRa
                                             scan_range.ranges, scan_range.broker_addresses,
                                             _pre_filter_texprs, counter);
         break;
+    case TFileFormatType::FORMAT_PROTOBUF:
+        scan = new vectorized::VProtobufScanner(
+                _runtime_state, runtime_profile(), scan_range.params, scan_range.ranges,
+                scan_range.broker_addresses, _pre_filter_texprs, counter);
+        break;
     default:
         scan = new vectorized::VBrokerScanner(_runtime_state, runtime_profile(), scan_range.params,
                                               scan_range.ranges, scan_range.broker_addresses,
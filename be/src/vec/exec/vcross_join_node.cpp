@@ -17,6 +17,7 @@
 
 #include "vec/exec/vcross_join_node.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "exprs/expr.h"
@@ -24,6 +25,10 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/runtime_profile.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 
@@ -39,9 +44,67 @@ Status VCrossJoinNode::prepare(RuntimeState* state) {
 
     _num_existing_columns = child(0)->row_desc().num_materialized_slots();
     _num_columns_to_add = child(1)->row_desc().num_materialized_slots();
+
+    _find_range_predicate();
+    if (_range_op != RangeOp::NONE) {
+        add_runtime_exec_option("Build Side Sorted For Range Predicate");
+    }
     return Status::OK();
 }
 
+void VCrossJoinNode::_find_range_predicate() {
+    if (_vconjunct_ctx_ptr == nullptr) {
+        return;
+    }
+    std::vector<VExpr*> exprs {(*_vconjunct_ctx_ptr)->root()};
+    while (!exprs.empty()) {
+        VExpr* expr = exprs.back();
+        exprs.pop_back();
+        if (expr->is_and_expr()) {
+            exprs.insert(exprs.end(), expr->children().begin(), expr->children().end());
+            continue;
+        }
+        if (expr->node_type() != TExprNodeType::BINARY_PRED || expr->children().size() != 2 ||
+            !expr->children()[0]->is_slot_ref() || !expr->children()[1]->is_slot_ref()) {
+            continue;
+        }
+
+        const auto& fn_name = expr->fn().name.function_name;
+        RangeOp op = RangeOp::NONE;
+        if (fn_name == "lt") {
+            op = RangeOp::LT;
+        } else if (fn_name == "le") {
+            op = RangeOp::LE;
+        } else if (fn_name == "gt") {
+            op = RangeOp::GT;
+        } else if (fn_name == "ge") {
+            op = RangeOp::GE;
+        } else {
+            continue;
+        }
+
+        auto left_slot = static_cast<VSlotRef*>(expr->children()[0]);
+        auto build_slot = static_cast<VSlotRef*>(expr->children()[1]);
+        if ((size_t)left_slot->column_id() >= _num_existing_columns) {
+            std::swap(left_slot, build_slot);
+            static const RangeOp flipped[] = {RangeOp::NONE, RangeOp::GT, RangeOp::GE,
+                                              RangeOp::LT, RangeOp::LE};
+            op = flipped[static_cast<int>(op)];
+        }
+        if ((size_t)left_slot->column_id() >= _num_existing_columns ||
+            (size_t)build_slot->column_id() < _num_existing_columns ||
+            !remove_nullable(left_slot->data_type())
+                     ->equals(*remove_nullable(build_slot->data_type()))) {
+            continue;
+        }
+
+        _range_op = op;
+        _range_left_column = left_slot->column_id();
+        _range_build_column = build_slot->column_id() - _num_existing_columns;
+        return;
+    }
+}
+
 Status VCrossJoinNode::close(RuntimeState* state) {
     // avoid double close
     if (is_closed()) {
@@ -83,16 +146,156 @@ Status VCrossJoinNode::construct_build_side(RuntimeState* state) {
     COUNTER_UPDATE(_build_row_counter, _build_rows);
     // If right table in join is empty, the node is eos
     _eos = _build_rows == 0;
+    if (_range_op != RangeOp::NONE && _build_rows != 0) {
+        _sort_build_blocks();
+    }
     return Status::OK();
 }
 
+void VCrossJoinNode::_sort_build_blocks() {
+    MutableBlock mutable_block;
+    for (auto& block : _build_blocks) {
+        mutable_block.merge(block);
+    }
+    _build_blocks.clear();
+    Block block = mutable_block.to_block();
+
+    IColumn::Permutation perm;
+    // the null rows are placed at the end
+    block.get_by_position(_range_build_column).column->get_permutation(false, 0, 1, perm);
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto& column = block.get_by_position(i).column;
+        column = column->permute(perm, 0);
+    }
+
+    const IColumn* build_column = block.get_by_position(_range_build_column).column.get();
+    _build_not_null_rows = block.rows();
+    if (auto* nullable = check_and_get_column<ColumnNullable>(*build_column)) {
+        const auto& null_map = nullable->get_null_map_data();
+        _build_not_null_rows -= std::count(null_map.begin(), null_map.end(), 1);
+        build_column = &nullable->get_nested_column();
+    }
+    _sorted_build_column = build_column;
+
+    _block_mem_tracker->release(_total_mem_usage);
+    _total_mem_usage = block.allocated_bytes();
+    _block_mem_tracker->consume(_total_mem_usage);
+    _build_blocks.emplace_back(std::move(block));
+}
+
 void VCrossJoinNode::init_get_next(int left_batch_row) {
     _current_build_pos = 0;
+    if (_range_op != RangeOp::NONE && left_batch_row >= 0) {
+        _init_build_range();
+    }
+}
+
+void VCrossJoinNode::_init_build_range() {
+    _current_build_pos = 0;
+    _build_range_end = 0;
+    if (_build_blocks.empty()) {
+        return;
+    }
+
+    const IColumn* left_column = _left_block.get_by_position(_range_left_column).column.get();
+    size_t left_row = _left_block_pos;
+    if (is_column_const(*left_column)) {
+        left_column = &assert_cast<const ColumnConst*>(left_column)->get_data_column();
+        left_row = 0;
+    }
+    if (auto* nullable = check_and_get_column<ColumnNullable>(*left_column)) {
+        // the comparison with null is never true
+        if (nullable->is_null_at(left_row)) {
+            return;
+        }
+        left_column = &nullable->get_nested_column();
+    }
+
+    // the first build row greater than (upper) or not less than the left value
+    auto bound = [&](bool upper) {
+        size_t low = 0;
+        size_t high = _build_not_null_rows;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            int res = _sorted_build_column->compare_at(mid, left_row, *left_column, 1);
+            if (res < 0 || (upper && res == 0)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    };
+
+    // The conjuncts are still evaluated on the joined rows, the range only has to contain
+    // all the build rows which may match.
+    switch (_range_op) {
+    case RangeOp::LT:
+        _current_build_pos = bound(true);
+        _build_range_end = _build_not_null_rows;
+        break;
+    case RangeOp::LE:
+        _current_build_pos = bound(false);
+        _build_range_end = _build_not_null_rows;
+        break;
+    case RangeOp::GT:
+        _build_range_end = bound(false);
+        break;
+    case RangeOp::GE:
+        _build_range_end = bound(true);
+        break;
+    default:
+        DCHECK(false);
+    }
+}
+
+Status VCrossJoinNode::_fetch_left_block(RuntimeState* state,
+                                         ScopedTimer<MonotonicStopWatch>& timer) {
+    _left_block_pos = 0;
+    if (_left_side_eos) {
+        _eos = true;
+        return Status::OK();
+    }
+    do {
+        release_block_memory(_left_block);
+        timer.stop();
+        RETURN_IF_ERROR(child(0)->get_next(state, &_left_block, &_left_side_eos));
+        timer.start();
+    } while (_left_block.rows() == 0 && !_left_side_eos);
+    COUNTER_UPDATE(_left_child_row_counter, _left_block.rows());
+    if (_left_block.rows() == 0) {
+        _eos = _left_side_eos;
+    }
+    return Status::OK();
+}
+
+Status VCrossJoinNode::_get_next_by_range(RuntimeState* state, MutableColumns& dst_columns,
+                                          Block* block, ScopedTimer<MonotonicStopWatch>& timer) {
+    const size_t batch_size = state->batch_size();
+    while (block->rows() < batch_size && !_eos) {
+        if (_current_build_pos == _build_range_end) {
+            _left_block_pos++;
+            if (_left_block_pos == _left_block.rows()) {
+                RETURN_IF_ERROR(_fetch_left_block(state, timer));
+                if (_eos) {
+                    break;
+                }
+            }
+            _init_build_range();
+            continue;
+        }
+
+        size_t rows = std::min(_build_range_end - _current_build_pos, batch_size - block->rows());
+        process_left_child_block(dst_columns, _build_blocks[0], _current_build_pos, rows);
+        _current_build_pos += rows;
+    }
+    return Status::OK();
 }
 
 Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
     *eos = false;
 
@@ -104,40 +307,31 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     auto dst_columns = get_mutable_columns(block);
     ScopedTimer<MonotonicStopWatch> timer(_left_child_timer);
 
-    while (block->rows() < state->batch_size() && !_eos) {
+    if (_range_op != RangeOp::NONE) {
+        RETURN_IF_ERROR(_get_next_by_range(state, dst_columns, block, timer));
+    }
+
+    while (_range_op == RangeOp::NONE && block->rows() < state->batch_size() && !_eos) {
         // Check to see if we're done processing the current left child batch
         if (_current_build_pos == _build_blocks.size()) {
             _current_build_pos = 0;
             _left_block_pos++;
 
             if (_left_block_pos == _left_block.rows()) {
-                _left_block_pos = 0;
-
-                if (_left_side_eos) {
-                    *eos = _eos = true;
-                } else {
-                    do {
-                        release_block_memory(_left_block);
-                        timer.stop();
-                        RETURN_IF_ERROR(child(0)->get_next(state, &_left_block, &_left_side_eos));
-                        timer.start();
-                    } while (_left_block.rows() == 0 && !_left_side_eos);
-                    COUNTER_UPDATE(_left_child_row_counter, _left_block.rows());
-                    if (_left_block.rows() == 0) {
-                        *eos = _eos = _left_side_eos;
-                    }
-                }
+                RETURN_IF_ERROR(_fetch_left_block(state, timer));
             }
         }
 
         if (!_eos) {
             do {
                 const auto& now_process_build_block = _build_blocks[_current_build_pos++];
-                process_left_child_block(dst_columns, now_process_build_block);
+                process_left_child_block(dst_columns, now_process_build_block, 0,
+                                         now_process_build_block.rows());
             } while (block->rows() < state->batch_size() &&
                      _current_build_pos < _build_blocks.size());
         }
     }
+    *eos = _eos;
     dst_columns.clear();
     RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
 
@@ -172,16 +366,16 @@ MutableColumns VCrossJoinNode::get_mutable_columns(Block* block) {
 }
 
 void VCrossJoinNode::process_left_child_block(MutableColumns& dst_columns,
-                                              const Block& now_process_build_block) {
-    const int max_added_rows = now_process_build_block.rows();
+                                              const Block& now_process_build_block, size_t start,
+                                              size_t rows) {
     for (size_t i = 0; i < _num_existing_columns; ++i) {
         const ColumnWithTypeAndName& src_column = _left_block.get_by_position(i);
-        dst_columns[i]->insert_many_from(*src_column.column, _left_block_pos, max_added_rows);
+        dst_columns[i]->insert_many_from(*src_column.column, _left_block_pos, rows);
     }
     for (size_t i = 0; i < _num_columns_to_add; ++i) {
         const ColumnWithTypeAndName& src_column = now_process_build_block.get_by_position(i);
-        dst_columns[_num_existing_columns + i]->insert_range_from(*src_column.column.get(), 0,
-                                                                  max_added_rows);
+        dst_columns[_num_existing_columns + i]->insert_range_from(*src_column.column.get(), start,
+                                                                  rows);
     }
 }
 
@@ -27,6 +27,7 @@
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/descriptors.h"
 #include "runtime/mem_pool.h"
+#include "util/runtime_profile.h"
 #include "vec/core/block.h"
 #include "vec/exec/vblocking_join_node.h"
 
@@ -37,6 +38,10 @@ namespace doris::vectorized {
 // build batches are kept in a list that is fully constructed from the right child in
 // construct_build_side() (called by BlockingJoinNode::open()) while rows are fetched from
 // the left child as necessary in get_next().
+//
+// If one of the conjuncts compares a left slot with a build slot (e.g. l.ip >= r.range_start),
+// the build rows are sorted by the build slot and the rows matching a left row are found
+// by binary search, so only that range is joined instead of the whole build side.
 class VCrossJoinNode final : public VBlockingJoinNode {
 public:
     VCrossJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -54,10 +59,26 @@ protected:
     Status construct_build_side(RuntimeState* state) override;
 
 private:
+    // The comparison of `left_slot op build_slot`, the operands are normalized so that the
+    // left slot is always on the left side.
+    enum class RangeOp { NONE, LT, LE, GT, GE };
+
     // List of build blocks, constructed in prepare()
     Blocks _build_blocks;
     size_t _current_build_pos = 0;
 
+    RangeOp _range_op = RangeOp::NONE;
+    // the positions of the compared slots in the left block and the build block
+    int _range_left_column = -1;
+    int _range_build_column = -1;
+    // With the range predicate, _build_blocks has a single block sorted by the build slot,
+    // whose null rows are placed after the first _build_not_null_rows rows. The rows in
+    // [_current_build_pos, _build_range_end) of it are left to join the current left row.
+    size_t _build_not_null_rows = 0;
+    size_t _build_range_end = 0;
+    // the not null column of the build slot in the sorted build block
+    const IColumn* _sorted_build_column = nullptr;
+
     size_t _num_existing_columns = 0;
     size_t _num_columns_to_add = 0;
 
@@ -74,8 +95,25 @@ private:
     // Processes a block from the left child.
     //  dst_columns: left_child_row and now_process_build_block to construct a bundle column of new block
     //  now_process_build_block: right child block now to process
+    //  start, rows: the range of the build rows to join
     void process_left_child_block(MutableColumns& dst_columns,
-                                  const Block& now_process_build_block);
+                                  const Block& now_process_build_block, size_t start,
+                                  size_t rows);
+
+    // Finds the conjunct that compares a left slot with a build slot of the same type.
+    void _find_range_predicate();
+
+    // Merges the build blocks into one and sorts it by the build slot of the range predicate.
+    void _sort_build_blocks();
+
+    // Sets the range of the sorted build rows which match the current left row.
+    void _init_build_range();
+
+    // Fetches the next left block, returns with _eos set if the left child has no more rows.
+    Status _fetch_left_block(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& timer);
+
+    Status _get_next_by_range(RuntimeState* state, MutableColumns& dst_columns, Block* block,
+                              ScopedTimer<MonotonicStopWatch>& timer);
 
     // Returns a debug string for _build_rows. This is used for debugging during the
     // build list construction and before doing the join.
@@ -21,6 +21,7 @@
 #include "exec/es/es_query_builder.h"
 #include "exec/es/es_scan_reader.h"
 #include "exec/es/es_scroll_query.h"
+#include "common/config.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/runtime_state.h"
@@ -121,6 +122,7 @@ Status VEsHttpScanNode::build_conjuncts_list() {
 
 Status VEsHttpScanNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     RETURN_IF_ERROR(ExecNode::open(state));
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
@@ -187,22 +189,34 @@ static std::string get_host_port(const std::vector<TNetworkAddress>& es_hosts) {
     return host_port;
 }
 
+bool VEsHttpScanNode::_push_down_limit() const {
+    // if predicate in _conjunct_ctxs can not be processed by Elasticsearch, we can not push down
+    // limit operator to Elasticsearch
+    return limit() != -1 && limit() <= _runtime_state->batch_size() && _conjunct_ctxs.empty();
+}
+
 Status VEsHttpScanNode::start_scanners() {
+    // each slice of a shard is scrolled by its own scanner
+    int num_slices = _push_down_limit() ? 1 : std::max(1, config::es_scroll_slices_per_shard);
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = _scan_ranges.size();
+        _num_running_scanners = _scan_ranges.size() * num_slices;
     }
 
-    _scanners_status.resize(_scan_ranges.size());
+    _scanners_status.resize(_scan_ranges.size() * num_slices);
     for (int i = 0; i < _scan_ranges.size(); i++) {
-        _scanner_threads.emplace_back(&VEsHttpScanNode::scanner_worker, this, i,
-                                      _scan_ranges.size(), std::ref(_scanners_status[i]));
+        for (int slice_id = 0; slice_id < num_slices; ++slice_id) {
+            _scanner_threads.emplace_back(
+                    &VEsHttpScanNode::scanner_worker, this, i, slice_id, num_slices,
+                    std::ref(_scanners_status[i * num_slices + slice_id]));
+        }
     }
     return Status::OK();
 }
 
 Status VEsHttpScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     if (state->is_cancelled()) {
         std::unique_lock<std::mutex> l(_block_queue_lock);
         if (update_status(Status::Cancelled("Cancelled"))) {
@@ -338,6 +352,7 @@ Status VEsHttpScanNode::close(RuntimeState* state) {
     }
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::CLOSE));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     _scan_finished.store(true);
     _queue_writer_cond.notify_all();
     _queue_reader_cond.notify_all();
@@ -381,11 +396,12 @@ void VEsHttpScanNode::debug_string(int ident_level, std::stringstream* out) cons
     (*out) << "VEsHttpScanNode";
 }
 
-void VEsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Status>& p_status) {
+void VEsHttpScanNode::scanner_worker(int start_idx, int slice_id, int num_slices,
+                                     std::promise<Status>& p_status) {
     SCOPED_ATTACH_TASK_THREAD(_runtime_state, mem_tracker());
     // Clone expr context
     std::vector<ExprContext*> scanner_expr_ctxs;
-    DCHECK(start_idx < length);
+    DCHECK(start_idx < _scan_ranges.size());
     auto status = Expr::clone_if_not_exists(_conjunct_ctxs, _runtime_state, &scanner_expr_ctxs);
     if (!status.ok()) {
         LOG(WARNING) << "Clone conjuncts failed.";
@@ -404,10 +420,13 @@ void VEsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Sta
     properties[ESScanReader::KEY_BATCH_SIZE] = std::to_string(_runtime_state->batch_size());
     properties[ESScanReader::KEY_HOST_PORT] = get_host_port(es_scan_range.es_hosts);
     // push down limit to Elasticsearch
-    // if predicate in _conjunct_ctxs can not be processed by Elasticsearch, we can not push down limit operator to Elasticsearch
-    if (limit() != -1 && limit() <= _runtime_state->batch_size() && _conjunct_ctxs.empty()) {
+    if (_push_down_limit()) {
         properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
     }
+    if (num_slices > 1) {
+        properties[ESScanReader::KEY_SLICE_ID] = std::to_string(slice_id);
+        properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(num_slices);
+    }
 
     bool doc_value_mode = false;
     properties[ESScanReader::KEY_QUERY] = ESScrollQueryBuilder::build(
@@ -419,7 +438,7 @@ void VEsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Sta
                                            scanner_expr_ctxs, &counter, doc_value_mode));
     status = scanner_scan(std::move(scanner));
     if (!status.ok()) {
-        LOG(WARNING) << "Scanner[" << start_idx
+        LOG(WARNING) << "Scanner[" << start_idx << ", slice " << slice_id
                      << "] process failed. status=" << status.get_error_msg();
     }
 
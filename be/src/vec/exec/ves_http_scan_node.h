@@ -59,8 +59,12 @@ private:
         }
         return false;
     }
-    // One scanner worker, This scanner will handle 'length' ranges start from start_idx
-    virtual void scanner_worker(int start_idx, int length, std::promise<Status>& p_status);
+    // One scanner worker, This scanner will scroll the slice of the range at start_idx
+    virtual void scanner_worker(int start_idx, int slice_id, int num_slices,
+                                std::promise<Status>& p_status);
+
+    // whether the limit is pushed down to Elasticsearch by a search with terminate_after
+    bool _push_down_limit() const;
 
     TupleId _tuple_id;
     RuntimeState* _runtime_state;
@@ -46,11 +46,13 @@ Status VExceptNode::open(RuntimeState* state) {
     bool eos = false;
     Status st;
     for (int i = 1; i < _children.size(); ++i) {
+        // all the rows have been removed by the previous children
+        if (_valid_element_in_hash_tbl == 0) {
+            break;
+        }
         if (i > 1) {
-            refresh_hash_table<false>();
+            RETURN_IF_ERROR(child(i)->open(state));
         }
-
-        RETURN_IF_ERROR(child(i)->open(state));
         eos = false;
         int probe_expr_ctxs_sz = _child_expr_lists[i].size();
         _probe_columns.resize(probe_expr_ctxs_sz);
@@ -65,7 +67,7 @@ Status VExceptNode::open(RuntimeState* state) {
                         if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
                             HashTableProbe<HashTableCtxType, false> process_hashtable_ctx(
                                     this, state->batch_size(), _probe_rows);
-                            st = process_hashtable_ctx.mark_data_in_hashtable(arg);
+                            st = process_hashtable_ctx.mark_data_in_hashtable(arg, i);
 
                         } else {
                             LOG(FATAL) << "FATAL: uninited hash table";
@@ -65,6 +65,7 @@ Status VExchangeNode::prepare(RuntimeState* state) {
 }
 Status VExchangeNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     ADD_THREAD_LOCAL_MEM_TRACKER(_stream_recvr->mem_tracker());
     RETURN_IF_ERROR(ExecNode::open(state));
@@ -99,6 +100,10 @@ Status VExchangeNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     return status;
 }
 
+bool VExchangeNode::can_read() {
+    return _stream_recvr->ready_to_read();
+}
+
 Status VExchangeNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
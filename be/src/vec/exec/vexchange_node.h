@@ -38,6 +38,11 @@ public:
     virtual Status get_next(RuntimeState* state, Block* row_batch, bool* eos) override;
     virtual Status close(RuntimeState* state) override;
 
+    // Whether get_next() returns without waiting for the senders.
+    bool can_read();
+    // The merging exchange waits for the first blocks of all the senders in open().
+    bool is_merging() const { return _is_merging; }
+
     // Status collect_query_statistics(QueryStatistics* statistics) override;
     void set_num_senders(int num_senders) { _num_senders = num_senders; }
 
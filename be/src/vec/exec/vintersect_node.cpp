@@ -47,12 +47,14 @@ Status VIntersectNode::open(RuntimeState* state) {
     Status st;
 
     for (int i = 1; i < _children.size(); ++i) {
-        if (i > 1) {
-            refresh_hash_table<true>();
+        // no row is left in the result if a child matched nothing
+        if (_valid_element_in_hash_tbl == 0) {
+            break;
         }
-
         _valid_element_in_hash_tbl = 0;
-        RETURN_IF_ERROR(child(i)->open(state));
+        if (i > 1) {
+            RETURN_IF_ERROR(child(i)->open(state));
+        }
         eos = false;
         _probe_columns.resize(_child_expr_lists[i].size());
 
@@ -66,7 +68,7 @@ Status VIntersectNode::open(RuntimeState* state) {
                         if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
                             HashTableProbe<HashTableCtxType, true> process_hashtable_ctx(
                                     this, state->batch_size(), _probe_rows);
-                            st = process_hashtable_ctx.mark_data_in_hashtable(arg);
+                            st = process_hashtable_ctx.mark_data_in_hashtable(arg, i);
 
                         } else {
                             LOG(FATAL) << "FATAL: uninited hash table";
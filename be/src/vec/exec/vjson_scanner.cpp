@@ -20,7 +20,10 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 
+#include "common/config.h"
 #include "exec/line_reader.h"
 #include "exprs/json_functions.h"
 #include "runtime/runtime_state.h"
@@ -135,6 +138,7 @@ Status VJsonReader::init(const std::string& jsonpath, const std::string& json_ro
             _vhandle_json_callback = &VJsonReader::_vhandle_nested_complex_json;
         }
     }
+    _use_simdjson = config::enable_simdjson_reader && _init_simdjson_paths();
 
     return Status::OK();
 }
@@ -142,7 +146,14 @@ Status VJsonReader::init(const std::string& jsonpath, const std::string& json_ro
 Status VJsonReader::read_json_column(std::vector<MutableColumnPtr>& columns,
                                      const std::vector<SlotDescriptor*>& slot_descs,
                                      bool* is_empty_row, bool* eof) {
-    return (this->*_vhandle_json_callback)(columns, slot_descs, is_empty_row, eof);
+    if (_use_simdjson && !_rapidjson_in_progress) {
+        return _simdjson_handle_json(columns, slot_descs, is_empty_row, eof);
+    }
+    RETURN_IF_ERROR((this->*_vhandle_json_callback)(columns, slot_descs, is_empty_row, eof));
+    if (_next_line >= _total_lines) {
+        _rapidjson_in_progress = false;
+    }
+    return Status::OK();
 }
 
 Status VJsonReader::_vhandle_simple_json(std::vector<MutableColumnPtr>& columns,
@@ -179,15 +190,7 @@ Status VJsonReader::_vhandle_simple_json(std::vector<MutableColumnPtr>& columns,
             }
             _next_line = 0;
             if (_fuzzy_parse) {
-                for (auto v : slot_descs) {
-                    for (int i = 0; i < objectValue->MemberCount(); ++i) {
-                        auto it = objectValue->MemberBegin() + i;
-                        if (v->col_name() == it->name.GetString()) {
-                            _name_map[v->col_name()] = i;
-                            break;
-                        }
-                    }
-                }
+                _fill_name_map(*objectValue, slot_descs);
             }
         }
 
@@ -213,6 +216,19 @@ Status VJsonReader::_vhandle_simple_json(std::vector<MutableColumnPtr>& columns,
     return Status::OK();
 }
 
+void VJsonReader::_fill_name_map(const rapidjson::Value& objectValue,
+                                 const std::vector<SlotDescriptor*>& slot_descs) {
+    for (auto v : slot_descs) {
+        for (int i = 0; i < objectValue.MemberCount(); ++i) {
+            auto it = objectValue.MemberBegin() + i;
+            if (v->col_name() == it->name.GetString()) {
+                _name_map[v->col_name()] = i;
+                break;
+            }
+        }
+    }
+}
+
 // for simple format json
 // set valid to true and return OK if succeed.
 // set valid to false and return OK if we met an invalid row.
@@ -459,7 +475,15 @@ Status VJsonReader::_write_columns_by_jsonpath(rapidjson::Value& objectValue,
 
 Status VJsonReader::_parse_json(bool* is_empty_row, bool* eof) {
     size_t size = 0;
-    Status st = JsonReader::_parse_json_doc(&size, eof);
+    Status st;
+    if (_replay_document) {
+        _replay_document = false;
+        size = _simdjson_size;
+        st = JsonReader::_parse_json_str(reinterpret_cast<const uint8_t*>(_simdjson_buffer.get()),
+                                         size, eof);
+    } else {
+        st = JsonReader::_parse_json_doc(&size, eof);
+    }
     // terminate if encounter other errors
     RETURN_IF_ERROR(st);
 
@@ -481,6 +505,406 @@ Status VJsonReader::_parse_json(bool* is_empty_row, bool* eof) {
     return Status::OK();
 }
 
+bool VJsonReader::_init_simdjson_paths() {
+    // only the paths of object keys, e.g. "$.a.b"
+    auto to_keys = [](const std::vector<JsonPath>& path, std::vector<std::string>* keys) {
+        if (path.empty() || !path[0].is_valid || path[0].idx != -1) {
+            return false;
+        }
+        for (size_t i = 1; i < path.size(); ++i) {
+            if (!path[i].is_valid || path[i].key.empty() || path[i].idx != -1) {
+                return false;
+            }
+            keys->push_back(path[i].key);
+        }
+        return true;
+    };
+    _simdjson_root.clear();
+    _simdjson_paths.clear();
+    if (!_parsed_json_root.empty() && !to_keys(_parsed_json_root, &_simdjson_root)) {
+        return false;
+    }
+    for (const auto& path : _parsed_jsonpaths) {
+        std::vector<std::string> keys;
+        if (!to_keys(path, &keys) || keys.empty()) {
+            return false;
+        }
+        _simdjson_paths.push_back(std::move(keys));
+    }
+    return true;
+}
+
+Status VJsonReader::_simdjson_handle_json(std::vector<MutableColumnPtr>& columns,
+                                          const std::vector<SlotDescriptor*>& slot_descs,
+                                          bool* is_empty_row, bool* eof) {
+    const size_t batch_size = _state->batch_size();
+    *is_empty_row = true;
+    while (columns[0]->size() < batch_size) {
+        if (!_in_document) {
+            bool fallback = false;
+            RETURN_IF_ERROR(_simdjson_next_document(eof, &fallback));
+            if (*eof) {
+                return Status::OK();
+            }
+            if (fallback) {
+                return _fall_back_to_rapidjson(columns, slot_descs, is_empty_row, eof);
+            }
+            if (!_in_document) {
+                // empty line
+                continue;
+            }
+        }
+
+        size_t rows = columns[0]->size();
+        bool fallback = false;
+        if (_array_document) {
+            simdjson::ondemand::value value;
+            simdjson::ondemand::object row;
+            if ((*_array_iter).get(value) || value.get_object().get(row)) {
+                fallback = true;
+            } else {
+                RETURN_IF_ERROR(_simdjson_write_row(row, columns, slot_descs, &fallback));
+            }
+        } else {
+            RETURN_IF_ERROR(_simdjson_write_row(_object_row, columns, slot_descs, &fallback));
+        }
+        if (fallback) {
+            // remove the partially written row
+            for (auto& column : columns) {
+                if (column->size() > rows) {
+                    column->pop_back(column->size() - rows);
+                }
+            }
+            _in_document = false;
+            return _fall_back_to_rapidjson(columns, slot_descs, is_empty_row, eof);
+        }
+        *is_empty_row = false;
+        ++_document_row;
+        if (_array_document) {
+            ++_array_iter;
+            _in_document = _array_iter != _array_end;
+        } else {
+            _in_document = false;
+        }
+    }
+    return Status::OK();
+}
+
+Status VJsonReader::_simdjson_next_document(bool* eof, bool* fallback) {
+    SCOPED_TIMER(_file_read_timer);
+    const uint8_t* json_str = nullptr;
+    std::unique_ptr<uint8_t[]> json_str_ptr;
+    size_t size = 0;
+    if (_line_reader != nullptr) {
+        RETURN_IF_ERROR(_line_reader->read_line(&json_str, &size, eof));
+    } else {
+        int64_t length = 0;
+        RETURN_IF_ERROR(_file_reader->read_one_message(&json_str_ptr, &length));
+        json_str = json_str_ptr.get();
+        size = length;
+        if (length == 0) {
+            *eof = true;
+        }
+    }
+    COUNTER_UPDATE(_bytes_read_counter, size);
+    if (*eof || size == 0) {
+        return Status::OK();
+    }
+
+    if (_simdjson_buffer_capacity < size + simdjson::SIMDJSON_PADDING) {
+        _simdjson_buffer_capacity = size + simdjson::SIMDJSON_PADDING;
+        _simdjson_buffer.reset(new char[_simdjson_buffer_capacity]);
+    }
+    memcpy(_simdjson_buffer.get(), json_str, size);
+    _simdjson_size = size;
+    _document_row = 0;
+
+    // Rows are the elements of the array if `strip_outer_array`, or the object itself.
+    // The mismatched, empty or invalid documents are left to rapidjson to report.
+    auto locate_rows = [this](auto& json) {
+        simdjson::ondemand::json_type type;
+        if (json.type().get(type)) {
+            return false;
+        }
+        if (type == simdjson::ondemand::json_type::array) {
+            simdjson::ondemand::array array;
+            if (!_strip_outer_array || json.get_array().get(array) ||
+                array.begin().get(_array_iter) || array.end().get(_array_end)) {
+                return false;
+            }
+            _array_document = true;
+            return _array_iter != _array_end;
+        }
+        if (type == simdjson::ondemand::json_type::object) {
+            _array_document = false;
+            return !_strip_outer_array && json.get_object().get(_object_row) == simdjson::SUCCESS;
+        }
+        return false;
+    };
+
+    *fallback = true;
+    if (_ondemand_parser.iterate(_simdjson_buffer.get(), size, _simdjson_buffer_capacity)
+                .get(_ondemand_doc)) {
+        return Status::OK();
+    }
+    if (_simdjson_root.empty()) {
+        *fallback = !locate_rows(_ondemand_doc);
+    } else {
+        simdjson::ondemand::object object;
+        simdjson::ondemand::value value;
+        if (_ondemand_doc.get_object().get(object)) {
+            return Status::OK();
+        }
+        for (size_t i = 0; i < _simdjson_root.size(); ++i) {
+            if (object.find_field_unordered(_simdjson_root[i]).get(value) ||
+                (i + 1 < _simdjson_root.size() && value.get_object().get(object))) {
+                return Status::OK();
+            }
+        }
+        *fallback = !locate_rows(value);
+    }
+    _in_document = !*fallback;
+    return Status::OK();
+}
+
+Status VJsonReader::_simdjson_write_row(simdjson::ondemand::object& row,
+                                        std::vector<MutableColumnPtr>& columns,
+                                        const std::vector<SlotDescriptor*>& slot_descs,
+                                        bool* fallback) {
+    // Same as _set_column_value() and _write_columns_by_jsonpath(), but any invalid row
+    // is left to them.
+    int nullcount = 0;
+    if (_parsed_jsonpaths.empty()) {
+        int ctx_idx = 0;
+        for (auto slot_desc : slot_descs) {
+            if (!slot_desc->is_materialized()) {
+                continue;
+            }
+            auto* column_ptr = columns[ctx_idx++].get();
+            simdjson::ondemand::value value;
+            auto error = row.find_field_unordered(slot_desc->col_name()).get(value);
+            if (error == simdjson::NO_SUCH_FIELD && slot_desc->is_nullable()) {
+                column_ptr->insert_default();
+                nullcount++;
+                continue;
+            }
+            if (error) {
+                *fallback = true;
+                return Status::OK();
+            }
+            RETURN_IF_ERROR(_simdjson_write_value(value, slot_desc, column_ptr, fallback));
+            if (*fallback) {
+                return Status::OK();
+            }
+        }
+        *fallback = nullcount == slot_descs.size();
+        return Status::OK();
+    }
+
+    size_t column_num = slot_descs.size();
+    for (size_t i = 0; i < column_num; i++) {
+        auto* column_ptr = columns[i].get();
+        simdjson::ondemand::value value;
+        bool found = false;
+        if (LIKELY(i < _simdjson_paths.size())) {
+            const auto& keys = _simdjson_paths[i];
+            auto error = row.find_field_unordered(keys[0]).get(value);
+            found = !error;
+            for (size_t k = 1; found && k < keys.size(); ++k) {
+                simdjson::ondemand::json_type type;
+                simdjson::ondemand::object object;
+                if (value.type().get(type) || type == simdjson::ondemand::json_type::array) {
+                    // the keys are matched in all elements of an array
+                    *fallback = true;
+                    return Status::OK();
+                }
+                if (type != simdjson::ondemand::json_type::object) {
+                    // not a nested type
+                    found = false;
+                    break;
+                }
+                if (value.get_object().get(object)) {
+                    *fallback = true;
+                    return Status::OK();
+                }
+                error = object.find_field_unordered(keys[k]).get(value);
+                found = !error;
+            }
+            if (error && error != simdjson::NO_SUCH_FIELD) {
+                *fallback = true;
+                return Status::OK();
+            }
+        }
+
+        if (!found) {
+            if (!slot_descs[i]->is_nullable()) {
+                *fallback = true;
+                return Status::OK();
+            }
+            column_ptr->insert_default();
+            nullcount++;
+            continue;
+        }
+        RETURN_IF_ERROR(_simdjson_write_value(value, slot_descs[i], column_ptr, fallback));
+        if (*fallback) {
+            return Status::OK();
+        }
+    }
+    *fallback = nullcount == column_num;
+    return Status::OK();
+}
+
+// Whether `str` is a json number, and whether it is an integer.
+static bool is_json_number(std::string_view str, bool* is_integer) {
+    size_t i = 0;
+    if (i < str.size() && str[i] == '-') {
+        ++i;
+    }
+    size_t digits_begin = i;
+    while (i < str.size() && isdigit(str[i])) {
+        ++i;
+    }
+    if (i == digits_begin || (str[digits_begin] == '0' && i - digits_begin > 1)) {
+        return false;
+    }
+    *is_integer = i == str.size();
+    if (i < str.size() && str[i] == '.') {
+        size_t fraction_begin = ++i;
+        while (i < str.size() && isdigit(str[i])) {
+            ++i;
+        }
+        if (i == fraction_begin) {
+            return false;
+        }
+    }
+    if (i < str.size() && (str[i] == 'e' || str[i] == 'E')) {
+        ++i;
+        if (i < str.size() && (str[i] == '+' || str[i] == '-')) {
+            ++i;
+        }
+        size_t exponent_begin = i;
+        while (i < str.size() && isdigit(str[i])) {
+            ++i;
+        }
+        if (i == exponent_begin) {
+            return false;
+        }
+    }
+    return i == str.size();
+}
+
+// Format a json number as _write_data_to_column() does for a rapidjson value: integers in
+// 64 bits as they are, the others as doubles by "%f".
+static std::string_view format_json_number(std::string_view str, bool is_integer, char* buf,
+                                           size_t buf_size) {
+    std::string number(str);
+    if (is_integer) {
+        if (number == "-0") {
+            return "0";
+        }
+        errno = 0;
+        if (number[0] == '-') {
+            strtoll(number.c_str(), nullptr, 10);
+        } else {
+            strtoull(number.c_str(), nullptr, 10);
+        }
+        if (errno != ERANGE) {
+            return str;
+        }
+    }
+    int len = snprintf(buf, buf_size, "%f", strtod(number.c_str(), nullptr));
+    return std::string_view(buf, std::min<size_t>(len, buf_size - 1));
+}
+
+Status VJsonReader::_simdjson_write_value(simdjson::ondemand::value& value,
+                                          SlotDescriptor* slot_desc,
+                                          vectorized::IColumn* column_ptr, bool* fallback) {
+    simdjson::ondemand::json_type type;
+    if (value.type().get(type)) {
+        *fallback = true;
+        return Status::OK();
+    }
+
+    std::string_view str;
+    char buf[512];
+    bool is_integer = false;
+    bool bool_value = false;
+    switch (type) {
+    case simdjson::ondemand::json_type::string:
+        *fallback = value.get_string().get(str) != simdjson::SUCCESS;
+        break;
+    case simdjson::ondemand::json_type::number:
+        str = value.raw_json_token();
+        while (!str.empty() && isspace(str.back())) {
+            str.remove_suffix(1);
+        }
+        *fallback = !is_json_number(str, &is_integer);
+        if (!*fallback && !_num_as_string) {
+            str = format_json_number(str, is_integer, buf, sizeof(buf));
+        }
+        break;
+    case simdjson::ondemand::json_type::boolean:
+        *fallback = value.get_bool().get(bool_value) != simdjson::SUCCESS;
+        str = bool_value ? "1" : "0";
+        break;
+    case simdjson::ondemand::json_type::null:
+        *fallback = !slot_desc->is_nullable();
+        if (!*fallback) {
+            column_ptr->insert_default();
+        }
+        return Status::OK();
+    default:
+        // nested values are printed by rapidjson
+        *fallback = true;
+        break;
+    }
+    if (*fallback) {
+        return Status::OK();
+    }
+
+    if (slot_desc->is_nullable()) {
+        auto* nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(column_ptr);
+        nullable_column->get_null_map_data().push_back(0);
+        column_ptr = &nullable_column->get_nested_column();
+    }
+    DCHECK(slot_desc->type().type == TYPE_VARCHAR);
+    assert_cast<ColumnString*>(column_ptr)->insert_data(str.data(), str.size());
+    return Status::OK();
+}
+
+Status VJsonReader::_fall_back_to_rapidjson(std::vector<MutableColumnPtr>& columns,
+                                            const std::vector<SlotDescriptor*>& slot_descs,
+                                            bool* is_empty_row, bool* eof) {
+    _replay_document = true;
+    _rapidjson_in_progress = true;
+    if (_document_row > 0) {
+        // the rows before `_document_row` of the array are read, go on from the next one
+        Status st = _parse_json(is_empty_row, eof);
+        if (st.is_data_quality_error() || (st.ok() && *is_empty_row)) {
+            _rapidjson_in_progress = false;
+            *is_empty_row = true;
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(st);
+        _total_lines = _json_doc->Size();
+        _next_line = _document_row;
+        _name_map.clear();
+        if (_parsed_jsonpaths.empty() && _fuzzy_parse && (*_json_doc)[0].IsObject()) {
+            _fill_name_map((*_json_doc)[0], slot_descs);
+        }
+        if (_next_line >= _total_lines) {
+            _rapidjson_in_progress = false;
+            *is_empty_row = true;
+            return Status::OK();
+        }
+    }
+    RETURN_IF_ERROR((this->*_vhandle_json_callback)(columns, slot_descs, is_empty_row, eof));
+    if (_next_line >= _total_lines) {
+        _rapidjson_in_progress = false;
+    }
+    return Status::OK();
+}
+
 Status VJsonReader::_append_error_msg(const rapidjson::Value& objectValue, std::string error_msg,
                                       std::string col_name, bool* valid) {
     std::string err_msg;
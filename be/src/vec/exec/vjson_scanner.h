@@ -21,6 +21,7 @@
 #include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
+#include <simdjson.h>
 
 #include <map>
 #include <memory>
@@ -108,6 +109,52 @@ private:
 
     Status _append_error_msg(const rapidjson::Value& objectValue, std::string error_msg,
                              std::string col_name, bool* valid);
+
+    void _fill_name_map(const rapidjson::Value& objectValue,
+                        const std::vector<SlotDescriptor*>& slot_descs);
+
+    // The simdjson on demand path, which only handles the documents whose rows are all valid
+    // and whose loaded values are all scalars. Once it meets anything else, the rest of the
+    // document is handed to the rapidjson callbacks, so the errors are reported as before.
+    bool _init_simdjson_paths();
+    Status _simdjson_handle_json(std::vector<MutableColumnPtr>& columns,
+                                 const std::vector<SlotDescriptor*>& slot_descs,
+                                 bool* is_empty_row, bool* eof);
+    // Read the next document and locate its rows, `*fallback` is set if it can not.
+    Status _simdjson_next_document(bool* eof, bool* fallback);
+    Status _simdjson_write_row(simdjson::ondemand::object& row,
+                               std::vector<MutableColumnPtr>& columns,
+                               const std::vector<SlotDescriptor*>& slot_descs, bool* fallback);
+    Status _simdjson_write_value(simdjson::ondemand::value& value, SlotDescriptor* slot_desc,
+                                 IColumn* column_ptr, bool* fallback);
+    // Parse the current document by rapidjson and go on from the row `_document_row`.
+    Status _fall_back_to_rapidjson(std::vector<MutableColumnPtr>& columns,
+                                   const std::vector<SlotDescriptor*>& slot_descs,
+                                   bool* is_empty_row, bool* eof);
+
+    bool _use_simdjson = false;
+    // the rapidjson callbacks are reading the rest of the current document
+    bool _rapidjson_in_progress = false;
+    // _parse_json() parses the document in `_simdjson_buffer` instead of reading one
+    bool _replay_document = false;
+    // the keys of `_parsed_json_root` and `_parsed_jsonpaths` after '$'
+    std::vector<std::string> _simdjson_root;
+    std::vector<std::vector<std::string>> _simdjson_paths;
+
+    simdjson::ondemand::parser _ondemand_parser;
+    simdjson::ondemand::document _ondemand_doc;
+    // the rows of the current document left, which is an array or an object
+    bool _in_document = false;
+    bool _array_document = false;
+    simdjson::ondemand::array_iterator _array_iter;
+    simdjson::ondemand::array_iterator _array_end;
+    simdjson::ondemand::object _object_row;
+    // the index of the next row in the current document
+    int _document_row = 0;
+    // with simdjson::SIMDJSON_PADDING bytes after the document
+    std::unique_ptr<char[]> _simdjson_buffer;
+    size_t _simdjson_buffer_capacity = 0;
+    size_t _simdjson_size = 0;
 };
 
 } // namespace vectorized
@@ -60,6 +60,7 @@ Status VOdbcScanNode::prepare(RuntimeState* state) {
     _odbc_param.connect_string = std::move(_connect_string);
     _odbc_param.query_string = std::move(_query_string);
     _odbc_param.tuple_desc = _tuple_desc;
+    _odbc_param.max_row_array_size = state->batch_size();
 
     _odbc_scanner.reset(new (std::nothrow) ODBCConnector(_odbc_param));
 
@@ -86,6 +87,7 @@ Status VOdbcScanNode::prepare(RuntimeState* state) {
 
 Status VOdbcScanNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     RETURN_IF_ERROR(ExecNode::open(state));
     VLOG_CRITICAL << _scan_node_type << "::Open";
@@ -160,21 +162,20 @@ Status VOdbcScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
             }
         }
 
-        for (int row_index = 0; true; row_index++) {
-            // block is full, break
-            if (state->batch_size() <= columns[0]->size()) {
-                break;
-            }
-
-            RETURN_IF_ERROR(odbc_scanner->get_next_row(&odbc_eos));
-
-            if (odbc_eos) {
-                *eos = true;
-                break;
+        // block is full, break
+        while (columns[0]->size() < state->batch_size()) {
+            if (_next_fetched_row == _num_fetched_rows) {
+                _next_fetched_row = 0;
+                RETURN_IF_ERROR(odbc_scanner->get_next_rows(&_num_fetched_rows, &odbc_eos));
+                if (odbc_eos) {
+                    *eos = true;
+                    break;
+                }
             }
 
-            // Read one row from reader
-
+            // Convert the fetched rows column by column
+            size_t num_rows = std::min(_num_fetched_rows - _next_fetched_row,
+                                       state->batch_size() - columns[0]->size());
             for (int column_index = 0, materialized_column_index = 0; column_index < column_size;
                  ++column_index) {
                 auto slot_desc = tuple_desc->slots()[column_index];
@@ -184,18 +185,27 @@ Status VOdbcScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
                 }
                 const auto& column_data = odbc_scanner->get_column_data(materialized_column_index);
 
-                char* value_data = static_cast<char*>(column_data.target_value_ptr);
-                int value_len = column_data.strlen_or_ind;
-
-                if (!text_converter->write_column(slot_desc, &columns[column_index], value_data,
-                                                  value_len, true, false)) {
-                    std::stringstream ss;
-                    ss << "Fail to convert odbc value:'" << value_data << "' to "
-                       << slot_desc->type() << " on column:`" << slot_desc->col_name() + "`";
-                    return Status::InternalError(ss.str());
+                for (size_t row = _next_fetched_row; row < _next_fetched_row + num_rows; ++row) {
+                    char* value_data = column_data.value(row);
+                    SQLLEN value_len = column_data.length(row);
+                    if (value_len > column_data.buffer_length) {
+                        std::stringstream ss;
+                        ss << "the value of column:`" << slot_desc->col_name()
+                           << "` is truncated, length " << value_len;
+                        return Status::InternalError(ss.str());
+                    }
+
+                    if (!text_converter->write_column(slot_desc, &columns[column_index],
+                                                      value_data, value_len, true, false)) {
+                        std::stringstream ss;
+                        ss << "Fail to convert odbc value:'" << value_data << "' to "
+                           << slot_desc->type() << " on column:`" << slot_desc->col_name() + "`";
+                        return Status::InternalError(ss.str());
+                    }
                 }
                 materialized_column_index++;
             }
+            _next_fetched_row += num_rows;
         }
 
         // Before really use the Block, muse clear other ptr of column in block
@@ -225,6 +235,7 @@ Status VOdbcScanNode::close(RuntimeState* state) {
     }
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::CLOSE));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
 
     _tuple_pool.reset();
 
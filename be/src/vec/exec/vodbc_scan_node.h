@@ -89,6 +89,10 @@ private:
     std::unique_ptr<TextConverter> _text_converter;
     // Current tuple.
     doris::Tuple* _tuple = nullptr;
+    // the rows of the array fetched by _odbc_scanner, [_next_fetched_row, _num_fetched_rows)
+    // are not read yet
+    size_t _num_fetched_rows = 0;
+    size_t _next_fetched_row = 0;
 };
 } // namespace vectorized
 } // namespace doris
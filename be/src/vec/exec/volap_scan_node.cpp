@@ -17,6 +17,9 @@
 
 #include "vec/exec/volap_scan_node.h"
 
+#include <algorithm>
+
+#include "agent/cgroups_mgr.h"
 #include "common/resource_tls.h"
 #include "exec/scan_node.h"
 #include "gen_cpp/PlanNodes_types.h"
@@ -25,9 +28,15 @@
 #include "runtime/exec_env.h"
 #include "runtime/large_int_value.h"
 #include "runtime/runtime_filter_mgr.h"
+#include "runtime/workload_group.h"
+#include "util/doris_metrics.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/query_trace.h"
+#include "util/time.h"
 #include "util/to_string.h"
 #include "vec/core/block.h"
+#include "vec/exec/scan/scanner_context.h"
+#include "vec/exec/vaggregation_node.h"
 #include "vec/exec/volap_scanner.h"
 #include "vec/exprs/vexpr.h"
 
@@ -41,19 +50,12 @@ VOlapScanNode::VOlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const Des
           _tuple_desc(nullptr),
           _tuple_idx(0),
           _eos(false),
-          _max_materialized_row_batches(config::doris_scanner_queue_size),
           _start(false),
-          _scanner_done(false),
-          _transfer_done(false),
-          _status(Status::OK()),
           _resource_info(nullptr),
-          _buffered_bytes(0),
           _eval_conjuncts_fn(nullptr),
-          _runtime_filter_descs(tnode.runtime_filters),
-          _max_materialized_blocks(config::doris_scanner_queue_size) {
-    _materialized_blocks.reserve(_max_materialized_blocks);
-    _free_blocks.reserve(_max_materialized_blocks);
-}
+          _runtime_filter_descs(tnode.runtime_filters) {}
+
+VOlapScanNode::~VOlapScanNode() = default;
 
 Status VOlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
@@ -119,6 +121,14 @@ void VOlapScanNode::_init_counter(RuntimeState* state) {
     _block_seek_counter = ADD_COUNTER(_segment_profile, "BlockSeekCount", TUnit::UNIT);
 
     _rows_vec_cond_counter = ADD_COUNTER(_segment_profile, "RowsVectorPredFiltered", TUnit::UNIT);
+    _rows_pred_column_skipped_counter =
+            ADD_COUNTER(_segment_profile, "RowsPredColumnSkipped", TUnit::UNIT);
+    _rows_read_by_metadata_counter =
+            ADD_COUNTER(_segment_profile, "RowsReadByMetadata", TUnit::UNIT);
+    _rows_counted_by_index_counter =
+            ADD_COUNTER(_segment_profile, "RowsCountedByIndex", TUnit::UNIT);
+    _rows_read_by_row_store_counter =
+            ADD_COUNTER(_segment_profile, "RowsReadByRowStore", TUnit::UNIT);
     _vec_cond_timer = ADD_TIMER(_segment_profile, "VectorPredEvalTime");
     _short_cond_timer = ADD_TIMER(_segment_profile, "ShortPredEvalTime");
     _first_read_timer = ADD_TIMER(_segment_profile, "FirstReadTime");
@@ -152,14 +162,18 @@ void VOlapScanNode::_init_counter(RuntimeState* state) {
     _filtered_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentFiltered", TUnit::UNIT);
     _total_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentTotal", TUnit::UNIT);
 
-    // time of transfer thread to wait for row batch from scan thread
-    _scanner_wait_batch_timer = ADD_TIMER(_runtime_profile, "ScannerBatchWaitTime");
     // time of scan thread to wait for worker thread of the thread pool
     _scanner_wait_worker_timer = ADD_TIMER(_runtime_profile, "ScannerWorkerWaitTime");
 
     // time of node to wait for batch/block queue
     _olap_wait_batch_queue_timer = ADD_TIMER(_runtime_profile, "BatchQueueWaitTime");
 
+    // time of scanner threads to aggregate the blocks read
+    _scan_aggregation_timer = ADD_TIMER(_runtime_profile, "ScanAggregationTime");
+
+    // rows of the blocks sized by the observed row width
+    _adaptive_block_rows_counter = ADD_COUNTER(_runtime_profile, "AdaptiveBlockRows", TUnit::UNIT);
+
     // for the purpose of debugging or profiling
     for (int i = 0; i < GENERAL_DEBUG_COUNT; ++i) {
         char name[64];
@@ -220,6 +234,7 @@ Status VOlapScanNode::prepare(RuntimeState* state) {
 Status VOlapScanNode::open(RuntimeState* state) {
     VLOG_CRITICAL << "VOlapScanNode::Open";
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(mem_tracker());
     RETURN_IF_CANCELLED(state);
     RETURN_IF_ERROR(ExecNode::open(state));
@@ -239,6 +254,7 @@ Status VOlapScanNode::open(RuntimeState* state) {
         }
         bool ready = runtime_filter->is_ready();
         if (!ready) {
+            SCOPED_QUERY_TRACE("runtime_filter", "wait_runtime_filter");
             ready = runtime_filter->await();
         }
         if (ready) {
@@ -261,134 +277,42 @@ Status VOlapScanNode::open(RuntimeState* state) {
     return Status::OK();
 }
 
-void VOlapScanNode::transfer_thread(RuntimeState* state) {
-    // scanner open pushdown to scanThread
-    SCOPED_ATTACH_TASK_THREAD(state, mem_tracker());
-    Status status = Status::OK();
-
-    if (_vconjunct_ctx_ptr) {
-        for (auto scanner : _volap_scanners) {
-            status = (*_vconjunct_ctx_ptr)->clone(state, scanner->vconjunct_ctx_ptr());
-            if (!status.ok()) {
-                std::lock_guard<SpinLock> guard(_status_mutex);
-                _status = status;
-                break;
-            }
-        }
-    }
-
-    /*********************************
-     * 优先级调度基本策略:
-     * 1. 通过查询拆分的Range个数来确定初始nice值
-     *    Range个数越多，越倾向于认定为大查询，nice值越小
-     * 2. 通过查询累计读取的数据量来调整nice值
-     *    读取的数据越多，越倾向于认定为大查询，nice值越小
-     * 3. 通过nice值来判断查询的优先级
-     *    nice值越大的，越优先获得的查询资源
-     * 4. 定期提高队列内残留任务的优先级，避免大查询完全饿死
-     *********************************/
-    _total_assign_num = 0;
-    _nice = 18 + std::max(0, 2 - (int)_volap_scanners.size() / 5);
-
-    auto doris_scanner_row_num =
-            _limit == -1 ? config::doris_scanner_row_num
-                         : std::min(static_cast<int64_t>(config::doris_scanner_row_num), _limit);
-    _block_size = _limit == -1 ? state->batch_size()
-                               : std::min(static_cast<int64_t>(state->batch_size()), _limit);
-    auto block_per_scanner = (doris_scanner_row_num + (_block_size - 1)) / _block_size;
-    auto pre_block_count =
-            std::min(_volap_scanners.size(),
-                     static_cast<size_t>(config::doris_scanner_thread_pool_thread_num)) *
-            block_per_scanner;
-
-    for (int i = 0; i < pre_block_count; ++i) {
-        auto block = new Block(_tuple_desc->slots(), _block_size);
-        _free_blocks.emplace_back(block);
-        _buffered_bytes += block->allocated_bytes();
-    }
-
-    _block_mem_tracker->consume(_buffered_bytes);
-
-    // read from scanner
-    while (LIKELY(status.ok())) {
-        int assigned_thread_num = _start_scanner_thread_task(state, block_per_scanner);
-
-        std::vector<Block*> blocks;
-        {
-            // 1 scanner idle task not empty, assign new scanner task
-            std::unique_lock<std::mutex> l(_scan_blocks_lock);
-
-            // scanner_row_num = 16k
-            // 16k * 10 * 12 * 8 = 15M(>2s)  --> nice=10
-            // 16k * 20 * 22 * 8 = 55M(>6s)  --> nice=0
-            while (_nice > 0 && _total_assign_num > (22 - _nice) * (20 - _nice) * 6) {
-                --_nice;
-            }
-
-            // 2 wait when all scanner are running & no result in queue
-            while (UNLIKELY(_running_thread == assigned_thread_num && _scan_blocks.empty() &&
-                            !_scanner_done)) {
-                SCOPED_TIMER(_scanner_wait_batch_timer);
-                _scan_block_added_cv.wait(l);
-            }
-
-            // 3 transfer result block when queue is not empty
-            if (LIKELY(!_scan_blocks.empty())) {
-                blocks.swap(_scan_blocks);
-                for (auto b : blocks) {
-                    _scan_row_batches_bytes -= b->allocated_bytes();
-                }
-                // delete scan_block if transfer thread should be stopped
-                // because scan_block wouldn't be useful anymore
-                if (UNLIKELY(_transfer_done)) {
-                    std::for_each(blocks.begin(), blocks.end(), std::default_delete<Block>());
-                    blocks.clear();
-                }
-            } else {
-                if (_scanner_done) {
-                    break;
-                }
-            }
-        }
-
-        if (!blocks.empty()) {
-            _add_blocks(blocks);
-        }
-    }
-
-    VLOG_CRITICAL << "TransferThread finish.";
-    _transfer_done = true;
-    _block_added_cv.notify_all();
-    {
-        std::unique_lock<std::mutex> l(_scan_blocks_lock);
-        _scan_thread_exit_cv.wait(l, [this] { return _running_thread == 0; });
-    }
-    VLOG_CRITICAL << "Scanner threads have been exited. TransferThread exit.";
+int VOlapScanNode::_adaptive_block_rows() const {
+    // blocks of too few rows do not amortize the cost per block of the operators
+    constexpr int64_t MIN_BLOCK_ROWS = 64;
+    const int batch_size = _runtime_state->batch_size();
+    int64_t rows = _observed_block_rows.load(std::memory_order_relaxed);
+    if (config::scan_block_target_bytes <= 0 || rows < batch_size) {
+        return batch_size;
+    }
+    int64_t row_bytes =
+            std::max<int64_t>(_observed_block_bytes.load(std::memory_order_relaxed) / rows, 1);
+    int64_t max_rows = std::max<int64_t>(config::scan_block_max_rows, batch_size);
+    return std::clamp<int64_t>(config::scan_block_target_bytes / row_bytes,
+                               std::min<int64_t>(MIN_BLOCK_ROWS, batch_size), max_rows);
 }
 
 void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     SCOPED_ATTACH_TASK_THREAD(_runtime_state, mem_tracker());
     ADD_THREAD_LOCAL_MEM_TRACKER(scanner->mem_tracker());
     Thread::set_self_name("volap_scanner");
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
+    if (_scanner_ctx->workload_group() != nullptr) {
+        _scanner_ctx->workload_group()->apply_cgroup();
+    } else {
+        CgroupsMgr::apply_system_cgroup();
+    }
     int64_t wait_time = scanner->update_wait_worker_timer();
+    DorisMetrics::instance()->scanner_queue_wait_us->add(wait_time / NANOS_PER_MICRO);
     // Do not use ScopedTimer. There is no guarantee that, the counter
-    // (_scan_cpu_timer, the class member) is not destroyed after `_running_thread==0`.
+    // (_scan_cpu_timer, the class member) is not destroyed after the scanner is pushed back
+    // to the context.
     ThreadCpuStopWatch cpu_watch;
     cpu_watch.start();
     Status status = Status::OK();
     bool eos = false;
     RuntimeState* state = scanner->runtime_state();
     DCHECK(nullptr != state);
-    if (!scanner->is_open()) {
-        status = scanner->open();
-        if (!status.ok()) {
-            std::lock_guard<SpinLock> guard(_status_mutex);
-            _status = status;
-            eos = true;
-        }
-        scanner->set_opened();
-    }
-
     std::vector<ExprContext*> contexts;
     auto& scanner_filter_apply_marks = *scanner->mutable_runtime_filter_marks();
     DCHECK(scanner_filter_apply_marks.size() == _runtime_filter_descs.size());
@@ -413,6 +337,24 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
         scanner_conjunct_ctxs.insert(scanner_conjunct_ctxs.end(), new_contexts.begin(),
                                      new_contexts.end());
         scanner->set_use_pushdown_conjuncts(true);
+
+        std::vector<TCondition> filters;
+        std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>> bloom_filters;
+        for (auto ctx : new_contexts) {
+            // a runtime filter failed to push down is just not applied
+            WARN_IF_ERROR(_normalize_late_runtime_filter(ctx, &filters, &bloom_filters),
+                          "failed to push down runtime filter to storage");
+        }
+        scanner->append_runtime_filters(filters, bloom_filters);
+    }
+
+    if (!scanner->is_open()) {
+        status = scanner->open();
+        if (!status.ok()) {
+            _scanner_ctx->set_status_on_error(status);
+            eos = true;
+        }
+        scanner->set_opened();
     }
 
     std::vector<Block*> blocks;
@@ -429,20 +371,27 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     int64_t raw_bytes_threshold = config::doris_scanner_row_bytes;
     bool get_free_block = true;
     int num_rows_in_block = 0;
+    const int block_rows = _adaptive_block_rows();
+    COUNTER_SET(_adaptive_block_rows_counter, (int64_t)block_rows);
 
     // Has to wait at least one full block, or it will cause a lot of schedule task in priority
     // queue, it will affect query latency and query concurrency for example ssb 3.3.
     while (!eos && ((raw_rows_read < raw_rows_threshold && raw_bytes_read < raw_bytes_threshold &&
                      get_free_block) ||
-                    num_rows_in_block < _runtime_state->batch_size())) {
-        if (UNLIKELY(_transfer_done)) {
+                    num_rows_in_block < block_rows)) {
+        if (UNLIKELY(_scanner_ctx->done())) {
+            // No need to set status on error here.
+            // Because done() maybe caused by "should_stop"
             eos = true;
-            status = Status::Cancelled("Cancelled");
-            LOG(INFO) << "Scan thread cancelled, cause query done, maybe reach limit.";
+            VLOG_CRITICAL << "Scan thread stopped, cause query done, maybe reach limit.";
             break;
         }
 
-        auto block = _alloc_block(get_free_block);
+        auto block = _scanner_ctx->get_free_block(&get_free_block);
+        if (scanner->aggregator() != nullptr) {
+            // the free blocks may be in the layout of the aggregated ones
+            block->clear();
+        }
         status = scanner->get_block(_runtime_state, block, &eos);
         VLOG_ROW << "VOlapScanNode input rows: " << block->rows();
         if (!status.ok()) {
@@ -455,17 +404,31 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
 
         raw_bytes_read += block->allocated_bytes();
         num_rows_in_block += block->rows();
+        if (block->rows() != 0) {
+            _observed_block_bytes.fetch_add(block->bytes(), std::memory_order_relaxed);
+            _observed_block_rows.fetch_add(block->rows(), std::memory_order_relaxed);
+        }
+        if (scanner->aggregator() != nullptr && block->rows() != 0) {
+            SCOPED_TIMER(_scan_aggregation_timer);
+            status = scanner->aggregator()->sink(_runtime_state, block, false);
+            block->clear_column_data();
+            if (!status.ok()) {
+                LOG(WARNING) << "Scan thread aggregate blocks failed: " << status.to_string();
+                _scanner_ctx->return_free_block(block);
+                eos = true;
+                break;
+            }
+        }
         // 4. if status not ok, change status_.
         if (UNLIKELY(block->rows() == 0)) {
-            std::lock_guard<std::mutex> l(_free_blocks_lock);
-            _free_blocks.emplace_back(block);
+            _scanner_ctx->return_free_block(block);
         } else {
-            if (!blocks.empty() &&
-                blocks.back()->rows() + block->rows() <= _runtime_state->batch_size()) {
+            // the dictionary columns can't be merged
+            if (!blocks.empty() && _dict_output_slot_id < 0 &&
+                blocks.back()->rows() + block->rows() <= block_rows) {
                 MutableBlock(blocks.back()).merge(*block);
                 block->clear_column_data();
-                std::lock_guard<std::mutex> l(_free_blocks_lock);
-                _free_blocks.emplace_back(block);
+                _scanner_ctx->return_free_block(block);
             } else {
                 blocks.push_back(block);
             }
@@ -473,78 +436,53 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
         raw_rows_read = scanner->raw_rows_read();
     }
 
-    {
-        // if we failed, check status.
-        if (UNLIKELY(!status.ok())) {
-            _transfer_done = true;
-            std::lock_guard<SpinLock> guard(_status_mutex);
-            if (LIKELY(_status.ok())) {
-                _status = status;
+    // Flush the groups aggregated once the scanner finishes or they are too many,
+    // the blocks flushed are merged by the parent aggregation node.
+    auto* aggregator = scanner->aggregator();
+    if (aggregator != nullptr && status.ok() &&
+        (eos ||
+         aggregator->scan_aggregation_groups() >= (size_t)config::scan_aggregation_max_groups)) {
+        SCOPED_TIMER(_scan_aggregation_timer);
+        bool flushed = false;
+        while (status.ok() && !flushed) {
+            auto block = _scanner_ctx->get_free_block(&get_free_block);
+            block->clear();
+            status = aggregator->flush_scan_aggregation(_runtime_state, block, &flushed);
+            if (block->rows() == 0) {
+                block->clear();
+                _scanner_ctx->return_free_block(block);
+            } else {
+                blocks.push_back(block);
             }
         }
-
-        bool global_status_ok = false;
-        {
-            std::lock_guard<SpinLock> guard(_status_mutex);
-            global_status_ok = _status.ok();
-        }
-        if (UNLIKELY(!global_status_ok)) {
+        if (!status.ok()) {
+            LOG(WARNING) << "Scan thread flush aggregated blocks failed: " << status.to_string();
             eos = true;
-            std::for_each(blocks.begin(), blocks.end(), std::default_delete<Block>());
-        } else {
-            std::lock_guard<std::mutex> l(_scan_blocks_lock);
-            _scan_blocks.insert(_scan_blocks.end(), blocks.begin(), blocks.end());
-            for (auto b : blocks) {
-                _scan_row_batches_bytes += b->allocated_bytes();
-            }
         }
-        // If eos is true, we will process out of this lock block.
-        if (eos) {
-            scanner->mark_to_need_to_close();
+    }
+
+    // if we failed, check status.
+    if (UNLIKELY(!status.ok())) {
+        _scanner_ctx->set_status_on_error(status);
+    }
+    if (UNLIKELY(!_scanner_ctx->status().ok())) {
+        eos = true;
+        for (auto block : blocks) {
+            block->clear_column_data();
+            _scanner_ctx->return_free_block(block);
         }
-        std::lock_guard<std::mutex> l(_volap_scanners_lock);
-        _volap_scanners.push_front(scanner);
+    } else if (!blocks.empty()) {
+        _scanner_ctx->append_blocks_to_queue(blocks);
     }
     if (eos) {
-        std::lock_guard<std::mutex> l(_scan_blocks_lock);
-        _progress.update(1);
-        if (_progress.done()) {
-            // this is the right out
-            _scanner_done = true;
-        }
+        scanner->close(state);
     }
     _scan_cpu_timer->update(cpu_watch.elapsed_time());
     _scanner_wait_worker_timer->update(wait_time);
 
-    std::unique_lock<std::mutex> l(_scan_blocks_lock);
-    _running_thread--;
-
-    // The transfer thead will wait for `_running_thread==0`, to make sure all scanner threads won't access class members.
-    // Do not access class members after this code.
-    _scan_block_added_cv.notify_one();
-    _scan_thread_exit_cv.notify_one();
-}
-
-Status VOlapScanNode::_add_blocks(std::vector<Block*>& block) {
-    {
-        std::unique_lock<std::mutex> l(_blocks_lock);
-
-        // check queue limit for both block queue size and bytes
-        while (UNLIKELY((_materialized_blocks.size() >= _max_materialized_blocks ||
-                         _materialized_row_batches_bytes >= _max_scanner_queue_size_bytes / 2) &&
-                        !_transfer_done)) {
-            _block_consumed_cv.wait(l);
-        }
-
-        VLOG_CRITICAL << "Push block to materialized_blocks";
-        _materialized_blocks.insert(_materialized_blocks.end(), block.cbegin(), block.cend());
-        for (auto b : block) {
-            _materialized_row_batches_bytes += b->allocated_bytes();
-        }
-    }
-    // remove one block, notify main thread
-    _block_added_cv.notify_one();
-    return Status::OK();
+    // The scan node waits for all the scanners in close(), do not access class members
+    // after this code.
+    _scanner_ctx->push_back_scanner_and_reschedule(scanner, eos);
 }
 
 void VOlapScanNode::eval_const_conjuncts() {
@@ -754,13 +692,16 @@ Status VOlapScanNode::normalize_predicate(ColumnValueRange<T>& range, SlotDescri
     // 3. Normalize BinaryPredicate , add to ColumnValueRange
     RETURN_IF_ERROR(normalize_noneq_binary_predicate(slot, &range));
 
-    // 3. Normalize BloomFilterPredicate, push down by hash join node
+    // 4. Normalize prefix LikePredicate, add the range of the prefix to ColumnValueRange
+    RETURN_IF_ERROR(normalize_like_predicate(slot, &range));
+
+    // 5. Normalize BloomFilterPredicate, push down by hash join node
     RETURN_IF_ERROR(normalize_bloom_filter_predicate(slot));
 
-    // 4. Check whether range is empty, set _eos
+    // 6. Check whether range is empty, set _eos
     if (range.is_empty_value_range()) _eos = true;
 
-    // 5. Add range to Column->ColumnValueRange map
+    // 7. Add range to Column->ColumnValueRange map
     _column_value_ranges[slot->col_name()] = range;
 
     return Status::OK();
@@ -1030,6 +971,19 @@ Status VOlapScanNode::normalize_in_and_eq_predicate(SlotDescriptor* slot,
                 range->intersection(temp_range);
             } // end for each binary predicate child
         }     // end of handling eq binary predicate
+        // 3. Normalize or conjuncts like 'where col = v1 or col in (v2, v3)'
+        else if (TExprOpcode::COMPOUND_OR == _conjunct_ctxs[conj_idx]->root()->op()) {
+            bool pushed = false;
+            RETURN_IF_ERROR(_normalize_or_eq_predicate(slot, _conjunct_ctxs[conj_idx]->root(),
+                                                       conj_idx, &temp_range, &pushed));
+            if (!pushed) {
+                continue;
+            }
+            if (is_key_column(slot->col_name())) {
+                filter_conjuncts_index.emplace_back(conj_idx);
+            }
+            range->intersection(temp_range);
+        } // end of handling or predicate
     }
 
     // exceed limit, no conditions will be pushed down to storage engine.
@@ -1042,6 +996,57 @@ Status VOlapScanNode::normalize_in_and_eq_predicate(SlotDescriptor* slot,
     return Status::OK();
 }
 
+// Adds the values of `pred` into `range` if it's an eq BinaryPredicate, an InPredicate or an
+// OR of them, all on the specified column. `pushed` is false if any part of it is not.
+template <class T>
+Status VOlapScanNode::_normalize_or_eq_predicate(SlotDescriptor* slot, Expr* pred, int conj_idx,
+                                                 ColumnValueRange<T>* range, bool* pushed) {
+    *pushed = false;
+    if (TExprOpcode::COMPOUND_OR == pred->op()) {
+        DCHECK(pred->get_num_children() == 2);
+        for (int child_idx = 0; child_idx < 2; ++child_idx) {
+            RETURN_IF_ERROR(_normalize_or_eq_predicate(slot, pred->get_child(child_idx), conj_idx,
+                                                       range, pushed));
+            if (!*pushed) {
+                return Status::OK();
+            }
+        }
+    } else if (TExprOpcode::FILTER_IN == pred->op()) {
+        InPredicate* in_pred = static_cast<InPredicate*>(pred);
+        if (!should_push_down_in_predicate(slot, in_pred)) {
+            return Status::OK();
+        }
+        HybridSetBase::IteratorBase* iter = in_pred->hybrid_set()->begin();
+        for (; iter->has_next(); iter->next()) {
+            if (iter->get_value() == nullptr) {
+                continue;
+            }
+            RETURN_IF_ERROR(change_fixed_value_range(*range, slot->type().type,
+                                                     const_cast<void*>(iter->get_value()),
+                                                     ColumnValueRange<T>::add_fixed_value_range));
+        }
+        *pushed = true;
+    } else if (TExprNodeType::BINARY_PRED == pred->node_type() &&
+               FILTER_IN == to_olap_filter_type(pred->op(), false)) {
+        DCHECK(pred->get_num_children() == 2);
+        for (int child_idx = 0; child_idx < 2; ++child_idx) {
+            auto result_pair = should_push_down_eq_predicate(slot, pred, conj_idx, child_idx);
+            if (!result_pair.first) {
+                continue;
+            }
+            // col = nullptr matches no rows
+            if (result_pair.second != nullptr) {
+                RETURN_IF_ERROR(change_fixed_value_range(
+                        *range, slot->type().type, result_pair.second,
+                        ColumnValueRange<T>::add_fixed_value_range));
+            }
+            *pushed = true;
+            break;
+        }
+    }
+    return Status::OK();
+}
+
 // Construct the ColumnValueRange for one specified column
 // It will only handle the NotInPredicate and not eq BinaryPredicate in conjunct_ctxs.
 // It will try to push down conditions of that column as much as possible,
@@ -1276,6 +1281,57 @@ Status VOlapScanNode::normalize_noneq_binary_predicate(SlotDescriptor* slot,
     return Status::OK();
 }
 
+template <class T>
+Status VOlapScanNode::normalize_like_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range) {
+    if constexpr (std::is_same_v<T, StringValue>) {
+        // the values of char columns are padded, only handle varchar and string
+        if (slot->type().type != TYPE_VARCHAR && slot->type().type != TYPE_STRING) {
+            return Status::OK();
+        }
+        for (int conj_idx = 0; conj_idx < _conjunct_ctxs.size(); ++conj_idx) {
+            Expr* root_expr = _conjunct_ctxs[conj_idx]->root();
+            if (TExprNodeType::FUNCTION_CALL != root_expr->node_type() ||
+                root_expr->fn().name.function_name != "like" ||
+                root_expr->get_num_children() != 2) {
+                continue;
+            }
+            Expr* slot_expr = root_expr->get_child(0);
+            Expr* pattern_expr = root_expr->get_child(1);
+            if (Expr::type_without_cast(slot_expr) != TExprNodeType::SLOT_REF ||
+                !pattern_expr->is_constant()) {
+                continue;
+            }
+            if (slot_expr->type().type != slot->type().type && !ignore_cast(slot, slot_expr)) {
+                continue;
+            }
+            std::vector<SlotId> slot_ids;
+            if (slot_expr->get_slot_ids(&slot_ids) != 1 || slot_ids[0] != slot->id()) {
+                continue;
+            }
+            auto pattern = reinterpret_cast<StringValue*>(
+                    _conjunct_ctxs[conj_idx]->get_value(pattern_expr, nullptr));
+            if (pattern == nullptr) {
+                continue;
+            }
+            // for the inverted index of the column if any
+            _like_predicates_push_down.emplace_back(slot->col_name(), pattern->to_string());
+            auto lower = _pool->add(new std::string());
+            auto upper = _pool->add(new std::string());
+            if (!get_like_prefix_range(pattern->ptr, pattern->len, lower, upper)) {
+                continue;
+            }
+            // The like predicate is not pushed down, it still filters the rows in the range.
+            range->add_range(FILTER_LARGER_OR_EQUAL, StringValue(*lower));
+            if (!upper->empty()) {
+                range->add_range(FILTER_LESS, StringValue(*upper));
+            }
+            VLOG_CRITICAL << slot->col_name() << " like prefix range: [" << *lower << ", "
+                          << *upper << ")";
+        }
+    }
+    return Status::OK();
+}
+
 Status VOlapScanNode::normalize_bloom_filter_predicate(SlotDescriptor* slot) {
     std::vector<uint32_t> filter_conjuncts_index;
 
@@ -1304,9 +1360,14 @@ Status VOlapScanNode::normalize_bloom_filter_predicate(SlotDescriptor* slot) {
             // only key column of bloom filter will push down to storage engine
             if (is_key_column(slot->col_name())) {
                 filter_conjuncts_index.emplace_back(conj_idx);
-                _bloom_filters_push_down.emplace_back(
-                        slot->col_name(),
-                        (reinterpret_cast<BloomFilterPredicate*>(pred))->get_bloom_filter_func());
+                auto bloom_filter_func =
+                        (reinterpret_cast<BloomFilterPredicate*>(pred))->get_bloom_filter_func();
+                _bloom_filters_push_down.emplace_back(slot->col_name(), bloom_filter_func);
+                auto iter = _conjunctid_to_runtime_filter_ctxs.find(conj_idx);
+                if (iter != _conjunctid_to_runtime_filter_ctxs.end()) {
+                    _bloom_runtime_filters_push_down.emplace_back(iter->second->runtimefilter,
+                                                                  bloom_filter_func);
+                }
             }
         }
     }
@@ -1317,12 +1378,129 @@ Status VOlapScanNode::normalize_bloom_filter_predicate(SlotDescriptor* slot) {
     return Status::OK();
 }
 
+Status VOlapScanNode::_normalize_late_runtime_filter(
+        ExprContext* ctx, std::vector<TCondition>* filters,
+        std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>*
+                bloom_filters) {
+    Expr* pred = ctx->root();
+    if (pred->get_num_children() < 1 ||
+        Expr::type_without_cast(pred->get_child(0)) != TExprNodeType::SLOT_REF) {
+        return Status::OK();
+    }
+    std::vector<SlotId> slot_ids;
+    if (pred->get_child(0)->get_slot_ids(&slot_ids) != 1) {
+        return Status::OK();
+    }
+    SlotDescriptor* slot = nullptr;
+    for (auto slot_desc : _tuple_desc->slots()) {
+        if (slot_desc->id() == slot_ids[0]) {
+            slot = slot_desc;
+            break;
+        }
+    }
+    if (slot == nullptr || (pred->get_child(0)->type().type != slot->type().type &&
+                            !ignore_cast(slot, pred->get_child(0)))) {
+        return Status::OK();
+    }
+
+    if (TExprNodeType::BLOOM_PRED == pred->node_type()) {
+        // only key column of bloom filter will push down to storage engine
+        if (is_key_column(slot->col_name())) {
+            bloom_filters->emplace_back(
+                    slot->col_name(),
+                    (reinterpret_cast<BloomFilterPredicate*>(pred))->get_bloom_filter_func());
+        }
+        return Status::OK();
+    }
+
+    switch (slot->type().type) {
+    case TYPE_TINYINT:
+        return _normalize_late_runtime_filter<int8_t>(slot, ctx, filters);
+    case TYPE_SMALLINT:
+        return _normalize_late_runtime_filter<int16_t>(slot, ctx, filters);
+    case TYPE_INT:
+        return _normalize_late_runtime_filter<int32_t>(slot, ctx, filters);
+    case TYPE_BIGINT:
+        return _normalize_late_runtime_filter<int64_t>(slot, ctx, filters);
+    case TYPE_LARGEINT:
+        return _normalize_late_runtime_filter<__int128>(slot, ctx, filters);
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_HLL:
+    case TYPE_STRING:
+        return _normalize_late_runtime_filter<StringValue>(slot, ctx, filters);
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return _normalize_late_runtime_filter<DateTimeValue>(slot, ctx, filters);
+    case TYPE_DECIMALV2:
+        return _normalize_late_runtime_filter<DecimalV2Value>(slot, ctx, filters);
+    case TYPE_BOOLEAN:
+        return _normalize_late_runtime_filter<bool>(slot, ctx, filters);
+    default:
+        return Status::OK();
+    }
+}
+
+template <class T>
+Status VOlapScanNode::_normalize_late_runtime_filter(SlotDescriptor* slot, ExprContext* ctx,
+                                                     std::vector<TCondition>* filters) {
+    Expr* pred = ctx->root();
+    PrimitiveType type = slot->type().type;
+    ColumnValueRange<T> range(slot->col_name(), type);
+
+    if (TExprNodeType::IN_PRED == pred->node_type()) {
+        // 1. IN filter, slot in (v1, v2, ...)
+        auto in_pred = reinterpret_cast<InPredicate*>(pred);
+        if (in_pred->is_not_in() ||
+            in_pred->hybrid_set()->size() > _max_pushdown_conditions_per_column) {
+            return Status::OK();
+        }
+        auto temp_range = ColumnValueRange<T>::create_empty_column_value_range(type);
+        HybridSetBase::IteratorBase* iter = in_pred->hybrid_set()->begin();
+        for (; iter->has_next(); iter->next()) {
+            if (iter->get_value() == nullptr) {
+                continue;
+            }
+            RETURN_IF_ERROR(change_fixed_value_range(temp_range, type,
+                                                     const_cast<void*>(iter->get_value()),
+                                                     ColumnValueRange<T>::add_fixed_value_range));
+        }
+        range.intersection(temp_range);
+    } else if (TExprNodeType::BINARY_PRED == pred->node_type()) {
+        // 2. MinMax filter, slot >= min and slot <= max
+        SQLFilterOp op = to_olap_filter_type(pred->op(), false);
+        Expr* expr = pred->get_child(1);
+        if (op == FILTER_IN || op == FILTER_NOT_IN || !expr->is_constant()) {
+            return Status::OK();
+        }
+        void* value = ctx->get_value(expr, nullptr);
+        if (value == nullptr) {
+            return Status::OK();
+        }
+        if (type == TYPE_DATE) {
+            DateTimeValue date_value = *reinterpret_cast<DateTimeValue*>(value);
+            // the same as normalize_noneq_binary_predicate
+            if (date_value.check_loss_accuracy_cast_to_date() &&
+                (pred->op() == TExprOpcode::LT || pred->op() == TExprOpcode::GE)) {
+                ++date_value;
+            }
+            range.add_range(op, *reinterpret_cast<T*>(&date_value));
+        } else {
+            range.add_range(op, *reinterpret_cast<T*>(value));
+        }
+    } else {
+        return Status::OK();
+    }
+
+    range.to_olap_filter(*filters);
+    return Status::OK();
+}
+
 Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
     if (_scan_ranges.empty()) {
-        _transfer_done = true;
+        _eos = true;
         return Status::OK();
     }
-    _block_mem_tracker = MemTracker::create_virtual_tracker(-1, "VOlapScanNode:Block");
 
     // ranges constructed from scan keys
     std::vector<std::unique_ptr<OlapScanRange>> cond_ranges;
@@ -1352,9 +1530,21 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
             return Status::InternalError(ss.str());
         }
 
+        // Avoid too many scanners for small tablets, one scanner is used for every
+        // doris_scan_range_max_mb bytes of the tablet.
+        int size_based_scanners_per_tablet = 1;
+        if (config::doris_scan_range_max_mb > 0) {
+            size_based_scanners_per_tablet = (int)std::max<int64_t>(
+                    1, tablet->tablet_footprint() / ((int64_t)config::doris_scan_range_max_mb << 20));
+        }
+        int num_scanners = std::min(scanners_per_tablet, size_based_scanners_per_tablet);
+
         std::vector<std::unique_ptr<OlapScanRange>>* ranges = &cond_ranges;
         std::vector<std::unique_ptr<OlapScanRange>> split_ranges;
-        if (need_split && !tablet->all_beta()) {
+        // Beta rowsets are split on the short key indexes of the segments, which have to be
+        // loaded, so only split them if the tablet is scanned by more than one scanner.
+        // The split ranges never overlap, so it's ok for the tablets of all keys types.
+        if (need_split && (!tablet->all_beta() || num_scanners > 1)) {
             auto st = get_hints(tablet, *scan_range, config::doris_scan_range_row_count,
                                 _scan_keys.begin_include(), _scan_keys.end_include(), cond_ranges,
                                 &split_ranges, _runtime_profile.get());
@@ -1362,16 +1552,7 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
                 ranges = &split_ranges;
             }
         }
-        int size_based_scanners_per_tablet = 1;
-
-        if (config::doris_scan_range_max_mb > 0) {
-            size_based_scanners_per_tablet = std::max(
-                    1, (int)tablet->tablet_footprint() / config::doris_scan_range_max_mb << 20);
-        }
-
-        int ranges_per_scanner =
-                std::max(1, (int)ranges->size() /
-                                    std::min(scanners_per_tablet, size_based_scanners_per_tablet));
+        int ranges_per_scanner = std::max(1, (int)ranges->size() / num_scanners);
         int num_ranges = ranges->size();
         for (int i = 0; i < num_ranges;) {
             std::vector<OlapScanRange*> scanner_ranges;
@@ -1391,6 +1572,13 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
             RETURN_IF_ERROR(scanner->prepare(*scan_range, scanner_ranges, _olap_filter,
                                              _bloom_filters_push_down));
 
+            if (_scan_aggregation_node != nullptr) {
+                std::unique_ptr<AggregationNode> aggregator;
+                RETURN_IF_ERROR(_scan_aggregation_node->create_scan_aggregator(state, &aggregator));
+                scanner->set_aggregator(aggregator.get());
+                _scan_aggregators.push_back(std::move(aggregator));
+            }
+
             _volap_scanners.push_back(scanner);
             disk_set.insert(scanner->scan_disk());
         }
@@ -1398,14 +1586,17 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
     COUNTER_SET(_num_disks_accessed_counter, static_cast<int64_t>(disk_set.size()));
     COUNTER_SET(_num_scanners, static_cast<int64_t>(_volap_scanners.size()));
 
-    // init progress
-    std::stringstream ss;
-    ss << "ScanThread complete (node=" << id() << "):";
-    _progress = ProgressUpdater(ss.str(), _volap_scanners.size(), 1);
-
-    _transfer_thread.reset(new std::thread(&VOlapScanNode::transfer_thread, this, state));
+    if (_vconjunct_ctx_ptr) {
+        for (auto scanner : _volap_scanners) {
+            RETURN_IF_ERROR((*_vconjunct_ctx_ptr)->clone(state, scanner->vconjunct_ctx_ptr()));
+        }
+    }
 
-    return Status::OK();
+    _scanner_ctx.reset(new ScannerContext(state, this, _tuple_desc, _volap_scanners, _limit,
+                                          _max_scanner_queue_size_bytes));
+    RETURN_IF_ERROR(_scanner_ctx->init());
+    _scanner_ctx->reschedule();
+    return _scanner_ctx->status();
 }
 
 Status VOlapScanNode::close(RuntimeState* state) {
@@ -1414,37 +1605,25 @@ Status VOlapScanNode::close(RuntimeState* state) {
     }
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::CLOSE));
 
-    // change done status
-    {
-        std::unique_lock<std::mutex> l(_blocks_lock);
-        _transfer_done = true;
-    }
-    // notify all scanner thread
-    _block_consumed_cv.notify_all();
-    _block_added_cv.notify_all();
-    _scan_block_added_cv.notify_all();
-
-    // join transfer thread
-    if (_transfer_thread) {
-        _transfer_thread->join();
-    }
-
-    // clear some block in queue
-    // TODO: The presence of transfer_thread here may cause Block's memory alloc and be released not in a thread,
-    // which may lead to potential performance problems. we should rethink whether to delete the transfer thread
-    std::for_each(_materialized_blocks.begin(), _materialized_blocks.end(),
-                  std::default_delete<Block>());
-    _materialized_row_batches_bytes = 0;
-    std::for_each(_scan_blocks.begin(), _scan_blocks.end(), std::default_delete<Block>());
-    _scan_row_batches_bytes = 0;
-    std::for_each(_free_blocks.begin(), _free_blocks.end(), std::default_delete<Block>());
-    _block_mem_tracker->release(_buffered_bytes);
+    // stop the scanners and wait for the running ones
+    if (_scanner_ctx != nullptr) {
+        _scanner_ctx->clear_and_join();
+    }
 
     // OlapScanNode terminate by exception
     // so that initiative close the Scanner
     for (auto scanner : _volap_scanners) {
         scanner->close(state);
     }
+    for (auto& aggregator : _scan_aggregators) {
+        aggregator->close(state);
+    }
+
+    for (auto& [runtime_filter, bloom_filter_func] : _bloom_runtime_filters_push_down) {
+        runtime_filter->update_selectivity_to_profile(bloom_filter_func->sampled_rows(),
+                                                      bloom_filter_func->sampled_passed_rows(),
+                                                      bloom_filter_func->is_effective());
+    }
 
     for (auto& filter_desc : _runtime_filter_descs) {
         IRuntimeFilter* runtime_filter = nullptr;
@@ -1457,20 +1636,26 @@ Status VOlapScanNode::close(RuntimeState* state) {
     return ScanNode::close(state);
 }
 
+bool VOlapScanNode::can_read() {
+    // the scanners are started by the first get_next()
+    if (!_start || _eos || _scanner_ctx == nullptr) {
+        return true;
+    }
+    return _scanner_ctx->has_block_or_finished();
+}
+
 Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(mem_tracker());
 
     // check if Canceled.
     if (state->is_cancelled()) {
-        std::unique_lock<std::mutex> l(_blocks_lock);
-        _transfer_done = true;
-        std::lock_guard<SpinLock> guard(_status_mutex);
-        if (LIKELY(_status.ok())) {
-            _status = Status::Cancelled("Cancelled");
+        if (_scanner_ctx != nullptr) {
+            _scanner_ctx->set_status_on_error(Status::Cancelled("Cancelled"));
         }
-        return _status;
+        return Status::Cancelled("Cancelled");
     }
 
     // check if started.
@@ -1496,29 +1681,12 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     // wait for block from queue
     Block* materialized_block = nullptr;
     {
-        std::unique_lock<std::mutex> l(_blocks_lock);
         SCOPED_TIMER(_olap_wait_batch_queue_timer);
-        while (_materialized_blocks.empty() && !_transfer_done) {
-            if (state->is_cancelled()) {
-                _transfer_done = true;
-            }
-
-            // use wait_for, not wait, in case to capture the state->is_cancelled()
-            _block_added_cv.wait_for(l, std::chrono::seconds(1));
-        }
-
-        if (!_materialized_blocks.empty()) {
-            materialized_block = _materialized_blocks.back();
-            DCHECK(materialized_block != nullptr);
-            _materialized_blocks.pop_back();
-            _materialized_row_batches_bytes -= materialized_block->allocated_bytes();
-        }
+        RETURN_IF_ERROR(_scanner_ctx->get_block_from_queue(&materialized_block, eos));
     }
 
     // return block
     if (nullptr != materialized_block) {
-        // notify scanner
-        _block_consumed_cv.notify_one();
         // get scanner's block memory
         block->swap(*materialized_block);
         VLOG_ROW << "VOlapScanNode output rows: " << block->rows();
@@ -1526,120 +1694,16 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
 
         // reach scan node limit
         if (*eos) {
-            {
-                std::unique_lock<std::mutex> l(_blocks_lock);
-                _transfer_done = true;
-            }
-
-            _block_consumed_cv.notify_all();
-            *eos = true;
+            _scanner_ctx->set_should_stop();
             LOG(INFO) << "VOlapScanNode ReachedLimit.";
-        } else {
-            *eos = false;
-        }
-
-        {
-            // ReThink whether the SpinLock Better
-            std::lock_guard<std::mutex> l(_free_blocks_lock);
-            _free_blocks.emplace_back(materialized_block);
         }
+        _scanner_ctx->return_free_block(materialized_block);
         return Status::OK();
     }
 
     // all scanner done, change *eos to true
     *eos = true;
-    std::lock_guard<SpinLock> guard(_status_mutex);
-    return _status;
-}
-
-Block* VOlapScanNode::_alloc_block(bool& get_free_block) {
-    {
-        std::lock_guard<std::mutex> l(_free_blocks_lock);
-        if (!_free_blocks.empty()) {
-            auto block = _free_blocks.back();
-            _free_blocks.pop_back();
-            return block;
-        }
-    }
-
-    get_free_block = false;
-
-    auto block = new Block(_tuple_desc->slots(), _block_size);
-    _buffered_bytes += block->allocated_bytes();
-    return block;
-}
-
-int VOlapScanNode::_start_scanner_thread_task(RuntimeState* state, int block_per_scanner) {
-    std::list<VOlapScanner*> olap_scanners;
-    int assigned_thread_num = _running_thread;
-    size_t max_thread = config::doris_scanner_queue_size;
-    if (config::doris_scanner_row_num > state->batch_size()) {
-        max_thread /= config::doris_scanner_row_num / state->batch_size();
-        if (max_thread <= 0) max_thread = 1;
-    }
-    // copy to local
-    {
-        // How many thread can apply to this query
-        size_t thread_slot_num = 0;
-        {
-            if (_scan_row_batches_bytes < _max_scanner_queue_size_bytes / 2) {
-                std::lock_guard<std::mutex> l(_free_blocks_lock);
-                thread_slot_num = _free_blocks.size() / block_per_scanner;
-                thread_slot_num += (_free_blocks.size() % block_per_scanner != 0);
-                thread_slot_num = std::min(thread_slot_num, max_thread - assigned_thread_num);
-                if (thread_slot_num <= 0) {
-                    thread_slot_num = 1;
-                }
-            } else {
-                std::lock_guard<std::mutex> l(_scan_blocks_lock);
-                if (_scan_blocks.empty()) {
-                    // Just for notify if _scan_blocks is empty and no running thread
-                    if (assigned_thread_num == 0) {
-                        thread_slot_num = 1;
-                        // NOTE: if olap_scanners_ is empty, scanner_done_ should be true
-                    }
-                }
-            }
-        }
-
-        {
-            std::lock_guard<std::mutex> l(_volap_scanners_lock);
-            thread_slot_num = std::min(thread_slot_num, _volap_scanners.size());
-            for (int i = 0; i < thread_slot_num && !_volap_scanners.empty();) {
-                auto scanner = _volap_scanners.front();
-                _volap_scanners.pop_front();
-
-                if (scanner->need_to_close()) {
-                    scanner->close(state);
-                } else {
-                    olap_scanners.push_back(scanner);
-                    _running_thread++;
-                    assigned_thread_num++;
-                    i++;
-                }
-            }
-        }
-    }
-
-    // post volap scanners to thread-pool
-    PriorityThreadPool* thread_pool = state->exec_env()->scan_thread_pool();
-    auto iter = olap_scanners.begin();
-    while (iter != olap_scanners.end()) {
-        PriorityThreadPool::Task task;
-        task.work_function = std::bind(&VOlapScanNode::scanner_thread, this, *iter);
-        task.priority = _nice;
-        task.queue_id = state->exec_env()->store_path_to_index((*iter)->scan_disk());
-        (*iter)->start_wait_worker_timer();
-        COUNTER_UPDATE(_scanner_sched_counter, 1);
-        if (thread_pool->offer(task)) {
-            olap_scanners.erase(iter++);
-        } else {
-            LOG(FATAL) << "Failed to assign scanner task to thread pool!";
-        }
-        ++_total_assign_num;
-    }
-
-    return assigned_thread_num;
+    return Status::OK();
 }
 
 // PlanFragmentExecutor will call this method to set scan range
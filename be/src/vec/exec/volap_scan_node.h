@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "exec/olap_scan_node.h"
 #include "exprs/in_predicate.h"
 #include "exprs/runtime_filter.h"
@@ -30,11 +32,16 @@ class DescriptorTbl;
 class RowBatch;
 namespace vectorized {
 
+class AggregationNode;
+class ScannerContext;
+class ScannerScheduler;
 class VOlapScanner;
 
 class VOlapScanNode final : public ScanNode {
 public:
     VOlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VOlapScanNode() override;
+    friend class ScannerScheduler;
     friend class VOlapScanner;
 
     Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
@@ -47,10 +54,23 @@ public:
     Status get_next(RuntimeState* state, Block* block, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    // Whether get_next() returns without waiting for the scanners.
+    bool can_read();
+
     Status set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) override;
 
     void set_no_agg_finalize() { _need_agg_finalize = false; }
 
+    const TOlapScanNode& olap_scan_node() const { return _olap_scan_node; }
+
+    // Let the scanners return the column of `slot_id` as dictionary columns if possible, it is
+    // only used as the group by key of the parent aggregation node.
+    void set_dict_output_slot(SlotId slot_id) { _dict_output_slot_id = slot_id; }
+
+    // Let every scanner aggregate the blocks read by a copy of the parent aggregation node
+    // `node`, then the blocks returned are serialized the same as the spilled ones of `node`.
+    void set_scan_aggregation_node(AggregationNode* node) { _scan_aggregation_node = node; }
+
     Status get_hints(TabletSharedPtr table, const TPaloScanRange& scan_range, int block_row_count,
                      bool is_begin_include, bool is_end_include,
                      const std::vector<std::unique_ptr<OlapScanRange>>& scan_key_range,
@@ -73,14 +93,31 @@ private:
     template <class T>
     Status normalize_in_and_eq_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
 
+    template <class T>
+    Status _normalize_or_eq_predicate(SlotDescriptor* slot, Expr* pred, int conj_idx,
+                                      ColumnValueRange<T>* range, bool* pushed);
+
     template <class T>
     Status normalize_not_in_and_not_eq_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
 
     template <class T>
     Status normalize_noneq_binary_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
 
+    template <class T>
+    Status normalize_like_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
+
     Status normalize_bloom_filter_predicate(SlotDescriptor* slot);
 
+    // Convert the runtime filters arriving after the scan node is opened to the olap filters
+    // and bloom filters of the scanners, so the segments not read yet are pruned by indexes.
+    Status _normalize_late_runtime_filter(
+            ExprContext* ctx, std::vector<TCondition>* filters,
+            std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>*
+                    bloom_filters);
+    template <class T>
+    Status _normalize_late_runtime_filter(SlotDescriptor* slot, ExprContext* ctx,
+                                          std::vector<TCondition>* filters);
+
     template <typename T>
     static bool normalize_is_null_predicate(Expr* expr, SlotDescriptor* slot,
                                             const std::string& is_null_str,
@@ -94,13 +131,13 @@ private:
     std::pair<bool, void*> should_push_down_eq_predicate(SlotDescriptor* slot, Expr* pred,
                                                          int conj_idx, int child_idx);
 
-    void transfer_thread(RuntimeState* state);
+    // Runs a scanner in a thread of the scan thread pool, scheduled by ScannerScheduler.
     void scanner_thread(VOlapScanner* scanner);
     Status start_scan_thread(RuntimeState* state);
 
-    Status _add_blocks(std::vector<Block*>& block);
-    int _start_scanner_thread_task(RuntimeState* state, int block_per_scanner);
-    Block* _alloc_block(bool& get_free_block);
+    // The rows of the blocks the scanners return, so that a block takes about
+    // `scan_block_target_bytes` by the row width observed so far.
+    int _adaptive_block_rows() const;
 
     void _init_counter(RuntimeState* state);
     // OLAP_SCAN_NODE profile layering: OLAP_SCAN_NODE, OlapScanner, and SegmentIterator
@@ -141,57 +178,30 @@ private:
     // 2. std::pair.second :: shared_ptr of BloomFilterFuncBase
     std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>
             _bloom_filters_push_down;
+    // the runtime filters of the bloom filters pushed down, to report the selectivity
+    std::vector<std::pair<IRuntimeFilter*, std::shared_ptr<IBloomFilterFuncBase>>>
+            _bloom_runtime_filters_push_down;
+    // push down like predicates to inverted indexes of storage engine.
+    // 1. std::pair.first :: column name
+    // 2. std::pair.second :: like pattern
+    std::vector<std::pair<std::string, std::string>> _like_predicates_push_down;
 
     // Pool for storing allocated scanner objects.  We don't want to use the
     // runtime pool to ensure that the scanner objects are deleted before this
     // object is.
     ObjectPool _scanner_pool;
 
-    std::shared_ptr<std::thread> _transfer_thread;
-
-    // Keeps track of total splits and the number finished.
-    ProgressUpdater _progress;
-
-    // Lock and condition variables protecting _materialized_row_batches.  Row batches are
-    // produced asynchronously by the scanner threads and consumed by the main thread in
-    // GetNext.  Row batches must be processed by the main thread in the order they are
-    // queued to avoid freeing attached resources prematurely (row batches will never depend
-    // on resources attached to earlier batches in the queue).
-    // This lock cannot be taken together with any other locks except _lock.
-    std::mutex _row_batches_lock;
-    std::condition_variable _row_batch_added_cv;
-    std::condition_variable _row_batch_consumed_cv;
-
-    std::list<RowBatch*> _materialized_row_batches;
-    // to limit _materialized_row_batches_bytes < _max_scanner_queue_size_bytes / 2
-    std::atomic_size_t _materialized_row_batches_bytes = 0;
-
-    std::mutex _scan_batches_lock;
-    std::condition_variable _scan_batch_added_cv;
-    std::atomic_int _running_thread = 0;
-    std::condition_variable _scan_thread_exit_cv;
-
-    std::list<RowBatch*> _scan_row_batches;
-    // to limit _scan_row_batches_bytes < _max_scanner_queue_size_bytes / 2
-    std::atomic_size_t _scan_row_batches_bytes = 0;
-
-    std::list<VOlapScanner*> _olap_scanners;
+    // all the scanners of the node
+    std::list<VOlapScanner*> _volap_scanners;
+    // The scanners, the blocks queue and the free blocks shared with the scanner threads,
+    // created when the scan starts.
+    std::unique_ptr<ScannerContext> _scanner_ctx;
 
-    int _max_materialized_row_batches;
-    // to limit _materialized_row_batches_bytes and _scan_row_batches_bytes
+    // to limit the bytes of the blocks queue of _scanner_ctx
     size_t _max_scanner_queue_size_bytes;
     bool _start;
-    // Used in Scan thread to ensure thread-safe
-    std::atomic_bool _scanner_done;
-    std::atomic_bool _transfer_done;
     size_t _direct_conjunct_size;
 
-    int _total_assign_num;
-    int _nice;
-
-    // protect _status, for many thread may change _status
-    SpinLock _status_mutex;
-    Status _status;
     RuntimeState* _runtime_state;
 
     RuntimeProfile::Counter* _scan_timer;
@@ -202,12 +212,22 @@ private:
     RuntimeProfile::Counter* _scanner_sched_counter = nullptr;
     TResourceInfo* _resource_info;
 
-    int64_t _buffered_bytes;
     // Count the memory consumption of Rowset Reader and Tablet Reader in OlapScanner.
     std::shared_ptr<MemTracker> _scanner_mem_tracker;
     EvalConjunctsFn _eval_conjuncts_fn;
 
     bool _need_agg_finalize = true;
+    SlotId _dict_output_slot_id = -1;
+
+    AggregationNode* _scan_aggregation_node = nullptr;
+    // the aggregators of the scanners, closed after the scanners
+    std::vector<std::unique_ptr<AggregationNode>> _scan_aggregators;
+    RuntimeProfile::Counter* _scan_aggregation_timer = nullptr;
+
+    // the bytes and rows of the blocks read by all scanners
+    std::atomic<int64_t> _observed_block_bytes {0};
+    std::atomic<int64_t> _observed_block_rows {0};
+    RuntimeProfile::Counter* _adaptive_block_rows_counter = nullptr;
 
     // the max num of scan keys of this scan request.
     // it will set as BE's config `doris_max_scan_key_num`,
@@ -241,6 +261,10 @@ private:
     RuntimeProfile::Counter* _raw_rows_counter = nullptr;
 
     RuntimeProfile::Counter* _rows_vec_cond_counter = nullptr;
+    RuntimeProfile::Counter* _rows_pred_column_skipped_counter = nullptr;
+    RuntimeProfile::Counter* _rows_read_by_metadata_counter = nullptr;
+    RuntimeProfile::Counter* _rows_counted_by_index_counter = nullptr;
+    RuntimeProfile::Counter* _rows_read_by_row_store_counter = nullptr;
     RuntimeProfile::Counter* _vec_cond_timer = nullptr;
     RuntimeProfile::Counter* _short_cond_timer = nullptr;
     RuntimeProfile::Counter* _first_read_timer = nullptr;
@@ -281,7 +305,6 @@ private:
     // total number of segment related to this scan node
     RuntimeProfile::Counter* _total_segment_counter = nullptr;
 
-    RuntimeProfile::Counter* _scanner_wait_batch_timer = nullptr;
     RuntimeProfile::Counter* _scanner_wait_worker_timer = nullptr;
 
     RuntimeProfile::Counter* _olap_wait_batch_queue_timer = nullptr;
@@ -289,26 +312,6 @@ private:
     // for debugging or profiling, record any info as you want
     RuntimeProfile::Counter* _general_debug_timer[GENERAL_DEBUG_COUNT] = {};
 
-    std::vector<Block*> _scan_blocks;
-    std::vector<Block*> _materialized_blocks;
-    std::mutex _blocks_lock;
-    std::condition_variable _block_added_cv;
-    std::condition_variable _block_consumed_cv;
-
-    std::mutex _scan_blocks_lock;
-    std::condition_variable _scan_block_added_cv;
-
-    std::vector<Block*> _free_blocks;
-    std::mutex _free_blocks_lock;
-
-    std::list<VOlapScanner*> _volap_scanners;
-    std::mutex _volap_scanners_lock;
-
-    std::shared_ptr<MemTracker> _block_mem_tracker;
-
-    int _max_materialized_blocks;
-
-    size_t _block_size = 0;
 };
 } // namespace vectorized
 } // namespace doris
@@ -19,8 +19,10 @@
 
 #include <memory>
 
+#include "io/cache/file_block_cache.h"
 #include "olap/storage_engine.h"
 #include "runtime/runtime_state.h"
+#include "util/query_trace.h"
 #include "vec/core/block.h"
 #include "vec/exec/volap_scan_node.h"
 #include "vec/exprs/vexpr_context.h"
@@ -53,6 +55,7 @@ Status VOlapScanner::prepare(
                 bloom_filters) {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     set_tablet_reader();
+    _runtime_filter_marks.resize(_parent->runtime_filter_descs().size(), false);
     // set limit to reduce end of rowset and segment mem use
     _tablet_reader->set_batch_size(
             _parent->limit() == -1
@@ -112,12 +115,20 @@ Status VOlapScanner::prepare(
 Status VOlapScanner::open() {
     SCOPED_TIMER(_parent->_reader_init_timer);
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    io::FileBlockCache::ScopedBypass bypass_file_cache(_runtime_state->disable_file_cache());
 
     if (_conjunct_ctxs.size() > _parent->_direct_conjunct_size) {
         _use_pushdown_conjuncts = true;
     }
 
-    _runtime_filter_marks.resize(_parent->runtime_filter_descs().size(), false);
+    // the scanners are opened in the scanner threads, those opened later read the blocks
+    // of wide rows in less rows by the row width observed by the earlier ones
+    int block_rows = _parent->_adaptive_block_rows();
+    if (block_rows < _runtime_state->batch_size()) {
+        _tablet_reader->set_batch_size(
+                _parent->limit() == -1 ? block_rows
+                                       : std::min<int64_t>(block_rows, _parent->limit()));
+    }
 
     auto res = _tablet_reader->init(_tablet_reader_params);
     if (!res.ok()) {
@@ -130,6 +141,21 @@ Status VOlapScanner::open() {
     return Status::OK();
 }
 
+void VOlapScanner::append_runtime_filters(
+        const std::vector<TCondition>& filters,
+        const std::vector<std::pair<string, std::shared_ptr<IBloomFilterFuncBase>>>&
+                bloom_filters) {
+    if (!_is_open) {
+        // the segments are also pruned by their zone maps when the reader is initialized
+        _tablet_reader_params.conditions.insert(_tablet_reader_params.conditions.end(),
+                                                filters.begin(), filters.end());
+        _tablet_reader_params.bloom_filters.insert(_tablet_reader_params.bloom_filters.end(),
+                                                   bloom_filters.begin(), bloom_filters.end());
+    } else {
+        _tablet_reader->append_runtime_predicates(filters, bloom_filters);
+    }
+}
+
 // it will be called under tablet read lock because capture rs readers need
 Status VOlapScanner::_init_tablet_reader_params(
         const std::vector<OlapScanRange*>& key_ranges, const std::vector<TCondition>& filters,
@@ -149,6 +175,15 @@ Status VOlapScanner::_init_tablet_reader_params(
     std::copy(bloom_filters.cbegin(), bloom_filters.cend(),
               std::inserter(_tablet_reader_params.bloom_filters,
                             _tablet_reader_params.bloom_filters.begin()));
+    _tablet_reader_params.like_predicates = _parent->_like_predicates_push_down;
+    for (auto slot : _tuple_desc->slots()) {
+        if (slot->id() == _parent->_dict_output_slot_id) {
+            int32_t index = _tablet->field_index(slot->col_name());
+            if (index >= 0) {
+                _tablet_reader_params.dict_output_columns.insert(index);
+            }
+        }
+    }
 
     // Range
     for (auto key_range : key_ranges) {
@@ -216,8 +251,19 @@ Status VOlapScanner::_init_tablet_reader_params(
     // to avoid the unnecessary SerDe and improve query performance
     _tablet_reader_params.need_agg_finalize = _need_agg_finalize;
 
+    // the rows of duplicate key tablets are returned as they are, so that the aggregation
+    // over the scan can be answered by the metadata or the indexes of the segments, unless
+    // some conjuncts are not pushed down and have to be evaluated on the rows read
+    if (_parent->_olap_scan_node.__isset.push_down_agg_type_opt &&
+        _tablet->keys_type() == KeysType::DUP_KEYS && _tablet_reader_params.direct_mode &&
+        _parent->_vconjunct_ctx_ptr == nullptr) {
+        _tablet_reader_params.push_down_agg_type_opt =
+                _parent->_olap_scan_node.push_down_agg_type_opt;
+    }
+
     if (!config::disable_storage_page_cache) {
         _tablet_reader_params.use_page_cache = true;
+        _tablet_reader_params.fill_page_cache = _runtime_state->fill_storage_page_cache();
     }
 
     return Status::OK();
@@ -268,6 +314,8 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
     // only empty block should be here
     DCHECK(block->rows() == 0);
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
+    SCOPED_QUERY_TRACE("scan", "get_block");
+    io::FileBlockCache::ScopedBypass bypass_file_cache(state->disable_file_cache());
 
     int64_t raw_rows_threshold = raw_rows_read() + config::doris_scanner_row_num;
     int64_t raw_bytes_threshold = config::doris_scanner_row_bytes;
@@ -293,6 +341,13 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
             }
             _num_rows_read += block->rows();
             _update_realtime_counter();
+            if (_vconjunct_ctx != nullptr && !_tablet_reader_params.dict_output_columns.empty()) {
+                // the conjuncts are evaluated on the values
+                for (int i = 0; i < block->columns(); ++i) {
+                    auto& column = block->get_by_position(i).column;
+                    column = column->convert_to_string_column_if_dictionary();
+                }
+            }
             RETURN_IF_ERROR(
                     VExprContext::filter_block(_vconjunct_ctx, block, _tuple_desc->slots().size()));
         } while (block->rows() == 0 && !(*eof) && raw_rows_read() < raw_rows_threshold &&
@@ -303,6 +358,16 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
     // But checking raw_bytes_threshold is still added here for consistency with raw_rows_threshold
     // and olap_scanner.cpp.
 
+    // a scanner never returns more rows than the limit of the scan node
+    if (_parent->limit() != -1) {
+        int64_t rows_left = _parent->limit() - _num_rows_returned;
+        if (block->rows() >= rows_left) {
+            block->set_num_rows(rows_left);
+            *eof = true;
+        }
+        _num_rows_returned += block->rows();
+    }
+
     return Status::OK();
 }
 
@@ -369,6 +434,10 @@ void VOlapScanner::update_counter() {
     COUNTER_UPDATE(_parent->_lazy_read_timer, stats.lazy_read_ns);
     COUNTER_UPDATE(_parent->_output_col_timer, stats.output_col_ns);
     COUNTER_UPDATE(_parent->_rows_vec_cond_counter, stats.rows_vec_cond_filtered);
+    COUNTER_UPDATE(_parent->_rows_pred_column_skipped_counter, stats.rows_pred_column_skipped);
+    COUNTER_UPDATE(_parent->_rows_read_by_metadata_counter, stats.rows_read_by_metadata);
+    COUNTER_UPDATE(_parent->_rows_counted_by_index_counter, stats.rows_counted_by_index);
+    COUNTER_UPDATE(_parent->_rows_read_by_row_store_counter, stats.rows_read_by_row_store);
 
     COUNTER_UPDATE(_parent->_stats_filtered_counter, stats.rows_stats_filtered);
     COUNTER_UPDATE(_parent->_bf_filtered_counter, stats.rows_bf_filtered);
@@ -398,9 +467,7 @@ void VOlapScanner::update_counter() {
     DorisMetrics::instance()->query_scan_bytes->increment(_compressed_bytes_read);
     DorisMetrics::instance()->query_scan_rows->increment(_raw_rows_read);
 
-    _tablet->query_scan_bytes->increment(_compressed_bytes_read);
-    _tablet->query_scan_rows->increment(_raw_rows_read);
-    _tablet->query_scan_count->increment(1);
+    _tablet->record_query_scan(_compressed_bytes_read, _raw_rows_read, stats);
 
     _has_update_counter = true;
 }
@@ -31,6 +31,7 @@ class Field;
 class RowBatch;
 
 namespace vectorized {
+class AggregationNode;
 class VOlapScanNode;
 
 class VOlapScanner {
@@ -47,6 +48,14 @@ public:
 
     Status open();
 
+    // Apply the runtime filters arriving after the scanner is created. The filters are
+    // applied by the tablet reader if this scanner is not opened yet, or else by the
+    // segments not read yet.
+    void append_runtime_filters(
+            const std::vector<TCondition>& filters,
+            const std::vector<std::pair<std::string, std::shared_ptr<IBloomFilterFuncBase>>>&
+                    bloom_filters);
+
     Status get_block(RuntimeState* state, vectorized::Block* block, bool* eof);
 
     Status close(RuntimeState* state);
@@ -93,6 +102,10 @@ public:
 
     const std::shared_ptr<MemTracker>& mem_tracker() const { return _mem_tracker; }
 
+    // The blocks read are aggregated by `aggregator` before returned if it is set.
+    void set_aggregator(AggregationNode* aggregator) { _aggregator = aggregator; }
+    AggregationNode* aggregator() const { return _aggregator; }
+
 private:
     Status _init_tablet_reader_params(
             const std::vector<OlapScanRange*>& key_ranges, const std::vector<TCondition>& filters,
@@ -136,6 +149,8 @@ private:
     // time costed and row returned statistics
     int64_t _num_rows_read = 0;
     int64_t _raw_rows_read = 0;
+    // rows returned after filtered by the conjuncts
+    int64_t _num_rows_returned = 0;
     int64_t _compressed_bytes_read = 0;
 
     // number rows filtered by pushed condition
@@ -149,6 +164,8 @@ private:
 
     VExprContext* _vconjunct_ctx = nullptr;
     bool _need_to_close = false;
+
+    AggregationNode* _aggregator = nullptr;
 };
 
 } // namespace vectorized
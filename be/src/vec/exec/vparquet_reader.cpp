@@ -0,0 +1,543 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vparquet_reader.h"
+
+#include <arrow/io/caching.h>
+#include <arrow/io/interfaces.h>
+
+#include <map>
+
+#include "common/logging.h"
+#include "exec/arrow/parquet_reader.h"
+#include "exec/file_statistics_filter.h"
+#include "runtime/descriptors.h"
+#include "runtime/types.h"
+#include "util/binary_cast.hpp"
+#include "util/timezone_utils.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+// DECIMALV2, which the decimal columns are converted to
+static constexpr int DECIMAL_SCALE = 9;
+static constexpr size_t MAX_DECIMAL_BYTES = 16;
+
+static Int128 decode_big_endian_decimal(const uint8_t* bytes, int32_t len) {
+    // sign extend
+    unsigned __int128 value = len > 0 && static_cast<int8_t>(bytes[0]) < 0 ? ~0 : 0;
+    for (int32_t i = 0; i < len; ++i) {
+        value = (value << 8) | bytes[i];
+    }
+    return static_cast<Int128>(value);
+}
+
+static Decimal128 to_decimalv2(Int128 unscaled, int scale) {
+    Decimal128 value(unscaled);
+    if (scale != DECIMAL_SCALE) {
+        value = convert_decimals<DataTypeDecimal<Decimal128>, DataTypeDecimal<Decimal128>>(
+                value, scale, DECIMAL_SCALE);
+    }
+    return value;
+}
+
+VParquetReader::VParquetReader(FileReader* file_reader, int32_t num_of_columns_from_file,
+                               const std::string& timezone)
+        : _arrow_file(new ArrowFile(file_reader)),
+          _num_of_columns_from_file(num_of_columns_from_file),
+          _timezone(timezone) {}
+
+VParquetReader::~VParquetReader() {
+    close();
+}
+
+void VParquetReader::close() {
+    _columns.clear();
+    if (_file_reader != nullptr) {
+        _file_reader->Close();
+        _file_reader.reset();
+    }
+    arrow::Status st = _arrow_file->Close();
+    if (!st.ok()) {
+        LOG(WARNING) << "close file error: " << st.ToString();
+    }
+}
+
+Status VParquetReader::init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                                   const FileStatisticsFilter* statistics_filter) {
+    DCHECK(_num_of_columns_from_file <= tuple_slot_descs.size());
+    if (!TimezoneUtils::find_cctz_time_zone(_timezone, _ctz)) {
+        return Status::InternalError("Invalid time zone: " + _timezone);
+    }
+    try {
+        _file_reader = parquet::ParquetFileReader::Open(_arrow_file);
+        _file_metadata = _file_reader->metadata();
+        _total_groups = _file_metadata->num_row_groups();
+        if (_total_groups == 0) {
+            return Status::EndOfFile("Empty Parquet File");
+        }
+
+        // -1 for the nested columns
+        std::map<std::string, int> map_column;
+        const auto* schema = _file_metadata->schema();
+        for (int i = 0; i < _file_metadata->num_columns(); ++i) {
+            const auto* descr = schema->Column(i);
+            auto path = descr->path()->ToDotVector();
+            if (path.size() > 1 || descr->max_repetition_level() > 0) {
+                map_column.emplace(path[0], -1);
+            } else {
+                map_column.emplace(descr->name(), i);
+            }
+        }
+
+        _columns.resize(_num_of_columns_from_file);
+        for (int i = 0; i < _num_of_columns_from_file; ++i) {
+            auto* slot_desc = tuple_slot_descs[i];
+            auto iter = map_column.find(slot_desc->col_name());
+            if (iter == map_column.end()) {
+                std::stringstream str_error;
+                str_error << "Invalid Column Name:" << slot_desc->col_name();
+                LOG(WARNING) << str_error.str();
+                return Status::InvalidArgument(str_error.str());
+            }
+            if (iter->second < 0) {
+                return Status::NotSupported("Nested parquet column is not supported: " +
+                                            slot_desc->col_name());
+            }
+            RETURN_IF_ERROR(_init_column(iter->second, &_columns[i]));
+            _column_indices.push_back(iter->second);
+        }
+
+        if (statistics_filter != nullptr && !statistics_filter->empty()) {
+            _statistics_filter = statistics_filter;
+        }
+        return Status::OK();
+    } catch (parquet::ParquetException& e) {
+        std::stringstream str_error;
+        str_error << "Init parquet reader fail. " << e.what();
+        LOG(WARNING) << str_error.str();
+        return Status::InternalError(str_error.str());
+    }
+}
+
+Status VParquetReader::_init_column(int column_index, ParquetColumn* column) {
+    const auto* descr = _file_metadata->schema()->Column(column_index);
+    column->column_index = column_index;
+    column->descr = descr;
+    const auto& logical_type = descr->logical_type();
+    PrimitiveType type = INVALID_TYPE;
+    if (logical_type->is_decimal()) {
+        column->decimal_scale = descr->type_scale();
+        type = TYPE_DECIMALV2;
+    }
+    switch (descr->physical_type()) {
+    case parquet::Type::BOOLEAN:
+        column->kind = ColumnKind::BOOLEAN;
+        type = TYPE_BOOLEAN;
+        break;
+    case parquet::Type::INT32:
+        if (logical_type->is_decimal()) {
+            column->kind = ColumnKind::INT32_DECIMAL;
+        } else if (logical_type->is_date()) {
+            column->kind = ColumnKind::DATE;
+            type = TYPE_DATE;
+        } else if (logical_type->is_int()) {
+            const auto& int_type = static_cast<const parquet::IntLogicalType&>(*logical_type);
+            column->kind = int_type.is_signed() ? ColumnKind::INT32 : ColumnKind::UINT32;
+            type = int_type.is_signed() ? TYPE_INT : TYPE_BIGINT;
+        } else if (logical_type->is_none()) {
+            column->kind = ColumnKind::INT32;
+            type = TYPE_INT;
+        }
+        break;
+    case parquet::Type::INT64:
+        if (logical_type->is_decimal()) {
+            column->kind = ColumnKind::INT64_DECIMAL;
+        } else if (logical_type->is_timestamp()) {
+            const auto& ts_type = static_cast<const parquet::TimestampLogicalType&>(*logical_type);
+            switch (ts_type.time_unit()) {
+            case parquet::LogicalType::TimeUnit::MILLIS:
+                column->time_unit_divisor = 1000L;
+                break;
+            case parquet::LogicalType::TimeUnit::MICROS:
+                column->time_unit_divisor = 1000000L;
+                break;
+            case parquet::LogicalType::TimeUnit::NANOS:
+                column->time_unit_divisor = 1000000000L;
+                break;
+            default:
+                return Status::NotSupported("Unknown time unit of parquet column " +
+                                            descr->name());
+            }
+            column->kind = ColumnKind::INT64_TIMESTAMP;
+            type = TYPE_DATETIME;
+        } else if (logical_type->is_none() ||
+                   (logical_type->is_int() &&
+                    static_cast<const parquet::IntLogicalType&>(*logical_type).is_signed())) {
+            column->kind = ColumnKind::INT64;
+            type = TYPE_BIGINT;
+        }
+        break;
+    case parquet::Type::INT96:
+        column->kind = ColumnKind::INT96_TIMESTAMP;
+        type = TYPE_DATETIME;
+        break;
+    case parquet::Type::FLOAT:
+        column->kind = ColumnKind::FLOAT;
+        type = TYPE_FLOAT;
+        break;
+    case parquet::Type::DOUBLE:
+        column->kind = ColumnKind::DOUBLE;
+        type = TYPE_DOUBLE;
+        break;
+    case parquet::Type::BYTE_ARRAY:
+        column->kind =
+                logical_type->is_decimal() ? ColumnKind::BINARY_DECIMAL : ColumnKind::BINARY;
+        if (!logical_type->is_decimal()) {
+            type = TYPE_VARCHAR;
+        }
+        break;
+    case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+        if (logical_type->is_decimal()) {
+            if (descr->type_length() > MAX_DECIMAL_BYTES) {
+                type = INVALID_TYPE;
+            }
+            column->kind = ColumnKind::FIXED_DECIMAL;
+        } else {
+            column->kind = ColumnKind::FIXED_BINARY;
+            type = TYPE_VARCHAR;
+        }
+        break;
+    default:
+        type = INVALID_TYPE;
+        break;
+    }
+    if (type == INVALID_TYPE) {
+        return Status::NotSupported(fmt::format("Not support parquet column {} of type {}",
+                                                descr->name(), descr->ToString()));
+    }
+    column->type = DataTypeFactory::instance().create_data_type(TypeDescriptor(type), true);
+    return Status::OK();
+}
+
+Status VParquetReader::_next_row_group(bool* eof) {
+    while (++_current_group < _total_groups) {
+        if (_statistics_filter != nullptr &&
+            filter_parquet_row_group(*_statistics_filter, *_file_metadata->RowGroup(_current_group),
+                                     _column_indices)) {
+            ++_filtered_row_groups;
+            continue;
+        }
+        // coalesce the reads of the column chunks, like ArrowReaderProperties::pre_buffer
+        _file_reader->PreBuffer({_current_group}, _column_indices, ::arrow::io::IOContext(),
+                                ::arrow::io::CacheOptions::Defaults());
+        auto row_group_reader = _file_reader->RowGroup(_current_group);
+        for (auto& column : _columns) {
+            column.reader = row_group_reader->Column(column.column_index);
+        }
+        _rows_of_group = row_group_reader->metadata()->num_rows();
+        _read_rows_of_group = 0;
+        if (_rows_of_group > 0) {
+            return Status::OK();
+        }
+    }
+    for (auto& column : _columns) {
+        column.reader.reset();
+    }
+    *eof = true;
+    return Status::OK();
+}
+
+Status VParquetReader::next_batch(size_t max_rows, size_t* rows, bool* eof) {
+    *rows = 0;
+    *eof = false;
+    try {
+        if (_current_group >= _total_groups) {
+            *eof = true;
+            return Status::OK();
+        }
+        if (_current_group < 0 || _read_rows_of_group >= _rows_of_group) {
+            RETURN_IF_ERROR(_next_row_group(eof));
+            if (*eof) {
+                return Status::OK();
+            }
+        }
+        _batch_rows = std::min<int64_t>(max_rows, _rows_of_group - _read_rows_of_group);
+        _read_rows_of_group += _batch_rows;
+        *rows = _batch_rows;
+        return Status::OK();
+    } catch (parquet::ParquetException& e) {
+        std::stringstream str_error;
+        str_error << e.what() << " RowGroup:" << _current_group;
+        LOG(WARNING) << str_error.str();
+        return Status::InternalError(str_error.str());
+    }
+}
+
+void VParquetReader::_fill_null_map(const ParquetColumn& column, int64_t levels_read,
+                                    UInt8* null_map) {
+    int16_t max_def_level = column.descr->max_definition_level();
+    if (max_def_level == 0) {
+        memset(null_map, 0, levels_read);
+        return;
+    }
+    for (int64_t i = 0; i < levels_read; ++i) {
+        null_map[i] = _def_levels[i] < max_def_level;
+    }
+}
+
+template <typename DType, typename CppType>
+Status VParquetReader::_read_fixed(ParquetColumn& column, ColumnNullable* dst) {
+    using T = typename DType::c_type;
+    static_assert(sizeof(T) == sizeof(CppType));
+    auto* reader = static_cast<parquet::TypedColumnReader<DType>*>(column.reader.get());
+    auto& data = assert_cast<ColumnVector<CppType>&>(dst->get_nested_column()).get_data();
+    auto& null_map = dst->get_null_map_data();
+    size_t start = data.size();
+    data.resize(start + _batch_rows);
+    null_map.resize(start + _batch_rows);
+
+    int64_t read = 0;
+    while (read < _batch_rows) {
+        T* values = reinterpret_cast<T*>(data.data() + start + read);
+        UInt8* nulls = null_map.data() + start + read;
+        int64_t values_read = 0;
+        int64_t levels_read = reader->ReadBatch(_batch_rows - read, _def_levels.data(), nullptr,
+                                                values, &values_read);
+        if (levels_read <= 0) {
+            return Status::Corruption("Unexpected end of parquet column " +
+                                      column.descr->name());
+        }
+        _fill_null_map(column, levels_read, nulls);
+        if (values_read < levels_read) {
+            // the values are dense, move them to the positions of their rows backward
+            int64_t value_idx = values_read;
+            for (int64_t i = levels_read - 1; i >= 0; --i) {
+                values[i] = nulls[i] ? T() : values[--value_idx];
+            }
+        }
+        read += levels_read;
+    }
+    return Status::OK();
+}
+
+template <typename DType, typename Convert>
+Status VParquetReader::_read_converted(ParquetColumn& column, ColumnNullable* dst,
+                                       Convert&& convert) {
+    using T = typename DType::c_type;
+    auto* reader = static_cast<parquet::TypedColumnReader<DType>*>(column.reader.get());
+    auto& nested = dst->get_nested_column();
+    auto& null_map = dst->get_null_map_data();
+    std::vector<T> values(_batch_rows);
+
+    int64_t read = 0;
+    while (read < _batch_rows) {
+        int64_t values_read = 0;
+        int64_t levels_read = reader->ReadBatch(_batch_rows - read, _def_levels.data(), nullptr,
+                                                values.data(), &values_read);
+        if (levels_read <= 0) {
+            return Status::Corruption("Unexpected end of parquet column " +
+                                      column.descr->name());
+        }
+        size_t start = null_map.size();
+        null_map.resize(start + levels_read);
+        UInt8* nulls = null_map.data() + start;
+        _fill_null_map(column, levels_read, nulls);
+        int64_t value_idx = 0;
+        for (int64_t i = 0; i < levels_read; ++i) {
+            if (nulls[i]) {
+                nested.insert_default();
+            } else {
+                convert(values[value_idx++]);
+            }
+        }
+        read += levels_read;
+    }
+    return Status::OK();
+}
+
+Int64 VParquetReader::_to_datetime(int64_t seconds, bool is_date) {
+    VecDateTimeValue value;
+    value.from_unixtime(seconds, _ctz);
+    if (is_date) {
+        value.cast_to_date();
+    }
+    return binary_cast<VecDateTimeValue, Int64>(value);
+}
+
+Status VParquetReader::read_column(int position, IColumn* column) {
+    auto& parquet_column = _columns[position];
+    auto* dst = assert_cast<ColumnNullable*>(column);
+    _def_levels.resize(_batch_rows);
+    try {
+        switch (parquet_column.kind) {
+        case ColumnKind::BOOLEAN:
+            return _read_fixed<parquet::BooleanType, UInt8>(parquet_column, dst);
+        case ColumnKind::INT32:
+            return _read_fixed<parquet::Int32Type, Int32>(parquet_column, dst);
+        case ColumnKind::INT64:
+            return _read_fixed<parquet::Int64Type, Int64>(parquet_column, dst);
+        case ColumnKind::FLOAT:
+            return _read_fixed<parquet::FloatType, Float32>(parquet_column, dst);
+        case ColumnKind::DOUBLE:
+            return _read_fixed<parquet::DoubleType, Float64>(parquet_column, dst);
+        case ColumnKind::UINT32: {
+            auto& data = assert_cast<ColumnInt64&>(dst->get_nested_column()).get_data();
+            return _read_converted<parquet::Int32Type>(parquet_column, dst, [&](int32_t value) {
+                data.push_back(static_cast<uint32_t>(value));
+            });
+        }
+        case ColumnKind::DATE: {
+            auto& data = assert_cast<ColumnInt64&>(dst->get_nested_column()).get_data();
+            return _read_converted<parquet::Int32Type>(parquet_column, dst, [&](int32_t value) {
+                data.push_back(_to_datetime(static_cast<int64_t>(value) * 24 * 60 * 60, true));
+            });
+        }
+        case ColumnKind::INT64_TIMESTAMP: {
+            auto& data = assert_cast<ColumnInt64&>(dst->get_nested_column()).get_data();
+            int64_t divisor = parquet_column.time_unit_divisor;
+            return _read_converted<parquet::Int64Type>(parquet_column, dst, [&](int64_t value) {
+                data.push_back(_to_datetime(value / divisor, false));
+            });
+        }
+        case ColumnKind::INT96_TIMESTAMP: {
+            auto& data = assert_cast<ColumnInt64&>(dst->get_nested_column()).get_data();
+            return _read_converted<parquet::Int96Type>(
+                    parquet_column, dst, [&](const parquet::Int96& value) {
+                        data.push_back(_to_datetime(
+                                parquet::Int96GetNanoSeconds(value) / 1000000000L, false));
+                    });
+        }
+        case ColumnKind::INT32_DECIMAL: {
+            auto& data = assert_cast<ColumnDecimal<Decimal128>&>(dst->get_nested_column())
+                                 .get_data();
+            int scale = parquet_column.decimal_scale;
+            return _read_converted<parquet::Int32Type>(parquet_column, dst, [&](int32_t value) {
+                data.push_back(to_decimalv2(value, scale));
+            });
+        }
+        case ColumnKind::INT64_DECIMAL: {
+            auto& data = assert_cast<ColumnDecimal<Decimal128>&>(dst->get_nested_column())
+                                 .get_data();
+            int scale = parquet_column.decimal_scale;
+            return _read_converted<parquet::Int64Type>(parquet_column, dst, [&](int64_t value) {
+                data.push_back(to_decimalv2(value, scale));
+            });
+        }
+        case ColumnKind::BINARY_DECIMAL: {
+            auto& data = assert_cast<ColumnDecimal<Decimal128>&>(dst->get_nested_column())
+                                 .get_data();
+            int scale = parquet_column.decimal_scale;
+            bool overflow = false;
+            RETURN_IF_ERROR(_read_converted<parquet::ByteArrayType>(
+                    parquet_column, dst, [&](const parquet::ByteArray& value) {
+                        overflow |= value.len > MAX_DECIMAL_BYTES;
+                        data.push_back(to_decimalv2(
+                                decode_big_endian_decimal(value.ptr, value.len), scale));
+                    }));
+            if (overflow) {
+                return Status::InternalError("Decimal value of parquet column " +
+                                             parquet_column.descr->name() + " is out of range");
+            }
+            return Status::OK();
+        }
+        case ColumnKind::FIXED_DECIMAL: {
+            auto& data = assert_cast<ColumnDecimal<Decimal128>&>(dst->get_nested_column())
+                                 .get_data();
+            int scale = parquet_column.decimal_scale;
+            int32_t width = parquet_column.descr->type_length();
+            return _read_converted<parquet::FLBAType>(
+                    parquet_column, dst, [&](const parquet::FixedLenByteArray& value) {
+                        data.push_back(
+                                to_decimalv2(decode_big_endian_decimal(value.ptr, width), scale));
+                    });
+        }
+        case ColumnKind::BINARY: {
+            auto& nested = assert_cast<ColumnString&>(dst->get_nested_column());
+            return _read_converted<parquet::ByteArrayType>(
+                    parquet_column, dst, [&](const parquet::ByteArray& value) {
+                        nested.insert_data(reinterpret_cast<const char*>(value.ptr), value.len);
+                    });
+        }
+        case ColumnKind::FIXED_BINARY: {
+            auto& nested = assert_cast<ColumnString&>(dst->get_nested_column());
+            int32_t width = parquet_column.descr->type_length();
+            return _read_converted<parquet::FLBAType>(
+                    parquet_column, dst, [&](const parquet::FixedLenByteArray& value) {
+                        nested.insert_data(reinterpret_cast<const char*>(value.ptr), width);
+                    });
+        }
+        }
+    } catch (parquet::ParquetException& e) {
+        std::stringstream str_error;
+        str_error << e.what() << " RowGroup:" << _current_group << ", Column "
+                  << parquet_column.descr->name();
+        LOG(WARNING) << str_error.str();
+        return Status::InternalError(str_error.str());
+    }
+    return Status::OK();
+}
+
+template <typename DType>
+Status VParquetReader::_skip(ParquetColumn& column) {
+    auto* reader = static_cast<parquet::TypedColumnReader<DType>*>(column.reader.get());
+    if (reader->Skip(_batch_rows) != _batch_rows) {
+        return Status::Corruption("Unexpected end of parquet column " + column.descr->name());
+    }
+    return Status::OK();
+}
+
+Status VParquetReader::skip_column(int position) {
+    auto& parquet_column = _columns[position];
+    try {
+        switch (parquet_column.descr->physical_type()) {
+        case parquet::Type::BOOLEAN:
+            return _skip<parquet::BooleanType>(parquet_column);
+        case parquet::Type::INT32:
+            return _skip<parquet::Int32Type>(parquet_column);
+        case parquet::Type::INT64:
+            return _skip<parquet::Int64Type>(parquet_column);
+        case parquet::Type::INT96:
+            return _skip<parquet::Int96Type>(parquet_column);
+        case parquet::Type::FLOAT:
+            return _skip<parquet::FloatType>(parquet_column);
+        case parquet::Type::DOUBLE:
+            return _skip<parquet::DoubleType>(parquet_column);
+        case parquet::Type::BYTE_ARRAY:
+            return _skip<parquet::ByteArrayType>(parquet_column);
+        case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+            return _skip<parquet::FLBAType>(parquet_column);
+        default:
+            return Status::NotSupported("Not support parquet column " +
+                                        parquet_column.descr->name());
+        }
+    } catch (parquet::ParquetException& e) {
+        std::stringstream str_error;
+        str_error << e.what() << " RowGroup:" << _current_group << ", Column "
+                  << parquet_column.descr->name();
+        LOG(WARNING) << str_error.str();
+        return Status::InternalError(str_error.str());
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,147 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parquet/api/reader.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cctz/time_zone.h"
+#include "common/status.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/field.h"
+#include "vec/data_types/data_type.h"
+
+namespace doris {
+
+class ArrowFile;
+class FileReader;
+class FileStatisticsFilter;
+class SlotDescriptor;
+
+namespace vectorized {
+
+// Reader of parquet file which decodes the pages of column chunks into doris columns with
+// the column readers of parquet-cpp, instead of materializing arrow record batches first.
+// The row groups whose statistics can not satisfy the FileStatisticsFilter of the scanner
+// are skipped.
+//
+// Rows are read in batches which never span row groups. After next_batch(), every file
+// column has to be read by read_column() or skipped by skip_column() exactly once.
+class VParquetReader {
+public:
+    VParquetReader(FileReader* file_reader, int32_t num_of_columns_from_file,
+                   const std::string& timezone);
+    ~VParquetReader();
+
+    // Return NotSupported if any file column can not be decoded by this reader, the
+    // caller should read the file with ParquetReaderWrap instead.
+    Status init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                       const FileStatisticsFilter* statistics_filter);
+
+    // Move to the next batch of at most `max_rows` rows.
+    Status next_batch(size_t max_rows, size_t* rows, bool* eof);
+
+    // Always nullable, what the file column at `position` is decoded into.
+    const DataTypePtr& column_type(int position) const { return _columns[position].type; }
+
+    // Append the rows of the current batch to `column`, which is created by column_type().
+    Status read_column(int position, IColumn* column);
+    Status skip_column(int position);
+
+    int64_t filtered_row_groups() const { return _filtered_row_groups; }
+
+    void close();
+
+private:
+    // How the values of a column chunk are converted.
+    enum class ColumnKind {
+        BOOLEAN,
+        INT32,
+        UINT32,
+        INT64,
+        FLOAT,
+        DOUBLE,
+        DATE,
+        INT64_TIMESTAMP,
+        INT96_TIMESTAMP,
+        INT32_DECIMAL,
+        INT64_DECIMAL,
+        BINARY_DECIMAL,
+        FIXED_DECIMAL,
+        BINARY,
+        FIXED_BINARY
+    };
+
+    struct ParquetColumn {
+        int column_index;
+        const parquet::ColumnDescriptor* descr;
+        ColumnKind kind;
+        DataTypePtr type;
+        // of INT64_TIMESTAMP, to convert to seconds
+        int64_t time_unit_divisor = 1;
+        int decimal_scale = 0;
+        // of the current row group
+        std::shared_ptr<parquet::ColumnReader> reader;
+    };
+
+    Status _init_column(int column_index, ParquetColumn* column);
+    Status _next_row_group(bool* eof);
+
+    void _fill_null_map(const ParquetColumn& column, int64_t levels_read, UInt8* null_map);
+
+    // Decode into the column data in place, for the types of the same layout.
+    template <typename DType, typename CppType>
+    Status _read_fixed(ParquetColumn& column, ColumnNullable* dst);
+
+    // Decode into a buffer first, `convert` appends a non null value to the nested column.
+    template <typename DType, typename Convert>
+    Status _read_converted(ParquetColumn& column, ColumnNullable* dst, Convert&& convert);
+
+    template <typename DType>
+    Status _skip(ParquetColumn& column);
+
+    Int64 _to_datetime(int64_t seconds, bool is_date);
+
+    std::shared_ptr<ArrowFile> _arrow_file;
+    std::unique_ptr<parquet::ParquetFileReader> _file_reader;
+    std::shared_ptr<parquet::FileMetaData> _file_metadata;
+    const int32_t _num_of_columns_from_file;
+    std::string _timezone;
+    cctz::time_zone _ctz;
+
+    // of the file slots
+    std::vector<ParquetColumn> _columns;
+    std::vector<int> _column_indices;
+    // nullable
+    const FileStatisticsFilter* _statistics_filter = nullptr;
+
+    int _total_groups = 0;
+    int _current_group = -1;
+    int64_t _rows_of_group = 0;
+    int64_t _read_rows_of_group = 0;
+    int64_t _batch_rows = 0;
+    int64_t _filtered_row_groups = 0;
+    std::vector<int16_t> _def_levels;
+};
+
+} // namespace vectorized
+} // namespace doris
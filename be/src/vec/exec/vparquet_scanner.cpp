@@ -17,10 +17,49 @@
 
 #include "vec/exec/vparquet_scanner.h"
 
+#include <algorithm>
+#include <set>
+
+#include "common/config.h"
 #include "exec/arrow/parquet_reader.h"
+#include "io/file_factory.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 
+static void collect_slot_ids(const VExpr* expr, std::set<int>* slot_ids) {
+    if (expr->is_slot_ref()) {
+        slot_ids->insert(static_cast<const VSlotRef*>(expr)->slot_id());
+    }
+    for (const auto* child : expr->children()) {
+        collect_slot_ids(child, slot_ids);
+    }
+}
+
+// true if no row passes the filter, null is taken as false
+static bool is_all_false(const ColumnPtr& filter_column) {
+    ColumnPtr column = filter_column->convert_to_full_column_if_const();
+    const NullMap* null_map = nullptr;
+    if (const auto* nullable_column = check_and_get_column<ColumnNullable>(*column)) {
+        null_map = &nullable_column->get_null_map_data();
+        column = nullable_column->get_nested_column_ptr();
+    }
+    const auto& filter = assert_cast<const ColumnUInt8&>(*column).get_data();
+    for (size_t i = 0; i < filter.size(); ++i) {
+        if (filter[i] && (null_map == nullptr || !(*null_map)[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 VParquetScanner::VParquetScanner(RuntimeState* state, RuntimeProfile* profile,
                                  const TBrokerScanRangeParams& params,
                                  const std::vector<TBrokerRangeDesc>& ranges,
@@ -35,4 +74,187 @@ ArrowReaderWrap* VParquetScanner::_new_arrow_reader(FileReader* file_reader, int
     return new ParquetReaderWrap(file_reader, batch_size, num_of_columns_from_file);
 }
 
+Status VParquetScanner::open() {
+    RETURN_IF_ERROR(VArrowScanner::open());
+    _use_native_reader = config::enable_native_parquet_reader;
+    _lazy_skipped_rows_counter = ADD_COUNTER(_profile, "LazySkippedRows", TUnit::UNIT);
+    _init_lazy_read_columns();
+    return Status::OK();
+}
+
+void VParquetScanner::_init_lazy_read_columns() {
+    std::vector<bool> is_predicate(_num_of_columns_from_file, false);
+    if (_vpre_filter_ctx_ptr != nullptr) {
+        std::set<int> slot_ids;
+        collect_slot_ids((*_vpre_filter_ctx_ptr)->root(), &slot_ids);
+        for (int slot_id : slot_ids) {
+            auto iter = std::find_if(
+                    _src_slot_descs.begin(), _src_slot_descs.end(),
+                    [slot_id](const SlotDescriptor* slot) { return slot->id() == slot_id; });
+            if (iter - _src_slot_descs.begin() >= _num_of_columns_from_file) {
+                // the columns from path are filled after all file columns are read
+                is_predicate.assign(_num_of_columns_from_file, false);
+                break;
+            }
+            is_predicate[iter - _src_slot_descs.begin()] = true;
+        }
+    }
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        (is_predicate[i] ? _predicate_positions : _lazy_positions).push_back(i);
+    }
+    if (_lazy_positions.empty()) {
+        // nothing to skip, save evaluating the pre-filter once more
+        _lazy_positions.swap(_predicate_positions);
+    }
+}
+
+Status VParquetScanner::_open_next_native_reader() {
+    while (true) {
+        if (_next_range >= _ranges.size()) {
+            _scanner_eof = true;
+            return Status::OK();
+        }
+        const TBrokerRangeDesc& range = _ranges[_next_range++];
+        std::unique_ptr<FileReader> file_reader;
+        RETURN_IF_ERROR(FileFactory::create_file_reader(
+                range.file_type, _state->exec_env(), _profile, _broker_addresses,
+                _params.properties, range, range.start_offset, file_reader));
+        RETURN_IF_ERROR(file_reader->open());
+        if (file_reader->size() == 0) {
+            file_reader->close();
+            continue;
+        }
+
+        _native_reader.reset(new VParquetReader(file_reader.release(), _num_of_columns_from_file,
+                                                _state->timezone()));
+        Status status = _native_reader->init_reader(_src_slot_descs, &_statistics_filter);
+        if (status.ok()) {
+            return status;
+        }
+        _native_reader.reset();
+        if (status.is_end_of_file()) {
+            continue;
+        }
+        if (status.is_not_supported()) {
+            // read this file and the rest by the arrow reader
+            LOG(INFO) << "fall back to arrow reader, file: " << range.path
+                      << " reason: " << status.get_error_msg();
+            --_next_range;
+            _use_native_reader = false;
+            return Status::OK();
+        }
+        std::stringstream ss;
+        ss << " file: " << range.path << " error:" << status.get_error_msg();
+        return Status::InternalError(ss.str());
+    }
+}
+
+Status VParquetScanner::_read_native_column(int position, Block* batch) {
+    auto* slot_desc = _src_slot_descs[position];
+    const auto& type = _native_reader->column_type(position);
+    auto column = type->create_column();
+    RETURN_IF_ERROR(_native_reader->read_column(position, column.get()));
+    batch->get_by_position(position) =
+            ColumnWithTypeAndName(std::move(column), type, slot_desc->col_name());
+    // cast PT0 => PT1
+    return _cast_src_column(batch, position, slot_desc);
+}
+
+Status VParquetScanner::_read_native_batch(size_t rows) {
+    Block batch;
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        auto* slot_desc = _src_slot_descs[i];
+        batch.insert(ColumnWithTypeAndName(slot_desc->get_data_type_ptr()->create_column(),
+                                           slot_desc->get_data_type_ptr(),
+                                           slot_desc->col_name()));
+    }
+
+    if (!_predicate_positions.empty()) {
+        for (int position : _predicate_positions) {
+            RETURN_IF_ERROR(_read_native_column(position, &batch));
+        }
+        // the other columns are default values to evaluate the pre-filter, the rows
+        // passing it are filtered again with the whole src block
+        for (int position : _lazy_positions) {
+            auto column = std::move(*batch.get_by_position(position).column).mutate();
+            column->insert_many_defaults(rows);
+            batch.get_by_position(position).column = std::move(column);
+        }
+        int result_column_id = -1;
+        RETURN_IF_ERROR((*_vpre_filter_ctx_ptr)->execute(&batch, &result_column_id));
+        bool filtered = is_all_false(batch.get_by_position(result_column_id).column);
+        Block::erase_useless_column(&batch, _num_of_columns_from_file);
+        if (filtered) {
+            for (int position : _lazy_positions) {
+                RETURN_IF_ERROR(_native_reader->skip_column(position));
+            }
+            _counter->num_rows_unselected += rows;
+            COUNTER_UPDATE(_lazy_skipped_rows_counter, rows);
+            return Status::OK();
+        }
+    }
+    for (int position : _lazy_positions) {
+        RETURN_IF_ERROR(_read_native_column(position, &batch));
+    }
+
+    if (_src_block.rows() == 0) {
+        _src_block.swap(batch);
+        return Status::OK();
+    }
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        auto& dst = _src_block.get_by_position(i);
+        auto column = std::move(*dst.column).mutate();
+        column->insert_range_from(*batch.get_by_position(i).column, 0, rows);
+        dst.column = std::move(column);
+    }
+    return Status::OK();
+}
+
+Status VParquetScanner::get_next(Block* block, bool* eof) {
+    if (!_use_native_reader) {
+        return VArrowScanner::get_next(block, eof);
+    }
+    SCOPED_TIMER(_read_timer);
+    _src_block.clear();
+    size_t read_rows = 0;
+    while (!_scanner_eof && _src_block.rows() < _state->batch_size()) {
+        if (_native_reader == nullptr) {
+            RETURN_IF_ERROR(_open_next_native_reader());
+            if (!_use_native_reader) {
+                break;
+            }
+            continue;
+        }
+        size_t rows = 0;
+        bool reader_eof = false;
+        RETURN_IF_ERROR(_native_reader->next_batch(_state->batch_size() - _src_block.rows(),
+                                                   &rows, &reader_eof));
+        if (reader_eof) {
+            COUNTER_UPDATE(_filtered_row_groups_counter, _native_reader->filtered_row_groups());
+            _native_reader.reset();
+            if (_next_range >= _ranges.size()) {
+                _scanner_eof = true;
+            }
+            // the columns from path are of the current range, do not mix the files
+            if (_src_block.rows() > 0) {
+                break;
+            }
+            continue;
+        }
+        read_rows += rows;
+        RETURN_IF_ERROR(_read_native_batch(rows));
+    }
+    COUNTER_UPDATE(_rows_read_counter, read_rows);
+    if (!_use_native_reader && _src_block.rows() == 0) {
+        return VArrowScanner::get_next(block, eof);
+    }
+    SCOPED_TIMER(_materialize_timer);
+    return _fill_dest_block(block, eof);
+}
+
+void VParquetScanner::close() {
+    _native_reader.reset();
+    VArrowScanner::close();
+}
+
 } // namespace doris::vectorized
@@ -32,6 +32,7 @@
 #include "gen_cpp/Types_types.h"
 #include "runtime/mem_pool.h"
 #include "util/runtime_profile.h"
+#include "vec/exec/vparquet_reader.h"
 
 namespace doris::vectorized {
 
@@ -46,9 +47,35 @@ public:
 
     ~VParquetScanner() override = default;
 
+    Status open() override;
+
+    using VArrowScanner::get_next;
+    Status get_next(Block* block, bool* eof) override;
+
+    void close() override;
+
 protected:
     ArrowReaderWrap* _new_arrow_reader(FileReader* file_reader, int64_t batch_size,
                                        int32_t num_of_columns_from_file) override;
+
+private:
+    void _init_lazy_read_columns();
+    Status _open_next_native_reader();
+    // Read a batch of the native reader and append it to the src block, whose columns
+    // are cast to the types in src desc.
+    Status _read_native_batch(size_t rows);
+    Status _read_native_column(int position, Block* batch);
+
+    // switched to the arrow reader once a file can not be read by the native one
+    bool _use_native_reader = false;
+    std::unique_ptr<VParquetReader> _native_reader;
+    // The file columns referenced by the pre-filter are read first, the others are
+    // skipped if no row of the batch passes the pre-filter. All columns are read at once
+    // if the pre-filter is absent or references the columns from path.
+    std::vector<int> _predicate_positions;
+    std::vector<int> _lazy_positions;
+
+    RuntimeProfile::Counter* _lazy_skipped_rows_counter = nullptr;
 };
 
 } // namespace doris::vectorized
@@ -0,0 +1,370 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vprotobuf_scanner.h"
+
+#include <google/protobuf/compiler/parser.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/io/tokenizer.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/json_util.h>
+
+#include "io/file_factory.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/string_util.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+namespace {
+
+// keep the first error of parsing the schema
+class SchemaErrorCollector : public google::protobuf::io::ErrorCollector {
+public:
+    void AddError(int line, google::protobuf::io::ColumnNumber column,
+                  const std::string& message) override {
+        if (_error.empty()) {
+            _error = fmt::format("line {}, column {}: {}", line + 1, column + 1, message);
+        }
+    }
+
+    const std::string& error() const { return _error; }
+
+private:
+    std::string _error;
+};
+
+void append_json_string(fmt::memory_buffer& buf, const std::string& str) {
+    buf.push_back('"');
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            fmt::format_to(buf, "\\\"");
+            break;
+        case '\\':
+            fmt::format_to(buf, "\\\\");
+            break;
+        case '\n':
+            fmt::format_to(buf, "\\n");
+            break;
+        case '\r':
+            fmt::format_to(buf, "\\r");
+            break;
+        case '\t':
+            fmt::format_to(buf, "\\t");
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                fmt::format_to(buf, "\\u{:04x}", static_cast<int>(c));
+            } else {
+                buf.push_back(c);
+            }
+        }
+    }
+    buf.push_back('"');
+}
+
+// the null fields are the unset fields which track presence, the unset proto3 scalars are
+// the default values
+bool is_null_field(const Message& message, const FieldDescriptor* field) {
+    if (field == nullptr) {
+        return true;
+    }
+    if (field->is_repeated()) {
+        return false;
+    }
+    bool has_presence = field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE ||
+                        field->containing_oneof() != nullptr ||
+                        field->file()->syntax() == google::protobuf::FileDescriptor::SYNTAX_PROTO2;
+    return has_presence && !message.GetReflection()->HasField(message, field);
+}
+
+const FieldDescriptor* find_field(const Descriptor* descriptor, const std::string& name) {
+    const FieldDescriptor* field = descriptor->FindFieldByName(name);
+    if (field != nullptr) {
+        return field;
+    }
+    // the column names are case insensitive
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        if (iequal(descriptor->field(i)->name(), name)) {
+            return descriptor->field(i);
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+VProtobufScanner::VProtobufScanner(RuntimeState* state, RuntimeProfile* profile,
+                                   const TBrokerScanRangeParams& params,
+                                   const std::vector<TBrokerRangeDesc>& ranges,
+                                   const std::vector<TNetworkAddress>& broker_addresses,
+                                   const std::vector<TExpr>& pre_filter_texprs,
+                                   ScannerCounter* counter)
+        : BaseScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs,
+                      counter) {}
+
+VProtobufScanner::~VProtobufScanner() {
+    close();
+}
+
+Status VProtobufScanner::open() {
+    RETURN_IF_ERROR(BaseScanner::open());
+    if (_ranges.empty()) {
+        return Status::OK();
+    }
+    // the ranges of a load share the message type
+    return _init_message_type(_ranges[0]);
+}
+
+void VProtobufScanner::close() {
+    BaseScanner::close();
+    _message.reset();
+    _cur_file_reader.reset();
+}
+
+Status VProtobufScanner::_init_message_type(const TBrokerRangeDesc& range) {
+    if (!range.__isset.protobuf_schema || !range.__isset.protobuf_message) {
+        return Status::InvalidArgument(
+                "protobuf_schema and protobuf_message are required by the protobuf format");
+    }
+    google::protobuf::io::ArrayInputStream input(range.protobuf_schema.data(),
+                                                 range.protobuf_schema.size());
+    SchemaErrorCollector errors;
+    google::protobuf::io::Tokenizer tokenizer(&input, &errors);
+    google::protobuf::compiler::Parser parser;
+    parser.RecordErrorsTo(&errors);
+    google::protobuf::FileDescriptorProto file_proto;
+    if (!parser.Parse(&tokenizer, &file_proto)) {
+        return Status::InvalidArgument(fmt::format("invalid protobuf schema, {}", errors.error()));
+    }
+    file_proto.set_name("protobuf_schema.proto");
+    _pool = std::make_unique<google::protobuf::DescriptorPool>();
+    if (_pool->BuildFile(file_proto) == nullptr) {
+        return Status::InvalidArgument(
+                "failed to build the protobuf schema, the imports are not supported");
+    }
+    const Descriptor* descriptor = _pool->FindMessageTypeByName(range.protobuf_message);
+    if (descriptor == nullptr) {
+        return Status::InvalidArgument(fmt::format(
+                "protobuf message {} is not found in the schema", range.protobuf_message));
+    }
+    _message.reset(_factory.GetPrototype(descriptor)->New());
+
+    for (int i = 0; i < _num_of_columns_from_file; ++i) {
+        SlotDescriptor* slot_desc = _src_slot_descs[i];
+        if (slot_desc == nullptr) {
+            continue;
+        }
+        _slots.push_back(slot_desc);
+        _fields.push_back(find_field(descriptor, slot_desc->col_name()));
+    }
+    return Status::OK();
+}
+
+Status VProtobufScanner::_open_next_reader() {
+    if (_next_range >= _ranges.size()) {
+        _scanner_eof = true;
+        return Status::OK();
+    }
+    const TBrokerRangeDesc& range = _ranges[_next_range++];
+    RETURN_IF_ERROR(FileFactory::create_file_reader(range.file_type, _state->exec_env(), _profile,
+                                                    _broker_addresses, _params.properties, range,
+                                                    range.start_offset, _cur_file_reader));
+    RETURN_IF_ERROR(_cur_file_reader->open());
+    _cur_reader_eof = false;
+    return Status::OK();
+}
+
+Status VProtobufScanner::get_next(vectorized::Block* output_block, bool* eof) {
+    SCOPED_TIMER(_read_timer);
+    RETURN_IF_ERROR(_init_src_block());
+    const int batch_size = _state->batch_size();
+
+    auto columns = _src_block.mutate_columns();
+    size_t rows = 0;
+    while (rows < batch_size && !_scanner_eof) {
+        if (_cur_file_reader == nullptr || _cur_reader_eof) {
+            RETURN_IF_ERROR(_open_next_reader());
+            // If there isn't any more reader, break this
+            if (_scanner_eof) {
+                break;
+            }
+        }
+
+        std::unique_ptr<uint8_t[]> data;
+        int64_t size = 0;
+        RETURN_IF_ERROR(_cur_file_reader->read_one_message(&data, &size));
+        if (size == 0) {
+            _cur_reader_eof = true;
+            continue;
+        }
+        RETURN_IF_ERROR(_write_message(data.get(), size, columns));
+        rows = columns.empty() ? rows + 1 : columns[0]->size();
+    }
+
+    COUNTER_UPDATE(_rows_read_counter, rows);
+    SCOPED_TIMER(_materialize_timer);
+
+    return _fill_dest_block(output_block, eof);
+}
+
+Status VProtobufScanner::_write_message(const uint8_t* data, int64_t size,
+                                        std::vector<MutableColumnPtr>& columns) {
+    if (!_message->ParseFromArray(data, size)) {
+        return _append_error_msg(fmt::format("protobuf message of {} bytes", size),
+                                 "failed to parse the protobuf message");
+    }
+    // check the message before writing, so the columns are not written by an invalid one
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        if (!_slots[i]->is_nullable() && is_null_field(*_message, _fields[i])) {
+            return _append_error_msg(
+                    _message->ShortDebugString(),
+                    fmt::format("The field `{}` is not set, but the column is not nullable.",
+                                _slots[i]->col_name()));
+        }
+    }
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        IColumn* column = columns[i].get();
+        if (_slots[i]->is_nullable()) {
+            auto* nullable_column = assert_cast<ColumnNullable*>(column);
+            if (is_null_field(*_message, _fields[i])) {
+                nullable_column->insert_default();
+                continue;
+            }
+            nullable_column->get_null_map_data().push_back(0);
+            column = &nullable_column->get_nested_column();
+        }
+        _write_field(_fields[i], column);
+    }
+    return Status::OK();
+}
+
+void VProtobufScanner::_write_field(const FieldDescriptor* field, IColumn* column) {
+    _value_buf.clear();
+    if (field->is_repeated()) {
+        // the repeated fields are written as json arrays, like the arrays of json loads
+        int count = _message->GetReflection()->FieldSize(*_message, field);
+        _value_buf.push_back('[');
+        for (int i = 0; i < count; ++i) {
+            if (i > 0) {
+                _value_buf.push_back(',');
+            }
+            _append_value(*_message, field, i, true);
+        }
+        _value_buf.push_back(']');
+    } else {
+        _append_value(*_message, field, -1, false);
+    }
+    // the src slots are all varchar, see VJsonReader::_write_data_to_column
+    DCHECK(column->is_column_string());
+    assert_cast<ColumnString*>(column)->insert_data(_value_buf.data(), _value_buf.size());
+}
+
+void VProtobufScanner::_append_value(const Message& message, const FieldDescriptor* field,
+                                     int index, bool quote_string) {
+    const Reflection* reflection = message.GetReflection();
+    bool repeated = index >= 0;
+    switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+        fmt::format_to(_value_buf, "{}",
+                       repeated ? reflection->GetRepeatedInt32(message, field, index)
+                                : reflection->GetInt32(message, field));
+        break;
+    case FieldDescriptor::CPPTYPE_INT64:
+        fmt::format_to(_value_buf, "{}",
+                       repeated ? reflection->GetRepeatedInt64(message, field, index)
+                                : reflection->GetInt64(message, field));
+        break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+        fmt::format_to(_value_buf, "{}",
+                       repeated ? reflection->GetRepeatedUInt32(message, field, index)
+                                : reflection->GetUInt32(message, field));
+        break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+        fmt::format_to(_value_buf, "{}",
+                       repeated ? reflection->GetRepeatedUInt64(message, field, index)
+                                : reflection->GetUInt64(message, field));
+        break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+        fmt::format_to(_value_buf, "{}",
+                       repeated ? reflection->GetRepeatedFloat(message, field, index)
+                                : reflection->GetFloat(message, field));
+        break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+        fmt::format_to(_value_buf, "{}",
+                       repeated ? reflection->GetRepeatedDouble(message, field, index)
+                                : reflection->GetDouble(message, field));
+        break;
+    case FieldDescriptor::CPPTYPE_BOOL: {
+        bool value = repeated ? reflection->GetRepeatedBool(message, field, index)
+                              : reflection->GetBool(message, field);
+        _value_buf.push_back(value ? '1' : '0');
+        break;
+    }
+    case FieldDescriptor::CPPTYPE_ENUM: {
+        const auto* value = repeated ? reflection->GetRepeatedEnum(message, field, index)
+                                     : reflection->GetEnum(message, field);
+        const std::string& name = value->name();
+        if (quote_string) {
+            append_json_string(_value_buf, name);
+        } else {
+            fmt::format_to(_value_buf, "{}", name);
+        }
+        break;
+    }
+    case FieldDescriptor::CPPTYPE_STRING: {
+        std::string scratch;
+        const std::string& value =
+                repeated ? reflection->GetRepeatedStringReference(message, field, index, &scratch)
+                         : reflection->GetStringReference(message, field, &scratch);
+        if (quote_string) {
+            append_json_string(_value_buf, value);
+        } else {
+            _value_buf.append(value.data(), value.data() + value.size());
+        }
+        break;
+    }
+    case FieldDescriptor::CPPTYPE_MESSAGE: {
+        // the nested messages are written as json objects
+        const Message& nested = repeated ? reflection->GetRepeatedMessage(message, field, index)
+                                         : reflection->GetMessage(message, field);
+        std::string json;
+        google::protobuf::util::MessageToJsonString(nested, &json);
+        _value_buf.append(json.data(), json.data() + json.size());
+        break;
+    }
+    }
+}
+
+Status VProtobufScanner::_append_error_msg(const std::string& line, const std::string& error_msg) {
+    RETURN_IF_ERROR(_state->append_error_msg_to_file([&]() -> std::string { return line; },
+                                                     [&]() -> std::string { return error_msg; },
+                                                     &_scanner_eof));
+    _counter->num_rows_filtered++;
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
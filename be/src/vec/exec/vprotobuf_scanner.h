@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <fmt/format.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/dynamic_message.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/base_scanner.h"
+#include "io/file_reader.h"
+#include "vec/columns/column.h"
+
+namespace doris::vectorized {
+
+// Scanner of the protobuf messages, e.g. the kafka messages of a routine load. Each message
+// read by FileReader::read_one_message() is a row, whose fields are written to the src
+// columns of the same names. The message type is parsed at runtime from the .proto schema
+// of the range, so no generated code is needed.
+class VProtobufScanner : public BaseScanner {
+public:
+    VProtobufScanner(RuntimeState* state, RuntimeProfile* profile,
+                     const TBrokerScanRangeParams& params,
+                     const std::vector<TBrokerRangeDesc>& ranges,
+                     const std::vector<TNetworkAddress>& broker_addresses,
+                     const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
+
+    ~VProtobufScanner() override;
+
+    Status open() override;
+
+    Status get_next(doris::Tuple* tuple, MemPool* tuple_pool, bool* eof,
+                    bool* fill_tuple) override {
+        return Status::NotSupported("Not Implemented get tuple");
+    }
+    Status get_next(vectorized::Block* block, bool* eof) override;
+
+    void close() override;
+
+private:
+    Status _init_message_type(const TBrokerRangeDesc& range);
+    Status _open_next_reader();
+    // write one message to the columns, the invalid message is filtered
+    Status _write_message(const uint8_t* data, int64_t size,
+                          std::vector<MutableColumnPtr>& columns);
+    void _write_field(const google::protobuf::FieldDescriptor* field, IColumn* column);
+    // append the value of a singular field, or of an element of a repeated field if index >= 0
+    void _append_value(const google::protobuf::Message& message,
+                       const google::protobuf::FieldDescriptor* field, int index,
+                       bool quote_string);
+    Status _append_error_msg(const std::string& line, const std::string& error_msg);
+
+private:
+    std::shared_ptr<FileReader> _cur_file_reader;
+    bool _cur_reader_eof = true;
+
+    std::unique_ptr<google::protobuf::DescriptorPool> _pool;
+    google::protobuf::DynamicMessageFactory _factory;
+    std::unique_ptr<google::protobuf::Message> _message;
+    // the src slots of the src columns, and their fields, nullptr if the message has no
+    // field of the slot name
+    std::vector<SlotDescriptor*> _slots;
+    std::vector<const google::protobuf::FieldDescriptor*> _fields;
+    // the text of the field being written
+    fmt::memory_buffer _value_buf;
+};
+
+} // namespace doris::vectorized
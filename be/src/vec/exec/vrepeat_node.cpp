@@ -21,6 +21,8 @@
 #include "gutil/strings/join.h"
 #include "runtime/runtime_state.h"
 #include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
 
 namespace doris::vectorized {
 VRepeatNode::VRepeatNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
@@ -31,6 +33,7 @@ VRepeatNode::VRepeatNode(ObjectPool* pool, const TPlanNode& tnode, const Descrip
 Status VRepeatNode::prepare(RuntimeState* state) {
     VLOG_CRITICAL << "VRepeatNode::prepare";
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(RepeatNode::prepare(state));
 
     // get current all output slots
@@ -61,6 +64,7 @@ Status VRepeatNode::prepare(RuntimeState* state) {
     }
 
     _child_block.reset(new Block());
+    _null_columns.resize(_child_slots.size());
 
     return Status::OK();
 }
@@ -68,6 +72,7 @@ Status VRepeatNode::prepare(RuntimeState* state) {
 Status VRepeatNode::open(RuntimeState* state) {
     VLOG_CRITICAL << "VRepeatNode::open";
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(RepeatNode::open(state));
     return Status::OK();
 }
@@ -79,17 +84,11 @@ Status VRepeatNode::get_repeated_block(Block* child_block, int repeat_id_idx, Bl
 
     size_t child_column_size = child_block->columns();
     size_t column_size = _output_slots.size();
-    bool mem_reuse = output_block->mem_reuse();
     DCHECK_EQ(child_column_size, _child_slots.size());
     DCHECK_LT(child_column_size, column_size);
-    std::vector<vectorized::MutableColumnPtr> columns(column_size);
-    for (size_t i = 0; i < column_size; i++) {
-        if (mem_reuse) {
-            columns[i] = std::move(*output_block->get_by_position(i).column).mutate();
-        } else {
-            columns[i] = _output_slots[i]->get_empty_mutable_column();
-        }
-    }
+    const size_t rows = child_block->rows();
+    // the output columns share the data of the child columns rather than copy them
+    output_block->clear();
 
     /* Fill all slots according to child, for example:select tc1,tc2,sum(tc3) from t1 group by grouping sets((tc1),(tc2));
      * insert into t1 values(1,2,1),(1,3,1),(2,1,1),(3,1,1);
@@ -97,6 +96,7 @@ Status VRepeatNode::get_repeated_block(Block* child_block, int repeat_id_idx, Bl
      * child_block 1,2,1 | 1,3,1 | 2,1,1 | 3,1,1
      * output_block 1,null,1,1 | 1,null,1,1 | 2,nul,1,1 | 3,null,1,1
      */
+    std::set<SlotId>& repeat_ids = _slot_id_set_list[repeat_id_idx];
     size_t cur_col = 0;
     for (size_t i = 0; i < child_column_size; i++) {
         const ColumnWithTypeAndName& src_column = child_block->get_by_position(i);
@@ -104,34 +104,22 @@ Status VRepeatNode::get_repeated_block(Block* child_block, int repeat_id_idx, Bl
         DCHECK_EQ(_child_slots[i]->type().type, _output_slots[cur_col]->type().type);
         DCHECK_EQ(_child_slots[i]->col_name(), _output_slots[cur_col]->col_name());
 
-        std::set<SlotId>& repeat_ids = _slot_id_set_list[repeat_id_idx];
-        bool is_repeat_slot =
-                _all_slot_ids.find(_output_slots[cur_col]->id()) != _all_slot_ids.end();
-        bool is_set_null_slot = repeat_ids.find(_output_slots[cur_col]->id()) == repeat_ids.end();
-        const auto row_size = src_column.column->size();
+        const auto* slot_desc = _output_slots[cur_col];
+        bool is_repeat_slot = _all_slot_ids.find(slot_desc->id()) != _all_slot_ids.end();
+        bool is_set_null_slot = repeat_ids.find(slot_desc->id()) == repeat_ids.end();
+        ColumnPtr column = src_column.column;
 
         if (is_repeat_slot) {
-            DCHECK(_output_slots[cur_col]->is_nullable());
-            auto* nullable_column = reinterpret_cast<ColumnNullable*>(columns[cur_col].get());
-            auto& null_map = nullable_column->get_null_map_data();
-            auto* column_ptr = columns[cur_col].get();
-
+            DCHECK(slot_desc->is_nullable());
             // set slot null not in repeat_ids
             if (is_set_null_slot) {
-                nullable_column->resize(row_size);
-                memset(nullable_column->get_null_map_data().data(), 1, sizeof(UInt8) * row_size);
-            } else {
-                if (!src_column.type->is_nullable()) {
-                    for (size_t j = 0; j < row_size; ++j) {
-                        null_map.push_back(0);
-                    }
-                    column_ptr = &nullable_column->get_nested_column();
-                }
-                column_ptr->insert_range_from(*src_column.column, 0, row_size);
+                column = get_null_column(cur_col, rows);
+            } else if (!src_column.type->is_nullable()) {
+                column = ColumnNullable::create(src_column.column, get_not_null_map(rows));
             }
-        } else {
-            columns[cur_col]->insert_range_from(*src_column.column, 0, row_size);
         }
+        output_block->insert(
+                {std::move(column), slot_desc->get_data_type_ptr(), slot_desc->col_name()});
         cur_col++;
     }
 
@@ -142,36 +130,42 @@ Status VRepeatNode::get_repeated_block(Block* child_block, int repeat_id_idx, Bl
         DCHECK_EQ(_virtual_slot_desc->type().type, _output_slots[cur_col]->type().type);
         DCHECK_EQ(_virtual_slot_desc->col_name(), _output_slots[cur_col]->col_name());
         int64_t val = _grouping_list[slot_idx][repeat_id_idx];
-        auto* column_ptr = columns[cur_col].get();
         DCHECK(!_output_slots[cur_col]->is_nullable());
 
-        auto* col = assert_cast<ColumnVector<Int64>*>(column_ptr);
-        for (size_t i = 0; i < child_block->rows(); ++i) {
-            col->insert_value(val);
-        }
+        output_block->insert({ColumnVector<Int64>::create(rows, val),
+                              _output_slots[cur_col]->get_data_type_ptr(),
+                              _output_slots[cur_col]->col_name()});
         cur_col++;
     }
 
     DCHECK_EQ(cur_col, column_size);
+    return Status::OK();
+}
 
-    if (!columns.empty() && !columns[0]->empty()) {
-        auto n_columns = 0;
-        if (!mem_reuse) {
-            for (const auto slot_desc : _output_slots) {
-                output_block->insert(ColumnWithTypeAndName(std::move(columns[n_columns++]),
-                                                           slot_desc->get_data_type_ptr(),
-                                                           slot_desc->col_name()));
-            }
-        } else {
-            columns.clear();
-        }
+ColumnPtr VRepeatNode::get_null_column(size_t slot_idx, size_t rows) {
+    DCHECK_LT(slot_idx, _null_columns.size());
+    auto& column = _null_columns[slot_idx];
+    if (column == nullptr) {
+        // the nested values are defaults, the same as the ones of a resized column
+        column = _output_slots[slot_idx]
+                         ->get_data_type_ptr()
+                         ->create_column_const_with_default_value(rows)
+                         ->convert_to_full_column_if_const();
     }
-    return Status::OK();
+    return column;
+}
+
+ColumnPtr VRepeatNode::get_not_null_map(size_t rows) {
+    if (_not_null_map == nullptr) {
+        _not_null_map = ColumnUInt8::create(rows, 0);
+    }
+    return _not_null_map;
 }
 
 Status VRepeatNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     VLOG_CRITICAL << "VRepeatNode::get_next";
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
 
     if (state == nullptr || block == nullptr || eos == nullptr) {
         return Status::InternalError("input is NULL pointer");
@@ -203,7 +197,10 @@ Status VRepeatNode::get_next(RuntimeState* state, Block* block, bool* eos) {
 
     int size = _repeat_id_list.size();
     if (_repeat_id_idx >= size) {
+        // the columns still shared by the output blocks are replaced rather than cleared
         release_block_memory(*_child_block.get());
+        std::fill(_null_columns.begin(), _null_columns.end(), nullptr);
+        _not_null_map = nullptr;
         _repeat_id_idx = 0;
     }
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "exec/repeat_node.h"
+#include "vec/columns/column.h"
 
 namespace doris {
 
@@ -44,8 +45,14 @@ protected:
 private:
     using RepeatNode::get_next;
     Status get_repeated_block(Block* child_block, int repeat_id_idx, Block* output_block);
+    ColumnPtr get_null_column(size_t slot_idx, size_t rows);
+    ColumnPtr get_not_null_map(size_t rows);
 
     std::unique_ptr<Block> _child_block;
+    // The all null columns of the repeat slots and the null map of not nullable child columns,
+    // they are shared by the output blocks of all the repeats of the current child block.
+    std::vector<ColumnPtr> _null_columns;
+    ColumnPtr _not_null_map;
     std::vector<SlotDescriptor*> _child_slots;
     std::vector<SlotDescriptor*> _output_slots;
 
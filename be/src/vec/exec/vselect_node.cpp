@@ -32,18 +32,23 @@ Status VSelectNode::prepare(RuntimeState* state) {
 }
 
 Status VSelectNode::open(RuntimeState* state) {
-    RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
-    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_ERROR(open_self(state));
     RETURN_IF_ERROR(child(0)->open(state));
     return Status::OK();
 }
 
+Status VSelectNode::open_self(RuntimeState* state) {
+    RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
+    return ExecNode::open(state);
+}
+
 Status VSelectNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
     return Status::NotSupported("Not Implemented VSelectNode::get_next.");
 }
 
 Status VSelectNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     RETURN_IF_CANCELLED(state);
     do {
@@ -61,6 +66,24 @@ Status VSelectNode::get_next(RuntimeState* state, vectorized::Block* block, bool
     return Status::OK();
 }
 
+Status VSelectNode::push(RuntimeState* state, vectorized::Block* block, bool eos) {
+    RETURN_IF_CANCELLED(state);
+    _child_block.swap(*block);
+    _child_eos = eos;
+    return Status::OK();
+}
+
+Status VSelectNode::pull(RuntimeState* state, vectorized::Block* block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
+    block->swap(_child_block);
+    _child_block.clear();
+    *eos = _child_eos;
+    RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
+    reached_limit(block, eos);
+    return Status::OK();
+}
+
 Status VSelectNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
@@ -17,6 +17,7 @@
 
 #pragma once
 #include "exec/exec_node.h"
+#include "vec/core/block.h"
 
 namespace doris {
 namespace vectorized {
@@ -31,9 +32,18 @@ public:
     virtual Status get_next(RuntimeState* state, vectorized::Block* block, bool* eos);
     virtual Status close(RuntimeState* state);
 
+    Status open_self(RuntimeState* state) override;
+    Status push(RuntimeState* state, vectorized::Block* block, bool eos) override;
+    Status pull(RuntimeState* state, vectorized::Block* block, bool* eos) override;
+    bool need_more_input_data() const override {
+        return _child_block.rows() == 0 && !_child_eos;
+    }
+
 private:
     // true if last get_next() call on child signalled eos
     bool _child_eos;
+    // the block pushed but not pulled yet
+    vectorized::Block _child_block;
 };
 } // namespace vectorized
 } // namespace doris
\ No newline at end of file
@@ -103,6 +103,9 @@ Status VSetOperationNode::init(const TPlanNode& tnode, RuntimeState* state) {
         return Status::NotSupported("Not Implemented, Check The Operation Node.");
     }
 
+    if (result_texpr_lists.size() > std::numeric_limits<uint16_t>::max()) {
+        return Status::NotSupported("Too many children of the set operation node.");
+    }
     for (auto& texprs : result_texpr_lists) {
         std::vector<VExprContext*> ctxs;
         RETURN_IF_ERROR(VExpr::create_expr_trees(_pool, texprs, &ctxs));
@@ -114,18 +117,35 @@ Status VSetOperationNode::init(const TPlanNode& tnode, RuntimeState* state) {
 
 Status VSetOperationNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     RETURN_IF_ERROR(ExecNode::open(state));
     // open result expr lists.
     for (const std::vector<VExprContext*>& exprs : _child_expr_lists) {
         RETURN_IF_ERROR(VExpr::open(exprs, state));
     }
-    RETURN_IF_ERROR(hash_table_build(state));
-    return Status::OK();
+
+    std::promise<Status> thread_status;
+    std::thread(bind(&VSetOperationNode::_hash_table_build_thread, this, state, &thread_status))
+            .detach();
+
+    // Open the first probe child in parallel with building the hash table, the other
+    // children are opened by the subclasses one by one before probing them.
+    // Don't exit even if we see an error, we still need to wait for the build thread.
+    Status open_status = child(1)->open(state);
+    RETURN_IF_ERROR(thread_status.get_future().get());
+    return open_status;
+}
+
+void VSetOperationNode::_hash_table_build_thread(RuntimeState* state,
+                                                 std::promise<Status>* status) {
+    SCOPED_ATTACH_TASK_THREAD(state, mem_tracker());
+    status->set_value(hash_table_build(state));
 }
 
 Status VSetOperationNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::prepare(state));
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     _hash_table_mem_tracker = MemTracker::create_virtual_tracker(-1, "VSetOperationNode:HashTable");
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <future>
+#include <thread>
+
 #include "exec/exec_node.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
@@ -52,10 +55,9 @@ protected:
     Status process_build_block(Block& block, uint8_t offset);
     Status extract_build_column(Block& block, ColumnRawPtrs& raw_ptrs);
     Status extract_probe_column(Block& block, ColumnRawPtrs& raw_ptrs, int child_id);
-    template <bool keep_matched>
-    void refresh_hash_table();
     Status process_probe_block(RuntimeState* state, int child_id, bool* eos);
     void create_mutable_cols(Block* output_block);
+    void _hash_table_build_thread(RuntimeState* state, std::promise<Status>* status);
 
 protected:
     HashTableVariants _hash_table_variants;
@@ -98,66 +100,6 @@ protected:
     friend struct HashTableProbe;
 };
 
-template <bool keep_matched>
-void VSetOperationNode::refresh_hash_table() {
-    std::visit(
-            [&](auto&& arg) {
-                using HashTableCtxType = std::decay_t<decltype(arg)>;
-                if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
-                    HashTableCtxType tmp_hash_table;
-                    bool is_need_shrink =
-                            arg.hash_table.should_be_shrink(_valid_element_in_hash_tbl);
-                    if (is_need_shrink) {
-                        tmp_hash_table.hash_table.init_buf_size(
-                                _valid_element_in_hash_tbl / arg.hash_table.get_factor() + 1);
-                    }
-
-                    arg.init_once();
-                    auto& iter = arg.iter;
-                    auto iter_end = arg.hash_table.end();
-                    while (iter != iter_end) {
-                        auto& mapped = iter->get_second();
-                        auto it = mapped.begin();
-
-                        if constexpr (keep_matched) { //intersected
-                            if (it->visited) {
-                                it->visited = false;
-                                if (is_need_shrink) {
-                                    tmp_hash_table.hash_table.insert(iter->get_value());
-                                }
-                                ++iter;
-                            } else {
-                                if (!is_need_shrink) {
-                                    arg.hash_table.delete_zero_key(iter->get_first());
-                                    // the ++iter would check if the current key is zero. if it does, the iterator will be moved to the container's head.
-                                    // so we do ++iter before set_zero to make the iterator move to next valid key correctly.
-                                    auto iter_prev = iter;
-                                    ++iter;
-                                    iter_prev->set_zero();
-                                } else {
-                                    ++iter;
-                                }
-                            }
-                        } else { //except
-                            if (!it->visited && is_need_shrink) {
-                                tmp_hash_table.hash_table.insert(iter->get_value());
-                            }
-                            ++iter;
-                        }
-                    }
-
-                    arg.inited = false;
-                    if (is_need_shrink) {
-                        arg.hash_table = std::move(tmp_hash_table.hash_table);
-                    }
-
-                } else {
-                    LOG(FATAL) << "FATAL: uninited hash table";
-                }
-            },
-            _hash_table_variants);
-}
-
 template <class HashTableContext, bool is_intersected>
 struct HashTableProbe {
     HashTableProbe(VSetOperationNode* operation_node, int batch_size, int probe_rows)
@@ -175,7 +117,11 @@ struct HashTableProbe {
               _build_col_idx(operation_node->_build_col_idx),
               _mutable_cols(operation_node->_mutable_cols) {}
 
-    Status mark_data_in_hashtable(HashTableContext& hash_table_ctx) {
+    // The rows of the child are marked in place instead of rebuilding the hash table for
+    // every child. For except, a row is removed once any child matched it. For intersect,
+    // a row is kept only if every child matched it, so the i-th child only marks the rows
+    // which have been matched by all the previous i - 1 children.
+    Status mark_data_in_hashtable(HashTableContext& hash_table_ctx, int child_id) {
         using KeyGetter = typename HashTableContext::State;
         using Mapped = typename HashTableContext::Mapped;
 
@@ -185,12 +131,14 @@ struct HashTableProbe {
             auto find_result = key_getter.find_key(hash_table_ctx.hash_table, _probe_index, _arena);
             if (find_result.is_found()) { //if found, marked visited
                 auto it = find_result.get_mapped().begin();
-                if (!(it->visited)) {
-                    it->visited = true;
-                    if constexpr (is_intersected) //intersected
+                if constexpr (is_intersected) {
+                    if (it->matched_children == child_id - 1) {
+                        it->matched_children = child_id;
                         _operation_node->_valid_element_in_hash_tbl++;
-                    else
-                        _operation_node->_valid_element_in_hash_tbl--; //except
+                    }
+                } else if (!(it->visited)) {
+                    it->visited = true;
+                    _operation_node->_valid_element_in_hash_tbl--;
                 }
             }
             _probe_index++;
@@ -211,6 +159,7 @@ struct HashTableProbe {
                                  std::vector<MutableColumnPtr>& mutable_cols, Block* output_block,
                                  bool* eos) {
         hash_table_ctx.init_once();
+        const size_t num_probe_children = _operation_node->_children.size() - 1;
         int left_col_len = _left_table_data_types.size();
         auto& iter = hash_table_ctx.iter;
         auto block_size = 0;
@@ -219,7 +168,7 @@ struct HashTableProbe {
             auto& value = iter->get_second();
             auto it = value.begin();
             if constexpr (is_intersected) {
-                if (it->visited) { //intersected: have done probe, so visited values it's the result
+                if (it->matched_children == num_probe_children) { //matched by all the children
                     add_result_columns(value, block_size);
                 }
             } else {
@@ -17,10 +17,17 @@
 
 #include "vec/exec/vsort_node.h"
 
+#include "common/config.h"
+#include "env/env.h"
 #include "exec/sort_exec_exprs.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory_reservation_mgr.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/debug_util.h"
+#include "vec/common/sip_hash.h"
+#include "vec/core/block_spill_manager.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/core/sort_block.h"
 
 namespace doris::vectorized {
@@ -35,27 +42,52 @@ Status VSortNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(_vsort_exec_exprs.init(tnode.sort_node.sort_info, _pool));
     _is_asc_order = tnode.sort_node.sort_info.is_asc_order;
     _nulls_first = tnode.sort_node.sort_info.nulls_first;
+    if (tnode.sort_node.__isset.num_partition_exprs) {
+        _num_partition_exprs = tnode.sort_node.num_partition_exprs;
+    }
     return Status::OK();
 }
 
 Status VSortNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     _runtime_profile->add_info_string("TOP-N", _limit == -1 ? "false" : "true");
     RETURN_IF_ERROR(ExecNode::prepare(state));
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     _block_mem_tracker = MemTracker::create_virtual_tracker(-1, "VSortNode:Block", mem_tracker());
     RETURN_IF_ERROR(_vsort_exec_exprs.prepare(state, child(0)->row_desc(), _row_descriptor,
                                               expr_mem_tracker()));
+    // TOP-N keeps at most limit rows in memory, no need to spill
+    _enable_spill = state->enable_spill() && _limit == -1;
+    // the partitions are kept in memory until output
+    if (_enable_spill || _limit != -1 || _offset != 0 ||
+        config::analytic_sort_partition_count <= 0) {
+        _num_partition_exprs = 0;
+    }
+    if (_num_partition_exprs > 0) {
+        _runtime_profile->add_info_string("PartitionExprs", std::to_string(_num_partition_exprs));
+        _partition_columns.resize(config::analytic_sort_partition_count);
+        _partition_sort_timer = ADD_TIMER(runtime_profile(), "PartitionSortTime");
+    }
+    if (_enable_spill) {
+        _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+        _spill_runs = ADD_COUNTER(runtime_profile(), "SpillRuns", TUnit::UNIT);
+        _spill_rows = ADD_COUNTER(runtime_profile(), "SpillRows", TUnit::UNIT);
+        _spill_bytes = ADD_COUNTER(runtime_profile(), "SpillBytes", TUnit::BYTES);
+    }
+    if (_limit != -1) {
+        _topn_filtered_rows = ADD_COUNTER(runtime_profile(), "TopNFilteredRows", TUnit::UNIT);
+        _topn_compactions = ADD_COUNTER(runtime_profile(), "TopNCompactions", TUnit::UNIT);
+        _topn_compact_timer = ADD_TIMER(runtime_profile(), "TopNCompactTime");
+    }
     return Status::OK();
 }
 
 Status VSortNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
-    RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(_vsort_exec_exprs.open(state));
-    RETURN_IF_CANCELLED(state);
-    RETURN_IF_ERROR(state->check_query_state("vsort, while open."));
+    RETURN_IF_ERROR(open_self(state));
     RETURN_IF_ERROR(child(0)->open(state));
 
     // The child has been opened and the sorter created. Sort the input.
@@ -77,10 +109,16 @@ Status VSortNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
 
 Status VSortNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
 
     auto status = Status::OK();
-    if (_sorted_blocks.empty()) {
+    if (_spill_merger != nullptr) {
+        RETURN_IF_ERROR(_spill_merger->get_next(block, eos));
+        RETURN_IF_ERROR(_spill_read_status);
+    } else if (_num_partition_exprs > 0) {
+        RETURN_IF_ERROR(partition_sort_read(block, eos));
+    } else if (_sorted_blocks.empty()) {
         *eos = true;
     } else if (_sorted_blocks.size() == 1) {
         if (_offset != 0) {
@@ -106,6 +144,13 @@ Status VSortNode::close(RuntimeState* state) {
         return Status::OK();
     }
     _block_mem_tracker->release(_total_mem_usage);
+    // the opened runs are removed by spill reader, while the others should be removed here
+    size_t opened_runs = _spill_readers.size();
+    _spill_merger.reset();
+    _spill_readers.clear();
+    for (size_t i = opened_runs; i < _spilled_run_paths.size(); ++i) {
+        BlockSpillManager::remove_file(_spilled_run_paths[i]);
+    }
     _vsort_exec_exprs.close(state);
     return ExecNode::close(state);
 }
@@ -121,51 +166,85 @@ void VSortNode::debug_string(int indentation_level, stringstream* out) const {
     *out << ")";
 }
 
+Status VSortNode::open_self(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_ERROR(_vsort_exec_exprs.open(state));
+    RETURN_IF_CANCELLED(state);
+    RETURN_IF_ERROR(state->check_query_state("vsort, while open."));
+    return Status::OK();
+}
+
 Status VSortNode::sort_input(RuntimeState* state) {
     bool eos = false;
     do {
         Block block;
         RETURN_IF_ERROR(child(0)->get_next(state, &block, &eos));
-        auto rows = block.rows();
-
-        if (rows != 0) {
-            RETURN_IF_ERROR(pretreat_block(block));
-            size_t mem_usage = block.allocated_bytes();
-
-            // dispose TOP-N logic
-            if (_limit != -1) {
-                // Here is a little opt to reduce the mem uasge, we build a max heap
-                // to order the block in _block_priority_queue.
-                // if one block totally greater the heap top of _block_priority_queue
-                // we can throw the block data directly.
-                if (_num_rows_in_block < _limit) {
-                    _total_mem_usage += mem_usage;
-                    _sorted_blocks.emplace_back(std::move(block));
-                    _num_rows_in_block += rows;
-                    _block_priority_queue.emplace(_pool->add(
-                            new SortCursorImpl(_sorted_blocks.back(), _sort_description)));
-                } else {
-                    SortBlockCursor block_cursor(
-                            _pool->add(new SortCursorImpl(block, _sort_description)));
-                    if (!block_cursor.totally_greater(_block_priority_queue.top())) {
-                        _sorted_blocks.emplace_back(std::move(block));
-                        _block_priority_queue.push(block_cursor);
-                        _total_mem_usage += mem_usage;
-                    } else {
-                        continue;
-                    }
-                }
-            } else {
-                // dispose normal sort logic
+        RETURN_IF_ERROR(sink(state, &block, eos));
+    } while (!eos);
+    return Status::OK();
+}
+
+Status VSortNode::sink(RuntimeState* state, Block* input_block, bool eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
+    SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
+    if (input_block->rows() != 0) {
+        Block block;
+        block.swap(*input_block);
+        RETURN_IF_ERROR(pretreat_block(block));
+        size_t mem_usage = block.allocated_bytes();
+
+        // dispose TOP-N logic
+        if (_limit != -1) {
+            // Here is a little opt to reduce the mem uasge, we build a max heap
+            // to order the block in _block_priority_queue.
+            // the rows greater than the last row of the heap top have been thrown
+            // in pretreat_block, the block may be empty now.
+            if (block.rows() != 0) {
                 _total_mem_usage += mem_usage;
                 _sorted_blocks.emplace_back(std::move(block));
+                _num_rows_in_block += _sorted_blocks.back().rows();
+                _block_priority_queue.emplace(_pool->add(
+                        new SortCursorImpl(_sorted_blocks.back(), _sort_description)));
+                _block_mem_tracker->consume(mem_usage);
             }
-
+        } else if (_num_partition_exprs > 0) {
+            _total_mem_usage += mem_usage;
+            partition_block(block);
+            _block_mem_tracker->consume(mem_usage);
+        } else {
+            // dispose normal sort logic
+            _total_mem_usage += mem_usage;
+            _sorted_blocks.emplace_back(std::move(block));
             _block_mem_tracker->consume(mem_usage);
-            RETURN_IF_CANCELLED(state);
-            RETURN_IF_ERROR(state->check_query_state("vsort, while sorting input."));
         }
-    } while (!eos);
+
+        if (_limit != -1 && _offset + _limit > 0 &&
+            _num_rows_in_block >= TOPN_COMPACT_FACTOR * (_offset + _limit)) {
+            compact_topn_blocks();
+        }
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(state->check_query_state("vsort, while sorting input."));
+
+        if (_enable_spill &&
+            _total_mem_usage >=
+                    MemoryReservationMgr::spill_threshold(config::spill_sort_threshold_bytes)) {
+            RETURN_IF_ERROR(spill_sorted_blocks(state));
+        }
+    }
+    if (!eos || _num_partition_exprs > 0) {
+        return Status::OK();
+    }
+
+    if (!_spilled_run_paths.empty()) {
+        if (!_sorted_blocks.empty()) {
+            RETURN_IF_ERROR(spill_sorted_blocks(state));
+        }
+        return create_spill_merger(state);
+    }
 
     build_merge_tree();
     return Status::OK();
@@ -196,11 +275,161 @@ Status VSortNode::pretreat_block(doris::vectorized::Block& block) {
                 _nulls_first[i] ? -_sort_description[i].direction : _sort_description[i].direction;
     }
 
-    sort_block(block, _sort_description, _offset + _limit);
+    if (_limit != -1 && !_block_priority_queue.empty() && _num_rows_in_block >= _offset + _limit) {
+        filter_by_topn_threshold(block);
+    }
+
+    // the hash partitions are sorted when they are output
+    if (_num_partition_exprs == 0) {
+        sort_block(block, _sort_description, _offset + _limit);
+    }
 
     return Status::OK();
 }
 
+void VSortNode::filter_by_topn_threshold(Block& block) {
+    // all the kept rows are no larger than the last row of the heap top, and there
+    // are enough of them, so a row greater than it will never be output
+    const auto& threshold = _block_priority_queue.top();
+    if (threshold->rows == 0) {
+        return;
+    }
+    const size_t threshold_row = threshold->rows - 1;
+
+    std::vector<const IColumn*> sort_columns(_sort_description.size());
+    for (size_t i = 0; i < _sort_description.size(); ++i) {
+        sort_columns[i] = block.get_by_position(_sort_description[i].column_number).column.get();
+    }
+
+    const size_t rows = block.rows();
+    IColumn::Filter filter(rows, 1);
+    size_t filtered_rows = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t i = 0; i < sort_columns.size(); ++i) {
+            const auto& desc = _sort_description[i];
+            int res = desc.direction * sort_columns[i]->compare_at(row, threshold_row,
+                                                                   *threshold->sort_columns[i],
+                                                                   desc.nulls_direction);
+            if (res > 0) {
+                filter[row] = 0;
+                ++filtered_rows;
+            }
+            if (res != 0) {
+                break;
+            }
+        }
+    }
+
+    if (filtered_rows == 0) {
+        return;
+    }
+    COUNTER_UPDATE(_topn_filtered_rows, filtered_rows);
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto& column = block.get_by_position(i).column;
+        column = column->filter(filter, rows - filtered_rows);
+    }
+}
+
+void VSortNode::partition_block(const Block& block) {
+    size_t rows = block.rows();
+    if (_partition_header.columns() == 0) {
+        _partition_header = block.clone_empty();
+    }
+    size_t partition_count = _partition_columns.size();
+    IColumn::Selector selector(rows);
+    {
+        std::vector<SipHash> siphashs(rows);
+        for (int i = 0; i < _num_partition_exprs; ++i) {
+            block.get_by_position(_sort_description[i].column_number)
+                    .column->update_hashes_with_value(siphashs);
+        }
+        // The input is hash partitioned by the same exprs of the same hash function, use the
+        // high bits which are not taken by the exchange.
+        for (size_t j = 0; j < rows; ++j) {
+            selector[j] = (siphashs[j].get64() >> 32) % partition_count;
+        }
+    }
+
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto column = block.get_by_position(i).column->convert_to_full_column_if_const();
+        auto scattered = column->scatter(partition_count, selector);
+        for (size_t p = 0; p < partition_count; ++p) {
+            auto& partition = _partition_columns[p];
+            if (partition.size() <= i) {
+                partition.emplace_back(std::move(scattered[p]));
+            } else {
+                partition[i]->insert_range_from(*scattered[p], 0, scattered[p]->size());
+            }
+        }
+    }
+}
+
+Status VSortNode::partition_sort_read(Block* block, bool* eos) {
+    while (_next_partition < _partition_columns.size() &&
+           (_partition_columns[_next_partition].empty() ||
+            _partition_columns[_next_partition][0]->empty())) {
+        ++_next_partition;
+    }
+    if (_next_partition == _partition_columns.size()) {
+        *eos = true;
+        return Status::OK();
+    }
+    SCOPED_TIMER(_partition_sort_timer);
+    Block partition =
+            _partition_header.clone_with_columns(std::move(_partition_columns[_next_partition]));
+    ++_next_partition;
+    sort_block(partition, _sort_description);
+    block->swap(partition);
+    *eos = false;
+    return Status::OK();
+}
+
+void VSortNode::compact_topn_blocks() {
+    SCOPED_TIMER(_topn_compact_timer);
+    DCHECK(!_sorted_blocks.empty());
+    const size_t topn_rows = _offset + _limit;
+
+    std::vector<SortCursorImpl> cursors;
+    cursors.reserve(_sorted_blocks.size());
+    for (const auto& block : _sorted_blocks) {
+        cursors.emplace_back(block, _sort_description);
+    }
+    std::priority_queue<SortCursor> priority_queue;
+    for (auto& cursor : cursors) {
+        if (!cursor.empty()) priority_queue.push(SortCursor(&cursor));
+    }
+
+    size_t num_columns = _sorted_blocks[0].columns();
+    MutableColumns merged_columns = _sorted_blocks[0].clone_empty_columns();
+    size_t merged_rows = 0;
+    while (!priority_queue.empty() && merged_rows < topn_rows) {
+        auto current = priority_queue.top();
+        priority_queue.pop();
+
+        for (size_t i = 0; i < num_columns; ++i) {
+            merged_columns[i]->insert_from(*current->all_columns[i], current->pos);
+        }
+        ++merged_rows;
+
+        if (!current->isLast()) {
+            current->next();
+            priority_queue.push(current);
+        }
+    }
+    Block merged_block = _sorted_blocks[0].clone_with_columns(std::move(merged_columns));
+
+    _block_priority_queue = std::priority_queue<SortBlockCursor>();
+    release_sorted_blocks();
+
+    _total_mem_usage = merged_block.allocated_bytes();
+    _block_mem_tracker->consume(_total_mem_usage);
+    _num_rows_in_block = merged_rows;
+    _sorted_blocks.emplace_back(std::move(merged_block));
+    _block_priority_queue.emplace(
+            _pool->add(new SortCursorImpl(_sorted_blocks.back(), _sort_description)));
+    COUNTER_UPDATE(_topn_compactions, 1);
+}
+
 void VSortNode::build_merge_tree() {
     for (const auto& block : _sorted_blocks) {
         _cursors.emplace_back(block, _sort_description);
@@ -254,4 +483,76 @@ Status VSortNode::merge_sort_read(doris::RuntimeState* state, doris::vectorized:
     return Status::OK();
 }
 
+Status VSortNode::spill_sorted_blocks(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    DCHECK(!_sorted_blocks.empty());
+
+    std::vector<BlockSupplier> suppliers;
+    for (auto& sorted_block : _sorted_blocks) {
+        suppliers.emplace_back([block_ptr = &sorted_block, returned = false](Block** block) mutable {
+            *block = returned ? nullptr : block_ptr;
+            returned = true;
+            return Status::OK();
+        });
+    }
+    VSortedRunMerger merger(_vsort_exec_exprs.lhs_ordering_expr_ctxs(), _is_asc_order,
+                            _nulls_first, state->batch_size(), -1, 0, runtime_profile());
+    RETURN_IF_ERROR(merger.prepare(suppliers));
+
+    BlockSpillWriter writer(
+            BlockSpillWriter::gen_spill_path(state->query_id(), fmt::format("sort_{}", id())),
+            state->exec_env()->block_spill_mgr(), state->query_id());
+    RETURN_IF_ERROR(writer.open());
+    _spilled_run_paths.emplace_back(writer.path());
+
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        Block block;
+        RETURN_IF_ERROR(merger.get_next(&block, &eos));
+        RETURN_IF_ERROR(writer.write(block));
+    }
+    RETURN_IF_ERROR(writer.close());
+
+    COUNTER_UPDATE(_spill_runs, 1);
+    COUNTER_UPDATE(_spill_rows, writer.written_rows());
+    COUNTER_UPDATE(_spill_bytes, writer.written_bytes());
+    release_sorted_blocks();
+    return Status::OK();
+}
+
+Status VSortNode::create_spill_merger(RuntimeState* state) {
+    std::vector<BlockSupplier> suppliers;
+    for (const auto& path : _spilled_run_paths) {
+        auto reader = std::make_unique<BlockSpillReader>(path);
+        RETURN_IF_ERROR(reader->open());
+        _spill_readers.emplace_back(std::move(reader));
+        _spill_read_blocks.emplace_back(std::make_unique<Block>());
+
+        suppliers.emplace_back([this, reader = _spill_readers.back().get(),
+                                block_ptr = _spill_read_blocks.back().get()](Block** block) {
+            bool eos = false;
+            auto st = reader->read(block_ptr, &eos);
+            if (!st.ok()) {
+                _spill_read_status = st;
+                *block = nullptr;
+                return st;
+            }
+            *block = eos ? nullptr : block_ptr;
+            return Status::OK();
+        });
+    }
+
+    _spill_merger = std::make_unique<VSortedRunMerger>(
+            _vsort_exec_exprs.lhs_ordering_expr_ctxs(), _is_asc_order, _nulls_first,
+            state->batch_size(), _limit, _offset, runtime_profile());
+    return _spill_merger->prepare(suppliers);
+}
+
+void VSortNode::release_sorted_blocks() {
+    _sorted_blocks.clear();
+    _block_mem_tracker->release(_total_mem_usage);
+    _total_mem_usage = 0;
+}
+
 } // namespace doris::vectorized
@@ -21,15 +21,28 @@
 
 #include "exec/exec_node.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
 #include "vec/core/sort_cursor.h"
 #include "vec/exec/vsort_exec_exprs.h"
+#include "vec/runtime/vsorted_run_merger.h"
 
 namespace doris::vectorized {
 // Node that implements a full sort of its input with a fixed memory budget
 // In open() the input Block to VSortNode will sort firstly, using the expressions specified in _sort_exec_exprs.
 // In get_next(), VSortNode do the merge sort to gather data to a new block
-
-// support spill to disk in the future
+//
+// If spilling is enabled and the sorted blocks exceed `spill_sort_threshold_bytes`, they are
+// merged to a sorted run and written to disk, all the runs are merged by VSortedRunMerger
+// in get_next().
+//
+// For TOP-N, once offset + limit rows are kept, the input rows greater than the last row of
+// the heap top can never be output and are filtered before sorting. The kept blocks are
+// compacted to offset + limit rows when they reach TOPN_COMPACT_FACTOR times of that, which
+// bounds the memory and tightens the filter threshold to the exact N-th row.
+//
+// If the node sorts the input of an analytic node, which only needs the rows of every
+// partition to be consecutive and sorted, the rows are hash partitioned by the partition
+// exprs, and every hash partition is sorted and output on its own in get_next().
 class VSortNode : public doris::ExecNode {
 public:
     VSortNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -50,6 +63,11 @@ public:
 
     virtual Status close(RuntimeState* state) override;
 
+    Status open_self(RuntimeState* state) override;
+
+    // Sorts the input block, the results are ready for get_next() after the last block.
+    Status sink(RuntimeState* state, Block* block, bool eos) override;
+
 protected:
     virtual void debug_string(int indentation_level, std::stringstream* out) const override;
 
@@ -63,6 +81,29 @@ private:
 
     Status merge_sort_read(RuntimeState* state, Block* block, bool* eos);
 
+    // Merge the blocks in _sorted_blocks to a sorted run and write it to a spill file.
+    Status spill_sorted_blocks(RuntimeState* state);
+
+    // Create the merger which merges all the spilled sorted runs.
+    Status create_spill_merger(RuntimeState* state);
+
+    void release_sorted_blocks();
+
+    // Remove the rows of a TOP-N input block which are greater than the last row of the
+    // heap top, should only be called when at least offset + limit rows are kept.
+    void filter_by_topn_threshold(Block& block);
+
+    // Merge the kept TOP-N blocks to one block of offset + limit rows.
+    void compact_topn_blocks();
+
+    // Split the pretreated block into _partition_columns by the partition exprs.
+    void partition_block(const Block& block);
+
+    // Sort and output the next hash partition which is not empty.
+    Status partition_sort_read(Block* block, bool* eos);
+
+    static constexpr uint64_t TOPN_COMPACT_FACTOR = 2;
+
     // Number of rows to skip.
     int64_t _offset;
 
@@ -86,6 +127,32 @@ private:
     std::priority_queue<SortBlockCursor> _block_priority_queue;
 
     std::shared_ptr<MemTracker> _block_mem_tracker;
+
+    bool _enable_spill = false;
+    std::vector<std::string> _spilled_run_paths;
+    std::vector<BlockSpillReaderUPtr> _spill_readers;
+    std::vector<std::unique_ptr<Block>> _spill_read_blocks;
+    std::unique_ptr<VSortedRunMerger> _spill_merger;
+    // error status of reading spilled runs, the block supplier can not return it to merger
+    Status _spill_read_status;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_runs = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+    RuntimeProfile::Counter* _spill_bytes = nullptr;
+
+    // the number of the leading ordering exprs which are partition exprs, 0 if the input is not
+    // sorted by hash partitions
+    int _num_partition_exprs = 0;
+    std::vector<MutableColumns> _partition_columns;
+    // the structure of the pretreated blocks
+    Block _partition_header;
+    size_t _next_partition = 0;
+    RuntimeProfile::Counter* _partition_sort_timer = nullptr;
+
+    RuntimeProfile::Counter* _topn_filtered_rows = nullptr;
+    RuntimeProfile::Counter* _topn_compactions = nullptr;
+    RuntimeProfile::Counter* _topn_compact_timer = nullptr;
 };
 
 } // namespace doris::vectorized
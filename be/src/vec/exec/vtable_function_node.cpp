@@ -55,6 +55,7 @@ Status VTableFunctionNode::init(const TPlanNode& tnode, RuntimeState* state) {
 
 Status VTableFunctionNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(TableFunctionNode::prepare(state));
     RETURN_IF_ERROR(VExpr::prepare(_vfn_ctxs, state, _row_descriptor, expr_mem_tracker()));
 
@@ -80,10 +81,15 @@ Status VTableFunctionNode::prepare(RuntimeState* state) {
 
 Status VTableFunctionNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
 
     RETURN_IF_CANCELLED(state);
 
-    RETURN_IF_ERROR(get_expanded_block(state, block, eos));
+    if (_fn_num == 1) {
+        RETURN_IF_ERROR(get_batch_expanded_block(state, block, eos));
+    } else {
+        RETURN_IF_ERROR(get_expanded_block(state, block, eos));
+    }
 
     reached_limit(block, eos);
 
@@ -206,6 +212,70 @@ Status VTableFunctionNode::get_expanded_block(RuntimeState* state, Block* output
     return Status::OK();
 }
 
+Status VTableFunctionNode::get_batch_expanded_block(RuntimeState* state, Block* output_block,
+                                                    bool* eos) {
+    DCHECK(_child_block != nullptr);
+    DCHECK_EQ(_output_slots.size(), _child_slots.size() + 1);
+    TableFunction* fn = _fns[0];
+    output_block->clear();
+
+    while (output_block->rows() == 0) {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(state->check_query_state("VTableFunctionNode, while getting next batch."));
+
+        // if child_block is empty, get data from child.
+        if (_child_block->rows() == 0) {
+            while (_child_block->rows() == 0 && !_child_eos) {
+                RETURN_IF_ERROR(child(0)->get_next(state, _child_block.get(), &_child_eos));
+            }
+            if (_child_eos && _child_block->rows() == 0) {
+                *eos = true;
+                break;
+            }
+            RETURN_IF_ERROR(fn->process_init(_child_block.get()));
+            _cur_child_offset = 0;
+        }
+
+        const SlotDescriptor* fn_slot = _output_slots[_child_slots.size()];
+        MutableColumnPtr fn_column = fn_slot->get_empty_mutable_column();
+        IColumn::Offsets offsets;
+        size_t start = _cur_child_offset;
+        size_t end = start;
+        size_t rows = _child_block->rows();
+        RETURN_IF_ERROR(fn->process_batch(&end, rows, state->batch_size(), &offsets,
+                                          fn_column.get()));
+        DCHECK_EQ(offsets.size(), end - start);
+
+        if (!fn_column->empty()) {
+            // The tuples order in parent row batch should be
+            //      child1, child2, tf1
+            for (int i = 0; i < _child_slots.size(); i++) {
+                ColumnPtr src_column = _child_block->get_by_position(i).column;
+                if (start != 0 || end != rows) {
+                    src_column = src_column->cut(start, end - start);
+                }
+                output_block->insert({src_column->replicate(offsets),
+                                      _output_slots[i]->get_data_type_ptr(),
+                                      _output_slots[i]->col_name()});
+            }
+            output_block->insert(
+                    {std::move(fn_column), fn_slot->get_data_type_ptr(), fn_slot->col_name()});
+        }
+
+        _cur_child_offset = end;
+        if (end >= rows) {
+            RETURN_IF_ERROR(fn->process_close());
+            release_block_memory(*_child_block);
+            _cur_child_offset = -1;
+        }
+    }
+
+    RETURN_IF_ERROR(
+            VExprContext::filter_block(_vconjunct_ctx_ptr, output_block, output_block->columns()));
+
+    return Status::OK();
+}
+
 Status VTableFunctionNode::_process_next_child_row() {
     _cur_child_offset++;
 
@@ -36,6 +36,9 @@ private:
     using TableFunctionNode::get_next;
 
     Status get_expanded_block(RuntimeState* state, Block* output_block, bool* eos);
+    // With a single table function, expands a range of child rows at once and replicates the
+    // child columns by the offsets of the function result.
+    Status get_batch_expanded_block(RuntimeState* state, Block* output_block, bool* eos);
 
     std::unique_ptr<Block> _child_block;
     std::vector<SlotDescriptor*> _child_slots;
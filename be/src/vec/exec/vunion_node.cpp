@@ -62,6 +62,7 @@ Status VUnionNode::init(const TPlanNode& tnode, RuntimeState* state) {
 
 Status VUnionNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::prepare(state));
     _materialize_exprs_evaluate_timer =
             ADD_TIMER(_runtime_profile, "MaterializeExprsEvaluateTimer");
@@ -80,6 +81,7 @@ Status VUnionNode::prepare(RuntimeState* state) {
 
 Status VUnionNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::open(state));
     // open const expr lists.
     for (const std::vector<VExprContext*>& exprs : _const_expr_lists) {
@@ -214,6 +216,7 @@ Status VUnionNode::get_next_const(RuntimeState* state, Block* block) {
 
 Status VUnionNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     RETURN_IF_CANCELLED(state);
     // RETURN_IF_ERROR(QueryMaintenance(state));
@@ -18,6 +18,9 @@
 #include "vec/exprs/table_function/vexplode_bitmap.h"
 
 #include "util/bitmap_value.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
@@ -69,6 +72,41 @@ Status VExplodeBitmapTableFunction::process_close() {
     return Status::OK();
 }
 
+Status VExplodeBitmapTableFunction::process_batch(size_t* row_idx, size_t rows,
+                                                  size_t max_values, IColumn::Offsets* offsets,
+                                                  IColumn* column) {
+    IColumn* value_column = column;
+    NullMap* null_map = nullptr;
+    if (column->is_nullable()) {
+        auto* nullable_column = assert_cast<ColumnNullable*>(column);
+        value_column = &nullable_column->get_nested_column();
+        null_map = &nullable_column->get_null_map_data();
+    }
+    auto& values = assert_cast<ColumnInt64*>(value_column)->get_data();
+
+    for (; *row_idx < rows && column->size() < max_values; ++*row_idx) {
+        StringRef value = _value_column->get_data_at(*row_idx);
+        const auto* bitmap = reinterpret_cast<const BitmapValue*>(value.data);
+        size_t cardinality = value.data == nullptr ? 0 : bitmap->cardinality();
+        if (cardinality == 0) {
+            if (_is_outer) {
+                column->insert_default();
+            }
+        } else {
+            size_t size = values.size();
+            values.resize(size + cardinality);
+            for (auto it = bitmap->begin(); it != bitmap->end(); ++it) {
+                values[size++] = *it;
+            }
+            if (null_map != nullptr) {
+                null_map->resize_fill(values.size(), 0);
+            }
+        }
+        offsets->push_back(column->size());
+    }
+    return Status::OK();
+}
+
 Status VExplodeBitmapTableFunction::get_value_length(int64_t* length) {
     if (_is_current_empty) {
         *length = -1;
@@ -31,6 +31,8 @@ public:
     Status process_init(vectorized::Block* block) override;
     Status process_row(size_t row_idx) override;
     Status process_close() override;
+    Status process_batch(size_t* row_idx, size_t rows, size_t max_values,
+                         IColumn::Offsets* offsets, IColumn* column) override;
     Status get_value_length(int64_t* length) override;
 
 private:
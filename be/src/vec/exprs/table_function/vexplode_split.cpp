@@ -78,6 +78,28 @@ Status VExplodeSplitTableFunction::process_close() {
     return Status::OK();
 }
 
+Status VExplodeSplitTableFunction::process_batch(size_t* row_idx, size_t rows, size_t max_values,
+                                                 IColumn::Offsets* offsets, IColumn* column) {
+    for (; *row_idx < rows && column->size() < max_values; ++*row_idx) {
+        size_t old_size = column->size();
+        StringRef text = _text_column->get_data_at(*row_idx);
+        if (text.data != nullptr) {
+            StringRef delimiter = _delimiter_column->get_data_at(*row_idx);
+            // the pieces refer to the text, so they are inserted without a copy to _backup
+            for (StringPiece piece : strings::Split(StringPiece((char*)text.data, text.size),
+                                                    StringPiece((char*)delimiter.data,
+                                                                delimiter.size))) {
+                column->insert_data(piece.data(), piece.size());
+            }
+        }
+        if (column->size() == old_size && _is_outer) {
+            column->insert_default();
+        }
+        offsets->push_back(column->size());
+    }
+    return Status::OK();
+}
+
 Status VExplodeSplitTableFunction::get_value(void** output) {
     if (_is_current_empty) {
         *output = nullptr;
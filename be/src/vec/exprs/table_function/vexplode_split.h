@@ -33,6 +33,8 @@ public:
     virtual Status process_init(vectorized::Block* block) override;
     virtual Status process_row(size_t row_idx) override;
     virtual Status process_close() override;
+    virtual Status process_batch(size_t* row_idx, size_t rows, size_t max_values,
+                                 IColumn::Offsets* offsets, IColumn* column) override;
     virtual Status get_value(void** output) override;
     virtual Status get_value_length(int64_t* length) override;
 
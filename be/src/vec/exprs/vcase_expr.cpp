@@ -17,6 +17,7 @@
 
 #include "vec/exprs/vcase_expr.h"
 
+#include "common/config.h"
 #include "vec/columns/column_nullable.h"
 
 namespace doris::vectorized {
@@ -92,13 +93,17 @@ void VCaseExpr::close(RuntimeState* state, VExprContext* context,
 Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
     ColumnNumbers arguments(_children.size());
 
-    for (int i = 0; i < _children.size(); i++) {
-        int column_id = -1;
-        _children[i]->execute(context, block, &column_id);
-        arguments[i] = column_id;
-
-        block->replace_by_position_if_const(column_id);
-        auto child_column = block->get_by_position(column_id).column;
+    // the constant exprs are executed on an empty block
+    if (!_has_case_expr && block->rows() > 0) {
+        RETURN_IF_ERROR(_execute_short_circuit(context, block, &arguments));
+    } else {
+        for (int i = 0; i < _children.size(); i++) {
+            int column_id = -1;
+            _children[i]->execute(context, block, &column_id);
+            arguments[i] = column_id;
+
+            block->replace_by_position_if_const(column_id);
+        }
     }
 
     size_t num_columns_without_result = block->columns();
@@ -111,6 +116,99 @@ Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_colum
     return Status::OK();
 }
 
+Status VCaseExpr::_execute_short_circuit(VExprContext* context, Block* block,
+                                         ColumnNumbers* arguments) {
+    const size_t rows = block->rows();
+    // the rows no WHEN has matched yet
+    IColumn::Filter remaining(rows, 1);
+    size_t remaining_rows = rows;
+    IColumn::Filter matched(rows);
+    const size_t then_end = _children.size() - _has_else_expr;
+    for (size_t i = 0; i < then_end; i += 2) {
+        int when_id = -1;
+        RETURN_IF_ERROR(_execute_on_rows(context, block, i, remaining, remaining_rows, &when_id));
+        (*arguments)[i] = when_id;
+
+        size_t matched_rows = 0;
+        if (remaining_rows > 0) {
+            const UInt8* when_data = nullptr;
+            const UInt8* when_null_map = nullptr;
+            if (!get_bool_data(*block->get_by_position(when_id).column, &when_data,
+                               &when_null_map)) {
+                return Status::InternalError(fmt::format(
+                        "Illegal column {} of WHEN",
+                        block->get_by_position(when_id).column->get_name()));
+            }
+            for (size_t row = 0; row < rows; ++row) {
+                bool is_true = when_data[row] && (when_null_map == nullptr || !when_null_map[row]);
+                matched[row] = remaining[row] && is_true;
+                remaining[row] &= !matched[row];
+                matched_rows += matched[row];
+            }
+            remaining_rows -= matched_rows;
+        }
+
+        int then_id = -1;
+        RETURN_IF_ERROR(_execute_on_rows(context, block, i + 1, matched, matched_rows, &then_id));
+        (*arguments)[i + 1] = then_id;
+    }
+    if (_has_else_expr) {
+        int else_id = -1;
+        RETURN_IF_ERROR(_execute_on_rows(context, block, _children.size() - 1, remaining,
+                                         remaining_rows, &else_id));
+        arguments->back() = else_id;
+    }
+    return Status::OK();
+}
+
+Status VCaseExpr::_execute_on_rows(VExprContext* context, Block* block, size_t child_idx,
+                                   const IColumn::Filter& filter, size_t selected_rows,
+                                   int* column_id) {
+    auto* child = _children[child_idx];
+    const size_t rows = block->rows();
+    if (selected_rows == 0) {
+        block->insert({child->data_type()->create_column_const_with_default_value(rows)
+                               ->convert_to_full_column_if_const(),
+                       child->data_type(), child->expr_name()});
+        *column_id = block->columns() - 1;
+        return Status::OK();
+    }
+    if (selected_rows > rows * config::short_circuit_evaluation_max_ratio) {
+        RETURN_IF_ERROR(child->execute(context, block, column_id));
+        block->replace_by_position_if_const(*column_id);
+        return Status::OK();
+    }
+
+    ColumnPtr selected;
+    RETURN_IF_ERROR(
+            execute_on_selected_rows(child, context, block, filter, selected_rows, &selected));
+    auto column = child->data_type()->create_column();
+    if (column->is_nullable() != selected->is_nullable()) {
+        selected = make_nullable(selected);
+        if (!column->is_nullable()) {
+            return Status::InternalError(fmt::format("Illegal column {} of {}",
+                                                     selected->get_name(), child->expr_name()));
+        }
+    }
+    // expand the selected rows back to the rows of the block
+    column->reserve(rows);
+    for (size_t row = 0, selected_row = 0; row < rows;) {
+        if (filter[row]) {
+            column->insert_from(*selected, selected_row++);
+            ++row;
+        } else {
+            size_t begin = row;
+            while (row < rows && !filter[row]) {
+                ++row;
+            }
+            column->insert_many_defaults(row - begin);
+        }
+    }
+    block->insert({std::move(column), child->data_type(), child->expr_name()});
+    *column_id = block->columns() - 1;
+    return Status::OK();
+}
+
 const std::string& VCaseExpr::expr_name() const {
     return _expr_name;
 }
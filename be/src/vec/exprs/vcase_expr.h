@@ -40,6 +40,13 @@ public:
     virtual const std::string& expr_name() const override;
 
 private:
+    // Executes the WHEN and THEN children of a CASE without case expr only on the rows
+    // reaching them, the other rows get default values.
+    Status _execute_short_circuit(VExprContext* context, Block* block,
+                                  ColumnNumbers* arguments);
+    Status _execute_on_rows(VExprContext* context, Block* block, size_t child_idx,
+                            const IColumn::Filter& filter, size_t selected_rows, int* column_id);
+
     bool _is_prepare;
     bool _has_case_expr;
     bool _has_else_expr;
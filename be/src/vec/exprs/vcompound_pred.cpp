@@ -0,0 +1,116 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vcompound_pred.h"
+
+#include <fmt/format.h>
+
+#include "common/config.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+Status VcompoundPred::execute(VExprContext* context, Block* block, int* result_column_id) {
+    // the constant exprs are executed on an empty block
+    if (_children.size() != 2 || block->rows() == 0) {
+        return VectorizedFnCall::execute(context, block, result_column_id);
+    }
+    if (find_reusable_result(block, result_column_id)) {
+        return Status::OK();
+    }
+    const bool is_and = _fn.name.function_name == "and";
+    const size_t rows = block->rows();
+
+    int lhs_id = -1;
+    RETURN_IF_ERROR(_children[0]->execute(context, block, &lhs_id));
+    ColumnPtr lhs = block->get_by_position(lhs_id).column->convert_to_full_column_if_const();
+    const UInt8* lhs_data = nullptr;
+    const UInt8* lhs_null_map = nullptr;
+    if (lhs->size() != rows || !get_bool_data(*lhs, &lhs_data, &lhs_null_map)) {
+        return VectorizedFnCall::execute(context, block, result_column_id);
+    }
+
+    // false decides AND, true decides OR, null decides neither
+    IColumn::Filter undecided(rows);
+    size_t undecided_rows = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        bool is_null = lhs_null_map != nullptr && lhs_null_map[i];
+        undecided[i] = is_null || (lhs_data[i] != 0) == is_and;
+        undecided_rows += undecided[i];
+    }
+
+    ColumnPtr rhs;
+    const UInt8* rhs_data = nullptr;
+    const UInt8* rhs_null_map = nullptr;
+    // the rhs has only the undecided rows
+    bool is_rhs_selected = false;
+    if (undecided_rows > 0) {
+        if (undecided_rows <= rows * config::short_circuit_evaluation_max_ratio) {
+            RETURN_IF_ERROR(execute_on_selected_rows(_children[1], context, block, undecided,
+                                                     undecided_rows, &rhs));
+            is_rhs_selected = true;
+        } else {
+            int rhs_id = -1;
+            RETURN_IF_ERROR(_children[1]->execute(context, block, &rhs_id));
+            rhs = block->get_by_position(rhs_id).column->convert_to_full_column_if_const();
+        }
+        if (!get_bool_data(*rhs, &rhs_data, &rhs_null_map)) {
+            return Status::InternalError(fmt::format("Illegal column {} of the right side of {}",
+                                                     rhs->get_name(), _expr_name));
+        }
+    }
+
+    auto res = ColumnUInt8::create(rows);
+    auto res_null_map = ColumnUInt8::create(rows, 0);
+    auto* __restrict res_data = res->get_data().data();
+    auto* __restrict res_null = res_null_map->get_data().data();
+    for (size_t i = 0, j = 0; i < rows; ++i) {
+        if (!undecided[i]) {
+            res_data[i] = !is_and;
+            continue;
+        }
+        size_t rhs_row = is_rhs_selected ? j++ : i;
+        bool rhs_value = rhs_data[rhs_row] != 0;
+        bool rhs_is_null = rhs_null_map != nullptr && rhs_null_map[rhs_row];
+        if (lhs_null_map == nullptr || !lhs_null_map[i]) {
+            // true AND rhs, false OR rhs
+            res_data[i] = rhs_value;
+            res_null[i] = rhs_is_null;
+        } else if (!rhs_is_null && rhs_value != is_and) {
+            // null AND false, null OR true
+            res_data[i] = !is_and;
+        } else {
+            res_data[i] = 0;
+            res_null[i] = 1;
+        }
+    }
+
+    ColumnPtr result;
+    if (_data_type->is_nullable()) {
+        result = ColumnNullable::create(std::move(res), std::move(res_null_map));
+    } else {
+        DCHECK(lhs_null_map == nullptr && rhs_null_map == nullptr);
+        result = std::move(res);
+    }
+    block->insert({result, _data_type, _result_name});
+    *result_column_id = block->columns() - 1;
+    mark_reusable_result(block, *result_column_id);
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -38,5 +38,12 @@ public:
             break;
         }
     }
+
+    virtual VExpr* clone(ObjectPool* pool) const override {
+        return pool->add(new VcompoundPred(*this));
+    }
+
+    // Executes the right side of AND / OR only on the rows the left side does not decide.
+    virtual Status execute(VExprContext* context, Block* block, int* result_column_id) override;
 };
 } // namespace doris::vectorized
@@ -22,6 +22,7 @@
 #include "runtime/descriptors.h"
 #include "vec/aggregate_functions/aggregate_function_java_udaf.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/aggregate_functions/aggregate_function_sort.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/core/materialize_block.h"
 #include "vec/data_types/data_type_factory.hpp"
@@ -44,6 +45,24 @@ AggFnEvaluator::AggFnEvaluator(const TExprNode& desc)
         nullable = desc.is_nullable;
     }
     _data_type = DataTypeFactory::instance().create_data_type(_return_type, nullable);
+
+    if (desc.agg_expr.__isset.param_types) {
+        for (const auto& param_type : desc.agg_expr.param_types) {
+            _param_types.push_back(DataTypeFactory::instance().create_data_type(
+                    TypeDescriptor::from_thrift(param_type), true));
+        }
+        size_t num_keys = desc.agg_expr.is_asc_order.size();
+        DCHECK_EQ(num_keys, desc.agg_expr.nulls_first.size());
+        DCHECK_LE(num_keys, _param_types.size());
+        _sort_description.resize(num_keys);
+        for (size_t i = 0; i < num_keys; ++i) {
+            _sort_description[i].column_number = _param_types.size() - num_keys + i;
+            _sort_description[i].direction = desc.agg_expr.is_asc_order[i] ? 1 : -1;
+            _sort_description[i].nulls_direction = desc.agg_expr.nulls_first[i]
+                                                           ? -_sort_description[i].direction
+                                                           : _sort_description[i].direction;
+        }
+    }
 }
 
 Status AggFnEvaluator::create(ObjectPool* pool, const TExpr& desc, AggFnEvaluator** result) {
@@ -87,7 +106,16 @@ Status AggFnEvaluator::prepare(RuntimeState* state, const RowDescriptor& desc, M
         child_expr_name.emplace_back(_input_exprs_ctxs[i]->root()->expr_name());
     }
 
-    if (_fn.binary_type == TFunctionBinaryType::JAVA_UDF) {
+    if (!_sort_description.empty()) {
+        // the arguments of the merge phase are the serialized states, so the types of the
+        // buffered rows come from the plan
+        DataTypes nested_types(_param_types.begin(),
+                               _param_types.end() - _sort_description.size());
+        auto nested_function = AggregateFunctionSimpleFactory::instance().get(
+                _fn.name.function_name, nested_types, params, _data_type->is_nullable());
+        _function = AggregateFunctionSort::create(nested_function, _param_types,
+                                                  _sort_description);
+    } else if (_fn.binary_type == TFunctionBinaryType::JAVA_UDF) {
 #ifdef LIBJVM
         _function = AggregateJavaUdaf::create(_fn, argument_types, params, _data_type);
 #else
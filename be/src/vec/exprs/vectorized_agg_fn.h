@@ -20,6 +20,7 @@
 #include "util/runtime_profile.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/core/block.h"
+#include "vec/core/sort_description.h"
 #include "vec/data_types/data_type.h"
 #include "vec/exprs/vexpr_context.h"
 
@@ -64,9 +65,14 @@ public:
     DataTypePtr& data_type() { return _data_type; }
 
     const AggregateFunctionPtr& function() { return _function; }
+    // replace the function by one of the same result, before any state is created
+    void set_function(AggregateFunctionPtr function) { _function = std::move(function); }
     static std::string debug_string(const std::vector<AggFnEvaluator*>& exprs);
     std::string debug_string() const;
     bool is_merge() const { return _is_merge; }
+    bool is_java_udaf() const { return _fn.binary_type == TFunctionBinaryType::JAVA_UDF; }
+
+    const std::vector<VExprContext*>& input_exprs_ctxs() const { return _input_exprs_ctxs; }
 
 private:
     const TFunction _fn;
@@ -97,6 +103,10 @@ private:
     std::string _expr_name;
 
     std::vector<const IColumn*> _agg_columns;
+
+    // set for the aggregations with ORDER BY, the sort keys are the last params
+    DataTypes _param_types;
+    SortDescription _sort_description;
 };
 } // namespace vectorized
 
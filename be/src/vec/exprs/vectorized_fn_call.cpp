@@ -19,11 +19,13 @@
 
 #include <string_view>
 
+#include "common/config.h"
 #include "exprs/anyval_util.h"
 #include "exprs/rpc_fn.h"
 #include "fmt/format.h"
 #include "fmt/ranges.h"
 #include "udf/udf_internal.h"
+#include "vec/columns/column_const.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/functions/function_java_udf.h"
@@ -63,6 +65,9 @@ doris::Status VectorizedFnCall::prepare(doris::RuntimeState* state,
     }
     VExpr::register_function_context(state, context);
     _expr_name = fmt::format("{}({})", _fn.name.function_name, child_expr_name);
+    _result_name = _fingerprint == 0 ? _expr_name
+                                     : fmt::format("{}#{:016x}", _expr_name, _fingerprint);
+    _fused_program = FusedExprProgram::create(this);
 
     return Status::OK();
 }
@@ -71,9 +76,35 @@ doris::Status VectorizedFnCall::open(doris::RuntimeState* state, VExprContext* c
                                      FunctionContext::FunctionStateScope scope) {
     RETURN_IF_ERROR(VExpr::open(state, context, scope));
     RETURN_IF_ERROR(VExpr::init_function_context(context, scope, _function));
+    if (scope == FunctionContext::FRAGMENT_LOCAL) {
+        fold_constant(context);
+    }
     return Status::OK();
 }
 
+void VectorizedFnCall::fold_constant(VExprContext* context) {
+    // a call without arguments, e.g. now(), is evaluated on no rows
+    if (_fingerprint == 0 || _children.empty() || !is_constant()) {
+        return;
+    }
+    Block block;
+    int result = -1;
+    Status st = execute(context, &block, &result);
+    if (!st.ok()) {
+        // the error is reported when the call is executed on the data
+        VLOG_DEBUG << "failed to fold " << _expr_name << ": " << st.get_error_msg();
+        return;
+    }
+    ColumnPtr column = block.get_by_position(result).column;
+    if (column == nullptr || column->size() == 0) {
+        return;
+    }
+    if (!is_column_const(*column)) {
+        column = ColumnConst::create(column->cut(0, 1), 1);
+    }
+    _folded_column = std::move(column);
+}
+
 void VectorizedFnCall::close(doris::RuntimeState* state, VExprContext* context,
                              FunctionContext::FunctionStateScope scope) {
     VExpr::close_function_context(context, scope, _function);
@@ -82,7 +113,24 @@ void VectorizedFnCall::close(doris::RuntimeState* state, VExprContext* context,
 
 doris::Status VectorizedFnCall::execute(VExprContext* context, doris::vectorized::Block* block,
                                         int* result_column_id) {
-    // TODO: not execute const expr again, but use the const column in function context
+    if (_folded_column != nullptr) {
+        // literal expr should return least one row, so does the folded call
+        size_t row_size = std::max(block->rows(), size_t(1));
+        *result_column_id =
+                VExpr::insert_param(block, {_folded_column, _data_type, _result_name}, row_size);
+        return Status::OK();
+    }
+    if (find_reusable_result(block, result_column_id)) {
+        return Status::OK();
+    }
+    if (_fused_program != nullptr) {
+        ColumnPtr column;
+        RETURN_IF_ERROR(_fused_program->execute(context, block, &column));
+        block->insert({std::move(column), _data_type, _result_name});
+        *result_column_id = block->columns() - 1;
+        mark_reusable_result(block, *result_column_id);
+        return Status::OK();
+    }
     doris::vectorized::ColumnNumbers arguments(_children.size());
     for (int i = 0; i < _children.size(); ++i) {
         int column_id = -1;
@@ -92,13 +140,36 @@ doris::Status VectorizedFnCall::execute(VExprContext* context, doris::vectorized
     // call function
     size_t num_columns_without_result = block->columns();
     // prepare a column to save result
-    block->insert({nullptr, _data_type, _expr_name});
+    block->insert({nullptr, _data_type, _result_name});
     RETURN_IF_ERROR(_function->execute(context->fn_context(_fn_context_index), *block, arguments,
                                        num_columns_without_result, block->rows(), false));
     *result_column_id = num_columns_without_result;
+    mark_reusable_result(block, *result_column_id);
     return Status::OK();
 }
 
+bool VectorizedFnCall::find_reusable_result(Block* block, int* result_column_id) const {
+    if (_fingerprint == 0 || !config::enable_expr_result_reuse ||
+        !block->is_reusable_result(_result_name) || !block->has(_result_name)) {
+        return false;
+    }
+    // an identical call has been executed on the batch of the block, the column is filtered
+    // along with the others, a column whose rows have been cut has a different size
+    size_t position = block->get_position_by_name(_result_name);
+    const auto& column = block->get_by_position(position).column;
+    if (column == nullptr || column->size() != block->rows()) {
+        return false;
+    }
+    *result_column_id = position;
+    return true;
+}
+
+void VectorizedFnCall::mark_reusable_result(Block* block, int result_column_id) const {
+    if (_fingerprint != 0 && config::enable_expr_result_reuse) {
+        block->mark_reusable_result(result_column_id);
+    }
+}
+
 const std::string& VectorizedFnCall::expr_name() const {
     return _expr_name;
 }
@@ -18,6 +18,7 @@
 #pragma once
 #include "runtime/runtime_state.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_fusion.h"
 #include "vec/functions/function.h"
 
 namespace doris::vectorized {
@@ -39,8 +40,27 @@ public:
     virtual std::string debug_string() const override;
     static std::string debug_string(const std::vector<VectorizedFnCall*>& exprs);
 
-private:
+protected:
+    // Returns true and sets *result_column_id if an identical call has been executed on
+    // the block.
+    bool find_reusable_result(Block* block, int* result_column_id) const;
+
+    // Marks the result column of the call in the block to be found by the identical calls
+    // until the block is cleared for the next batch.
+    void mark_reusable_result(Block* block, int result_column_id) const;
+
+    // Evaluates a deterministic call of constant arguments once when the expr is opened,
+    // the later executions only insert the result. Nothing is folded if it fails.
+    void fold_constant(VExprContext* context);
+
     FunctionBasePtr _function;
     std::string _expr_name;
+    // The name of the result column in the block, with the fingerprint if it is not 0, so
+    // that the identical calls of the node find the result by it and reuse it.
+    std::string _result_name;
+    // The ColumnConst of the folded call, nullptr if the call is not folded.
+    ColumnPtr _folded_column;
+    // Set if the tree of the call is evaluated by a fused program, shared by the clones.
+    std::shared_ptr<const FusedExprProgram> _fused_program;
 };
 } // namespace doris::vectorized
@@ -24,6 +24,9 @@
 
 #include "exprs/anyval_util.h"
 #include "gen_cpp/Exprs_types.h"
+#include "util/hash_util.hpp"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/exprs/varray_literal.h"
 #include "vec/exprs/vcase_expr.h"
@@ -158,7 +161,8 @@ Status VExpr::create_tree_from_thrift(doris::ObjectPool* pool,
     if (*node_idx >= nodes.size()) {
         return Status::InternalError("Failed to reconstruct expression tree from thrift.");
     }
-    int num_children = nodes[*node_idx].num_children;
+    int expr_idx = *node_idx;
+    int num_children = nodes[expr_idx].num_children;
     VExpr* expr = nullptr;
     RETURN_IF_ERROR(create_expr(pool, nodes[*node_idx], &expr));
     DCHECK(expr != nullptr);
@@ -179,9 +183,32 @@ Status VExpr::create_tree_from_thrift(doris::ObjectPool* pool,
             return Status::InternalError("Failed to reconstruct expression tree from thrift.");
         }
     }
+    expr->init_fingerprint(nodes[expr_idx]);
     return Status::OK();
 }
 
+void VExpr::init_fingerprint(const TExprNode& node) {
+    _fingerprint = 0;
+    if (node.__isset.fn) {
+        // the same non-deterministic functions as the FE
+        const auto& name = node.fn.name.function_name;
+        if (node.fn.binary_type != TFunctionBinaryType::BUILTIN || name == "rand" ||
+            name == "random" || name == "uuid" || name == "sleep") {
+            return;
+        }
+    }
+    // the node holds the slot ids, the literal values, the function and the result type
+    std::string node_string = apache::thrift::ThriftDebugString(node);
+    uint64_t hash = HashUtil::hash64(node_string.data(), node_string.size(), 0);
+    for (auto child : _children) {
+        if (child->_fingerprint == 0) {
+            return;
+        }
+        hash = HashUtil::hash64(&child->_fingerprint, sizeof(child->_fingerprint), hash);
+    }
+    _fingerprint = hash == 0 ? 1 : hash;
+}
+
 Status VExpr::create_expr_tree(doris::ObjectPool* pool, const doris::TExpr& texpr,
                                VExprContext** ctx) {
     if (texpr.nodes.size() == 0) {
@@ -314,6 +341,41 @@ ColumnPtrWrapper* VExpr::get_const_col(VExprContext* context) {
     return _constant_col.get();
 }
 
+Status VExpr::execute_on_selected_rows(VExpr* expr, VExprContext* context, Block* block,
+                                       const IColumn::Filter& filter, size_t selected_rows,
+                                       ColumnPtr* result) {
+    DCHECK_EQ(filter.size(), block->rows());
+    // keep the positions of the columns for the slot refs
+    Block selected_block;
+    for (const auto& column : *block) {
+        if (column.column == nullptr || column.column->size() != filter.size()) {
+            selected_block.insert(column);
+        } else {
+            selected_block.insert(
+                    {column.column->filter(filter, selected_rows), column.type, column.name});
+        }
+    }
+    int column_id = -1;
+    RETURN_IF_ERROR(expr->execute(context, &selected_block, &column_id));
+    *result = selected_block.get_by_position(column_id).column->convert_to_full_column_if_const();
+    return Status::OK();
+}
+
+bool VExpr::get_bool_data(const IColumn& column, const UInt8** data, const UInt8** null_map) {
+    const IColumn* nested = &column;
+    *null_map = nullptr;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(column)) {
+        nested = &nullable->get_nested_column();
+        *null_map = nullable->get_null_map_data().data();
+    }
+    const auto* bool_column = check_and_get_column<ColumnUInt8>(*nested);
+    if (bool_column == nullptr) {
+        return false;
+    }
+    *data = bool_column->get_data().data();
+    return true;
+}
+
 void VExpr::register_function_context(doris::RuntimeState* state, VExprContext* context) {
     FunctionContext::TypeDesc return_type = AnyValUtil::column_type_to_type_desc(_type);
     std::vector<FunctionContext::TypeDesc> arg_types;
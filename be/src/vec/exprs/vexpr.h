@@ -131,6 +131,10 @@ public:
     /// the children are constant.
     virtual bool is_constant() const;
 
+    /// Identifies the result of a deterministic expr tree created from thrift, identical
+    /// trees have the same fingerprint. 0 if the tree is not deterministic.
+    uint64_t fingerprint() const { return _fingerprint; }
+
     /// If this expr is constant, evaluates the expr with no input row argument and returns
     /// the output. Returns nullptr if the argument is not constant. The returned ColumnPtr is
     /// owned by this expr. This should only be called after Open() has been called on this
@@ -161,6 +165,20 @@ protected:
     void close_function_context(VExprContext* context, FunctionContext::FunctionStateScope scope,
                                 const FunctionBasePtr& function) const;
 
+    /// Called when the tree is created from thrift after the children are created.
+    void init_fingerprint(const TExprNode& node);
+
+    /// Executes expr only on the rows of block selected by filter, which are copied out of
+    /// the block. *result is a full column of the selected rows.
+    static Status execute_on_selected_rows(VExpr* expr, VExprContext* context, Block* block,
+                                           const IColumn::Filter& filter, size_t selected_rows,
+                                           ColumnPtr* result);
+
+    /// Gets the data and the null map (nullptr if not nullable) of a full boolean column.
+    /// Returns false if the column is not of UInt8.
+    static bool get_bool_data(const IColumn& column, const UInt8** data,
+                              const UInt8** null_map);
+
     TExprNodeType::type _node_type;
     TypeDescriptor _type;
     DataTypePtr _data_type;
@@ -175,6 +193,8 @@ protected:
     // If this expr is constant, this will store and cache the value generated by
     // get_const_col()
     std::shared_ptr<ColumnPtrWrapper> _constant_col;
+
+    uint64_t _fingerprint = 0;
 };
 
 } // namespace vectorized
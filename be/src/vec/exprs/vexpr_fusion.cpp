@@ -0,0 +1,235 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vexpr_fusion.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/columns_number.h"
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+bool is_fusable_type(const DataTypePtr& type, TypeIndex type_index) {
+    return type != nullptr && type->get_type_id() == type_index;
+}
+
+template <typename T, typename R, typename F>
+void apply_binary(const T* a, const T* b, R* c, size_t size, F f) {
+    for (size_t i = 0; i < size; ++i) {
+        c[i] = f(a[i], b[i]);
+    }
+}
+
+} // namespace
+
+std::unique_ptr<FusedExprProgram> FusedExprProgram::create(VExpr* root) {
+    if (config::expr_fusion_min_operators <= 0 || root->children().size() != 2) {
+        return nullptr;
+    }
+    // the operands of the root call decide the type, it is checked again for every call
+    TypeIndex type = root->children()[0]->data_type()->get_type_id();
+    if (type != TypeIndex::Int64 && type != TypeIndex::Float64) {
+        return nullptr;
+    }
+    std::unique_ptr<FusedExprProgram> program(new FusedExprProgram(type));
+    if (!program->_compile(root, true, 1) ||
+        program->_num_operators < config::expr_fusion_min_operators) {
+        return nullptr;
+    }
+    return program;
+}
+
+bool FusedExprProgram::_compile(VExpr* expr, bool is_root, int depth) {
+    static const std::unordered_map<std::string, OpCode> op_codes = {
+            {"add", OpCode::ADD}, {"subtract", OpCode::SUBTRACT}, {"multiply", OpCode::MULTIPLY},
+            {"eq", OpCode::EQ},   {"ne", OpCode::NE},             {"lt", OpCode::LT},
+            {"le", OpCode::LE},   {"gt", OpCode::GT},             {"ge", OpCode::GE}};
+
+    auto node_type = expr->node_type();
+    bool is_call = node_type == TExprNodeType::ARITHMETIC_EXPR ||
+                   node_type == TExprNodeType::BINARY_PRED ||
+                   node_type == TExprNodeType::FUNCTION_CALL ||
+                   node_type == TExprNodeType::COMPUTE_FUNCTION_CALL;
+    auto it = op_codes.end();
+    if (is_call && expr->fn().binary_type == TFunctionBinaryType::BUILTIN &&
+        expr->children().size() == 2) {
+        it = op_codes.find(expr->fn().name.function_name);
+    }
+    if (it != op_codes.end()) {
+        OpCode code = it->second;
+        bool is_comparison = code >= OpCode::EQ;
+        // a comparison is only fused at the root, its result is of another type
+        bool fusable = (!is_comparison || is_root) &&
+                       is_fusable_type(expr->data_type(),
+                                       is_comparison ? TypeIndex::UInt8 : _type) &&
+                       is_fusable_type(expr->children()[0]->data_type(), _type) &&
+                       is_fusable_type(expr->children()[1]->data_type(), _type);
+        if (fusable) {
+            if (!_compile(expr->children()[0], false, depth) ||
+                !_compile(expr->children()[1], false, depth + 1)) {
+                return false;
+            }
+            _ops.push_back({code});
+            _is_comparison = is_comparison;
+            ++_num_operators;
+            return true;
+        }
+    }
+    if (is_root || !is_fusable_type(expr->data_type(), _type)) {
+        return false;
+    }
+    _max_depth = std::max(_max_depth, size_t(depth));
+    _ops.push_back({OpCode::LOAD, static_cast<int>(_leaves.size())});
+    _leaves.push_back(expr);
+    return true;
+}
+
+Status FusedExprProgram::execute(VExprContext* context, Block* block, ColumnPtr* result) const {
+    switch (_type) {
+    case TypeIndex::Int64:
+        return _execute<Int64>(context, block, result);
+    case TypeIndex::Float64:
+        return _execute<Float64>(context, block, result);
+    default:
+        return Status::InternalError(fmt::format("Unsupported type {} of fused expr",
+                                                 getTypeName(_type)));
+    }
+}
+
+template <typename T>
+Status FusedExprProgram::_execute(VExprContext* context, Block* block, ColumnPtr* result) const {
+    std::vector<LeafData<T>> leaves(_leaves.size());
+    std::vector<ColumnPtr> leaf_columns(_leaves.size());
+    for (size_t i = 0; i < _leaves.size(); ++i) {
+        int column_id = -1;
+        RETURN_IF_ERROR(_leaves[i]->execute(context, block, &column_id));
+        leaf_columns[i] = block->get_by_position(column_id).column;
+    }
+    size_t rows = block->rows();
+    for (size_t i = 0; i < _leaves.size(); ++i) {
+        const IColumn* column = leaf_columns[i].get();
+        if (const auto* const_column = check_and_get_column<ColumnConst>(column)) {
+            const auto& nested = const_column->get_data_column();
+            if (const auto* data = check_and_get_column<ColumnVector<T>>(nested)) {
+                leaves[i].value = data->get_element(0);
+                continue;
+            }
+        } else if (const auto* data = check_and_get_column<ColumnVector<T>>(column)) {
+            if (data->size() >= rows) {
+                leaves[i].data = data->get_data().data();
+                continue;
+            }
+        }
+        return Status::InternalError(fmt::format("Illegal column {} of {} in fused expr",
+                                                 column->get_name(), _leaves[i]->expr_name()));
+    }
+
+    MutableColumnPtr result_column;
+    T* values = nullptr;
+    UInt8* flags = nullptr;
+    if (_is_comparison) {
+        auto column = ColumnUInt8::create(rows);
+        flags = column->get_data().data();
+        result_column = std::move(column);
+    } else {
+        auto column = ColumnVector<T>::create(rows);
+        values = column->get_data().data();
+        result_column = std::move(column);
+    }
+
+    // the constants are broadcast to a tile once
+    std::vector<std::vector<T>> constants(_leaves.size());
+    for (size_t i = 0; i < _leaves.size(); ++i) {
+        if (leaves[i].data == nullptr) {
+            constants[i].assign(TILE_SIZE, leaves[i].value);
+        }
+    }
+    std::vector<T> buffers(_max_depth * TILE_SIZE);
+    std::vector<const T*> registers(_max_depth);
+    for (size_t start = 0; start < rows; start += TILE_SIZE) {
+        size_t size = std::min(TILE_SIZE, rows - start);
+        size_t top = 0;
+        for (size_t i = 0; i < _ops.size(); ++i) {
+            const Op& op = _ops[i];
+            if (op.code == OpCode::LOAD) {
+                const auto& leaf = leaves[op.leaf];
+                registers[top++] =
+                        leaf.data == nullptr ? constants[op.leaf].data() : leaf.data + start;
+                continue;
+            }
+            const T* a = registers[top - 2];
+            const T* b = registers[top - 1];
+            --top;
+            if (_is_comparison) {
+                // the comparison is the last op
+                UInt8* dst = flags + start;
+                switch (op.code) {
+                case OpCode::EQ:
+                    apply_binary(a, b, dst, size, [](T x, T y) -> UInt8 { return x == y; });
+                    break;
+                case OpCode::NE:
+                    apply_binary(a, b, dst, size, [](T x, T y) -> UInt8 { return x != y; });
+                    break;
+                case OpCode::LT:
+                    apply_binary(a, b, dst, size, [](T x, T y) -> UInt8 { return x < y; });
+                    break;
+                case OpCode::LE:
+                    apply_binary(a, b, dst, size, [](T x, T y) -> UInt8 { return x <= y; });
+                    break;
+                case OpCode::GT:
+                    apply_binary(a, b, dst, size, [](T x, T y) -> UInt8 { return x > y; });
+                    break;
+                case OpCode::GE:
+                    apply_binary(a, b, dst, size, [](T x, T y) -> UInt8 { return x >= y; });
+                    break;
+                default:
+                    break;
+                }
+                continue;
+            }
+            // the last op writes the result, the others the buffer of the left operand's slot
+            T* dst = i + 1 == _ops.size() ? values + start : buffers.data() + (top - 1) * TILE_SIZE;
+            switch (op.code) {
+            case OpCode::ADD:
+                apply_binary(a, b, dst, size, [](T x, T y) -> T { return x + y; });
+                break;
+            case OpCode::SUBTRACT:
+                apply_binary(a, b, dst, size, [](T x, T y) -> T { return x - y; });
+                break;
+            case OpCode::MULTIPLY:
+                apply_binary(a, b, dst, size, [](T x, T y) -> T { return x * y; });
+                break;
+            default:
+                break;
+            }
+            registers[top - 1] = dst;
+        }
+    }
+    *result = std::move(result_column);
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+#include "vec/core/block.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+class VExpr;
+class VExprContext;
+
+// Evaluates a tree of add, subtract and multiply calls, optionally under a comparison, in
+// one pass. The rows are processed in tiles small enough for the intermediate values to
+// stay in the cache, instead of materializing a column for every call. The subtrees which
+// are not fused, e.g. slot refs, literals and casts, are the leaves and executed as usual.
+class FusedExprProgram {
+public:
+    // Returns nullptr if root can not be fused or has less operators than
+    // config::expr_fusion_min_operators.
+    static std::unique_ptr<FusedExprProgram> create(VExpr* root);
+
+    // Executes the leaves on block and sets *result to the full result column.
+    Status execute(VExprContext* context, Block* block, ColumnPtr* result) const;
+
+    size_t num_operators() const { return _num_operators; }
+
+private:
+    enum class OpCode : uint8_t { LOAD, ADD, SUBTRACT, MULTIPLY, EQ, NE, LT, LE, GT, GE };
+
+    struct Op {
+        OpCode code;
+        // the index of the leaf, only for LOAD
+        int leaf = -1;
+    };
+
+    // The values of a leaf for one block, a full column or a constant.
+    template <typename T>
+    struct LeafData {
+        const T* data = nullptr;
+        T value {};
+    };
+
+    static constexpr size_t TILE_SIZE = 256;
+
+    FusedExprProgram(TypeIndex type) : _type(type) {}
+
+    bool _compile(VExpr* expr, bool is_root, int depth);
+
+    template <typename T>
+    Status _execute(VExprContext* context, Block* block, ColumnPtr* result) const;
+
+    // The type of the operands of every call.
+    TypeIndex _type;
+    bool _is_comparison = false;
+    std::vector<Op> _ops;
+    std::vector<VExpr*> _leaves;
+    size_t _max_depth = 0;
+    size_t _num_operators = 0;
+};
+
+} // namespace doris::vectorized
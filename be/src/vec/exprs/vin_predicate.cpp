@@ -17,6 +17,7 @@
 
 #include "vec/exprs/vin_predicate.h"
 
+#include <algorithm>
 #include <string_view>
 
 #include "exprs/create_predicate_function.h"
@@ -47,6 +48,8 @@ Status VInPredicate::prepare(RuntimeState* state, const RowDescriptor& desc,
     _is_prepare = true;
 
     DCHECK(_children.size() > 1);
+    _is_all_const_set = std::all_of(_children.begin() + 1, _children.end(),
+                                    [](VExpr* child) { return child->is_constant(); });
     ColumnsWithTypeAndName argument_template;
     argument_template.reserve(_children.size());
     for (auto child : _children) {
@@ -82,9 +85,10 @@ void VInPredicate::close(RuntimeState* state, VExprContext* context,
 }
 
 Status VInPredicate::execute(VExprContext* context, Block* block, int* result_column_id) {
-    // TODO: not execute const expr again, but use the const column in function context
-    doris::vectorized::ColumnNumbers arguments(_children.size());
-    for (int i = 0; i < _children.size(); ++i) {
+    // the constant set is kept by the function, only the first argument is needed
+    size_t num_arguments = _is_all_const_set ? 1 : _children.size();
+    doris::vectorized::ColumnNumbers arguments(num_arguments);
+    for (int i = 0; i < num_arguments; ++i) {
         int column_id = -1;
         _children[i]->execute(context, block, &column_id);
         arguments[i] = column_id;
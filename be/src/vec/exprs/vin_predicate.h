@@ -45,6 +45,9 @@ private:
 
     const bool _is_not_in;
     bool _is_prepare;
+    // all the values of the set are constant, the function finds them in its state
+    // instead of the columns of the block, so they are not executed for every block
+    bool _is_all_const_set = false;
 
 private:
     static const constexpr char* function_name = "in";
@@ -26,12 +26,14 @@ void register_function_array_element(SimpleFunctionFactory&);
 void register_function_array_index(SimpleFunctionFactory&);
 void register_function_array_size(SimpleFunctionFactory&);
 void register_function_array_aggregation(SimpleFunctionFactory&);
+void register_function_arrays_overlap(SimpleFunctionFactory&);
 
 void register_function_array(SimpleFunctionFactory& factory) {
     register_function_array_element(factory);
     register_function_array_index(factory);
     register_function_array_size(factory);
     register_function_array_aggregation(factory);
+    register_function_arrays_overlap(factory);
 }
 
 } // namespace doris::vectorized
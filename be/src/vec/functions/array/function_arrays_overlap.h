@@ -0,0 +1,215 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/columns/column_array.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/hash_table/hash_set.h"
+#include "vec/data_types/data_type_array.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/functions/function.h"
+#include "vec/functions/function_helpers.h"
+
+namespace doris::vectorized {
+
+// arrays_overlap(array1, array2) returns true if the two arrays have a common not null element.
+// The elements of the shorter array of each row are put into a small hash set, which is probed
+// by the elements of the other one.
+class FunctionArraysOverlap : public IFunction {
+public:
+    static constexpr auto name = "arrays_overlap";
+    static FunctionPtr create() { return std::make_shared<FunctionArraysOverlap>(); }
+
+    /// Get function name.
+    String get_name() const override { return name; }
+
+    bool is_variadic() const override { return false; }
+
+    size_t get_number_of_arguments() const override { return 2; }
+
+    DataTypePtr get_return_type_impl(const DataTypes& arguments) const override {
+        DCHECK(is_array(arguments[0])) << "first argument for function: " << name
+                                       << " should be DataTypeArray";
+        DCHECK(is_array(arguments[1])) << "second argument for function: " << name
+                                       << " should be DataTypeArray";
+        return std::make_shared<DataTypeUInt8>();
+    }
+
+    Status execute_impl(FunctionContext* context, Block& block, const ColumnNumbers& arguments,
+                        size_t result, size_t input_rows_count) override {
+        auto left_column =
+                block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
+        auto right_column =
+                block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
+        const auto* left_array = check_and_get_column<ColumnArray>(*left_column);
+        const auto* right_array = check_and_get_column<ColumnArray>(*right_column);
+        if (!left_array || !right_array) {
+            return _unsupported_types(block, arguments);
+        }
+        ArrayData left(*left_array);
+        ArrayData right(*right_array);
+
+        auto dst = ColumnUInt8::create(input_rows_count, 0);
+        auto& dst_data = dst->get_data();
+
+        WhichDataType which(remove_nullable(
+                assert_cast<const DataTypeArray&>(*block.get_by_position(arguments[0]).type)
+                        .get_nested_type()));
+        bool executed = true;
+        if (which.is_uint8()) {
+            _execute_number<ColumnUInt8>(left, right, dst_data);
+        } else if (which.is_int8()) {
+            _execute_number<ColumnInt8>(left, right, dst_data);
+        } else if (which.is_int16()) {
+            _execute_number<ColumnInt16>(left, right, dst_data);
+        } else if (which.is_int32()) {
+            _execute_number<ColumnInt32>(left, right, dst_data);
+        } else if (which.is_int64() || which.is_date_or_datetime()) {
+            _execute_number<ColumnInt64>(left, right, dst_data);
+        } else if (which.is_int128()) {
+            _execute_number<ColumnInt128>(left, right, dst_data);
+        } else if (which.is_float32()) {
+            _execute_number<ColumnFloat32>(left, right, dst_data);
+        } else if (which.is_float64()) {
+            _execute_number<ColumnFloat64>(left, right, dst_data);
+        } else if (which.is_decimal128()) {
+            _execute_number<ColumnDecimal128>(left, right, dst_data);
+        } else if (which.is_string_or_fixed_string()) {
+            _execute_string(left, right, dst_data);
+        } else {
+            executed = false;
+        }
+        if (!executed || !left.nested_column || !right.nested_column) {
+            return _unsupported_types(block, arguments);
+        }
+
+        block.replace_by_position(result, std::move(dst));
+        return Status::OK();
+    }
+
+private:
+    struct ArrayData {
+        explicit ArrayData(const ColumnArray& array) : offsets(array.get_offsets()) {
+            if (array.get_data().is_nullable()) {
+                const auto& nullable = assert_cast<const ColumnNullable&>(array.get_data());
+                null_map = nullable.get_null_map_data().data();
+                nested_column = &nullable.get_nested_column();
+            } else {
+                nested_column = &array.get_data();
+            }
+        }
+
+        bool is_null(size_t pos) const { return null_map && null_map[pos]; }
+
+        const ColumnArray::Offsets& offsets;
+        const UInt8* null_map = nullptr;
+        const IColumn* nested_column = nullptr;
+    };
+
+    // Builds the set from the shorter array of the row and probes it with the other one.
+    template <typename Set, typename GetKey>
+    static void _execute(const ArrayData& left, const ArrayData& right, GetKey&& get_key,
+                         ColumnUInt8::Container& dst_data) {
+        Set set;
+        for (size_t row = 0; row < dst_data.size(); ++row) {
+            const ArrayData* build = &left;
+            const ArrayData* probe = &right;
+            size_t build_len = left.offsets[row] - left.offsets[row - 1];
+            size_t probe_len = right.offsets[row] - right.offsets[row - 1];
+            if (build_len == 0 || probe_len == 0) {
+                continue;
+            }
+            if (build_len > probe_len) {
+                std::swap(build, probe);
+            }
+
+            set.clear();
+            for (size_t pos = build->offsets[row - 1]; pos < build->offsets[row]; ++pos) {
+                if (!build->is_null(pos)) {
+                    set.insert(get_key(*build, pos));
+                }
+            }
+            if (set.empty()) {
+                continue;
+            }
+            for (size_t pos = probe->offsets[row - 1]; pos < probe->offsets[row]; ++pos) {
+                if (!probe->is_null(pos) && set.has(get_key(*probe, pos))) {
+                    dst_data[row] = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    template <typename ColumnType>
+    void _execute_number(ArrayData& left, ArrayData& right, ColumnUInt8::Container& dst_data) {
+        const auto* left_nested = check_and_get_column<ColumnType>(*left.nested_column);
+        const auto* right_nested = check_and_get_column<ColumnType>(*right.nested_column);
+        if (!left_nested || !right_nested) {
+            left.nested_column = nullptr;
+            return;
+        }
+        using ValueType = typename ColumnType::value_type;
+        if constexpr (IsDecimalNumber<ValueType>) {
+            using Key = typename ValueType::NativeType;
+            _execute<HashSetWithStackMemory<Key, DefaultHash<Key>, 4>>(
+                    left, right,
+                    [](const ArrayData& data, size_t pos) {
+                        return assert_cast<const ColumnType&>(*data.nested_column)
+                                .get_data()[pos]
+                                .value;
+                    },
+                    dst_data);
+        } else {
+            _execute<HashSetWithStackMemory<ValueType, DefaultHash<ValueType>, 4>>(
+                    left, right,
+                    [](const ArrayData& data, size_t pos) {
+                        return assert_cast<const ColumnType&>(*data.nested_column).get_data()[pos];
+                    },
+                    dst_data);
+        }
+    }
+
+    void _execute_string(ArrayData& left, ArrayData& right, ColumnUInt8::Container& dst_data) {
+        if (!check_column<ColumnString>(*left.nested_column) ||
+            !check_column<ColumnString>(*right.nested_column)) {
+            left.nested_column = nullptr;
+            return;
+        }
+        // the keys refer to the chars of the nested columns, which outlive the set
+        _execute<HashSetWithSavedHashWithStackMemory<StringRef, StringRefHash, 4>>(
+                left, right,
+                [](const ArrayData& data, size_t pos) {
+                    return assert_cast<const ColumnString&>(*data.nested_column)
+                            .get_data_at(pos);
+                },
+                dst_data);
+    }
+
+    Status _unsupported_types(Block& block, const ColumnNumbers& arguments) const {
+        return Status::RuntimeError(
+                fmt::format("execute failed or unsupported types for function {}({}, {})",
+                            get_name(), block.get_by_position(arguments[0]).type->get_name(),
+                            block.get_by_position(arguments[1]).type->get_name()));
+    }
+};
+
+} // namespace doris::vectorized
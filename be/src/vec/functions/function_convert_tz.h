@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "util/timezone_utils.h"
 #include "vec/columns/columns_number.h"
 #include "vec/common/string_ref.h"
 #include "vec/core/types.h"
@@ -75,10 +76,34 @@ public:
     }
 
 private:
+    // The time zone arguments are mostly constants, so a time zone is looked up only when its
+    // name differs from the one of the previous row.
+    class CachedTimeZone {
+    public:
+        bool find(StringRef name) {
+            if (!_inited || name != StringRef(_name)) {
+                _name = name.to_string();
+                _found = TimezoneUtils::find_cctz_time_zone(_name, _ctz);
+                _inited = true;
+            }
+            return _found;
+        }
+
+        const cctz::time_zone& ctz() const { return _ctz; }
+
+    private:
+        bool _inited = false;
+        bool _found = false;
+        std::string _name;
+        cctz::time_zone _ctz;
+    };
+
     void execute_straight(FunctionContext* context, const ColumnDateTime* date_column,
                           const ColumnString* from_tz_column, const ColumnString* to_tz_column,
                           ColumnDateTime* result_column, NullMap& result_null_map,
                           size_t input_rows_count) {
+        CachedTimeZone from_ctz;
+        CachedTimeZone to_ctz;
         for (size_t i = 0; i < input_rows_count; i++) {
             if (result_null_map[i]) {
                 result_column->insert_default();
@@ -92,14 +117,14 @@ private:
                     binary_cast<Int64, VecDateTimeValue>(date_column->get_element(i));
             int64_t timestamp;
 
-            if (!ts_value.unix_timestamp(&timestamp, from_tz.to_string())) {
+            if (!from_ctz.find(from_tz) || !ts_value.unix_timestamp(&timestamp, from_ctz.ctz())) {
                 result_null_map[i] = true;
                 result_column->insert_default();
                 continue;
             }
 
             VecDateTimeValue ts_value2;
-            if (!ts_value2.from_unixtime(timestamp, to_tz.to_string())) {
+            if (!to_ctz.find(to_tz) || !ts_value2.from_unixtime(timestamp, to_ctz.ctz())) {
                 result_null_map[i] = true;
                 result_column->insert_default();
                 continue;
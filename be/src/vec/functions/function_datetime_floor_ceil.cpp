@@ -252,9 +252,58 @@ struct TimeRound {
         time_round(ts2, period, ts1, is_null);
     }
 
+    // With the default origin and a period of 1, the unit boundaries are the calendar ones, so
+    // rounding down only truncates the smaller fields rather than counting and adding the units
+    // since FIRST_DAY. Returns false if it has to be done in the general way.
+    static bool truncate_to_unit(const doris::vectorized::VecDateTimeValue& ts2,
+                                 doris::vectorized::VecDateTimeValue& ts1) {
+        if constexpr (Impl::Unit == WEEK) {
+            return false;
+        } else {
+            if (!ts2.is_valid_date()) {
+                return false;
+            }
+            uint32_t month = ts2.month();
+            uint32_t day = ts2.day();
+            uint32_t hour = ts2.hour();
+            uint32_t minute = ts2.minute();
+            uint32_t second = ts2.second();
+            if constexpr (Impl::Unit == YEAR) {
+                month = 1;
+            }
+            if constexpr (Impl::Unit == YEAR || Impl::Unit == MONTH) {
+                day = 1;
+            }
+            if constexpr (Impl::Unit == YEAR || Impl::Unit == MONTH || Impl::Unit == DAY) {
+                hour = 0;
+            }
+            if constexpr (Impl::Unit != MINUTE && Impl::Unit != SECOND) {
+                minute = 0;
+            }
+            if constexpr (Impl::Unit != SECOND) {
+                second = 0;
+            }
+            if constexpr (Impl::Type == CEIL) {
+                // a time not on the boundary is rounded up in the general way
+                if (month != ts2.month() || day != ts2.day() || hour != ts2.hour() ||
+                    minute != ts2.minute() || second != ts2.second()) {
+                    return false;
+                }
+            }
+            ts1 = ts2;
+            ts1.to_datetime();
+            ts1.set_time(ts2.year(), month, day, hour, minute, second);
+            return true;
+        }
+    }
+
     static void time_round(Int64 date, Int32 period, Int64& res, UInt8& is_null) {
         auto ts2 = binary_cast<Int64, VecDateTimeValue>(date);
         auto& ts1 = (doris::vectorized::VecDateTimeValue&)(res);
+        if (period == 1 && truncate_to_unit(ts2, ts1)) {
+            is_null = false;
+            return;
+        }
         if constexpr (Impl::Unit != WEEK) {
             ts1.from_olap_datetime(FIRST_DAY);
         } else {
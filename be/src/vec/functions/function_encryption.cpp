@@ -90,8 +90,9 @@ public:
     }
 };
 
-template <typename Impl, bool is_encrypt>
-static void exectue_result(std::vector<const ColumnString::Offsets*>& offsets_list,
+template <typename Impl>
+static void exectue_result(EncryptionContext& ctx,
+                           std::vector<const ColumnString::Offsets*>& offsets_list,
                            std::vector<const ColumnString::Chars*>& chars_list, size_t i,
                            EncryptionMode& encryption_mode, const char* iv_raw,
                            ColumnString::Chars& result_data, ColumnString::Offsets& result_offset,
@@ -106,26 +107,29 @@ static void exectue_result(std::vector<const ColumnString::Offsets*>& offsets_li
         StringOP::push_null_string(i, result_data, result_offset, null_map);
         return;
     }
-    int cipher_len = src_size;
-    if constexpr (is_encrypt) {
-        cipher_len += 16;
-    }
-    std::unique_ptr<char[]> p;
-    p.reset(new char[cipher_len]);
-    int ret_code = 0;
-
-    ret_code = Impl::exectue_impl(encryption_mode, (unsigned char*)src_raw, src_size,
-                                  (unsigned char*)key_raw, key_size, iv_raw, true,
-                                  (unsigned char*)p.get());
+    // write the result into the column directly, at most one block longer than the source
+    size_t old_size = result_data.size();
+    result_data.resize(old_size + src_size + 16);
+    int ret_code = Impl::exectue_impl(ctx, encryption_mode, (unsigned char*)src_raw, src_size,
+                                      (unsigned char*)key_raw, key_size, iv_raw, true,
+                                      result_data.data() + old_size);
 
     if (ret_code < 0) {
+        result_data.resize(old_size);
         StringOP::push_null_string(i, result_data, result_offset, null_map);
     } else {
-        StringOP::push_value_string(std::string_view(p.get(), ret_code), i, result_data,
-                                    result_offset);
+        result_data.resize(old_size + ret_code);
+        StringOP::push_empty_string(i, result_data, result_offset);
     }
 }
 
+template <bool is_encrypt>
+static void reserve_result(const ColumnString::Chars& src_chars, size_t input_rows_count,
+                           ColumnString::Chars& result_data) {
+    // the padding of the encryption adds at most one block to each row
+    result_data.reserve(src_chars.size() + (is_encrypt ? 16 * input_rows_count : 0));
+}
+
 template <typename Impl, EncryptionMode mode, bool is_encrypt>
 struct EncryptionAndDecryptTwoImpl {
     static DataTypes get_variadic_argument_types_impl() {
@@ -136,14 +140,16 @@ struct EncryptionAndDecryptTwoImpl {
                                 std::vector<const ColumnString::Chars*>& chars_list,
                                 size_t input_rows_count, ColumnString::Chars& result_data,
                                 ColumnString::Offsets& result_offset, NullMap& null_map) {
+        EncryptionContext ctx;
+        reserve_result<is_encrypt>(*chars_list[0], input_rows_count, result_data);
         for (int i = 0; i < input_rows_count; ++i) {
             if (null_map[i]) {
                 StringOP::push_null_string(i, result_data, result_offset, null_map);
                 continue;
             }
             EncryptionMode encryption_mode = mode;
-            exectue_result<Impl, is_encrypt>(offsets_list, chars_list, i, encryption_mode, nullptr,
-                                             result_data, result_offset, null_map);
+            exectue_result<Impl>(ctx, offsets_list, chars_list, i, encryption_mode, nullptr,
+                                 result_data, result_offset, null_map);
         }
         return Status::OK();
     }
@@ -160,6 +166,8 @@ struct EncryptionAndDecryptFourImpl {
                                 std::vector<const ColumnString::Chars*>& chars_list,
                                 size_t input_rows_count, ColumnString::Chars& result_data,
                                 ColumnString::Offsets& result_offset, NullMap& null_map) {
+        EncryptionContext ctx;
+        reserve_result<is_encrypt>(*chars_list[0], input_rows_count, result_data);
         for (int i = 0; i < input_rows_count; ++i) {
             if (null_map[i]) {
                 StringOP::push_null_string(i, result_data, result_offset, null_map);
@@ -189,28 +197,28 @@ struct EncryptionAndDecryptFourImpl {
                 }
             }
 
-            exectue_result<Impl, is_encrypt>(offsets_list, chars_list, i, encryption_mode, iv_raw,
-                                             result_data, result_offset, null_map);
+            exectue_result<Impl>(ctx, offsets_list, chars_list, i, encryption_mode, iv_raw,
+                                 result_data, result_offset, null_map);
         }
         return Status::OK();
     }
 };
 
 struct EncryptImpl {
-    static int exectue_impl(EncryptionMode mode, const unsigned char* source,
-                            uint32_t source_length, const unsigned char* key, uint32_t key_length,
-                            const char* iv, bool padding, unsigned char* encrypt) {
-        return EncryptionUtil::encrypt(mode, source, source_length, key, key_length, iv, true,
-                                       encrypt);
+    static int exectue_impl(EncryptionContext& ctx, EncryptionMode mode,
+                            const unsigned char* source, uint32_t source_length,
+                            const unsigned char* key, uint32_t key_length, const char* iv,
+                            bool padding, unsigned char* encrypt) {
+        return ctx.encrypt(mode, source, source_length, key, key_length, iv, true, encrypt);
     }
 };
 
 struct DecryptImpl {
-    static int exectue_impl(EncryptionMode mode, const unsigned char* source,
-                            uint32_t source_length, const unsigned char* key, uint32_t key_length,
-                            const char* iv, bool padding, unsigned char* encrypt) {
-        return EncryptionUtil::decrypt(mode, source, source_length, key, key_length, iv, true,
-                                       encrypt);
+    static int exectue_impl(EncryptionContext& ctx, EncryptionMode mode,
+                            const unsigned char* source, uint32_t source_length,
+                            const unsigned char* key, uint32_t key_length, const char* iv,
+                            bool padding, unsigned char* encrypt) {
+        return ctx.decrypt(mode, source, source_length, key, key_length, iv, true, encrypt);
     }
 };
 
@@ -159,7 +159,7 @@ Status JavaFunctionCall::execute(FunctionContext* context, Block& block,
         ColumnString::Chars& chars = const_cast<ColumnString::Chars&>(str_col->get_chars());       \
         ColumnString::Offsets& offsets =                                                           \
                 const_cast<ColumnString::Offsets&>(str_col->get_offsets());                        \
-        int increase_buffer_size = 0;                                                              \
+        int& increase_buffer_size = jni_ctx->output_buffer_level;                                  \
         int32_t buffer_size = JniUtil::IncreaseReservedBufferSize(increase_buffer_size);           \
         chars.reserve(buffer_size);                                                                \
         chars.resize(buffer_size);                                                                 \
@@ -180,6 +180,7 @@ Status JavaFunctionCall::execute(FunctionContext* context, Block& block,
             env->CallNonvirtualVoidMethodA(jni_ctx->executor, executor_cl_, executor_evaluate_id_, \
                                            nullptr);                                               \
         }                                                                                          \
+        chars.resize(num_rows == 0 ? 0 : offsets[num_rows - 1]);                                   \
     } else if (data_col->is_numeric() || data_col->is_column_decimal()) {                          \
         data_col->reserve(num_rows);                                                               \
         data_col->resize(num_rows);                                                                \
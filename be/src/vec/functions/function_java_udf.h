@@ -94,6 +94,9 @@ private:
         std::unique_ptr<int32_t> batch_size_ptr;
         // intermediate_state includes two parts: reserved / used buffer size and rows
         std::unique_ptr<IntermediateState> output_intermediate_state_ptr;
+        // the output string buffer of a batch starts from the size needed by the last batch,
+        // instead of being grown again from the initial size by reevaluating for every batch
+        int output_buffer_level = 0;
 
         JniContext(int64_t num_args, JavaFunctionCall* parent) : parent(parent) {
             input_values_buffer_ptr.reset(new int64_t[num_args]);
@@ -186,31 +186,67 @@ rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjs
     return root;
 }
 
+// Keeps the parsed json paths of the last path string. The path argument is a constant
+// in most queries, so it is parsed only once for a block instead of once for each row.
+class JsonPathCache {
+public:
+    const std::vector<JsonPath>& get(const std::string_view& path_string) {
+        if (!_initialized || path_string != _path_string) {
+            _path_string.assign(path_string.data(), path_string.size());
+            _parsed_paths.clear();
+            auto tok = get_json_token(path_string);
+            std::vector<std::string> paths(tok.begin(), tok.end());
+            get_parsed_paths(paths, &_parsed_paths);
+            _initialized = true;
+        }
+        return _parsed_paths;
+    }
+
+private:
+    bool _initialized = false;
+    std::string _path_string;
+    std::vector<JsonPath> _parsed_paths;
+};
+
+// A rapidjson document reused by the rows of a block. The values of a row are allocated
+// from a preallocated buffer, which is recycled for the next row instead of malloc and
+// free the memory pool chunks for every row.
+class ReusableJsonDocument {
+public:
+    ReusableJsonDocument() : _allocator(_buffer, sizeof(_buffer)), _document(&_allocator) {}
+
+    rapidjson::Document* reset() {
+        _document.SetNull();
+        _allocator.Clear();
+        return &_document;
+    }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 8 * 1024;
+
+    char _buffer[BUFFER_SIZE];
+    rapidjson::Document::AllocatorType _allocator;
+    rapidjson::Document _document;
+};
+
 template <JsonFunctionType fntype>
 rapidjson::Value* get_json_object(const std::string_view& json_string,
-                                  const std::string_view& path_string,
+                                  const std::vector<JsonPath>& parsed_paths,
                                   rapidjson::Document* document) {
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
-
-    auto tok = get_json_token(path_string);
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
-
-    if (!(*parsed_paths)[0].is_valid) {
+    if (UNLIKELY(parsed_paths.empty()) || !parsed_paths[0].is_valid) {
         return document;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
+    if (UNLIKELY(parsed_paths.size() == 1)) {
         if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.data(), document->GetAllocator());
+            document->SetString(json_string.data(), json_string.size(),
+                                document->GetAllocator());
         } else {
             return document;
         }
     }
 
-    document->Parse(json_string.data());
+    document->Parse(json_string.data(), json_string.size());
     if (UNLIKELY(document->HasParseError())) {
         // VLOG_CRITICAL << "Error at offset " << document->GetErrorOffset() << ": "
         //         << GetParseError_En(document->GetParseError());
@@ -218,7 +254,7 @@ rapidjson::Value* get_json_object(const std::string_view& json_string,
         return document;
     }
 
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, document->GetAllocator());
 }
 
 template <typename NumberType>
@@ -233,6 +269,8 @@ struct GetJsonNumberType {
                               NullMap& null_map) {
         size_t size = loffsets.size();
         res.resize(size);
+        JsonPathCache path_cache;
+        ReusableJsonDocument document;
         for (size_t i = 0; i < size; ++i) {
             const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
             int l_str_size = loffsets[i] - loffsets[i - 1] - 1;
@@ -248,14 +286,16 @@ struct GetJsonNumberType {
             std::string_view json_string(l_raw_str, l_str_size);
             std::string_view path_string(r_raw_str, r_str_size);
 
-            rapidjson::Document document;
+            const auto& parsed_paths = path_cache.get(path_string);
             rapidjson::Value* root = nullptr;
 
             if constexpr (std::is_same_v<double, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
+                root = get_json_object<JSON_FUN_DOUBLE>(json_string, parsed_paths,
+                                                        document.reset());
                 handle_result<double>(root, res[i], null_map[i]);
             } else if constexpr (std::is_same_v<int32_t, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
+                root = get_json_object<JSON_FUN_DOUBLE>(json_string, parsed_paths,
+                                                        document.reset());
                 handle_result<int32_t>(root, res[i], null_map[i]);
             }
         }
@@ -321,6 +361,9 @@ struct GetJsonString {
                               Offsets& res_offsets, NullMap& null_map) {
         size_t input_rows_count = loffsets.size();
         res_offsets.resize(input_rows_count);
+        JsonPathCache path_cache;
+        ReusableJsonDocument document;
+        rapidjson::StringBuffer buf;
 
         for (size_t i = 0; i < input_rows_count; ++i) {
             int l_size = loffsets[i] - loffsets[i - 1] - 1;
@@ -337,10 +380,8 @@ struct GetJsonString {
             std::string_view json_string(l_raw, l_size);
             std::string_view path_string(r_raw, r_size);
 
-            rapidjson::Document document;
-            rapidjson::Value* root = nullptr;
-
-            root = get_json_object<JSON_FUN_STRING>(json_string, path_string, &document);
+            rapidjson::Value* root = get_json_object<JSON_FUN_STRING>(
+                    json_string, path_cache.get(path_string), document.reset());
             const int max_string_len = 65535;
 
             if (root == nullptr || root->IsNull()) {
@@ -350,7 +391,7 @@ struct GetJsonString {
                 size_t len = strnlen(ptr, max_string_len);
                 StringOP::push_value_string(std::string_view(ptr, len), i, res_data, res_offsets);
             } else {
-                rapidjson::StringBuffer buf;
+                buf.Clear();
                 rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
                 root->Accept(writer);
 
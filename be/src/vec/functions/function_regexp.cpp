@@ -25,10 +25,50 @@
 #include "vec/data_types/data_type_number.h"
 #include "vec/data_types/data_type_string.h"
 #include "vec/functions/function_string.h"
+#include "vec/functions/regex_cache.h"
 #include "vec/functions/simple_function_factory.h"
 #include "vec/utils/util.hpp"
 namespace doris::vectorized {
 
+using RegexPtr = std::shared_ptr<const re2::RE2>;
+
+// Compiles the pattern with the options of StringFunctions::compile_regex(), the regexes are
+// shared by the fragments and rows with the same patterns through RegexCache.
+static RegexPtr compile_regex(const StringRef& pattern, std::string* error_str) {
+    re2::RE2::Options options;
+    // Disable error logging in case e.g. every row causes an error
+    options.set_log_errors(false);
+    options.set_dot_nl(true);
+    auto re = RegexCache::compile(re2::StringPiece(pattern.data, pattern.size), options);
+    if (!re->ok()) {
+        *error_str = fmt::format("Could not compile regexp pattern: {}\nError: {}",
+                                 pattern.to_string(), re->error());
+        return nullptr;
+    }
+    return re;
+}
+
+// Returns the regex of the constant pattern compiled by prepare(), or the one of the pattern
+// of the row, which is kept in row_re for the next rows with the same pattern.
+static const re2::RE2* get_regex(FunctionContext* context, const ColumnString* pattern_col,
+                                 size_t row, RegexPtr* row_re, StringRef* row_pattern,
+                                 std::string* error_str) {
+    auto state = reinterpret_cast<RegexPtr*>(
+            context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    if (state != nullptr) {
+        return state->get();
+    }
+    const auto& pattern = pattern_col->get_data_at(row);
+    if (*row_re == nullptr || pattern != *row_pattern) {
+        *row_re = compile_regex(pattern, error_str);
+        if (*row_re == nullptr) {
+            return nullptr;
+        }
+        *row_pattern = pattern;
+    }
+    return row_re->get();
+}
+
 template <typename Impl>
 class FunctionRegexp : public IFunction {
 public:
@@ -61,12 +101,12 @@ public:
             }
 
             std::string error_str;
-            re2::RE2* re = StringFunctions::compile_regex(pattern, &error_str, StringVal::null());
+            auto re = compile_regex(pattern_col->get_data_at(0), &error_str);
             if (re == nullptr) {
                 context->set_error(error_str.c_str());
                 return Status::InvalidArgument(error_str);
             }
-            context->set_function_state(scope, re);
+            context->set_function_state(scope, new RegexPtr(std::move(re)));
         }
         return Status::OK();
     }
@@ -102,8 +142,7 @@ public:
 
     Status close(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
         if (scope == FunctionContext::FRAGMENT_LOCAL) {
-            re2::RE2* re = reinterpret_cast<re2::RE2*>(context->get_function_state(scope));
-            delete re;
+            delete reinterpret_cast<RegexPtr*>(context->get_function_state(scope));
         }
         return Status::OK();
     }
@@ -119,24 +158,20 @@ struct RegexpReplaceImpl {
         const auto* pattern_col = check_and_get_column<ColumnString>(argument_columns[1].get());
         const auto* replace_col = check_and_get_column<ColumnString>(argument_columns[2].get());
 
+        RegexPtr row_re;
+        StringRef row_pattern;
         for (int i = 0; i < input_rows_count; ++i) {
             if (null_map[i]) {
                 StringOP::push_null_string(i, result_data, result_offset, null_map);
                 continue;
             }
-            re2::RE2* re = reinterpret_cast<re2::RE2*>(
-                    context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-            std::unique_ptr<re2::RE2> scoped_re; // destroys re if state->re is nullptr
+            std::string error_str;
+            const re2::RE2* re =
+                    get_regex(context, pattern_col, i, &row_re, &row_pattern, &error_str);
             if (re == nullptr) {
-                std::string error_str;
-                const auto& pattern = pattern_col->get_data_at(i).to_string_val();
-                re = StringFunctions::compile_regex(pattern, &error_str, StringVal::null());
-                if (re == nullptr) {
-                    context->add_warning(error_str.c_str());
-                    StringOP::push_null_string(i, result_data, result_offset, null_map);
-                    continue;
-                }
-                scoped_re.reset(re);
+                context->add_warning(error_str.c_str());
+                StringOP::push_null_string(i, result_data, result_offset, null_map);
+                continue;
             }
 
             re2::StringPiece replace_str =
@@ -161,6 +196,8 @@ struct RegexpExtractImpl {
         const auto* pattern_col = check_and_get_column<ColumnString>(argument_columns[1].get());
         const auto* index_col =
                 check_and_get_column<ColumnVector<Int64>>(argument_columns[2].get());
+        RegexPtr row_re;
+        StringRef row_pattern;
         for (int i = 0; i < input_rows_count; ++i) {
             if (null_map[i]) {
                 StringOP::push_null_string(i, result_data, result_offset, null_map);
@@ -171,19 +208,13 @@ struct RegexpExtractImpl {
                 StringOP::push_empty_string(i, result_data, result_offset);
                 continue;
             }
-            re2::RE2* re = reinterpret_cast<re2::RE2*>(
-                    context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-            std::unique_ptr<re2::RE2> scoped_re;
+            std::string error_str;
+            const re2::RE2* re =
+                    get_regex(context, pattern_col, i, &row_re, &row_pattern, &error_str);
             if (re == nullptr) {
-                std::string error_str;
-                const auto& pattern = pattern_col->get_data_at(i).to_string_val();
-                re = StringFunctions::compile_regex(pattern, &error_str, StringVal::null());
-                if (re == nullptr) {
-                    context->add_warning(error_str.c_str());
-                    StringOP::push_null_string(i, result_data, result_offset, null_map);
-                    continue;
-                }
-                scoped_re.reset(re);
+                context->add_warning(error_str.c_str());
+                StringOP::push_null_string(i, result_data, result_offset, null_map);
+                continue;
             }
             const auto& str = str_col->get_data_at(i);
             re2::StringPiece str_sp = re2::StringPiece(str.data, str.size);
@@ -47,6 +47,9 @@ struct StringASCII {
                          PaddedPODArray<Int32>& res) {
         auto size = offsets.size();
         res.resize(size);
+        if (simd::VStringFunctions::is_ascii(data.data(), data.size())) {
+            return StringLengthImpl::vector(data, offsets, res);
+        }
         for (int i = 0; i < size; ++i) {
             const char* raw_str = reinterpret_cast<const char*>(&data[offsets[i - 1]]);
             // if strlen(raw_str) == 0, raw_str[0] is '\0'
@@ -29,6 +29,7 @@
 #include "udf/udf.h"
 #include "util/md5.h"
 #include "util/sm3.h"
+#include "util/simd/vstring_function.h"
 #include "util/url_parser.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/columns/column_nullable.h"
@@ -160,6 +161,10 @@ private:
         int size = offsets.size();
         res_offsets.resize(size);
         res_chars.reserve(chars.size());
+        if (simd::VStringFunctions::is_ascii(chars.data(), chars.size())) {
+            vector_ascii(chars, offsets, start, len, null_map, res_chars, res_offsets);
+            return;
+        }
         std::vector<size_t> index;
 
         for (int i = 0; i < size; ++i) {
@@ -194,6 +199,11 @@ private:
                 StringOP::push_null_string(i, res_chars, res_offsets, null_map);
                 continue;
             }
+            // the negative start is before the beginning of the string
+            if (fixed_pos <= 0) {
+                StringOP::push_empty_string(i, res_chars, res_offsets);
+                continue;
+            }
 
             byte_pos = index[fixed_pos - 1];
             int fixed_len = str_size - byte_pos;
@@ -212,6 +222,37 @@ private:
             }
         }
     }
+
+    // the chars are all ascii, so the char positions are the byte positions
+    static void vector_ascii(const ColumnString::Chars& chars, const ColumnString::Offsets& offsets,
+                             const PaddedPODArray<Int32>& start, const PaddedPODArray<Int32>& len,
+                             NullMap& null_map, ColumnString::Chars& res_chars,
+                             ColumnString::Offsets& res_offsets) {
+        int size = offsets.size();
+        for (int i = 0; i < size; ++i) {
+            int str_size = offsets[i] - offsets[i - 1] - 1;
+            if (start[i] > str_size) {
+                StringOP::push_null_string(i, res_chars, res_offsets, null_map);
+                continue;
+            }
+            if (len[i] <= 0 || str_size == 0 || start[i] == 0) {
+                StringOP::push_empty_string(i, res_chars, res_offsets);
+                continue;
+            }
+            int fixed_pos = start[i] > 0 ? start[i] : str_size + start[i] + 1;
+            if (fixed_pos <= 0) {
+                StringOP::push_empty_string(i, res_chars, res_offsets);
+                continue;
+            }
+            int byte_pos = fixed_pos - 1;
+            int fixed_len = std::min<int64_t>((int64_t)len[i], str_size - byte_pos);
+            StringOP::push_value_string(
+                    std::string_view {reinterpret_cast<const char*>(&chars[offsets[i - 1]]) +
+                                              byte_pos,
+                                      (size_t)fixed_len},
+                    i, res_chars, res_offsets);
+        }
+    }
 };
 
 template <typename Impl>
@@ -704,6 +745,10 @@ public:
         auto& padcol_offsets = padcol->get_offsets();
         auto& padcol_chars = padcol->get_chars();
 
+        // with only ascii chars, the char positions are the byte positions
+        const bool is_ascii =
+                simd::VStringFunctions::is_ascii(strcol_chars.data(), strcol_chars.size()) &&
+                simd::VStringFunctions::is_ascii(padcol_chars.data(), padcol_chars.size());
         std::vector<size_t> str_index;
         std::vector<size_t> pad_index;
 
@@ -727,14 +772,17 @@ public:
                         reinterpret_cast<const char*>(&padcol_chars[padcol_offsets[i - 1]]);
 
                 size_t str_char_size =
-                        get_char_len(std::string_view(str_data, str_len), &str_index);
+                        is_ascii ? str_len
+                                 : get_char_len(std::string_view(str_data, str_len), &str_index);
                 size_t pad_char_size =
-                        get_char_len(std::string_view(pad_data, pad_len), &pad_index);
+                        is_ascii ? pad_len
+                                 : get_char_len(std::string_view(pad_data, pad_len), &pad_index);
 
                 if (col_len_data[i] <= str_char_size) {
                     // truncate the input string
                     if (col_len_data[i] < str_char_size) {
-                        buffer.append(str_data, str_data + str_index[col_len_data[i]]);
+                        buffer.append(str_data, str_data + (is_ascii ? col_len_data[i]
+                                                                     : str_index[col_len_data[i]]));
                     } else {
                         buffer.append(str_data, str_data + str_len);
                     }
@@ -753,39 +801,30 @@ public:
                 int32_t pad_byte_len = 0;
                 int32_t pad_times = (col_len_data[i] - str_char_size) / pad_char_size;
                 int32_t pad_remainder = (col_len_data[i] - str_char_size) % pad_char_size;
-                pad_byte_len = pad_times * pad_len;
-                pad_byte_len += pad_index[pad_remainder];
-                int32_t byte_len = str_len + pad_byte_len;
-                // StringVal result(context, byte_len);
+                int32_t pad_remainder_len = is_ascii ? pad_remainder : pad_index[pad_remainder];
+                pad_byte_len = pad_times * pad_len + pad_remainder_len;
+                buffer.reserve(str_len + pad_byte_len);
                 if constexpr (Impl::is_lpad) {
-                    int pad_idx = 0;
-                    int result_index = 0;
-
-                    // Prepend chars of pad.
-                    while (result_index++ < pad_byte_len) {
-                        buffer.push_back(pad_data[pad_idx++]);
-                        pad_idx = pad_idx % pad_len;
+                    // Prepend the whole pads and then the head of pad.
+                    for (int32_t j = 0; j < pad_times; ++j) {
+                        buffer.append(pad_data, pad_data + pad_len);
                     }
+                    buffer.append(pad_data, pad_data + pad_remainder_len);
 
                     // Append given string.
                     buffer.append(str_data, str_data + str_len);
-                    StringOP::push_value_string(std::string_view(buffer.data(), buffer.size()), i,
-                                                res_chars, res_offsets);
-
                 } else {
                     // is rpad
                     buffer.append(str_data, str_data + str_len);
 
-                    // Append chars of pad until desired length
-                    int pad_idx = 0;
-                    int result_len = str_len;
-                    while (result_len++ < byte_len) {
-                        buffer.push_back(pad_data[pad_idx++]);
-                        pad_idx = pad_idx % pad_len;
+                    // Append the whole pads and then the head of pad.
+                    for (int32_t j = 0; j < pad_times; ++j) {
+                        buffer.append(pad_data, pad_data + pad_len);
                     }
-                    StringOP::push_value_string(std::string_view(buffer.data(), buffer.size()), i,
-                                                res_chars, res_offsets);
+                    buffer.append(pad_data, pad_data + pad_remainder_len);
                 }
+                StringOP::push_value_string(std::string_view(buffer.data(), buffer.size()), i,
+                                            res_chars, res_offsets);
             }
         }
 
@@ -1226,9 +1265,17 @@ public:
         auto& vec_res = col_res->get_data();
         vec_res.resize(input_rows_count);
 
-        for (int i = 0; i < input_rows_count; ++i) {
-            vec_res[i] = locate_pos(col_substr->get_data_at(i).to_string_val(),
-                                    col_str->get_data_at(i).to_string_val(), vec_pos[i]);
+        const auto& str_chars = assert_cast<const ColumnString*>(col_str.get())->get_chars();
+        if (simd::VStringFunctions::is_ascii(str_chars.data(), str_chars.size())) {
+            for (int i = 0; i < input_rows_count; ++i) {
+                vec_res[i] = locate_pos_ascii(col_substr->get_data_at(i).to_string_val(),
+                                              col_str->get_data_at(i).to_string_val(), vec_pos[i]);
+            }
+        } else {
+            for (int i = 0; i < input_rows_count; ++i) {
+                vec_res[i] = locate_pos(col_substr->get_data_at(i).to_string_val(),
+                                        col_str->get_data_at(i).to_string_val(), vec_pos[i]);
+            }
         }
 
         block.replace_by_position(result, std::move(col_res));
@@ -1269,6 +1316,22 @@ private:
             return 0;
         }
     }
+
+    // the same as locate_pos when str is ascii, the char positions are the byte positions
+    int locate_pos_ascii(StringVal substr, StringVal str, int start_pos) {
+        if (substr.len == 0) {
+            return locate_pos(substr, str, start_pos);
+        }
+        if (start_pos <= 0 || start_pos > str.len) {
+            return 0;
+        }
+        StringValue substr_sv = StringValue::from_string_val(substr);
+        StringSearch search(&substr_sv);
+        StringValue adjusted_str(reinterpret_cast<char*>(str.ptr) + start_pos - 1,
+                                 str.len - start_pos + 1);
+        int32_t match_pos = search.search(&adjusted_str);
+        return match_pos >= 0 ? start_pos + match_pos : 0;
+    }
 };
 
 class FunctionReplace : public IFunction {
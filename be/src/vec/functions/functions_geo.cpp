@@ -25,6 +25,19 @@
 
 namespace doris::vectorized {
 
+// Returns the not nullable column of a constant argument, or nullptr if the argument is null.
+static ColumnPtr get_constant_arg(FunctionContext* context, int i) {
+    ColumnPtr column =
+            context->get_constant_col(i)->column_ptr->convert_to_full_column_if_const();
+    if (column->is_null_at(0)) {
+        return nullptr;
+    }
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+        return nullable->get_nested_column_ptr();
+    }
+    return column;
+}
+
 struct StPoint {
     static constexpr auto NEED_CONTEXT = false;
     static constexpr auto NAME = "st_point";
@@ -269,21 +282,22 @@ struct StCircle {
             return Status::OK();
         }
 
-        if (!context->is_arg_constant(0) || !context->is_arg_constant(1) ||
-            !context->is_arg_constant(2)) {
+        if (!context->is_col_constant(0) || !context->is_col_constant(1) ||
+            !context->is_col_constant(2)) {
             return Status::OK();
         }
 
         auto state = new StConstructState();
-        DoubleVal* lng = reinterpret_cast<DoubleVal*>(context->get_constant_arg(0));
-        DoubleVal* lat = reinterpret_cast<DoubleVal*>(context->get_constant_arg(1));
-        DoubleVal* radius = reinterpret_cast<DoubleVal*>(context->get_constant_arg(2));
-        if (lng->is_null || lat->is_null || radius->is_null) {
+        auto lng = get_constant_arg(context, 0);
+        auto lat = get_constant_arg(context, 1);
+        auto radius = get_constant_arg(context, 2);
+        if (lng == nullptr || lat == nullptr || radius == nullptr) {
             state->is_null = true;
         } else {
             std::unique_ptr<GeoCircle> circle(new GeoCircle());
 
-            auto res = circle->init(lng->val, lat->val, radius->val);
+            auto res = circle->init(lng->get_float64(0), lat->get_float64(0),
+                                    radius->get_float64(0));
             if (res != GEO_PARSE_OK) {
                 state->is_null = true;
             } else {
@@ -331,6 +345,9 @@ struct StContains {
 
         int i;
         std::vector<std::shared_ptr<GeoShape>> shapes = {nullptr, nullptr};
+        // the shapes of the last row are reused if the next row has the same encoded value,
+        // e.g. a shape computed by a function and repeated for every row
+        StringRef last_values[2];
         for (int row = 0; row < size; ++row) {
             auto lhs_value = shape1->get_data_at(row);
             auto rhs_value = shape2->get_data_at(row);
@@ -338,9 +355,10 @@ struct StContains {
             for (i = 0; i < 2; ++i) {
                 if (state != nullptr && state->shapes[i] != nullptr) {
                     shapes[i] = state->shapes[i];
-                } else {
+                } else if (shapes[i] == nullptr || *strs[i] != last_values[i]) {
                     shapes[i] = std::shared_ptr<GeoShape>(
                             GeoShape::from_encoded(strs[i]->data, strs[i]->size));
+                    last_values[i] = *strs[i];
                     if (shapes[i] == nullptr) {
                         res->insert_data(nullptr, 0);
                         break;
@@ -362,19 +380,20 @@ struct StContains {
             return Status::OK();
         }
 
-        if (!context->is_arg_constant(0) && !context->is_arg_constant(1)) {
+        if (!context->is_col_constant(0) && !context->is_col_constant(1)) {
             return Status::OK();
         }
 
         auto contains_ctx = new StContainsState();
         for (int i = 0; !contains_ctx->is_null && i < 2; ++i) {
-            if (context->is_arg_constant(i)) {
-                StringVal* str = reinterpret_cast<StringVal*>(context->get_constant_arg(i));
-                if (str->is_null) {
+            if (context->is_col_constant(i)) {
+                auto column = get_constant_arg(context, i);
+                if (column == nullptr) {
                     contains_ctx->is_null = true;
                 } else {
+                    auto str = column->get_data_at(0);
                     contains_ctx->shapes[i] =
-                            std::shared_ptr<GeoShape>(GeoShape::from_encoded(str->ptr, str->len));
+                            std::shared_ptr<GeoShape>(GeoShape::from_encoded(str.data, str.size));
                     if (contains_ctx->shapes[i] == nullptr) {
                         contains_ctx->is_null = true;
                     }
@@ -483,18 +502,18 @@ struct StGeoFromText {
             return Status::OK();
         }
 
-        if (!context->is_arg_constant(0)) {
+        if (!context->is_col_constant(0)) {
             return Status::OK();
         }
 
         auto state = new StConstructState();
-        auto str_value = reinterpret_cast<StringVal*>(context->get_constant_arg(0));
-        if (str_value->is_null) {
+        auto column = get_constant_arg(context, 0);
+        if (column == nullptr) {
             state->is_null = true;
         } else {
             GeoParseStatus status;
-            std::unique_ptr<GeoShape> shape(GeoShape::from_wkt(
-                    const_cast<const char*>((char*)str_value->ptr), str_value->len, &status));
+            auto str = column->get_data_at(0);
+            std::unique_ptr<GeoShape> shape(GeoShape::from_wkt(str.data, str.size, &status));
             if (shape == nullptr ||
                 (Impl::shape_type != GEO_SHAPE_ANY && shape->type() != Impl::shape_type)) {
                 state->is_null = true;
@@ -17,12 +17,17 @@
 // This file is copied from
 
 #include <fmt/format.h>
+#include <parallel_hashmap/phmap.h>
+
+#include <string_view>
 
 #include "exprs/create_predicate_function.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_set.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/columns_number.h"
+#include "vec/common/hash_table/hash_set.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/functions/function.h"
@@ -30,12 +35,144 @@
 
 namespace doris::vectorized {
 
+// Finds the values of a column in the constant set of IN column at a time, specialized by
+// the type of the column. A small set is compared with all the rows value by value in a
+// loop the compiler vectorizes, a large set is probed as a hash set.
+class InSetSearcher {
+public:
+    static constexpr size_t SMALL_SET_SIZE = 8;
+
+    virtual ~InSetSearcher() = default;
+
+    virtual void insert(const StringRef& value) = 0;
+
+    // Set results[i] to whether the i-th value of column is in the set, ignoring nulls.
+    // Returns false if the column is not of the type of the searcher.
+    virtual bool search(const IColumn& column, uint8_t* __restrict results) const = 0;
+};
+
+template <typename T, typename LargeSet>
+class NumberInSetSearcher final : public InSetSearcher {
+public:
+    void insert(const StringRef& value) override {
+        DCHECK_EQ(value.size, sizeof(T));
+        T number;
+        memcpy(&number, value.data, sizeof(T));
+        _values.push_back(number);
+        _large_set.insert(number);
+    }
+
+    bool search(const IColumn& column, uint8_t* __restrict results) const override {
+        const auto* number_column = check_and_get_column<ColumnVector<T>>(column);
+        if (number_column == nullptr) {
+            return false;
+        }
+        const auto* __restrict data = number_column->get_data().data();
+        size_t rows = number_column->size();
+        if (_values.size() <= SMALL_SET_SIZE) {
+            memset(results, 0, rows);
+            for (T value : _values) {
+                for (size_t i = 0; i < rows; ++i) {
+                    results[i] |= data[i] == value;
+                }
+            }
+        } else {
+            for (size_t i = 0; i < rows; ++i) {
+                if constexpr (std::is_same_v<LargeSet, phmap::flat_hash_set<T>>) {
+                    results[i] = _large_set.find(data[i]) != _large_set.end();
+                } else {
+                    results[i] = _large_set.has(data[i]);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<T> _values;
+    LargeSet _large_set;
+};
+
+// the hash set of the hash tables does not treat -0.0 and 0.0 as the same key
+template <typename T>
+using IntegerInSetSearcher = NumberInSetSearcher<T, HashSet<T, HashCRC32<T>>>;
+template <typename T>
+using FloatInSetSearcher = NumberInSetSearcher<T, phmap::flat_hash_set<T>>;
+
+class StringInSetSearcher final : public InSetSearcher {
+public:
+    void insert(const StringRef& value) override {
+        _values.emplace_back(value.data, value.size);
+        _large_set.emplace(value.data, value.size);
+    }
+
+    bool search(const IColumn& column, uint8_t* __restrict results) const override {
+        const auto* string_column = check_and_get_column<ColumnString>(column);
+        if (string_column == nullptr) {
+            return false;
+        }
+        size_t rows = string_column->size();
+        if (_values.size() <= SMALL_SET_SIZE) {
+            for (size_t i = 0; i < rows; ++i) {
+                StringRef ref = string_column->get_data_at(i);
+                uint8_t found = 0;
+                for (const auto& value : _values) {
+                    found |= value.size() == ref.size &&
+                             memcmp(value.data(), ref.data, ref.size) == 0;
+                }
+                results[i] = found;
+            }
+        } else {
+            for (size_t i = 0; i < rows; ++i) {
+                StringRef ref = string_column->get_data_at(i);
+                results[i] = _large_set.find(std::string_view(ref.data, ref.size)) !=
+                             _large_set.end();
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<std::string> _values;
+    phmap::flat_hash_set<std::string> _large_set;
+};
+
+inline std::unique_ptr<InSetSearcher> create_in_set_searcher(PrimitiveType type) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+        return std::make_unique<IntegerInSetSearcher<UInt8>>();
+    case TYPE_TINYINT:
+        return std::make_unique<IntegerInSetSearcher<Int8>>();
+    case TYPE_SMALLINT:
+        return std::make_unique<IntegerInSetSearcher<Int16>>();
+    case TYPE_INT:
+        return std::make_unique<IntegerInSetSearcher<Int32>>();
+    case TYPE_BIGINT:
+        return std::make_unique<IntegerInSetSearcher<Int64>>();
+    case TYPE_LARGEINT:
+        return std::make_unique<IntegerInSetSearcher<Int128>>();
+    case TYPE_FLOAT:
+        return std::make_unique<FloatInSetSearcher<Float32>>();
+    case TYPE_DOUBLE:
+        return std::make_unique<FloatInSetSearcher<Float64>>();
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_STRING:
+        return std::make_unique<StringInSetSearcher>();
+    default:
+        // the other types are found in the hybrid set row by row
+        return nullptr;
+    }
+}
+
 struct InState {
     bool use_set = true;
 
     // only use in null in set
     bool null_in_set = false;
     std::unique_ptr<HybridSetBase> hybrid_set;
+    // null if the type is not specialized or use_set is false
+    std::unique_ptr<InSetSearcher> searcher;
 };
 
 template <bool negative>
@@ -66,8 +203,9 @@ public:
         }
         auto* state = new InState();
         context->set_function_state(scope, state);
-        state->hybrid_set.reset(
-                create_set(convert_type_to_primitive(context->get_arg_type(0)->type)));
+        PrimitiveType type = convert_type_to_primitive(context->get_arg_type(0)->type);
+        state->hybrid_set.reset(create_set(type));
+        state->searcher = create_in_set_searcher(type);
 
         DCHECK(context->get_num_args() > 1);
         for (int i = 1; i < context->get_num_args(); ++i) {
@@ -78,9 +216,13 @@ public:
                     state->null_in_set = true;
                 } else {
                     state->hybrid_set->insert((void*)const_data.data, const_data.size);
+                    if (state->searcher != nullptr) {
+                        state->searcher->insert(const_data);
+                    }
                 }
             } else {
                 state->use_set = false;
+                state->searcher.reset();
                 break;
             }
         }
@@ -107,7 +249,22 @@ public:
         const ColumnWithTypeAndName& left_arg = block.get_by_position(arguments[0]);
         auto materialized_column = left_arg.column->convert_to_full_column_if_const();
 
-        if (in_state->use_set) {
+        const IColumn* nested_column = materialized_column.get();
+        const NullMap* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*materialized_column)) {
+            nested_column = &nullable->get_nested_column();
+            null_map = &nullable->get_null_map_data();
+        }
+
+        if (in_state->searcher != nullptr &&
+            in_state->searcher->search(*nested_column, vec_res.data())) {
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                // a value not in a set containing null is null
+                vec_null_map_to[i] = (null_map != nullptr && (*null_map)[i]) ||
+                                     (in_state->null_in_set && !vec_res[i]);
+                vec_res[i] = negative ^ vec_res[i];
+            }
+        } else if (in_state->use_set) {
             for (size_t i = 0; i < input_rows_count; ++i) {
                 const auto& ref_data = materialized_column->get_data_at(i);
                 if (ref_data.data) {
@@ -25,6 +25,7 @@
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/functions/function.h"
+#include "vec/functions/regex_cache.h"
 #include "vec/functions/simple_function_factory.h"
 
 namespace doris::vectorized {
@@ -82,6 +83,47 @@ Status FunctionLikeBase::constant_substring_fn(LikeSearchState* state, const Str
     return Status::OK();
 }
 
+#ifdef DORIS_WITH_HYPERSCAN
+Status FunctionLikeBase::hs_prepare(const std::string& regex, LikeSearchState* state) {
+    hs_compile_error_t* compile_err = nullptr;
+    // the same semantics as the RE2 options: dot matches new lines and the input is UTF-8
+    if (hs_compile(regex.c_str(), HS_FLAG_DOTALL | HS_FLAG_ALLOWEMPTY | HS_FLAG_UTF8 |
+                                          HS_FLAG_SINGLEMATCH,
+                   HS_MODE_BLOCK, nullptr, &state->hs_database, &compile_err) != HS_SUCCESS) {
+        std::string msg = compile_err != nullptr ? compile_err->message : "unknown error";
+        hs_free_compile_error(compile_err);
+        state->hs_database = nullptr;
+        return Status::InternalError(fmt::format("hyperscan can not compile {}: {}", regex, msg));
+    }
+    if (hs_alloc_scratch(state->hs_database, &state->hs_scratch) != HS_SUCCESS) {
+        hs_free_database(state->hs_database);
+        state->hs_database = nullptr;
+        state->hs_scratch = nullptr;
+        return Status::InternalError(fmt::format("hyperscan can not alloc scratch for {}", regex));
+    }
+    return Status::OK();
+}
+
+Status FunctionLikeBase::constant_regex_hs_fn(LikeSearchState* state, const StringValue& val,
+                                              const StringValue& pattern,
+                                              unsigned char* result) {
+    *result = false;
+    auto on_match = [](unsigned int /*id*/, unsigned long long /*from*/,
+                       unsigned long long /*to*/, unsigned int /*flags*/, void* ctx) -> int {
+        *reinterpret_cast<unsigned char*>(ctx) = true;
+        // stop scanning at the first match
+        return 1;
+    };
+    auto ret = hs_scan(state->hs_database, val.ptr, val.len, 0, state->hs_scratch, on_match,
+                       result);
+    if (ret != HS_SUCCESS && ret != HS_SCAN_TERMINATED) {
+        return Status::RuntimeError(fmt::format("hyperscan error {} when matching {}", ret,
+                                                std::string(val.ptr, val.len)));
+    }
+    return Status::OK();
+}
+#endif
+
 Status FunctionLikeBase::execute_impl(FunctionContext* context, Block& block,
                                       const ColumnNumbers& arguments, size_t result,
                                       size_t /*input_rows_count*/) {
@@ -143,20 +185,31 @@ Status FunctionLikeBase::vector_vector(const ColumnString::Chars& values,
     return Status::OK();
 }
 
-Status FunctionLike::like_fn(LikeSearchState* state, const StringValue& val,
-                             const StringValue& pattern, unsigned char* result) {
-    std::string re_pattern;
+static Status compile_row_regex(LikeSearchState* state, const StringValue& pattern,
+                                 const std::string& re_pattern) {
     RE2::Options opts;
     opts.set_never_nl(false);
     opts.set_dot_nl(true);
-    convert_like_pattern(state, std::string(pattern.ptr, pattern.len), &re_pattern);
-    re2::RE2 re(re_pattern, opts);
-    if (re.ok()) {
-        *result = RE2::FullMatch(re2::StringPiece(val.ptr, val.len), re);
-        return Status::OK();
-    } else {
+    auto re = RegexCache::compile(re_pattern, opts);
+    if (!re->ok()) {
+        state->regex.reset();
         return Status::RuntimeError(fmt::format("Invalid pattern: {}", pattern.debug_string()));
     }
+    state->regex = std::move(re);
+    state->regex_pattern.assign(pattern.ptr, pattern.len);
+    return Status::OK();
+}
+
+Status FunctionLike::like_fn(LikeSearchState* state, const StringValue& val,
+                             const StringValue& pattern, unsigned char* result) {
+    if (state->regex == nullptr ||
+        std::string_view(pattern.ptr, pattern.len) != state->regex_pattern) {
+        std::string re_pattern;
+        convert_like_pattern(state, std::string(pattern.ptr, pattern.len), &re_pattern);
+        RETURN_IF_ERROR(compile_row_regex(state, pattern, re_pattern));
+    }
+    *result = RE2::FullMatch(re2::StringPiece(val.ptr, val.len), *state->regex);
+    return Status::OK();
 }
 
 Status FunctionLike::constant_regex_full_fn(LikeSearchState* state, const StringValue& val,
@@ -242,10 +295,17 @@ Status FunctionLike::prepare(FunctionContext* context, FunctionContext::Function
         } else {
             std::string re_pattern;
             convert_like_pattern(&state->search_state, pattern_str, &re_pattern);
+#ifdef DORIS_WITH_HYPERSCAN
+            // LIKE matches the whole value
+            if (hs_prepare("^(?:" + re_pattern + ")\\z", &state->search_state).ok()) {
+                state->function = constant_regex_hs_fn;
+                return Status::OK();
+            }
+#endif
             RE2::Options opts;
             opts.set_never_nl(false);
             opts.set_dot_nl(true);
-            state->search_state.regex = std::make_unique<RE2>(re_pattern, opts);
+            state->search_state.regex = RegexCache::compile(re_pattern, opts);
             if (!state->search_state.regex->ok()) {
                 return Status::InternalError(
                         fmt::format("Invalid regex expression: {}", pattern_str));
@@ -283,10 +343,16 @@ Status FunctionRegexp::prepare(FunctionContext* context,
             state->search_state.set_search_string(search_string);
             state->function = constant_substring_fn;
         } else {
+#ifdef DORIS_WITH_HYPERSCAN
+            if (hs_prepare(pattern_str, &state->search_state).ok()) {
+                state->function = constant_regex_hs_fn;
+                return Status::OK();
+            }
+#endif
             RE2::Options opts;
             opts.set_never_nl(false);
             opts.set_dot_nl(true);
-            state->search_state.regex = std::make_unique<RE2>(pattern_str, opts);
+            state->search_state.regex = RegexCache::compile(pattern_str, opts);
             if (!state->search_state.regex->ok()) {
                 return Status::InternalError(
                         fmt::format("Invalid regex expression: {}", pattern_str));
@@ -306,17 +372,12 @@ Status FunctionRegexp::constant_regex_partial_fn(LikeSearchState* state, const S
 
 Status FunctionRegexp::regexp_fn(LikeSearchState* state, const StringValue& val,
                                  const StringValue& pattern, unsigned char* result) {
-    std::string re_pattern(pattern.ptr, pattern.len);
-    RE2::Options opts;
-    opts.set_never_nl(false);
-    opts.set_dot_nl(true);
-    re2::RE2 re(re_pattern, opts);
-    if (re.ok()) {
-        *result = RE2::PartialMatch(re2::StringPiece(val.ptr, val.len), re);
-        return Status::OK();
-    } else {
-        return Status::RuntimeError(fmt::format("Invalid pattern: {}", pattern.debug_string()));
+    if (state->regex == nullptr ||
+        std::string_view(pattern.ptr, pattern.len) != state->regex_pattern) {
+        RETURN_IF_ERROR(compile_row_regex(state, pattern, std::string(pattern.ptr, pattern.len)));
     }
+    *result = RE2::PartialMatch(re2::StringPiece(val.ptr, val.len), *state->regex);
+    return Status::OK();
 }
 
 } // namespace doris::vectorized
@@ -17,6 +17,10 @@
 
 #pragma once
 
+#ifdef DORIS_WITH_HYPERSCAN
+#include <hs/hs.h>
+#endif
+
 #include <functional>
 #include <memory>
 
@@ -53,11 +57,28 @@ struct LikeSearchState {
     /// in the value.
     doris::StringSearch substring_pattern;
 
-    /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument.
-    std::unique_ptr<re2::RE2> regex;
+    /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument, and for
+    /// all the predicates of the non-constant patterns, which reuse it while the pattern of
+    /// the rows is the same as regex_pattern.
+    std::shared_ptr<const re2::RE2> regex;
+    std::string regex_pattern;
+
+#ifdef DORIS_WITH_HYPERSCAN
+    /// Used instead of regex if the constant pattern can be compiled by hyperscan.
+    /// The scratch space is owned by the state, which is thread local.
+    hs_database_t* hs_database = nullptr;
+    hs_scratch_t* hs_scratch = nullptr;
+#endif
 
     LikeSearchState() : escape_char('\\') {}
 
+    ~LikeSearchState() {
+#ifdef DORIS_WITH_HYPERSCAN
+        hs_free_scratch(hs_scratch);
+        hs_free_database(hs_database);
+#endif
+    }
+
     void set_search_string(const std::string& search_string_arg) {
         search_string = search_string_arg;
         search_string_sv = StringValue(search_string);
@@ -105,6 +126,15 @@ protected:
 
     static Status constant_substring_fn(LikeSearchState* state, const StringValue& val,
                                         const StringValue& pattern, unsigned char* result);
+
+#ifdef DORIS_WITH_HYPERSCAN
+    // Compile the regex into the hyperscan database of state, fails if hyperscan does not
+    // support the regex, e.g. it has back references.
+    static Status hs_prepare(const std::string& regex, LikeSearchState* state);
+
+    static Status constant_regex_hs_fn(LikeSearchState* state, const StringValue& val,
+                                       const StringValue& pattern, unsigned char* result);
+#endif
 };
 
 class FunctionLike : public FunctionLikeBase {
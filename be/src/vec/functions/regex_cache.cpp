@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/functions/regex_cache.h"
+
+namespace doris::vectorized {
+
+RegexCache* RegexCache::_s_instance = nullptr;
+
+void RegexCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity == 0) {
+        return;
+    }
+    static RegexCache instance(capacity);
+    _s_instance = &instance;
+}
+
+std::shared_ptr<const re2::RE2> RegexCache::compile(const re2::StringPiece& pattern,
+                                                    const re2::RE2::Options& options) {
+    if (_s_instance != nullptr) {
+        return _s_instance->get(pattern, options);
+    }
+    return std::make_shared<const re2::RE2>(pattern, options);
+}
+
+RegexCache::RegexCache(size_t capacity) {
+    _cache.reset(new_lru_cache("RegexCache", capacity, LRUCacheType::SIZE));
+}
+
+std::string RegexCache::_key(const re2::StringPiece& pattern, const re2::RE2::Options& options) {
+    // the options deciding the compiled program, the others only affect logging
+    int flags = options.ParseFlags();
+    bool longest_match = options.longest_match();
+    int64_t max_mem = options.max_mem();
+    std::string key;
+    key.append(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    key.append(reinterpret_cast<const char*>(&longest_match), sizeof(longest_match));
+    key.append(reinterpret_cast<const char*>(&max_mem), sizeof(max_mem));
+    key.append(pattern.data(), pattern.size());
+    return key;
+}
+
+std::shared_ptr<const re2::RE2> RegexCache::get(const re2::StringPiece& pattern,
+                                                const re2::RE2::Options& options) {
+    std::string key = _key(pattern, options);
+    auto handle = _cache->lookup(CacheKey(key));
+    if (handle != nullptr) {
+        auto re = *reinterpret_cast<std::shared_ptr<const re2::RE2>*>(_cache->value(handle));
+        _cache->release(handle);
+        return re;
+    }
+
+    auto re = std::make_shared<const re2::RE2>(pattern, options);
+    if (!re->ok()) {
+        return re;
+    }
+    auto deleter = [](const CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const re2::RE2>*>(value);
+    };
+    // roughly the pattern and the instructions of the program, the DFAs built lazily by
+    // the matches are bounded by max_mem of each regex
+    size_t charge = sizeof(re2::RE2) + key.size() * 2 + re->ProgramSize() * 16;
+    handle = _cache->insert(CacheKey(key), new std::shared_ptr<const re2::RE2>(re), charge,
+                            deleter, CachePriority::NORMAL);
+    _cache->release(handle);
+    return re;
+}
+
+} // namespace doris::vectorized
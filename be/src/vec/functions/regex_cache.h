@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <re2/re2.h>
+
+#include <memory>
+#include <string>
+
+#include "olap/lru_cache.h"
+
+namespace doris::vectorized {
+
+// RegexCache caches the compiled regexes of the functions by their patterns and options,
+// so the same patterns of the queries running again and again, and the patterns from the
+// columns, are not compiled for every fragment or row. A compiled RE2 is safe to match by
+// many threads.
+class RegexCache {
+public:
+    // Caches nothing if capacity is 0.
+    static void create_global_instance(size_t capacity);
+
+    // nullptr if the cache is disabled or not created, e.g. in the tools.
+    static RegexCache* instance() { return _s_instance; }
+
+    // Returns the regex of the pattern from the global cache, or compiles it if the cache
+    // is disabled. Check ok() of the result, the patterns failed to compile are not cached.
+    static std::shared_ptr<const re2::RE2> compile(const re2::StringPiece& pattern,
+                                                   const re2::RE2::Options& options);
+
+    explicit RegexCache(size_t capacity);
+
+    std::shared_ptr<const re2::RE2> get(const re2::StringPiece& pattern,
+                                        const re2::RE2::Options& options);
+
+private:
+    static std::string _key(const re2::StringPiece& pattern, const re2::RE2::Options& options);
+
+    static RegexCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris::vectorized
@@ -32,6 +32,14 @@ OlapBlockDataConvertor::OlapBlockDataConvertor(const TabletSchema* tablet_schema
     }
 }
 
+OlapBlockDataConvertor::OlapBlockDataConvertor(const TabletSchema* tablet_schema,
+                                               const std::vector<uint32_t>& col_ids) {
+    assert(tablet_schema);
+    for (const auto& id : col_ids) {
+        _convertors.emplace_back(create_olap_column_data_convertor(tablet_schema->column(id)));
+    }
+}
+
 OlapBlockDataConvertor::OlapColumnDataConvertorBaseUPtr
 OlapBlockDataConvertor::create_olap_column_data_convertor(const TabletColumn& column) {
     switch (column.type()) {
@@ -132,7 +140,10 @@ void OlapBlockDataConvertor::OlapColumnDataConvertorBase::set_source_column(
     if (_typed_column.column->is_nullable()) {
         auto nullable_column =
                 assert_cast<const vectorized::ColumnNullable*>(_typed_column.column.get());
-        _nullmap = nullable_column->get_null_map_data().data();
+        // aligned with the data of the rows converted
+        _nullmap = nullable_column->get_null_map_data().data() + row_pos;
+    } else {
+        _nullmap = nullptr;
     }
 }
 
@@ -189,7 +200,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorBitMap::convert_to_olap()
 
     size_t total_size = 0;
     if (_nullmap) {
-        const UInt8* nullmap_cur = _nullmap + _row_pos;
+        const UInt8* nullmap_cur = _nullmap;
         while (bitmap_value_cur != bitmap_value_end) {
             if (!*nullmap_cur) {
                 total_size += bitmap_value_cur->getSizeInBytes();
@@ -210,7 +221,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorBitMap::convert_to_olap()
     char* raw_data = _raw_data.data();
     Slice* slice = _slice.data();
     if (_nullmap) {
-        const UInt8* nullmap_cur = _nullmap + _row_pos;
+        const UInt8* nullmap_cur = _nullmap;
         while (bitmap_value_cur != bitmap_value_end) {
             if (!*nullmap_cur) {
                 slice_size = bitmap_value_cur->getSizeInBytes();
@@ -228,7 +239,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorBitMap::convert_to_olap()
             ++nullmap_cur;
             ++bitmap_value_cur;
         }
-        assert(nullmap_cur == _nullmap + _row_pos + _num_rows && slice == _slice.get_end_ptr());
+        assert(nullmap_cur == _nullmap + _num_rows && slice == _slice.get_end_ptr());
     } else {
         while (bitmap_value_cur != bitmap_value_end) {
             slice_size = bitmap_value_cur->getSizeInBytes();
@@ -266,7 +277,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorHLL::convert_to_olap() {
 
     size_t total_size = 0;
     if (nullmap) {
-        const UInt8* nullmap_cur = nullmap + _row_pos;
+        const UInt8* nullmap_cur = nullmap;
         while (hll_value_cur != hll_value_end) {
             if (!*nullmap_cur) {
                 total_size += hll_value_cur->max_serialized_size();
@@ -288,7 +299,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorHLL::convert_to_olap() {
 
     hll_value_cur = hll_value;
     if (nullmap) {
-        const UInt8* nullmap_cur = nullmap + _row_pos;
+        const UInt8* nullmap_cur = nullmap;
         while (hll_value_cur != hll_value_end) {
             if (!*nullmap_cur) {
                 slice_size = hll_value_cur->serialize((uint8_t*)raw_data);
@@ -305,7 +316,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorHLL::convert_to_olap() {
             ++nullmap_cur;
             ++hll_value_cur;
         }
-        assert(nullmap_cur == nullmap + _row_pos + _num_rows && slice == _slice.get_end_ptr());
+        assert(nullmap_cur == nullmap + _num_rows && slice == _slice.get_end_ptr());
     } else {
         while (hll_value_cur != hll_value_end) {
             slice_size = hll_value_cur->serialize((uint8_t*)raw_data);
@@ -360,19 +371,25 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorChar::convert_to_olap() {
         column_string = assert_cast<const vectorized::ColumnString*>(_typed_column.column.get());
     }
 
-    // If column_string is not padded to full, we should do padding here.
-    if (should_padding(column_string, _length)) {
-        _column = clone_and_padding(column_string, _length);
-        column_string = assert_cast<const vectorized::ColumnString*>(_column.get());
-    }
-
+    // The strings of the full length are referenced in place, only the shorter ones of the
+    // rows converted are copied and padded, instead of padding the whole column.
+    _padded_chars.resize(_num_rows * _length);
+    char* padded = _padded_chars.data();
     for (size_t i = 0; i < _num_rows; i++) {
-        if (!_nullmap || !_nullmap[i + _row_pos]) {
-            _slice[i] = column_string->get_data_at(i + _row_pos).to_slice();
-            DCHECK(_slice[i].size == _length)
-                    << "char type data length not equal to schema, schema=" << _length
-                    << ", real=" << _slice[i].size;
+        if (_nullmap && _nullmap[i]) {
+            continue;
+        }
+        auto str = column_string->get_data_at(i + _row_pos);
+        DCHECK(str.size <= _length) << "char type data length over limit, padding_length="
+                                    << _length << ", real=" << str.size;
+        if (str.size == _length) {
+            _slice[i] = str.to_slice();
+            continue;
         }
+        memcpy(padded, str.data, str.size);
+        memset(padded + str.size, 0, _length - str.size);
+        _slice[i] = Slice(padded, _length);
+        padded += _length;
     }
 
     return Status::OK();
@@ -424,14 +441,17 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorVarChar::convert_to_olap()
 
     Slice* slice = _slice.data();
     size_t string_offset = *(offset_cur - 1);
+    // the strings are checked one by one only if they may exceed the limit in total
+    const bool check_length = _check_length && *(offset_end - 1) - string_offset >
+                                                       config::string_type_length_soft_limit_bytes;
     if (_nullmap) {
-        const UInt8* nullmap_cur = _nullmap + _row_pos;
+        const UInt8* nullmap_cur = _nullmap;
         while (offset_cur != offset_end) {
             if (!*nullmap_cur) {
                 slice->data = const_cast<char*>(char_data + string_offset);
                 slice->size = *offset_cur - string_offset - 1;
-                if (UNLIKELY(slice->size > config::string_type_length_soft_limit_bytes &&
-                             _check_length)) {
+                if (UNLIKELY(check_length &&
+                             slice->size > config::string_type_length_soft_limit_bytes)) {
                     return Status::NotSupported(
                             "Not support string len over than "
                             "`string_type_length_soft_limit_bytes` in vec engine.");
@@ -446,13 +466,13 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorVarChar::convert_to_olap()
             ++slice;
             ++offset_cur;
         }
-        assert(nullmap_cur == _nullmap + _row_pos + _num_rows && slice == _slice.get_end_ptr());
+        assert(nullmap_cur == _nullmap + _num_rows && slice == _slice.get_end_ptr());
     } else {
         while (offset_cur != offset_end) {
             slice->data = const_cast<char*>(char_data + string_offset);
             slice->size = *offset_cur - string_offset - 1;
-            if (UNLIKELY(slice->size > config::string_type_length_soft_limit_bytes &&
-                         _check_length)) {
+            if (UNLIKELY(check_length &&
+                         slice->size > config::string_type_length_soft_limit_bytes)) {
                 return Status::NotSupported(
                         "Not support string len over than `string_type_length_soft_limit_bytes`"
                         " in vec engine.");
@@ -486,7 +506,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorDate::convert_to_olap() {
     const VecDateTimeValue* datetime_end = datetime_cur + _num_rows;
     uint24_t* value = _values.data();
     if (_nullmap) {
-        const UInt8* nullmap_cur = _nullmap + _row_pos;
+        const UInt8* nullmap_cur = _nullmap;
         while (datetime_cur != datetime_end) {
             if (!*nullmap_cur) {
                 *value = datetime_cur->to_olap_date();
@@ -497,7 +517,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorDate::convert_to_olap() {
             ++datetime_cur;
             ++nullmap_cur;
         }
-        assert(nullmap_cur == _nullmap + _row_pos + _num_rows && value == _values.get_end_ptr());
+        assert(nullmap_cur == _nullmap + _num_rows && value == _values.get_end_ptr());
     } else {
         while (datetime_cur != datetime_end) {
             *value = datetime_cur->to_olap_date();
@@ -529,7 +549,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorDateTime::convert_to_olap(
     const VecDateTimeValue* datetime_end = datetime_cur + _num_rows;
     uint64_t* value = _values.data();
     if (_nullmap) {
-        const UInt8* nullmap_cur = _nullmap + _row_pos;
+        const UInt8* nullmap_cur = _nullmap;
         while (datetime_cur != datetime_end) {
             if (!*nullmap_cur) {
                 *value = datetime_cur->to_olap_datetime();
@@ -540,7 +560,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorDateTime::convert_to_olap(
             ++datetime_cur;
             ++nullmap_cur;
         }
-        assert(nullmap_cur == _nullmap + _row_pos + _num_rows && value == _values.get_end_ptr());
+        assert(nullmap_cur == _nullmap + _num_rows && value == _values.get_end_ptr());
     } else {
         while (datetime_cur != datetime_end) {
             *value = datetime_cur->to_olap_datetime();
@@ -572,7 +592,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorDecimal::convert_to_olap()
     const DecimalV2Value* decimal_end = decimal_cur + _num_rows;
     decimal12_t* value = _values.data();
     if (_nullmap) {
-        const UInt8* nullmap_cur = _nullmap + _row_pos;
+        const UInt8* nullmap_cur = _nullmap;
         while (decimal_cur != decimal_end) {
             if (!*nullmap_cur) {
                 value->integer = decimal_cur->int_value();
@@ -584,7 +604,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorDecimal::convert_to_olap()
             ++decimal_cur;
             ++nullmap_cur;
         }
-        assert(nullmap_cur == _nullmap + _row_pos + _num_rows && value == _values.get_end_ptr());
+        assert(nullmap_cur == _nullmap + _num_rows && value == _values.get_end_ptr());
     } else {
         while (decimal_cur != decimal_end) {
             value->integer = decimal_cur->int_value();
@@ -620,7 +640,7 @@ Status OlapBlockDataConvertor::OlapColumnDataConvertorArray::convert_to_olap() {
     for (int i = 0; i < _num_rows; ++i, ++collection_value) {
         int64_t cur_pos = _row_pos + i;
         int64_t prev_pos = cur_pos - 1;
-        if (_nullmap && _nullmap[cur_pos]) {
+        if (_nullmap && _nullmap[i]) {
             continue;
         }
         auto offset = offsets[prev_pos];
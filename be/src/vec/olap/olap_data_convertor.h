@@ -35,6 +35,8 @@ public:
 class OlapBlockDataConvertor {
 public:
     OlapBlockDataConvertor(const TabletSchema* tablet_schema);
+    // only convert the columns in `col_ids`, the source block should only contain these columns
+    OlapBlockDataConvertor(const TabletSchema* tablet_schema, const std::vector<uint32_t>& col_ids);
     void set_source_content(const vectorized::Block* block, size_t row_pos, size_t num_rows);
     void clear_source_content();
     std::pair<Status, IOlapColumnDataAccessor*> convert_column_data(size_t cid);
@@ -103,41 +105,10 @@ private:
         Status convert_to_olap() override;
 
     private:
-        static bool should_padding(const ColumnString* column, size_t padding_length) {
-            // Check sum of data length, including terminating zero.
-            return column->size() * (padding_length + 1) != column->chars.size();
-        }
-
-        static ColumnPtr clone_and_padding(const ColumnString* input, size_t padding_length) {
-            auto column = vectorized::ColumnString::create();
-            auto padded_column =
-                    assert_cast<vectorized::ColumnString*>(column->assume_mutable().get());
-
-            column->offsets.resize(input->size());
-            column->chars.resize(input->size() * (padding_length + 1));
-            memset(padded_column->chars.data(), 0, input->size() * (padding_length + 1));
-
-            for (size_t i = 0; i < input->size(); i++) {
-                column->offsets[i] = (i + 1) * (padding_length + 1);
-
-                auto str = input->get_data_at(i);
-
-                DCHECK(str.size <= padding_length)
-                        << "char type data length over limit, padding_length=" << padding_length
-                        << ", real=" << str.size;
-
-                if (str.size) {
-                    memcpy(padded_column->chars.data() + i * (padding_length + 1), str.data,
-                           str.size);
-                }
-            }
-
-            return column;
-        }
-
         size_t _length;
         PaddedPODArray<Slice> _slice;
-        ColumnPtr _column = nullptr;
+        // the strings shorter than _length padded with zeros
+        PaddedPODArray<char> _padded_chars;
     };
 
     class OlapColumnDataConvertorVarChar : public OlapColumnDataConvertorBase {
@@ -37,9 +37,11 @@ VCollectIterator::~VCollectIterator() {}
 void VCollectIterator::init(TabletReader* reader) {
     _reader = reader;
     // when aggregate is enabled or key_type is DUP_KEYS, we don't merge
-    // multiple data to aggregate for better performance
+    // multiple data to aggregate for better performance.
+    // unique keys with merge-on-write have no duplicated keys among rowsets either.
     if (_reader->_reader_type == READER_QUERY &&
-        (_reader->_direct_mode || _reader->_tablet->keys_type() == KeysType::DUP_KEYS)) {
+        (_reader->_direct_mode || _reader->_tablet->keys_type() == KeysType::DUP_KEYS ||
+         _reader->_tablet->enable_unique_key_merge_on_write())) {
         _merge = false;
     }
 }
@@ -317,11 +319,7 @@ Status VCollectIterator::Level1Iterator::init() {
             }
         }
         _heap.reset(new MergeHeap {LevelIteratorComparator(sequence_loc)});
-        for (auto child : _children) {
-            DCHECK(child != nullptr);
-            //DCHECK(child->current_row().ok());
-            _heap->push(child);
-        }
+        _heap->init(std::vector<LevelIterator*>(_children.begin(), _children.end()));
         _cur_child = _heap->top();
         // Clear _children earlier to release any related references
         _children.clear();
@@ -335,14 +333,14 @@ Status VCollectIterator::Level1Iterator::init() {
 }
 
 Status VCollectIterator::Level1Iterator::_merge_next(IteratorRowRef* ref) {
-    _heap->pop();
     auto res = _cur_child->next(ref);
     if (LIKELY(res.ok())) {
-        _heap->push(_cur_child);
+        _heap->update_top();
         _cur_child = _heap->top();
     } else if (res.precise_code() == OLAP_ERR_DATA_EOF) {
         // current child has been read, to read next
         delete _cur_child;
+        _heap->pop_top();
         if (!_heap->empty()) {
             _cur_child = _heap->top();
         } else {
@@ -17,15 +17,10 @@
 
 #pragma once
 
-#ifdef USE_LIBCPP
-#include <queue>
-#else
-#include <ext/pb_ds/priority_queue.hpp>
-#endif
-
 #include "olap/olap_define.h"
 #include "olap/reader.h"
 #include "olap/rowset/rowset_reader.h"
+#include "vec/common/loser_tree.h"
 #include "vec/core/block.h"
 
 namespace doris {
@@ -68,7 +63,7 @@ private:
     // This interface is the actual implementation of the new version of iterator.
     // It currently contains two implementations, one is Level0Iterator,
     // which only reads data from the rowset reader, and the other is Level1Iterator,
-    // which can read merged data from multiple LevelIterators through MergeHeap.
+    // which can read merged data from multiple LevelIterators through MergeHeap (a loser tree).
     // By using Level1Iterator, some rowset readers can be merged in advance and
     // then merged with other rowset readers.
     class LevelIterator {
@@ -110,13 +105,10 @@ private:
         int _sequence;
     };
 
-#ifdef USE_LIBCPP
-    using MergeHeap = std::priority_queue<LevelIterator*, std::vector<LevelIterator*>,
-                                          LevelIteratorComparator>;
-#else
-    using MergeHeap = __gnu_pbds::priority_queue<LevelIterator*, LevelIteratorComparator,
-                                                 __gnu_pbds::pairing_heap_tag>;
-#endif
+    // Advancing the top child only replays the matches on its path, and the equal rows
+    // are always compared with the winner on the way, so the lower versions are still
+    // marked by LevelIteratorComparator.
+    using MergeHeap = LoserTree<LevelIterator*, LevelIteratorComparator>;
 
     // Iterate from rowset reader. This Iterator usually like a leaf node
     class Level0Iterator : public LevelIterator {
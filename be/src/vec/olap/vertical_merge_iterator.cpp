@@ -0,0 +1,350 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_merge_iterator.h"
+
+#include <queue>
+
+#include "olap/schema.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+namespace vectorized {
+
+size_t RowSourcesBuffer::same_source_count(size_t limit) const {
+    size_t end = std::min(_buffer.size(), _position + limit);
+    uint16_t data = _buffer[_position];
+    size_t pos = _position + 1;
+    while (pos < end && _buffer[pos] == data) {
+        ++pos;
+    }
+    return pos - _position;
+}
+
+// Used to store merge state of an input iterator for vertical merge iterators.
+// Unlike VMergeIteratorContext, the input iterator has been inited by the client,
+// because the inputs of vertical compaction have different read options.
+class VerticalMergeIteratorContext {
+public:
+    VerticalMergeIteratorContext(RowwiseIterator* iter, uint16_t order)
+            : _iter(iter), _order(order), _num_key_columns(iter->schema().num_key_columns()) {}
+
+    VerticalMergeIteratorContext(const VerticalMergeIteratorContext&) = delete;
+    VerticalMergeIteratorContext& operator=(const VerticalMergeIteratorContext&) = delete;
+
+    ~VerticalMergeIteratorContext() {
+        delete _iter;
+        _iter = nullptr;
+    }
+
+    // Prepare data for the first row
+    Status init(const StorageReadOptions& opts) {
+        _block_row_max = opts.block_row_max;
+        RETURN_IF_ERROR(_block_reset());
+        return _load_next_block();
+    }
+
+    // Return true if the current row of this context is greater than the one of `rhs`,
+    // rows with the same key are ordered by `_order`, the larger one comes first if
+    // `newer_first` is true.
+    bool compare(const VerticalMergeIteratorContext& rhs, bool newer_first) const {
+        int cmp_res = _block.compare_at(_index_in_block, rhs._index_in_block, _num_key_columns,
+                                        rhs._block, -1);
+        if (cmp_res != 0) {
+            return cmp_res > 0;
+        }
+        return newer_first ? _order < rhs._order : _order > rhs._order;
+    }
+
+    bool is_same_key(const VerticalMergeIteratorContext& rhs) const {
+        return _block.compare_at(_index_in_block, rhs._index_in_block, _num_key_columns,
+                                 rhs._block, -1) == 0;
+    }
+
+    // copy `count` rows from the current row to `block`
+    void copy_rows(Block* block, size_t count = 1) {
+        for (size_t i = 0; i < _block.columns(); ++i) {
+            auto& s_col = _block.get_by_position(i).column;
+            auto& d_col = block->get_by_position(i).column;
+            if (count == 1) {
+                ((IColumn&)(*d_col)).insert_from(*s_col, _index_in_block);
+            } else {
+                ((IColumn&)(*d_col)).insert_range_from(*s_col, _index_in_block, count);
+            }
+        }
+    }
+
+    // Advance `step` rows, which should not exceed remain_rows()
+    Status advance(size_t step = 1) {
+        DCHECK_LE(step, remain_rows());
+        _index_in_block += step;
+        if (_index_in_block < _block.rows()) {
+            return Status::OK();
+        }
+        return _load_next_block();
+    }
+
+    bool valid() const { return _valid; }
+
+    // number of the rows left in the current block
+    size_t remain_rows() const { return _block.rows() - _index_in_block; }
+
+    uint16_t order() const { return _order; }
+
+private:
+    Status _block_reset() {
+        if (_block.columns() > 0) {
+            _block.clear_column_data();
+            return Status::OK();
+        }
+        const Schema& schema = _iter->schema();
+        for (auto cid : schema.column_ids()) {
+            auto column_desc = schema.column(cid);
+            auto data_type = Schema::get_data_type_ptr(*column_desc);
+            if (data_type == nullptr) {
+                return Status::RuntimeError("invalid data type");
+            }
+            auto column = data_type->create_column();
+            column->reserve(_block_row_max);
+            _block.insert(ColumnWithTypeAndName(std::move(column), data_type, column_desc->name()));
+        }
+        return Status::OK();
+    }
+
+    Status _load_next_block() {
+        do {
+            RETURN_IF_ERROR(_block_reset());
+            Status st = _iter->next_batch(&_block);
+            if (!st.ok()) {
+                _valid = false;
+                return st.is_end_of_file() ? Status::OK() : st;
+            }
+        } while (_block.rows() == 0);
+        _index_in_block = 0;
+        _valid = true;
+        return Status::OK();
+    }
+
+    RowwiseIterator* _iter;
+    uint16_t _order;
+    int _num_key_columns;
+
+    Block _block;
+    size_t _index_in_block = 0;
+    bool _valid = false;
+    int _block_row_max = 4096;
+};
+
+class VerticalHeapMergeIterator : public RowwiseIterator {
+public:
+    // VerticalHeapMergeIterator takes the ownership of input iterators
+    VerticalHeapMergeIterator(std::vector<RowwiseIterator*>& iters, bool is_unique,
+                              RowSourcesBuffer* row_sources_buf)
+            : _origin_iters(iters),
+              _is_unique(is_unique),
+              _row_sources_buf(row_sources_buf),
+              _merge_heap(VerticalMergeContextComparator {is_unique}) {}
+
+    ~VerticalHeapMergeIterator() override {
+        while (!_merge_heap.empty()) {
+            auto ctx = _merge_heap.top();
+            _merge_heap.pop();
+            delete ctx;
+        }
+        std::for_each(_origin_iters.begin(), _origin_iters.end(),
+                      std::default_delete<RowwiseIterator>());
+    }
+
+    Status init(const StorageReadOptions& opts) override;
+
+    Status next_batch(Block* block) override;
+
+    const Schema& schema() const override { return *_schema; }
+
+private:
+    // Pop the top context of heap and push it back if it has more data
+    Status _advance_top(VerticalMergeIteratorContext* ctx);
+
+    // It will be released after '_merge_heap' has been built.
+    std::vector<RowwiseIterator*> _origin_iters;
+    const Schema* _schema = nullptr;
+    bool _is_unique = false;
+    RowSourcesBuffer* _row_sources_buf;
+
+    struct VerticalMergeContextComparator {
+        bool newer_first;
+        bool operator()(const VerticalMergeIteratorContext* lhs,
+                        const VerticalMergeIteratorContext* rhs) const {
+            return lhs->compare(*rhs, newer_first);
+        }
+    };
+
+    std::priority_queue<VerticalMergeIteratorContext*, std::vector<VerticalMergeIteratorContext*>,
+                        VerticalMergeContextComparator>
+            _merge_heap;
+
+    int _block_row_max = 0;
+};
+
+Status VerticalHeapMergeIterator::init(const StorageReadOptions& opts) {
+    if (_origin_iters.empty()) {
+        return Status::OK();
+    }
+    if (_origin_iters.size() > RowSource::MAX_SOURCE_NUM) {
+        return Status::NotSupported("too many input iterators for vertical merge");
+    }
+    _schema = &(*_origin_iters.begin())->schema();
+
+    for (uint16_t order = 0; order < _origin_iters.size(); ++order) {
+        auto ctx = std::make_unique<VerticalMergeIteratorContext>(_origin_iters[order], order);
+        // the ownership has been transferred to ctx
+        _origin_iters[order] = nullptr;
+        RETURN_IF_ERROR(ctx->init(opts));
+        if (!ctx->valid()) {
+            continue;
+        }
+        _merge_heap.push(ctx.release());
+    }
+    _origin_iters.clear();
+    _block_row_max = opts.block_row_max;
+    return Status::OK();
+}
+
+Status VerticalHeapMergeIterator::_advance_top(VerticalMergeIteratorContext* ctx) {
+    RETURN_IF_ERROR(ctx->advance());
+    if (ctx->valid()) {
+        _merge_heap.push(ctx);
+    } else {
+        // Release ctx earlier to reduce resource consumed
+        delete ctx;
+    }
+    return Status::OK();
+}
+
+Status VerticalHeapMergeIterator::next_batch(Block* block) {
+    while (block->rows() < _block_row_max && !_merge_heap.empty()) {
+        auto ctx = _merge_heap.top();
+        _merge_heap.pop();
+        ctx->copy_rows(block);
+        _row_sources_buf->append(RowSource(ctx->order(), false));
+        if (_is_unique) {
+            // the rows with the same key are ordered from newer to older, and the keys
+            // of one input are unique, so all the rows left with this key are merged
+            while (!_merge_heap.empty() && _merge_heap.top()->is_same_key(*ctx)) {
+                auto same_ctx = _merge_heap.top();
+                _merge_heap.pop();
+                _row_sources_buf->append(RowSource(same_ctx->order(), true));
+                RETURN_IF_ERROR(_advance_top(same_ctx));
+            }
+        }
+        RETURN_IF_ERROR(_advance_top(ctx));
+    }
+    if (block->rows() == 0 && _merge_heap.empty()) {
+        return Status::EndOfFile("no more data in segment");
+    }
+    return Status::OK();
+}
+
+class VerticalMaskMergeIterator : public RowwiseIterator {
+public:
+    // VerticalMaskMergeIterator takes the ownership of input iterators
+    VerticalMaskMergeIterator(std::vector<RowwiseIterator*>& iters,
+                              RowSourcesBuffer* row_sources_buf)
+            : _origin_iters(iters), _row_sources_buf(row_sources_buf) {}
+
+    ~VerticalMaskMergeIterator() override {
+        std::for_each(_origin_iters.begin(), _origin_iters.end(),
+                      std::default_delete<RowwiseIterator>());
+    }
+
+    Status init(const StorageReadOptions& opts) override;
+
+    Status next_batch(Block* block) override;
+
+    const Schema& schema() const override { return *_schema; }
+
+private:
+    // It will be released after the contexts have been built.
+    std::vector<RowwiseIterator*> _origin_iters;
+    const Schema* _schema = nullptr;
+    RowSourcesBuffer* _row_sources_buf;
+
+    std::vector<std::unique_ptr<VerticalMergeIteratorContext>> _origin_iter_ctx;
+
+    int _block_row_max = 0;
+};
+
+Status VerticalMaskMergeIterator::init(const StorageReadOptions& opts) {
+    if (_origin_iters.empty()) {
+        return Status::OK();
+    }
+    _schema = &(*_origin_iters.begin())->schema();
+
+    if (_origin_iters.size() > RowSource::MAX_SOURCE_NUM) {
+        return Status::NotSupported("too many input iterators for vertical merge");
+    }
+    for (uint16_t order = 0; order < _origin_iters.size(); ++order) {
+        _origin_iter_ctx.emplace_back(
+                std::make_unique<VerticalMergeIteratorContext>(_origin_iters[order], order));
+        // the ownership has been transferred to the context
+        _origin_iters[order] = nullptr;
+        RETURN_IF_ERROR(_origin_iter_ctx.back()->init(opts));
+    }
+    _origin_iters.clear();
+    _block_row_max = opts.block_row_max;
+    return Status::OK();
+}
+
+Status VerticalMaskMergeIterator::next_batch(Block* block) {
+    while (block->rows() < _block_row_max && _row_sources_buf->has_remaining()) {
+        auto row_source = _row_sources_buf->current();
+        auto order = row_source.get_source_num();
+        if (UNLIKELY(order >= _origin_iter_ctx.size() || !_origin_iter_ctx[order]->valid())) {
+            return Status::InternalError(
+                    fmt::format("invalid row source {} of vertical merge", order));
+        }
+        auto& ctx = _origin_iter_ctx[order];
+        // the continuous rows from the same input are copied together
+        size_t limit = std::min(ctx->remain_rows(), size_t(_block_row_max - block->rows()));
+        size_t count = _row_sources_buf->same_source_count(limit);
+        if (!row_source.agg_flag()) {
+            ctx->copy_rows(block, count);
+        }
+        RETURN_IF_ERROR(ctx->advance(count));
+        _row_sources_buf->advance(count);
+    }
+    if (block->rows() == 0 && !_row_sources_buf->has_remaining()) {
+        return Status::EndOfFile("no more data in segment");
+    }
+    return Status::OK();
+}
+
+RowwiseIterator* new_vertical_heap_merge_iterator(std::vector<RowwiseIterator*>& inputs,
+                                                  bool is_unique,
+                                                  RowSourcesBuffer* row_sources_buf) {
+    return new VerticalHeapMergeIterator(inputs, is_unique, row_sources_buf);
+}
+
+RowwiseIterator* new_vertical_mask_merge_iterator(std::vector<RowwiseIterator*>& inputs,
+                                                  RowSourcesBuffer* row_sources_buf) {
+    return new VerticalMaskMergeIterator(inputs, row_sources_buf);
+}
+
+} // namespace vectorized
+
+} // namespace doris
@@ -0,0 +1,102 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "olap/iterators.h"
+
+namespace doris {
+
+namespace vectorized {
+
+// RowSource records where a merged row of vertical compaction comes from: the index of
+// the input iterator (source_num), and whether the row is merged into another row with
+// the same key (agg_flag), in which case it is not written to the output.
+class RowSource {
+public:
+    explicit RowSource(uint16_t data) : _data(data) {}
+    RowSource(uint16_t source_num, bool agg_flag)
+            : _data((source_num & SOURCE_NUM_MASK) | (agg_flag ? AGG_FLAG : 0)) {}
+
+    uint16_t get_source_num() const { return _data & SOURCE_NUM_MASK; }
+    bool agg_flag() const { return (_data & AGG_FLAG) != 0; }
+    uint16_t data() const { return _data; }
+
+    // the max number of input iterators
+    static constexpr uint16_t MAX_SOURCE_NUM = 0x7FFF;
+
+private:
+    static constexpr uint16_t SOURCE_NUM_MASK = 0x7FFF;
+    static constexpr uint16_t AGG_FLAG = 0x8000;
+
+    uint16_t _data;
+};
+
+// RowSourcesBuffer keeps the row sources generated when merging the key columns, and is
+// replayed to merge every group of value columns in the same order. It takes 2 bytes for
+// each input row.
+class RowSourcesBuffer {
+public:
+    void append(RowSource source) { _buffer.push_back(source.data()); }
+
+    void seek_to_begin() { _position = 0; }
+    bool has_remaining() const { return _position < _buffer.size(); }
+    RowSource current() const { return RowSource(_buffer[_position]); }
+    void advance(size_t step = 1) { _position += step; }
+
+    // Return the number of continuous row sources which are the same as the current one,
+    // at most `limit`.
+    size_t same_source_count(size_t limit) const;
+
+    size_t total_size() const { return _buffer.size(); }
+    void clear() {
+        _buffer.clear();
+        _position = 0;
+    }
+
+private:
+    std::vector<uint16_t> _buffer;
+    size_t _position = 0;
+};
+
+// Create a merge iterator for the key columns of vertical compaction. It merges ordered
+// input iterators like the merge iterator, and records the source of every input row in
+// `row_sources_buf`. For unique keys, only the row from the last input iterator is output
+// among the rows with the same key, the others are recorded with agg_flag.
+//
+// Input iterators should have been inited, and their ownership is taken by the created
+// iterator. Client should delete returned iterator after usage.
+RowwiseIterator* new_vertical_heap_merge_iterator(std::vector<RowwiseIterator*>& inputs,
+                                                  bool is_unique,
+                                                  RowSourcesBuffer* row_sources_buf);
+
+// Create a merge iterator for a group of value columns of vertical compaction. It reads
+// the input iterators in the order recorded in `row_sources_buf`, and skips the rows with
+// agg_flag. The inputs must be the same as the ones used for the key columns, in the same
+// order.
+//
+// Input iterators should have been inited, and their ownership is taken by the created
+// iterator. Client should delete returned iterator after usage.
+RowwiseIterator* new_vertical_mask_merge_iterator(std::vector<RowwiseIterator*>& inputs,
+                                                  RowSourcesBuffer* row_sources_buf);
+
+} // namespace vectorized
+
+} // namespace doris
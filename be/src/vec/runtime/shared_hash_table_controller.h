@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "vec/common/arena.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+class RuntimeState;
+
+namespace vectorized {
+
+// The hash table built by one instance of a broadcast join, and everything it refers to.
+struct SharedHashTableContext {
+    Status status;
+    // JoinHashTableVariants of the hash join node, the type is erased to keep this header
+    // independent of the hash join.
+    std::shared_ptr<void> hash_table_variants;
+    std::shared_ptr<std::vector<Block>> blocks;
+    std::shared_ptr<Arena> arena;
+    std::vector<std::shared_ptr<Arena>> parallel_build_arenas;
+    std::shared_ptr<std::unordered_map<const Block*, std::vector<int>>> inserted_rows;
+};
+
+using SharedHashTableContextPtr = std::shared_ptr<SharedHashTableContext>;
+
+// All instances of a broadcast join on one BE receive the same build side, so only the first
+// instance builds the hash table, and the others wait for it and probe it read-only.
+// There is one controller in each QueryFragmentsCtx, the hash tables are keyed by the id of
+// the join node.
+class SharedHashTableController {
+public:
+    // Return true if the instance `fragment_instance_id` should build the hash table of the
+    // join node `node_id`.
+    bool should_build_hash_table(const TUniqueId& fragment_instance_id, int node_id);
+
+    // Publish the hash table of the join node `node_id` built by this instance, the context
+    // carries the error status if the build failed.
+    void signal(int node_id, SharedHashTableContextPtr context);
+
+    // Wait until the hash table of the join node `node_id` is built, or the query is cancelled.
+    Status wait_for_signal(RuntimeState* state, int node_id, SharedHashTableContextPtr* context);
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::map<int, TUniqueId> _builder_fragment_ids;
+    std::map<int, SharedHashTableContextPtr> _shared_contexts;
+};
+
+} // namespace vectorized
+} // namespace doris
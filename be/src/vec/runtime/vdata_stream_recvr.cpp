@@ -20,6 +20,7 @@
 #include "gen_cpp/data.pb.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/thread_context.h"
+#include "util/query_trace.h"
 #include "util/uid_util.h"
 #include "vec/core/block.h"
 #include "vec/core/materialize_block.h"
@@ -49,6 +50,7 @@ Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
         CANCEL_SAFE_SCOPED_TIMER(
                 _received_first_batch ? NULL : _recvr->_first_batch_wait_total_timer,
                 &_is_cancelled);
+        SCOPED_QUERY_TRACE("exchange", "wait_block");
         _data_arrival_cv.wait(l);
     }
 
@@ -87,6 +89,11 @@ Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
     return Status::OK();
 }
 
+bool VDataStreamRecvr::SenderQueue::ready_to_read() {
+    std::lock_guard<std::mutex> l(_lock);
+    return _is_cancelled || !_block_queue.empty() || _num_remaining_senders == 0;
+}
+
 void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
                                               int64_t packet_seq,
                                               ::google::protobuf::Closure** done) {
@@ -162,9 +169,14 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
     size_t block_size = nblock->bytes();
     _block_queue.emplace_back(block_size, nblock);
     _recvr->_block_mem_tracker->consume(nblock->bytes());
+    // Wait only if the buffer is full before adding this block, so a sender which checks
+    // is_full() before sending is never blocked unless racing with the other senders.
+    // The block is counted before waiting, as get_batch() may pop it meanwhile.
+    bool is_full = _recvr->is_full();
+    _recvr->_num_buffered_bytes += block_size;
     _data_arrival_cv.notify_one();
 
-    if (_recvr->exceeds_limit(block_size)) {
+    if (is_full) {
         std::thread::id tid = std::this_thread::get_id();
         MonotonicStopWatch monotonicStopWatch;
         monotonicStopWatch.start();
@@ -176,8 +188,6 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
         _pending_closures.emplace_back(iter->second.get(), monotonicStopWatch);
         iter->second->wait(l);
     }
-
-    _recvr->_num_buffered_bytes += block_size;
 }
 
 void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
@@ -321,6 +331,16 @@ void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move) {
     _sender_queues[use_sender_id]->add_block(block, use_move);
 }
 
+bool VDataStreamRecvr::ready_to_read() {
+    // the merger may read any of the sender queues
+    for (auto* sender_queue : _sender_queues) {
+        if (!sender_queue->ready_to_read()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status VDataStreamRecvr::get_next(Block* block, bool* eos) {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
     if (!_is_merging) {
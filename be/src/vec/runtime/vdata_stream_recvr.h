@@ -70,6 +70,13 @@ public:
 
     Status get_next(Block* block, bool* eos);
 
+    // Whether get_next() returns without waiting for the senders, used by pipelines.
+    bool ready_to_read();
+
+    // Whether the buffered blocks exceed the buffer limit, a local sender waits for the
+    // blocks to be read when it adds a block then.
+    bool is_full() const { return _num_buffered_bytes > _total_buffer_limit; }
+
     const TUniqueId& fragment_instance_id() const { return _fragment_instance_id; }
     PlanNodeId dest_node_id() const { return _dest_node_id; }
     const RowDescriptor& row_desc() const { return _row_desc; }
@@ -151,6 +158,9 @@ public:
 
     Status get_batch(Block** next_block);
 
+    // Whether get_batch() returns without waiting.
+    bool ready_to_read();
+
     void add_block(const PBlock& pblock, int be_number, int64_t packet_seq,
                    ::google::protobuf::Closure** done);
 
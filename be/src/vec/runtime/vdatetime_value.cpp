@@ -68,10 +68,45 @@ bool VecDateTimeValue::check_date(uint32_t year, uint32_t month, uint32_t day) {
     return false;
 }
 
+// Parses the usual "YYYY-MM-DD" and "YYYY-MM-DD HH:MM:SS" formats without scanning the fields,
+// returns false if the string is not in one of them.
+static bool parse_fixed_format_date_str(const char* s, int len, uint32_t (&vals)[6]) {
+    if (len != 10 && len != 19) {
+        return false;
+    }
+    if (s[4] != '-' || s[7] != '-' ||
+        (len == 19 && (s[10] != ' ' || s[13] != ':' || s[16] != ':'))) {
+        return false;
+    }
+    for (int i = 0; i < len; ++i) {
+        if (i != 4 && i != 7 && i != 10 && i != 13 && i != 16 && (s[i] < '0' || s[i] > '9')) {
+            return false;
+        }
+    }
+    auto two_digits = [s](int i) { return uint32_t(s[i] - '0') * 10 + (s[i + 1] - '0'); };
+    vals[0] = two_digits(0) * 100 + two_digits(2);
+    vals[1] = two_digits(5);
+    vals[2] = two_digits(8);
+    if (len == 19) {
+        vals[3] = two_digits(11);
+        vals[4] = two_digits(14);
+        vals[5] = two_digits(17);
+    }
+    return true;
+}
+
 // The interval format is that with no delimiters
 // YYYY-MM-DD HH-MM-DD.FFFFFF AM in default format
 // 0    1  2  3  4  5  6      7
 bool VecDateTimeValue::from_date_str(const char* date_str, int len) {
+    uint32_t fixed_vals[6] = {0, 0, 0, 0, 0, 0};
+    if (parse_fixed_format_date_str(date_str, len, fixed_vals)) {
+        _neg = false;
+        _type = len == 10 ? TIME_DATE : TIME_DATETIME;
+        return check_range_and_set_time(fixed_vals[0], fixed_vals[1], fixed_vals[2],
+                                        fixed_vals[3], fixed_vals[4], fixed_vals[5], _type);
+    }
+
     const char* ptr = date_str;
     const char* end = date_str + len;
     // ONLY 2, 6 can follow by a sapce
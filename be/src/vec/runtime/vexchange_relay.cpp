@@ -0,0 +1,139 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vexchange_relay.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "common/status.h"
+#include "runtime/exec_env.h"
+#include "service/backend_options.h"
+#include "util/brpc_client_cache.h"
+
+namespace doris::vectorized {
+
+std::vector<std::pair<int, int>> split_relay_destinations(int num_destinations, int fanout) {
+    std::vector<std::pair<int, int>> subtrees;
+    if (num_destinations <= 0 || fanout <= 0) {
+        return subtrees;
+    }
+    int num_subtrees = std::min(num_destinations, fanout);
+    int size = num_destinations / num_subtrees;
+    int num_larger = num_destinations % num_subtrees;
+    int begin = 0;
+    for (int i = 0; i < num_subtrees; ++i) {
+        int end = begin + size + (i < num_larger ? 1 : 0);
+        subtrees.emplace_back(begin, end);
+        begin = end;
+    }
+    return subtrees;
+}
+
+class ExchangeRelayClosure::ForwardClosure : public google::protobuf::Closure {
+public:
+    ForwardClosure(ExchangeRelayClosure* parent, std::string dest)
+            : _parent(parent), _dest(std::move(dest)) {}
+
+    void Run() override {
+        if (cntl.Failed()) {
+            _parent->_set_error(fmt::format("failed to relay block to {}: {}", _dest,
+                                            cntl.ErrorText()));
+        } else if (Status st(result.status()); !st.ok()) {
+            _parent->_set_error(
+                    fmt::format("failed to relay block to {}: {}", _dest, st.get_error_msg()));
+        }
+        _parent->Run();
+        delete this;
+    }
+
+    brpc::Controller cntl;
+    PTransmitDataResult result;
+
+private:
+    ExchangeRelayClosure* _parent;
+    std::string _dest;
+};
+
+google::protobuf::Closure* ExchangeRelayClosure::relay(ExecEnv* exec_env, brpc::Controller* cntl,
+                                                       const PTransmitDataParams& request,
+                                                       google::protobuf::Closure* done) {
+    const auto& dests = request.relay_destinations();
+    auto subtrees = split_relay_destinations(dests.size(), request.relay_fanout());
+    auto relay = new ExchangeRelayClosure(cntl, done, subtrees.size() + 1);
+
+    PTransmitDataParams forward;
+    forward.set_node_id(request.node_id());
+    forward.set_sender_id(request.sender_id());
+    forward.set_be_number(request.be_number());
+    forward.set_eos(request.eos());
+    forward.set_packet_seq(request.packet_seq());
+    if (request.has_query_id()) {
+        *forward.mutable_query_id() = request.query_id();
+    }
+    forward.set_relay_fanout(request.relay_fanout());
+    forward.set_relay_timeout_ms(request.relay_timeout_ms());
+    // the block is serialized into the rpcs before they return, borrow it instead of copying
+    if (request.has_block()) {
+        forward.set_allocated_block(const_cast<PBlock*>(&request.block()));
+    }
+    for (auto [begin, end] : subtrees) {
+        const auto& root = dests[begin];
+        *forward.mutable_finst_id() = root.finst_id();
+        forward.clear_relay_destinations();
+        for (int i = begin + 1; i < end; ++i) {
+            *forward.add_relay_destinations() = dests[i];
+        }
+        std::string host = root.host() == BackendOptions::get_localhost() ? "127.0.0.1"
+                                                                            : root.host();
+        auto closure = new ForwardClosure(relay, fmt::format("{}:{}", root.host(), root.port()));
+        auto stub = exec_env->brpc_internal_client_cache()->get_client(host, root.port());
+        if (stub == nullptr) {
+            closure->cntl.SetFailed("failed to get brpc client");
+            closure->Run();
+            continue;
+        }
+        closure->cntl.set_timeout_ms(request.relay_timeout_ms());
+        stub->transmit_block(&closure->cntl, &forward, &closure->result, closure);
+    }
+    if (request.has_block()) {
+        forward.release_block();
+    }
+    return relay;
+}
+
+void ExchangeRelayClosure::Run() {
+    if (_pending.fetch_sub(1) != 1) {
+        return;
+    }
+    if (!_error.empty()) {
+        LOG(WARNING) << _error;
+        _cntl->SetFailed(brpc::EINTERNAL, "%s", _error.c_str());
+    }
+    _done->Run();
+    delete this;
+}
+
+void ExchangeRelayClosure::_set_error(const std::string& error) {
+    std::lock_guard l(_lock);
+    if (_error.empty()) {
+        _error = error;
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gen_cpp/internal_service.pb.h"
+#include "service/brpc.h"
+
+namespace doris {
+
+class ExecEnv;
+
+namespace vectorized {
+
+// A broadcast exchange to many receivers can be relayed through a tree of receivers to
+// save the bandwidth of the senders. A sender sends every packet to the roots of the tree
+// only, with the other receivers in the relay destinations of the packets. The receiver of
+// such a packet forwards it to the roots of the subtrees under it before passing it to its
+// own VDataStreamRecvr, so a serialized block is forwarded as it is, and all the packets of
+// a sender reach every receiver in order.
+
+// Splits `num_destinations` receivers into at most `fanout` subtrees of about the same
+// size, returns the [begin, end) of each. The first receiver of a subtree is its root, and
+// the others are relayed by the root.
+std::vector<std::pair<int, int>> split_relay_destinations(int num_destinations, int fanout);
+
+// The closure of a transmit_block rpc whose packet is relayed. It is run once by the local
+// receiver as the original closure, and runs the original closure when the forwarded rpcs
+// are answered too. The controller is set failed if any of them fails, which fails the
+// sender or the relay waiting for the answer.
+class ExchangeRelayClosure : public google::protobuf::Closure {
+public:
+    // Forwards `request` to the roots of the subtrees of its relay destinations, returns the
+    // closure to pass to the local receiver instead of `done`. `request` is not referred to
+    // after this returns.
+    static google::protobuf::Closure* relay(ExecEnv* exec_env, brpc::Controller* cntl,
+                                            const PTransmitDataParams& request,
+                                            google::protobuf::Closure* done);
+
+    void Run() override;
+
+private:
+    class ForwardClosure;
+
+    ExchangeRelayClosure(brpc::Controller* cntl, google::protobuf::Closure* done, int pending)
+            : _cntl(cntl), _done(done), _pending(pending) {}
+
+    void _set_error(const std::string& error);
+
+    brpc::Controller* _cntl;
+    google::protobuf::Closure* _done;
+    // the local receiver and the forwarded rpcs not finished
+    std::atomic<int> _pending;
+    std::mutex _lock;
+    std::string _error;
+};
+
+} // namespace vectorized
+} // namespace doris
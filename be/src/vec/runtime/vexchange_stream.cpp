@@ -0,0 +1,250 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vexchange_stream.h"
+
+#include <fmt/format.h>
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "service/backend_options.h"
+#include "util/uid_util.h"
+#include "vec/runtime/vdata_stream_mgr.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// Run by the receiver when it is able to take more blocks.
+class WaitClosure : public google::protobuf::Closure {
+public:
+    void Run() override { _event.signal(); }
+
+    void wait() { _event.wait(); }
+
+private:
+    bthread::CountdownEvent _event {1};
+};
+
+template <typename T>
+Status parse_message(const butil::IOBuf& message, T* pb) {
+    butil::IOBufAsZeroCopyInputStream input(message);
+    if (!pb->ParseFromZeroCopyStream(&input)) {
+        return Status::InternalError("failed to parse the message of exchange stream");
+    }
+    return Status::OK();
+}
+
+template <typename T>
+void serialize_message(const T& pb, butil::IOBuf* message) {
+    butil::IOBufAsZeroCopyOutputStream output(message);
+    pb.SerializeToZeroCopyStream(&output);
+}
+
+} // namespace
+
+int ExchangeStreamHandler::on_received_messages(brpc::StreamId id,
+                                                butil::IOBuf* const messages[], size_t size) {
+    for (size_t i = 0; i < size && !_responded; ++i) {
+        PTransmitDataParams request;
+        Status st = parse_message(*messages[i], &request);
+        if (st.ok()) {
+            st = _transmit_block(request);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to transmit block by exchange stream, fragment_instance_id="
+                         << print_id(request.finst_id()) << ", node=" << request.node_id()
+                         << ": " << st;
+            _respond(id, st);
+        } else if (request.eos()) {
+            _respond(id, st);
+        }
+    }
+    return 0;
+}
+
+void ExchangeStreamHandler::on_closed(brpc::StreamId id) {
+    delete this;
+}
+
+Status ExchangeStreamHandler::_transmit_block(const PTransmitDataParams& request) {
+    std::string query_id = print_id(request.query_id());
+    TUniqueId finst_id;
+    finst_id.__set_hi(request.finst_id().hi());
+    finst_id.__set_lo(request.finst_id().lo());
+    auto query_tracker =
+            _exec_env->task_pool_mem_tracker_registry()->get_task_mem_tracker(query_id);
+    if (!query_tracker) {
+        query_tracker = _exec_env->query_pool_mem_tracker();
+    }
+    SCOPED_ATTACH_TASK_THREAD(ThreadContext::TaskType::QUERY, query_id, finst_id, query_tracker);
+
+    WaitClosure closure;
+    google::protobuf::Closure* done = &closure;
+    Status st = _exec_env->vstream_mgr()->transmit_block(&request, &done);
+    // the receiver delays the closure while it is full, stop consuming the stream until
+    // then to hold back the writer
+    if (done == nullptr) {
+        closure.wait();
+    }
+    return st;
+}
+
+void ExchangeStreamHandler::_respond(brpc::StreamId id, const Status& status) {
+    PTransmitDataResult result;
+    status.to_protobuf(result.mutable_status());
+    butil::IOBuf message;
+    serialize_message(result, &message);
+    int ret = brpc::StreamWrite(id, message);
+    if (ret != 0) {
+        LOG(WARNING) << "failed to answer exchange stream: " << berror(ret);
+    }
+    _responded = true;
+}
+
+class ExchangeStreamWriter::ResponseHandler : public brpc::StreamInputHandler {
+public:
+    int on_received_messages(brpc::StreamId id, butil::IOBuf* const messages[],
+                             size_t size) override {
+        if (size > 0) {
+            PTransmitDataResult result;
+            Status st = parse_message(*messages[0], &result);
+            _set_status(st.ok() ? Status(result.status()) : st);
+        }
+        return 0;
+    }
+
+    void on_idle_timeout(brpc::StreamId id) override {}
+
+    void on_closed(brpc::StreamId id) override {
+        _set_status(Status::ThriftRpcError("exchange stream closed by the receiver"));
+        _closed_event.signal();
+    }
+
+    // Wait for the answer of the receiver.
+    Status wait_response(int64_t timeout_ms) {
+        timespec deadline = butil::milliseconds_from_now(timeout_ms);
+        if (_response_event.timed_wait(deadline) != 0) {
+            return Status::TimedOut("wait for the eos of exchange stream timed out");
+        }
+        std::lock_guard l(_lock);
+        return _status;
+    }
+
+    // Return the answer if it has arrived, the receiver only answers eos or a failure.
+    Status status() {
+        std::lock_guard l(_lock);
+        return _responded ? _status : Status::OK();
+    }
+
+    void wait_closed() { _closed_event.wait(); }
+
+private:
+    void _set_status(const Status& status) {
+        std::lock_guard l(_lock);
+        if (!_responded) {
+            _responded = true;
+            _status = status;
+            _response_event.signal();
+        }
+    }
+
+    std::mutex _lock;
+    bool _responded = false;
+    Status _status;
+    bthread::CountdownEvent _response_event {1};
+    bthread::CountdownEvent _closed_event {1};
+};
+
+ExchangeStreamWriter::~ExchangeStreamWriter() {
+    close();
+}
+
+Status ExchangeStreamWriter::open(PBackendService_Stub* stub, const PTransmitDataParams& request,
+                                  int64_t timeout_ms) {
+    _timeout_ms = timeout_ms;
+    _response_handler = std::make_unique<ResponseHandler>();
+
+    brpc::Controller cntl;
+    cntl.set_timeout_ms(timeout_ms);
+    brpc::StreamOptions options;
+    options.handler = _response_handler.get();
+    options.max_buf_size = config::exchange_stream_max_buf_bytes;
+    if (brpc::StreamCreate(&_stream_id, cntl, &options) != 0) {
+        _response_handler.reset();
+        return Status::InternalError("failed to create exchange stream");
+    }
+
+    POpenExchangeStreamRequest open_request;
+    *open_request.mutable_finst_id() = request.finst_id();
+    open_request.set_node_id(request.node_id());
+    open_request.set_sender_id(request.sender_id());
+    POpenExchangeStreamResult open_result;
+    stub->open_exchange_stream(&cntl, &open_request, &open_result, nullptr);
+    Status st;
+    if (cntl.Failed()) {
+        st = Status::ThriftRpcError(fmt::format(
+                "failed to open exchange stream, error={}, error_text={}, client: {}",
+                berror(cntl.ErrorCode()), cntl.ErrorText(), BackendOptions::get_localhost()));
+    } else {
+        st = Status(open_result.status());
+    }
+    if (!st.ok()) {
+        // the stream is closed by brpc if the rpc failed
+        close();
+    }
+    return st;
+}
+
+Status ExchangeStreamWriter::write(const PTransmitDataParams& request) {
+    // the receiver answers before eos only if it failed
+    RETURN_IF_ERROR(_response_handler->status());
+    butil::IOBuf message;
+    serialize_message(request, &message);
+    int ret = brpc::StreamWrite(_stream_id, message);
+    while (ret == EAGAIN) {
+        timespec deadline = butil::milliseconds_from_now(_timeout_ms);
+        ret = brpc::StreamWait(_stream_id, &deadline);
+        if (ret == 0) {
+            ret = brpc::StreamWrite(_stream_id, message);
+        }
+    }
+    if (ret != 0) {
+        RETURN_IF_ERROR(_response_handler->status());
+        return Status::ThriftRpcError(
+                fmt::format("failed to write exchange stream, error={}, client: {}",
+                            berror(ret), BackendOptions::get_localhost()));
+    }
+    return Status::OK();
+}
+
+Status ExchangeStreamWriter::wait_eos() {
+    return _response_handler->wait_response(_timeout_ms);
+}
+
+void ExchangeStreamWriter::close() {
+    if (_stream_id != brpc::INVALID_STREAM_ID) {
+        brpc::StreamClose(_stream_id);
+        _stream_id = brpc::INVALID_STREAM_ID;
+        // the handler is used by brpc until on_closed() returns
+        _response_handler->wait_closed();
+    }
+    _response_handler.reset();
+}
+
+} // namespace doris::vectorized
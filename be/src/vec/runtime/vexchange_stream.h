@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "service/brpc.h"
+
+namespace doris {
+
+class ExecEnv;
+
+namespace vectorized {
+
+// An exchange channel can send its blocks through a brpc stream instead of issuing a
+// transmit_block rpc per block and waiting for the last one. Every message of the stream
+// is a PTransmitDataParams carrying its block inline, and the receiving side answers the
+// eos message or the first failed one with a PTransmitDataResult.
+//
+// The receiving side handles the messages of a stream in order and does not return while
+// its VDataStreamRecvr is full, so the bytes not consumed by the receiver pile up to
+// max_buf_size of the stream and the writer waits. This window is the flow control of
+// the exchange, several blocks may be in flight as long as they fit in it.
+
+// The handler of the exchange streams accepted by open_exchange_stream, deletes itself
+// when the stream is closed.
+class ExchangeStreamHandler : public brpc::StreamInputHandler {
+public:
+    explicit ExchangeStreamHandler(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    int on_received_messages(brpc::StreamId id, butil::IOBuf* const messages[],
+                             size_t size) override;
+
+    void on_idle_timeout(brpc::StreamId id) override {}
+
+    void on_closed(brpc::StreamId id) override;
+
+private:
+    // Pass the request to the receiver, waits while the receiver is full.
+    Status _transmit_block(const PTransmitDataParams& request);
+
+    void _respond(brpc::StreamId id, const Status& status);
+
+    ExecEnv* _exec_env;
+    // the answer has been sent, the following messages are dropped
+    bool _responded = false;
+};
+
+// The writing side of an exchange stream, used by a VDataStreamSender::Channel.
+class ExchangeStreamWriter {
+public:
+    ExchangeStreamWriter() = default;
+    ~ExchangeStreamWriter();
+
+    // Open a stream to the receiver of request through stub.
+    Status open(PBackendService_Stub* stub, const PTransmitDataParams& request,
+                int64_t timeout_ms);
+
+    // Write request to the stream, waits while the window of the stream is full.
+    Status write(const PTransmitDataParams& request);
+
+    // Wait for the answer to the eos request written.
+    Status wait_eos();
+
+    void close();
+
+private:
+    class ResponseHandler;
+
+    brpc::StreamId _stream_id = brpc::INVALID_STREAM_ID;
+    std::unique_ptr<ResponseHandler> _response_handler;
+    int64_t _timeout_ms = 0;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -17,6 +17,7 @@
 
 #include "vec/runtime/vfile_result_writer.h"
 
+#include "common/config.h"
 #include "common/consts.h"
 #include "exprs/expr_context.h"
 #include "gutil/strings/numbers.h"
@@ -28,6 +29,7 @@
 #include "runtime/large_int_value.h"
 #include "runtime/runtime_state.h"
 #include "runtime/string_value.h"
+#include "runtime/thread_context.h"
 #include "service/backend_options.h"
 #include "util/file_utils.h"
 #include "util/mysql_global.h"
@@ -56,9 +58,21 @@ VFileResultWriter::VFileResultWriter(const ResultFileOptions* file_opts,
     _output_object_data = output_object_data;
 }
 
+VFileResultWriter::~VFileResultWriter() {
+    // the file writers queued in the token are closed by their destructors
+    if (_upload_token != nullptr) {
+        _upload_token->shutdown();
+    }
+}
+
 Status VFileResultWriter::init(RuntimeState* state) {
     _state = state;
     _init_profile();
+    if (config::outfile_max_concurrent_uploads > 0 && _state->exec_env() != nullptr &&
+        _state->exec_env()->file_upload_thread_pool() != nullptr) {
+        _upload_token = _state->exec_env()->file_upload_thread_pool()->new_token(
+                ThreadPool::ExecutionMode::CONCURRENT, config::outfile_max_concurrent_uploads);
+    }
     return _create_next_file_writer();
 }
 
@@ -76,7 +90,10 @@ Status VFileResultWriter::_create_success_file() {
     std::string file_name;
     RETURN_IF_ERROR(_get_success_file_name(&file_name));
     RETURN_IF_ERROR(_create_file_writer(file_name));
-    return _close_file_writer(true);
+    // the success file is empty, close it in place
+    RETURN_IF_ERROR(_file_writer_impl->close());
+    _file_writer_impl.reset();
+    return Status::OK();
 }
 
 Status VFileResultWriter::_get_success_file_name(std::string* file_name) {
@@ -101,22 +118,19 @@ Status VFileResultWriter::_get_success_file_name(std::string* file_name) {
 Status VFileResultWriter::_create_next_file_writer() {
     std::string file_name;
     RETURN_IF_ERROR(_get_next_file_name(&file_name));
-    return _create_file_writer(file_name);
-}
-
-Status VFileResultWriter::_create_file_writer(const std::string& file_name) {
-    RETURN_IF_ERROR(FileFactory::create_file_writer(
-            FileFactory::convert_storage_type(_storage_type), _state->exec_env(),
-            _file_opts->broker_addresses, _file_opts->broker_properties, file_name, 0,
-            _file_writer_impl));
-    RETURN_IF_ERROR(_file_writer_impl->open());
+    RETURN_IF_ERROR(_create_file_writer(file_name));
     switch (_file_opts->file_format) {
     case TFileFormatType::FORMAT_CSV_PLAIN:
         // just use file writer is enough
         break;
-    case TFileFormatType::FORMAT_PARQUET:
-        return Status::NotSupported("Parquet Writer is not supported yet!");
+    case TFileFormatType::FORMAT_PARQUET: {
+        auto parquet_writer = std::make_unique<VParquetWriterWrapper>(
+                _file_writer_impl.get(), _output_expr_ctxs, _file_opts->file_properties,
+                _file_opts->schema, _output_object_data);
+        RETURN_IF_ERROR(parquet_writer->init());
+        _parquet_writer = std::move(parquet_writer);
         break;
+    }
     default:
         return Status::InternalError(
                 strings::Substitute("unsupported file format: $0", _file_opts->file_format));
@@ -127,6 +141,14 @@ Status VFileResultWriter::_create_file_writer(const std::string& file_name) {
     return Status::OK();
 }
 
+Status VFileResultWriter::_create_file_writer(const std::string& file_name) {
+    RETURN_IF_ERROR(FileFactory::create_file_writer(
+            FileFactory::convert_storage_type(_storage_type), _state->exec_env(),
+            _file_opts->broker_addresses, _file_opts->broker_properties, file_name, 0,
+            _file_writer_impl));
+    return _file_writer_impl->open();
+}
+
 // file name format as: my_prefix_{fragment_instance_id}_0.csv
 Status VFileResultWriter::_get_next_file_name(std::string* file_name) {
     std::stringstream ss;
@@ -183,7 +205,7 @@ Status VFileResultWriter::append_block(Block& block) {
     RETURN_IF_ERROR(write_csv_header());
     SCOPED_TIMER(_append_row_batch_timer);
     if (_parquet_writer != nullptr) {
-        return Status::NotSupported("Parquet Writer is not supported yet!");
+        RETURN_IF_ERROR(_write_parquet_file(block));
     } else {
         RETURN_IF_ERROR(_write_csv_file(block));
     }
@@ -192,6 +214,16 @@ Status VFileResultWriter::append_block(Block& block) {
     return Status::OK();
 }
 
+Status VFileResultWriter::_write_parquet_file(const Block& block) {
+    {
+        SCOPED_TIMER(_file_write_timer);
+        RETURN_IF_ERROR(_parquet_writer->write(block));
+    }
+    _current_written_bytes = _parquet_writer->written_len();
+    // split file if exceed limit
+    return _create_new_file_if_exceed_size();
+}
+
 Status VFileResultWriter::_write_csv_file(const Block& block) {
     for (size_t i = 0; i < block.rows(); i++) {
         for (size_t col_id = 0; col_id < block.columns(); col_id++) {
@@ -354,18 +386,55 @@ Status VFileResultWriter::_create_new_file_if_exceed_size() {
     return Status::OK();
 }
 
+Status VFileResultWriter::_finish_file_writer() {
+    if (_file_writer_impl == nullptr) {
+        return Status::OK();
+    }
+    std::shared_ptr<FileWriter> file_writer = std::move(_file_writer_impl);
+    if (_upload_token != nullptr) {
+        Status st = _upload_token->submit_func([this, file_writer]() {
+            SCOPED_ATTACH_TASK_THREAD(_state, _state->instance_mem_tracker());
+            Status close_st = file_writer->close();
+            if (!close_st.ok()) {
+                LOG(WARNING) << "failed to close result file: " << close_st
+                             << ", query id: " << print_id(_state->query_id());
+                std::lock_guard l(_upload_lock);
+                if (_upload_status.ok()) {
+                    _upload_status = close_st;
+                }
+            }
+        });
+        // close the file in place if the pool is full
+        if (st.ok()) {
+            return Status::OK();
+        }
+    }
+    return file_writer->close();
+}
+
+Status VFileResultWriter::_wait_uploads() {
+    if (_upload_token != nullptr) {
+        _upload_token->wait();
+    }
+    std::lock_guard l(_upload_lock);
+    return _upload_status;
+}
+
 Status VFileResultWriter::_close_file_writer(bool done) {
     if (_parquet_writer != nullptr) {
-        return Status::NotSupported("Parquet Writer is not supported yet!");
-    } else if (_file_writer_impl) {
-        _file_writer_impl->close();
+        RETURN_IF_ERROR(_parquet_writer->close());
+        _current_written_bytes = _parquet_writer->written_len();
+        COUNTER_UPDATE(_written_data_bytes, _current_written_bytes);
+        _parquet_writer.reset();
     }
+    RETURN_IF_ERROR(_finish_file_writer());
 
     if (!done) {
         // not finished, create new file writer for next file
         RETURN_IF_ERROR(_create_next_file_writer());
     } else {
         // All data is written to file, send statistic result
+        RETURN_IF_ERROR(_wait_uploads());
         if (_file_opts->success_file_name != "") {
             // write success file, just need to touch an empty file
             RETURN_IF_ERROR(_create_success_file());
@@ -17,8 +17,12 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "io/file_writer.h"
 #include "runtime/file_result_writer.h"
+#include "util/threadpool.h"
+#include "vec/runtime/vparquet_writer.h"
 #include "vec/sink/result_sink.h"
 
 namespace doris {
@@ -34,7 +38,7 @@ public:
                       RuntimeProfile* parent_profile, BufferControlBlock* sinker,
                       Block* output_block, bool output_object_data,
                       const RowDescriptor& output_row_descriptor);
-    virtual ~VFileResultWriter() = default;
+    virtual ~VFileResultWriter();
 
     virtual Status append_block(Block& block) override;
     virtual Status append_row_batch(const RowBatch* batch) override {
@@ -52,6 +56,7 @@ public:
 
 private:
     Status _write_csv_file(const Block& block);
+    Status _write_parquet_file(const Block& block);
 
     // if buffer exceed the limit, write the data buffered in _plain_text_outstream via file_writer
     // if eos, write the data even if buffer is not full.
@@ -59,6 +64,7 @@ private:
     void _init_profile();
 
     Status _create_file_writer(const std::string& file_name);
+    // create the file writer of the next export file, and the format writer on it
     Status _create_next_file_writer();
     Status _create_success_file();
     // get next export file name
@@ -67,8 +73,13 @@ private:
     Status _get_file_url(std::string* file_url);
     std::string _file_format_to_name();
     // close file writer, and if !done, it will create new writer for next file.
-    // if only_close is true, this method will just close the file writer and return.
     Status _close_file_writer(bool done);
+    // Close the file writer, in background if there is an upload token. Closing the file
+    // writer uploads the file for S3, so the uploads of the finished files overlap with
+    // writing the next file.
+    Status _finish_file_writer();
+    // wait for the files closed in background, return the first error of them
+    Status _wait_uploads();
     // create a new file if current file size exceed limit
     Status _create_new_file_if_exceed_size();
     // send the final statistic result
@@ -82,11 +93,16 @@ private:
     TUniqueId _fragment_instance_id;
     const std::vector<ExprContext*>& _output_expr_ctxs;
 
-    // If the result file format is plain text, like CSV, this _file_writer is owned by this FileResultWriter.
-    // If the result file format is Parquet, this _file_writer is owned by _parquet_writer.
+    // The parquet writer writes to _file_writer_impl, it is declared after the file writer
+    // to be destroyed before it.
     std::unique_ptr<FileWriter> _file_writer_impl;
     // parquet file writer
-    ParquetWriterWrapper* _parquet_writer = nullptr;
+    std::unique_ptr<VParquetWriterWrapper> _parquet_writer;
+    // closes the finished file writers on the file upload thread pool
+    std::unique_ptr<ThreadPoolToken> _upload_token;
+    std::mutex _upload_lock;
+    // the first error of the file writers closed in background
+    Status _upload_status;
     // Used to buffer the export data of plain text
     // TODO(cmy): I simply use a stringstrteam to buffer the data, to avoid calling
     // file writer's write() for every single row.
@@ -0,0 +1,342 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vparquet_writer.h"
+
+#include "exprs/expr_context.h"
+#include "olap/hll.h"
+#include "runtime/primitive_type.h"
+#include "util/binary_cast.hpp"
+#include "util/bitmap_value.h"
+#include "util/mysql_global.h"
+#include "vec/columns/column_complex.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+VParquetWriterWrapper::VParquetWriterWrapper(
+        FileWriter* file_writer, const std::vector<ExprContext*>& output_expr_ctxs,
+        const std::map<std::string, std::string>& properties,
+        const std::vector<std::vector<std::string>>& schema, bool output_object_data)
+        : _outstream(std::make_shared<ParquetOutputStream>(file_writer)),
+          _properties(ParquetWriterWrapper::build_properties(properties)),
+          _schema(ParquetWriterWrapper::build_schema(schema)),
+          _output_expr_ctxs(output_expr_ctxs),
+          _str_schema(schema),
+          _output_object_data(output_object_data) {}
+
+Status VParquetWriterWrapper::_check_schema_type(size_t index, const std::string& parquet_type,
+                                                 const std::string& field_desc) {
+    if (_str_schema[index][1] != parquet_type) {
+        std::stringstream ss;
+        ss << "project field type is " << field_desc << ", but the definition type of column "
+           << _str_schema[index][2] << " is " << _str_schema[index][1];
+        return Status::InvalidArgument(ss.str());
+    }
+    return Status::OK();
+}
+
+// The types are checked before writing any data, so that a failed block does not leave
+// the columns of the buffered row group with different numbers of values.
+Status VParquetWriterWrapper::init() {
+    if (_output_expr_ctxs.size() != _str_schema.size()) {
+        return Status::InternalError("project field size is not equal to schema column size");
+    }
+    for (size_t index = 0; index < _output_expr_ctxs.size(); ++index) {
+        switch (_output_expr_ctxs[index]->root()->type().type) {
+        case TYPE_BOOLEAN:
+            RETURN_IF_ERROR(_check_schema_type(index, "boolean", "boolean"));
+            break;
+        case TYPE_TINYINT:
+        case TYPE_SMALLINT:
+        case TYPE_INT:
+            RETURN_IF_ERROR(_check_schema_type(index, "int32",
+                                               "tiny int/small int/int, should use int32"));
+            break;
+        case TYPE_BIGINT:
+            RETURN_IF_ERROR(_check_schema_type(index, "int64", "big int, should use int64"));
+            break;
+        case TYPE_LARGEINT:
+            return Status::InvalidArgument("do not support large int type.");
+        case TYPE_FLOAT:
+            RETURN_IF_ERROR(_check_schema_type(index, "float", "float"));
+            break;
+        case TYPE_DOUBLE:
+            RETURN_IF_ERROR(_check_schema_type(index, "double", "double"));
+            break;
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+            RETURN_IF_ERROR(
+                    _check_schema_type(index, "int64", "date/datetime, should use int64"));
+            break;
+        case TYPE_HLL:
+        case TYPE_OBJECT:
+            if (!_output_object_data) {
+                std::stringstream ss;
+                ss << "unsupported file format: " << _output_expr_ctxs[index]->root()->type().type;
+                return Status::InvalidArgument(ss.str());
+            }
+            RETURN_IF_ERROR(_check_schema_type(index, "byte_array",
+                                               "hll/bitmap, should use byte_array"));
+            break;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING:
+            RETURN_IF_ERROR(_check_schema_type(index, "byte_array",
+                                               "char/varchar, should use byte_array"));
+            break;
+        case TYPE_DECIMALV2:
+            RETURN_IF_ERROR(_check_schema_type(index, "byte_array",
+                                               "decimal v2, should use byte_array"));
+            break;
+        default: {
+            std::stringstream ss;
+            ss << "unsupported file format: " << _output_expr_ctxs[index]->root()->type().type;
+            return Status::InvalidArgument(ss.str());
+        }
+        }
+    }
+    try {
+        _writer = parquet::ParquetFileWriter::Open(_outstream, _schema, _properties);
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "Parquet writer open error: " << e.what();
+        return Status::InternalError(e.what());
+    }
+    if (_writer == nullptr) {
+        return Status::InternalError("Failed to create file writer");
+    }
+    return Status::OK();
+}
+
+parquet::RowGroupWriter* VParquetWriterWrapper::_get_rg_writer() {
+    if (_rg_writer == nullptr) {
+        _rg_writer = _writer->AppendBufferedRowGroup();
+    }
+    return _rg_writer;
+}
+
+int64_t VParquetWriterWrapper::_buffered_row_group_bytes() {
+    if (_rg_writer == nullptr) {
+        return 0;
+    }
+    return _rg_writer->total_bytes_written() + _rg_writer->total_compressed_bytes();
+}
+
+int64_t VParquetWriterWrapper::written_len() {
+    return _outstream->get_written_len() + _buffered_row_group_bytes();
+}
+
+// The values of the null rows are written as the defaults at REQUIRED columns, and are
+// skipped by the valid bits at OPTIONAL ones.
+template <typename ParquetWriter, typename T>
+void VParquetWriterWrapper::_write_batch(parquet::ColumnWriter* writer, const T* values,
+                                         size_t num_rows, const NullMap* null_map) {
+    auto* col_writer = static_cast<ParquetWriter*>(writer);
+    if (col_writer->descr()->max_definition_level() == 0) {
+        col_writer->WriteBatch(num_rows, nullptr, nullptr, values);
+        return;
+    }
+    _def_levels.resize(num_rows);
+    if (null_map == nullptr) {
+        std::fill(_def_levels.begin(), _def_levels.end(), 1);
+        col_writer->WriteBatch(num_rows, _def_levels.data(), nullptr, values);
+        return;
+    }
+    _valid_bits.assign((num_rows + 7) / 8, 0);
+    const auto* nulls = null_map->data();
+    for (size_t i = 0; i < num_rows; ++i) {
+        _def_levels[i] = !nulls[i];
+        _valid_bits[i / 8] |= (uint8_t)(!nulls[i]) << (i % 8);
+    }
+    col_writer->WriteBatchSpaced(num_rows, _def_levels.data(), nullptr, _valid_bits.data(), 0,
+                                 values);
+}
+
+void VParquetWriterWrapper::_write_column(size_t index, const ColumnPtr& column_ptr) {
+    const NullMap* null_map = nullptr;
+    ColumnPtr column = column_ptr;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+        null_map = &nullable->get_null_map_data();
+        column = nullable->get_nested_column_ptr();
+    }
+    const size_t num_rows = column->size();
+    parquet::ColumnWriter* writer = _get_rg_writer()->column(index);
+
+    switch (_output_expr_ctxs[index]->root()->type().type) {
+    case TYPE_BOOLEAN: {
+        // UInt8 of 0/1 has the same representation as bool
+        const auto& data = assert_cast<const ColumnUInt8&>(*column).get_data();
+        _write_batch<parquet::BoolWriter>(writer, reinterpret_cast<const bool*>(data.data()),
+                                          num_rows, null_map);
+        break;
+    }
+    case TYPE_TINYINT: {
+        const auto& data = assert_cast<const ColumnInt8&>(*column).get_data();
+        _int32_values.assign(data.begin(), data.end());
+        _write_batch<parquet::Int32Writer>(writer, _int32_values.data(), num_rows, null_map);
+        break;
+    }
+    case TYPE_SMALLINT: {
+        const auto& data = assert_cast<const ColumnInt16&>(*column).get_data();
+        _int32_values.assign(data.begin(), data.end());
+        _write_batch<parquet::Int32Writer>(writer, _int32_values.data(), num_rows, null_map);
+        break;
+    }
+    case TYPE_INT: {
+        const auto& data = assert_cast<const ColumnInt32&>(*column).get_data();
+        _write_batch<parquet::Int32Writer>(writer, data.data(), num_rows, null_map);
+        break;
+    }
+    case TYPE_BIGINT: {
+        const auto& data = assert_cast<const ColumnInt64&>(*column).get_data();
+        _write_batch<parquet::Int64Writer>(writer, reinterpret_cast<const int64_t*>(data.data()),
+                                           num_rows, null_map);
+        break;
+    }
+    case TYPE_FLOAT: {
+        const auto& data = assert_cast<const ColumnFloat32&>(*column).get_data();
+        _write_batch<parquet::FloatWriter>(writer, data.data(), num_rows, null_map);
+        break;
+    }
+    case TYPE_DOUBLE: {
+        const auto& data = assert_cast<const ColumnFloat64&>(*column).get_data();
+        _write_batch<parquet::DoubleWriter>(writer, data.data(), num_rows, null_map);
+        break;
+    }
+    case TYPE_DATE:
+    case TYPE_DATETIME: {
+        const auto& data = assert_cast<const ColumnInt64&>(*column).get_data();
+        _int64_values.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            _int64_values[i] = binary_cast<Int64, VecDateTimeValue>(data[i]).to_olap_datetime();
+        }
+        _write_batch<parquet::Int64Writer>(writer, _int64_values.data(), num_rows, null_map);
+        break;
+    }
+    case TYPE_HLL:
+    case TYPE_OBJECT:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_STRING: {
+        _byte_array_values.resize(num_rows);
+        if (const auto* bitmaps = check_and_get_column<ColumnBitmap>(*column)) {
+            size_t total_size = 0;
+            for (size_t i = 0; i < num_rows; ++i) {
+                total_size += const_cast<BitmapValue&>(bitmaps->get_element(i)).getSizeInBytes();
+            }
+            _text_buffer.resize(total_size);
+            char* pos = _text_buffer.data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                auto& bitmap = const_cast<BitmapValue&>(bitmaps->get_element(i));
+                size_t size = bitmap.getSizeInBytes();
+                bitmap.write(pos);
+                _byte_array_values[i] = parquet::ByteArray(size, (const uint8_t*)pos);
+                pos += size;
+            }
+        } else if (const auto* hlls = check_and_get_column<ColumnHLL>(*column)) {
+            size_t total_size = 0;
+            for (size_t i = 0; i < num_rows; ++i) {
+                total_size += hlls->get_element(i).max_serialized_size();
+            }
+            _text_buffer.resize(total_size);
+            char* pos = _text_buffer.data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                size_t size = hlls->get_element(i).serialize((uint8_t*)pos);
+                _byte_array_values[i] = parquet::ByteArray(size, (const uint8_t*)pos);
+                pos += size;
+            }
+        } else {
+            for (size_t i = 0; i < num_rows; ++i) {
+                StringRef value = column->get_data_at(i);
+                _byte_array_values[i] = parquet::ByteArray(value.size, (const uint8_t*)value.data);
+            }
+        }
+        _write_batch<parquet::ByteArrayWriter>(writer, _byte_array_values.data(), num_rows,
+                                               null_map);
+        break;
+    }
+    case TYPE_DECIMALV2: {
+        const auto& data = assert_cast<const ColumnDecimal<Decimal128>&>(*column).get_data();
+        int output_scale = _output_expr_ctxs[index]->root()->output_scale();
+        _byte_array_values.resize(num_rows);
+        // reserved up front, the byte arrays point into the buffer
+        _text_buffer.resize(num_rows * MAX_DECIMAL_WIDTH);
+        char* pos = _text_buffer.data();
+        for (size_t i = 0; i < num_rows; ++i) {
+            int len = DecimalV2Value(data[i]).to_buffer(pos, output_scale);
+            _byte_array_values[i] = parquet::ByteArray(len, (const uint8_t*)pos);
+            pos += len;
+        }
+        _write_batch<parquet::ByteArrayWriter>(writer, _byte_array_values.data(), num_rows,
+                                               null_map);
+        break;
+    }
+    default:
+        // rejected by init()
+        DCHECK(false) << "unsupported type " << _output_expr_ctxs[index]->root()->type().type;
+    }
+}
+
+Status VParquetWriterWrapper::write(const Block& block) {
+    if (block.rows() == 0) {
+        return Status::OK();
+    }
+    if (block.columns() != _str_schema.size()) {
+        return Status::InternalError("project field size is not equal to schema column size");
+    }
+    try {
+        for (size_t index = 0; index < block.columns(); ++index) {
+            _write_column(index,
+                          block.get_by_position(index).column->convert_to_full_column_if_const());
+        }
+        if (_buffered_row_group_bytes() >= MAX_ROW_GROUP_BYTES) {
+            _rg_writer->Close();
+            _rg_writer = nullptr;
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "Parquet write error: " << e.what();
+        return Status::InternalError(e.what());
+    }
+    return Status::OK();
+}
+
+Status VParquetWriterWrapper::close() {
+    try {
+        if (_rg_writer != nullptr) {
+            _rg_writer->Close();
+            _rg_writer = nullptr;
+        }
+        _writer->Close();
+    } catch (const std::exception& e) {
+        _rg_writer = nullptr;
+        LOG(WARNING) << "Parquet writer close error: " << e.what();
+        return Status::InternalError(e.what());
+    }
+    _outstream->release_file_writer();
+    arrow::Status st = _outstream->Close();
+    if (!st.ok()) {
+        return Status::InternalError(st.ToString());
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parquet/api/writer.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/parquet_writer.h"
+#include "vec/columns/column_nullable.h"
+
+namespace doris {
+class ExprContext;
+class FileWriter;
+
+namespace vectorized {
+class Block;
+
+// Writes blocks to a parquet file column by column, each column of a block is written
+// to its column writer in one batch.
+class VParquetWriterWrapper {
+public:
+    VParquetWriterWrapper(FileWriter* file_writer,
+                          const std::vector<ExprContext*>& output_expr_ctxs,
+                          const std::map<std::string, std::string>& properties,
+                          const std::vector<std::vector<std::string>>& schema,
+                          bool output_object_data);
+    ~VParquetWriterWrapper() = default;
+
+    // check the output types against the schema and open the parquet file writer
+    Status init();
+
+    Status write(const Block& block);
+
+    // Write the footer of the parquet file. The file writer is left open, the caller
+    // closes it.
+    Status close();
+
+    // including the estimated size of the buffered row group
+    int64_t written_len();
+
+private:
+    Status _check_schema_type(size_t index, const std::string& parquet_type,
+                              const std::string& field_desc);
+
+    parquet::RowGroupWriter* _get_rg_writer();
+
+    template <typename ParquetWriter, typename T>
+    void _write_batch(parquet::ColumnWriter* writer, const T* values, size_t num_rows,
+                      const NullMap* null_map);
+
+    void _write_column(size_t index, const ColumnPtr& column);
+
+    int64_t _buffered_row_group_bytes();
+
+    // the buffered row group is flushed to the file once it is estimated to be so large
+    static constexpr int64_t MAX_ROW_GROUP_BYTES = 128 * 1024 * 1024;
+
+    std::shared_ptr<ParquetOutputStream> _outstream;
+    std::shared_ptr<parquet::WriterProperties> _properties;
+    std::shared_ptr<parquet::schema::GroupNode> _schema;
+    std::unique_ptr<parquet::ParquetFileWriter> _writer;
+    parquet::RowGroupWriter* _rg_writer = nullptr;
+    const std::vector<ExprContext*>& _output_expr_ctxs;
+    std::vector<std::vector<std::string>> _str_schema;
+    bool _output_object_data;
+
+    // reused between the columns
+    std::vector<int16_t> _def_levels;
+    std::vector<uint8_t> _valid_bits;
+    std::vector<int32_t> _int32_values;
+    std::vector<int64_t> _int64_values;
+    std::vector<parquet::ByteArray> _byte_array_values;
+    std::vector<char> _text_buffer;
+};
+
+} // namespace vectorized
+} // namespace doris
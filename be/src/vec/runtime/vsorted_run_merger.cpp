@@ -17,6 +17,7 @@
 
 #include "vec/runtime/vsorted_run_merger.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "runtime/descriptors.h"
@@ -49,9 +50,11 @@ Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs, bool p
         _cursors.emplace_back(supplier, _ordering_expr, _is_asc_order, _nulls_first);
     }
 
+    std::vector<SortCursor> cursors;
     for (auto& _cursor : _cursors) {
-        if (!_cursor._is_eof) _priority_queue.push(SortCursor(&_cursor));
+        if (!_cursor._is_eof) cursors.emplace_back(&_cursor);
     }
+    _loser_tree.init(std::move(cursors));
 
     for (const auto& cursor : _cursors) {
         if (!cursor._is_eof) {
@@ -68,8 +71,8 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     // Only have one receive data queue of data, no need to do merge and
     // copy the data of block.
     // return the data in receive data directly
-    if (_priority_queue.size() == 1) {
-        auto current = _priority_queue.top();
+    if (_loser_tree.size() == 1) {
+        auto current = _loser_tree.top();
         while (_offset != 0 && current->block_ptr() != nullptr) {
             if (_offset >= current->rows - current->pos) {
                 _offset -= (current->rows - current->pos);
@@ -108,9 +111,27 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
 
         /// Take rows from queue in right order and push to 'merged'.
         size_t merged_rows = 0;
-        while (!_priority_queue.empty()) {
-            auto current = _priority_queue.top();
-            _priority_queue.pop();
+        size_t last_top_index = -1;
+        while (!_loser_tree.empty()) {
+            auto current = _loser_tree.top();
+            // only check the run once the top changes, so a top winning row by row
+            // does not pay for it each row
+            if (_offset == 0 && _loser_tree.top_index() != last_top_index) {
+                last_top_index = _loser_tree.top_index();
+                if (top_is_whole_run(current)) {
+                    size_t length =
+                            std::min(current->rows - current->pos, _batch_size - merged_rows);
+                    for (size_t i = 0; i < num_columns; ++i)
+                        merged_columns[i]->insert_range_from(*current->all_columns[i],
+                                                             current->pos, length);
+                    merged_rows += length;
+                    current->pos += length - 1;
+                    next_heap(current);
+                    last_top_index = -1;
+                    if (merged_rows == _batch_size) break;
+                    continue;
+                }
+            }
 
             if (_offset > 0) {
                 _offset--;
@@ -145,10 +166,20 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
 void VSortedRunMerger::next_heap(SortCursor& current) {
     if (!current->isLast()) {
         current->next();
-        _priority_queue.push(current);
+        _loser_tree.update_top();
     } else if (has_next_block(current)) {
-        _priority_queue.push(current);
+        _loser_tree.update_top();
+    } else {
+        _loser_tree.pop_top();
+    }
+}
+
+bool VSortedRunMerger::top_is_whole_run(SortCursor& current) {
+    if (current->isLast()) {
+        return false;
     }
+    auto* second = _loser_tree.second();
+    return second == nullptr || current.greater_at(*second, current->rows - 1, (*second)->pos) <= 0;
 }
 
 inline bool VSortedRunMerger::has_next_block(doris::vectorized::SortCursor& current) {
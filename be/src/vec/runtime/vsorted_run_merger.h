@@ -21,6 +21,7 @@
 
 #include "common/object_pool.h"
 #include "util/tuple_row_compare.h"
+#include "vec/common/loser_tree.h"
 #include "vec/core/sort_cursor.h"
 
 namespace doris {
@@ -32,8 +33,9 @@ namespace vectorized {
 class Block;
 // VSortedRunMerger is used to merge multiple sorted runs of blocks. A run is a sorted
 // sequence of blocks, which are fetched from a BlockSupplier function object.
-// Merging is implemented using a binary min-heap that maintains the run with the next
-// rows in sorted order at the top of the heap.
+// Merging is implemented using a loser tree that maintains the run with the next
+// rows in sorted order at the top of the tree. If the rest rows of the top block are
+// no larger than the next row of all the other runs, they are copied as a whole.
 //
 // Merged block of rows are retrieved from VSortedRunMerger via calls to get_next().
 class VSortedRunMerger {
@@ -72,7 +74,8 @@ protected:
     size_t _offset = 0;
 
     std::vector<ReceiveQueueSortCursorImpl> _cursors;
-    std::priority_queue<SortCursor> _priority_queue;
+    // SortCursor::operator< means the cursor should be output after the other one
+    LoserTree<SortCursor, std::less<SortCursor>> _loser_tree;
 
     Block _empty_block;
 
@@ -84,6 +87,8 @@ protected:
 
 private:
     void next_heap(SortCursor& current);
+    // Whether the rest rows of the current block of the top cursor could be output as a whole.
+    bool top_is_whole_run(SortCursor& current);
     bool has_next_block(SortCursor& current);
 };
 
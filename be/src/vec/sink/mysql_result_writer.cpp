@@ -18,7 +18,6 @@
 #include "vec/sink/mysql_result_writer.h"
 
 #include "runtime/buffer_control_block.h"
-#include "runtime/large_int_value.h"
 #include "runtime/runtime_state.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_vector.h"
@@ -26,6 +25,7 @@
 #include "vec/data_types/data_type_array.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
+#include "util/mysql_global.h"
 #include "vec/runtime/vdatetime_value.h"
 
 namespace doris {
@@ -54,9 +54,39 @@ void VMysqlResultWriter::_init_profile() {
     _sent_rows_counter = ADD_COUNTER(_parent_profile, "NumSentRows", TUnit::UNIT);
 }
 
+// The upper bound of the serialized size of a column, the length flag of a cell takes
+// at most 9 bytes. The nested types are pushed in dynamic mode and grow the buffer on demand.
+template <PrimitiveType type>
+static int64_t _reserved_column_size(const IColumn& column, size_t row_size) {
+    if constexpr (type == TYPE_VARCHAR) {
+        return column.byte_size() + 9 * row_size;
+    } else if constexpr (type == TYPE_BOOLEAN || type == TYPE_TINYINT) {
+        return (3 + MAX_TINYINT_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_SMALLINT) {
+        return (3 + MAX_SMALLINT_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_INT) {
+        return (3 + MAX_INT_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_BIGINT) {
+        return (3 + MAX_BIGINT_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_LARGEINT) {
+        return (3 + MAX_LARGEINT_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_FLOAT) {
+        return (3 + MAX_FLOAT_STR_LENGTH) * row_size;
+    } else if constexpr (type == TYPE_DOUBLE) {
+        return (3 + MAX_DOUBLE_STR_LENGTH) * row_size;
+    } else if constexpr (type == TYPE_TIME) {
+        return (2 + MAX_TIME_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_DATETIME) {
+        return (9 + MAX_DATETIME_WIDTH) * row_size;
+    } else if constexpr (type == TYPE_DECIMALV2) {
+        return (2 + MAX_DECIMAL_WIDTH) * row_size;
+    } else {
+        return row_size;
+    }
+}
+
 template <PrimitiveType type, bool is_nullable>
-Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
-                                           std::unique_ptr<TFetchDataResult>& result,
+Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr, ColumnBuffer& column_buffer,
                                            const DataTypePtr& nested_type_ptr) {
     SCOPED_TIMER(_convert_tuple_timer);
 
@@ -69,7 +99,13 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
         column = column_ptr;
     }
 
-    MysqlRowBuffer _buffer;
+    MysqlRowBuffer& buffer = column_buffer.buffer;
+    auto& offsets = column_buffer.offsets;
+    buffer.reset();
+    offsets.resize(row_size);
+    if (0 != buffer.reserve(_reserved_column_size<type>(*column, row_size))) {
+        return Status::InternalError("pack mysql buffer failed.");
+    }
     int buf_ret = 0;
 
     if constexpr (type == TYPE_OBJECT || type == TYPE_VARCHAR) {
@@ -77,18 +113,17 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             if (0 != buf_ret) {
                 return Status::InternalError("pack mysql buffer failed.");
             }
-            _buffer.reset();
 
             if constexpr (is_nullable) {
                 if (column_ptr->is_null_at(i)) {
-                    buf_ret = _buffer.push_null();
-                    result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
+                    buf_ret = buffer.push_null();
+                    offsets[i] = buffer.length();
                     continue;
                 }
             }
 
             if constexpr (type == TYPE_OBJECT) {
-                buf_ret = _buffer.push_null();
+                buf_ret = buffer.push_null();
             }
             if constexpr (type == TYPE_VARCHAR) {
                 const auto string_val = column->get_data_at(i);
@@ -97,16 +132,16 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
                     if (string_val.size == 0) {
                         // 0x01 is a magic num, not useful actually, just for present ""
                         char* tmp_val = reinterpret_cast<char*>(0x01);
-                        buf_ret = _buffer.push_string(tmp_val, string_val.size);
+                        buf_ret = buffer.push_string(tmp_val, string_val.size);
                     } else {
-                        buf_ret = _buffer.push_null();
+                        buf_ret = buffer.push_null();
                     }
                 } else {
-                    buf_ret = _buffer.push_string(string_val.data, string_val.size);
+                    buf_ret = buffer.push_string(string_val.data, string_val.size);
                 }
             }
 
-            result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
+            offsets[i] = buffer.length();
         }
     } else if constexpr (type == TYPE_ARRAY) {
         auto& column_array = assert_cast<const ColumnArray&>(*column);
@@ -115,34 +150,33 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             if (0 != buf_ret) {
                 return Status::InternalError("pack mysql buffer failed.");
             }
-            _buffer.reset();
 
             if constexpr (is_nullable) {
                 if (column_ptr->is_null_at(i)) {
-                    buf_ret = _buffer.push_null();
-                    result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
+                    buf_ret = buffer.push_null();
+                    offsets[i] = buffer.length();
                     continue;
                 }
             }
 
-            _buffer.open_dynamic_mode();
-            buf_ret = _buffer.push_string("[", 1);
+            buffer.open_dynamic_mode();
+            buf_ret = buffer.push_string("[", 1);
             bool begin = true;
             for (int j = offsets[i - 1]; j < offsets[i]; ++j) {
                 if (!begin) {
-                    buf_ret = _buffer.push_string(", ", 2);
+                    buf_ret = buffer.push_string(", ", 2);
                 }
                 const auto& data = column_array.get_data_ptr();
                 if (data->is_null_at(j)) {
-                    buf_ret = _buffer.push_string("NULL", strlen("NULL"));
+                    buf_ret = buffer.push_string("NULL", strlen("NULL"));
                 } else {
-                    buf_ret = _add_one_cell(data, j, nested_type_ptr, _buffer);
+                    buf_ret = _add_one_cell(data, j, nested_type_ptr, buffer);
                 }
                 begin = false;
             }
-            buf_ret = _buffer.push_string("]", 1);
-            _buffer.close_dynamic_mode();
-            result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
+            buf_ret = buffer.push_string("]", 1);
+            buffer.close_dynamic_mode();
+            offsets[i] = buffer.length();
         }
     } else {
         using ColumnType = typename PrimitiveTypeTraits<type>::ColumnType;
@@ -152,62 +186,57 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             if (0 != buf_ret) {
                 return Status::InternalError("pack mysql buffer failed.");
             }
-            _buffer.reset();
 
             if constexpr (is_nullable) {
                 if (column_ptr->is_null_at(i)) {
-                    buf_ret = _buffer.push_null();
-                    result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
+                    buf_ret = buffer.push_null();
+                    offsets[i] = buffer.length();
                     continue;
                 }
             }
 
             if constexpr (type == TYPE_BOOLEAN) {
                 //todo here need to using uint after MysqlRowBuffer support it
-                buf_ret = _buffer.push_tinyint(data[i]);
+                buf_ret = buffer.push_tinyint(data[i]);
             }
             if constexpr (type == TYPE_TINYINT) {
-                buf_ret = _buffer.push_tinyint(data[i]);
+                buf_ret = buffer.push_tinyint(data[i]);
             }
             if constexpr (type == TYPE_SMALLINT) {
-                buf_ret = _buffer.push_smallint(data[i]);
+                buf_ret = buffer.push_smallint(data[i]);
             }
             if constexpr (type == TYPE_INT) {
-                buf_ret = _buffer.push_int(data[i]);
+                buf_ret = buffer.push_int(data[i]);
             }
             if constexpr (type == TYPE_BIGINT) {
-                buf_ret = _buffer.push_bigint(data[i]);
+                buf_ret = buffer.push_bigint(data[i]);
             }
             if constexpr (type == TYPE_LARGEINT) {
-                auto v = LargeIntValue::to_string(data[i]);
-                buf_ret = _buffer.push_string(v.c_str(), v.size());
+                buf_ret = buffer.push_largeint(data[i]);
             }
             if constexpr (type == TYPE_FLOAT) {
-                buf_ret = _buffer.push_float(data[i]);
+                buf_ret = buffer.push_float(data[i]);
             }
             if constexpr (type == TYPE_DOUBLE) {
-                buf_ret = _buffer.push_double(data[i]);
+                buf_ret = buffer.push_double(data[i]);
             }
             if constexpr (type == TYPE_TIME) {
-                buf_ret = _buffer.push_time(data[i]);
+                buf_ret = buffer.push_time(data[i]);
             }
             if constexpr (type == TYPE_DATETIME) {
                 char buf[64];
                 auto time_num = data[i];
                 VecDateTimeValue time_val;
                 memcpy(static_cast<void*>(&time_val), &time_num, sizeof(Int64));
-                // TODO(zhaochun), this function has core risk
-                char* pos = time_val.to_string(buf);
-                buf_ret = _buffer.push_string(buf, pos - buf - 1);
+                int len = time_val.tobuffer(buf);
+                buf_ret = buffer.push_string(buf, len);
             }
 
             if constexpr (type == TYPE_DECIMALV2) {
-                DecimalV2Value decimal_val(data[i]);
-                auto decimal_str = decimal_val.to_string();
-                buf_ret = _buffer.push_string(decimal_str.c_str(), decimal_str.length());
+                buf_ret = buffer.push_decimal(DecimalV2Value(data[i]), -1);
             }
 
-            result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
+            offsets[i] = buffer.length();
         }
     }
     if (0 != buf_ret) {
@@ -249,8 +278,7 @@ int VMysqlResultWriter::_add_one_cell(const ColumnPtr& column_ptr, size_t row_id
         return buffer.push_bigint(data[row_idx]);
     } else if (which.is_int128()) {
         auto& data = assert_cast<const ColumnInt128&>(*column).get_data();
-        auto v = LargeIntValue::to_string(data[row_idx]);
-        return buffer.push_string(v.c_str(), v.size());
+        return buffer.push_largeint(data[row_idx]);
     } else if (which.is_float32()) {
         auto& data = assert_cast<const ColumnFloat32&>(*column).get_data();
         return buffer.push_float(data[row_idx]);
@@ -281,14 +309,12 @@ int VMysqlResultWriter::_add_one_cell(const ColumnPtr& column_ptr, size_t row_id
             datetime.cast_to_date();
         }
         char buf[64];
-        char* pos = datetime.to_string(buf);
-        return buffer.push_string(buf, pos - buf - 1);
+        int len = datetime.to_buffer(buf);
+        return buffer.push_string(buf, len);
     } else if (which.is_decimal128()) {
         auto& column_data =
                 static_cast<const ColumnDecimal<vectorized::Decimal128>&>(*column).get_data();
-        DecimalV2Value decimal_val(column_data[row_idx]);
-        auto decimal_str = decimal_val.to_string();
-        return buffer.push_string(decimal_str.c_str(), decimal_str.length());
+        return buffer.push_decimal(DecimalV2Value(column_data[row_idx]), -1);
     } else if (which.is_array()) {
         auto& column_array = assert_cast<const ColumnArray&>(*column);
         auto& offsets = column_array.get_offsets();
@@ -347,82 +373,87 @@ Status VMysqlResultWriter::append_block(Block& input_block) {
         return status;
     }
 
-    // convert one batch
+    // convert one batch, column by column
     auto result = std::make_unique<TFetchDataResult>();
     result->result_batch.rows.resize(num_rows);
-    for (int i = 0; status.ok() && i < _output_vexpr_ctxs.size(); ++i) {
+    const size_t num_columns = _output_vexpr_ctxs.size();
+    while (_column_buffers.size() < num_columns) {
+        _column_buffers.emplace_back(std::make_unique<ColumnBuffer>());
+    }
+    for (int i = 0; status.ok() && i < num_columns; ++i) {
+        auto& buffer = *_column_buffers[i];
         auto column_ptr = block.get_by_position(i).column->convert_to_full_column_if_const();
         auto type_ptr = block.get_by_position(i).type;
 
         switch (_output_vexpr_ctxs[i]->root()->result_type()) {
         case TYPE_BOOLEAN:
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_BOOLEAN, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_BOOLEAN, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_BOOLEAN, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_BOOLEAN, false>(column_ptr, buffer);
             }
             break;
         case TYPE_TINYINT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_TINYINT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_TINYINT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_TINYINT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_TINYINT, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_SMALLINT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_SMALLINT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_SMALLINT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_SMALLINT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_SMALLINT, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_INT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_INT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_INT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_INT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_INT, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_BIGINT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_BIGINT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_BIGINT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_BIGINT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_BIGINT, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_LARGEINT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_LARGEINT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_LARGEINT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_LARGEINT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_LARGEINT, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_FLOAT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_FLOAT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_FLOAT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_FLOAT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_FLOAT, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_DOUBLE: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_DOUBLE, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_DOUBLE, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_DOUBLE, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_DOUBLE, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_TIME: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_TIME, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_TIME, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_TIME, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_TIME, false>(column_ptr, buffer);
             }
             break;
         }
@@ -430,35 +461,35 @@ Status VMysqlResultWriter::append_block(Block& input_block) {
         case TYPE_CHAR:
         case TYPE_VARCHAR: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_VARCHAR, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_VARCHAR, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_VARCHAR, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_VARCHAR, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_DECIMALV2: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_DECIMALV2, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_DECIMALV2, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_DECIMALV2, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_DECIMALV2, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_DATE:
         case TYPE_DATETIME: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_DATETIME, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_DATETIME, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_DATETIME, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_DATETIME, false>(column_ptr, buffer);
             }
             break;
         }
         case TYPE_HLL:
         case TYPE_OBJECT: {
             if (type_ptr->is_nullable()) {
-                status = _add_one_column<PrimitiveType::TYPE_OBJECT, true>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_OBJECT, true>(column_ptr, buffer);
             } else {
-                status = _add_one_column<PrimitiveType::TYPE_OBJECT, false>(column_ptr, result);
+                status = _add_one_column<PrimitiveType::TYPE_OBJECT, false>(column_ptr, buffer);
             }
             break;
         }
@@ -467,11 +498,11 @@ Status VMysqlResultWriter::append_block(Block& input_block) {
                 auto& nested_type =
                         assert_cast<const DataTypeNullable&>(*type_ptr).get_nested_type();
                 auto& sub_type = assert_cast<const DataTypeArray&>(*nested_type).get_nested_type();
-                status = _add_one_column<PrimitiveType::TYPE_ARRAY, true>(column_ptr, result,
+                status = _add_one_column<PrimitiveType::TYPE_ARRAY, true>(column_ptr, buffer,
                                                                           sub_type);
             } else {
                 auto& sub_type = assert_cast<const DataTypeArray&>(*type_ptr).get_nested_type();
-                status = _add_one_column<PrimitiveType::TYPE_ARRAY, false>(column_ptr, result,
+                status = _add_one_column<PrimitiveType::TYPE_ARRAY, false>(column_ptr, buffer,
                                                                            sub_type);
             }
             break;
@@ -488,6 +519,25 @@ Status VMysqlResultWriter::append_block(Block& input_block) {
             break;
         }
     }
+    if (status) {
+        SCOPED_TIMER(_convert_tuple_timer);
+        // gather the cells of each row from the column buffers, every row is allocated once
+        for (size_t row = 0; row < num_rows; ++row) {
+            size_t row_length = 0;
+            for (size_t col = 0; col < num_columns; ++col) {
+                const auto& offsets = _column_buffers[col]->offsets;
+                row_length += offsets[row] - (row == 0 ? 0 : offsets[row - 1]);
+            }
+            auto& row_data = result->result_batch.rows[row];
+            row_data.reserve(row_length);
+            for (size_t col = 0; col < num_columns; ++col) {
+                const auto& column_buffer = *_column_buffers[col];
+                size_t start = row == 0 ? 0 : column_buffer.offsets[row - 1];
+                row_data.append(column_buffer.buffer.buf() + start,
+                                column_buffer.offsets[row] - start);
+            }
+        }
+    }
     if (status) {
         SCOPED_TIMER(_result_send_timer);
         // push this batch to back
@@ -48,8 +48,15 @@ public:
 private:
     void _init_profile();
 
+    // The cells of a column serialized one after another, offsets[i] is the end of the i-th
+    // row. The buffers are kept between blocks to avoid allocating them again.
+    struct ColumnBuffer {
+        MysqlRowBuffer buffer;
+        std::vector<size_t> offsets;
+    };
+
     template <PrimitiveType type, bool is_nullable>
-    Status _add_one_column(const ColumnPtr& column_ptr, std::unique_ptr<TFetchDataResult>& result,
+    Status _add_one_column(const ColumnPtr& column_ptr, ColumnBuffer& column_buffer,
                            const DataTypePtr& nested_type_ptr = nullptr);
     int _add_one_cell(const ColumnPtr& column_ptr, size_t row_idx, const DataTypePtr& type,
                       MysqlRowBuffer& buffer);
@@ -68,6 +75,8 @@ private:
     RuntimeProfile::Counter* _result_send_timer = nullptr;
     // number of sent rows
     RuntimeProfile::Counter* _sent_rows_counter = nullptr;
+
+    std::vector<std::unique_ptr<ColumnBuffer>> _column_buffers;
 };
 } // namespace vectorized
 } // namespace doris
\ No newline at end of file
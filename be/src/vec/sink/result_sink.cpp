@@ -93,6 +93,10 @@ Status VResultSink::send(RuntimeState* state, Block* block) {
     return _writer->append_block(*block);
 }
 
+bool VResultSink::can_write() {
+    return _sender == nullptr || _sender->can_add_batch();
+}
+
 Status VResultSink::close(RuntimeState* state, Status exec_status) {
     if (_closed) {
         return Status::OK();
@@ -45,6 +45,7 @@ public:
     // not implement
     virtual Status send(RuntimeState* state, RowBatch* batch) override;
     virtual Status send(RuntimeState* state, Block* block) override;
+    bool can_write() override;
     // Flush all buffered data and close all existing channels to destination
     // hosts. Further send() calls are illegal after calling close().
     virtual Status close(RuntimeState* state, Status exec_status) override;
@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include <algorithm>
 #include <random>
 
 #include "runtime/client_cache.h"
@@ -29,9 +30,12 @@
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "util/proto_util.h"
+#include "util/query_trace.h"
+#include "util/string_util.h"
 #include "vec/common/sip_hash.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 #include "vec/runtime/vdata_stream_recvr.h"
+#include "vec/runtime/vexchange_relay.h"
 #include "vec/runtime/vpartition_info.h"
 
 namespace doris::vectorized {
@@ -72,17 +76,45 @@ Status VDataStreamSender::Channel::init(RuntimeState* state) {
     // In bucket shuffle join will set fragment_instance_id (-1, -1)
     // to build a camouflaged empty channel. the ip and port is '0.0.0.0:0"
     // so the empty channel not need call function close_internal()
-    _need_close = (_fragment_instance_id.hi != -1 && _fragment_instance_id.lo != -1);
+    _need_close = (_fragment_instance_id.hi != -1 && _fragment_instance_id.lo != -1) &&
+                  !_is_relayed;
     _state = state;
+    if (_brpc_request.relay_destinations_size() > 0) {
+        // the relays answer transmit_block only
+        _brpc_request.set_relay_timeout_ms(_brpc_timeout_ms);
+    } else if (_need_close && !_is_local && config::exchange_use_brpc_stream) {
+        _open_stream_writer();
+    }
     return Status::OK();
 }
 
+void VDataStreamSender::Channel::set_relay_channels(const std::vector<Channel*>& channels,
+                                                    int fanout) {
+    for (auto channel : channels) {
+        auto dest = _brpc_request.add_relay_destinations();
+        dest->mutable_finst_id()->set_hi(channel->_fragment_instance_id.hi);
+        dest->mutable_finst_id()->set_lo(channel->_fragment_instance_id.lo);
+        dest->set_host(channel->_brpc_dest_addr.hostname);
+        dest->set_port(channel->_brpc_dest_addr.port);
+        channel->_is_relayed = true;
+    }
+    _brpc_request.set_relay_fanout(fanout);
+}
+
+void VDataStreamSender::Channel::_open_stream_writer() {
+    _stream_writer = std::make_unique<ExchangeStreamWriter>();
+    Status st = _stream_writer->open(_brpc_stub.get(), _brpc_request, _brpc_timeout_ms);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to open exchange stream to " << _brpc_dest_addr.hostname
+                     << ", send blocks by transmit_block instead: " << st;
+        _stream_writer.reset();
+    }
+}
+
 Status VDataStreamSender::Channel::send_current_block(bool eos) {
-    // TODO: Now, local exchange will cause the performance problem is in a multi-threaded scenario
-    //  so this feature is turned off here. We need to re-examine this logic
-    //    if (is_local()) {
-    //        return send_local_block(eos);
-    //    }
+    if (is_local()) {
+        return send_local_block(eos);
+    }
     auto block = _mutable_block->to_block();
     RETURN_IF_ERROR(_parent->serialize_block(&block, _ch_cur_pb_block));
     block.clear_column_data();
@@ -92,34 +124,74 @@ Status VDataStreamSender::Channel::send_current_block(bool eos) {
     return Status::OK();
 }
 
+std::shared_ptr<VDataStreamRecvr> VDataStreamSender::Channel::_find_local_recvr() {
+    if (_local_recvr == nullptr) {
+        _local_recvr = _parent->state()->exec_env()->vstream_mgr()->find_recvr(
+                _fragment_instance_id, _dest_node_id);
+    }
+    return _local_recvr;
+}
+
+void VDataStreamSender::Channel::_send_local_query_statistics(VDataStreamRecvr* recvr, bool eos) {
+    if (_is_transfer_chain && (_send_query_statistics_with_every_batch || eos)) {
+        PQueryStatistics statistics;
+        _parent->_query_statistics->to_pb(&statistics);
+        recvr->add_sub_plan_statistics(statistics, _parent->_sender_id);
+    }
+}
+
 Status VDataStreamSender::Channel::send_local_block(bool eos) {
-    std::shared_ptr<VDataStreamRecvr> recvr =
-            _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
-                                                                    _dest_node_id);
+    std::shared_ptr<VDataStreamRecvr> recvr = _find_local_recvr();
     if (recvr != nullptr) {
-        Block block = _mutable_block->to_block();
-        COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
-        recvr->add_block(&block, _parent->_sender_id, true);
+        _send_local_query_statistics(recvr.get(), eos);
+        if (_mutable_block != nullptr && _mutable_block->rows() > 0) {
+            Block block = _mutable_block->to_block();
+            COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
+            recvr->add_block(&block, _parent->_sender_id, true);
+        }
         if (eos) {
             recvr->remove_sender(_parent->_sender_id, _be_number);
         }
     }
-    _mutable_block->clear();
+    // the columns are moved to the receiver, add_rows() creates new ones
+    _mutable_block.reset();
     return Status::OK();
 }
 
 Status VDataStreamSender::Channel::send_local_block(Block* block) {
-    std::shared_ptr<VDataStreamRecvr> recvr =
-            _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
-                                                                    _dest_node_id);
+    std::shared_ptr<VDataStreamRecvr> recvr = _find_local_recvr();
     if (recvr != nullptr) {
+        _send_local_query_statistics(recvr.get(), false);
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
         recvr->add_block(block, _parent->_sender_id, false);
     }
     return Status::OK();
 }
 
+bool VDataStreamSender::Channel::can_write_local() {
+    std::shared_ptr<VDataStreamRecvr> recvr = _find_local_recvr();
+    return recvr == nullptr || !recvr->is_full();
+}
+
 Status VDataStreamSender::Channel::send_block(PBlock* block, bool eos) {
+    SCOPED_QUERY_TRACE("exchange", "send_block");
+    if (_stream_writer != nullptr) {
+        if (_is_transfer_chain && (_send_query_statistics_with_every_batch || eos)) {
+            auto statistic = _brpc_request.mutable_query_statistics();
+            _parent->_query_statistics->to_pb(statistic);
+        }
+        _brpc_request.set_eos(eos);
+        if (block != nullptr) {
+            _brpc_request.set_allocated_block(block);
+        }
+        _brpc_request.set_packet_seq(_packet_seq++);
+        // the request is serialized into the stream, the block can be reused at once
+        Status st = _stream_writer->write(_brpc_request);
+        if (block != nullptr) {
+            _brpc_request.release_block();
+        }
+        return st;
+    }
     if (_closure == nullptr) {
         _closure = new RefCountClosure<PTransmitDataResult>();
         _closure->ref();
@@ -187,44 +259,42 @@ Status VDataStreamSender::Channel::add_row(Block* block, int row) {
     return Status::OK();
 }
 
-Status VDataStreamSender::Channel::add_rows(Block* block, const std::vector<int>& rows) {
+Status VDataStreamSender::Channel::add_columns(Block* block, MutableColumns&& columns) {
     if (_fragment_instance_id.lo == -1) {
         return Status::OK();
     }
-
-    if (_mutable_block.get() == nullptr) {
-        _mutable_block.reset(new MutableBlock(block->clone_empty()));
+    if (columns.empty() || columns[0]->empty()) {
+        return Status::OK();
     }
 
-    int row_wait_add = rows.size();
-    int batch_size = _parent->state()->batch_size();
-    const int* begin = &rows[0];
-
-    while (row_wait_add > 0) {
-        int row_add = 0;
-        int max_add = batch_size - _mutable_block->rows();
-        if (row_wait_add >= max_add) {
-            row_add = max_add;
-        } else {
-            row_add = row_wait_add;
-        }
-
-        _mutable_block->add_rows(block, begin, begin + row_add);
-
-        row_wait_add -= row_add;
-        begin += row_add;
-
-        if (row_add == max_add) {
-            RETURN_IF_ERROR(send_current_block());
+    if (_mutable_block == nullptr) {
+        // a local channel moves the columns to the receiver when sending the block
+        _mutable_block.reset(new MutableBlock());
+        _mutable_block->data_types() = block->get_data_types();
+    }
+    if (_mutable_block->rows() == 0) {
+        _mutable_block->set_muatable_columns(std::move(columns));
+    } else {
+        auto& dst_columns = _mutable_block->mutable_columns();
+        DCHECK_EQ(dst_columns.size(), columns.size());
+        for (size_t i = 0; i < dst_columns.size(); ++i) {
+            dst_columns[i]->insert_range_from(*columns[i], 0, columns[i]->size());
         }
     }
 
+    if (_mutable_block->rows() >= _parent->state()->batch_size()) {
+        RETURN_IF_ERROR(send_current_block());
+    }
     return Status::OK();
 }
 
 Status VDataStreamSender::Channel::close_wait(RuntimeState* state) {
     if (_need_close) {
         Status st = _wait_last_brpc();
+        if (_stream_writer != nullptr) {
+            st = _stream_writer->wait_eos();
+            _stream_writer->close();
+        }
         if (!st.ok()) {
             state->log_error(st.get_error_msg());
         }
@@ -242,7 +312,9 @@ Status VDataStreamSender::Channel::close_internal() {
     VLOG_RPC << "Channel::close() instance_id=" << _fragment_instance_id
              << " dest_node=" << _dest_node_id
              << " #rows= " << ((_mutable_block == nullptr) ? 0 : _mutable_block->rows());
-    if (_mutable_block != nullptr && _mutable_block->rows() > 0) {
+    if (is_local()) {
+        RETURN_IF_ERROR(send_local_block(true));
+    } else if (_mutable_block != nullptr && _mutable_block->rows() > 0) {
         RETURN_IF_ERROR(send_current_block(true));
     } else {
         RETURN_IF_ERROR(send_block(nullptr, true));
@@ -405,6 +477,7 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
         std::random_device rd;
         std::mt19937 g(rd());
         shuffle(_channels.begin(), _channels.end(), g);
+        _init_broadcast_relay();
     } else if (_part_type == TPartitionType::HASH_PARTITIONED ||
                _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) {
         RETURN_IF_ERROR(VExpr::prepare(_partition_expr_ctxs, state, _row_desc, _expr_mem_tracker));
@@ -425,6 +498,10 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
                                profile()->total_time_counter()),
             "");
     _local_bytes_send_counter = ADD_COUNTER(profile(), "LocalBytesSent", TUnit::BYTES);
+    _uncompressed_blocks_counter =
+            ADD_COUNTER(profile(), "UncompressedBlocksByPoorRatio", TUnit::UNIT);
+
+    RETURN_IF_ERROR(_init_compression_codec(state));
     for (int i = 0; i < _channels.size(); ++i) {
         RETURN_IF_ERROR(_channels[i]->init(state));
     }
@@ -445,6 +522,15 @@ Status VDataStreamSender::send(RuntimeState* state, RowBatch* batch) {
     return Status::NotSupported("Not Implemented VOlapScanNode Node::get_next scalar");
 }
 
+bool VDataStreamSender::can_write() {
+    for (auto channel : _channels) {
+        if (channel->is_local() && !channel->can_write_local()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status VDataStreamSender::send(RuntimeState* state, Block* block) {
     SCOPED_TIMER(_profile->total_time_counter());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
@@ -461,9 +547,12 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
                 RETURN_IF_ERROR(channel->send_local_block(block));
             }
         } else {
-            RETURN_IF_ERROR(serialize_block(block, _cur_pb_block, _channels.size()));
+            RETURN_IF_ERROR(serialize_block(block, _cur_pb_block,
+                                            _channels.size() - _num_relayed_channels));
             for (auto channel : _channels) {
-                if (channel->is_local()) {
+                if (channel->is_relayed()) {
+                    continue;
+                } else if (channel->is_local()) {
                     RETURN_IF_ERROR(channel->send_local_block(block));
                 } else {
                     RETURN_IF_ERROR(channel->send_block(_cur_pb_block));
@@ -500,12 +589,9 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         // result[j] means column index, i means rows index
         for (int j = 0; j < result_size; ++j) {
             auto column = block->get_by_position(result[j]).column;
-            for (int i = 0; i < rows; ++i) {
-                column->update_hash_with_value(i, siphashs[i]);
-            }
+            column->update_hashes_with_value(siphashs);
         }
 
-        // channel2rows' subscript means channel id
         std::vector<vectorized::UInt64> hash_vals(rows);
         for (int i = 0; i < rows; i++) {
             hash_vals[i] = siphashs[i].get64();
@@ -526,24 +612,12 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         // vectorized calculate hash val
         int rows = block->rows();
         // for each row, we have a hash_val
-        std::vector<size_t> hash_vals(rows);
+        std::vector<uint32_t> hash_vals(rows);
 
         // result[j] means column index, i means rows index
         for (int j = 0; j < result_size; ++j) {
             auto& column = block->get_by_position(result[j]).column;
-            for (int i = 0; i < rows; ++i) {
-                auto val = column->get_data_at(i);
-                if (val.data == nullptr) {
-                    // nullptr is treat as 0 when hash
-                    static const int INT_VALUE = 0;
-                    static const TypeDescriptor INT_TYPE(TYPE_INT);
-                    hash_vals[i] = RawValue::zlib_crc32(&INT_VALUE, INT_TYPE, hash_vals[i]);
-                } else {
-                    hash_vals[i] = RawValue::zlib_crc32(val.data, val.size,
-                                                        _partition_expr_ctxs[j]->root()->type(),
-                                                        hash_vals[i]);
-                }
-            }
+            column->update_crcs_with_value(hash_vals, _partition_expr_ctxs[j]->root()->type());
         }
 
         Block::erase_useless_column(block, column_to_keep);
@@ -582,13 +656,74 @@ Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
     return final_st;
 }
 
+void VDataStreamSender::_init_broadcast_relay() {
+    int fanout = config::exchange_broadcast_relay_fanout;
+    if (_part_type != TPartitionType::UNPARTITIONED || fanout <= 0) {
+        return;
+    }
+    std::vector<Channel*> remote_channels;
+    for (auto channel : _channels) {
+        auto finst_id = channel->get_fragment_instance_id();
+        if (!channel->is_local() && finst_id.hi != -1 && finst_id.lo != -1) {
+            remote_channels.push_back(channel);
+        }
+    }
+    if (remote_channels.size() <= static_cast<size_t>(fanout)) {
+        return;
+    }
+    // the query statistics are not relayed, the channel sending them must be a root
+    std::stable_partition(remote_channels.begin(), remote_channels.end(),
+                          [](Channel* channel) { return channel->is_transfer_chain(); });
+    for (auto [begin, end] : split_relay_destinations(remote_channels.size(), fanout)) {
+        remote_channels[begin]->set_relay_channels(
+                {remote_channels.begin() + begin + 1, remote_channels.begin() + end}, fanout);
+        _num_relayed_channels += end - begin - 1;
+    }
+}
+
+Status VDataStreamSender::_init_compression_codec(RuntimeState* state) {
+    const std::string& codec_name = state->fragment_transmission_compression_codec();
+    if (codec_name.empty()) {
+        _compression_type = config::compress_rowbatches
+                                    ? segment_v2::CompressionTypePB::SNAPPY
+                                    : segment_v2::CompressionTypePB::NO_COMPRESSION;
+    } else if (iequal(codec_name, "none")) {
+        _compression_type = segment_v2::CompressionTypePB::NO_COMPRESSION;
+    } else if (iequal(codec_name, "snappy")) {
+        _compression_type = segment_v2::CompressionTypePB::SNAPPY;
+    } else if (iequal(codec_name, "lz4")) {
+        _compression_type = segment_v2::CompressionTypePB::LZ4;
+    } else if (iequal(codec_name, "zstd")) {
+        _compression_type = segment_v2::CompressionTypePB::ZSTD;
+    } else {
+        return Status::InvalidArgument(
+                fmt::format("unknown fragment transmission compression codec: {}", codec_name));
+    }
+    return get_block_compression_codec(
+            _compression_type, state->fragment_transmission_compression_level(),
+            _compression_codec);
+}
+
 Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers) {
     {
         SCOPED_TIMER(_serialize_batch_timer);
+        SCOPED_QUERY_TRACE("exchange", "serialize_block");
         dest->Clear();
         size_t uncompressed_bytes = 0, compressed_bytes = 0;
+        BlockCompressionCodec* codec = _compression_codec.get();
+        if (codec != nullptr && _compression_skipped_blocks > 0) {
+            --_compression_skipped_blocks;
+            COUNTER_UPDATE(_uncompressed_blocks_counter, 1);
+            codec = nullptr;
+        }
         RETURN_IF_ERROR(src->serialize(dest, &uncompressed_bytes, &compressed_bytes,
-                                       _transfer_large_data_by_brpc));
+                                       _compression_type, codec, _transfer_large_data_by_brpc));
+        // Compressing data which hardly shrinks only costs cpu, send the next blocks
+        // uncompressed and try again later in case the data changes.
+        if (codec != nullptr &&
+            compressed_bytes > uncompressed_bytes * config::exchange_compression_min_ratio) {
+            _compression_skipped_blocks = config::exchange_compression_skip_blocks;
+        }
         COUNTER_UPDATE(_bytes_sent_counter, compressed_bytes * num_receivers);
         COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_bytes * num_receivers);
     }
@@ -25,11 +25,13 @@
 #include "runtime/descriptors.h"
 #include "service/backend_options.h"
 #include "service/brpc.h"
+#include "util/block_compression.h"
 #include "util/brpc_client_cache.h"
 #include "util/network_util.h"
 #include "util/ref_count_closure.h"
 #include "util/uid_util.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/runtime/vexchange_stream.h"
 
 namespace doris {
 class ObjectPool;
@@ -44,6 +46,7 @@ class PartRangeKey;
 namespace vectorized {
 class VExprContext;
 class VPartitionInfo;
+class VDataStreamRecvr;
 
 class VDataStreamSender : public DataSink {
 public:
@@ -69,6 +72,9 @@ public:
     virtual Status send(RuntimeState* state, RowBatch* batch) override;
     virtual Status send(RuntimeState* state, Block* block) override;
 
+    // Only the local receivers are checked, a remote channel waits for the last rpc only.
+    bool can_write() override;
+
     virtual Status close(RuntimeState* state, Status exec_status) override;
     virtual RuntimeProfile* profile() override { return _profile; }
 
@@ -78,6 +84,10 @@ public:
 
 protected:
     void _roll_pb_block();
+    Status _init_compression_codec(RuntimeState* state);
+    // Relays a broadcast to many remote receivers through a tree of them, see
+    // exchange_broadcast_relay_fanout.
+    void _init_broadcast_relay();
     class Channel;
 
     Status get_partition_column_result(Block* block, int* result) const {
@@ -146,10 +156,21 @@ protected:
 
     // User can change this config at runtime, avoid it being modified during query or loading process.
     bool _transfer_large_data_by_brpc = false;
-};
 
-// TODO: support local exechange
+    // the codec of the serialized blocks, chosen by the query option
+    // fragment_transmission_compression_codec, nullptr means no compression
+    segment_v2::CompressionTypePB _compression_type;
+    std::unique_ptr<BlockCompressionCodec> _compression_codec;
+    // the blocks still sent uncompressed since the compression ratio was found to be poor
+    int _compression_skipped_blocks = 0;
+    RuntimeProfile::Counter* _uncompressed_blocks_counter;
+    // number of the channels whose blocks are relayed by other receivers
+    int _num_relayed_channels = 0;
+};
 
+// A channel to the receiver on the same BE (is_local()) passes the blocks to it by moving
+// the columns without serialization, and waits in VDataStreamRecvr::add_block() while the
+// receiver is full as a remote channel waits for the delayed rpc response.
 class VDataStreamSender::Channel {
 public:
     // Create channel to send data to particular ipaddress/port/query/node
@@ -173,7 +194,7 @@ public:
               _send_query_statistics_with_every_batch(send_query_statistics_with_every_batch),
               _ch_cur_pb_block(&_ch_pb_block1) {
         std::string localhost = BackendOptions::get_localhost();
-        _is_local = (_brpc_dest_addr.hostname == localhost) &&
+        _is_local = config::enable_local_exchange && (_brpc_dest_addr.hostname == localhost) &&
                     (_brpc_dest_addr.port == config::brpc_port);
         if (_is_local) {
             LOG(INFO) << "will use local Exchange, dest_node_id is : " << _dest_node_id;
@@ -181,6 +202,7 @@ public:
     }
 
     virtual ~Channel() {
+        _stream_writer.reset();
         if (_closure != nullptr && _closure->unref()) {
             delete _closure;
         }
@@ -205,7 +227,9 @@ public:
     Status send_block(PBlock* block, bool eos = false);
 
     Status add_row(Block* block, int row);
-    Status add_rows(Block* block, const std::vector<int>& row);
+    // Append the columns scattered from block to this channel, takes them over directly
+    // when nothing is buffered.
+    Status add_columns(Block* block, MutableColumns&& columns);
 
     Status send_current_block(bool eos = false);
 
@@ -234,6 +258,19 @@ public:
 
     bool is_local() const { return _is_local; }
 
+    bool is_transfer_chain() const { return _is_transfer_chain; }
+
+    // Relays the packets of this channel to the receivers of `channels` in a tree of
+    // `fanout`, see vexchange_relay.h. Must be called before init().
+    void set_relay_channels(const std::vector<Channel*>& channels, int fanout);
+
+    // The packets are relayed to the receiver by another one, nothing is sent by this
+    // channel.
+    bool is_relayed() const { return _is_relayed; }
+
+    // Whether send_local_block() returns without waiting for the receiver.
+    bool can_write_local();
+
     void ch_roll_pb_block();
 
 private:
@@ -258,6 +295,15 @@ private:
     Status send_current_batch(bool eos = false);
     Status close_internal();
 
+    // The receiver of a local channel, which is looked up until it is registered.
+    std::shared_ptr<VDataStreamRecvr> _find_local_recvr();
+    // Pass the query statistics to the local receiver as send_block() does by rpc.
+    void _send_local_query_statistics(VDataStreamRecvr* recvr, bool eos);
+
+    // Open the exchange stream if exchange_use_brpc_stream is set, falls back to
+    // transmit_block rpcs if the receiver does not support it.
+    void _open_stream_writer();
+
     VDataStreamSender* _parent;
     int _buffer_size;
 
@@ -283,6 +329,8 @@ private:
     PTransmitDataParams _brpc_request;
     std::shared_ptr<PBackendService_Stub> _brpc_stub = nullptr;
     RefCountClosure<PTransmitDataResult>* _closure = nullptr;
+    // not null if the blocks are sent through a brpc stream
+    std::unique_ptr<ExchangeStreamWriter> _stream_writer;
     int32_t _brpc_timeout_ms = 500;
     // whether the dest can be treated as query statistics transfer chain.
     bool _is_transfer_chain;
@@ -291,6 +339,8 @@ private:
 
     size_t _capacity;
     bool _is_local;
+    std::shared_ptr<VDataStreamRecvr> _local_recvr;
+    bool _is_relayed = false;
 
     // serialized blocks for broadcasting; we need two so we can write
     // one while the other one is still being sent.
@@ -304,19 +354,25 @@ private:
 template <typename Channels, typename HashVals>
 Status VDataStreamSender::channel_add_rows(Channels& channels, int num_channels,
                                            const HashVals& hash_vals, int rows, Block* block) {
-    std::vector<int> channel2rows[num_channels];
-
+    IColumn::Selector selector(rows);
     for (int i = 0; i < rows; i++) {
-        auto cid = hash_vals[i] % num_channels;
-        channel2rows[cid].emplace_back(i);
+        selector[i] = hash_vals[i] % num_channels;
     }
 
-    for (int i = 0; i < num_channels; ++i) {
-        if (!channel2rows[i].empty()) {
-            RETURN_IF_ERROR(channels[i]->add_rows(block, channel2rows[i]));
+    // scatter each column once, the i-th part of every column belongs to channel i
+    std::vector<MutableColumns> channel_columns(num_channels);
+    for (size_t i = 0; i < block->columns(); ++i) {
+        auto column = block->get_by_position(i).column->convert_to_full_column_if_const();
+        auto scattered_columns = column->scatter(num_channels, selector);
+        for (int j = 0; j < num_channels; ++j) {
+            channel_columns[j].emplace_back(std::move(scattered_columns[j]));
         }
     }
 
+    for (int i = 0; i < num_channels; ++i) {
+        RETURN_IF_ERROR(channels[i]->add_columns(block, std::move(channel_columns[i])));
+    }
+
     return Status::OK();
 }
 
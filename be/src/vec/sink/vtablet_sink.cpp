@@ -36,10 +36,10 @@ VNodeChannel::VNodeChannel(OlapTableSink* parent, IndexChannel* index_channel, i
 }
 
 VNodeChannel::~VNodeChannel() {
-    if (_add_block_closure != nullptr) {
-        delete _add_block_closure;
-        _add_block_closure = nullptr;
+    for (auto closure : _add_block_closures) {
+        delete closure;
     }
+    _add_block_closures.clear();
     _cur_add_block_request.release_id();
 }
 
@@ -76,9 +76,17 @@ Status VNodeChannel::open_wait() {
         return status;
     }
 
-    // add block closure
-    _add_block_closure = ReusableClosure<PTabletWriterAddBlockResult>::create();
-    _add_block_closure->addFailedHandler([this](bool is_last_rpc) {
+    // add block closures
+    int num_closures = std::max(1, config::tablet_writer_max_inflight_rpcs);
+    for (int i = 0; i < num_closures; ++i) {
+        _add_block_closures.push_back(_create_add_block_closure());
+    }
+    return status;
+}
+
+ReusableClosure<PTabletWriterAddBlockResult>* VNodeChannel::_create_add_block_closure() {
+    auto closure = ReusableClosure<PTabletWriterAddBlockResult>::create();
+    closure->addFailedHandler([this, closure](bool is_last_rpc) {
         std::lock_guard<std::mutex> l(this->_closed_lock);
         if (this->_is_closed) {
             // if the node channel is closed, no need to call `mark_as_failed`,
@@ -86,8 +94,8 @@ Status VNodeChannel::open_wait() {
             return;
         }
         // If rpc failed, mark all tablets on this node channel as failed
-        _index_channel->mark_as_failed(this->node_id(), this->host(),
-                                       _add_block_closure->cntl.ErrorText(), -1);
+        _index_channel->mark_as_failed(this->node_id(), this->host(), closure->cntl.ErrorText(),
+                                       -1);
         Status st = _index_channel->check_intolerable_failure();
         if (!st.ok()) {
             _cancel_with_msg(fmt::format("{}, err: {}", channel_info(), st.get_error_msg()));
@@ -98,8 +106,8 @@ Status VNodeChannel::open_wait() {
         }
     });
 
-    _add_block_closure->addSuccessHandler([this](const PTabletWriterAddBlockResult& result,
-                                                 bool is_last_rpc) {
+    closure->addSuccessHandler([this](const PTabletWriterAddBlockResult& result,
+                                      bool is_last_rpc) {
         std::lock_guard<std::mutex> l(this->_closed_lock);
         if (this->_is_closed) {
             // if the node channel is closed, no need to call the following logic,
@@ -124,6 +132,15 @@ Status VNodeChannel::open_wait() {
                     commit_info.backendId = _node_id;
                     _tablet_commit_infos.emplace_back(std::move(commit_info));
                 }
+                // the slave replicas which pulled the rowsets are committed too
+                for (auto& [tablet_id, node_ids] : result.success_slave_tablet_node_ids()) {
+                    for (auto node_id : node_ids.slave_node_ids()) {
+                        TTabletCommitInfo commit_info;
+                        commit_info.tabletId = tablet_id;
+                        commit_info.backendId = node_id;
+                        _tablet_commit_infos.emplace_back(std::move(commit_info));
+                    }
+                }
                 _add_batches_finished = true;
             }
         } else {
@@ -137,7 +154,7 @@ Status VNodeChannel::open_wait() {
             _add_batch_counter.add_batch_num++;
         }
     });
-    return status;
+    return closure;
 }
 
 Status VNodeChannel::add_row(const BlockRow& block_row, int64_t tablet_id) {
@@ -192,46 +209,59 @@ int VNodeChannel::try_send_and_fetch_status(RuntimeState* state,
         return 0;
     }
 
-    if (!_add_block_closure->try_set_in_flight()) {
-        return _send_finished ? 0 : 1;
-    }
+    for (auto closure : _add_block_closures) {
+        if (!closure->try_set_in_flight()) {
+            continue;
+        }
+        // The blocks are popped and numbered here, so the packets are in order even though
+        // they are sent concurrently.
+        AddBlockReq send_block;
+        {
+            debug::ScopedTSANIgnoreReadsAndWrites ignore_tsan;
+            std::lock_guard<std::mutex> l(_pending_batches_lock);
+            // the eos packet must be the last one the receiver gets
+            bool can_send = !_pending_blocks.empty() &&
+                            (!_pending_blocks.front().second.eos() ||
+                             std::none_of(_add_block_closures.begin(), _add_block_closures.end(),
+                                          [closure](auto* other) {
+                                              return other != closure &&
+                                                     other->is_packet_in_flight();
+                                          }));
+            if (!can_send) {
+                // clear in flight
+                closure->clear_in_flight();
+                break;
+            }
+            send_block = std::move(_pending_blocks.front());
+            _pending_blocks.pop();
+            _pending_batches_num--;
+            _pending_batches_bytes -= send_block.first->allocated_bytes();
+        }
+        send_block.second.set_packet_seq(_next_packet_seq++);
 
-    // We are sure that try_send_batch is not running
-    if (_pending_batches_num > 0) {
+        auto req = std::make_shared<AddBlockReq>(std::move(send_block));
         auto s = thread_pool_token->submit_func(
-                std::bind(&VNodeChannel::try_send_block, this, state));
+                [this, state, closure, req]() { try_send_block(state, closure, req); });
         if (!s.ok()) {
             _cancel_with_msg("submit send_batch task to send_batch_thread_pool failed");
             // clear in flight
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
+            break;
         }
         // in_flight is cleared in closure::Run
-    } else {
-        // clear in flight
-        _add_block_closure->clear_in_flight();
     }
     return _send_finished ? 0 : 1;
 }
 
-void VNodeChannel::try_send_block(RuntimeState* state) {
+void VNodeChannel::try_send_block(RuntimeState* state,
+                                  ReusableClosure<PTabletWriterAddBlockResult>* closure,
+                                  std::shared_ptr<AddBlockReq> send_block) {
     SCOPED_ATTACH_TASK_THREAD(state, _node_channel_tracker);
     SCOPED_ATOMIC_TIMER(&_actual_consume_ns);
-    AddBlockReq send_block;
-    {
-        debug::ScopedTSANIgnoreReadsAndWrites ignore_tsan;
-        std::lock_guard<std::mutex> l(_pending_batches_lock);
-        DCHECK(!_pending_blocks.empty());
-        send_block = std::move(_pending_blocks.front());
-        _pending_blocks.pop();
-        _pending_batches_num--;
-        _pending_batches_bytes -= send_block.first->allocated_bytes();
-    }
+    auto mutable_block = std::move(send_block->first);
+    auto& request = send_block->second;
 
-    auto mutable_block = std::move(send_block.first);
-    auto request = std::move(send_block.second); // doesn't need to be saved in heap
-
-    // tablet_ids has already set when add row
-    request.set_packet_seq(_next_packet_seq);
+    // tablet_ids and packet_seq have already set
     auto block = mutable_block->to_block();
     if (block.rows() > 0) {
         SCOPED_ATOMIC_TIMER(&_serialize_batch_ns);
@@ -240,7 +270,7 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
                                     _parent->_transfer_large_data_by_brpc);
         if (!st.ok()) {
             cancel(fmt::format("{}, err: {}", channel_info(), st.get_error_msg()));
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
             return;
         }
         if (compressed_bytes >= double(config::brpc_max_body_size) * 0.95f) {
@@ -254,26 +284,39 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
     if (UNLIKELY(remain_ms < config::min_load_rpc_timeout_ms)) {
         if (remain_ms <= 0 && !request.eos()) {
             cancel(fmt::format("{}, err: timeout", channel_info()));
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
             return;
         } else {
             remain_ms = config::min_load_rpc_timeout_ms;
         }
     }
 
-    _add_block_closure->reset();
-    _add_block_closure->cntl.set_timeout_ms(remain_ms);
+    closure->reset();
+    closure->cntl.set_timeout_ms(remain_ms);
     if (config::tablet_writer_ignore_eovercrowded) {
-        _add_block_closure->cntl.ignore_eovercrowded();
+        closure->cntl.ignore_eovercrowded();
     }
 
     if (request.eos()) {
         for (auto pid : _parent->_partition_ids) {
             request.add_partition_ids(pid);
         }
+        for (auto& [tablet_id, node_ids] : _slave_tablet_nodes) {
+            auto& slave_nodes = (*request.mutable_slave_tablet_nodes())[tablet_id];
+            for (auto node_id : node_ids) {
+                auto node = _parent->_nodes_info->find_node(node_id);
+                if (node == nullptr) {
+                    continue;
+                }
+                auto pnode = slave_nodes.add_slave_nodes();
+                pnode->set_id(node->id);
+                pnode->set_host(node->host);
+                pnode->set_async_internal_port(node->brpc_port);
+            }
+        }
 
         // eos request must be the last request
-        _add_block_closure->end_mark();
+        closure->end_mark();
         _send_finished = true;
         CHECK(_pending_batches_num == 0) << _pending_batches_num;
     }
@@ -282,29 +325,27 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
         request.block().has_column_values() && request.ByteSizeLong() > MIN_HTTP_BRPC_SIZE) {
         Status st = request_embed_attachment_contain_block<
                 PTabletWriterAddBlockRequest, ReusableClosure<PTabletWriterAddBlockResult>>(
-                &request, _add_block_closure);
+                &request, closure);
         if (!st.ok()) {
             cancel(fmt::format("{}, err: {}", channel_info(), st.get_error_msg()));
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
             return;
         }
         std::string brpc_url = fmt::format("http://{}:{}", _node_info.host, _node_info.brpc_port);
         std::shared_ptr<PBackendService_Stub> _brpc_http_stub =
                 _state->exec_env()->brpc_internal_client_cache()->get_new_client_no_cache(brpc_url,
                                                                                           "http");
-        _add_block_closure->cntl.http_request().uri() =
+        closure->cntl.http_request().uri() =
                 brpc_url + "/PInternalServiceImpl/tablet_writer_add_block_by_http";
-        _add_block_closure->cntl.http_request().set_method(brpc::HTTP_METHOD_POST);
-        _add_block_closure->cntl.http_request().set_content_type("application/json");
+        closure->cntl.http_request().set_method(brpc::HTTP_METHOD_POST);
+        closure->cntl.http_request().set_content_type("application/json");
         _brpc_http_stub->tablet_writer_add_block_by_http(
-                &_add_block_closure->cntl, NULL, &_add_block_closure->result, _add_block_closure);
+                &closure->cntl, NULL, &closure->result, closure);
     } else {
-        _add_block_closure->cntl.http_request().Clear();
-        _stub->tablet_writer_add_block(&_add_block_closure->cntl, &request,
-                                       &_add_block_closure->result, _add_block_closure);
+        closure->cntl.http_request().Clear();
+        _stub->tablet_writer_add_block(&closure->cntl, &request,
+                                       &closure->result, closure);
     }
-
-    _next_packet_seq++;
 }
 
 void VNodeChannel::_close_check() {
@@ -426,14 +467,19 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block)
     if (findTabletMode == FindTabletMode::FIND_TABLET_EVERY_BATCH) {
         _partition_to_tablet_map.clear();
     }
+    // route the rows column-wise, the per row lookups compare the partition keys row by row
+    _vpartition->find_partitions(&block, &_row_partitions);
+    if (findTabletMode == FindTabletMode::FIND_TABLET_EVERY_ROW) {
+        _vpartition->find_tablets(&block, _row_partitions, &_row_tablet_indexes);
+    }
     for (int i = 0; i < num_rows; ++i) {
         if (filtered_rows > 0 && _filter_bitmap.Get(i)) {
             continue;
         }
-        const VOlapTablePartition* partition = nullptr;
+        const VOlapTablePartition* partition = _row_partitions[i];
         uint32_t tablet_index = 0;
         block_row = {&block, i};
-        if (!_vpartition->find_partition(&block_row, &partition)) {
+        if (partition == nullptr) {
             RETURN_IF_ERROR(state->append_error_msg_to_file(
                     []() -> std::string { return ""; },
                     [&]() -> std::string {
@@ -457,7 +503,7 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block)
                 tablet_index = _partition_to_tablet_map[partition->id];
             }
         } else {
-            tablet_index = _vpartition->find_tablet(&block_row, *partition);
+            tablet_index = _row_tablet_indexes[i];
         }
         for (int j = 0; j < partition->indexes.size(); ++j) {
             int64_t tablet_id = partition->indexes[j].tablets[tablet_index];
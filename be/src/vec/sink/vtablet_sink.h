@@ -43,8 +43,6 @@ public:
     int try_send_and_fetch_status(RuntimeState* state,
                                   std::unique_ptr<ThreadPoolToken>& thread_pool_token) override;
 
-    void try_send_block(RuntimeState* state);
-
     void clear_all_blocks() override;
 
     // two ways to stop channel:
@@ -56,13 +54,21 @@ protected:
     void _close_check() override;
 
 private:
+    using AddBlockReq =
+            std::pair<std::unique_ptr<vectorized::MutableBlock>, PTabletWriterAddBlockRequest>;
+
+    ReusableClosure<PTabletWriterAddBlockResult>* _create_add_block_closure();
+
+    void try_send_block(RuntimeState* state, ReusableClosure<PTabletWriterAddBlockResult>* closure,
+                        std::shared_ptr<AddBlockReq> send_block);
+
     std::unique_ptr<vectorized::MutableBlock> _cur_mutable_block;
     PTabletWriterAddBlockRequest _cur_add_block_request;
 
-    using AddBlockReq =
-            std::pair<std::unique_ptr<vectorized::MutableBlock>, PTabletWriterAddBlockRequest>;
     std::queue<AddBlockReq> _pending_blocks;
-    ReusableClosure<PTabletWriterAddBlockResult>* _add_block_closure = nullptr;
+    // Each closure carries one add block rpc, at most `tablet_writer_max_inflight_rpcs` rpcs
+    // are in flight, and the eos one is sent after all the others are done.
+    std::vector<ReusableClosure<PTabletWriterAddBlockResult>*> _add_block_closures;
 };
 
 class OlapTableSink;
@@ -103,6 +109,9 @@ private:
 
     VOlapTablePartitionParam* _vpartition = nullptr;
     std::vector<vectorized::VExprContext*> _output_vexpr_ctxs;
+    // the partitions and tablet indexes of the rows of the block being sent
+    std::vector<const VOlapTablePartition*> _row_partitions;
+    std::vector<uint32_t> _row_tablet_indexes;
 };
 
 } // namespace stream_load
@@ -179,4 +179,34 @@ TEST_F(BufferedReaderTest, test_miss) {
     EXPECT_EQ(45, bytes_read);
 }
 
+TEST_F(BufferedReaderTest, test_read_ahead) {
+    RuntimeProfile profile("test");
+    // buffered_reader_test_file.txt 45 bytes
+    auto file_reader = new LocalFileReader(
+            "./be/test/exec/test_data/buffered_reader/buffered_reader_test_file.txt", 0);
+    // the buffers after the first one are read ahead
+    BufferedReader reader(&profile, file_reader, 8);
+    auto st = reader.open();
+    EXPECT_TRUE(st.ok());
+    uint8_t buf[3];
+    bool eof = false;
+    int64_t read_length = 0;
+    std::string content;
+    while (true) {
+        st = reader.read(buf, 3, &read_length, &eof);
+        EXPECT_TRUE(st.ok());
+        if (eof) {
+            break;
+        }
+        content.append((char*)buf, read_length);
+    }
+    EXPECT_EQ("bdfhjlnprtvxzAbCdEfGhIj\n\nMnOpQrStUvWxYz\nIjKl\n", content);
+
+    // a random read misses the buffer read ahead
+    uint8_t random_buf[10];
+    st = reader.readat(4, 10, &read_length, random_buf);
+    EXPECT_TRUE(st.ok());
+    EXPECT_EQ("jlnprtvxzA", std::string((char*)random_buf, read_length));
+}
+
 } // end namespace doris
@@ -244,4 +244,37 @@ TEST_F(MockESServerTest, workflow) {
     auto cst = reader.close();
     EXPECT_TRUE(cst.ok());
 }
+
+TEST(ESScrollQueryBuilderTest, sliced_scroll) {
+    std::vector<std::string> fields = {"id", "value"};
+    std::map<std::string, std::string> props;
+    props[ESScanReader::KEY_BATCH_SIZE] = "100";
+    props[ESScanReader::KEY_SLICE_ID] = "1";
+    props[ESScanReader::KEY_SLICE_MAX] = "4";
+    std::vector<EsPredicate*> predicates;
+    std::map<std::string, std::string> docvalue_context;
+    bool doc_value_mode = false;
+    rapidjson::Document dsl;
+    dsl.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context,
+                                          &doc_value_mode)
+                      .c_str());
+    EXPECT_TRUE(dsl.HasMember("slice"));
+    EXPECT_EQ(1, dsl["slice"]["id"].GetInt());
+    EXPECT_EQ(4, dsl["slice"]["max"].GetInt());
+
+    // the search with terminate_after is not a scroll
+    props[ESScanReader::KEY_TERMINATE_AFTER] = "10";
+    dsl.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context,
+                                          &doc_value_mode)
+                      .c_str());
+    EXPECT_FALSE(dsl.HasMember("slice"));
+
+    // one slice is the whole shard
+    props.erase(ESScanReader::KEY_TERMINATE_AFTER);
+    props[ESScanReader::KEY_SLICE_MAX] = "1";
+    dsl.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context,
+                                          &doc_value_mode)
+                      .c_str());
+    EXPECT_FALSE(dsl.HasMember("slice"));
+}
 } // namespace doris
@@ -0,0 +1,163 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/file_statistics_filter.h"
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+
+namespace doris {
+
+using vectorized::Field;
+using vectorized::Int64;
+
+class FileStatisticsFilterTest : public testing::Test {
+public:
+    void SetUp() override {
+        // k1 int, k2 varchar, path column k3 int
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").column_pos(0).build());
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().string_type(20).column_name("k2").column_pos(1).build());
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("k3").column_pos(2).build());
+        tuple_builder.build(&dtb);
+
+        DescriptorTbl* desc_tbl = nullptr;
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, dtb.desc_tbl(), &desc_tbl).ok());
+        _slot_descs = desc_tbl->get_tuple_descriptor(0)->slots();
+    }
+
+protected:
+    static TExprNode slot_ref(SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.num_children = 0;
+        node.__set_slot_ref(TSlotRef());
+        node.slot_ref.slot_id = slot_id;
+        return node;
+    }
+
+    static TExprNode int_literal(int64_t value) {
+        TExprNode node;
+        node.node_type = TExprNodeType::INT_LITERAL;
+        node.num_children = 0;
+        node.__set_int_literal(TIntLiteral());
+        node.int_literal.value = value;
+        return node;
+    }
+
+    static TExprNode string_literal(const std::string& value) {
+        TExprNode node;
+        node.node_type = TExprNodeType::STRING_LITERAL;
+        node.num_children = 0;
+        node.__set_string_literal(TStringLiteral());
+        node.string_literal.value = value;
+        return node;
+    }
+
+    static TExprNode predicate(TExprNodeType::type node_type, TExprOpcode::type op,
+                               int num_children) {
+        TExprNode node;
+        node.node_type = node_type;
+        node.__set_opcode(op);
+        node.num_children = num_children;
+        return node;
+    }
+
+    ObjectPool _pool;
+    std::vector<SlotDescriptor*> _slot_descs;
+};
+
+TEST_F(FileStatisticsFilterTest, collect) {
+    // k1 > 10 and 'b' >= k2 and k2 in ('x', 'y') and k3 = 1 and k1 = 'a'
+    TExpr texpr;
+    texpr.nodes.push_back(
+            predicate(TExprNodeType::COMPOUND_PRED, TExprOpcode::COMPOUND_AND, 2));
+    texpr.nodes.push_back(
+            predicate(TExprNodeType::COMPOUND_PRED, TExprOpcode::COMPOUND_AND, 2));
+    texpr.nodes.push_back(predicate(TExprNodeType::BINARY_PRED, TExprOpcode::GT, 2));
+    texpr.nodes.push_back(slot_ref(_slot_descs[0]->id()));
+    texpr.nodes.push_back(int_literal(10));
+    texpr.nodes.push_back(predicate(TExprNodeType::BINARY_PRED, TExprOpcode::GE, 2));
+    texpr.nodes.push_back(string_literal("b"));
+    texpr.nodes.push_back(slot_ref(_slot_descs[1]->id()));
+    texpr.nodes.push_back(
+            predicate(TExprNodeType::COMPOUND_PRED, TExprOpcode::COMPOUND_AND, 2));
+    texpr.nodes.push_back(predicate(TExprNodeType::IN_PRED, TExprOpcode::FILTER_IN, 3));
+    texpr.nodes.push_back(slot_ref(_slot_descs[1]->id()));
+    texpr.nodes.push_back(string_literal("x"));
+    texpr.nodes.push_back(string_literal("y"));
+    texpr.nodes.push_back(
+            predicate(TExprNodeType::COMPOUND_PRED, TExprOpcode::COMPOUND_AND, 2));
+    texpr.nodes.push_back(predicate(TExprNodeType::BINARY_PRED, TExprOpcode::EQ, 2));
+    texpr.nodes.push_back(slot_ref(_slot_descs[2]->id()));
+    texpr.nodes.push_back(int_literal(1));
+    texpr.nodes.push_back(predicate(TExprNodeType::BINARY_PRED, TExprOpcode::EQ, 2));
+    texpr.nodes.push_back(slot_ref(_slot_descs[0]->id()));
+    texpr.nodes.push_back(string_literal("a"));
+
+    FileStatisticsFilter filter;
+    filter.init({texpr}, _slot_descs, 2);
+    // the path column and the mismatched literal are ignored
+    const auto& predicates = filter.predicates();
+    ASSERT_EQ(3, predicates.size());
+    EXPECT_EQ(0, predicates[0].position);
+    EXPECT_EQ(TExprOpcode::GT, predicates[0].op);
+    EXPECT_EQ(Field(Int64(10)), predicates[0].values[0]);
+    EXPECT_EQ(1, predicates[1].position);
+    EXPECT_EQ(TExprOpcode::LE, predicates[1].op);
+    EXPECT_EQ(Field("b", 1), predicates[1].values[0]);
+    EXPECT_EQ(1, predicates[2].position);
+    EXPECT_EQ(TExprOpcode::EQ, predicates[2].op);
+    EXPECT_EQ(2, predicates[2].values.size());
+    EXPECT_EQ(TYPE_VARCHAR, filter.slot_type(1));
+}
+
+TEST_F(FileStatisticsFilterTest, can_skip) {
+    auto check = [](TExprOpcode::type op, std::vector<Field> values, int64_t min, int64_t max) {
+        FileStatisticsFilter::Predicate predicate {0, op, std::move(values)};
+        return FileStatisticsFilter::can_skip(predicate, Field(Int64(min)), Field(Int64(max)));
+    };
+    EXPECT_TRUE(check(TExprOpcode::EQ, {Field(Int64(5))}, 10, 20));
+    EXPECT_FALSE(check(TExprOpcode::EQ, {Field(Int64(5)), Field(Int64(15))}, 10, 20));
+    EXPECT_TRUE(check(TExprOpcode::LT, {Field(Int64(10))}, 10, 20));
+    EXPECT_FALSE(check(TExprOpcode::LE, {Field(Int64(10))}, 10, 20));
+    EXPECT_TRUE(check(TExprOpcode::GT, {Field(Int64(20))}, 10, 20));
+    EXPECT_FALSE(check(TExprOpcode::GE, {Field(Int64(20))}, 10, 20));
+}
+
+TEST_F(FileStatisticsFilterTest, date) {
+    int64_t days = 0;
+    ASSERT_TRUE(FileStatisticsFilter::date_string_to_days("2026-10-01", &days));
+    EXPECT_EQ(20727, days);
+    EXPECT_FALSE(FileStatisticsFilter::date_string_to_days("2026-02-30", &days));
+    EXPECT_FALSE(FileStatisticsFilter::date_string_to_days("2026-1-01", &days));
+
+    Field min;
+    Field max;
+    FileStatisticsFilter::date_range_to_strings(20727, 20728, &min, &max);
+    EXPECT_EQ(Field("2026-09-30", 10), min);
+    EXPECT_EQ(Field("2026-10-03", 10), max);
+}
+
+} // namespace doris
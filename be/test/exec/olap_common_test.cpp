@@ -745,4 +745,40 @@ TEST_F(OlapScanKeysTest, ToOlapFilterTest) {
     EXPECT_EQ(std::next(filters.begin(), 0)->condition_values[1], "40");
 }
 
+TEST(LikePrefixRangeTest, NormalCase) {
+    std::string lower;
+    std::string upper;
+    auto get_range = [&](const std::string& pattern) {
+        return get_like_prefix_range(pattern.data(), pattern.size(), &lower, &upper);
+    };
+    EXPECT_TRUE(get_range("abc%"));
+    EXPECT_EQ("abc", lower);
+    EXPECT_EQ("abd", upper);
+
+    EXPECT_TRUE(get_range("ab_d%"));
+    EXPECT_EQ("ab", lower);
+    EXPECT_EQ("ac", upper);
+
+    EXPECT_TRUE(get_range("abc"));
+    EXPECT_EQ("abc", lower);
+    EXPECT_EQ("abd", upper);
+
+    EXPECT_TRUE(get_range("a\\%b%"));
+    EXPECT_EQ("a", lower);
+    EXPECT_EQ("b", upper);
+
+    EXPECT_TRUE(get_range("a\xff\xff%"));
+    EXPECT_EQ("a\xff\xff", lower);
+    EXPECT_EQ("b", upper);
+
+    // no upper bound
+    EXPECT_TRUE(get_range("\xff%"));
+    EXPECT_EQ("\xff", lower);
+    EXPECT_EQ("", upper);
+
+    EXPECT_FALSE(get_range("%abc"));
+    EXPECT_FALSE(get_range("_abc"));
+    EXPECT_FALSE(get_range(""));
+}
+
 } // namespace doris
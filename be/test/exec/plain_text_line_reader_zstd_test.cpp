@@ -0,0 +1,133 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include "exec/decompressor.h"
+#include "exec/pipelined_decompress_reader.h"
+#include "exec/plain_text_line_reader.h"
+#include "io/local_file_reader.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+class PlainTextLineReaderZstdTest : public testing::Test {
+public:
+    PlainTextLineReaderZstdTest() : _profile("TestProfile") {}
+
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+
+    void check_test_file(PlainTextLineReader* line_reader) {
+        const uint8_t* ptr;
+        size_t size;
+        bool eof;
+
+        // 1,2
+        auto st = line_reader->read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ("1,2", std::string((const char*)ptr, size));
+        EXPECT_FALSE(eof);
+
+        // Empty
+        st = line_reader->read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ(0, size);
+        EXPECT_FALSE(eof);
+
+        // 1,2,3,4
+        st = line_reader->read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ("1,2,3,4", std::string((const char*)ptr, size));
+        EXPECT_FALSE(eof);
+
+        // Empty
+        st = line_reader->read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_FALSE(eof);
+
+        // Empty
+        st = line_reader->read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_FALSE(eof);
+
+        // Eof
+        st = line_reader->read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_TRUE(eof);
+    }
+
+private:
+    RuntimeProfile _profile;
+};
+
+TEST_F(PlainTextLineReaderZstdTest, zstd_normal_use) {
+    LocalFileReader file_reader("./be/test/exec/test_data/plain_text_line_reader/test_file.csv.zst",
+                                0);
+    auto st = file_reader.open();
+    EXPECT_TRUE(st.ok());
+
+    Decompressor* decompressor;
+    st = Decompressor::create_decompressor(CompressType::ZSTD, &decompressor);
+    EXPECT_TRUE(st.ok());
+
+    PlainTextLineReader line_reader(&_profile, &file_reader, decompressor, -1, "\n", 1);
+    check_test_file(&line_reader);
+    delete decompressor;
+}
+
+TEST_F(PlainTextLineReaderZstdTest, pipelined_decompress) {
+    for (auto type : {CompressType::ZSTD, CompressType::GZIP}) {
+        std::string path = type == CompressType::ZSTD ? "test_file.csv.zst" : "test_file.csv.gz";
+        auto file_reader = std::make_shared<LocalFileReader>(
+                "./be/test/exec/test_data/plain_text_line_reader/" + path, 0);
+        auto st = file_reader->open();
+        EXPECT_TRUE(st.ok());
+
+        Decompressor* decompressor;
+        st = Decompressor::create_decompressor(type, &decompressor);
+        EXPECT_TRUE(st.ok());
+
+        PipelinedDecompressReader reader(file_reader, decompressor, 1);
+        st = reader.open();
+        EXPECT_TRUE(st.ok());
+        PlainTextLineReader line_reader(&_profile, &reader, nullptr, -1, "\n", 1);
+        check_test_file(&line_reader);
+    }
+}
+
+TEST_F(PlainTextLineReaderZstdTest, pipelined_decompress_error) {
+    // the error of decompressing an uncompressed file is returned to the consumer
+    auto file_reader = std::make_shared<LocalFileReader>(
+            "./be/test/exec/test_data/plain_text_line_reader/test_file.csv", 0);
+    auto st = file_reader->open();
+    EXPECT_TRUE(st.ok());
+
+    Decompressor* decompressor;
+    st = Decompressor::create_decompressor(CompressType::ZSTD, &decompressor);
+    EXPECT_TRUE(st.ok());
+
+    PipelinedDecompressReader reader(file_reader, decompressor, 1);
+    st = reader.open();
+    EXPECT_TRUE(st.ok());
+    ByteBufferPtr buf;
+    st = reader.read_buffer(&buf);
+    EXPECT_FALSE(st.ok());
+}
+
+} // namespace doris
@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <optional>
+
 #include "runtime/descriptor_helper.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/row_batch.h"
@@ -800,6 +802,129 @@ TEST_F(OlapTablePartitionParamTest, bad_index) {
     }
 }
 
+static TExprNode int_literal(const TTypeDesc& type, int64_t value) {
+    TExprNode node;
+    node.node_type = TExprNodeType::INT_LITERAL;
+    node.type = type;
+    node.num_children = 0;
+    node.__isset.int_literal = true;
+    node.int_literal.value = value;
+    return node;
+}
+
+static void add_partition(TOlapTablePartitionParam* t_param, int64_t id, int num_buckets) {
+    auto& t_part = t_param->partitions.emplace_back();
+    t_part.id = id;
+    t_part.num_buckets = num_buckets;
+    t_part.indexes.resize(2);
+    for (int i = 0; i < 2; ++i) {
+        t_part.indexes[i].index_id = 4 + i;
+        for (int j = 0; j < num_buckets; ++j) {
+            t_part.indexes[i].tablets.push_back(id * 100 + i * 10 + j);
+        }
+    }
+}
+
+// the column-wise routing must be the same as the per row one
+static void check_find_partitions(const std::shared_ptr<OlapTableSchemaParam>& schema,
+                                  const VOlapTablePartitionParam& part,
+                                  const std::vector<std::optional<int64_t>>& c2_values,
+                                  const std::vector<int64_t>& expected_ids) {
+    vectorized::Block block;
+    for (auto slot : schema->tuple_desc()->slots()) {
+        auto column = slot->get_empty_mutable_column();
+        for (int i = 0; i < c2_values.size(); ++i) {
+            int32_t c1 = i * 7;
+            std::string c3 = "abc" + std::to_string(i);
+            if (slot->col_name() == "c1") {
+                column->insert_data(reinterpret_cast<const char*>(&c1), 0);
+            } else if (slot->col_name() == "c2") {
+                if (c2_values[i].has_value()) {
+                    column->insert_data(reinterpret_cast<const char*>(&c2_values[i].value()), 0);
+                } else {
+                    column->insert_data(nullptr, 0);
+                }
+            } else {
+                column->insert_data(c3.data(), c3.size());
+            }
+        }
+        block.insert({std::move(column), slot->get_data_type_ptr(), slot->col_name()});
+    }
+
+    std::vector<const VOlapTablePartition*> partitions;
+    std::vector<uint32_t> tablet_indexes;
+    part.find_partitions(&block, &partitions);
+    part.find_tablets(&block, partitions, &tablet_indexes);
+    ASSERT_EQ(c2_values.size(), partitions.size());
+    ASSERT_EQ(c2_values.size(), tablet_indexes.size());
+    for (int i = 0; i < c2_values.size(); ++i) {
+        BlockRow block_row(&block, i);
+        const VOlapTablePartition* expected = nullptr;
+        part.find_partition(&block_row, &expected);
+        EXPECT_EQ(expected, partitions[i]);
+        EXPECT_EQ(expected_ids[i], partitions[i] == nullptr ? -1 : partitions[i]->id);
+        if (expected != nullptr) {
+            EXPECT_EQ(part.find_tablet(&block_row, *expected), tablet_indexes[i]);
+        }
+    }
+}
+
+TEST_F(OlapTablePartitionParamTest, vec_find_partitions_range) {
+    TDescriptorTable t_desc_tbl;
+    auto t_schema = get_schema(&t_desc_tbl);
+    std::shared_ptr<OlapTableSchemaParam> schema(new OlapTableSchemaParam());
+    EXPECT_TRUE(schema->init(t_schema).ok());
+    const auto& type = t_desc_tbl.slotDescriptors[1].slotType;
+
+    // (-oo, 10) | [10, 50) | [60, +oo)
+    TOlapTablePartitionParam t_partition_param;
+    t_partition_param.db_id = 1;
+    t_partition_param.table_id = 2;
+    t_partition_param.version = 0;
+    t_partition_param.__set_partition_columns({"c2"});
+    t_partition_param.__set_distributed_columns({"c1", "c3"});
+    add_partition(&t_partition_param, 10, 1);
+    t_partition_param.partitions[0].__set_end_keys({int_literal(type, 10)});
+    add_partition(&t_partition_param, 11, 2);
+    t_partition_param.partitions[1].__set_start_keys({int_literal(type, 10)});
+    t_partition_param.partitions[1].__set_end_keys({int_literal(type, 50)});
+    add_partition(&t_partition_param, 12, 4);
+    t_partition_param.partitions[2].__set_start_keys({int_literal(type, 60)});
+
+    VOlapTablePartitionParam part(schema, t_partition_param);
+    EXPECT_TRUE(part.init().ok());
+    check_find_partitions(schema, part, {-100, 9, 10, 49, 50, 55, 60, 1000, std::nullopt},
+                          {10, 10, 11, 11, -1, -1, 12, 12, 10});
+}
+
+TEST_F(OlapTablePartitionParamTest, vec_find_partitions_list) {
+    TDescriptorTable t_desc_tbl;
+    auto t_schema = get_schema(&t_desc_tbl);
+    std::shared_ptr<OlapTableSchemaParam> schema(new OlapTableSchemaParam());
+    EXPECT_TRUE(schema->init(t_schema).ok());
+    const auto& type = t_desc_tbl.slotDescriptors[1].slotType;
+
+    // (1, 2) | (3) | (4, 5, 6)
+    TOlapTablePartitionParam t_partition_param;
+    t_partition_param.db_id = 1;
+    t_partition_param.table_id = 2;
+    t_partition_param.version = 0;
+    t_partition_param.__set_partition_columns({"c2"});
+    t_partition_param.__set_distributed_columns({"c1", "c3"});
+    add_partition(&t_partition_param, 10, 1);
+    t_partition_param.partitions[0].__set_in_keys(
+            {{int_literal(type, 1)}, {int_literal(type, 2)}});
+    add_partition(&t_partition_param, 11, 2);
+    t_partition_param.partitions[1].__set_in_keys({{int_literal(type, 3)}});
+    add_partition(&t_partition_param, 12, 4);
+    t_partition_param.partitions[2].__set_in_keys(
+            {{int_literal(type, 4)}, {int_literal(type, 5)}, {int_literal(type, 6)}});
+
+    VOlapTablePartitionParam part(schema, t_partition_param);
+    EXPECT_TRUE(part.init().ok());
+    check_find_partitions(schema, part, {0, 1, 2, 3, 4, 5, 6, 7}, {-1, 10, 10, 11, 12, 12, 12, -1});
+}
+
 TEST_F(OlapTablePartitionParamTest, tableLoacation) {
     TOlapTableLocationParam tparam;
     tparam.tablets.resize(1);
@@ -0,0 +1 @@
+dorisab
\ No newline at end of file
@@ -16,6 +16,7 @@
 // under the License.
 
 #include <string>
+#include <vector>
 
 #include "exprs/bloomfilter_predicate.h"
 #include "exprs/create_predicate_function.h"
@@ -109,4 +110,59 @@ TEST_F(BloomFilterPredicateTest, bloom_filter_size_test) {
     EXPECT_EQ(length, len);
 }
 
+TEST_F(BloomFilterPredicateTest, bloom_filter_selectivity_test) {
+    std::unique_ptr<IBloomFilterFuncBase> func(create_bloom_filter(PrimitiveType::TYPE_INT));
+    func->init_with_fixed_length(4096);
+    // 10% filtered, but not enough rows sampled yet
+    func->update_selectivity(500, 450, 1000, 0.5);
+    EXPECT_TRUE(func->is_sampling());
+    EXPECT_TRUE(func->is_effective());
+    func->update_selectivity(500, 450, 1000, 0.5);
+    EXPECT_FALSE(func->is_sampling());
+    EXPECT_FALSE(func->is_effective());
+    EXPECT_EQ(1000U, func->sampled_rows());
+    EXPECT_EQ(900U, func->sampled_passed_rows());
+    // the decision is made once
+    func->update_selectivity(10000, 0, 1000, 0.5);
+    EXPECT_FALSE(func->is_effective());
+    EXPECT_EQ(1000U, func->sampled_rows());
+
+    std::unique_ptr<IBloomFilterFuncBase> func2(create_bloom_filter(PrimitiveType::TYPE_INT));
+    func2->init_with_fixed_length(4096);
+    func2->update_selectivity(1024, 100, 1000, 0.5);
+    EXPECT_FALSE(func2->is_sampling());
+    EXPECT_TRUE(func2->is_effective());
+}
+
+TEST_F(BloomFilterPredicateTest, bloom_filter_find_batch_test) {
+    BloomFilterFunc<TYPE_INT, CurrentBloomFilterAdaptor> func;
+    EXPECT_TRUE(func.init_with_fixed_length(4096).ok());
+    const int data_size = 1000;
+    int data[data_size];
+    std::vector<uint16_t> sel(data_size);
+    for (int i = 0; i < data_size; i++) {
+        data[i] = i;
+        sel[i] = data_size - 1 - i;
+        if (i % 2 == 0) {
+            func.insert((const void*)&data[i]);
+        }
+    }
+    std::vector<uint8_t> results(data_size);
+    func.find_olap_engine_batch(data, sel.data(), data_size, results.data());
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_EQ(func.find_olap_engine((const void*)&data[sel[i]]), results[i]);
+        if (sel[i] % 2 == 0) {
+            EXPECT_EQ(1, results[i]);
+        }
+    }
+
+    // an empty filter finds nothing
+    BloomFilterFunc<TYPE_INT, CurrentBloomFilterAdaptor> empty_func;
+    EXPECT_TRUE(empty_func.init_with_fixed_length(4096).ok());
+    empty_func.find_olap_engine_batch(data, sel.data(), data_size, results.data());
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_EQ(0, results[i]);
+    }
+}
+
 } // namespace doris
@@ -17,12 +17,17 @@
 
 #include "exprs/runtime_filter.h"
 
+#include <butil/iobuf.h>
+
 #include <array>
+#include <limits>
 #include <memory>
 
+#include "common/config.h"
 #include "exprs/expr_context.h"
 #include "exprs/slot_ref.h"
 #include "gen_cpp/Planner_types.h"
+#include "gen_cpp/internal_service.pb.h"
 #include "gen_cpp/Types_types.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -529,4 +534,88 @@ TEST_F(RuntimeFilterTest, runtime_filter_in_or_bloom_filter_bloom_filter_merge_b
     }
 }
 
+TEST_F(RuntimeFilterTest, runtime_filter_bloom_filter_size_for_ndv_test) {
+    EXPECT_EQ(config::runtime_bloom_filter_min_size_bytes,
+              IRuntimeFilter::bloom_filter_size_for_ndv(0));
+    EXPECT_EQ(config::runtime_bloom_filter_max_size_bytes,
+              IRuntimeFilter::bloom_filter_size_for_ndv(std::numeric_limits<int64_t>::max()));
+    int64_t size = IRuntimeFilter::bloom_filter_size_for_ndv(1000000);
+    EXPECT_EQ(0, size & (size - 1));
+    EXPECT_LT(IRuntimeFilter::bloom_filter_size_for_ndv(100000), size);
+    EXPECT_GE(size * 8, 1000000 * 6);
+}
+
+TEST_F(RuntimeFilterTest, runtime_filter_resize_bloom_filter_test) {
+    SlotRef* expr = _obj_pool.add(new SlotRef(TYPE_INT, 0));
+    ExprContext* prob_expr_ctx = _obj_pool.add(new ExprContext(expr));
+    ExprContext* build_expr_ctx = _obj_pool.add(new ExprContext(expr));
+
+    TQueryOptions options;
+    IRuntimeFilter* runtime_filter = create_runtime_filter(TRuntimeFilterType::BLOOM, &options,
+                                                           _runtime_stat.get(), &_obj_pool);
+    EXPECT_TRUE(runtime_filter->resize_bloom_filter(1000000).ok());
+
+    auto rows1 = create_rows(&_obj_pool, 1, 3);
+    insert(runtime_filter, build_expr_ctx, rows1);
+
+    std::list<ExprContext*> expr_context_list;
+    EXPECT_TRUE(runtime_filter->get_push_expr_ctxs(&expr_context_list, prob_expr_ctx).ok());
+    EXPECT_FALSE(expr_context_list.empty());
+    for (TupleRow& row : *rows1) {
+        for (ExprContext* ctx : expr_context_list) {
+            EXPECT_TRUE(ctx->get_boolean_val(&row).val);
+        }
+    }
+}
+
+TEST_F(RuntimeFilterTest, runtime_filter_compressed_bloom_filter_test) {
+    SlotRef* expr = _obj_pool.add(new SlotRef(TYPE_INT, 0));
+    ExprContext* prob_expr_ctx = _obj_pool.add(new ExprContext(expr));
+    ExprContext* build_expr_ctx = _obj_pool.add(new ExprContext(expr));
+
+    TQueryOptions options;
+    IRuntimeFilter* runtime_filter = create_runtime_filter(TRuntimeFilterType::BLOOM, &options,
+                                                           _runtime_stat.get(), &_obj_pool);
+    auto rows1 = create_rows(&_obj_pool, 1, 3);
+    insert(runtime_filter, build_expr_ctx, rows1);
+
+    PMergeFilterRequest request;
+    void* data = nullptr;
+    int len = 0;
+    EXPECT_TRUE(runtime_filter->serialize(&request, &data, &len).ok());
+    EXPECT_EQ(4096, len);
+
+    int64_t origin_min_bytes = config::runtime_filter_compression_min_bytes;
+    config::runtime_filter_compression_min_bytes = 1024;
+    butil::IOBuf attachment;
+    IRuntimeFilter::append_bloom_filter_to_attachment(request.mutable_bloom_filter(), data, len,
+                                                      &attachment);
+    config::runtime_filter_compression_min_bytes = origin_min_bytes;
+    // the filter of 3 values is sparse
+    EXPECT_EQ(segment_v2::CompressionTypePB::LZ4, request.bloom_filter().compression_type());
+    EXPECT_EQ(static_cast<size_t>(request.bloom_filter().compressed_length()), attachment.size());
+    EXPECT_LT(attachment.size(), 4096U);
+    EXPECT_EQ(4096, request.bloom_filter().filter_length());
+
+    std::string buf = attachment.to_string();
+    MergeRuntimeFilterParams params;
+    params.request = &request;
+    params.data = buf.data();
+    RuntimeFilterWrapperHolder holder;
+    EXPECT_TRUE(IRuntimeFilter::create_wrapper(&params, &_obj_pool, holder.getHandle()).ok());
+
+    IRuntimeFilter* merged_filter = create_runtime_filter(TRuntimeFilterType::BLOOM, &options,
+                                                          _runtime_stat.get(), &_obj_pool);
+    EXPECT_TRUE(merged_filter->merge_from(holder.getHandle()->get()).ok());
+
+    std::list<ExprContext*> expr_context_list;
+    EXPECT_TRUE(merged_filter->get_push_expr_ctxs(&expr_context_list, prob_expr_ctx).ok());
+    EXPECT_FALSE(expr_context_list.empty());
+    for (TupleRow& row : *rows1) {
+        for (ExprContext* ctx : expr_context_list) {
+            EXPECT_TRUE(ctx->get_boolean_val(&row).val);
+        }
+    }
+}
+
 } // namespace doris
@@ -68,7 +68,15 @@ public:
     }
 };
 
+static const std::string s_file_path = "./.http_client_test_file.dat";
+
+class HttpClientTestFileHandler : public HttpHandler {
+public:
+    void handle(HttpRequest* req) override { do_file_response(s_file_path, req); }
+};
+
 static HttpClientTestSimpleGetHandler s_simple_get_handler = HttpClientTestSimpleGetHandler();
+static HttpClientTestFileHandler s_file_handler = HttpClientTestFileHandler();
 static HttpClientTestSimplePostHandler s_simple_post_handler = HttpClientTestSimplePostHandler();
 static EvHttpServer* s_server = nullptr;
 static int real_port = 0;
@@ -84,13 +92,20 @@ public:
         s_server->register_handler(GET, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(HEAD, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(POST, "/simple_post", &s_simple_post_handler);
+        s_server->register_handler(GET, "/simple_file", &s_file_handler);
+        auto fp = fopen(s_file_path.c_str(), "w");
+        fwrite("0123456789", 1, 10, fp);
+        fclose(fp);
         s_server->start();
         real_port = s_server->get_real_port();
         EXPECT_NE(0, real_port);
         hostname = "http://127.0.0.1:" + std::to_string(real_port);
     }
 
-    static void TearDownTestCase() { delete s_server; }
+    static void TearDownTestCase() {
+        delete s_server;
+        unlink(s_file_path.c_str());
+    }
 };
 
 TEST_F(HttpClientTest, get_normal) {
@@ -133,6 +148,26 @@ TEST_F(HttpClientTest, download) {
     unlink(local_file.c_str());
 }
 
+TEST_F(HttpClientTest, download_resume) {
+    std::string local_file = ".http_client_test_resume.dat";
+    auto fp = fopen(local_file.c_str(), "w");
+    fwrite("0123", 1, 4, fp);
+    fclose(fp);
+
+    HttpClient client;
+    auto st = client.init(hostname + "/simple_file");
+    EXPECT_TRUE(st.ok());
+    st = client.download(local_file, true);
+    EXPECT_TRUE(st.ok());
+    char buf[50];
+    fp = fopen(local_file.c_str(), "r");
+    auto size = fread(buf, 1, 50, fp);
+    fclose(fp);
+    buf[size] = 0;
+    EXPECT_STREQ("0123456789", buf);
+    unlink(local_file.c_str());
+}
+
 TEST_F(HttpClientTest, get_failed) {
     HttpClient client;
     auto st = client.init(hostname + "/simple_get");
@@ -89,4 +89,29 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, parse_range_header) {
+    int64_t offset = 0;
+    int64_t length = 0;
+    EXPECT_TRUE(parse_range_header("bytes=0-99", 1000, &offset, &length));
+    EXPECT_EQ(0, offset);
+    EXPECT_EQ(100, length);
+    EXPECT_TRUE(parse_range_header("bytes=100-", 1000, &offset, &length));
+    EXPECT_EQ(100, offset);
+    EXPECT_EQ(900, length);
+    EXPECT_TRUE(parse_range_header("bytes=-100", 1000, &offset, &length));
+    EXPECT_EQ(900, offset);
+    EXPECT_EQ(100, length);
+    // the end is truncated to the file size
+    EXPECT_TRUE(parse_range_header("bytes=900-2000", 1000, &offset, &length));
+    EXPECT_EQ(900, offset);
+    EXPECT_EQ(100, length);
+
+    EXPECT_FALSE(parse_range_header("bytes=1000-", 1000, &offset, &length));
+    EXPECT_FALSE(parse_range_header("bytes=100-99", 1000, &offset, &length));
+    EXPECT_FALSE(parse_range_header("bytes=0-9,20-29", 1000, &offset, &length));
+    EXPECT_FALSE(parse_range_header("bytes=-", 1000, &offset, &length));
+    EXPECT_FALSE(parse_range_header("bytes=a-b", 1000, &offset, &length));
+    EXPECT_FALSE(parse_range_header("items=0-99", 1000, &offset, &length));
+}
+
 } // namespace doris
@@ -17,6 +17,7 @@
 
 #include "http/action/stream_load.h"
 
+#include <event2/buffer.h>
 #include <event2/http.h>
 #include <event2/http_struct.h>
 #include <gtest/gtest.h>
@@ -25,8 +26,10 @@
 #include "exec/schema_scanner/schema_helper.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "http/http_channel.h"
+#include "http/http_common.h"
 #include "http/http_request.h"
 #include "runtime/exec_env.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/thread_resource_mgr.h"
@@ -77,6 +80,7 @@ public:
         _env._internal_client_cache = new BrpcClientCache<PBackendService_Stub>();
         _env._function_client_cache = new BrpcClientCache<PFunctionService_Stub>();
         _env._stream_load_executor = new StreamLoadExecutor(&_env);
+        _env._group_commit_mgr = new GroupCommitMgr(&_env);
 
         _evhttp_req = evhttp_request_new(nullptr, nullptr);
     }
@@ -91,6 +95,8 @@ public:
         _env._master_info = nullptr;
         delete _env._thread_mgr;
         _env._thread_mgr = nullptr;
+        delete _env._group_commit_mgr;
+        _env._group_commit_mgr = nullptr;
         delete _env._stream_load_executor;
         _env._stream_load_executor = nullptr;
 
@@ -235,4 +241,53 @@ TEST_F(StreamLoadActionTest, plan_fail) {
     EXPECT_STREQ("Fail", doc["Status"].GetString());
 }
 
+TEST_F(StreamLoadActionTest, group_commit) {
+    config::group_commit_interval_ms = 10;
+    k_stream_load_begin_result.__set_txnId(100);
+    StreamLoadAction action(&_env);
+
+    HttpRequest request(_evhttp_req);
+    struct evhttp_request ev_req;
+    ev_req.remote_host = nullptr;
+    ev_req.input_buffer = evbuffer_new();
+    std::string body = "1,a\n2,b";
+    evbuffer_add(ev_req.input_buffer, body.data(), body.size());
+    request._ev_req = &ev_req;
+    request._headers.emplace(HttpHeaders::AUTHORIZATION, "Basic cm9vdDo=");
+    request._headers.emplace(HttpHeaders::CONTENT_LENGTH, std::to_string(body.size()));
+    request._headers.emplace(HTTP_GROUP_COMMIT, "true");
+    request.set_handler(&action);
+    action.on_header(&request);
+    action.on_chunk_data(&request);
+    action.handle(&request);
+    evbuffer_free(ev_req.input_buffer);
+
+    rapidjson::Document doc;
+    doc.Parse(k_response_str.c_str());
+    EXPECT_STREQ("Success", doc["Status"].GetString());
+    EXPECT_EQ(100, doc["TxnId"].GetInt64());
+    EXPECT_EQ(2, doc["NumberTotalRows"].GetInt64());
+    EXPECT_EQ(0, std::string(doc["Label"].GetString()).find("group_commit_"));
+}
+
+TEST_F(StreamLoadActionTest, group_commit_with_label) {
+    StreamLoadAction action(&_env);
+
+    HttpRequest request(_evhttp_req);
+    struct evhttp_request ev_req;
+    ev_req.remote_host = nullptr;
+    request._ev_req = &ev_req;
+    request._headers.emplace(HttpHeaders::AUTHORIZATION, "Basic cm9vdDo=");
+    request._headers.emplace(HttpHeaders::CONTENT_LENGTH, "16");
+    request._headers.emplace(HTTP_LABEL_KEY, "label");
+    request._headers.emplace(HTTP_GROUP_COMMIT, "true");
+    request.set_handler(&action);
+    action.on_header(&request);
+    action.handle(&request);
+
+    rapidjson::Document doc;
+    doc.Parse(k_response_str.c_str());
+    EXPECT_STREQ("Fail", doc["Status"].GetString());
+}
+
 } // namespace doris
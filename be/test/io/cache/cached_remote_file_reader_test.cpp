@@ -0,0 +1,134 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/cache/cached_remote_file_reader.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "io/cache/file_block_cache.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace io {
+
+static const std::string kCacheDir = "./ut_dir/file_block_cache_test";
+
+// A remote file reader over an in-memory string, which counts the remote requests
+class MockRemoteFileReader : public FileReader {
+public:
+    MockRemoteFileReader(std::string data) : _data(std::move(data)), _path("mock_remote_file") {}
+
+    Status close() override { return Status::OK(); }
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override {
+        ++num_requests;
+        *bytes_read = std::min(result.size, _data.size() - offset);
+        memcpy(result.data, _data.data() + offset, *bytes_read);
+        return Status::OK();
+    }
+
+    const Path& path() const override { return _path; }
+
+    size_t size() const override { return _data.size(); }
+
+    int num_requests = 0;
+
+private:
+    std::string _data;
+    Path _path;
+};
+
+class CachedRemoteFileReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        _data.resize(100);
+        for (size_t i = 0; i < _data.size(); ++i) {
+            _data[i] = 'a' + i % 26;
+        }
+        _cache.reset(new FileBlockCache(kCacheDir, 16 * 1024, 16));
+        EXPECT_TRUE(_cache->init().ok());
+        auto remote_reader = std::make_unique<MockRemoteFileReader>(_data);
+        _remote_reader = remote_reader.get();
+        _reader.reset(new CachedRemoteFileReader(std::move(remote_reader), _cache.get()));
+    }
+
+    void TearDown() override {
+        _reader.reset();
+        _cache.reset();
+        FileUtils::remove_all(kCacheDir);
+        config::file_cache_admit_on_second_access = true;
+    }
+
+    void check_read(size_t offset, size_t size) {
+        std::string buf(size, '\0');
+        size_t bytes_read = 0;
+        EXPECT_TRUE(_reader->read_at(offset, Slice(buf.data(), size), &bytes_read).ok());
+        EXPECT_EQ(size, bytes_read);
+        EXPECT_EQ(_data.substr(offset, size), buf);
+    }
+
+protected:
+    std::string _data;
+    std::unique_ptr<FileBlockCache> _cache;
+    std::unique_ptr<CachedRemoteFileReader> _reader;
+    MockRemoteFileReader* _remote_reader = nullptr;
+};
+
+TEST_F(CachedRemoteFileReaderTest, AdmitOnSecondAccess) {
+    config::file_cache_admit_on_second_access = true;
+    // blocks 0~2 are missed for the first time, read from remote in one request
+    check_read(10, 30);
+    EXPECT_EQ(1, _remote_reader->num_requests);
+    // blocks 0~2 are admitted, each of them is loaded from remote
+    check_read(10, 30);
+    EXPECT_EQ(4, _remote_reader->num_requests);
+    // all from cache
+    check_read(10, 30);
+    check_read(0, 48);
+    EXPECT_EQ(4, _remote_reader->num_requests);
+    // the last block is not full
+    check_read(90, 10);
+    check_read(90, 10);
+    check_read(96, 4);
+    EXPECT_EQ(7, _remote_reader->num_requests);
+}
+
+TEST_F(CachedRemoteFileReaderTest, AdmitOnFirstAccess) {
+    config::file_cache_admit_on_second_access = false;
+    check_read(0, 100);
+    EXPECT_EQ(7, _remote_reader->num_requests);
+    check_read(0, 100);
+    check_read(33, 50);
+    EXPECT_EQ(7, _remote_reader->num_requests);
+}
+
+TEST_F(CachedRemoteFileReaderTest, Bypass) {
+    config::file_cache_admit_on_second_access = false;
+    {
+        FileBlockCache::ScopedBypass bypass(true);
+        check_read(0, 32);
+        check_read(0, 32);
+        EXPECT_EQ(2, _remote_reader->num_requests);
+    }
+    check_read(0, 32);
+    check_read(0, 32);
+    EXPECT_EQ(4, _remote_reader->num_requests);
+}
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/io_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "util/time.h"
+
+namespace doris {
+namespace io {
+
+class IOLimiterTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_rate_limit = config::compaction_io_rate_limit_mbytes_per_sec;
+        _old_min_rate = config::compaction_io_min_rate_mbytes_per_sec;
+        _old_latency_target = config::compaction_io_read_latency_target_ms;
+        config::compaction_io_rate_limit_mbytes_per_sec = 100;
+        config::compaction_io_min_rate_mbytes_per_sec = 20;
+        config::compaction_io_read_latency_target_ms = 10;
+    }
+
+    void TearDown() override {
+        config::compaction_io_rate_limit_mbytes_per_sec = _old_rate_limit;
+        config::compaction_io_min_rate_mbytes_per_sec = _old_min_rate;
+        config::compaction_io_read_latency_target_ms = _old_latency_target;
+    }
+
+private:
+    int64_t _old_rate_limit;
+    int64_t _old_min_rate;
+    int64_t _old_latency_target;
+};
+
+TEST_F(IOLimiterTest, scope) {
+    EXPECT_FALSE(IOLimiter::is_limited());
+    {
+        IOLimiter::Scope scope;
+        EXPECT_TRUE(IOLimiter::is_limited());
+        {
+            IOLimiter::Scope inner_scope;
+            EXPECT_TRUE(IOLimiter::is_limited());
+        }
+        EXPECT_TRUE(IOLimiter::is_limited());
+    }
+    EXPECT_FALSE(IOLimiter::is_limited());
+}
+
+TEST_F(IOLimiterTest, adjust) {
+    const int64_t mb = 1024 * 1024;
+    IOLimiter limiter;
+    EXPECT_EQ(100 * mb, limiter.rate());
+
+    // halved while the foreground reads are slow, down to the lower limit
+    limiter.record_read_latency(20 * 1000 * 1000);
+    limiter.adjust();
+    EXPECT_EQ(50 * mb, limiter.rate());
+    limiter.record_read_latency(20 * 1000 * 1000);
+    limiter.adjust();
+    EXPECT_EQ(25 * mb, limiter.rate());
+    limiter.record_read_latency(20 * 1000 * 1000);
+    limiter.adjust();
+    EXPECT_EQ(20 * mb, limiter.rate());
+
+    // grows back while the foreground reads are fast, up to the upper limit
+    limiter.record_read_latency(1000 * 1000);
+    limiter.adjust();
+    EXPECT_EQ(30 * mb, limiter.rate());
+    for (int i = 0; i < 10; ++i) {
+        limiter.adjust();
+    }
+    EXPECT_EQ(100 * mb, limiter.rate());
+
+    config::compaction_io_rate_limit_mbytes_per_sec = 0;
+    limiter.adjust();
+    EXPECT_EQ(0, limiter.rate());
+}
+
+TEST_F(IOLimiterTest, acquire) {
+    config::compaction_io_rate_limit_mbytes_per_sec = 1;
+    IOLimiter limiter;
+    int64_t start_ns = MonotonicNanos();
+    limiter.acquire(256 * 1024);
+    limiter.acquire(256 * 1024);
+    // the bucket is empty at first, 512KB takes about 0.5 second at 1MB/s
+    EXPECT_GE(MonotonicNanos() - start_ns, 400 * 1000 * 1000);
+
+    config::compaction_io_rate_limit_mbytes_per_sec = 0;
+    limiter.adjust();
+    start_ns = MonotonicNanos();
+    limiter.acquire(1024 * 1024 * 1024);
+    EXPECT_LT(MonotonicNanos() - start_ns, 100 * 1000 * 1000);
+}
+
+} // namespace io
+} // namespace doris
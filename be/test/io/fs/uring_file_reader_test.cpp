@@ -0,0 +1,85 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/uring_file_reader.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "io/fs/io_uring.h"
+#include "io/fs/local_file_system.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace io {
+
+static const std::string kTestDir = "./ut_dir/uring_file_reader_test";
+
+class UringFileReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        if (!IoUring::is_supported()) {
+            GTEST_SKIP() << "io_uring is not supported";
+        }
+        FileUtils::remove_all(kTestDir);
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+        _data.resize(64 * 1024);
+        for (size_t i = 0; i < _data.size(); ++i) {
+            _data[i] = 'a' + i % 26;
+        }
+        _fs = std::make_shared<LocalFileSystem>(kTestDir);
+        std::unique_ptr<FileWriter> writer;
+        EXPECT_TRUE(_fs->create_file("data", &writer).ok());
+        EXPECT_TRUE(writer->append(Slice(_data)).ok());
+        EXPECT_TRUE(writer->close().ok());
+    }
+
+    void TearDown() override { FileUtils::remove_all(kTestDir); }
+
+    void check_read(FileReader* reader, size_t offset, size_t size) {
+        std::string buf(size, '\0');
+        size_t bytes_read = 0;
+        EXPECT_TRUE(reader->read_at(offset, Slice(buf.data(), size), &bytes_read).ok());
+        EXPECT_EQ(std::min(size, _data.size() - offset), bytes_read);
+        EXPECT_EQ(_data.substr(offset, bytes_read), buf.substr(0, bytes_read));
+    }
+
+protected:
+    std::string _data;
+    std::shared_ptr<LocalFileSystem> _fs;
+};
+
+TEST_F(UringFileReaderTest, ReadPrefetched) {
+    config::enable_io_uring = true;
+    std::unique_ptr<FileReader> reader;
+    EXPECT_TRUE(_fs->open_file("data", &reader).ok());
+    config::enable_io_uring = false;
+    ASSERT_NE(nullptr, dynamic_cast<UringFileReader*>(reader.get()));
+    EXPECT_TRUE(reader->support_prefetch());
+    // skip the first range and read the others partially
+    reader->prefetch({{0, 4096}, {4096, 4096}, {16384, 8192}, {60000, 10000}});
+    check_read(reader.get(), 4096, 4096);
+    check_read(reader.get(), 16384, 4096);
+    check_read(reader.get(), 20480, 4096);
+    check_read(reader.get(), 60000, 10000);
+    // not prefetched
+    check_read(reader.get(), 100, 200);
+    EXPECT_TRUE(reader->close().ok());
+}
+
+} // namespace io
+} // namespace doris
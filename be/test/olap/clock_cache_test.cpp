@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/clock_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace doris {
+
+class ClockCacheTest : public testing::Test {
+public:
+    static void deleter(const CacheKey& key, void* value) { ++_s_deleted; }
+
+    void SetUp() override { _s_deleted = 0; }
+
+    static Cache::Handle* insert(ClockCache* cache, int key, CachePriority priority) {
+        std::string key_str = std::to_string(key);
+        CacheKey cache_key(key_str);
+        uint32_t hash = cache_key.hash(cache_key.data(), cache_key.size(), 0);
+        return cache->insert(cache_key, hash, reinterpret_cast<void*>((intptr_t)key), 1,
+                             &deleter, priority);
+    }
+
+    // Returns the value of key, -1 if missing.
+    static int lookup(ClockCache* cache, int key) {
+        std::string key_str = std::to_string(key);
+        CacheKey cache_key(key_str);
+        uint32_t hash = cache_key.hash(cache_key.data(), cache_key.size(), 0);
+        auto handle = cache->lookup(cache_key, hash);
+        if (handle == nullptr) {
+            return -1;
+        }
+        int value = (intptr_t)reinterpret_cast<ClockHandle*>(handle)->value;
+        cache->release(handle);
+        return value;
+    }
+
+    static std::atomic<int> _s_deleted;
+};
+
+std::atomic<int> ClockCacheTest::_s_deleted {0};
+
+TEST_F(ClockCacheTest, hit_and_miss) {
+    ClockCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(10);
+    EXPECT_EQ(-1, lookup(&cache, 1));
+    cache.release(insert(&cache, 1, CachePriority::NORMAL));
+    EXPECT_EQ(1, lookup(&cache, 1));
+    EXPECT_EQ(1, cache.get_usage());
+
+    // replace
+    cache.release(insert(&cache, 1, CachePriority::NORMAL));
+    EXPECT_EQ(1, _s_deleted);
+    EXPECT_EQ(1, cache.get_usage());
+
+    std::string key_str = "1";
+    CacheKey key(key_str);
+    cache.erase(key, key.hash(key.data(), key.size(), 0));
+    EXPECT_EQ(-1, lookup(&cache, 1));
+    EXPECT_EQ(2, _s_deleted);
+    EXPECT_EQ(0, cache.get_usage());
+    EXPECT_EQ(3, cache.get_lookup_count());
+    EXPECT_EQ(1, cache.get_hit_count());
+}
+
+TEST_F(ClockCacheTest, evict) {
+    ClockCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(10);
+    for (int i = 0; i < 10; ++i) {
+        cache.release(insert(&cache, i, CachePriority::NORMAL));
+    }
+    // the entries hit get a second chance
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i, lookup(&cache, i));
+    }
+    for (int i = 10; i < 15; ++i) {
+        cache.release(insert(&cache, i, CachePriority::NORMAL));
+    }
+    EXPECT_EQ(10, cache.get_usage());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i, lookup(&cache, i));
+    }
+    for (int i = 5; i < 10; ++i) {
+        EXPECT_EQ(-1, lookup(&cache, i));
+    }
+    EXPECT_EQ(5, _s_deleted);
+}
+
+TEST_F(ClockCacheTest, in_use) {
+    ClockCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(2);
+    auto handle = insert(&cache, 1, CachePriority::NORMAL);
+    cache.release(insert(&cache, 2, CachePriority::NORMAL));
+
+    cache.release(insert(&cache, 3, CachePriority::NORMAL));
+    EXPECT_EQ(1, lookup(&cache, 1));
+    EXPECT_EQ(-1, lookup(&cache, 2));
+    EXPECT_EQ(3, lookup(&cache, 3));
+    EXPECT_EQ(1, _s_deleted);
+
+    // not evicted when it's in use
+    cache.release(insert(&cache, 4, CachePriority::NORMAL));
+    EXPECT_EQ(1, lookup(&cache, 1));
+    cache.release(handle);
+
+    EXPECT_EQ(2, cache.get_usage());
+    EXPECT_EQ(2, cache.prune());
+    EXPECT_EQ(0, cache.get_usage());
+    EXPECT_EQ(4, _s_deleted);
+}
+
+TEST_F(ClockCacheTest, durable) {
+    ClockCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(2);
+    cache.release(insert(&cache, 1, CachePriority::DURABLE));
+    cache.release(insert(&cache, 2, CachePriority::NORMAL));
+    cache.release(insert(&cache, 3, CachePriority::NORMAL));
+    EXPECT_EQ(1, lookup(&cache, 1));
+    EXPECT_EQ(-1, lookup(&cache, 2));
+    EXPECT_EQ(3, lookup(&cache, 3));
+}
+
+TEST_F(ClockCacheTest, concurrent_lookup) {
+    ClockCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(100);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                int key = (i * 7 + t) % 200;
+                int value = lookup(&cache, key);
+                if (value == -1) {
+                    cache.release(insert(&cache, key, CachePriority::NORMAL));
+                } else {
+                    EXPECT_EQ(key, value);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // the entries in use by the other threads may not be evicted
+    EXPECT_LE(cache.get_usage(), 100 + 8);
+    cache.prune();
+    EXPECT_EQ(0, cache.get_usage());
+    EXPECT_EQ(8 * 10000 - (int)cache.get_hit_count(), _s_deleted.load());
+}
+
+} // namespace doris
@@ -24,6 +24,7 @@
 #include "olap/cumulative_compaction.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/tablet_meta.h"
+#include "util/time.h"
 
 namespace doris {
 
@@ -1124,6 +1125,240 @@ TEST_F(TestSizeBasedCumulativeCompactionPolicy, _pick_missing_version_cumulative
     compaction.find_longest_consecutive_version(&rowsets3, nullptr);
     EXPECT_EQ(0, rowsets3.size());
 }
+
+class TestTimeSeriesCumulativeCompactionPolicy : public testing::Test {
+public:
+    TestTimeSeriesCumulativeCompactionPolicy() {}
+    void SetUp() {
+        config::time_series_compaction_goal_size_mbytes = 1;
+        config::time_series_compaction_time_window_seconds = 3600;
+        _now = UnixSeconds();
+
+        _tablet_meta = static_cast<TabletMetaSharedPtr>(new TabletMeta(
+                1, 2, 15673, 15674, 4, 5, TTabletSchema(), 6, {{7, 8}}, UniqueId(9, 10),
+                TTabletType::TABLET_TYPE_DISK, TStorageMedium::HDD, "", TCompressionType::LZ4F));
+
+        _json_rowset_meta = R"({
+            "rowset_id": 540081,
+            "tablet_id": 15673,
+            "txn_id": 4042,
+            "tablet_schema_hash": 567997577,
+            "rowset_type": "BETA_ROWSET",
+            "rowset_state": "VISIBLE",
+            "start_version": 2,
+            "end_version": 2,
+            "num_rows": 3929,
+            "total_disk_size": 41,
+            "data_disk_size": 41,
+            "index_disk_size": 235,
+            "empty": false,
+            "load_id": {
+                "hi": -5350970832824939812,
+                "lo": -6717994719194512122
+            },
+            "creation_time": 1553765670,
+            "alpha_rowset_extra_meta_pb": {
+                "segment_groups": [
+                {
+                    "segment_group_id": 0,
+                    "num_segments": 2,
+                    "index_size": 132,
+                    "data_size": 576,
+                    "num_rows": 5,
+                    "zone_maps": [
+                    {
+                        "min": "MQ==",
+                        "max": "NQ==",
+                        "null_flag": false
+                    },
+                    {
+                        "min": "MQ==",
+                        "max": "Mw==",
+                        "null_flag": false
+                    },
+                    {
+                        "min": "J2J1c2gn",
+                        "max": "J3RvbSc=",
+                        "null_flag": false
+                    }
+                    ],
+                    "empty": false
+                },
+                {
+                    "segment_group_id": 1,
+                    "num_segments": 1,
+                    "index_size": 132,
+                    "data_size": 576,
+                    "num_rows": 5,
+                    "zone_maps": [
+                    {
+                        "min": "MQ==",
+                        "max": "NQ==",
+                        "null_flag": false
+                    },
+                    {
+                        "min": "MQ==",
+                        "max": "Mw==",
+                        "null_flag": false
+                    },
+                    {
+                        "min": "J2J1c2gn",
+                        "max": "J3RvbSc=",
+                        "null_flag": false
+                    }
+                    ],
+                    "empty": false
+                }
+                ]
+            }
+        })";
+    }
+    void TearDown() {}
+
+    void init_rs_meta(RowsetMetaSharedPtr& pb1, int64_t start, int64_t end, int64_t timestamp,
+                      int64_t size, bool overlapping) {
+        pb1->init_from_json(_json_rowset_meta);
+        pb1->set_start_version(start);
+        pb1->set_end_version(end);
+        pb1->set_total_disk_size(size);
+        pb1->set_creation_time(timestamp);
+        pb1->set_oldest_write_timestamp(timestamp);
+        pb1->set_newest_write_timestamp(timestamp);
+        pb1->set_segments_overlap(overlapping ? OVERLAPPING : NONOVERLAPPING);
+    }
+
+    void add_rs_meta(int64_t start, int64_t end, int64_t timestamp, int64_t size = 41,
+                     bool overlapping = true) {
+        RowsetMetaSharedPtr ptr(new RowsetMeta());
+        init_rs_meta(ptr, start, end, timestamp, size, overlapping);
+        _tablet_meta->add_rs_meta(ptr);
+    }
+
+    TabletSharedPtr create_tablet() {
+        StorageParamPB storage_param;
+        storage_param.set_storage_medium(StorageMediumPB::HDD);
+        TabletSharedPtr tablet(
+                new Tablet(_tablet_meta, storage_param, nullptr, CUMULATIVE_TIME_SERIES_POLICY));
+        tablet->init();
+        tablet->calculate_cumulative_point();
+        return tablet;
+    }
+
+    void pick_input_rowsets(TabletSharedPtr tablet, std::vector<RowsetSharedPtr>* input_rowsets,
+                            size_t* compaction_score) {
+        std::vector<RowsetSharedPtr> candidate_rowsets;
+        tablet->pick_candidate_rowsets_to_cumulative_compaction(&candidate_rowsets);
+        Version last_delete_version {-1, -1};
+        tablet->_cumulative_compaction_policy->pick_input_rowsets(
+                tablet.get(), candidate_rowsets, 100, 5, input_rowsets, &last_delete_version,
+                compaction_score);
+    }
+
+protected:
+    int64_t _now;
+    std::string _json_rowset_meta;
+    TabletMetaSharedPtr _tablet_meta;
+};
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_same_bucket) {
+    add_rs_meta(0, 1, _now - 36000, 41, false);
+    add_rs_meta(2, 2, _now - 7200);
+    add_rs_meta(3, 3, _now - 7200);
+    add_rs_meta(4, 4, _now - 7200);
+    add_rs_meta(5, 5, _now);
+    add_rs_meta(6, 6, _now);
+    TabletSharedPtr tablet = create_tablet();
+    EXPECT_EQ(2, tablet->cumulative_layer_point());
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = 0;
+    pick_input_rowsets(tablet, &input_rowsets, &compaction_score);
+
+    // the rowsets of the closed bucket are never compacted with the current one
+    EXPECT_EQ(3, input_rowsets.size());
+    EXPECT_EQ(2, input_rowsets.front()->start_version());
+    EXPECT_EQ(4, input_rowsets.back()->end_version());
+    EXPECT_EQ(9, compaction_score);
+    EXPECT_EQ(0, tablet->calc_compaction_score(CompactionType::BASE_COMPACTION,
+                                               tablet->get_cumulative_compaction_policy()));
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_skip_closed) {
+    add_rs_meta(0, 1, _now - 36000, 41, false);
+    add_rs_meta(2, 4, _now - 7200, 41, false);
+    add_rs_meta(5, 5, _now);
+    add_rs_meta(6, 6, _now);
+    TabletSharedPtr tablet = create_tablet();
+    tablet->set_cumulative_layer_point(2);
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = 0;
+    pick_input_rowsets(tablet, &input_rowsets, &compaction_score);
+
+    // the only run of the closed bucket is skipped
+    EXPECT_EQ(5, tablet->cumulative_layer_point());
+    EXPECT_EQ(2, input_rowsets.size());
+    EXPECT_EQ(5, input_rowsets.front()->start_version());
+    EXPECT_EQ(6, compaction_score);
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_promotion) {
+    add_rs_meta(0, 1, _now - 36000, 41, false);
+    add_rs_meta(2, 2, _now - 7200);
+    add_rs_meta(3, 3, _now);
+    TabletSharedPtr tablet = create_tablet();
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = 0;
+    pick_input_rowsets(tablet, &input_rowsets, &compaction_score);
+
+    // the only rowset of the closed bucket is overlapping, so it is compacted once
+    EXPECT_EQ(1, input_rowsets.size());
+    EXPECT_EQ(2, input_rowsets.front()->start_version());
+
+    RowsetSharedPtr output_rowset = input_rowsets.front();
+    output_rowset->rowset_meta()->set_segments_overlap(NONOVERLAPPING);
+    Version last_delete_version {-1, -1};
+    tablet->_cumulative_compaction_policy->update_cumulative_point(
+            tablet.get(), input_rowsets, output_rowset, last_delete_version);
+    EXPECT_EQ(3, tablet->cumulative_layer_point());
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_goal_size) {
+    add_rs_meta(0, 1, _now - 36000, 41, false);
+    add_rs_meta(2, 2, _now - 7200, 600 * 1024);
+    add_rs_meta(3, 3, _now - 7200, 600 * 1024);
+    add_rs_meta(4, 4, _now - 7200, 600 * 1024);
+    TabletSharedPtr tablet = create_tablet();
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = 0;
+    pick_input_rowsets(tablet, &input_rowsets, &compaction_score);
+
+    // the output never exceeds the goal size
+    EXPECT_EQ(1, input_rowsets.size());
+    EXPECT_EQ(2, input_rowsets.front()->start_version());
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_size_tier) {
+    add_rs_meta(0, 1, _now - 36000, 41, false);
+    add_rs_meta(2, 4, _now, 1000, false);
+    add_rs_meta(5, 5, _now);
+    add_rs_meta(6, 6, _now);
+    TabletSharedPtr tablet = create_tablet();
+    tablet->set_cumulative_layer_point(2);
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = 0;
+    pick_input_rowsets(tablet, &input_rowsets, &compaction_score);
+
+    // the big run of the open bucket waits for the small ones to catch up
+    EXPECT_EQ(2, input_rowsets.size());
+    EXPECT_EQ(5, input_rowsets.front()->start_version());
+    EXPECT_EQ(6, compaction_score);
+    EXPECT_EQ(2, tablet->cumulative_layer_point());
+}
+
 } // namespace doris
 
 // @brief Test Stub
@@ -1130,4 +1130,25 @@ TEST_F(TestDeleteHandler, FilterDataVersion) {
     _delete_handler.finalize();
 }
 
+TEST_F(TestDeleteHandler, GetConditionColumns) {
+    DelPredicateArray delete_conditions;
+    DeletePredicatePB* del_pred = delete_conditions.Add();
+    del_pred->set_version(3);
+    del_pred->add_sub_predicates("k1=1");
+    del_pred->add_sub_predicates("k2 IS NULL");
+    del_pred = delete_conditions.Add();
+    del_pred->set_version(4);
+    InPredicatePB* in_pred = del_pred->add_in_predicates();
+    in_pred->set_column_name("k3");
+    in_pred->set_is_not_in(false);
+    in_pred->add_values("5");
+
+    std::set<std::string> column_names;
+    EXPECT_EQ(Status::OK(), DeleteHandler::get_condition_columns(delete_conditions, &column_names));
+    EXPECT_EQ(std::set<std::string>({"k1", "k2", "k3"}), column_names);
+
+    del_pred->add_sub_predicates("invalid");
+    EXPECT_FALSE(DeleteHandler::get_condition_columns(delete_conditions, &column_names).ok());
+}
+
 } // namespace doris
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/delete_predicate_bitmap_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+
+static std::shared_ptr<const roaring::Roaring> make_rows(uint32_t from, uint32_t to) {
+    auto rows = std::make_shared<roaring::Roaring>();
+    rows->addRange(from, to);
+    return rows;
+}
+
+TEST(DeletePredicateBitmapCacheTest, lookup) {
+    DeletePredicateBitmapCache cache(1024 * 1024);
+    RowsetId rowset_id;
+    rowset_id.init(10001);
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 5}));
+
+    cache.insert({rowset_id, 0, 5}, make_rows(10, 20));
+    auto rows = cache.lookup({rowset_id, 0, 5});
+    ASSERT_NE(nullptr, rows);
+    EXPECT_EQ(10, rows->cardinality());
+    EXPECT_TRUE(rows->contains(10));
+    EXPECT_FALSE(rows->contains(20));
+
+    // the other delete versions, segments and rowsets
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 6}));
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 1, 5}));
+    RowsetId other_rowset_id;
+    other_rowset_id.init(10002);
+    EXPECT_EQ(nullptr, cache.lookup({other_rowset_id, 0, 5}));
+}
+
+TEST(DeletePredicateBitmapCacheTest, evict) {
+    DeletePredicateBitmapCache cache(16 * 4096);
+    RowsetId rowset_id;
+    rowset_id.init(10001);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        cache.insert({rowset_id, i, 5}, make_rows(0, 100));
+    }
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 5}));
+    auto rows = cache.lookup({rowset_id, 9999, 5});
+    ASSERT_NE(nullptr, rows);
+
+    for (uint32_t i = 10000; i < 20000; ++i) {
+        cache.insert({rowset_id, i, 5}, make_rows(0, 100));
+    }
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 9999, 5}));
+    // the evicted rows are kept by their users
+    EXPECT_EQ(100, rows->cardinality());
+}
+
+} // namespace doris
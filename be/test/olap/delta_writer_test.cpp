@@ -796,4 +796,121 @@ TEST_F(TestDeltaWriter, vec_sequence_col) {
     delete delta_writer;
 }
 
+TEST_F(TestDeltaWriter, flush_active_memtable) {
+    TCreateTabletReq request;
+    create_tablet_request_with_sequence_col(10006, 270068378, &request);
+    Status res = k_engine->create_tablet(request);
+    EXPECT_EQ(Status::OK(), res);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_sequence_col();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    const std::vector<SlotDescriptor*>& slots = tuple_desc->slots();
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req = {10006, 270068378, WriteType::LOAD, 20004,
+                              30004, load_id,   tuple_desc,      &(tuple_desc->slots())};
+    DeltaWriter* delta_writer = nullptr;
+    DeltaWriter::open(&write_req, &delta_writer);
+    EXPECT_NE(delta_writer, nullptr);
+    // not initialized yet
+    EXPECT_EQ(0, delta_writer->active_memtable_mem_consumption());
+    EXPECT_EQ(Status::OK(), delta_writer->flush_active_memtable());
+
+    MemTracker tracker;
+    MemPool pool(&tracker);
+    for (int i = 0; i < 2; ++i) {
+        Tuple* tuple = reinterpret_cast<Tuple*>(pool.allocate(tuple_desc->byte_size()));
+        memset(tuple, 0, tuple_desc->byte_size());
+        *(int8_t*)(tuple->get_slot(slots[0]->tuple_offset())) = 123;
+        *(int16_t*)(tuple->get_slot(slots[1]->tuple_offset())) = 456 + i;
+        *(int32_t*)(tuple->get_slot(slots[2]->tuple_offset())) = 1;
+        ((DateTimeValue*)(tuple->get_slot(slots[3]->tuple_offset())))
+                ->from_date_str("2020-07-16 19:39:43", 19);
+
+        res = delta_writer->write(tuple);
+        EXPECT_EQ(Status::OK(), res);
+        EXPECT_GT(delta_writer->active_memtable_mem_consumption(), 0);
+        // every row is flushed to its own segment
+        res = delta_writer->flush_active_memtable();
+        EXPECT_EQ(Status::OK(), res);
+    }
+
+    res = delta_writer->close();
+    EXPECT_EQ(Status::OK(), res);
+    res = delta_writer->close_wait();
+    EXPECT_EQ(Status::OK(), res);
+    EXPECT_EQ(0, delta_writer->active_memtable_mem_consumption());
+
+    std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+    StorageEngine::instance()->txn_manager()->get_txn_related_tablets(
+            write_req.txn_id, write_req.partition_id, &tablet_related_rs);
+    EXPECT_EQ(1, tablet_related_rs.size());
+    for (auto& tablet_rs : tablet_related_rs) {
+        EXPECT_EQ(2, tablet_rs.second->num_rows());
+        EXPECT_EQ(2, tablet_rs.second->rowset_meta()->num_segments());
+    }
+
+    res = k_engine->tablet_manager()->drop_tablet(request.tablet_id, request.replica_id);
+    EXPECT_EQ(Status::OK(), res);
+    delete delta_writer;
+}
+
+TEST_F(TestDeltaWriter, fill_pull_rowset_request) {
+    TCreateTabletReq request;
+    create_tablet_request_with_sequence_col(10007, 270068379, &request);
+    Status res = k_engine->create_tablet(request);
+    EXPECT_EQ(Status::OK(), res);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_sequence_col();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    const std::vector<SlotDescriptor*>& slots = tuple_desc->slots();
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req = {10007, 270068379, WriteType::LOAD, 20005,
+                              30005, load_id,   tuple_desc,      &(tuple_desc->slots())};
+    DeltaWriter* delta_writer = nullptr;
+    DeltaWriter::open(&write_req, &delta_writer);
+    EXPECT_NE(delta_writer, nullptr);
+
+    MemTracker tracker;
+    MemPool pool(&tracker);
+    Tuple* tuple = reinterpret_cast<Tuple*>(pool.allocate(tuple_desc->byte_size()));
+    memset(tuple, 0, tuple_desc->byte_size());
+    *(int8_t*)(tuple->get_slot(slots[0]->tuple_offset())) = 123;
+    *(int16_t*)(tuple->get_slot(slots[1]->tuple_offset())) = 456;
+    *(int32_t*)(tuple->get_slot(slots[2]->tuple_offset())) = 1;
+    ((DateTimeValue*)(tuple->get_slot(slots[3]->tuple_offset())))
+            ->from_date_str("2020-07-16 19:39:43", 19);
+    EXPECT_EQ(Status::OK(), delta_writer->write(tuple));
+
+    // the rowset is not built yet
+    PTabletPullRowsetRequest pull_request;
+    EXPECT_FALSE(delta_writer->fill_pull_rowset_request(&pull_request).ok());
+
+    EXPECT_EQ(Status::OK(), delta_writer->close());
+    EXPECT_EQ(Status::OK(), delta_writer->close_wait());
+    EXPECT_EQ(Status::OK(), delta_writer->fill_pull_rowset_request(&pull_request));
+    TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(write_req.tablet_id);
+    EXPECT_EQ(write_req.txn_id, pull_request.txn_id());
+    EXPECT_EQ(write_req.partition_id, pull_request.partition_id());
+    EXPECT_EQ(write_req.tablet_id, pull_request.rowset_meta().tablet_id());
+    EXPECT_EQ(tablet->tablet_path(), pull_request.tablet_path());
+    EXPECT_EQ(1, pull_request.segments_size_size());
+    EXPECT_GT(pull_request.segments_size().at(0), 0);
+
+    res = k_engine->tablet_manager()->drop_tablet(request.tablet_id, request.replica_id);
+    EXPECT_EQ(Status::OK(), res);
+    delete delta_writer;
+}
+
 } // namespace doris
@@ -19,6 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "util/hash_util.hpp"
 #include "util/slice.h"
 
@@ -192,6 +195,58 @@ TEST_F(TestHll, Normal) {
     }
 }
 
+TEST_F(TestHll, MergeSerialized) {
+    // explicit, sparse and full
+    std::vector<HyperLogLog> hlls(3);
+    for (int i = 0; i < 10; ++i) {
+        hlls[0].update(hash(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        hlls[1].update(hash(i + 10));
+    }
+    for (int i = 0; i < 100000; ++i) {
+        hlls[2].update(hash(i + 500));
+    }
+    std::vector<std::string> serialized;
+    for (const auto& hll : hlls) {
+        std::string buf(hll.max_serialized_size(), '\0');
+        buf.resize(hll.serialize((uint8_t*)buf.data()));
+        serialized.push_back(std::move(buf));
+    }
+
+    // every order starting from every type
+    for (int first = 0; first < 3; ++first) {
+        HyperLogLog expected;
+        HyperLogLog merged;
+        for (int i = 0; i < 3; ++i) {
+            int idx = (first + i) % 3;
+            expected.merge(hlls[idx]);
+            EXPECT_TRUE(merged.merge_serialized(Slice(serialized[idx])));
+            EXPECT_EQ(expected.estimate_cardinality(), merged.estimate_cardinality());
+        }
+    }
+
+    HyperLogLog hll;
+    EXPECT_FALSE(hll.merge_serialized(Slice()));
+    EXPECT_EQ(0, hll.estimate_cardinality());
+}
+
+TEST_F(TestHll, UpdateBatch) {
+    for (int num : {10, 1000, 100000}) {
+        std::vector<uint64_t> hash_values;
+        HyperLogLog expected;
+        for (int i = 0; i < num; ++i) {
+            hash_values.push_back(hash(i));
+            expected.update(hash(i));
+        }
+        HyperLogLog hll;
+        hll.update_batch(hash_values.data(), hash_values.size());
+        EXPECT_EQ(expected.estimate_cardinality(), hll.estimate_cardinality());
+        hll.update_batch(hash_values.data(), hash_values.size());
+        EXPECT_EQ(expected.estimate_cardinality(), hll.estimate_cardinality());
+    }
+}
+
 TEST_F(TestHll, InvalidPtr) {
     {
         HyperLogLog hll(Slice((char*)nullptr, 0));
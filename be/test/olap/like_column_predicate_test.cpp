@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/like_column_predicate.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/string_value.h"
+#include "vec/columns/column_dictionary.h"
+#include "vec/columns/predicate_column.h"
+
+using namespace doris::vectorized;
+
+namespace doris {
+
+TEST(LikeColumnPredicateTest, supported_pattern) {
+    EXPECT_TRUE(LikeColumnPredicate::is_supported_pattern("abc"));
+    EXPECT_TRUE(LikeColumnPredicate::is_supported_pattern("%ab%c%"));
+    EXPECT_FALSE(LikeColumnPredicate::is_supported_pattern("a_c"));
+    EXPECT_FALSE(LikeColumnPredicate::is_supported_pattern("a\\%c"));
+}
+
+TEST(LikeColumnPredicateTest, match) {
+    LikeColumnPredicate exact(0, "abc");
+    EXPECT_TRUE(exact.match("abc", 3));
+    EXPECT_FALSE(exact.match("abcd", 4));
+
+    LikeColumnPredicate pred(0, "ab%cd%ef");
+    EXPECT_TRUE(pred.match("abcdef", 6));
+    EXPECT_TRUE(pred.match("abxxcdxxef", 10));
+    EXPECT_FALSE(pred.match("abcef", 5));
+    // the middle literal overlaps the suffix
+    EXPECT_FALSE(pred.match("abef", 4));
+    EXPECT_FALSE(pred.match("abdcef", 6));
+
+    LikeColumnPredicate any(0, "%");
+    EXPECT_TRUE(any.match("", 0));
+    EXPECT_TRUE(any.match("x", 1));
+
+    LikeColumnPredicate contains(0, "%b%");
+    EXPECT_TRUE(contains.match("abc", 3));
+    EXPECT_FALSE(contains.match("ac", 2));
+}
+
+TEST(LikeColumnPredicateTest, evaluate_predicate_column) {
+    std::vector<std::string> values = {"apple", "banana", "pineapple", "grape"};
+    auto column = PredicateColumnType<StringValue>::create();
+    for (auto& value : values) {
+        column->insert_data(value.data(), value.size());
+    }
+    LikeColumnPredicate pred(0, "%apple");
+    uint16_t sel[4] = {0, 1, 2, 3};
+    uint16_t size = 4;
+    pred.evaluate(*column, sel, &size);
+    ASSERT_EQ(2, size);
+    EXPECT_EQ(0, sel[0]);
+    EXPECT_EQ(2, sel[1]);
+}
+
+TEST(LikeColumnPredicateTest, evaluate_dictionary_column) {
+    std::vector<StringRef> dict = {StringRef("apple", 5), StringRef("banana", 6),
+                                   StringRef("grape", 5)};
+    std::vector<int32_t> codes = {1, 0, 2, 0, 1};
+    auto column = ColumnDictionary<Int32>::create();
+    column->reserve(codes.size());
+    column->insert_many_dict_data(codes.data(), 0, dict.data(), codes.size(), dict.size());
+
+    LikeColumnPredicate pred(0, "%an%");
+    uint16_t sel[5] = {0, 1, 2, 3, 4};
+    uint16_t size = 5;
+    pred.evaluate(*column, sel, &size);
+    ASSERT_EQ(2, size);
+    EXPECT_EQ(0, sel[0]);
+    EXPECT_EQ(4, sel[1]);
+
+    bool flags[5] = {false, false, false, false, false};
+    uint16_t all[5] = {0, 1, 2, 3, 4};
+    LikeColumnPredicate prefix(0, "ap%");
+    prefix.evaluate_or(*column, all, 5, flags);
+    EXPECT_FALSE(flags[0]);
+    EXPECT_TRUE(flags[1]);
+    EXPECT_FALSE(flags[2]);
+    EXPECT_TRUE(flags[3]);
+    EXPECT_FALSE(flags[4]);
+}
+
+} // namespace doris
@@ -224,6 +224,66 @@ static void insert_LRUCache(LRUCache& cache, const CacheKey& key, int value,
     cache.release(cache.insert(key, hash, EncodeValue(value), value, &deleter, priority));
 }
 
+// Returns whether key is hit, and inserts it if not.
+static bool lookup_or_insert_LRUCache(LRUCache& cache, int key) {
+    std::string key_str = std::to_string(key);
+    CacheKey cache_key(key_str);
+    uint32_t hash = cache_key.hash(cache_key.data(), cache_key.size(), 0);
+    auto handle = cache.lookup(cache_key, hash);
+    if (handle != nullptr) {
+        cache.release(handle);
+        return true;
+    }
+    cache.release(cache.insert(cache_key, hash, EncodeValue(key), 1, &deleter));
+    return false;
+}
+
+TEST_F(CacheTest, TinyLFUAdmission) {
+    LRUCache cache(LRUCacheType::NUMBER, CacheEvictionPolicy::TINY_LFU);
+    cache.set_capacity(10);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(lookup_or_insert_LRUCache(cache, i));
+    }
+    EXPECT_EQ(0, cache.get_reject_count());
+
+    // accessed once, not more frequent than the entry to evict
+    EXPECT_FALSE(lookup_or_insert_LRUCache(cache, 100));
+    EXPECT_EQ(1, cache.get_reject_count());
+    EXPECT_EQ(10, cache.get_usage());
+
+    // admitted when accessed again
+    EXPECT_FALSE(lookup_or_insert_LRUCache(cache, 100));
+    EXPECT_EQ(1, cache.get_reject_count());
+    EXPECT_TRUE(lookup_or_insert_LRUCache(cache, 100));
+    EXPECT_EQ(10, cache.get_usage());
+}
+
+TEST_F(CacheTest, TinyLFUScanResistant) {
+    for (auto policy : {CacheEvictionPolicy::LRU, CacheEvictionPolicy::TINY_LFU}) {
+        LRUCache cache(LRUCacheType::NUMBER, policy);
+        cache.set_capacity(100);
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 50; ++i) {
+                lookup_or_insert_LRUCache(cache, i);
+            }
+        }
+        // a scan of the keys accessed once
+        for (int i = 1000; i < 2000; ++i) {
+            lookup_or_insert_LRUCache(cache, i);
+        }
+        int hits = 0;
+        for (int i = 0; i < 50; ++i) {
+            hits += lookup_or_insert_LRUCache(cache, i);
+        }
+        if (policy == CacheEvictionPolicy::LRU) {
+            EXPECT_EQ(0, hits);
+        } else {
+            EXPECT_EQ(50, hits);
+        }
+        EXPECT_LE(cache.get_usage(), 100);
+    }
+}
+
 TEST_F(CacheTest, Usage) {
     LRUCache cache(LRUCacheType::SIZE);
     cache.set_capacity(1040);
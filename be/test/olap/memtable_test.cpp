@@ -0,0 +1,264 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/memtable.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "olap/schema.h"
+#include "olap/tablet_schema.h"
+#include "runtime/descriptors.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+static constexpr size_t kNumBlocks = 4;
+static constexpr size_t kRowsPerBlock = 100;
+
+class MemTableTest : public testing::Test {
+public:
+    void SetUp() override { _sort_on_flush = config::enable_memtable_sort_on_flush; }
+    void TearDown() override { config::enable_memtable_sort_on_flush = _sort_on_flush; }
+
+protected:
+    static TabletColumn create_column(int32_t unique_id, FieldType type, bool is_key,
+                                      FieldAggregationMethod aggregation, bool is_nullable) {
+        TabletColumn column;
+        column._unique_id = unique_id;
+        column._col_name = std::to_string(unique_id);
+        column._type = type;
+        column._is_key = is_key;
+        column._aggregation = aggregation;
+        column._is_nullable = is_nullable;
+        column._length = type == OLAP_FIELD_TYPE_VARCHAR ? 65533 : 4;
+        column._index_length = 4;
+        return column;
+    }
+
+    // k1 INT, k2 VARCHAR NULL, v1 INT NULL, v2 VARCHAR NULL, v3 INT, and the sequence column
+    // INT if `with_sequence`
+    static TabletSchema create_schema(KeysType keys_type, bool with_sequence) {
+        std::vector<FieldAggregationMethod> aggregations;
+        switch (keys_type) {
+        case DUP_KEYS:
+            aggregations.assign(4, OLAP_FIELD_AGGREGATION_NONE);
+            break;
+        case AGG_KEYS:
+            aggregations = {OLAP_FIELD_AGGREGATION_SUM, OLAP_FIELD_AGGREGATION_REPLACE_IF_NOT_NULL,
+                            OLAP_FIELD_AGGREGATION_MAX, OLAP_FIELD_AGGREGATION_REPLACE};
+            break;
+        default:
+            aggregations.assign(4, OLAP_FIELD_AGGREGATION_REPLACE);
+            break;
+        }
+        TabletSchema schema;
+        schema._keys_type = keys_type;
+        schema._cols.push_back(create_column(0, OLAP_FIELD_TYPE_INT, true,
+                                             OLAP_FIELD_AGGREGATION_NONE, false));
+        schema._cols.push_back(create_column(1, OLAP_FIELD_TYPE_VARCHAR, true,
+                                             OLAP_FIELD_AGGREGATION_NONE, true));
+        schema._cols.push_back(create_column(2, OLAP_FIELD_TYPE_INT, false, aggregations[0], true));
+        schema._cols.push_back(
+                create_column(3, OLAP_FIELD_TYPE_VARCHAR, false, aggregations[1], true));
+        schema._cols.push_back(
+                create_column(4, OLAP_FIELD_TYPE_INT, false, aggregations[2], false));
+        if (with_sequence) {
+            schema._cols.push_back(
+                    create_column(5, OLAP_FIELD_TYPE_INT, false, aggregations[3], false));
+            schema._sequence_col_idx = 5;
+        }
+        schema._num_columns = schema._cols.size();
+        schema._num_key_columns = 2;
+        schema._num_short_key_columns = 2;
+        schema.init_field_index_for_test();
+        return schema;
+    }
+
+    // The rows [block_id * kRowsPerBlock, (block_id + 1) * kRowsPerBlock), of many duplicated
+    // keys with null k2, null values and unordered sequences. v3 is the row number.
+    static vectorized::Block create_block(const TabletSchema& tablet_schema, size_t block_id) {
+        vectorized::Block block = tablet_schema.create_block();
+        auto columns = block.mutate_columns();
+        for (size_t i = 0; i < kRowsPerBlock; ++i) {
+            size_t row = block_id * kRowsPerBlock + i;
+            columns[0]->insert(vectorized::Field(Int64(row * 7 % 13)));
+            if (row % 4 == 0) {
+                columns[1]->insert_default();
+            } else {
+                columns[1]->insert(vectorized::Field(std::to_string(row % 3)));
+            }
+            if (row % 5 == 0) {
+                columns[2]->insert_default();
+            } else {
+                columns[2]->insert(vectorized::Field(Int64(row)));
+            }
+            if (row % 3 == 0) {
+                columns[3]->insert_default();
+            } else {
+                columns[3]->insert(vectorized::Field("v" + std::to_string(row)));
+            }
+            columns[4]->insert(vectorized::Field(Int64(row)));
+            if (tablet_schema.has_sequence_col()) {
+                columns[5]->insert(vectorized::Field(Int64(row * 11 % 7)));
+            }
+        }
+        block.set_columns(std::move(columns));
+        return block;
+    }
+
+    // Loads all the blocks into a memtable, shrinking it by aggregation after each block if
+    // `shrink`, so that the aggregated rows are loaded again with the following blocks.
+    // Returns the rows to flush.
+    static vectorized::Block load(const TabletSchema& tablet_schema, bool sort_on_flush,
+                                  bool shrink) {
+        config::enable_memtable_sort_on_flush = sort_on_flush;
+        Schema schema(tablet_schema);
+        ObjectPool object_pool;
+        DescriptorTblBuilder builder(&object_pool);
+        auto& tuple_builder = builder.declare_tuple();
+        for (const auto& column : tablet_schema.columns()) {
+            if (column.type() == OLAP_FIELD_TYPE_VARCHAR) {
+                tuple_builder << TypeDescriptor::create_varchar_type(column.length());
+            } else {
+                tuple_builder << TYPE_INT;
+            }
+        }
+        DescriptorTbl* desc_tbl = builder.build();
+        auto* tuple_desc = const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+        MemTable memtable(0, &schema, &tablet_schema, &tuple_desc->slots(), tuple_desc,
+                          tablet_schema.keys_type(), nullptr, nullptr, true);
+        EXPECT_EQ(sort_on_flush, memtable._sort_on_flush);
+        for (size_t block_id = 0; block_id < kNumBlocks; ++block_id) {
+            vectorized::Block block = create_block(tablet_schema, block_id);
+            std::vector<int> row_idxs(block.rows());
+            std::iota(row_idxs.begin(), row_idxs.end(), 0);
+            memtable.insert(&block, row_idxs);
+            if (shrink) {
+                memtable.shrink_memtable_by_agg();
+            }
+        }
+        if (sort_on_flush) {
+            memtable._sort_and_collect_results<true>();
+        } else {
+            memtable._collect_vskiplist_results<true>();
+        }
+        return memtable._output_mutable_block.to_block();
+    }
+
+    // the rows of the first `num_columns` columns of the block
+    static std::vector<std::string> to_rows(const vectorized::Block& block, size_t num_columns) {
+        std::vector<std::string> rows;
+        for (size_t i = 0; i < block.rows(); ++i) {
+            std::string row;
+            for (size_t cid = 0; cid < num_columns; ++cid) {
+                const auto& column = block.get_by_position(cid);
+                row += column.type->to_string(*column.column, i) + "|";
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    // The rows sorted on flush are the rows of the skiplist, with or without shrinking.
+    static void check(KeysType keys_type, bool with_sequence) {
+        TabletSchema tablet_schema = create_schema(keys_type, with_sequence);
+        size_t num_columns = tablet_schema.num_columns();
+        auto expected = load(tablet_schema, false, false);
+        auto expected_rows = to_rows(expected, num_columns);
+        if (keys_type != DUP_KEYS) {
+            // many rows are aggregated
+            EXPECT_LT(expected.rows(), kNumBlocks * kRowsPerBlock / 4);
+        }
+        if (keys_type == UNIQUE_KEYS && with_sequence) {
+            // the last loaded row of the largest sequence of each key is kept
+            std::map<std::string, std::pair<int64_t, int64_t>> kept_rows;
+            for (int64_t row = 0; row < int64_t(kNumBlocks * kRowsPerBlock); ++row) {
+                std::string key = fmt::format("{}|{}|", row * 7 % 13,
+                                              row % 4 == 0 ? "NULL" : std::to_string(row % 3));
+                int64_t sequence = row * 11 % 7;
+                auto it = kept_rows.emplace(key, std::make_pair(sequence, row)).first;
+                if (sequence >= it->second.first) {
+                    it->second = {sequence, row};
+                }
+            }
+            auto keys = to_rows(expected, tablet_schema.num_key_columns());
+            ASSERT_EQ(kept_rows.size(), keys.size());
+            const auto& v3 = *expected.get_by_position(4).column;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                EXPECT_EQ(kept_rows[keys[i]].second, v3[i].get<Int64>()) << keys[i];
+            }
+        }
+        for (bool sort_on_flush : {false, true}) {
+            for (bool shrink : {false, true}) {
+                SCOPED_TRACE(fmt::format("sort_on_flush: {}, shrink: {}", sort_on_flush, shrink));
+                auto result = load(tablet_schema, sort_on_flush, shrink);
+                auto rows = to_rows(result, num_columns);
+                if (keys_type != DUP_KEYS) {
+                    EXPECT_EQ(expected_rows, rows);
+                    continue;
+                }
+                // the keys are in the same order, the rows of the same key may not
+                EXPECT_EQ(to_rows(expected, tablet_schema.num_key_columns()),
+                          to_rows(result, tablet_schema.num_key_columns()));
+                auto sorted_expected_rows = expected_rows;
+                std::sort(sorted_expected_rows.begin(), sorted_expected_rows.end());
+                std::sort(rows.begin(), rows.end());
+                EXPECT_EQ(sorted_expected_rows, rows);
+                if (sort_on_flush) {
+                    // the rows of the same key are sorted stably, in load order
+                    auto keys = to_rows(result, tablet_schema.num_key_columns());
+                    const auto& v3 = *result.get_by_position(4).column;
+                    for (size_t i = 1; i < result.rows(); ++i) {
+                        if (keys[i - 1] == keys[i]) {
+                            EXPECT_LT(v3[i - 1].get<Int64>(), v3[i].get<Int64>());
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    bool _sort_on_flush;
+};
+
+TEST_F(MemTableTest, sort_on_flush_dup_keys) {
+    check(DUP_KEYS, false);
+    check(DUP_KEYS, true);
+}
+
+TEST_F(MemTableTest, sort_on_flush_agg_keys) {
+    check(AGG_KEYS, false);
+    check(AGG_KEYS, true);
+}
+
+TEST_F(MemTableTest, sort_on_flush_unique_keys) {
+    check(UNIQUE_KEYS, false);
+    check(UNIQUE_KEYS, true);
+}
+
+} // namespace doris
@@ -78,6 +78,21 @@ TEST_F(OlapMetaTest, TestPutAndGet) {
     EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_META_KEY_NOT_FOUND), s);
 }
 
+TEST_F(OlapMetaTest, TestBatchPut) {
+    std::vector<std::pair<std::string, std::string>> entries;
+    for (int i = 0; i < 10; i++) {
+        entries.emplace_back("batch_key_" + std::to_string(i), "value_" + std::to_string(i));
+    }
+    Status s = _meta->put(META_COLUMN_FAMILY_INDEX, entries);
+    EXPECT_EQ(Status::OK(), s);
+    for (auto& [key, value] : entries) {
+        std::string value_get;
+        s = _meta->get(META_COLUMN_FAMILY_INDEX, key, &value_get);
+        EXPECT_EQ(Status::OK(), s);
+        EXPECT_EQ(value, value_get);
+    }
+}
+
 TEST_F(OlapMetaTest, TestRemove) {
     // normal cases
     std::string key = "key";
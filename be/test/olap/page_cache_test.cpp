@@ -245,4 +245,26 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+TEST(StoragePageCacheTest, decoded_page) {
+    DecodedPageCache cache(kNumShards * 2048, kNumShards);
+    StoragePageCache::CacheKey key("abc", 0);
+
+    PageCacheHandle handle;
+    EXPECT_FALSE(cache.lookup(key, &handle));
+
+    char* buf = new char[1024];
+    {
+        PageCacheHandle insert_handle;
+        cache.insert(key, Slice(buf, 1024), &insert_handle);
+        EXPECT_EQ(buf, insert_handle.data().data);
+    }
+    EXPECT_TRUE(cache.lookup(key, &handle));
+    EXPECT_EQ(buf, handle.data().data);
+    EXPECT_EQ(1024, handle.data().size);
+
+    // another offset of the same file
+    PageCacheHandle other_handle;
+    EXPECT_FALSE(cache.lookup(StoragePageCache::CacheKey("abc", 1024), &other_handle));
+}
+
 } // namespace doris
@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/page_cache_warmer.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "io/fs/local_file_system.h"
+
+namespace doris {
+
+static const std::string kTestDir = "./ut_dir/page_cache_warmer_test";
+
+class PageCacheWarmerTest : public testing::Test {
+public:
+    void SetUp() override {
+        std::filesystem::remove_all(kTestDir);
+        std::filesystem::create_directories(kTestDir);
+    }
+    void TearDown() override { std::filesystem::remove_all(kTestDir); }
+
+    static PageCacheWarmer::PageInfo page_info(uint32_t size) {
+        PageCacheWarmer::PageInfo info;
+        info.size = size;
+        info.type = segment_v2::DATA_PAGE;
+        info.compression = segment_v2::LZ4F;
+        info.field_type = OLAP_FIELD_TYPE_INT;
+        info.encoding = segment_v2::BIT_SHUFFLE;
+        info.kept_in_memory = false;
+        return info;
+    }
+};
+
+TEST_F(PageCacheWarmerTest, add_and_remove) {
+    PageCacheWarmer warmer(2);
+    StoragePageCache::CacheKey key1(kTestDir + "/a.dat", 0);
+    StoragePageCache::CacheKey key2(kTestDir + "/a.dat", 100);
+    StoragePageCache::CacheKey key3(kTestDir + "/b.dat", 0);
+    warmer.add(key1, page_info(100));
+    warmer.add(key2, page_info(50));
+    // full
+    warmer.add(key3, page_info(10));
+    EXPECT_EQ(2, warmer.num_pages());
+
+    std::string encoded = key1.encode();
+    warmer.remove(CacheKey(encoded));
+    EXPECT_EQ(1, warmer.num_pages());
+    warmer.add(key3, page_info(10));
+    EXPECT_EQ(2, warmer.num_pages());
+}
+
+TEST_F(PageCacheWarmerTest, save) {
+    PageCacheWarmer warmer(100);
+    warmer.add(StoragePageCache::CacheKey(kTestDir + "/b.dat", 200), page_info(30));
+    warmer.add(StoragePageCache::CacheKey(kTestDir + "/a.dat", 100), page_info(20));
+    warmer.add(StoragePageCache::CacheKey(kTestDir + "/a.dat", 0), page_info(100));
+    // not in the dir
+    warmer.add(StoragePageCache::CacheKey("./ut_dir/other/c.dat", 0), page_info(10));
+    auto info = page_info(40);
+    info.field_type = OLAP_FIELD_TYPE_UNKNOWN;
+    info.type = segment_v2::INDEX_PAGE;
+    warmer.add(StoragePageCache::CacheKey(kTestDir + "/b.dat", 0), info);
+
+    EXPECT_TRUE(warmer.save(kTestDir).ok());
+
+    segment_v2::CachedPagesPB pages_pb;
+    std::ifstream in(kTestDir + "/" + PageCacheWarmer::PAGES_FILE_NAME, std::ios::binary);
+    ASSERT_TRUE(pages_pb.ParseFromIstream(&in));
+    ASSERT_EQ(2, pages_pb.files_size());
+
+    auto& a = pages_pb.files(0);
+    EXPECT_EQ(kTestDir + "/a.dat", a.path());
+    ASSERT_EQ(2, a.pages_size());
+    EXPECT_EQ(0, a.pages(0).offset());
+    EXPECT_EQ(100, a.pages(0).size());
+    EXPECT_EQ(100, a.pages(1).offset());
+    EXPECT_EQ(20, a.pages(1).size());
+    EXPECT_EQ(segment_v2::LZ4F, a.pages(1).compression());
+    EXPECT_EQ(OLAP_FIELD_TYPE_INT, a.pages(1).field_type());
+    EXPECT_EQ(segment_v2::BIT_SHUFFLE, a.pages(1).encoding());
+
+    auto& b = pages_pb.files(1);
+    EXPECT_EQ(kTestDir + "/b.dat", b.path());
+    ASSERT_EQ(2, b.pages_size());
+    EXPECT_EQ(0, b.pages(0).offset());
+    EXPECT_EQ(segment_v2::INDEX_PAGE, b.pages(0).type());
+    EXPECT_FALSE(b.pages(0).has_field_type());
+    EXPECT_EQ(200, b.pages(1).offset());
+}
+
+TEST_F(PageCacheWarmerTest, warm_up_missing_files) {
+    PageCacheWarmer warmer(100);
+    int64_t num_pages = -1;
+    auto fs = io::global_local_filesystem();
+    auto fs_ptr = std::shared_ptr<io::FileSystem>(fs, [](io::FileSystem*) {});
+    // nothing saved
+    EXPECT_TRUE(warmer.warm_up(fs_ptr, kTestDir, [] { return false; }, &num_pages).ok());
+    EXPECT_EQ(0, num_pages);
+
+    // the files are gone, e.g. compacted
+    warmer.add(StoragePageCache::CacheKey(kTestDir + "/a.dat", 0), page_info(100));
+    EXPECT_TRUE(warmer.save(kTestDir).ok());
+    EXPECT_TRUE(warmer.warm_up(fs_ptr, kTestDir, [] { return false; }, &num_pages).ok());
+    EXPECT_EQ(0, num_pages);
+
+    // corrupted
+    std::ofstream(kTestDir + "/" + PageCacheWarmer::PAGES_FILE_NAME) << "corrupted";
+    EXPECT_FALSE(warmer.warm_up(fs_ptr, kTestDir, [] { return false; }, &num_pages).ok());
+}
+
+} // namespace doris
@@ -0,0 +1,294 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gen_cpp/AgentService_types.h"
+#include "olap/delta_writer.h"
+#include "olap/key_coder.h"
+#include "olap/options.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_manager.h"
+#include "olap/txn_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/olap/olap_data_convertor.h"
+
+namespace doris {
+
+static StorageEngine* k_engine = nullptr;
+
+static const std::string kTestDir = "./ut_dir/partial_update_test";
+static const int32_t kSchemaHash = 270068391;
+static const int64_t kPartitionId = 30002;
+
+using Row = std::tuple<int32_t, int32_t, int32_t>;
+
+class PartialUpdateTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        config::storage_root_path = kTestDir;
+        config::min_file_descriptor_number = 100;
+        FileUtils::remove_all(kTestDir);
+        FileUtils::create_dir(kTestDir);
+
+        EngineOptions options;
+        options.store_paths = {{kTestDir, -1}};
+        Status st = StorageEngine::open(options, &k_engine);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(k_engine);
+    }
+
+    static void TearDownTestSuite() {
+        if (k_engine != nullptr) {
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        FileUtils::remove_all(kTestDir);
+    }
+
+protected:
+    void SetUp() override {
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        for (const char* name : {"k1", "v1", "v2"}) {
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                           .column_name(name).column_pos(_num_slots++).build());
+        }
+        tuple_builder.build(&table_builder);
+        ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+    }
+
+    // unique key table of (k1 INT, v1 INT DEFAULT 0, v2 INT DEFAULT 0) with merge-on-write
+    void create_tablet(int64_t tablet_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::UNIQUE_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+        request.__set_enable_unique_key_merge_on_write(true);
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(k1);
+        for (const char* name : {"v1", "v2"}) {
+            TColumn value;
+            value.column_name = name;
+            value.__set_is_key(false);
+            value.column_type.type = TPrimitiveType::INT;
+            value.__set_aggregation_type(TAggregationType::REPLACE);
+            value.__set_default_value("0");
+            request.tablet_schema.columns.push_back(value);
+        }
+
+        Status st = k_engine->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+
+    // Opens a writer of a load and writes the rows, a partial update only provides k1 and v1,
+    // whose v2 is the default value filled by the planner.
+    std::unique_ptr<DeltaWriter> write(int64_t tablet_id, int64_t txn_id,
+                                       const std::vector<Row>& rows, bool is_partial_update) {
+        auto tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+        PUniqueId load_id;
+        load_id.set_hi(0);
+        load_id.set_lo(txn_id);
+        WriteRequest write_req = {tablet_id,     kSchemaHash, WriteType::LOAD,        txn_id,
+                                  kPartitionId, load_id,     tuple_desc, &(tuple_desc->slots())};
+        write_req.is_partial_update = is_partial_update;
+        write_req.partial_update_input_columns = &_partial_update_input_columns;
+        DeltaWriter* writer = nullptr;
+        EXPECT_TRUE(DeltaWriter::open(&write_req, &writer, true).ok());
+        std::unique_ptr<DeltaWriter> writer_guard(writer);
+
+        vectorized::Block block;
+        for (const auto& slot_desc : tuple_desc->slots()) {
+            block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                          slot_desc->col_name()});
+        }
+        auto columns = block.mutate_columns();
+        std::vector<int> row_idxs;
+        for (const auto& [key, v1, v2] : rows) {
+            int32_t value2 = is_partial_update ? 0 : v2;
+            columns[0]->insert_data(reinterpret_cast<const char*>(&key), sizeof(key));
+            columns[1]->insert_data(reinterpret_cast<const char*>(&v1), sizeof(v1));
+            columns[2]->insert_data(reinterpret_cast<const char*>(&value2), sizeof(value2));
+            row_idxs.push_back(row_idxs.size());
+        }
+        block.set_columns(std::move(columns));
+        EXPECT_TRUE(writer->write(&block, row_idxs).ok());
+        return writer_guard;
+    }
+
+    // Closes the writer and publishes the txn as the next version, the rowset of the load has
+    // `delete_predicate` if not null.
+    void publish(int64_t tablet_id, int64_t txn_id, std::unique_ptr<DeltaWriter> writer,
+                 const DeletePredicatePB* delete_predicate = nullptr) {
+        ASSERT_TRUE(writer->close().ok());
+        ASSERT_TRUE(writer->close_wait().ok());
+
+        auto tablet = k_engine->tablet_manager()->get_tablet(tablet_id);
+        ASSERT_NE(tablet, nullptr);
+        int64_t version = tablet->max_version().second + 1;
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        k_engine->txn_manager()->get_txn_related_tablets(txn_id, kPartitionId,
+                                                         &tablet_related_rs);
+        ASSERT_EQ(1, tablet_related_rs.size());
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            if (delete_predicate != nullptr) {
+                rowset->rowset_meta()->set_delete_predicate(*delete_predicate);
+            }
+            ASSERT_TRUE(k_engine->txn_manager()
+                                ->publish_txn(tablet->data_dir()->get_meta(), kPartitionId,
+                                              txn_id, tablet_id, kSchemaHash,
+                                              tablet_info.tablet_uid, {version, version})
+                                .ok());
+            Status st = tablet->add_inc_rowset(rowset);
+            ASSERT_TRUE(st.ok()) << st.to_string();
+        }
+    }
+
+    void load(int64_t tablet_id, int64_t txn_id, const std::vector<Row>& rows,
+              bool is_partial_update = false, const DeletePredicatePB* delete_predicate = nullptr) {
+        publish(tablet_id, txn_id, write(tablet_id, txn_id, rows, is_partial_update),
+                delete_predicate);
+    }
+
+    // Reads the latest (v1, v2) of the keys, or (-1, -1) for the keys not found.
+    std::vector<Row> read(int64_t tablet_id, const std::vector<int32_t>& keys) {
+        auto tablet = k_engine->tablet_manager()->get_tablet(tablet_id);
+        EXPECT_NE(tablet, nullptr);
+        const auto& schema = tablet->tablet_schema();
+        std::vector<const KeyCoder*> key_coders = {get_key_coder(OLAP_FIELD_TYPE_INT)};
+        std::vector<std::string> encoded_keys;
+        auto key_column = vectorized::ColumnInt32::create();
+        for (int32_t key : keys) {
+            encoded_keys.push_back(
+                    segment_v2::SegmentWriter::full_encode_keys(schema, key_coders, {&key}));
+            key_column->insert_value(key);
+        }
+        vectorized::Block key_block;
+        key_block.insert({std::move(key_column), std::make_shared<vectorized::DataTypeInt32>(),
+                          "k1"});
+        vectorized::OlapBlockDataConvertor convertor(&schema, {0});
+        convertor.set_source_content(&key_block, 0, keys.size());
+        auto converted_result = convertor.convert_column_data(0);
+        EXPECT_TRUE(converted_result.first.ok());
+
+        std::vector<RowsetSharedPtr> rowsets;
+        int64_t version = 0;
+        tablet->capture_rowsets_for_lookup(&rowsets, &version);
+        vectorized::MutableColumns columns;
+        columns.push_back(vectorized::ColumnInt32::create());
+        columns.push_back(vectorized::ColumnInt32::create());
+        std::vector<bool> found;
+        Status st = tablet->read_latest_rows(encoded_keys, {converted_result.second}, rowsets,
+                                             version, {1, 2}, &columns, &found);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+
+        std::vector<Row> rows;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (found[i]) {
+                rows.emplace_back(keys[i], columns[0]->get_int(i), columns[1]->get_int(i));
+            } else {
+                rows.emplace_back(keys[i], -1, -1);
+            }
+        }
+        return rows;
+    }
+
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    int _num_slots = 0;
+    std::set<std::string> _partial_update_input_columns = {"k1", "v1"};
+};
+
+TEST_F(PartialUpdateTest, existing_and_new_keys) {
+    const int64_t tablet_id = 15101;
+    create_tablet(tablet_id);
+    load(tablet_id, 20101, {{1, 10, 100}, {2, 20, 200}});
+    // v2 of key 1 is read from the first load, key 3 is new and has the default value
+    load(tablet_id, 20102, {{1, 11, 0}, {3, 31, 0}}, true);
+
+    std::vector<Row> expected = {{1, 11, 100}, {2, 20, 200}, {3, 31, 0}, {4, -1, -1}};
+    EXPECT_EQ(expected, read(tablet_id, {1, 2, 3, 4}));
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+TEST_F(PartialUpdateTest, concurrent_load) {
+    const int64_t tablet_id = 15102;
+    create_tablet(tablet_id);
+    load(tablet_id, 20103, {{1, 10, 100}, {2, 20, 200}});
+    // the partial update reads the rowsets of version 2 when it starts
+    auto writer = write(tablet_id, 20104, {{1, 11, 0}, {2, 21, 0}, {3, 31, 0}}, true);
+    // published as version 3 before the partial update
+    load(tablet_id, 20105, {{1, 12, 120}, {3, 32, 320}});
+    // v2 of key 1 and 3 are read again from version 3 when the partial update is published
+    publish(tablet_id, 20104, std::move(writer));
+
+    std::vector<Row> expected = {{1, 11, 120}, {2, 21, 200}, {3, 31, 320}};
+    EXPECT_EQ(expected, read(tablet_id, {1, 2, 3}));
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+TEST_F(PartialUpdateTest, delete_predicate) {
+    const int64_t tablet_id = 15103;
+    create_tablet(tablet_id);
+    load(tablet_id, 20106, {{1, 10, 100}, {2, 20, 200}, {3, 30, 300}});
+    DeletePredicatePB delete_key1;
+    delete_key1.set_version(3);
+    delete_key1.add_sub_predicates("k1=1");
+    load(tablet_id, 20107, {{5, 50, 500}}, false, &delete_key1);
+
+    // key 1 is deleted before the partial update starts
+    auto writer = write(tablet_id, 20108, {{1, 11, 0}, {2, 21, 0}}, true);
+    // key 2 is deleted after the partial update starts
+    DeletePredicatePB delete_key2;
+    delete_key2.set_version(4);
+    delete_key2.add_sub_predicates("k1=2");
+    load(tablet_id, 20109, {{6, 60, 600}}, false, &delete_key2);
+    publish(tablet_id, 20108, std::move(writer));
+
+    std::vector<Row> expected = {{1, 11, 0}, {2, 21, 0}, {3, 30, 300}, {5, 50, 500},
+                                 {6, 60, 600}};
+    EXPECT_EQ(expected, read(tablet_id, {1, 2, 3, 5, 6}));
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+} // namespace doris
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/row_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris {
+
+static std::shared_ptr<const vectorized::Block> make_row(int32_t value) {
+    auto column = vectorized::ColumnInt32::create();
+    column->insert_value(value);
+    auto block = std::make_shared<vectorized::Block>();
+    block->insert({std::move(column), std::make_shared<vectorized::DataTypeInt32>(), "k1"});
+    return block;
+}
+
+static int32_t value_of(const vectorized::Block& row) {
+    return row.get_by_position(0).column->get_int(0);
+}
+
+TEST(RowCacheTest, lookup) {
+    RowCache cache(1024 * 1024);
+    RowsetId rowset_id;
+    rowset_id.init(10001);
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 1}));
+
+    cache.insert({rowset_id, 0, 1}, make_row(100));
+    auto row = cache.lookup({rowset_id, 0, 1});
+    ASSERT_NE(nullptr, row);
+    EXPECT_EQ(100, value_of(*row));
+
+    // the other rows of the same segment, the same rows of the other segments and rowsets
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 2}));
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 1, 1}));
+    RowsetId other_rowset_id;
+    other_rowset_id.init(10002);
+    EXPECT_EQ(nullptr, cache.lookup({other_rowset_id, 0, 1}));
+}
+
+TEST(RowCacheTest, evict) {
+    // the rows are charged by their memory, a few KB for each of the 16 shards
+    RowCache cache(16 * 4096);
+    RowsetId rowset_id;
+    rowset_id.init(10001);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        cache.insert({rowset_id, 0, i}, make_row(i));
+    }
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 0}));
+    auto row = cache.lookup({rowset_id, 0, 9999});
+    ASSERT_NE(nullptr, row);
+
+    for (uint32_t i = 10000; i < 20000; ++i) {
+        cache.insert({rowset_id, 0, i}, make_row(i));
+    }
+    EXPECT_EQ(nullptr, cache.lookup({rowset_id, 0, 9999}));
+    // the evicted rows are kept by their users
+    EXPECT_EQ(9999, value_of(*row));
+}
+
+} // namespace doris
@@ -424,6 +424,198 @@ class S3ClientMockGetErrorData : public S3ClientMock {
     }
 };
 
+TEST_F(BetaRowsetTest, SegmentsKeyBoundsTest) {
+    Status s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetSharedPtr rowset;
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 100;
+    { // segment "i" contains k1 in [i * 100, i * 100 + 99]
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        RowCursor input_row;
+        input_row.init(tablet_schema);
+        for (int i = 0; i < num_segments; ++i) {
+            MemPool mem_pool("BetaRowsetTest");
+            for (int rid = 0; rid < rows_per_segment; ++rid) {
+                uint32_t k1 = rows_per_segment * i + rid;
+                uint32_t k2 = k1 * 10;
+                uint32_t k3 = rid;
+                input_row.set_field_content(0, reinterpret_cast<char*>(&k1), &mem_pool);
+                input_row.set_field_content(1, reinterpret_cast<char*>(&k2), &mem_pool);
+                input_row.set_field_content(2, reinterpret_cast<char*>(&k3), &mem_pool);
+                s = rowset_writer->add_row(input_row);
+                EXPECT_EQ(Status::OK(), s);
+            }
+            s = rowset_writer->flush();
+            EXPECT_EQ(Status::OK(), s);
+        }
+
+        rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        auto rowset_meta = rowset->rowset_meta();
+        EXPECT_TRUE(rowset_meta->has_segments_key_bounds());
+        for (int i = 0; i < num_segments; ++i) {
+            EXPECT_LT(rowset_meta->segment_key_bounds(i).min_key(),
+                      rowset_meta->segment_key_bounds(i).max_key());
+        }
+        EXPECT_LT(rowset_meta->segment_key_bounds(0).max_key(),
+                  rowset_meta->segment_key_bounds(1).min_key());
+    }
+
+    { // link the segments into a new rowset
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.rowset_id.init(10001);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+        s = rowset_writer->add_rowset(rowset);
+        EXPECT_EQ(Status::OK(), s);
+        s = rowset_writer->flush();
+        EXPECT_EQ(Status::OK(), s);
+
+        auto linked_rowset = rowset_writer->build();
+        EXPECT_TRUE(linked_rowset != nullptr);
+        auto linked_meta = linked_rowset->rowset_meta();
+        EXPECT_EQ(num_segments, linked_meta->num_segments());
+        EXPECT_EQ(num_segments * rows_per_segment, linked_meta->num_rows());
+        EXPECT_TRUE(linked_meta->has_segments_key_bounds());
+        for (int i = 0; i < num_segments; ++i) {
+            EXPECT_EQ(rowset->rowset_meta()->segment_key_bounds(i).min_key(),
+                      linked_meta->segment_key_bounds(i).min_key());
+            EXPECT_EQ(rowset->rowset_meta()->segment_key_bounds(i).max_key(),
+                      linked_meta->segment_key_bounds(i).max_key());
+        }
+    }
+}
+
+TEST_F(BetaRowsetTest, ReservedSegmentIdTest) {
+    Status s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetWriterContext writer_context;
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+    writer_context.rowset_id.init(10002);
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    EXPECT_EQ(Status::OK(), s);
+
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 100;
+    std::vector<int32_t> segment_ids;
+    for (int i = 0; i < num_segments; ++i) {
+        segment_ids.push_back(rowset_writer->allocate_segment_id());
+        EXPECT_EQ(i, segment_ids.back());
+    }
+    // flush the later memtable first, as concurrent flush may do
+    for (int i = num_segments - 1; i >= 0; --i) {
+        vectorized::Block block = tablet_schema.create_block();
+        auto columns = block.mutate_columns();
+        for (uint32_t rid = 0; rid < rows_per_segment; ++rid) {
+            int32_t k1 = rows_per_segment * i + rid;
+            int32_t k2 = k1 * 10;
+            int32_t v1 = rid;
+            columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+            columns[1]->insert_data(reinterpret_cast<const char*>(&k2), sizeof(k2));
+            columns[2]->insert_data(reinterpret_cast<const char*>(&v1), sizeof(v1));
+        }
+        block.set_columns(std::move(columns));
+        s = rowset_writer->flush_single_memtable(&block, segment_ids[i]);
+        EXPECT_EQ(Status::OK(), s);
+    }
+
+    auto rowset = rowset_writer->build();
+    EXPECT_TRUE(rowset != nullptr);
+    auto rowset_meta = rowset->rowset_meta();
+    EXPECT_EQ(num_segments, rowset_meta->num_segments());
+    EXPECT_EQ(num_segments * rows_per_segment, rowset_meta->num_rows());
+    EXPECT_TRUE(rowset_meta->has_segments_key_bounds());
+    // segment ids follow the reserving order instead of the flushing order
+    EXPECT_LT(rowset_meta->segment_key_bounds(0).max_key(),
+              rowset_meta->segment_key_bounds(1).min_key());
+}
+
+TEST_F(BetaRowsetTest, SplitRangeTest) {
+    Status s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetWriterContext writer_context;
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+    writer_context.rowset_id.init(10003);
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    EXPECT_EQ(Status::OK(), s);
+
+    // 2 segments of 4096 rows, there is a short key for every 1024 rows
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 4096;
+    RowCursor input_row;
+    input_row.init(tablet_schema);
+    for (int i = 0; i < num_segments; ++i) {
+        MemPool mem_pool("BetaRowsetTest");
+        for (int rid = 0; rid < rows_per_segment; ++rid) {
+            uint32_t k1 = rows_per_segment * i + rid;
+            uint32_t k2 = k1 * 10;
+            uint32_t k3 = rid;
+            input_row.set_field_content(0, reinterpret_cast<char*>(&k1), &mem_pool);
+            input_row.set_field_content(1, reinterpret_cast<char*>(&k2), &mem_pool);
+            input_row.set_field_content(2, reinterpret_cast<char*>(&k3), &mem_pool);
+            s = rowset_writer->add_row(input_row);
+            EXPECT_EQ(Status::OK(), s);
+        }
+        s = rowset_writer->flush();
+        EXPECT_EQ(Status::OK(), s);
+    }
+    auto rowset = rowset_writer->build();
+    EXPECT_TRUE(rowset != nullptr);
+
+    RowCursor start_key;
+    EXPECT_EQ(Status::OK(), start_key.init(tablet_schema, 2));
+    start_key.allocate_memory_for_string_type(tablet_schema);
+    start_key.build_min_key();
+    RowCursor end_key;
+    EXPECT_EQ(Status::OK(), end_key.init(tablet_schema, 2));
+    end_key.allocate_memory_for_string_type(tablet_schema);
+    end_key.build_max_key();
+
+    // split every 2048 rows, on the short keys of k1 = 2048, 4096 and 6144
+    std::vector<OlapTuple> ranges;
+    s = rowset->split_range(start_key, end_key, 2048, 2, &ranges);
+    EXPECT_EQ(Status::OK(), s);
+    ASSERT_EQ(8, ranges.size());
+    EXPECT_EQ(start_key.to_tuple().get_value(0), ranges[0].get_value(0));
+    EXPECT_EQ(end_key.to_tuple().get_value(0), ranges[7].get_value(0));
+    for (int i = 1; i < 7; i += 2) {
+        EXPECT_EQ(ranges[i].values(), ranges[i + 1].values());
+        EXPECT_EQ(std::to_string(2048 * (i / 2 + 1)), ranges[i].get_value(0));
+    }
+
+    // only the short keys inside the scan range are used
+    RowCursor lower_key;
+    EXPECT_EQ(Status::OK(), lower_key.init_scan_key(tablet_schema, {"4096"}));
+    EXPECT_EQ(Status::OK(), lower_key.from_tuple(OlapTuple({"4096"})));
+    ranges.clear();
+    s = rowset->split_range(lower_key, end_key, 2048, 1, &ranges);
+    EXPECT_EQ(Status::OK(), s);
+    ASSERT_EQ(4, ranges.size());
+    EXPECT_EQ("4096", ranges[0].get_value(0));
+    EXPECT_EQ("6144", ranges[1].get_value(0));
+    EXPECT_EQ("6144", ranges[2].get_value(0));
+}
+
 TEST_F(BetaRowsetTest, ReadTest) {
     RowsetMetaSharedPtr rowset_meta = std::make_shared<RowsetMeta>();
     BetaRowset rowset(nullptr, "", rowset_meta);
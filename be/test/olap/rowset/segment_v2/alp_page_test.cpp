@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include "olap/rowset/segment_v2/options.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+using doris::segment_v2::PageBuilderOptions;
+using doris::segment_v2::PageDecoderOptions;
+
+namespace doris {
+class AlpPageTest : public testing::Test {
+public:
+    template <FieldType Type>
+    void test_encode_decode_page_template(typename TypeTraits<Type>::CppType* src, size_t size,
+                                          size_t* encoded_size = nullptr) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        segment_v2::AlpPageBuilder<Type> page_builder(builder_options);
+        size_t num_added = size;
+        page_builder.add(reinterpret_cast<const uint8_t*>(src), &num_added);
+        EXPECT_EQ(size, num_added);
+        OwnedSlice s = page_builder.finish();
+        EXPECT_EQ(size, page_builder.count());
+        if (encoded_size != nullptr) {
+            *encoded_size = s.slice().size;
+        }
+
+        PageDecoderOptions decoder_options;
+        segment_v2::AlpPageDecoder<Type> page_decoder(s.slice(), decoder_options);
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(size, page_decoder.count());
+        if (size == 0) {
+            return;
+        }
+
+        auto tracker = std::make_shared<MemTracker>();
+        MemPool pool(tracker.get());
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        ColumnVectorBatch::create(size, true, get_scalar_type_info(Type), nullptr, &cvb);
+        ColumnBlock block(cvb.get(), &pool);
+        ColumnBlockView column_block_view(&block);
+        size_t size_to_fetch = size;
+        EXPECT_TRUE(page_decoder.next_batch(&size_to_fetch, &column_block_view).ok());
+        EXPECT_EQ(size, size_to_fetch);
+
+        // compare the bits, so that NaN and -0.0 are checked too
+        CppType* values = reinterpret_cast<CppType*>(column_block_view.data());
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(0, memcmp(&src[i], &values[i], sizeof(CppType))) << "Fail at index " << i;
+        }
+
+        for (int i = 0; i < 100; i++) {
+            size_t seek_off = random() % size;
+            page_decoder.seek_to_position_in_page(seek_off);
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            ColumnBlockView one_view(&block);
+            size_t n = 1;
+            EXPECT_TRUE(page_decoder.next_batch(&n, &one_view).ok());
+            EXPECT_EQ(1, n);
+            EXPECT_EQ(0, memcmp(&src[seek_off], block.cell_ptr(0), sizeof(CppType)));
+        }
+    }
+};
+
+TEST_F(AlpPageTest, TestDoubleMetrics) {
+    const size_t size = 10000;
+    std::unique_ptr<double[]> doubles(new double[size]);
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < size; i++) {
+        // two decimal digits, like a cpu usage
+        doubles[i] = (rng() % 10000) / 100.0;
+    }
+    size_t encoded_size = 0;
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_DOUBLE>(doubles.get(), size, &encoded_size);
+    // 14 bits for each value
+    EXPECT_LT(encoded_size, size * sizeof(double) / 4);
+}
+
+TEST_F(AlpPageTest, TestFloatMetrics) {
+    const size_t size = 10000;
+    std::unique_ptr<float[]> floats(new float[size]);
+    for (size_t i = 0; i < size; i++) {
+        floats[i] = 20.5f + (i % 300) / 10.0f;
+    }
+    size_t encoded_size = 0;
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_FLOAT>(floats.get(), size, &encoded_size);
+    EXPECT_LT(encoded_size, size * sizeof(float) / 2);
+}
+
+TEST_F(AlpPageTest, TestExceptions) {
+    const size_t size = 1000;
+    std::unique_ptr<double[]> doubles(new double[size]);
+    for (size_t i = 0; i < size; i++) {
+        doubles[i] = i * 0.5;
+    }
+    doubles[3] = std::numeric_limits<double>::quiet_NaN();
+    doubles[10] = -0.0;
+    doubles[100] = std::numeric_limits<double>::infinity();
+    doubles[500] = -std::numeric_limits<double>::max();
+    doubles[999] = M_PI;
+    size_t encoded_size = 0;
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_DOUBLE>(doubles.get(), size, &encoded_size);
+    EXPECT_LT(encoded_size, size * sizeof(double) / 2);
+}
+
+TEST_F(AlpPageTest, TestRandomBits) {
+    const size_t size = 1000;
+    std::unique_ptr<double[]> doubles(new double[size]);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < size; i++) {
+        uint64_t bits = rng();
+        memcpy(&doubles[i], &bits, sizeof(double));
+    }
+    size_t encoded_size = 0;
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_DOUBLE>(doubles.get(), size, &encoded_size);
+    // stored as the raw values
+    EXPECT_EQ(size * sizeof(double) + segment_v2::ALP_PAGE_HEADER_SIZE + BitPacking::PADDING_BYTES,
+              encoded_size);
+}
+
+TEST_F(AlpPageTest, TestEmptyPage) {
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_DOUBLE>(nullptr, 0);
+}
+
+} // namespace doris
@@ -0,0 +1,169 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/binary_fsst_page.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "olap/olap_common.h"
+#include "olap/types.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "util/fsst.h"
+
+namespace doris {
+namespace segment_v2 {
+
+class BinaryFsstPageTest : public testing::Test {
+public:
+    static std::vector<std::string> make_values(size_t num) {
+        std::vector<std::string> values;
+        for (size_t i = 0; i < num; ++i) {
+            values.push_back("http://www.example.com/path/to/item?id=" + std::to_string(i * 7));
+        }
+        values.push_back("");
+        values.push_back(std::string("\xff\x00\xfe", 3));
+        return values;
+    }
+
+    static OwnedSlice build_page(const std::vector<std::string>& values,
+                                 BinaryFsstPageBuilder* builder) {
+        std::vector<Slice> slices(values.begin(), values.end());
+        size_t count = slices.size();
+        EXPECT_TRUE(builder->add(reinterpret_cast<const uint8_t*>(slices.data()), &count).ok());
+        EXPECT_EQ(slices.size(), count);
+        return builder->finish();
+    }
+};
+
+TEST_F(BinaryFsstPageTest, TestSymbolTable) {
+    std::vector<std::string> values = make_values(1000);
+    std::vector<Slice> samples(values.begin(), values.end());
+    FsstSymbolTable table;
+    table.build(samples);
+    EXPECT_GT(table.num_symbols(), 0);
+
+    faststring serialized;
+    table.serialize(&serialized);
+    FsstSymbolTable table2;
+    size_t size = 0;
+    EXPECT_TRUE(table2.deserialize(Slice(serialized.data(), serialized.size()), &size).ok());
+    EXPECT_EQ(serialized.size(), size);
+    EXPECT_EQ(table.num_symbols(), table2.num_symbols());
+
+    size_t raw_size = 0;
+    size_t compressed_size = 0;
+    for (auto& value : values) {
+        faststring compressed;
+        table.compress(value, &compressed);
+        std::vector<uint8_t> buf(FsstSymbolTable::max_decompressed_size(compressed.size()));
+        size_t len = table2.decompress(Slice(compressed.data(), compressed.size()), buf.data());
+        EXPECT_EQ(value, std::string((char*)buf.data(), len));
+        raw_size += value.size();
+        compressed_size += compressed.size();
+    }
+    EXPECT_LT(compressed_size * 2, raw_size);
+
+    EXPECT_FALSE(table2.deserialize(Slice(serialized.data(), serialized.size() - 1), &size).ok());
+}
+
+TEST_F(BinaryFsstPageTest, TestRoundTrip) {
+    std::vector<std::string> values = make_values(1000);
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    BinaryFsstPageBuilder builder(options);
+    OwnedSlice page = build_page(values, &builder);
+    EXPECT_LT(page.slice().size, builder.size());
+
+    Slice first_value;
+    EXPECT_TRUE(builder.get_first_value(&first_value).ok());
+    EXPECT_EQ(values.front(), first_value.to_string());
+    Slice last_value;
+    EXPECT_TRUE(builder.get_last_value(&last_value).ok());
+    EXPECT_EQ(values.back(), last_value.to_string());
+
+    BinaryFsstPageDecoder decoder(page.slice(), PageDecoderOptions());
+    EXPECT_TRUE(decoder.init().ok());
+    EXPECT_EQ(values.size(), decoder.count());
+
+    auto tracker = std::make_shared<MemTracker>();
+    MemPool pool(tracker.get());
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    ColumnVectorBatch::create(values.size(), false, get_scalar_type_info(OLAP_FIELD_TYPE_VARCHAR),
+                              nullptr, &cvb);
+    ColumnBlock block(cvb.get(), &pool);
+    ColumnBlockView block_view(&block);
+    size_t n = values.size();
+    EXPECT_TRUE(decoder.next_batch(&n, &block_view).ok());
+    EXPECT_EQ(values.size(), n);
+    Slice* decoded = reinterpret_cast<Slice*>(block.data());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(values[i], decoded[i].to_string());
+    }
+
+    // seek and read a batch in the middle of the page
+    EXPECT_TRUE(decoder.seek_to_position_in_page(500).ok());
+    ColumnBlockView block_view2(&block);
+    n = 10;
+    EXPECT_TRUE(decoder.next_batch(&n, &block_view2).ok());
+    EXPECT_EQ(10, n);
+    EXPECT_EQ(510, decoder.current_index());
+    decoded = reinterpret_cast<Slice*>(block.data());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(values[500 + i], decoded[i].to_string());
+    }
+}
+
+TEST_F(BinaryFsstPageTest, TestCompressedPredicates) {
+    std::vector<std::string> values = make_values(100);
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    BinaryFsstPageBuilder builder(options);
+    OwnedSlice page = build_page(values, &builder);
+
+    BinaryFsstPageDecoder decoder(page.slice(), PageDecoderOptions());
+    EXPECT_TRUE(decoder.init().ok());
+
+    faststring compressed;
+    decoder.compress_value(values[42], &compressed);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i] == values[42], decoder.compressed_equals(i, compressed));
+    }
+    EXPECT_TRUE(decoder.starts_with(42, Slice("http://www.example.com/")));
+    EXPECT_TRUE(decoder.starts_with(42, Slice(values[42])));
+    EXPECT_FALSE(decoder.starts_with(42, Slice("https://")));
+    EXPECT_FALSE(decoder.starts_with(100, Slice("http")));
+}
+
+TEST_F(BinaryFsstPageTest, TestEmptyPage) {
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    BinaryFsstPageBuilder builder(options);
+    OwnedSlice page = builder.finish();
+    Slice value;
+    EXPECT_FALSE(builder.get_first_value(&value).ok());
+
+    BinaryFsstPageDecoder decoder(page.slice(), PageDecoderOptions());
+    EXPECT_TRUE(decoder.init().ok());
+    EXPECT_EQ(0, decoder.count());
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "common/logging.h"
 #include "env/env.h"
 #include "io/fs/file_system.h"
@@ -289,5 +292,52 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram_bloom_filter) {
+    std::vector<std::string> strings;
+    for (int i = 0; i < 2048; ++i) {
+        strings.push_back("trace-" + std::to_string(i * 7));
+    }
+    std::vector<Slice> values(strings.begin(), strings.end());
+    const auto* type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+    std::string fname = dname + "/ngram_bloom_filter";
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<io::FileWriter> file_writer;
+        EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        EXPECT_TRUE(
+                BloomFilterIndexWriter::create_ngram(BloomFilterOptions(), type_info, 3, &writer)
+                        .ok());
+        // two pages
+        writer->add_values(values.data(), 1024);
+        EXPECT_TRUE(writer->flush().ok());
+        writer->add_values(values.data() + 1024, 1024);
+        EXPECT_TRUE(writer->finish(file_writer.get(), &meta).ok());
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+    EXPECT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+    EXPECT_EQ(3, meta.ngram_bloom_filter_index().gram_size());
+
+    BloomFilterIndexReader reader(io::global_local_filesystem(), fname,
+                                  &meta.ngram_bloom_filter_index());
+    EXPECT_TRUE(reader.load(true, false).ok());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    EXPECT_TRUE(reader.new_iterator(&iter).ok());
+
+    std::unique_ptr<BloomFilter> bf;
+    EXPECT_TRUE(iter->read_bloom_filter(0, &bf).ok());
+    for (int i = 0; i < 1024; ++i) {
+        for_each_ngram(strings[i].data(), strings[i].size(), 3, [&](const char* gram, size_t len) {
+            EXPECT_TRUE(bf->test_bytes(const_cast<char*>(gram), len));
+        });
+    }
+    EXPECT_TRUE(iter->read_bloom_filter(1, &bf).ok());
+    for (int i = 1024; i < 2048; ++i) {
+        for_each_ngram(strings[i].data(), strings[i].size(), 3, [&](const char* gram, size_t len) {
+            EXPECT_TRUE(bf->test_bytes(const_cast<char*>(gram), len));
+        });
+    }
+}
+
 } // namespace segment_v2
 } // namespace doris
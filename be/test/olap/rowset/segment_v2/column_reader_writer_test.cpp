@@ -77,7 +77,8 @@ private:
 
 template <FieldType type, EncodingTypePB encoding>
 void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
-                        std::string test_name) {
+                        std::string test_name,
+                        CompressionTypePB compression = segment_v2::CompressionTypePB::LZ4F) {
     using Type = typename TypeTraits<type>::CppType;
     Type* src = (Type*)src_data;
 
@@ -102,7 +103,7 @@ void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
             writer_opts.meta->set_length(0);
         }
         writer_opts.meta->set_encoding(encoding);
-        writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+        writer_opts.meta->set_compression(compression);
         writer_opts.meta->set_is_nullable(true);
         writer_opts.need_zone_map = true;
 
@@ -648,6 +649,10 @@ TEST_F(ColumnReaderWriterTest, test_nullable) {
                                                             "null_bigint_bs");
     test_nullable_data<OLAP_FIELD_TYPE_LARGEINT, BIT_SHUFFLE>(val, is_null, num_uint8_rows / 16,
                                                               "null_largeint_bs");
+    test_nullable_data<OLAP_FIELD_TYPE_INT, DELTA_BINARY_PACKED>(val, is_null, num_uint8_rows / 4,
+                                                                 "null_int_delta");
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, INT_DICT_ENCODING>(val, is_null, num_uint8_rows / 8,
+                                                                  "null_bigint_dict");
 
     // test for the case where most values are not null
     uint8_t* is_null_sparse = new uint8_t[num_uint8_rows];
@@ -678,6 +683,8 @@ TEST_F(ColumnReaderWriterTest, test_nullable) {
     }
     test_nullable_data<OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE>((uint8_t*)double_vals, is_null,
                                                             num_uint8_rows, "null_double_bs");
+    test_nullable_data<OLAP_FIELD_TYPE_DOUBLE, ALP_ENCODING>((uint8_t*)double_vals, is_null,
+                                                             num_uint8_rows, "null_double_alp");
     // test_nullable_data<OLAP_FIELD_TYPE_FLOAT, BIT_SHUFFLE>(val, is_null, num_uint8_rows / 4, "null_float_bs");
     // test_nullable_data<OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE>(val, is_null, num_uint8_rows / 8, "null_double_bs");
     delete[] val;
@@ -738,6 +745,70 @@ TEST_F(ColumnReaderWriterTest, test_types) {
     delete[] decimal_vals;
 }
 
+TEST_F(ColumnReaderWriterTest, test_adaptive_page_encoding) {
+    size_t num_rows = LOOP_LESS_OR_MORE(1024, 1024 * 1024);
+    uint8_t* is_null = new uint8_t[num_rows];
+    int32_t* int_vals = new int32_t[num_rows];
+    int64_t* bigint_vals = new int64_t[num_rows];
+    Slice* varchar_vals = new Slice[num_rows];
+    for (int i = 0; i < num_rows; ++i) {
+        // sequence at first and low cardinality later, so that pages choose differently
+        int_vals[i] = i < num_rows / 2 ? i : i % 5;
+        bigint_vals[i] = random();
+        set_column_value_by_type(OLAP_FIELD_TYPE_VARCHAR, i, (char*)&varchar_vals[i], &_pool);
+        BitmapChange(is_null, i, (i % 4) == 0);
+    }
+
+    config::enable_int_column_encoding_selection = true;
+    test_nullable_data<OLAP_FIELD_TYPE_INT, DEFAULT_ENCODING>((uint8_t*)int_vals, is_null,
+                                                              num_rows, "null_int_selected");
+    config::enable_int_column_encoding_selection = false;
+
+    config::adaptive_page_encoding_sample_pages = 4;
+    test_nullable_data<OLAP_FIELD_TYPE_INT, DEFAULT_ENCODING>((uint8_t*)int_vals, is_null,
+                                                              num_rows, "null_int_adaptive");
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, DEFAULT_ENCODING>((uint8_t*)bigint_vals, is_null,
+                                                                 num_rows, "null_bigint_adaptive");
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DEFAULT_ENCODING>(
+            (uint8_t*)varchar_vals, is_null, num_rows, "null_varchar_adaptive");
+    config::adaptive_page_encoding_sample_pages = 0;
+
+    delete[] is_null;
+    delete[] int_vals;
+    delete[] bigint_vals;
+    delete[] varchar_vals;
+}
+
+TEST_F(ColumnReaderWriterTest, test_zstd_dict_compression) {
+    // enough rows for several pages
+    size_t num_rows = 64 * 1024;
+    uint8_t* is_null = new uint8_t[num_rows];
+    int64_t* bigint_vals = new int64_t[num_rows];
+    Slice* varchar_vals = new Slice[num_rows];
+    for (int i = 0; i < num_rows; ++i) {
+        bigint_vals[i] = i % 1000;
+        set_column_value_by_type(OLAP_FIELD_TYPE_VARCHAR, i, (char*)&varchar_vals[i], &_pool);
+        BitmapChange(is_null, i, (i % 4) == 0);
+    }
+
+    config::zstd_dict_train_pages = 4;
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE>((uint8_t*)bigint_vals, is_null,
+                                                            num_rows, "null_bigint_zstd_dict",
+                                                            CompressionTypePB::ZSTD);
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING>(
+            (uint8_t*)varchar_vals, is_null, num_rows, "null_varchar_zstd_dict",
+            CompressionTypePB::ZSTD);
+    // too few pages to train a dictionary
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE>((uint8_t*)bigint_vals, is_null, 1024,
+                                                            "null_bigint_zstd_no_dict",
+                                                            CompressionTypePB::ZSTD);
+    config::zstd_dict_train_pages = 0;
+
+    delete[] is_null;
+    delete[] bigint_vals;
+    delete[] varchar_vals;
+}
+
 TEST_F(ColumnReaderWriterTest, test_default_value) {
     std::string v_int("1");
     int32_t result = 1;
@@ -0,0 +1,136 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/column_statistics.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "olap/field.h"
+#include "olap/tablet_schema_helper.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+TEST(ColumnStatisticsTest, IntColumn) {
+    TabletColumn int_column = create_int_key(0);
+    std::unique_ptr<Field> field(FieldFactory::create(int_column));
+
+    ColumnStatisticsCollector collector(field.get());
+    std::vector<int32_t> values;
+    for (int32_t i = 0; i < 100000; ++i) {
+        values.push_back(i % 10000);
+    }
+    collector.add_values(values.data(), values.size());
+    collector.add_nulls(100);
+
+    ColumnStatisticsPB statistics;
+    collector.finish(7, &statistics);
+    EXPECT_EQ(7, statistics.unique_id());
+    EXPECT_EQ(100100, statistics.num_rows());
+    EXPECT_EQ(100, statistics.null_count());
+    int64_t ndv = ColumnStatisticsCollector::estimate_ndv(statistics);
+    EXPECT_GT(ndv, 9000);
+    EXPECT_LT(ndv, 11000);
+
+    double median = 0;
+    EXPECT_TRUE(ColumnStatisticsCollector::estimate_quantile(statistics, 0.5, &median));
+    EXPECT_NEAR(5000, median, 200);
+}
+
+TEST(ColumnStatisticsTest, SmallNdv) {
+    TabletColumn int_column = create_int_key(0);
+    std::unique_ptr<Field> field(FieldFactory::create(int_column));
+
+    ColumnStatisticsCollector collector(field.get());
+    std::vector<int32_t> values = {1, 2, 3, 1, 2, 3, 1, 2, 3};
+    collector.add_values(values.data(), values.size());
+
+    ColumnStatisticsPB statistics;
+    collector.finish(0, &statistics);
+    EXPECT_NEAR(3, ColumnStatisticsCollector::estimate_ndv(statistics), 1);
+}
+
+TEST(ColumnStatisticsTest, VarcharColumnWithoutQuantile) {
+    TabletColumn varchar_column = create_varchar_key(0);
+    std::unique_ptr<Field> field(FieldFactory::create(varchar_column));
+
+    ColumnStatisticsCollector collector(field.get());
+    std::vector<std::string> strings;
+    for (int i = 0; i < 1000; ++i) {
+        strings.push_back("value_" + std::to_string(i % 100));
+    }
+    std::vector<Slice> values(strings.begin(), strings.end());
+    collector.add_values(values.data(), values.size());
+
+    ColumnStatisticsPB statistics;
+    collector.finish(1, &statistics);
+    EXPECT_EQ(1000, statistics.num_rows());
+    EXPECT_EQ(0, statistics.null_count());
+    int64_t ndv = ColumnStatisticsCollector::estimate_ndv(statistics);
+    EXPECT_GT(ndv, 90);
+    EXPECT_LT(ndv, 110);
+
+    double value = 0;
+    EXPECT_FALSE(ColumnStatisticsCollector::estimate_quantile(statistics, 0.5, &value));
+}
+
+TEST(ColumnStatisticsTest, Merge) {
+    TabletColumn int_column = create_int_key(0);
+    std::unique_ptr<Field> field(FieldFactory::create(int_column));
+
+    // two segments with half of the values overlapped
+    ColumnStatisticsPB merged;
+    for (int32_t start : {0, 5000}) {
+        ColumnStatisticsCollector collector(field.get());
+        std::vector<int32_t> values;
+        for (int32_t i = start; i < start + 10000; ++i) {
+            values.push_back(i);
+        }
+        collector.add_values(values.data(), values.size());
+        collector.add_nulls(10);
+        ColumnStatisticsPB statistics;
+        collector.finish(3, &statistics);
+        ColumnStatisticsCollector::merge(statistics, &merged);
+    }
+    EXPECT_EQ(3, merged.unique_id());
+    EXPECT_EQ(20020, merged.num_rows());
+    EXPECT_EQ(20, merged.null_count());
+    int64_t ndv = ColumnStatisticsCollector::estimate_ndv(merged);
+    EXPECT_GT(ndv, 13500);
+    EXPECT_LT(ndv, 16500);
+
+    double value = 0;
+    EXPECT_TRUE(ColumnStatisticsCollector::estimate_quantile(merged, 0, &value));
+    EXPECT_NEAR(0, value, 10);
+    EXPECT_TRUE(ColumnStatisticsCollector::estimate_quantile(merged, 1, &value));
+    EXPECT_NEAR(14999, value, 10);
+}
+
+TEST(ColumnStatisticsTest, NeedStatistics) {
+    EXPECT_TRUE(ColumnStatisticsCollector::need_statistics(OLAP_FIELD_TYPE_INT));
+    EXPECT_TRUE(ColumnStatisticsCollector::need_statistics(OLAP_FIELD_TYPE_VARCHAR));
+    EXPECT_FALSE(ColumnStatisticsCollector::need_statistics(OLAP_FIELD_TYPE_HLL));
+    EXPECT_FALSE(ColumnStatisticsCollector::need_statistics(OLAP_FIELD_TYPE_ARRAY));
+}
+
+} // namespace segment_v2
+} // namespace doris
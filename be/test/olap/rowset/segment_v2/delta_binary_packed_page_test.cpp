@@ -0,0 +1,159 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/delta_binary_packed_page.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "olap/rowset/segment_v2/options.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+using doris::segment_v2::PageBuilderOptions;
+using doris::segment_v2::PageDecoderOptions;
+
+namespace doris {
+class DeltaBinaryPackedPageTest : public testing::Test {
+public:
+    template <FieldType Type>
+    void test_encode_decode_page_template(typename TypeTraits<Type>::CppType* src, size_t size,
+                                          size_t* encoded_size = nullptr) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        segment_v2::DeltaBinaryPackedPageBuilder<Type> page_builder(builder_options);
+        size_t num_added = size;
+        page_builder.add(reinterpret_cast<const uint8_t*>(src), &num_added);
+        EXPECT_EQ(size, num_added);
+        OwnedSlice s = page_builder.finish();
+        EXPECT_EQ(size, page_builder.count());
+        if (encoded_size != nullptr) {
+            *encoded_size = s.slice().size;
+        }
+
+        PageDecoderOptions decoder_options;
+        segment_v2::DeltaBinaryPackedPageDecoder<Type> page_decoder(s.slice(), decoder_options);
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(size, page_decoder.count());
+
+        auto tracker = std::make_shared<MemTracker>();
+        MemPool pool(tracker.get());
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        ColumnVectorBatch::create(size, true, get_scalar_type_info(Type), nullptr, &cvb);
+        ColumnBlock block(cvb.get(), &pool);
+        ColumnBlockView column_block_view(&block);
+        size_t size_to_fetch = size;
+        EXPECT_TRUE(page_decoder.next_batch(&size_to_fetch, &column_block_view).ok());
+        EXPECT_EQ(size, size_to_fetch);
+
+        CppType* values = reinterpret_cast<CppType*>(column_block_view.data());
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(src[i], values[i]) << "Fail at index " << i;
+        }
+
+        for (int i = 0; i < 100; i++) {
+            size_t seek_off = random() % size;
+            page_decoder.seek_to_position_in_page(seek_off);
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            ColumnBlockView one_view(&block);
+            size_t n = 1;
+            EXPECT_TRUE(page_decoder.next_batch(&n, &one_view).ok());
+            EXPECT_EQ(1, n);
+            EXPECT_EQ(src[seek_off], *reinterpret_cast<const CppType*>(block.cell_ptr(0)));
+        }
+    }
+};
+
+TEST_F(DeltaBinaryPackedPageTest, TestInt32Sequence) {
+    const uint32_t size = 10000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = 12345 + i * 3;
+    }
+    size_t encoded_size = 0;
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.get(), size, &encoded_size);
+    // all the deltas are the same, only the headers of the mini blocks are stored
+    EXPECT_LT(encoded_size, size / 10);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestInt32Random) {
+    const uint32_t size = 10000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = random() - (RAND_MAX / 2);
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints.get(), size);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestInt64Extremes) {
+    const uint32_t size = 1000;
+    std::unique_ptr<int64_t[]> ints(new int64_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = i % 2 == 0 ? std::numeric_limits<int64_t>::max()
+                                   : std::numeric_limits<int64_t>::min() + i;
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_BIGINT>(ints.get(), size);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestTinyIntAndTimestamps) {
+    const uint32_t size = 300;
+    std::unique_ptr<int8_t[]> tiny(new int8_t[size]);
+    std::unique_ptr<int64_t[]> datetimes(new int64_t[size]);
+    for (int i = 0; i < size; i++) {
+        tiny.get()[i] = static_cast<int8_t>(i * 7);
+        datetimes.get()[i] = 20221012000000L + i * (random() % 60);
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_TINYINT>(tiny.get(), size);
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_DATETIME>(datetimes.get(), size);
+}
+
+TEST_F(DeltaBinaryPackedPageTest, TestSingleValueAndSeekValue) {
+    int32_t one = 42;
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(&one, 1);
+
+    const uint32_t size = 1000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = i * 2;
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::DeltaBinaryPackedPageBuilder<OLAP_FIELD_TYPE_INT> page_builder(builder_options);
+    size_t num_added = size;
+    page_builder.add(reinterpret_cast<const uint8_t*>(ints.get()), &num_added);
+    OwnedSlice s = page_builder.finish();
+    segment_v2::DeltaBinaryPackedPageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(
+            s.slice(), PageDecoderOptions());
+    EXPECT_TRUE(page_decoder.init().ok());
+
+    bool exact_match = false;
+    int32_t target = 501;
+    EXPECT_TRUE(page_decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    EXPECT_FALSE(exact_match);
+    EXPECT_EQ(251, page_decoder.current_index());
+    target = 600;
+    EXPECT_TRUE(page_decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    EXPECT_TRUE(exact_match);
+    EXPECT_EQ(300, page_decoder.current_index());
+    target = 2000;
+    EXPECT_FALSE(page_decoder.seek_at_or_after_value(&target, &exact_match).ok());
+}
+
+} // namespace doris
@@ -0,0 +1,164 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/fs/file_system.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/match_predicate.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
+#include "olap/types.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace segment_v2 {
+using roaring::Roaring;
+
+class InvertedIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/inverted_index_test";
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+};
+
+static void write_index_file(const std::string& filename, const std::vector<Slice>& values,
+                             size_t null_count, ColumnIndexMetaPB* meta) {
+    const auto* type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+    std::unique_ptr<io::FileWriter> file_writer;
+    EXPECT_TRUE(io::global_local_filesystem()->create_file(filename, &file_writer).ok());
+
+    std::unique_ptr<InvertedIndexWriter> writer;
+    EXPECT_TRUE(InvertedIndexWriter::create(type_info, &writer).ok());
+    writer->add_values(values.data(), values.size());
+    writer->add_nulls(null_count);
+    EXPECT_TRUE(writer->finish(file_writer.get(), meta).ok());
+    EXPECT_EQ(INVERTED_INDEX, meta->type());
+    EXPECT_TRUE(file_writer->close().ok());
+}
+
+TEST_F(InvertedIndexTest, test_read_term) {
+    std::vector<std::string> strings = {"hello world", "Hello, doris!", "", "world wide web",
+                                        "doris-2022 hello"};
+    std::vector<Slice> values(strings.begin(), strings.end());
+    std::string file_name = kTestDir + "/read_term";
+    ColumnIndexMetaPB meta;
+    write_index_file(file_name, values, 2, &meta);
+
+    InvertedIndexReader reader(io::global_local_filesystem(), file_name, &meta.inverted_index());
+    EXPECT_TRUE(reader.load(true, false).ok());
+    // hello, world, Hello, doris, wide, web, 2022
+    EXPECT_EQ(7, reader.num_terms());
+
+    InvertedIndexIterator* iter = nullptr;
+    EXPECT_TRUE(reader.new_iterator(&iter).ok());
+    std::unique_ptr<InvertedIndexIterator> iter_holder(iter);
+
+    Roaring bitmap;
+    EXPECT_TRUE(iter->read_term(Slice("hello"), &bitmap).ok());
+    EXPECT_TRUE(Roaring::bitmapOf(2, 0, 4) == bitmap);
+
+    bitmap = Roaring();
+    EXPECT_TRUE(iter->read_term(Slice("doris"), &bitmap).ok());
+    EXPECT_TRUE(Roaring::bitmapOf(2, 1, 4) == bitmap);
+
+    bitmap = Roaring();
+    EXPECT_TRUE(iter->read_term(Slice("dori"), &bitmap).ok());
+    EXPECT_TRUE(bitmap.isEmpty());
+
+    bitmap = Roaring();
+    EXPECT_TRUE(iter->read_term(Slice("zzz"), &bitmap).ok());
+    EXPECT_TRUE(bitmap.isEmpty());
+}
+
+TEST_F(InvertedIndexTest, test_read_terms_containing) {
+    size_t num_rows = 10000;
+    std::vector<std::string> strings;
+    for (int i = 0; i < num_rows; ++i) {
+        strings.push_back("row" + std::to_string(i) + " common");
+    }
+    std::vector<Slice> values(strings.begin(), strings.end());
+    std::string file_name = kTestDir + "/read_terms_containing";
+    ColumnIndexMetaPB meta;
+    write_index_file(file_name, values, 0, &meta);
+
+    InvertedIndexReader reader(io::global_local_filesystem(), file_name, &meta.inverted_index());
+    EXPECT_TRUE(reader.load(true, false).ok());
+    EXPECT_EQ(num_rows + 1, reader.num_terms());
+
+    InvertedIndexIterator* iter = nullptr;
+    EXPECT_TRUE(reader.new_iterator(&iter).ok());
+    std::unique_ptr<InvertedIndexIterator> iter_holder(iter);
+
+    Roaring bitmap;
+    EXPECT_TRUE(iter->read_terms_containing(Slice("999"), &bitmap).ok());
+    // 999, 1999, ..., 9999 and 9990 ~ 9998
+    EXPECT_EQ(19, bitmap.cardinality());
+    EXPECT_TRUE(bitmap.contains(999));
+    EXPECT_TRUE(bitmap.contains(9995));
+
+    bitmap = Roaring();
+    EXPECT_TRUE(iter->read_terms_containing(Slice("mmo"), &bitmap).ok());
+    EXPECT_EQ(num_rows, bitmap.cardinality());
+
+    // row ids not matching all the words are removed
+    MatchPredicate pred(0, {"ow12", "common"}, {});
+    bitmap = Roaring();
+    bitmap.addRange(0, num_rows);
+    EXPECT_TRUE(pred.evaluate(iter, &bitmap).ok());
+    // 12, 120 ~ 129, 1200 ~ 1299
+    EXPECT_EQ(111, bitmap.cardinality());
+}
+
+TEST_F(InvertedIndexTest, test_like_pattern_words) {
+    std::vector<std::string> words;
+    EXPECT_TRUE(MatchPredicate::get_words_of_like_pattern("%hello world%", &words));
+    EXPECT_EQ((std::vector<std::string> {"hello", "world"}), words);
+
+    words.clear();
+    EXPECT_TRUE(MatchPredicate::get_words_of_like_pattern("ab_cd%e", &words));
+    EXPECT_EQ((std::vector<std::string> {"ab", "cd", "e"}), words);
+
+    words.clear();
+    EXPECT_FALSE(MatchPredicate::get_words_of_like_pattern("%_%", &words));
+    EXPECT_FALSE(MatchPredicate::get_words_of_like_pattern("%a\\%b%", &words));
+
+    std::vector<std::string> substrings;
+    EXPECT_TRUE(MatchPredicate::get_substrings_of_like_pattern("%trace-id:1_3%", &substrings));
+    EXPECT_EQ((std::vector<std::string> {"trace-id:1", "3"}), substrings);
+    substrings.clear();
+    EXPECT_FALSE(MatchPredicate::get_substrings_of_like_pattern("%%_", &substrings));
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/json_sub_column_collector.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+namespace segment_v2 {
+
+static void add(JsonSubColumnCollector* collector, const std::string& json) {
+    std::string buf;
+    ASSERT_TRUE(BinaryJsonValue::parse(json, &buf).ok());
+    collector->add(BinaryJsonValue(buf.data(), buf.size()));
+}
+
+TEST(JsonSubColumnCollectorTest, frequent_keys) {
+    JsonSubColumnCollector collector;
+    add(&collector, R"({"uid":1,"name":"a","score":1,"tags":[1],"flag":true,"sparse":1})");
+    add(&collector, R"({"uid":2,"name":"b","score":1.5,"tags":[2],"flag":false})");
+    add(&collector, R"({"uid":3,"name":null,"score":2,"tags":[3],"flag":true,"mixed":1})");
+    add(&collector, R"({"uid":4,"name":"d","mixed":"x"})");
+    add(&collector, R"([1,2])");
+    add(&collector, "null");
+    EXPECT_EQ(6, collector.num_rows());
+
+    auto columns = collector.frequent_keys(0.5, 10);
+    ASSERT_EQ(4, columns.size());
+    EXPECT_EQ("name", columns[0].key);
+    EXPECT_EQ(OLAP_FIELD_TYPE_STRING, columns[0].type);
+    EXPECT_EQ(4, columns[0].count);
+    EXPECT_EQ("uid", columns[1].key);
+    EXPECT_EQ(OLAP_FIELD_TYPE_BIGINT, columns[1].type);
+    EXPECT_EQ("flag", columns[2].key);
+    EXPECT_EQ(OLAP_FIELD_TYPE_BOOL, columns[2].type);
+    EXPECT_EQ("score", columns[3].key);
+    EXPECT_EQ(OLAP_FIELD_TYPE_DOUBLE, columns[3].type);
+
+    columns = collector.frequent_keys(0.5, 1);
+    ASSERT_EQ(1, columns.size());
+    EXPECT_EQ("name", columns[0].key);
+
+    EXPECT_TRUE(collector.frequent_keys(0.8, 10).empty());
+}
+
+TEST(JsonSubColumnCollectorTest, max_keys) {
+    JsonSubColumnCollector collector(2);
+    add(&collector, R"({"a":1,"b":2,"c":3})");
+    add(&collector, R"({"c":3,"d":4})");
+    auto columns = collector.frequent_keys(0, 10);
+    ASSERT_EQ(2, columns.size());
+    EXPECT_EQ("a", columns[0].key);
+    EXPECT_EQ("b", columns[1].key);
+}
+
+} // namespace segment_v2
+} // namespace doris
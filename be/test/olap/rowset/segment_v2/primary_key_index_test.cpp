@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/primary_key_index.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace segment_v2 {
+
+class PrimaryKeyIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/primary_key_index_test";
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+};
+
+TEST_F(PrimaryKeyIndexTest, builder_and_seek) {
+    std::string filename = kTestDir + "/builder";
+    io::FileSystem* fs = io::global_local_filesystem();
+    std::unique_ptr<io::FileWriter> file_writer;
+    EXPECT_TRUE(fs->create_file(filename, &file_writer).ok());
+
+    PrimaryKeyIndexBuilder builder(file_writer.get());
+    EXPECT_TRUE(builder.init().ok());
+    // keys are added in ascending order, only even numbers are written
+    std::vector<std::string> keys;
+    for (int i = 1000; i < 100000; i += 2) {
+        std::string key = std::to_string(i);
+        key.insert(0, 6 - key.size(), '0');
+        keys.push_back(key);
+        EXPECT_TRUE(builder.add_item(keys.back()).ok());
+    }
+    EXPECT_EQ(keys.size(), builder.num_rows());
+    EXPECT_EQ("001000", builder.min_key().to_string());
+    EXPECT_EQ("099998", builder.max_key().to_string());
+
+    PrimaryKeyIndexMetaPB index_meta;
+    EXPECT_TRUE(builder.finalize(&index_meta).ok());
+    EXPECT_TRUE(file_writer->close().ok());
+    EXPECT_EQ("001000", index_meta.min_key());
+    EXPECT_EQ("099998", index_meta.max_key());
+
+    PrimaryKeyIndexReader index_reader;
+    EXPECT_TRUE(index_reader.parse(fs, filename, index_meta).ok());
+    EXPECT_EQ(keys.size(), index_reader.num_rows());
+
+    std::unique_ptr<IndexedColumnIterator> index_iterator;
+    EXPECT_TRUE(index_reader.new_iterator(&index_iterator).ok());
+    bool exact_match = false;
+    for (size_t i = 0; i < keys.size(); i += 97) {
+        Slice key(keys[i]);
+        EXPECT_TRUE(index_iterator->seek_at_or_after(&key, &exact_match).ok());
+        EXPECT_TRUE(exact_match);
+        EXPECT_EQ(i, index_iterator->get_current_ordinal());
+    }
+    {
+        // an odd number is not in the index, seek to the next even one
+        std::string missing_key = "001001";
+        Slice key(missing_key);
+        EXPECT_TRUE(index_iterator->seek_at_or_after(&key, &exact_match).ok());
+        EXPECT_FALSE(exact_match);
+        EXPECT_EQ(1, index_iterator->get_current_ordinal());
+    }
+    {
+        // greater than all keys
+        std::string missing_key = "099999";
+        Slice key(missing_key);
+        EXPECT_TRUE(index_iterator->seek_at_or_after(&key, &exact_match).is_not_found());
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
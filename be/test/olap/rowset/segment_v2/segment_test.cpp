@@ -22,6 +22,7 @@
 #include <filesystem>
 #include <functional>
 #include <iostream>
+#include <numeric>
 
 #include "common/logging.h"
 #include "io/fs/file_system.h"
@@ -36,6 +37,7 @@
 #include "olap/row_block.h"
 #include "olap/row_block2.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/row_store_codec.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/tablet_schema.h"
@@ -44,7 +46,10 @@
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "testutil/test_util.h"
+#include "util/defer_op.h"
 #include "util/file_utils.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/block.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -409,6 +414,427 @@ TEST_F(SegmentReaderWriterTest, LazyMaterialization) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, StagedPredicateRead) {
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1), create_varchar_key(2), create_int_value(3)});
+    auto tracker = std::make_shared<MemTracker>();
+    MemPool pool(tracker.get());
+    ValueGenerator data_gen = [&](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        cell.set_not_null();
+        if (cid == 0) {
+            *(int*)(cell.mutable_cell_ptr()) = rid;
+        } else if (cid == 1) {
+            set_column_value_by_type(OLAP_FIELD_TYPE_VARCHAR, rid, (char*)cell.mutable_cell_ptr(),
+                                     &pool, tablet_schema.column(1).length());
+        } else {
+            *(int*)(cell.mutable_cell_ptr()) = rid % 100;
+        }
+    };
+    const int num_rows = 10000;
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, num_rows, data_gen,
+                  &segment);
+
+    // select c1, c2, c3 where c1 >= 5000 and c3 = 7;
+    // the varchar column c2 is read lazily, so c1 and c3 are read by stage
+    Schema read_schema(tablet_schema);
+    std::unique_ptr<ColumnPredicate> p0(new GreaterEqualPredicate<int32_t>(0, 5000));
+    std::unique_ptr<ColumnPredicate> p2(new EqualPredicate<int32_t>(2, 7));
+    OlapReaderStatistics stats;
+    StorageReadOptions read_opts;
+    read_opts.column_predicates = {p0.get(), p2.get()};
+    read_opts.stats = &stats;
+
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+    std::vector<int64_t> c1_values;
+    while (true) {
+        vectorized::Block block = tablet_schema.create_block();
+        Status st = iter->next_batch(&block);
+        if (!st.ok()) {
+            EXPECT_TRUE(st.is_end_of_file());
+            break;
+        }
+        EXPECT_TRUE(iter->is_lazy_materialization_read());
+        for (size_t i = 0; i < block.rows(); ++i) {
+            int64_t c1 = (*block.get_by_position(0).column)[i].get<Int64>();
+            c1_values.push_back(c1);
+            EXPECT_EQ(std::to_string(c1),
+                      (*block.get_by_position(1).column)[i].get<String>());
+            EXPECT_EQ(7, (*block.get_by_position(2).column)[i].get<Int64>());
+        }
+    }
+    ASSERT_EQ(50, c1_values.size());
+    for (size_t i = 0; i < c1_values.size(); ++i) {
+        EXPECT_EQ(5007 + int64_t(i) * 100, c1_values[i]);
+    }
+    EXPECT_EQ(num_rows - 50, stats.rows_vec_cond_filtered);
+    // c3 isn't read for the rows with c1 < 5000
+    EXPECT_GE(stats.rows_pred_column_skipped, 5000);
+}
+
+TEST_F(SegmentReaderWriterTest, PushDownAggregation) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_value(2)});
+    ValueGenerator data_gen = [&](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        cell.set_not_null();
+        *(int*)(cell.mutable_cell_ptr()) = cid == 0 ? rid + 10 : rid % 100;
+    };
+    const int num_rows = 10000;
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, num_rows, data_gen,
+                  &segment);
+    Schema read_schema(tablet_schema);
+    {
+        // min and max from the zone maps
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.push_down_agg_type_opt = TPushAggOp::MINMAX;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+        vectorized::Block block = tablet_schema.create_block();
+        ASSERT_TRUE(iter->next_batch(&block).ok());
+        ASSERT_EQ(2, block.rows());
+        EXPECT_EQ(10, (*block.get_by_position(0).column)[0].get<Int64>());
+        EXPECT_EQ(num_rows + 9, (*block.get_by_position(0).column)[1].get<Int64>());
+        EXPECT_EQ(0, (*block.get_by_position(1).column)[0].get<Int64>());
+        EXPECT_EQ(99, (*block.get_by_position(1).column)[1].get<Int64>());
+        block = tablet_schema.create_block();
+        EXPECT_TRUE(iter->next_batch(&block).is_end_of_file());
+        EXPECT_EQ(0, stats.raw_rows_read);
+        EXPECT_EQ(num_rows, stats.rows_read_by_metadata);
+    }
+    {
+        // as many rows as the segment has
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.push_down_agg_type_opt = TPushAggOp::COUNT;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+        size_t rows = 0;
+        while (true) {
+            vectorized::Block block = tablet_schema.create_block();
+            Status st = iter->next_batch(&block);
+            if (!st.ok()) {
+                EXPECT_TRUE(st.is_end_of_file());
+                break;
+            }
+            rows += block.rows();
+        }
+        EXPECT_EQ(num_rows, rows);
+        EXPECT_EQ(0, stats.raw_rows_read);
+    }
+    {
+        // the data pages are read to apply the predicates
+        std::unique_ptr<ColumnPredicate> predicate(new GreaterEqualPredicate<int32_t>(0, 5010));
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.column_predicates = {predicate.get()};
+        read_opts.push_down_agg_type_opt = TPushAggOp::COUNT;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+        size_t rows = 0;
+        while (true) {
+            vectorized::Block block = tablet_schema.create_block();
+            Status st = iter->next_batch(&block);
+            if (!st.ok()) {
+                EXPECT_TRUE(st.is_end_of_file());
+                break;
+            }
+            rows += block.rows();
+        }
+        EXPECT_EQ(num_rows - 5000, rows);
+        EXPECT_EQ(0, stats.rows_read_by_metadata);
+    }
+}
+
+TEST_F(SegmentReaderWriterTest, CountByBitmapIndex) {
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1, true, false, true), create_int_value(2)});
+    ValueGenerator data_gen = [&](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        cell.set_not_null();
+        *(int*)(cell.mutable_cell_ptr()) = cid == 0 ? rid / 1000 : rid;
+    };
+    const int num_rows = 10000;
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, num_rows, data_gen,
+                  &segment);
+    Schema read_schema(tablet_schema);
+    auto count = [&](const std::vector<ColumnPredicate*>& predicates,
+                     OlapReaderStatistics* stats) {
+        StorageReadOptions read_opts;
+        read_opts.stats = stats;
+        read_opts.column_predicates = predicates;
+        read_opts.push_down_agg_type_opt = TPushAggOp::COUNT;
+        std::unique_ptr<RowwiseIterator> iter;
+        EXPECT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+        size_t rows = 0;
+        while (true) {
+            vectorized::Block block = tablet_schema.create_block();
+            Status st = iter->next_batch(&block);
+            if (!st.ok()) {
+                EXPECT_TRUE(st.is_end_of_file());
+                break;
+            }
+            rows += block.rows();
+        }
+        return rows;
+    };
+    {
+        // select count(*) where c1 = 3, answered by the bitmap index of c1
+        std::unique_ptr<ColumnPredicate> predicate(new EqualPredicate<int32_t>(0, 3));
+        OlapReaderStatistics stats;
+        EXPECT_EQ(1000, count({predicate.get()}, &stats));
+        EXPECT_EQ(1000, stats.rows_counted_by_index);
+        EXPECT_EQ(0, stats.raw_rows_read);
+    }
+    {
+        // select count(*) where c1 = 3 and c2 >= 3500, c2 is read to apply its predicate
+        std::unique_ptr<ColumnPredicate> p0(new EqualPredicate<int32_t>(0, 3));
+        std::unique_ptr<ColumnPredicate> p1(new GreaterEqualPredicate<int32_t>(1, 3500));
+        OlapReaderStatistics stats;
+        EXPECT_EQ(500, count({p0.get(), p1.get()}, &stats));
+        EXPECT_EQ(0, stats.rows_counted_by_index);
+        EXPECT_EQ(1000, stats.raw_rows_read);
+    }
+}
+
+TEST_F(SegmentReaderWriterTest, ReadColumnsByRowids) {
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1), create_int_value(2), create_int_value(3)});
+    ValueGenerator data_gen = [&](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        cell.set_not_null();
+        *(int*)(cell.mutable_cell_ptr()) = rid * 10 + cid;
+    };
+    const int num_rows = 5000;
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, num_rows, data_gen,
+                  &segment);
+
+    // the rows are in different pages, and columns are read in any order
+    std::vector<uint32_t> row_ids = {0, 7, 1024, 3000, 4999};
+    std::vector<uint32_t> cids = {2, 1};
+    vectorized::Block block = tablet_schema.create_block({2, 1});
+    auto columns = block.mutate_columns();
+    OlapReaderStatistics stats;
+    ASSERT_TRUE(segment->read_columns_by_rowids(cids, row_ids.data(), row_ids.size(), &columns,
+                                                &stats)
+                        .ok());
+    for (size_t i = 0; i < row_ids.size(); ++i) {
+        EXPECT_EQ(row_ids[i] * 10 + 2, (*columns[0])[i].get<Int64>());
+        EXPECT_EQ(row_ids[i] * 10 + 1, (*columns[1])[i].get<Int64>());
+    }
+}
+
+TEST_F(SegmentReaderWriterTest, RowStoreCodec) {
+    auto nullable = vectorized::ColumnNullable::create(vectorized::ColumnInt32::create(),
+                                                       vectorized::ColumnUInt8::create());
+    nullable->insert(vectorized::Field(Int64(7)));
+    nullable->insert_default();
+    auto str = vectorized::ColumnString::create();
+    str->insert_data("abc", 3);
+    str->insert_data("", 0);
+    ASSERT_TRUE(RowStoreCodec::is_supported(*nullable));
+    ASSERT_TRUE(RowStoreCodec::is_supported(*str));
+
+    faststring buf;
+    std::vector<size_t> row_ends;
+    RowStoreCodec::encode_rows({nullable.get(), str.get()}, {11, 12}, 0, 2, &buf, &row_ends);
+    ASSERT_EQ(2, row_ends.size());
+    EXPECT_EQ(RowStoreCodec::ROW_STORE_VERSION, buf[0]);
+    Slice row0(buf.data(), row_ends[0]);
+    Slice row1(buf.data() + row_ends[0], row_ends[1] - row_ends[0]);
+
+    // the cells are found by the unique ids, whatever the order of the columns
+    auto decoded_str = str->clone_empty();
+    auto decoded_nullable = nullable->clone_empty();
+    std::vector<vectorized::IColumn*> columns = {decoded_str.get(), decoded_nullable.get()};
+    ASSERT_TRUE(RowStoreCodec::decode_row(row0, {{12, 0}, {11, 1}}, columns).ok());
+    ASSERT_TRUE(RowStoreCodec::decode_row(row1, {{12, 0}, {11, 1}}, columns).ok());
+    EXPECT_EQ("abc", (*decoded_str)[0].get<String>());
+    EXPECT_EQ("", (*decoded_str)[1].get<String>());
+    EXPECT_EQ(7, (*decoded_nullable)[0].get<Int64>());
+    EXPECT_TRUE(decoded_nullable->is_null_at(1));
+
+    // the cells of the other columns are skipped
+    columns = {decoded_str.get()};
+    ASSERT_TRUE(RowStoreCodec::decode_row(row0, {{12, 0}}, columns).ok());
+    EXPECT_EQ("abc", (*decoded_str)[2].get<String>());
+
+    // a missing column, a null of a not nullable column, a value of another size
+    EXPECT_TRUE(RowStoreCodec::decode_row(row0, {{13, 0}}, columns).is_corruption());
+    auto not_nullable = vectorized::ColumnInt32::create();
+    columns = {not_nullable.get()};
+    EXPECT_TRUE(RowStoreCodec::decode_row(row1, {{11, 0}}, columns).is_corruption());
+    auto int64_column = vectorized::ColumnInt64::create();
+    columns = {int64_column.get()};
+    EXPECT_TRUE(RowStoreCodec::decode_row(row0, {{11, 0}}, columns).is_corruption());
+
+    // the rows of an unknown version
+    std::string future_row = row0.to_string();
+    future_row[0] = RowStoreCodec::ROW_STORE_VERSION + 1;
+    columns = {decoded_str.get()};
+    EXPECT_TRUE(RowStoreCodec::decode_row(future_row, {{12, 0}}, columns).is_not_supported());
+}
+
+TEST_F(SegmentReaderWriterTest, RowStore) {
+    int32_t old_row_store_min_columns = config::row_store_min_columns;
+    config::row_store_min_columns = 1;
+    Defer defer {[&]() { config::row_store_min_columns = old_row_store_min_columns; }};
+
+    TabletSchema build_schema = create_schema(
+            {create_int_key(1, false), create_varchar_key(2, false),
+             create_int_value(3, OLAP_FIELD_AGGREGATION_REPLACE),
+             create_int_value(4, OLAP_FIELD_AGGREGATION_REPLACE, false)});
+    build_schema._keys_type = UNIQUE_KEYS;
+    // c1, c2: rid, c3: rid * 10 or null if rid % 3 == 0, c4: rid * 100
+    const size_t num_rows = 1000;
+    vectorized::Block block = build_schema.create_block();
+    {
+        auto columns = block.mutate_columns();
+        for (size_t rid = 0; rid < num_rows; ++rid) {
+            std::string str = std::to_string(rid);
+            columns[0]->insert(vectorized::Field(Int64(rid)));
+            columns[1]->insert_data(str.data(), str.size());
+            if (rid % 3 == 0) {
+                columns[2]->insert_default();
+            } else {
+                columns[2]->insert(vectorized::Field(Int64(rid * 10)));
+            }
+            columns[3]->insert(vectorized::Field(Int64(rid * 100)));
+        }
+        block.set_columns(std::move(columns));
+    }
+    std::string path = fmt::format("{}/row_store.dat", kSegmentDir);
+    auto fs = io::global_local_filesystem();
+    {
+        std::unique_ptr<io::FileWriter> file_writer;
+        ASSERT_TRUE(fs->create_file(path, &file_writer).ok());
+        DataDir data_dir(kSegmentDir);
+        data_dir.init();
+        SegmentWriterOptions opts;
+        opts.enable_unique_key_merge_on_write = true;
+        SegmentWriter writer(file_writer.get(), 0, &build_schema, &data_dir, INT32_MAX, opts);
+        ASSERT_TRUE(writer.init(10).ok());
+        ASSERT_TRUE(writer.append_block(&block, 0, num_rows).ok());
+        uint64_t file_size, index_size;
+        ASSERT_TRUE(writer.finalize(&file_size, &index_size).ok());
+        ASSERT_TRUE(file_writer->close().ok());
+    }
+
+    // the expected value of the column of unique id `unique_id`, "NULL" for null
+    auto expected = [](size_t rid, int32_t unique_id) -> std::string {
+        switch (unique_id) {
+        case 1:
+        case 2:
+            return std::to_string(rid);
+        case 3:
+            return rid % 3 == 0 ? "NULL" : std::to_string(rid * 10);
+        case 4:
+            return std::to_string(rid * 100);
+        default:
+            // the added column
+            return "42";
+        }
+    };
+    auto check_row = [&](const TabletSchema& schema, const vectorized::Block& result,
+                         size_t pos, size_t rid) {
+        for (size_t cid = 0; cid < schema.num_columns(); ++cid) {
+            const auto& column = result.get_by_position(cid);
+            EXPECT_EQ(expected(rid, schema.column(cid).unique_id()),
+                      column.type->to_string(*column.column, pos))
+                    << "column " << cid << " of row " << rid;
+        }
+    };
+    // select * where c1 = 7, the other columns are read lazily
+    auto check_iterator = [&](const TabletSchema& schema, shared_ptr<Segment> segment,
+                              int64_t rows_read_by_row_store) {
+        Schema read_schema(schema);
+        std::unique_ptr<ColumnPredicate> predicate(new EqualPredicate<int32_t>(0, 7));
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.column_predicates = {predicate.get()};
+        read_opts.stats = &stats;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+        size_t num_read = 0;
+        while (true) {
+            vectorized::Block result = schema.create_block();
+            Status st = iter->next_batch(&result);
+            if (!st.ok()) {
+                EXPECT_TRUE(st.is_end_of_file());
+                break;
+            }
+            EXPECT_TRUE(iter->is_lazy_materialization_read());
+            for (size_t i = 0; i < result.rows(); ++i) {
+                check_row(schema, result, i, 7);
+            }
+            num_read += result.rows();
+        }
+        EXPECT_EQ(1, num_read);
+        EXPECT_EQ(rows_read_by_row_store, stats.rows_read_by_row_store);
+    };
+    auto read_row = [&](const TabletSchema& schema, shared_ptr<Segment> segment, size_t rid) {
+        std::vector<uint32_t> cids(schema.num_columns());
+        std::iota(cids.begin(), cids.end(), 0);
+        vectorized::Block result = schema.create_block();
+        auto columns = result.mutate_columns();
+        ASSERT_TRUE(segment->read_row_by_rowid(rid, cids, &columns).ok());
+        result.set_columns(std::move(columns));
+        check_row(schema, result, 0, rid);
+    };
+
+    {
+        shared_ptr<Segment> segment;
+        ASSERT_TRUE(Segment::open(fs, path, 0, &build_schema, &segment).ok());
+        ASSERT_TRUE(segment->footer().has_row_store());
+        ASSERT_TRUE(segment->has_row_store());
+        for (size_t rid : {0, 1, 500, 999}) {
+            read_row(build_schema, segment, rid);
+        }
+        // no column is opened
+        for (const auto& reader : segment->_column_readers) {
+            EXPECT_EQ(nullptr, reader);
+        }
+        check_iterator(build_schema, segment, 1);
+    }
+    {
+        // c5 is added after the rows are written, the columns are read instead
+        TabletSchema query_schema = create_schema(
+                {create_int_key(1, false), create_varchar_key(2, false),
+                 create_int_value(3, OLAP_FIELD_AGGREGATION_REPLACE),
+                 create_int_value(4, OLAP_FIELD_AGGREGATION_REPLACE, false),
+                 create_int_value(5, OLAP_FIELD_AGGREGATION_REPLACE, true, "42")});
+        query_schema._keys_type = UNIQUE_KEYS;
+        shared_ptr<Segment> segment;
+        ASSERT_TRUE(Segment::open(fs, path, 0, &query_schema, &segment).ok());
+        ASSERT_TRUE(segment->has_row_store());
+        for (size_t rid : {0, 1, 500, 999}) {
+            read_row(query_schema, segment, rid);
+        }
+        EXPECT_NE(nullptr, segment->_column_readers[1]);
+        check_iterator(query_schema, segment, 0);
+    }
+    {
+        // c3 is dropped after the rows are written, its values are skipped
+        TabletSchema query_schema = create_schema(
+                {create_int_key(1, false), create_varchar_key(2, false),
+                 create_int_value(4, OLAP_FIELD_AGGREGATION_REPLACE, false)});
+        query_schema._keys_type = UNIQUE_KEYS;
+        shared_ptr<Segment> segment;
+        ASSERT_TRUE(Segment::open(fs, path, 0, &query_schema, &segment).ok());
+        for (size_t rid : {0, 1, 500, 999}) {
+            read_row(query_schema, segment, rid);
+        }
+        for (const auto& reader : segment->_column_readers) {
+            EXPECT_EQ(nullptr, reader);
+        }
+        check_iterator(query_schema, segment, 1);
+    }
+}
+
 TEST_F(SegmentReaderWriterTest, TestIndex) {
     TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_key(2, true, true),
                                                 create_int_key(3), create_int_value(4)});
@@ -1138,6 +1564,35 @@ TEST_F(SegmentReaderWriterTest, TestBitmapPredicate) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, TestRuntimePredicate) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1, true, false, true),
+                                                create_int_key(2, true, false, true),
+                                                create_int_value(3), create_int_value(4)});
+
+    SegmentWriterOptions opts;
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 4096, DefaultIntGenerator, &segment);
+
+    Schema schema(tablet_schema);
+    std::vector<ColumnPredicate*> runtime_predicates;
+    StorageReadOptions read_opts;
+    OlapReaderStatistics stats;
+    read_opts.runtime_predicates = &runtime_predicates;
+    read_opts.stats = &stats;
+
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+    // the predicates appended before the segment is read are applied
+    std::unique_ptr<ColumnPredicate> predicate(new EqualPredicate<int32_t>(0, 10));
+    runtime_predicates.emplace_back(predicate.get());
+
+    RowBlockV2 block(schema, 1024);
+    EXPECT_TRUE(iter->next_batch(&block).ok());
+    EXPECT_EQ(block.num_rows(), 1);
+    EXPECT_EQ(read_opts.stats->raw_rows_read, 1);
+}
+
 TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     TabletSchema schema =
             create_schema({create_int_key(1), create_int_key(2), create_int_key(3),
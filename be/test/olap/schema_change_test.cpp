@@ -30,6 +30,10 @@
 #include "runtime/mem_pool.h"
 #include "runtime/vectorized_row_batch.h"
 #include "util/logging.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
 
 using std::string;
 
@@ -1179,4 +1183,76 @@ TEST_F(TestColumn, ConvertCharToCount) {
     auto dst = mv_row_cursor.cell_ptr(1);
     EXPECT_EQ(*(int64_t*)dst, 1);
 }
+
+TEST_F(TestColumn, ChangeBlock) {
+    auto add_column = [](TabletSchemaPB* schema_pb, int32_t unique_id, const std::string& name,
+                         const std::string& type, int32_t length, bool is_key, bool is_nullable) {
+        ColumnPB* column = schema_pb->add_column();
+        column->set_unique_id(unique_id);
+        column->set_name(name);
+        column->set_type(type);
+        column->set_length(length);
+        column->set_index_length(length);
+        column->set_is_key(is_key);
+        column->set_is_nullable(is_nullable);
+        column->set_is_bf_column(false);
+        if (!is_key) {
+            column->set_aggregation("REPLACE");
+        }
+        return column;
+    };
+
+    TabletSchemaPB base_schema_pb;
+    base_schema_pb.set_keys_type(KeysType::UNIQUE_KEYS);
+    base_schema_pb.set_num_short_key_columns(1);
+    add_column(&base_schema_pb, 1, "k1", "INT", 4, true, false);
+    add_column(&base_schema_pb, 2, "v1", "INT", 4, false, true);
+    TabletSchema base_schema;
+    base_schema.init_from_pb(base_schema_pb);
+
+    // modify v1 to BIGINT and add v2 VARCHAR with default value
+    TabletSchemaPB new_schema_pb;
+    new_schema_pb.set_keys_type(KeysType::UNIQUE_KEYS);
+    new_schema_pb.set_num_short_key_columns(1);
+    add_column(&new_schema_pb, 1, "k1", "INT", 4, true, false);
+    add_column(&new_schema_pb, 3, "v1", "BIGINT", 8, false, true);
+    add_column(&new_schema_pb, 4, "v2", "VARCHAR", 16, false, false)->set_default_value("abc");
+    TabletSchema new_schema;
+    new_schema.init_from_pb(new_schema_pb);
+
+    RowBlockChanger row_block_changer(new_schema, DescriptorTbl());
+    row_block_changer.get_mutable_column_mapping(0)->ref_column = 0;
+    row_block_changer.get_mutable_column_mapping(1)->ref_column = 1;
+    row_block_changer.get_mutable_column_mapping(2)->ref_column = -1;
+
+    auto ref_block = base_schema.create_block();
+    {
+        auto columns = ref_block.mutate_columns();
+        for (int32_t i = 0; i < 3; ++i) {
+            columns[0]->insert_data(reinterpret_cast<const char*>(&i), sizeof(i));
+        }
+        int32_t value = 100;
+        columns[1]->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+        columns[1]->insert_data(nullptr, 0);
+        value = -1;
+        columns[1]->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+        ref_block.set_columns(std::move(columns));
+    }
+
+    auto new_block = new_schema.create_block();
+    EXPECT_TRUE(row_block_changer.change_block(&ref_block, &new_block).ok());
+    EXPECT_EQ(3, new_block.rows());
+
+    const auto& k1 = new_block.get_by_position(0).column;
+    EXPECT_EQ(2, k1->get_int(2));
+
+    const auto& v1 = assert_cast<const vectorized::ColumnNullable&>(
+            *new_block.get_by_position(1).column);
+    EXPECT_EQ(100, v1.get_nested_column().get_int(0));
+    EXPECT_TRUE(v1.is_null_at(1));
+    EXPECT_EQ(-1, v1.get_nested_column().get_int(2));
+
+    const auto& v2 = new_block.get_by_position(2).column;
+    EXPECT_EQ("abc", v2->get_data_at(1).to_string());
+}
 } // namespace doris
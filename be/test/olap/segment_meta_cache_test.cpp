@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/segment_meta_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+
+TEST(SegmentMetaCacheTest, footer) {
+    SegmentMetaCache cache(1024 * 1024);
+    EXPECT_EQ(nullptr, cache.lookup_footer("/path/0.dat"));
+
+    auto footer = std::make_shared<segment_v2::SegmentFooterPB>();
+    footer->set_num_rows(100);
+    cache.insert_footer("/path/0.dat", footer);
+    auto found = cache.lookup_footer("/path/0.dat");
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(100, found->num_rows());
+    EXPECT_EQ(nullptr, cache.lookup_footer("/path/1.dat"));
+    // the short key index of the same segment is cached separately
+    EXPECT_EQ(nullptr, cache.lookup_short_key_index("/path/0.dat"));
+}
+
+TEST(SegmentMetaCacheTest, short_key_index) {
+    SegmentMetaCache cache(1024 * 1024);
+    auto page = std::make_shared<ShortKeyIndexPage>();
+    page->body = "abc";
+    page->footer.set_num_items(3);
+    cache.insert_short_key_index("/path/0.dat", page);
+    page.reset();
+
+    auto found = cache.lookup_short_key_index("/path/0.dat");
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ("abc", found->body);
+    EXPECT_EQ(3, found->footer.num_items());
+}
+
+TEST(SegmentMetaCacheTest, evict) {
+    // 4KB for each of the 16 shards
+    SegmentMetaCache cache(16 * 4096);
+    auto insert = [&](int i) {
+        auto page = std::make_shared<ShortKeyIndexPage>();
+        page->body.assign(1024, 'a');
+        cache.insert_short_key_index("/path/" + std::to_string(i), page);
+    };
+    for (int i = 0; i < 1000; ++i) {
+        insert(i);
+    }
+    EXPECT_EQ(nullptr, cache.lookup_short_key_index("/path/0"));
+    auto page = cache.lookup_short_key_index("/path/999");
+    ASSERT_NE(nullptr, page);
+
+    for (int i = 1000; i < 2000; ++i) {
+        insert(i);
+    }
+    EXPECT_EQ(nullptr, cache.lookup_short_key_index("/path/999"));
+    // the evicted entries are kept by their users
+    EXPECT_EQ(1024, page->body.size());
+}
+
+} // namespace doris
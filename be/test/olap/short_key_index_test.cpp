@@ -17,8 +17,11 @@
 
 #include "olap/short_key_index.h"
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "olap/row_cursor.h"
 #include "olap/tablet_schema_helper.h"
 #include "util/debug_util.h"
@@ -93,6 +96,46 @@ TEST_F(ShortKeyIndexTest, builder) {
     }
 }
 
+TEST_F(ShortKeyIndexTest, seek_with_common_prefix) {
+    // keys longer than the 8 bytes prefix, many of them share the same prefix
+    std::vector<std::string> keys;
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 20; j += 2) {
+            keys.push_back(fmt::format("prefix{:02d}{:04d}", i, j));
+        }
+    }
+    keys.push_back("short");
+    std::sort(keys.begin(), keys.end());
+
+    ShortKeyIndexBuilder builder(0, 1024);
+    for (auto& key : keys) {
+        builder.add_item(key);
+    }
+    std::vector<Slice> slices;
+    segment_v2::PageFooterPB footer;
+    EXPECT_TRUE(builder.finalize(keys.size() * 1024, &slices, &footer).ok());
+    std::string buf;
+    for (auto& slice : slices) {
+        buf.append(slice.data, slice.size);
+    }
+    ShortKeyIndexDecoder decoder;
+    EXPECT_TRUE(decoder.parse(buf, footer.short_key_page_footer()).ok());
+
+    std::vector<std::string> targets = {"", "a", "prefix", "prefix00", "prefix000000",
+                                        "prefix000001", "prefix42", "prefix420018",
+                                        "prefix420019", "prefix99", "prefix990018", "s",
+                                        "short", "shortest", "z"};
+    for (auto& target : targets) {
+        ssize_t lower = std::lower_bound(keys.begin(), keys.end(), target) - keys.begin();
+        ssize_t upper = std::upper_bound(keys.begin(), keys.end(), target) - keys.begin();
+        EXPECT_EQ(lower, decoder.lower_bound(target).ordinal()) << target;
+        EXPECT_EQ(upper, decoder.upper_bound(target).ordinal()) << target;
+        auto [lower_iter, upper_iter] = decoder.equal_range(target);
+        EXPECT_EQ(lower, lower_iter.ordinal()) << target;
+        EXPECT_EQ(upper, upper_iter.ordinal()) << target;
+    }
+}
+
 TEST_F(ShortKeyIndexTest, encode) {
     TabletSchema tablet_schema;
     tablet_schema._cols.push_back(create_int_key(0));
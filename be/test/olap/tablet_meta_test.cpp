@@ -42,4 +42,52 @@ TEST(TabletMetaTest, SaveAndParse) {
     EXPECT_EQ(old_tablet_meta, new_tablet_meta);
 }
 
+TEST(TabletMetaTest, DeleteBitmap) {
+    RowsetId rowset_id;
+    rowset_id.init(10000);
+    RowsetId other_rowset_id;
+    other_rowset_id.init(10001);
+
+    DeleteBitmap delete_bitmap;
+    // rows of segment 1 overwritten by version 2 and 3
+    delete_bitmap.add({rowset_id, 1, 2}, 5);
+    delete_bitmap.add({rowset_id, 1, 2}, 6);
+    delete_bitmap.add({rowset_id, 1, 3}, 7);
+    delete_bitmap.add({other_rowset_id, 0, 3}, 1);
+
+    EXPECT_TRUE(delete_bitmap.contains({rowset_id, 1, 2}, 5));
+    EXPECT_FALSE(delete_bitmap.contains({rowset_id, 1, 2}, 7));
+    EXPECT_FALSE(delete_bitmap.contains({rowset_id, 0, 2}, 5));
+    EXPECT_TRUE(delete_bitmap.contains_agg({rowset_id, 1, 3}, 5));
+    EXPECT_FALSE(delete_bitmap.contains_agg({rowset_id, 1, 2}, 7));
+
+    EXPECT_EQ(2, delete_bitmap.get_agg({rowset_id, 1, 2})->cardinality());
+    EXPECT_EQ(3, delete_bitmap.get_agg({rowset_id, 1, 3})->cardinality());
+    EXPECT_TRUE(delete_bitmap.get_agg({rowset_id, 1, 1})->isEmpty());
+
+    roaring::Roaring bitmap;
+    EXPECT_TRUE(delete_bitmap.get({rowset_id, 1, 3}, &bitmap).ok());
+    EXPECT_TRUE(bitmap.contains(7));
+    EXPECT_TRUE(delete_bitmap.get({rowset_id, 1, 4}, &bitmap).is_not_found());
+
+    auto snapshot = delete_bitmap.snapshot({rowset_id}, 2);
+    EXPECT_EQ(1, snapshot.delete_bitmap.size());
+    EXPECT_TRUE(snapshot.contains({rowset_id, 1, 2}, 6));
+
+    DeleteBitmapPB delete_bitmap_pb;
+    delete_bitmap.to_pb(&delete_bitmap_pb);
+    DeleteBitmap parsed;
+    parsed.init_from_pb(delete_bitmap_pb);
+    EXPECT_EQ(delete_bitmap.delete_bitmap, parsed.delete_bitmap);
+
+    EXPECT_TRUE(parsed.remove({rowset_id, 1, 2}, 5));
+    EXPECT_FALSE(parsed.remove({rowset_id, 1, 2}, 5));
+    parsed.merge(delete_bitmap);
+    EXPECT_TRUE(parsed.contains({rowset_id, 1, 2}, 5));
+
+    parsed.remove_rowset(rowset_id);
+    EXPECT_EQ(1, parsed.delete_bitmap.size());
+    EXPECT_TRUE(parsed.contains({other_rowset_id, 0, 3}, 1));
+}
+
 } // namespace doris
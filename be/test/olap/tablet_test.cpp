@@ -209,6 +209,90 @@ TEST_F(TestTablet, delete_expired_stale_rowset) {
     _tablet.reset();
 }
 
+TEST_F(TestTablet, continuous_version_cache) {
+    RowsetMetaSharedPtr ptr1(new RowsetMeta());
+    init_rs_meta(ptr1, 0, 1);
+    _tablet_meta->add_rs_meta(ptr1);
+    RowsetMetaSharedPtr ptr2(new RowsetMeta());
+    init_rs_meta(ptr2, 3, 3);
+    _tablet_meta->add_rs_meta(ptr2);
+
+    StorageParamPB storage_param;
+    storage_param.set_storage_medium(StorageMediumPB::HDD);
+    TabletSharedPtr tablet(new Tablet(_tablet_meta, storage_param, nullptr));
+    Version version;
+    Version max_version;
+    tablet->max_continuous_version_from_beginning(&version, &max_version);
+    EXPECT_EQ(Version(0, 1), version);
+    EXPECT_EQ(Version(3, 3), max_version);
+    // served from the cache
+    tablet->max_continuous_version_from_beginning(&version, &max_version);
+    EXPECT_EQ(Version(0, 1), version);
+    EXPECT_EQ(Version(3, 3), max_version);
+
+    // the missing version arrives
+    int64_t rs_metas_version = _tablet_meta->rs_metas_version();
+    RowsetMetaSharedPtr ptr3(new RowsetMeta());
+    init_rs_meta(ptr3, 2, 2);
+    _tablet_meta->add_rs_meta(ptr3);
+    EXPECT_GT(_tablet_meta->rs_metas_version(), rs_metas_version);
+    tablet->max_continuous_version_from_beginning(&version, &max_version);
+    EXPECT_EQ(Version(3, 3), version);
+    EXPECT_EQ(Version(3, 3), max_version);
+
+    _tablet_meta->delete_rs_meta_by_version(Version(3, 3), nullptr);
+    tablet->max_continuous_version_from_beginning(&version, &max_version);
+    EXPECT_EQ(Version(2, 2), version);
+    EXPECT_EQ(Version(2, 2), max_version);
+}
+
+TEST_F(TestTablet, read_amplification) {
+    StorageParamPB storage_param;
+    storage_param.set_storage_medium(StorageMediumPB::HDD);
+    TabletSharedPtr tablet(new Tablet(_tablet_meta, storage_param, nullptr));
+    EXPECT_DOUBLE_EQ(1.0, tablet->calculate_read_amplification());
+
+    tablet->record_read_amplification(3);
+    tablet->record_read_amplification(5);
+    EXPECT_DOUBLE_EQ(4.0, tablet->calculate_read_amplification());
+
+    int64_t origin_interval = config::tablet_scan_frequency_time_node_interval_second;
+    config::tablet_scan_frequency_time_node_interval_second = 0;
+    // the average of the last interval is kept until no query in a whole interval
+    EXPECT_DOUBLE_EQ(4.0, tablet->calculate_read_amplification());
+    EXPECT_DOUBLE_EQ(4.0, tablet->calculate_read_amplification());
+    EXPECT_DOUBLE_EQ(1.0, tablet->calculate_read_amplification());
+    tablet->record_read_amplification(2);
+    EXPECT_DOUBLE_EQ(2.0, tablet->calculate_read_amplification());
+    config::tablet_scan_frequency_time_node_interval_second = origin_interval;
+    EXPECT_EQ(10, tablet->query_scan_sorted_runs->value());
+}
+
+TEST_F(TestTablet, record_query_scan) {
+    StorageParamPB storage_param;
+    storage_param.set_storage_medium(StorageMediumPB::HDD);
+    TabletSharedPtr tablet(new Tablet(_tablet_meta, storage_param, nullptr));
+
+    OlapReaderStatistics stats;
+    stats.rows_key_range_filtered = 1;
+    stats.rows_conditions_filtered = 2;
+    // counted in rows_conditions_filtered
+    stats.rows_stats_filtered = 2;
+    stats.rows_del_filtered = 3;
+    stats.rows_vec_cond_filtered = 4;
+    stats.total_pages_num = 10;
+    stats.cached_pages_num = 6;
+    tablet->record_query_scan(1024, 100, stats);
+    tablet->record_query_scan(1024, 100, stats);
+
+    EXPECT_EQ(2, tablet->query_scan_count->value());
+    EXPECT_EQ(2048, tablet->query_scan_bytes->value());
+    EXPECT_EQ(200, tablet->query_scan_rows->value());
+    EXPECT_EQ(20, tablet->query_scan_filtered_rows->value());
+    EXPECT_EQ(20, tablet->query_scan_pages->value());
+    EXPECT_EQ(12, tablet->query_scan_cached_pages->value());
+}
+
 TEST_F(TestTablet, cooldown_policy) {
     std::vector<RowsetMetaSharedPtr> rs_metas;
     RowsetMetaSharedPtr ptr1(new RowsetMeta());
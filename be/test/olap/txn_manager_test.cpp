@@ -295,6 +295,44 @@ TEST_F(TxnManagerTest, PublishNotExistedTxn) {
     EXPECT_TRUE(status != Status::OK());
 }
 
+TEST_F(TxnManagerTest, PublishVersionBatch) {
+    TTabletId other_tablet_id = tablet_id + 1;
+    TabletUid other_tablet_uid(11, 11);
+    Status status = _txn_mgr->commit_txn(_meta, partition_id, transaction_id, tablet_id,
+                                         schema_hash, _tablet_uid, load_id, _alpha_rowset, false);
+    EXPECT_TRUE(status == Status::OK());
+    status = _txn_mgr->commit_txn(_meta, partition_id, transaction_id, other_tablet_id,
+                                  schema_hash, other_tablet_uid, load_id, _alpha_rowset_diff_id,
+                                  false);
+    EXPECT_TRUE(status == Status::OK());
+
+    // the third tablet has no related txn
+    std::vector<TabletInfo> tablet_infos {
+            TabletInfo(tablet_id, schema_hash, _tablet_uid),
+            TabletInfo(other_tablet_id, schema_hash, other_tablet_uid),
+            TabletInfo(other_tablet_id + 1, schema_hash, other_tablet_uid)};
+    Version new_version(10, 10);
+    std::vector<Status> results;
+    _txn_mgr->publish_txn(_meta, partition_id, transaction_id, tablet_infos, new_version,
+                          &results);
+    EXPECT_EQ(3, results.size());
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_TRUE(results[1].ok());
+    EXPECT_FALSE(results[2].ok());
+
+    RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
+    status = RowsetMetaManager::get_rowset_meta(_meta, other_tablet_uid,
+                                                _alpha_rowset_diff_id->rowset_id(), rowset_meta);
+    EXPECT_TRUE(status == Status::OK());
+    EXPECT_EQ(10, rowset_meta->start_version());
+    EXPECT_EQ(10, rowset_meta->end_version());
+
+    // the published txns are removed
+    std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+    _txn_mgr->get_txn_related_tablets(transaction_id, partition_id, &tablet_related_rs);
+    EXPECT_TRUE(tablet_related_rs.empty());
+}
+
 TEST_F(TxnManagerTest, DeletePreparedTxn) {
     Status status = _txn_mgr->prepare_txn(partition_id, transaction_id, tablet_id, schema_hash,
                                           _tablet_uid, load_id);
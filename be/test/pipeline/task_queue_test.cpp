@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/task_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace doris::pipeline {
+
+// The queue never dereferences the tasks.
+static PipelineTask* fake_task(intptr_t i) {
+    return reinterpret_cast<PipelineTask*>(i);
+}
+
+TEST(TaskQueueTest, TakeOwnQueueFirst) {
+    TaskQueue queue(2);
+    queue.push_back(fake_task(1), 0);
+    queue.push_back(fake_task(2), 0);
+    queue.push_back(fake_task(3), 1);
+
+    // fifo in the own queue
+    EXPECT_EQ(fake_task(3), queue.take(1));
+    EXPECT_EQ(fake_task(1), queue.take(0));
+    EXPECT_EQ(fake_task(2), queue.take(0));
+}
+
+TEST(TaskQueueTest, StealFromOtherQueues) {
+    TaskQueue queue(3);
+    queue.push_back(fake_task(1), 0);
+    queue.push_back(fake_task(2), 0);
+
+    // the task pushed last is stolen
+    EXPECT_EQ(fake_task(2), queue.take(2));
+    EXPECT_EQ(fake_task(1), queue.take(1));
+}
+
+TEST(TaskQueueTest, CloseWakesUpTakers) {
+    TaskQueue queue(2);
+    PipelineTask* task = fake_task(1);
+    std::thread taker([&]() { task = queue.take(0); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.close();
+    taker.join();
+    EXPECT_EQ(nullptr, task);
+}
+
+} // namespace doris::pipeline
@@ -158,6 +158,32 @@ TEST_F(PartitionCacheTest, fetch_simple_data) {
     LOG(WARNING) << "finish fetch3\n";
 }
 
+TEST_F(PartitionCacheTest, fetch_multi_sql_key) {
+    init_default();
+    // the sql keys are spread over the shards
+    init_batch_data(64, 1, 2, CacheType::PARTITION_CACHE);
+    EXPECT_EQ(_cache->get_cache_size(), 64 * 2 * 16);
+    PCacheParam* p1 = _fetch_request->add_params();
+    p1->set_partition_key(1);
+    p1->set_last_version(1);
+    p1->set_last_version_time(1);
+    PCacheParam* p2 = _fetch_request->add_params();
+    p2->set_partition_key(2);
+    p2->set_last_version(2);
+    p2->set_last_version_time(2);
+    for (int i = 1; i <= 64; i++) {
+        UniqueId sql_key(i, i);
+        EXPECT_TRUE(_cache->contains(sql_key));
+        set_sql_key(_fetch_request->mutable_sql_key(), i, i);
+        _fetch_result->Clear();
+        _cache->fetch(_fetch_request, _fetch_result);
+        EXPECT_TRUE(_fetch_result->status() == PCacheStatus::CACHE_OK);
+        EXPECT_EQ(_fetch_result->values_size(), 2);
+    }
+    EXPECT_FALSE(_cache->contains(UniqueId(65, 65)));
+    clear();
+}
+
 TEST_F(PartitionCacheTest, fetch_not_sqlid) {
     init_default();
     init_batch_data(1, 1, 1, CacheType::SQL_CACHE);
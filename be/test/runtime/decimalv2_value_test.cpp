@@ -276,6 +276,33 @@ TEST_F(DecimalV2ValueTest, mul) {
     DecimalV2Value value21(std::string("0")); // zero
     DecimalV2Value mul_result2 = value11 * value21;
     EXPECT_EQ(DecimalV2Value(std::string("0")), mul_result2);
+
+    // the product fits in 64 bits, and is rounded
+    DecimalV2Value value31(std::string("1.5"));
+    DecimalV2Value value32(std::string("0.000000001"));
+    EXPECT_EQ(DecimalV2Value(std::string("0.000000002")), value31 * value32);
+    EXPECT_EQ(DecimalV2Value(std::string("-0.000000002")), -value31 * value32);
+
+    DecimalV2Value value41(std::string("12345678.123456789"));
+    DecimalV2Value value42(std::string("987654321.987654321"));
+    EXPECT_EQ(DecimalV2Value(std::string("12193262356500531.456942538")), value41 * value42);
+
+    // overflow
+    DecimalV2Value max_value(DecimalV2Value::MAX_DECIMAL_VALUE);
+    EXPECT_EQ(max_value, max_value * DecimalV2Value(std::string("2")));
+    EXPECT_EQ(-max_value, max_value * DecimalV2Value(std::string("-2")));
+}
+
+TEST_F(DecimalV2ValueTest, add_sub_overflow) {
+    DecimalV2Value max_value(DecimalV2Value::MAX_DECIMAL_VALUE);
+    DecimalV2Value one(std::string("1"));
+    EXPECT_EQ(max_value, max_value + one);
+    EXPECT_EQ(-max_value, -max_value - one);
+    EXPECT_EQ(-max_value, -max_value + (-one));
+    EXPECT_EQ(max_value, max_value - (-one));
+    EXPECT_EQ(DecimalV2Value(DecimalV2Value::MAX_DECIMAL_VALUE - DecimalV2Value::ONE_BILLION),
+              max_value - one);
+    EXPECT_EQ(DecimalV2Value(std::string("0")), max_value + (-max_value));
 }
 
 TEST_F(DecimalV2ValueTest, div) {
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "runtime/mem_tracker.h"
 #include "util/logging.h"
 #include "util/metrics.h"
@@ -141,4 +144,36 @@ TEST(MemTestTest, TrackerHierarchyTryConsume) {
     c2->release(10);
 }
 
+TEST(MemTestTest, ConsumeCache) {
+    auto p = MemTracker::create_tracker(-1, "p");
+    auto c = MemTracker::create_tracker(-1, "c", p);
+    int64_t quantum = c->untracked_mem_quantum();
+    EXPECT_GE(quantum, 64 * 1024);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&c] {
+            for (int j = 0; j < 10000; ++j) {
+                c->consume_cache(1024);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // the untracked memory is bounded by the quantum on every core
+    int64_t total = 8 * 10000 * 1024;
+    EXPECT_LE(c->consumption(), total);
+    EXPECT_EQ(c->consumption(), p->consumption());
+
+    c->flush_untracked_mem();
+    EXPECT_EQ(c->consumption(), total);
+    EXPECT_EQ(p->consumption(), total);
+
+    c->release_cache(total);
+    c->flush_untracked_mem();
+    EXPECT_EQ(c->consumption(), 0);
+    EXPECT_EQ(p->consumption(), 0);
+}
+
 } // end namespace doris
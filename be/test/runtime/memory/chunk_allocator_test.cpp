@@ -19,6 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <thread>
+
 #include "common/config.h"
 #include "common/status.h"
 #include "runtime/memory/chunk.h"
@@ -37,4 +40,25 @@ TEST(ChunkAllocatorTest, Normal) {
         ChunkAllocator::instance()->free(chunk);
     }
 }
+
+TEST(ChunkAllocatorTest, NumaAffinity) {
+    config::use_mmap_allocate_chunk = true;
+    config::enable_numa_affinity = true;
+    CpuInfo::init();
+    int numa_node = CpuInfo::get_max_num_numa_nodes() - 1;
+    std::thread thread([numa_node] {
+        EXPECT_TRUE(CpuInfo::bind_current_thread_to_numa_node(numa_node));
+        EXPECT_EQ(numa_node, CpuInfo::get_current_numa_node());
+        for (size_t size = 4096; size <= 1024 * 1024; size <<= 1) {
+            Chunk chunk;
+            EXPECT_TRUE(ChunkAllocator::instance()->allocate(size, &chunk).ok());
+            EXPECT_NE(nullptr, chunk.data);
+            EXPECT_EQ(numa_node, CpuInfo::get_numa_node_of_core(chunk.core_id));
+            memset(chunk.data, 0, size);
+            ChunkAllocator::instance()->free(chunk);
+        }
+    });
+    thread.join();
+    config::enable_numa_affinity = false;
+}
 } // namespace doris
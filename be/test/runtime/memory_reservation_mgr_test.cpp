@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory_reservation_mgr.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+
+static TUniqueId make_query_id(int64_t lo) {
+    TUniqueId query_id;
+    query_id.__set_hi(1);
+    query_id.__set_lo(lo);
+    return query_id;
+}
+
+TEST(MemoryReservationMgrTest, AdmitInOrder) {
+    MemoryReservationMgr mgr(100, nullptr);
+
+    auto r1 = mgr.reserve(make_query_id(1), 60);
+    EXPECT_TRUE(r1->is_admitted());
+    auto r2 = mgr.reserve(make_query_id(2), 50);
+    EXPECT_FALSE(r2->is_admitted());
+    // queued after r2 though it fits
+    auto r3 = mgr.reserve(make_query_id(3), 10);
+    EXPECT_FALSE(r3->is_admitted());
+    EXPECT_EQ(2, mgr.queued_num());
+    EXPECT_EQ(60, mgr.reserved_bytes());
+    EXPECT_FALSE(r2->wait_for_admission(1));
+
+    r1.reset();
+    EXPECT_TRUE(r2->wait_for_admission(1));
+    EXPECT_TRUE(r3->is_admitted());
+    EXPECT_EQ(0, mgr.queued_num());
+    EXPECT_EQ(60, mgr.reserved_bytes());
+
+    r2.reset();
+    r3.reset();
+    EXPECT_EQ(0, mgr.reserved_bytes());
+}
+
+TEST(MemoryReservationMgrTest, AlwaysAdmitFirst) {
+    MemoryReservationMgr mgr(100, nullptr);
+    auto r1 = mgr.reserve(make_query_id(1), 1000);
+    EXPECT_TRUE(r1->is_admitted());
+
+    // the queued reservation is removed when the query is gone
+    auto r2 = mgr.reserve(make_query_id(2), 10);
+    EXPECT_FALSE(r2->is_admitted());
+    r2.reset();
+    EXPECT_EQ(0, mgr.queued_num());
+}
+
+TEST(MemoryReservationMgrTest, Consumption) {
+    int64_t consumption = 0;
+    MemoryReservationMgr mgr(100, [&consumption]() { return consumption; });
+    auto r1 = mgr.reserve(make_query_id(1), 10);
+    EXPECT_TRUE(r1->is_admitted());
+
+    // the running queries consume more than they reserved
+    consumption = 95;
+    auto r2 = mgr.reserve(make_query_id(2), 10);
+    EXPECT_FALSE(r2->is_admitted());
+
+    consumption = 50;
+    EXPECT_TRUE(r2->wait_for_admission(1));
+}
+
+} // namespace doris
@@ -21,6 +21,9 @@
 
 #include <thread>
 
+#include "exec/plain_text_line_reader.h"
+#include "util/runtime_profile.h"
+
 namespace doris {
 
 class StreamLoadPipeTest : public testing::Test {
@@ -258,4 +261,32 @@ TEST_F(StreamLoadPipeTest, close) {
     t1.join();
 }
 
+TEST_F(StreamLoadPipeTest, read_buffer_by_line_reader) {
+    // the lines and the delimiters are cut by the chunks
+    std::string data = "a,1||bb,22||ccc|,333||||dddd,4444";
+    auto owner = std::make_shared<std::string>(data);
+    StreamLoadPipe pipe(1024, 64);
+    for (size_t pos = 0; pos < data.size(); pos += 5) {
+        size_t size = std::min<size_t>(5, data.size() - pos);
+        EXPECT_TRUE(pipe.append(ByteBuffer::wrap(owner->data() + pos, size, owner)).ok());
+    }
+    pipe.finish();
+
+    RuntimeProfile profile("test");
+    PlainTextLineReader line_reader(&profile, &pipe, nullptr, -1, "||", 2);
+    std::vector<std::string> lines;
+    while (true) {
+        const uint8_t* ptr = nullptr;
+        size_t size = 0;
+        bool eof = false;
+        EXPECT_TRUE(line_reader.read_line(&ptr, &size, &eof).ok());
+        if (eof) {
+            break;
+        }
+        lines.emplace_back((const char*)ptr, size);
+    }
+    std::vector<std::string> expected = {"a,1", "bb,22", "ccc|,333", "", "dddd,4444"};
+    EXPECT_EQ(expected, lines);
+}
+
 } // namespace doris
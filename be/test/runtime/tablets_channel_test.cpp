@@ -0,0 +1,287 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/tablets_channel.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/AgentService_types.h"
+#include "olap/options.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "olap/txn_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+
+namespace doris {
+
+static StorageEngine* k_engine = nullptr;
+
+static const std::string kTestDir = "./ut_dir/tablets_channel_test";
+static const int32_t kSchemaHash = 270068392;
+static const int64_t kIndexId = 4;
+static const int64_t kPartitionId = 30003;
+
+class TabletsChannelTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        config::storage_root_path = kTestDir;
+        config::min_file_descriptor_number = 100;
+        FileUtils::remove_all(kTestDir);
+        FileUtils::create_dir(kTestDir);
+
+        EngineOptions options;
+        options.store_paths = {{kTestDir, -1}};
+        Status st = StorageEngine::open(options, &k_engine);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(k_engine);
+    }
+
+    static void TearDownTestSuite() {
+        if (k_engine != nullptr) {
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        FileUtils::remove_all(kTestDir);
+    }
+
+protected:
+    void SetUp() override {
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                       .column_name("k1").column_pos(0).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                       .column_name("v1").column_pos(1).build());
+        tuple_builder.build(&table_builder);
+        ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+    }
+
+    // duplicate key table of (k1 INT, v1 INT)
+    void create_tablet(int64_t tablet_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+        for (const char* name : {"k1", "v1"}) {
+            TColumn column;
+            column.column_name = name;
+            column.__set_is_key(column.column_name == "k1");
+            column.column_type.type = TPrimitiveType::INT;
+            request.tablet_schema.columns.push_back(column);
+        }
+        Status st = k_engine->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+
+    // Opens a channel of one sender writing into the tablet.
+    std::unique_ptr<TabletsChannel> open_channel(int64_t txn_id, int64_t tablet_id) {
+        _load_id.set_hi(1);
+        _load_id.set_lo(txn_id);
+        auto channel = std::make_unique<TabletsChannel>(TabletsChannelKey(_load_id, kIndexId),
+                                                        false, true);
+        PTabletWriterOpenRequest request;
+        *request.mutable_id() = _load_id;
+        request.set_index_id(kIndexId);
+        request.set_txn_id(txn_id);
+        auto schema = request.mutable_schema();
+        schema->set_db_id(1);
+        schema->set_table_id(2);
+        schema->set_version(0);
+        auto tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+        tuple_desc->to_protobuf(schema->mutable_tuple_desc());
+        auto index = schema->add_indexes();
+        index->set_id(kIndexId);
+        index->set_schema_hash(kSchemaHash);
+        for (auto slot : tuple_desc->slots()) {
+            slot->to_protobuf(schema->add_slot_descs());
+            index->add_columns(slot->col_name());
+        }
+        auto tablet = request.add_tablets();
+        tablet->set_partition_id(kPartitionId);
+        tablet->set_tablet_id(tablet_id);
+        request.set_num_senders(1);
+        request.set_need_gen_rollup(false);
+        Status st = channel->open(request);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        return channel;
+    }
+
+    // A packet of the sender with `num_rows` rows of the tablet.
+    std::unique_ptr<PTabletWriterAddBlockRequest> make_packet(int64_t packet_seq,
+                                                              int64_t tablet_id,
+                                                              int32_t num_rows) {
+        auto request = std::make_unique<PTabletWriterAddBlockRequest>();
+        *request->mutable_id() = _load_id;
+        request->set_index_id(kIndexId);
+        request->set_sender_id(0);
+        request->set_packet_seq(packet_seq);
+
+        vectorized::Block block;
+        for (const auto& slot_desc : _desc_tbl->get_tuple_descriptor(0)->slots()) {
+            block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                          slot_desc->col_name()});
+        }
+        auto columns = block.mutate_columns();
+        for (int32_t i = 0; i < num_rows; ++i) {
+            int32_t value = static_cast<int32_t>(packet_seq * 100 + i);
+            columns[0]->insert_data(reinterpret_cast<const char*>(&i), sizeof(i));
+            columns[1]->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+            request->add_tablet_ids(tablet_id);
+        }
+        block.set_columns(std::move(columns));
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        EXPECT_TRUE(block.serialize(request->mutable_block(), &uncompressed_bytes,
+                                    &compressed_bytes)
+                            .ok());
+        return request;
+    }
+
+    // Closes the only sender and returns the number of rows loaded into the tablet.
+    int64_t close_channel(TabletsChannel* channel, int64_t txn_id) {
+        bool finished = false;
+        google::protobuf::RepeatedField<int64_t> partition_ids;
+        partition_ids.Add(kPartitionId);
+        google::protobuf::Map<int64_t, PSlaveTabletNodes> slave_tablet_nodes;
+        google::protobuf::RepeatedPtrField<PTabletInfo> tablet_vec;
+        google::protobuf::RepeatedPtrField<PTabletError> tablet_errors;
+        google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds> success_slave_tablet_node_ids;
+        Status st = channel->close(0, 0, &finished, partition_ids, slave_tablet_nodes,
+                                   &tablet_vec, &tablet_errors, &success_slave_tablet_node_ids);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        EXPECT_TRUE(finished);
+        EXPECT_EQ(1, tablet_vec.size());
+        EXPECT_EQ(0, tablet_errors.size());
+
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        k_engine->txn_manager()->get_txn_related_tablets(txn_id, kPartitionId,
+                                                         &tablet_related_rs);
+        EXPECT_EQ(1, tablet_related_rs.size());
+        int64_t num_rows = 0;
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            num_rows += rowset->num_rows();
+        }
+        return num_rows;
+    }
+
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    PUniqueId _load_id;
+};
+
+TEST_F(TabletsChannelTest, reordered_packets) {
+    const int64_t tablet_id = 15201;
+    const int64_t txn_id = 20201;
+    create_tablet(tablet_id);
+    auto channel = open_channel(txn_id, tablet_id);
+
+    std::vector<std::unique_ptr<PTabletWriterAddBlockRequest>> packets;
+    for (int64_t seq = 0; seq < 3; ++seq) {
+        packets.push_back(make_packet(seq, tablet_id, seq + 1));
+    }
+    // the packets resumed in order, which are processed again like the rpc service does
+    std::vector<int64_t> resumed;
+    auto add_packet = [&](int64_t seq, PTabletWriterAddBlockResult* response) {
+        TabletWriterAddContext ctx;
+        ctx.resume = [&resumed, seq]() { resumed.push_back(seq); };
+        Status st = channel->add_batch(*packets[seq], response, &ctx);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        return ctx.parked;
+    };
+
+    std::vector<PTabletWriterAddBlockResult> responses(3);
+    // the packets arrive in the order of 2, 1, 0, the later ones are parked without blocking
+    EXPECT_TRUE(add_packet(2, &responses[2]));
+    EXPECT_TRUE(add_packet(1, &responses[1]));
+    EXPECT_TRUE(resumed.empty());
+    // each packet done resumes the next one only
+    EXPECT_FALSE(add_packet(0, &responses[0]));
+    EXPECT_EQ(std::vector<int64_t>({1}), resumed);
+    EXPECT_FALSE(add_packet(1, &responses[1]));
+    EXPECT_EQ(std::vector<int64_t>({1, 2}), resumed);
+    EXPECT_FALSE(add_packet(2, &responses[2]));
+    EXPECT_EQ(std::vector<int64_t>({1, 2}), resumed);
+    for (const auto& response : responses) {
+        EXPECT_EQ(0, response.tablet_errors_size());
+    }
+
+    // a packet received before is skipped
+    PTabletWriterAddBlockResult response;
+    EXPECT_FALSE(add_packet(1, &response));
+    EXPECT_EQ(6, close_channel(channel.get(), txn_id));
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+TEST_F(TabletsChannelTest, out_of_order_without_context) {
+    const int64_t tablet_id = 15202;
+    const int64_t txn_id = 20202;
+    create_tablet(tablet_id);
+    auto channel = open_channel(txn_id, tablet_id);
+
+    // the packets out of order are rejected if they can't be parked
+    auto packet = make_packet(1, tablet_id, 1);
+    PTabletWriterAddBlockResult response;
+    EXPECT_FALSE(channel->add_batch(*packet, &response).ok());
+
+    packet = make_packet(0, tablet_id, 2);
+    EXPECT_TRUE(channel->add_batch(*packet, &response).ok());
+    EXPECT_EQ(2, close_channel(channel.get(), txn_id));
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+TEST_F(TabletsChannelTest, cancel_resumes_parked_packets) {
+    const int64_t tablet_id = 15203;
+    const int64_t txn_id = 20203;
+    create_tablet(tablet_id);
+    auto channel = open_channel(txn_id, tablet_id);
+
+    auto packet = make_packet(1, tablet_id, 1);
+    int num_resumed = 0;
+    TabletWriterAddContext ctx;
+    ctx.resume = [&num_resumed]() { ++num_resumed; };
+    PTabletWriterAddBlockResult response;
+    ASSERT_TRUE(channel->add_batch(*packet, &response, &ctx).ok());
+    ASSERT_TRUE(ctx.parked);
+
+    // the parked packet is resumed to reply, and it's a no-op on the cancelled channel
+    ASSERT_TRUE(channel->cancel().ok());
+    EXPECT_EQ(1, num_resumed);
+    TabletWriterAddContext resumed_ctx;
+    resumed_ctx.resume = [&num_resumed]() { ++num_resumed; };
+    EXPECT_TRUE(channel->add_batch(*packet, &response, &resumed_ctx).ok());
+    EXPECT_FALSE(resumed_ctx.parked);
+    EXPECT_EQ(1, num_resumed);
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+} // namespace doris
@@ -0,0 +1,131 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/workload_group.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_tracker.h"
+
+namespace doris {
+
+static WorkloadGroupInfo make_info(const std::string& name) {
+    WorkloadGroupInfo info;
+    info.name = name;
+    return info;
+}
+
+TEST(WorkloadGroupTest, Validate) {
+    auto info = make_info("normal_group-1");
+    EXPECT_TRUE(info.validate().ok());
+
+    info.name = "";
+    EXPECT_FALSE(info.validate().ok());
+    info.name = "a/b";
+    EXPECT_FALSE(info.validate().ok());
+
+    info = make_info("g");
+    info.cpu_share = 1;
+    EXPECT_FALSE(info.validate().ok());
+
+    info = make_info("g");
+    info.memory_limit = 0;
+    EXPECT_FALSE(info.validate().ok());
+
+    info = make_info("g");
+    info.scan_thread_num = 0;
+    EXPECT_FALSE(info.validate().ok());
+}
+
+TEST(WorkloadGroupTest, ScanSlots) {
+    auto info = make_info("scan");
+    info.scan_thread_num = 4;
+    WorkloadGroup group(info);
+
+    EXPECT_EQ(3, group.acquire_scan_slots(3, false));
+    EXPECT_EQ(1, group.acquire_scan_slots(3, false));
+    EXPECT_EQ(0, group.acquire_scan_slots(3, false));
+    // a query with nothing running always gets a slot
+    EXPECT_EQ(1, group.acquire_scan_slots(3, true));
+    EXPECT_EQ(5, group.running_scan_num());
+
+    group.release_scan_slots(3);
+    EXPECT_EQ(2, group.acquire_scan_slots(3, false));
+    EXPECT_EQ(0, group.acquire_scan_slots(1, false));
+
+    // the quota is changed at runtime
+    info.scan_thread_num = -1;
+    group.update(info);
+    EXPECT_EQ(10, group.acquire_scan_slots(10, false));
+    group.release_scan_slots(14);
+    EXPECT_EQ(0, group.running_scan_num());
+}
+
+TEST(WorkloadGroupTest, MemoryLimit) {
+    auto info = make_info("mem");
+    info.memory_limit = 100;
+    WorkloadGroup group(info);
+    EXPECT_EQ(100, group.mem_tracker()->limit());
+
+    auto query = MemTracker::create_tracker(-1, "query", group.mem_tracker());
+    EXPECT_TRUE(query->try_consume(80).ok());
+    EXPECT_FALSE(query->try_consume(40).ok());
+
+    // not limited by the tracker with the cancel policy
+    info.memory_policy = WorkloadGroupMemoryPolicy::CANCEL;
+    group.update(info);
+    EXPECT_GT(group.mem_tracker()->limit(), 100);
+    EXPECT_TRUE(query->try_consume(40).ok());
+    query->release(120);
+}
+
+TEST(WorkloadGroupTest, QueryToCancel) {
+    auto info = make_info("cancel");
+    info.memory_limit = 100;
+    info.memory_policy = WorkloadGroupMemoryPolicy::CANCEL;
+    WorkloadGroup group(info);
+
+    TUniqueId id1;
+    id1.hi = 1;
+    id1.lo = 1;
+    TUniqueId id2;
+    id2.hi = 2;
+    id2.lo = 2;
+    auto q1 = MemTracker::create_tracker(-1, "q1", group.mem_tracker());
+    auto q2 = MemTracker::create_tracker(-1, "q2", group.mem_tracker());
+    group.add_query(id1, q1);
+    group.add_query(id2, q2);
+
+    TUniqueId to_cancel;
+    q1->consume(30);
+    q2->consume(50);
+    EXPECT_FALSE(group.get_query_to_cancel(&to_cancel));
+
+    q1->consume(40);
+    EXPECT_TRUE(group.get_query_to_cancel(&to_cancel));
+    EXPECT_EQ(id1, to_cancel);
+
+    // the finished queries are removed
+    q1->release(70);
+    q1.reset();
+    q2->consume(60);
+    EXPECT_TRUE(group.get_query_to_cancel(&to_cancel));
+    EXPECT_EQ(id2, to_cancel);
+    q2->release(110);
+}
+
+} // namespace doris
@@ -0,0 +1,230 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "service/point_query_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gen_cpp/AgentService_types.h"
+#include "olap/delta_writer.h"
+#include "olap/options.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "olap/txn_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+
+namespace doris {
+
+static StorageEngine* k_engine = nullptr;
+
+static const std::string kTestDir = "./ut_dir/point_query_executor_test";
+static const int32_t kSchemaHash = 270068390;
+
+class PointQueryExecutorTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        config::storage_root_path = kTestDir;
+        config::min_file_descriptor_number = 100;
+        FileUtils::remove_all(kTestDir);
+        FileUtils::create_dir(kTestDir);
+
+        EngineOptions options;
+        options.store_paths = {{kTestDir, -1}};
+        Status st = StorageEngine::open(options, &k_engine);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(k_engine);
+    }
+
+    static void TearDownTestSuite() {
+        if (k_engine != nullptr) {
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        FileUtils::remove_all(kTestDir);
+    }
+
+protected:
+    void SetUp() override {
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                       .column_name("k1").column_pos(0).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                       .column_name("v1").column_pos(1).build());
+        tuple_builder.build(&table_builder);
+        ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+    }
+
+    // unique key table of (k1 INT, v1 INT) with merge-on-write
+    void create_tablet(int64_t tablet_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::UNIQUE_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+        request.__set_enable_unique_key_merge_on_write(true);
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        v1.__set_aggregation_type(TAggregationType::REPLACE);
+        request.tablet_schema.columns.push_back(v1);
+
+        Status st = k_engine->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+
+    // Loads the (k1, v1) rows in a txn and publishes it as the next version, the rowset of
+    // the load has `delete_predicate` if not null.
+    void load(int64_t tablet_id, int64_t txn_id,
+              const std::vector<std::pair<int32_t, int32_t>>& rows,
+              const DeletePredicatePB* delete_predicate = nullptr) {
+        auto tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+        PUniqueId load_id;
+        load_id.set_hi(0);
+        load_id.set_lo(txn_id);
+        const int64_t partition_id = 30001;
+        WriteRequest write_req = {tablet_id,     kSchemaHash, WriteType::LOAD,        txn_id,
+                                  partition_id, load_id,     tuple_desc, &(tuple_desc->slots())};
+        DeltaWriter* writer = nullptr;
+        ASSERT_TRUE(DeltaWriter::open(&write_req, &writer, true).ok());
+        std::unique_ptr<DeltaWriter> writer_guard(writer);
+
+        vectorized::Block block;
+        for (const auto& slot_desc : tuple_desc->slots()) {
+            block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                          slot_desc->col_name()});
+        }
+        auto columns = block.mutate_columns();
+        std::vector<int> row_idxs;
+        for (const auto& [key, value] : rows) {
+            columns[0]->insert_data(reinterpret_cast<const char*>(&key), sizeof(key));
+            columns[1]->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+            row_idxs.push_back(row_idxs.size());
+        }
+        block.set_columns(std::move(columns));
+        ASSERT_TRUE(writer->write(&block, row_idxs).ok());
+        ASSERT_TRUE(writer->close().ok());
+        ASSERT_TRUE(writer->close_wait().ok());
+
+        auto tablet = k_engine->tablet_manager()->get_tablet(tablet_id);
+        ASSERT_NE(tablet, nullptr);
+        int64_t version = tablet->max_version().second + 1;
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        k_engine->txn_manager()->get_txn_related_tablets(txn_id, partition_id,
+                                                         &tablet_related_rs);
+        ASSERT_EQ(1, tablet_related_rs.size());
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            if (delete_predicate != nullptr) {
+                rowset->rowset_meta()->set_delete_predicate(*delete_predicate);
+            }
+            ASSERT_TRUE(k_engine->txn_manager()
+                                ->publish_txn(tablet->data_dir()->get_meta(), partition_id,
+                                              txn_id, tablet_id, kSchemaHash,
+                                              tablet_info.tablet_uid, {version, version})
+                                .ok());
+            ASSERT_TRUE(tablet->add_inc_rowset(rowset).ok());
+        }
+    }
+
+    // Looks up the keys and returns the values of v1, or "NULL" for the keys not found.
+    Status lookup(int64_t tablet_id, const std::vector<int32_t>& keys,
+                  std::vector<std::string>* values) {
+        PTabletKeyLookupRequest request;
+        request.set_tablet_id(tablet_id);
+        for (int32_t key : keys) {
+            request.add_key_tuples()->add_key_column_rep(std::to_string(key));
+        }
+        request.add_output_columns("v1");
+        PTabletKeyLookupResponse response;
+        PointQueryExecutor executor;
+        RETURN_IF_ERROR(executor.init(&request, &response));
+        RETURN_IF_ERROR(executor.lookup());
+
+        EXPECT_EQ(keys.size(), response.found_size());
+        vectorized::Block block(response.row_block());
+        EXPECT_EQ(1, block.columns());
+        size_t row = 0;
+        for (int i = 0; i < response.found_size(); ++i) {
+            if (response.found(i)) {
+                values->push_back(
+                        std::to_string(block.get_by_position(0).column->get_int(row++)));
+            } else {
+                values->push_back("NULL");
+            }
+        }
+        EXPECT_EQ(row, block.rows());
+        return Status::OK();
+    }
+
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(PointQueryExecutorTest, lookup) {
+    const int64_t tablet_id = 15001;
+    create_tablet(tablet_id);
+    load(tablet_id, 20001, {{1, 10}, {2, 20}, {4, 40}});
+    // the rows of key 1 and 4 in the first load are marked in the delete bitmap
+    load(tablet_id, 20002, {{1, 11}, {3, 30}, {4, 41}});
+
+    std::vector<std::string> values;
+    Status st = lookup(tablet_id, {4, 1, 5, 2, 3, 0}, &values);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    EXPECT_EQ(std::vector<std::string>({"41", "11", "NULL", "20", "30", "NULL"}), values);
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+TEST_F(PointQueryExecutorTest, delete_predicate) {
+    const int64_t tablet_id = 15002;
+    create_tablet(tablet_id);
+    load(tablet_id, 20003, {{1, 10}, {2, 20}});
+    DeletePredicatePB delete_predicate;
+    delete_predicate.set_version(3);
+    delete_predicate.add_sub_predicates("k1=1");
+    load(tablet_id, 20004, {{3, 30}}, &delete_predicate);
+
+    // the row of key 1 is deleted by the predicate but not by the delete bitmap
+    std::vector<std::string> values;
+    Status st = lookup(tablet_id, {1, 2}, &values);
+    EXPECT_TRUE(st.is_not_supported()) << st.to_string();
+
+    EXPECT_TRUE(k_engine->tablet_manager()->drop_tablet(tablet_id, 0).ok());
+}
+
+} // namespace doris
@@ -36,12 +36,14 @@
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
+#include "io/fs/s3_file_system.h"
 #include "olap/comparison_predicate.h"
 #include "olap/data_dir.h"
 #include "olap/fs/block_manager.h"
 #include "olap/fs/fs_util.h"
 #include "olap/in_list_predicate.h"
 #include "olap/olap_common.h"
+#include "olap/olap_cond.h"
 #include "olap/row_block2.h"
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h"
@@ -55,9 +57,12 @@
 #include "olap/types.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/string_value.h"
 #include "testutil/test_util.h"
 #include "util/debug_util.h"
 #include "util/file_utils.h"
+#include "util/s3_util.h"
+#include "vec/core/block.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
@@ -68,6 +73,28 @@ DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, strin
 DEFINE_string(rows_number, "10000", "rows number");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
+DEFINE_int32(cardinality, 0,
+             "distinct values of each column of the generated segments, 0 means random values");
+DEFINE_string(encodings, "",
+              "encodings of the columns of the segments in the order of the schema, "
+              "see EncodingTypePB, e.g. DICT_ENCODING,DEFAULT_ENCODING");
+DEFINE_string(compression, "LZ4F", "page compression of the segments, see CompressionTypePB");
+DEFINE_string(bitmap_index_columns, "", "positions of the columns with a bitmap index, e.g. 0,2");
+DEFINE_string(bloom_filter_columns, "", "positions of the columns with a bloom filter index");
+DEFINE_string(predicates, "",
+              "predicates of the segment scans, column position:op:values separated by ';', "
+              "op is one of eq, ne, lt, le, gt, ge and in, values are separated by '|', "
+              "e.g. 0:lt:1000;1:in:abc|def");
+DEFINE_bool(warm_page_cache, false,
+            "the segment scans read the pages from a warm StoragePageCache, otherwise every "
+            "iteration scans a new segment without the page cache");
+DEFINE_bool(vectorized, false, "the segment scans read vectorized blocks");
+DEFINE_string(s3_endpoint, "", "the segment scans read the segments uploaded to S3 if it is set");
+DEFINE_string(s3_region, "", "S3 region");
+DEFINE_string(s3_bucket, "", "S3 bucket");
+DEFINE_string(s3_prefix, "segment_benchmark", "S3 prefix of the uploaded segments");
+DEFINE_string(s3_ak, "", "S3 access key");
+DEFINE_string(s3_sk, "", "S3 secret key");
 
 const std::string kSegmentDir = "./segment_benchmark";
 
@@ -84,6 +111,10 @@ std::string get_usage(const std::string& progname) {
           "--rows_number=10000 --iterations=40\n";
     ss << "./benchmark_tool --operation=SegmentScan --column_type=int,varchar "
           "--rows_number=10000 --iterations=0\n";
+    ss << "./benchmark_tool --operation=SegmentScan --column_type=int,varchar "
+          "--rows_number=1000000 --cardinality=1000 --encodings=BIT_SHUFFLE,DICT_ENCODING "
+          "--compression=ZSTD --bitmap_index_columns=1 --predicates=\"1:eq:abc\" "
+          "--warm_page_cache=true --vectorized=true\n";
     ss << "./benchmark_tool --operation=SegmentWrite --column_type=int "
           "--rows_number=10000 --iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentScanByFile --input_file=./sample.dat "
@@ -113,6 +144,8 @@ public:
 
     virtual void init() {}
     virtual void run() {}
+    // adds the counters of the benchmark after the iterations
+    virtual void report(benchmark::State& state) {}
 
     void register_bm() {
         auto bm = benchmark::RegisterBenchmark(_name.c_str(), [&](benchmark::State& state) {
@@ -125,6 +158,7 @@ public:
                 state.ResumeTiming();
                 this->run();
             }
+            this->report(state);
         });
         if (_iterations != 0) {
             bm->Iterations(_iterations);
@@ -278,6 +312,7 @@ public:
             FileUtils::remove_all(kSegmentDir);
         }
         FileUtils::create_dir(kSegmentDir);
+        init_remote_fs();
 
         init_schema(column_type);
     }
@@ -289,11 +324,15 @@ public:
             FileUtils::remove_all(kSegmentDir);
         }
         FileUtils::create_dir(kSegmentDir);
+        init_remote_fs();
     }
     virtual ~SegmentBenchmark() override {
         if (FileUtils::check_exist(kSegmentDir)) {
             FileUtils::remove_all(kSegmentDir);
         }
+        for (const auto& path : _remote_files) {
+            WARN_IF_ERROR(_remote_fs->delete_file(path), "failed to delete " + path);
+        }
     }
 
     const Schema& get_schema() { return *_schema; }
@@ -333,10 +372,40 @@ public:
             }
         }
 
+        for (auto pos : column_positions(FLAGS_bitmap_index_columns, columns.size())) {
+            columns[pos]._has_bitmap_index = true;
+        }
+        for (auto pos : column_positions(FLAGS_bloom_filter_columns, columns.size())) {
+            columns[pos]._is_bf_column = true;
+        }
+
         _tablet_schema = _create_schema(columns);
         _schema = std::make_shared<Schema>(_tablet_schema);
 
+        std::vector<std::string> encodings =
+                strings::Split(FLAGS_encodings, ",", strings::SkipWhitespace());
+        CHECK_LE(encodings.size(), columns.size()) << "more encodings than columns";
+        for (int cid = 0; cid < encodings.size(); ++cid) {
+            segment_v2::EncodingTypePB encoding;
+            CHECK(segment_v2::EncodingTypePB_Parse(encodings[cid], &encoding))
+                    << "invalid encoding: " << encodings[cid];
+            _writer_opts.column_encodings[columns[cid].unique_id()] = encoding;
+        }
+        init_predicates();
+
         add_name(column_valid);
+        // the storage options given on the command line
+        for (const char* flag : {"cardinality", "encodings", "compression", "bitmap_index_columns",
+                                 "bloom_filter_columns", "predicates", "warm_page_cache",
+                                 "vectorized"}) {
+            auto info = gflags::GetCommandLineFlagInfoOrDie(flag);
+            if (!info.is_default) {
+                add_name(fmt::format("/{}:{}", flag, info.current_value));
+            }
+        }
+        if (_remote_fs != nullptr) {
+            add_name("/remote:s3");
+        }
     }
 
     void build_segment(std::vector<std::vector<std::string>> dataset,
@@ -349,10 +418,10 @@ public:
 
         std::unique_ptr<io::FileWriter> file_writer;
         fs->create_file(path, &file_writer);
-        SegmentWriterOptions opts;
         DataDir data_dir(kSegmentDir);
         data_dir.init();
-        SegmentWriter writer(file_writer.get(), 0, &_tablet_schema, &data_dir, INT32_MAX, opts);
+        SegmentWriter writer(file_writer.get(), 0, &_tablet_schema, &data_dir, INT32_MAX,
+                             _writer_opts);
         writer.init(1024);
 
         RowCursor row;
@@ -372,22 +441,195 @@ public:
         writer.finalize(&file_size, &index_size);
         file_writer->close();
 
+        if (_remote_fs != nullptr) {
+            Status st = _remote_fs->upload(path, filename);
+            CHECK(st.ok()) << "failed to upload " << path << ": " << st;
+            _remote_files.push_back(filename);
+            Segment::open(_remote_fs.get(), filename, seg_id, &_tablet_schema, res);
+            return;
+        }
         Segment::open(fs, path, seg_id, &_tablet_schema, res);
     }
 
     std::vector<std::vector<std::string>> generate_dataset(int rows_number) {
+        // the values of the columns if the cardinality is limited
+        std::vector<std::vector<std::string>> dictionaries(_tablet_schema.num_columns());
+        for (int cid = 0; cid < _tablet_schema.num_columns(); ++cid) {
+            for (int i = 0; i < FLAGS_cardinality; ++i) {
+                dictionaries[cid].emplace_back(rand_rng_by_type(_tablet_schema._cols[cid]._type));
+            }
+        }
         std::vector<std::vector<std::string>> dataset;
         while (rows_number--) {
             std::vector<std::string> row_data;
             for (int cid = 0; cid < _tablet_schema.num_columns(); ++cid) {
-                row_data.emplace_back(rand_rng_by_type(_tablet_schema._cols[cid]._type));
+                if (dictionaries[cid].empty()) {
+                    row_data.emplace_back(rand_rng_by_type(_tablet_schema._cols[cid]._type));
+                } else {
+                    int i = rand_rng_int(0, FLAGS_cardinality - 1);
+                    row_data.emplace_back(dictionaries[cid][i]);
+                }
             }
             dataset.emplace_back(row_data);
         }
         return dataset;
     }
 
+    // Scans the segment with the predicates of --predicates, the statistics of the scan are kept
+    // for report_scan().
+    void scan_segment(const std::shared_ptr<Segment>& segment) {
+        _stats = OlapReaderStatistics();
+        StorageReadOptions read_opts;
+        read_opts.stats = &_stats;
+        read_opts.use_page_cache = FLAGS_warm_page_cache;
+        if (!_conditions.empty()) {
+            read_opts.conditions = &_conditions;
+        }
+        for (auto& predicate : _predicates) {
+            read_opts.column_predicates.push_back(predicate.get());
+        }
+        std::unique_ptr<RowwiseIterator> iter;
+        Status st = segment->new_iterator(get_schema(), read_opts, &iter);
+        CHECK(st.ok()) << st;
+
+        if (FLAGS_vectorized) {
+            vectorized::Block block;
+            for (auto cid : get_schema().column_ids()) {
+                const Field* field = get_schema().column(cid);
+                auto type = Schema::get_data_type_ptr(*field);
+                block.insert({type->create_column(), type, field->name()});
+            }
+            do {
+                block.clear_column_data();
+                st = iter->next_batch(&block);
+            } while (st.ok());
+        } else {
+            RowBlockV2 block(get_schema(), 1024);
+            do {
+                block.clear();
+                st = iter->next_batch(&block);
+            } while (st.ok());
+        }
+        CHECK(st.is_end_of_file()) << st;
+    }
+
+    // the statistics of the last scan
+    void report_scan(benchmark::State& state) {
+        state.counters["RawRowsRead"] = _stats.raw_rows_read;
+        state.counters["RowsStatsFiltered"] = _stats.rows_stats_filtered;
+        state.counters["RowsBloomFilterFiltered"] = _stats.rows_bf_filtered;
+        state.counters["RowsBitmapIndexFiltered"] = _stats.rows_bitmap_index_filtered;
+        state.counters["RowsConditionsFiltered"] = _stats.rows_conditions_filtered;
+        state.counters["TotalPages"] = _stats.total_pages_num;
+        state.counters["CachedPages"] = _stats.cached_pages_num;
+        state.counters["CompressedBytesRead"] = benchmark::Counter(
+                _stats.compressed_bytes_read, benchmark::Counter::kDefaults,
+                benchmark::Counter::kIs1024);
+        state.counters["UncompressedBytesRead"] = benchmark::Counter(
+                _stats.uncompressed_bytes_read, benchmark::Counter::kDefaults,
+                benchmark::Counter::kIs1024);
+        state.counters["DecompressMs"] = _stats.decompress_ns / 1e6;
+        state.counters["IoMs"] = _stats.io_ns / 1e6;
+    }
+
 private:
+    void init_remote_fs() {
+        if (FLAGS_s3_endpoint.empty()) {
+            return;
+        }
+        std::map<std::string, std::string> properties = {{S3_AK, FLAGS_s3_ak},
+                                                         {S3_SK, FLAGS_s3_sk},
+                                                         {S3_ENDPOINT, FLAGS_s3_endpoint},
+                                                         {S3_REGION, FLAGS_s3_region}};
+        _remote_fs = std::make_shared<io::S3FileSystem>(properties, FLAGS_s3_bucket,
+                                                        FLAGS_s3_prefix, "benchmark_tool");
+        Status st = _remote_fs->connect();
+        CHECK(st.ok()) << "failed to connect to " << FLAGS_s3_endpoint << ": " << st;
+    }
+
+    static std::vector<int> column_positions(const std::string& str, size_t num_columns) {
+        std::vector<int> positions;
+        std::vector<std::string> tokens = strings::Split(str, ",", strings::SkipWhitespace());
+        for (const auto& token : tokens) {
+            int pos = std::stoi(token);
+            CHECK(pos >= 0 && pos < num_columns) << "invalid column position: " << token;
+            positions.push_back(pos);
+        }
+        return positions;
+    }
+
+    template <typename T>
+    static ColumnPredicate* new_predicate(uint32_t cid, const std::string& op,
+                                          const std::vector<T>& values) {
+        if (op == "in") {
+            phmap::flat_hash_set<T> set(values.begin(), values.end());
+            return new InListPredicate<T>(cid, std::move(set));
+        }
+        CHECK(values.size() == 1) << "only `in` takes several values";
+        if (op == "eq") {
+            return new EqualPredicate<T>(cid, values[0]);
+        } else if (op == "ne") {
+            return new NotEqualPredicate<T>(cid, values[0]);
+        } else if (op == "lt") {
+            return new LessPredicate<T>(cid, values[0]);
+        } else if (op == "le") {
+            return new LessEqualPredicate<T>(cid, values[0]);
+        } else if (op == "gt") {
+            return new GreaterPredicate<T>(cid, values[0]);
+        }
+        return new GreaterEqualPredicate<T>(cid, values[0]);
+    }
+
+    // The predicates are pushed down like TabletReader does: the conditions prune the pages by
+    // the zone maps and the bloom filters, the column predicates use the bitmap indexes and
+    // filter the rows.
+    void init_predicates() {
+        static const std::map<std::string, std::string> condition_ops = {
+                {"eq", "="}, {"ne", "!="}, {"lt", "<<"}, {"le", "<="},
+                {"gt", ">>"}, {"ge", ">="}, {"in", "*="}};
+        _conditions.finalize();
+        _conditions.set_tablet_schema(&_tablet_schema);
+        _predicates.clear();
+        std::vector<std::string> specs =
+                strings::Split(FLAGS_predicates, ";", strings::SkipWhitespace());
+        for (const auto& spec : specs) {
+            std::vector<std::string> tokens = strings::Split(spec, ":");
+            CHECK_EQ(tokens.size(), 3) << "invalid predicate: " << spec;
+            uint32_t cid = column_positions(tokens[0], _tablet_schema.num_columns())[0];
+            auto op = condition_ops.find(tokens[1]);
+            CHECK(op != condition_ops.end()) << "invalid predicate op: " << tokens[1];
+            const TabletColumn& column = _tablet_schema.column(cid);
+            std::vector<std::string> values = strings::Split(tokens[2], "|");
+
+            TCondition condition;
+            condition.column_name = column.name();
+            condition.condition_op = op->second;
+            condition.condition_values = values;
+            Status st = _conditions.append_condition(condition);
+            CHECK(st.ok()) << "invalid predicate " << spec << ": " << st;
+
+            if (column.type() == OLAP_FIELD_TYPE_INT) {
+                std::vector<int32_t> ints;
+                for (const auto& value : values) {
+                    ints.push_back(std::stoi(value));
+                }
+                _predicates.emplace_back(new_predicate(cid, tokens[1], ints));
+                continue;
+            }
+            // the char values are padded to the length of the column
+            size_t min_length = column.type() == OLAP_FIELD_TYPE_CHAR ? column.length() : 0;
+            std::vector<StringValue> strings;
+            for (const auto& value : values) {
+                size_t length = std::max(min_length, value.size());
+                char* buffer = reinterpret_cast<char*>(_pool.allocate(length));
+                memset(buffer, 0, length);
+                memcpy(buffer, value.data(), value.size());
+                strings.emplace_back(buffer, length);
+            }
+            _predicates.emplace_back(new_predicate(cid, tokens[1], strings));
+        }
+    }
+
     TabletSchema _create_schema(const std::vector<TabletColumn>& columns,
                                 int num_short_key_columns = -1) {
         TabletSchema res;
@@ -402,6 +644,8 @@ private:
         res._num_key_columns = num_key_columns;
         res._num_short_key_columns =
                 num_short_key_columns != -1 ? num_short_key_columns : num_key_columns;
+        CHECK(segment_v2::CompressionTypePB_Parse(FLAGS_compression, &res._compression_type))
+                << "invalid compression: " << FLAGS_compression;
         res.init_field_index_for_test();
         return res;
     }
@@ -411,6 +655,12 @@ private:
     MemPool _pool;
     TabletSchema _tablet_schema;
     std::shared_ptr<Schema> _schema;
+    SegmentWriterOptions _writer_opts;
+    Conditions _conditions;
+    std::vector<std::unique_ptr<ColumnPredicate>> _predicates;
+    OlapReaderStatistics _stats;
+    std::shared_ptr<io::S3FileSystem> _remote_fs;
+    std::vector<std::string> _remote_files;
 }; // namespace doris
 
 class SegmentWriteBenchmark : public SegmentBenchmark {
@@ -470,27 +720,19 @@ public:
               _dataset(generate_dataset(rows_number)) {}
     virtual ~SegmentScanBenchmark() override {}
 
-    virtual void init() override { build_segment(_dataset, &_segment); }
-    virtual void run() override {
-        StorageReadOptions read_opts;
-        read_opts.stats = &stats;
-        std::unique_ptr<RowwiseIterator> iter;
-        _segment->new_iterator(get_schema(), read_opts, &iter);
-        RowBlockV2 block(get_schema(), 1024);
-
-        int left = _dataset.size();
-        while (left > 0) {
-            int rows_read = std::min(left, 1024);
-            block.clear();
-            iter->next_batch(&block);
-            left -= rows_read;
+    // A warm scan reads the same segment again and again, a cold one reads a new segment of
+    // which no page is cached.
+    virtual void init() override {
+        if (!FLAGS_warm_page_cache || _segment == nullptr) {
+            build_segment(_dataset, &_segment);
         }
     }
+    virtual void run() override { scan_segment(_segment); }
+    virtual void report(benchmark::State& state) override { report_scan(state); }
 
 private:
     std::vector<std::vector<std::string>> _dataset;
     std::shared_ptr<Segment> _segment;
-    OlapReaderStatistics stats;
 };
 
 class SegmentScanByFileBenchmark : public SegmentBenchmark {
@@ -515,27 +757,19 @@ public:
     }
     virtual ~SegmentScanByFileBenchmark() override {}
 
-    virtual void init() override { build_segment(_dataset, &_segment); }
-    virtual void run() override {
-        StorageReadOptions read_opts;
-        read_opts.stats = &stats;
-        std::unique_ptr<RowwiseIterator> iter;
-        _segment->new_iterator(get_schema(), read_opts, &iter);
-        RowBlockV2 block(get_schema(), 1024);
-
-        int left = _dataset.size();
-        while (left > 0) {
-            int rows_read = std::min(left, 1024);
-            block.clear();
-            iter->next_batch(&block);
-            left -= rows_read;
+    // A warm scan reads the same segment again and again, a cold one reads a new segment of
+    // which no page is cached.
+    virtual void init() override {
+        if (!FLAGS_warm_page_cache || _segment == nullptr) {
+            build_segment(_dataset, &_segment);
         }
     }
+    virtual void run() override { scan_segment(_segment); }
+    virtual void report(benchmark::State& state) override { report_scan(state); }
 
 private:
     std::vector<std::vector<std::string>> _dataset;
     std::shared_ptr<Segment> _segment;
-    OlapReaderStatistics stats;
 };
 
 // This is sample custom test. User can write custom test code at custom_init()&custom_run().
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util/arrow/block_convertor.h"
+
+#define ARROW_UTIL_LOGGING_H
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris {
+
+TEST(ArrowBlockConvertorTest, Normal) {
+    auto int_column = vectorized::ColumnInt32::create();
+    auto double_column = vectorized::ColumnFloat64::create();
+    auto str_column = vectorized::ColumnString::create();
+    auto null_map = vectorized::ColumnUInt8::create();
+    for (int i = 0; i < 10; ++i) {
+        int_column->insert_value(i);
+        double_column->insert_value(i * 1.5);
+        std::string str = std::to_string(i);
+        str_column->insert_data(str.c_str(), str.size());
+        null_map->insert_value(i % 3 == 0);
+    }
+    auto str_type = vectorized::make_nullable(std::make_shared<vectorized::DataTypeString>());
+    vectorized::Block block(
+            {{std::move(int_column), std::make_shared<vectorized::DataTypeInt32>(), "k1"},
+             {std::move(double_column), std::make_shared<vectorized::DataTypeFloat64>(), "k2"},
+             {vectorized::ColumnNullable::create(std::move(str_column), std::move(null_map)),
+              str_type, "k3"}});
+
+    auto schema = arrow::schema({arrow::field("k1", arrow::int32(), false),
+                                 arrow::field("k2", arrow::float64(), false),
+                                 arrow::field("k3", arrow::utf8(), true)});
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    EXPECT_TRUE(
+            convert_to_arrow_batch(block, schema, arrow::default_memory_pool(), &record_batch)
+                    .ok());
+    EXPECT_EQ(10, record_batch->num_rows());
+    EXPECT_EQ(3, record_batch->num_columns());
+
+    auto k1 = std::static_pointer_cast<arrow::Int32Array>(record_batch->column(0));
+    auto k2 = std::static_pointer_cast<arrow::DoubleArray>(record_batch->column(1));
+    auto k3 = std::static_pointer_cast<arrow::StringArray>(record_batch->column(2));
+    EXPECT_EQ(0, k1->null_count());
+    EXPECT_EQ(4, k3->null_count());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i, k1->Value(i));
+        EXPECT_DOUBLE_EQ(i * 1.5, k2->Value(i));
+        if (i % 3 == 0) {
+            EXPECT_TRUE(k3->IsNull(i));
+        } else {
+            EXPECT_EQ(std::to_string(i), k3->GetString(i));
+        }
+    }
+}
+
+TEST(ArrowBlockConvertorTest, TypeMismatch) {
+    auto int_column = vectorized::ColumnInt32::create();
+    int_column->insert_value(1);
+    vectorized::Block block(
+            {{std::move(int_column), std::make_shared<vectorized::DataTypeInt32>(), "k1"}});
+    auto schema = arrow::schema({arrow::field("k1", arrow::int64(), false)});
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    EXPECT_FALSE(
+            convert_to_arrow_batch(block, schema, arrow::default_memory_pool(), &record_batch)
+                    .ok());
+
+    // the number of fields should match
+    auto schema2 = arrow::schema({arrow::field("k1", arrow::int32(), false),
+                                  arrow::field("k2", arrow::int32(), false)});
+    EXPECT_FALSE(
+            convert_to_arrow_batch(block, schema2, arrow::default_memory_pool(), &record_batch)
+                    .ok());
+}
+
+} // namespace doris
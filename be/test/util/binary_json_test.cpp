@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/binary_json.h"
+
+#include <gtest/gtest.h>
+
+#include "exprs/json_functions.h"
+
+namespace doris {
+
+static BinaryJsonValue find(const BinaryJsonValue& root, const std::string& path) {
+    std::vector<JsonPath> paths;
+    JsonFunctions::parse_json_paths(path, &paths);
+    BinaryJsonValue result;
+    EXPECT_TRUE(root.find_path(paths, &result).ok());
+    return result;
+}
+
+TEST(BinaryJsonTest, scalar) {
+    std::string buf;
+    EXPECT_TRUE(BinaryJsonValue::parse("null", &buf).ok());
+    EXPECT_TRUE(BinaryJsonValue(buf.data(), buf.size()).is_null());
+    EXPECT_TRUE(BinaryJsonValue::parse("true", &buf).ok());
+    EXPECT_TRUE(BinaryJsonValue(buf.data(), buf.size()).get_bool());
+    EXPECT_TRUE(BinaryJsonValue::parse("-9223372036854775808", &buf).ok());
+    EXPECT_EQ(INT64_MIN, BinaryJsonValue(buf.data(), buf.size()).get_int64());
+    EXPECT_TRUE(BinaryJsonValue::parse("1.5", &buf).ok());
+    EXPECT_EQ(1.5, BinaryJsonValue(buf.data(), buf.size()).get_double());
+    EXPECT_TRUE(BinaryJsonValue::parse("18446744073709551615", &buf).ok());
+    EXPECT_EQ(BinaryJsonValue::DOUBLE, BinaryJsonValue(buf.data(), buf.size()).type());
+    EXPECT_TRUE(BinaryJsonValue::parse("\"abc\"", &buf).ok());
+    EXPECT_EQ("abc", BinaryJsonValue(buf.data(), buf.size()).get_string());
+    EXPECT_TRUE(BinaryJsonValue::check(buf.data(), buf.size()).ok());
+
+    EXPECT_FALSE(BinaryJsonValue::parse("{\"k1\":", &buf).ok());
+}
+
+TEST(BinaryJsonTest, find_path) {
+    std::string json = R"({"k2":[1,{"k3":"v3"},[true,null]],"k1":"v1","my.key":2.5,"k1":"dup"})";
+    std::string buf;
+    ASSERT_TRUE(BinaryJsonValue::parse(json, &buf).ok());
+    ASSERT_TRUE(BinaryJsonValue::check(buf.data(), buf.size()).ok());
+    BinaryJsonValue root(buf.data(), buf.size());
+
+    EXPECT_EQ(BinaryJsonValue::OBJECT, root.type());
+    EXPECT_EQ(3, root.count());
+    EXPECT_EQ("v1", find(root, "$.k1").get_string());
+    EXPECT_EQ(2.5, find(root, "$.\"my.key\"").get_double());
+    EXPECT_EQ(1, find(root, "$.k2[0]").get_int64());
+    EXPECT_EQ("v3", find(root, "$.k2[1].k3").get_string());
+    EXPECT_EQ("[true,null]", find(root, "$.k2[2]").to_json());
+    EXPECT_EQ(root.to_json(), find(root, "$").to_json());
+
+    EXPECT_FALSE(find(root, "$.k0").is_valid());
+    EXPECT_FALSE(find(root, "$.k2[3]").is_valid());
+    EXPECT_FALSE(find(root, "$.k1[0]").is_valid());
+    EXPECT_FALSE(find(root, "$.k1.k3").is_valid());
+
+    std::vector<JsonPath> paths;
+    JsonFunctions::parse_json_paths("$.k2.k3", &paths);
+    BinaryJsonValue result;
+    EXPECT_TRUE(root.find_path(paths, &result).is_not_supported());
+
+    EXPECT_EQ(R"({"k1":"v1","k2":[1,{"k3":"v3"},[true,null]],"my.key":2.5})", root.to_json());
+}
+
+TEST(BinaryJsonTest, check) {
+    std::string buf;
+    ASSERT_TRUE(BinaryJsonValue::parse(R"({"a":[1,2],"b":{}})", &buf).ok());
+    EXPECT_TRUE(BinaryJsonValue::check(buf.data(), buf.size()).ok());
+    EXPECT_FALSE(BinaryJsonValue::check(buf.data(), buf.size() - 1).ok());
+    EXPECT_FALSE(BinaryJsonValue::check(buf.data(), 0).ok());
+
+    std::string corrupted = buf;
+    corrupted[0] = 100;
+    EXPECT_FALSE(BinaryJsonValue::check(corrupted.data(), corrupted.size()).ok());
+    corrupted = buf;
+    // the offset of the first member
+    corrupted[9] = 0;
+    EXPECT_FALSE(BinaryJsonValue::check(corrupted.data(), corrupted.size()).ok());
+}
+
+} // namespace doris
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "util/coding.h"
 #define private public
@@ -66,6 +67,70 @@ TEST(BitmapValueTest, bitmap_union) {
     EXPECT_EQ(5, bitmap2.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_fastunion) {
+    std::vector<BitmapValue> values;
+    values.emplace_back();
+    values.emplace_back(7ULL);
+    values.emplace_back(std::vector<uint64_t> {1, 2, 3});
+    values.emplace_back(std::vector<uint64_t> {3, 4, (1ULL << 40) + 1});
+    values.emplace_back((1ULL << 40) + 2);
+    for (int i = 0; i < 100; ++i) {
+        values.emplace_back(std::vector<uint64_t> {i * 1000ULL, i * 1000ULL + 1});
+    }
+    std::vector<const BitmapValue*> inputs;
+    BitmapValue expected;
+    for (const auto& value : values) {
+        inputs.push_back(&value);
+        expected |= value;
+    }
+
+    for (auto& result : {BitmapValue(), BitmapValue(5ULL), BitmapValue({5, 6})}) {
+        BitmapValue copy = result;
+        BitmapValue with_result = expected;
+        with_result |= result;
+        copy.fastunion(inputs);
+        EXPECT_EQ(with_result.cardinality(), copy.cardinality());
+        EXPECT_EQ(with_result.to_string(), copy.to_string());
+    }
+
+    // only singles keep the smaller types
+    BitmapValue single;
+    BitmapValue one(10ULL);
+    single.fastunion({&one, &one});
+    EXPECT_EQ(BitmapValue::SINGLE, single._type);
+    EXPECT_EQ(1, single.cardinality());
+
+    BitmapValue empty;
+    empty.fastunion({});
+    EXPECT_EQ(BitmapValue::EMPTY, empty._type);
+}
+
+TEST(BitmapValueTest, bitmap_union_serialized) {
+    std::vector<BitmapValue> values;
+    values.emplace_back();
+    values.emplace_back(7ULL);
+    values.emplace_back((1ULL << 40) + 2);
+    values.emplace_back(std::vector<uint64_t> {1, 2, 3});
+    values.emplace_back(std::vector<uint64_t> {3, 4, (1ULL << 40) + 1});
+    std::vector<std::string> serialized;
+    for (auto& value : values) {
+        std::string buf(value.getSizeInBytes(), '\0');
+        value.write(buf.data());
+        serialized.push_back(std::move(buf));
+    }
+
+    for (int first = 0; first < values.size(); ++first) {
+        BitmapValue expected;
+        BitmapValue merged;
+        for (int i = 0; i < values.size(); ++i) {
+            int idx = (first + i) % values.size();
+            expected |= values[idx];
+            EXPECT_TRUE(merged.union_serialized(serialized[idx].data()));
+            EXPECT_EQ(expected.to_string(), merged.to_string());
+        }
+    }
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
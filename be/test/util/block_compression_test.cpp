@@ -160,4 +160,53 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(segment_v2::CompressionTypePB::ZSTD);
 }
 
+TEST_F(BlockCompressionTest, zstd_dict) {
+    static const char* words[] = {"{\"city\": \"", "Beijing", "Shanghai", "\", \"user\": ",
+                                  "\"status\": \"active\"", "\"status\": \"deleted\"", "}"};
+    std::vector<std::string> samples;
+    for (int i = 0; i < 200; ++i) {
+        std::string sample;
+        while (sample.size() < 1000) {
+            sample.append(words[rand() % 8]);
+            sample.append(std::to_string(rand() % 100));
+        }
+        samples.push_back(std::move(sample));
+    }
+    std::vector<Slice> sample_slices(samples.begin(), samples.end());
+    std::string dict;
+    EXPECT_TRUE(train_zstd_dictionary(sample_slices, 4096, &dict).ok());
+    EXPECT_FALSE(dict.empty());
+    EXPECT_LE(dict.size(), 4096UL);
+
+    // too few samples to train a dictionary from
+    std::string empty_dict;
+    EXPECT_TRUE(train_zstd_dictionary({Slice("abc")}, 4096, &empty_dict).ok());
+    EXPECT_TRUE(empty_dict.empty());
+
+    auto zstd_dict = std::make_shared<ZstdDictionary>(dict);
+    std::unique_ptr<BlockCompressionCodec> dict_codec;
+    EXPECT_TRUE(get_zstd_dict_compression_codec(zstd_dict, dict_codec).ok());
+    std::unique_ptr<BlockCompressionCodec> codec;
+    EXPECT_TRUE(get_block_compression_codec(segment_v2::CompressionTypePB::ZSTD, codec).ok());
+
+    const std::string& orig = samples[0];
+    std::string compressed(dict_codec->max_compressed_len(orig.size()), '\0');
+    Slice compressed_slice(compressed);
+    EXPECT_TRUE(dict_codec->compress(orig, &compressed_slice).ok());
+    std::string plain_compressed(codec->max_compressed_len(orig.size()), '\0');
+    Slice plain_slice(plain_compressed);
+    EXPECT_TRUE(codec->compress(orig, &plain_slice).ok());
+    EXPECT_LT(compressed_slice.size, plain_slice.size);
+
+    // decompressed by another codec sharing the dictionary
+    std::unique_ptr<BlockCompressionCodec> other_codec;
+    EXPECT_TRUE(get_zstd_dict_compression_codec(zstd_dict, other_codec).ok());
+    for (int i = 0; i < 2; ++i) {
+        std::string uncompressed(orig.size(), '\0');
+        Slice uncompressed_slice(uncompressed);
+        EXPECT_TRUE(other_codec->decompress(compressed_slice, &uncompressed_slice).ok());
+        EXPECT_EQ(orig, uncompressed);
+    }
+}
+
 } // namespace doris
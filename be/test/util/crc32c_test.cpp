@@ -72,5 +72,23 @@ TEST(CRC, Extend) {
     EXPECT_EQ(Value("hello world", 11), Value(slices));
 }
 
+TEST(CRC, LargeBuffer) {
+    // large enough to be computed by interleaved streams, with an unaligned start and tail
+    std::vector<char> buf(3 * 4096 * 3 + 123);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf[i] = static_cast<char>(i * 31 + (i >> 7));
+    }
+    for (size_t offset : {0, 1, 5}) {
+        const char* data = buf.data() + offset;
+        size_t size = buf.size() - offset;
+        uint32_t expected = 0;
+        for (size_t i = 0; i < size; ++i) {
+            expected = Extend(expected, data + i, 1);
+        }
+        EXPECT_EQ(expected, Value(data, size));
+        EXPECT_EQ(expected, Extend(Value(data, 100), data + 100, size - 100));
+    }
+}
+
 } // namespace crc32c
 } // namespace doris
@@ -19,8 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "util/url_coding.h"
 
@@ -226,4 +229,65 @@ TEST_F(EncryptionUtilTest, sm4_with_iv_test_by_case) {
     EXPECT_EQ(source_2, decrypted_content_21);
 }
 
+TEST_F(EncryptionUtilTest, context_test) {
+    // the rows of a column, with the same or different keys, modes and ivs
+    struct Row {
+        EncryptionMode mode;
+        std::string key;
+        const char* iv;
+        std::string source;
+    };
+    std::vector<Row> rows = {{AES_128_ECB, _aes_key, nullptr, "hello, doris"},
+                             {AES_128_ECB, _aes_key, nullptr, "doris test"},
+                             {AES_128_CBC, _aes_key, "doris", "hello, doris"},
+                             {AES_128_CBC, _aes_key, "iv", "hello, doris"},
+                             {AES_128_CBC, "another_key", "iv", "doris test"},
+                             {SM4_128_ECB, _aes_key, nullptr, "hello, doris"},
+                             {AES_128_ECB, _aes_key, nullptr, ""}};
+    EncryptionContext encrypt_ctx;
+    EncryptionContext decrypt_ctx;
+    for (auto& row : rows) {
+        int cipher_len = row.source.length() + 16;
+        std::unique_ptr<unsigned char[]> expected(new unsigned char[cipher_len]);
+        int expected_length = EncryptionUtil::encrypt(
+                row.mode, (unsigned char*)row.source.c_str(), row.source.length(),
+                (unsigned char*)row.key.c_str(), row.key.length(), row.iv, true, expected.get());
+        EXPECT_TRUE(expected_length > 0);
+
+        std::unique_ptr<unsigned char[]> dest(new unsigned char[cipher_len]);
+        int ret_code = encrypt_ctx.encrypt(row.mode, (unsigned char*)row.source.c_str(),
+                                           row.source.length(), (unsigned char*)row.key.c_str(),
+                                           row.key.length(), row.iv, true, dest.get());
+        EXPECT_EQ(expected_length, ret_code);
+        EXPECT_EQ(0, memcmp(expected.get(), dest.get(), expected_length));
+
+        std::unique_ptr<char[]> decrypted(new char[cipher_len]);
+        ret_code = decrypt_ctx.decrypt(row.mode, dest.get(), expected_length,
+                                       (unsigned char*)row.key.c_str(), row.key.length(), row.iv,
+                                       true, (unsigned char*)decrypted.get());
+        EXPECT_EQ(row.source, std::string(decrypted.get(), std::max(ret_code, 0)));
+    }
+
+    // a bad row does not break the following ones
+    std::string bad_data = "not encrypted";
+    std::unique_ptr<char[]> decrypted(new char[bad_data.length() + 16]);
+    int ret_code = decrypt_ctx.decrypt(AES_128_ECB, (unsigned char*)bad_data.c_str(),
+                                       bad_data.length(), (unsigned char*)_aes_key.c_str(),
+                                       _aes_key.length(), nullptr, true,
+                                       (unsigned char*)decrypted.get());
+    EXPECT_EQ(AES_BAD_DATA, ret_code);
+    ret_code = decrypt_ctx.decrypt(AES_128_CBC, nullptr, 0, (unsigned char*)_aes_key.c_str(),
+                                   _aes_key.length(), nullptr, true,
+                                   (unsigned char*)decrypted.get());
+    EXPECT_EQ(AES_BAD_DATA, ret_code);
+
+    std::string case_1 = "9qYx8l1601oWHEVCREAqZg=="; // base64 for encrypted "hello, doris"
+    std::unique_ptr<char[]> encrypt_1(new char[case_1.length()]);
+    int length_1 = base64_decode(case_1.c_str(), case_1.length(), encrypt_1.get());
+    ret_code = decrypt_ctx.decrypt(AES_128_ECB, (unsigned char*)encrypt_1.get(), length_1,
+                                   (unsigned char*)_aes_key.c_str(), _aes_key.length(), nullptr,
+                                   true, (unsigned char*)decrypted.get());
+    EXPECT_EQ("hello, doris", std::string(decrypted.get(), std::max(ret_code, 0)));
+}
+
 } // namespace doris
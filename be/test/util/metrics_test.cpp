@@ -485,4 +485,50 @@ test_registry_task_duration_standard_deviation{instance="test",type="create_tabl
         registry.deregister_entity(entity);
     }
 }
+
+TEST_F(MetricsTest, CoreLocalHistogram) {
+    MetricRegistry registry("test_registry");
+    auto entity = registry.register_entity("test_entity");
+
+    MetricPrototype task_duration_type(MetricType::HISTOGRAM, MetricUnit::MILLISECONDS,
+                                       "task_duration");
+    CoreLocalHistogramMetric* task_duration =
+            (CoreLocalHistogramMetric*)entity->register_metric<CoreLocalHistogramMetric>(
+                    &task_duration_type);
+    // the values added on different cores are merged
+    std::vector<std::thread> adders;
+    for (int i = 0; i < 4; ++i) {
+        adders.emplace_back([task_duration, i]() {
+            for (int j = i * 25 + 1; j <= (i + 1) * 25; j++) {
+                task_duration->add(j);
+            }
+        });
+        adders.back().join();
+    }
+
+    HistogramMetric merged;
+    task_duration->merge_to(&merged);
+    EXPECT_EQ(100, merged.num());
+    EXPECT_EQ(5050, merged.sum());
+    EXPECT_EQ(1, merged.min());
+    EXPECT_EQ(100, merged.max());
+
+    EXPECT_EQ(R"(# TYPE test_registry_task_duration histogram
+test_registry_task_duration{quantile="0.50"} 50
+test_registry_task_duration{quantile="0.75"} 75
+test_registry_task_duration{quantile="0.90"} 95.8333
+test_registry_task_duration{quantile="0.95"} 100
+test_registry_task_duration{quantile="0.99"} 100
+test_registry_task_duration_sum 5050
+test_registry_task_duration_count 100
+test_registry_task_duration_max 100
+test_registry_task_duration_min 1
+test_registry_task_duration_average 50.5
+test_registry_task_duration_median 50
+test_registry_task_duration_standard_deviation 28.8661
+)",
+              registry.to_prometheus());
+    registry.deregister_entity(entity);
+}
+
 } // namespace doris
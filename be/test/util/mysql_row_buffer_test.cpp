@@ -119,4 +119,36 @@ TEST(MysqlRowBufferTest, dynamic_mode) {
     EXPECT_EQ(0, strncmp(buf + 43, "test", 4));
 }
 
+TEST(MysqlRowBufferTest, dynamic_mode_grow) {
+    MysqlRowBuffer mrb;
+    // fill the default buffer so that the dynamic column grows the buffer
+    std::string s(4000, 'a');
+    mrb.push_string(s.c_str(), s.size());
+    int64_t column_start = mrb.length();
+
+    mrb.open_dynamic_mode();
+    std::string t(5000, 'b');
+    mrb.push_string(t.c_str(), t.size());
+    mrb.push_int(12345);
+    mrb.close_dynamic_mode();
+
+    const char* buf = mrb.buf() + column_start;
+    EXPECT_EQ(254, *((uint8_t*)(buf)));
+    EXPECT_EQ(5005, *((int64_t*)(buf + 1)));
+    EXPECT_EQ(0, strncmp(buf + 9, t.c_str(), t.size()));
+    EXPECT_EQ(0, strncmp(buf + 9 + t.size(), "12345", 5));
+    EXPECT_EQ(column_start + 9 + 5005, mrb.length());
+}
+
+TEST(MysqlRowBufferTest, reserve) {
+    MysqlRowBuffer mrb;
+    EXPECT_EQ(0, mrb.reserve(100000));
+    const char* buf = mrb.buf();
+    for (int i = 0; i < 10000; ++i) {
+        mrb.push_int(i);
+    }
+    // no more allocation after the reservation
+    EXPECT_EQ(buf, mrb.buf());
+}
+
 } // namespace doris
@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/perf_counters.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+
+static int64_t busy_loop(int n) {
+    volatile int64_t sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += i;
+    }
+    return sum;
+}
+
+TEST(ThreadPerfCountersTest, exclusive_scopes) {
+    if (ThreadPerfCounters::current() == nullptr) {
+        GTEST_SKIP() << "perf_event is not available";
+    }
+    RuntimeProfile parent_profile("parent");
+    RuntimeProfile child_profile("child");
+    ProfilePerfCounters parent(&parent_profile);
+    ProfilePerfCounters child(&child_profile);
+    {
+        SCOPED_PERF_COUNTERS(&parent);
+        busy_loop(1000);
+        {
+            SCOPED_PERF_COUNTERS(&child);
+            busy_loop(1000000);
+        }
+    }
+    auto name = ThreadPerfCounters::name(ThreadPerfCounters::INSTRUCTIONS);
+    auto parent_instructions = parent_profile.get_counter(name)->value();
+    auto child_instructions = child_profile.get_counter(name)->value();
+    // the instructions of the child are not counted by the parent, unless the counter is
+    // not supported, e.g. in a virtual machine
+    if (child_instructions > 0) {
+        EXPECT_GT(child_instructions, 1000000);
+        EXPECT_LT(parent_instructions, child_instructions);
+    }
+}
+
+TEST(ThreadPerfCountersTest, disabled) {
+    // does nothing without counters
+    SCOPED_PERF_COUNTERS(nullptr);
+}
+
+} // namespace doris
@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/priority_work_stealing_thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "util/countdown_latch.h"
+
+namespace doris {
+
+TEST(PriorityWorkStealingThreadPoolTest, RunAllTasks) {
+    PriorityWorkStealingThreadPool pool(8, 3, 100);
+    std::atomic<int> count {0};
+    CountDownLatch latch(300);
+    for (int i = 0; i < 300; ++i) {
+        PriorityThreadPool::Task task;
+        task.priority = i % 20;
+        task.queue_id = i % 3;
+        task.work_function = [&] {
+            count++;
+            latch.count_down();
+        };
+        EXPECT_TRUE(pool.offer(task));
+    }
+    latch.wait();
+    EXPECT_EQ(300, count.load());
+    EXPECT_EQ(0, pool.get_queue_size());
+}
+
+TEST(PriorityWorkStealingThreadPoolTest, StealFromBusyQueue) {
+    // all the tasks are put on the workers of queue 0, the workers of queue 1 steal them
+    PriorityWorkStealingThreadPool pool(4, 2, 100);
+    int64_t stolen = DorisMetrics::instance()->scanner_thread_pool_stolen_task_total->value();
+    CountDownLatch latch(40);
+    for (int i = 0; i < 40; ++i) {
+        PriorityThreadPool::Task task;
+        task.priority = 0;
+        task.queue_id = 0;
+        task.work_function = [&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            latch.count_down();
+        };
+        EXPECT_TRUE(pool.offer(task));
+    }
+    latch.wait();
+    EXPECT_GT(DorisMetrics::instance()->scanner_thread_pool_stolen_task_total->value(), stolen);
+}
+
+TEST(PriorityWorkStealingThreadPoolTest, BlockWhenFull) {
+    PriorityWorkStealingThreadPool pool(1, 1, 2);
+    CountDownLatch start(1);
+    std::atomic<int> count {0};
+    // occupies the only worker
+    pool.offer([&] {
+        start.wait();
+        count++;
+    });
+    while (pool.get_queue_size() != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(pool.offer([&] { count++; }));
+    EXPECT_TRUE(pool.offer([&] { count++; }));
+
+    std::atomic<bool> offered {false};
+    std::thread t([&] {
+        pool.offer([&] { count++; });
+        offered = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(offered.load());
+
+    start.count_down();
+    t.join();
+    EXPECT_TRUE(offered.load());
+    pool.drain_and_shutdown();
+    EXPECT_EQ(4, count.load());
+}
+
+TEST(PriorityWorkStealingThreadPoolTest, OfferAfterShutdown) {
+    PriorityWorkStealingThreadPool pool(2, 1, 10);
+    pool.shutdown();
+    EXPECT_FALSE(pool.offer([] {}));
+    pool.join();
+}
+
+} // namespace doris
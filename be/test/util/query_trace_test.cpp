@@ -0,0 +1,156 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/query_trace.h"
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include <thread>
+
+#include "common/config.h"
+
+namespace doris {
+
+class QueryTraceTest : public testing::Test {
+public:
+    void SetUp() override {
+        _saved_enabled = config::enable_query_trace;
+        _saved_capacity = config::query_trace_thread_buffer_events;
+        config::enable_query_trace = true;
+        QueryTracer::instance()->clear();
+    }
+
+    void TearDown() override {
+        config::enable_query_trace = _saved_enabled;
+        config::query_trace_thread_buffer_events = _saved_capacity;
+    }
+
+    // The spans of a thread are dropped when it exits, so they are copied by the thread.
+    static std::vector<QueryTraceEvent> trace_in_thread(int num_spans) {
+        std::vector<QueryTraceEvent> events;
+        std::thread thread([&]() {
+            for (int i = 0; i < num_spans; ++i) {
+                SCOPED_QUERY_TRACE("test", i % 2 == 0 ? "even" : "odd");
+            }
+            QueryTracer::instance()->get_events(nullptr, &events);
+        });
+        thread.join();
+        return events;
+    }
+
+private:
+    bool _saved_enabled;
+    int32_t _saved_capacity;
+};
+
+TEST_F(QueryTraceTest, record) {
+    auto events = trace_in_thread(3);
+    ASSERT_EQ(3, events.size());
+    EXPECT_STREQ("even", events[0].name);
+    EXPECT_STREQ("odd", events[1].name);
+    EXPECT_STREQ("even", events[2].name);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_STREQ("test", events[i].category);
+        EXPECT_GE(events[i].duration_ns, 0);
+        if (i > 0) {
+            EXPECT_LE(events[i - 1].start_ns, events[i].start_ns);
+        }
+    }
+    // dropped with the thread
+    events.clear();
+    QueryTracer::instance()->get_events(nullptr, &events);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(QueryTraceTest, disabled) {
+    config::enable_query_trace = false;
+    EXPECT_TRUE(trace_in_thread(3).empty());
+}
+
+TEST_F(QueryTraceTest, overwrite_oldest) {
+    config::query_trace_thread_buffer_events = 4;
+    auto events = trace_in_thread(10);
+    ASSERT_EQ(4, events.size());
+    // the last 4 spans, 6 to 9
+    EXPECT_STREQ("even", events[0].name);
+    EXPECT_STREQ("odd", events[3].name);
+}
+
+TEST_F(QueryTraceTest, clear) {
+    std::vector<QueryTraceEvent> events;
+    std::thread thread([&]() {
+        { SCOPED_QUERY_TRACE("test", "before"); }
+        QueryTracer::instance()->clear();
+        { SCOPED_QUERY_TRACE("test", "after"); }
+        QueryTracer::instance()->get_events(nullptr, &events);
+    });
+    thread.join();
+    ASSERT_EQ(1, events.size());
+    EXPECT_STREQ("after", events[0].name);
+}
+
+TEST_F(QueryTraceTest, filter_query) {
+    TUniqueId query_id;
+    query_id.hi = 1;
+    query_id.lo = 2;
+    std::vector<QueryTraceEvent> events;
+    std::thread thread([&]() {
+        { SCOPED_QUERY_TRACE("test", "span"); }
+        QueryTracer::instance()->get_events(&query_id, &events);
+    });
+    thread.join();
+    // not attached to any fragment instance of the query
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(QueryTraceTest, chrome_trace) {
+    auto events = trace_in_thread(2);
+    rapidjson::Document doc;
+    doc.Parse(QueryTracer::to_chrome_trace(events).c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    auto& trace_events = doc["traceEvents"];
+    ASSERT_EQ(2, trace_events.Size());
+    EXPECT_STREQ("even", trace_events[0]["name"].GetString());
+    EXPECT_STREQ("test", trace_events[0]["cat"].GetString());
+    EXPECT_STREQ("X", trace_events[0]["ph"].GetString());
+    EXPECT_EQ(events[0].thread_id, trace_events[0]["tid"].GetInt64());
+    EXPECT_GE(trace_events[1]["ts"].GetDouble(), trace_events[0]["ts"].GetDouble());
+}
+
+TEST_F(QueryTraceTest, otlp_json) {
+    auto events = trace_in_thread(2);
+    TUniqueId query_id;
+    query_id.hi = 0x1234;
+    query_id.lo = 0x5678;
+    for (auto& event : events) {
+        event.fragment_instance_id.hi = query_id.hi;
+        event.fragment_instance_id.lo = query_id.lo + 1;
+    }
+    rapidjson::Document doc;
+    doc.Parse(QueryTracer::to_otlp_json(events, &query_id).c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    auto& spans = doc["resourceSpans"][0]["scopeSpans"][0]["spans"];
+    ASSERT_EQ(2, spans.Size());
+    EXPECT_STREQ("00000000000012340000000000005678", spans[0]["traceId"].GetString());
+    EXPECT_STRNE(spans[0]["spanId"].GetString(), spans[1]["spanId"].GetString());
+    EXPECT_STREQ("even", spans[0]["name"].GetString());
+    EXPECT_LE(std::stoull(spans[0]["startTimeUnixNano"].GetString()),
+              std::stoull(spans[0]["endTimeUnixNano"].GetString()));
+}
+
+} // namespace doris
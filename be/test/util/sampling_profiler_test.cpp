@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/sampling_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include "util/uid_util.h"
+
+namespace doris {
+
+TEST(SamplingProfilerTest, tag_fragment_instance) {
+    TUniqueId instance_id;
+    instance_id.hi = 0x1234;
+    instance_id.lo = 0x5679;
+    std::atomic<bool> stop {false};
+    std::thread busy([&]() {
+        SamplingProfiler::set_thread_fragment_instance(instance_id);
+        volatile int64_t sum = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            sum += 1;
+        }
+        SamplingProfiler::set_thread_fragment_instance(TUniqueId());
+    });
+
+    TUniqueId query_id;
+    query_id.hi = 0x1234;
+    query_id.lo = 0x5678;
+    std::string stacks;
+    Status st = SamplingProfiler::profile(1, 99, &query_id, &stacks);
+    stop = true;
+    busy.join();
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_FALSE(stacks.empty());
+    // only the samples of the query
+    std::string root = "fragment_" + print_id(instance_id) + ";";
+    std::stringstream ss(stacks);
+    std::string line;
+    while (std::getline(ss, line)) {
+        EXPECT_EQ(0, line.find(root)) << line;
+    }
+
+    TUniqueId other_query_id;
+    other_query_id.hi = 1;
+    other_query_id.lo = 1;
+    ASSERT_TRUE(SamplingProfiler::profile(1, 99, &other_query_id, &stacks).ok());
+    EXPECT_TRUE(stacks.empty());
+}
+
+TEST(SamplingProfilerTest, invalid_argument) {
+    std::string stacks;
+    EXPECT_FALSE(SamplingProfiler::profile(0, 99, nullptr, &stacks).ok());
+    EXPECT_FALSE(SamplingProfiler::profile(1, 0, nullptr, &stacks).ok());
+}
+
+} // namespace doris
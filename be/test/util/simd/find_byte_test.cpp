@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/find_byte.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris {
+
+TEST(FindByteTest, find_all_bytes) {
+    std::vector<size_t> positions;
+    simd::find_all_bytes(reinterpret_cast<const uint8_t*>(""), 0, ',', &positions);
+    EXPECT_TRUE(positions.empty());
+
+    // cover the bytes compared 32 at a time and the tail
+    for (size_t len : {1, 31, 32, 33, 64, 100}) {
+        std::string str(len, 'a');
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < len; i += 3) {
+            str[i] = ',';
+            expected.push_back(i);
+        }
+        positions.clear();
+        simd::find_all_bytes(reinterpret_cast<const uint8_t*>(str.data()), str.size(), ',',
+                             &positions);
+        EXPECT_EQ(expected, positions) << len;
+    }
+
+    // bytes larger than 0x7f
+    std::string str = "\xff\x01\xff";
+    std::vector<uint32_t> positions32;
+    simd::find_all_bytes(reinterpret_cast<const uint8_t*>(str.data()), str.size(), 0xff,
+                         &positions32);
+    EXPECT_EQ(std::vector<uint32_t>({0, 2}), positions32);
+}
+
+} // namespace doris
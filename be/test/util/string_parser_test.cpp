@@ -212,6 +212,20 @@ TEST(StringToInt, InvalidLeadingTrailing) {
     test_int_value<int8_t>("   ", 0, StringParser::PARSE_FAILURE);
 }
 
+TEST(StringToInt, LongDigits) {
+    // more than 8 digits after the first one are converted by chunks
+    test_int_value<int32_t>("123456789", 123456789, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("-987654321", -987654321, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("1234567890123456789", 1234567890123456789,
+                            StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("100000000000000000", 100000000000000000,
+                            StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("12345678901234   ", 12345678901234, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("1234567a901234", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("123456789012:4", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("12345678 9", 0, StringParser::PARSE_FAILURE);
+}
+
 TEST(StringToInt, Limit) {
     test_int_value<int8_t>("127", 127, StringParser::PARSE_SUCCESS);
     test_int_value<int8_t>("-128", -128, StringParser::PARSE_SUCCESS);
@@ -234,4 +234,47 @@ TEST_F(TDigestTest, Montonicity) {
     }
 }
 
+TEST_F(TDigestTest, BatchAdd) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> reals(0.0, 1000.0);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(reals(gen));
+    }
+    values.push_back(NAN);
+
+    TDigest digest(100);
+    for (auto value : values) {
+        digest.add(value);
+    }
+    TDigest batch_digest(100);
+    batch_digest.add(values.data(), values.size());
+
+    EXPECT_FLOAT_EQ(digest.processedWeight() + digest.unprocessedWeight(),
+                    batch_digest.processedWeight() + batch_digest.unprocessedWeight());
+    for (double q = 0; q <= 1; q += 0.1) {
+        EXPECT_FLOAT_EQ(digest.quantile(q), batch_digest.quantile(q)) << "q = " << q;
+    }
+}
+
+TEST_F(TDigestTest, SerializeProcessed) {
+    TDigest digest(100);
+    for (int i = 0; i < 500; i++) {
+        digest.add(i);
+    }
+    EXPECT_TRUE(digest.haveUnprocessed());
+
+    std::string buf(digest.serialized_size(), '0');
+    EXPECT_FALSE(digest.haveUnprocessed());
+    EXPECT_EQ(buf.size(), digest.serialize((uint8_t*)buf.data()));
+
+    TDigest other(100);
+    other.unserialize((const uint8_t*)buf.data());
+    EXPECT_FALSE(other.haveUnprocessed());
+    EXPECT_EQ(digest.processed().size(), other.processed().size());
+    for (double q = 0; q <= 1; q += 0.1) {
+        EXPECT_FLOAT_EQ(digest.quantile(q), other.quantile(q)) << "q = " << q;
+    }
+}
+
 } // namespace doris
@@ -20,10 +20,15 @@
 
 #include "gtest/gtest.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/aggregate_function_distinct_shared.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/aggregate_functions/aggregate_function_sort.h"
 #include "vec/aggregate_functions/aggregate_function_topn.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/column_vector.h"
+#include "vec/common/arena.h"
 #include "vec/data_types/data_type.h"
+#include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/data_types/data_type_string.h"
 
@@ -33,6 +38,10 @@ namespace doris::vectorized {
 // declare function
 void register_aggregate_function_sum(AggregateFunctionSimpleFactory& factory);
 void register_aggregate_function_topn(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_uniq(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_group_concat(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_combinator_null(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_combinator_distinct(AggregateFunctionSimpleFactory& factory);
 
 TEST(AggTest, basic_test) {
     auto column_vector_int32 = ColumnVector<Int32>::create();
@@ -96,4 +105,316 @@ TEST(AggTest, topn_test) {
     EXPECT_EQ(result, expect_result);
     agg_function->destroy(place);
 }
+
+TEST(AggTest, uniq_deserialize_and_merge_test) {
+    // two partial states with [0, 3000) and [2000, 4096), overlapping in [2000, 3000)
+    auto lhs_column = ColumnInt64::create();
+    auto rhs_column = ColumnInt64::create();
+    for (Int64 i = 0; i < agg_test_batch_size; i++) {
+        if (i < 3000) {
+            lhs_column->insert_value(i);
+        }
+        if (i >= 2000) {
+            rhs_column->insert_value(i);
+        }
+    }
+
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_uniq(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt64>()};
+    Array array;
+    auto agg_function = factory.get("multi_distinct_count", data_types, array);
+
+    std::unique_ptr<char[]> memory(new char[agg_function->size_of_data() * 3]);
+    AggregateDataPtr place = memory.get();
+    AggregateDataPtr rhs = place + agg_function->size_of_data();
+    AggregateDataPtr tmp = rhs + agg_function->size_of_data();
+    agg_function->create(place);
+    agg_function->create(rhs);
+
+    const IColumn* lhs_columns[1] = {lhs_column.get()};
+    const IColumn* rhs_columns[1] = {rhs_column.get()};
+    for (size_t i = 0; i < lhs_column->size(); i++) {
+        agg_function->add(place, lhs_columns, i, nullptr);
+    }
+    for (size_t i = 0; i < rhs_column->size(); i++) {
+        agg_function->add(rhs, rhs_columns, i, nullptr);
+    }
+
+    ColumnString buf;
+    VectorBufferWriter buf_writer(buf);
+    agg_function->serialize(rhs, buf_writer);
+    buf_writer.commit();
+    VectorBufferReader buf_reader(buf.get_data_at(0));
+    agg_function->deserialize_and_merge(place, tmp, buf_reader, nullptr);
+
+    ColumnInt64 result;
+    agg_function->insert_result_into(place, result);
+    EXPECT_EQ(agg_test_batch_size, result.get_data()[0]);
+
+    agg_function->destroy(place);
+    agg_function->destroy(rhs);
+}
+
+TEST(AggTest, uniq_few_values_test) {
+    // few distinct values stay inline, and move to the hash set after merging
+    auto lhs_column = ColumnInt64::create();
+    auto rhs_column = ColumnInt64::create();
+    for (Int64 i = 0; i < 100; i++) {
+        lhs_column->insert_value(i % 3);
+        rhs_column->insert_value(i % 5 + 3);
+    }
+
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_uniq(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt64>()};
+    Array array;
+    auto agg_function = factory.get("multi_distinct_count", data_types, array);
+
+    std::unique_ptr<char[]> memory(new char[agg_function->size_of_data() * 3]);
+    AggregateDataPtr place = memory.get();
+    AggregateDataPtr rhs = place + agg_function->size_of_data();
+    AggregateDataPtr tmp = rhs + agg_function->size_of_data();
+    agg_function->create(place);
+    agg_function->create(rhs);
+
+    const IColumn* lhs_columns[1] = {lhs_column.get()};
+    const IColumn* rhs_columns[1] = {rhs_column.get()};
+    for (size_t i = 0; i < lhs_column->size(); i++) {
+        agg_function->add(place, lhs_columns, i, nullptr);
+        agg_function->add(rhs, rhs_columns, i, nullptr);
+    }
+
+    ColumnInt64 partial;
+    agg_function->insert_result_into(rhs, partial);
+    EXPECT_EQ(5, partial.get_data()[0]);
+
+    ColumnString buf;
+    VectorBufferWriter buf_writer(buf);
+    agg_function->serialize(rhs, buf_writer);
+    buf_writer.commit();
+    VectorBufferReader buf_reader(buf.get_data_at(0));
+    agg_function->deserialize_and_merge(place, tmp, buf_reader, nullptr);
+
+    ColumnInt64 result;
+    agg_function->insert_result_into(place, result);
+    EXPECT_EQ(8, result.get_data()[0]);
+
+    agg_function->destroy(place);
+    agg_function->destroy(rhs);
+}
+
+TEST(AggTest, group_concat_test) {
+    // the values of lhs span several chunks
+    auto lhs_column = ColumnString::create();
+    auto rhs_column = ColumnString::create();
+    std::string expect_result;
+    for (int i = 0; i < agg_test_batch_size; i++) {
+        std::string str = "v" + std::to_string(i);
+        lhs_column->insert_data(str.c_str(), str.length());
+        expect_result += (i == 0 ? "" : ", ") + str;
+    }
+    for (int i = 0; i < 10; i++) {
+        std::string str = "w" + std::to_string(i);
+        rhs_column->insert_data(str.c_str(), str.length());
+        expect_result += ", " + str;
+    }
+
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_group_concat(factory);
+    DataTypes data_types = {std::make_shared<DataTypeString>()};
+    Array array;
+    auto agg_function = factory.get("group_concat", data_types, array);
+    EXPECT_TRUE(agg_function->allocates_memory_in_arena());
+
+    std::unique_ptr<char[]> memory(new char[agg_function->size_of_data() * 3]);
+    AggregateDataPtr place = memory.get();
+    AggregateDataPtr rhs = place + agg_function->size_of_data();
+    AggregateDataPtr tmp = rhs + agg_function->size_of_data();
+    agg_function->create(place);
+    agg_function->create(rhs);
+
+    Arena arena;
+    const IColumn* lhs_columns[1] = {lhs_column.get()};
+    const IColumn* rhs_columns[1] = {rhs_column.get()};
+    for (size_t i = 0; i < lhs_column->size(); i++) {
+        agg_function->add(place, lhs_columns, i, &arena);
+    }
+    // no arena is passed by the window functions
+    for (size_t i = 0; i < rhs_column->size(); i++) {
+        agg_function->add(rhs, rhs_columns, i, nullptr);
+    }
+
+    ColumnString buf;
+    VectorBufferWriter buf_writer(buf);
+    agg_function->serialize(rhs, buf_writer);
+    buf_writer.commit();
+    VectorBufferReader buf_reader(buf.get_data_at(0));
+    agg_function->deserialize_and_merge(place, tmp, buf_reader, &arena);
+
+    ColumnString result;
+    agg_function->insert_result_into(place, result);
+    EXPECT_EQ(expect_result, result.get_data_at(0).to_string());
+
+    agg_function->reset(rhs);
+    agg_function->insert_result_into(rhs, result);
+    EXPECT_EQ("", result.get_data_at(1).to_string());
+
+    agg_function->destroy(place);
+    agg_function->destroy(rhs);
+}
+
+TEST(AggTest, group_concat_order_by_test) {
+    // group_concat(v ORDER BY k ASC NULLS FIRST), the null values are skipped and the null
+    // keys come first
+    std::vector<const char*> values = {"a", "b", "c", "d", nullptr};
+    std::vector<int32_t> keys = {2, -1, 3, 1, 0};
+    auto value_column = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+    auto key_column = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    for (size_t i = 0; i < values.size(); i++) {
+        value_column->insert_data(values[i], values[i] == nullptr ? 0 : strlen(values[i]));
+        key_column->insert_data(keys[i] < 0 ? nullptr : reinterpret_cast<char*>(&keys[i]),
+                                sizeof(int32_t));
+    }
+
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_group_concat(factory);
+    register_aggregate_function_combinator_null(factory);
+    DataTypes data_types = {make_nullable(std::make_shared<DataTypeString>()),
+                            make_nullable(std::make_shared<DataTypeInt32>())};
+    SortDescription sort_desc(1);
+    sort_desc[0].column_number = 1;
+    sort_desc[0].direction = 1;
+    sort_desc[0].nulls_direction = -1;
+    Array array;
+    auto nested_function = factory.get("group_concat", {data_types[0]}, array, true);
+    auto agg_function = AggregateFunctionSort::create(nested_function, data_types, sort_desc);
+
+    std::unique_ptr<char[]> memory(new char[agg_function->size_of_data() * 3]);
+    AggregateDataPtr place = memory.get();
+    AggregateDataPtr rhs = place + agg_function->size_of_data();
+    AggregateDataPtr tmp = rhs + agg_function->size_of_data();
+    agg_function->create(place);
+    agg_function->create(rhs);
+
+    // the rows are split into two states, and merged through the serialized one
+    const IColumn* columns[2] = {value_column.get(), key_column.get()};
+    for (size_t i = 0; i < values.size(); i++) {
+        agg_function->add(i % 2 == 0 ? place : rhs, columns, i, nullptr);
+    }
+    ColumnString buf;
+    VectorBufferWriter buf_writer(buf);
+    agg_function->serialize(rhs, buf_writer);
+    buf_writer.commit();
+    VectorBufferReader buf_reader(buf.get_data_at(0));
+    agg_function->deserialize_and_merge(place, tmp, buf_reader, nullptr);
+
+    auto result = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+    agg_function->insert_result_into(place, *result);
+    EXPECT_EQ("b, d, a, c", result->get_data_at(0).to_string());
+
+    agg_function->destroy(place);
+    agg_function->destroy(rhs);
+}
+
+TEST(AggTest, shared_distinct_test) {
+    // two groups of a count and a sum distinct whose keys are in one hash table
+    auto column = ColumnInt64::create();
+    for (Int64 i = 0; i < 1000; i++) {
+        column->insert_value(i % 37 - 10);
+    }
+
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_sum(factory);
+    register_aggregate_function_uniq(factory);
+    register_aggregate_function_combinator_distinct(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt64>()};
+    Array array;
+    AggregateFunctionPtr functions[2] = {factory.get("multi_distinct_count", data_types, array),
+                                         factory.get("multi_distinct_sum", data_types, array)};
+
+    auto keys = std::make_shared<SharedDistinctKeys>();
+    AggregateFunctionPtr shared_functions[2];
+    for (int i = 0; i < 2; i++) {
+        shared_functions[i] = functions[i]->create_shared_distinct(keys, true);
+        ASSERT_NE(nullptr, shared_functions[i]);
+        EXPECT_EQ(functions[i]->get_name(), shared_functions[i]->get_name());
+    }
+
+    const IColumn* columns[1] = {column.get()};
+    std::vector<std::unique_ptr<char[]>> memory;
+    auto create = [&](const AggregateFunctionPtr& function) {
+        memory.emplace_back(new char[function->size_of_data()]);
+        function->create(memory.back().get());
+        return memory.back().get();
+    };
+    // the rows of group i are the ones of row % 3 == i, the even rows of group 0 are added
+    // into a state merged into it
+    AggregateDataPtr places[2][2];
+    AggregateDataPtr shared_places[2][2];
+    for (int f = 0; f < 2; f++) {
+        for (int g = 0; g < 2; g++) {
+            places[f][g] = create(functions[f]);
+            shared_places[f][g] = create(shared_functions[f]);
+        }
+        AggregateDataPtr shared_rhs = create(shared_functions[f]);
+        for (size_t i = 0; i < column->size(); i++) {
+            if (i % 3 > 1) {
+                continue;
+            }
+            functions[f]->add(places[f][i % 3], columns, i, nullptr);
+            bool to_rhs = i % 3 == 0 && i % 2 == 0;
+            shared_functions[f]->add(to_rhs ? shared_rhs : shared_places[f][i % 3], columns, i,
+                                     nullptr);
+        }
+        shared_functions[f]->merge(shared_places[f][0], shared_rhs, nullptr);
+        shared_functions[f]->destroy(shared_rhs);
+    }
+
+    auto result_of = [](const AggregateFunctionPtr& function, AggregateDataPtr place) {
+        ColumnInt64 result;
+        function->insert_result_into(place, result);
+        return result.get_data()[0];
+    };
+    for (int f = 0; f < 2; f++) {
+        for (int g = 0; g < 2; g++) {
+            EXPECT_EQ(result_of(functions[f], places[f][g]),
+                      result_of(shared_functions[f], shared_places[f][g]));
+        }
+    }
+    EXPECT_EQ(37, result_of(shared_functions[0], shared_places[0][0]));
+
+    // the serialized states are the same as the ones not shared in both ways
+    for (int f = 0; f < 2; f++) {
+        ColumnString buf;
+        VectorBufferWriter buf_writer(buf);
+        shared_functions[f]->serialize(shared_places[f][1], buf_writer);
+        buf_writer.commit();
+        functions[f]->serialize(places[f][0], buf_writer);
+        buf_writer.commit();
+
+        std::unique_ptr<char[]> tmp(new char[functions[f]->size_of_data()]);
+        AggregateDataPtr place = create(functions[f]);
+        VectorBufferReader shared_reader(buf.get_data_at(0));
+        functions[f]->deserialize_and_merge(place, tmp.get(), shared_reader, nullptr);
+        EXPECT_EQ(result_of(functions[f], places[f][1]), result_of(functions[f], place));
+
+        // the keys already in the state are not added again
+        auto final_function = functions[f]->create_shared_distinct(keys, false);
+        AggregateDataPtr final_place = create(final_function);
+        VectorBufferReader reader(buf.get_data_at(1));
+        final_function->deserialize_and_merge(final_place, tmp.get(), reader, nullptr);
+        VectorBufferReader again_reader(buf.get_data_at(1));
+        final_function->deserialize_and_merge(final_place, tmp.get(), again_reader, nullptr);
+        EXPECT_EQ(result_of(functions[f], places[f][0]),
+                  result_of(final_function, final_place));
+
+        functions[f]->destroy(place);
+        final_function->destroy(final_place);
+        for (int g = 0; g < 2; g++) {
+            functions[f]->destroy(places[f][g]);
+            shared_functions[f]->destroy(shared_places[f][g]);
+        }
+    }
+}
 } // namespace doris::vectorized
@@ -415,4 +415,58 @@ TEST_F(VWindowFunnelTest, testMax4ReverseSortedMerge) {
     }
 }
 
+TEST_F(VWindowFunnelTest, testSameTimestamp) {
+    // all the conditions match at one timestamp, in reverse order of the levels and
+    // on different rows
+    const int NUM_CONDS = 4;
+    auto column_mode = ColumnString::create();
+    auto column_timestamp = ColumnVector<Int64>::create();
+    auto column_window = ColumnVector<Int64>::create();
+    for (int i = 0; i < NUM_CONDS; i++) {
+        column_mode->insert("mode");
+        VecDateTimeValue time_value;
+        time_value.set_time(2022, 2, 28, 0, 0, 0);
+        column_timestamp->insert_data((char*)&time_value, 0);
+        column_window->insert(0);
+    }
+    MutableColumns column_events(NUM_CONDS);
+    for (int level = 0; level < NUM_CONDS; level++) {
+        column_events[level] = ColumnVector<UInt8>::create();
+        for (int i = 0; i < NUM_CONDS; i++) {
+            column_events[level]->insert(level == NUM_CONDS - 1 - i ? 1 : 0);
+        }
+    }
+
+    std::unique_ptr<char[]> memory(new char[agg_function->size_of_data()]);
+    AggregateDataPtr place = memory.get();
+    agg_function->create(place);
+    const IColumn* column[7] = {column_window.get(),    column_mode.get(),
+                                column_timestamp.get(), column_events[0].get(),
+                                column_events[1].get(), column_events[2].get(),
+                                column_events[3].get()};
+    for (int i = 0; i < NUM_CONDS; i++) {
+        agg_function->add(place, column, i, nullptr);
+    }
+
+    ColumnString buf;
+    VectorBufferWriter buf_writer(buf);
+    agg_function->serialize(place, buf_writer);
+    buf_writer.commit();
+
+    std::unique_ptr<char[]> memory2(new char[agg_function->size_of_data()]);
+    AggregateDataPtr place2 = memory2.get();
+    agg_function->create(place2);
+    VectorBufferReader buf_reader(buf.get_data_at(0));
+    agg_function->deserialize(place2, buf_reader, nullptr);
+    agg_function->merge(place2, place, nullptr);
+
+    ColumnVector<Int32> column_result;
+    agg_function->insert_result_into(place, column_result);
+    agg_function->insert_result_into(place2, column_result);
+    EXPECT_EQ(column_result.get_data()[0], NUM_CONDS);
+    EXPECT_EQ(column_result.get_data()[1], NUM_CONDS);
+    agg_function->destroy(place);
+    agg_function->destroy(place2);
+}
+
 } // namespace doris::vectorized
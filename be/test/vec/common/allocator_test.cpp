@@ -0,0 +1,58 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/allocator.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "util/doris_metrics.h"
+#include "vec/common/hash_table/hash_table_allocator.h"
+
+namespace doris::vectorized {
+
+TEST(AllocatorTest, HugePages) {
+    config::enable_huge_pages_for_hash_table = true;
+    auto metric = DorisMetrics::instance()->huge_page_allocated_bytes;
+    int64_t allocated_bytes = metric->value();
+
+    HashTableAllocator allocator;
+    size_t size = 3 * HUGE_PAGE_SIZE + 100;
+    auto buf = reinterpret_cast<char*>(allocator.alloc(size));
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(buf) % HUGE_PAGE_SIZE);
+    EXPECT_EQ(allocated_bytes + size, metric->value());
+    // cleared
+    EXPECT_EQ(0, buf[0]);
+    EXPECT_EQ(0, buf[size - 1]);
+    buf[size - 1] = 1;
+
+    buf = reinterpret_cast<char*>(allocator.realloc(buf, size, 2 * size));
+    EXPECT_EQ(1, buf[size - 1]);
+    EXPECT_EQ(0, buf[2 * size - 1]);
+    EXPECT_EQ(allocated_bytes + 2 * size, metric->value());
+
+    allocator.free(buf, 2 * size);
+    EXPECT_EQ(allocated_bytes, metric->value());
+
+    // the allocators not opting in do not use huge pages
+    Allocator<false> default_allocator;
+    void* ptr = default_allocator.alloc(size);
+    EXPECT_EQ(allocated_bytes, metric->value());
+    default_allocator.free(ptr, size);
+}
+
+} // namespace doris::vectorized
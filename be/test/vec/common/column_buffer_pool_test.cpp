@@ -0,0 +1,80 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/column_buffer_pool.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/thread_context.h"
+#include "vec/common/pod_array.h"
+
+namespace doris::vectorized {
+
+TEST(ColumnBufferPoolTest, GetAndPut) {
+    ColumnBufferPool pool(16 * 1024);
+    EXPECT_EQ(nullptr, pool.get(4096));
+
+    void* buf = malloc(4096);
+    EXPECT_TRUE(pool.put(buf, 4096));
+    EXPECT_EQ(4096, pool.cached_bytes());
+    // only the power-of-two sizes in range are pooled
+    EXPECT_EQ(nullptr, pool.get(8192));
+    EXPECT_EQ(nullptr, pool.get(4095));
+    EXPECT_EQ(buf, pool.get(4096));
+    EXPECT_EQ(0, pool.cached_bytes());
+    EXPECT_EQ(1, pool.hit_count());
+
+    void* small = malloc(1024);
+    EXPECT_FALSE(pool.put(small, 1024));
+    free(small);
+    void* odd = malloc(6000);
+    EXPECT_FALSE(pool.put(odd, 6000));
+    free(odd);
+
+    // the capacity is respected
+    void* large = malloc(16 * 1024);
+    EXPECT_TRUE(pool.put(buf, 4096));
+    EXPECT_FALSE(pool.put(large, 16 * 1024));
+    free(large);
+}
+
+TEST(ColumnBufferPoolTest, ReusedByPODArray) {
+    // the buffers are mmap-ed in the debug build
+    if (MMAP_THRESHOLD <= ColumnBufferPool::MIN_BUFFER_SIZE) {
+        return;
+    }
+    ColumnBufferPool pool(1024 * 1024);
+    tls_ctx()->_column_buffer_pool = &pool;
+    const void* data = nullptr;
+    {
+        PaddedPODArray<int64_t> array;
+        array.resize(10000);
+        data = array.data();
+    }
+    int64_t cached_bytes = pool.cached_bytes();
+    EXPECT_GT(cached_bytes, 0);
+    {
+        PaddedPODArray<int64_t> array;
+        array.resize(10000);
+        EXPECT_EQ(data, array.data());
+        EXPECT_EQ(1, pool.hit_count());
+        EXPECT_EQ(0, pool.cached_bytes());
+    }
+    tls_ctx()->_column_buffer_pool = nullptr;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/loser_tree.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+namespace doris::vectorized {
+
+namespace {
+struct Run {
+    std::vector<int> values;
+    size_t pos = 0;
+};
+
+struct RunGreater {
+    bool operator()(const Run* lhs, const Run* rhs) const {
+        return lhs->values[lhs->pos] > rhs->values[rhs->pos];
+    }
+};
+} // namespace
+
+TEST(LoserTreeTest, merge_runs) {
+    std::mt19937 rng(42);
+    for (size_t k : {1, 2, 3, 7, 64}) {
+        std::vector<Run> runs(k);
+        std::vector<int> expected;
+        for (auto& run : runs) {
+            size_t rows = 1 + rng() % 50;
+            for (size_t i = 0; i < rows; ++i) {
+                run.values.push_back(rng() % 100);
+            }
+            std::sort(run.values.begin(), run.values.end());
+            expected.insert(expected.end(), run.values.begin(), run.values.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        LoserTree<Run*, RunGreater> tree;
+        std::vector<Run*> items;
+        for (auto& run : runs) {
+            items.push_back(&run);
+        }
+        tree.init(items);
+
+        std::vector<int> merged;
+        while (!tree.empty()) {
+            Run* top = tree.top();
+            Run** second = tree.second();
+            if (second != nullptr) {
+                EXPECT_LE(top->values[top->pos], (*second)->values[(*second)->pos]);
+            }
+            merged.push_back(top->values[top->pos]);
+            if (++top->pos < top->values.size()) {
+                tree.update_top();
+            } else {
+                tree.pop_top();
+            }
+        }
+        EXPECT_EQ(expected, merged);
+    }
+}
+
+TEST(LoserTreeTest, second_of_top) {
+    std::vector<Run> runs = {{{5}}, {{1}}, {{3}}, {{4}}, {{2}}};
+    std::vector<Run*> items;
+    for (auto& run : runs) {
+        items.push_back(&run);
+    }
+    LoserTree<Run*, RunGreater> tree;
+    tree.init(items);
+    EXPECT_EQ(5, tree.size());
+    EXPECT_EQ(1, tree.top_index());
+    ASSERT_NE(nullptr, tree.second());
+    EXPECT_EQ(2, (*tree.second())->values[0]);
+
+    tree.pop_top();
+    EXPECT_EQ(4, tree.top_index());
+    EXPECT_EQ(3, (*tree.second())->values[0]);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,124 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/two_level_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "vec/common/hash_table/hash.h"
+
+namespace doris::vectorized {
+
+using SingleLevelMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using TwoLevelMap = TwoLevelHashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+
+TEST(TwoLevelHashTableTest, emplace_and_find) {
+    TwoLevelMap map;
+    for (UInt64 i = 0; i < 10000; ++i) {
+        TwoLevelMap::LookupResult it;
+        bool inserted = false;
+        map.emplace(i, it, inserted);
+        EXPECT_TRUE(inserted);
+        *lookup_result_get_mapped(it) = i * 2;
+    }
+    EXPECT_EQ(10000, map.size());
+
+    for (UInt64 i = 0; i < 10000; ++i) {
+        TwoLevelMap::LookupResult it;
+        bool inserted = true;
+        map.emplace(i, it, inserted);
+        EXPECT_FALSE(inserted);
+        EXPECT_EQ(i * 2, *lookup_result_get_mapped(it));
+    }
+    EXPECT_EQ(nullptr, map.find(20000));
+
+    UInt64 sum = 0;
+    size_t count = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        sum += it->get_second();
+        ++count;
+    }
+    EXPECT_EQ(10000, count);
+    EXPECT_EQ(9999 * 10000, sum);
+}
+
+TEST(TwoLevelHashTableTest, convert_from_single_level) {
+    SingleLevelMap single_level;
+    // zero key is stored out of the buffer of the single level table
+    for (UInt64 i = 0; i < 5000; ++i) {
+        single_level[i] = i + 1;
+    }
+
+    TwoLevelMap two_level(single_level);
+    EXPECT_EQ(single_level.size(), two_level.size());
+    for (UInt64 i = 0; i < 5000; ++i) {
+        auto it = two_level.find(i);
+        ASSERT_NE(nullptr, it);
+        EXPECT_EQ(i + 1, *lookup_result_get_mapped(it));
+    }
+
+    size_t count = 0;
+    two_level.for_each_mapped([&](auto& mapped) {
+        EXPECT_GT(mapped, 0);
+        ++count;
+    });
+    EXPECT_EQ(5000, count);
+
+    TwoLevelMap moved(std::move(two_level));
+    EXPECT_EQ(5000, moved.size());
+    EXPECT_TRUE(two_level.empty());
+}
+
+TEST(TwoLevelHashTableTest, build_buckets_in_parallel) {
+    constexpr int parallelism = 4;
+    constexpr UInt64 rows = 100000;
+    TwoLevelMap map;
+    map.expanse_for_add_elem(rows);
+
+    // every thread only inserts the keys of its own buckets
+    std::vector<std::thread> threads;
+    for (int i = 0; i < parallelism; ++i) {
+        threads.emplace_back([&map, i]() {
+            for (UInt64 key = 0; key < rows; ++key) {
+                size_t hash_value = map.hash(key);
+                size_t bucket = TwoLevelMap::get_bucket_from_hash(hash_value);
+                if (bucket % parallelism != i) {
+                    continue;
+                }
+                TwoLevelMap::LookupResult it;
+                bool inserted = false;
+                map.impls[bucket].emplace(key, it, inserted, hash_value);
+                *lookup_result_get_mapped(it) = key;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(rows, map.size());
+    for (UInt64 key = 0; key < rows; ++key) {
+        auto it = map.find(key);
+        ASSERT_NE(nullptr, it);
+        EXPECT_EQ(key, *lookup_result_get_mapped(it));
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,184 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "util/file_utils.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/core/block_spill_manager.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class BlockSpillTest : public testing::Test {
+public:
+    void SetUp() override {
+        if (FileUtils::check_exist(_dir)) {
+            EXPECT_TRUE(FileUtils::remove_all(_dir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(_dir).ok());
+    }
+    void TearDown() override { EXPECT_TRUE(FileUtils::remove_all(_dir).ok()); }
+
+protected:
+    static Block _create_block(int start, int rows) {
+        auto column_int = ColumnVector<Int32>::create();
+        auto column_string = ColumnString::create();
+        for (int i = start; i < start + rows; ++i) {
+            column_int->insert_value(i);
+            auto str = std::to_string(i);
+            column_string->insert_data(str.data(), str.size());
+        }
+        ColumnWithTypeAndName int_column(std::move(column_int), std::make_shared<DataTypeInt32>(),
+                                         "k1");
+        ColumnWithTypeAndName string_column(std::move(column_string),
+                                            std::make_shared<DataTypeString>(), "v1");
+        return Block({int_column, string_column});
+    }
+
+    std::string _dir = "./ut_dir/block_spill_test";
+};
+
+TEST_F(BlockSpillTest, write_and_read) {
+    std::string path = _dir + "/write_and_read.spill";
+    BlockSpillWriter writer(path);
+    EXPECT_TRUE(writer.open().ok());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(writer.write(_create_block(i * 100, 100)).ok());
+    }
+    // empty block is ignored
+    EXPECT_TRUE(writer.write(_create_block(0, 0)).ok());
+    EXPECT_TRUE(writer.close().ok());
+    EXPECT_EQ(10, writer.written_blocks());
+    EXPECT_EQ(1000, writer.written_rows());
+
+    BlockSpillReader reader(path);
+    EXPECT_TRUE(reader.open().ok());
+    int next = 0;
+    bool eos = false;
+    while (true) {
+        Block block;
+        EXPECT_TRUE(reader.read(&block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        EXPECT_EQ(2, block.columns());
+        EXPECT_EQ(100, block.rows());
+        const auto& ints = block.get_by_position(0).column;
+        const auto& strs = block.get_by_position(1).column;
+        for (int i = 0; i < block.rows(); ++i, ++next) {
+            EXPECT_EQ(next, ints->get_int(i));
+            EXPECT_EQ(std::to_string(next), strs->get_data_at(i).to_string());
+        }
+    }
+    EXPECT_EQ(1000, next);
+    EXPECT_TRUE(reader.close().ok());
+    EXPECT_FALSE(FileUtils::check_exist(path));
+}
+
+TEST_F(BlockSpillTest, keep_file_after_read) {
+    std::string path = _dir + "/keep_file_after_read.spill";
+    BlockSpillWriter writer(path);
+    EXPECT_TRUE(writer.open().ok());
+    EXPECT_TRUE(writer.write(_create_block(0, 10)).ok());
+    EXPECT_TRUE(writer.close().ok());
+
+    BlockSpillReader reader(path, false);
+    EXPECT_TRUE(reader.open().ok());
+    Block block;
+    bool eos = false;
+    EXPECT_TRUE(reader.read(&block, &eos).ok());
+    EXPECT_FALSE(eos);
+    EXPECT_EQ(10, block.rows());
+    EXPECT_TRUE(reader.read(&block, &eos).ok());
+    EXPECT_TRUE(eos);
+    EXPECT_TRUE(reader.close().ok());
+    EXPECT_TRUE(FileUtils::check_exist(path));
+}
+
+TEST_F(BlockSpillTest, async_write) {
+    BlockSpillManager manager(nullptr);
+    EXPECT_TRUE(manager.init().ok());
+    EXPECT_NE(nullptr, manager.io_thread_pool());
+
+    TUniqueId query_id;
+    query_id.__set_hi(1);
+    query_id.__set_lo(2);
+    std::string path = _dir + "/async_write.spill";
+    BlockSpillWriter writer(path, &manager, query_id);
+    EXPECT_TRUE(writer.open().ok());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(writer.write(_create_block(i * 100, 100)).ok());
+    }
+    EXPECT_TRUE(writer.close().ok());
+    EXPECT_EQ(writer.written_bytes(), manager.spilled_bytes(query_id));
+
+    BlockSpillReader reader(path, false);
+    EXPECT_TRUE(reader.open().ok());
+    int next = 0;
+    bool eos = false;
+    while (true) {
+        Block block;
+        EXPECT_TRUE(reader.read(&block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        const auto& ints = block.get_by_position(0).column;
+        for (int i = 0; i < block.rows(); ++i, ++next) {
+            EXPECT_EQ(next, ints->get_int(i));
+        }
+    }
+    EXPECT_EQ(10000, next);
+    EXPECT_TRUE(reader.close().ok());
+
+    EXPECT_TRUE(manager.remove_spill_file(path).ok());
+    EXPECT_EQ(0, manager.spilled_bytes(query_id));
+    EXPECT_FALSE(FileUtils::check_exist(path));
+}
+
+TEST_F(BlockSpillTest, query_spill_limit) {
+    int64_t old_limit = config::spill_max_bytes_per_query;
+    BlockSpillManager manager(nullptr);
+    EXPECT_TRUE(manager.init().ok());
+
+    TUniqueId query_id;
+    query_id.__set_hi(1);
+    query_id.__set_lo(2);
+    std::string path = _dir + "/query_spill_limit.spill";
+    BlockSpillWriter writer(path, &manager, query_id);
+    EXPECT_TRUE(writer.open().ok());
+    EXPECT_TRUE(writer.write(_create_block(0, 100)).ok());
+    config::spill_max_bytes_per_query = writer.written_bytes() + 1;
+    EXPECT_FALSE(writer.write(_create_block(0, 100)).ok());
+    EXPECT_TRUE(writer.close().ok());
+    config::spill_max_bytes_per_query = old_limit;
+
+    // the space is released with the file
+    EXPECT_TRUE(manager.remove_spill_file(path).ok());
+    EXPECT_EQ(0, manager.spilled_bytes(query_id));
+}
+
+} // namespace doris::vectorized
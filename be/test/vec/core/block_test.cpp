@@ -28,6 +28,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/string_value.h"
 #include "runtime/tuple_row.h"
+#include "util/block_compression.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
@@ -332,6 +333,75 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
     }
 }
 
+TEST(BlockTest, SerializeWithCompressionCodec) {
+    auto strcol = vectorized::ColumnString::create();
+    for (int i = 0; i < 1024; ++i) {
+        std::string is = std::to_string(i % 16);
+        strcol->insert_data(is.c_str(), is.size());
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeString>());
+    vectorized::ColumnWithTypeAndName type_and_name(strcol->get_ptr(), data_type, "test_string");
+    vectorized::Block block({type_and_name});
+
+    for (auto type : {segment_v2::CompressionTypePB::NO_COMPRESSION,
+                      segment_v2::CompressionTypePB::SNAPPY, segment_v2::CompressionTypePB::LZ4,
+                      segment_v2::CompressionTypePB::ZSTD}) {
+        std::unique_ptr<BlockCompressionCodec> codec;
+        EXPECT_TRUE(get_block_compression_codec(type, 1, codec).ok());
+        PBlock pblock;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        EXPECT_TRUE(block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes, type,
+                                    codec.get())
+                            .ok());
+        EXPECT_EQ(compressed_bytes, pblock.column_values().size());
+        EXPECT_EQ(codec != nullptr, pblock.compressed());
+        EXPECT_LE(compressed_bytes, uncompressed_bytes);
+
+        vectorized::Block block2(pblock);
+        EXPECT_EQ(block.dump_data(), block2.dump_data());
+    }
+}
+
+TEST(BlockTest, FilterBlock) {
+    auto int_column = vectorized::ColumnInt32::create();
+    auto str_column = vectorized::ColumnString::create();
+    auto null_map = vectorized::ColumnUInt8::create();
+    auto filter_column = vectorized::ColumnUInt8::create();
+    for (int i = 0; i < 100; ++i) {
+        int_column->insert_value(i);
+        std::string str = std::to_string(i);
+        str_column->insert_data(str.c_str(), str.size());
+        null_map->insert_value(i % 3 == 0);
+        filter_column->insert_value(i % 2 == 0);
+    }
+    vectorized::ColumnPtr shared_column = int_column->clone_resized(100);
+    auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+    auto str_type = vectorized::make_nullable(std::make_shared<vectorized::DataTypeString>());
+    vectorized::Block block({{std::move(int_column), int_type, "k1"},
+                             {vectorized::ColumnNullable::create(std::move(str_column),
+                                                                 std::move(null_map)),
+                              str_type, "k2"},
+                             {shared_column, int_type, "k3"},
+                             {shared_column, int_type, "k4"},
+                             {std::move(filter_column), int_type, "filter"}});
+    shared_column.reset();
+
+    EXPECT_TRUE(vectorized::Block::filter_block(&block, 4, 4).ok());
+    EXPECT_EQ(4, block.columns());
+    EXPECT_EQ(50, block.rows());
+    // the shared column is filtered once
+    EXPECT_EQ(block.get_by_position(2).column.get(), block.get_by_position(3).column.get());
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(i * 2, block.get_by_position(0).column->get_int(i));
+        EXPECT_EQ(i * 2, block.get_by_position(3).column->get_int(i));
+        const auto& nullable =
+                assert_cast<const vectorized::ColumnNullable&>(*block.get_by_position(1).column);
+        EXPECT_EQ(i * 2 % 3 == 0, nullable.is_null_at(i));
+        EXPECT_EQ(std::to_string(i * 2), nullable.get_nested_column().get_data_at(i).to_string());
+    }
+}
+
 TEST(BlockTest, dump_data) {
     auto vec = vectorized::ColumnVector<Int32>::create();
     auto& int32_data = vec->get_data();
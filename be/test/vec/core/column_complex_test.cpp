@@ -22,6 +22,7 @@
 #include <memory>
 #include <string>
 
+#include "vec/common/assert_cast.h"
 #include "vec/data_types/data_type_bitmap.h"
 namespace doris::vectorized {
 TEST(ColumnComplexTest, BasicTest) {
@@ -40,6 +41,25 @@ TEST(ColumnComplexTest, BasicTest) {
     EXPECT_EQ((*reinterpret_cast<const std::string*>(ref.data)), val1);
 }
 
+TEST(ColumnComplexTest, ScatterTest) {
+    auto column = ColumnBitmap::create();
+    for (uint64_t i = 0; i < 10; ++i) {
+        column->insert_value(BitmapValue(i));
+    }
+    IColumn::Selector selector;
+    for (size_t i = 0; i < 10; ++i) {
+        selector.push_back(i % 3);
+    }
+    auto columns = column->scatter(3, selector);
+    EXPECT_EQ(columns.size(), 3);
+    EXPECT_EQ(columns[0]->size(), 4);
+    EXPECT_EQ(columns[1]->size(), 3);
+    EXPECT_EQ(columns[2]->size(), 3);
+    auto& bitmaps = assert_cast<const ColumnBitmap&>(*columns[1]);
+    EXPECT_TRUE(bitmaps.get_element(0).contains(uint64_t(1)));
+    EXPECT_TRUE(bitmaps.get_element(2).contains(uint64_t(7)));
+}
+
 // Test the compile failed
 TEST(ColumnComplexType, DataTypeBitmapTest) {
     std::make_shared<DataTypeBitMap>();
@@ -0,0 +1,56 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_dictionary.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_string.h"
+
+namespace doris::vectorized {
+
+TEST(ColumnDictionaryTest, OwnedColumnTest) {
+    std::string page_dict = "applebananagrape";
+    std::vector<StringRef> dict = {StringRef(page_dict.data(), 5),
+                                   StringRef(page_dict.data() + 5, 6),
+                                   StringRef(page_dict.data() + 11, 5)};
+    std::vector<int32_t> codes = {2, 0, 2, 1, 0};
+    auto column = ColumnDictI32::create();
+    column->reserve(codes.size());
+    column->insert_many_dict_data(codes.data(), 0, dict.data(), codes.size(), dict.size());
+
+    uint16_t sel[] = {0, 2, 4};
+    auto owned = column->create_owned_column(sel, 3);
+    // the dictionary of the page is freed
+    page_dict.assign(page_dict.size(), 'x');
+
+    auto& owned_dict_col = assert_cast<const ColumnDictI32&>(*owned);
+    EXPECT_EQ(3, owned_dict_col.size());
+    EXPECT_EQ(2, owned_dict_col.dict_size());
+    EXPECT_EQ(owned_dict_col.get_data()[0], owned_dict_col.get_data()[1]);
+
+    auto strings = owned->convert_to_string_column_if_dictionary();
+    ASSERT_EQ(3, strings->size());
+    EXPECT_EQ("grape", strings->get_data_at(0).to_string());
+    EXPECT_EQ("grape", strings->get_data_at(1).to_string());
+    EXPECT_EQ("apple", strings->get_data_at(2).to_string());
+}
+
+} // namespace doris::vectorized
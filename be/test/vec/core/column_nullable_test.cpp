@@ -22,7 +22,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "runtime/raw_value.h"
+#include "runtime/types.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/sip_hash.h"
 
@@ -50,4 +55,71 @@ TEST(ColumnNullableTest, HashTest) {
     EXPECT_NE(hashes[0].get64(), hashes[1].get64());
 }
 
+TEST(ColumnNullableTest, HashesTest) {
+    auto column = ColumnVector<int>::create();
+    auto strings = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 10; ++i) {
+        column->insert_value(i);
+        std::string str = std::to_string(i);
+        strings->insert_data(str.data(), str.size());
+        null_map->insert_value(i % 3 == 0);
+    }
+    ColumnPtr nullable_column = ColumnNullable::create(std::move(column), null_map->clone());
+    ColumnPtr nullable_strings = ColumnNullable::create(std::move(strings), std::move(null_map));
+
+    std::vector<SipHash> hashes(10);
+    nullable_column->update_hashes_with_value(hashes);
+    nullable_strings->update_hashes_with_value(hashes);
+    for (size_t i = 0; i < 10; ++i) {
+        SipHash hash;
+        nullable_column->update_hash_with_value(i, hash);
+        nullable_strings->update_hash_with_value(i, hash);
+        EXPECT_EQ(hash.get64(), hashes[i].get64());
+    }
+}
+
+TEST(ColumnNullableTest, CrcsTest) {
+    auto column = ColumnVector<Int64>::create();
+    auto strings = ColumnString::create();
+    auto decimals = ColumnDecimal<Decimal128>::create(0, 9);
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 10; ++i) {
+        column->insert_value(i);
+        std::string str = std::to_string(i);
+        strings->insert_data(str.data(), str.size());
+        decimals->get_data().push_back(Decimal128(DecimalV2Value(i, i * 1000).value()));
+        null_map->insert_value(i % 3 == 0);
+    }
+    ColumnPtr nullable_column = ColumnNullable::create(std::move(column), null_map->clone());
+    ColumnPtr nullable_strings = ColumnNullable::create(std::move(strings), null_map->clone());
+    ColumnPtr nullable_decimals = ColumnNullable::create(std::move(decimals), std::move(null_map));
+
+    TypeDescriptor bigint_type(TYPE_BIGINT);
+    TypeDescriptor varchar_type(TYPE_VARCHAR);
+    TypeDescriptor decimal_type(TYPE_DECIMALV2);
+    std::vector<uint32_t> hashes(10, 0);
+    nullable_column->update_crcs_with_value(hashes, bigint_type);
+    nullable_strings->update_crcs_with_value(hashes, varchar_type);
+    nullable_decimals->update_crcs_with_value(hashes, decimal_type);
+
+    // the same as the row by row hash of the bucket shuffle
+    static const int INT_VALUE = 0;
+    static const TypeDescriptor INT_TYPE(TYPE_INT);
+    for (size_t i = 0; i < 10; ++i) {
+        uint32_t hash = 0;
+        for (auto& [col, type] : {std::make_pair(nullable_column, bigint_type),
+                                  std::make_pair(nullable_strings, varchar_type),
+                                  std::make_pair(nullable_decimals, decimal_type)}) {
+            auto val = col->get_data_at(i);
+            if (val.data == nullptr) {
+                hash = RawValue::zlib_crc32(&INT_VALUE, INT_TYPE, hash);
+            } else {
+                hash = RawValue::zlib_crc32(val.data, val.size, type, hash);
+            }
+        }
+        EXPECT_EQ(hash, hashes[i]);
+    }
+}
+
 } // namespace doris::vectorized
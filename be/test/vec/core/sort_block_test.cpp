@@ -0,0 +1,191 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_block.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/normalized_key.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+static Block create_block(size_t rows) {
+    std::mt19937 rng(1234);
+    auto a = ColumnInt32::create();
+    auto a_null_map = ColumnUInt8::create();
+    auto b = ColumnInt16::create();
+    auto row_id = ColumnInt64::create();
+    for (size_t i = 0; i < rows; ++i) {
+        a->insert_value(static_cast<Int32>(rng() % 100) - 50);
+        a_null_map->insert_value(rng() % 10 == 0);
+        b->insert_value(static_cast<Int16>(rng() % 1000) - 500);
+        row_id->insert_value(i);
+    }
+
+    Block block;
+    block.insert({ColumnNullable::create(std::move(a), std::move(a_null_map)),
+                  make_nullable(std::make_shared<DataTypeInt32>()), "a"});
+    block.insert({std::move(b), std::make_shared<DataTypeInt16>(), "b"});
+    block.insert({std::move(row_id), std::make_shared<DataTypeInt64>(), "row_id"});
+    return block;
+}
+
+// the strings share long prefixes, so the normalized keys often tie
+static Block create_string_block(size_t rows, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto s = ColumnString::create();
+    auto s_null_map = ColumnUInt8::create();
+    auto a = ColumnInt64::create();
+    auto row_id = ColumnInt64::create();
+    for (size_t i = 0; i < rows; ++i) {
+        std::string value(rng() % 20, 'x');
+        for (auto& c : value) {
+            c = "ab\xff"[rng() % 3];
+        }
+        s->insert_data(value.data(), value.size());
+        s_null_map->insert_value(rng() % 10 == 0);
+        a->insert_value(static_cast<Int64>(rng() % 10) - 5);
+        row_id->insert_value(i);
+    }
+
+    Block block;
+    block.insert({std::move(a), std::make_shared<DataTypeInt64>(), "a"});
+    block.insert({ColumnNullable::create(std::move(s), std::move(s_null_map)),
+                  make_nullable(std::make_shared<DataTypeString>()), "s"});
+    block.insert({std::move(row_id), std::make_shared<DataTypeInt64>(), "row_id"});
+    return block;
+}
+
+static void check_sorted(const Block& block, const SortDescription& description) {
+    for (size_t row = 0; row + 1 < block.rows(); ++row) {
+        int res = 0;
+        for (const auto& desc : description) {
+            const auto& column = block.get_by_position(desc.column_number).column;
+            res = desc.direction * column->compare_at(row, row + 1, *column, desc.nulls_direction);
+            if (res != 0) {
+                break;
+            }
+        }
+        ASSERT_LE(res, 0) << "row " << row;
+    }
+}
+
+TEST(SortBlockTest, sort_by_packed_keys) {
+    constexpr size_t rows = 1000;
+    // a asc nulls first, b desc nulls last
+    SortDescription description;
+    description.emplace_back(0, 1, -1);
+    description.emplace_back(1, -1, -1);
+
+    Block block = create_block(rows);
+    sort_block(block, description);
+    EXPECT_EQ(rows, block.rows());
+    check_sorted(block, description);
+
+    const auto& row_id = assert_cast<const ColumnInt64&>(*block.get_by_position(2).column);
+    std::vector<bool> seen(rows, false);
+    for (size_t i = 0; i < rows; ++i) {
+        ASSERT_FALSE(seen[row_id.get_element(i)]);
+        seen[row_id.get_element(i)] = true;
+    }
+}
+
+TEST(SortBlockTest, sort_by_packed_keys_with_limit) {
+    constexpr size_t rows = 1000;
+    constexpr size_t limit = 100;
+    // a desc nulls last, b asc nulls first
+    SortDescription description;
+    description.emplace_back(0, -1, 1);
+    description.emplace_back(1, 1, -1);
+
+    Block full_block = create_block(rows);
+    sort_block(full_block, description);
+
+    Block block = create_block(rows);
+    sort_block(block, description, limit);
+    EXPECT_EQ(limit, block.rows());
+    check_sorted(block, description);
+
+    for (size_t row = 0; row < limit; ++row) {
+        for (size_t i = 0; i < 2; ++i) {
+            const auto& column = block.get_by_position(i).column;
+            EXPECT_EQ(0, column->compare_at(row, row, *full_block.get_by_position(i).column, 1));
+        }
+    }
+}
+
+TEST(SortBlockTest, sort_by_normalized_keys) {
+    constexpr size_t rows = 1000;
+    for (int direction : {1, -1}) {
+        for (int nulls_direction : {1, -1}) {
+            SortDescription description;
+            description.emplace_back(0, -direction, nulls_direction);
+            description.emplace_back(1, direction, nulls_direction);
+
+            Block block = create_string_block(rows, 1234);
+            sort_block(block, description);
+            EXPECT_EQ(rows, block.rows());
+            check_sorted(block, description);
+        }
+    }
+}
+
+TEST(SortBlockTest, compare_normalized_keys) {
+    constexpr size_t rows = 200;
+    SortDescription description;
+    description.emplace_back(0, 1, -1);
+    description.emplace_back(1, -1, 1);
+
+    Block lhs = create_string_block(rows, 1);
+    Block rhs = create_string_block(rows, 2);
+    ColumnRawPtrs lhs_columns {lhs.get_by_position(0).column.get(),
+                               lhs.get_by_position(1).column.get()};
+    ColumnRawPtrs rhs_columns {rhs.get_by_position(0).column.get(),
+                               rhs.get_by_position(1).column.get()};
+    NormalizedKeys lhs_keys;
+    NormalizedKeys rhs_keys;
+    ASSERT_TRUE(lhs_keys.build(lhs_columns, description));
+    ASSERT_TRUE(rhs_keys.build(rhs_columns, description));
+    ASSERT_TRUE(lhs_keys.compatible_with(rhs_keys));
+    EXPECT_FALSE(lhs_keys.complete());
+
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < rows; ++j) {
+            int res = 0;
+            for (size_t c = 0; c < description.size() && res == 0; ++c) {
+                res = description[c].direction *
+                      lhs_columns[c]->compare_at(i, j, *rhs_columns[c],
+                                                 description[c].nulls_direction);
+            }
+            int key_res = lhs_keys.compare(i, rhs_keys, j);
+            // the keys never contradict the columns
+            if (key_res != 0) {
+                ASSERT_EQ(key_res < 0, res < 0) << i << ", " << j;
+            }
+        }
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,365 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vcross_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+using Keys = std::vector<std::optional<int32_t>>;
+using RangeOp = VCrossJoinNode::RangeOp;
+
+// Returns the prepared blocks one by one, the last one comes with eos.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        if (_index < _blocks.size()) {
+            block->swap(_blocks[_index++]);
+        }
+        *eos = _index == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _index = 0;
+};
+
+ColumnPtr create_key_column(const Keys& keys, size_t begin, size_t end) {
+    auto key_column = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    for (size_t i = begin; i < end; ++i) {
+        key_column->insert_value(keys[i].value_or(0));
+        null_map->insert_value(!keys[i].has_value());
+    }
+    return ColumnNullable::create(std::move(key_column), std::move(null_map));
+}
+
+// Key is a nullable int and value is an int, the value of the i-th row is first_value + i.
+Block create_block(const Keys& keys, size_t begin, size_t end, int32_t first_value) {
+    auto value_column = ColumnInt32::create();
+    for (size_t i = begin; i < end; ++i) {
+        value_column->insert_value(first_value + i);
+    }
+    auto int_type = std::make_shared<DataTypeInt32>();
+    Block block;
+    block.insert({create_key_column(keys, begin, end), make_nullable(int_type), "k"});
+    block.insert({std::move(value_column), int_type, "v"});
+    return block;
+}
+
+TExprNode create_slot_ref(TSlotId slot_id, TTupleId tuple_id) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+    node.__set_num_children(0);
+    node.__set_is_nullable(true);
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot_id);
+    slot_ref.__set_tuple_id(tuple_id);
+    node.__set_slot_ref(slot_ref);
+    return node;
+}
+
+// `fn_name(l.k, r.k)`, or `fn_name(r.k, l.k)` if `left_first` is false.
+TExpr create_predicate(const std::string& fn_name, bool left_first) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::BINARY_PRED);
+    node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+    node.__set_num_children(2);
+    node.__isset.fn = true;
+    node.fn.name.function_name = fn_name;
+    node.fn.binary_type = TFunctionBinaryType::BUILTIN;
+    node.fn.ret_type = TypeDescriptor(TYPE_BOOLEAN).to_thrift();
+    node.fn.has_var_args = false;
+    TExpr expr;
+    expr.nodes.push_back(node);
+    expr.nodes.push_back(left_first ? create_slot_ref(0, 0) : create_slot_ref(2, 1));
+    expr.nodes.push_back(left_first ? create_slot_ref(2, 1) : create_slot_ref(0, 0));
+    return expr;
+}
+
+// Compares a and b with the comparison of fn_name, the comparison with null is never true.
+bool compare(const std::string& fn_name, const std::optional<int32_t>& a,
+             const std::optional<int32_t>& b) {
+    if (!a.has_value() || !b.has_value()) {
+        return false;
+    }
+    if (fn_name == "lt") {
+        return *a < *b;
+    } else if (fn_name == "le") {
+        return *a <= *b;
+    } else if (fn_name == "gt") {
+        return *a > *b;
+    } else if (fn_name == "ge") {
+        return *a >= *b;
+    }
+    return *a == *b;
+}
+
+std::string to_string(const std::optional<int32_t>& value) {
+    return value.has_value() ? std::to_string(*value) : "NULL";
+}
+
+std::string to_string(const IColumn& column, size_t row) {
+    Field field = column[row];
+    return field.is_null() ? "NULL" : std::to_string(field.get<Int64>());
+}
+
+// The sorted rows of the join computed by nested loops, the value of the i-th left row is i
+// and the value of the i-th build row is 100 + i.
+std::vector<std::string> nested_loop_join(const std::string& fn_name, bool left_first,
+                                          const Keys& left_keys, const Keys& build_keys) {
+    std::vector<std::string> rows;
+    for (size_t l = 0; l < left_keys.size(); ++l) {
+        for (size_t r = 0; r < build_keys.size(); ++r) {
+            if (left_first ? compare(fn_name, left_keys[l], build_keys[r])
+                           : compare(fn_name, build_keys[r], left_keys[l])) {
+                rows.push_back(to_string(left_keys[l]) + "," + std::to_string(l) + "," +
+                               to_string(build_keys[r]) + "," + std::to_string(100 + r));
+            }
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+const std::vector<std::string> kRangeFns = {"lt", "le", "gt", "ge"};
+
+// the build keys with duplicates and nulls, and the left keys matching none, some or all of
+// them
+const Keys kBuildKeys = {5, 3, std::nullopt, 8, 3, 1, std::nullopt, 10, 5};
+const Keys kLeftKeys = {0, 1, 3, 4, std::nullopt, 5, 8, 10, 11, std::nullopt, 3};
+
+} // namespace
+
+class VCrossJoinNodeTest : public testing::Test {
+public:
+    VCrossJoinNodeTest() : _runtime_state(TQueryGlobals()) {
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._query_options.enable_vectorized_engine = true;
+        // a small batch to make the range of a left row span batches
+        _runtime_state._query_options.batch_size = 4;
+
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder left_tuple;
+        left_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                    .column_name("lk").column_pos(0).build());
+        left_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                    .column_name("lv").column_pos(1).build());
+        left_tuple.build(&table_builder);
+        TTupleDescriptorBuilder build_tuple;
+        build_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                     .column_name("rk").column_pos(0).build());
+        build_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                     .column_name("rv").column_pos(1).build());
+        build_tuple.build(&table_builder);
+        EXPECT_TRUE(DescriptorTbl::create(&_obj_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+        _runtime_state.set_desc_tbl(_desc_tbl);
+    }
+
+protected:
+    // Creates and opens a cross join node on the predicate, the rows of each side are in two
+    // blocks.
+    VCrossJoinNode* open_node(const TExpr& predicate, const Keys& left_keys,
+                              const Keys& build_keys) {
+        TPlanNode left_tnode;
+        left_tnode.__set_node_id(1);
+        left_tnode.__set_limit(-1);
+        left_tnode.row_tuples = {0};
+        left_tnode.nullable_tuples = {false};
+        size_t left_half = left_keys.size() / 2;
+        std::vector<Block> left_blocks;
+        left_blocks.push_back(create_block(left_keys, 0, left_half, 0));
+        left_blocks.push_back(create_block(left_keys, left_half, left_keys.size(), 0));
+        auto left = _obj_pool.add(
+                new MockBlockNode(&_obj_pool, left_tnode, *_desc_tbl, std::move(left_blocks)));
+
+        TPlanNode build_tnode = left_tnode;
+        build_tnode.__set_node_id(2);
+        build_tnode.row_tuples = {1};
+        size_t build_half = build_keys.size() / 2;
+        std::vector<Block> build_blocks;
+        build_blocks.push_back(create_block(build_keys, 0, build_half, 100));
+        build_blocks.push_back(create_block(build_keys, build_half, build_keys.size(), 100));
+        auto build = _obj_pool.add(
+                new MockBlockNode(&_obj_pool, build_tnode, *_desc_tbl, std::move(build_blocks)));
+
+        TPlanNode tnode;
+        tnode.__set_node_id(0);
+        tnode.__set_node_type(TPlanNodeType::CROSS_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        tnode.row_tuples = {0, 1};
+        tnode.nullable_tuples = {false, false};
+        tnode.__set_vconjunct(predicate);
+
+        auto node = _obj_pool.add(new VCrossJoinNode(&_obj_pool, tnode, *_desc_tbl));
+        node->_children.push_back(left);
+        node->_children.push_back(build);
+        EXPECT_TRUE(left->init(left_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(build->init(build_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node->init(tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node->prepare(&_runtime_state).ok());
+        EXPECT_TRUE(node->open(&_runtime_state).ok());
+        return node;
+    }
+
+    // Returns the sorted output rows of the node.
+    std::vector<std::string> get_rows(VCrossJoinNode* node) {
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(&_runtime_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string str;
+                for (size_t i = 0; i < block.columns(); ++i) {
+                    str += (i == 0 ? "" : ",") + to_string(*block.get_by_position(i).column, row);
+                }
+                rows.push_back(str);
+            }
+        }
+        EXPECT_TRUE(node->close(&_runtime_state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(VCrossJoinNodeTest, find_range_predicate) {
+    // the operands are normalized to put the left slot first
+    const std::vector<std::pair<RangeOp, RangeOp>> ops = {{RangeOp::LT, RangeOp::GT},
+                                                          {RangeOp::LE, RangeOp::GE},
+                                                          {RangeOp::GT, RangeOp::LT},
+                                                          {RangeOp::GE, RangeOp::LE}};
+    for (size_t i = 0; i < kRangeFns.size(); ++i) {
+        for (bool left_first : {true, false}) {
+            SCOPED_TRACE(kRangeFns[i] + (left_first ? "(l.k, r.k)" : "(r.k, l.k)"));
+            auto node = open_node(create_predicate(kRangeFns[i], left_first), kLeftKeys,
+                                  kBuildKeys);
+            EXPECT_EQ(left_first ? ops[i].first : ops[i].second, node->_range_op);
+            EXPECT_EQ(0, node->_range_left_column);
+            EXPECT_EQ(0, node->_range_build_column);
+            const std::string* exec_option =
+                    node->runtime_profile()->get_info_string("ExecOption");
+            ASSERT_NE(nullptr, exec_option);
+            EXPECT_NE(std::string::npos,
+                      exec_option->find("Build Side Sorted For Range Predicate"));
+            // the build rows are merged and sorted, with the null rows at the end
+            ASSERT_EQ(1u, node->_build_blocks.size());
+            EXPECT_EQ(7u, node->_build_not_null_rows);
+            EXPECT_TRUE(node->close(&_runtime_state).ok());
+        }
+    }
+
+    // not a range predicate
+    auto node = open_node(create_predicate("eq", true), kLeftKeys, kBuildKeys);
+    EXPECT_EQ(RangeOp::NONE, node->_range_op);
+    const std::string* exec_option = node->runtime_profile()->get_info_string("ExecOption");
+    EXPECT_TRUE(exec_option == nullptr ||
+                exec_option->find("Build Side Sorted For Range Predicate") == std::string::npos);
+    EXPECT_EQ(nested_loop_join("eq", true, kLeftKeys, kBuildKeys), get_rows(node));
+}
+
+TEST_F(VCrossJoinNodeTest, range_join) {
+    for (const auto& fn_name : kRangeFns) {
+        for (bool left_first : {true, false}) {
+            SCOPED_TRACE(fn_name + (left_first ? "(l.k, r.k)" : "(r.k, l.k)"));
+            auto node = open_node(create_predicate(fn_name, left_first), kLeftKeys, kBuildKeys);
+            EXPECT_EQ(nested_loop_join(fn_name, left_first, kLeftKeys, kBuildKeys),
+                      get_rows(node));
+        }
+    }
+}
+
+TEST_F(VCrossJoinNodeTest, range_join_null_build_rows) {
+    const Keys build_keys = {std::nullopt, std::nullopt, std::nullopt};
+    for (const auto& fn_name : kRangeFns) {
+        SCOPED_TRACE(fn_name);
+        auto node = open_node(create_predicate(fn_name, true), kLeftKeys, build_keys);
+        EXPECT_EQ(0u, node->_build_not_null_rows);
+        EXPECT_TRUE(get_rows(node).empty());
+    }
+}
+
+// The range of a const left column, which may be null, is found by its only value.
+TEST_F(VCrossJoinNodeTest, init_build_range_const_left_column) {
+    const Keys left_keys = {0, 1, 3, 4, 5, 8, 10, 11, std::nullopt};
+    for (const auto& fn_name : kRangeFns) {
+        for (bool left_first : {true, false}) {
+            SCOPED_TRACE(fn_name + (left_first ? "(l.k, r.k)" : "(r.k, l.k)"));
+            auto node = open_node(create_predicate(fn_name, left_first), kLeftKeys, kBuildKeys);
+            const Block& build_block = node->_build_blocks[0];
+            const IColumn& build_column = *build_block.get_by_position(0).column;
+            for (size_t i = 0; i < left_keys.size(); ++i) {
+                SCOPED_TRACE("left key: " + to_string(left_keys[i]));
+                auto int_type = make_nullable(std::make_shared<DataTypeInt32>());
+                Block left_block;
+                left_block.insert({ColumnConst::create(create_key_column(left_keys, i, i + 1), 3),
+                                   int_type, "k"});
+                node->_left_block = std::move(left_block);
+                node->_left_block_pos = 2;
+                node->_init_build_range();
+
+                // the sorted build rows in the range are exactly the matching ones
+                for (size_t row = 0; row < build_block.rows(); ++row) {
+                    Field field = build_column[row];
+                    std::optional<int32_t> build_key;
+                    if (!field.is_null()) {
+                        build_key = int32_t(field.get<Int64>());
+                    }
+                    bool in_range =
+                            row >= node->_current_build_pos && row < node->_build_range_end;
+                    EXPECT_EQ(left_first ? compare(fn_name, left_keys[i], build_key)
+                                         : compare(fn_name, build_key, left_keys[i]),
+                              in_range);
+                }
+            }
+            EXPECT_TRUE(node->close(&_runtime_state).ok());
+        }
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,351 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vhash_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+using Keys = std::vector<std::optional<int32_t>>;
+
+// Returns the prepared blocks one by one, the last one comes with eos.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        if (_index < _blocks.size()) {
+            block->swap(_blocks[_index++]);
+        }
+        *eos = _index == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _index = 0;
+};
+
+// Key is an int and value is a nullable int, the value of the i-th row is first_value + i.
+Block create_block(const Keys& keys, size_t begin, size_t end, int32_t first_value,
+                   bool nullable_key) {
+    auto key_column = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    auto value_column = ColumnInt32::create();
+    for (size_t i = begin; i < end; ++i) {
+        key_column->insert_value(keys[i].value_or(0));
+        null_map->insert_value(!keys[i].has_value());
+        value_column->insert_value(first_value + i);
+    }
+    auto int_type = std::make_shared<DataTypeInt32>();
+    Block block;
+    if (nullable_key) {
+        block.insert({ColumnNullable::create(std::move(key_column), std::move(null_map)),
+                      make_nullable(int_type), "k"});
+    } else {
+        block.insert({std::move(key_column), int_type, "k"});
+    }
+    block.insert({make_nullable(std::move(value_column)), make_nullable(int_type), "v"});
+    return block;
+}
+
+TExpr create_slot_ref(TSlotId slot_id, TTupleId tuple_id, bool nullable) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+    node.__set_num_children(0);
+    node.__set_is_nullable(nullable);
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot_id);
+    slot_ref.__set_tuple_id(tuple_id);
+    node.__set_slot_ref(slot_ref);
+    TExpr expr;
+    expr.nodes.push_back(node);
+    return expr;
+}
+
+std::string to_string(const std::optional<int32_t>& value) {
+    return value.has_value() ? std::to_string(*value) : "NULL";
+}
+
+std::string to_string(const IColumn& column, size_t row) {
+    Field field = column[row];
+    return field.is_null() ? "NULL" : std::to_string(field.get<Int64>());
+}
+
+bool output_left(TJoinOp::type join_op) {
+    return join_op != TJoinOp::RIGHT_SEMI_JOIN && join_op != TJoinOp::RIGHT_ANTI_JOIN;
+}
+
+bool output_right(TJoinOp::type join_op) {
+    return join_op != TJoinOp::LEFT_SEMI_JOIN && join_op != TJoinOp::LEFT_ANTI_JOIN;
+}
+
+// The sorted rows of the join computed by nested loops, the value of the i-th left row is i
+// and the value of the i-th right row is 100 + i.
+std::vector<std::string> nested_loop_join(TJoinOp::type join_op, const Keys& left_keys,
+                                          const Keys& right_keys) {
+    std::vector<std::string> rows;
+    auto left_row = [&](size_t i) { return to_string(left_keys[i]) + "," + std::to_string(i); };
+    auto right_row = [&](size_t i) {
+        return to_string(right_keys[i]) + "," + std::to_string(100 + i);
+    };
+    std::vector<bool> right_matched(right_keys.size(), false);
+    for (size_t l = 0; l < left_keys.size(); ++l) {
+        bool matched = false;
+        for (size_t r = 0; r < right_keys.size(); ++r) {
+            if (!left_keys[l].has_value() || left_keys[l] != right_keys[r]) {
+                continue;
+            }
+            matched = true;
+            right_matched[r] = true;
+            if (output_left(join_op) && output_right(join_op)) {
+                rows.push_back(left_row(l) + "," + right_row(r));
+            }
+        }
+        if ((join_op == TJoinOp::LEFT_SEMI_JOIN && matched) ||
+            (join_op == TJoinOp::LEFT_ANTI_JOIN && !matched)) {
+            rows.push_back(left_row(l));
+        } else if (!matched && (join_op == TJoinOp::LEFT_OUTER_JOIN ||
+                                join_op == TJoinOp::FULL_OUTER_JOIN)) {
+            rows.push_back(left_row(l) + ",NULL,NULL");
+        }
+    }
+    for (size_t r = 0; r < right_keys.size(); ++r) {
+        if ((join_op == TJoinOp::RIGHT_SEMI_JOIN && right_matched[r]) ||
+            (join_op == TJoinOp::RIGHT_ANTI_JOIN && !right_matched[r])) {
+            rows.push_back(right_row(r));
+        } else if (!right_matched[r] && (join_op == TJoinOp::RIGHT_OUTER_JOIN ||
+                                         join_op == TJoinOp::FULL_OUTER_JOIN)) {
+            rows.push_back("NULL,NULL," + right_row(r));
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+const std::vector<TJoinOp::type> kJoinOps = {
+        TJoinOp::INNER_JOIN,      TJoinOp::LEFT_OUTER_JOIN, TJoinOp::RIGHT_OUTER_JOIN,
+        TJoinOp::FULL_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN,  TJoinOp::LEFT_ANTI_JOIN,
+        TJoinOp::RIGHT_SEMI_JOIN, TJoinOp::RIGHT_ANTI_JOIN};
+
+} // namespace
+
+class VHashJoinNodeTest : public testing::Test {
+public:
+    VHashJoinNodeTest() : _runtime_state(TQueryGlobals()) {
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._query_options.enable_vectorized_engine = true;
+        // a small batch to make the probe of a block span batches
+        _runtime_state._query_options.batch_size = 4;
+    }
+
+protected:
+    // Joins the left and the right rows on the keys with the hash join node, the rows of each
+    // side are in two blocks. Returns the sorted output rows, and whether the build keys are
+    // looked up in the direct map in `direct_mapped`.
+    std::vector<std::string> hash_join(TJoinOp::type join_op, const Keys& left_keys,
+                                       const Keys& right_keys, bool* direct_mapped) {
+        // the build keys of the joins outputting the unmatched build rows are mapped directly
+        // only if they are not nullable, the other joins ignore the null build keys
+        bool nullable_right_key = join_op != TJoinOp::RIGHT_OUTER_JOIN &&
+                                  join_op != TJoinOp::RIGHT_SEMI_JOIN &&
+                                  join_op != TJoinOp::RIGHT_ANTI_JOIN;
+        // all columns are nullable to be outer joined, except the right key
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder left_tuple;
+        left_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                    .column_name("lk").column_pos(0).build());
+        left_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                    .column_name("lv").column_pos(1).build());
+        left_tuple.build(&table_builder);
+        TTupleDescriptorBuilder right_tuple;
+        right_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(nullable_right_key)
+                                     .column_name("rk").column_pos(0).build());
+        right_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                     .column_name("rv").column_pos(1).build());
+        right_tuple.build(&table_builder);
+        DescriptorTbl* desc_tbl = nullptr;
+        EXPECT_TRUE(DescriptorTbl::create(&_obj_pool, table_builder.desc_tbl(), &desc_tbl).ok());
+        _runtime_state.set_desc_tbl(desc_tbl);
+
+        TPlanNode left_tnode;
+        left_tnode.__set_node_id(1);
+        left_tnode.__set_limit(-1);
+        left_tnode.row_tuples = {0};
+        left_tnode.nullable_tuples = {false};
+        size_t left_half = left_keys.size() / 2;
+        std::vector<Block> left_blocks;
+        left_blocks.push_back(create_block(left_keys, 0, left_half, 0, true));
+        left_blocks.push_back(create_block(left_keys, left_half, left_keys.size(), 0, true));
+        auto left = _obj_pool.add(
+                new MockBlockNode(&_obj_pool, left_tnode, *desc_tbl, std::move(left_blocks)));
+
+        TPlanNode right_tnode = left_tnode;
+        right_tnode.__set_node_id(2);
+        right_tnode.row_tuples = {1};
+        size_t right_half = right_keys.size() / 2;
+        std::vector<Block> right_blocks;
+        right_blocks.push_back(create_block(right_keys, 0, right_half, 100, nullable_right_key));
+        right_blocks.push_back(create_block(right_keys, right_half, right_keys.size(), 100,
+                                            nullable_right_key));
+        auto right = _obj_pool.add(
+                new MockBlockNode(&_obj_pool, right_tnode, *desc_tbl, std::move(right_blocks)));
+
+        TPlanNode tnode;
+        tnode.__set_node_id(0);
+        tnode.__set_node_type(TPlanNodeType::HASH_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        if (output_left(join_op)) {
+            tnode.row_tuples.push_back(0);
+            tnode.nullable_tuples.push_back(false);
+        }
+        if (output_right(join_op)) {
+            tnode.row_tuples.push_back(1);
+            tnode.nullable_tuples.push_back(false);
+        }
+        TEqJoinCondition condition;
+        condition.__set_left(create_slot_ref(0, 0, true));
+        condition.__set_right(create_slot_ref(2, 1, nullable_right_key));
+        tnode.hash_join_node.eq_join_conjuncts.push_back(condition);
+        tnode.hash_join_node.__set_join_op(join_op);
+        tnode.__isset.hash_join_node = true;
+
+        HashJoinNode node(&_obj_pool, tnode, *desc_tbl);
+        node._children.push_back(left);
+        node._children.push_back(right);
+        EXPECT_TRUE(left->init(left_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(right->init(right_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node.init(tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node.prepare(&_runtime_state).ok());
+        EXPECT_TRUE(node.open(&_runtime_state).ok());
+
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node.get_next(&_runtime_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string str;
+                for (size_t i = 0; i < block.columns(); ++i) {
+                    str += (i == 0 ? "" : ",") + to_string(*block.get_by_position(i).column, row);
+                }
+                rows.push_back(str);
+            }
+        }
+        const std::string* exec_option = node.runtime_profile()->get_info_string("ExecOption");
+        *direct_mapped = exec_option != nullptr &&
+                         exec_option->find("Direct Mapped Build Keys") != std::string::npos;
+        EXPECT_TRUE(node.close(&_runtime_state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // Checks all the joins against the nested loop joins, the null right keys are dropped for
+    // the joins without nullable right keys.
+    void check(const Keys& left_keys, const Keys& right_keys, bool dense) {
+        for (auto join_op : kJoinOps) {
+            SCOPED_TRACE("join op: " + std::to_string(join_op));
+            Keys keys = right_keys;
+            if (join_op == TJoinOp::RIGHT_OUTER_JOIN || join_op == TJoinOp::RIGHT_SEMI_JOIN ||
+                join_op == TJoinOp::RIGHT_ANTI_JOIN) {
+                keys.erase(std::remove(keys.begin(), keys.end(), std::nullopt), keys.end());
+            }
+            bool direct_mapped = false;
+            EXPECT_EQ(nested_loop_join(join_op, left_keys, keys),
+                      hash_join(join_op, left_keys, keys, &direct_mapped));
+            // the nullable build keys of full outer join are not hashed as integers
+            EXPECT_EQ(dense && join_op != TJoinOp::FULL_OUTER_JOIN, direct_mapped);
+        }
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _obj_pool;
+};
+
+constexpr int32_t kMin = std::numeric_limits<int32_t>::min();
+constexpr int32_t kMax = std::numeric_limits<int32_t>::max();
+
+TEST_F(VHashJoinNodeTest, dense_keys) {
+    // 100 - 119 without 105 and 110, with duplicated 101 and 118
+    Keys right_keys;
+    for (int32_t key = 100; key < 120; ++key) {
+        if (key != 105 && key != 110) {
+            right_keys.push_back(key);
+        }
+    }
+    right_keys.push_back(101);
+    right_keys.push_back(std::nullopt);
+    right_keys.push_back(118);
+    // the keys below the min and above the max, including the zero key and the keys wrapping
+    // around
+    Keys left_keys = {0,  99,   100,  101,  105,  110, 118,          119,
+                      120, 1000, -1,   kMin, kMax, std::nullopt, 100 - 4096, 119 + 4096};
+    check(left_keys, right_keys, true);
+}
+
+TEST_F(VHashJoinNodeTest, dense_keys_with_zero) {
+    Keys right_keys;
+    for (int32_t key = 0; key < 16; ++key) {
+        right_keys.push_back(key);
+    }
+    right_keys.push_back(0);
+    right_keys.push_back(std::nullopt);
+    Keys left_keys = {0, 0, 7, 15, 16, -1, kMin, kMax, std::nullopt, std::nullopt};
+    check(left_keys, right_keys, true);
+}
+
+TEST_F(VHashJoinNodeTest, dense_negative_keys) {
+    // as unsigned integers, -10 - -1 are the largest keys
+    Keys right_keys;
+    for (int32_t key = -10; key < 0; ++key) {
+        right_keys.push_back(key);
+    }
+    Keys left_keys = {-11, -10, -5, -1, 0, 1, kMin, kMax, std::nullopt};
+    check(left_keys, right_keys, true);
+}
+
+TEST_F(VHashJoinNodeTest, sparse_keys) {
+    Keys right_keys = {0, 7, 1000, 1000000, -7, std::nullopt, 7, kMax};
+    Keys left_keys = {0, 7, 8, -7, 1000, 999999, 1000000, kMin, kMax, std::nullopt};
+    check(left_keys, right_keys, false);
+}
+
+} // namespace doris::vectorized
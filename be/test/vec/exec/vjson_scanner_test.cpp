@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exec/broker_scan_node.h"
 #include "exprs/cast_functions.h"
@@ -770,5 +771,64 @@ TEST_F(VJsonScannerTest, use_jsonpaths_mismatch) {
     scan_node.close(&_runtime_state);
 }
 
+TEST_F(VJsonScannerTest, simdjson_fall_back) {
+    // the nested value of the second row is left to rapidjson
+    for (bool enable_simdjson : {true, false}) {
+        config::enable_simdjson_reader = enable_simdjson;
+        VBrokerScanNode scan_node(&_obj_pool, _tnode, *_desc_tbl);
+        scan_node.init(_tnode);
+        auto status = scan_node.prepare(&_runtime_state);
+        EXPECT_TRUE(status.ok());
+
+        std::vector<TScanRangeParams> scan_ranges;
+        {
+            TScanRangeParams scan_range_params;
+
+            TBrokerScanRange broker_scan_range;
+            broker_scan_range.params = _params;
+            TBrokerRangeDesc range;
+            range.start_offset = 0;
+            range.size = -1;
+            range.format_type = TFileFormatType::FORMAT_JSON;
+            range.strip_outer_array = true;
+            range.__isset.strip_outer_array = true;
+            range.splittable = true;
+            range.path = "./be/test/exec/test_data/json_scanner/test_nested_value.json";
+            range.file_type = TFileType::FILE_LOCAL;
+            broker_scan_range.ranges.push_back(range);
+            scan_range_params.scan_range.__set_broker_scan_range(broker_scan_range);
+            scan_ranges.push_back(scan_range_params);
+        }
+
+        scan_node.set_scan_ranges(scan_ranges);
+        status = scan_node.open(&_runtime_state);
+        EXPECT_TRUE(status.ok());
+
+        bool eof = false;
+        vectorized::Block block;
+        status = scan_node.get_next(&_runtime_state, &block, &eof);
+        EXPECT_TRUE(status.ok());
+        EXPECT_EQ(3, block.rows());
+        EXPECT_EQ(6, block.columns());
+
+        auto columns = block.get_columns_with_type_and_name();
+        ASSERT_EQ(columns.size(), 6);
+        ASSERT_EQ(columns[1].to_string(0), "NigelRees");
+        ASSERT_EQ(columns[1].to_string(1), "{\"first\":\"Evelyn\",\"last\":\"Waugh\"}");
+        ASSERT_EQ(columns[1].to_string(2), "HermanMelville");
+        ASSERT_EQ(columns[3].to_string(0), "8.950000");
+        ASSERT_EQ(columns[3].to_string(2), "8.990000");
+        ASSERT_EQ(columns[4].to_string(0), "1234");
+        ASSERT_EQ(columns[4].to_string(2), "-1234");
+
+        block.clear();
+        status = scan_node.get_next(&_runtime_state, &block, &eof);
+        ASSERT_EQ(0, block.rows());
+        ASSERT_TRUE(eof);
+        scan_node.close(&_runtime_state);
+    }
+    config::enable_simdjson_reader = true;
+}
+
 } // namespace vectorized
 } // namespace doris
@@ -0,0 +1,240 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vmerge_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// Returns the prepared blocks one by one, the last one comes with eos.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        if (_index < _blocks.size()) {
+            block->swap(_blocks[_index++]);
+        }
+        *eos = _index == _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _index = 0;
+};
+
+// Key is a nullable int and value is an int, the value of the i-th row is first_value + i.
+Block create_block(const std::vector<std::optional<int32_t>>& keys, int32_t first_value,
+                   bool nullable_value) {
+    auto key_column = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    auto value_column = ColumnInt32::create();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i].has_value()) {
+            int32_t key = *keys[i];
+            key_column->insert_data(reinterpret_cast<const char*>(&key), sizeof(key));
+        } else {
+            key_column->insert_data(nullptr, 0);
+        }
+        value_column->insert_value(first_value + i);
+    }
+    auto int_type = std::make_shared<DataTypeInt32>();
+    Block block;
+    block.insert({std::move(key_column), make_nullable(int_type), "k"});
+    if (nullable_value) {
+        block.insert({make_nullable(std::move(value_column)), make_nullable(int_type), "v"});
+    } else {
+        block.insert({std::move(value_column), int_type, "v"});
+    }
+    return block;
+}
+
+TExpr create_slot_ref(TSlotId slot_id, TTupleId tuple_id) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+    node.__set_num_children(0);
+    node.__set_is_nullable(true);
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot_id);
+    slot_ref.__set_tuple_id(tuple_id);
+    node.__set_slot_ref(slot_ref);
+    TExpr expr;
+    expr.nodes.push_back(node);
+    return expr;
+}
+
+std::string to_string(const IColumn& column, size_t row) {
+    Field field = column[row];
+    return field.is_null() ? "NULL" : std::to_string(field.get<Int64>());
+}
+
+} // namespace
+
+class VMergeJoinNodeTest : public testing::Test {
+public:
+    VMergeJoinNodeTest() : _runtime_state(TQueryGlobals()) {
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._query_options.enable_vectorized_engine = true;
+        // a small batch to make the output of a group span batches
+        _runtime_state._query_options.batch_size = 4;
+    }
+
+protected:
+    void SetUp() override {
+        // left: lk nullable, lv; right: rk nullable, rv nullable
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder left_tuple;
+        left_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                    .column_name("lk").column_pos(0).build());
+        left_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(false)
+                                    .column_name("lv").column_pos(1).build());
+        left_tuple.build(&table_builder);
+        TTupleDescriptorBuilder right_tuple;
+        right_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                     .column_name("rk").column_pos(0).build());
+        right_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(true)
+                                     .column_name("rv").column_pos(1).build());
+        right_tuple.build(&table_builder);
+        ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+        _runtime_state.set_desc_tbl(_desc_tbl);
+    }
+
+    // Joins the left rows (null, 0), (1, 1), (2, 2) | (2, 3), (3, 4), (5, 5) and the right
+    // rows (null, 10), (null, 11), (2, 12) | (2, 13), (2, 14) | (3, 15), (4, 16) on the keys,
+    // where "|" separates the blocks, and returns the output rows.
+    std::vector<std::string> join(TJoinOp::type join_op) {
+        TPlanNode left_tnode;
+        left_tnode.__set_node_id(1);
+        left_tnode.__set_limit(-1);
+        left_tnode.row_tuples = {0};
+        left_tnode.nullable_tuples = {false};
+        std::vector<Block> left_blocks;
+        left_blocks.push_back(create_block({std::nullopt, 1, 2}, 0, false));
+        left_blocks.push_back(create_block({2, 3, 5}, 3, false));
+        auto left = _obj_pool.add(
+                new MockBlockNode(&_obj_pool, left_tnode, *_desc_tbl, std::move(left_blocks)));
+
+        TPlanNode right_tnode = left_tnode;
+        right_tnode.__set_node_id(2);
+        right_tnode.row_tuples = {1};
+        std::vector<Block> right_blocks;
+        right_blocks.push_back(create_block({std::nullopt, std::nullopt, 2}, 10, true));
+        right_blocks.push_back(create_block({2, 2}, 13, true));
+        right_blocks.push_back(create_block({3, 4}, 15, true));
+        auto right = _obj_pool.add(
+                new MockBlockNode(&_obj_pool, right_tnode, *_desc_tbl, std::move(right_blocks)));
+
+        bool output_right =
+                join_op == TJoinOp::INNER_JOIN || join_op == TJoinOp::LEFT_OUTER_JOIN;
+        TPlanNode tnode;
+        tnode.__set_node_id(0);
+        tnode.__set_node_type(TPlanNodeType::MERGE_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        tnode.row_tuples = {0};
+        tnode.nullable_tuples = {false};
+        if (output_right) {
+            tnode.row_tuples.push_back(1);
+            tnode.nullable_tuples.push_back(true);
+        }
+        // the keys are slot refs, their columns are the first ones of the blocks
+        TEqJoinCondition condition;
+        condition.__set_left(create_slot_ref(0, 0));
+        condition.__set_right(create_slot_ref(2, 1));
+        tnode.merge_join_node.cmp_conjuncts.push_back(condition);
+        tnode.merge_join_node.__set_join_op(join_op);
+        tnode.__isset.merge_join_node = true;
+
+        VMergeJoinNode node(&_obj_pool, tnode, *_desc_tbl);
+        node._children.push_back(left);
+        node._children.push_back(right);
+        EXPECT_TRUE(left->init(left_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(right->init(right_tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node.init(tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node.prepare(&_runtime_state).ok());
+        EXPECT_TRUE(node.open(&_runtime_state).ok());
+
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node.get_next(&_runtime_state, &block, &eos).ok());
+            EXPECT_LE(block.rows(), _runtime_state.batch_size());
+            EXPECT_EQ(output_right ? 4 : 2, block.columns());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string str;
+                for (size_t i = 0; i < block.columns(); ++i) {
+                    str += (i == 0 ? "" : ",") + to_string(*block.get_by_position(i).column, row);
+                }
+                rows.push_back(str);
+            }
+        }
+        EXPECT_TRUE(node.close(&_runtime_state).ok());
+        return rows;
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(VMergeJoinNodeTest, inner_join) {
+    std::vector<std::string> expected = {"2,2,2,12", "2,2,2,13", "2,2,2,14", "2,3,2,12",
+                                         "2,3,2,13", "2,3,2,14", "3,4,3,15"};
+    EXPECT_EQ(expected, join(TJoinOp::INNER_JOIN));
+}
+
+TEST_F(VMergeJoinNodeTest, left_outer_join) {
+    std::vector<std::string> expected = {"NULL,0,NULL,NULL", "1,1,NULL,NULL", "2,2,2,12",
+                                         "2,2,2,13",         "2,2,2,14",      "2,3,2,12",
+                                         "2,3,2,13",         "2,3,2,14",      "3,4,3,15",
+                                         "5,5,NULL,NULL"};
+    EXPECT_EQ(expected, join(TJoinOp::LEFT_OUTER_JOIN));
+}
+
+TEST_F(VMergeJoinNodeTest, left_semi_join) {
+    std::vector<std::string> expected = {"2,2", "2,3", "3,4"};
+    EXPECT_EQ(expected, join(TJoinOp::LEFT_SEMI_JOIN));
+}
+
+TEST_F(VMergeJoinNodeTest, left_anti_join) {
+    std::vector<std::string> expected = {"NULL,0", "1,1", "5,5"};
+    EXPECT_EQ(expected, join(TJoinOp::LEFT_ANTI_JOIN));
+}
+
+} // namespace doris::vectorized
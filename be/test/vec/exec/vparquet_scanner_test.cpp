@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exprs/cast_functions.h"
 #include "gen_cpp/Descriptors_types.h"
@@ -61,6 +62,7 @@ private:
     int create_dst_tuple(TDescriptorTable& t_desc_table, int next_slot_id);
     void create_expr_info();
     void init_desc_table();
+    void scan_local_file();
     RuntimeState _runtime_state;
     ObjectPool _obj_pool;
     std::map<std::string, SlotDescriptor*> _slots_map;
@@ -424,7 +426,7 @@ void VParquetScannerTest::init() {
     _tnode.__isset.broker_scan_node = true;
 }
 
-TEST_F(VParquetScannerTest, normal) {
+void VParquetScannerTest::scan_local_file() {
     VBrokerScanNode scan_node(&_obj_pool, _tnode, *_desc_tbl);
     scan_node.init(_tnode);
     auto status = scan_node.prepare(&_runtime_state);
@@ -495,5 +497,15 @@ TEST_F(VParquetScannerTest, normal) {
     }
 }
 
+TEST_F(VParquetScannerTest, normal) {
+    scan_local_file();
+}
+
+TEST_F(VParquetScannerTest, arrow_reader) {
+    config::enable_native_parquet_reader = false;
+    scan_local_file();
+    config::enable_native_parquet_reader = true;
+}
+
 } // namespace vectorized
 } // namespace doris
\ No newline at end of file
@@ -0,0 +1,235 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vprotobuf_scanner.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+
+namespace doris {
+
+namespace vectorized {
+
+// event1.pb: id: 1, name: "doris", tags: ["a", "b"]
+// event2.pb: id: 2
+static const std::string EVENT_SCHEMA =
+        "syntax = \"proto2\";\n"
+        "package test;\n"
+        "message Event {\n"
+        "  optional int64 id = 1;\n"
+        "  optional string name = 2;\n"
+        "  repeated string tags = 3;\n"
+        "}\n";
+
+class VProtobufScannerTest : public testing::Test {
+public:
+    VProtobufScannerTest() : _runtime_state(TQueryGlobals()) {
+        init();
+        _profile = _runtime_state.runtime_profile();
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+
+        TUniqueId unique_id;
+        TQueryOptions query_options;
+        query_options.__set_enable_vectorized_engine(true);
+        TQueryGlobals query_globals;
+
+        _runtime_state.init(unique_id, query_options, query_globals, nullptr);
+    }
+    void init();
+
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+
+    TBrokerRangeDesc create_range(const std::string& file) {
+        TBrokerRangeDesc range;
+        range.path = "./be/test/exec/test_data/protobuf_scanner/" + file;
+        range.start_offset = 0;
+        range.size = -1;
+        range.splittable = false;
+        range.file_type = TFileType::FILE_LOCAL;
+        range.format_type = TFileFormatType::FORMAT_PROTOBUF;
+        range.__set_protobuf_schema(EVENT_SCHEMA);
+        range.__set_protobuf_message("test.Event");
+        return range;
+    }
+
+private:
+    void init_desc_table();
+    void init_params();
+
+    TupleId _dst_tuple_id = 0;
+    TupleId _src_tuple_id = 1;
+    RuntimeState _runtime_state;
+    RuntimeProfile* _profile;
+    ObjectPool _obj_pool;
+    TBrokerScanRangeParams _params;
+    DescriptorTbl* _desc_tbl;
+    std::vector<TNetworkAddress> _addresses;
+    ScannerCounter _counter;
+    std::vector<TExpr> _pre_filter;
+};
+
+static const char* COLUMN_NAMES[] = {"id", "name", "tags"};
+
+void VProtobufScannerTest::init_desc_table() {
+    TDescriptorTable t_desc_table;
+
+    // table descriptors
+    TTableDescriptor t_table_desc;
+
+    t_table_desc.id = 0;
+    t_table_desc.tableType = TTableType::OLAP_TABLE;
+    t_table_desc.numCols = 0;
+    t_table_desc.numClusteringCols = 0;
+    t_desc_table.tableDescriptors.push_back(t_table_desc);
+    t_desc_table.__isset.tableDescriptors = true;
+
+    // the nullable varchar slots of the dest tuple 0 and the src tuple 1
+    int next_slot_id = 1;
+    for (int tuple_id = 0; tuple_id < 2; ++tuple_id) {
+        for (int i = 0; i < 3; ++i) {
+            TSlotDescriptor slot_desc;
+
+            slot_desc.id = next_slot_id++;
+            slot_desc.parent = tuple_id;
+            TTypeDesc type;
+            {
+                TTypeNode node;
+                node.__set_type(TTypeNodeType::SCALAR);
+                TScalarType scalar_type;
+                scalar_type.__set_type(TPrimitiveType::VARCHAR);
+                scalar_type.__set_len(65535);
+                node.__set_scalar_type(scalar_type);
+                type.types.push_back(node);
+            }
+            slot_desc.slotType = type;
+            slot_desc.columnPos = i;
+            slot_desc.byteOffset = 8 + i * 16;
+            slot_desc.nullIndicatorByte = 0;
+            slot_desc.nullIndicatorBit = i;
+            slot_desc.colName = COLUMN_NAMES[i];
+            slot_desc.slotIdx = i + 1;
+            slot_desc.isMaterialized = true;
+
+            t_desc_table.slotDescriptors.push_back(slot_desc);
+        }
+
+        TTupleDescriptor t_tuple_desc;
+        t_tuple_desc.id = tuple_id;
+        t_tuple_desc.byteSize = 56;
+        t_tuple_desc.numNullBytes = 1;
+        t_tuple_desc.tableId = 0;
+        t_tuple_desc.__isset.tableId = true;
+        t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+    }
+    t_desc_table.__isset.slotDescriptors = true;
+
+    DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+
+    _runtime_state.set_desc_tbl(_desc_tbl);
+}
+
+void VProtobufScannerTest::init_params() {
+    TTypeDesc varchar_type;
+    {
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(TPrimitiveType::VARCHAR);
+        scalar_type.__set_len(65535);
+        node.__set_scalar_type(scalar_type);
+        varchar_type.types.push_back(node);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = varchar_type;
+        slot_ref.num_children = 0;
+        slot_ref.__isset.slot_ref = true;
+        slot_ref.slot_ref.slot_id = 4 + i;
+        slot_ref.slot_ref.tuple_id = 1;
+
+        TExpr expr;
+        expr.nodes.push_back(slot_ref);
+
+        _params.expr_of_dest_slot.emplace(i + 1, expr);
+        _params.src_slot_ids.push_back(4 + i);
+    }
+    _params.__set_dest_tuple_id(_dst_tuple_id);
+    _params.__set_src_tuple_id(_src_tuple_id);
+}
+
+void VProtobufScannerTest::init() {
+    init_desc_table();
+    init_params();
+}
+
+TEST_F(VProtobufScannerTest, normal) {
+    // each file is a message, like a kafka message of routine load
+    std::vector<TBrokerRangeDesc> ranges;
+    ranges.push_back(create_range("event1.pb"));
+    ranges.push_back(create_range("event2.pb"));
+    VProtobufScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                             &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    vectorized::Block block;
+    bool eof = false;
+    st = scanner.get_next(&block, &eof);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_TRUE(eof);
+    ASSERT_EQ(2, block.rows());
+    auto columns = block.get_columns_with_type_and_name();
+    ASSERT_EQ(3, columns.size());
+    EXPECT_EQ("1", columns[0].to_string(0));
+    EXPECT_EQ("doris", columns[1].to_string(0));
+    EXPECT_EQ("[\"a\",\"b\"]", columns[2].to_string(0));
+    // the unset optional field is null, and the empty repeated field is an empty array
+    EXPECT_EQ("2", columns[0].to_string(1));
+    EXPECT_EQ("NULL", columns[1].to_string(1));
+    EXPECT_EQ("[]", columns[2].to_string(1));
+    EXPECT_EQ(0, _counter.num_rows_filtered);
+}
+
+TEST_F(VProtobufScannerTest, invalid_schema) {
+    std::vector<TBrokerRangeDesc> ranges;
+    ranges.push_back(create_range("event1.pb"));
+    ranges[0].__set_protobuf_message("test.NotExist");
+    VProtobufScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                             &_counter);
+    EXPECT_FALSE(scanner.open().ok());
+
+    ranges[0].__set_protobuf_schema("message Event {");
+    VProtobufScanner scanner2(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                              &_counter);
+    EXPECT_FALSE(scanner2.open().ok());
+}
+
+} // namespace vectorized
+} // namespace doris
@@ -21,8 +21,11 @@
 #include <thrift/protocol/TJSONProtocol.h>
 
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <optional>
 
+#include "common/config.h"
 #include "exec/schema_scanner.h"
 #include "gen_cpp/Exprs_types.h"
 #include "gen_cpp/Types_types.h"
@@ -36,6 +39,10 @@
 #include "runtime/tuple.h"
 #include "runtime/tuple_row.h"
 #include "testutil/desc_tbl_builder.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vliteral.h"
 #include "vec/runtime/vdatetime_value.h"
 #include "vec/utils/util.hpp"
@@ -128,6 +135,238 @@ TEST(TEST_VEXPR, ABSTEST2) {
     context->close(&runtime_stat);
 }
 
+TEST(TEST_VEXPR, RESULT_REUSE_TEST) {
+    using namespace doris;
+    SchemaScanner::ColumnDesc column_descs[] = {{"k1", TYPE_INT, sizeof(int32_t), false}};
+    SchemaScanner schema_scanner(column_descs, 1);
+    ObjectPool object_pool;
+    SchemaScannerParam param;
+    schema_scanner.init(&param, &object_pool);
+    auto tuple_desc = const_cast<TupleDescriptor*>(schema_scanner.tuple_desc());
+    RowDescriptor row_desc(tuple_desc, false);
+    RowBatch row_batch(row_desc, 1024);
+    std::string expr_json =
+            R"|({"1":{"lst":["rec",2,{"1":{"i32":20},"2":{"rec":{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":6}}}}]}}},"4":{"i32":1},"20":{"i32":-1},"26":{"rec":{"1":{"rec":{"2":{"str":"abs"}}},"2":{"i32":0},"3":{"lst":["rec",1,{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":5}}}}]}}]},"4":{"rec":{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":6}}}}]}}},"5":{"tf":0},"7":{"str":"abs(INT)"},"9":{"rec":{"1":{"str":"_ZN5doris13MathFunctions3absEPN9doris_udf15FunctionContextERKNS1_6IntValE"}}},"11":{"i64":0}}}},{"1":{"i32":16},"2":{"rec":{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":5}}}}]}}},"4":{"i32":0},"15":{"rec":{"1":{"i32":0},"2":{"i32":0}}},"20":{"i32":-1},"23":{"i32":-1}}]}})|";
+    TExpr exprx = apache::thrift::from_json_string<TExpr>(expr_json);
+
+    // abs(k1) of the projection and of the conjunct
+    doris::vectorized::VExprContext* context = nullptr;
+    doris::vectorized::VExpr::create_expr_tree(&object_pool, exprx, &context);
+    doris::vectorized::VExprContext* other_context = nullptr;
+    doris::vectorized::VExpr::create_expr_tree(&object_pool, exprx, &other_context);
+    EXPECT_NE(0, context->root()->fingerprint());
+    EXPECT_EQ(context->root()->fingerprint(), other_context->root()->fingerprint());
+
+    int32_t k1 = -100;
+    for (int i = 0; i < 1024; ++i, k1++) {
+        auto idx = row_batch.add_row();
+        doris::TupleRow* tuple_row = row_batch.get_row(idx);
+        auto tuple =
+                (doris::Tuple*)(row_batch.tuple_data_pool()->allocate(tuple_desc->byte_size()));
+        auto slot_desc = tuple_desc->slots()[0];
+        memcpy(tuple->get_slot(slot_desc->tuple_offset()), &k1, slot_desc->slot_size());
+        tuple_row->set_tuple(0, tuple);
+        row_batch.commit_last_row();
+    }
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    DescriptorTbl desc_tbl;
+    desc_tbl._slot_desc_map[0] = tuple_desc->slots()[0];
+    runtime_stat.set_desc_tbl(&desc_tbl);
+    std::shared_ptr<doris::MemTracker> tracker = doris::MemTracker::create_tracker();
+    context->prepare(&runtime_stat, row_desc, tracker);
+    context->open(&runtime_stat);
+    other_context->prepare(&runtime_stat, row_desc, tracker);
+    other_context->open(&runtime_stat);
+
+    auto block = row_batch.convert_to_vec_block();
+    int ts = -1;
+    EXPECT_TRUE(context->execute(&block, &ts).ok());
+    EXPECT_EQ(2, block.columns());
+    int other_ts = -1;
+    EXPECT_TRUE(other_context->execute(&block, &other_ts).ok());
+    EXPECT_EQ(ts, other_ts);
+    EXPECT_EQ(2, block.columns());
+    EXPECT_EQ(100, block.get_by_position(ts).column->get_int(0));
+
+    // the result of another number of rows is not reused
+    block.get_by_position(0).column = block.get_by_position(0).column->cut(0, 10);
+    EXPECT_TRUE(other_context->execute(&block, &other_ts).ok());
+    EXPECT_EQ(2, other_ts);
+    EXPECT_EQ(10, block.get_by_position(other_ts).column->size());
+
+    // the results are erased when the block is reused for the next batch of the same rows
+    const std::string result_name = block.get_by_position(other_ts).name;
+    block.clear_column_data();
+    EXPECT_EQ(1, block.columns());
+    EXPECT_FALSE(block.is_reusable_result(result_name));
+    auto next_k1 = doris::vectorized::ColumnInt32::create();
+    for (int32_t i = 0; i < 10; ++i) {
+        next_k1->insert_value(-i);
+    }
+    block.get_by_position(0).column = std::move(next_k1);
+    EXPECT_TRUE(context->execute(&block, &ts).ok());
+    EXPECT_EQ(1, ts);
+    EXPECT_EQ(9, block.get_by_position(ts).column->get_int(9));
+    EXPECT_TRUE(other_context->execute(&block, &other_ts).ok());
+    EXPECT_EQ(ts, other_ts);
+    EXPECT_EQ(2, block.columns());
+
+    // a column of the name not computed on the batch is not reused
+    doris::vectorized::Block copy(block.get_columns_with_type_and_name());
+    EXPECT_FALSE(copy.is_reusable_result(result_name));
+    EXPECT_TRUE(other_context->execute(&copy, &other_ts).ok());
+    EXPECT_EQ(2, other_ts);
+
+    context->close(&runtime_stat);
+    other_context->close(&runtime_stat);
+}
+
+TEST(TEST_VEXPR, CONSTANT_FOLDING_TEST) {
+    using namespace doris;
+    ObjectPool object_pool;
+    RowDescriptor row_desc;
+    // abs(-100)
+    std::string expr_json =
+            R"|({"1":{"lst":["rec",2,{"1":{"i32":20},"2":{"rec":{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":6}}}}]}}},"4":{"i32":1},"20":{"i32":-1},"26":{"rec":{"1":{"rec":{"2":{"str":"abs"}}},"2":{"i32":0},"3":{"lst":["rec",1,{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":5}}}}]}}]},"4":{"rec":{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":6}}}}]}}},"5":{"tf":0},"7":{"str":"abs(INT)"},"9":{"rec":{"1":{"str":"_ZN5doris13MathFunctions3absEPN9doris_udf15FunctionContextERKNS1_6IntValE"}}},"11":{"i64":0}}}},{"1":{"i32":9},"2":{"rec":{"1":{"lst":["rec",1,{"1":{"i32":0},"2":{"rec":{"1":{"i32":5}}}}]}}},"4":{"i32":0},"10":{"rec":{"1":{"i64":-100}}},"20":{"i32":-1}}]}})|";
+    TExpr exprx = apache::thrift::from_json_string<TExpr>(expr_json);
+    doris::vectorized::VExprContext* context = nullptr;
+    doris::vectorized::VExpr::create_expr_tree(&object_pool, exprx, &context);
+    EXPECT_TRUE(context->root()->is_constant());
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    std::shared_ptr<doris::MemTracker> tracker = doris::MemTracker::create_tracker();
+    context->prepare(&runtime_stat, row_desc, tracker);
+    context->open(&runtime_stat);
+
+    for (int rows : {10, 3}) {
+        auto column = vectorized::ColumnInt32::create();
+        for (int i = 0; i < rows; ++i) {
+            column->insert_value(i);
+        }
+        vectorized::Block block(
+                {{std::move(column), std::make_shared<vectorized::DataTypeInt32>(), "k1"}});
+        int ts = -1;
+        EXPECT_TRUE(context->execute(&block, &ts).ok());
+        const auto& result = block.get_by_position(ts).column;
+        EXPECT_TRUE(vectorized::is_column_const(*result));
+        EXPECT_EQ(rows, result->size());
+        EXPECT_EQ(100, result->get_int(rows - 1));
+    }
+    context->close(&runtime_stat);
+}
+
+namespace {
+doris::TExprNode create_double_node(doris::TExprNodeType::type node_type, int num_children) {
+    doris::TExprNode node;
+    node.__set_node_type(node_type);
+    node.__set_type(doris::TypeDescriptor(doris::TYPE_DOUBLE).to_thrift());
+    node.__set_num_children(num_children);
+    node.__set_is_nullable(false);
+    node.__set_output_scale(-1);
+    return node;
+}
+
+doris::TExprNode create_call_node(const std::string& name, doris::PrimitiveType ret_type) {
+    doris::TExprNode node = create_double_node(doris::TExprNodeType::FUNCTION_CALL, 2);
+    node.__set_type(doris::TypeDescriptor(ret_type).to_thrift());
+    doris::TFunction fn;
+    doris::TFunctionName fn_name;
+    fn_name.__set_function_name(name);
+    fn.__set_name(fn_name);
+    fn.__set_binary_type(doris::TFunctionBinaryType::BUILTIN);
+    fn.__set_arg_types({doris::TypeDescriptor(doris::TYPE_DOUBLE).to_thrift(),
+                        doris::TypeDescriptor(doris::TYPE_DOUBLE).to_thrift()});
+    fn.__set_ret_type(doris::TypeDescriptor(ret_type).to_thrift());
+    fn.__set_has_var_args(false);
+    node.__set_fn(fn);
+    return node;
+}
+
+// (k1 + 1.5) * k1 - k1 > 10 in prefix order
+doris::TExpr create_fusable_expr() {
+    doris::TExprNode slot_ref = create_double_node(doris::TExprNodeType::SLOT_REF, 0);
+    doris::TSlotRef slot;
+    slot.__set_slot_id(0);
+    slot.__set_tuple_id(0);
+    slot_ref.__set_slot_ref(slot);
+    doris::TExprNode literal = create_double_node(doris::TExprNodeType::FLOAT_LITERAL, 0);
+    doris::TFloatLiteral float_literal;
+    float_literal.__set_value(1.5);
+    literal.__set_float_literal(float_literal);
+    doris::TExprNode ten = literal;
+    ten.float_literal.__set_value(10);
+
+    doris::TExpr expr;
+    expr.nodes = {create_call_node("gt", doris::TYPE_BOOLEAN),
+                  create_call_node("subtract", doris::TYPE_DOUBLE),
+                  create_call_node("multiply", doris::TYPE_DOUBLE),
+                  create_call_node("add", doris::TYPE_DOUBLE),
+                  slot_ref,
+                  literal,
+                  slot_ref,
+                  slot_ref,
+                  ten};
+    return expr;
+}
+} // namespace
+
+TEST(TEST_VEXPR, FUSION_TEST) {
+    using namespace doris;
+    SchemaScanner::ColumnDesc column_descs[] = {{"k1", TYPE_DOUBLE, sizeof(double), false}};
+    SchemaScanner schema_scanner(column_descs, 1);
+    ObjectPool object_pool;
+    SchemaScannerParam param;
+    schema_scanner.init(&param, &object_pool);
+    auto tuple_desc = const_cast<TupleDescriptor*>(schema_scanner.tuple_desc());
+    RowDescriptor row_desc(tuple_desc, false);
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    DescriptorTbl desc_tbl;
+    desc_tbl._slot_desc_map[0] = tuple_desc->slots()[0];
+    runtime_stat.set_desc_tbl(&desc_tbl);
+    std::shared_ptr<doris::MemTracker> tracker = doris::MemTracker::create_tracker();
+
+    auto min_operators = config::expr_fusion_min_operators;
+    std::vector<vectorized::ColumnPtr> results;
+    for (int32_t fusion_min_operators : {3, 0}) {
+        config::expr_fusion_min_operators = fusion_min_operators;
+        doris::vectorized::VExprContext* context = nullptr;
+        EXPECT_TRUE(doris::vectorized::VExpr::create_expr_tree(&object_pool,
+                                                               create_fusable_expr(), &context)
+                            .ok());
+        EXPECT_TRUE(context->prepare(&runtime_stat, row_desc, tracker).ok());
+        EXPECT_TRUE(context->open(&runtime_stat).ok());
+
+        // more rows than a tile
+        auto column = vectorized::ColumnFloat64::create();
+        for (int i = 0; i < 1000; ++i) {
+            column->insert_value(i * 0.01 - 3);
+        }
+        vectorized::Block block(
+                {{std::move(column), std::make_shared<vectorized::DataTypeFloat64>(), "k1"}});
+        int ts = -1;
+        EXPECT_TRUE(context->execute(&block, &ts).ok());
+        results.push_back(block.get_by_position(ts).column);
+        context->close(&runtime_stat);
+    }
+    config::expr_fusion_min_operators = min_operators;
+
+    EXPECT_EQ(1000, results[0]->size());
+    EXPECT_EQ(1000, results[1]->size());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(results[1]->get_int(i), results[0]->get_int(i));
+    }
+    double k1 = 999 * 0.01 - 3;
+    EXPECT_EQ((k1 + 1.5) * k1 - k1 > 10, results[0]->get_int(999));
+}
+
 namespace doris {
 template <PrimitiveType T>
 struct literal_traits {};
@@ -352,3 +591,267 @@ TEST(TEST_VEXPR, LITERALTEST) {
         EXPECT_FLOAT_EQ(((double)v.get_value()) / (std::pow(10, v.get_scale())), 1234.56);
     }
 }
+
+namespace {
+doris::TExprNode create_nullable_node(doris::TExprNodeType::type node_type,
+                                      doris::PrimitiveType type, int num_children) {
+    doris::TExprNode node = create_double_node(node_type, num_children);
+    node.__set_type(doris::TypeDescriptor(type).to_thrift());
+    node.__set_is_nullable(true);
+    return node;
+}
+
+doris::TExprNode create_slot_ref_node(doris::PrimitiveType type, int slot_id) {
+    doris::TExprNode node = create_nullable_node(doris::TExprNodeType::SLOT_REF, type, 0);
+    doris::TSlotRef slot;
+    slot.__set_slot_id(slot_id);
+    slot.__set_tuple_id(0);
+    node.__set_slot_ref(slot);
+    return node;
+}
+
+doris::TExprNode create_gt_node() {
+    doris::TExprNode node = create_call_node("gt", doris::TYPE_BOOLEAN);
+    node.__set_is_nullable(true);
+    return node;
+}
+
+// the nullable columns b, x and y of the rows
+struct ShortCircuitRows {
+    std::vector<std::optional<bool>> b;
+    std::vector<std::optional<double>> x;
+    std::vector<std::optional<double>> y;
+};
+
+template <typename T>
+doris::vectorized::ColumnPtr create_nullable_column(const std::vector<std::optional<T>>& values) {
+    auto column = doris::vectorized::ColumnVector<T>::create();
+    auto null_map = doris::vectorized::ColumnUInt8::create();
+    for (const auto& value : values) {
+        column->insert_value(value.value_or(T()));
+        null_map->insert_value(!value.has_value());
+    }
+    return doris::vectorized::ColumnNullable::create(std::move(column), std::move(null_map));
+}
+
+template <typename T>
+std::optional<T> get_nullable_value(const doris::vectorized::IColumn& column, size_t row) {
+    doris::vectorized::Field field = column[row];
+    if (field.is_null()) {
+        return std::nullopt;
+    }
+    if constexpr (std::is_same_v<T, bool>) {
+        return field.get<doris::vectorized::UInt64>() != 0;
+    } else {
+        return field.get<T>();
+    }
+}
+
+// x > y, null if any is null
+std::optional<bool> greater(const ShortCircuitRows& rows, size_t row) {
+    if (!rows.x[row].has_value() || !rows.y[row].has_value()) {
+        return std::nullopt;
+    }
+    return *rows.x[row] > *rows.y[row];
+}
+
+// x is i except for every 7th row, y is 50
+ShortCircuitRows create_rows(size_t num_rows,
+                             const std::function<std::optional<bool>(size_t)>& get_b) {
+    ShortCircuitRows rows;
+    for (size_t i = 0; i < num_rows; ++i) {
+        rows.b.push_back(get_b(i));
+        rows.x.push_back(i % 7 == 0 ? std::nullopt : std::optional<double>(i));
+        rows.y.push_back(50);
+    }
+    return rows;
+}
+} // namespace
+
+class VExprShortCircuitTest : public testing::Test {
+public:
+    void SetUp() override {
+        _ratio = doris::config::short_circuit_evaluation_max_ratio;
+        doris::DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << doris::TYPE_BOOLEAN << doris::TYPE_DOUBLE << doris::TYPE_DOUBLE;
+        _desc_tbl = builder.build();
+        _tuple_desc = const_cast<doris::TupleDescriptor*>(_desc_tbl->get_tuple_descriptor(0));
+        _row_desc = std::make_unique<doris::RowDescriptor>(_tuple_desc, false);
+        _state = std::make_unique<doris::RuntimeState>(
+                doris::TUniqueId(), doris::TQueryOptions(), doris::TQueryGlobals(), nullptr);
+        _state->init_instance_mem_tracker();
+        _state->set_desc_tbl(_desc_tbl);
+    }
+
+    void TearDown() override { doris::config::short_circuit_evaluation_max_ratio = _ratio; }
+
+protected:
+    doris::TExprNode slot_ref(doris::PrimitiveType type, int column) {
+        return create_slot_ref_node(type, _tuple_desc->slots()[column]->id());
+    }
+
+    // b AND x > y, b OR x > y
+    doris::TExpr create_compound_expr(bool is_and) {
+        doris::TExprNode node =
+                create_nullable_node(doris::TExprNodeType::COMPOUND_PRED, doris::TYPE_BOOLEAN, 2);
+        node.__set_opcode(is_and ? doris::TExprOpcode::COMPOUND_AND
+                                 : doris::TExprOpcode::COMPOUND_OR);
+        doris::TExpr expr;
+        expr.nodes = {node, slot_ref(doris::TYPE_BOOLEAN, 0), create_gt_node(),
+                      slot_ref(doris::TYPE_DOUBLE, 1), slot_ref(doris::TYPE_DOUBLE, 2)};
+        return expr;
+    }
+
+    // CASE WHEN b THEN x WHEN x > y THEN y [ELSE x] END
+    doris::TExpr create_case_expr(bool has_else) {
+        doris::TExprNode node = create_nullable_node(doris::TExprNodeType::CASE_EXPR,
+                                                     doris::TYPE_DOUBLE, has_else ? 5 : 4);
+        doris::TCaseExpr case_expr;
+        case_expr.__set_has_case_expr(false);
+        case_expr.__set_has_else_expr(has_else);
+        node.__set_case_expr(case_expr);
+        doris::TExpr expr;
+        expr.nodes = {node,
+                      slot_ref(doris::TYPE_BOOLEAN, 0),
+                      slot_ref(doris::TYPE_DOUBLE, 1),
+                      create_gt_node(),
+                      slot_ref(doris::TYPE_DOUBLE, 1),
+                      slot_ref(doris::TYPE_DOUBLE, 2),
+                      slot_ref(doris::TYPE_DOUBLE, 2)};
+        if (has_else) {
+            expr.nodes.push_back(slot_ref(doris::TYPE_DOUBLE, 1));
+        }
+        return expr;
+    }
+
+    // returns the result and the number of the columns added into the block
+    doris::vectorized::ColumnPtr execute(const doris::TExpr& expr, const ShortCircuitRows& rows,
+                                         size_t* added_columns) {
+        doris::vectorized::VExprContext* context = nullptr;
+        EXPECT_TRUE(doris::vectorized::VExpr::create_expr_tree(&_pool, expr, &context).ok());
+        std::shared_ptr<doris::MemTracker> tracker = doris::MemTracker::create_tracker();
+        EXPECT_TRUE(context->prepare(_state.get(), *_row_desc, tracker).ok());
+        EXPECT_TRUE(context->open(_state.get()).ok());
+
+        auto bool_type = doris::vectorized::make_nullable(
+                std::make_shared<doris::vectorized::DataTypeUInt8>());
+        auto double_type = doris::vectorized::make_nullable(
+                std::make_shared<doris::vectorized::DataTypeFloat64>());
+        doris::vectorized::Block block({{create_nullable_column<doris::vectorized::UInt8>(
+                                                 to_uint8(rows.b)),
+                                         bool_type, "b"},
+                                        {create_nullable_column(rows.x), double_type, "x"},
+                                        {create_nullable_column(rows.y), double_type, "y"}});
+        int result_id = -1;
+        EXPECT_TRUE(context->execute(&block, &result_id).ok());
+        *added_columns = block.columns() - 3;
+        auto result = block.get_by_position(result_id).column->convert_to_full_column_if_const();
+        context->close(_state.get());
+        return result;
+    }
+
+    static std::vector<std::optional<doris::vectorized::UInt8>> to_uint8(
+            const std::vector<std::optional<bool>>& values) {
+        std::vector<std::optional<doris::vectorized::UInt8>> result;
+        for (const auto& value : values) {
+            result.push_back(value.has_value() ? std::optional<doris::vectorized::UInt8>(*value)
+                                               : std::nullopt);
+        }
+        return result;
+    }
+
+    doris::ObjectPool _pool;
+    doris::DescriptorTbl* _desc_tbl = nullptr;
+    doris::TupleDescriptor* _tuple_desc = nullptr;
+    std::unique_ptr<doris::RowDescriptor> _row_desc;
+    std::unique_ptr<doris::RuntimeState> _state;
+    double _ratio = 0;
+};
+
+TEST_F(VExprShortCircuitTest, compound_pred) {
+    const size_t num_rows = 100;
+    for (bool is_and : {true, false}) {
+        // false decides AND, true decides OR
+        const bool deciding = !is_and;
+        // every `undecided_every` row is null or not deciding, 0 for none
+        for (size_t undecided_every : {2, 10, 0}) {
+            auto rows = create_rows(num_rows, [&](size_t i) -> std::optional<bool> {
+                if (undecided_every == 0 || i % undecided_every != 0) {
+                    return deciding;
+                }
+                return (i / undecided_every) % 2 == 0 ? std::nullopt
+                                                      : std::optional<bool>(!deciding);
+            });
+            size_t undecided_rows = undecided_every == 0 ? 0 : num_rows / undecided_every;
+            for (double ratio : {0.0, 0.3, 1.0}) {
+                doris::config::short_circuit_evaluation_max_ratio = ratio;
+                size_t added_columns = 0;
+                auto result = execute(create_compound_expr(is_and), rows, &added_columns);
+                ASSERT_EQ(num_rows, result->size());
+                for (size_t i = 0; i < num_rows; ++i) {
+                    std::optional<bool> expected;
+                    if (rows.b[i] == deciding) {
+                        expected = deciding;
+                    } else if (rows.b[i].has_value()) {
+                        expected = greater(rows, i);
+                    } else if (greater(rows, i) == deciding) {
+                        // null AND false, null OR true
+                        expected = deciding;
+                    }
+                    EXPECT_EQ(expected, get_nullable_value<bool>(*result, i))
+                            << "is_and " << is_and << " undecided every " << undecided_every
+                            << " ratio " << ratio << " row " << i;
+                }
+                // the right side executed on the whole block adds its column into it
+                bool rhs_on_block = undecided_rows > 0 && undecided_rows > num_rows * ratio;
+                EXPECT_EQ(rhs_on_block ? 2 : 1, added_columns)
+                        << "is_and " << is_and << " undecided every " << undecided_every
+                        << " ratio " << ratio;
+            }
+        }
+    }
+}
+
+TEST_F(VExprShortCircuitTest, case_when) {
+    const size_t num_rows = 100;
+    std::vector<ShortCircuitRows> data = {
+            // all the branches are reached
+            create_rows(num_rows,
+                        [](size_t i) -> std::optional<bool> {
+                            if (i % 3 == 0) {
+                                return std::nullopt;
+                            }
+                            return i % 3 == 1;
+                        }),
+            // the rows not matched by the first WHEN are few
+            create_rows(num_rows, [](size_t i) { return i % 10 != 0; }),
+            // the first WHEN matches all the rows, nothing else is reached
+            create_rows(num_rows, [](size_t) { return true; }),
+            // the first THEN is reached by no row
+            create_rows(num_rows, [](size_t) { return false; }),
+    };
+    for (bool has_else : {true, false}) {
+        for (size_t d = 0; d < data.size(); ++d) {
+            const auto& rows = data[d];
+            for (double ratio : {0.0, 0.3, 1.0}) {
+                doris::config::short_circuit_evaluation_max_ratio = ratio;
+                size_t added_columns = 0;
+                auto result = execute(create_case_expr(has_else), rows, &added_columns);
+                ASSERT_EQ(num_rows, result->size());
+                for (size_t i = 0; i < num_rows; ++i) {
+                    std::optional<double> expected;
+                    if (rows.b[i] == true) {
+                        expected = rows.x[i];
+                    } else if (greater(rows, i) == true) {
+                        expected = rows.y[i];
+                    } else if (has_else) {
+                        expected = rows.x[i];
+                    }
+                    EXPECT_EQ(expected, get_nullable_value<double>(*result, i))
+                            << "has_else " << has_else << " data " << d << " ratio " << ratio
+                            << " row " << i;
+                }
+            }
+        }
+    }
+}
@@ -61,7 +61,10 @@ TEST(FunctionJsonTEST, GetJsonStringTest) {
              VARCHAR("v1")},
             {{VARCHAR("[{\"k1\":\"v1\"}, {\"k2\":\"v2\"}, {\"k1\":\"v3\"}, {\"k1\":\"v4\"}]"),
               VARCHAR("$.k1")},
-             VARCHAR("[\"v1\",\"v3\",\"v4\"]")}};
+             VARCHAR("[\"v1\",\"v3\",\"v4\"]")},
+            {{VARCHAR("{\"k1\":\"v1\""), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":{\"k2\":3}}"), VARCHAR("$.k1")}, VARCHAR("{\"k2\":3}")},
+            {{VARCHAR("{\"k1\":\"v5\"}"), VARCHAR("$.k1")}, VARCHAR("v5")}};
 
     check_function<DataTypeString, true>(func_name, input_types, data_set);
 }
@@ -58,6 +58,24 @@ TEST(function_string_test, function_string_substr_test) {
 
         check_function<DataTypeString, true>(func_name, input_types, data_set);
     }
+
+    {
+        // only ascii chars
+        InputTypeSet input_types = {TypeIndex::String, TypeIndex::Int32, TypeIndex::Int32};
+
+        DataSet data_set = {{{std::string("hello word"), -5, 5}, std::string(" word")},
+                            {{std::string("hello word"), -5, 2}, std::string(" w")},
+                            {{std::string("hello word"), -20, 2}, std::string("")},
+                            {{std::string("hello word"), 1, 12}, std::string("hello word")},
+                            {{std::string("hello word"), 10, 1}, std::string("d")},
+                            {{std::string("hello word"), 11, 1}, Null()},
+                            {{std::string("HELLO,!^%"), 4, 2}, std::string("LO")},
+                            {{std::string("HELLO,!^%"), 4, 0}, std::string("")},
+                            {{std::string(""), 5, 4}, Null()},
+                            {{Null(), 5, 4}, Null()}};
+
+        check_function<DataTypeString, true>(func_name, input_types, data_set);
+    }
 }
 
 TEST(function_string_test, function_string_strright_test) {
@@ -268,6 +286,15 @@ TEST(function_string_test, function_rpad_test) {
                         {{std::string("呵呵"), 5, std::string("hi")}, std::string("呵呵hih")}};
 
     check_function<DataTypeString, true>(func_name, input_types, data_set);
+
+    // only ascii chars
+    data_set = {{{std::string("hi"), 5, std::string("?")}, std::string("hi???")},
+                {{std::string("hi"), 1, std::string("?")}, std::string("h")},
+                {{std::string("hi"), 5, std::string("")}, Null()},
+                {{std::string("hi"), 7, std::string("ab")}, std::string("hiababa")},
+                {{std::string("hi"), 6, std::string("abc")}, std::string("hiabca")}};
+
+    check_function<DataTypeString, true>(func_name, input_types, data_set);
 }
 
 TEST(function_string_test, function_ascii_test) {
@@ -479,6 +506,21 @@ TEST(function_string_test, function_locate_test) {
 
         check_function<DataTypeInt32, true>(func_name, input_types, data_set);
     }
+
+    {
+        // only ascii chars
+        InputTypeSet input_types = {TypeIndex::String, TypeIndex::String, TypeIndex::Int32};
+
+        DataSet data_set = {{{STRING("bar"), STRING("foobarbar"), INT(5)}, INT(7)},
+                            {{STRING("bar"), STRING("foobarbar"), INT(4)}, INT(4)},
+                            {{STRING("bar"), STRING("foobarbar"), INT(10)}, INT(0)},
+                            {{STRING("xbar"), STRING("foobar"), INT(1)}, INT(0)},
+                            {{STRING(""), STRING("foobar"), INT(2)}, INT(2)},
+                            {{STRING("A"), STRING("aAbA"), INT(0)}, INT(0)},
+                            {{STRING("A"), STRING("aAbA"), INT(3)}, INT(4)}};
+
+        check_function<DataTypeInt32, true>(func_name, input_types, data_set);
+    }
 }
 
 TEST(function_string_test, function_find_in_set_test) {
@@ -539,11 +539,41 @@ TEST(VTimestampFunctionsTest, convert_tz_test) {
               STRING("America/Los_Angeles")},
              str_to_date_time("2019-07-31 22:21:03", true)},
             {{DATETIME("2019-08-01 13:21:03"), STRING("+08:00"), STRING("America/Los_Angeles")},
-             str_to_date_time("2019-07-31 22:21:03", true)}};
+             str_to_date_time("2019-07-31 22:21:03", true)},
+            {{DATETIME("2019-08-01 13:21:03"), STRING("+08:00"), STRING("Invalid/Zone")}, Null()},
+            {{DATETIME("2019-08-01 13:21:03"), STRING("+08:00"), STRING("America/Los_Angeles")},
+             str_to_date_time("2019-07-31 22:21:03", true)},
+            {{DATETIME("2019-08-01 13:21:03"), STRING("+08:00"), STRING("+00:00")},
+             str_to_date_time("2019-08-01 05:21:03", true)}};
 
     check_function<DataTypeDate, true>(func_name, input_types, data_set);
 }
 
+TEST(VTimestampFunctionsTest, floor_ceil_test) {
+    InputTypeSet input_types = {TypeIndex::DateTime};
+    auto check = [&](const std::string& func_name, const std::string& value,
+                     const std::string& expected) {
+        DataSet data_set = {{{DATETIME(value)}, str_to_date_time(expected, true)}};
+        check_function<DataTypeDateTime, true>(func_name, input_types, data_set);
+    };
+
+    check("year_floor", "2021-07-15 11:22:33", "2021-01-01 00:00:00");
+    check("month_floor", "2021-07-15 11:22:33", "2021-07-01 00:00:00");
+    check("day_floor", "2021-07-15 11:22:33", "2021-07-15 00:00:00");
+    check("hour_floor", "2021-07-15 11:22:33", "2021-07-15 11:00:00");
+    check("minute_floor", "2021-07-15 11:22:33", "2021-07-15 11:22:00");
+    check("second_floor", "2021-07-15 11:22:33", "2021-07-15 11:22:33");
+    check("week_floor", "2021-07-15 11:22:33", "2021-07-11 00:00:00");
+    check("hour_floor", "1969-12-31 23:59:59", "1969-12-31 23:00:00");
+
+    check("year_ceil", "2021-07-15 11:22:33", "2022-01-01 00:00:00");
+    check("year_ceil", "2021-01-01 00:00:00", "2021-01-01 00:00:00");
+    check("month_ceil", "2021-12-15 11:22:33", "2022-01-01 00:00:00");
+    check("day_ceil", "2021-07-15 00:00:00", "2021-07-15 00:00:00");
+    check("hour_ceil", "2021-07-15 23:22:33", "2021-07-16 00:00:00");
+    check("minute_ceil", "2021-07-15 11:22:00", "2021-07-15 11:22:00");
+}
+
 TEST(VTimestampFunctionsTest, weekday_test) {
     std::string func_name = "weekday";
 
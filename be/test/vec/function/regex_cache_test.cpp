@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/functions/regex_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris::vectorized {
+
+TEST(RegexCacheTest, get) {
+    RegexCache cache(1024 * 1024);
+    re2::RE2::Options options;
+    options.set_dot_nl(true);
+    auto re = cache.get("a.*b", options);
+    ASSERT_TRUE(re->ok());
+    EXPECT_TRUE(re2::RE2::FullMatch("a\nb", *re));
+    EXPECT_EQ(re, cache.get("a.*b", options));
+
+    // the logging options share the same regex, the others not
+    options.set_log_errors(false);
+    EXPECT_EQ(re, cache.get("a.*b", options));
+    options.set_dot_nl(false);
+    auto other_re = cache.get("a.*b", options);
+    EXPECT_NE(re, other_re);
+    EXPECT_FALSE(re2::RE2::FullMatch("a\nb", *other_re));
+    EXPECT_NE(re, cache.get("a.*c", options));
+
+    // the invalid patterns are not cached
+    auto invalid_re = cache.get("a(b", options);
+    EXPECT_FALSE(invalid_re->ok());
+    EXPECT_NE(invalid_re, cache.get("a(b", options));
+}
+
+TEST(RegexCacheTest, evict) {
+    RegexCache cache(16 * 4096);
+    re2::RE2::Options options;
+    auto re = cache.get("pattern_0", options);
+    for (int i = 1; i < 10000; ++i) {
+        cache.get("pattern_" + std::to_string(i), options);
+    }
+    EXPECT_NE(re, cache.get("pattern_0", options));
+    // the evicted regex is kept by its users
+    EXPECT_TRUE(re2::RE2::FullMatch("pattern_0", *re));
+}
+
+} // namespace doris::vectorized
@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
 #include "vec/olap/olap_data_convertor.h"
 
 namespace doris::vectorized {
@@ -33,10 +37,17 @@ TEST(CharTypePaddingTest, CharTypePaddingFullTest) {
     for (size_t i = 0; i < rows; i++) {
         input->insert_data(str.data(), str.length());
     }
-    EXPECT_FALSE(ConvertorChar::should_padding(input, str.length()));
 
-    input->insert_data(str.data(), str.length() - 1);
-    EXPECT_TRUE(ConvertorChar::should_padding(input, str.length()));
+    // the strings of the full length are not copied
+    ColumnPtr column = std::move(input);
+    ConvertorChar convertor(str.length());
+    convertor.set_source_column({column, std::make_shared<DataTypeString>(), ""}, 0, rows);
+    EXPECT_TRUE(convertor.convert_to_olap().ok());
+    auto slices = reinterpret_cast<const Slice*>(convertor.get_data());
+    for (size_t i = 0; i < rows; i++) {
+        EXPECT_EQ(column->get_data_at(i).data, slices[i].data);
+        EXPECT_EQ(str.length(), slices[i].size);
+    }
 }
 
 TEST(CharTypePaddingTest, CharTypePaddingDataTest) {
@@ -49,10 +60,17 @@ TEST(CharTypePaddingTest, CharTypePaddingDataTest) {
         input->insert_data(str.data(), str.length() - i);
     }
 
-    auto output = ConvertorChar::clone_and_padding(input, str.length());
-
-    for (int i = 0; i < rows; i++) {
-        auto cell = output->get_data_at(i).to_string();
+    // only the rows converted are padded
+    ColumnPtr column = std::move(input);
+    ConvertorChar convertor(str.length());
+    size_t row_pos = 2;
+    convertor.set_source_column({column, std::make_shared<DataTypeString>(), ""}, row_pos,
+                                rows - row_pos);
+    EXPECT_TRUE(convertor.convert_to_olap().ok());
+    auto slices = reinterpret_cast<const Slice*>(convertor.get_data());
+
+    for (int i = row_pos; i < rows; i++) {
+        auto cell = slices[i - row_pos].to_string();
         EXPECT_EQ(cell.length(), str.length());
 
         auto str_real = std::string(cell.data(), str.length() - i);
@@ -65,4 +83,33 @@ TEST(CharTypePaddingTest, CharTypePaddingDataTest) {
     }
 }
 
+TEST(CharTypePaddingTest, NullableCharTest) {
+    auto nested = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    std::string str = "Allemande";
+    size_t rows = 10;
+    for (size_t i = 0; i < rows; i++) {
+        nested->insert_data(str.data(), i % 3 == 0 ? 0 : str.length() - 1);
+        null_map->insert_value(i % 3 == 0);
+    }
+
+    // the null map is aligned with the rows converted
+    ColumnPtr column = ColumnNullable::create(std::move(nested), std::move(null_map));
+    auto type = make_nullable(std::make_shared<DataTypeString>());
+    ConvertorChar convertor(str.length());
+    size_t row_pos = 4;
+    convertor.set_source_column({column, type, ""}, row_pos, rows - row_pos);
+    EXPECT_TRUE(convertor.convert_to_olap().ok());
+    const UInt8* nullmap = convertor.get_nullmap();
+    auto slices = reinterpret_cast<const Slice*>(convertor.get_data());
+    for (size_t i = row_pos; i < rows; i++) {
+        EXPECT_EQ(i % 3 == 0, nullmap[i - row_pos]);
+        if (i % 3 == 0) {
+            EXPECT_EQ(nullptr, convertor.get_data_at(i - row_pos));
+        } else {
+            EXPECT_EQ(str.substr(0, str.length() - 1) + '\0', slices[i - row_pos].to_string());
+        }
+    }
+}
+
 } // namespace doris::vectorized
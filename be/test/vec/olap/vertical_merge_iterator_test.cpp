@@ -0,0 +1,195 @@
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "vec/olap/vertical_merge_iterator.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "olap/olap_common.h"
+#include "olap/schema.h"
+#include "vec/olap/vgeneric_iterators.h"
+
+namespace doris {
+
+namespace vectorized {
+
+class VerticalMergeIteratorTest : public testing::Test {
+public:
+    VerticalMergeIteratorTest() {}
+    virtual ~VerticalMergeIteratorTest() {}
+};
+
+static Schema create_schema() {
+    std::vector<TabletColumn> col_schemas;
+    // c1: smallint, key
+    col_schemas.emplace_back(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_SMALLINT, true);
+    // c2: int, key
+    col_schemas.emplace_back(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_INT, true);
+    // c3: big int
+    col_schemas.emplace_back(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_BIGINT, true);
+
+    Schema schema(col_schemas, 2);
+    return schema;
+}
+
+static void create_block(Schema& schema, Block& block) {
+    for (auto& column_desc : schema.columns()) {
+        EXPECT_TRUE(column_desc);
+        auto data_type = Schema::get_data_type_ptr(*column_desc);
+        EXPECT_NE(data_type, nullptr);
+        auto column = data_type->create_column();
+        ColumnWithTypeAndName ctn(std::move(column), data_type, column_desc->name());
+        block.insert(ctn);
+    }
+}
+
+static std::vector<RowwiseIterator*> create_inputs(Schema& schema) {
+    std::vector<RowwiseIterator*> inputs;
+    inputs.push_back(new_auto_increment_iterator(schema, 100));
+    inputs.push_back(new_auto_increment_iterator(schema, 200));
+    inputs.push_back(new_auto_increment_iterator(schema, 300));
+    StorageReadOptions opts;
+    for (auto input : inputs) {
+        EXPECT_TRUE(input->init(opts).ok());
+    }
+    return inputs;
+}
+
+static void read_all(RowwiseIterator* iter, Block* block) {
+    Status st;
+    do {
+        st = iter->next_batch(block);
+    } while (st.ok());
+    EXPECT_TRUE(st.is_end_of_file());
+}
+
+TEST(VerticalMergeIteratorTest, RowSourcesBuffer) {
+    RowSourcesBuffer buffer;
+    buffer.append(RowSource(1, false));
+    buffer.append(RowSource(1, false));
+    buffer.append(RowSource(1, true));
+    buffer.append(RowSource(RowSource::MAX_SOURCE_NUM, true));
+    EXPECT_EQ(4, buffer.total_size());
+
+    buffer.seek_to_begin();
+    EXPECT_TRUE(buffer.has_remaining());
+    EXPECT_EQ(1, buffer.current().get_source_num());
+    EXPECT_FALSE(buffer.current().agg_flag());
+    EXPECT_EQ(2, buffer.same_source_count(10));
+    EXPECT_EQ(1, buffer.same_source_count(1));
+
+    buffer.advance(2);
+    EXPECT_EQ(1, buffer.current().get_source_num());
+    EXPECT_TRUE(buffer.current().agg_flag());
+    EXPECT_EQ(1, buffer.same_source_count(10));
+
+    buffer.advance();
+    EXPECT_EQ(RowSource::MAX_SOURCE_NUM, buffer.current().get_source_num());
+    EXPECT_TRUE(buffer.current().agg_flag());
+    buffer.advance();
+    EXPECT_FALSE(buffer.has_remaining());
+}
+
+TEST(VerticalMergeIteratorTest, DupKeys) {
+    auto schema = create_schema();
+    RowSourcesBuffer row_sources;
+
+    auto inputs = create_inputs(schema);
+    std::unique_ptr<RowwiseIterator> key_iter(
+            new_vertical_heap_merge_iterator(inputs, false, &row_sources));
+    StorageReadOptions opts;
+    EXPECT_TRUE(key_iter->init(opts).ok());
+    Block key_block;
+    create_block(schema, key_block);
+    read_all(key_iter.get(), &key_block);
+    EXPECT_EQ(600, key_block.rows());
+    EXPECT_EQ(600, row_sources.total_size());
+
+    inputs = create_inputs(schema);
+    std::unique_ptr<RowwiseIterator> value_iter(
+            new_vertical_mask_merge_iterator(inputs, &row_sources));
+    EXPECT_TRUE(value_iter->init(opts).ok());
+    Block value_block;
+    create_block(schema, value_block);
+    read_all(value_iter.get(), &value_block);
+    EXPECT_EQ(600, value_block.rows());
+
+    // both are ordered by keys, and the rows with the same key come from older inputs first
+    auto c0 = key_block.get_by_position(0).column;
+    row_sources.seek_to_begin();
+    for (size_t i = 0; i < key_block.rows(); ++i) {
+        int base_value = i < 300 ? i / 3 : (i < 500 ? 100 + (i - 300) / 2 : 200 + (i - 500));
+        EXPECT_EQ(base_value, (*c0)[i].get<int>());
+        EXPECT_FALSE(row_sources.current().agg_flag());
+        row_sources.advance();
+        for (size_t cid = 0; cid < 3; ++cid) {
+            EXPECT_EQ(0, key_block.get_by_position(cid).column->compare_at(
+                                 i, i, *value_block.get_by_position(cid).column, -1));
+        }
+    }
+}
+
+TEST(VerticalMergeIteratorTest, UniqueKeys) {
+    auto schema = create_schema();
+    RowSourcesBuffer row_sources;
+
+    auto inputs = create_inputs(schema);
+    std::unique_ptr<RowwiseIterator> key_iter(
+            new_vertical_heap_merge_iterator(inputs, true, &row_sources));
+    StorageReadOptions opts;
+    EXPECT_TRUE(key_iter->init(opts).ok());
+    Block key_block;
+    create_block(schema, key_block);
+    read_all(key_iter.get(), &key_block);
+    EXPECT_EQ(300, key_block.rows());
+    EXPECT_EQ(600, row_sources.total_size());
+
+    // the row of the newest input is kept
+    row_sources.seek_to_begin();
+    EXPECT_EQ(2, row_sources.current().get_source_num());
+    EXPECT_FALSE(row_sources.current().agg_flag());
+    row_sources.advance();
+    EXPECT_EQ(1, row_sources.current().get_source_num());
+    EXPECT_TRUE(row_sources.current().agg_flag());
+    row_sources.advance();
+    EXPECT_EQ(0, row_sources.current().get_source_num());
+    EXPECT_TRUE(row_sources.current().agg_flag());
+
+    inputs = create_inputs(schema);
+    std::unique_ptr<RowwiseIterator> value_iter(
+            new_vertical_mask_merge_iterator(inputs, &row_sources));
+    row_sources.seek_to_begin();
+    EXPECT_TRUE(value_iter->init(opts).ok());
+    Block value_block;
+    create_block(schema, value_block);
+    read_all(value_iter.get(), &value_block);
+    EXPECT_EQ(300, value_block.rows());
+
+    for (size_t i = 0; i < key_block.rows(); ++i) {
+        EXPECT_EQ(static_cast<int>(i), (*key_block.get_by_position(0).column)[i].get<int>());
+        for (size_t cid = 0; cid < 3; ++cid) {
+            EXPECT_EQ(0, key_block.get_by_position(cid).column->compare_at(
+                                 i, i, *value_block.get_by_position(cid).column, -1));
+        }
+    }
+}
+
+} // namespace vectorized
+
+} // namespace doris
@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/shared_hash_table_controller.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "runtime/runtime_state.h"
+
+namespace doris::vectorized {
+
+static TUniqueId make_instance_id(int64_t lo) {
+    TUniqueId id;
+    id.hi = 1;
+    id.lo = lo;
+    return id;
+}
+
+TEST(SharedHashTableControllerTest, only_first_instance_builds) {
+    SharedHashTableController controller;
+    EXPECT_TRUE(controller.should_build_hash_table(make_instance_id(1), 0));
+    EXPECT_FALSE(controller.should_build_hash_table(make_instance_id(2), 0));
+    // the builder is asked again
+    EXPECT_TRUE(controller.should_build_hash_table(make_instance_id(1), 0));
+    // another join node of the same query
+    EXPECT_TRUE(controller.should_build_hash_table(make_instance_id(2), 1));
+}
+
+TEST(SharedHashTableControllerTest, wait_for_signal) {
+    RuntimeState state;
+    SharedHashTableController controller;
+    EXPECT_TRUE(controller.should_build_hash_table(make_instance_id(1), 0));
+
+    auto blocks = std::make_shared<std::vector<Block>>();
+    std::thread builder([&]() {
+        auto context = std::make_shared<SharedHashTableContext>();
+        context->blocks = blocks;
+        controller.signal(0, context);
+    });
+
+    SharedHashTableContextPtr context;
+    EXPECT_TRUE(controller.wait_for_signal(&state, 0, &context).ok());
+    builder.join();
+    EXPECT_EQ(blocks, context->blocks);
+}
+
+TEST(SharedHashTableControllerTest, build_failed) {
+    RuntimeState state;
+    SharedHashTableController controller;
+    auto context = std::make_shared<SharedHashTableContext>();
+    context->status = Status::InternalError("build failed");
+    controller.signal(0, context);
+
+    SharedHashTableContextPtr result;
+    EXPECT_FALSE(controller.wait_for_signal(&state, 0, &result).ok());
+}
+
+TEST(SharedHashTableControllerTest, cancelled) {
+    RuntimeState state;
+    state.set_is_cancelled(true);
+    SharedHashTableController controller;
+    SharedHashTableContextPtr context;
+    EXPECT_TRUE(controller.wait_for_signal(&state, 0, &context).is_cancelled());
+}
+
+} // namespace doris::vectorized
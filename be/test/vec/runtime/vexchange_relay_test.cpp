@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vexchange_relay.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace doris::vectorized {
+
+using Subtrees = std::vector<std::pair<int, int>>;
+
+TEST(ExchangeRelayTest, split_relay_destinations) {
+    EXPECT_EQ(Subtrees({{0, 4}, {4, 7}, {7, 10}}), split_relay_destinations(10, 3));
+    EXPECT_EQ(Subtrees({{0, 1}, {1, 2}}), split_relay_destinations(2, 4));
+    EXPECT_EQ(Subtrees({{0, 5}}), split_relay_destinations(5, 1));
+    EXPECT_TRUE(split_relay_destinations(0, 3).empty());
+    EXPECT_TRUE(split_relay_destinations(3, 0).empty());
+}
+
+TEST(ExchangeRelayTest, relay_tree) {
+    // every receiver is reached once, and the depth of the tree grows by log(fanout)
+    const int num_receivers = 100;
+    const int fanout = 3;
+    std::vector<int> reached(num_receivers, 0);
+    int max_depth = 0;
+    std::function<void(int, int, int)> relay = [&](int begin, int end, int depth) {
+        max_depth = std::max(max_depth, depth);
+        for (auto [sub_begin, sub_end] : split_relay_destinations(end - begin, fanout)) {
+            ++reached[begin + sub_begin];
+            relay(begin + sub_begin + 1, begin + sub_end, depth + 1);
+        }
+    };
+    relay(0, num_receivers, 0);
+    for (int i = 0; i < num_receivers; ++i) {
+        EXPECT_EQ(1, reached[i]) << i;
+    }
+    EXPECT_LE(max_depth, 5);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vparquet_writer.h"
+
+#include <gtest/gtest.h>
+#include <parquet/api/reader.h>
+
+#include <filesystem>
+
+#include "common/object_pool.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+#include "io/local_file_writer.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class VParquetWriterTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _file_path = std::filesystem::temp_directory_path() / "vparquet_writer_test.parquet";
+        std::filesystem::remove(_file_path);
+        _exprs.push_back(_pool.add(new ExprContext(_pool.add(new SlotRef(TYPE_INT, 0)))));
+        _exprs.push_back(_pool.add(new ExprContext(_pool.add(new SlotRef(TYPE_VARCHAR, 1)))));
+    }
+    void TearDown() override { std::filesystem::remove(_file_path); }
+
+    Block _make_block(int begin, int rows) {
+        auto ints = ColumnInt32::create();
+        auto null_map = ColumnUInt8::create();
+        auto strings = ColumnString::create();
+        for (int i = begin; i < begin + rows; ++i) {
+            ints->insert_value(i);
+            // every third row is null
+            null_map->insert_value(i % 3 == 0);
+            std::string str = "str" + std::to_string(i);
+            strings->insert_data(str.data(), str.size());
+        }
+        Block block;
+        block.insert({ColumnNullable::create(std::move(ints), std::move(null_map)),
+                      make_nullable(std::make_shared<DataTypeInt32>()), "k1"});
+        block.insert({std::move(strings), std::make_shared<DataTypeString>(), "k2"});
+        return block;
+    }
+
+    ObjectPool _pool;
+    std::string _file_path;
+    std::vector<ExprContext*> _exprs;
+};
+
+TEST_F(VParquetWriterTest, write_blocks) {
+    std::vector<std::vector<std::string>> schema = {{"optional", "int32", "k1"},
+                                                    {"required", "byte_array", "k2"}};
+    LocalFileWriter file_writer(_file_path, 0);
+    EXPECT_TRUE(file_writer.open().ok());
+    VParquetWriterWrapper writer(&file_writer, _exprs, {{"compression", "snappy"}}, schema,
+                                 false);
+    EXPECT_TRUE(writer.init().ok());
+    EXPECT_TRUE(writer.write(_make_block(0, 100)).ok());
+    EXPECT_TRUE(writer.write(_make_block(100, 50)).ok());
+    EXPECT_TRUE(writer.close().ok());
+    EXPECT_GT(writer.written_len(), 0);
+    // the file writer is left to the caller
+    EXPECT_TRUE(file_writer.close().ok());
+
+    auto reader = parquet::ParquetFileReader::OpenFile(_file_path);
+    auto metadata = reader->metadata();
+    EXPECT_EQ(150, metadata->num_rows());
+    EXPECT_EQ(1, metadata->num_row_groups());
+
+    auto row_group = reader->RowGroup(0);
+    auto* int_reader = static_cast<parquet::Int32Reader*>(row_group->Column(0).get());
+    std::vector<int32_t> values(150);
+    std::vector<int16_t> def_levels(150);
+    int64_t values_read = 0;
+    EXPECT_EQ(150, int_reader->ReadBatch(150, def_levels.data(), nullptr, values.data(),
+                                         &values_read));
+    EXPECT_EQ(100, values_read);
+    EXPECT_EQ(0, def_levels[0]);
+    EXPECT_EQ(1, def_levels[1]);
+    // the values only hold the non-null rows
+    EXPECT_EQ(1, values[0]);
+    EXPECT_EQ(2, values[1]);
+    EXPECT_EQ(4, values[2]);
+
+    auto column = row_group->Column(1);
+    auto* string_reader = static_cast<parquet::ByteArrayReader*>(column.get());
+    std::vector<parquet::ByteArray> strings(150);
+    EXPECT_EQ(150, string_reader->ReadBatch(150, nullptr, nullptr, strings.data(),
+                                            &values_read));
+    EXPECT_EQ("str149", std::string((const char*)strings[149].ptr, strings[149].len));
+}
+
+TEST_F(VParquetWriterTest, mismatched_schema) {
+    std::vector<std::vector<std::string>> schema = {{"optional", "int64", "k1"},
+                                                    {"required", "byte_array", "k2"}};
+    LocalFileWriter file_writer(_file_path, 0);
+    EXPECT_TRUE(file_writer.open().ok());
+    VParquetWriterWrapper writer(&file_writer, _exprs, {}, schema, false);
+    EXPECT_FALSE(writer.init().ok());
+
+    schema.pop_back();
+    VParquetWriterWrapper short_writer(&file_writer, _exprs, {}, schema, false);
+    EXPECT_FALSE(short_writer.init().ok());
+    EXPECT_TRUE(file_writer.close().ok());
+}
+
+} // namespace doris::vectorized
@@ -43,6 +43,7 @@ Usage: $0 <options>
      --fe               build Frontend and Spark DPP application
      --be               build Backend
      --meta-tool        build Backend meta tool
+     --benchmark        build Backend micro-benchmarks
      --broker           build Broker
      --spark-dpp        build Spark DPP application
      --hive-udf         build Hive UDF library for Spark Load
@@ -53,11 +54,13 @@ Usage: $0 <options>
   Environment variables:
     USE_AVX2            If the CPU does not support AVX2 instruction set, please set USE_AVX2=0. Default is ON.
     STRIP_DEBUG_INFO    If set STRIP_DEBUG_INFO=ON, the debug information in the compiled binaries will be stored separately in the 'be/lib/debug_info' directory. Default is OFF.
+    WITH_HYPERSCAN      If set WITH_HYPERSCAN=ON, LIKE and REGEXP with constant patterns are matched by hyperscan, x86 only. Default is OFF.
 
   Eg.
     $0                                      build all
     $0 --be                                 build Backend
     $0 --meta-tool                          build Backend meta tool
+    $0 --be --benchmark                     build Backend and its micro-benchmarks
     $0 --fe --clean                         clean and build Frontend and Spark Dpp application
     $0 --fe --be --clean                    clean and build Frontend, Spark Dpp application and Backend
     $0 --spark-dpp                          build Spark DPP application alone
@@ -104,6 +107,7 @@ OPTS=$(getopt \
   -l 'be' \
   -l 'broker' \
   -l 'meta-tool' \
+  -l 'benchmark' \
   -l 'spark-dpp' \
   -l 'java-udf' \
   -l 'hive-udf' \
@@ -123,6 +127,7 @@ BUILD_FE=0
 BUILD_BE=0
 BUILD_BROKER=0
 BUILD_META_TOOL=OFF
+BUILD_BENCHMARK=OFF
 BUILD_SPARK_DPP=0
 BUILD_JAVA_UDF=0
 BUILD_HIVE_UDF=0
@@ -147,6 +152,7 @@ else
             --be) BUILD_BE=1 ; shift ;;
             --broker) BUILD_BROKER=1 ; shift ;;
             --meta-tool) BUILD_META_TOOL=ON ; shift ;;
+            --benchmark) BUILD_BENCHMARK=ON ; shift ;;
             --spark-dpp) BUILD_SPARK_DPP=1 ; shift ;;
             --java-udf) BUILD_JAVA_UDF=1 BUILD_FE=1 BUILD_SPARK_DPP=1 ; shift ;;
             --hive-udf) BUILD_HIVE_UDF=1 ; shift ;;
@@ -202,6 +208,9 @@ fi
 if [[ -z ${WITH_LZO} ]]; then
     WITH_LZO=OFF
 fi
+if [[ -z ${WITH_HYPERSCAN} ]]; then
+    WITH_HYPERSCAN=OFF
+fi
 if [[ -z ${USE_LIBCPP} ]]; then
     USE_LIBCPP=OFF
 fi
@@ -224,6 +233,7 @@ echo "Get params:
     BUILD_BE            -- $BUILD_BE
     BUILD_BROKER        -- $BUILD_BROKER
     BUILD_META_TOOL     -- $BUILD_META_TOOL
+    BUILD_BENCHMARK     -- $BUILD_BENCHMARK
     BUILD_SPARK_DPP     -- $BUILD_SPARK_DPP
     BUILD_JAVA_UDF      -- $BUILD_JAVA_UDF
     BUILD_HIVE_UDF      -- $BUILD_HIVE_UDF
@@ -231,6 +241,7 @@ echo "Get params:
     CLEAN               -- $CLEAN
     WITH_MYSQL          -- $WITH_MYSQL
     WITH_LZO            -- $WITH_LZO
+    WITH_HYPERSCAN      -- $WITH_HYPERSCAN
     GLIBC_COMPATIBILITY -- $GLIBC_COMPATIBILITY
     USE_AVX2            -- $USE_AVX2
     USE_LIBCPP          -- $USE_LIBCPP
@@ -293,8 +304,10 @@ if [ ${BUILD_BE} -eq 1 ] ; then
             ${CMAKE_USE_CCACHE} \
             -DWITH_MYSQL=${WITH_MYSQL} \
             -DWITH_LZO=${WITH_LZO} \
+            -DWITH_HYPERSCAN=${WITH_HYPERSCAN} \
             -DUSE_LIBCPP=${USE_LIBCPP} \
             -DBUILD_META_TOOL=${BUILD_META_TOOL} \
+            -DBUILD_BENCHMARK=${BUILD_BENCHMARK} \
             -DUSE_LLD=${USE_LLD} \
             -DBUILD_JAVA_UDF=${BUILD_JAVA_UDF} \
             -DSTRIP_DEBUG_INFO=${STRIP_DEBUG_INFO} \
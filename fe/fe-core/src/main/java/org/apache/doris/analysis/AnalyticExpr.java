@@ -500,6 +500,11 @@ public class AnalyticExpr extends Expr {
                 "DISTINCT not allowed in analytic function: " + getFnCall().toSql());
         }
 
+        if (getFnCall().hasOrderBy()) {
+            throw new AnalysisException(
+                "ORDER BY in the params not allowed in analytic function: " + getFnCall().toSql());
+        }
+
         // check for correct composition of analytic expr
         Function fn = getFnCall().getFn();
 
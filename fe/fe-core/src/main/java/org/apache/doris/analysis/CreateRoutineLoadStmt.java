@@ -97,12 +97,15 @@ public class CreateRoutineLoadStmt extends DdlStmt {
     public static final String MAX_BATCH_SIZE_PROPERTY = "max_batch_size";
     public static final String EXEC_MEM_LIMIT_PROPERTY = "exec_mem_limit";
 
-    public static final String FORMAT = "format"; // the value is csv or json, default is csv
+    public static final String FORMAT = "format"; // the value is csv, json or protobuf, default is csv
     public static final String STRIP_OUTER_ARRAY = "strip_outer_array";
     public static final String JSONPATHS = "jsonpaths";
     public static final String JSONROOT = "json_root";
     public static final String NUM_AS_STRING = "num_as_string";
     public static final String FUZZY_PARSE = "fuzzy_parse";
+    // the .proto schema and the full name of the message type of the protobuf format
+    public static final String PROTOBUF_SCHEMA = "protobuf_schema";
+    public static final String PROTOBUF_MESSAGE = "protobuf_message";
 
     // kafka type properties
     public static final String KAFKA_BROKER_LIST_PROPERTY = "kafka_broker_list";
@@ -130,6 +133,8 @@ public class CreateRoutineLoadStmt extends DdlStmt {
             .add(NUM_AS_STRING)
             .add(FUZZY_PARSE)
             .add(JSONROOT)
+            .add(PROTOBUF_SCHEMA)
+            .add(PROTOBUF_MESSAGE)
             .add(LoadStmt.STRICT_MODE)
             .add(LoadStmt.TIMEZONE)
             .add(EXEC_MEM_LIMIT_PROPERTY)
@@ -171,6 +176,8 @@ public class CreateRoutineLoadStmt extends DdlStmt {
     private boolean stripOuterArray = false;
     private boolean numAsString = false;
     private boolean fuzzyParse = false;
+    private String protobufSchema = "";
+    private String protobufMessage = "";
 
     private LoadTask.MergeType mergeType;
 
@@ -278,6 +285,14 @@ public class CreateRoutineLoadStmt extends DdlStmt {
         return jsonRoot;
     }
 
+    public String getProtobufSchema() {
+        return protobufSchema;
+    }
+
+    public String getProtobufMessage() {
+        return protobufMessage;
+    }
+
     public String getKafkaBrokerList() {
         return this.dataSourceProperties.getKafkaBrokerList();
     }
@@ -467,6 +482,14 @@ public class CreateRoutineLoadStmt extends DdlStmt {
                 stripOuterArray = Boolean.valueOf(jobProperties.getOrDefault(STRIP_OUTER_ARRAY, "false"));
                 numAsString = Boolean.valueOf(jobProperties.getOrDefault(NUM_AS_STRING, "false"));
                 fuzzyParse = Boolean.valueOf(jobProperties.getOrDefault(FUZZY_PARSE, "false"));
+            } else if (format.equalsIgnoreCase("protobuf")) {
+                format = "protobuf";
+                protobufSchema = jobProperties.getOrDefault(PROTOBUF_SCHEMA, "");
+                protobufMessage = jobProperties.getOrDefault(PROTOBUF_MESSAGE, "");
+                if (Strings.isNullOrEmpty(protobufSchema) || Strings.isNullOrEmpty(protobufMessage)) {
+                    throw new AnalysisException(PROTOBUF_SCHEMA + " and " + PROTOBUF_MESSAGE
+                            + " are required by the protobuf format");
+                }
             } else {
                 throw new UserException("Format type is invalid. format=`" + format + "`");
             }
@@ -39,6 +39,7 @@ import org.apache.doris.qe.ConnectContext;
 import org.apache.doris.thrift.TAggregateExpr;
 import org.apache.doris.thrift.TExprNode;
 import org.apache.doris.thrift.TExprNodeType;
+import org.apache.doris.thrift.TTypeDesc;
 
 import com.google.common.base.Joiner;
 import com.google.common.base.MoreObjects;
@@ -78,6 +79,13 @@ public class FunctionCallExpr extends Expr {
     // resetAnalysisState() which is used during expr substitution.
     private boolean isMergeAggFn;
 
+    // The ORDER BY of an aggregate function, e.g. group_concat(v ORDER BY k). The ORDER BY exprs
+    // are the last children, after the params of the function. The merge aggregation has only
+    // the intermediate slot as child and keeps the types of the update one in aggParamTypes.
+    private List<Boolean> orderByIsAsc = Lists.newArrayList();
+    private List<Boolean> orderByNullsFirst = Lists.newArrayList();
+    private List<Type> aggParamTypes;
+
     private static final ImmutableSet<String> STDDEV_FUNCTION_SET =
             new ImmutableSortedSet.Builder(String.CASE_INSENSITIVE_ORDER)
                     .add("stddev").add("stddev_val").add("stddev_samp")
@@ -141,6 +149,13 @@ public class FunctionCallExpr extends Expr {
         if (params.exprs() != null) {
             children.addAll(params.exprs());
         }
+        if (params.orderByElements() != null) {
+            for (OrderByElement element : params.orderByElements()) {
+                children.add(element.getExpr());
+                orderByIsAsc.add(element.getIsAsc());
+                orderByNullsFirst.add(OrderByElement.nullsFirst(element.getNullsFirstParam(), element.getIsAsc()));
+            }
+        }
         originChildSize = children.size();
     }
 
@@ -168,13 +183,19 @@ public class FunctionCallExpr extends Expr {
         // fnParams = other.fnParams;
         // Clone the params in a way that keeps the children_ and the params.exprs()
         // in sync. The children have already been cloned in the super c'tor.
+        this.isMergeAggFn = other.isMergeAggFn;
+        orderByIsAsc = other.orderByIsAsc;
+        orderByNullsFirst = other.orderByNullsFirst;
+        aggParamTypes = other.aggParamTypes;
         if (other.fnParams.isStar()) {
             Preconditions.checkState(children.isEmpty());
             fnParams = FunctionParams.createStarParam();
-        } else {
+        } else if (orderByIsAsc.isEmpty() || isMergeAggFn) {
             fnParams = new FunctionParams(other.fnParams.isDistinct(), children);
+        } else {
+            fnParams = new FunctionParams(other.fnParams.isDistinct(),
+                    Lists.newArrayList(children.subList(0, getNumFnArgs())));
         }
-        this.isMergeAggFn = other.isMergeAggFn;
         fn = other.fn;
         this.isTableFnCall = other.isTableFnCall;
     }
@@ -208,6 +229,28 @@ public class FunctionCallExpr extends Expr {
         return isMergeAggFn;
     }
 
+    public boolean hasOrderBy() {
+        return !orderByIsAsc.isEmpty();
+    }
+
+    // the number of children which are the params of the function, the others are ORDER BY exprs
+    private int getNumFnArgs() {
+        return isMergeAggFn ? children.size() : children.size() - orderByIsAsc.size();
+    }
+
+    private String orderByToSql() {
+        if (isMergeAggFn || orderByIsAsc.isEmpty()) {
+            return "";
+        }
+        List<String> result = Lists.newArrayList();
+        int numArgs = getNumFnArgs();
+        for (int i = 0; i < orderByIsAsc.size(); ++i) {
+            result.add(new OrderByElement(children.get(numArgs + i), orderByIsAsc.get(i),
+                    orderByNullsFirst.get(i)).toSql());
+        }
+        return " ORDER BY " + Joiner.on(", ").join(result);
+    }
+
     @Override
     public Expr clone() {
         return new FunctionCallExpr(this);
@@ -233,7 +276,9 @@ public class FunctionCallExpr extends Expr {
         FunctionCallExpr o = (FunctionCallExpr) obj;
         return /*opcode == o.opcode && aggOp == o.aggOp &&*/ fnName.equals(o.fnName)
                 && fnParams.isDistinct() == o.fnParams.isDistinct()
-                && fnParams.isStar() == o.fnParams.isStar();
+                && fnParams.isStar() == o.fnParams.isStar()
+                && orderByIsAsc.equals(o.orderByIsAsc)
+                && orderByNullsFirst.equals(o.orderByNullsFirst);
     }
 
     private String paramsToSql() {
@@ -246,7 +291,7 @@ public class FunctionCallExpr extends Expr {
         if (fnParams.isDistinct()) {
             sb.append("DISTINCT ");
         }
-        int len = children.size();
+        int len = getNumFnArgs();
         List<String> result = Lists.newArrayList();
         if (fnName.getFunction().equalsIgnoreCase("json_array")
                 || fnName.getFunction().equalsIgnoreCase("json_object")) {
@@ -268,7 +313,7 @@ public class FunctionCallExpr extends Expr {
                 result.add(children.get(i).toSql());
             }
         }
-        sb.append(Joiner.on(", ").join(result)).append(")");
+        sb.append(Joiner.on(", ").join(result)).append(orderByToSql()).append(")");
         return sb.toString();
     }
 
@@ -301,7 +346,7 @@ public class FunctionCallExpr extends Expr {
         if (fnParams.isDistinct()) {
             sb.append("DISTINCT ");
         }
-        int len = children.size();
+        int len = getNumFnArgs();
         List<String> result = Lists.newArrayList();
         if (fnName.getFunction().equalsIgnoreCase("json_array")
                 || fnName.getFunction().equalsIgnoreCase("json_object")) {
@@ -428,7 +473,18 @@ public class FunctionCallExpr extends Expr {
         if (isAggregate() || isAnalyticFnCall) {
             msg.node_type = TExprNodeType.AGG_EXPR;
             if (!isAnalyticFnCall) {
-                msg.setAggExpr(new TAggregateExpr(isMergeAggFn));
+                TAggregateExpr aggExpr = new TAggregateExpr(isMergeAggFn);
+                if (!orderByIsAsc.isEmpty()) {
+                    List<TTypeDesc> paramTypes = Lists.newArrayList();
+                    for (Type paramType : isMergeAggFn ? aggParamTypes
+                            : Arrays.asList(collectChildReturnTypes())) {
+                        paramTypes.add(paramType.toThrift());
+                    }
+                    aggExpr.setParamTypes(paramTypes);
+                    aggExpr.setIsAscOrder(orderByIsAsc);
+                    aggExpr.setNullsFirst(orderByNullsFirst);
+                }
+                msg.setAggExpr(aggExpr);
             }
         } else {
             msg.node_type = TExprNodeType.FUNCTION_CALL;
@@ -476,8 +532,24 @@ public class FunctionCallExpr extends Expr {
             return;
         }
 
+        if (!orderByIsAsc.isEmpty() && !fnName.getFunction().equalsIgnoreCase("group_concat")) {
+            throw new AnalysisException("ORDER BY is only supported by group_concat: " + this.toSql());
+        }
+
         if (fnName.getFunction().equalsIgnoreCase("group_concat")) {
-            if (children.size() > 2 || children.isEmpty()) {
+            if (!orderByIsAsc.isEmpty()) {
+                if (fnParams.isDistinct()) {
+                    throw new AnalysisException(
+                            "group_concat with ORDER BY does not support DISTINCT: " + this.toSql());
+                }
+                if (!VectorizedUtil.isVectorized()) {
+                    throw new AnalysisException(
+                            "group_concat with ORDER BY is only supported by the vectorized engine: "
+                                    + this.toSql());
+                }
+            }
+            int numArgs = getNumFnArgs();
+            if (numArgs > 2 || numArgs == 0) {
                 throw new AnalysisException(
                         "group_concat requires one or two parameters: " + this.toSql());
             }
@@ -488,7 +560,7 @@ public class FunctionCallExpr extends Expr {
                         "group_concat requires first parameter to be of type STRING: " + this.toSql());
             }
 
-            if (children.size() == 2) {
+            if (numArgs == 2) {
                 Expr arg1 = getChild(1);
                 if (!arg1.type.isStringType() && !arg1.type.isNull()) {
                     throw new AnalysisException(
@@ -915,7 +987,7 @@ public class FunctionCallExpr extends Expr {
             } else {
                 // now first find function in built-in functions
                 if (Strings.isNullOrEmpty(fnName.getDb())) {
-                    Type[] childTypes = collectChildReturnTypes();
+                    Type[] childTypes = Arrays.copyOf(collectChildReturnTypes(), getNumFnArgs());
                     fn = getBuiltinFunction(analyzer, fnName.getFunction(), childTypes,
                             Function.CompareMode.IS_NONSTRICT_SUPERTYPE_OF);
                 }
@@ -998,8 +1070,9 @@ public class FunctionCallExpr extends Expr {
         if (!fn.getFunctionName().getFunction().equals(ELEMENT_EXTRACT_FN_NAME)) {
             Type[] args = fn.getArgs();
             if (args.length > 0) {
-                // Implicitly cast all the children to match the function if necessary
-                for (int i = 0; i < argTypes.length; ++i) {
+                // Implicitly cast all the children to match the function if necessary,
+                // the ORDER BY exprs are not params of the function
+                for (int i = 0; i < getNumFnArgs(); ++i) {
                     // For varargs, we must compare with the last type in callArgs.argTypes.
                     int ix = Math.min(args.length - 1, i);
                     if (!argTypes[i].matchesType(args[ix]) && !(
@@ -1151,6 +1224,12 @@ public class FunctionCallExpr extends Expr {
         // Inherit the function object from 'agg'.
         result.fn = agg.fn;
         result.type = agg.type;
+        if (agg.hasOrderBy()) {
+            result.orderByIsAsc = agg.orderByIsAsc;
+            result.orderByNullsFirst = agg.orderByNullsFirst;
+            result.aggParamTypes = agg.isMergeAggFn ? agg.aggParamTypes
+                    : Arrays.asList(agg.collectChildReturnTypes());
+        }
         return result;
     }
 
@@ -38,6 +38,8 @@ public class FunctionParams implements Writable {
     private boolean isStar;
     private List<Expr> exprs;
     private boolean isDistinct;
+    // ORDER BY of an aggregate function, e.g. group_concat(v ORDER BY k), not persisted
+    private List<OrderByElement> orderByElements;
 
     // c'tor for non-star params
     public FunctionParams(boolean isDistinct, List<Expr> exprs) {
@@ -46,6 +48,12 @@ public class FunctionParams implements Writable {
         this.exprs = exprs;
     }
 
+    // c'tor for non-star params with ORDER BY
+    public FunctionParams(boolean isDistinct, List<Expr> exprs, List<OrderByElement> orderByElements) {
+        this(isDistinct, exprs);
+        this.orderByElements = orderByElements;
+    }
+
     // c'tor for non-star, non-distinct params
     public FunctionParams(List<Expr> exprs) {
         this(false, exprs);
@@ -74,6 +82,10 @@ public class FunctionParams implements Writable {
         return exprs;
     }
 
+    public List<OrderByElement> orderByElements() {
+        return orderByElements;
+    }
+
     public void setIsDistinct(boolean v) {
         isDistinct = v;
     }
@@ -51,9 +51,11 @@ public class IndexDef {
     }
 
     public void analyze() throws AnalysisException {
-        if (indexType == IndexDef.IndexType.BITMAP) {
+        if (indexType == IndexDef.IndexType.BITMAP || indexType == IndexDef.IndexType.INVERTED
+                || indexType == IndexDef.IndexType.NGRAM_BF) {
             if (columns == null || columns.size() != 1) {
-                throw new AnalysisException("bitmap index can only apply to a single column.");
+                throw new AnalysisException(indexType.toString().toLowerCase()
+                        + " index can only apply to a single column.");
             }
             if (Strings.isNullOrEmpty(indexName)) {
                 throw new AnalysisException("index name cannot be blank.");
@@ -126,7 +128,8 @@ public class IndexDef {
 
     public enum IndexType {
         BITMAP,
-
+        INVERTED,
+        NGRAM_BF,
     }
 
     public void checkColumn(Column column, KeysType keysType) throws AnalysisException {
@@ -142,13 +145,25 @@ public class IndexDef {
                         "BITMAP index only used in columns of DUP_KEYS/UNIQUE_KEYS table or key columns of"
                                 + " AGG_KEYS table. invalid column: " + indexColName);
             }
+        } else if (indexType == IndexType.INVERTED || indexType == IndexType.NGRAM_BF) {
+            String indexColName = column.getName();
+            PrimitiveType colType = column.getDataType();
+            if (!colType.isStringType()) {
+                throw new AnalysisException(colType + " is not supported in " + indexType + " index. "
+                        + "invalid column: " + indexColName);
+            } else if ((keysType == KeysType.AGG_KEYS && !column.isKey())) {
+                throw new AnalysisException(indexType
+                        + " index only used in columns of DUP_KEYS/UNIQUE_KEYS table or key columns of"
+                                + " AGG_KEYS table. invalid column: " + indexColName);
+            }
         } else {
             throw new AnalysisException("Unsupported index type: " + indexType);
         }
     }
 
     public void checkColumns(List<Column> columns, KeysType keysType) throws AnalysisException {
-        if (indexType == IndexType.BITMAP) {
+        if (indexType == IndexType.BITMAP || indexType == IndexType.INVERTED
+                || indexType == IndexType.NGRAM_BF) {
             for (Column col : columns) {
                 checkColumn(col, keysType);
             }
@@ -519,7 +519,8 @@ public class OutFileClause {
                 || fileFormatType == TFileFormatType.FORMAT_CSV_LZ4FRAME
                 || fileFormatType == TFileFormatType.FORMAT_CSV_LZO
                 || fileFormatType == TFileFormatType.FORMAT_CSV_LZOP
-                || fileFormatType == TFileFormatType.FORMAT_CSV_PLAIN;
+                || fileFormatType == TFileFormatType.FORMAT_CSV_PLAIN
+                || fileFormatType == TFileFormatType.FORMAT_CSV_ZSTD;
     }
 
     private boolean isParquetFormat() {
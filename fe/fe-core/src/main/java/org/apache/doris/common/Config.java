@@ -1072,6 +1072,15 @@ public class Config extends ConfigBase {
     @ConfField(mutable = true, masterOnly = true)
     public static boolean disable_load_job = false;
 
+    /**
+     * If set to true, the loads write the rows to one replica of each tablet only,
+     * and the other replicas pull the rowset written by it before the load is committed.
+     * This saves the CPU of the other replicas building the same rowset.
+     * Only the vectorized load supports it.
+     */
+    @ConfField(mutable = true, masterOnly = true)
+    public static boolean enable_single_replica_load = false;
+
     /*
      * One master daemon thread will update database used data quota for db txn manager
      * every db_used_data_quota_update_interval_secs
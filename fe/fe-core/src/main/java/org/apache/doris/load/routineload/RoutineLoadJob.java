@@ -201,6 +201,8 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
     private static final String PROPS_JSONPATHS = "jsonpaths";
     private static final String PROPS_JSONROOT = "json_root";
     private static final String PROPS_FUZZY_PARSE = "fuzzy_parse";
+    private static final String PROPS_PROTOBUF_SCHEMA = "protobuf_schema";
+    private static final String PROPS_PROTOBUF_MESSAGE = "protobuf_message";
 
 
     protected int currentTaskConcurrentNum;
@@ -306,6 +308,10 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
             jobProperties.put(PROPS_FORMAT, "csv");
         } else if (stmt.getFormat().equals("json")) {
             jobProperties.put(PROPS_FORMAT, "json");
+        } else if (stmt.getFormat().equals("protobuf")) {
+            jobProperties.put(PROPS_FORMAT, "protobuf");
+            jobProperties.put(PROPS_PROTOBUF_SCHEMA, stmt.getProtobufSchema());
+            jobProperties.put(PROPS_PROTOBUF_MESSAGE, stmt.getProtobufMessage());
         } else {
             throw new UserException("Invalid format type.");
         }
@@ -457,6 +463,8 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
         TFileFormatType fileFormatType = TFileFormatType.FORMAT_CSV_PLAIN;
         if (getFormat().equals("json")) {
             fileFormatType = TFileFormatType.FORMAT_JSON;
+        } else if (getFormat().equals("protobuf")) {
+            fileFormatType = TFileFormatType.FORMAT_PROTOBUF;
         }
         return fileFormatType;
     }
@@ -580,6 +588,11 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
         return "";
     }
 
+    @Override
+    public boolean isPartialUpdate() {
+        return false;
+    }
+
     @Override
     public ImportColumnDescs getColumnExprDescs() {
         if (columnDescs == null) {
@@ -604,6 +617,16 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
         return value;
     }
 
+    @Override
+    public String getProtobufSchema() {
+        return jobProperties.getOrDefault(PROPS_PROTOBUF_SCHEMA, "");
+    }
+
+    @Override
+    public String getProtobufMessage() {
+        return jobProperties.getOrDefault(PROPS_PROTOBUF_MESSAGE, "");
+    }
+
     @Override
     public String getSequenceCol() {
         return sequenceCol;
@@ -1391,6 +1414,8 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
         appendProperties(sb, CreateRoutineLoadStmt.MAX_BATCH_ROWS_PROPERTY, maxBatchRows, false);
         appendProperties(sb, CreateRoutineLoadStmt.MAX_BATCH_SIZE_PROPERTY, maxBatchSizeBytes, false);
         appendProperties(sb, PROPS_FORMAT, getFormat(), false);
+        appendProperties(sb, PROPS_PROTOBUF_SCHEMA, getProtobufSchema().replace("\"", "\\\""), false);
+        appendProperties(sb, PROPS_PROTOBUF_MESSAGE, getProtobufMessage(), false);
         appendProperties(sb, PROPS_JSONPATHS, getJsonPaths(), false);
         appendProperties(sb, PROPS_STRIP_OUTER_ARRAY, isStripOuterArray(), false);
         appendProperties(sb, PROPS_NUM_AS_STRING, isNumAsString(), false);
@@ -1465,6 +1490,9 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
         jobProperties.put("whereExpr", whereExpr == null ? STAR_STRING : whereExpr.toSql());
         if (getFormat().equalsIgnoreCase("json")) {
             jobProperties.put("dataFormat", "json");
+        } else if (getFormat().equalsIgnoreCase("protobuf")) {
+            jobProperties.put("dataFormat", "protobuf");
+            jobProperties.put("protobufMessage", getProtobufMessage());
         } else {
             jobProperties.put("columnSeparator", columnSeparator == null ? "\t" : columnSeparator.toString());
             jobProperties.put("lineDelimiter", lineDelimiter == null ? "\n" : lineDelimiter.toString());
@@ -417,6 +417,7 @@ public class AnalyticPlanner {
             // to be executed like a regular distributed sort
             if (!partitionByExprs.isEmpty()) {
                 sortNode.setIsAnalyticSort(true);
+                sortNode.setNumPartitionExprs(partitionByExprs.size());
             }
 
             if (partitionExprs != null) {
@@ -470,6 +470,8 @@ public class BrokerScanNode extends LoadScanNode {
             return TFileFormatType.FORMAT_CSV_LZOP;
         } else if (lowerCasePath.endsWith(".deflate")) {
             return TFileFormatType.FORMAT_CSV_DEFLATE;
+        } else if (lowerCasePath.endsWith(".zst")) {
+            return TFileFormatType.FORMAT_CSV_ZSTD;
         } else {
             return TFileFormatType.FORMAT_CSV_PLAIN;
         }
@@ -62,6 +62,7 @@ import org.apache.doris.thrift.TPaloScanRange;
 import org.apache.doris.thrift.TPlanNode;
 import org.apache.doris.thrift.TPlanNodeType;
 import org.apache.doris.thrift.TPrimitiveType;
+import org.apache.doris.thrift.TPushAggOp;
 import org.apache.doris.thrift.TScanRange;
 import org.apache.doris.thrift.TScanRangeLocation;
 import org.apache.doris.thrift.TScanRangeLocations;
@@ -127,6 +128,8 @@ public class OlapScanNode extends ScanNode {
     private String reasonOfPreAggregation = null;
     private boolean canTurnOnPreAggr = true;
     private boolean forceOpenPreAgg = false;
+    // the aggregation without grouping over this node which is answered by the segment metadata
+    private TPushAggOp pushDownAggNoGroupingOp = TPushAggOp.NONE;
     private OlapTable olapTable = null;
     private long selectedTabletsNum = 0;
     private long totalTabletsNum = 0;
@@ -159,6 +162,14 @@ public class OlapScanNode extends ScanNode {
         return isPreAggregation;
     }
 
+    public void setPushDownAggNoGrouping(TPushAggOp pushDownAggNoGroupingOp) {
+        this.pushDownAggNoGroupingOp = pushDownAggNoGroupingOp;
+    }
+
+    public TPushAggOp getPushDownAggNoGroupingOp() {
+        return pushDownAggNoGroupingOp;
+    }
+
     public boolean getCanTurnOnPreAggr() {
         return canTurnOnPreAggr;
     }
@@ -704,6 +715,9 @@ public class OlapScanNode extends ScanNode {
             output.append(", PREAGGREGATION: OFF. Reason: ").append(reasonOfPreAggregation);
         }
         output.append("\n");
+        if (pushDownAggNoGroupingOp != TPushAggOp.NONE) {
+            output.append(prefix).append("PUSH DOWN AGG: ").append(pushDownAggNoGroupingOp).append("\n");
+        }
 
         if (null != sortColumn) {
             output.append(prefix).append("SORT COLUMN: ").append(sortColumn).append("\n");
@@ -761,6 +775,9 @@ public class OlapScanNode extends ScanNode {
         }
         msg.olap_scan_node.setKeyType(olapTable.getKeysType().toThrift());
         msg.olap_scan_node.setTableName(olapTable.getName());
+        if (pushDownAggNoGroupingOp != TPushAggOp.NONE) {
+            msg.olap_scan_node.setPushDownAggTypeOpt(pushDownAggNoGroupingOp);
+        }
     }
 
     // export some tablets
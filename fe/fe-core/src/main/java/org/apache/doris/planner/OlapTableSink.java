@@ -37,6 +37,7 @@ import org.apache.doris.catalog.RandomDistributionInfo;
 import org.apache.doris.catalog.RangePartitionItem;
 import org.apache.doris.catalog.Tablet;
 import org.apache.doris.common.AnalysisException;
+import org.apache.doris.common.Config;
 import org.apache.doris.common.DdlException;
 import org.apache.doris.common.ErrorCode;
 import org.apache.doris.common.ErrorReport;
@@ -66,6 +67,7 @@ import com.google.common.collect.HashMultimap;
 import com.google.common.collect.Lists;
 import com.google.common.collect.Multimap;
 import com.google.common.collect.Range;
+import com.google.common.collect.Sets;
 import org.apache.commons.lang.StringUtils;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
@@ -73,6 +75,7 @@ import org.apache.logging.log4j.Logger;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
 import java.util.stream.Collectors;
 
 public class OlapTableSink extends DataSink {
@@ -83,6 +86,9 @@ public class OlapTableSink extends DataSink {
     private TupleDescriptor tupleDescriptor;
     // specified partition ids.
     private List<Long> partitionIds;
+    // only the columns in partialUpdateInputColumns are provided by a partial update
+    private boolean isPartialUpdate = false;
+    private Set<String> partialUpdateInputColumns = Sets.newHashSet();
 
     // set after init called
     private TDataSink tDataSink;
@@ -106,6 +112,7 @@ public class OlapTableSink extends DataSink {
                     + " the olap table must be with random distribution");
         }
         tSink.setLoadToSingleTablet(loadToSingleTablet);
+        tSink.setWriteSingleReplica(Config.enable_single_replica_load);
         tDataSink = new TDataSink(TDataSinkType.OLAP_TABLE_SINK);
         tDataSink.setOlapTableSink(tSink);
 
@@ -123,6 +130,11 @@ public class OlapTableSink extends DataSink {
         }
     }
 
+    public void setPartialUpdateInputColumns(boolean isPartialUpdate, Set<String> columns) {
+        this.isPartialUpdate = isPartialUpdate;
+        this.partialUpdateInputColumns = columns;
+    }
+
     public void updateLoadId(TUniqueId newLoadId) {
         tDataSink.getOlapTableSink().setLoadId(newLoadId);
     }
@@ -192,6 +204,12 @@ public class OlapTableSink extends DataSink {
                     indexMeta.getSchemaHash());
             schemaParam.addToIndexes(indexSchema);
         }
+        schemaParam.setIsPartialUpdate(isPartialUpdate);
+        if (isPartialUpdate) {
+            for (String column : partialUpdateInputColumns) {
+                schemaParam.addToPartialUpdateInputColumns(column);
+            }
+        }
         return schemaParam;
     }
 
@@ -54,14 +54,17 @@ import org.apache.doris.catalog.AggregateFunction;
 import org.apache.doris.catalog.AggregateType;
 import org.apache.doris.catalog.Column;
 import org.apache.doris.catalog.FunctionSet;
+import org.apache.doris.catalog.KeysType;
 import org.apache.doris.catalog.MysqlTable;
 import org.apache.doris.catalog.OdbcTable;
 import org.apache.doris.catalog.Table;
+import org.apache.doris.catalog.Type;
 import org.apache.doris.common.AnalysisException;
 import org.apache.doris.common.FeConstants;
 import org.apache.doris.common.Pair;
 import org.apache.doris.common.Reference;
 import org.apache.doris.common.UserException;
+import org.apache.doris.thrift.TPushAggOp;
 
 import com.google.common.base.Preconditions;
 import com.google.common.base.Predicate;
@@ -354,6 +357,65 @@ public class SingleNodePlanner {
         return selectNode;
     }
 
+    /**
+     * Push the aggregation without grouping over a duplicate key table down to the scan node, so
+     * that it's answered by the segment metadata instead of the data pages: count(*) by the row
+     * counts and min/max of the numeric columns by the zone maps. The storage engine still scans
+     * the segments with deleted rows. count(*) with filters is pushed down too, it's answered by
+     * the rows left by the bitmap indexes if all the filters are evaluated by them.
+     */
+    private void pushDownAggNoGrouping(AggregateInfo aggInfo, SelectStmt selectStmt, PlanNode root) {
+        if (!(root instanceof OlapScanNode) || aggInfo == null || aggInfo.isDistinctAgg()
+                || !aggInfo.getGroupingExprs().isEmpty() || selectStmt.getTableRefs().size() != 1) {
+            return;
+        }
+        boolean hasFilter = selectStmt.getWhereClause() != null || !root.getConjuncts().isEmpty();
+        OlapScanNode scanNode = (OlapScanNode) root;
+        if (scanNode.getOlapTable().getKeysType() != KeysType.DUP_KEYS) {
+            return;
+        }
+        TPushAggOp op = TPushAggOp.NONE;
+        for (FunctionCallExpr aggExpr : aggInfo.getAggregateExprs()) {
+            String fnName = aggExpr.getFnName().getFunction();
+            TPushAggOp exprOp;
+            if (fnName.equalsIgnoreCase(FunctionSet.COUNT)) {
+                // count(col) counts the not null values
+                if (!aggExpr.isCountStar()) {
+                    SlotRef slotRef = aggExpr.getChild(0).unwrapSlotRef(true);
+                    if (slotRef == null || slotRef.getDesc().getIsNullable()) {
+                        return;
+                    }
+                }
+                exprOp = TPushAggOp.COUNT;
+            } else if (fnName.equalsIgnoreCase("min") || fnName.equalsIgnoreCase("max")) {
+                if (!(aggExpr.getChild(0) instanceof SlotRef)) {
+                    return;
+                }
+                exprOp = TPushAggOp.MINMAX;
+            } else {
+                return;
+            }
+            if (op != TPushAggOp.NONE && op != exprOp) {
+                return;
+            }
+            op = exprOp;
+        }
+        if (op == TPushAggOp.MINMAX) {
+            if (hasFilter) {
+                return;
+            }
+            // the zone maps of the other types are truncated or in another format
+            for (SlotDescriptor slot : scanNode.getTupleDesc().getMaterializedSlots()) {
+                Column column = slot.getColumn();
+                Type type = column == null ? null : column.getType();
+                if (type == null || !(type.isFixedPointType() || type.isFloatingPointType())) {
+                    return;
+                }
+            }
+        }
+        scanNode.setPushDownAggNoGrouping(op);
+    }
+
     private void turnOffPreAgg(AggregateInfo aggInfo, SelectStmt selectStmt, Analyzer analyzer, PlanNode root) {
         String turnOffReason = null;
         do {
@@ -986,6 +1048,7 @@ public class SingleNodePlanner {
                 materializeTableResultForCrossJoinOrCountStar(ref, analyzer);
                 PlanNode plan = createTableRefNode(analyzer, ref, selectStmt);
                 turnOffPreAgg(aggInfo, selectStmt, analyzer, plan);
+                pushDownAggNoGrouping(aggInfo, selectStmt, plan);
 
                 if (plan instanceof OlapScanNode) {
                     OlapScanNode olapNode = (OlapScanNode) plan;
@@ -1014,6 +1077,7 @@ public class SingleNodePlanner {
             // selectStmt.seondSubstituteInlineViewExprs(analyzer.getChangeResSmap());
 
             turnOffPreAgg(aggInfo, selectStmt, analyzer, root);
+            pushDownAggNoGrouping(aggInfo, selectStmt, root);
 
             if (root instanceof OlapScanNode) {
                 OlapScanNode olapNode = (OlapScanNode) root;
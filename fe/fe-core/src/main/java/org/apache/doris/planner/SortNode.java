@@ -72,6 +72,13 @@ public class SortNode extends PlanNode {
         return isAnalyticSort;
     }
 
+    // the number of the leading ordering exprs which are the partition exprs of the AnalyticNode
+    private int numPartitionExprs = 0;
+
+    public void setNumPartitionExprs(int numPartitionExprs) {
+        this.numPartitionExprs = numPartitionExprs;
+    }
+
     private DataPartition inputPartition;
 
     public void setInputPartition(DataPartition inputPartition) {
@@ -190,6 +197,9 @@ public class SortNode extends PlanNode {
 
         msg.sort_node = sortNode;
         msg.sort_node.setOffset(offset);
+        if (isAnalyticSort && numPartitionExprs > 0) {
+            msg.sort_node.setNumPartitionExprs(numPartitionExprs);
+        }
 
         // TODO(lingbin): remove blew codes, because it is duplicate with TSortInfo
         msg.sort_node.setOrderingExprs(Expr.treesToThrift(info.getOrderingExprs()));
@@ -20,6 +20,7 @@ package org.apache.doris.planner;
 import org.apache.doris.analysis.Analyzer;
 import org.apache.doris.analysis.DescriptorTable;
 import org.apache.doris.analysis.Expr;
+import org.apache.doris.analysis.ImportColumnDesc;
 import org.apache.doris.analysis.PartitionNames;
 import org.apache.doris.analysis.SlotDescriptor;
 import org.apache.doris.analysis.TupleDescriptor;
@@ -56,6 +57,7 @@ import org.apache.doris.thrift.TUniqueId;
 
 import com.google.common.collect.Lists;
 import com.google.common.collect.Maps;
+import com.google.common.collect.Sets;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
 
@@ -64,6 +66,7 @@ import java.text.SimpleDateFormat;
 import java.util.Date;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
 
 // Used to generate a plan fragment for a streaming load.
 // we only support OlapTable now.
@@ -121,6 +124,10 @@ public class StreamLoadPlanner {
         if (!destTable.hasSequenceCol() && taskInfo.hasSequenceCol()) {
             throw new UserException("There is no sequence column in the table " + destTable.getName());
         }
+        Set<String> partialUpdateInputColumns = Sets.newHashSet();
+        if (taskInfo.isPartialUpdate()) {
+            partialUpdateInputColumns = getPartialUpdateInputColumns();
+        }
         resetAnalyzer();
         // construct tuple descriptor, used for scanNode and dataSink
         tupleDesc = descTable.createTupleDescriptor("DstTableTuple");
@@ -157,6 +164,7 @@ public class StreamLoadPlanner {
         OlapTableSink olapTableSink = new OlapTableSink(destTable, tupleDesc, partitionIds);
         olapTableSink.init(loadId, taskInfo.getTxnId(), db.getId(), taskInfo.getTimeout(),
                 taskInfo.getSendBatchParallelism(), taskInfo.isLoadToSingleTablet());
+        olapTableSink.setPartialUpdateInputColumns(taskInfo.isPartialUpdate(), partialUpdateInputColumns);
         olapTableSink.complete();
 
         // for stream load, we only need one fragment, ScanNode -> DataSink.
@@ -219,6 +227,34 @@ public class StreamLoadPlanner {
         return params;
     }
 
+    // The columns provided by a partial update are the table columns in the column descs,
+    // which must contain all the key columns. The other columns keep their latest values.
+    private Set<String> getPartialUpdateInputColumns() throws UserException {
+        if (destTable.getKeysType() != KeysType.UNIQUE_KEYS) {
+            throw new UserException("Partial update is only supported in unique tables.");
+        }
+        if (destTable.hasSequenceCol()) {
+            throw new UserException("Partial update is not supported in tables with sequence column.");
+        }
+        if (taskInfo.getMergeType() != LoadTask.MergeType.APPEND) {
+            throw new UserException("Partial update is only supported by load with APPEND merge type.");
+        }
+        Set<String> columns = Sets.newHashSet();
+        for (ImportColumnDesc desc : taskInfo.getColumnExprDescs().descs) {
+            Column column = destTable.getColumn(desc.getColumnName());
+            if (column != null) {
+                columns.add(column.getName());
+            }
+        }
+        for (Column column : destTable.getBaseSchema()) {
+            if (column.isKey() && !columns.contains(column.getName())) {
+                throw new UserException("Partial update should include all key columns, missing: "
+                        + column.getName());
+            }
+        }
+        return columns;
+    }
+
     // get all specified partition ids.
     // if no partition specified, return null
     private List<Long> getAllPartitionIds() throws DdlException, AnalysisException {
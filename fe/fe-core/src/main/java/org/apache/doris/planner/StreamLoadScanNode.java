@@ -107,6 +107,9 @@ public class StreamLoadScanNode extends LoadScanNode {
             rangeDesc.setNumAsString(taskInfo.isNumAsString());
             rangeDesc.setFuzzyParse(taskInfo.isFuzzyParse());
             rangeDesc.setReadJsonByLine(taskInfo.isReadJsonByLine());
+        } else if (rangeDesc.format_type == TFileFormatType.FORMAT_PROTOBUF) {
+            rangeDesc.setProtobufSchema(taskInfo.getProtobufSchema());
+            rangeDesc.setProtobufMessage(taskInfo.getProtobufMessage());
         }
         rangeDesc.splittable = false;
         switch (taskInfo.getFileType()) {
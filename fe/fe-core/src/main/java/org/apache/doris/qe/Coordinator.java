@@ -229,6 +229,8 @@ public class Coordinator {
     public List<RuntimeFilter> assignedRuntimeFilters = new ArrayList<>();
     // Runtime filter ID to the builder instance number
     public Map<RuntimeFilterId, Integer> ridToBuilderNum = Maps.newHashMap();
+    // Runtime filter ID to the builder instance number on each host
+    public Map<RuntimeFilterId, Map<TNetworkAddress, Integer>> ridToBuilderNumOnHost = Maps.newHashMap();
 
 
     // Used for query/insert
@@ -1324,6 +1326,11 @@ public class Coordinator {
 
             for (RuntimeFilterId rid : fragment.getBuilderRuntimeFilterIds()) {
                 ridToBuilderNum.merge(rid, params.instanceExecParams.size(), Integer::sum);
+                Map<TNetworkAddress, Integer> builderNumOnHost =
+                        ridToBuilderNumOnHost.computeIfAbsent(rid, k -> Maps.newHashMap());
+                for (final FInstanceExecParam instance : params.instanceExecParams) {
+                    builderNumOnHost.merge(instance.host, 1, Integer::sum);
+                }
             }
         }
         // Use the uppermost fragment as a merged node, the uppermost fragment has one and only one instance
@@ -2177,6 +2184,15 @@ public class Coordinator {
                 }
                 state.unsetFields();
             }
+            // the instances of a fragment are added in turn, and their plans are the same
+            PlanFragmentId prevFragmentId = null;
+            for (BackendExecState state : states) {
+                if (state.fragmentId.equals(prevFragmentId)) {
+                    state.rpcParams.unsetFragment();
+                    state.rpcParams.setReusePrevFragment(true);
+                }
+                prevFragmentId = state.fragmentId;
+            }
         }
 
         public Future<InternalService.PExecPlanFragmentResult> execRemoteFragmentsAsync() throws TException {
@@ -2289,6 +2305,13 @@ public class Coordinator {
                         fragment.isTransferQueryStatisticsWithEveryBatch());
                 params.params.setRuntimeFilterParams(new TRuntimeFilterParams());
                 params.params.runtime_filter_params.setRuntimeFilterMergeAddr(runtimeFilterMergeAddr);
+                for (RuntimeFilterId rid : fragment.getBuilderRuntimeFilterIds()) {
+                    Map<TNetworkAddress, Integer> builderNumOnHost = ridToBuilderNumOnHost.get(rid);
+                    if (builderNumOnHost != null && builderNumOnHost.containsKey(instanceExecParam.host)) {
+                        params.params.runtime_filter_params.putToRuntimeFilterBuilderNumOnHost(
+                                rid.asInt(), builderNumOnHost.get(instanceExecParam.host));
+                    }
+                }
                 if (instanceExecParam.instanceId.equals(runtimeFilterMergeInstanceId)) {
                     for (Map.Entry<RuntimeFilterId, List<FRuntimeFilterTargetParam>> entry
                             : ridToTargetParam.entrySet()) {
@@ -192,6 +192,18 @@ public class SessionVariable implements Serializable, Writable {
 
     static final String ENABLE_ARRAY_TYPE = "enable_array_type";
 
+    public static final String DISABLE_FILE_CACHE = "disable_file_cache";
+
+    public static final String WORKLOAD_GROUP = "workload_group";
+
+    public static final String FRAGMENT_TRANSMISSION_COMPRESSION_CODEC =
+            "fragment_transmission_compression_codec";
+
+    public static final String FRAGMENT_TRANSMISSION_COMPRESSION_LEVEL =
+            "fragment_transmission_compression_level";
+
+    public static final String FILL_STORAGE_PAGE_CACHE = "fill_storage_page_cache";
+
     // session origin value
     public Map<Field, String> sessionOriginValue = new HashMap<Field, String>();
     // check stmt is or not [select /*+ SET_VAR(...)*/ ...]
@@ -415,6 +427,29 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = TRIM_TAILING_SPACES_FOR_EXTERNAL_TABLE_QUERY, needForward = true)
     public boolean trimTailingSpacesForExternalTableQuery = false;
 
+    // if true, the query reads remote data directly instead of through the file cache of BE
+    @VariableMgr.VarAttr(name = DISABLE_FILE_CACHE)
+    public boolean disableFileCache = false;
+
+    // the workload group on BE which limits the cpu, memory and scan threads of the query,
+    // empty means the query does not belong to any group
+    @VariableMgr.VarAttr(name = WORKLOAD_GROUP, needForward = true)
+    public String workloadGroup = "";
+
+    // the codec of the blocks sent between fragments: none, snappy, lz4 or zstd, empty means
+    // snappy or none according to compress_rowbatches of BE
+    @VariableMgr.VarAttr(name = FRAGMENT_TRANSMISSION_COMPRESSION_CODEC, needForward = true)
+    public String fragmentTransmissionCompressionCodec = "";
+
+    // the zstd level of the blocks sent between fragments, 0 means the default level
+    @VariableMgr.VarAttr(name = FRAGMENT_TRANSMISSION_COMPRESSION_LEVEL, needForward = true)
+    public int fragmentTransmissionCompressionLevel = 0;
+
+    // if false, the query reads the pages cached by BE but does not cache the pages it reads,
+    // for the large scans not to evict the pages of the other queries
+    @VariableMgr.VarAttr(name = FILL_STORAGE_PAGE_CACHE, needForward = true)
+    public boolean fillStoragePageCache = true;
+
 
     // the maximum size in bytes for a table that will be broadcast to all be nodes
     // when performing a join, By setting this value to -1 broadcasting can be disabled.
@@ -990,6 +1025,15 @@ public class SessionVariable implements Serializable, Writable {
         tResult.setEnableVectorizedEngine(enableVectorizedEngine);
         tResult.setReturnObjectDataAsBinary(returnObjectDataAsBinary);
         tResult.setTrimTailingSpacesForExternalTableQuery(trimTailingSpacesForExternalTableQuery);
+        tResult.setDisableFileCache(disableFileCache);
+        if (!workloadGroup.isEmpty()) {
+            tResult.setWorkloadGroup(workloadGroup);
+        }
+        if (!fragmentTransmissionCompressionCodec.isEmpty()) {
+            tResult.setFragmentTransmissionCompressionCodec(fragmentTransmissionCompressionCodec);
+        }
+        tResult.setFragmentTransmissionCompressionLevel(fragmentTransmissionCompressionLevel);
+        tResult.setFillStoragePageCache(fillStoragePageCache);
 
         tResult.setBatchSize(batchSize);
         tResult.setDisableStreamPreaggregations(disableStreamPreaggregations);
@@ -66,6 +66,11 @@ public interface LoadTaskInfo {
 
     boolean isReadJsonByLine();
 
+    // only for the protobuf format
+    String getProtobufSchema();
+
+    String getProtobufMessage();
+
     String getPath();
 
     double getMaxFilterRatio();
@@ -88,6 +93,9 @@ public interface LoadTaskInfo {
 
     String getHeaderType();
 
+    // only the columns in the column descs are updated, the others keep the latest values
+    boolean isPartialUpdate();
+
     class ImportColumnDescs {
         public List<ImportColumnDesc> descs = Lists.newArrayList();
         public boolean isColumnDescsRewrited = false;
@@ -76,6 +76,7 @@ public class StreamLoadTask implements LoadTaskInfo {
     private double maxFilterRatio = 0.0;
     private boolean loadToSingleTablet = false;
     private String headerType = "";
+    private boolean isPartialUpdate = false;
 
     public StreamLoadTask(TUniqueId id, long txnId, TFileType fileType, TFileFormatType formatType) {
         this.id = id;
@@ -126,6 +127,17 @@ public class StreamLoadTask implements LoadTaskInfo {
         return headerType;
     }
 
+    // the protobuf format is only supported by routine load
+    @Override
+    public String getProtobufSchema() {
+        return "";
+    }
+
+    @Override
+    public String getProtobufMessage() {
+        return "";
+    }
+
     public Separator getLineDelimiter() {
         return lineDelimiter;
     }
@@ -140,6 +152,11 @@ public class StreamLoadTask implements LoadTaskInfo {
         return loadToSingleTablet;
     }
 
+    @Override
+    public boolean isPartialUpdate() {
+        return isPartialUpdate;
+    }
+
     public PartitionNames getPartitions() {
         return partitions;
     }
@@ -320,6 +337,9 @@ public class StreamLoadTask implements LoadTaskInfo {
         if (request.isSetLoadToSingleTablet()) {
             loadToSingleTablet = request.isLoadToSingleTablet();
         }
+        if (request.isSetPartialUpdate()) {
+            isPartialUpdate = request.isPartialUpdate();
+        }
     }
 
     // used for stream load
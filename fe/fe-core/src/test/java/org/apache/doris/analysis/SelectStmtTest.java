@@ -808,4 +808,35 @@ public class SelectStmtTest {
         FunctionCallExpr expr = (FunctionCallExpr) stmt1.getSelectList().getItems().get(1).getExpr();
         Assert.assertTrue(expr.getFnParams().isDistinct());
     }
+
+    @Test
+    public void testGroupConcatOrderBy() throws Exception {
+        ConnectContext ctx = UtFrameUtils.createDefaultCtx();
+        String sql = "select siteid, group_concat(username, '-' order by citycode desc, pv) "
+                + "from db1.table1 group by siteid";
+        SelectStmt stmt = (SelectStmt) UtFrameUtils.parseAndAnalyzeStmt(sql, ctx);
+        FunctionCallExpr expr = (FunctionCallExpr) stmt.getSelectList().getItems().get(1).getExpr();
+        Assert.assertTrue(expr.hasOrderBy());
+        Assert.assertEquals(2, expr.getFnParams().exprs().size());
+        Assert.assertEquals(4, expr.getChildren().size());
+        Assert.assertTrue(expr.toSql().contains("ORDER BY"));
+        Assert.assertTrue(expr.toSql().contains("DESC"));
+        dorisAssert.query(sql).explainQuery();
+
+        String distinctSql = "select group_concat(distinct username order by citycode) from db1.table1";
+        try {
+            UtFrameUtils.parseAndAnalyzeStmt(distinctSql, ctx);
+            Assert.fail();
+        } catch (AnalysisException e) {
+            Assert.assertTrue(e.getMessage().contains("does not support DISTINCT"));
+        }
+
+        String sumSql = "select sum(pv order by citycode) from db1.table1";
+        try {
+            UtFrameUtils.parseAndAnalyzeStmt(sumSql, ctx);
+            Assert.fail();
+        } catch (AnalysisException e) {
+            Assert.assertTrue(e.getMessage().contains("ORDER BY is only supported by group_concat"));
+        }
+    }
 }
@@ -100,7 +100,9 @@ enum THdfsCompression {
 }
 
 enum TIndexType {
-  BITMAP
+  BITMAP,
+  INVERTED,
+  NGRAM_BF
 }
 
 // Mapping from names defined by Avro to the enum.
@@ -169,6 +171,10 @@ struct TOlapTableSchemaParam {
     4: required list<TSlotDescriptor> slot_descs
     5: required TTupleDescriptor tuple_desc
     6: required list<TOlapTableIndexSchema> indexes
+    // Only the columns in partial_update_input_columns are provided by a partial update, the
+    // others are filled with the latest values of the same keys if the keys exist
+    7: optional bool is_partial_update
+    8: optional list<string> partial_update_input_columns
 }
 
 struct TOlapTableIndex {
@@ -73,6 +73,12 @@ enum TExprNodeType {
 struct TAggregateExpr {
   // Indicates whether this expr is the merge() of an aggregation.
   1: required bool is_merge_agg
+  // Set for the aggregations with ORDER BY, e.g. group_concat(v ORDER BY k).
+  // The types of the arguments followed by the ORDER BY exprs, which are the
+  // last is_asc_order.size() children of the update expr.
+  2: optional list<Types.TTypeDesc> param_types
+  3: optional list<bool> is_asc_order
+  4: optional list<bool> nulls_first
 }
 struct TBoolLiteral {
   1: required bool value
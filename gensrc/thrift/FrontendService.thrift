@@ -599,6 +599,8 @@ struct TStreamLoadPutRequest {
     36: optional double max_filter_ratio
     37: optional bool load_to_single_tablet
     38: optional string header_type
+    // only the columns in `columns` are updated, for merge-on-write unique key tables
+    39: optional bool partial_update
 }
 
 struct TStreamLoadPutResult {
@@ -23,6 +23,14 @@ include "PaloInternalService.thrift"
 include "Types.thrift"
 include "Status.thrift"
 
+struct TColumnStatistics {
+    1: optional i32 unique_id
+    2: optional i64 num_rows
+    3: optional i64 null_count
+    // estimated number of the distinct non-null values
+    4: optional i64 ndv
+}
+
 struct TTabletInfo {
     1: required Types.TTabletId tablet_id
     2: required Types.TSchemaHash schema_hash
@@ -42,6 +50,8 @@ struct TTabletInfo {
     15: optional Types.TReplicaId replica_id
     // data size on remote storage
     16: optional Types.TSize remote_data_size
+    // statistics of the columns by unique id, only reported if enabled on BE
+    17: optional list<TColumnStatistics> column_statistics
 }
 
 struct TFinishTaskRequest {
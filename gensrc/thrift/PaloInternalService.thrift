@@ -163,6 +163,23 @@ struct TQueryOptions {
 
   // trim tailing spaces while querying external table and stream load
   44: optional bool trim_tailing_spaces_for_external_table_query = false
+
+  // do not read or fill the local file cache of remote data in this query
+  45: optional bool disable_file_cache = false
+
+  // the workload group of the query on BE, the query is not limited by any group if unset
+  46: optional string workload_group
+
+  // the codec of the blocks sent between fragments: none, snappy, lz4 or zstd,
+  // snappy if compress_rowbatches of BE is set when empty
+  47: optional string fragment_transmission_compression_codec = ""
+
+  // the zstd level of fragment_transmission_compression_codec, 0 means the default level
+  48: optional i32 fragment_transmission_compression_level = 0
+
+  // insert the pages read by the query into the storage page cache of BE, false for the
+  // large scans not to evict the hot pages, which still read the cached pages
+  49: optional bool fill_storage_page_cache = true
 }
     
 
@@ -201,6 +218,10 @@ struct TRuntimeFilterParams {
 
   // Number of Runtime filter producers
   4: optional map<i32, i32> runtime_filter_builder_num
+
+  // Number of Runtime filter producers on the host of this instance,
+  // whose filters are merged on the host before sent to the merge instance
+  5: optional map<i32, i32> runtime_filter_builder_num_on_host
 }
 
 // Parameters for a single execution instance of a particular TPlanFragment
@@ -349,6 +370,10 @@ struct TExecPlanFragmentParams {
   // it will wait for the FE to send the "start execution" command before it is actually executed.
   // Otherwise, the fragment will start executing directly on the BE side.
   20: optional bool need_wait_execution_trigger = false;
+
+  // If true, the fragment is unset and is the same as the one of the previous params in
+  // TExecPlanFragmentParamsList, the instances of a fragment share the plan sent once.
+  21: optional bool reuse_prev_fragment = false;
 }
 
 struct TExecPlanFragmentParamsList {
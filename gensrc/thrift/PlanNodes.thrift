@@ -29,7 +29,7 @@ enum TPlanNodeType {
   CSV_SCAN_NODE, // deprecated
   SCHEMA_SCAN_NODE,
   HASH_JOIN_NODE,
-  MERGE_JOIN_NODE, // deprecated
+  MERGE_JOIN_NODE,
   AGGREGATION_NODE,
   PRE_AGGREGATION_NODE,
   SORT_NODE,
@@ -108,6 +108,8 @@ enum TFileFormatType {
     FORMAT_ORC,
     FORMAT_JSON,
     FORMAT_PROTO,
+    FORMAT_CSV_ZSTD,
+    FORMAT_PROTOBUF,
 }
 
 struct THdfsConf {
@@ -155,6 +157,9 @@ struct TBrokerRangeDesc {
     18: optional bool read_by_column_def;
     // csv with header type
     19: optional string header_type;
+    // the .proto schema and the full name of the message type, only for FORMAT_PROTOBUF
+    20: optional string protobuf_schema;
+    21: optional string protobuf_message;
 }
 
 struct TBrokerScanRangeParams {
@@ -350,6 +355,16 @@ struct TMetaScanNode {
   5: optional string user
 }
 
+// The aggregation without grouping over an olap scan node which can be answered by the
+// segment metadata instead of the data pages
+enum TPushAggOp {
+  NONE = 0,
+  // min/max of the columns, answered by the segment zone maps
+  MINMAX = 1,
+  // count(*), answered by the row counts of the segments
+  COUNT = 2
+}
+
 struct TOlapScanNode {
   1: required Types.TTupleId tuple_id
   2: required list<string> key_column_name
@@ -358,6 +373,7 @@ struct TOlapScanNode {
   5: optional string sort_column
   6: optional Types.TKeysType keyType
   7: optional string table_name
+  8: optional TPushAggOp push_down_agg_type_opt
 }
 
 struct TEqJoinCondition {
@@ -409,8 +425,13 @@ struct THashJoinNode {
 
   // hash output column
   6: optional list<Types.TSlotId> hash_output_slot_ids
+
+  // the build side is broadcast to all instances, so the instances on the same BE
+  // can share one hash table
+  7: optional bool is_broadcast_join
 }
 
+// The children must be sorted by the keys of cmp_conjuncts in ascending order.
 struct TMergeJoinNode {
   // anything from the ON, USING or WHERE clauses that's an equi-join predicate
   1: required list<TEqJoinCondition> cmp_conjuncts
@@ -418,6 +439,12 @@ struct TMergeJoinNode {
   // anything from the ON or USING clauses (but *not* the WHERE clause) that's not an
   // equi-join predicate
   2: optional list<Exprs.TExpr> other_join_conjuncts
+
+  // INNER_JOIN if not set
+  3: optional TJoinOp join_op
+
+  // other_join_conjuncts, only use in vec exec engine
+  4: optional Exprs.TExpr vother_join_conjunct
 }
 
 enum TAggregationOp {
@@ -523,6 +550,10 @@ struct TSortNode {
   // Expressions evaluated over the input row that materialize the tuple to be so
   // Contains one expr per slot in the materialized tuple.                       
   8: optional list<Exprs.TExpr> sort_tuple_slot_exprs                            
+  // Only set if the node sorts the input of an analytic node, the number of the leading
+  // ordering exprs which are the partition exprs of it. The rows only need to be sorted
+  // within every partition.
+  9: optional i32 num_partition_exprs
 }
 
 enum TAnalyticWindowType {